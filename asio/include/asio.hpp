@@ -15,6 +15,9 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include "asio/accept_batch.hpp"
+#include "asio/admission_controller.hpp"
+#include "asio/aligned_buffer.hpp"
 #include "asio/any_completion_executor.hpp"
 #include "asio/any_completion_handler.hpp"
 #include "asio/any_io_executor.hpp"
@@ -22,18 +25,22 @@
 #include "asio/as_tuple.hpp"
 #include "asio/associated_allocator.hpp"
 #include "asio/associated_cancellation_slot.hpp"
+#include "asio/associated_deadline.hpp"
 #include "asio/associated_executor.hpp"
 #include "asio/associated_immediate_executor.hpp"
 #include "asio/associator.hpp"
 #include "asio/async_result.hpp"
 #include "asio/awaitable.hpp"
+#include "asio/awaitable_arena_allocator.hpp"
 #include "asio/basic_datagram_socket.hpp"
 #include "asio/basic_deadline_timer.hpp"
 #include "asio/basic_file.hpp"
 #include "asio/basic_io_object.hpp"
+#include "asio/basic_packet_ring.hpp"
 #include "asio/basic_random_access_file.hpp"
 #include "asio/basic_raw_socket.hpp"
 #include "asio/basic_readable_pipe.hpp"
+#include "asio/basic_readiness_set.hpp"
 #include "asio/basic_seq_packet_socket.hpp"
 #include "asio/basic_serial_port.hpp"
 #include "asio/basic_signal_set.hpp"
@@ -44,6 +51,7 @@
 #include "asio/basic_stream_file.hpp"
 #include "asio/basic_stream_socket.hpp"
 #include "asio/basic_streambuf.hpp"
+#include "asio/basic_timeout_timer.hpp"
 #include "asio/basic_waitable_timer.hpp"
 #include "asio/basic_writable_pipe.hpp"
 #include "asio/bind_allocator.hpp"
@@ -55,25 +63,34 @@
 #include "asio/buffered_read_stream_fwd.hpp"
 #include "asio/buffered_read_stream.hpp"
 #include "asio/buffered_stream_fwd.hpp"
+#include "asio/buffered_stream_pool.hpp"
 #include "asio/buffered_stream.hpp"
 #include "asio/buffered_write_stream_fwd.hpp"
 #include "asio/buffered_write_stream.hpp"
+#include "asio/buffers_cat.hpp"
 #include "asio/buffers_iterator.hpp"
+#include "asio/buffers_prefix.hpp"
+#include "asio/buffers_suffix.hpp"
 #include "asio/cancel_after.hpp"
 #include "asio/cancel_at.hpp"
 #include "asio/cancellation_signal.hpp"
 #include "asio/cancellation_state.hpp"
 #include "asio/cancellation_type.hpp"
+#include "asio/chain_buffer.hpp"
 #include "asio/co_composed.hpp"
 #include "asio/co_spawn.hpp"
+#include "asio/coarse_steady_timer.hpp"
 #include "asio/completion_condition.hpp"
 #include "asio/compose.hpp"
 #include "asio/composed.hpp"
 #include "asio/config.hpp"
 #include "asio/connect.hpp"
+#include "asio/connect_with_data.hpp"
 #include "asio/connect_pipe.hpp"
 #include "asio/consign.hpp"
 #include "asio/coroutine.hpp"
+#include "asio/datagram_arena.hpp"
+#include "asio/deadline_executor.hpp"
 #include "asio/deadline_timer.hpp"
 #include "asio/defer.hpp"
 #include "asio/deferred.hpp"
@@ -100,6 +117,8 @@
 #include "asio/executor.hpp"
 #include "asio/executor_work_guard.hpp"
 #include "asio/file_base.hpp"
+#include "asio/frame_slot.hpp"
+#include "asio/framed_stream.hpp"
 #include "asio/generic/basic_endpoint.hpp"
 #include "asio/generic/datagram_protocol.hpp"
 #include "asio/generic/raw_protocol.hpp"
@@ -109,7 +128,10 @@
 #include "asio/high_resolution_timer.hpp"
 #include "asio/immediate.hpp"
 #include "asio/io_context.hpp"
+#include "asio/io_context_pool.hpp"
 #include "asio/io_context_strand.hpp"
+#include "asio/io_uring_capabilities.hpp"
+#include "asio/io_uring_protocol.hpp"
 #include "asio/ip/address.hpp"
 #include "asio/ip/address_v4.hpp"
 #include "asio/ip/address_v4_iterator.hpp"
@@ -119,15 +141,22 @@
 #include "asio/ip/address_v6_range.hpp"
 #include "asio/ip/network_v4.hpp"
 #include "asio/ip/network_v6.hpp"
+#include "asio/ip/packet_info.hpp"
+#include "asio/ip/prefix_table.hpp"
 #include "asio/ip/bad_address_cast.hpp"
+#include "asio/ip/basic_connection_pool.hpp"
 #include "asio/ip/basic_endpoint.hpp"
+#include "asio/ip/basic_multicast_receiver.hpp"
 #include "asio/ip/basic_resolver.hpp"
 #include "asio/ip/basic_resolver_entry.hpp"
 #include "asio/ip/basic_resolver_iterator.hpp"
 #include "asio/ip/basic_resolver_query.hpp"
+#include "asio/ip/caching_resolver.hpp"
+#include "asio/ip/endpoint_key.hpp"
 #include "asio/ip/host_name.hpp"
 #include "asio/ip/icmp.hpp"
 #include "asio/ip/multicast.hpp"
+#include "asio/ip/multicast_receiver.hpp"
 #include "asio/ip/resolver_base.hpp"
 #include "asio/ip/resolver_query_base.hpp"
 #include "asio/ip/tcp.hpp"
@@ -139,38 +168,61 @@
 #include "asio/is_executor.hpp"
 #include "asio/is_read_buffered.hpp"
 #include "asio/is_write_buffered.hpp"
+#include "asio/latency_histogram.hpp"
 #include "asio/local/basic_endpoint.hpp"
+#include "asio/local/basic_shm_stream.hpp"
 #include "asio/local/connect_pair.hpp"
 #include "asio/local/datagram_protocol.hpp"
+#include "asio/local/passed_fds.hpp"
 #include "asio/local/seq_packet_protocol.hpp"
+#include "asio/local/shm_stream.hpp"
 #include "asio/local/stream_protocol.hpp"
+#include "asio/mapped_file.hpp"
+#include "asio/memory_statistics.hpp"
 #include "asio/multiple_exceptions.hpp"
 #include "asio/packaged_task.hpp"
+#include "asio/packet_ring.hpp"
+#include "asio/parallel_for.hpp"
 #include "asio/placeholders.hpp"
+#include "asio/pooled_allocator.hpp"
 #include "asio/posix/basic_descriptor.hpp"
 #include "asio/posix/basic_stream_descriptor.hpp"
 #include "asio/posix/descriptor.hpp"
 #include "asio/posix/descriptor_base.hpp"
 #include "asio/posix/stream_descriptor.hpp"
 #include "asio/post.hpp"
+#include "asio/post_batch.hpp"
 #include "asio/prefer.hpp"
 #include "asio/prepend.hpp"
+#include "asio/provided_buffer_ring.hpp"
 #include "asio/query.hpp"
 #include "asio/random_access_file.hpp"
+#include "asio/rate_limited_stream.hpp"
+#include "asio/rate_limiter.hpp"
 #include "asio/read.hpp"
 #include "asio/read_at.hpp"
+#include "asio/read_frame.hpp"
+#include "asio/read_ranges_at.hpp"
 #include "asio/read_until.hpp"
 #include "asio/readable_pipe.hpp"
+#include "asio/readiness_set.hpp"
 #include "asio/recycling_allocator.hpp"
 #include "asio/redirect_error.hpp"
 #include "asio/registered_buffer.hpp"
+#include "asio/registered_buffer_pool.hpp"
+#include "asio/relay.hpp"
 #include "asio/require.hpp"
 #include "asio/require_concept.hpp"
+#include "asio/ring_buffer.hpp"
+#include "asio/sendfile.hpp"
 #include "asio/serial_port.hpp"
 #include "asio/serial_port_base.hpp"
+#include "asio/shared_const_buffer.hpp"
 #include "asio/signal_set.hpp"
 #include "asio/signal_set_base.hpp"
 #include "asio/socket_base.hpp"
+#include "asio/socket_timestamp.hpp"
+#include "asio/splice.hpp"
 #include "asio/static_thread_pool.hpp"
 #include "asio/steady_timer.hpp"
 #include "asio/strand.hpp"
@@ -184,6 +236,9 @@
 #include "asio/thread.hpp"
 #include "asio/thread_pool.hpp"
 #include "asio/time_traits.hpp"
+#include "asio/timeout_timer.hpp"
+#include "asio/transport_info.hpp"
+#include "asio/transport_info_sampler.hpp"
 #include "asio/use_awaitable.hpp"
 #include "asio/use_future.hpp"
 #include "asio/uses_executor.hpp"
@@ -201,5 +256,6 @@
 #include "asio/writable_pipe.hpp"
 #include "asio/write.hpp"
 #include "asio/write_at.hpp"
+#include "asio/write_queue.hpp"
 
 #endif // ASIO_HPP
@@ -0,0 +1,206 @@
+//
+// accept_batch.hpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_ACCEPT_BATCH_HPP
+#define ASIO_ACCEPT_BATCH_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <vector>
+#include "asio/async_result.hpp"
+#include "asio/basic_socket_acceptor.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+class io_context_pool;
+
+namespace detail {
+
+template <typename Protocol, typename Executor>
+class initiate_async_accept_batch;
+
+} // namespace detail
+
+/**
+ * @defgroup async_accept_batch asio::async_accept_batch
+ *
+ * @brief The @c async_accept_batch function is a composed asynchronous
+ * operation that accepts all of the connections that are pending on an
+ * acceptor, up to a limit, for a single readiness notification.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to accept a batch of connections.
+/**
+ * This function is used to asynchronously accept up to @c max_n new
+ * connections. It is an initiating function for an @ref
+ * asynchronous_operation, and always returns immediately.
+ *
+ * The operation accepts connections until @c max_n have been accepted or no
+ * more are pending, and waits for the acceptor to become readable only if no
+ * connection is pending at all. Under a high connection rate this returns
+ * many connections for each pass through the reactor, rather than one for
+ * each call to @c async_accept. The acceptor is placed into non-blocking
+ * mode.
+ *
+ * @param a The acceptor on which the connections are accepted. The object
+ * must remain valid until the completion handler is called.
+ *
+ * @param max_n The maximum number of connections to accept. If zero, the
+ * operation completes immediately with no sockets.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the operation completes.
+ * Potential completion tokens include @ref use_future, @ref use_awaitable,
+ * @ref yield_context, or a function object with the correct completion
+ * signature. The function signature of the completion handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const asio::error_code& error,
+ *
+ *   // The accepted sockets, which use the acceptor's executor.
+ *   std::vector<typename Protocol::socket> sockets
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the completion handler will not be invoked from within this function.
+ * On immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::async_immediate().
+ *
+ * @par Completion Signature
+ * @code void(asio::error_code, std::vector<typename Protocol::socket>) @endcode
+ *
+ * If an error occurs after at least one connection has been accepted, the
+ * operation completes successfully with the connections accepted so far. The
+ * error, if it persists, is reported by the next operation.
+ *
+ * @par Example
+ * @code
+ * void do_accept(asio::ip::tcp::acceptor& acceptor)
+ * {
+ *   asio::async_accept_batch(acceptor, 64,
+ *       [&](asio::error_code ec, std::vector<asio::ip::tcp::socket> sockets)
+ *       {
+ *         for (auto& s : sockets)
+ *           start_session(std::move(s));
+ *         if (!ec)
+ *           do_accept(acceptor);
+ *       });
+ * }
+ * @endcode
+ *
+ * @par Per-Operation Cancellation
+ * This asynchronous operation supports cancellation for the following
+ * asio::cancellation_type values:
+ *
+ * @li @c cancellation_type::terminal
+ *
+ * if they are also supported by the acceptor's @c async_wait operation.
+ */
+template <typename Protocol, typename Executor,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::vector<typename Protocol::socket>)) AcceptBatchToken
+        = default_completion_token_t<Executor>>
+inline auto async_accept_batch(basic_socket_acceptor<Protocol, Executor>& a,
+    std::size_t max_n,
+    AcceptBatchToken&& token = default_completion_token_t<Executor>())
+  -> decltype(
+    async_initiate<AcceptBatchToken,
+      void (asio::error_code, std::vector<typename Protocol::socket>)>(
+        declval<detail::initiate_async_accept_batch<Protocol, Executor>>(),
+        token, max_n, static_cast<io_context_pool*>(0)))
+{
+  return async_initiate<AcceptBatchToken,
+    void (asio::error_code, std::vector<typename Protocol::socket>)>(
+      detail::initiate_async_accept_batch<Protocol, Executor>(a),
+      token, max_n, static_cast<io_context_pool*>(0));
+}
+
+/// Start an asynchronous operation to accept a batch of connections and
+/// distribute them across a pool of io_context objects.
+/**
+ * This function is used to asynchronously accept up to @c max_n new
+ * connections, as for the overload above. Each accepted socket is associated
+ * with the next io_context in @c targets, as returned by
+ * io_context_pool::get_executor(), so that consecutive connections are
+ * distributed round-robin across the pool.
+ *
+ * @param a The acceptor on which the connections are accepted. The object
+ * must remain valid until the completion handler is called.
+ *
+ * @param max_n The maximum number of connections to accept. If zero, the
+ * operation completes immediately with no sockets.
+ *
+ * @param targets The pool whose io_context objects are used by the accepted
+ * sockets. The object must remain valid until the completion handler is
+ * called.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the operation completes.
+ * Potential completion tokens include @ref use_future, @ref use_awaitable,
+ * @ref yield_context, or a function object with the correct completion
+ * signature. The function signature of the completion handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const asio::error_code& error,
+ *
+ *   // The accepted sockets, which use executors from the pool.
+ *   std::vector<typename Protocol::socket> sockets
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the completion handler will not be invoked from within this function.
+ * On immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::async_immediate().
+ *
+ * @par Completion Signature
+ * @code void(asio::error_code, std::vector<typename Protocol::socket>) @endcode
+ *
+ * @par Per-Operation Cancellation
+ * This asynchronous operation supports cancellation for the following
+ * asio::cancellation_type values:
+ *
+ * @li @c cancellation_type::terminal
+ *
+ * if they are also supported by the acceptor's @c async_wait operation.
+ */
+template <typename Protocol, typename Executor,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::vector<typename Protocol::socket>)) AcceptBatchToken
+        = default_completion_token_t<Executor>>
+inline auto async_accept_batch(basic_socket_acceptor<Protocol, Executor>& a,
+    std::size_t max_n, io_context_pool& targets,
+    AcceptBatchToken&& token = default_completion_token_t<Executor>())
+  -> decltype(
+    async_initiate<AcceptBatchToken,
+      void (asio::error_code, std::vector<typename Protocol::socket>)>(
+        declval<detail::initiate_async_accept_batch<Protocol, Executor>>(),
+        token, max_n, &targets))
+{
+  return async_initiate<AcceptBatchToken,
+    void (asio::error_code, std::vector<typename Protocol::socket>)>(
+      detail::initiate_async_accept_batch<Protocol, Executor>(a),
+      token, max_n, &targets);
+}
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/accept_batch.hpp"
+
+#endif // ASIO_ACCEPT_BATCH_HPP
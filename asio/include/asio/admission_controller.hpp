@@ -0,0 +1,553 @@
+//
+// admission_controller.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_ADMISSION_CONTROLLER_HPP
+#define ASIO_ADMISSION_CONTROLLER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <deque>
+#include <memory>
+#include "asio/any_completion_handler.hpp"
+#include "asio/any_io_executor.hpp"
+#include "asio/append.hpp"
+#include "asio/associated_executor.hpp"
+#include "asio/async_result.hpp"
+#include "asio/basic_socket_acceptor.hpp"
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/dispatch.hpp"
+#include "asio/error.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/executor_work_guard.hpp"
+#include "asio/post.hpp"
+#include "asio/socket_base.hpp"
+#include "asio/wait_traits.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Limits the acceptance of new connections while an executor is overloaded.
+/**
+ * The basic_admission_controller class template accepts connections on behalf
+ * of a server, and stops admitting new connections while the executor that
+ * runs the server is too busy to serve them promptly. Connections that have
+ * already been accepted then continue to be served within their latency
+ * objectives, rather than every connection being degraded alike.
+ *
+ * The load on the executor is measured by its queue delay. Periodically, the
+ * controller posts a function object to the executor and measures the time
+ * that elapses before it runs. This is the time that a ready handler waits
+ * behind the other work of the executor's threads, and it grows sharply once
+ * they are saturated. The measured delays are smoothed, and the executor is
+ * considered overloaded once the smoothed delay exceeds a threshold. It
+ * recovers once the delay has fallen to half the threshold. Sampling takes
+ * place only while an accept operation is outstanding, so that an idle
+ * controller does not keep its execution context running.
+ *
+ * While the executor is overloaded, the controller performs one of the
+ * following actions:
+ *
+ * @li @c pause_accepting: Accept operations do not accept further connections
+ * until the executor recovers. New connections wait in the acceptor's listen
+ * backlog, and are refused by the operating system once it is full.
+ *
+ * @li @c reset_connections: Accept operations continue to accept connections,
+ * but close each of them immediately with a TCP reset, so that clients fail
+ * fast and may retry elsewhere.
+ *
+ * The controller must use the same executor as the acceptors on which it
+ * accepts connections. On destruction, the controller completes any accept
+ * operations that are paused with asio::error::operation_aborted.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe. The controller must be used only from within
+ * its executor. When the executor's context is run on several threads, use a
+ * strand.
+ *
+ * @par Example
+ * @code
+ * asio::admission_controller admission(my_context.get_executor());
+ * admission.set_threshold(std::chrono::milliseconds(5));
+ * ...
+ * void do_accept()
+ * {
+ *   admission.async_accept(acceptor,
+ *       [](asio::error_code ec, asio::ip::tcp::socket s)
+ *       {
+ *         if (!ec)
+ *           start_session(std::move(s));
+ *         do_accept();
+ *       });
+ * }
+ * @endcode
+ */
+template <typename Executor = any_io_executor>
+class basic_admission_controller
+  : private noncopyable
+{
+private:
+  template <typename Protocol, typename AcceptorExecutor>
+  class initiate_async_accept;
+  struct state;
+
+public:
+  /// The type of the executor associated with the object.
+  typedef Executor executor_type;
+
+  /// The duration type used for queue delays.
+  typedef chrono::steady_clock::duration duration;
+
+  /// The actions that may be taken while the executor is overloaded.
+  enum overload_action
+  {
+    /// Stop accepting connections until the executor recovers.
+    pause_accepting,
+
+    /// Accept connections, and close them immediately with a TCP reset.
+    reset_connections
+  };
+
+  /// Construct a controller for an executor.
+  explicit basic_admission_controller(const executor_type& ex)
+    : state_(std::make_shared<state>(ex))
+  {
+  }
+
+  /// Construct a controller for an execution context's executor.
+  template <typename ExecutionContext>
+  explicit basic_admission_controller(ExecutionContext& context,
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      > = 0)
+    : state_(std::make_shared<state>(context.get_executor()))
+  {
+  }
+
+  /// Destructor.
+  /**
+   * Completes any paused accept operations with
+   * asio::error::operation_aborted.
+   */
+  ~basic_admission_controller()
+  {
+    state_->shutdown();
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() const noexcept
+  {
+    return state_->executor_;
+  }
+
+  /// Get the queue delay above which the executor is considered overloaded.
+  duration threshold() const noexcept
+  {
+    return state_->threshold_;
+  }
+
+  /// Set the queue delay above which the executor is considered overloaded.
+  /**
+   * The new threshold applies from the next sample. The default is 10
+   * milliseconds.
+   */
+  void set_threshold(const duration& threshold) noexcept
+  {
+    state_->threshold_ = threshold;
+  }
+
+  /// Get the interval between samples of the queue delay.
+  duration sample_interval() const noexcept
+  {
+    return state_->sample_interval_;
+  }
+
+  /// Set the interval between samples of the queue delay.
+  /**
+   * The new interval applies from the next sample. The default is 10
+   * milliseconds.
+   */
+  void set_sample_interval(const duration& interval) noexcept
+  {
+    state_->sample_interval_ = interval;
+  }
+
+  /// Get the action taken while the executor is overloaded.
+  overload_action action() const noexcept
+  {
+    return state_->action_;
+  }
+
+  /// Set the action taken while the executor is overloaded.
+  /**
+   * The default is @c pause_accepting. Accept operations that are already
+   * paused remain paused until the executor recovers.
+   */
+  void set_action(overload_action action) noexcept
+  {
+    state_->action_ = action;
+  }
+
+  /// Get the smoothed queue delay of the executor, as most recently sampled.
+  duration queue_delay() const noexcept
+  {
+    return state_->queue_delay_;
+  }
+
+  /// Determine whether the executor is currently considered overloaded.
+  bool overloaded() const noexcept
+  {
+    return state_->overloaded_;
+  }
+
+  /// Get the number of connections that have been reset by the controller.
+  uint64_t reset_count() const noexcept
+  {
+    return state_->reset_count_;
+  }
+
+  /// Start an asynchronous operation to accept a connection.
+  /**
+   * This function is used to accept a new connection from a peer, subject to
+   * the controller's admission policy. It always returns immediately.
+   *
+   * @param a The acceptor on which the connection is accepted. The object must
+   * remain valid until the completion handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when a connection has been
+   * admitted. The function signature of the completion handler must be:
+   * @code void handler(
+   *   // Result of operation.
+   *   const asio::error_code& error,
+   *
+   *   // On success, the newly accepted socket.
+   *   typename Protocol::socket::template
+   *     rebind_executor<AcceptorExecutor>::other peer
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code,
+   *    typename Protocol::socket::template
+   *      rebind_executor<AcceptorExecutor>::other)) @endcode
+   */
+  template <typename Protocol, typename AcceptorExecutor,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        typename Protocol::socket::template rebind_executor<
+          AcceptorExecutor>::other)) AcceptToken
+            = default_completion_token_t<executor_type>>
+  auto async_accept(basic_socket_acceptor<Protocol, AcceptorExecutor>& a,
+      AcceptToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      asio::async_initiate<AcceptToken,
+        void (asio::error_code, typename Protocol::socket::template
+          rebind_executor<AcceptorExecutor>::other)>(
+            declval<initiate_async_accept<Protocol, AcceptorExecutor>>(),
+            token, &a))
+  {
+    return asio::async_initiate<AcceptToken,
+      void (asio::error_code, typename Protocol::socket::template
+        rebind_executor<AcceptorExecutor>::other)>(
+          initiate_async_accept<Protocol, AcceptorExecutor>(state_.get()),
+          token, &a);
+  }
+
+private:
+  // The type of a paused accept operation, which is resumed with an error
+  // code.
+  typedef any_completion_handler<void(asio::error_code)> waiter_type;
+
+  // The timer type used to schedule samples.
+  typedef basic_waitable_timer<chrono::steady_clock,
+      wait_traits<chrono::steady_clock>, executor_type> timer_type;
+
+  // Completes an accept operation, and keeps the handler's executor busy
+  // while it is outstanding.
+  template <typename Handler, typename Socket>
+  class accept_handler
+  {
+  public:
+    accept_handler(Handler&& handler, const executor_type& ex)
+      : work_(asio::make_work_guard(handler, ex)),
+        handler_(static_cast<Handler&&>(handler))
+    {
+    }
+
+    void operator()(asio::error_code ec, Socket peer)
+    {
+      typename associated_executor<Handler, executor_type>::type ex(
+          work_.get_executor());
+      asio::dispatch(ex, asio::append(static_cast<Handler&&>(handler_),
+            ec, static_cast<Socket&&>(peer)));
+      work_.reset();
+    }
+
+  private:
+    executor_work_guard<
+      typename associated_executor<Handler, executor_type>::type> work_;
+    Handler handler_;
+  };
+
+  // Accepts connections until one is admitted.
+  template <typename Acceptor, typename Socket>
+  class accept_op
+  {
+  public:
+    typedef any_completion_handler<void(asio::error_code, Socket)>
+      handler_type;
+
+    accept_op(const std::shared_ptr<state>& s,
+        Acceptor* a, handler_type&& handler)
+      : state_(s),
+        acceptor_(a),
+        handler_(static_cast<handler_type&&>(handler))
+    {
+    }
+
+    void start()
+    {
+      if (state_->shut_down_)
+        asio::post(state_->executor_, asio::append(
+              static_cast<accept_op&&>(*this), asio::error::operation_aborted));
+      else if (state_->overloaded_ && state_->action_ == pause_accepting)
+        state_->waiters_.push_back(
+            waiter_type(static_cast<accept_op&&>(*this)));
+      else
+        acceptor_->async_accept(static_cast<accept_op&&>(*this));
+    }
+
+    // Resumes a paused operation.
+    void operator()(asio::error_code ec)
+    {
+      if (ec)
+        complete(ec);
+      else
+        start();
+    }
+
+    void operator()(asio::error_code ec, Socket peer)
+    {
+      if (!ec && state_->overloaded_ && state_->action_ == reset_connections)
+      {
+        // Closing the socket with a zero linger time sends a reset.
+        asio::error_code ignored_ec;
+        peer.set_option(socket_base::linger(true, 0), ignored_ec);
+        peer.close(ignored_ec);
+        ++state_->reset_count_;
+        start();
+        return;
+      }
+
+      --state_->outstanding_;
+      static_cast<handler_type&&>(handler_)(ec, static_cast<Socket&&>(peer));
+    }
+
+  private:
+    void complete(const asio::error_code& ec)
+    {
+      --state_->outstanding_;
+      static_cast<handler_type&&>(handler_)(ec,
+          Socket(acceptor_->get_executor()));
+    }
+
+    std::shared_ptr<state> state_;
+    Acceptor* acceptor_;
+    handler_type handler_;
+  };
+
+  // Handles the expiry of the timer that schedules the next sample.
+  class sample_handler
+  {
+  public:
+    explicit sample_handler(const std::shared_ptr<state>& s)
+      : state_(s)
+    {
+    }
+
+    void operator()(const asio::error_code& ec)
+    {
+      state_->start_sample(ec);
+    }
+
+  private:
+    std::shared_ptr<state> state_;
+  };
+
+  // Measures the time taken for a posted function object to run.
+  class probe_handler
+  {
+  public:
+    explicit probe_handler(const std::shared_ptr<state>& s)
+      : state_(s),
+        posted_(chrono::steady_clock::now())
+    {
+    }
+
+    void operator()()
+    {
+      state_->complete_sample(chrono::steady_clock::now() - posted_);
+    }
+
+  private:
+    std::shared_ptr<state> state_;
+    chrono::steady_clock::time_point posted_;
+  };
+
+  // The state of the controller, which is shared with its outstanding
+  // operations so that they may outlive the controller object.
+  struct state
+    : std::enable_shared_from_this<state>
+  {
+    explicit state(const executor_type& ex)
+      : executor_(ex),
+        timer_(ex),
+        threshold_(chrono::milliseconds(10)),
+        sample_interval_(chrono::milliseconds(10)),
+        action_(pause_accepting),
+        queue_delay_(duration::zero()),
+        overloaded_(false),
+        reset_count_(0),
+        outstanding_(0),
+        sampling_(false),
+        shut_down_(false)
+    {
+    }
+
+    // Start sampling, if it is not already running.
+    void start_sampling()
+    {
+      if (!sampling_ && !shut_down_)
+      {
+        sampling_ = true;
+        timer_.expires_after(sample_interval_);
+        timer_.async_wait(sample_handler(this->shared_from_this()));
+      }
+    }
+
+    void start_sample(const asio::error_code& ec)
+    {
+      if (ec || shut_down_)
+        sampling_ = false;
+      else
+        asio::post(executor_, probe_handler(this->shared_from_this()));
+    }
+
+    void complete_sample(duration delay)
+    {
+      // Samples are smoothed so that a single slow handler does not pause
+      // accepting.
+      queue_delay_ = (queue_delay_ * 3 + delay) / 4;
+      if (!overloaded_)
+        overloaded_ = queue_delay_ > threshold_;
+      else if (queue_delay_ <= threshold_ / 2)
+        recover();
+
+      sampling_ = false;
+      if (outstanding_ > 0)
+        start_sampling();
+    }
+
+    // Resume the paused accept operations.
+    void recover()
+    {
+      overloaded_ = false;
+      std::deque<waiter_type> waiters;
+      waiters.swap(waiters_);
+      for (std::size_t i = 0; i < waiters.size(); ++i)
+        asio::post(executor_, asio::append(
+              static_cast<waiter_type&&>(waiters[i]), asio::error_code()));
+    }
+
+    void shutdown()
+    {
+      shut_down_ = true;
+      timer_.cancel();
+      std::deque<waiter_type> waiters;
+      waiters.swap(waiters_);
+      for (std::size_t i = 0; i < waiters.size(); ++i)
+        asio::post(executor_, asio::append(
+              static_cast<waiter_type&&>(waiters[i]),
+              asio::error::operation_aborted));
+    }
+
+    executor_type executor_;
+    timer_type timer_;
+    duration threshold_;
+    duration sample_interval_;
+    overload_action action_;
+    duration queue_delay_;
+    bool overloaded_;
+    uint64_t reset_count_;
+    std::size_t outstanding_;
+    bool sampling_;
+    bool shut_down_;
+    std::deque<waiter_type> waiters_;
+  };
+
+  template <typename Protocol, typename AcceptorExecutor>
+  class initiate_async_accept
+  {
+  public:
+    typedef typename basic_admission_controller::executor_type executor_type;
+
+    explicit initiate_async_accept(state* s)
+      : state_(s)
+    {
+    }
+
+    executor_type get_executor() const noexcept
+    {
+      return state_->executor_;
+    }
+
+    template <typename AcceptHandler>
+    void operator()(AcceptHandler&& handler,
+        basic_socket_acceptor<Protocol, AcceptorExecutor>* a) const
+    {
+      typedef typename Protocol::socket::template
+        rebind_executor<AcceptorExecutor>::other socket_type;
+      typedef accept_op<basic_socket_acceptor<Protocol, AcceptorExecutor>,
+        socket_type> op_type;
+
+      ++state_->outstanding_;
+      state_->start_sampling();
+      op_type(state_->shared_from_this(), a, typename op_type::handler_type(
+            accept_handler<decay_t<AcceptHandler>, socket_type>(
+              static_cast<AcceptHandler&&>(handler),
+              state_->executor_))).start();
+    }
+
+  private:
+    state* state_;
+  };
+
+  std::shared_ptr<state> state_;
+};
+
+/// Typedef for the typical usage of basic_admission_controller.
+typedef basic_admission_controller<> admission_controller;
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_ADMISSION_CONTROLLER_HPP
@@ -0,0 +1,222 @@
+//
+// aligned_buffer.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_ALIGNED_BUFFER_HPP
+#define ASIO_ALIGNED_BUFFER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include "asio/buffer.hpp"
+#include "asio/error.hpp"
+#include "asio/detail/throw_error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A block of memory with a specified alignment.
+/**
+ * An aligned buffer owns a block of memory whose address is a multiple of
+ * the requested alignment. It is intended for use with files opened using
+ * file_base::direct, where the operating system requires that the memory,
+ * offset and length of each transfer be aligned to the device's logical
+ * block size.
+ *
+ * The contents of a newly constructed buffer are zero-initialised. Moving a
+ * buffer transfers ownership of the memory, so that buffers obtained from it
+ * remain valid.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code
+ * asio::aligned_buffer block(4096);
+ * file.async_read_some_at(0, asio::buffer(block), handler);
+ * @endcode
+ */
+class aligned_buffer
+{
+public:
+  /// The default alignment, which is suitable for most block devices.
+  static constexpr std::size_t default_alignment = 4096;
+
+  /// Construct an empty buffer.
+  aligned_buffer() noexcept
+    : storage_(0),
+      data_(0),
+      size_(0),
+      alignment_(default_alignment)
+  {
+  }
+
+  /// Construct a buffer of the specified size.
+  /**
+   * @param size The size of the buffer, in bytes.
+   *
+   * @param alignment The alignment of the buffer's memory. Must be a power of
+   * two.
+   *
+   * @throws asio::system_error Thrown with @c error::invalid_argument if the
+   * alignment is not a power of two.
+   *
+   * @throws std::bad_alloc Thrown if the memory cannot be allocated.
+   */
+  explicit aligned_buffer(std::size_t size,
+      std::size_t alignment = default_alignment)
+    : storage_(0),
+      data_(0),
+      size_(size),
+      alignment_(alignment)
+  {
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0
+        || size > static_cast<std::size_t>(-1) - alignment)
+    {
+      asio::error_code ec(asio::error::invalid_argument);
+      asio::detail::throw_error(ec, "aligned_buffer");
+    }
+
+    if (size > 0)
+    {
+      storage_ = static_cast<char*>(::operator new(size + alignment - 1));
+      std::size_t misalignment =
+        reinterpret_cast<std::size_t>(storage_) & (alignment - 1);
+      data_ = storage_ + (misalignment ? alignment - misalignment : 0);
+      std::memset(data_, 0, size);
+    }
+  }
+
+  /// Move-construct a buffer from another.
+  aligned_buffer(aligned_buffer&& other) noexcept
+    : storage_(other.storage_),
+      data_(other.data_),
+      size_(other.size_),
+      alignment_(other.alignment_)
+  {
+    other.storage_ = 0;
+    other.data_ = 0;
+    other.size_ = 0;
+  }
+
+  /// Move-assign a buffer from another.
+  aligned_buffer& operator=(aligned_buffer&& other) noexcept
+  {
+    if (this != &other)
+    {
+      ::operator delete(storage_);
+      storage_ = other.storage_;
+      data_ = other.data_;
+      size_ = other.size_;
+      alignment_ = other.alignment_;
+      other.storage_ = 0;
+      other.data_ = 0;
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  /// Destroy the buffer, freeing its memory.
+  ~aligned_buffer()
+  {
+    ::operator delete(storage_);
+  }
+
+  /// Get a pointer to the beginning of the memory.
+  void* data() noexcept
+  {
+    return data_;
+  }
+
+  /// Get a pointer to the beginning of the memory.
+  const void* data() const noexcept
+  {
+    return data_;
+  }
+
+  /// Get the size of the buffer.
+  std::size_t size() const noexcept
+  {
+    return size_;
+  }
+
+  /// Get the alignment of the buffer's memory.
+  std::size_t alignment() const noexcept
+  {
+    return alignment_;
+  }
+
+private:
+  aligned_buffer(const aligned_buffer&) = delete;
+  aligned_buffer& operator=(const aligned_buffer&) = delete;
+
+  char* storage_;
+  char* data_;
+  std::size_t size_;
+  std::size_t alignment_;
+};
+
+/// Create a new modifiable buffer that represents an aligned buffer.
+/**
+ * @returns <tt>mutable_buffer(b.data(), b.size())</tt>.
+ */
+ASIO_NODISCARD inline mutable_buffer buffer(aligned_buffer& b) noexcept
+{
+  return mutable_buffer(b.data(), b.size());
+}
+
+/// Create a new modifiable buffer that represents an aligned buffer.
+/**
+ * @returns A mutable_buffer value equivalent to:
+ * @code mutable_buffer(
+ *     b.data(),
+ *     min(b.size(), max_size_in_bytes)); @endcode
+ */
+ASIO_NODISCARD inline mutable_buffer buffer(aligned_buffer& b,
+    std::size_t max_size_in_bytes) noexcept
+{
+  return mutable_buffer(b.data(),
+      b.size() < max_size_in_bytes ? b.size() : max_size_in_bytes);
+}
+
+/// Create a new non-modifiable buffer that represents an aligned buffer.
+/**
+ * @returns <tt>const_buffer(b.data(), b.size())</tt>.
+ */
+ASIO_NODISCARD inline const_buffer buffer(const aligned_buffer& b) noexcept
+{
+  return const_buffer(b.data(), b.size());
+}
+
+/// Create a new non-modifiable buffer that represents an aligned buffer.
+/**
+ * @returns A const_buffer value equivalent to:
+ * @code const_buffer(
+ *     b.data(),
+ *     min(b.size(), max_size_in_bytes)); @endcode
+ */
+ASIO_NODISCARD inline const_buffer buffer(const aligned_buffer& b,
+    std::size_t max_size_in_bytes) noexcept
+{
+  return const_buffer(b.data(),
+      b.size() < max_size_in_bytes ? b.size() : max_size_in_bytes);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_ALIGNED_BUFFER_HPP
@@ -48,6 +48,49 @@ private:
   cancellation_state cancel_state_;
 };
 
+template <typename Allocator>
+void* any_completion_handler_allocate(const Allocator& a,
+    std::size_t size, std::size_t align)
+{
+  typename std::allocator_traits<Allocator>::template
+    rebind_alloc<unsigned char> alloc(a);
+
+  std::size_t space = size + align - 1;
+  unsigned char* base =
+    std::allocator_traits<decltype(alloc)>::allocate(
+      alloc, space + sizeof(std::ptrdiff_t));
+
+  void* p = base;
+  if (detail::align(align, size, p, space))
+  {
+    std::ptrdiff_t off = static_cast<unsigned char*>(p) - base;
+    std::memcpy(static_cast<unsigned char*>(p) + size, &off, sizeof(off));
+    return p;
+  }
+
+  std::bad_alloc ex;
+  asio::detail::throw_exception(ex);
+  return nullptr;
+}
+
+template <typename Allocator>
+void any_completion_handler_deallocate(const Allocator& a,
+    void* p, std::size_t size, std::size_t align)
+{
+  if (p)
+  {
+    typename std::allocator_traits<Allocator>::template
+      rebind_alloc<unsigned char> alloc(a);
+
+    std::ptrdiff_t off;
+    std::memcpy(&off, static_cast<unsigned char*>(p) + size, sizeof(off));
+    unsigned char* base = static_cast<unsigned char*>(p) - off;
+
+    std::allocator_traits<decltype(alloc)>::deallocate(
+        alloc, base, size + align -1 + sizeof(std::ptrdiff_t));
+  }
+}
+
 template <typename Handler>
 class any_completion_handler_impl :
   public any_completion_handler_impl_base
@@ -130,49 +173,16 @@ public:
 
   void* allocate(std::size_t size, std::size_t align) const
   {
-    typename std::allocator_traits<
-      associated_allocator_t<Handler,
-        asio::recycling_allocator<void>>>::template
-          rebind_alloc<unsigned char> alloc(
-            (get_associated_allocator)(handler_,
-              asio::recycling_allocator<void>()));
-
-    std::size_t space = size + align - 1;
-    unsigned char* base =
-      std::allocator_traits<decltype(alloc)>::allocate(
-        alloc, space + sizeof(std::ptrdiff_t));
-
-    void* p = base;
-    if (detail::align(align, size, p, space))
-    {
-      std::ptrdiff_t off = static_cast<unsigned char*>(p) - base;
-      std::memcpy(static_cast<unsigned char*>(p) + size, &off, sizeof(off));
-      return p;
-    }
-
-    std::bad_alloc ex;
-    asio::detail::throw_exception(ex);
-    return nullptr;
+    return detail::any_completion_handler_allocate(
+        (get_associated_allocator)(handler_,
+          asio::recycling_allocator<void>()), size, align);
   }
 
   void deallocate(void* p, std::size_t size, std::size_t align) const
   {
-    if (p)
-    {
-      typename std::allocator_traits<
-        associated_allocator_t<Handler,
-          asio::recycling_allocator<void>>>::template
-            rebind_alloc<unsigned char> alloc(
-              (get_associated_allocator)(handler_,
-                asio::recycling_allocator<void>()));
-
-      std::ptrdiff_t off;
-      std::memcpy(&off, static_cast<unsigned char*>(p) + size, sizeof(off));
-      unsigned char* base = static_cast<unsigned char*>(p) - off;
-
-      std::allocator_traits<decltype(alloc)>::deallocate(
-          alloc, base, size + align -1 + sizeof(std::ptrdiff_t));
-    }
+    detail::any_completion_handler_deallocate(
+        (get_associated_allocator)(handler_,
+          asio::recycling_allocator<void>()), p, size, align);
   }
 
   template <typename... Args>
@@ -194,6 +204,128 @@ private:
   Handler handler_;
 };
 
+// A handler that is stored within the storage of an any_completion_handler
+// object, rather than in allocated memory. Only handlers that use the default
+// allocator are stored this way, as the allocator associated with the
+// any_completion_handler may outlive the move of the handler itself.
+template <typename Handler>
+class any_completion_handler_inline_impl :
+  public any_completion_handler_impl_base
+{
+public:
+  template <typename S, typename H>
+  any_completion_handler_inline_impl(S&& slot, H&& h)
+    : any_completion_handler_impl_base(static_cast<S&&>(slot)),
+      handler_(static_cast<H&&>(h))
+  {
+  }
+
+  template <typename S, typename H>
+  static any_completion_handler_inline_impl* create(
+      void* storage, S&& slot, H&& h)
+  {
+    return new (storage) any_completion_handler_inline_impl(
+        static_cast<S&&>(slot), static_cast<H&&>(h));
+  }
+
+  void destroy()
+  {
+    this->~any_completion_handler_inline_impl();
+  }
+
+  any_completion_handler_impl_base* relocate(void* storage) noexcept
+  {
+    any_completion_handler_inline_impl* ptr =
+      new (storage) any_completion_handler_inline_impl(
+        static_cast<any_completion_handler_inline_impl&&>(*this));
+    destroy();
+    return ptr;
+  }
+
+  any_completion_executor executor(
+      const any_completion_executor& candidate) const noexcept
+  {
+    return any_completion_executor(std::nothrow,
+        (get_associated_executor)(handler_, candidate));
+  }
+
+  any_completion_executor immediate_executor(
+      const any_io_executor& candidate) const noexcept
+  {
+    return any_completion_executor(std::nothrow,
+        (get_associated_immediate_executor)(handler_, candidate));
+  }
+
+  template <typename... Args>
+  void call(Args&&... args)
+  {
+    Handler handler(static_cast<Handler&&>(handler_));
+    destroy();
+
+    static_cast<Handler&&>(handler)(
+        static_cast<Args&&>(args)...);
+  }
+
+private:
+  Handler handler_;
+};
+
+// Determine whether a handler may be stored inline in the specified number of
+// bytes.
+template <typename Handler, std::size_t InlineSize>
+struct any_completion_handler_is_inline :
+  integral_constant<bool,
+    sizeof(any_completion_handler_inline_impl<Handler>) <= InlineSize
+      && alignof(any_completion_handler_inline_impl<Handler>)
+        <= ASIO_DEFAULT_ALIGN
+      && is_nothrow_move_constructible<Handler>::value
+      && is_same<
+          associated_allocator_t<Handler, asio::recycling_allocator<void>>,
+          asio::recycling_allocator<void>
+        >::value
+  >
+{
+};
+
+template <typename Handler>
+struct any_completion_handler_is_inline<Handler, 0> : false_type
+{
+};
+
+// The inline storage for an any_completion_handler object.
+template <std::size_t InlineSize>
+class any_completion_handler_storage
+{
+public:
+  void* storage() noexcept
+  {
+    return &storage_;
+  }
+
+  const void* storage() const noexcept
+  {
+    return &storage_;
+  }
+
+private:
+  aligned_storage_t<InlineSize, ASIO_DEFAULT_ALIGN> storage_;
+};
+
+template <>
+class any_completion_handler_storage<0>
+{
+public:
+  void* storage() noexcept
+  {
+    return nullptr;
+  }
+
+  const void* storage() const noexcept
+  {
+    return nullptr;
+  }
+};
+
 template <typename Signature>
 class any_completion_handler_call_fn;
 
@@ -213,11 +345,10 @@ public:
     call_fn_(impl, static_cast<Args&&>(args)...);
   }
 
-  template <typename Handler>
+  template <typename Impl>
   static void impl(any_completion_handler_impl_base* impl, Args... args)
   {
-    static_cast<any_completion_handler_impl<Handler>*>(impl)->call(
-        static_cast<Args&&>(args)...);
+    static_cast<Impl*>(impl)->call(static_cast<Args&&>(args)...);
   }
 
 private:
@@ -269,16 +400,49 @@ public:
     destroy_fn_(impl);
   }
 
-  template <typename Handler>
+  template <typename Impl>
   static void impl(any_completion_handler_impl_base* impl)
   {
-    static_cast<any_completion_handler_impl<Handler>*>(impl)->destroy();
+    static_cast<Impl*>(impl)->destroy();
   }
 
 private:
   type destroy_fn_;
 };
 
+class any_completion_handler_relocate_fn
+{
+public:
+  using type = any_completion_handler_impl_base*(*)(
+      any_completion_handler_impl_base*, void*);
+
+  constexpr any_completion_handler_relocate_fn(type fn)
+    : relocate_fn_(fn)
+  {
+  }
+
+  bool relocatable() const noexcept
+  {
+    return relocate_fn_ != nullptr;
+  }
+
+  any_completion_handler_impl_base* relocate(
+      any_completion_handler_impl_base* impl, void* storage) const noexcept
+  {
+    return relocate_fn_(impl, storage);
+  }
+
+  template <typename Impl>
+  static any_completion_handler_impl_base* impl(
+      any_completion_handler_impl_base* impl, void* storage)
+  {
+    return static_cast<Impl*>(impl)->relocate(storage);
+  }
+
+private:
+  type relocate_fn_;
+};
+
 class any_completion_handler_executor_fn
 {
 public:
@@ -296,12 +460,11 @@ public:
     return executor_fn_(impl, candidate);
   }
 
-  template <typename Handler>
+  template <typename Impl>
   static any_completion_executor impl(any_completion_handler_impl_base* impl,
       const any_completion_executor& candidate)
   {
-    return static_cast<any_completion_handler_impl<Handler>*>(impl)->executor(
-        candidate);
+    return static_cast<Impl*>(impl)->executor(candidate);
   }
 
 private:
@@ -326,12 +489,11 @@ public:
     return immediate_executor_fn_(impl, candidate);
   }
 
-  template <typename Handler>
+  template <typename Impl>
   static any_completion_executor impl(any_completion_handler_impl_base* impl,
       const any_io_executor& candidate)
   {
-    return static_cast<any_completion_handler_impl<Handler>*>(
-        impl)->immediate_executor(candidate);
+    return static_cast<Impl*>(impl)->immediate_executor(candidate);
   }
 
 private:
@@ -355,12 +517,21 @@ public:
     return allocate_fn_(impl, size, align);
   }
 
-  template <typename Handler>
+  template <typename Impl>
   static void* impl(any_completion_handler_impl_base* impl,
       std::size_t size, std::size_t align)
   {
-    return static_cast<any_completion_handler_impl<Handler>*>(impl)->allocate(
-        size, align);
+    return static_cast<Impl*>(impl)->allocate(size, align);
+  }
+
+  // Used for handlers that are stored inline, which always have the default
+  // allocator. The implementation object is not accessed, as the allocator
+  // may be used after the handler has been moved.
+  static void* default_impl(any_completion_handler_impl_base*,
+      std::size_t size, std::size_t align)
+  {
+    return detail::any_completion_handler_allocate(
+        asio::recycling_allocator<void>(), size, align);
   }
 
 private:
@@ -384,12 +555,19 @@ public:
     deallocate_fn_(impl, p, size, align);
   }
 
-  template <typename Handler>
+  template <typename Impl>
   static void impl(any_completion_handler_impl_base* impl,
       void* p, std::size_t size, std::size_t align)
   {
-    static_cast<any_completion_handler_impl<Handler>*>(impl)->deallocate(
-        p, size, align);
+    static_cast<Impl*>(impl)->deallocate(p, size, align);
+  }
+
+  // Used for handlers that are stored inline.
+  static void default_impl(any_completion_handler_impl_base*,
+      void* p, std::size_t size, std::size_t align)
+  {
+    detail::any_completion_handler_deallocate(
+        asio::recycling_allocator<void>(), p, size, align);
   }
 
 private:
@@ -399,6 +577,7 @@ private:
 template <typename... Signatures>
 class any_completion_handler_fn_table
   : private any_completion_handler_destroy_fn,
+    private any_completion_handler_relocate_fn,
     private any_completion_handler_executor_fn,
     private any_completion_handler_immediate_executor_fn,
     private any_completion_handler_allocate_fn,
@@ -409,12 +588,14 @@ public:
   template <typename... CallFns>
   constexpr any_completion_handler_fn_table(
       any_completion_handler_destroy_fn::type destroy_fn,
+      any_completion_handler_relocate_fn::type relocate_fn,
       any_completion_handler_executor_fn::type executor_fn,
       any_completion_handler_immediate_executor_fn::type immediate_executor_fn,
       any_completion_handler_allocate_fn::type allocate_fn,
       any_completion_handler_deallocate_fn::type deallocate_fn,
       CallFns... call_fns)
     : any_completion_handler_destroy_fn(destroy_fn),
+      any_completion_handler_relocate_fn(relocate_fn),
       any_completion_handler_executor_fn(executor_fn),
       any_completion_handler_immediate_executor_fn(immediate_executor_fn),
       any_completion_handler_allocate_fn(allocate_fn),
@@ -424,6 +605,8 @@ public:
   }
 
   using any_completion_handler_destroy_fn::destroy;
+  using any_completion_handler_relocate_fn::relocatable;
+  using any_completion_handler_relocate_fn::relocate;
   using any_completion_handler_executor_fn::executor;
   using any_completion_handler_immediate_executor_fn::immediate_executor;
   using any_completion_handler_allocate_fn::allocate;
@@ -434,22 +617,50 @@ public:
 template <typename Handler, typename... Signatures>
 struct any_completion_handler_fn_table_instance
 {
+  typedef any_completion_handler_impl<Handler> impl_type;
+
   static constexpr any_completion_handler_fn_table<Signatures...>
     value = any_completion_handler_fn_table<Signatures...>(
-        &any_completion_handler_destroy_fn::impl<Handler>,
-        &any_completion_handler_executor_fn::impl<Handler>,
-        &any_completion_handler_immediate_executor_fn::impl<Handler>,
-        &any_completion_handler_allocate_fn::impl<Handler>,
-        &any_completion_handler_deallocate_fn::impl<Handler>,
-        &any_completion_handler_call_fn<Signatures>::template impl<Handler>...);
+        &any_completion_handler_destroy_fn::impl<impl_type>,
+        nullptr,
+        &any_completion_handler_executor_fn::impl<impl_type>,
+        &any_completion_handler_immediate_executor_fn::impl<impl_type>,
+        &any_completion_handler_allocate_fn::impl<impl_type>,
+        &any_completion_handler_deallocate_fn::impl<impl_type>,
+        &any_completion_handler_call_fn<
+          Signatures>::template impl<impl_type>...);
 };
 
 template <typename Handler, typename... Signatures>
 constexpr any_completion_handler_fn_table<Signatures...>
 any_completion_handler_fn_table_instance<Handler, Signatures...>::value;
 
+template <typename Handler, typename... Signatures>
+struct any_completion_handler_inline_fn_table_instance
+{
+  typedef any_completion_handler_inline_impl<Handler> impl_type;
+
+  static constexpr any_completion_handler_fn_table<Signatures...>
+    value = any_completion_handler_fn_table<Signatures...>(
+        &any_completion_handler_destroy_fn::impl<impl_type>,
+        &any_completion_handler_relocate_fn::impl<impl_type>,
+        &any_completion_handler_executor_fn::impl<impl_type>,
+        &any_completion_handler_immediate_executor_fn::impl<impl_type>,
+        &any_completion_handler_allocate_fn::default_impl,
+        &any_completion_handler_deallocate_fn::default_impl,
+        &any_completion_handler_call_fn<
+          Signatures>::template impl<impl_type>...);
+};
+
+template <typename Handler, typename... Signatures>
+constexpr any_completion_handler_fn_table<Signatures...>
+any_completion_handler_inline_fn_table_instance<Handler, Signatures...>::value;
+
 } // namespace detail
 
+template <std::size_t InlineSize, typename... Signatures>
+class basic_any_completion_handler;
+
 template <typename... Signatures>
 class any_completion_handler;
 
@@ -459,8 +670,8 @@ template <typename T, typename... Signatures>
 class any_completion_handler_allocator
 {
 private:
-  template <typename...>
-  friend class any_completion_handler;
+  template <std::size_t, typename...>
+  friend class basic_any_completion_handler;
 
   template <typename, typename...>
   friend class any_completion_handler_allocator;
@@ -468,8 +679,10 @@ private:
   const detail::any_completion_handler_fn_table<Signatures...>* fn_table_;
   detail::any_completion_handler_impl_base* impl_;
 
+  template <std::size_t InlineSize>
   constexpr any_completion_handler_allocator(int,
-      const any_completion_handler<Signatures...>& h) noexcept
+      const basic_any_completion_handler<InlineSize, Signatures...>& h)
+    noexcept
     : fn_table_(h.fn_table_),
       impl_(h.impl_)
   {
@@ -539,8 +752,8 @@ template <typename... Signatures>
 class any_completion_handler_allocator<void, Signatures...>
 {
 private:
-  template <typename...>
-  friend class any_completion_handler;
+  template <std::size_t, typename...>
+  friend class basic_any_completion_handler;
 
   template <typename, typename...>
   friend class any_completion_handler_allocator;
@@ -548,8 +761,10 @@ private:
   const detail::any_completion_handler_fn_table<Signatures...>* fn_table_;
   detail::any_completion_handler_impl_base* impl_;
 
+  template <std::size_t InlineSize>
   constexpr any_completion_handler_allocator(int,
-      const any_completion_handler<Signatures...>& h) noexcept
+      const basic_any_completion_handler<InlineSize, Signatures...>& h)
+    noexcept
     : fn_table_(h.fn_table_),
       impl_(h.impl_)
   {
@@ -592,25 +807,37 @@ public:
   }
 };
 
-/// Polymorphic wrapper for completion handlers.
+/// Polymorphic wrapper for completion handlers, with storage for small
+/// targets.
 /**
- * The @c any_completion_handler class template is a polymorphic wrapper for
- * completion handlers that propagates the associated executor, associated
+ * The @c basic_any_completion_handler class template is a polymorphic wrapper
+ * for completion handlers that propagates the associated executor, associated
  * allocator, and associated cancellation slot through a type-erasing interface.
  *
- * When using @c any_completion_handler, specify one or more completion
- * signatures as template parameters. These will dictate the arguments that may
- * be passed to the handler through the polymorphic interface.
+ * The @c InlineSize template parameter specifies the number of bytes reserved
+ * within the wrapper object. A target is stored in this space, rather than in
+ * memory obtained from its associated allocator, if it fits and if:
  *
- * Typical uses for @c any_completion_handler include:
+ * @li it has a non-throwing move constructor; and
  *
- * @li Separate compilation of asynchronous operation implementations.
+ * @li it has no associated allocator.
  *
- * @li Enabling interoperability between asynchronous operations and virtual
- *     functions.
+ * Other targets are stored in allocated memory, as for
+ * @c any_completion_handler. Moving the wrapper moves a target that is stored
+ * inline.
+ *
+ * @par Example
+ * A type-erased asynchronous operation whose handlers are commonly composed
+ * of a coroutine handle and an executor:
+ * @code void async_lookup(std::string name,
+ *     asio::basic_any_completion_handler<64,
+ *       void(asio::error_code, record)> handler); @endcode
  */
-template <typename... Signatures>
-class any_completion_handler
+template <std::size_t InlineSize, typename... Signatures>
+class basic_any_completion_handler
+#if !defined(GENERATING_DOCUMENTATION)
+  : private detail::any_completion_handler_storage<InlineSize>
+#endif // !defined(GENERATING_DOCUMENTATION)
 {
 #if !defined(GENERATING_DOCUMENTATION)
 private:
@@ -634,69 +861,67 @@ public:
   /// The associated cancellation slot type.
   using cancellation_slot_type = cancellation_slot;
 
-  /// Construct an @c any_completion_handler in an empty state, without a target
-  /// object.
-  constexpr any_completion_handler()
+  /// Construct a @c basic_any_completion_handler in an empty state, without a
+  /// target object.
+  constexpr basic_any_completion_handler()
     : fn_table_(nullptr),
       impl_(nullptr)
   {
   }
 
-  /// Construct an @c any_completion_handler in an empty state, without a target
-  /// object.
-  constexpr any_completion_handler(nullptr_t)
+  /// Construct a @c basic_any_completion_handler in an empty state, without a
+  /// target object.
+  constexpr basic_any_completion_handler(nullptr_t)
     : fn_table_(nullptr),
       impl_(nullptr)
   {
   }
 
-  /// Construct an @c any_completion_handler to contain the specified target.
+  /// Construct a @c basic_any_completion_handler to contain the specified
+  /// target.
   template <typename H, typename Handler = decay_t<H>>
-  any_completion_handler(H&& h,
+  basic_any_completion_handler(H&& h,
       constraint_t<
-        !is_same<decay_t<H>, any_completion_handler>::value
+        !is_base_of<basic_any_completion_handler, decay_t<H>>::value
       > = 0)
-    : fn_table_(
-        &detail::any_completion_handler_fn_table_instance<
-          Handler, Signatures...>::value),
-      impl_(detail::any_completion_handler_impl<Handler>::create(
-            (get_associated_cancellation_slot)(h), static_cast<H&&>(h)))
+    : fn_table_(nullptr),
+      impl_(nullptr)
   {
+    this->create<Handler>(static_cast<H&&>(h),
+        detail::any_completion_handler_is_inline<Handler, InlineSize>());
   }
 
-  /// Move-construct an @c any_completion_handler from another.
+  /// Move-construct a @c basic_any_completion_handler from another.
   /**
    * After the operation, the moved-from object @c other has no target.
    */
-  any_completion_handler(any_completion_handler&& other) noexcept
+  basic_any_completion_handler(basic_any_completion_handler&& other) noexcept
     : fn_table_(other.fn_table_),
-      impl_(other.impl_)
+      impl_(other.release(this->storage()))
   {
-    other.fn_table_ = nullptr;
-    other.impl_ = nullptr;
   }
 
-  /// Move-assign an @c any_completion_handler from another.
+  /// Move-assign a @c basic_any_completion_handler from another.
   /**
    * After the operation, the moved-from object @c other has no target.
    */
-  any_completion_handler& operator=(
-      any_completion_handler&& other) noexcept
+  basic_any_completion_handler& operator=(
+      basic_any_completion_handler&& other) noexcept
   {
-    any_completion_handler(
-        static_cast<any_completion_handler&&>(other)).swap(*this);
+    basic_any_completion_handler(
+        static_cast<basic_any_completion_handler&&>(other)).swap(*this);
     return *this;
   }
 
   /// Assignment operator that sets the polymorphic wrapper to the empty state.
-  any_completion_handler& operator=(nullptr_t) noexcept
+  basic_any_completion_handler& operator=(nullptr_t) noexcept
   {
-    any_completion_handler().swap(*this);
+    basic_any_completion_handler().swap(*this);
     return *this;
   }
 
   /// Destructor.
-  ~any_completion_handler()
+  ~basic_any_completion_handler()
   {
     if (impl_)
       fn_table_->destroy(impl_);
@@ -714,11 +939,23 @@ public:
     return impl_ == nullptr;
   }
 
-  /// Swap the content of an @c any_completion_handler with another.
-  void swap(any_completion_handler& other) noexcept
+  /// Swap the content of a @c basic_any_completion_handler with another.
+  void swap(basic_any_completion_handler& other) noexcept
   {
-    std::swap(fn_table_, other.fn_table_);
-    std::swap(impl_, other.impl_);
+    if (InlineSize > 0)
+    {
+      basic_any_completion_handler tmp(
+          static_cast<basic_any_completion_handler&&>(other));
+      other.fn_table_ = fn_table_;
+      other.impl_ = release(other.storage());
+      fn_table_ = tmp.fn_table_;
+      impl_ = tmp.release(this->storage());
+    }
+    else
+    {
+      std::swap(fn_table_, other.fn_table_);
+      std::swap(impl_, other.impl_);
+    }
   }
 
   /// Get the associated allocator.
@@ -757,39 +994,122 @@ public:
 
   /// Equality operator.
   friend constexpr bool operator==(
-      const any_completion_handler& a, nullptr_t) noexcept
+      const basic_any_completion_handler& a, nullptr_t) noexcept
   {
     return a.impl_ == nullptr;
   }
 
   /// Equality operator.
   friend constexpr bool operator==(
-      nullptr_t, const any_completion_handler& b) noexcept
+      nullptr_t, const basic_any_completion_handler& b) noexcept
   {
     return nullptr == b.impl_;
   }
 
   /// Inequality operator.
   friend constexpr bool operator!=(
-      const any_completion_handler& a, nullptr_t) noexcept
+      const basic_any_completion_handler& a, nullptr_t) noexcept
   {
     return a.impl_ != nullptr;
   }
 
   /// Inequality operator.
   friend constexpr bool operator!=(
-      nullptr_t, const any_completion_handler& b) noexcept
+      nullptr_t, const basic_any_completion_handler& b) noexcept
   {
     return nullptr != b.impl_;
   }
+
+#if !defined(GENERATING_DOCUMENTATION)
+private:
+  template <typename Handler, typename H>
+  void create(H&& h, false_type)
+  {
+    impl_ = detail::any_completion_handler_impl<Handler>::create(
+        (get_associated_cancellation_slot)(h), static_cast<H&&>(h));
+    fn_table_ = &detail::any_completion_handler_fn_table_instance<
+      Handler, Signatures...>::value;
+  }
+
+  template <typename Handler, typename H>
+  void create(H&& h, true_type)
+  {
+    impl_ = detail::any_completion_handler_inline_impl<Handler>::create(
+        this->storage(), (get_associated_cancellation_slot)(h),
+        static_cast<H&&>(h));
+    fn_table_ = &detail::any_completion_handler_inline_fn_table_instance<
+      Handler, Signatures...>::value;
+  }
+
+  // Give up ownership of the target, moving it to the specified storage if it
+  // is stored inline.
+  detail::any_completion_handler_impl_base* release(void* storage) noexcept
+  {
+    detail::any_completion_handler_impl_base* impl = impl_;
+    if (InlineSize > 0 && impl && fn_table_->relocatable())
+      impl = fn_table_->relocate(impl, storage);
+    fn_table_ = nullptr;
+    impl_ = nullptr;
+    return impl;
+  }
+#endif // !defined(GENERATING_DOCUMENTATION)
 };
 
-template <typename... Signatures, typename Candidate>
-struct associated_executor<any_completion_handler<Signatures...>, Candidate>
+/// Polymorphic wrapper for completion handlers.
+/**
+ * The @c any_completion_handler class template is a polymorphic wrapper for
+ * completion handlers that propagates the associated executor, associated
+ * allocator, and associated cancellation slot through a type-erasing interface.
+ *
+ * When using @c any_completion_handler, specify one or more completion
+ * signatures as template parameters. These will dictate the arguments that may
+ * be passed to the handler through the polymorphic interface.
+ *
+ * Typical uses for @c any_completion_handler include:
+ *
+ * @li Separate compilation of asynchronous operation implementations.
+ *
+ * @li Enabling interoperability between asynchronous operations and virtual
+ *     functions.
+ *
+ * The target is always stored in memory obtained from its associated
+ * allocator. Use @c basic_any_completion_handler to store small targets
+ * within the wrapper object.
+ */
+template <typename... Signatures>
+class any_completion_handler
+#if !defined(GENERATING_DOCUMENTATION)
+  : public basic_any_completion_handler<0, Signatures...>
+#endif // !defined(GENERATING_DOCUMENTATION)
+{
+public:
+#if !defined(GENERATING_DOCUMENTATION)
+  using basic_any_completion_handler<0,
+    Signatures...>::basic_any_completion_handler;
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+  /// Construct an @c any_completion_handler in an empty state, without a target
+  /// object.
+  constexpr any_completion_handler()
+  {
+  }
+
+  /// Assignment operator that sets the polymorphic wrapper to the empty state.
+  any_completion_handler& operator=(nullptr_t) noexcept
+  {
+    basic_any_completion_handler<0, Signatures...>::operator=(nullptr);
+    return *this;
+  }
+};
+
+template <std::size_t InlineSize, typename... Signatures, typename Candidate>
+struct associated_executor<
+    basic_any_completion_handler<InlineSize, Signatures...>, Candidate>
 {
   using type = any_completion_executor;
 
-  static type get(const any_completion_handler<Signatures...>& handler,
+  static type get(
+      const basic_any_completion_handler<InlineSize, Signatures...>& handler,
       const Candidate& candidate = Candidate()) noexcept
   {
     any_completion_executor any_candidate(std::nothrow, candidate);
@@ -800,12 +1120,19 @@ struct associated_executor<any_completion_handler<Signatures...>, Candidate>
 };
 
 template <typename... Signatures, typename Candidate>
+struct associated_executor<any_completion_handler<Signatures...>, Candidate> :
+  associated_executor<basic_any_completion_handler<0, Signatures...>, Candidate>
+{
+};
+
+template <std::size_t InlineSize, typename... Signatures, typename Candidate>
 struct associated_immediate_executor<
-    any_completion_handler<Signatures...>, Candidate>
+    basic_any_completion_handler<InlineSize, Signatures...>, Candidate>
 {
   using type = any_completion_executor;
 
-  static type get(const any_completion_handler<Signatures...>& handler,
+  static type get(
+      const basic_any_completion_handler<InlineSize, Signatures...>& handler,
       const Candidate& candidate = Candidate()) noexcept
   {
     any_io_executor any_candidate(std::nothrow, candidate);
@@ -815,6 +1142,14 @@ struct associated_immediate_executor<
   }
 };
 
+template <typename... Signatures, typename Candidate>
+struct associated_immediate_executor<
+    any_completion_handler<Signatures...>, Candidate> :
+  associated_immediate_executor<
+    basic_any_completion_handler<0, Signatures...>, Candidate>
+{
+};
+
 } // namespace asio
 
 #include "asio/detail/pop_options.hpp"
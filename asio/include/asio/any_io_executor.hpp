@@ -21,6 +21,9 @@
 #else // defined(ASIO_USE_TS_EXECUTOR_AS_DEFAULT)
 # include "asio/execution.hpp"
 # include "asio/execution_context.hpp"
+# include "asio/io_context.hpp"
+# include "asio/prefer.hpp"
+# include "asio/strand.hpp"
 #endif // defined(ASIO_USE_TS_EXECUTOR_AS_DEFAULT)
 
 #include "asio/detail/push_options.hpp"
@@ -247,6 +250,50 @@ public:
   {
     return static_cast<const base_type&>(*this).prefer(p);
   }
+
+  /// Execute the function on the target executor.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * execution::execute customisation point.
+   *
+   * When the target is an io_context::executor_type, with or without
+   * outstanding work tracking, or a strand<io_context::executor_type>, the
+   * function is passed to the target directly. It is not wrapped in a
+   * type-erased function object, and so is not allocated when the target
+   * runs it immediately.
+   *
+   * For example:
+   * @code any_io_executor ex = ...;
+   * execution::execute(ex, my_function_object); @endcode
+   */
+  template <typename Function>
+  void execute(Function&& f) const
+  {
+    if (const io_context::executor_type* ex1 =
+        this->template fast_target<io_context::executor_type>())
+      ex1->execute(static_cast<Function&&>(f));
+    else if (const tracked_io_executor_type* ex2 =
+        this->template fast_target<tracked_io_executor_type>())
+      ex2->execute(static_cast<Function&&>(f));
+    else if (const strand<io_context::executor_type>* ex3 =
+        this->template fast_target<strand<io_context::executor_type>>())
+      ex3->execute(static_cast<Function&&>(f));
+    else
+      static_cast<const base_type&>(*this).execute(static_cast<Function&&>(f));
+  }
+
+private:
+  typedef decay_t<
+      prefer_result_t<io_context::executor_type,
+        execution::outstanding_work_t::tracked_t>
+    > tracked_io_executor_type;
+
+  // The executors that have a fast path must not require allocation.
+  static_assert(
+      is_stored_inline<io_context::executor_type>::value
+        && is_stored_inline<tracked_io_executor_type>::value
+        && is_stored_inline<strand<io_context::executor_type>>::value,
+      "io_context executors must be stored within any_io_executor");
 };
 
 #if !defined(GENERATING_DOCUMENTATION)
@@ -0,0 +1,173 @@
+//
+// associated_deadline.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_ASSOCIATED_DEADLINE_HPP
+#define ASIO_ASSOCIATED_DEADLINE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/associator.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+template <typename T, typename Deadline>
+struct associated_deadline;
+
+namespace detail {
+
+template <typename T, typename = void>
+struct has_deadline_type : false_type
+{
+};
+
+template <typename T>
+struct has_deadline_type<T, void_t<typename T::deadline_type>>
+  : true_type
+{
+};
+
+template <typename T, typename D, typename = void, typename = void>
+struct associated_deadline_impl
+{
+  typedef void asio_associated_deadline_is_unspecialised;
+
+  typedef D type;
+
+  static type get(const T&) noexcept
+  {
+    return (type::max)();
+  }
+
+  static const type& get(const T&, const D& d) noexcept
+  {
+    return d;
+  }
+};
+
+template <typename T, typename D>
+struct associated_deadline_impl<T, D,
+  void_t<typename T::deadline_type>>
+{
+  typedef typename T::deadline_type type;
+
+  static auto get(const T& t) noexcept
+    -> decltype(t.get_deadline())
+  {
+    return t.get_deadline();
+  }
+
+  static auto get(const T& t, const D&) noexcept
+    -> decltype(t.get_deadline())
+  {
+    return t.get_deadline();
+  }
+};
+
+template <typename T, typename D>
+struct associated_deadline_impl<T, D,
+  enable_if_t<
+    !has_deadline_type<T>::value
+  >,
+  void_t<
+    typename associator<associated_deadline, T, D>::type
+  >> : associator<associated_deadline, T, D>
+{
+};
+
+} // namespace detail
+
+/// Traits type used to obtain the deadline associated with an object.
+/**
+ * A deadline is the latest time by which a function object should be run. It
+ * is used by executors, such as @ref deadline_executor, that choose which of
+ * their ready function objects to run next.
+ *
+ * A program may specialise this traits type if the @c T template parameter in
+ * the specialisation is a user-defined type. The template parameter @c
+ * Deadline shall be a @c std::chrono::time_point type.
+ *
+ * Specialisations shall meet the following requirements, where @c t is a const
+ * reference to an object of type @c T, and @c d is an object of type @c
+ * Deadline.
+ *
+ * @li Provide a nested typedef @c type that identifies a type meeting the
+ * requirements of @c std::chrono::time_point.
+ *
+ * @li Provide a noexcept static member function named @c get, callable as @c
+ * get(t) and with return type @c type or a (possibly const) reference to @c
+ * type.
+ *
+ * @li Provide a noexcept static member function named @c get, callable as @c
+ * get(t,d) and with return type @c type or a (possibly const) reference to @c
+ * type.
+ */
+template <typename T,
+    typename Deadline = chrono::steady_clock::time_point>
+struct associated_deadline
+#if !defined(GENERATING_DOCUMENTATION)
+  : detail::associated_deadline_impl<T, Deadline>
+#endif // !defined(GENERATING_DOCUMENTATION)
+{
+#if defined(GENERATING_DOCUMENTATION)
+  /// If @c T has a nested type @c deadline_type, <tt>T::deadline_type</tt>.
+  /// Otherwise @c Deadline.
+  typedef see_below type;
+
+  /// If @c T has a nested type @c deadline_type, returns
+  /// <tt>t.get_deadline()</tt>. Otherwise returns <tt>type::max()</tt>, so
+  /// that an object without a deadline is never late.
+  static decltype(auto) get(const T& t) noexcept;
+
+  /// If @c T has a nested type @c deadline_type, returns
+  /// <tt>t.get_deadline()</tt>. Otherwise returns @c d.
+  static decltype(auto) get(const T& t, const Deadline& d) noexcept;
+#endif // defined(GENERATING_DOCUMENTATION)
+};
+
+/// Helper function to obtain an object's associated deadline.
+/**
+ * @returns <tt>associated_deadline<T>::get(t)</tt>
+ */
+template <typename T>
+ASIO_NODISCARD inline typename associated_deadline<T>::type
+get_associated_deadline(const T& t) noexcept
+{
+  return associated_deadline<T>::get(t);
+}
+
+/// Helper function to obtain an object's associated deadline.
+/**
+ * @returns <tt>associated_deadline<T, Deadline>::get(t, d)</tt>
+ */
+template <typename T, typename Deadline>
+ASIO_NODISCARD inline auto get_associated_deadline(
+    const T& t, const Deadline& d) noexcept
+  -> decltype(associated_deadline<T, Deadline>::get(t, d))
+{
+  return associated_deadline<T, Deadline>::get(t, d);
+}
+
+template <typename T,
+    typename Deadline = chrono::steady_clock::time_point>
+using associated_deadline_t =
+  typename associated_deadline<T, Deadline>::type;
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_ASSOCIATED_DEADLINE_HPP
@@ -35,9 +35,11 @@ namespace detail {
 
 #if defined(ASIO_HAS_STD_COROUTINE)
 using std::coroutine_handle;
+using std::noop_coroutine;
 using std::suspend_always;
 #else // defined(ASIO_HAS_STD_COROUTINE)
 using std::experimental::coroutine_handle;
+using std::experimental::noop_coroutine;
 using std::experimental::suspend_always;
 #endif // defined(ASIO_HAS_STD_COROUTINE)
 
@@ -98,12 +100,14 @@ public:
     return false;
   }
 
-  // Support for co_await keyword.
+  // Support for co_await keyword. Control is transferred directly to the
+  // awaited coroutine, without returning to the awaitable thread's pump.
   template <class U>
-  void await_suspend(
+  detail::coroutine_handle<void> await_suspend(
       detail::coroutine_handle<detail::awaitable_frame<U, Executor>> h)
   {
     frame_->push_frame(&h.promise());
+    return h.promise().transfer_to(frame_);
   }
 
   // Support for co_await keyword.
@@ -0,0 +1,194 @@
+//
+// awaitable_arena_allocator.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_AWAITABLE_ARENA_ALLOCATOR_HPP
+#define ASIO_AWAITABLE_ARENA_ALLOCATOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/recycling_allocator.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// An allocator that selects a stack arena for the coroutine frames of a
+/// spawned thread of execution.
+/**
+ * When an awaitable_arena_allocator is the associated allocator of the
+ * completion handler passed to asio::co_spawn, the coroutine frames created
+ * by the new thread of execution are allocated from a per-thread stack arena,
+ * rather than individually from the thread-local recycling cache. Frames are
+ * bump-allocated from chunks of contiguous memory and are reclaimed in LIFO
+ * order, which matches the nesting of @c co_await calls. A frame that is
+ * freed out of order, or that outlives the thread of execution, is reclaimed
+ * once the frames above it have been freed.
+ *
+ * The frame of the awaitable passed to co_spawn is created before the thread
+ * of execution starts, and so is not allocated from the arena.
+ *
+ * Other memory is allocated in the same way as for asio::recycling_allocator.
+ *
+ * @par Example
+ * @code asio::co_spawn(ctx, session(std::move(socket)),
+ *     asio::bind_allocator(
+ *       asio::awaitable_arena_allocator<void>(),
+ *       asio::detached)); @endcode
+ */
+template <typename T>
+class awaitable_arena_allocator
+{
+public:
+  /// The type of object allocated by the allocator.
+  typedef T value_type;
+
+  /// The default size, in bytes, of each chunk of the arena.
+  static constexpr std::size_t default_chunk_size = 16384;
+
+  /// Rebind the allocator to another value_type.
+  template <typename U>
+  struct rebind
+  {
+    /// The rebound @c allocator type.
+    typedef awaitable_arena_allocator<U> other;
+  };
+
+  /// Construct with a specified chunk size.
+  /**
+   * @param chunk_size The minimum size, in bytes, of each chunk of contiguous
+   * memory from which coroutine frames are allocated.
+   */
+  constexpr explicit awaitable_arena_allocator(
+      std::size_t chunk_size = default_chunk_size) noexcept
+    : chunk_size_(chunk_size)
+  {
+  }
+
+  /// Converting constructor.
+  template <typename U>
+  constexpr awaitable_arena_allocator(
+      const awaitable_arena_allocator<U>& other) noexcept
+    : chunk_size_(other.chunk_size())
+  {
+  }
+
+  /// Get the minimum size of each chunk of the arena.
+  constexpr std::size_t chunk_size() const noexcept
+  {
+    return chunk_size_;
+  }
+
+  /// Equality operator. Always returns true.
+  constexpr bool operator==(
+      const awaitable_arena_allocator&) const noexcept
+  {
+    return true;
+  }
+
+  /// Inequality operator. Always returns false.
+  constexpr bool operator!=(
+      const awaitable_arena_allocator&) const noexcept
+  {
+    return false;
+  }
+
+  /// Allocate memory for the specified number of values.
+  T* allocate(std::size_t n)
+  {
+    return detail::recycling_allocator<T>().allocate(n);
+  }
+
+  /// Deallocate memory for the specified number of values.
+  void deallocate(T* p, std::size_t n)
+  {
+    detail::recycling_allocator<T>().deallocate(p, n);
+  }
+
+private:
+  std::size_t chunk_size_;
+};
+
+/// A proto-allocator that selects a stack arena for the coroutine frames of a
+/// spawned thread of execution.
+/**
+ * When an awaitable_arena_allocator is the associated allocator of the
+ * completion handler passed to asio::co_spawn, the coroutine frames created
+ * by the new thread of execution are allocated from a per-thread stack arena.
+ */
+template <>
+class awaitable_arena_allocator<void>
+{
+public:
+  /// No values are allocated by a proto-allocator.
+  typedef void value_type;
+
+  /// The default size, in bytes, of each chunk of the arena.
+  static constexpr std::size_t default_chunk_size = 16384;
+
+  /// Rebind the allocator to another value_type.
+  template <typename U>
+  struct rebind
+  {
+    /// The rebound @c allocator type.
+    typedef awaitable_arena_allocator<U> other;
+  };
+
+  /// Construct with a specified chunk size.
+  /**
+   * @param chunk_size The minimum size, in bytes, of each chunk of contiguous
+   * memory from which coroutine frames are allocated.
+   */
+  constexpr explicit awaitable_arena_allocator(
+      std::size_t chunk_size = default_chunk_size) noexcept
+    : chunk_size_(chunk_size)
+  {
+  }
+
+  /// Converting constructor.
+  template <typename U>
+  constexpr awaitable_arena_allocator(
+      const awaitable_arena_allocator<U>& other) noexcept
+    : chunk_size_(other.chunk_size())
+  {
+  }
+
+  /// Get the minimum size of each chunk of the arena.
+  constexpr std::size_t chunk_size() const noexcept
+  {
+    return chunk_size_;
+  }
+
+  /// Equality operator. Always returns true.
+  constexpr bool operator==(
+      const awaitable_arena_allocator&) const noexcept
+  {
+    return true;
+  }
+
+  /// Inequality operator. Always returns false.
+  constexpr bool operator!=(
+      const awaitable_arena_allocator&) const noexcept
+  {
+    return false;
+  }
+
+private:
+  std::size_t chunk_size_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_AWAITABLE_ARENA_ALLOCATOR_HPP
@@ -18,11 +18,16 @@
 #include "asio/detail/config.hpp"
 #include <cstddef>
 #include "asio/basic_socket.hpp"
+#include "asio/datagram_arena.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
 #include "asio/detail/non_const_lvalue.hpp"
 #include "asio/detail/throw_error.hpp"
 #include "asio/detail/type_traits.hpp"
 #include "asio/error.hpp"
+#include "asio/ip/packet_info.hpp"
+#include "asio/local/passed_fds.hpp"
+#include "asio/provided_buffer_ring.hpp"
+#include "asio/socket_timestamp.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -60,8 +65,31 @@ class basic_datagram_socket
 private:
   class initiate_async_send;
   class initiate_async_send_to;
+#if defined(ASIO_HAS_DATAGRAM_BATCH)
+  class initiate_async_send_batch;
+#endif // defined(ASIO_HAS_DATAGRAM_BATCH)
+#if defined(ASIO_HAS_UDP_OFFLOAD)
+  class initiate_async_send_segments;
+#endif // defined(ASIO_HAS_UDP_OFFLOAD)
   class initiate_async_receive;
+#if defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+  class initiate_async_receive_multishot;
+#endif // defined(ASIO_HAS_PROVIDED_BUFFER_RING)
   class initiate_async_receive_from;
+#if defined(ASIO_HAS_DATAGRAM_BATCH)
+  class initiate_async_receive_batch;
+  class initiate_async_receive_arena;
+#endif // defined(ASIO_HAS_DATAGRAM_BATCH)
+#if defined(ASIO_HAS_UDP_OFFLOAD)
+  class initiate_async_receive_coalesced;
+#endif // defined(ASIO_HAS_UDP_OFFLOAD)
+#if defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+  class initiate_async_receive_timestamped;
+#endif // defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+#if defined(ASIO_HAS_FD_PASSING)
+  class initiate_async_send_fds;
+  class initiate_async_receive_fds;
+#endif // defined(ASIO_HAS_FD_PASSING)
 
 public:
   /// The type of the executor associated with the object.
@@ -330,6 +358,65 @@ public:
     return *this;
   }
 
+  /// Move-construct a basic_datagram_socket from another, transferring it to a
+  /// new executor.
+  /**
+   * This constructor moves an open datagram socket to the execution context of
+   * @c ex without closing and reopening it, retaining the socket's native
+   * handle and state.
+   *
+   * @param ex The I/O executor that the socket will use, by default, to
+   * dispatch handlers for any asynchronous operations performed on the socket.
+   *
+   * @param other The other basic_datagram_socket object from which the move
+   * will occur. Any asynchronous operations outstanding on @c other are
+   * cancelled, and their handlers are passed the asio::error::operation_aborted
+   * error.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Following the move, the moved-from object is in the same state as if
+   * constructed using the @c basic_datagram_socket(const executor_type&)
+   * constructor.
+   */
+  template <typename Executor1>
+  basic_datagram_socket(const executor_type& ex,
+      basic_datagram_socket<Protocol, Executor1>&& other)
+    : basic_socket<Protocol, Executor>(ex, std::move(other))
+  {
+  }
+
+  /// Move-construct a basic_datagram_socket from another, transferring it to a
+  /// new execution context.
+  /**
+   * This constructor moves an open datagram socket to @c context without
+   * closing and reopening it, retaining the socket's native handle and state.
+   *
+   * @param context An execution context which provides the I/O executor that
+   * the socket will use, by default, to dispatch handlers for any asynchronous
+   * operations performed on the socket.
+   *
+   * @param other The other basic_datagram_socket object from which the move
+   * will occur. Any asynchronous operations outstanding on @c other are
+   * cancelled, and their handlers are passed the asio::error::operation_aborted
+   * error.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Following the move, the moved-from object is in the same state as if
+   * constructed using the @c basic_datagram_socket(const executor_type&)
+   * constructor.
+   */
+  template <typename ExecutionContext, typename Executor1>
+  basic_datagram_socket(ExecutionContext& context,
+      basic_datagram_socket<Protocol, Executor1>&& other,
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      > = 0)
+    : basic_socket<Protocol, Executor>(context, std::move(other))
+  {
+  }
+
   /// Destroys the socket.
   /**
    * This function destroys the socket, cancelling any outstanding asynchronous
@@ -772,114 +859,195 @@ public:
         buffers, destination, flags);
   }
 
-  /// Receive some data on a connected socket.
+#if defined(ASIO_HAS_DATAGRAM_BATCH) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous send of a batch of datagrams.
   /**
-   * This function is used to receive data on the datagram socket. The function
-   * call will block until data has been received successfully or an error
-   * occurs.
+   * This function is used to asynchronously send several datagrams using a
+   * single system call, where supported. Each buffer in the sequence is sent
+   * as a separate datagram. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
    *
-   * @param buffers One or more buffers into which the data will be received.
+   * @param buffers A sequence of buffers, each of which holds one datagram to
+   * be sent. At most 64 datagrams are sent by a single operation. Although the
+   * buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid until the completion handler is called.
    *
-   * @returns The number of bytes received.
+   * @param destinations An array of endpoints, one for each datagram, giving
+   * the remote endpoint to which the datagram will be sent. May be null if the
+   * socket is connected. Ownership of the array is retained by the caller,
+   * which must guarantee that it is valid until the completion handler is
+   * called.
    *
-   * @throws asio::system_error Thrown on failure.
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the send completes. Potential
+   * completion tokens include @ref use_future, @ref use_awaitable, @ref
+   * yield_context, or a function object with the correct completion signature.
+   * The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t messages_transferred // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
    *
-   * @note The receive operation can only be used with a connected socket. Use
-   * the receive_from function to receive data on an unconnected datagram
-   * socket.
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note The send operation may not send all of the datagrams. The leading
+   * @c messages_transferred datagrams have been sent, and the remainder may be
+   * sent by starting a new operation.
    *
    * @par Example
-   * To receive into a single data buffer use the @ref buffer function as
-   * follows:
-   * @code socket.receive(asio::buffer(data, size)); @endcode
-   * See the @ref buffer documentation for information on receiving into
-   * multiple buffers in one go, and how to use it with arrays, boost::array or
-   * std::vector.
+   * To send two datagrams to different endpoints:
+   * @code
+   * std::array<asio::const_buffer, 2> bufs = {
+   *   asio::buffer(data1, size1), asio::buffer(data2, size2) };
+   * asio::ip::udp::endpoint destinations[2] = { endpoint1, endpoint2 };
+   * socket.async_send_batch(bufs, destinations, handler);
+   * @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
    */
-  template <typename MutableBufferSequence>
-  std::size_t receive(const MutableBufferSequence& buffers)
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_send_batch(const ConstBufferSequence& buffers,
+      const endpoint_type* destinations,
+      WriteToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<WriteToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_send_batch>(), token, buffers,
+          destinations, static_cast<const ip::packet_info*>(0),
+          socket_base::message_flags(0)))
   {
-    asio::error_code ec;
-    std::size_t s = this->impl_.get_service().receive(
-        this->impl_.get_implementation(), buffers, 0, ec);
-    asio::detail::throw_error(ec, "receive");
-    return s;
+    return async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_batch(this), token, buffers,
+        destinations, static_cast<const ip::packet_info*>(0),
+        socket_base::message_flags(0));
   }
 
-  /// Receive some data on a connected socket.
+  /// Start an asynchronous send of a batch of datagrams.
   /**
-   * This function is used to receive data on the datagram socket. The function
-   * call will block until data has been received successfully or an error
-   * occurs.
+   * This function is used to asynchronously send several datagrams using a
+   * single system call, where supported. Each buffer in the sequence is sent
+   * as a separate datagram. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
    *
-   * @param buffers One or more buffers into which the data will be received.
+   * @param buffers A sequence of buffers, each of which holds one datagram to
+   * be sent. At most 64 datagrams are sent by a single operation. Although the
+   * buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid until the completion handler is called.
    *
-   * @param flags Flags specifying how the receive call is to be made.
+   * @param destinations An array of endpoints, one for each datagram, giving
+   * the remote endpoint to which the datagram will be sent. May be null if the
+   * socket is connected. Ownership of the array is retained by the caller,
+   * which must guarantee that it is valid until the completion handler is
+   * called.
    *
-   * @returns The number of bytes received.
+   * @param flags Flags specifying how the send call is to be made.
    *
-   * @throws asio::system_error Thrown on failure.
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the send completes. Potential
+   * completion tokens include @ref use_future, @ref use_awaitable, @ref
+   * yield_context, or a function object with the correct completion signature.
+   * The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t messages_transferred // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
    *
-   * @note The receive operation can only be used with a connected socket. Use
-   * the receive_from function to receive data on an unconnected datagram
-   * socket.
-   */
-  template <typename MutableBufferSequence>
-  std::size_t receive(const MutableBufferSequence& buffers,
-      socket_base::message_flags flags)
-  {
-    asio::error_code ec;
-    std::size_t s = this->impl_.get_service().receive(
-        this->impl_.get_implementation(), buffers, flags, ec);
-    asio::detail::throw_error(ec, "receive");
-    return s;
-  }
-
-  /// Receive some data on a connected socket.
-  /**
-   * This function is used to receive data on the datagram socket. The function
-   * call will block until data has been received successfully or an error
-   * occurs.
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
    *
-   * @param buffers One or more buffers into which the data will be received.
+   * @note The send operation may not send all of the datagrams. The leading
+   * @c messages_transferred datagrams have been sent, and the remainder may be
+   * sent by starting a new operation.
    *
-   * @param flags Flags specifying how the receive call is to be made.
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
    *
-   * @param ec Set to indicate what error occurred, if any.
+   * @li @c cancellation_type::terminal
    *
-   * @returns The number of bytes received.
+   * @li @c cancellation_type::partial
    *
-   * @note The receive operation can only be used with a connected socket. Use
-   * the receive_from function to receive data on an unconnected datagram
-   * socket.
+   * @li @c cancellation_type::total
    */
-  template <typename MutableBufferSequence>
-  std::size_t receive(const MutableBufferSequence& buffers,
-      socket_base::message_flags flags, asio::error_code& ec)
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_send_batch(const ConstBufferSequence& buffers,
+      const endpoint_type* destinations, socket_base::message_flags flags,
+      WriteToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<WriteToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_send_batch>(), token, buffers,
+          destinations, static_cast<const ip::packet_info*>(0), flags))
   {
-    return this->impl_.get_service().receive(
-        this->impl_.get_implementation(), buffers, flags, ec);
+    return async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_batch(this), token, buffers,
+        destinations, static_cast<const ip::packet_info*>(0), flags);
   }
+#endif // defined(ASIO_HAS_DATAGRAM_BATCH)
+       //   || defined(GENERATING_DOCUMENTATION)
 
-  /// Start an asynchronous receive on a connected socket.
+#if defined(ASIO_HAS_PACKET_INFO) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous send of a batch of datagrams with packet
+  /// information.
   /**
-   * This function is used to asynchronously receive data from the datagram
-   * socket. It is an initiating function for an @ref asynchronous_operation,
-   * and always returns immediately.
+   * This function is used to asynchronously send several datagrams using a
+   * single system call, where supported. Each buffer in the sequence is sent
+   * as a separate datagram, with the source address, outgoing interface and
+   * traffic class given by the corresponding packet information. It is an
+   * initiating function for an @ref asynchronous_operation, and always returns
+   * immediately.
    *
-   * @param buffers One or more buffers into which the data will be received.
-   * Although the buffers object may be copied as necessary, ownership of the
-   * underlying memory blocks is retained by the caller, which must guarantee
-   * that they remain valid until the completion handler is called.
+   * @param buffers A sequence of buffers, each of which holds one datagram to
+   * be sent. At most 64 datagrams are sent by a single operation. Although the
+   * buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid until the completion handler is called.
+   *
+   * @param destinations An array of endpoints, one for each datagram, giving
+   * the remote endpoint to which the datagram will be sent. May be null if the
+   * socket is connected. Ownership of the array is retained by the caller,
+   * which must guarantee that it is valid until the completion handler is
+   * called.
+   *
+   * @param infos An array of packet information, one for each datagram.
+   * Ownership of the array is retained by the caller, which must guarantee
+   * that it is valid until the completion handler is called.
    *
    * @param token The @ref completion_token that will be used to produce a
-   * completion handler, which will be called when the receive completes.
-   * Potential completion tokens include @ref use_future, @ref use_awaitable,
-   * @ref yield_context, or a function object with the correct completion
-   * signature. The function signature of the completion handler must be:
+   * completion handler, which will be called when the send completes. Potential
+   * completion tokens include @ref use_future, @ref use_awaitable, @ref
+   * yield_context, or a function object with the correct completion signature.
+   * The function signature of the completion handler must be:
    * @code void handler(
    *   const asio::error_code& error, // Result of operation.
-   *   std::size_t bytes_transferred // Number of bytes received.
+   *   std::size_t messages_transferred // Number of datagrams sent.
    * ); @endcode
    * Regardless of whether the asynchronous operation completes immediately or
    * not, the completion handler will not be invoked from within this function.
@@ -889,23 +1057,25 @@ public:
    * @par Completion Signature
    * @code void(asio::error_code, std::size_t) @endcode
    *
-   * @note The async_receive operation can only be used with a connected socket.
-   * Use the async_receive_from function to receive data on an unconnected
-   * datagram socket.
+   * @note The send operation may not send all of the datagrams. The leading
+   * @c messages_transferred datagrams have been sent, and the remainder may be
+   * sent by starting a new operation.
    *
    * @par Example
-   * To receive into a single data buffer use the @ref buffer function as
-   * follows:
+   * To send two ECN-capable datagrams from a specific local address:
    * @code
-   * socket.async_receive(asio::buffer(data, size), handler);
+   * asio::ip::udp::packet_info infos[2];
+   * for (int i = 0; i < 2; ++i)
+   * {
+   *   infos[i].local_address(local_address);
+   *   infos[i].ecn(asio::ip::udp::packet_info::ect0);
+   * }
+   * socket.async_send_batch(bufs, destinations, infos, handler);
    * @endcode
-   * See the @ref buffer documentation for information on receiving into
-   * multiple buffers in one go, and how to use it with arrays, boost::array or
-   * std::vector.
    *
    * @par Per-Operation Cancellation
-   * On POSIX or Windows operating systems, this asynchronous operation supports
-   * cancellation for the following asio::cancellation_type values:
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
    *
    * @li @c cancellation_type::terminal
    *
@@ -913,44 +1083,52 @@ public:
    *
    * @li @c cancellation_type::total
    */
-  template <typename MutableBufferSequence,
+  template <typename ConstBufferSequence,
       ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
-        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
-  auto async_receive(const MutableBufferSequence& buffers,
-      ReadToken&& token = default_completion_token_t<executor_type>())
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_send_batch(const ConstBufferSequence& buffers,
+      const endpoint_type* destinations, const ip::packet_info* infos,
+      WriteToken&& token = default_completion_token_t<executor_type>())
     -> decltype(
-      async_initiate<ReadToken,
+      async_initiate<WriteToken,
         void (asio::error_code, std::size_t)>(
-          declval<initiate_async_receive>(), token,
-          buffers, socket_base::message_flags(0)))
+          declval<initiate_async_send_batch>(), token, buffers,
+          destinations, infos, socket_base::message_flags(0)))
   {
-    return async_initiate<ReadToken,
+    return async_initiate<WriteToken,
       void (asio::error_code, std::size_t)>(
-        initiate_async_receive(this), token,
-        buffers, socket_base::message_flags(0));
+        initiate_async_send_batch(this), token, buffers,
+        destinations, infos, socket_base::message_flags(0));
   }
+#endif // defined(ASIO_HAS_PACKET_INFO)
+       //   || defined(GENERATING_DOCUMENTATION)
 
-  /// Start an asynchronous receive on a connected socket.
+#if defined(ASIO_HAS_UDP_OFFLOAD) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous send of data split into equally sized datagrams.
   /**
-   * This function is used to asynchronously receive data from the datagram
-   * socket. It is an initiating function for an @ref asynchronous_operation,
-   * and always returns immediately.
+   * This function is used to asynchronously send data on a connected socket
+   * as a sequence of datagrams, each of @c segment_size bytes except possibly
+   * the last. The data is passed to the kernel in a single call, and the
+   * datagrams are formed by UDP generic segmentation offload (UDP_SEGMENT).
+   * It is an initiating function for an @ref asynchronous_operation, and
+   * always returns immediately.
    *
-   * @param buffers One or more buffers into which the data will be received.
-   * Although the buffers object may be copied as necessary, ownership of the
-   * underlying memory blocks is retained by the caller, which must guarantee
-   * that they remain valid until the completion handler is called.
+   * @param buffers One or more data buffers to be sent on the socket. Although
+   * the buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid until the completion handler is called.
    *
-   * @param flags Flags specifying how the receive call is to be made.
+   * @param segment_size The size of each datagram.
    *
    * @param token The @ref completion_token that will be used to produce a
-   * completion handler, which will be called when the receive completes.
-   * Potential completion tokens include @ref use_future, @ref use_awaitable,
-   * @ref yield_context, or a function object with the correct completion
-   * signature. The function signature of the completion handler must be:
+   * completion handler, which will be called when the send completes. Potential
+   * completion tokens include @ref use_future, @ref use_awaitable, @ref
+   * yield_context, or a function object with the correct completion signature.
+   * The function signature of the completion handler must be:
    * @code void handler(
    *   const asio::error_code& error, // Result of operation.
-   *   std::size_t bytes_transferred // Number of bytes received.
+   *   std::size_t bytes_transferred // Number of bytes sent.
    * ); @endcode
    * Regardless of whether the asynchronous operation completes immediately or
    * not, the completion handler will not be invoked from within this function.
@@ -960,12 +1138,12 @@ public:
    * @par Completion Signature
    * @code void(asio::error_code, std::size_t) @endcode
    *
-   * @note The async_receive operation can only be used with a connected socket.
-   * Use the async_receive_from function to receive data on an unconnected
-   * datagram socket.
+   * @note The kernel limits the number of segments in a single send, and the
+   * operation fails with asio::error::invalid_argument if the limit is
+   * exceeded or segmentation offload is not supported.
    *
    * @par Per-Operation Cancellation
-   * On POSIX or Windows operating systems, this asynchronous operation supports
+   * On POSIX operating systems, this asynchronous operation supports
    * cancellation for the following asio::cancellation_type values:
    *
    * @li @c cancellation_type::terminal
@@ -974,127 +1152,194 @@ public:
    *
    * @li @c cancellation_type::total
    */
-  template <typename MutableBufferSequence,
+  template <typename ConstBufferSequence,
       ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
-        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
-  auto async_receive(const MutableBufferSequence& buffers,
-      socket_base::message_flags flags,
-      ReadToken&& token = default_completion_token_t<executor_type>())
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_send_segments(const ConstBufferSequence& buffers,
+      std::size_t segment_size,
+      WriteToken&& token = default_completion_token_t<executor_type>())
     -> decltype(
-      async_initiate<ReadToken,
+      async_initiate<WriteToken,
         void (asio::error_code, std::size_t)>(
-          declval<initiate_async_receive>(), token, buffers, flags))
+          declval<initiate_async_send_segments>(), token, buffers,
+          segment_size, static_cast<const endpoint_type*>(0)))
   {
-    return async_initiate<ReadToken,
+    return async_initiate<WriteToken,
       void (asio::error_code, std::size_t)>(
-        initiate_async_receive(this), token, buffers, flags);
+        initiate_async_send_segments(this), token, buffers,
+        segment_size, static_cast<const endpoint_type*>(0));
   }
 
-  /// Receive a datagram with the endpoint of the sender.
+  /// Start an asynchronous send of data split into equally sized datagrams.
   /**
-   * This function is used to receive a datagram. The function call will block
-   * until data has been received successfully or an error occurs.
+   * This function is used to asynchronously send data to the specified remote
+   * endpoint as a sequence of datagrams, each of @c segment_size bytes except
+   * possibly the last. The data is passed to the kernel in a single call, and
+   * the datagrams are formed by UDP generic segmentation offload
+   * (UDP_SEGMENT). It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
    *
-   * @param buffers One or more buffers into which the data will be received.
+   * @param buffers One or more data buffers to be sent to the remote endpoint.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the completion handler is called.
    *
-   * @param sender_endpoint An endpoint object that receives the endpoint of
-   * the remote sender of the datagram.
+   * @param segment_size The size of each datagram.
+   *
+   * @param destination The remote endpoint to which the data will be sent.
+   * Copies will be made of the endpoint as required.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the send completes. Potential
+   * completion tokens include @ref use_future, @ref use_awaitable, @ref
+   * yield_context, or a function object with the correct completion signature.
+   * The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note The kernel limits the number of segments in a single send, and the
+   * operation fails with asio::error::invalid_argument if the limit is
+   * exceeded or segmentation offload is not supported.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_send_segments_to(const ConstBufferSequence& buffers,
+      std::size_t segment_size, const endpoint_type& destination,
+      WriteToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<WriteToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_send_segments>(), token,
+          buffers, segment_size, &destination))
+  {
+    return async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_segments(this), token,
+        buffers, segment_size, &destination);
+  }
+#endif // defined(ASIO_HAS_UDP_OFFLOAD)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+  /// Receive some data on a connected socket.
+  /**
+   * This function is used to receive data on the datagram socket. The function
+   * call will block until data has been received successfully or an error
+   * occurs.
+   *
+   * @param buffers One or more buffers into which the data will be received.
    *
    * @returns The number of bytes received.
    *
    * @throws asio::system_error Thrown on failure.
    *
+   * @note The receive operation can only be used with a connected socket. Use
+   * the receive_from function to receive data on an unconnected datagram
+   * socket.
+   *
    * @par Example
    * To receive into a single data buffer use the @ref buffer function as
    * follows:
-   * @code
-   * asio::ip::udp::endpoint sender_endpoint;
-   * socket.receive_from(
-   *     asio::buffer(data, size), sender_endpoint);
-   * @endcode
+   * @code socket.receive(asio::buffer(data, size)); @endcode
    * See the @ref buffer documentation for information on receiving into
    * multiple buffers in one go, and how to use it with arrays, boost::array or
    * std::vector.
    */
   template <typename MutableBufferSequence>
-  std::size_t receive_from(const MutableBufferSequence& buffers,
-      endpoint_type& sender_endpoint)
+  std::size_t receive(const MutableBufferSequence& buffers)
   {
     asio::error_code ec;
-    std::size_t s = this->impl_.get_service().receive_from(
-        this->impl_.get_implementation(), buffers, sender_endpoint, 0, ec);
-    asio::detail::throw_error(ec, "receive_from");
+    std::size_t s = this->impl_.get_service().receive(
+        this->impl_.get_implementation(), buffers, 0, ec);
+    asio::detail::throw_error(ec, "receive");
     return s;
   }
 
-  /// Receive a datagram with the endpoint of the sender.
+  /// Receive some data on a connected socket.
   /**
-   * This function is used to receive a datagram. The function call will block
-   * until data has been received successfully or an error occurs.
+   * This function is used to receive data on the datagram socket. The function
+   * call will block until data has been received successfully or an error
+   * occurs.
    *
    * @param buffers One or more buffers into which the data will be received.
    *
-   * @param sender_endpoint An endpoint object that receives the endpoint of
-   * the remote sender of the datagram.
-   *
    * @param flags Flags specifying how the receive call is to be made.
    *
    * @returns The number of bytes received.
    *
    * @throws asio::system_error Thrown on failure.
+   *
+   * @note The receive operation can only be used with a connected socket. Use
+   * the receive_from function to receive data on an unconnected datagram
+   * socket.
    */
   template <typename MutableBufferSequence>
-  std::size_t receive_from(const MutableBufferSequence& buffers,
-      endpoint_type& sender_endpoint, socket_base::message_flags flags)
+  std::size_t receive(const MutableBufferSequence& buffers,
+      socket_base::message_flags flags)
   {
     asio::error_code ec;
-    std::size_t s = this->impl_.get_service().receive_from(
-        this->impl_.get_implementation(), buffers, sender_endpoint, flags, ec);
-    asio::detail::throw_error(ec, "receive_from");
+    std::size_t s = this->impl_.get_service().receive(
+        this->impl_.get_implementation(), buffers, flags, ec);
+    asio::detail::throw_error(ec, "receive");
     return s;
   }
 
-  /// Receive a datagram with the endpoint of the sender.
+  /// Receive some data on a connected socket.
   /**
-   * This function is used to receive a datagram. The function call will block
-   * until data has been received successfully or an error occurs.
+   * This function is used to receive data on the datagram socket. The function
+   * call will block until data has been received successfully or an error
+   * occurs.
    *
    * @param buffers One or more buffers into which the data will be received.
    *
-   * @param sender_endpoint An endpoint object that receives the endpoint of
-   * the remote sender of the datagram.
-   *
    * @param flags Flags specifying how the receive call is to be made.
    *
    * @param ec Set to indicate what error occurred, if any.
    *
    * @returns The number of bytes received.
+   *
+   * @note The receive operation can only be used with a connected socket. Use
+   * the receive_from function to receive data on an unconnected datagram
+   * socket.
    */
   template <typename MutableBufferSequence>
-  std::size_t receive_from(const MutableBufferSequence& buffers,
-      endpoint_type& sender_endpoint, socket_base::message_flags flags,
-      asio::error_code& ec)
+  std::size_t receive(const MutableBufferSequence& buffers,
+      socket_base::message_flags flags, asio::error_code& ec)
   {
-    return this->impl_.get_service().receive_from(
-        this->impl_.get_implementation(), buffers, sender_endpoint, flags, ec);
+    return this->impl_.get_service().receive(
+        this->impl_.get_implementation(), buffers, flags, ec);
   }
 
-  /// Start an asynchronous receive.
+  /// Start an asynchronous receive on a connected socket.
   /**
-   * This function is used to asynchronously receive a datagram. It is an
-   * initiating function for an @ref asynchronous_operation, and always returns
-   * immediately.
+   * This function is used to asynchronously receive data from the datagram
+   * socket. It is an initiating function for an @ref asynchronous_operation,
+   * and always returns immediately.
    *
    * @param buffers One or more buffers into which the data will be received.
    * Although the buffers object may be copied as necessary, ownership of the
    * underlying memory blocks is retained by the caller, which must guarantee
    * that they remain valid until the completion handler is called.
    *
-   * @param sender_endpoint An endpoint object that receives the endpoint of
-   * the remote sender of the datagram. Ownership of the sender_endpoint object
-   * is retained by the caller, which must guarantee that it is valid until the
-   * completion handler is called.
-   *
    * @param token The @ref completion_token that will be used to produce a
    * completion handler, which will be called when the receive completes.
    * Potential completion tokens include @ref use_future, @ref use_awaitable,
@@ -1112,11 +1357,16 @@ public:
    * @par Completion Signature
    * @code void(asio::error_code, std::size_t) @endcode
    *
+   * @note The async_receive operation can only be used with a connected socket.
+   * Use the async_receive_from function to receive data on an unconnected
+   * datagram socket.
+   *
    * @par Example
    * To receive into a single data buffer use the @ref buffer function as
    * follows:
-   * @code socket.async_receive_from(
-   *     asio::buffer(data, size), sender_endpoint, handler); @endcode
+   * @code
+   * socket.async_receive(asio::buffer(data, size), handler);
+   * @endcode
    * See the @ref buffer documentation for information on receiving into
    * multiple buffers in one go, and how to use it with arrays, boost::array or
    * std::vector.
@@ -1134,38 +1384,1196 @@ public:
   template <typename MutableBufferSequence,
       ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
         std::size_t)) ReadToken = default_completion_token_t<executor_type>>
-  auto async_receive_from(const MutableBufferSequence& buffers,
-      endpoint_type& sender_endpoint,
+  auto async_receive(const MutableBufferSequence& buffers,
       ReadToken&& token = default_completion_token_t<executor_type>())
     -> decltype(
       async_initiate<ReadToken,
         void (asio::error_code, std::size_t)>(
-          declval<initiate_async_receive_from>(), token, buffers,
-          &sender_endpoint, socket_base::message_flags(0)))
+          declval<initiate_async_receive>(), token,
+          buffers, socket_base::message_flags(0)))
   {
     return async_initiate<ReadToken,
       void (asio::error_code, std::size_t)>(
-        initiate_async_receive_from(this), token, buffers,
-        &sender_endpoint, socket_base::message_flags(0));
+        initiate_async_receive(this), token,
+        buffers, socket_base::message_flags(0));
   }
 
-  /// Start an asynchronous receive.
+  /// Start an asynchronous receive on a connected socket.
   /**
-   * This function is used to asynchronously receive a datagram. It is an
-   * initiating function for an @ref asynchronous_operation, and always returns
-   * immediately.
+   * This function is used to asynchronously receive data from the datagram
+   * socket. It is an initiating function for an @ref asynchronous_operation,
+   * and always returns immediately.
    *
    * @param buffers One or more buffers into which the data will be received.
    * Although the buffers object may be copied as necessary, ownership of the
    * underlying memory blocks is retained by the caller, which must guarantee
    * that they remain valid until the completion handler is called.
    *
-   * @param sender_endpoint An endpoint object that receives the endpoint of
-   * the remote sender of the datagram. Ownership of the sender_endpoint object
-   * is retained by the caller, which must guarantee that it is valid until the
-   * completion handler is called.
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note The async_receive operation can only be used with a connected socket.
+   * Use the async_receive_from function to receive data on an unconnected
+   * datagram socket.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX or Windows operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_receive(const MutableBufferSequence& buffers,
+      socket_base::message_flags flags,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_receive>(), token, buffers, flags))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive(this), token, buffers, flags);
+  }
+
+#if defined(ASIO_HAS_PROVIDED_BUFFER_RING) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous receive into a buffer from a provided buffer ring.
+  /**
+   * This function is used to asynchronously receive data from the datagram
+   * socket into a buffer that is selected from a provided_buffer_ring only
+   * once data has arrived. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * @param ring The ring from which the buffer will be selected. The ring must
+   * remain valid until the completion handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred, // Number of bytes received.
+   *   std::size_t buffer_id // Identifier of the buffer used.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t, std::size_t) @endcode
+   *
+   * @note The @c buffer_id is valid only when the operation succeeds with a
+   * non-zero @c bytes_transferred. The application then owns the buffer, and
+   * must return it to the ring by calling provided_buffer_ring::recycle().
+   * The operation fails with asio::error::no_buffer_space if data
+   * arrives when the ring has no free buffers.
+   *
+   * @note When the io_uring backend is in use, the underlying submission may
+   * remain armed after the operation completes, so that subsequent calls to
+   * async_receive_multishot() collect data that has already arrived. Other
+   * receive operations must not be started on the socket while multishot
+   * receives are in use.
+   *
+   * @note The async_receive_multishot operation can only be used with a
+   * connected socket.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t, std::size_t)) ReadToken
+          = default_completion_token_t<executor_type>>
+  auto async_receive_multishot(provided_buffer_ring& ring,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t, std::size_t)>(
+          declval<initiate_async_receive_multishot>(), token,
+          &ring, socket_base::message_flags(0)))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t, std::size_t)>(
+        initiate_async_receive_multishot(this), token,
+        &ring, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous receive into a buffer from a provided buffer ring.
+  /**
+   * This function is used to asynchronously receive data from the datagram
+   * socket into a buffer that is selected from a provided_buffer_ring only
+   * once data has arrived. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * @param ring The ring from which the buffer will be selected. The ring must
+   * remain valid until the completion handler is called.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred, // Number of bytes received.
+   *   std::size_t buffer_id // Identifier of the buffer used.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t, std::size_t) @endcode
+   *
+   * @note The @c buffer_id is valid only when the operation succeeds with a
+   * non-zero @c bytes_transferred. The application then owns the buffer, and
+   * must return it to the ring by calling provided_buffer_ring::recycle().
+   * The operation fails with asio::error::no_buffer_space if data
+   * arrives when the ring has no free buffers.
+   *
+   * @note When the io_uring backend is in use, the underlying submission may
+   * remain armed after the operation completes, so that subsequent calls to
+   * async_receive_multishot() collect data that has already arrived. Other
+   * receive operations must not be started on the socket while multishot
+   * receives are in use.
+   *
+   * @note The async_receive_multishot operation can only be used with a
+   * connected socket.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t, std::size_t)) ReadToken
+          = default_completion_token_t<executor_type>>
+  auto async_receive_multishot(provided_buffer_ring& ring,
+      socket_base::message_flags flags,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t, std::size_t)>(
+          declval<initiate_async_receive_multishot>(),
+          token, &ring, flags))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t, std::size_t)>(
+        initiate_async_receive_multishot(this), token, &ring, flags);
+  }
+#endif // defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+  /// Receive a datagram with the endpoint of the sender.
+  /**
+   * This function is used to receive a datagram. The function call will block
+   * until data has been received successfully or an error occurs.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagram.
+   *
+   * @returns The number of bytes received.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @par Example
+   * To receive into a single data buffer use the @ref buffer function as
+   * follows:
+   * @code
+   * asio::ip::udp::endpoint sender_endpoint;
+   * socket.receive_from(
+   *     asio::buffer(data, size), sender_endpoint);
+   * @endcode
+   * See the @ref buffer documentation for information on receiving into
+   * multiple buffers in one go, and how to use it with arrays, boost::array or
+   * std::vector.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().receive_from(
+        this->impl_.get_implementation(), buffers, sender_endpoint, 0, ec);
+    asio::detail::throw_error(ec, "receive_from");
+    return s;
+  }
+
+  /// Receive a datagram with the endpoint of the sender.
+  /**
+   * This function is used to receive a datagram. The function call will block
+   * until data has been received successfully or an error occurs.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagram.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @returns The number of bytes received.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, socket_base::message_flags flags)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().receive_from(
+        this->impl_.get_implementation(), buffers, sender_endpoint, flags, ec);
+    asio::detail::throw_error(ec, "receive_from");
+    return s;
+  }
+
+  /// Receive a datagram with the endpoint of the sender.
+  /**
+   * This function is used to receive a datagram. The function call will block
+   * until data has been received successfully or an error occurs.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagram.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes received.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, socket_base::message_flags flags,
+      asio::error_code& ec)
+  {
+    return this->impl_.get_service().receive_from(
+        this->impl_.get_implementation(), buffers, sender_endpoint, flags, ec);
+  }
+
+  /// Start an asynchronous receive.
+  /**
+   * This function is used to asynchronously receive a datagram. It is an
+   * initiating function for an @ref asynchronous_operation, and always returns
+   * immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the completion handler is called.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagram. Ownership of the sender_endpoint object
+   * is retained by the caller, which must guarantee that it is valid until the
+   * completion handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @par Example
+   * To receive into a single data buffer use the @ref buffer function as
+   * follows:
+   * @code socket.async_receive_from(
+   *     asio::buffer(data, size), sender_endpoint, handler); @endcode
+   * See the @ref buffer documentation for information on receiving into
+   * multiple buffers in one go, and how to use it with arrays, boost::array or
+   * std::vector.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX or Windows operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_receive_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_receive_from>(), token, buffers,
+          &sender_endpoint, socket_base::message_flags(0)))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_from(this), token, buffers,
+        &sender_endpoint, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous receive.
+  /**
+   * This function is used to asynchronously receive a datagram. It is an
+   * initiating function for an @ref asynchronous_operation, and always returns
+   * immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the completion handler is called.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagram. Ownership of the sender_endpoint object
+   * is retained by the caller, which must guarantee that it is valid until the
+   * completion handler is called.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX or Windows operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_receive_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, socket_base::message_flags flags,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_receive_from>(), token,
+          buffers, &sender_endpoint, flags))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_from(this), token,
+        buffers, &sender_endpoint, flags);
+  }
+
+#if defined(ASIO_HAS_DATAGRAM_BATCH) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous receive of a batch of datagrams.
+  /**
+   * This function is used to asynchronously receive several datagrams using a
+   * single system call, where supported. Each buffer in the sequence receives
+   * a separate datagram. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * @param buffers A sequence of buffers, each of which receives one datagram.
+   * At most 64 datagrams are received by a single operation. Although the
+   * buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid until the completion handler is called.
+   *
+   * @param sender_endpoints An array of endpoints, one for each buffer, that
+   * receives the endpoint of the remote sender of each datagram. May be null
+   * if the senders are not required. Ownership of the array is retained by the
+   * caller, which must guarantee that it is valid until the completion handler
+   * is called.
+   *
+   * @param sizes An array, one element for each buffer, that receives the
+   * length of each datagram. Ownership of the array is retained by the caller,
+   * which must guarantee that it is valid until the completion handler is
+   * called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t messages_transferred // Number of datagrams received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note The operation completes once at least one datagram has been
+   * received. Only the leading @c messages_transferred elements of the buffers,
+   * @c sender_endpoints and @c sizes are filled in.
+   *
+   * @par Example
+   * To receive up to 16 datagrams into separate buffers:
+   * @code
+   * std::array<asio::mutable_buffer, 16> bufs;
+   * for (std::size_t i = 0; i < bufs.size(); ++i)
+   *   bufs[i] = asio::buffer(data[i]);
+   * asio::ip::udp::endpoint senders[16];
+   * std::size_t sizes[16];
+   * socket.async_receive_batch(bufs, senders, sizes, handler);
+   * @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_receive_batch(const MutableBufferSequence& buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_receive_batch>(), token, buffers,
+          sender_endpoints, sizes, static_cast<ip::packet_info*>(0),
+          socket_base::message_flags(0)))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_batch(this), token, buffers,
+        sender_endpoints, sizes, static_cast<ip::packet_info*>(0),
+        socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous receive of a batch of datagrams.
+  /**
+   * This function is used to asynchronously receive several datagrams using a
+   * single system call, where supported. Each buffer in the sequence receives
+   * a separate datagram. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * @param buffers A sequence of buffers, each of which receives one datagram.
+   * At most 64 datagrams are received by a single operation. Although the
+   * buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid until the completion handler is called.
+   *
+   * @param sender_endpoints An array of endpoints, one for each buffer, that
+   * receives the endpoint of the remote sender of each datagram. May be null
+   * if the senders are not required. Ownership of the array is retained by the
+   * caller, which must guarantee that it is valid until the completion handler
+   * is called.
+   *
+   * @param sizes An array, one element for each buffer, that receives the
+   * length of each datagram. Ownership of the array is retained by the caller,
+   * which must guarantee that it is valid until the completion handler is
+   * called.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t messages_transferred // Number of datagrams received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note The operation completes once at least one datagram has been
+   * received. Only the leading @c messages_transferred elements of the buffers,
+   * @c sender_endpoints and @c sizes are filled in.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_receive_batch(const MutableBufferSequence& buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes,
+      socket_base::message_flags flags,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_receive_batch>(), token, buffers,
+          sender_endpoints, sizes, static_cast<ip::packet_info*>(0), flags))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_batch(this), token, buffers,
+        sender_endpoints, sizes, static_cast<ip::packet_info*>(0), flags);
+  }
+
+#if defined(ASIO_HAS_PACKET_INFO) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous receive of a batch of datagrams with packet
+  /// information.
+  /**
+   * This function is used to asynchronously receive several datagrams using a
+   * single system call, where supported. Each buffer in the sequence receives
+   * a separate datagram, and the destination address, arrival interface and
+   * traffic class of each datagram are stored in the corresponding packet
+   * information. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * The addresses and interfaces are available only when the
+   * ip::udp::receive_packet_info option is enabled on the socket, and the
+   * traffic classes only when the ip::udp::receive_traffic_class option is
+   * enabled.
+   *
+   * @param buffers A sequence of buffers, each of which receives one datagram.
+   * At most 64 datagrams are received by a single operation. Although the
+   * buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid until the completion handler is called.
+   *
+   * @param sender_endpoints An array of endpoints, one for each buffer, that
+   * receives the endpoint of the remote sender of each datagram. May be null
+   * if the senders are not required. Ownership of the array is retained by the
+   * caller, which must guarantee that it is valid until the completion handler
+   * is called.
+   *
+   * @param sizes An array, one element for each buffer, that receives the
+   * length of each datagram. Ownership of the array is retained by the caller,
+   * which must guarantee that it is valid until the completion handler is
+   * called.
+   *
+   * @param infos An array, one element for each buffer, that receives the
+   * packet information of each datagram. Ownership of the array is retained by
+   * the caller, which must guarantee that it is valid until the completion
+   * handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t messages_transferred // Number of datagrams received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note The operation completes once at least one datagram has been
+   * received. Only the leading @c messages_transferred elements of the buffers,
+   * @c sender_endpoints, @c sizes and @c infos are filled in.
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_receive_batch(const MutableBufferSequence& buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes,
+      ip::packet_info* infos,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_receive_batch>(), token, buffers,
+          sender_endpoints, sizes, infos, socket_base::message_flags(0)))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_batch(this), token, buffers,
+        sender_endpoints, sizes, infos, socket_base::message_flags(0));
+  }
+#endif // defined(ASIO_HAS_PACKET_INFO)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+  /// Start an asynchronous receive of a batch of datagrams into an arena.
+  /**
+   * This function is used to asynchronously receive several datagrams into a
+   * datagram_arena, using a single system call where supported. It is an
+   * initiating function for an @ref asynchronous_operation, and always returns
+   * immediately.
+   *
+   * When the operation completes, the arena's contents are replaced by the
+   * datagrams that were received. Each datagram is described by a packet
+   * header giving its offset and length within the arena's payload region,
+   * its sender and the time at which it was received.
+   *
+   * @param arena The arena that receives the datagrams. Ownership of the arena
+   * is retained by the caller, which must guarantee that it is valid until the
+   * completion handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t messages_transferred // Number of datagrams received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note The operation completes once at least one datagram has been
+   * received. If an error occurs, the arena is left empty.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_receive_arena(datagram_arena<protocol_type>& arena,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_receive_arena>(), token,
+          &arena, socket_base::message_flags(0)))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_arena(this), token,
+        &arena, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous receive of a batch of datagrams into an arena.
+  /**
+   * This function is used to asynchronously receive several datagrams into a
+   * datagram_arena, using a single system call where supported. It is an
+   * initiating function for an @ref asynchronous_operation, and always returns
+   * immediately.
+   *
+   * When the operation completes, the arena's contents are replaced by the
+   * datagrams that were received. Each datagram is described by a packet
+   * header giving its offset and length within the arena's payload region,
+   * its sender and the time at which it was received.
+   *
+   * @param arena The arena that receives the datagrams. Ownership of the arena
+   * is retained by the caller, which must guarantee that it is valid until the
+   * completion handler is called.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t messages_transferred // Number of datagrams received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note The operation completes once at least one datagram has been
+   * received. If an error occurs, the arena is left empty.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_receive_arena(datagram_arena<protocol_type>& arena,
+      socket_base::message_flags flags,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_receive_arena>(), token, &arena, flags))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_arena(this), token, &arena, flags);
+  }
+#endif // defined(ASIO_HAS_DATAGRAM_BATCH)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#if defined(ASIO_HAS_UDP_OFFLOAD) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous receive of datagrams that may have been coalesced.
+  /**
+   * This function is used to asynchronously receive data on a connected
+   * socket. When UDP generic receive offload has been enabled using the
+   * ip::udp::receive_offload socket option, the kernel may deliver several
+   * consecutive datagrams from the same sender in a single receive. It is an
+   * initiating function for an @ref asynchronous_operation, and always returns
+   * immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the completion handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred, // Number of bytes received.
+   *   std::size_t segment_size // Size of each coalesced datagram.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t, std::size_t) @endcode
+   *
+   * @note The received data consists of datagrams of @c segment_size bytes,
+   * except that the last may be shorter. If the data was not coalesced,
+   * @c segment_size is equal to @c bytes_transferred. The buffers should be
+   * large enough to hold a coalesced batch, which may be up to 64 KiB.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t, std::size_t)) ReadToken
+          = default_completion_token_t<executor_type>>
+  auto async_receive_coalesced(const MutableBufferSequence& buffers,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t, std::size_t)>(
+          declval<initiate_async_receive_coalesced>(), token,
+          buffers, static_cast<endpoint_type*>(0)))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t, std::size_t)>(
+        initiate_async_receive_coalesced(this), token,
+        buffers, static_cast<endpoint_type*>(0));
+  }
+
+  /// Start an asynchronous receive of datagrams that may have been coalesced.
+  /**
+   * This function is used to asynchronously receive data together with the
+   * endpoint of the sender. When UDP generic receive offload has been enabled
+   * using the ip::udp::receive_offload socket option, the kernel may deliver
+   * several consecutive datagrams from the same sender in a single receive. It
+   * is an initiating function for an @ref asynchronous_operation, and always
+   * returns immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the completion handler is called.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagrams. Ownership of the sender_endpoint
+   * object is retained by the caller, which must guarantee that it is valid
+   * until the completion handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred, // Number of bytes received.
+   *   std::size_t segment_size // Size of each coalesced datagram.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t, std::size_t) @endcode
+   *
+   * @note The received data consists of datagrams of @c segment_size bytes,
+   * except that the last may be shorter. If the data was not coalesced,
+   * @c segment_size is equal to @c bytes_transferred. The buffers should be
+   * large enough to hold a coalesced batch, which may be up to 64 KiB.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t, std::size_t)) ReadToken
+          = default_completion_token_t<executor_type>>
+  auto async_receive_coalesced_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t, std::size_t)>(
+          declval<initiate_async_receive_coalesced>(), token,
+          buffers, &sender_endpoint))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t, std::size_t)>(
+        initiate_async_receive_coalesced(this), token,
+        buffers, &sender_endpoint);
+  }
+#endif // defined(ASIO_HAS_UDP_OFFLOAD)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#if defined(ASIO_HAS_SOCKET_TIMESTAMPING) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous receive that reports the receive timestamp.
+  /**
+   * This function is used to asynchronously receive data on a connected
+   * socket, together with the software or hardware timestamp generated by the
+   * kernel when the data arrived. It is an initiating function for an
+   * @ref asynchronous_operation, and always returns immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the completion handler is called.
+   *
+   * @param timestamp A socket_timestamp object that receives the timestamp
+   * generated for the received data. Ownership of the timestamp object is
+   * retained by the caller, which must guarantee that it is valid until the
+   * completion handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note Timestamps are generated only after they have been enabled using the
+   * socket_base::timestamping socket option. A timestamp that was not
+   * generated for the received data is reported as zero.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_receive_timestamped(const MutableBufferSequence& buffers,
+      socket_timestamp& timestamp,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_receive_timestamped>(), token,
+          buffers, static_cast<endpoint_type*>(0), &timestamp))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_timestamped(this), token,
+        buffers, static_cast<endpoint_type*>(0), &timestamp);
+  }
+
+  /// Start an asynchronous receive that reports the receive timestamp.
+  /**
+   * This function is used to asynchronously receive a datagram together with
+   * the endpoint of the sender and the software or hardware timestamp
+   * generated by the kernel when the datagram arrived. It is an initiating
+   * function for an @ref asynchronous_operation, and always returns
+   * immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the completion handler is called.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagram. Ownership of the sender_endpoint object
+   * is retained by the caller, which must guarantee that it is valid until the
+   * completion handler is called.
+   *
+   * @param timestamp A socket_timestamp object that receives the timestamp
+   * generated for the received data. Ownership of the timestamp object is
+   * retained by the caller, which must guarantee that it is valid until the
+   * completion handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note Timestamps are generated only after they have been enabled using the
+   * socket_base::timestamping socket option. A timestamp that was not
+   * generated for the received data is reported as zero.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_receive_from_timestamped(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, socket_timestamp& timestamp,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_receive_timestamped>(), token,
+          buffers, &sender_endpoint, &timestamp))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_timestamped(this), token,
+        buffers, &sender_endpoint, &timestamp);
+  }
+#endif // defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#if defined(ASIO_HAS_FD_PASSING) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous send that passes file descriptors with the data.
+  /**
+   * This function is used to asynchronously send data on a local datagram
+   * socket, passing the specified file descriptors to the peer with the data.
+   * It is an initiating function for an @ref asynchronous_operation, and always
+   * returns immediately.
+   *
+   * @param buffers One or more data buffers to be sent on the socket. Although
+   * the buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid until the completion handler is called.
+   *
+   * @param fds The descriptors to be passed. Ownership of the fds object is
+   * retained by the caller, which must guarantee that it is valid until the
+   * completion handler is called. The descriptors remain owned by the caller.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the send completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note The descriptors are passed with the datagram and at most
+   * local::passed_fds::max_fds descriptors may be sent in one datagram.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_send_fds(const ConstBufferSequence& buffers,
+      const local::passed_fds& fds,
+      WriteToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<WriteToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_send_fds>(), token, buffers, &fds))
+  {
+    return async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_fds(this), token, buffers, &fds);
+  }
+
+  /// Start an asynchronous receive that accepts passed file descriptors.
+  /**
+   * This function is used to asynchronously receive data from a local
+   * datagram socket, together with any file descriptors and credentials passed
+   * by the peer with the data. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the completion handler is called.
    *
-   * @param flags Flags specifying how the receive call is to be made.
+   * @param fds A passed_fds object that receives the descriptors. Ownership of
+   * the fds object is retained by the caller, which must guarantee that it is
+   * valid until the completion handler is called. Received descriptors are
+   * owned by the caller, even if the operation fails after they arrive.
    *
    * @param token The @ref completion_token that will be used to produce a
    * completion handler, which will be called when the receive completes.
@@ -1184,8 +2592,11 @@ public:
    * @par Completion Signature
    * @code void(asio::error_code, std::size_t) @endcode
    *
+   * @note The sender's credentials are received only after they have been
+   * enabled using the local::pass_credentials socket option.
+   *
    * @par Per-Operation Cancellation
-   * On POSIX or Windows operating systems, this asynchronous operation supports
+   * On POSIX operating systems, this asynchronous operation supports
    * cancellation for the following asio::cancellation_type values:
    *
    * @li @c cancellation_type::terminal
@@ -1197,20 +2608,20 @@ public:
   template <typename MutableBufferSequence,
       ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
         std::size_t)) ReadToken = default_completion_token_t<executor_type>>
-  auto async_receive_from(const MutableBufferSequence& buffers,
-      endpoint_type& sender_endpoint, socket_base::message_flags flags,
+  auto async_receive_fds(const MutableBufferSequence& buffers,
+      local::passed_fds& fds,
       ReadToken&& token = default_completion_token_t<executor_type>())
     -> decltype(
       async_initiate<ReadToken,
         void (asio::error_code, std::size_t)>(
-          declval<initiate_async_receive_from>(), token,
-          buffers, &sender_endpoint, flags))
+          declval<initiate_async_receive_fds>(), token, buffers, &fds))
   {
     return async_initiate<ReadToken,
       void (asio::error_code, std::size_t)>(
-        initiate_async_receive_from(this), token,
-        buffers, &sender_endpoint, flags);
+        initiate_async_receive_fds(this), token, buffers, &fds);
   }
+#endif // defined(ASIO_HAS_FD_PASSING)
+       //   || defined(GENERATING_DOCUMENTATION)
 
 private:
   // Disallow copying and assignment.
@@ -1223,6 +2634,11 @@ private:
   public:
     typedef Executor executor_type;
 
+#if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+    // The operation links any cancel_after timeout to its submission.
+    typedef void linked_timeout_support;
+#endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
     explicit initiate_async_send(basic_datagram_socket* self)
       : self_(self)
     {
@@ -1291,6 +2707,11 @@ private:
   public:
     typedef Executor executor_type;
 
+#if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+    // The operation links any cancel_after timeout to its submission.
+    typedef void linked_timeout_support;
+#endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
     explicit initiate_async_receive(basic_datagram_socket* self)
       : self_(self)
     {
@@ -1353,6 +2774,325 @@ private:
   private:
     basic_datagram_socket* self_;
   };
+
+#if defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+  class initiate_async_receive_multishot
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_multishot(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler>
+    void operator()(ReadHandler&& handler, provided_buffer_ring* ring,
+        socket_base::message_flags flags) const
+    {
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_multishot(
+          self_->impl_.get_implementation(), *ring, flags,
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+#endif // defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+
+#if defined(ASIO_HAS_DATAGRAM_BATCH)
+  class initiate_async_send_batch
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_batch(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(WriteHandler&& handler,
+        const ConstBufferSequence& buffers,
+        const endpoint_type* destinations, const ip::packet_info* infos,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send_batch(
+          self_->impl_.get_implementation(), buffers, destinations,
+          infos, flags, handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+
+  class initiate_async_receive_batch
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_batch(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ReadHandler&& handler,
+        const MutableBufferSequence& buffers,
+        endpoint_type* sender_endpoints, std::size_t* sizes,
+        ip::packet_info* infos, socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_batch(
+          self_->impl_.get_implementation(), buffers, sender_endpoints,
+          sizes, infos, flags, handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+
+  class initiate_async_receive_arena
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_arena(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler>
+    void operator()(ReadHandler&& handler,
+        datagram_arena<protocol_type>* arena,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      arena->clear();
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      detail::datagram_arena_handler<protocol_type, decay_t<ReadHandler>>
+        arena_handler(*arena, handler2.value);
+      self_->impl_.get_service().async_receive_batch(
+          self_->impl_.get_implementation(), arena->buffers_,
+          arena->endpoints_.data(), arena->sizes_.data(),
+          static_cast<ip::packet_info*>(0), flags,
+          arena_handler, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+#endif // defined(ASIO_HAS_DATAGRAM_BATCH)
+
+#if defined(ASIO_HAS_UDP_OFFLOAD)
+  class initiate_async_send_segments
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_segments(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(WriteHandler&& handler,
+        const ConstBufferSequence& buffers, std::size_t segment_size,
+        const endpoint_type* destination) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send_segments(
+          self_->impl_.get_implementation(), buffers, segment_size,
+          destination, socket_base::message_flags(0),
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+
+  class initiate_async_receive_coalesced
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_coalesced(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ReadHandler&& handler,
+        const MutableBufferSequence& buffers,
+        endpoint_type* sender_endpoint) const
+    {
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_coalesced(
+          self_->impl_.get_implementation(), buffers, sender_endpoint,
+          socket_base::message_flags(0), handler2.value,
+          self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+#endif // defined(ASIO_HAS_UDP_OFFLOAD)
+
+#if defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+  class initiate_async_receive_timestamped
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_timestamped(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ReadHandler&& handler,
+        const MutableBufferSequence& buffers,
+        endpoint_type* sender_endpoint, socket_timestamp* timestamp) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_timestamped(
+          self_->impl_.get_implementation(), buffers, sender_endpoint,
+          timestamp, socket_base::message_flags(0), handler2.value,
+          self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+#endif // defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+
+#if defined(ASIO_HAS_FD_PASSING)
+  class initiate_async_send_fds
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_fds(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(WriteHandler&& handler,
+        const ConstBufferSequence& buffers,
+        const local::passed_fds* fds) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send_fds(
+          self_->impl_.get_implementation(), buffers, fds,
+          socket_base::message_flags(0), handler2.value,
+          self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+
+  class initiate_async_receive_fds
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_fds(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ReadHandler&& handler,
+        const MutableBufferSequence& buffers,
+        local::passed_fds* fds) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_fds(
+          self_->impl_.get_implementation(), buffers, fds,
+          socket_base::message_flags(0), handler2.value,
+          self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+#endif // defined(ASIO_HAS_FD_PASSING)
 };
 
 } // namespace asio
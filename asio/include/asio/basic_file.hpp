@@ -38,6 +38,8 @@
 # include "asio/detail/win_iocp_file_service.hpp"
 #elif defined(ASIO_HAS_IO_URING)
 # include "asio/detail/io_uring_file_service.hpp"
+#elif defined(ASIO_HAS_THREAD_POOL_FILE)
+# include "asio/detail/thread_pool_file_service.hpp"
 #endif
 
 #include "asio/detail/push_options.hpp"
@@ -66,6 +68,11 @@ template <typename Executor>
 class basic_file
   : public file_base
 {
+private:
+  class initiate_async_sync_all;
+  class initiate_async_sync_data;
+  class initiate_async_sync_range;
+
 public:
   /// The type of the executor associated with the object.
   typedef Executor executor_type;
@@ -85,6 +92,9 @@ public:
   typedef detail::win_iocp_file_service::native_handle_type native_handle_type;
 #elif defined(ASIO_HAS_IO_URING)
   typedef detail::io_uring_file_service::native_handle_type native_handle_type;
+#elif defined(ASIO_HAS_THREAD_POOL_FILE)
+  typedef detail::thread_pool_file_service::native_handle_type
+    native_handle_type;
 #endif
 
   /// Construct a basic_file without opening it.
@@ -904,6 +914,147 @@ public:
     ASIO_SYNC_OP_VOID_RETURN(ec);
   }
 
+  /// Start an asynchronous synchronisation of the file to disk.
+  /**
+   * This function is used to asynchronously synchronise the file data and
+   * metadata to disk, without blocking the calling thread. It is an
+   * initiating function for an @ref asynchronous_operation, and always
+   * returns immediately.
+   *
+   * The synchronisation covers the writes that have completed before it
+   * starts. Where the implementation uses io_uring, it also starts after the
+   * async_write_some() and async_write_some_at() operations that were started
+   * before it on the same file have completed. Otherwise, and for batches of
+   * writes, wait for the writes to complete before starting the
+   * synchronisation.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the synchronisation
+   * completes. Potential completion tokens include @ref use_future, @ref
+   * use_awaitable, @ref yield_context, or a function object with the correct
+   * completion signature. The function signature of the completion handler
+   * must be:
+   * @code void handler(
+   *   const asio::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   *
+   * @note On Windows, the file is flushed by the calling thread before this
+   * function returns, as there is no asynchronous form of the flush.
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        SyncToken = default_completion_token_t<executor_type>>
+  auto async_sync_all(
+      SyncToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<SyncToken, void (asio::error_code)>(
+        declval<initiate_async_sync_all>(), token))
+  {
+    return async_initiate<SyncToken, void (asio::error_code)>(
+        initiate_async_sync_all(this), token);
+  }
+
+  /// Start an asynchronous synchronisation of the file data to disk.
+  /**
+   * This function is used to asynchronously synchronise the file data to
+   * disk, without blocking the calling thread. Metadata is synchronised only
+   * where it is needed to read the data back. It is an initiating function
+   * for an @ref asynchronous_operation, and always returns immediately.
+   *
+   * The synchronisation is ordered with respect to writes in the same way as
+   * for async_sync_all().
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the synchronisation
+   * completes. Potential completion tokens include @ref use_future, @ref
+   * use_awaitable, @ref yield_context, or a function object with the correct
+   * completion signature. The function signature of the completion handler
+   * must be:
+   * @code void handler(
+   *   const asio::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   *
+   * @note On Windows, the file is flushed by the calling thread before this
+   * function returns, as there is no asynchronous form of the flush.
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        SyncToken = default_completion_token_t<executor_type>>
+  auto async_sync_data(
+      SyncToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<SyncToken, void (asio::error_code)>(
+        declval<initiate_async_sync_data>(), token))
+  {
+    return async_initiate<SyncToken, void (asio::error_code)>(
+        initiate_async_sync_data(this), token);
+  }
+
+  /// Start an asynchronous write-out of a range of the file.
+  /**
+   * This function is used to asynchronously write out the modified data in a
+   * range of the file, waiting for any write-out of the range that is already
+   * in progress. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * On Linux, this function uses @c sync_file_range, which does not
+   * synchronise metadata and does not guarantee that the data is durable,
+   * for example if it occupies newly allocated blocks. It may be used to
+   * start writing out a log early, so that a subsequent async_sync_data() has
+   * less to do. On other platforms, the file data is synchronised as for
+   * async_sync_data().
+   *
+   * The write-out is ordered with respect to writes in the same way as for
+   * async_sync_all().
+   *
+   * @param offset The offset of the first byte of the range.
+   *
+   * @param size The number of bytes in the range. A size of 0 means that the
+   * range extends to the end of the file.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the write-out completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        SyncToken = default_completion_token_t<executor_type>>
+  auto async_sync_range(uint64_t offset, uint64_t size,
+      SyncToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<SyncToken, void (asio::error_code)>(
+        declval<initiate_async_sync_range>(), token, offset, size))
+  {
+    return async_initiate<SyncToken, void (asio::error_code)>(
+        initiate_async_sync_range(this), token, offset, size);
+  }
+
 protected:
   /// Protected destructor to prevent deletion through this type.
   /**
@@ -918,12 +1069,99 @@ protected:
   detail::io_object_impl<detail::win_iocp_file_service, Executor> impl_;
 #elif defined(ASIO_HAS_IO_URING)
   detail::io_object_impl<detail::io_uring_file_service, Executor> impl_;
+#elif defined(ASIO_HAS_THREAD_POOL_FILE)
+  detail::io_object_impl<detail::thread_pool_file_service, Executor> impl_;
 #endif
 
 private:
   // Disallow copying and assignment.
   basic_file(const basic_file&) = delete;
   basic_file& operator=(const basic_file&) = delete;
+
+  class initiate_async_sync_all
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_sync_all(basic_file* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename SyncHandler>
+    void operator()(SyncHandler&& handler) const
+    {
+      detail::non_const_lvalue<SyncHandler> handler2(handler);
+      self_->impl_.get_service().async_sync_all(
+          self_->impl_.get_implementation(),
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_file* self_;
+  };
+
+  class initiate_async_sync_data
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_sync_data(basic_file* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename SyncHandler>
+    void operator()(SyncHandler&& handler) const
+    {
+      detail::non_const_lvalue<SyncHandler> handler2(handler);
+      self_->impl_.get_service().async_sync_data(
+          self_->impl_.get_implementation(),
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_file* self_;
+  };
+
+  class initiate_async_sync_range
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_sync_range(basic_file* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename SyncHandler>
+    void operator()(SyncHandler&& handler,
+        uint64_t offset, uint64_t size) const
+    {
+      detail::non_const_lvalue<SyncHandler> handler2(handler);
+      self_->impl_.get_service().async_sync_range(
+          self_->impl_.get_implementation(), offset, size,
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_file* self_;
+  };
 };
 
 } // namespace asio
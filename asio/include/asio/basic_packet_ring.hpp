@@ -0,0 +1,686 @@
+//
+// basic_packet_ring.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_BASIC_PACKET_RING_HPP
+#define ASIO_BASIC_PACKET_RING_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_PACKET_RING) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include "asio/any_io_executor.hpp"
+#include "asio/basic_raw_socket.hpp"
+#include "asio/buffer.hpp"
+#include "asio/compose.hpp"
+#include "asio/error.hpp"
+#include "asio/generic/raw_protocol.hpp"
+#include "asio/post.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A frame received from a packet ring.
+/**
+ * A frame refers to memory in the ring, and remains valid only as long as the
+ * packet_batch that contains it.
+ */
+class packet_frame
+{
+public:
+  /// The clock used to timestamp received frames.
+  typedef std::chrono::system_clock clock_type;
+
+  /// Get the captured bytes, starting with the link-layer header.
+  const_buffer data() const noexcept
+  {
+    return const_buffer(
+        static_cast<const char*>(header_) + header()->tp_mac,
+        header()->tp_snaplen);
+  }
+
+  /// Get the length of the frame as it appeared on the wire.
+  /**
+   * This may exceed the size of data() if the frame was truncated to fit into
+   * the ring.
+   */
+  std::size_t original_size() const noexcept
+  {
+    return header()->tp_len;
+  }
+
+  /// Get the time at which the frame was received.
+  clock_type::time_point timestamp() const noexcept
+  {
+    return clock_type::time_point(
+        std::chrono::duration_cast<clock_type::duration>(
+          std::chrono::seconds(header()->tp_sec)
+            + std::chrono::nanoseconds(header()->tp_nsec)));
+  }
+
+  /// Get the index of the interface on which the frame was received.
+  int interface_index() const noexcept
+  {
+    return address()->sll_ifindex;
+  }
+
+  /// Get the link-layer protocol of the frame, in host byte order.
+  unsigned short protocol() const noexcept
+  {
+    return asio::detail::socket_ops::network_to_host_short(
+        address()->sll_protocol);
+  }
+
+private:
+  friend class packet_batch;
+
+  explicit packet_frame(const void* header) noexcept
+    : header_(header)
+  {
+  }
+
+  const ::tpacket3_hdr* header() const noexcept
+  {
+    return static_cast<const ::tpacket3_hdr*>(header_);
+  }
+
+  const ::sockaddr_ll* address() const noexcept
+  {
+    return reinterpret_cast<const ::sockaddr_ll*>(
+        static_cast<const char*>(header_)
+          + TPACKET_ALIGN(sizeof(::tpacket3_hdr)));
+  }
+
+  const void* header_;
+};
+
+/// A batch of frames received from a packet ring.
+/**
+ * A batch holds one block of the ring, and returns the block to the kernel
+ * when it is destroyed or released. Until then the kernel cannot reuse the
+ * block, so batches should be released promptly, and in the order in which
+ * they were received.
+ *
+ * A batch must not outlive the ring from which it was received.
+ */
+class packet_batch
+{
+public:
+  /// An iterator over the frames in a batch.
+  class const_iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef packet_frame value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const packet_frame* pointer;
+    typedef packet_frame reference;
+
+    /// Construct an iterator that does not refer to any frame.
+    const_iterator() noexcept
+      : header_(0),
+        remaining_(0)
+    {
+    }
+
+    /// Get the frame at the iterator's position.
+    packet_frame operator*() const noexcept
+    {
+      return packet_frame(header_);
+    }
+
+    /// Move to the next frame in the batch.
+    const_iterator& operator++() noexcept
+    {
+      if (--remaining_ > 0)
+      {
+        header_ = static_cast<const char*>(header_)
+          + static_cast<const ::tpacket3_hdr*>(header_)->tp_next_offset;
+      }
+      else
+      {
+        header_ = 0;
+      }
+      return *this;
+    }
+
+    /// Move to the next frame in the batch.
+    const_iterator operator++(int) noexcept
+    {
+      const_iterator tmp(*this);
+      ++*this;
+      return tmp;
+    }
+
+    /// Compare two iterators for equality.
+    friend bool operator==(const const_iterator& a,
+        const const_iterator& b) noexcept
+    {
+      return a.header_ == b.header_;
+    }
+
+    /// Compare two iterators for inequality.
+    friend bool operator!=(const const_iterator& a,
+        const const_iterator& b) noexcept
+    {
+      return a.header_ != b.header_;
+    }
+
+  private:
+    friend class packet_batch;
+
+    const_iterator(const void* header, std::size_t remaining) noexcept
+      : header_(remaining > 0 ? header : 0),
+        remaining_(remaining)
+    {
+    }
+
+    const void* header_;
+    std::size_t remaining_;
+  };
+
+  /// Construct an empty batch.
+  packet_batch() noexcept
+    : block_(0)
+  {
+  }
+
+  /// Move constructor.
+  packet_batch(packet_batch&& other) noexcept
+    : block_(other.block_)
+  {
+    other.block_ = 0;
+  }
+
+  /// Move assignment. Releases any block held by this batch.
+  packet_batch& operator=(packet_batch&& other) noexcept
+  {
+    if (this != &other)
+    {
+      release();
+      block_ = other.block_;
+      other.block_ = 0;
+    }
+    return *this;
+  }
+
+  /// Destructor. Returns the block to the kernel.
+  ~packet_batch()
+  {
+    release();
+  }
+
+  /// Get the number of frames in the batch.
+  std::size_t size() const noexcept
+  {
+    return block_ ? descriptor()->hdr.bh1.num_pkts : 0;
+  }
+
+  /// Determine whether the batch contains no frames.
+  bool empty() const noexcept
+  {
+    return size() == 0;
+  }
+
+  /// Get an iterator to the first frame in the batch.
+  const_iterator begin() const noexcept
+  {
+    if (!block_)
+      return const_iterator();
+    return const_iterator(static_cast<const char*>(block_)
+        + descriptor()->hdr.bh1.offset_to_first_pkt, size());
+  }
+
+  /// Get an iterator to one past the last frame in the batch.
+  const_iterator end() const noexcept
+  {
+    return const_iterator();
+  }
+
+  /// Return the block to the kernel. The batch is empty afterwards.
+  void release() noexcept
+  {
+    if (block_)
+    {
+      __atomic_store_n(&static_cast< ::tpacket_block_desc*>(
+            block_)->hdr.bh1.block_status,
+          static_cast<unsigned int>(TP_STATUS_KERNEL), __ATOMIC_RELEASE);
+      block_ = 0;
+    }
+  }
+
+private:
+  template <typename> friend class basic_packet_ring;
+
+  explicit packet_batch(void* block) noexcept
+    : block_(block)
+  {
+  }
+
+  const ::tpacket_block_desc* descriptor() const noexcept
+  {
+    return static_cast<const ::tpacket_block_desc*>(block_);
+  }
+
+  void* block_;
+};
+
+/// Provides memory-mapped packet capture.
+/**
+ * The basic_packet_ring class template receives frames from a network
+ * interface through a receive ring that is shared with the kernel, using
+ * Linux's @c AF_PACKET sockets with @c TPACKET_V3. The kernel fills the
+ * ring's blocks with frames and hands each block over once it is full or once
+ * its timeout has elapsed. Each receive operation delivers one block as a
+ * packet_batch, so that many frames are received without a system call or a
+ * copy per frame.
+ *
+ * Waiting for a block uses the reactor, in the same way as a wait on a socket.
+ *
+ * Opening a packet ring typically requires the @c CAP_NET_RAW capability.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code
+ * asio::packet_ring ring(my_context);
+ * asio::packet_ring::ring_parameters params;
+ * params.interface_index = if_nametoindex("eth0");
+ * ring.open(params);
+ * ring.async_receive(
+ *     [](asio::error_code ec, asio::packet_batch batch)
+ *     {
+ *       for (asio::packet_frame frame : batch)
+ *         parse(frame.data());
+ *     });
+ * @endcode
+ */
+template <typename Executor = any_io_executor>
+class basic_packet_ring
+{
+private:
+  class receive_op;
+
+public:
+  /// The type of the executor associated with the object.
+  typedef Executor executor_type;
+
+  /// Rebinds the packet ring type to another executor.
+  template <typename Executor1>
+  struct rebind_executor
+  {
+    /// The packet ring type when rebound to the specified executor.
+    typedef basic_packet_ring<Executor1> other;
+  };
+
+  /// Parameters used when opening a packet ring.
+  struct ring_parameters
+  {
+    /// The interface from which to receive frames, or 0 for all interfaces.
+    unsigned int interface_index = 0;
+
+    /// The link-layer protocol to receive, in host byte order.
+    unsigned short protocol = ETH_P_ALL;
+
+    /// The size of each block. Rounded up to a multiple of the page size.
+    std::size_t block_size = 1 << 20;
+
+    /// The number of blocks in the ring.
+    std::size_t block_count = 16;
+
+    /// The time after which a partly filled block is handed over, in
+    /// milliseconds.
+    unsigned int block_timeout = 10;
+  };
+
+  /// Construct a packet ring without opening it.
+  explicit basic_packet_ring(const executor_type& ex)
+    : socket_(ex),
+      ring_(0),
+      ring_size_(0),
+      block_size_(0),
+      block_count_(0),
+      next_block_(0)
+  {
+  }
+
+  /// Construct a packet ring without opening it.
+  template <typename ExecutionContext>
+  explicit basic_packet_ring(ExecutionContext& context,
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      > = 0)
+    : socket_(context),
+      ring_(0),
+      ring_size_(0),
+      block_size_(0),
+      block_count_(0),
+      next_block_(0)
+  {
+  }
+
+  /// Destructor. Cancels any outstanding operation and unmaps the ring.
+  ~basic_packet_ring()
+  {
+    asio::error_code ec;
+    close(ec);
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() noexcept
+  {
+    return socket_.get_executor();
+  }
+
+  /// Open the packet ring.
+  /**
+   * @throws asio::system_error Thrown on failure.
+   */
+  void open(const ring_parameters& params = ring_parameters())
+  {
+    asio::error_code ec;
+    open(params, ec);
+    asio::detail::throw_error(ec, "open");
+  }
+
+  /// Open the packet ring.
+  /**
+   * @param params The parameters of the ring.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID open(const ring_parameters& params,
+      asio::error_code& ec)
+  {
+    if (is_open())
+    {
+      ec = asio::error::already_open;
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    std::size_t block_size = params.block_size > 0 ? params.block_size : 1;
+    block_size = (block_size + page_size - 1) / page_size * page_size;
+    std::size_t block_count = params.block_count > 0 ? params.block_count : 1;
+    const std::size_t frame_size = TPACKET_ALIGNMENT << 7;
+
+    unsigned short protocol =
+      asio::detail::socket_ops::host_to_network_short(params.protocol);
+    socket_.open(generic::raw_protocol(AF_PACKET, protocol), ec);
+    if (ec)
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+
+    int version = TPACKET_V3;
+    ::tpacket_req3 req;
+    std::memset(&req, 0, sizeof(req));
+    req.tp_block_size = static_cast<unsigned int>(block_size);
+    req.tp_block_nr = static_cast<unsigned int>(block_count);
+    req.tp_frame_size = static_cast<unsigned int>(frame_size);
+    req.tp_frame_nr = static_cast<unsigned int>(
+        block_size / frame_size * block_count);
+    req.tp_retire_blk_tov = params.block_timeout;
+
+    void* ring = MAP_FAILED;
+    if (::setsockopt(socket_.native_handle(), SOL_PACKET,
+          PACKET_VERSION, &version, sizeof(version)) != 0
+        || ::setsockopt(socket_.native_handle(), SOL_PACKET,
+          PACKET_RX_RING, &req, sizeof(req)) != 0
+        || (ring = ::mmap(0, block_size * block_count,
+            PROT_READ | PROT_WRITE, MAP_SHARED,
+            socket_.native_handle(), 0)) == MAP_FAILED)
+    {
+      ec = asio::error_code(errno, asio::error::get_system_category());
+      asio::error_code ignored_ec;
+      socket_.close(ignored_ec);
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    ::sockaddr_ll addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = protocol;
+    addr.sll_ifindex = static_cast<int>(params.interface_index);
+    socket_.bind(generic::raw_protocol::endpoint(
+          &addr, sizeof(addr), protocol), ec);
+    if (ec)
+    {
+      ::munmap(ring, block_size * block_count);
+      asio::error_code ignored_ec;
+      socket_.close(ignored_ec);
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    ring_ = ring;
+    ring_size_ = block_size * block_count;
+    block_size_ = block_size;
+    block_count_ = block_count;
+    next_block_ = 0;
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Determine whether the packet ring is open.
+  bool is_open() const noexcept
+  {
+    return socket_.is_open();
+  }
+
+  /// Close the packet ring.
+  /**
+   * Any asynchronous receive operation is cancelled immediately, and will
+   * complete with the asio::error::operation_aborted error. All batches
+   * received from the ring must have been destroyed or released beforehand.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void close()
+  {
+    asio::error_code ec;
+    close(ec);
+    asio::detail::throw_error(ec, "close");
+  }
+
+  /// Close the packet ring.
+  /**
+   * Any asynchronous receive operation is cancelled immediately, and will
+   * complete with the asio::error::operation_aborted error. All batches
+   * received from the ring must have been destroyed or released beforehand.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID close(asio::error_code& ec)
+  {
+    socket_.close(ec);
+    if (ring_)
+    {
+      ::munmap(ring_, ring_size_);
+      ring_ = 0;
+      ring_size_ = 0;
+      block_size_ = 0;
+      block_count_ = 0;
+      next_block_ = 0;
+    }
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Cancel any asynchronous receive operation.
+  /**
+   * @throws asio::system_error Thrown on failure.
+   */
+  void cancel()
+  {
+    socket_.cancel();
+  }
+
+  /// Get the number of blocks in the ring.
+  std::size_t block_count() const noexcept
+  {
+    return block_count_;
+  }
+
+  /// Get the size of each block in the ring.
+  std::size_t block_size() const noexcept
+  {
+    return block_size_;
+  }
+
+  /// Receive the next block of frames without blocking.
+  /**
+   * @returns A batch holding the next block, or an empty batch if the kernel
+   * has not yet handed over the next block.
+   */
+  packet_batch try_receive() noexcept
+  {
+    void* block = next_ready_block();
+    if (!block)
+      return packet_batch();
+    next_block_ = (next_block_ + 1) % block_count_;
+    return packet_batch(block);
+  }
+
+  /// Start an asynchronous operation to receive the next block of frames.
+  /**
+   * This function is used to asynchronously receive the next block from the
+   * ring. If the kernel has already handed over the block then the operation
+   * completes without waiting, although the completion handler is not invoked
+   * from within this function.
+   *
+   * At most one receive operation may be outstanding at a time.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   asio::packet_batch batch // The received block.
+   * ); @endcode
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, asio::packet_batch) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code, packet_batch))
+        ReceiveToken = default_completion_token_t<executor_type>>
+  auto async_receive(
+      ReceiveToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_compose<ReceiveToken, void (asio::error_code, packet_batch)>(
+        declval<receive_op>(), token,
+        declval<basic_raw_socket<generic::raw_protocol, Executor>&>()))
+  {
+    return async_compose<ReceiveToken,
+      void (asio::error_code, packet_batch)>(
+        receive_op(this), token, socket_);
+  }
+
+private:
+  // Disallow copying and assignment.
+  basic_packet_ring(const basic_packet_ring&) = delete;
+  basic_packet_ring& operator=(const basic_packet_ring&) = delete;
+
+  // Get the next block if it has been handed over by the kernel.
+  void* next_ready_block() const noexcept
+  {
+    if (!ring_)
+      return 0;
+    ::tpacket_block_desc* block = reinterpret_cast< ::tpacket_block_desc*>(
+        static_cast<char*>(ring_) + next_block_ * block_size_);
+    unsigned int status = __atomic_load_n(
+        &block->hdr.bh1.block_status, __ATOMIC_ACQUIRE);
+    return (status & TP_STATUS_USER) ? block : 0;
+  }
+
+  // Receives the next block, waiting for the socket to become readable when
+  // the block has not yet been handed over. When no wait is needed on the
+  // first check, the operation is posted so that it does not complete from
+  // within async_receive().
+  class receive_op
+  {
+  public:
+    explicit receive_op(basic_packet_ring* ring)
+      : ring_(ring),
+        started_(false)
+    {
+    }
+
+    template <typename Self>
+    void operator()(Self& self, asio::error_code ec = asio::error_code())
+    {
+      if (!started_)
+      {
+        started_ = true;
+        if (!ring_->ring_ || ring_->next_ready_block())
+          asio::post(ring_->socket_.get_executor(), static_cast<Self&&>(self));
+        else
+          ring_->socket_.async_wait(socket_base::wait_read,
+              static_cast<Self&&>(self));
+        return;
+      }
+
+      if (!ec && !ring_->ring_)
+        ec = asio::error::bad_descriptor;
+
+      if (ec)
+        self.complete(ec, packet_batch());
+      else if (ring_->next_ready_block())
+        self.complete(ec, ring_->try_receive());
+      else
+        ring_->socket_.async_wait(socket_base::wait_read,
+            static_cast<Self&&>(self));
+    }
+
+  private:
+    basic_packet_ring* ring_;
+    bool started_;
+  };
+
+  basic_raw_socket<generic::raw_protocol, Executor> socket_;
+  void* ring_;
+  std::size_t ring_size_;
+  std::size_t block_size_;
+  std::size_t block_count_;
+  std::size_t next_block_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_PACKET_RING)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_BASIC_PACKET_RING_HPP
@@ -63,6 +63,8 @@ class basic_random_access_file
 private:
   class initiate_async_write_some_at;
   class initiate_async_read_some_at;
+  class initiate_async_write_batch_at;
+  class initiate_async_read_batch_at;
 
 public:
   /// The type of the executor associated with the object.
@@ -606,6 +608,135 @@ public:
         initiate_async_read_some_at(this), token, offset, buffers);
   }
 
+  /// Start an asynchronous batch of writes at specified offsets.
+  /**
+   * This function is used to asynchronously write data at many offsets in the
+   * random-access file. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * All of the writes are started together and may complete in any order.
+   * Where the implementation uses io_uring, the writes are submitted to the
+   * kernel in a single system call, rather than being queued behind one
+   * another as for separate calls to async_write_some_at(). The operation
+   * completes when every write has completed.
+   *
+   * @param requests A pointer to an array of write requests. Each request's
+   * @c error and @c bytes_transferred members are set to the result of its
+   * write. Ownership of the requests and of the data they refer to is
+   * retained by the caller, which must guarantee that they remain valid until
+   * the completion handler is called.
+   *
+   * @param count The number of requests in the array.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the writes complete.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   // The error of the first request that failed, if any.
+   *   const asio::error_code& error,
+   *
+   *   // The total number of bytes written by all requests.
+   *   std::size_t bytes_transferred
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note Each write may not write all of the data in its request. A request
+   * that was not started reports error::operation_aborted.
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_write_batch_at(file_base::write_request* requests,
+      std::size_t count,
+      WriteToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<WriteToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_write_batch_at>(), token, requests, count))
+  {
+    return async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_write_batch_at(this), token, requests, count);
+  }
+
+  /// Start an asynchronous batch of reads at specified offsets.
+  /**
+   * This function is used to asynchronously read data from many offsets in
+   * the random-access file. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * All of the reads are started together and may complete in any order.
+   * Where the implementation uses io_uring, the reads are submitted to the
+   * kernel in a single system call, rather than being queued behind one
+   * another as for separate calls to async_read_some_at(). The operation
+   * completes when every read has completed.
+   *
+   * @param requests A pointer to an array of read requests. Each request's
+   * @c error and @c bytes_transferred members are set to the result of its
+   * read. Ownership of the requests and of the buffers they refer to is
+   * retained by the caller, which must guarantee that they remain valid until
+   * the completion handler is called.
+   *
+   * @param count The number of requests in the array.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the reads complete.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   // The error of the first request that failed, if any.
+   *   const asio::error_code& error,
+   *
+   *   // The total number of bytes read by all requests.
+   *   std::size_t bytes_transferred
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note Each read may not read all of the data in its request. A request
+   * that was not started reports error::operation_aborted.
+   *
+   * @par Example
+   * @code
+   * std::vector<asio::aligned_buffer> blocks;
+   * std::vector<asio::random_access_file::read_request> requests;
+   * for (uint64_t offset : offsets)
+   * {
+   *   blocks.emplace_back(4096);
+   *   requests.emplace_back(offset, asio::buffer(blocks.back()));
+   * }
+   * file.async_read_batch_at(requests.data(), requests.size(), handler);
+   * @endcode
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_read_batch_at(file_base::read_request* requests, std::size_t count,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_read_batch_at>(), token, requests, count))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_read_batch_at(this), token, requests, count);
+  }
+
 private:
   // Disallow copying and assignment.
   basic_random_access_file(const basic_random_access_file&) = delete;
@@ -677,6 +808,72 @@ private:
   private:
     basic_random_access_file* self_;
   };
+
+  class initiate_async_write_batch_at
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_write_batch_at(basic_random_access_file* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler>
+    void operator()(WriteHandler&& handler,
+        file_base::write_request* requests, std::size_t count) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_write_batch_at(
+          self_->impl_.get_implementation(), requests, count,
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_random_access_file* self_;
+  };
+
+  class initiate_async_read_batch_at
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_read_batch_at(basic_random_access_file* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler>
+    void operator()(ReadHandler&& handler,
+        file_base::read_request* requests, std::size_t count) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_read_batch_at(
+          self_->impl_.get_implementation(), requests, count,
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_random_access_file* self_;
+  };
 };
 
 } // namespace asio
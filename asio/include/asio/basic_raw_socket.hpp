@@ -325,6 +325,63 @@ public:
     return *this;
   }
 
+  /// Move-construct a basic_raw_socket from another, transferring it to a new
+  /// executor.
+  /**
+   * This constructor moves an open raw socket to the execution context of @c ex
+   * without closing and reopening it, retaining the socket's native handle and
+   * state.
+   *
+   * @param ex The I/O executor that the socket will use, by default, to
+   * dispatch handlers for any asynchronous operations performed on the socket.
+   *
+   * @param other The other basic_raw_socket object from which the move will
+   * occur. Any asynchronous operations outstanding on @c other are cancelled,
+   * and their handlers are passed the asio::error::operation_aborted error.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Following the move, the moved-from object is in the same state as if
+   * constructed using the @c basic_raw_socket(const executor_type&)
+   * constructor.
+   */
+  template <typename Executor1>
+  basic_raw_socket(const executor_type& ex,
+      basic_raw_socket<Protocol, Executor1>&& other)
+    : basic_socket<Protocol, Executor>(ex, std::move(other))
+  {
+  }
+
+  /// Move-construct a basic_raw_socket from another, transferring it to a new
+  /// execution context.
+  /**
+   * This constructor moves an open raw socket to @c context without closing and
+   * reopening it, retaining the socket's native handle and state.
+   *
+   * @param context An execution context which provides the I/O executor that
+   * the socket will use, by default, to dispatch handlers for any asynchronous
+   * operations performed on the socket.
+   *
+   * @param other The other basic_raw_socket object from which the move will
+   * occur. Any asynchronous operations outstanding on @c other are cancelled,
+   * and their handlers are passed the asio::error::operation_aborted error.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Following the move, the moved-from object is in the same state as if
+   * constructed using the @c basic_raw_socket(const executor_type&)
+   * constructor.
+   */
+  template <typename ExecutionContext, typename Executor1>
+  basic_raw_socket(ExecutionContext& context,
+      basic_raw_socket<Protocol, Executor1>&& other,
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      > = 0)
+    : basic_socket<Protocol, Executor>(context, std::move(other))
+  {
+  }
+
   /// Destroys the socket.
   /**
    * This function destroys the socket, cancelling any outstanding asynchronous
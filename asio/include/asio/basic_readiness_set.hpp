@@ -0,0 +1,582 @@
+//
+// basic_readiness_set.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_BASIC_READINESS_SET_HPP
+#define ASIO_BASIC_READINESS_SET_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_READINESS_SET) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <climits>
+#include <cstddef>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include "asio/any_io_executor.hpp"
+#include "asio/compose.hpp"
+#include "asio/error.hpp"
+#include "asio/post.hpp"
+#include "asio/posix/basic_stream_descriptor.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// The readiness of one descriptor, as reported by a readiness set.
+/**
+ * A readiness_event has the same layout as the native @c epoll_event
+ * structure, so that an array of them is filled directly by the kernel.
+ */
+class readiness_event
+{
+public:
+  /// The native representation of a descriptor.
+  typedef int native_handle_type;
+
+  /// Get the descriptor that is ready.
+  native_handle_type native_handle() const noexcept
+  {
+    return event_.data.fd;
+  }
+
+  /// Determine whether the descriptor is ready for reading.
+  bool readable() const noexcept
+  {
+    return (event_.events & EPOLLIN) != 0;
+  }
+
+  /// Determine whether the descriptor is ready for writing.
+  bool writable() const noexcept
+  {
+    return (event_.events & EPOLLOUT) != 0;
+  }
+
+  /// Determine whether the descriptor has priority data to read.
+  bool priority() const noexcept
+  {
+    return (event_.events & EPOLLPRI) != 0;
+  }
+
+  /// Determine whether the peer has hung up.
+  bool hangup() const noexcept
+  {
+    return (event_.events & EPOLLHUP) != 0;
+  }
+
+  /// Determine whether an error is pending on the descriptor.
+  bool error() const noexcept
+  {
+    return (event_.events & EPOLLERR) != 0;
+  }
+
+private:
+  template <typename> friend class basic_readiness_set;
+
+  ::epoll_event event_;
+};
+
+/// Waits for readiness on many descriptors with a single operation.
+/**
+ * The basic_readiness_set class template reports which of a set of
+ * descriptors are ready for non-blocking I/O. It is intended for integrating
+ * libraries that perform their own non-blocking calls, where a separate
+ * basic_socket::async_wait() per descriptor would cost one reactor operation
+ * and one handler invocation each.
+ *
+ * The set is a private epoll instance. Descriptors are added to it with
+ * level-triggered interest, and the set itself is waited on through the
+ * reactor in the same way as a socket. When the wait completes, the ready
+ * descriptors are written directly into a caller-supplied array of
+ * readiness_event objects, and the handler is invoked once with their number.
+ * Descriptors that remain ready are reported again by the next wait.
+ *
+ * The set does not take ownership of the descriptors added to it. A
+ * descriptor should be removed from the set before it is closed.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code
+ * asio::readiness_set set(my_context);
+ * set.open();
+ * set.add(socket.native_handle(), asio::readiness_set::interest_read);
+ *
+ * asio::readiness_event events[64];
+ * set.async_wait(events, 64,
+ *     [&](asio::error_code ec, std::size_t n)
+ *     {
+ *       for (std::size_t i = 0; !ec && i < n; ++i)
+ *         on_ready(events[i].native_handle());
+ *     });
+ * @endcode
+ */
+template <typename Executor = any_io_executor>
+class basic_readiness_set
+{
+private:
+  class wait_op;
+
+public:
+  /// The type of the executor associated with the object.
+  typedef Executor executor_type;
+
+  /// Rebinds the readiness set type to another executor.
+  template <typename Executor1>
+  struct rebind_executor
+  {
+    /// The readiness set type when rebound to the specified executor.
+    typedef basic_readiness_set<Executor1> other;
+  };
+
+  /// The native representation of the set.
+  typedef int native_handle_type;
+
+  /// Bitmask type for the readiness in which a descriptor is interested.
+  typedef int interest_flags;
+
+#if defined(GENERATING_DOCUMENTATION)
+  /// Interest in the descriptor becoming ready for reading.
+  static const int interest_read = implementation_defined;
+
+  /// Interest in the descriptor becoming ready for writing.
+  static const int interest_write = implementation_defined;
+
+  /// Interest in the descriptor having priority data to read.
+  static const int interest_priority = implementation_defined;
+#else
+  ASIO_STATIC_CONSTANT(int, interest_read = EPOLLIN);
+  ASIO_STATIC_CONSTANT(int, interest_write = EPOLLOUT);
+  ASIO_STATIC_CONSTANT(int, interest_priority = EPOLLPRI);
+#endif
+
+  /// Construct a readiness set without opening it.
+  explicit basic_readiness_set(const executor_type& ex)
+    : descriptor_(ex)
+  {
+  }
+
+  /// Construct a readiness set without opening it.
+  template <typename ExecutionContext>
+  explicit basic_readiness_set(ExecutionContext& context,
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      > = 0)
+    : descriptor_(context)
+  {
+  }
+
+  /// Destructor. Cancels any outstanding operation and closes the set.
+  ~basic_readiness_set()
+  {
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() noexcept
+  {
+    return descriptor_.get_executor();
+  }
+
+  /// Open the readiness set.
+  /**
+   * @throws asio::system_error Thrown on failure.
+   */
+  void open()
+  {
+    asio::error_code ec;
+    open(ec);
+    asio::detail::throw_error(ec, "open");
+  }
+
+  /// Open the readiness set.
+  /**
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID open(asio::error_code& ec)
+  {
+    if (is_open())
+    {
+      ec = asio::error::already_open;
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    int fd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (fd == -1)
+    {
+      ec = asio::error_code(errno, asio::error::get_system_category());
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    descriptor_.assign(fd, ec);
+    if (ec)
+      ::close(fd);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Determine whether the readiness set is open.
+  bool is_open() const noexcept
+  {
+    return descriptor_.is_open();
+  }
+
+  /// Close the readiness set.
+  /**
+   * Any asynchronous wait operation is cancelled immediately, and will
+   * complete with the asio::error::operation_aborted error. The descriptors
+   * that were added to the set are not affected.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void close()
+  {
+    descriptor_.close();
+  }
+
+  /// Close the readiness set.
+  /**
+   * Any asynchronous wait operation is cancelled immediately, and will
+   * complete with the asio::error::operation_aborted error. The descriptors
+   * that were added to the set are not affected.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID close(asio::error_code& ec)
+  {
+    descriptor_.close(ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Get the native representation of the set.
+  native_handle_type native_handle()
+  {
+    return descriptor_.native_handle();
+  }
+
+  /// Cancel any asynchronous wait operation.
+  /**
+   * @throws asio::system_error Thrown on failure.
+   */
+  void cancel()
+  {
+    descriptor_.cancel();
+  }
+
+  /// Add a descriptor to the set.
+  /**
+   * @param descriptor The descriptor to add.
+   *
+   * @param interest The readiness to report, as a combination of
+   * interest_read, interest_write and interest_priority. Hang-ups and errors
+   * are always reported.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void add(readiness_event::native_handle_type descriptor,
+      interest_flags interest)
+  {
+    asio::error_code ec;
+    add(descriptor, interest, ec);
+    asio::detail::throw_error(ec, "add");
+  }
+
+  /// Add a descriptor to the set.
+  /**
+   * @param descriptor The descriptor to add.
+   *
+   * @param interest The readiness to report, as a combination of
+   * interest_read, interest_write and interest_priority. Hang-ups and errors
+   * are always reported.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID add(readiness_event::native_handle_type descriptor,
+      interest_flags interest, asio::error_code& ec)
+  {
+    control(EPOLL_CTL_ADD, descriptor, interest, ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Change the readiness reported for a descriptor in the set.
+  /**
+   * @param descriptor A descriptor that has been added to the set.
+   *
+   * @param interest The readiness to report, as a combination of
+   * interest_read, interest_write and interest_priority.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void modify(readiness_event::native_handle_type descriptor,
+      interest_flags interest)
+  {
+    asio::error_code ec;
+    modify(descriptor, interest, ec);
+    asio::detail::throw_error(ec, "modify");
+  }
+
+  /// Change the readiness reported for a descriptor in the set.
+  /**
+   * @param descriptor A descriptor that has been added to the set.
+   *
+   * @param interest The readiness to report, as a combination of
+   * interest_read, interest_write and interest_priority.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID modify(readiness_event::native_handle_type descriptor,
+      interest_flags interest, asio::error_code& ec)
+  {
+    control(EPOLL_CTL_MOD, descriptor, interest, ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Remove a descriptor from the set.
+  /**
+   * @throws asio::system_error Thrown on failure.
+   */
+  void remove(readiness_event::native_handle_type descriptor)
+  {
+    asio::error_code ec;
+    remove(descriptor, ec);
+    asio::detail::throw_error(ec, "remove");
+  }
+
+  /// Remove a descriptor from the set.
+  /**
+   * @param descriptor A descriptor that has been added to the set.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID remove(readiness_event::native_handle_type descriptor,
+      asio::error_code& ec)
+  {
+    control(EPOLL_CTL_DEL, descriptor, 0, ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Obtain the ready descriptors without blocking.
+  /**
+   * @param events The array into which the ready descriptors are written.
+   *
+   * @param max_events The number of elements in @c events.
+   *
+   * @returns The number of ready descriptors written to @c events, which is
+   * 0 if no descriptor is ready.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  std::size_t poll(readiness_event* events, std::size_t max_events)
+  {
+    asio::error_code ec;
+    std::size_t n = poll(events, max_events, ec);
+    asio::detail::throw_error(ec, "poll");
+    return n;
+  }
+
+  /// Obtain the ready descriptors without blocking.
+  /**
+   * @param events The array into which the ready descriptors are written.
+   *
+   * @param max_events The number of elements in @c events.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of ready descriptors written to @c events, which is
+   * 0 if no descriptor is ready or an error occurred.
+   */
+  std::size_t poll(readiness_event* events, std::size_t max_events,
+      asio::error_code& ec)
+  {
+    if (!is_open())
+    {
+      ec = asio::error::bad_descriptor;
+      return 0;
+    }
+
+    if (max_events == 0)
+    {
+      ec = asio::error::invalid_argument;
+      return 0;
+    }
+
+    static_assert(sizeof(readiness_event) == sizeof(::epoll_event),
+        "readiness_event must have the layout of epoll_event");
+
+    int max = max_events > INT_MAX ? INT_MAX : static_cast<int>(max_events);
+    for (;;)
+    {
+      int n = ::epoll_wait(descriptor_.native_handle(),
+          &events[0].event_, max, 0);
+      if (n >= 0)
+      {
+        ec.assign(0, ec.category());
+        return static_cast<std::size_t>(n);
+      }
+      if (errno != EINTR)
+      {
+        ec = asio::error_code(errno, asio::error::get_system_category());
+        return 0;
+      }
+    }
+  }
+
+  /// Start an asynchronous wait for descriptors in the set to become ready.
+  /**
+   * This function is used to asynchronously wait until at least one
+   * descriptor in the set is ready. The ready descriptors are then written to
+   * the @c events array. If a descriptor is already ready then the operation
+   * completes without waiting, although the completion handler is not invoked
+   * from within this function.
+   *
+   * At most one wait operation may be outstanding at a time.
+   *
+   * @param events The array into which the ready descriptors are written.
+   * Ownership of the array is retained by the caller, which must guarantee
+   * that it remains valid until the completion handler is called.
+   *
+   * @param max_events The number of elements in @c events. Any further ready
+   * descriptors are reported by a later wait or poll.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the wait completes.
+   * The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t n // The number of ready descriptors written to events.
+   * ); @endcode
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code, std::size_t))
+        WaitToken = default_completion_token_t<executor_type>>
+  auto async_wait(readiness_event* events, std::size_t max_events,
+      WaitToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_compose<WaitToken, void (asio::error_code, std::size_t)>(
+        declval<wait_op>(), token,
+        declval<posix::basic_stream_descriptor<Executor>&>()))
+  {
+    return async_compose<WaitToken, void (asio::error_code, std::size_t)>(
+        wait_op(this, events, max_events), token, descriptor_);
+  }
+
+private:
+  // Disallow copying and assignment.
+  basic_readiness_set(const basic_readiness_set&) = delete;
+  basic_readiness_set& operator=(const basic_readiness_set&) = delete;
+
+  // Add, modify or remove the registration of a descriptor.
+  void control(int op, readiness_event::native_handle_type descriptor,
+      interest_flags interest, asio::error_code& ec)
+  {
+    if (!is_open())
+    {
+      ec = asio::error::bad_descriptor;
+      return;
+    }
+
+    ::epoll_event ev = { 0, { 0 } };
+    ev.events = static_cast<unsigned int>(
+        interest & (EPOLLIN | EPOLLOUT | EPOLLPRI));
+    ev.data.fd = descriptor;
+    if (::epoll_ctl(descriptor_.native_handle(), op, descriptor, &ev) != 0)
+      ec = asio::error_code(errno, asio::error::get_system_category());
+    else
+      ec.assign(0, ec.category());
+  }
+
+  // Obtains the ready descriptors, waiting for the set to become readable
+  // when none is ready. When no wait is needed on the first check, the
+  // operation is posted so that it does not complete from within
+  // async_wait().
+  class wait_op
+  {
+  public:
+    wait_op(basic_readiness_set* set,
+        readiness_event* events, std::size_t max_events)
+      : set_(set),
+        events_(events),
+        max_events_(max_events),
+        ready_(0),
+        started_(false)
+    {
+    }
+
+    template <typename Self>
+    void operator()(Self& self, asio::error_code ec = asio::error_code())
+    {
+      if (!started_)
+      {
+        started_ = true;
+        ready_ = set_->poll(events_, max_events_, ec);
+        if (ec || ready_ > 0)
+        {
+          asio::post(set_->descriptor_.get_executor(),
+              asio::detail::bind_handler(static_cast<Self&&>(self), ec));
+        }
+        else
+        {
+          set_->descriptor_.async_wait(
+              posix::descriptor_base::wait_read, static_cast<Self&&>(self));
+        }
+        return;
+      }
+
+      if (!ec && ready_ == 0)
+        ready_ = set_->poll(events_, max_events_, ec);
+
+      if (ec)
+        self.complete(ec, 0);
+      else if (ready_ > 0)
+        self.complete(ec, ready_);
+      else
+        set_->descriptor_.async_wait(
+            posix::descriptor_base::wait_read, static_cast<Self&&>(self));
+    }
+
+  private:
+    basic_readiness_set* set_;
+    readiness_event* events_;
+    std::size_t max_events_;
+    std::size_t ready_;
+    bool started_;
+  };
+
+  posix::basic_stream_descriptor<Executor> descriptor_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_READINESS_SET)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_BASIC_READINESS_SET_HPP
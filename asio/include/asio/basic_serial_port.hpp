@@ -546,6 +546,40 @@ public:
     ASIO_SYNC_OP_VOID_RETURN(ec);
   }
 
+  /// Determine the number of bytes available for reading.
+  /**
+   * This function is used to determine the number of bytes that may be read
+   * without blocking.
+   *
+   * @return The number of bytes that may be read without blocking, or 0 if an
+   * error occurs.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  std::size_t available() const
+  {
+    asio::error_code ec;
+    std::size_t s = impl_.get_service().available(
+        impl_.get_implementation(), ec);
+    asio::detail::throw_error(ec, "available");
+    return s;
+  }
+
+  /// Determine the number of bytes available for reading.
+  /**
+   * This function is used to determine the number of bytes that may be read
+   * without blocking.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @return The number of bytes that may be read without blocking, or 0 if an
+   * error occurs.
+   */
+  std::size_t available(asio::error_code& ec) const
+  {
+    return impl_.get_service().available(impl_.get_implementation(), ec);
+  }
+
   /// Set an option on the serial port.
   /**
    * This function is used to set an option on the serial port.
@@ -559,7 +593,9 @@ public:
    * asio::serial_port_base::flow_control @n
    * asio::serial_port_base::parity @n
    * asio::serial_port_base::stop_bits @n
-   * asio::serial_port_base::character_size
+   * asio::serial_port_base::character_size @n
+   * asio::serial_port_base::read_timing @n
+   * asio::serial_port_base::low_latency
    */
   template <typename SettableSerialPortOption>
   void set_option(const SettableSerialPortOption& option)
@@ -582,7 +618,9 @@ public:
    * asio::serial_port_base::flow_control @n
    * asio::serial_port_base::parity @n
    * asio::serial_port_base::stop_bits @n
-   * asio::serial_port_base::character_size
+   * asio::serial_port_base::character_size @n
+   * asio::serial_port_base::read_timing @n
+   * asio::serial_port_base::low_latency
    */
   template <typename SettableSerialPortOption>
   ASIO_SYNC_OP_VOID set_option(const SettableSerialPortOption& option,
@@ -606,7 +644,9 @@ public:
    * asio::serial_port_base::flow_control @n
    * asio::serial_port_base::parity @n
    * asio::serial_port_base::stop_bits @n
-   * asio::serial_port_base::character_size
+   * asio::serial_port_base::character_size @n
+   * asio::serial_port_base::read_timing @n
+   * asio::serial_port_base::low_latency
    */
   template <typename GettableSerialPortOption>
   void get_option(GettableSerialPortOption& option) const
@@ -630,7 +670,9 @@ public:
    * asio::serial_port_base::flow_control @n
    * asio::serial_port_base::parity @n
    * asio::serial_port_base::stop_bits @n
-   * asio::serial_port_base::character_size
+   * asio::serial_port_base::character_size @n
+   * asio::serial_port_base::read_timing @n
+   * asio::serial_port_base::low_latency
    */
   template <typename GettableSerialPortOption>
   ASIO_SYNC_OP_VOID get_option(GettableSerialPortOption& option,
@@ -92,6 +92,14 @@ namespace asio {
  * and @c pthread_sigmask(). For signals to be delivered, programs must ensure
  * that any signals registered using signal_set objects are unblocked in at
  * least one thread.
+ *
+ * On Linux, an execution context may instead be configured to receive signals
+ * using a signalfd, by setting the @c signal.signalfd configuration option.
+ * Signals received in this way are delivered without synchronising with other
+ * execution contexts, and signals that occur together are delivered as a
+ * batch. The program must block the signals in all threads, and a signal is
+ * then delivered to only one of the execution contexts that registers it.
+ * Flags other than signal_set_base::flags::dont_care are not supported.
  */
 template <typename Executor = any_io_executor>
 class basic_signal_set : public signal_set_base
@@ -28,16 +28,10 @@
 #include "asio/execution_context.hpp"
 #include "asio/post.hpp"
 #include "asio/socket_base.hpp"
+#include "asio/socket_timestamp.hpp"
+#include "asio/detail/socket_tx_timestamp_op.hpp"
 
-#if defined(ASIO_WINDOWS_RUNTIME)
-# include "asio/detail/null_socket_service.hpp"
-#elif defined(ASIO_HAS_IOCP)
-# include "asio/detail/win_iocp_socket_service.hpp"
-#elif defined(ASIO_HAS_IO_URING_AS_DEFAULT)
-# include "asio/detail/io_uring_socket_service.hpp"
-#else
-# include "asio/detail/reactive_socket_service.hpp"
-#endif
+#include "asio/detail/default_socket_service.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -68,6 +62,11 @@ class basic_socket
 private:
   class initiate_async_connect;
   class initiate_async_wait;
+  class initiate_async_close;
+  class initiate_async_shutdown;
+#if defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+  class initiate_async_receive_tx_timestamp;
+#endif // defined(ASIO_HAS_SOCKET_TIMESTAMPING)
 
 public:
   /// The type of the executor associated with the object.
@@ -84,18 +83,9 @@ public:
   /// The native representation of a socket.
 #if defined(GENERATING_DOCUMENTATION)
   typedef implementation_defined native_handle_type;
-#elif defined(ASIO_WINDOWS_RUNTIME)
-  typedef typename detail::null_socket_service<
-    Protocol>::native_handle_type native_handle_type;
-#elif defined(ASIO_HAS_IOCP)
-  typedef typename detail::win_iocp_socket_service<
-    Protocol>::native_handle_type native_handle_type;
-#elif defined(ASIO_HAS_IO_URING_AS_DEFAULT)
-  typedef typename detail::io_uring_socket_service<
-    Protocol>::native_handle_type native_handle_type;
 #else
-  typedef typename detail::reactive_socket_service<
-    Protocol>::native_handle_type native_handle_type;
+  typedef typename detail::default_socket_service<
+    Protocol>::type::native_handle_type native_handle_type;
 #endif
 
   /// The protocol type.
@@ -367,6 +357,81 @@ public:
     return *this;
   }
 
+  /// Move-construct a basic_socket from another, transferring it to a new
+  /// executor.
+  /**
+   * This constructor moves an open socket to the execution context of @c ex
+   * without closing and reopening it. The socket's native handle, its
+   * non-blocking modes and any internally buffered state are retained, and its
+   * registration is moved from the reactor of the source context to that of
+   * the target context.
+   *
+   * @param ex The I/O executor that the socket will use, by default, to
+   * dispatch handlers for any asynchronous operations performed on the socket.
+   *
+   * @param other The other basic_socket object from which the move will
+   * occur. Any asynchronous operations outstanding on @c other are cancelled,
+   * and their handlers are passed the asio::error::operation_aborted error.
+   *
+   * @throws asio::system_error Thrown on failure. When sockets are
+   * implemented using I/O completion ports, moving a socket between
+   * execution contexts that do not share a completion port fails with
+   * asio::error::operation_not_supported.
+   *
+   * @note Following the move, the moved-from object is in the same state as if
+   * constructed using the @c basic_socket(const executor_type&) constructor.
+   * On failure, @c other is unchanged.
+   */
+  template <typename Executor1>
+  basic_socket(const executor_type& ex,
+      basic_socket<Protocol, Executor1>&& other)
+    : impl_(0, ex)
+  {
+    asio::error_code ec;
+    impl_.get_service().transfer(impl_.get_implementation(),
+        other.impl_.get_service(), other.impl_.get_implementation(), ec);
+    asio::detail::throw_error(ec, "transfer");
+  }
+
+  /// Move-construct a basic_socket from another, transferring it to a new
+  /// execution context.
+  /**
+   * This constructor moves an open socket to @c context without closing and
+   * reopening it. The socket's native handle, its non-blocking modes and any
+   * internally buffered state are retained, and its registration is moved from
+   * the reactor of the source context to that of the target context.
+   *
+   * @param context An execution context which provides the I/O executor that
+   * the socket will use, by default, to dispatch handlers for any asynchronous
+   * operations performed on the socket.
+   *
+   * @param other The other basic_socket object from which the move will
+   * occur. Any asynchronous operations outstanding on @c other are cancelled,
+   * and their handlers are passed the asio::error::operation_aborted error.
+   *
+   * @throws asio::system_error Thrown on failure. When sockets are
+   * implemented using I/O completion ports, moving a socket between
+   * execution contexts that do not share a completion port fails with
+   * asio::error::operation_not_supported.
+   *
+   * @note Following the move, the moved-from object is in the same state as if
+   * constructed using the @c basic_socket(const executor_type&) constructor.
+   * On failure, @c other is unchanged.
+   */
+  template <typename ExecutionContext, typename Executor1>
+  basic_socket(ExecutionContext& context,
+      basic_socket<Protocol, Executor1>&& other,
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      > = 0)
+    : impl_(0, 0, context)
+  {
+    asio::error_code ec;
+    impl_.get_service().transfer(impl_.get_implementation(),
+        other.impl_.get_service(), other.impl_.get_implementation(), ec);
+    asio::detail::throw_error(ec, "transfer");
+  }
+
   /// Get the executor associated with the object.
   const executor_type& get_executor() noexcept
   {
@@ -542,6 +607,64 @@ public:
     ASIO_SYNC_OP_VOID_RETURN(ec);
   }
 
+  /// Start an asynchronous operation to close the socket.
+  /**
+   * This function is used to asynchronously close the socket. It is an
+   * initiating function for an @ref asynchronous_operation, and always returns
+   * immediately.
+   *
+   * As with close(), any asynchronous send, receive or connect operations are
+   * cancelled immediately, and the socket object is closed and may be reopened
+   * or destroyed as soon as this function returns. The underlying descriptor,
+   * however, is closed without blocking the calling thread. When io_uring is
+   * used the close is submitted to the kernel, and otherwise it is performed
+   * on an internal thread. This allows many sockets to be closed at once, or
+   * a socket that lingers to send unsent data to be closed, without holding
+   * up the thread running the I/O execution context.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the close completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   *
+   * @par Example
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * socket.async_close(
+   *     [](asio::error_code ec)
+   *     {
+   *       // The descriptor has been closed.
+   *     });
+   * @endcode
+   *
+   * @note On Windows, the socket is closed immediately and the completion
+   * handler is then posted.
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        CloseToken = default_completion_token_t<executor_type>>
+  auto async_close(
+      CloseToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<CloseToken, void (asio::error_code)>(
+          declval<initiate_async_close>(), token))
+  {
+    return async_initiate<CloseToken, void (asio::error_code)>(
+        initiate_async_close(this), token);
+  }
+
   /// Release ownership of the underlying native socket.
   /**
    * This function causes all outstanding asynchronous connect, send and receive
@@ -1710,6 +1833,60 @@ public:
     ASIO_SYNC_OP_VOID_RETURN(ec);
   }
 
+  /// Start an asynchronous operation to disable sends or receives on the
+  /// socket.
+  /**
+   * This function is used to asynchronously disable send operations, receive
+   * operations, or both. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * When io_uring is used the shutdown is submitted to the kernel. Otherwise,
+   * the shutdown is performed immediately and the completion handler is then
+   * posted.
+   *
+   * @param what Determines what types of operation will no longer be allowed.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the shutdown completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   *
+   * @par Example
+   * Shutting down the send side of the socket:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * socket.async_shutdown(asio::ip::tcp::socket::shutdown_send,
+   *     [](asio::error_code ec)
+   *     {
+   *       // ...
+   *     });
+   * @endcode
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        ShutdownToken = default_completion_token_t<executor_type>>
+  auto async_shutdown(shutdown_type what,
+      ShutdownToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ShutdownToken, void (asio::error_code)>(
+          declval<initiate_async_shutdown>(), token, what))
+  {
+    return async_initiate<ShutdownToken, void (asio::error_code)>(
+        initiate_async_shutdown(this), token, what);
+  }
+
   /// Wait for the socket to become ready to read, ready to write, or to have
   /// pending error conditions.
   /**
@@ -1824,6 +2001,66 @@ public:
         initiate_async_wait(this), token, w);
   }
 
+#if defined(ASIO_HAS_SOCKET_TIMESTAMPING) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous operation to read a transmit timestamp.
+  /**
+   * This function is used to asynchronously read the next timestamp that the
+   * kernel, or the network device, generated for data sent on the socket. The
+   * timestamps are queued on the socket's error queue once transmit
+   * timestamps have been enabled using the socket_base::timestamping socket
+   * option. It is an initiating function for an @ref asynchronous_operation,
+   * and always returns immediately.
+   *
+   * @param timestamp A socket_timestamp object that receives the transmit
+   * timestamp. Ownership of the timestamp object is retained by the caller,
+   * which must guarantee that it is valid until the completion handler is
+   * called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when a timestamp has been read.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   *
+   * @note Use socket_base::timestamp_opt_id to match each timestamp, through
+   * socket_timestamp::id, with the data for which it was generated.
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        WaitToken = default_completion_token_t<executor_type>>
+  auto async_receive_tx_timestamp(socket_timestamp& timestamp,
+      WaitToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<WaitToken, void (asio::error_code)>(
+          declval<initiate_async_receive_tx_timestamp>(), token, &timestamp))
+  {
+    return async_initiate<WaitToken, void (asio::error_code)>(
+        initiate_async_receive_tx_timestamp(this), token, &timestamp);
+  }
+#endif // defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+       //   || defined(GENERATING_DOCUMENTATION)
+
 protected:
   /// Protected destructor to prevent deletion through this type.
   /**
@@ -1834,19 +2071,8 @@ protected:
   {
   }
 
-#if defined(ASIO_WINDOWS_RUNTIME)
-  detail::io_object_impl<
-    detail::null_socket_service<Protocol>, Executor> impl_;
-#elif defined(ASIO_HAS_IOCP)
-  detail::io_object_impl<
-    detail::win_iocp_socket_service<Protocol>, Executor> impl_;
-#elif defined(ASIO_HAS_IO_URING_AS_DEFAULT)
-  detail::io_object_impl<
-    detail::io_uring_socket_service<Protocol>, Executor> impl_;
-#else
   detail::io_object_impl<
-    detail::reactive_socket_service<Protocol>, Executor> impl_;
-#endif
+    typename detail::default_socket_service<Protocol>::type, Executor> impl_;
 
 private:
   // Disallow copying and assignment.
@@ -1896,6 +2122,70 @@ private:
     basic_socket* self_;
   };
 
+  class initiate_async_close
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_close(basic_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename CloseHandler>
+    void operator()(CloseHandler&& handler) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WaitHandler.
+      ASIO_WAIT_HANDLER_CHECK(CloseHandler, handler) type_check;
+
+      detail::non_const_lvalue<CloseHandler> handler2(handler);
+      self_->impl_.get_service().async_close(
+          self_->impl_.get_implementation(),
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_socket* self_;
+  };
+
+  class initiate_async_shutdown
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_shutdown(basic_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ShutdownHandler>
+    void operator()(ShutdownHandler&& handler, shutdown_type what) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ShutdownHandler.
+      ASIO_SHUTDOWN_HANDLER_CHECK(ShutdownHandler, handler) type_check;
+
+      detail::non_const_lvalue<ShutdownHandler> handler2(handler);
+      self_->impl_.get_service().async_shutdown(
+          self_->impl_.get_implementation(), what,
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_socket* self_;
+  };
+
   class initiate_async_wait
   {
   public:
@@ -1927,6 +2217,39 @@ private:
   private:
     basic_socket* self_;
   };
+
+#if defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+  class initiate_async_receive_tx_timestamp
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_tx_timestamp(basic_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WaitHandler>
+    void operator()(WaitHandler&& handler, socket_timestamp* timestamp) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WaitHandler.
+      ASIO_WAIT_HANDLER_CHECK(WaitHandler, handler) type_check;
+
+      detail::non_const_lvalue<WaitHandler> handler2(handler);
+      detail::socket_tx_timestamp_op<basic_socket, decay_t<WaitHandler>>(
+          *self_, timestamp, handler2.value).start();
+    }
+
+  private:
+    basic_socket* self_;
+  };
+#endif // defined(ASIO_HAS_SOCKET_TIMESTAMPING)
 };
 
 } // namespace asio
@@ -28,15 +28,7 @@
 #include "asio/execution_context.hpp"
 #include "asio/socket_base.hpp"
 
-#if defined(ASIO_WINDOWS_RUNTIME)
-# include "asio/detail/null_socket_service.hpp"
-#elif defined(ASIO_HAS_IOCP)
-# include "asio/detail/win_iocp_socket_service.hpp"
-#elif defined(ASIO_HAS_IO_URING_AS_DEFAULT)
-# include "asio/detail/io_uring_socket_service.hpp"
-#else
-# include "asio/detail/reactive_socket_service.hpp"
-#endif
+#include "asio/detail/default_socket_service.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -101,18 +93,9 @@ public:
   /// The native representation of an acceptor.
 #if defined(GENERATING_DOCUMENTATION)
   typedef implementation_defined native_handle_type;
-#elif defined(ASIO_WINDOWS_RUNTIME)
-  typedef typename detail::null_socket_service<
-    Protocol>::native_handle_type native_handle_type;
-#elif defined(ASIO_HAS_IOCP)
-  typedef typename detail::win_iocp_socket_service<
-    Protocol>::native_handle_type native_handle_type;
-#elif defined(ASIO_HAS_IO_URING_AS_DEFAULT)
-  typedef typename detail::io_uring_socket_service<
-    Protocol>::native_handle_type native_handle_type;
 #else
-  typedef typename detail::reactive_socket_service<
-    Protocol>::native_handle_type native_handle_type;
+  typedef typename detail::default_socket_service<
+    Protocol>::type::native_handle_type native_handle_type;
 #endif
 
   /// The protocol type.
@@ -2686,19 +2669,8 @@ private:
     basic_socket_acceptor* self_;
   };
 
-#if defined(ASIO_WINDOWS_RUNTIME)
-  detail::io_object_impl<
-    detail::null_socket_service<Protocol>, Executor> impl_;
-#elif defined(ASIO_HAS_IOCP)
-  detail::io_object_impl<
-    detail::win_iocp_socket_service<Protocol>, Executor> impl_;
-#elif defined(ASIO_HAS_IO_URING_AS_DEFAULT)
   detail::io_object_impl<
-    detail::io_uring_socket_service<Protocol>, Executor> impl_;
-#else
-  detail::io_object_impl<
-    detail::reactive_socket_service<Protocol>, Executor> impl_;
-#endif
+    typename detail::default_socket_service<Protocol>::type, Executor> impl_;
 };
 
 } // namespace asio
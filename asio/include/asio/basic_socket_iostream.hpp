@@ -196,6 +196,23 @@ public:
     return rdbuf()->socket();
   }
 
+  /// Change the sizes of the stream buffer's get and put areas.
+  /**
+   * @param get_size The maximum number of bytes to receive in a single system
+   * call.
+   *
+   * @param put_size The number of bytes of output to buffer before it is
+   * sent. A size of zero makes the output unbuffered.
+   *
+   * @note Output is flushed after every output operation unless the
+   * @c std::ios_base::unitbuf flag, which is set by default, is cleared.
+   */
+  void resize_buffers(std::size_t get_size, std::size_t put_size)
+  {
+    if (rdbuf()->resize_buffers(get_size, put_size) == 0)
+      this->setstate(std::ios_base::failbit);
+  }
+
   /// Get the last error associated with the stream.
   /**
    * @return An \c error_code corresponding to the last error from the stream.
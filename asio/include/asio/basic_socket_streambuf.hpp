@@ -19,6 +19,7 @@
 
 #if !defined(ASIO_NO_IOSTREAM)
 
+#include <cstring>
 #include <streambuf>
 #include <vector>
 #include "asio/basic_socket.hpp"
@@ -44,6 +45,21 @@ protected:
   {
   }
 
+  socket_streambuf_io_context(const shared_ptr<io_context>& ctx)
+    : default_io_context_(ctx)
+  {
+  }
+
+  // The streambuf performs its I/O with direct system calls, so its
+  // io_context is never run and serves only to own the socket service. A
+  // single io_context is shared by all default-constructed streambufs, rather
+  // than creating a scheduler and reactor for each one.
+  static shared_ptr<io_context> shared_io_context()
+  {
+    static const shared_ptr<io_context> ctx(new io_context);
+    return ctx;
+  }
+
   shared_ptr<io_context> default_io_context_;
 };
 
@@ -119,7 +135,7 @@ public:
 
   /// Construct a basic_socket_streambuf without establishing a connection.
   basic_socket_streambuf()
-    : detail::socket_streambuf_io_context(new io_context),
+    : detail::socket_streambuf_io_context(shared_io_context()),
       basic_socket<Protocol>(*default_io_context_),
       expiry_time_(max_expiry_time())
   {
@@ -231,6 +247,49 @@ public:
     return *this;
   }
 
+  /// Change the sizes of the get and put areas.
+  /**
+   * This function flushes any buffered output and then reallocates the
+   * stream buffer's get and put areas. Larger areas reduce the number of
+   * system calls needed to transfer bulk data. Input that has been received
+   * but not yet extracted is retained.
+   *
+   * @param get_size The maximum number of bytes to receive in a single system
+   * call.
+   *
+   * @param put_size The number of bytes of output to buffer before it is
+   * sent. A size of zero makes the output unbuffered.
+   *
+   * @return \c this if the buffered output was flushed and the areas resized,
+   * a null pointer otherwise.
+   */
+  basic_socket_streambuf* resize_buffers(
+      std::size_t get_size, std::size_t put_size)
+  {
+    if (pptr() != pbase()
+        && traits_type::eq_int_type(overflow(traits_type::eof()),
+          traits_type::eof()))
+      return 0;
+
+    std::size_t unread = egptr() - gptr();
+    std::vector<char> get_buffer(putback_max
+        + (get_size > unread ? get_size : (unread > 0 ? unread : 1)));
+    std::vector<char> put_buffer(put_size);
+
+    if (unread > 0)
+      std::memcpy(&get_buffer[putback_max], gptr(), unread);
+    get_buffer_.swap(get_buffer);
+    put_buffer_.swap(put_buffer);
+
+    setg(&get_buffer_[0], &get_buffer_[0] + putback_max,
+        &get_buffer_[0] + putback_max + unread);
+    if (put_buffer_.empty())
+      setp(0, 0);
+    else
+      setp(&put_buffer_[0], &put_buffer_[0] + put_buffer_.size());
+    return this;
+  }
+
   /// Get the last error associated with the stream buffer.
   /**
    * @return An \c error_code corresponding to the last error from the stream
@@ -298,9 +357,8 @@ protected:
         return traits_type::eof();
       }
 
-      // Try to complete the operation without blocking.
-      if (!socket().native_non_blocking())
-        socket().native_non_blocking(true, ec_);
+      // Perform the operation directly.
+      bool blocking = use_blocking_mode();
       detail::buffer_sequence_adapter<mutable_buffer, mutable_buffer>
         bufs(asio::buffer(get_buffer_) + putback_max);
       detail::signed_size_type bytes = detail::socket_ops::recv(
@@ -322,6 +380,8 @@ protected:
       }
 
       // Operation failed.
+      if (blocking && ec_ == asio::error::interrupted)
+        continue;
       if (ec_ != asio::error::would_block
           && ec_ != asio::error::try_again)
         return traits_type::eof();
@@ -365,9 +425,8 @@ protected:
         return traits_type::eof();
       }
 
-      // Try to complete the operation without blocking.
-      if (!socket().native_non_blocking())
-        socket().native_non_blocking(true, ec_);
+      // Perform the operation directly.
+      bool blocking = use_blocking_mode();
       detail::buffer_sequence_adapter<
         const_buffer, const_buffer> bufs(output_buffer);
       detail::signed_size_type bytes = detail::socket_ops::send(
@@ -381,6 +440,8 @@ protected:
       }
 
       // Operation failed.
+      if (blocking && ec_ == asio::error::interrupted)
+        continue;
       if (ec_ != asio::error::would_block
           && ec_ != asio::error::try_again)
         return traits_type::eof();
@@ -444,6 +505,23 @@ private:
       setp(&put_buffer_[0], &put_buffer_[0] + put_buffer_.size());
   }
 
+  // Put the socket into the mode used for reads and writes. When there is no
+  // expiry time the socket blocks, so that each transfer is a single system
+  // call. Otherwise the socket is non-blocking and waits are bounded by
+  // polling with a timeout. Returns whether the socket is in blocking mode.
+  bool use_blocking_mode()
+  {
+    bool blocking = expiry_time_ == max_expiry_time();
+    if (socket().native_non_blocking() == blocking)
+    {
+      asio::error_code ec;
+      socket().native_non_blocking(!blocking, ec);
+      if (ec)
+        return false;
+    }
+    return blocking;
+  }
+
   int timeout() const
   {
     int64_t msec = traits_helper::to_posix_duration(
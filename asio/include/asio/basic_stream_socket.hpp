@@ -23,6 +23,11 @@
 #include "asio/detail/non_const_lvalue.hpp"
 #include "asio/detail/throw_error.hpp"
 #include "asio/error.hpp"
+#include "asio/local/passed_fds.hpp"
+#include "asio/provided_buffer_ring.hpp"
+#include "asio/socket_timestamp.hpp"
+#include "asio/transport_info.hpp"
+#include "asio/detail/socket_option.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -62,7 +67,23 @@ class basic_stream_socket
 {
 private:
   class initiate_async_send;
+#if defined(ASIO_HAS_SOCKET_SEND_ALL)
+  class initiate_async_send_all;
+#endif // defined(ASIO_HAS_SOCKET_SEND_ALL)
   class initiate_async_receive;
+#if defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+  class initiate_async_receive_all;
+#endif // defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+#if defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+  class initiate_async_receive_multishot;
+#endif // defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+#if defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+  class initiate_async_receive_timestamped;
+#endif // defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+#if defined(ASIO_HAS_FD_PASSING)
+  class initiate_async_send_fds;
+  class initiate_async_receive_fds;
+#endif // defined(ASIO_HAS_FD_PASSING)
 
 public:
   /// The type of the executor associated with the object.
@@ -330,6 +351,63 @@ public:
     return *this;
   }
 
+  /// Move-construct a basic_stream_socket from another, transferring it to a
+  /// new executor.
+  /**
+   * This constructor moves an open stream socket to the execution context of @c
+   * ex without closing and reopening it, retaining the socket's native handle
+   * and state.
+   *
+   * @param ex The I/O executor that the socket will use, by default, to
+   * dispatch handlers for any asynchronous operations performed on the socket.
+   *
+   * @param other The other basic_stream_socket object from which the move will
+   * occur. Any asynchronous operations outstanding on @c other are cancelled,
+   * and their handlers are passed the asio::error::operation_aborted error.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Following the move, the moved-from object is in the same state as if
+   * constructed using the @c basic_stream_socket(const executor_type&)
+   * constructor.
+   */
+  template <typename Executor1>
+  basic_stream_socket(const executor_type& ex,
+      basic_stream_socket<Protocol, Executor1>&& other)
+    : basic_socket<Protocol, Executor>(ex, std::move(other))
+  {
+  }
+
+  /// Move-construct a basic_stream_socket from another, transferring it to a
+  /// new execution context.
+  /**
+   * This constructor moves an open stream socket to @c context without closing
+   * and reopening it, retaining the socket's native handle and state.
+   *
+   * @param context An execution context which provides the I/O executor that
+   * the socket will use, by default, to dispatch handlers for any asynchronous
+   * operations performed on the socket.
+   *
+   * @param other The other basic_stream_socket object from which the move will
+   * occur. Any asynchronous operations outstanding on @c other are cancelled,
+   * and their handlers are passed the asio::error::operation_aborted error.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Following the move, the moved-from object is in the same state as if
+   * constructed using the @c basic_stream_socket(const executor_type&)
+   * constructor.
+   */
+  template <typename ExecutionContext, typename Executor1>
+  basic_stream_socket(ExecutionContext& context,
+      basic_stream_socket<Protocol, Executor1>&& other,
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      > = 0)
+    : basic_socket<Protocol, Executor>(context, std::move(other))
+  {
+  }
+
   /// Destroys the socket.
   /**
    * This function destroys the socket, cancelling any outstanding asynchronous
@@ -575,6 +653,143 @@ public:
         initiate_async_send(this), token, buffers, flags);
   }
 
+#if defined(ASIO_HAS_SOCKET_SEND_ALL) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous send of all of the data.
+  /**
+   * This function is used to asynchronously send data on the stream socket.
+   * The operation completes only when all of the data has been sent, or when
+   * an error occurs. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * @param buffers One or more data buffers to be sent on the socket. Although
+   * the buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid until the completion handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the send completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note Unlike @ref async_write, which performs a sequence of @c
+   * async_write_some operations, this operation is continued within the
+   * socket's backend when the data is only partially sent, so that the
+   * handler is invoked only once. The @ref async_write function uses this
+   * operation when called with a basic_stream_socket and the
+   * asio::transfer_all completion condition.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   *
+   * If the operation is cancelled, the handler's @c bytes_transferred
+   * argument reports the number of bytes sent before the cancellation.
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_send_all(const ConstBufferSequence& buffers,
+      WriteToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<WriteToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_send_all>(), token,
+          buffers, socket_base::message_flags(0)))
+  {
+    return async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_all(this), token,
+        buffers, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous send of all of the data.
+  /**
+   * This function is used to asynchronously send data on the stream socket.
+   * The operation completes only when all of the data has been sent, or when
+   * an error occurs. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * @param buffers One or more data buffers to be sent on the socket. Although
+   * the buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid until the completion handler is called.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the send completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note Unlike @ref async_write, which performs a sequence of @c
+   * async_write_some operations, this operation is continued within the
+   * socket's backend when the data is only partially sent, so that the
+   * handler is invoked only once. The @ref async_write function uses this
+   * operation when called with a basic_stream_socket and the
+   * asio::transfer_all completion condition.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   *
+   * If the operation is cancelled, the handler's @c bytes_transferred
+   * argument reports the number of bytes sent before the cancellation.
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_send_all(const ConstBufferSequence& buffers,
+      socket_base::message_flags flags,
+      WriteToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<WriteToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_send_all>(), token, buffers, flags))
+  {
+    return async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_all(this), token, buffers, flags);
+  }
+#endif // defined(ASIO_HAS_SOCKET_SEND_ALL)
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Receive some data on the socket.
   /**
    * This function is used to receive data on the stream socket. The function
@@ -821,86 +1036,102 @@ public:
         initiate_async_receive(this), token, buffers, flags);
   }
 
-  /// Write some data to the socket.
+#if defined(ASIO_HAS_SOCKET_RECEIVE_ALL) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous receive that fills the buffers.
   /**
-   * This function is used to write data to the stream socket. The function call
-   * will block until one or more bytes of the data has been written
-   * successfully, or until an error occurs.
+   * This function is used to asynchronously receive data from the stream
+   * socket. The operation completes only when the buffers have been filled,
+   * when the peer closes the connection, or when an error occurs. It is an
+   * initiating function for an @ref asynchronous_operation, and always returns
+   * immediately.
    *
-   * @param buffers One or more data buffers to be written to the socket.
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the completion handler is called.
    *
-   * @returns The number of bytes written.
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
    *
-   * @throws asio::system_error Thrown on failure. An error code of
-   * asio::error::eof indicates that the connection was closed by the
-   * peer.
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
    *
-   * @note The write_some operation may not transmit all of the data to the
-   * peer. Consider using the @ref write function if you need to ensure that
-   * all data is written before the blocking operation completes.
+   * @note Unlike @ref async_read, which performs a sequence of @c
+   * async_read_some operations, this operation is continued within the
+   * socket's backend when the data is only partially received, so that the
+   * handler is invoked only once. With io_uring, the receive is submitted
+   * with MSG_WAITALL so that the kernel waits for all of the data. The @ref
+   * async_read function uses this operation when called with a
+   * basic_stream_socket and the asio::transfer_all completion condition.
    *
-   * @par Example
-   * To write a single data buffer use the @ref buffer function as follows:
-   * @code
-   * socket.write_some(asio::buffer(data, size));
-   * @endcode
-   * See the @ref buffer documentation for information on writing multiple
-   * buffers in one go, and how to use it with arrays, boost::array or
-   * std::vector.
-   */
-  template <typename ConstBufferSequence>
-  std::size_t write_some(const ConstBufferSequence& buffers)
-  {
-    asio::error_code ec;
-    std::size_t s = this->impl_.get_service().send(
-        this->impl_.get_implementation(), buffers, 0, ec);
-    asio::detail::throw_error(ec, "write_some");
-    return s;
-  }
-
-  /// Write some data to the socket.
-  /**
-   * This function is used to write data to the stream socket. The function call
-   * will block until one or more bytes of the data has been written
-   * successfully, or until an error occurs.
+   * If the peer closes the connection before the buffers are filled, the
+   * handler is passed asio::error::eof and the number of bytes received.
    *
-   * @param buffers One or more data buffers to be written to the socket.
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
    *
-   * @param ec Set to indicate what error occurred, if any.
+   * @li @c cancellation_type::terminal
    *
-   * @returns The number of bytes written. Returns 0 if an error occurred.
+   * @li @c cancellation_type::partial
    *
-   * @note The write_some operation may not transmit all of the data to the
-   * peer. Consider using the @ref write function if you need to ensure that
-   * all data is written before the blocking operation completes.
+   * @li @c cancellation_type::total
+   *
+   * If the operation is cancelled, the handler's @c bytes_transferred
+   * argument reports the number of bytes received before the cancellation.
    */
-  template <typename ConstBufferSequence>
-  std::size_t write_some(const ConstBufferSequence& buffers,
-      asio::error_code& ec)
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_receive_all(const MutableBufferSequence& buffers,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_receive_all>(), token,
+          buffers, socket_base::message_flags(0)))
   {
-    return this->impl_.get_service().send(
-        this->impl_.get_implementation(), buffers, 0, ec);
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_all(this), token,
+        buffers, socket_base::message_flags(0));
   }
 
-  /// Start an asynchronous write.
+  /// Start an asynchronous receive that fills the buffers.
   /**
-   * This function is used to asynchronously write data to the stream socket.
-   * It is an initiating function for an @ref asynchronous_operation, and always
-   * returns immediately.
+   * This function is used to asynchronously receive data from the stream
+   * socket. The operation completes only when the buffers have been filled,
+   * when the peer closes the connection, or when an error occurs. It is an
+   * initiating function for an @ref asynchronous_operation, and always returns
+   * immediately.
    *
-   * @param buffers One or more data buffers to be written to the socket.
+   * @param buffers One or more buffers into which the data will be received.
    * Although the buffers object may be copied as necessary, ownership of the
    * underlying memory blocks is retained by the caller, which must guarantee
    * that they remain valid until the completion handler is called.
    *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
    * @param token The @ref completion_token that will be used to produce a
-   * completion handler, which will be called when the write completes.
+   * completion handler, which will be called when the receive completes.
    * Potential completion tokens include @ref use_future, @ref use_awaitable,
    * @ref yield_context, or a function object with the correct completion
    * signature. The function signature of the completion handler must be:
    * @code void handler(
    *   const asio::error_code& error, // Result of operation.
-   *   std::size_t bytes_transferred // Number of bytes written.
+   *   std::size_t bytes_transferred // Number of bytes received.
    * ); @endcode
    * Regardless of whether the asynchronous operation completes immediately or
    * not, the completion handler will not be invoked from within this function.
@@ -910,21 +1141,19 @@ public:
    * @par Completion Signature
    * @code void(asio::error_code, std::size_t) @endcode
    *
-   * @note The write operation may not transmit all of the data to the peer.
-   * Consider using the @ref async_write function if you need to ensure that all
-   * data is written before the asynchronous operation completes.
+   * @note Unlike @ref async_read, which performs a sequence of @c
+   * async_read_some operations, this operation is continued within the
+   * socket's backend when the data is only partially received, so that the
+   * handler is invoked only once. With io_uring, the receive is submitted
+   * with MSG_WAITALL so that the kernel waits for all of the data. The @ref
+   * async_read function uses this operation when called with a
+   * basic_stream_socket and the asio::transfer_all completion condition.
    *
-   * @par Example
-   * To write a single data buffer use the @ref buffer function as follows:
-   * @code
-   * socket.async_write_some(asio::buffer(data, size), handler);
-   * @endcode
-   * See the @ref buffer documentation for information on writing multiple
-   * buffers in one go, and how to use it with arrays, boost::array or
-   * std::vector.
+   * If the peer closes the connection before the buffers are filled, the
+   * handler is passed asio::error::eof and the number of bytes received.
    *
    * @par Per-Operation Cancellation
-   * On POSIX or Windows operating systems, this asynchronous operation supports
+   * On POSIX operating systems, this asynchronous operation supports
    * cancellation for the following asio::cancellation_type values:
    *
    * @li @c cancellation_type::terminal
@@ -932,12 +1161,287 @@ public:
    * @li @c cancellation_type::partial
    *
    * @li @c cancellation_type::total
+   *
+   * If the operation is cancelled, the handler's @c bytes_transferred
+   * argument reports the number of bytes received before the cancellation.
    */
-  template <typename ConstBufferSequence,
+  template <typename MutableBufferSequence,
       ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
-        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
-  auto async_write_some(const ConstBufferSequence& buffers,
-      WriteToken&& token = default_completion_token_t<executor_type>())
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_receive_all(const MutableBufferSequence& buffers,
+      socket_base::message_flags flags,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_receive_all>(), token, buffers, flags))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_all(this), token, buffers, flags);
+  }
+#endif // defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#if defined(ASIO_HAS_PROVIDED_BUFFER_RING) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous receive into a buffer from a provided buffer ring.
+  /**
+   * This function is used to asynchronously receive data from the stream
+   * socket into a buffer that is selected from a provided_buffer_ring only
+   * once data has arrived. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * @param ring The ring from which the buffer will be selected. The ring must
+   * remain valid until the completion handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred, // Number of bytes received.
+   *   std::size_t buffer_id // Identifier of the buffer used.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t, std::size_t) @endcode
+   *
+   * @note The @c buffer_id is valid only when the operation succeeds with a
+   * non-zero @c bytes_transferred. The application then owns the buffer, and
+   * must return it to the ring by calling provided_buffer_ring::recycle().
+   * The operation fails with asio::error::no_buffer_space if data
+   * arrives when the ring has no free buffers.
+   *
+   * @note When the io_uring backend is in use, the underlying submission may
+   * remain armed after the operation completes, so that subsequent calls to
+   * async_receive_multishot() collect data that has already arrived. Other
+   * receive operations must not be started on the socket while multishot
+   * receives are in use.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t, std::size_t)) ReadToken
+          = default_completion_token_t<executor_type>>
+  auto async_receive_multishot(provided_buffer_ring& ring,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t, std::size_t)>(
+          declval<initiate_async_receive_multishot>(), token,
+          &ring, socket_base::message_flags(0)))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t, std::size_t)>(
+        initiate_async_receive_multishot(this), token,
+        &ring, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous receive into a buffer from a provided buffer ring.
+  /**
+   * This function is used to asynchronously receive data from the stream
+   * socket into a buffer that is selected from a provided_buffer_ring only
+   * once data has arrived. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * @param ring The ring from which the buffer will be selected. The ring must
+   * remain valid until the completion handler is called.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred, // Number of bytes received.
+   *   std::size_t buffer_id // Identifier of the buffer used.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t, std::size_t) @endcode
+   *
+   * @note The @c buffer_id is valid only when the operation succeeds with a
+   * non-zero @c bytes_transferred. The application then owns the buffer, and
+   * must return it to the ring by calling provided_buffer_ring::recycle().
+   * The operation fails with asio::error::no_buffer_space if data
+   * arrives when the ring has no free buffers.
+   *
+   * @note When the io_uring backend is in use, the underlying submission may
+   * remain armed after the operation completes, so that subsequent calls to
+   * async_receive_multishot() collect data that has already arrived. Other
+   * receive operations must not be started on the socket while multishot
+   * receives are in use.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t, std::size_t)) ReadToken
+          = default_completion_token_t<executor_type>>
+  auto async_receive_multishot(provided_buffer_ring& ring,
+      socket_base::message_flags flags,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t, std::size_t)>(
+          declval<initiate_async_receive_multishot>(),
+          token, &ring, flags))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t, std::size_t)>(
+        initiate_async_receive_multishot(this), token, &ring, flags);
+  }
+#endif // defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+  /// Write some data to the socket.
+  /**
+   * This function is used to write data to the stream socket. The function call
+   * will block until one or more bytes of the data has been written
+   * successfully, or until an error occurs.
+   *
+   * @param buffers One or more data buffers to be written to the socket.
+   *
+   * @returns The number of bytes written.
+   *
+   * @throws asio::system_error Thrown on failure. An error code of
+   * asio::error::eof indicates that the connection was closed by the
+   * peer.
+   *
+   * @note The write_some operation may not transmit all of the data to the
+   * peer. Consider using the @ref write function if you need to ensure that
+   * all data is written before the blocking operation completes.
+   *
+   * @par Example
+   * To write a single data buffer use the @ref buffer function as follows:
+   * @code
+   * socket.write_some(asio::buffer(data, size));
+   * @endcode
+   * See the @ref buffer documentation for information on writing multiple
+   * buffers in one go, and how to use it with arrays, boost::array or
+   * std::vector.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t write_some(const ConstBufferSequence& buffers)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().send(
+        this->impl_.get_implementation(), buffers, 0, ec);
+    asio::detail::throw_error(ec, "write_some");
+    return s;
+  }
+
+  /// Write some data to the socket.
+  /**
+   * This function is used to write data to the stream socket. The function call
+   * will block until one or more bytes of the data has been written
+   * successfully, or until an error occurs.
+   *
+   * @param buffers One or more data buffers to be written to the socket.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes written. Returns 0 if an error occurred.
+   *
+   * @note The write_some operation may not transmit all of the data to the
+   * peer. Consider using the @ref write function if you need to ensure that
+   * all data is written before the blocking operation completes.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t write_some(const ConstBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    return this->impl_.get_service().send(
+        this->impl_.get_implementation(), buffers, 0, ec);
+  }
+
+  /// Start an asynchronous write.
+  /**
+   * This function is used to asynchronously write data to the stream socket.
+   * It is an initiating function for an @ref asynchronous_operation, and always
+   * returns immediately.
+   *
+   * @param buffers One or more data buffers to be written to the socket.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the completion handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the write completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes written.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note The write operation may not transmit all of the data to the peer.
+   * Consider using the @ref async_write function if you need to ensure that all
+   * data is written before the asynchronous operation completes.
+   *
+   * @par Example
+   * To write a single data buffer use the @ref buffer function as follows:
+   * @code
+   * socket.async_write_some(asio::buffer(data, size), handler);
+   * @endcode
+   * See the @ref buffer documentation for information on writing multiple
+   * buffers in one go, and how to use it with arrays, boost::array or
+   * std::vector.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX or Windows operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_write_some(const ConstBufferSequence& buffers,
+      WriteToken&& token = default_completion_token_t<executor_type>())
     -> decltype(
       async_initiate<WriteToken,
         void (asio::error_code, std::size_t)>(
@@ -1082,16 +1586,277 @@ public:
         buffers, socket_base::message_flags(0));
   }
 
-private:
-  // Disallow copying and assignment.
-  basic_stream_socket(const basic_stream_socket&) = delete;
-  basic_stream_socket& operator=(const basic_stream_socket&) = delete;
-
-  class initiate_async_send
+#if defined(ASIO_HAS_SOCKET_TIMESTAMPING) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous receive that reports the receive timestamp.
+  /**
+   * This function is used to asynchronously receive data from the stream
+   * socket, together with the software or hardware timestamp generated by the
+   * kernel when the most recent of the received data arrived. It is an
+   * initiating function for an @ref asynchronous_operation, and always returns
+   * immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the completion handler is called.
+   *
+   * @param timestamp A socket_timestamp object that receives the timestamp
+   * generated for the received data. Ownership of the timestamp object is
+   * retained by the caller, which must guarantee that it is valid until the
+   * completion handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note Timestamps are generated only after they have been enabled using the
+   * socket_base::timestamping socket option. A timestamp that was not
+   * generated for the received data is reported as zero.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_receive_timestamped(const MutableBufferSequence& buffers,
+      socket_timestamp& timestamp,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_receive_timestamped>(), token,
+          buffers, &timestamp))
   {
-  public:
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_timestamped(this), token,
+        buffers, &timestamp);
+  }
+#endif // defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#if defined(ASIO_HAS_FD_PASSING) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous send that passes file descriptors with the data.
+  /**
+   * This function is used to asynchronously send data on a local stream socket,
+   * passing the specified file descriptors to the peer with the data. It is an
+   * initiating function for an @ref asynchronous_operation, and always returns
+   * immediately.
+   *
+   * @param buffers One or more data buffers to be sent on the socket. Although
+   * the buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid until the completion handler is called.
+   *
+   * @param fds The descriptors to be passed. Ownership of the fds object is
+   * retained by the caller, which must guarantee that it is valid until the
+   * completion handler is called. The descriptors remain owned by the caller.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the send completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note The descriptors are passed with the first byte of data sent, so at
+   * least one byte must be sent. The operation may send fewer bytes than
+   * requested; any remaining data is sent without the descriptors.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_send_fds(const ConstBufferSequence& buffers,
+      const local::passed_fds& fds,
+      WriteToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<WriteToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_send_fds>(), token, buffers, &fds))
+  {
+    return async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_fds(this), token, buffers, &fds);
+  }
+
+  /// Start an asynchronous receive that accepts passed file descriptors.
+  /**
+   * This function is used to asynchronously receive data from a local
+   * stream socket, together with any file descriptors and credentials passed by
+   * the peer with the data. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the completion handler is called.
+   *
+   * @param fds A passed_fds object that receives the descriptors. Ownership of
+   * the fds object is retained by the caller, which must guarantee that it is
+   * valid until the completion handler is called. Received descriptors are
+   * owned by the caller, even if the operation fails after they arrive.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note The sender's credentials are received only after they have been
+   * enabled using the local::pass_credentials socket option.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_receive_fds(const MutableBufferSequence& buffers,
+      local::passed_fds& fds,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_receive_fds>(), token, buffers, &fds))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_fds(this), token, buffers, &fds);
+  }
+#endif // defined(ASIO_HAS_FD_PASSING)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+  /// Get information about the state of the connection's transport protocol.
+  /**
+   * This function is used to obtain the round trip time, congestion window
+   * and other information that the operating system maintains for a
+   * connected TCP socket.
+   *
+   * @returns The transport information.
+   *
+   * @throws asio::system_error Thrown on failure. The error is
+   * asio::error::operation_not_supported if the operating system does not
+   * provide the information.
+   *
+   * @par Example
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::transport_info info = socket.get_transport_info();
+   * std::cout << "rtt: " << info.rtt.count() << "us\n";
+   * @endcode
+   */
+  transport_info get_transport_info() const
+  {
+    asio::error_code ec;
+    transport_info info = get_transport_info(ec);
+    asio::detail::throw_error(ec, "get_transport_info");
+    return info;
+  }
+
+  /// Get information about the state of the connection's transport protocol.
+  /**
+   * This function is used to obtain the round trip time, congestion window
+   * and other information that the operating system maintains for a
+   * connected TCP socket.
+   *
+   * @param ec Set to indicate what error occurred, if any. The error is
+   * asio::error::operation_not_supported if the operating system does not
+   * provide the information.
+   *
+   * @returns The transport information. All values are zero if an error
+   * occurs.
+   */
+  transport_info get_transport_info(asio::error_code& ec) const
+  {
+    transport_info_option option;
+    this->impl_.get_service().get_option(
+        this->impl_.get_implementation(), option, ec);
+    return option.value();
+  }
+
+private:
+  // The option used to obtain the transport information.
+  typedef asio::detail::socket_option::structure<
+    asio::detail::custom_socket_option_level,
+    asio::detail::transport_info_option,
+    transport_info> transport_info_option;
+
+  // Disallow copying and assignment.
+  basic_stream_socket(const basic_stream_socket&) = delete;
+  basic_stream_socket& operator=(const basic_stream_socket&) = delete;
+
+  class initiate_async_send
+  {
+  public:
     typedef Executor executor_type;
 
+#if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+    // The operation links any cancel_after timeout to its submission.
+    typedef void linked_timeout_support;
+#endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
     explicit initiate_async_send(basic_stream_socket* self)
       : self_(self)
     {
@@ -1121,11 +1886,52 @@ private:
     basic_stream_socket* self_;
   };
 
+#if defined(ASIO_HAS_SOCKET_SEND_ALL)
+  class initiate_async_send_all
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_all(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(WriteHandler&& handler,
+        const ConstBufferSequence& buffers,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send_all(
+          self_->impl_.get_implementation(), buffers, flags,
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
+#endif // defined(ASIO_HAS_SOCKET_SEND_ALL)
+
   class initiate_async_receive
   {
   public:
     typedef Executor executor_type;
 
+#if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+    // The operation links any cancel_after timeout to its submission.
+    typedef void linked_timeout_support;
+#endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
     explicit initiate_async_receive(basic_stream_socket* self)
       : self_(self)
     {
@@ -1154,6 +1960,183 @@ private:
   private:
     basic_stream_socket* self_;
   };
+
+#if defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+  class initiate_async_receive_all
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_all(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ReadHandler&& handler,
+        const MutableBufferSequence& buffers,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_all(
+          self_->impl_.get_implementation(), buffers, flags,
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
+#endif // defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+
+#if defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+  class initiate_async_receive_multishot
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_multishot(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler>
+    void operator()(ReadHandler&& handler, provided_buffer_ring* ring,
+        socket_base::message_flags flags) const
+    {
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_multishot(
+          self_->impl_.get_implementation(), *ring, flags,
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
+#endif // defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+
+#if defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+  class initiate_async_receive_timestamped
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_timestamped(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ReadHandler&& handler,
+        const MutableBufferSequence& buffers,
+        socket_timestamp* timestamp) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_timestamped(
+          self_->impl_.get_implementation(), buffers,
+          static_cast<endpoint_type*>(0), timestamp,
+          socket_base::message_flags(0), handler2.value,
+          self_->impl_.get_executor());
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
+#endif // defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+
+#if defined(ASIO_HAS_FD_PASSING)
+  class initiate_async_send_fds
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_fds(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(WriteHandler&& handler,
+        const ConstBufferSequence& buffers,
+        const local::passed_fds* fds) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send_fds(
+          self_->impl_.get_implementation(), buffers, fds,
+          socket_base::message_flags(0), handler2.value,
+          self_->impl_.get_executor());
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
+
+  class initiate_async_receive_fds
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_fds(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ReadHandler&& handler,
+        const MutableBufferSequence& buffers,
+        local::passed_fds* fds) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_fds(
+          self_->impl_.get_implementation(), buffers, fds,
+          socket_base::message_flags(0), handler2.value,
+          self_->impl_.get_executor());
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
+#endif // defined(ASIO_HAS_FD_PASSING)
 };
 
 } // namespace asio
@@ -101,6 +101,14 @@ namespace asio {
  * std::string s;
  * is >> s;
  * @endcode
+ *
+ * Recycling the storage of the streambufs used by successive connections:
+ * @code
+ * asio::buffered_stream_pool pool;
+ * ...
+ * asio::basic_streambuf<asio::pooled_allocator<char>> b(
+ *     65536, asio::pooled_allocator<char>(pool));
+ * @endcode
  */
 #if defined(GENERATING_DOCUMENTATION)
 template <typename Allocator = std::allocator<char>>
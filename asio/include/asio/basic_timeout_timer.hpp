@@ -0,0 +1,271 @@
+//
+// basic_timeout_timer.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_BASIC_TIMEOUT_TIMER_HPP
+#define ASIO_BASIC_TIMEOUT_TIMER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/any_io_executor.hpp"
+#include "asio/async_result.hpp"
+#include "asio/compose.hpp"
+#include "asio/error.hpp"
+#include "asio/wait_traits.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/timeout_timer_op.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Provides a timeout that has a single waiter and is cheap to push back.
+/**
+ * The basic_timeout_timer class template provides a timer for the common case
+ * of a timeout with exactly one waiter, such as an idle timeout on a
+ * connection that is pushed back each time data arrives.
+ *
+ * Unlike basic_waitable_timer, changing the expiry time does not cancel an
+ * outstanding wait. The wait instead completes when the most recently set
+ * expiry time is reached. Pushing the expiry time back only records the new
+ * time in the timer object, without cancelling the wait, completing its
+ * handler, or updating the reactor's timer queue. The underlying timer is
+ * moved only when it fires before the current expiry time, or when the expiry
+ * time is brought forward. The memory for the underlying wait operation is
+ * kept by the timer and reused by each wait.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code
+ * void connection::start()
+ * {
+ *   idle_timer_.expires_after(std::chrono::seconds(30));
+ *   idle_timer_.async_wait(
+ *       [this](asio::error_code ec)
+ *       {
+ *         if (!ec)
+ *           socket_.close();
+ *       });
+ *   start_read();
+ * }
+ *
+ * void connection::handle_read(asio::error_code ec, std::size_t n)
+ * {
+ *   if (!ec)
+ *   {
+ *     idle_timer_.expires_after(std::chrono::seconds(30));
+ *     ...
+ *   }
+ * }
+ * @endcode
+ */
+template <typename Clock,
+    typename WaitTraits = asio::wait_traits<Clock>,
+    typename Executor = any_io_executor>
+class basic_timeout_timer
+{
+private:
+  typedef detail::timeout_timer_state<Clock, WaitTraits, Executor> state_type;
+  typedef detail::timeout_timer_wait_op<Clock, WaitTraits, Executor> op_type;
+
+public:
+  /// The type of the executor associated with the object.
+  typedef Executor executor_type;
+
+  /// Rebinds the timer type to another executor.
+  template <typename Executor1>
+  struct rebind_executor
+  {
+    /// The timer type when rebound to the specified executor.
+    typedef basic_timeout_timer<Clock, WaitTraits, Executor1> other;
+  };
+
+  /// The clock type.
+  typedef Clock clock_type;
+
+  /// The duration type of the clock.
+  typedef typename clock_type::duration duration;
+
+  /// The time point type of the clock.
+  typedef typename clock_type::time_point time_point;
+
+  /// The wait traits type.
+  typedef WaitTraits traits_type;
+
+  /// Constructor.
+  /**
+   * This constructor creates a timer without setting an expiry time. The
+   * expires_at() or expires_after() functions must be called to set an expiry
+   * time before the timer can be waited on.
+   *
+   * @param ex The I/O executor that the timer will use, by default, to
+   * dispatch handlers for any asynchronous operations performed on the timer.
+   */
+  explicit basic_timeout_timer(const executor_type& ex)
+    : state_(detail::make_shared<state_type>(ex))
+  {
+  }
+
+  /// Constructor.
+  /**
+   * This constructor creates a timer without setting an expiry time. The
+   * expires_at() or expires_after() functions must be called to set an expiry
+   * time before the timer can be waited on.
+   *
+   * @param context An execution context which provides the I/O executor that
+   * the timer will use, by default, to dispatch handlers for any asynchronous
+   * operations performed on the timer.
+   */
+  template <typename ExecutionContext>
+  explicit basic_timeout_timer(ExecutionContext& context,
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      > = 0)
+    : state_(detail::make_shared<state_type>(context))
+  {
+  }
+
+  /// Destroys the timer.
+  /**
+   * This function destroys the timer, cancelling any outstanding asynchronous
+   * wait as if by calling @c cancel.
+   */
+  ~basic_timeout_timer()
+  {
+    cancel();
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() noexcept
+  {
+    return state_->timer_.get_executor();
+  }
+
+  /// Cancel the outstanding asynchronous wait.
+  /**
+   * This function forces the completion of an outstanding asynchronous wait
+   * against the timer. The handler for the cancelled operation will be invoked
+   * with the asio::error::operation_aborted error code.
+   *
+   * Cancelling the timer does not change the expiry time.
+   *
+   * @return The number of asynchronous operations that were cancelled.
+   */
+  std::size_t cancel()
+  {
+    ++state_->cancellations_;
+    return state_->timer_.cancel();
+  }
+
+  /// Get the timer's expiry time as an absolute time.
+  time_point expiry() const
+  {
+    return state_->expiry_;
+  }
+
+  /// Set the timer's expiry time as an absolute time.
+  /**
+   * This function sets the expiry time. An outstanding asynchronous wait is not
+   * cancelled, and will complete when the new expiry time is reached.
+   *
+   * @param expiry_time The expiry time to be used for the timer.
+   */
+  void expires_at(const time_point& expiry_time)
+  {
+    state_->expiry_ = expiry_time;
+
+    // Only a move to an earlier time requires the underlying timer to be
+    // updated. An outstanding wait observes a later time when it fires.
+    if (expiry_time < state_->timer_.expiry())
+      state_->timer_.expires_at(expiry_time);
+  }
+
+  /// Set the timer's expiry time relative to now.
+  /**
+   * This function sets the expiry time. An outstanding asynchronous wait is not
+   * cancelled, and will complete when the new expiry time is reached.
+   *
+   * @param expiry_time The expiry time to be used for the timer.
+   */
+  void expires_after(const duration& expiry_time)
+  {
+    expires_at(clock_type::now() + expiry_time);
+  }
+
+  /// Start an asynchronous wait on the timer.
+  /**
+   * This function may be used to initiate an asynchronous wait against the
+   * timer. It is an initiating function for an @ref asynchronous_operation,
+   * and always returns immediately.
+   *
+   * At most one asynchronous wait may be outstanding on the timer at a time.
+   * The completion handler will be called when:
+   *
+   * @li The timer has expired, taking into account any changes to the expiry
+   * time that were made after the wait was started.
+   *
+   * @li The timer was cancelled or destroyed, in which case the handler is
+   * passed the error code asio::error::operation_aborted.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the timer expires. Potential
+   * completion tokens include @ref use_future, @ref use_awaitable, @ref
+   * yield_context, or a function object with the correct completion signature.
+   * The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        WaitToken = default_completion_token_t<executor_type>>
+  auto async_wait(
+      WaitToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_compose<WaitToken, void (asio::error_code)>(
+        declval<op_type>(), token, declval<basic_timeout_timer&>()))
+  {
+    return async_compose<WaitToken, void (asio::error_code)>(
+        op_type(state_), token, *this);
+  }
+
+private:
+  // Disallow copying and assignment.
+  basic_timeout_timer(const basic_timeout_timer&) = delete;
+  basic_timeout_timer& operator=(const basic_timeout_timer&) = delete;
+
+  detail::shared_ptr<state_type> state_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_BASIC_TIMEOUT_TIMER_HPP
@@ -516,6 +516,36 @@ public:
     return s;
   }
 
+  /// Set the timer's expiry time relative to now, allowing the timer to
+  /// complete later than that time.
+  /**
+   * This function sets the expiry time, as for expires_after(). In addition,
+   * it permits asynchronous wait operations to complete up to @c slack after
+   * the expiry time. This allows the implementation to complete many timers
+   * whose permitted ranges overlap together, reducing the number of times the
+   * reactor must wake. A timer never completes before its expiry time.
+   *
+   * The slack applies until the next call to expires_at() or expires_after().
+   *
+   * @param expiry_time The expiry time to be used for the timer.
+   *
+   * @param slack The maximum amount of time by which completion of the timer
+   * may be delayed.
+   *
+   * @return The number of asynchronous operations that were cancelled.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  std::size_t expires_after_with_slack(const duration& expiry_time,
+      const duration& slack)
+  {
+    asio::error_code ec;
+    std::size_t s = impl_.get_service().expires_after_with_slack(
+        impl_.get_implementation(), expiry_time, slack, ec);
+    asio::detail::throw_error(ec, "expires_after_with_slack");
+    return s;
+  }
+
   /// Perform a blocking wait on the timer.
   /**
    * This function is used to wait for the timer to expire. This function
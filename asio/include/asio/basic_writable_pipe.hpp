@@ -57,6 +57,9 @@ class basic_writable_pipe
 {
 private:
   class initiate_async_write_some;
+#if !defined(ASIO_HAS_IOCP)
+  class initiate_async_wait;
+#endif // !defined(ASIO_HAS_IOCP)
 
 public:
   /// The type of the executor associated with the object.
@@ -565,6 +568,78 @@ public:
         initiate_async_write_some(this), token, buffers);
   }
 
+#if !defined(ASIO_HAS_IOCP) || defined(GENERATING_DOCUMENTATION)
+  /// Wait for the pipe to become ready to write.
+  /**
+   * This function is used to perform a blocking wait for the pipe to become
+   * ready to write.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note This function is not available on Windows.
+   */
+  void wait()
+  {
+    asio::error_code ec;
+    impl_.get_service().wait(impl_.get_implementation(),
+        posix::descriptor_base::wait_write, ec);
+    asio::detail::throw_error(ec, "wait");
+  }
+
+  /// Wait for the pipe to become ready to write.
+  /**
+   * This function is used to perform a blocking wait for the pipe to become
+   * ready to write.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note This function is not available on Windows.
+   */
+  ASIO_SYNC_OP_VOID wait(asio::error_code& ec)
+  {
+    impl_.get_service().wait(impl_.get_implementation(),
+        posix::descriptor_base::wait_write, ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Asynchronously wait for the pipe to become ready to write.
+  /**
+   * This function is used to perform an asynchronous wait for the pipe to
+   * become ready to write. It is an initiating function for an
+   * @ref asynchronous_operation, and always returns immediately.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the wait completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   *
+   * @note This function is not available on Windows.
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        WaitToken = default_completion_token_t<executor_type>>
+  auto async_wait(
+      WaitToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<WaitToken, void (asio::error_code)>(
+        declval<initiate_async_wait>(), token))
+  {
+    return async_initiate<WaitToken, void (asio::error_code)>(
+        initiate_async_wait(this), token);
+  }
+#endif // !defined(ASIO_HAS_IOCP) || defined(GENERATING_DOCUMENTATION)
+
 private:
   // Disallow copying and assignment.
   basic_writable_pipe(const basic_writable_pipe&) = delete;
@@ -603,6 +678,41 @@ private:
     basic_writable_pipe* self_;
   };
 
+#if !defined(ASIO_HAS_IOCP)
+  class initiate_async_wait
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_wait(basic_writable_pipe* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WaitHandler>
+    void operator()(WaitHandler&& handler) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WaitHandler.
+      ASIO_WAIT_HANDLER_CHECK(WaitHandler, handler) type_check;
+
+      detail::non_const_lvalue<WaitHandler> handler2(handler);
+      self_->impl_.get_service().async_wait(
+          self_->impl_.get_implementation(),
+          posix::descriptor_base::wait_write,
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_writable_pipe* self_;
+  };
+#endif // !defined(ASIO_HAS_IOCP)
+
 #if defined(ASIO_HAS_IOCP)
   detail::io_object_impl<detail::win_iocp_handle_service, Executor> impl_;
 #elif defined(ASIO_HAS_IO_URING_AS_DEFAULT)
@@ -20,6 +20,9 @@
 #include <utility>
 #include <vector>
 #include "asio/detail/memory.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/error.hpp"
+#include "asio/error_code.hpp"
 #include "asio/execution/context.hpp"
 #include "asio/execution/executor.hpp"
 #include "asio/execution_context.hpp"
@@ -53,6 +56,12 @@ protected:
 /**
  * For portability, applications should assume that only one registration is
  * permitted per execution context.
+ *
+ * A registration may be created with a capacity greater than the number of
+ * buffers in the sequence. The additional slots are initially empty, and
+ * update() may be used to fill, replace or empty any slot while operations
+ * that use the other buffers are in progress. This allows the set of
+ * registered buffers to grow and shrink without unregistering them all.
  */
 template <typename MutableBufferSequence,
     typename Allocator = std::allocator<void>>
@@ -89,7 +98,37 @@ public:
   {
     init_buffers(buffer_registration::get_context(ex),
         asio::buffer_sequence_begin(buffer_sequence_),
-        asio::buffer_sequence_end(buffer_sequence_));
+        asio::buffer_sequence_end(buffer_sequence_), 0);
+  }
+
+  /// Register buffers with an executor's execution context, reserving slots
+  /// for additional buffers.
+  /**
+   * @param ex The executor whose execution context the buffers are registered
+   * with.
+   *
+   * @param buffer_sequence The buffers to be registered in the first slots.
+   *
+   * @param capacity The total number of slots. If less than the number of
+   * buffers in @c buffer_sequence, the number of buffers is used.
+   *
+   * @param alloc The allocator used for the buffers container.
+   */
+  template <typename Executor>
+  buffer_registration(const Executor& ex,
+      const MutableBufferSequence& buffer_sequence, std::size_t capacity,
+      const allocator_type& alloc = allocator_type(),
+      constraint_t<
+        is_executor<Executor>::value || execution::is_executor<Executor>::value
+      > = 0)
+    : buffer_sequence_(buffer_sequence),
+      buffers_(
+          ASIO_REBIND_ALLOC(allocator_type,
+            mutable_registered_buffer)(alloc))
+  {
+    init_buffers(buffer_registration::get_context(ex),
+        asio::buffer_sequence_begin(buffer_sequence_),
+        asio::buffer_sequence_end(buffer_sequence_), capacity);
   }
 
   /// Register buffers with an execution context.
@@ -107,14 +146,46 @@ public:
   {
     init_buffers(ctx,
         asio::buffer_sequence_begin(buffer_sequence_),
-        asio::buffer_sequence_end(buffer_sequence_));
+        asio::buffer_sequence_end(buffer_sequence_), 0);
+  }
+
+  /// Register buffers with an execution context, reserving slots for
+  /// additional buffers.
+  /**
+   * @param ctx The execution context the buffers are registered with.
+   *
+   * @param buffer_sequence The buffers to be registered in the first slots.
+   *
+   * @param capacity The total number of slots. If less than the number of
+   * buffers in @c buffer_sequence, the number of buffers is used.
+   *
+   * @param alloc The allocator used for the buffers container.
+   */
+  template <typename ExecutionContext>
+  buffer_registration(ExecutionContext& ctx,
+      const MutableBufferSequence& buffer_sequence, std::size_t capacity,
+      const allocator_type& alloc = allocator_type(),
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      > = 0)
+    : buffer_sequence_(buffer_sequence),
+      buffers_(
+          ASIO_REBIND_ALLOC(allocator_type,
+            mutable_registered_buffer)(alloc))
+  {
+    init_buffers(ctx,
+        asio::buffer_sequence_begin(buffer_sequence_),
+        asio::buffer_sequence_end(buffer_sequence_), capacity);
   }
 
   /// Move constructor.
   buffer_registration(buffer_registration&& other) noexcept
     : buffer_sequence_(std::move(other.buffer_sequence_)),
-      buffers_(std::move(other.buffers_))
+      buffers_(std::move(other.buffers_)),
+      scope_(other.scope_),
+      capacity_(other.capacity_)
   {
+    other.capacity_ = 0;
 #if defined(ASIO_HAS_IO_URING)
     service_ = other.service_;
     other.service_ = 0;
@@ -137,6 +208,9 @@ public:
     {
       buffer_sequence_ = std::move(other.buffer_sequence_);
       buffers_ = std::move(other.buffers_);
+      scope_ = other.scope_;
+      capacity_ = other.capacity_;
+      other.capacity_ = 0;
 #if defined(ASIO_HAS_IO_URING)
       if (service_)
         service_->unregister_buffers();
@@ -148,11 +222,99 @@ public:
   }
 
   /// Get the number of registered buffers.
+  /**
+   * If update() has been used, this is one more than the index of the last
+   * slot that holds a buffer. Empty slots below this index hold an empty
+   * buffer.
+   */
   std::size_t size() const noexcept
   {
     return buffers_.size();
   }
 
+  /// Get the number of slots that may hold a registered buffer.
+  std::size_t capacity() const noexcept
+  {
+    return capacity_;
+  }
+
+  /// Replace the buffer registered in a slot.
+  /**
+   * Registers a buffer in the specified slot, replacing any buffer that was
+   * previously registered there. Passing an empty buffer leaves the slot
+   * empty. The new buffer is then available using <tt>operator[](i)</tt>.
+   *
+   * Operations that are in progress on the buffer previously held in the slot
+   * are unaffected, and the memory of that buffer must remain valid until
+   * they complete. Operations on other slots may continue concurrently,
+   * but calls to update() must not be made concurrently with each other or
+   * with other member functions of the registration.
+   *
+   * @param i The index of the slot. Must be less than capacity().
+   *
+   * @param b The buffer to be registered.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void update(std::size_t i, const mutable_buffer& b)
+  {
+    asio::error_code ec;
+    update(i, b, ec);
+    asio::detail::throw_error(ec, "update");
+  }
+
+  /// Replace the buffer registered in a slot.
+  /**
+   * Registers a buffer in the specified slot, replacing any buffer that was
+   * previously registered there. Passing an empty buffer leaves the slot
+   * empty. The new buffer is then available using <tt>operator[](i)</tt>.
+   *
+   * Operations that are in progress on the buffer previously held in the slot
+   * are unaffected, and the memory of that buffer must remain valid until
+   * they complete. Operations on other slots may continue concurrently,
+   * but calls to update() must not be made concurrently with each other or
+   * with other member functions of the registration.
+   *
+   * @param i The index of the slot. Must be less than capacity().
+   *
+   * @param b The buffer to be registered.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID update(std::size_t i,
+      const mutable_buffer& b, asio::error_code& ec)
+  {
+    if (i >= capacity_)
+    {
+      ec = asio::error::invalid_argument;
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+#if defined(ASIO_HAS_IO_URING)
+    iovec v;
+    v.iov_base = b.size() ? b.data() : 0;
+    v.iov_len = b.size();
+    if (service_->update_buffers(static_cast<unsigned>(i), &v, 1, ec))
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+#endif // defined(ASIO_HAS_IO_URING)
+
+    if (b.size() > 0)
+    {
+      if (i >= buffers_.size())
+        buffers_.resize(i + 1);
+      buffers_[i] = this->make_buffer(b, scope_, static_cast<int>(i));
+    }
+    else if (i < buffers_.size())
+    {
+      buffers_[i] = mutable_registered_buffer();
+      while (!buffers_.empty() && buffers_.back().size() == 0)
+        buffers_.pop_back();
+    }
+
+    ec.assign(0, ec.category());
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
   /// Get the begin iterator for the sequence of registered buffers.
   const_iterator begin() const noexcept
   {
@@ -212,10 +374,13 @@ private:
 
   // Helper function to initialise the container of buffers.
   template <typename Iterator>
-  void init_buffers(execution_context& ctx, Iterator begin, Iterator end)
+  void init_buffers(execution_context& ctx,
+      Iterator begin, Iterator end, std::size_t capacity)
   {
     std::size_t n = std::distance(begin, end);
     buffers_.resize(n);
+    scope_ = &ctx;
+    capacity_ = capacity > n ? capacity : n;
 
 #if defined(ASIO_HAS_IO_URING)
     service_ = &use_service<detail::io_uring_service>(ctx);
@@ -239,7 +404,23 @@ private:
     }
 
 #if defined(ASIO_HAS_IO_URING)
-    if (n > 0)
+    if (capacity_ > n)
+    {
+      // Register a sparse table and fill the leading slots.
+      service_->register_buffers_sparse(static_cast<unsigned>(capacity_));
+      if (n > 0)
+      {
+        asio::error_code ec;
+        service_->update_buffers(0, &iovecs[0],
+            static_cast<unsigned>(iovecs.size()), ec);
+        if (ec)
+        {
+          service_->unregister_buffers();
+          asio::detail::throw_error(ec, "register_buffers");
+        }
+      }
+    }
+    else if (n > 0)
     {
       service_->register_buffers(&iovecs[0],
           static_cast<unsigned>(iovecs.size()));
@@ -251,6 +432,8 @@ private:
   std::vector<mutable_registered_buffer,
     ASIO_REBIND_ALLOC(allocator_type,
       mutable_registered_buffer)> buffers_;
+  const void* scope_;
+  std::size_t capacity_;
 #if defined(ASIO_HAS_IO_URING)
   detail::io_uring_service* service_;
 #endif // defined(ASIO_HAS_IO_URING)
@@ -20,6 +20,7 @@
 #include "asio/async_result.hpp"
 #include "asio/buffered_read_stream_fwd.hpp"
 #include "asio/buffer.hpp"
+#include "asio/buffered_stream_pool.hpp"
 #include "asio/detail/bind_handler.hpp"
 #include "asio/detail/buffer_resize_guard.hpp"
 #include "asio/detail/buffered_stream_storage.hpp"
@@ -42,6 +43,26 @@ template <typename> class initiate_async_buffered_read_some;
  * The buffered_read_stream class template can be used to add buffering to the
  * synchronous and asynchronous read operations of a stream.
  *
+ * By default the buffer has a fixed size. When constructed with a maximum
+ * buffer size, the buffer grows when a read fills it, up to the maximum, and
+ * shrinks again when reads leave most of it unused. The buffer may also be
+ * drawn from a buffered_stream_pool, so that streams reuse each other's
+ * memory.
+ *
+ * The data() and consume() functions allow a protocol decoder to parse
+ * messages directly from the internal buffer, rather than copying them out
+ * with read_some() or peek():
+ * @code asio::buffered_read_stream<asio::ip::tcp::socket> stream(
+ *     std::move(socket), 1024, 65536);
+ * for (;;)
+ * {
+ *   std::size_t length = parse_message(stream.data());
+ *   if (length > 0)
+ *     stream.consume(length);
+ *   else
+ *     stream.fill();
+ * } @endcode
+ *
  * @par Thread Safety
  * @e Distinct @e objects: Safe.@n
  * @e Shared @e objects: Unsafe.
@@ -87,6 +108,44 @@ public:
   {
   }
 
+  /// Construct with a buffer whose size adapts to the data read.
+  /**
+   * @param a The argument used to initialise the next layer.
+   *
+   * @param buffer_size The initial and minimum size of the buffer.
+   *
+   * @param max_buffer_size The size up to which the buffer may grow. If this
+   * is not greater than @c buffer_size, the buffer has a fixed size.
+   */
+  template <typename Arg>
+  buffered_read_stream(Arg&& a,
+      std::size_t buffer_size, std::size_t max_buffer_size)
+    : next_layer_(static_cast<Arg&&>(a)),
+      storage_(buffer_size, max_buffer_size, 0)
+  {
+  }
+
+  /// Construct with a buffer drawn from a pool.
+  /**
+   * @param a The argument used to initialise the next layer.
+   *
+   * @param pool The pool from which the buffer is obtained. The pool must
+   * outlive the stream.
+   *
+   * @param buffer_size The initial and minimum size of the buffer.
+   *
+   * @param max_buffer_size The size up to which the buffer may grow. If this
+   * is not greater than @c buffer_size, the buffer has a fixed size.
+   */
+  template <typename Arg>
+  buffered_read_stream(Arg&& a, buffered_stream_pool& pool,
+      std::size_t buffer_size = default_buffer_size,
+      std::size_t max_buffer_size = 0)
+    : next_layer_(static_cast<Arg&&>(a)),
+      storage_(buffer_size, max_buffer_size, &pool)
+  {
+  }
+
   /// Get a reference to the next layer.
   next_layer_type& next_layer()
   {
@@ -236,6 +295,32 @@ public:
     return storage_.size();
   }
 
+  /// Get the data held in the buffer, without copying it.
+  /**
+   * The returned buffer is invalidated by any subsequent operation that reads
+   * from the stream, and by a call to consume().
+   */
+  const_buffer data() const noexcept
+  {
+    return asio::buffer(storage_.data(), storage_.size());
+  }
+
+  /// Remove data from the beginning of the buffer.
+  /**
+   * Removes @c n bytes, or all of the data if @c n is greater than the amount
+   * held in the buffer.
+   */
+  void consume(std::size_t n)
+  {
+    storage_.consume(n < storage_.size() ? n : storage_.size());
+  }
+
+  /// Get the current size of the buffer.
+  std::size_t buffer_capacity() const noexcept
+  {
+    return storage_.capacity();
+  }
+
 private:
   /// Copy data out of the internal buffer to the specified target buffer.
   /// Returns the number of bytes copied.
@@ -275,6 +275,18 @@ public:
     return stream_impl_.in_avail(ec);
   }
 
+  /// Get the data held in the read buffer, without copying it.
+  const_buffer data() const noexcept
+  {
+    return stream_impl_.data();
+  }
+
+  /// Remove data from the beginning of the read buffer.
+  void consume(std::size_t n)
+  {
+    stream_impl_.consume(n);
+  }
+
 private:
   // The buffered write stream.
   typedef buffered_write_stream<Stream> write_stream_type;
@@ -0,0 +1,172 @@
+//
+// buffered_stream_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_BUFFERED_STREAM_POOL_HPP
+#define ASIO_BUFFERED_STREAM_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <new>
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class buffered_stream_storage;
+
+} // namespace detail
+
+template <typename> class pooled_allocator;
+
+/// A pool of memory blocks used as the buffers of buffered streams.
+/**
+ * A buffered_read_stream that is constructed with a pool obtains its buffer
+ * from the pool, and returns the buffer to the pool when the buffer is resized
+ * or the stream is destroyed. Containers, such as basic_streambuf, may obtain
+ * their storage from the pool by using a pooled_allocator.
+ *
+ * Blocks are grouped by size, with each size being a power of two, and a block
+ * is reused for any buffer that rounds up to the same size. The memory is
+ * freed only when the pool is destroyed, or when a block is returned to a size
+ * that already holds the maximum number of blocks.
+ *
+ * The pool must outlive every stream and allocator that uses it.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ */
+class buffered_stream_pool
+  : private detail::noncopyable
+{
+public:
+  /// Construct a pool.
+  /**
+   * @param max_blocks_per_size The maximum number of unused blocks of each
+   * size that the pool holds for reuse.
+   */
+  explicit buffered_stream_pool(std::size_t max_blocks_per_size = 64)
+    : max_blocks_per_size_(max_blocks_per_size)
+  {
+    for (int i = 0; i < num_size_classes; ++i)
+    {
+      free_lists_[i] = 0;
+      free_counts_[i] = 0;
+    }
+  }
+
+  /// Destructor frees the blocks held by the pool.
+  ~buffered_stream_pool()
+  {
+    for (int i = 0; i < num_size_classes; ++i)
+    {
+      while (block* b = free_lists_[i])
+      {
+        free_lists_[i] = b->next;
+        ::operator delete(static_cast<void*>(b));
+      }
+    }
+  }
+
+  /// Get the number of unused blocks held by the pool for reuse.
+  std::size_t cached_blocks() const
+  {
+    detail::mutex::scoped_lock lock(mutex_);
+    std::size_t count = 0;
+    for (int i = 0; i < num_size_classes; ++i)
+      count += free_counts_[i];
+    return count;
+  }
+
+private:
+  friend class detail::buffered_stream_storage;
+  template <typename> friend class pooled_allocator;
+
+  // Blocks of up to 2^(min_size_class + num_size_classes - 1) bytes are held
+  // for reuse. Larger blocks are allocated and freed directly.
+  enum { min_size_class = 6, num_size_classes = 20 };
+
+  struct block
+  {
+    block* next;
+  };
+
+  // Determine the size class for a block of the given size. Returns
+  // num_size_classes if the block is too large to be held by the pool.
+  static int size_class(std::size_t size)
+  {
+    int c = 0;
+    std::size_t class_size = std::size_t(1) << min_size_class;
+    while (class_size < size && c < num_size_classes)
+    {
+      class_size <<= 1;
+      ++c;
+    }
+    return c;
+  }
+
+  // Obtain a block with space for at least the given number of bytes.
+  void* allocate(std::size_t size)
+  {
+    int c = size_class(size);
+    if (c == num_size_classes)
+      return ::operator new(size);
+
+    {
+      detail::mutex::scoped_lock lock(mutex_);
+      if (block* b = free_lists_[c])
+      {
+        free_lists_[c] = b->next;
+        --free_counts_[c];
+        return b;
+      }
+    }
+
+    return ::operator new(std::size_t(1) << (min_size_class + c));
+  }
+
+  // Return a block obtained from allocate() with the same size.
+  void deallocate(void* p, std::size_t size) noexcept
+  {
+    int c = size_class(size);
+    if (c != num_size_classes)
+    {
+      detail::mutex::scoped_lock lock(mutex_);
+      if (free_counts_[c] < max_blocks_per_size_)
+      {
+        block* b = new (p) block;
+        b->next = free_lists_[c];
+        free_lists_[c] = b;
+        ++free_counts_[c];
+        return;
+      }
+    }
+
+    ::operator delete(p);
+  }
+
+  const std::size_t max_blocks_per_size_;
+  mutable detail::mutex mutex_;
+  block* free_lists_[num_size_classes];
+  std::size_t free_counts_[num_size_classes];
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_BUFFERED_STREAM_POOL_HPP
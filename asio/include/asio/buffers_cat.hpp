@@ -0,0 +1,341 @@
+//
+// buffers_cat.hpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_BUFFERS_CAT_HPP
+#define ASIO_BUFFERS_CAT_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include "asio/buffer.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A buffer sequence that represents the concatenation of several buffer
+/// sequences.
+/**
+ * The buffers_cat_view class template presents a number of buffer sequences
+ * as a single sequence, without allocating memory or copying the underlying
+ * data. The view holds a copy of each sequence, and its iterator visits the
+ * buffers of each sequence in turn.
+ *
+ * If every sequence satisfies the MutableBufferSequence requirements, so does
+ * the view. Otherwise the view satisfies the ConstBufferSequence
+ * requirements.
+ *
+ * A buffers_cat_view object is usually created by calling
+ * asio::buffers_cat().
+ *
+ * @par Example
+ * Writing a response made from several fragments:
+ * @code
+ * asio::write(sock, asio::buffers_cat(
+ *       asio::buffer(status_line), header_buffers, asio::buffer(body)));
+ * @endcode
+ */
+template <typename... Buffers>
+class buffers_cat_view
+{
+public:
+  static_assert(sizeof...(Buffers) > 0,
+      "buffers_cat_view requires at least one buffer sequence");
+
+  static_assert(
+      conjunction<is_const_buffer_sequence<Buffers>...>::value,
+      "Concatenated types must satisfy the ConstBufferSequence requirements");
+
+  /// The type for each element in the sequence.
+  typedef conditional_t<
+      conjunction<is_mutable_buffer_sequence<Buffers>...>::value,
+      mutable_buffer, const_buffer> value_type;
+
+  /// A bidirectional iterator type that may be used to read elements.
+  class const_iterator;
+
+  /// Construct a view that represents the concatenation of the given buffer
+  /// sequences.
+  explicit buffers_cat_view(const Buffers&... buffers)
+    : buffers_(buffers...)
+  {
+  }
+
+  /// Get a bidirectional iterator to the first element.
+  const_iterator begin() const;
+
+  /// Get a bidirectional iterator for one past the last element.
+  const_iterator end() const noexcept;
+
+private:
+  std::tuple<Buffers...> buffers_;
+};
+
+template <typename... Buffers>
+class buffers_cat_view<Buffers...>::const_iterator
+{
+public:
+  /// The type of the elements.
+  typedef typename buffers_cat_view::value_type value_type;
+
+  /// The type used for the distance between two iterators.
+  typedef std::ptrdiff_t difference_type;
+
+  /// The type of the result of applying operator->() to the iterator.
+  typedef const value_type* pointer;
+
+  /// The type of the result of applying operator*() to the iterator.
+  typedef value_type reference;
+
+  /// The iterator category.
+  typedef std::bidirectional_iterator_tag iterator_category;
+
+  /// Default constructor creates an iterator in an undefined state.
+  const_iterator() noexcept
+    : buffers_(0),
+      index_(count)
+  {
+  }
+
+  /// Dereference the iterator.
+  value_type operator*() const
+  {
+    return dereference(integral_constant<std::size_t, 0>());
+  }
+
+  /// Pre-increment the iterator.
+  const_iterator& operator++()
+  {
+    increment(integral_constant<std::size_t, 0>());
+    return *this;
+  }
+
+  /// Post-increment the iterator.
+  const_iterator operator++(int)
+  {
+    const_iterator tmp(*this);
+    ++*this;
+    return tmp;
+  }
+
+  /// Pre-decrement the iterator.
+  const_iterator& operator--()
+  {
+    decrement(integral_constant<std::size_t, 0>());
+    return *this;
+  }
+
+  /// Post-decrement the iterator.
+  const_iterator operator--(int)
+  {
+    const_iterator tmp(*this);
+    --*this;
+    return tmp;
+  }
+
+  /// Test two iterators for equality.
+  friend bool operator==(const const_iterator& a,
+      const const_iterator& b)
+  {
+    return a.buffers_ == b.buffers_ && a.index_ == b.index_
+      && a.equal(b, integral_constant<std::size_t, 0>());
+  }
+
+  /// Test two iterators for inequality.
+  friend bool operator!=(const const_iterator& a,
+      const const_iterator& b)
+  {
+    return !(a == b);
+  }
+
+private:
+  friend class buffers_cat_view;
+
+  enum { count = sizeof...(Buffers) };
+
+  // Construct an iterator to the first element of the view.
+  explicit const_iterator(const std::tuple<Buffers...>& buffers)
+    : buffers_(&buffers),
+      index_(0)
+  {
+    start(integral_constant<std::size_t, 0>());
+  }
+
+  // Construct an iterator to the end of the view.
+  const_iterator(const std::tuple<Buffers...>& buffers, std::size_t index)
+    : buffers_(&buffers),
+      index_(index)
+  {
+  }
+
+  template <std::size_t I>
+  typename std::tuple_element<I,
+    std::tuple<Buffers...>>::type const& sequence() const
+  {
+    return std::get<I>(*buffers_);
+  }
+
+  // Each operation below walks the sequences at compile time until it reaches
+  // the one that holds the iterator's current position.
+
+  template <std::size_t I>
+  value_type dereference(integral_constant<std::size_t, I>) const
+  {
+    if (index_ == I)
+      return value_type(*std::get<I>(iterators_));
+    return dereference(integral_constant<std::size_t, I + 1>());
+  }
+
+  value_type dereference(integral_constant<std::size_t, count>) const
+  {
+    return value_type();
+  }
+
+  template <std::size_t I>
+  void increment(integral_constant<std::size_t, I>)
+  {
+    if (index_ == I)
+    {
+      ++std::get<I>(iterators_);
+      settle(integral_constant<std::size_t, I>());
+    }
+    else
+      increment(integral_constant<std::size_t, I + 1>());
+  }
+
+  void increment(integral_constant<std::size_t, count>)
+  {
+  }
+
+  template <std::size_t I>
+  void decrement(integral_constant<std::size_t, I>)
+  {
+    if (index_ == I)
+      retreat(integral_constant<std::size_t, I>());
+    else
+      decrement(integral_constant<std::size_t, I + 1>());
+  }
+
+  void decrement(integral_constant<std::size_t, count>)
+  {
+    retreat_into(integral_constant<std::size_t, count>());
+  }
+
+  // Move to the first element of sequence I, or of the first non-empty
+  // sequence after it.
+  template <std::size_t I>
+  void start(integral_constant<std::size_t, I>)
+  {
+    index_ = I;
+    std::get<I>(iterators_) = asio::buffer_sequence_begin(sequence<I>());
+    settle(integral_constant<std::size_t, I>());
+  }
+
+  void start(integral_constant<std::size_t, count>)
+  {
+    index_ = count;
+  }
+
+  // If the iterator for sequence I has reached the end of that sequence, move
+  // on to the following sequence.
+  template <std::size_t I>
+  void settle(integral_constant<std::size_t, I>)
+  {
+    if (std::get<I>(iterators_) == asio::buffer_sequence_end(sequence<I>()))
+      start(integral_constant<std::size_t, I + 1>());
+  }
+
+  // Move back one element within sequence I, or to the last element of the
+  // last non-empty sequence before it.
+  template <std::size_t I>
+  void retreat(integral_constant<std::size_t, I>)
+  {
+    if (std::get<I>(iterators_) == asio::buffer_sequence_begin(sequence<I>()))
+      retreat_into(integral_constant<std::size_t, I>());
+    else
+      --std::get<I>(iterators_);
+  }
+
+  // Move to the last element of the last non-empty sequence before I.
+  template <std::size_t I>
+  void retreat_into(integral_constant<std::size_t, I>)
+  {
+    index_ = I - 1;
+    std::get<I - 1>(iterators_) =
+      asio::buffer_sequence_end(sequence<I - 1>());
+    retreat(integral_constant<std::size_t, I - 1>());
+  }
+
+  void retreat_into(integral_constant<std::size_t, 0>)
+  {
+  }
+
+  template <std::size_t I>
+  bool equal(const const_iterator& other,
+      integral_constant<std::size_t, I>) const
+  {
+    if (index_ == I)
+      return std::get<I>(iterators_) == std::get<I>(other.iterators_);
+    return equal(other, integral_constant<std::size_t, I + 1>());
+  }
+
+  bool equal(const const_iterator&,
+      integral_constant<std::size_t, count>) const
+  {
+    return true;
+  }
+
+  const std::tuple<Buffers...>* buffers_;
+  std::size_t index_;
+  std::tuple<decltype(asio::buffer_sequence_begin(
+        declval<const Buffers&>()))...> iterators_;
+};
+
+template <typename... Buffers>
+inline typename buffers_cat_view<Buffers...>::const_iterator
+buffers_cat_view<Buffers...>::begin() const
+{
+  return const_iterator(buffers_);
+}
+
+template <typename... Buffers>
+inline typename buffers_cat_view<Buffers...>::const_iterator
+buffers_cat_view<Buffers...>::end() const noexcept
+{
+  return const_iterator(buffers_, sizeof...(Buffers));
+}
+
+/// Create a view that represents the concatenation of the given buffer
+/// sequences.
+/**
+ * @returns <tt>buffers_cat_view<Buffers...>(buffers...)</tt>.
+ *
+ * @note The view holds copies of the buffer sequences, but not of the data
+ * they refer to. The underlying memory blocks must remain valid while the view
+ * is in use.
+ */
+template <typename... Buffers>
+ASIO_NODISCARD inline buffers_cat_view<Buffers...>
+buffers_cat(const Buffers&... buffers)
+{
+  return buffers_cat_view<Buffers...>(buffers...);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_BUFFERS_CAT_HPP
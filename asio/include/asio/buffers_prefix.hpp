@@ -0,0 +1,226 @@
+//
+// buffers_prefix.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_BUFFERS_PREFIX_HPP
+#define ASIO_BUFFERS_PREFIX_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <iterator>
+#include "asio/buffer.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A buffer sequence that represents the leading bytes of another buffer
+/// sequence.
+/**
+ * The buffers_prefix_view class template presents no more than a specified
+ * number of bytes from the beginning of a buffer sequence, without allocating
+ * memory or copying the underlying data. The view holds a copy of the
+ * underlying sequence, and trims its final element as required.
+ *
+ * The number of bytes represented by the view is calculated on construction,
+ * and is available from the size() member function.
+ *
+ * A buffers_prefix_view object is usually created by calling
+ * asio::buffers_prefix().
+ */
+template <typename Buffers>
+class buffers_prefix_view
+{
+public:
+  static_assert(is_const_buffer_sequence<Buffers>::value,
+      "Buffers must satisfy the ConstBufferSequence requirements");
+
+  /// The type for each element in the sequence.
+  typedef conditional_t<is_mutable_buffer_sequence<Buffers>::value,
+      mutable_buffer, const_buffer> value_type;
+
+  /// A bidirectional iterator type that may be used to read elements.
+  class const_iterator;
+
+  /// Construct a view that represents no more than @c n bytes from the
+  /// beginning of a buffer sequence.
+  buffers_prefix_view(std::size_t n, const Buffers& buffers)
+    : buffers_(buffers),
+      count_(0),
+      last_size_(0),
+      size_(0)
+  {
+    iterator iter = asio::buffer_sequence_begin(buffers_);
+    iterator end = asio::buffer_sequence_end(buffers_);
+    for (; iter != end && size_ < n; ++iter)
+    {
+      std::size_t element_size = value_type(*iter).size();
+      last_size_ = element_size < n - size_ ? element_size : n - size_;
+      size_ += last_size_;
+      ++count_;
+    }
+  }
+
+  /// Get a bidirectional iterator to the first element.
+  const_iterator begin() const
+  {
+    iterator first = asio::buffer_sequence_begin(buffers_);
+    return const_iterator(first, last(first), last_size_);
+  }
+
+  /// Get a bidirectional iterator for one past the last element.
+  const_iterator end() const
+  {
+    iterator first = asio::buffer_sequence_begin(buffers_);
+    iterator last_element = last(first);
+    iterator end = count_ == 0 ? first : std::next(last_element);
+    return const_iterator(end, last_element, last_size_);
+  }
+
+  /// Get the number of bytes represented by the view.
+  std::size_t size() const noexcept
+  {
+    return size_;
+  }
+
+private:
+  typedef decltype(asio::buffer_sequence_begin(
+        declval<const Buffers&>())) iterator;
+
+  iterator last(iterator first) const
+  {
+    return count_ == 0 ? first
+      : std::next(first, static_cast<std::ptrdiff_t>(count_ - 1));
+  }
+
+  Buffers buffers_;
+  std::size_t count_;
+  std::size_t last_size_;
+  std::size_t size_;
+};
+
+template <typename Buffers>
+class buffers_prefix_view<Buffers>::const_iterator
+{
+public:
+  /// The type of the elements.
+  typedef typename buffers_prefix_view::value_type value_type;
+
+  /// The type used for the distance between two iterators.
+  typedef std::ptrdiff_t difference_type;
+
+  /// The type of the result of applying operator->() to the iterator.
+  typedef const value_type* pointer;
+
+  /// The type of the result of applying operator*() to the iterator.
+  typedef value_type reference;
+
+  /// The iterator category.
+  typedef std::bidirectional_iterator_tag iterator_category;
+
+  /// Default constructor creates an iterator in an undefined state.
+  const_iterator() noexcept
+    : current_(),
+      last_(),
+      last_size_(0)
+  {
+  }
+
+  /// Dereference the iterator.
+  value_type operator*() const
+  {
+    value_type b(*current_);
+    return current_ == last_ ? value_type(b.data(), last_size_) : b;
+  }
+
+  /// Pre-increment the iterator.
+  const_iterator& operator++()
+  {
+    ++current_;
+    return *this;
+  }
+
+  /// Post-increment the iterator.
+  const_iterator operator++(int)
+  {
+    const_iterator tmp(*this);
+    ++current_;
+    return tmp;
+  }
+
+  /// Pre-decrement the iterator.
+  const_iterator& operator--()
+  {
+    --current_;
+    return *this;
+  }
+
+  /// Post-decrement the iterator.
+  const_iterator operator--(int)
+  {
+    const_iterator tmp(*this);
+    --current_;
+    return tmp;
+  }
+
+  /// Test two iterators for equality.
+  friend bool operator==(const const_iterator& a,
+      const const_iterator& b)
+  {
+    return a.current_ == b.current_;
+  }
+
+  /// Test two iterators for inequality.
+  friend bool operator!=(const const_iterator& a,
+      const const_iterator& b)
+  {
+    return a.current_ != b.current_;
+  }
+
+private:
+  friend class buffers_prefix_view;
+
+  const_iterator(iterator current, iterator last, std::size_t last_size)
+    : current_(current),
+      last_(last),
+      last_size_(last_size)
+  {
+  }
+
+  iterator current_;
+  iterator last_;
+  std::size_t last_size_;
+};
+
+/// Create a view that represents no more than @c n bytes from the beginning
+/// of a buffer sequence.
+/**
+ * @returns <tt>buffers_prefix_view<Buffers>(n, buffers)</tt>.
+ *
+ * @note The view holds a copy of the buffer sequence, but not of the data it
+ * refers to. The underlying memory blocks must remain valid while the view is
+ * in use.
+ */
+template <typename Buffers>
+ASIO_NODISCARD inline buffers_prefix_view<Buffers>
+buffers_prefix(std::size_t n, const Buffers& buffers)
+{
+  return buffers_prefix_view<Buffers>(n, buffers);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_BUFFERS_PREFIX_HPP
@@ -0,0 +1,219 @@
+//
+// buffers_suffix.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_BUFFERS_SUFFIX_HPP
+#define ASIO_BUFFERS_SUFFIX_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <iterator>
+#include "asio/buffer.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A buffer sequence that represents the bytes of another buffer sequence
+/// which remain after some have been consumed.
+/**
+ * The buffers_suffix class template presents the trailing bytes of a buffer
+ * sequence, without allocating memory or copying the underlying data. It is
+ * used to track progress through a buffer sequence: initially it represents
+ * the whole of the underlying sequence, and each call to consume() removes
+ * bytes from the beginning.
+ *
+ * @par Example
+ * Writing a buffer sequence with repeated calls to write_some():
+ * @code
+ * asio::buffers_suffix<std::vector<asio::const_buffer>> remaining(buffers);
+ * while (asio::buffer_size(remaining) > 0)
+ *   remaining.consume(sock.write_some(remaining));
+ * @endcode
+ */
+template <typename Buffers>
+class buffers_suffix
+{
+private:
+  typedef decltype(asio::buffer_sequence_begin(
+        declval<const Buffers&>())) iterator;
+
+public:
+  static_assert(is_const_buffer_sequence<Buffers>::value,
+      "Buffers must satisfy the ConstBufferSequence requirements");
+
+  /// The type for each element in the sequence.
+  typedef conditional_t<is_mutable_buffer_sequence<Buffers>::value,
+      mutable_buffer, const_buffer> value_type;
+
+  /// A bidirectional iterator type that may be used to read elements.
+  class const_iterator;
+
+  /// Construct a suffix that represents the whole of a buffer sequence.
+  explicit buffers_suffix(const Buffers& buffers)
+    : buffers_(buffers),
+      skip_(0),
+      offset_(0)
+  {
+  }
+
+  /// Get a bidirectional iterator to the first element.
+  const_iterator begin() const
+  {
+    iterator f = first();
+    return const_iterator(f, f, offset_);
+  }
+
+  /// Get a bidirectional iterator for one past the last element.
+  const_iterator end() const
+  {
+    return const_iterator(asio::buffer_sequence_end(buffers_),
+        first(), offset_);
+  }
+
+  /// Remove bytes from the beginning of the sequence.
+  /**
+   * If @c n is greater than the number of bytes remaining, the sequence is
+   * emptied.
+   */
+  void consume(std::size_t n)
+  {
+    iterator iter = first();
+    iterator end = asio::buffer_sequence_end(buffers_);
+    while (n > 0 && iter != end)
+    {
+      std::size_t remaining = value_type(*iter).size() - offset_;
+      if (n < remaining)
+      {
+        offset_ += n;
+        return;
+      }
+
+      n -= remaining;
+      offset_ = 0;
+      ++skip_;
+      ++iter;
+    }
+  }
+
+private:
+  iterator first() const
+  {
+    return std::next(asio::buffer_sequence_begin(buffers_),
+        static_cast<std::ptrdiff_t>(skip_));
+  }
+
+  Buffers buffers_;
+  std::size_t skip_;
+  std::size_t offset_;
+};
+
+template <typename Buffers>
+class buffers_suffix<Buffers>::const_iterator
+{
+public:
+  /// The type of the elements.
+  typedef typename buffers_suffix::value_type value_type;
+
+  /// The type used for the distance between two iterators.
+  typedef std::ptrdiff_t difference_type;
+
+  /// The type of the result of applying operator->() to the iterator.
+  typedef const value_type* pointer;
+
+  /// The type of the result of applying operator*() to the iterator.
+  typedef value_type reference;
+
+  /// The iterator category.
+  typedef std::bidirectional_iterator_tag iterator_category;
+
+  /// Default constructor creates an iterator in an undefined state.
+  const_iterator() noexcept
+    : current_(),
+      first_(),
+      offset_(0)
+  {
+  }
+
+  /// Dereference the iterator.
+  value_type operator*() const
+  {
+    value_type b(*current_);
+    return current_ == first_ ? b + offset_ : b;
+  }
+
+  /// Pre-increment the iterator.
+  const_iterator& operator++()
+  {
+    ++current_;
+    return *this;
+  }
+
+  /// Post-increment the iterator.
+  const_iterator operator++(int)
+  {
+    const_iterator tmp(*this);
+    ++current_;
+    return tmp;
+  }
+
+  /// Pre-decrement the iterator.
+  const_iterator& operator--()
+  {
+    --current_;
+    return *this;
+  }
+
+  /// Post-decrement the iterator.
+  const_iterator operator--(int)
+  {
+    const_iterator tmp(*this);
+    --current_;
+    return tmp;
+  }
+
+  /// Test two iterators for equality.
+  friend bool operator==(const const_iterator& a,
+      const const_iterator& b)
+  {
+    return a.current_ == b.current_;
+  }
+
+  /// Test two iterators for inequality.
+  friend bool operator!=(const const_iterator& a,
+      const const_iterator& b)
+  {
+    return a.current_ != b.current_;
+  }
+
+private:
+  friend class buffers_suffix;
+
+  const_iterator(iterator current, iterator first, std::size_t offset)
+    : current_(current),
+      first_(first),
+      offset_(offset)
+  {
+  }
+
+  iterator current_;
+  iterator first_;
+  std::size_t offset_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_BUFFERS_SUFFIX_HPP
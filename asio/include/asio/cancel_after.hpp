@@ -31,6 +31,11 @@ namespace asio {
  * The cancel_after_t class is used to indicate that an asynchronous operation
  * should be cancelled if not complete before the specified duration has
  * elapsed.
+ *
+ * When io_uring is the default backend, the send and receive operations of
+ * stream and datagram sockets apply a terminal, partial or total cancellation
+ * timeout as a timeout linked to the operation's submission, and no timer wait
+ * is started.
  */
 template <typename CompletionToken, typename Clock,
     typename WaitTraits = asio::wait_traits<Clock>>
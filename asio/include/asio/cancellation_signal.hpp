@@ -81,11 +81,21 @@ private:
 class cancellation_slot;
 
 /// A cancellation signal with a single slot.
+/**
+ * The signal contains enough storage for the cancellation handlers installed
+ * by asio's own asynchronous operations, so that installing such a handler
+ * does not allocate memory. Larger handlers are allocated using the
+ * recycling allocator. The signal keeps the memory of the largest such
+ * handler when it is removed, and reuses it for the next large handler, so a
+ * long-lived signal stops allocating once its largest handler has been seen.
+ */
 class cancellation_signal
 {
 public:
   constexpr cancellation_signal()
-    : handler_(0)
+    : handler_(0),
+      spare_(),
+      storage_()
   {
   }
 
@@ -106,10 +116,26 @@ public:
   cancellation_slot slot() noexcept;
 
 private:
+  friend class cancellation_slot;
+
   cancellation_signal(const cancellation_signal&) = delete;
   cancellation_signal& operator=(const cancellation_signal&) = delete;
 
+  // The size and alignment of the storage for a small handler.
+  static constexpr std::size_t storage_size = 8 * sizeof(void*);
+  static constexpr std::size_t storage_align = alignof(void*);
+
+  // Release the memory used by a handler, unless it is the signal's own
+  // storage.
+  ASIO_DECL void deallocate(std::pair<void*, std::size_t> mem) noexcept;
+
+  // Keep the memory used by a removed handler for reuse, if it is larger than
+  // the memory already kept, and release it otherwise.
+  ASIO_DECL void retain(std::pair<void*, std::size_t> mem) noexcept;
+
   detail::cancellation_handler_base* handler_;
+  std::pair<void*, std::size_t> spare_;
+  alignas(storage_align) unsigned char storage_[storage_size];
 };
 
 /// A slot associated with a cancellation signal.
@@ -118,7 +144,7 @@ class cancellation_slot
 public:
   /// Creates a slot that is not connected to any cancellation signal.
   constexpr cancellation_slot()
-    : handler_(0)
+    : signal_(0)
   {
   }
 
@@ -146,12 +172,12 @@ public:
       cancellation_handler_type;
     auto_delete_helper del = { prepare_memory(
         sizeof(cancellation_handler_type),
-        alignof(CancellationHandler)) };
+        alignof(cancellation_handler_type)), signal_ };
     cancellation_handler_type* handler_obj =
       new (del.mem.first) cancellation_handler_type(
         del.mem.second, static_cast<Args&&>(args)...);
     del.mem.first = 0;
-    *handler_ = handler_obj;
+    signal_->handler_ = handler_obj;
     return handler_obj->handler();
   }
 
@@ -184,35 +210,34 @@ public:
   /// Returns whether the slot is connected to a signal.
   constexpr bool is_connected() const noexcept
   {
-    return handler_ != 0;
+    return signal_ != 0;
   }
 
   /// Returns whether the slot is connected and has an installed handler.
   constexpr bool has_handler() const noexcept
   {
-    return handler_ != 0 && *handler_ != 0;
+    return signal_ != 0 && signal_->handler_ != 0;
   }
 
   /// Compare two slots for equality.
   friend constexpr bool operator==(const cancellation_slot& lhs,
       const cancellation_slot& rhs) noexcept
   {
-    return lhs.handler_ == rhs.handler_;
+    return lhs.signal_ == rhs.signal_;
   }
 
   /// Compare two slots for inequality.
   friend constexpr bool operator!=(const cancellation_slot& lhs,
       const cancellation_slot& rhs) noexcept
   {
-    return lhs.handler_ != rhs.handler_;
+    return lhs.signal_ != rhs.signal_;
   }
 
 private:
   friend class cancellation_signal;
 
-  constexpr cancellation_slot(int,
-      detail::cancellation_handler_base** handler)
-    : handler_(handler)
+  constexpr cancellation_slot(int, cancellation_signal* signal)
+    : signal_(signal)
   {
   }
 
@@ -222,16 +247,17 @@ private:
   struct auto_delete_helper
   {
     std::pair<void*, std::size_t> mem;
+    cancellation_signal* signal;
 
     ASIO_DECL ~auto_delete_helper();
   };
 
-  detail::cancellation_handler_base** handler_;
+  cancellation_signal* signal_;
 };
 
 inline cancellation_slot cancellation_signal::slot() noexcept
 {
-  return cancellation_slot(0, &handler_);
+  return cancellation_slot(0, this);
 }
 
 } // namespace asio
@@ -0,0 +1,698 @@
+//
+// chain_buffer.hpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_CHAIN_BUFFER_HPP
+#define ASIO_CHAIN_BUFFER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include "asio/buffer.hpp"
+#include "asio/detail/chain_buffer_sequence.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/throw_exception.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+class chain_buffer;
+
+/// A pool of fixed-size memory blocks used by chain_buffer objects.
+/**
+ * Blocks are allocated from the heap on demand. A block that is no longer
+ * used by any chain_buffer is returned to the pool and reused, and the memory
+ * is freed only when the pool is destroyed. The pool must outlive every
+ * chain_buffer that uses it, and every chain_buffer that holds a slice of
+ * data taken from such a buffer.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ */
+class chain_buffer_pool
+  : private detail::noncopyable
+{
+public:
+  /// Construct a pool of blocks with the specified size.
+  /**
+   * @param block_size The size of each block, in bytes. Must be greater than
+   * zero.
+   */
+  explicit chain_buffer_pool(std::size_t block_size = 4096)
+    : block_size_(block_size == 0 ? 1 : block_size),
+      free_list_(0)
+  {
+  }
+
+  /// Destructor frees the blocks held by the pool.
+  ~chain_buffer_pool()
+  {
+    while (free_list_)
+    {
+      detail::chain_buffer_block* block = free_list_;
+      free_list_ = block->next;
+      destroy(block);
+    }
+  }
+
+  /// Get the size of each block, in bytes.
+  std::size_t block_size() const noexcept
+  {
+    return block_size_;
+  }
+
+private:
+  friend class chain_buffer;
+
+  // Obtain a block with a single reference.
+  detail::chain_buffer_block* allocate()
+  {
+    {
+      detail::mutex::scoped_lock lock(mutex_);
+      if (detail::chain_buffer_block* block = free_list_)
+      {
+        free_list_ = block->next;
+        block->ref_count = 1;
+        return block;
+      }
+    }
+
+    void* p = ::operator new(sizeof(detail::chain_buffer_block) + block_size_);
+    detail::chain_buffer_block* block = new (p) detail::chain_buffer_block;
+    block->ref_count = 1;
+    block->next = 0;
+    block->pool = this;
+    return block;
+  }
+
+  // Return a block that no longer has any references.
+  void deallocate(detail::chain_buffer_block* block) noexcept
+  {
+    detail::mutex::scoped_lock lock(mutex_);
+    block->next = free_list_;
+    free_list_ = block;
+  }
+
+  static void destroy(detail::chain_buffer_block* block) noexcept
+  {
+    block->~chain_buffer_block();
+    ::operator delete(static_cast<void*>(block));
+  }
+
+  const std::size_t block_size_;
+  detail::mutex mutex_;
+  detail::chain_buffer_block* free_list_;
+};
+
+/// Byte storage held as a chain of reference-counted blocks.
+/**
+ * The chain_buffer class holds a sequence of bytes in blocks drawn from a
+ * chain_buffer_pool. Growing the data allocates further blocks rather than
+ * moving the data, and consuming data releases whole blocks from the
+ * beginning of the chain. The data is presented as a buffer sequence with one
+ * element per block, which the socket operations pass to the operating system
+ * as a scatter-gather list.
+ *
+ * The append() functions that take another chain_buffer add a slice of its
+ * data without copying it, by sharing the blocks that hold it. A shared block
+ * is never written to by a subsequent prepare() or grow(), so the slice
+ * continues to refer to the original data. Data modified through the buffers
+ * returned by the non-const data() functions is seen by every chain_buffer
+ * that shares the block.
+ *
+ * The input sequence is extended either in the style of @c basic_streambuf,
+ * using prepare() and commit(), or in the style of the DynamicBuffer_v2
+ * requirements, using grow() and shrink(). The chain_buffer is used with the
+ * read and write operations through a dynamic_chain_buffer object, which is
+ * usually created by calling asio::dynamic_buffer().
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * Building a response from a cached header and body without copying them:
+ * @code
+ * asio::chain_buffer response(pool);
+ * response.append(cached_header);
+ * response.append(cached_body, offset, length);
+ * asio::async_write(sock, response.data(), handler);
+ * @endcode
+ */
+class chain_buffer
+  : private detail::noncopyable
+{
+public:
+#if defined(GENERATING_DOCUMENTATION)
+  /// The type used to represent the input sequence, or a part of the data, as
+  /// a list of constant buffers.
+  typedef implementation_defined const_buffers_type;
+
+  /// The type used to represent the output sequence, or a part of the data,
+  /// as a list of mutable buffers.
+  typedef implementation_defined mutable_buffers_type;
+#else
+  typedef detail::chain_buffer_sequence<const_buffer> const_buffers_type;
+  typedef detail::chain_buffer_sequence<mutable_buffer> mutable_buffers_type;
+#endif
+
+  /// Construct a chain_buffer that allocates blocks from the specified pool.
+  /**
+   * @param pool The pool from which blocks are obtained. The pool must remain
+   * valid until the chain_buffer, and every chain_buffer that holds a slice
+   * of its data, has been destroyed.
+   *
+   * @param maximum_size Specifies a maximum size for the buffer, in bytes.
+   */
+  explicit chain_buffer(chain_buffer_pool& pool,
+      std::size_t maximum_size =
+        (std::numeric_limits<std::size_t>::max)()) noexcept
+    : pool_(pool),
+      size_(0),
+      total_size_(0),
+      max_size_(maximum_size)
+  {
+  }
+
+  /// Destructor releases the blocks used by the buffer.
+  ~chain_buffer()
+  {
+    clear();
+  }
+
+  /// Get the size of the input sequence.
+  std::size_t size() const noexcept
+  {
+    return size_;
+  }
+
+  /// Get the maximum size of the buffer.
+  std::size_t max_size() const noexcept
+  {
+    return max_size_;
+  }
+
+  /// Get the size that the input sequence may grow to without allocating
+  /// another block.
+  std::size_t capacity() const noexcept
+  {
+    return total_size_ + tail_space();
+  }
+
+  /// Get a list of buffers that represents the input sequence.
+  /**
+   * @note The returned object is invalidated by any member function that
+   * modifies the input sequence or output sequence.
+   */
+  const_buffers_type data() const noexcept
+  {
+    return const_buffers_type(segments_, 0, size_);
+  }
+
+  /// Get a list of buffers that represents part of the input sequence.
+  /**
+   * @param pos Position of the first byte to represent in the buffer sequence.
+   *
+   * @param n The number of bytes to return in the buffer sequence. If the
+   * input sequence is shorter, the buffer sequence represents as many bytes as
+   * are available.
+   *
+   * @note The returned object is invalidated by any member function that
+   * modifies the input sequence or output sequence.
+   */
+  mutable_buffers_type data(std::size_t pos, std::size_t n) noexcept
+  {
+    pos = (std::min)(pos, size_);
+    return mutable_buffers_type(segments_, pos, (std::min)(n, size_ - pos));
+  }
+
+  /// Get a list of buffers that represents part of the input sequence.
+  /**
+   * @param pos Position of the first byte to represent in the buffer sequence.
+   *
+   * @param n The number of bytes to return in the buffer sequence. If the
+   * input sequence is shorter, the buffer sequence represents as many bytes as
+   * are available.
+   *
+   * @note The returned object is invalidated by any member function that
+   * modifies the input sequence or output sequence.
+   */
+  const_buffers_type data(std::size_t pos, std::size_t n) const noexcept
+  {
+    pos = (std::min)(pos, size_);
+    return const_buffers_type(segments_, pos, (std::min)(n, size_ - pos));
+  }
+
+  /// Get a list of buffers that represents the output sequence, with the
+  /// given size.
+  /**
+   * Ensures that the output sequence can accommodate @c n bytes, allocating
+   * blocks as required. Any existing output sequence is discarded.
+   *
+   * @returns An object of type @c mutable_buffers_type that satisfies
+   * MutableBufferSequence requirements, representing memory at the start of
+   * the output sequence of size @c n.
+   *
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   *
+   * @note The returned object is invalidated by any member function that
+   * modifies the input sequence or output sequence.
+   */
+  mutable_buffers_type prepare(std::size_t n)
+  {
+    check_length(n);
+    discard_output();
+    extend(n);
+    return mutable_buffers_type(segments_, size_, n);
+  }
+
+  /// Move bytes from the output sequence to the input sequence.
+  /**
+   * @param n The number of bytes to append from the start of the output
+   * sequence to the end of the input sequence. The remainder of the output
+   * sequence is discarded.
+   *
+   * Requires a preceding call <tt>prepare(x)</tt> where <tt>x >= n</tt>, and
+   * no intervening operations that modify the input or output sequence.
+   *
+   * @note If @c n is greater than the size of the output sequence, the entire
+   * output sequence is moved to the input sequence and no error is issued.
+   */
+  void commit(std::size_t n) noexcept
+  {
+    size_ += (std::min)(n, total_size_ - size_);
+    discard_output();
+  }
+
+  /// Grow the input sequence by the specified number of bytes.
+  /**
+   * Allocates blocks as required to accommodate an additional @c n bytes at
+   * the end of the input sequence. The contents of the new bytes are
+   * unspecified. Any existing output sequence is discarded.
+   *
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   */
+  void grow(std::size_t n)
+  {
+    check_length(n);
+    discard_output();
+    extend(n);
+    size_ += n;
+  }
+
+  /// Shrink the input sequence by the specified number of bytes.
+  /**
+   * Removes @c n bytes from the end of the input sequence, releasing blocks
+   * that are no longer used. If @c n is greater than the size of the input
+   * sequence, the input sequence is emptied. Any existing output sequence is
+   * discarded.
+   */
+  void shrink(std::size_t n) noexcept
+  {
+    discard_output();
+    n = (std::min)(n, size_);
+    truncate(size_ - n);
+    size_ -= n;
+  }
+
+  /// Remove bytes from the input sequence.
+  /**
+   * Removes @c n bytes from the beginning of the input sequence, releasing
+   * blocks that are no longer used. If @c n is greater than the size of the
+   * input sequence, the entire input sequence is consumed and no error is
+   * issued.
+   */
+  void consume(std::size_t n) noexcept
+  {
+    n = (std::min)(n, size_);
+    size_ -= n;
+    total_size_ -= n;
+    while (n > 0)
+    {
+      detail::chain_buffer_segment& front = segments_.front();
+      if (front.size > n)
+      {
+        front.offset += n;
+        front.size -= n;
+        break;
+      }
+
+      n -= front.size;
+      release(front.block);
+      segments_.pop_front();
+    }
+  }
+
+  /// Append a copy of the specified data to the input sequence.
+  /**
+   * Any existing output sequence is discarded.
+   *
+   * @throws std::length_error If <tt>size() + buffer_size(buffers) >
+   * max_size()</tt>.
+   */
+  template <typename ConstBufferSequence>
+  void append(const ConstBufferSequence& buffers,
+      constraint_t<
+        is_const_buffer_sequence<ConstBufferSequence>::value
+      > = 0)
+  {
+    std::size_t n = asio::buffer_size(buffers);
+    grow(n);
+    asio::buffer_copy(data(size_ - n, n), buffers);
+  }
+
+  /// Append a slice of the input sequence of another chain_buffer, without
+  /// copying the data.
+  /**
+   * @param other The buffer that holds the data. The blocks holding the data
+   * are shared between the two buffers. The other buffer may be this buffer.
+   *
+   * @param pos The position of the first byte of the slice within the input
+   * sequence of @c other.
+   *
+   * @param n The size of the slice. If the input sequence of @c other is
+   * shorter, the slice includes as many bytes as are available.
+   *
+   * Any existing output sequence is discarded.
+   *
+   * @throws std::length_error If the appended data would make
+   * <tt>size() > max_size()</tt>.
+   */
+  void append(const chain_buffer& other, std::size_t pos = 0,
+      std::size_t n = (std::numeric_limits<std::size_t>::max)())
+  {
+    pos = (std::min)(pos, other.size_);
+    n = (std::min)(n, other.size_ - pos);
+    check_length(n);
+    discard_output();
+
+    // Indexes are used, rather than iterators, as the other buffer's segments
+    // may be the ones being appended to.
+    std::size_t count = other.segments_.size();
+    for (std::size_t i = 0; i < count && n > 0; ++i)
+    {
+      detail::chain_buffer_segment segment = other.segments_[i];
+      if (pos >= segment.size)
+      {
+        pos -= segment.size;
+        continue;
+      }
+
+      segment.offset += pos;
+      segment.size = (std::min)(segment.size - pos, n);
+      pos = 0;
+      n -= segment.size;
+
+      detail::ref_count_up(segment.block->ref_count);
+      segments_.push_back(segment);
+      size_ += segment.size;
+      total_size_ += segment.size;
+    }
+  }
+
+  /// Remove all data from the buffer, releasing its blocks.
+  void clear() noexcept
+  {
+    while (!segments_.empty())
+    {
+      release(segments_.back().block);
+      segments_.pop_back();
+    }
+    size_ = 0;
+    total_size_ = 0;
+  }
+
+private:
+  // Throw if the input sequence cannot grow by n bytes.
+  void check_length(std::size_t n) const
+  {
+    if (size_ > max_size_ || max_size_ - size_ < n)
+    {
+      std::length_error ex("chain_buffer too long");
+      asio::detail::throw_exception(ex);
+    }
+  }
+
+  // Get the free space at the end of the last block, if it may be written.
+  std::size_t tail_space() const noexcept
+  {
+    if (segments_.empty())
+      return 0;
+    const detail::chain_buffer_segment& back = segments_.back();
+    if (back.block->pool != &pool_ || back.block->ref_count != 1)
+      return 0;
+    return pool_.block_size() - back.offset - back.size;
+  }
+
+  // Add n bytes of space after the existing segments.
+  void extend(std::size_t n)
+  {
+    std::size_t space = (std::min)(tail_space(), n);
+    if (space > 0)
+    {
+      segments_.back().size += space;
+      total_size_ += space;
+      n -= space;
+    }
+
+    while (n > 0)
+    {
+      detail::chain_buffer_block* block = pool_.allocate();
+      detail::chain_buffer_segment segment = { block, 0,
+        (std::min)(pool_.block_size(), n) };
+      try
+      {
+        segments_.push_back(segment);
+      }
+      catch (...)
+      {
+        release(block);
+        throw;
+      }
+      total_size_ += segment.size;
+      n -= segment.size;
+    }
+  }
+
+  // Remove segments, or parts of segments, beyond the specified size.
+  void truncate(std::size_t size) noexcept
+  {
+    while (total_size_ > size)
+    {
+      detail::chain_buffer_segment& back = segments_.back();
+      std::size_t excess = total_size_ - size;
+      if (back.size > excess)
+      {
+        back.size -= excess;
+        total_size_ = size;
+        break;
+      }
+
+      total_size_ -= back.size;
+      release(back.block);
+      segments_.pop_back();
+    }
+  }
+
+  // Discard the output sequence.
+  void discard_output() noexcept
+  {
+    truncate(size_);
+  }
+
+  // Release a reference to a block, returning it to its pool if unused.
+  static void release(detail::chain_buffer_block* block) noexcept
+  {
+    if (detail::ref_count_down(block->ref_count))
+      block->pool->deallocate(block);
+  }
+
+  chain_buffer_pool& pool_;
+  detail::chain_buffer_segments segments_;
+  std::size_t size_;
+  std::size_t total_size_;
+  const std::size_t max_size_;
+};
+
+/// Adapt a chain_buffer to the DynamicBuffer_v1 and DynamicBuffer_v2
+/// requirements.
+/**
+ * The dynamic_chain_buffer class stores a reference to a chain_buffer
+ * object. The chain buffer's input sequence is the underlying memory of the
+ * dynamic buffer.
+ */
+class dynamic_chain_buffer
+{
+public:
+  /// The type used to represent a sequence of constant buffers that refers to
+  /// the underlying memory.
+  typedef chain_buffer::const_buffers_type const_buffers_type;
+
+  /// The type used to represent a sequence of mutable buffers that refers to
+  /// the underlying memory.
+  typedef chain_buffer::mutable_buffers_type mutable_buffers_type;
+
+  /// Construct a dynamic buffer from a chain buffer.
+  /**
+   * @param c The chain buffer to be used as backing storage for the dynamic
+   * buffer. The object stores a reference to the chain buffer and the user is
+   * responsible for ensuring that the chain buffer object remains valid while
+   * the dynamic_chain_buffer object, and copies of the object, are in use.
+   */
+  explicit dynamic_chain_buffer(chain_buffer& c) noexcept
+    : chain_(c)
+  {
+  }
+
+  /// @b DynamicBuffer_v2: Copy construct a dynamic buffer.
+  dynamic_chain_buffer(const dynamic_chain_buffer& other) noexcept
+    : chain_(other.chain_)
+  {
+  }
+
+  /// @b DynamicBuffer_v1: Get the size of the input sequence.
+  /// @b DynamicBuffer_v2: Get the current size of the underlying memory.
+  std::size_t size() const noexcept
+  {
+    return chain_.size();
+  }
+
+  /// Get the maximum size of the dynamic buffer.
+  std::size_t max_size() const noexcept
+  {
+    return chain_.max_size();
+  }
+
+  /// Get the maximum size that the buffer may grow to without allocating
+  /// another block.
+  std::size_t capacity() const noexcept
+  {
+    return chain_.capacity();
+  }
+
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+  /// @b DynamicBuffer_v1: Get a list of buffers that represents the input
+  /// sequence.
+  /**
+   * @note The returned object is invalidated by any @c dynamic_chain_buffer
+   * or @c chain_buffer member function that modifies the input sequence or
+   * output sequence.
+   */
+  const_buffers_type data() const noexcept
+  {
+    return static_cast<const chain_buffer&>(chain_).data();
+  }
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+
+  /// @b DynamicBuffer_v2: Get a sequence of buffers that represents the
+  /// underlying memory.
+  /**
+   * @param pos Position of the first byte to represent in the buffer sequence
+   *
+   * @param n The number of bytes to return in the buffer sequence. If the
+   * underlying memory is shorter, the buffer sequence represents as many bytes
+   * as are available.
+   *
+   * @note The returned object is invalidated by any @c dynamic_chain_buffer
+   * or @c chain_buffer member function that modifies the data.
+   */
+  mutable_buffers_type data(std::size_t pos, std::size_t n) noexcept
+  {
+    return chain_.data(pos, n);
+  }
+
+  /// @b DynamicBuffer_v2: Get a sequence of buffers that represents the
+  /// underlying memory.
+  /**
+   * @param pos Position of the first byte to represent in the buffer sequence
+   *
+   * @param n The number of bytes to return in the buffer sequence. If the
+   * underlying memory is shorter, the buffer sequence represents as many bytes
+   * as are available.
+   *
+   * @note The returned object is invalidated by any @c dynamic_chain_buffer
+   * or @c chain_buffer member function that modifies the data.
+   */
+  const_buffers_type data(std::size_t pos, std::size_t n) const noexcept
+  {
+    return static_cast<const chain_buffer&>(chain_).data(pos, n);
+  }
+
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+  /// @b DynamicBuffer_v1: Get a list of buffers that represents the output
+  /// sequence, with the given size.
+  /**
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   */
+  mutable_buffers_type prepare(std::size_t n)
+  {
+    return chain_.prepare(n);
+  }
+
+  /// @b DynamicBuffer_v1: Move bytes from the output sequence to the input
+  /// sequence.
+  void commit(std::size_t n)
+  {
+    chain_.commit(n);
+  }
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+
+  /// @b DynamicBuffer_v2: Grow the underlying memory by the specified number of
+  /// bytes.
+  /**
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   */
+  void grow(std::size_t n)
+  {
+    chain_.grow(n);
+  }
+
+  /// @b DynamicBuffer_v2: Shrink the underlying memory by the specified number
+  /// of bytes.
+  void shrink(std::size_t n)
+  {
+    chain_.shrink(n);
+  }
+
+  /// @b DynamicBuffer_v1: Remove characters from the input sequence.
+  /// @b DynamicBuffer_v2: Consume the specified number of bytes from the
+  /// beginning of the underlying memory.
+  void consume(std::size_t n)
+  {
+    chain_.consume(n);
+  }
+
+private:
+  chain_buffer& chain_;
+};
+
+/// Create a new dynamic buffer that represents the given chain buffer.
+/**
+ * @returns <tt>dynamic_chain_buffer(data)</tt>.
+ */
+ASIO_NODISCARD inline dynamic_chain_buffer dynamic_buffer(
+    chain_buffer& data) noexcept
+{
+  return dynamic_chain_buffer(data);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_CHAIN_BUFFER_HPP
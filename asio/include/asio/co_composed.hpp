@@ -1216,6 +1216,13 @@ namespace asio {
  * operation, or to alter its supported cancellation types, call the state's
  * @c reset_cancellation_state function.
  *
+ * @par Frame Allocation
+ * The coroutine frame is allocated using the completion handler's associated
+ * allocator, and is deallocated before the completion handler is invoked. An
+ * object that starts the same operation repeatedly, such as a connection, may
+ * bind the allocator of an asio::frame_slot to the completion handler, so that
+ * each invocation reuses the frame memory of the previous one.
+ *
  * @par Examples
  * The following example illustrates manual error handling and explicit checks
  * for cancellation. The completion handler is invoked via a @c co_yield to the
@@ -0,0 +1,47 @@
+//
+// coarse_steady_timer.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_COARSE_STEADY_TIMER_HPP
+#define ASIO_COARSE_STEADY_TIMER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/detail/coarse_steady_clock.hpp"
+
+namespace asio {
+
+/// A steady clock with a cheaper but less precise @c now() function.
+/**
+ * On Linux, this clock reads @c CLOCK_MONOTONIC_COARSE, which is updated once
+ * per kernel tick (typically every 1 to 4 milliseconds) and can be read
+ * without accessing the hardware clock. On other platforms it is equivalent
+ * to @c chrono::steady_clock.
+ */
+typedef detail::coarse_steady_clock coarse_steady_clock;
+
+/// Typedef for a timer based on the coarse steady clock.
+/**
+ * This timer is suited to timeouts that are rearmed frequently, such as an
+ * idle timeout that is pushed back after every read, where the precision of
+ * the expiry time matters less than the cost of obtaining the current time.
+ * Because the clock may lag the current time by up to one kernel tick, a
+ * timer may complete up to one tick later than it would with
+ * asio::steady_timer. It never completes before its expiry time, as measured
+ * by the coarse clock.
+ */
+typedef basic_waitable_timer<coarse_steady_clock> coarse_steady_timer;
+
+} // namespace asio
+
+#endif // ASIO_COARSE_STEADY_TIMER_HPP
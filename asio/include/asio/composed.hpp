@@ -68,11 +68,19 @@ public:
     return work_.head_.get_executor();
   }
 
-  typedef associated_executor_t<Handler, io_executor_type> executor_type;
+  // Intermediate completion handlers use the I/O executor without tracking
+  // outstanding work, since work_ keeps the work outstanding until the
+  // operation completes. When the I/O executor is also the executor of the
+  // intermediate operations' I/O objects, their completions are then
+  // delivered without per-step work counting.
+  typedef associated_executor_t<Handler,
+    typename composed_work_guard<
+      typename Work::head_type>::untracked_executor_type> executor_type;
 
   executor_type get_executor() const noexcept
   {
-    return (get_associated_executor)(handler_, work_.head_.get_executor());
+    return (get_associated_executor)(handler_,
+        work_.head_.get_untracked_executor());
   }
 
   typedef associated_allocator_t<Handler, std::allocator<void>> allocator_type;
@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <chrono>
 #include "asio/async_result.hpp"
 #include "asio/basic_socket.hpp"
 #include "asio/detail/type_traits.hpp"
@@ -30,6 +31,7 @@ namespace detail
   struct default_connect_condition;
   template <typename, typename> class initiate_async_range_connect;
   template <typename, typename> class initiate_async_iterator_connect;
+  template <typename, typename> class initiate_async_staggered_connect;
 
   template <typename T, typename = void, typename = void>
   struct is_endpoint_sequence_helper : false_type
@@ -122,6 +124,51 @@ struct is_connect_condition : detail::is_connect_condition_helper<T, Iterator>
 
 #endif // defined(GENERATING_DOCUMENTATION)
 
+/// Selects an @c async_connect operation that races connection attempts to
+/// the endpoints in a sequence.
+/**
+ * When passed to @c async_connect, this class requests the connection
+ * behaviour described in RFC 8305, "Happy Eyeballs Version 2":
+ *
+ * @li The endpoints are reordered so that address families alternate,
+ * starting with the family of the first endpoint.
+ *
+ * @li A new connection attempt is started each time the attempt delay elapses
+ * without a connection being established, or immediately when an attempt
+ * fails.
+ *
+ * @li The first attempt to succeed wins. The other attempts are cancelled.
+ *
+ * A broken path to one address family therefore costs at most the attempt
+ * delay, rather than a full connect timeout.
+ */
+class staggered_connect
+{
+public:
+  /// Construct with the attempt delay recommended by RFC 8305, 250
+  /// milliseconds.
+  staggered_connect() noexcept
+    : attempt_delay_(std::chrono::milliseconds(250))
+  {
+  }
+
+  /// Construct with the specified attempt delay.
+  explicit staggered_connect(
+      std::chrono::steady_clock::duration attempt_delay) noexcept
+    : attempt_delay_(attempt_delay)
+  {
+  }
+
+  /// Get the delay between the starts of successive connection attempts.
+  std::chrono::steady_clock::duration attempt_delay() const noexcept
+  {
+    return attempt_delay_;
+  }
+
+private:
+  std::chrono::steady_clock::duration attempt_delay_;
+};
+
 /**
  * @defgroup connect asio::connect
  *
@@ -636,6 +683,9 @@ inline auto async_connect(basic_socket<Protocol, Executor>& s,
     constraint_t<
       !is_connect_condition<RangeConnectToken,
         decltype(declval<const EndpointSequence&>().begin())>::value
+    > = 0,
+    constraint_t<
+      !is_same<decay_t<RangeConnectToken>, staggered_connect>::value
     > = 0)
   -> decltype(
     async_initiate<RangeConnectToken,
@@ -873,6 +923,88 @@ inline auto async_connect(basic_socket<Protocol, Executor>& s,
       token, endpoints, connect_condition);
 }
 
+/// Asynchronously establishes a socket connection by racing connection
+/// attempts to the endpoints in a sequence.
+/**
+ * This function attempts to connect a socket to one of a sequence of
+ * endpoints, using the staggered connection attempts described by @ref
+ * staggered_connect. Each attempt uses a socket of its own. The socket of the
+ * winning attempt is move-assigned to @c s. It is an initiating function for
+ * an @ref asynchronous_operation, and always returns immediately.
+ *
+ * @param s The socket to be connected. If the socket is already open, it will
+ * be closed. The socket's protocol must provide a nested @c socket type.
+ *
+ * @param endpoints A sequence of endpoints.
+ *
+ * @param options The attempt delay to be used.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the connect completes.
+ * Potential completion tokens include @ref use_future, @ref use_awaitable,
+ * @ref yield_context, or a function object with the correct completion
+ * signature. The function signature of the completion handler must be:
+ * @code void handler(
+ *   // Result of operation. if the sequence is empty, set to
+ *   // asio::error::not_found. Otherwise, contains the
+ *   // error from the last connection attempt to fail.
+ *   const asio::error_code& error,
+ *
+ *   // On success, the successfully connected endpoint.
+ *   // Otherwise, a default-constructed endpoint.
+ *   const typename Protocol::endpoint& endpoint
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the completion handler will not be invoked from within this function.
+ * On immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::async_immediate().
+ *
+ * @par Completion Signature
+ * @code void(asio::error_code, typename Protocol::endpoint) @endcode
+ *
+ * @par Example
+ * @code void resolve_handler(
+ *     const asio::error_code& ec,
+ *     tcp::resolver::results_type results)
+ * {
+ *   if (!ec)
+ *   {
+ *     asio::async_connect(s, results,
+ *         asio::staggered_connect(std::chrono::milliseconds(250)),
+ *         connect_handler);
+ *   }
+ * } @endcode
+ *
+ * @par Per-Operation Cancellation
+ * This asynchronous operation supports cancellation for the following
+ * asio::cancellation_type values:
+ *
+ * @li @c cancellation_type::terminal
+ *
+ * @li @c cancellation_type::partial
+ */
+template <typename Protocol, typename Executor, typename EndpointSequence,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      typename Protocol::endpoint)) RangeConnectToken
+        = default_completion_token_t<Executor>>
+inline auto async_connect(basic_socket<Protocol, Executor>& s,
+    const EndpointSequence& endpoints, const staggered_connect& options,
+    RangeConnectToken&& token = default_completion_token_t<Executor>(),
+    constraint_t<
+      is_endpoint_sequence<EndpointSequence>::value
+    > = 0)
+  -> decltype(
+    async_initiate<RangeConnectToken,
+      void (asio::error_code, typename Protocol::endpoint)>(
+        declval<detail::initiate_async_staggered_connect<Protocol, Executor>>(),
+        token, endpoints, options))
+{
+  return async_initiate<RangeConnectToken,
+    void (asio::error_code, typename Protocol::endpoint)>(
+      detail::initiate_async_staggered_connect<Protocol, Executor>(s),
+      token, endpoints, options);
+}
+
 /// Asynchronously establishes a socket connection by trying each endpoint in a
 /// sequence.
 /**
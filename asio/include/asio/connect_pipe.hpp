@@ -20,6 +20,7 @@
 #if defined(ASIO_HAS_PIPE) \
   || defined(GENERATING_DOCUMENTATION)
 
+#include <cstddef>
 #include "asio/basic_readable_pipe.hpp"
 #include "asio/basic_writable_pipe.hpp"
 #include "asio/error.hpp"
@@ -36,7 +37,7 @@ typedef int native_pipe_handle;
 #endif // defined(ASIO_HAS_IOCP)
 
 ASIO_DECL void create_pipe(native_pipe_handle p[2],
-    asio::error_code& ec);
+    std::size_t capacity, asio::error_code& ec);
 
 ASIO_DECL void close_pipe(native_pipe_handle p);
 
@@ -68,6 +69,47 @@ template <typename Executor1, typename Executor2>
 ASIO_SYNC_OP_VOID connect_pipe(basic_readable_pipe<Executor1>& read_end,
     basic_writable_pipe<Executor2>& write_end, asio::error_code& ec);
 
+/// Connect two pipe ends using an anonymous pipe with the specified capacity.
+/**
+ * @param read_end The read end of the pipe.
+ *
+ * @param write_end The write end of the pipe.
+ *
+ * @param capacity The number of bytes that the pipe should be able to hold
+ * before writes block. On Linux the capacity is set using @c F_SETPIPE_SZ, and
+ * is rounded up by the operating system. Unprivileged processes cannot exceed
+ * the limit in @c /proc/sys/fs/pipe-max-size. On Windows the capacity is used
+ * as the size of the pipe's buffers. On other platforms the capacity is
+ * ignored. A value of 0 means that the operating system's default capacity is
+ * used.
+ *
+ * @throws asio::system_error Thrown on failure.
+ */
+template <typename Executor1, typename Executor2>
+void connect_pipe(basic_readable_pipe<Executor1>& read_end,
+    basic_writable_pipe<Executor2>& write_end, std::size_t capacity);
+
+/// Connect two pipe ends using an anonymous pipe with the specified capacity.
+/**
+ * @param read_end The read end of the pipe.
+ *
+ * @param write_end The write end of the pipe.
+ *
+ * @param capacity The number of bytes that the pipe should be able to hold
+ * before writes block. On Linux the capacity is set using @c F_SETPIPE_SZ, and
+ * is rounded up by the operating system. Unprivileged processes cannot exceed
+ * the limit in @c /proc/sys/fs/pipe-max-size. On Windows the capacity is used
+ * as the size of the pipe's buffers. On other platforms the capacity is
+ * ignored. A value of 0 means that the operating system's default capacity is
+ * used.
+ *
+ * @param ec Set to indicate what error occurred, if any.
+ */
+template <typename Executor1, typename Executor2>
+ASIO_SYNC_OP_VOID connect_pipe(basic_readable_pipe<Executor1>& read_end,
+    basic_writable_pipe<Executor2>& write_end, std::size_t capacity,
+    asio::error_code& ec);
+
 } // namespace asio
 
 #include "asio/detail/pop_options.hpp"
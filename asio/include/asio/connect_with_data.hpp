@@ -0,0 +1,149 @@
+//
+// connect_with_data.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_CONNECT_WITH_DATA_HPP
+#define ASIO_CONNECT_WITH_DATA_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/async_result.hpp"
+#include "asio/basic_stream_socket.hpp"
+#include "asio/buffer.hpp"
+#include "asio/error.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename Protocol, typename Executor>
+class initiate_async_connect_with_data;
+
+} // namespace detail
+
+/**
+ * @defgroup async_connect_with_data asio::async_connect_with_data
+ *
+ * @brief The @c async_connect_with_data function is a composed asynchronous
+ * operation that establishes a stream socket connection and sends data on it,
+ * using TCP Fast Open where available.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to connect a socket and send data on it.
+/**
+ * This function is used to asynchronously connect a stream socket to the
+ * specified remote endpoint and to write all of the supplied data to it. It
+ * is an initiating function for an @ref asynchronous_operation, and always
+ * returns immediately.
+ *
+ * On Linux, the connection is initiated by a @c sendmsg call with the @c
+ * MSG_FASTOPEN flag. If the client holds a Fast Open cookie for the server,
+ * the first segment of the data is carried in the SYN, and the server can
+ * respond to it without waiting for the handshake to complete. Otherwise the
+ * kernel requests a cookie for later connections and the data is sent once
+ * the connection is established. If Fast Open is disabled on the host (see
+ * the @c net.ipv4.tcp_fastopen sysctl), or is not supported by the protocol or
+ * platform, the operation falls back to a normal connect followed by a write.
+ *
+ * Data carried in the SYN may be delivered more than once if the SYN is
+ * retransmitted, so Fast Open should only be used for requests that are safe
+ * to repeat.
+ *
+ * @param s The socket to be connected. If the socket is not already open, it
+ * will be opened using the endpoint's protocol. The socket will be placed
+ * into non-blocking mode. The object must remain valid until the completion
+ * handler is called.
+ *
+ * @param peer_endpoint The remote endpoint to which the socket will be
+ * connected. Copies will be made of the endpoint object as required.
+ *
+ * @param buffers One or more buffers containing the data to be written.
+ * Although the buffers object may be copied as necessary, ownership of the
+ * underlying memory blocks is retained by the caller, which must guarantee
+ * that they remain valid until the completion handler is called.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the operation completes.
+ * Potential completion tokens include @ref use_future, @ref use_awaitable,
+ * @ref yield_context, or a function object with the correct completion
+ * signature. The function signature of the completion handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const asio::error_code& error,
+ *
+ *   // Number of bytes written. If an error occurred, this will be the
+ *   // number of bytes successfully written prior to the error.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the completion handler will not be invoked from within this function.
+ * On immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::async_immediate().
+ *
+ * @par Completion Signature
+ * @code void(asio::error_code, std::size_t) @endcode
+ *
+ * @par Example
+ * @code
+ * asio::ip::tcp::socket socket(my_context);
+ * asio::async_connect_with_data(socket, endpoint,
+ *     asio::buffer(request),
+ *     [](asio::error_code ec, std::size_t n)
+ *     {
+ *       // ...
+ *     });
+ * @endcode
+ *
+ * @par Per-Operation Cancellation
+ * This asynchronous operation supports cancellation for the following
+ * asio::cancellation_type values:
+ *
+ * @li @c cancellation_type::terminal
+ *
+ * if they are also supported by the socket's @c async_connect, @c async_wait
+ * and @c async_write_some operations.
+ */
+template <typename Protocol, typename Executor, typename ConstBufferSequence,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) WriteToken = default_completion_token_t<Executor>>
+inline auto async_connect_with_data(basic_stream_socket<Protocol, Executor>& s,
+    const typename Protocol::endpoint& peer_endpoint,
+    const ConstBufferSequence& buffers,
+    WriteToken&& token = default_completion_token_t<Executor>(),
+    constraint_t<
+      is_const_buffer_sequence<ConstBufferSequence>::value
+    > = 0)
+  -> decltype(
+    async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        declval<detail::initiate_async_connect_with_data<Protocol, Executor>>(),
+        token, peer_endpoint, buffers))
+{
+  return async_initiate<WriteToken,
+    void (asio::error_code, std::size_t)>(
+      detail::initiate_async_connect_with_data<Protocol, Executor>(s),
+      token, peer_endpoint, buffers);
+}
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/connect_with_data.hpp"
+
+#endif // ASIO_CONNECT_WITH_DATA_HPP
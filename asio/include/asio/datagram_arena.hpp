@@ -0,0 +1,301 @@
+//
+// datagram_arena.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DATAGRAM_ARENA_HPP
+#define ASIO_DATAGRAM_ARENA_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_DATAGRAM_BATCH) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+#include "asio/associator.hpp"
+#include "asio/buffer.hpp"
+#include "asio/error.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/throw_error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename Protocol, typename Handler> class datagram_arena_handler;
+
+} // namespace detail
+
+template <typename Protocol, typename Executor> class basic_datagram_socket;
+
+/// Storage that receives a batch of datagrams into a single region of memory.
+/**
+ * A datagram arena is used with basic_datagram_socket::async_receive_arena().
+ * It holds one contiguous payload region, divided into equally sized slots,
+ * and a packed array of packet headers. Each receive operation replaces the
+ * arena's contents with the datagrams it received, so that an application
+ * may parse a whole batch by walking the headers and indexing into the
+ * payload, rather than visiting a separate buffer object for each datagram.
+ *
+ * The arena must outlive any operation that uses it, and its contents must
+ * not be accessed while an operation is outstanding.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code
+ * asio::datagram_arena<asio::ip::udp> arena(32, 1500);
+ * socket.async_receive_arena(arena,
+ *     [&](asio::error_code ec, std::size_t n)
+ *     {
+ *       for (const auto& p : arena)
+ *         parse(arena.payload(p), p.endpoint);
+ *     });
+ * @endcode
+ */
+template <typename Protocol>
+class datagram_arena
+  : private detail::noncopyable
+{
+public:
+  /// The endpoint type.
+  typedef typename Protocol::endpoint endpoint_type;
+
+  /// The clock used to timestamp received datagrams.
+  typedef std::chrono::steady_clock clock_type;
+
+  /// The header that describes a received datagram.
+  struct packet
+  {
+    /// The offset of the datagram's data from the start of the payload.
+    std::size_t offset;
+
+    /// The length of the datagram.
+    std::size_t length;
+
+    /// The endpoint of the remote sender of the datagram.
+    endpoint_type endpoint;
+
+    /// The time at which the batch containing the datagram was received.
+    clock_type::time_point timestamp;
+  };
+
+  /// The type of iterator over the packet headers.
+  typedef const packet* const_iterator;
+
+  /// The maximum number of datagrams that an arena may hold.
+  static constexpr std::size_t max_capacity = 64;
+
+  /// Construct an arena.
+  /**
+   * @param max_packets The maximum number of datagrams received by a single
+   * operation. Must be between 1 and @c max_capacity.
+   *
+   * @param max_packet_size The size of each slot in the payload region.
+   * Datagrams larger than this are truncated. Must be greater than 0.
+   *
+   * @throws asio::system_error Thrown with @c error::invalid_argument if
+   * either argument is out of range.
+   */
+  datagram_arena(std::size_t max_packets, std::size_t max_packet_size)
+    : max_packets_(max_packets),
+      max_packet_size_(max_packet_size),
+      size_(0)
+  {
+    if (max_packets == 0 || max_packets > max_capacity
+        || max_packet_size == 0
+        || max_packet_size > static_cast<std::size_t>(-1) / max_packets)
+    {
+      asio::error_code ec(asio::error::invalid_argument);
+      asio::detail::throw_error(ec, "datagram_arena");
+    }
+
+    payload_.resize(max_packets * max_packet_size);
+    buffers_.resize(max_packets);
+    endpoints_.resize(max_packets);
+    sizes_.resize(max_packets);
+    packets_.resize(max_packets);
+    for (std::size_t i = 0; i < max_packets; ++i)
+    {
+      buffers_[i] = asio::buffer(&payload_[i * max_packet_size],
+          max_packet_size);
+      packets_[i].offset = i * max_packet_size;
+      packets_[i].length = 0;
+    }
+  }
+
+  /// Get the maximum number of datagrams received by a single operation.
+  std::size_t max_packets() const noexcept
+  {
+    return max_packets_;
+  }
+
+  /// Get the size of each slot in the payload region.
+  std::size_t max_packet_size() const noexcept
+  {
+    return max_packet_size_;
+  }
+
+  /// Get the number of datagrams received by the most recent operation.
+  std::size_t size() const noexcept
+  {
+    return size_;
+  }
+
+  /// Determine whether the arena holds no datagrams.
+  bool empty() const noexcept
+  {
+    return size_ == 0;
+  }
+
+  /// Get the packed array of packet headers.
+  const packet* packets() const noexcept
+  {
+    return packets_.data();
+  }
+
+  /// Get an iterator to the first packet header.
+  const_iterator begin() const noexcept
+  {
+    return packets_.data();
+  }
+
+  /// Get an iterator past the last packet header.
+  const_iterator end() const noexcept
+  {
+    return packets_.data() + size_;
+  }
+
+  /// Get the header of a received datagram.
+  const packet& operator[](std::size_t i) const noexcept
+  {
+    return packets_[i];
+  }
+
+  /// Get the whole payload region.
+  const_buffer payload() const noexcept
+  {
+    return asio::buffer(payload_);
+  }
+
+  /// Get the data of a received datagram.
+  const_buffer payload(const packet& p) const noexcept
+  {
+    return asio::buffer(&payload_[p.offset], p.length);
+  }
+
+  /// Discard the received datagrams.
+  void clear() noexcept
+  {
+    size_ = 0;
+  }
+
+private:
+  template <typename, typename> friend class basic_datagram_socket;
+  template <typename, typename> friend class detail::datagram_arena_handler;
+
+  // Fill in the headers after a receive operation completes.
+  void complete(std::size_t messages)
+  {
+    clock_type::time_point now = clock_type::now();
+    size_ = messages < max_packets_ ? messages : max_packets_;
+    for (std::size_t i = 0; i < size_; ++i)
+    {
+      packets_[i].length = sizes_[i] < max_packet_size_
+        ? sizes_[i] : max_packet_size_;
+      packets_[i].endpoint = endpoints_[i];
+      packets_[i].timestamp = now;
+    }
+  }
+
+  std::size_t max_packets_;
+  std::size_t max_packet_size_;
+  std::size_t size_;
+  std::vector<unsigned char> payload_;
+  std::vector<mutable_buffer> buffers_;
+  std::vector<endpoint_type> endpoints_;
+  std::vector<std::size_t> sizes_;
+  std::vector<packet> packets_;
+};
+
+namespace detail {
+
+// Adapts a completion handler to fill in an arena's packet headers.
+template <typename Protocol, typename Handler>
+class datagram_arena_handler
+{
+public:
+  datagram_arena_handler(datagram_arena<Protocol>& arena, Handler& handler)
+    : arena_(&arena),
+      handler_(static_cast<Handler&&>(handler))
+  {
+  }
+
+  void operator()(const asio::error_code& ec, std::size_t messages)
+  {
+    arena_->complete(ec ? 0 : messages);
+    static_cast<Handler&&>(handler_)(ec, arena_->size());
+  }
+
+//private:
+  datagram_arena<Protocol>* arena_;
+  Handler handler_;
+};
+
+template <typename Protocol, typename Handler>
+inline bool asio_handler_is_continuation(
+    datagram_arena_handler<Protocol, Handler>* this_handler)
+{
+  return asio_handler_cont_helpers::is_continuation(this_handler->handler_);
+}
+
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <template <typename, typename> class Associator,
+    typename Protocol, typename Handler, typename DefaultCandidate>
+struct associator<Associator,
+    detail::datagram_arena_handler<Protocol, Handler>,
+    DefaultCandidate>
+  : Associator<Handler, DefaultCandidate>
+{
+  static typename Associator<Handler, DefaultCandidate>::type get(
+      const detail::datagram_arena_handler<Protocol, Handler>& h) noexcept
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static auto get(const detail::datagram_arena_handler<Protocol, Handler>& h,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<Handler, DefaultCandidate>::get(h.handler_, c))
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_DATAGRAM_BATCH)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_DATAGRAM_ARENA_HPP
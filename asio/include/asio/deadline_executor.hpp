@@ -0,0 +1,612 @@
+//
+// deadline_executor.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DEADLINE_EXECUTOR_HPP
+#define ASIO_DEADLINE_EXECUTOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <memory>
+#include "asio/associated_allocator.hpp"
+#include "asio/associated_deadline.hpp"
+#include "asio/associator.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/deadline_queue.hpp"
+#include "asio/detail/executor_function.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/execution/blocking.hpp"
+#include "asio/execution/executor.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/latency_histogram.hpp"
+#include "asio/prefer.hpp"
+#include "asio/query.hpp"
+#include "asio/require.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A call wrapper type to associate an object with a deadline.
+/**
+ * The deadline is obtained by executors, such as deadline_executor, using
+ * the associated_deadline trait.
+ */
+template <typename T>
+class deadline_binder
+{
+public:
+  /// The type of the target object.
+  typedef T target_type;
+
+  /// The type of the associated deadline.
+  typedef chrono::steady_clock::time_point deadline_type;
+
+  /// Construct a deadline wrapper for the specified object.
+  /**
+   * This constructor is only valid if the type @c T is constructible from type
+   * @c U.
+   */
+  template <typename U>
+  deadline_binder(const deadline_type& d, U&& u)
+    : deadline_(d),
+      target_(static_cast<U&&>(u))
+  {
+  }
+
+  /// Copy constructor.
+  deadline_binder(const deadline_binder& other)
+    : deadline_(other.get_deadline()),
+      target_(other.get())
+  {
+  }
+
+  /// Move constructor.
+  deadline_binder(deadline_binder&& other)
+    : deadline_(other.get_deadline()),
+      target_(static_cast<T&&>(other.get()))
+  {
+  }
+
+  /// Destructor.
+  ~deadline_binder()
+  {
+  }
+
+  /// Obtain a reference to the target object.
+  target_type& get() noexcept
+  {
+    return target_;
+  }
+
+  /// Obtain a reference to the target object.
+  const target_type& get() const noexcept
+  {
+    return target_;
+  }
+
+  /// Obtain the associated deadline.
+  deadline_type get_deadline() const noexcept
+  {
+    return deadline_;
+  }
+
+  /// Forwarding function call operator.
+  template <typename... Args>
+  result_of_t<T(Args...)> operator()(Args&&... args) &
+  {
+    return target_(static_cast<Args&&>(args)...);
+  }
+
+  /// Forwarding function call operator.
+  template <typename... Args>
+  result_of_t<T(Args...)> operator()(Args&&... args) &&
+  {
+    return static_cast<T&&>(target_)(static_cast<Args&&>(args)...);
+  }
+
+  /// Forwarding function call operator.
+  template <typename... Args>
+  result_of_t<T(Args...)> operator()(Args&&... args) const&
+  {
+    return target_(static_cast<Args&&>(args)...);
+  }
+
+private:
+  deadline_type deadline_;
+  T target_;
+};
+
+/// Associate an object of type @c T with a deadline.
+/**
+ * @par Example
+ * @code asio::post(ex,
+ *     asio::with_deadline(
+ *       std::chrono::steady_clock::now() + std::chrono::milliseconds(5),
+ *       [&]{ send_order(order); })); @endcode
+ */
+template <typename T>
+ASIO_NODISCARD inline deadline_binder<decay_t<T>>
+with_deadline(const chrono::steady_clock::time_point& d, T&& t)
+{
+  return deadline_binder<decay_t<T>>(d, static_cast<T&&>(t));
+}
+
+/// Provides earliest-deadline-first function invocation for any executor type.
+/**
+ * The deadline_executor class template adapts an underlying executor so that,
+ * of the function objects that have been submitted and are waiting to run, the
+ * one with the earliest deadline is run first. The deadline of a function
+ * object is obtained using the associated_deadline trait, and may be set using
+ * the with_deadline function. Function objects without a deadline are run
+ * after all those with a deadline, and function objects with equal deadlines
+ * are run in the order in which they were submitted. As the deadline is
+ * obtained from the function object itself, it is not seen when the function
+ * object is submitted through a type-erased wrapper, such as
+ * any_io_executor, that holds the deadline_executor.
+ *
+ * Each function object submitted to a deadline_executor is added to a queue
+ * that is shared by all copies of the executor, and a small function object is
+ * submitted to the underlying executor. When the underlying executor runs that
+ * object, it takes and runs the function object that then has the earliest
+ * deadline. Function objects are therefore run with the same concurrency as
+ * the underlying executor, and are reordered only while they are waiting for
+ * it to become available. Combine the deadline_executor with a strand to also
+ * serialise the function objects.
+ *
+ * When a function object is run after its deadline has passed, the
+ * deadline_executor counts a missed deadline and records how late it was. The
+ * counters may be obtained by calling get_metrics().
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ *
+ * @par Example
+ * @code asio::io_context ctx;
+ * auto ex = asio::make_deadline_executor(ctx);
+ * auto now = std::chrono::steady_clock::now();
+ * asio::post(ex, [&]{ update_statistics(); });
+ * asio::post(ex, asio::with_deadline(now + 2ms, [&]{ send_cancel(); }));
+ * asio::post(ex, asio::with_deadline(now + 1ms, [&]{ send_order(); }));
+ * ctx.run(); // Runs send_order(), send_cancel(), update_statistics().
+ * @endcode
+ */
+template <typename Executor>
+class deadline_executor
+{
+public:
+  /// The type of the underlying executor.
+  typedef Executor inner_executor_type;
+
+  /// A snapshot of the counters that describe the function objects that have
+  /// been run.
+  struct metrics_snapshot
+  {
+    /// The number of function objects that have been run.
+    uint64_t handlers_run;
+
+    /// The number of function objects that were run after their deadline.
+    uint64_t deadlines_missed;
+
+    /// The largest amount by which a function object has missed its deadline.
+    chrono::nanoseconds max_lateness;
+
+    /// The amounts by which function objects have missed their deadlines.
+    latency_histogram lateness;
+  };
+
+  /// Default constructor.
+  /**
+   * This constructor is only valid if the underlying executor type is default
+   * constructible.
+   */
+  deadline_executor()
+    : executor_(),
+      impl_(std::make_shared<detail::deadline_queue>())
+  {
+  }
+
+  /// Construct a deadline_executor for the specified executor.
+  template <typename Executor1>
+  explicit deadline_executor(const Executor1& e,
+      constraint_t<
+        conditional_t<
+          !is_same<Executor1, deadline_executor>::value,
+          is_convertible<Executor1, Executor>,
+          false_type
+        >::value
+      > = 0)
+    : executor_(e),
+      impl_(std::make_shared<detail::deadline_queue>())
+  {
+  }
+
+  /// Copy constructor.
+  deadline_executor(const deadline_executor& other) noexcept
+    : executor_(other.executor_),
+      impl_(other.impl_)
+  {
+  }
+
+  /// Converting constructor.
+  /**
+   * This constructor is only valid if the @c OtherExecutor type is convertible
+   * to @c Executor.
+   */
+  template <class OtherExecutor>
+  deadline_executor(
+      const deadline_executor<OtherExecutor>& other) noexcept
+    : executor_(other.executor_),
+      impl_(other.impl_)
+  {
+  }
+
+  /// Assignment operator.
+  deadline_executor& operator=(const deadline_executor& other) noexcept
+  {
+    executor_ = other.executor_;
+    impl_ = other.impl_;
+    return *this;
+  }
+
+  /// Move constructor.
+  deadline_executor(deadline_executor&& other) noexcept
+    : executor_(static_cast<Executor&&>(other.executor_)),
+      impl_(static_cast<implementation_type&&>(other.impl_))
+  {
+  }
+
+  /// Move assignment operator.
+  deadline_executor& operator=(deadline_executor&& other) noexcept
+  {
+    executor_ = static_cast<Executor&&>(other.executor_);
+    impl_ = static_cast<implementation_type&&>(other.impl_);
+    return *this;
+  }
+
+  /// Destructor.
+  ~deadline_executor() noexcept
+  {
+  }
+
+  /// Obtain the underlying executor.
+  inner_executor_type get_inner_executor() const noexcept
+  {
+    return executor_;
+  }
+
+  /// Forward a query to the underlying executor.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * asio::query customisation point.
+   */
+  template <typename Property>
+  constraint_t<
+    can_query<const Executor&, Property>::value,
+    conditional_t<
+      is_convertible<Property, execution::blocking_t>::value,
+      execution::blocking_t,
+      query_result_t<const Executor&, Property>
+    >
+  > query(const Property& p) const
+    noexcept(is_nothrow_query<const Executor&, Property>::value)
+  {
+    return this->query_helper(
+        is_convertible<Property, execution::blocking_t>(), p);
+  }
+
+  /// Forward a requirement to the underlying executor.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * asio::require customisation point.
+   *
+   * The @c execution::blocking.always property cannot be required, as a
+   * submitted function object may be run after others with earlier
+   * deadlines.
+   */
+  template <typename Property>
+  constraint_t<
+    can_require<const Executor&, Property>::value
+      && !is_convertible<Property, execution::blocking_t::always_t>::value,
+    deadline_executor<decay_t<require_result_t<const Executor&, Property>>>
+  > require(const Property& p) const
+    noexcept(is_nothrow_require<const Executor&, Property>::value)
+  {
+    return deadline_executor<
+      decay_t<require_result_t<const Executor&, Property>>>(
+        asio::require(executor_, p), impl_);
+  }
+
+  /// Forward a preference to the underlying executor.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * asio::prefer customisation point.
+   */
+  template <typename Property>
+  constraint_t<
+    can_prefer<const Executor&, Property>::value
+      && !is_convertible<Property, execution::blocking_t::always_t>::value,
+    deadline_executor<decay_t<prefer_result_t<const Executor&, Property>>>
+  > prefer(const Property& p) const
+    noexcept(is_nothrow_prefer<const Executor&, Property>::value)
+  {
+    return deadline_executor<
+      decay_t<prefer_result_t<const Executor&, Property>>>(
+        asio::prefer(executor_, p), impl_);
+  }
+
+  /// Request the deadline_executor to invoke the given function object.
+  /**
+   * This function is used to ask the deadline_executor to execute the given
+   * function object on its underlying executor. The function object is queued
+   * according to its associated deadline, and is run when the underlying
+   * executor next runs one of the deadline_executor's function objects and it
+   * has the earliest deadline of those waiting.
+   *
+   * @param f The function object to be called. The executor will make
+   * a copy of the handler object as required. The function signature of the
+   * function object must be: @code void function(); @endcode
+   */
+  template <typename Function>
+  constraint_t<
+    traits::execute_member<const Executor&, Function>::is_valid,
+    void
+  > execute(Function&& f) const
+  {
+    chrono::steady_clock::time_point deadline =
+      (get_associated_deadline)(f);
+    impl_->push(deadline, detail::executor_function(
+          static_cast<Function&&>(f), (get_associated_allocator)(f)));
+    executor_.execute(detail::deadline_queue_runner(impl_));
+  }
+
+  /// Get the number of function objects that are waiting to be run.
+  std::size_t size() const
+  {
+    return impl_->size();
+  }
+
+  /// Obtain a snapshot of the counters that describe the function objects
+  /// that have been run.
+  /**
+   * This function may be called from any thread, including while the
+   * underlying executor is running function objects.
+   */
+  metrics_snapshot get_metrics() const
+  {
+    detail::deadline_queue::counters c = impl_->get_counters();
+    metrics_snapshot m;
+    m.handlers_run = c.handlers_run;
+    m.deadlines_missed = c.deadlines_missed;
+    m.max_lateness = c.max_lateness;
+    m.lateness = c.lateness;
+    return m;
+  }
+
+  /// Compare two deadline_executors for equality.
+  /**
+   * Two deadline_executors are equal if they share the same queue.
+   */
+  friend bool operator==(const deadline_executor& a,
+      const deadline_executor& b) noexcept
+  {
+    return a.impl_ == b.impl_;
+  }
+
+  /// Compare two deadline_executors for inequality.
+  /**
+   * Two deadline_executors are equal if they share the same queue.
+   */
+  friend bool operator!=(const deadline_executor& a,
+      const deadline_executor& b) noexcept
+  {
+    return a.impl_ != b.impl_;
+  }
+
+#if defined(GENERATING_DOCUMENTATION)
+private:
+#endif // defined(GENERATING_DOCUMENTATION)
+  typedef std::shared_ptr<detail::deadline_queue> implementation_type;
+
+  deadline_executor(const Executor& ex, const implementation_type& impl)
+    : executor_(ex),
+      impl_(impl)
+  {
+  }
+
+  template <typename Property>
+  query_result_t<const Executor&, Property> query_helper(
+      false_type, const Property& property) const
+  {
+    return asio::query(executor_, property);
+  }
+
+  template <typename Property>
+  execution::blocking_t query_helper(true_type, const Property& property) const
+  {
+    execution::blocking_t result = asio::query(executor_, property);
+    return result == execution::blocking.always
+      ? execution::blocking.possibly : result;
+  }
+
+  Executor executor_;
+  implementation_type impl_;
+};
+
+/** @defgroup make_deadline_executor asio::make_deadline_executor
+ *
+ * @brief The asio::make_deadline_executor function creates a @ref
+ * deadline_executor object for an executor or execution context.
+ */
+/*@{*/
+
+/// Create a @ref deadline_executor object for an executor.
+/**
+ * @param ex An executor.
+ *
+ * @returns A deadline_executor constructed with the specified executor.
+ */
+template <typename Executor>
+inline deadline_executor<Executor> make_deadline_executor(const Executor& ex,
+    constraint_t<
+      execution::is_executor<Executor>::value
+    > = 0)
+{
+  return deadline_executor<Executor>(ex);
+}
+
+/// Create a @ref deadline_executor object for an execution context.
+/**
+ * @param ctx An execution context, from which an executor will be obtained.
+ *
+ * @returns A deadline_executor constructed with the execution context's
+ * executor, obtained by performing <tt>ctx.get_executor()</tt>.
+ */
+template <typename ExecutionContext>
+inline deadline_executor<typename ExecutionContext::executor_type>
+make_deadline_executor(ExecutionContext& ctx,
+    constraint_t<
+      is_convertible<ExecutionContext&, execution_context&>::value
+    > = 0)
+{
+  return deadline_executor<typename ExecutionContext::executor_type>(
+      ctx.get_executor());
+}
+
+/*@}*/
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <template <typename, typename> class Associator,
+    typename T, typename DefaultCandidate>
+struct associator<Associator, deadline_binder<T>, DefaultCandidate>
+  : Associator<T, DefaultCandidate>
+{
+  static typename Associator<T, DefaultCandidate>::type get(
+      const deadline_binder<T>& b) noexcept
+  {
+    return Associator<T, DefaultCandidate>::get(b.get());
+  }
+
+  static auto get(const deadline_binder<T>& b,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<T, DefaultCandidate>::get(b.get(), c))
+  {
+    return Associator<T, DefaultCandidate>::get(b.get(), c);
+  }
+};
+
+template <typename T, typename Deadline>
+struct associated_deadline<deadline_binder<T>, Deadline>
+{
+  typedef chrono::steady_clock::time_point type;
+
+  static type get(const deadline_binder<T>& b,
+      const Deadline& = Deadline()) noexcept
+  {
+    return b.get_deadline();
+  }
+};
+
+namespace traits {
+
+#if !defined(ASIO_HAS_DEDUCED_EQUALITY_COMPARABLE_TRAIT)
+
+template <typename Executor>
+struct equality_comparable<deadline_executor<Executor>>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = true;
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_EQUALITY_COMPARABLE_TRAIT)
+
+#if !defined(ASIO_HAS_DEDUCED_EXECUTE_MEMBER_TRAIT)
+
+template <typename Executor, typename Function>
+struct execute_member<deadline_executor<Executor>, Function,
+    enable_if_t<
+      traits::execute_member<const Executor&, Function>::is_valid
+    >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = false;
+  typedef void result_type;
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_EXECUTE_MEMBER_TRAIT)
+
+#if !defined(ASIO_HAS_DEDUCED_QUERY_MEMBER_TRAIT)
+
+template <typename Executor, typename Property>
+struct query_member<deadline_executor<Executor>, Property,
+    enable_if_t<
+      can_query<const Executor&, Property>::value
+    >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept =
+    is_nothrow_query<Executor, Property>::value;
+  typedef conditional_t<
+    is_convertible<Property, execution::blocking_t>::value,
+      execution::blocking_t, query_result_t<Executor, Property>> result_type;
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_QUERY_MEMBER_TRAIT)
+
+#if !defined(ASIO_HAS_DEDUCED_REQUIRE_MEMBER_TRAIT)
+
+template <typename Executor, typename Property>
+struct require_member<deadline_executor<Executor>, Property,
+    enable_if_t<
+      can_require<const Executor&, Property>::value
+        && !is_convertible<Property, execution::blocking_t::always_t>::value
+    >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept =
+    is_nothrow_require<Executor, Property>::value;
+  typedef deadline_executor<
+    decay_t<require_result_t<Executor, Property>>> result_type;
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_REQUIRE_MEMBER_TRAIT)
+
+#if !defined(ASIO_HAS_DEDUCED_PREFER_MEMBER_TRAIT)
+
+template <typename Executor, typename Property>
+struct prefer_member<deadline_executor<Executor>, Property,
+    enable_if_t<
+      can_prefer<const Executor&, Property>::value
+        && !is_convertible<Property, execution::blocking_t::always_t>::value
+    >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept =
+    is_nothrow_prefer<Executor, Property>::value;
+  typedef deadline_executor<
+    decay_t<prefer_result_t<Executor, Property>>> result_type;
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_PREFER_MEMBER_TRAIT)
+
+} // namespace traits
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DEADLINE_EXECUTOR_HPP
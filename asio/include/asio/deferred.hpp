@@ -450,6 +450,24 @@ struct is_deferred<
 #endif // !defined(GENERATING_DOCUMENTATION)
 
 /// Defines a link between two consecutive operations in a sequence.
+/**
+ * Each operation in a sequence is started from the completion handler of the
+ * one before it, after that operation has released its memory. The
+ * operations all allocate through the associated allocator of the final
+ * completion handler, so binding the allocator of an asio::frame_slot lets
+ * every stage of the sequence reuse a single block of memory.
+ *
+ * @par Example
+ * @code asio::frame_slot slot;
+ * auto pipeline = timer.async_wait(asio::deferred)
+ *   | asio::deferred(
+ *       [&](asio::error_code)
+ *       {
+ *         return socket.async_read_some(buffer, asio::deferred);
+ *       });
+ * std::move(pipeline)(asio::bind_allocator(slot.get_allocator(), handler));
+ * @endcode
+ */
 template <typename Head, typename Tail>
 class ASIO_NODISCARD deferred_sequence :
   public detail::deferred_sequence_types<Head, Tail>::base
@@ -32,6 +32,7 @@ inline void increment(atomic_count& a, long b) { a += b; }
 inline void decrement(atomic_count& a, long b) { a -= b; }
 inline void ref_count_up(atomic_count& a) { ++a; }
 inline bool ref_count_down(atomic_count& a) { return --a == 0; }
+inline bool ref_count_is_unique(const atomic_count& a) { return a == 1; }
 #else // !defined(ASIO_HAS_THREADS)
 typedef std::atomic<long> atomic_count;
 inline void increment(atomic_count& a, long b) { a += b; }
@@ -51,6 +52,14 @@ inline bool ref_count_down(atomic_count& a)
   }
   return false;
 }
+
+// Determine whether the caller holds the only reference. Only valid when no
+// other thread may add a reference concurrently, such as when references are
+// only ever added by the holder of the reference being tested.
+inline bool ref_count_is_unique(const atomic_count& a)
+{
+  return a.load(std::memory_order_acquire) == 1;
+}
 #endif // !defined(ASIO_HAS_THREADS)
 
 } // namespace detail
@@ -0,0 +1,270 @@
+//
+// detail/awaitable_frame_arena.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_AWAITABLE_FRAME_ARENA_HPP
+#define ASIO_DETAIL_AWAITABLE_FRAME_ARENA_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <vector>
+#include "asio/detail/atomic_count.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/thread_context.hpp"
+#include "asio/detail/thread_info_base.hpp"
+#include "asio/detail/tss_ptr.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class awaitable_frame_arena;
+
+template <typename Arena = awaitable_frame_arena>
+struct awaitable_frame_arena_tss
+{
+  static tss_ptr<Arena> current_;
+};
+
+template <typename Arena>
+tss_ptr<Arena> awaitable_frame_arena_tss<Arena>::current_;
+
+// A stack arena for the coroutine frames of one awaitable thread. While the
+// awaitable thread is being pumped, new frames are bump-allocated from a list
+// of contiguous chunks, and are reclaimed when the frames at the top of the
+// stack are freed. A frame that is freed out of order, or by another thread
+// after escaping (e.g. by being passed to co_spawn), is flagged and
+// reclaimed once the frames above it have gone. The arena is reference
+// counted by its owning awaitable thread and by its live frames.
+class awaitable_frame_arena
+  : private noncopyable
+{
+public:
+  // Create an arena that allocates chunks of at least the specified size.
+  static awaitable_frame_arena* create(std::size_t chunk_size)
+  {
+    return new awaitable_frame_arena(chunk_size);
+  }
+
+  // Release the owning awaitable thread's reference to the arena.
+  void release()
+  {
+    if (ref_count_down(ref_count_))
+      delete this;
+  }
+
+  // Makes an arena current for frame allocations on the calling thread.
+  class scope
+    : private noncopyable
+  {
+  public:
+    explicit scope(awaitable_frame_arena* arena)
+      : prev_(awaitable_frame_arena_tss<>::current_)
+    {
+      awaitable_frame_arena_tss<>::current_ = arena;
+    }
+
+    ~scope()
+    {
+      awaitable_frame_arena_tss<>::current_ = prev_;
+    }
+
+  private:
+    awaitable_frame_arena* prev_;
+  };
+
+  // Allocate a coroutine frame, using the current arena if there is one, and
+  // otherwise the thread-local recycling cache.
+  static void* allocate_frame(std::size_t size)
+  {
+    if (awaitable_frame_arena* arena = awaitable_frame_arena_tss<>::current_)
+      return arena->allocate(size);
+
+#if !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+    void* const pointer = thread_info_base::allocate(
+        thread_info_base::awaitable_frame_tag(),
+        thread_context::top_of_thread_call_stack(),
+        sizeof(block_header) + size);
+#else // !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+    void* const pointer = ::operator new(sizeof(block_header) + size);
+#endif // !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+    block_header* const block = new (pointer) block_header;
+    block->arena_ = 0;
+    return block + 1;
+  }
+
+  // Deallocate a coroutine frame.
+  static void deallocate_frame(void* pointer, std::size_t size)
+  {
+    block_header* const block = static_cast<block_header*>(pointer) - 1;
+    if (awaitable_frame_arena* arena = block->arena_)
+    {
+      arena->deallocate(block);
+      return;
+    }
+
+    block->~block_header();
+#if !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+    thread_info_base::deallocate(
+        thread_info_base::awaitable_frame_tag(),
+        thread_context::top_of_thread_call_stack(),
+        block, sizeof(block_header) + size);
+#else // !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+    (void)size;
+    ::operator delete(block);
+#endif // !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+  }
+
+private:
+  // Prefixed to every frame, whether or not it is allocated from an arena.
+  struct alignas(ASIO_DEFAULT_ALIGN) block_header
+  {
+    awaitable_frame_arena* arena_;
+    std::atomic<bool> freed_;
+  };
+
+  // A contiguous region from which frames are bump-allocated.
+  struct alignas(ASIO_DEFAULT_ALIGN) chunk
+  {
+    chunk* prev_;
+    std::size_t capacity_;
+    std::size_t used_;
+
+    unsigned char* data()
+    {
+      return reinterpret_cast<unsigned char*>(this + 1);
+    }
+  };
+
+  // An allocated frame, in stack order.
+  struct entry
+  {
+    block_header* block_;
+    chunk* chunk_;
+  };
+
+  explicit awaitable_frame_arena(std::size_t chunk_size)
+    : chunk_size_(chunk_size),
+      current_(0),
+      spare_(0),
+      ref_count_(1)
+  {
+  }
+
+  ~awaitable_frame_arena()
+  {
+    free_chunk(spare_);
+    while (chunk* c = current_)
+    {
+      current_ = c->prev_;
+      free_chunk(c);
+    }
+  }
+
+  void* allocate(std::size_t size)
+  {
+    reclaim();
+
+    std::size_t need = sizeof(block_header) + size;
+    need = (need + ASIO_DEFAULT_ALIGN - 1) & ~(ASIO_DEFAULT_ALIGN - 1);
+    blocks_.reserve(blocks_.size() + 1);
+
+    if (!current_ || current_->capacity_ - current_->used_ < need)
+    {
+      chunk* c = spare_;
+      if (c && c->capacity_ >= need)
+        spare_ = 0;
+      else
+      {
+        std::size_t capacity = need > chunk_size_ ? need : chunk_size_;
+        void* p = aligned_new(ASIO_DEFAULT_ALIGN, sizeof(chunk) + capacity);
+        c = static_cast<chunk*>(p);
+        c->capacity_ = capacity;
+      }
+      c->prev_ = current_;
+      c->used_ = 0;
+      current_ = c;
+    }
+
+    block_header* const block = new (current_->data() + current_->used_)
+      block_header;
+    block->arena_ = this;
+    block->freed_.store(false, std::memory_order_relaxed);
+    current_->used_ += need;
+    entry e = { block, current_ };
+    blocks_.push_back(e);
+    ref_count_up(ref_count_);
+    return block + 1;
+  }
+
+  void deallocate(block_header* block)
+  {
+    block->freed_.store(true, std::memory_order_release);
+    if (awaitable_frame_arena_tss<>::current_ == this)
+      reclaim();
+    release();
+  }
+
+  // Pop freed frames from the top of the stack. Called only by the owning
+  // awaitable thread.
+  void reclaim()
+  {
+    while (!blocks_.empty()
+        && blocks_.back().block_->freed_.load(std::memory_order_acquire))
+    {
+      entry e = blocks_.back();
+      blocks_.pop_back();
+      e.block_->~block_header();
+      e.chunk_->used_ = reinterpret_cast<unsigned char*>(e.block_)
+        - e.chunk_->data();
+      if (e.chunk_->used_ == 0 && e.chunk_->prev_)
+      {
+        current_ = e.chunk_->prev_;
+        free_chunk(spare_);
+        spare_ = e.chunk_;
+      }
+    }
+  }
+
+  static void free_chunk(chunk* c)
+  {
+    if (c)
+      aligned_delete(c);
+  }
+
+  // The minimum size of each chunk.
+  const std::size_t chunk_size_;
+
+  // The chunk from which frames are currently allocated.
+  chunk* current_;
+
+  // An empty chunk retained for reuse.
+  chunk* spare_;
+
+  // The allocated frames, in stack order.
+  std::vector<entry> blocks_;
+
+  // One reference for the owning awaitable thread, and one for each frame.
+  atomic_count ref_count_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_AWAITABLE_FRAME_ARENA_HPP
@@ -0,0 +1,261 @@
+//
+// detail/bounded_mpmc_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_BOUNDED_MPMC_QUEUE_HPP
+#define ASIO_DETAIL_BOUNDED_MPMC_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A bounded, lock-free queue of values that supports any number of concurrent
+// producers and consumers. The implementation follows Dmitry Vyukov's bounded
+// MPMC queue, where each cell carries a sequence number that tells producers
+// and consumers whether the cell is free for the current position. Sequence
+// numbers advance by two per use of a cell, so that a queue with a capacity of
+// one can distinguish a full cell from a free one.
+//
+// The value type's move constructor must not throw.
+template <typename T>
+class bounded_mpmc_queue
+  : private noncopyable
+{
+public:
+  // Holds a value that has been removed from the queue.
+  class value_holder
+    : private noncopyable
+  {
+  public:
+    value_holder()
+      : has_value_(false)
+    {
+    }
+
+    ~value_holder()
+    {
+      if (has_value_)
+        get().~T();
+    }
+
+    T& get()
+    {
+      return *static_cast<T*>(static_cast<void*>(&storage_));
+    }
+
+  private:
+    friend class bounded_mpmc_queue;
+    aligned_storage_t<sizeof(T), alignment_of<T>::value> storage_;
+    bool has_value_;
+  };
+
+  // Construct a queue with no capacity.
+  bounded_mpmc_queue()
+    : enqueue_pos_(0),
+      dequeue_pos_(0),
+      capacity_(0),
+      cells_(0)
+  {
+  }
+
+  // Destructor destroys any values that remain in the queue.
+  ~bounded_mpmc_queue()
+  {
+    clear();
+    delete[] cells_;
+  }
+
+  // Allocate storage for the specified number of values. Must not be called
+  // concurrently with any other operation.
+  void allocate(std::size_t capacity)
+  {
+    clear();
+    delete[] cells_;
+    cells_ = 0;
+    capacity_ = capacity;
+    enqueue_pos_.store(0, std::memory_order_relaxed);
+    dequeue_pos_.store(0, std::memory_order_relaxed);
+    if (capacity > 0)
+    {
+      cells_ = new cell[capacity];
+      for (std::size_t i = 0; i < capacity; ++i)
+        cells_[i].sequence_.store(2 * i, std::memory_order_relaxed);
+    }
+  }
+
+  // Exchange the contents with another queue. Must not be called concurrently
+  // with any other operation on either queue.
+  void swap(bounded_mpmc_queue& other)
+  {
+    std::size_t tmp = enqueue_pos_.load(std::memory_order_relaxed);
+    enqueue_pos_.store(other.enqueue_pos_.load(
+          std::memory_order_relaxed), std::memory_order_relaxed);
+    other.enqueue_pos_.store(tmp, std::memory_order_relaxed);
+    tmp = dequeue_pos_.load(std::memory_order_relaxed);
+    dequeue_pos_.store(other.dequeue_pos_.load(
+          std::memory_order_relaxed), std::memory_order_relaxed);
+    other.dequeue_pos_.store(tmp, std::memory_order_relaxed);
+    tmp = capacity_;
+    capacity_ = other.capacity_;
+    other.capacity_ = tmp;
+    cell* tmp_cells = cells_;
+    cells_ = other.cells_;
+    other.cells_ = tmp_cells;
+  }
+
+  // Get the maximum number of values that may be held in the queue.
+  std::size_t capacity() const noexcept
+  {
+    return capacity_;
+  }
+
+  // Determine whether the queue appears to be empty. The result is only a
+  // snapshot when called concurrently with other threads.
+  bool empty() const noexcept
+  {
+    std::size_t dequeue_pos = dequeue_pos_.load(std::memory_order_acquire);
+    return enqueue_pos_.load(std::memory_order_acquire) == dequeue_pos;
+  }
+
+  // Determine whether the queue appears to be full. The result is only a
+  // snapshot when called concurrently with other threads.
+  bool full() const noexcept
+  {
+    std::size_t dequeue_pos = dequeue_pos_.load(std::memory_order_acquire);
+    return enqueue_pos_.load(std::memory_order_acquire)
+      - dequeue_pos >= capacity_;
+  }
+
+  // Add a value to the back of the queue. Returns false if the queue is full,
+  // in which case the value is left unchanged.
+  bool try_push(T& value)
+  {
+    if (capacity_ == 0)
+      return false;
+
+    std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;)
+    {
+      cell& c = cells_[pos % capacity_];
+      std::size_t seq = c.sequence_.load(std::memory_order_acquire);
+      std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - 2 * pos);
+      if (diff == 0)
+      {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+              std::memory_order_relaxed, std::memory_order_relaxed))
+        {
+          new (&c.storage_) T(static_cast<T&&>(value));
+          c.sequence_.store(2 * pos + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (diff < 0)
+      {
+        // The cell still holds the value from one lap ago.
+        return false;
+      }
+      else
+      {
+        // Another producer claimed this position first.
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Remove a value from the front of the queue. Returns false if the queue is
+  // empty. The holder must not already contain a value.
+  bool try_pop(value_holder& holder)
+  {
+    if (capacity_ == 0)
+      return false;
+
+    std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    for (;;)
+    {
+      cell& c = cells_[pos % capacity_];
+      std::size_t seq = c.sequence_.load(std::memory_order_acquire);
+      std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - (2 * pos + 1));
+      if (diff == 0)
+      {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+              std::memory_order_relaxed, std::memory_order_relaxed))
+        {
+          T* v = static_cast<T*>(static_cast<void*>(&c.storage_));
+          new (&holder.storage_) T(static_cast<T&&>(*v));
+          holder.has_value_ = true;
+          v->~T();
+          c.sequence_.store(2 * (pos + capacity_), std::memory_order_release);
+          return true;
+        }
+      }
+      else if (diff < 0)
+      {
+        // The cell has not yet been filled for this position.
+        return false;
+      }
+      else
+      {
+        // Another consumer claimed this position first.
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Remove and destroy all values in the queue.
+  void clear()
+  {
+    for (;;)
+    {
+      value_holder holder;
+      if (!try_pop(holder))
+        break;
+    }
+  }
+
+private:
+  struct cell
+  {
+    std::atomic<std::size_t> sequence_;
+    aligned_storage_t<sizeof(T), alignment_of<T>::value> storage_;
+  };
+
+  // The position at which the next value will be added.
+  std::atomic<std::size_t> enqueue_pos_;
+
+  // Padding to keep producer and consumer positions on separate cache lines.
+  char padding_[64 - sizeof(std::atomic<std::size_t>)];
+
+  // The position from which the next value will be removed.
+  std::atomic<std::size_t> dequeue_pos_;
+
+  // The number of cells in the queue.
+  std::size_t capacity_;
+
+  // The cells that hold the queued values.
+  cell* cells_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_BOUNDED_MPMC_QUEUE_HPP
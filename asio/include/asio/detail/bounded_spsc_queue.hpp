@@ -0,0 +1,236 @@
+//
+// detail/bounded_spsc_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_BOUNDED_SPSC_QUEUE_HPP
+#define ASIO_DETAIL_BOUNDED_SPSC_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A bounded, wait-free queue of values for one producer and one consumer. At
+// any time only one thread may add values and only one thread may remove them,
+// although either role may be handed to another thread provided that the hand
+// over is itself synchronised. Each side keeps a cached copy of the other
+// side's position, so that the shared positions are read only when the cached
+// copy says the queue is full or empty.
+//
+// The value type's move constructor must not throw.
+template <typename T>
+class bounded_spsc_queue
+  : private noncopyable
+{
+public:
+  // Holds a value that has been removed from the queue.
+  class value_holder
+    : private noncopyable
+  {
+  public:
+    value_holder()
+      : has_value_(false)
+    {
+    }
+
+    ~value_holder()
+    {
+      if (has_value_)
+        get().~T();
+    }
+
+    T& get()
+    {
+      return *static_cast<T*>(static_cast<void*>(&storage_));
+    }
+
+  private:
+    friend class bounded_spsc_queue;
+    aligned_storage_t<sizeof(T), alignment_of<T>::value> storage_;
+    bool has_value_;
+  };
+
+  // Construct a queue with no capacity.
+  bounded_spsc_queue()
+    : enqueue_pos_(0),
+      cached_dequeue_pos_(0),
+      dequeue_pos_(0),
+      cached_enqueue_pos_(0),
+      capacity_(0),
+      cells_(0)
+  {
+  }
+
+  // Destructor destroys any values that remain in the queue.
+  ~bounded_spsc_queue()
+  {
+    clear();
+    delete[] cells_;
+  }
+
+  // Allocate storage for the specified number of values. Must not be called
+  // concurrently with any other operation.
+  void allocate(std::size_t capacity)
+  {
+    clear();
+    delete[] cells_;
+    cells_ = 0;
+    capacity_ = capacity;
+    enqueue_pos_.store(0, std::memory_order_relaxed);
+    cached_dequeue_pos_ = 0;
+    dequeue_pos_.store(0, std::memory_order_relaxed);
+    cached_enqueue_pos_ = 0;
+    if (capacity > 0)
+      cells_ = new cell[capacity];
+  }
+
+  // Exchange the contents with another queue. Must not be called concurrently
+  // with any other operation on either queue.
+  void swap(bounded_spsc_queue& other)
+  {
+    std::size_t tmp = enqueue_pos_.load(std::memory_order_relaxed);
+    enqueue_pos_.store(other.enqueue_pos_.load(
+          std::memory_order_relaxed), std::memory_order_relaxed);
+    other.enqueue_pos_.store(tmp, std::memory_order_relaxed);
+    tmp = dequeue_pos_.load(std::memory_order_relaxed);
+    dequeue_pos_.store(other.dequeue_pos_.load(
+          std::memory_order_relaxed), std::memory_order_relaxed);
+    other.dequeue_pos_.store(tmp, std::memory_order_relaxed);
+    tmp = cached_enqueue_pos_;
+    cached_enqueue_pos_ = other.cached_enqueue_pos_;
+    other.cached_enqueue_pos_ = tmp;
+    tmp = cached_dequeue_pos_;
+    cached_dequeue_pos_ = other.cached_dequeue_pos_;
+    other.cached_dequeue_pos_ = tmp;
+    tmp = capacity_;
+    capacity_ = other.capacity_;
+    other.capacity_ = tmp;
+    cell* tmp_cells = cells_;
+    cells_ = other.cells_;
+    other.cells_ = tmp_cells;
+  }
+
+  // Get the maximum number of values that may be held in the queue.
+  std::size_t capacity() const noexcept
+  {
+    return capacity_;
+  }
+
+  // Determine whether the queue appears to be empty. The result is only a
+  // snapshot when called concurrently with the producer.
+  bool empty() const noexcept
+  {
+    std::size_t dequeue_pos = dequeue_pos_.load(std::memory_order_acquire);
+    return enqueue_pos_.load(std::memory_order_acquire) == dequeue_pos;
+  }
+
+  // Determine whether the queue appears to be full. The result is only a
+  // snapshot when called concurrently with the consumer.
+  bool full() const noexcept
+  {
+    std::size_t dequeue_pos = dequeue_pos_.load(std::memory_order_acquire);
+    return enqueue_pos_.load(std::memory_order_acquire)
+      - dequeue_pos >= capacity_;
+  }
+
+  // Add a value to the back of the queue. Returns false if the queue is full,
+  // in which case the value is left unchanged. Called only by the producer.
+  bool try_push(T& value)
+  {
+    std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    if (pos - cached_dequeue_pos_ >= capacity_)
+    {
+      cached_dequeue_pos_ = dequeue_pos_.load(std::memory_order_acquire);
+      if (pos - cached_dequeue_pos_ >= capacity_)
+        return false;
+    }
+
+    new (&cells_[pos % capacity_].storage_) T(static_cast<T&&>(value));
+    enqueue_pos_.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Remove a value from the front of the queue. Returns false if the queue is
+  // empty. The holder must not already contain a value. Called only by the
+  // consumer.
+  bool try_pop(value_holder& holder)
+  {
+    std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    if (pos == cached_enqueue_pos_)
+    {
+      cached_enqueue_pos_ = enqueue_pos_.load(std::memory_order_acquire);
+      if (pos == cached_enqueue_pos_)
+        return false;
+    }
+
+    T* v = static_cast<T*>(
+        static_cast<void*>(&cells_[pos % capacity_].storage_));
+    new (&holder.storage_) T(static_cast<T&&>(*v));
+    holder.has_value_ = true;
+    v->~T();
+    dequeue_pos_.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Remove and destroy all values in the queue.
+  void clear()
+  {
+    for (;;)
+    {
+      value_holder holder;
+      if (!try_pop(holder))
+        break;
+    }
+  }
+
+private:
+  struct cell
+  {
+    aligned_storage_t<sizeof(T), alignment_of<T>::value> storage_;
+  };
+
+  // The position at which the next value will be added.
+  std::atomic<std::size_t> enqueue_pos_;
+
+  // The producer's most recently observed consumer position.
+  std::size_t cached_dequeue_pos_;
+
+  // Padding to keep producer and consumer positions on separate cache lines.
+  char padding_[64 - sizeof(std::atomic<std::size_t>) - sizeof(std::size_t)];
+
+  // The position from which the next value will be removed.
+  std::atomic<std::size_t> dequeue_pos_;
+
+  // The consumer's most recently observed producer position.
+  std::size_t cached_enqueue_pos_;
+
+  // The number of cells in the queue.
+  std::size_t capacity_;
+
+  // The cells that hold the queued values.
+  cell* cells_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_BOUNDED_SPSC_QUEUE_HPP
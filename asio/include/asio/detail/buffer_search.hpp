@@ -0,0 +1,123 @@
+//
+// detail/buffer_search.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_BUFFER_SEARCH_HPP
+#define ASIO_DETAIL_BUFFER_SEARCH_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include "asio/buffer.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Algorithms that search the data in a buffer sequence one contiguous buffer
+// at a time, using the C library's memchr and memcmp functions. Positions are
+// byte offsets from the beginning of the sequence.
+
+// Finds the first occurrence of a character at or after the given position.
+// Returns the position of the character, or the total size of the buffers if
+// the character was not found.
+template <typename ConstBufferSequence>
+std::size_t buffer_find(const ConstBufferSequence& buffers,
+    std::size_t position, char value)
+{
+  std::size_t offset = 0;
+  for (auto iter = asio::buffer_sequence_begin(buffers),
+      end = asio::buffer_sequence_end(buffers); iter != end; ++iter)
+  {
+    asio::const_buffer buffer(*iter);
+    if (buffer.size() > 0 && position < offset + buffer.size())
+    {
+      const char* data = static_cast<const char*>(buffer.data());
+      std::size_t start = position > offset ? position - offset : 0;
+      if (const void* match = std::memchr(
+            data + start, value, buffer.size() - start))
+        return offset + (static_cast<const char*>(match) - data);
+    }
+    offset += buffer.size();
+  }
+  return offset;
+}
+
+// Finds the first occurrence of a string at or after the given position. The
+// first member of the result is the position at which the match begins, with
+// the second member set to true for a full match, or to false for a partial
+// match that continues to the end of the buffers. If no match was found, the
+// result is the total size of the buffers and false.
+template <typename ConstBufferSequence>
+std::pair<std::size_t, bool> buffer_partial_search(
+    const ConstBufferSequence& buffers, std::size_t position,
+    const char* value, std::size_t length)
+{
+  typedef decltype(asio::buffer_sequence_begin(buffers)) iterator;
+  iterator end = asio::buffer_sequence_end(buffers);
+
+  std::size_t offset = 0;
+  for (iterator iter = asio::buffer_sequence_begin(buffers);
+      iter != end; ++iter)
+  {
+    asio::const_buffer buffer(*iter);
+    const char* data = static_cast<const char*>(buffer.data());
+    std::size_t start = position > offset ? position - offset : 0;
+    while (start < buffer.size())
+    {
+      if (length == 0)
+        return std::make_pair(offset + start, true);
+
+      const void* first = std::memchr(
+          data + start, value[0], buffer.size() - start);
+      if (first == 0)
+        break;
+      start = static_cast<const char*>(first) - data;
+
+      // Compare the remainder of the string, which may continue into the
+      // following buffers.
+      iterator test_iter = iter;
+      std::size_t test_start = start;
+      std::size_t matched = 0;
+      for (;;)
+      {
+        asio::const_buffer test_buffer(*test_iter);
+        std::size_t n = test_buffer.size() - test_start;
+        if (n > length - matched)
+          n = length - matched;
+        if (n > 0 && std::memcmp(static_cast<const char*>(test_buffer.data())
+              + test_start, value + matched, n) != 0)
+          break;
+        matched += n;
+        if (matched == length)
+          return std::make_pair(offset + start, true);
+        if (++test_iter == end)
+          return std::make_pair(offset + start, false);
+        test_start = 0;
+      }
+
+      ++start;
+    }
+    offset += buffer.size();
+  }
+  return std::make_pair(offset, false);
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_BUFFER_SEARCH_HPP
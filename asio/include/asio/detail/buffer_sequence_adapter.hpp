@@ -24,6 +24,11 @@
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
+
+template <typename... Buffers> class buffers_cat_view;
+template <typename Buffers> class buffers_prefix_view;
+template <typename Buffers> class buffers_suffix;
+
 namespace detail {
 
 class buffer_sequence_adapter_base
@@ -99,6 +104,103 @@ protected:
 #endif // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
 };
 
+// Helper template to determine the number of native buffers needed for the
+// elements of a buffer sequence of fixed length N.
+template <std::size_t N>
+struct fixed_buffer_sequence_native_buffers
+{
+  enum
+  {
+    max_buffers = buffer_sequence_adapter_base::max_buffers,
+    value = N == 0 ? 1
+      : N < max_buffers ? N : static_cast<std::size_t>(max_buffers)
+  };
+};
+
+// Helper template to determine the number of native buffers that the adapter
+// needs for a buffer sequence type. Sequence types that have a length known at
+// compile time specialise this template, so that only as much storage as the
+// sequence can use is reserved.
+template <typename Buffers>
+struct buffer_sequence_native_buffers
+{
+  enum { value = buffer_sequence_adapter_base::max_buffers };
+};
+
+template <typename Elem, std::size_t N>
+struct buffer_sequence_native_buffers<boost::array<Elem, N>>
+  : fixed_buffer_sequence_native_buffers<N>
+{
+};
+
+template <typename Elem, std::size_t N>
+struct buffer_sequence_native_buffers<std::array<Elem, N>>
+  : fixed_buffer_sequence_native_buffers<N>
+{
+};
+
+template <>
+struct buffer_sequence_native_buffers<mutable_buffer>
+  : fixed_buffer_sequence_native_buffers<1>
+{
+};
+
+template <>
+struct buffer_sequence_native_buffers<const_buffer>
+  : fixed_buffer_sequence_native_buffers<1>
+{
+};
+
+template <>
+struct buffer_sequence_native_buffers<mutable_registered_buffer>
+  : fixed_buffer_sequence_native_buffers<1>
+{
+};
+
+template <>
+struct buffer_sequence_native_buffers<const_registered_buffer>
+  : fixed_buffer_sequence_native_buffers<1>
+{
+};
+
+// A concatenation needs the storage of its component sequences combined.
+template <typename... Buffers>
+struct buffer_sequence_native_buffers_sum;
+
+template <>
+struct buffer_sequence_native_buffers_sum<>
+{
+  static constexpr std::size_t value = 0;
+};
+
+template <typename Head, typename... Tail>
+struct buffer_sequence_native_buffers_sum<Head, Tail...>
+{
+  static constexpr std::size_t value =
+    static_cast<std::size_t>(buffer_sequence_native_buffers<Head>::value)
+      + buffer_sequence_native_buffers_sum<Tail...>::value;
+};
+
+template <typename... Buffers>
+struct buffer_sequence_native_buffers<buffers_cat_view<Buffers...>>
+  : fixed_buffer_sequence_native_buffers<
+      buffer_sequence_native_buffers_sum<Buffers...>::value>
+{
+};
+
+// A prefix or suffix has no more elements than the underlying sequence.
+template <typename Buffers>
+struct buffer_sequence_native_buffers<buffers_prefix_view<Buffers>>
+  : buffer_sequence_native_buffers<Buffers>
+{
+};
+
+template <typename Buffers>
+struct buffer_sequence_native_buffers<buffers_suffix<Buffers>>
+  : buffer_sequence_native_buffers<Buffers>
+{
+};
+
 // Helper class to translate buffers into the native buffer representation.
 template <typename Buffer, typename Buffers>
 class buffer_sequence_adapter
@@ -108,6 +210,9 @@ public:
   enum { is_single_buffer = false };
   enum { is_registered_buffer = false };
 
+  // The number of native buffers that the adapter can hold.
+  enum { max_native_buffers = buffer_sequence_native_buffers<Buffers>::value };
+
   explicit buffer_sequence_adapter(const Buffers& buffer_sequence)
     : count_(0), total_buffer_size_(0)
   {
@@ -177,7 +282,7 @@ private:
   void init(Iterator begin, Iterator end)
   {
     Iterator iter = begin;
-    for (; iter != end && count_ < max_buffers; ++iter, ++count_)
+    for (; iter != end && count_ < max_native_buffers; ++iter, ++count_)
     {
       Buffer buffer(*iter);
       init_native_buffer(buffers_[count_], buffer);
@@ -244,7 +349,7 @@ private:
     return Buffer(storage.data(), storage.size() - unused_storage.size());
   }
 
-  native_buffer_type buffers_[max_buffers];
+  native_buffer_type buffers_[max_native_buffers];
   std::size_t count_;
   std::size_t total_buffer_size_;
 };
@@ -17,10 +17,12 @@
 
 #include "asio/detail/config.hpp"
 #include "asio/buffer.hpp"
+#include "asio/buffered_stream_pool.hpp"
 #include "asio/detail/assert.hpp"
+#include "asio/detail/noncopyable.hpp"
 #include <cstddef>
 #include <cstring>
-#include <vector>
+#include <new>
 
 #include "asio/detail/push_options.hpp"
 
@@ -28,6 +30,7 @@ namespace asio {
 namespace detail {
 
 class buffered_stream_storage
+  : private noncopyable
 {
 public:
   // The type of the bytes stored in the buffer.
@@ -40,10 +43,38 @@ public:
   explicit buffered_stream_storage(std::size_t buffer_capacity)
     : begin_offset_(0),
       end_offset_(0),
-      buffer_(buffer_capacity)
+      capacity_(buffer_capacity),
+      min_capacity_(buffer_capacity),
+      max_capacity_(buffer_capacity),
+      target_capacity_(buffer_capacity),
+      small_fills_(0),
+      pool_(0),
+      buffer_(allocate(buffer_capacity))
   {
   }
 
+  // Construct a buffer whose capacity adapts to the amount of data read,
+  // between the specified limits, with memory drawn from an optional pool.
+  buffered_stream_storage(std::size_t min_capacity,
+      std::size_t max_capacity, buffered_stream_pool* pool)
+    : begin_offset_(0),
+      end_offset_(0),
+      capacity_(min_capacity == 0 ? 1 : min_capacity),
+      min_capacity_(capacity_),
+      max_capacity_(max_capacity < capacity_ ? capacity_ : max_capacity),
+      target_capacity_(capacity_),
+      small_fills_(0),
+      pool_(pool),
+      buffer_(allocate(capacity_))
+  {
+  }
+
+  // Destructor.
+  ~buffered_stream_storage()
+  {
+    deallocate(buffer_, capacity_);
+  }
+
   /// Clear the buffer.
   void clear()
   {
@@ -54,13 +85,13 @@ public:
   // Return a pointer to the beginning of the unread data.
   mutable_buffer data()
   {
-    return asio::buffer(buffer_) + begin_offset_;
+    return asio::buffer(buffer_, capacity_) + begin_offset_;
   }
 
   // Return a pointer to the beginning of the unread data.
   const_buffer data() const
   {
-    return asio::buffer(buffer_) + begin_offset_;
+    return asio::buffer(buffer_, capacity_) + begin_offset_;
   }
 
   // Is there no unread data in the buffer.
@@ -86,7 +117,7 @@ public:
     else
     {
       using namespace std; // For memmove.
-      memmove(&buffer_[0], &buffer_[0] + begin_offset_, size());
+      memmove(buffer_, buffer_ + begin_offset_, size());
       end_offset_ = length;
       begin_offset_ = 0;
     }
@@ -95,7 +126,7 @@ public:
   // Return the maximum size for data in the buffer.
   size_type capacity() const
   {
-    return buffer_.size();
+    return capacity_;
   }
 
   // Consume multiple bytes from the beginning of the buffer.
@@ -107,15 +138,104 @@ public:
       clear();
   }
 
+  // Apply any change of capacity chosen by earlier reads, before reading more
+  // data into the buffer. The buffer grows while holding unread data, which is
+  // moved to the new memory, but is shrunk only when it is empty.
+  void prepare_fill()
+  {
+    if (target_capacity_ > capacity_
+        || (target_capacity_ < capacity_ && empty()))
+    {
+      byte_type* new_buffer = allocate(target_capacity_);
+      size_type length = size();
+      if (length > 0)
+      {
+        using namespace std; // For memcpy.
+        memcpy(new_buffer, buffer_ + begin_offset_, length);
+      }
+      deallocate(buffer_, capacity_);
+      buffer_ = new_buffer;
+      capacity_ = target_capacity_;
+      begin_offset_ = 0;
+      end_offset_ = length;
+    }
+  }
+
+  // Record the number of bytes placed into the buffer by a read, and the free
+  // space that was available to it. A read that fills the free space doubles
+  // the capacity for the next read. Consecutive reads that leave at least
+  // three quarters of the buffer unused halve it.
+  void record_fill(size_type bytes_transferred, size_type space)
+  {
+    if (bytes_transferred > 0 && bytes_transferred == space
+        && capacity_ < max_capacity_)
+    {
+      target_capacity_ = capacity_ < max_capacity_ / 2
+        ? capacity_ * 2 : max_capacity_;
+      small_fills_ = 0;
+    }
+    else if (capacity_ > min_capacity_ && size() <= capacity_ / 4)
+    {
+      if (++small_fills_ >= shrink_threshold)
+      {
+        target_capacity_ = capacity_ / 2 > min_capacity_
+          ? capacity_ / 2 : min_capacity_;
+        small_fills_ = 0;
+      }
+    }
+    else
+    {
+      small_fills_ = 0;
+    }
+  }
+
 private:
+  // The number of consecutive small reads after which the buffer is shrunk.
+  enum { shrink_threshold = 4 };
+
+  byte_type* allocate(size_type length)
+  {
+    if (length == 0)
+      return 0;
+    if (pool_)
+      return static_cast<byte_type*>(pool_->allocate(length));
+    return static_cast<byte_type*>(::operator new(length));
+  }
+
+  void deallocate(byte_type* p, size_type length) noexcept
+  {
+    if (p == 0)
+      return;
+    if (pool_)
+      pool_->deallocate(p, length);
+    else
+      ::operator delete(p);
+  }
+
   // The offset to the beginning of the unread data.
   size_type begin_offset_;
 
   // The offset to the end of the unread data.
   size_type end_offset_;
 
+  // The current size of the buffer.
+  size_type capacity_;
+
+  // The limits between which the size of the buffer adapts.
+  size_type min_capacity_;
+  size_type max_capacity_;
+
+  // The size to which the buffer is changed before the next read.
+  size_type target_capacity_;
+
+  // The number of consecutive reads that left most of the buffer unused.
+  size_type small_fills_;
+
+  // The pool from which the buffer is obtained, if any.
+  buffered_stream_pool* pool_;
+
   // The data in the buffer.
-  std::vector<byte_type> buffer_;
+  byte_type* buffer_;
 };
 
 } // namespace detail
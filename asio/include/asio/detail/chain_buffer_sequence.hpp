@@ -0,0 +1,205 @@
+//
+// detail/chain_buffer_sequence.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_CHAIN_BUFFER_SEQUENCE_HPP
+#define ASIO_DETAIL_CHAIN_BUFFER_SEQUENCE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include "asio/detail/atomic_count.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+class chain_buffer_pool;
+
+namespace detail {
+
+// A reference-counted block of memory belonging to a chain_buffer_pool. The
+// block's data immediately follows the header.
+struct chain_buffer_block
+{
+  atomic_count ref_count;
+  chain_buffer_block* next;
+  chain_buffer_pool* pool;
+
+  unsigned char* data() noexcept
+  {
+    return reinterpret_cast<unsigned char*>(this + 1);
+  }
+};
+
+// A range of bytes within a block. Each segment holds one reference to its
+// block.
+struct chain_buffer_segment
+{
+  chain_buffer_block* block;
+  std::size_t offset;
+  std::size_t size;
+};
+
+typedef std::deque<chain_buffer_segment> chain_buffer_segments;
+
+// A buffer sequence that refers to a range of bytes held in a sequence of
+// segments, trimming the first and last segments as required.
+template <typename Buffer>
+class chain_buffer_sequence
+{
+public:
+  typedef chain_buffer_segments::const_iterator segment_iterator;
+
+  // The iterator type, which produces one buffer per segment.
+  class const_iterator
+  {
+  public:
+    typedef std::ptrdiff_t difference_type;
+    typedef Buffer value_type;
+    typedef const Buffer* pointer;
+    typedef Buffer reference;
+    typedef std::bidirectional_iterator_tag iterator_category;
+
+    const_iterator() noexcept
+      : first_offset_(0),
+        last_end_(0)
+    {
+    }
+
+    Buffer operator*() const noexcept
+    {
+      std::size_t begin = current_ == first_ ? first_offset_ : 0;
+      std::size_t end = current_ == last_ ? last_end_ : current_->size;
+      return Buffer(current_->block->data()
+          + current_->offset + begin, end - begin);
+    }
+
+    const_iterator& operator++() noexcept
+    {
+      ++current_;
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept
+    {
+      const_iterator tmp(*this);
+      ++current_;
+      return tmp;
+    }
+
+    const_iterator& operator--() noexcept
+    {
+      --current_;
+      return *this;
+    }
+
+    const_iterator operator--(int) noexcept
+    {
+      const_iterator tmp(*this);
+      --current_;
+      return tmp;
+    }
+
+    friend bool operator==(const const_iterator& a,
+        const const_iterator& b) noexcept
+    {
+      return a.current_ == b.current_;
+    }
+
+    friend bool operator!=(const const_iterator& a,
+        const const_iterator& b) noexcept
+    {
+      return a.current_ != b.current_;
+    }
+
+  private:
+    friend class chain_buffer_sequence;
+
+    const_iterator(const chain_buffer_sequence& s,
+        segment_iterator current) noexcept
+      : current_(current),
+        first_(s.first_),
+        last_(s.last_),
+        first_offset_(s.first_offset_),
+        last_end_(s.last_end_)
+    {
+    }
+
+    segment_iterator current_;
+    segment_iterator first_;
+    segment_iterator last_;
+    std::size_t first_offset_;
+    std::size_t last_end_;
+  };
+
+  // Construct a sequence that refers to n bytes starting at the given
+  // position within the segments. The range must lie within the segments.
+  chain_buffer_sequence(const chain_buffer_segments& segments,
+      std::size_t position, std::size_t n) noexcept
+    : first_(segments.begin()),
+      last_(segments.begin()),
+      end_(segments.begin()),
+      first_offset_(0),
+      last_end_(0)
+  {
+    if (n == 0)
+      return;
+
+    while (position >= first_->size)
+    {
+      position -= first_->size;
+      ++first_;
+    }
+
+    last_ = first_;
+    std::size_t end = position + n;
+    while (end > last_->size)
+    {
+      end -= last_->size;
+      ++last_;
+    }
+
+    end_ = last_;
+    ++end_;
+    first_offset_ = position;
+    last_end_ = end;
+  }
+
+  // Get an iterator to the first buffer in the sequence.
+  const_iterator begin() const noexcept
+  {
+    return const_iterator(*this, first_);
+  }
+
+  // Get an iterator to one past the last buffer in the sequence.
+  const_iterator end() const noexcept
+  {
+    return const_iterator(*this, end_);
+  }
+
+private:
+  segment_iterator first_;
+  segment_iterator last_;
+  segment_iterator end_;
+  std::size_t first_offset_;
+  std::size_t last_end_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_CHAIN_BUFFER_SEQUENCE_HPP
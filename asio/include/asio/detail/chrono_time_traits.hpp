@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/cstdint.hpp"
+#include "asio/detail/type_traits.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -29,6 +30,21 @@ struct gcd { enum { value = gcd<v2, v1 % v2>::value }; };
 template <int64_t v1>
 struct gcd<v1, 0> { enum { value = v1 }; };
 
+// Helper template to obtain the timer wheel resolution, in microseconds, from
+// the wait traits. A resolution of zero means that no timer wheel is used.
+template <typename WaitTraits, typename = void>
+struct wait_traits_timer_wheel_resolution
+{
+  static constexpr long value = 0;
+};
+
+template <typename WaitTraits>
+struct wait_traits_timer_wheel_resolution<WaitTraits,
+    void_t<decltype(WaitTraits::timer_wheel_resolution)>>
+{
+  static constexpr long value = WaitTraits::timer_wheel_resolution;
+};
+
 // Adapts std::chrono clocks for use with a deadline timer.
 template <typename Clock, typename WaitTraits>
 struct chrono_time_traits
@@ -45,6 +61,10 @@ struct chrono_time_traits
   // The period of the clock.
   typedef typename duration_type::period period_type;
 
+  // The resolution of the timer wheel, if the wait traits select one.
+  static constexpr long timer_wheel_resolution =
+    wait_traits_timer_wheel_resolution<WaitTraits>::value;
+
   // Get the current time.
   static time_type now()
   {
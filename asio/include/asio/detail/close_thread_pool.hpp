@@ -0,0 +1,106 @@
+//
+// detail/close_thread_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_CLOSE_THREAD_POOL_HPP
+#define ASIO_DETAIL_CLOSE_THREAD_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if !defined(ASIO_HAS_IOCP) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
+#include "asio/execution_context.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/operation.hpp"
+#include "asio/detail/scheduler.hpp"
+#include "asio/detail/thread_group.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Closes descriptors on internal threads, so that a close that blocks, such as
+// one that lingers to send unsent data, does not hold up the reactor.
+class close_thread_pool :
+  public execution_context_service_base<close_thread_pool>
+{
+public:
+  // Constructor.
+  ASIO_DECL close_thread_pool(execution_context& context);
+
+  // Destructor.
+  ASIO_DECL ~close_thread_pool();
+
+  // Destroy all user-defined handler objects owned by the service.
+  ASIO_DECL void shutdown();
+
+  // Perform any fork-related housekeeping.
+  ASIO_DECL void notify_fork(execution_context::fork_event fork_ev);
+
+  // Start an operation that performs the close on an internal thread, and is
+  // then passed back to the scheduler for completion.
+  ASIO_DECL void start_close_op(operation* op, bool is_continuation);
+
+  // Get the scheduler used to deliver completions.
+  scheduler& owner_scheduler()
+  {
+    return scheduler_;
+  }
+
+private:
+  // Helper class to run the work scheduler in a thread.
+  class work_scheduler_runner;
+
+  // Start the work scheduler if it's not already running.
+  ASIO_DECL void start_work_threads();
+
+  // The scheduler used to post completions.
+  scheduler& scheduler_;
+
+  // Mutex to protect access to internal data.
+  asio::detail::mutex mutex_;
+
+  // Private scheduler used for performing the closes.
+  scheduler work_scheduler_;
+
+  // Threads used for running the work scheduler's run loop.
+  thread_group<execution_context::allocator<void>> work_threads_;
+
+  // The number of threads used to run the work scheduler.
+  unsigned int num_work_threads_;
+
+  // Whether closes are performed on the internal threads. Otherwise, they are
+  // performed by the calling thread.
+  bool scheduler_locking_;
+
+  // Whether the scheduler has been shut down.
+  bool shutdown_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/close_thread_pool.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // !defined(ASIO_HAS_IOCP)
+       //   && !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
+#endif // ASIO_DETAIL_CLOSE_THREAD_POOL_HPP
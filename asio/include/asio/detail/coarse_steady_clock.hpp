@@ -0,0 +1,63 @@
+//
+// detail/coarse_steady_clock.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_COARSE_STEADY_CLOCK_HPP
+#define ASIO_DETAIL_COARSE_STEADY_CLOCK_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/chrono.hpp"
+
+#if defined(__linux__)
+# include <time.h>
+#endif // defined(__linux__)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A steady clock that reads the time kept by the kernel's periodic tick, where
+// that is available, and so avoids reading the hardware clock. The time is
+// measured from the same epoch as CLOCK_MONOTONIC.
+class coarse_steady_clock
+{
+public:
+  typedef chrono::nanoseconds duration;
+  typedef duration::rep rep;
+  typedef duration::period period;
+  typedef chrono::time_point<coarse_steady_clock> time_point;
+
+  static constexpr bool is_steady = true;
+
+  static time_point now() noexcept
+  {
+#if defined(__linux__) && defined(CLOCK_MONOTONIC_COARSE)
+    timespec ts;
+    if (::clock_gettime(CLOCK_MONOTONIC_COARSE, &ts) == 0)
+    {
+      return time_point(duration(
+            static_cast<rep>(ts.tv_sec) * 1000000000 + ts.tv_nsec));
+    }
+#endif // defined(__linux__) && defined(CLOCK_MONOTONIC_COARSE)
+    return time_point(chrono::duration_cast<duration>(
+          chrono::steady_clock::now().time_since_epoch()));
+  }
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_COARSE_STEADY_CLOCK_HPP
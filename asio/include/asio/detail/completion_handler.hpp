@@ -38,6 +38,7 @@ public:
       handler_(static_cast<Handler&&>(h)),
       work_(handler_, io_ex)
   {
+    set_latency_kind(latency_post);
   }
 
   static void do_complete(void* owner, operation* base,
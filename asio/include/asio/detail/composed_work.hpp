@@ -36,6 +36,11 @@ public:
       prefer_result_t<Executor, execution::outstanding_work_t::tracked_t>
     > executor_type;
 
+  typedef decay_t<
+      prefer_result_t<executor_type,
+        execution::outstanding_work_t::untracked_t>
+    > untracked_executor_type;
+
   composed_work_guard(const Executor& ex)
     : executor_(asio::prefer(ex, execution::outstanding_work.tracked))
   {
@@ -50,6 +55,13 @@ public:
     return executor_;
   }
 
+  // Get the executor without outstanding work, for use by intermediate
+  // completion handlers while the guard keeps the work outstanding.
+  untracked_executor_type get_untracked_executor() const noexcept
+  {
+    return asio::prefer(executor_, execution::outstanding_work.untracked);
+  }
+
 private:
   executor_type executor_;
 };
@@ -59,6 +71,7 @@ struct composed_work_guard<system_executor>
 {
 public:
   typedef system_executor executor_type;
+  typedef system_executor untracked_executor_type;
 
   composed_work_guard(const system_executor&)
   {
@@ -72,6 +85,11 @@ public:
   {
     return system_executor();
   }
+
+  untracked_executor_type get_untracked_executor() const noexcept
+  {
+    return system_executor();
+  }
 };
 
 #if !defined(ASIO_NO_TS_EXECUTORS)
@@ -83,10 +101,17 @@ struct composed_work_guard<Executor,
     >
   > : executor_work_guard<Executor>
 {
+  typedef Executor untracked_executor_type;
+
   composed_work_guard(const Executor& ex)
     : executor_work_guard<Executor>(ex)
   {
   }
+
+  untracked_executor_type get_untracked_executor() const noexcept
+  {
+    return this->get_executor();
+  }
 };
 
 #endif // !defined(ASIO_NO_TS_EXECUTORS)
@@ -33,6 +33,10 @@
 // If set, this bit indicates that the reactor should perform locking for I/O.
 #define ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_IO 0x4u
 
+// If set, this bit indicates that the scheduler should use per-thread work
+// queues with work stealing.
+#define ASIO_CONCURRENCY_HINT_SCHEDULER_WORK_STEALING 0x8u
+
 // Helper macro to determine if we have a special concurrency hint.
 #define ASIO_CONCURRENCY_HINT_IS_SPECIAL(hint) \
   ((static_cast<unsigned>(hint) \
@@ -46,6 +50,12 @@
       | ASIO_CONCURRENCY_HINT_LOCKING_ ## facility)) \
         ^ ASIO_CONCURRENCY_HINT_ID) != 0)
 
+// Helper macro to determine if work stealing is enabled for a given hint.
+#define ASIO_CONCURRENCY_HINT_IS_WORK_STEALING(hint) \
+  (ASIO_CONCURRENCY_HINT_IS_SPECIAL(hint) \
+    && (static_cast<unsigned>(hint) \
+      & ASIO_CONCURRENCY_HINT_SCHEDULER_WORK_STEALING) != 0)
+
 // This special concurrency hint disables locking in both the scheduler and
 // reactor I/O. This hint has the following restrictions:
 //
@@ -78,6 +88,16 @@
       | ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_REGISTRATION \
       | ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_IO)
 
+// This special concurrency hint provides full thread safety, and enables
+// per-thread work queues with work stealing in the scheduler. It is intended
+// for an io_context that is run from many threads.
+#define ASIO_CONCURRENCY_HINT_WORK_STEALING \
+  static_cast<int>(ASIO_CONCURRENCY_HINT_ID \
+      | ASIO_CONCURRENCY_HINT_LOCKING_SCHEDULER \
+      | ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_REGISTRATION \
+      | ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_IO \
+      | ASIO_CONCURRENCY_HINT_SCHEDULER_WORK_STEALING)
+
 // This #define may be overridden at compile time to specify a program-wide
 // default concurrency hint, used by the zero-argument io_context constructor.
 #if !defined(ASIO_CONCURRENCY_HINT_DEFAULT)
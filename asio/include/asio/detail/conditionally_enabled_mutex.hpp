@@ -147,6 +147,12 @@ public:
     }
   }
 
+  // Try to lock the mutex without blocking.
+  bool try_lock()
+  {
+    return !enabled_ || mutex_.try_lock();
+  }
+
   // Unlock the mutex.
   void unlock()
   {
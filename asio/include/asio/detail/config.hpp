@@ -847,6 +847,13 @@
 #   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,22)
 #  endif // !defined(ASIO_DISABLE_EVENTFD)
 # endif // !defined(ASIO_HAS_EVENTFD)
+# if !defined(ASIO_HAS_SIGNALFD)
+#  if !defined(ASIO_DISABLE_SIGNALFD)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,27)
+#    define ASIO_HAS_SIGNALFD 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,27)
+#  endif // !defined(ASIO_DISABLE_SIGNALFD)
+# endif // !defined(ASIO_HAS_SIGNALFD)
 # if !defined(ASIO_HAS_TIMERFD)
 #  if defined(ASIO_HAS_EPOLL)
 #   if (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 8)
@@ -854,6 +861,13 @@
 #   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 8)
 #  endif // defined(ASIO_HAS_EPOLL)
 # endif // !defined(ASIO_HAS_TIMERFD)
+# if !defined(ASIO_HAS_MIRRORED_MEMORY)
+#  if !defined(ASIO_DISABLE_MIRRORED_MEMORY)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(3,17,0)
+#    define ASIO_HAS_MIRRORED_MEMORY 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(3,17,0)
+#  endif // !defined(ASIO_DISABLE_MIRRORED_MEMORY)
+# endif // !defined(ASIO_HAS_MIRRORED_MEMORY)
 # if defined(ASIO_HAS_IO_URING)
 #  if LINUX_VERSION_CODE < KERNEL_VERSION(5,10,0)
 #   error Linux kernel 5.10 or later is required to support io_uring
@@ -892,6 +906,25 @@
 # endif // !defined(ASIO_HAS_DEV_POLL)
 #endif // defined(__sun)
 
+// POSIX: poll, where none of epoll, kqueue or /dev/poll is available.
+#if !defined(ASIO_HAS_POLL)
+# if !defined(ASIO_WINDOWS) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(__CYGWIN__)
+#  if !defined(ASIO_HAS_EPOLL) \
+  && !defined(ASIO_HAS_KQUEUE) \
+  && !defined(ASIO_HAS_DEV_POLL)
+#   if !defined(ASIO_DISABLE_POLL)
+#    define ASIO_HAS_POLL 1
+#   endif // !defined(ASIO_DISABLE_POLL)
+#  endif // !defined(ASIO_HAS_EPOLL)
+         //   && !defined(ASIO_HAS_KQUEUE)
+         //   && !defined(ASIO_HAS_DEV_POLL)
+# endif // !defined(ASIO_WINDOWS)
+        //   && !defined(ASIO_WINDOWS_RUNTIME)
+        //   && !defined(__CYGWIN__)
+#endif // !defined(ASIO_HAS_POLL)
+
 // Serial ports.
 #if !defined(ASIO_HAS_SERIAL_PORT)
 # if defined(ASIO_HAS_IOCP) \
@@ -969,6 +1002,93 @@
 # endif // !defined(ASIO_DISABLE_LOCAL_SOCKETS)
 #endif // !defined(ASIO_HAS_LOCAL_SOCKETS)
 
+// Passing file descriptors over local sockets.
+#if !defined(ASIO_HAS_FD_PASSING)
+# if !defined(ASIO_DISABLE_FD_PASSING)
+#  if defined(ASIO_HAS_LOCAL_SOCKETS) \
+    && !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+#   define ASIO_HAS_FD_PASSING 1
+#  endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+         //   && !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+# endif // !defined(ASIO_DISABLE_FD_PASSING)
+#endif // !defined(ASIO_HAS_FD_PASSING)
+
+// Shared-memory streams between local processes.
+#if !defined(ASIO_HAS_SHM_STREAM)
+# if !defined(ASIO_DISABLE_SHM_STREAM)
+#  if defined(__linux__) \
+    && defined(ASIO_HAS_FD_PASSING) \
+    && defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+#   define ASIO_HAS_SHM_STREAM 1
+#  endif // defined(__linux__)
+         //   && defined(ASIO_HAS_FD_PASSING)
+         //   && defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+# endif // !defined(ASIO_DISABLE_SHM_STREAM)
+#endif // !defined(ASIO_HAS_SHM_STREAM)
+
+// Rings of provided buffers for receive operations.
+#if !defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+# if !defined(ASIO_DISABLE_PROVIDED_BUFFER_RING)
+#  if !defined(ASIO_HAS_IOCP) && !defined(ASIO_WINDOWS_RUNTIME)
+#   define ASIO_HAS_PROVIDED_BUFFER_RING 1
+#  endif // !defined(ASIO_HAS_IOCP) && !defined(ASIO_WINDOWS_RUNTIME)
+# endif // !defined(ASIO_DISABLE_PROVIDED_BUFFER_RING)
+#endif // !defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+
+// Batched datagram send and receive operations.
+#if !defined(ASIO_HAS_DATAGRAM_BATCH)
+# if !defined(ASIO_DISABLE_DATAGRAM_BATCH)
+#  if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+#   define ASIO_HAS_DATAGRAM_BATCH 1
+#  endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+# endif // !defined(ASIO_DISABLE_DATAGRAM_BATCH)
+#endif // !defined(ASIO_HAS_DATAGRAM_BATCH)
+
+// Memory-mapped packet capture rings.
+#if !defined(ASIO_HAS_PACKET_RING)
+# if !defined(ASIO_DISABLE_PACKET_RING)
+#  if defined(__linux__)
+#   define ASIO_HAS_PACKET_RING 1
+#  endif // defined(__linux__)
+# endif // !defined(ASIO_DISABLE_PACKET_RING)
+#endif // !defined(ASIO_HAS_PACKET_RING)
+
+// Sets of descriptors waited on with a single readiness operation.
+#if !defined(ASIO_HAS_READINESS_SET)
+# if !defined(ASIO_DISABLE_READINESS_SET)
+#  if defined(ASIO_HAS_EPOLL)
+#   define ASIO_HAS_READINESS_SET 1
+#  endif // defined(ASIO_HAS_EPOLL)
+# endif // !defined(ASIO_DISABLE_READINESS_SET)
+#endif // !defined(ASIO_HAS_READINESS_SET)
+
+// Receivers that demultiplex many multicast groups on one socket.
+#if !defined(ASIO_HAS_MULTICAST_RECEIVER)
+# if !defined(ASIO_DISABLE_MULTICAST_RECEIVER)
+#  if defined(__linux__) && defined(ASIO_HAS_DATAGRAM_BATCH)
+#   define ASIO_HAS_MULTICAST_RECEIVER 1
+#  endif // defined(__linux__) && defined(ASIO_HAS_DATAGRAM_BATCH)
+# endif // !defined(ASIO_DISABLE_MULTICAST_RECEIVER)
+#endif // !defined(ASIO_HAS_MULTICAST_RECEIVER)
+
+// Stream socket send operations that transfer all of the data.
+#if !defined(ASIO_HAS_SOCKET_SEND_ALL)
+# if !defined(ASIO_DISABLE_SOCKET_SEND_ALL)
+#  if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+#   define ASIO_HAS_SOCKET_SEND_ALL 1
+#  endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+# endif // !defined(ASIO_DISABLE_SOCKET_SEND_ALL)
+#endif // !defined(ASIO_HAS_SOCKET_SEND_ALL)
+
+// Stream socket receive operations that fill all of the buffers.
+#if !defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+# if !defined(ASIO_DISABLE_SOCKET_RECEIVE_ALL)
+#  if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+#   define ASIO_HAS_SOCKET_RECEIVE_ALL 1
+#  endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+# endif // !defined(ASIO_DISABLE_SOCKET_RECEIVE_ALL)
+#endif // !defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+
 // Files.
 #if !defined(ASIO_HAS_FILE)
 # if !defined(ASIO_DISABLE_FILE)
@@ -976,10 +1096,26 @@
 #   define ASIO_HAS_FILE 1
 #  elif defined(ASIO_HAS_IO_URING)
 #   define ASIO_HAS_FILE 1
-#  endif // defined(ASIO_HAS_IO_URING)
+#  elif !defined(ASIO_WINDOWS) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(__CYGWIN__)
+#   define ASIO_HAS_FILE 1
+#  endif // !defined(ASIO_WINDOWS)
+         //   && !defined(ASIO_WINDOWS_RUNTIME)
+         //   && !defined(__CYGWIN__)
 # endif // !defined(ASIO_DISABLE_FILE)
 #endif // !defined(ASIO_HAS_FILE)
 
+// Files that perform blocking operations on a pool of threads, used on POSIX
+// platforms when io_uring is not available.
+#if !defined(ASIO_HAS_THREAD_POOL_FILE)
+# if defined(ASIO_HAS_FILE)
+#  if !defined(ASIO_HAS_IOCP) && !defined(ASIO_HAS_IO_URING)
+#   define ASIO_HAS_THREAD_POOL_FILE 1
+#  endif // !defined(ASIO_HAS_IOCP) && !defined(ASIO_HAS_IO_URING)
+# endif // defined(ASIO_HAS_FILE)
+#endif // !defined(ASIO_HAS_THREAD_POOL_FILE)
+
 // Pipes.
 #if !defined(ASIO_HAS_PIPE)
 # if defined(ASIO_HAS_IOCP) \
@@ -997,6 +1133,33 @@
         //   && !defined(__CYGWIN__)
 #endif // !defined(ASIO_HAS_PIPE)
 
+// Linux splice() for moving data between descriptors within the kernel.
+#if !defined(ASIO_HAS_SPLICE)
+# if !defined(ASIO_DISABLE_SPLICE)
+#  if defined(__linux__) && defined(ASIO_HAS_PIPE)
+#   define ASIO_HAS_SPLICE 1
+#  endif // defined(__linux__) && defined(ASIO_HAS_PIPE)
+# endif // !defined(ASIO_DISABLE_SPLICE)
+#endif // !defined(ASIO_HAS_SPLICE)
+
+// Read-only memory-mapped views of files.
+#if !defined(ASIO_HAS_MAPPED_FILE)
+# if !defined(ASIO_DISABLE_MAPPED_FILE)
+#  if !defined(ASIO_WINDOWS_RUNTIME)
+#   define ASIO_HAS_MAPPED_FILE 1
+#  endif // !defined(ASIO_WINDOWS_RUNTIME)
+# endif // !defined(ASIO_DISABLE_MAPPED_FILE)
+#endif // !defined(ASIO_HAS_MAPPED_FILE)
+
+// Linux sendfile() or Windows TransmitFile() for sending file data to sockets.
+#if !defined(ASIO_HAS_SENDFILE)
+# if !defined(ASIO_DISABLE_SENDFILE)
+#  if defined(__linux__) || defined(ASIO_HAS_WINDOWS_OVERLAPPED_PTR)
+#   define ASIO_HAS_SENDFILE 1
+#  endif // defined(__linux__) || defined(ASIO_HAS_WINDOWS_OVERLAPPED_PTR)
+# endif // !defined(ASIO_DISABLE_SENDFILE)
+#endif // !defined(ASIO_HAS_SENDFILE)
+
 // Can use sigaction() instead of signal().
 #if !defined(ASIO_HAS_SIGACTION)
 # if !defined(ASIO_DISABLE_SIGACTION)
@@ -1397,6 +1560,150 @@
 # endif // defined(_POSIX_VERSION)
 #endif // !defined(ASIO_HAS_MSG_NOSIGNAL)
 
+// Kernel support for recvmmsg and sendmmsg.
+#if !defined(ASIO_HAS_MMSG)
+# if defined(__linux__)
+#  define ASIO_HAS_MMSG 1
+# endif // defined(__linux__)
+#endif // !defined(ASIO_HAS_MMSG)
+
+// Kernel support for UDP segmentation and receive offload.
+#if !defined(ASIO_HAS_UDP_OFFLOAD)
+# if !defined(ASIO_DISABLE_UDP_OFFLOAD)
+#  if defined(__linux__)
+#   define ASIO_HAS_UDP_OFFLOAD 1
+#  endif // defined(__linux__)
+# endif // !defined(ASIO_DISABLE_UDP_OFFLOAD)
+#endif // !defined(ASIO_HAS_UDP_OFFLOAD)
+
+// Per-datagram local address, interface and traffic class on batched datagram
+// operations.
+#if !defined(ASIO_HAS_PACKET_INFO)
+# if !defined(ASIO_DISABLE_PACKET_INFO)
+#  if defined(__linux__) && defined(ASIO_HAS_DATAGRAM_BATCH)
+#   define ASIO_HAS_PACKET_INFO 1
+#  endif // defined(__linux__) && defined(ASIO_HAS_DATAGRAM_BATCH)
+# endif // !defined(ASIO_DISABLE_PACKET_INFO)
+#endif // !defined(ASIO_HAS_PACKET_INFO)
+
+// Support for the SO_REUSEPORT socket option.
+#if !defined(ASIO_HAS_SO_REUSEPORT)
+# if !defined(ASIO_DISABLE_SO_REUSEPORT)
+#  if defined(__linux__) \
+  || (defined(__MACH__) && defined(__APPLE__)) \
+  || defined(__NetBSD__) || defined(__FreeBSD__) \
+  || defined(__OpenBSD__) || defined(__DragonFly__)
+#   define ASIO_HAS_SO_REUSEPORT 1
+#  endif // defined(__linux__) || ...
+# endif // !defined(ASIO_DISABLE_SO_REUSEPORT)
+#endif // !defined(ASIO_HAS_SO_REUSEPORT)
+
+// Support for the SO_BUSY_POLL, SO_PREFER_BUSY_POLL and SO_BUSY_POLL_BUDGET
+// socket options.
+#if !defined(ASIO_HAS_SO_BUSY_POLL)
+# if !defined(ASIO_DISABLE_SO_BUSY_POLL)
+#  if defined(__linux__)
+#   define ASIO_HAS_SO_BUSY_POLL 1
+#  endif // defined(__linux__)
+# endif // !defined(ASIO_DISABLE_SO_BUSY_POLL)
+#endif // !defined(ASIO_HAS_SO_BUSY_POLL)
+
+// Support for the SO_MAX_PACING_RATE socket option.
+#if !defined(ASIO_HAS_SO_MAX_PACING_RATE)
+# if !defined(ASIO_DISABLE_SO_MAX_PACING_RATE)
+#  if defined(__linux__)
+#   define ASIO_HAS_SO_MAX_PACING_RATE 1
+#  endif // defined(__linux__)
+# endif // !defined(ASIO_DISABLE_SO_MAX_PACING_RATE)
+#endif // !defined(ASIO_HAS_SO_MAX_PACING_RATE)
+
+// Support for TCP Fast Open using MSG_FASTOPEN and the TCP_FASTOPEN socket
+// option.
+#if !defined(ASIO_HAS_TCP_FASTOPEN)
+# if !defined(ASIO_DISABLE_TCP_FASTOPEN)
+#  if defined(__linux__)
+#   define ASIO_HAS_TCP_FASTOPEN 1
+#  endif // defined(__linux__)
+# endif // !defined(ASIO_DISABLE_TCP_FASTOPEN)
+#endif // !defined(ASIO_HAS_TCP_FASTOPEN)
+
+// Support for the TCP_DEFER_ACCEPT socket option.
+#if !defined(ASIO_HAS_TCP_DEFER_ACCEPT)
+# if !defined(ASIO_DISABLE_TCP_DEFER_ACCEPT)
+#  if defined(__linux__)
+#   define ASIO_HAS_TCP_DEFER_ACCEPT 1
+#  endif // defined(__linux__)
+# endif // !defined(ASIO_DISABLE_TCP_DEFER_ACCEPT)
+#endif // !defined(ASIO_HAS_TCP_DEFER_ACCEPT)
+
+// Support for the TCP_NOTSENT_LOWAT socket option, and for obtaining the
+// number of bytes not yet sent on a TCP socket.
+#if !defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
+# if !defined(ASIO_DISABLE_TCP_NOTSENT_LOWAT)
+#  if defined(__linux__)
+#   define ASIO_HAS_TCP_NOTSENT_LOWAT 1
+#  endif // defined(__linux__)
+# endif // !defined(ASIO_DISABLE_TCP_NOTSENT_LOWAT)
+#endif // !defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
+
+// Support for SO_TIMESTAMPING receive and transmit timestamps.
+#if !defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+# if !defined(ASIO_DISABLE_SOCKET_TIMESTAMPING)
+#  if defined(__linux__)
+#   define ASIO_HAS_SOCKET_TIMESTAMPING 1
+#  endif // defined(__linux__)
+# endif // !defined(ASIO_DISABLE_SOCKET_TIMESTAMPING)
+#endif // !defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+
+// Support for SO_ZEROCOPY and MSG_ZEROCOPY sends by the reactive backends.
+#if !defined(ASIO_HAS_MSG_ZEROCOPY)
+# if !defined(ASIO_DISABLE_MSG_ZEROCOPY)
+#  if defined(__linux__)
+#   define ASIO_HAS_MSG_ZEROCOPY 1
+#  endif // defined(__linux__)
+# endif // !defined(ASIO_DISABLE_MSG_ZEROCOPY)
+#endif // !defined(ASIO_HAS_MSG_ZEROCOPY)
+
+// Kernel support for steering SO_REUSEPORT connections using a classic BPF
+// program.
+#if !defined(ASIO_HAS_REUSEPORT_CBPF)
+# if !defined(ASIO_DISABLE_REUSEPORT_CBPF)
+#  if defined(__linux__) && defined(ASIO_HAS_SO_REUSEPORT)
+#   define ASIO_HAS_REUSEPORT_CBPF 1
+#  endif // defined(__linux__) && defined(ASIO_HAS_SO_REUSEPORT)
+# endif // !defined(ASIO_DISABLE_REUSEPORT_CBPF)
+#endif // !defined(ASIO_HAS_REUSEPORT_CBPF)
+
+// Support for binding threads to NUMA nodes and keeping per-thread memory
+// caches node-local.
+#if !defined(ASIO_HAS_NUMA)
+# if !defined(ASIO_DISABLE_NUMA)
+#  if defined(__linux__) && defined(ASIO_HAS_THREAD_KEYWORD_EXTENSION)
+#   define ASIO_HAS_NUMA 1
+#  endif // defined(__linux__) && defined(ASIO_HAS_THREAD_KEYWORD_EXTENSION)
+# endif // !defined(ASIO_DISABLE_NUMA)
+#endif // !defined(ASIO_HAS_NUMA)
+
+// Support for backing buffers and handler memory with huge pages.
+#if !defined(ASIO_HAS_HUGE_PAGES)
+# if !defined(ASIO_DISABLE_HUGE_PAGES)
+#  if defined(__linux__) && defined(__LP64__)
+#   define ASIO_HAS_HUGE_PAGES 1
+#  endif // defined(__linux__) && defined(__LP64__)
+# endif // !defined(ASIO_DISABLE_HUGE_PAGES)
+#endif // !defined(ASIO_HAS_HUGE_PAGES)
+
+// Support for USDT static probes using the systemtap sys/sdt.h header.
+#if !defined(ASIO_HAS_USDT_PROBES)
+# if !defined(ASIO_DISABLE_USDT_PROBES)
+#  if defined(__linux__) && defined(__has_include)
+#   if __has_include(<sys/sdt.h>)
+#    define ASIO_HAS_USDT_PROBES 1
+#   endif // __has_include(<sys/sdt.h>)
+#  endif // defined(__linux__) && defined(__has_include)
+# endif // !defined(ASIO_DISABLE_USDT_PROBES)
+#endif // !defined(ASIO_HAS_USDT_PROBES)
+
 // Standard library support for std::to_address.
 #if !defined(ASIO_HAS_STD_TO_ADDRESS)
 # if !defined(ASIO_DISABLE_STD_TO_ADDRESS)
@@ -1428,4 +1735,11 @@
 # endif // !defined(ASIO_DISABLE_SNPRINTF)
 #endif // !defined(ASIO_HAS_SNPRINTF)
 
+// Buffered handler tracking implies handler tracking.
+#if defined(ASIO_ENABLE_BUFFERED_HANDLER_TRACKING)
+# if !defined(ASIO_ENABLE_HANDLER_TRACKING)
+#  define ASIO_ENABLE_HANDLER_TRACKING 1
+# endif // !defined(ASIO_ENABLE_HANDLER_TRACKING)
+#endif // defined(ASIO_ENABLE_BUFFERED_HANDLER_TRACKING)
+
 #endif // ASIO_DETAIL_CONFIG_HPP
@@ -63,6 +63,13 @@ struct prepared_buffers
   std::size_t count;
 };
 
+template <typename Buffer, std::size_t MaxBuffers>
+struct buffer_sequence_native_buffers<prepared_buffers<Buffer, MaxBuffers>>
+  : fixed_buffer_sequence_native_buffers<
+      prepared_buffers<Buffer, MaxBuffers>::max_buffers>
+{
+};
+
 // A proxy for a sub-range in a list of buffers.
 template <typename Buffer, typename Buffers, typename Buffer_Iterator>
 class consuming_buffers
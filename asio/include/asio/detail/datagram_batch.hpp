@@ -0,0 +1,207 @@
+//
+// detail/datagram_batch.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_DATAGRAM_BATCH_HPP
+#define ASIO_DETAIL_DATAGRAM_BATCH_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_DATAGRAM_BATCH)
+
+#include <cstddef>
+#include <cstring>
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/detail/socket_types.hpp"
+#include "asio/ip/packet_info.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Helper class to translate a sequence of buffers, each of which holds a
+// single datagram, into the message headers used by recvmmsg and sendmmsg.
+template <typename Endpoint>
+class datagram_batch
+{
+public:
+  // The maximum number of messages to transfer in a single operation.
+  enum { max_messages = buffer_sequence_adapter_base::max_buffers };
+
+  // Prepare one message header for each buffer. The endpoints may be null, in
+  // which case no addresses are transferred. The packet information may be
+  // null, in which case no control messages are received.
+  void prepare(socket_ops::buf* bufs, std::size_t count,
+      Endpoint* endpoints, ip::packet_info* infos = 0)
+  {
+    count_ = count < static_cast<std::size_t>(max_messages)
+      ? count : static_cast<std::size_t>(max_messages);
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+      msgs_[i].msg_hdr = msghdr();
+      msgs_[i].msg_hdr.msg_iov = bufs + i;
+      msgs_[i].msg_hdr.msg_iovlen = 1;
+      if (endpoints)
+      {
+        msgs_[i].msg_hdr.msg_name = static_cast<socket_addr_type*>(
+            static_cast<void*>(endpoints[i].data()));
+        msgs_[i].msg_hdr.msg_namelen = endpoints[i].capacity();
+      }
+#if defined(ASIO_HAS_PACKET_INFO)
+      if (infos)
+      {
+        socket_ops::init_recv_packet_info_control(
+            msgs_[i].msg_hdr, controls_[i]);
+      }
+#endif // defined(ASIO_HAS_PACKET_INFO)
+      msgs_[i].msg_len = 0;
+    }
+    (void)infos;
+  }
+
+  // Prepare one message header for each buffer, sent to the corresponding
+  // endpoint. The endpoints may be null if the socket is connected. The packet
+  // information may be null, in which case no control messages are sent.
+  void prepare(socket_ops::buf* bufs, std::size_t count,
+      const Endpoint* endpoints, const ip::packet_info* infos = 0,
+      int family = 0)
+  {
+    count_ = count < static_cast<std::size_t>(max_messages)
+      ? count : static_cast<std::size_t>(max_messages);
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+      msgs_[i].msg_hdr = msghdr();
+      msgs_[i].msg_hdr.msg_iov = bufs + i;
+      msgs_[i].msg_hdr.msg_iovlen = 1;
+      if (endpoints)
+      {
+        msgs_[i].msg_hdr.msg_name = const_cast<socket_addr_type*>(
+            static_cast<const socket_addr_type*>(
+              static_cast<const void*>(endpoints[i].data())));
+        msgs_[i].msg_hdr.msg_namelen = endpoints[i].size();
+      }
+#if defined(ASIO_HAS_PACKET_INFO)
+      if (infos)
+      {
+        socket_ops::packet_info_type info;
+        to_packet_info_type(infos[i], info);
+        socket_ops::init_send_packet_info_control(
+            msgs_[i].msg_hdr, controls_[i], family, info);
+      }
+#endif // defined(ASIO_HAS_PACKET_INFO)
+      msgs_[i].msg_len = 0;
+    }
+    (void)infos;
+    (void)family;
+  }
+
+  // Record the lengths, sender addresses and packet information of received
+  // messages.
+  void complete(std::size_t messages, Endpoint* endpoints,
+      std::size_t* sizes, ip::packet_info* infos = 0)
+  {
+    for (std::size_t i = 0; i < messages && i < count_; ++i)
+    {
+      if (endpoints)
+        endpoints[i].resize(msgs_[i].msg_hdr.msg_namelen);
+      if (sizes)
+        sizes[i] = msgs_[i].msg_len;
+#if defined(ASIO_HAS_PACKET_INFO)
+      if (infos)
+      {
+        socket_ops::packet_info_type info;
+        socket_ops::get_recv_packet_info(msgs_[i].msg_hdr, info);
+        from_packet_info_type(info, infos[i]);
+      }
+#endif // defined(ASIO_HAS_PACKET_INFO)
+    }
+    (void)infos;
+  }
+
+  // Get the message headers.
+  mmsghdr_type* messages()
+  {
+    return msgs_;
+  }
+
+  // Get the number of messages.
+  std::size_t count() const
+  {
+    return count_;
+  }
+
+private:
+#if defined(ASIO_HAS_PACKET_INFO)
+  static void to_packet_info_type(const ip::packet_info& from,
+      socket_ops::packet_info_type& to)
+  {
+    to.family = ASIO_OS_DEF(AF_UNSPEC);
+    if (from.local_address().is_v4()
+        && !from.local_address().is_unspecified())
+    {
+      ip::address_v4::bytes_type bytes =
+        from.local_address().to_v4().to_bytes();
+      to.family = ASIO_OS_DEF(AF_INET);
+      std::memcpy(to.address, bytes.data(), bytes.size());
+    }
+    else if (from.local_address().is_v6()
+        && !from.local_address().is_unspecified())
+    {
+      ip::address_v6::bytes_type bytes =
+        from.local_address().to_v6().to_bytes();
+      to.family = ASIO_OS_DEF(AF_INET6);
+      std::memcpy(to.address, bytes.data(), bytes.size());
+    }
+    to.interface_index = from.interface_index();
+    to.traffic_class = from.has_traffic_class() ? from.traffic_class() : -1;
+  }
+
+  static void from_packet_info_type(const socket_ops::packet_info_type& from,
+      ip::packet_info& to)
+  {
+    to = ip::packet_info();
+    if (from.family == ASIO_OS_DEF(AF_INET))
+    {
+      ip::address_v4::bytes_type bytes;
+      std::memcpy(bytes.data(), from.address, bytes.size());
+      to.local_address(ip::address_v4(bytes));
+    }
+    else if (from.family == ASIO_OS_DEF(AF_INET6))
+    {
+      ip::address_v6::bytes_type bytes;
+      std::memcpy(bytes.data(), from.address, bytes.size());
+      to.local_address(ip::address_v6(bytes));
+    }
+    to.interface_index(from.interface_index);
+    if (from.traffic_class >= 0)
+      to.traffic_class(static_cast<unsigned char>(from.traffic_class));
+  }
+#endif // defined(ASIO_HAS_PACKET_INFO)
+
+  mmsghdr_type msgs_[max_messages];
+#if defined(ASIO_HAS_PACKET_INFO)
+  socket_ops::packet_info_control_type controls_[max_messages];
+#endif // defined(ASIO_HAS_PACKET_INFO)
+  std::size_t count_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_DATAGRAM_BATCH)
+
+#endif // ASIO_DETAIL_DATAGRAM_BATCH_HPP
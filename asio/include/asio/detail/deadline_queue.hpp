@@ -0,0 +1,216 @@
+//
+// detail/deadline_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_DEADLINE_QUEUE_HPP
+#define ASIO_DETAIL_DEADLINE_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "asio/detail/assert.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/executor_function.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/latency_histogram.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// The function objects waiting to be run by a deadline_executor, ordered so
+// that the function with the earliest deadline is run first. Functions with
+// equal deadlines are run in the order in which they were added.
+class deadline_queue
+  : private noncopyable
+{
+public:
+  typedef chrono::steady_clock::time_point time_point;
+
+  // Counters describing the functions that have been run.
+  struct counters
+  {
+    counters()
+      : handlers_run(0),
+        deadlines_missed(0),
+        max_lateness(0)
+    {
+    }
+
+    uint64_t handlers_run;
+    uint64_t deadlines_missed;
+    chrono::nanoseconds max_lateness;
+    latency_histogram lateness;
+  };
+
+  // Constructor.
+  deadline_queue()
+    : next_sequence_(0)
+  {
+  }
+
+  // Add a function to the queue.
+  void push(const time_point& deadline, executor_function&& f)
+  {
+    mutex::scoped_lock lock(mutex_);
+    entries_.push_back(entry(deadline, next_sequence_++,
+          static_cast<executor_function&&>(f)));
+    std::push_heap(entries_.begin(), entries_.end(), entry_compare());
+  }
+
+  // Remove the function with the earliest deadline. If the function is about
+  // to be run, record whether it has missed its deadline.
+  executor_function pop(bool will_run)
+  {
+    mutex::scoped_lock lock(mutex_);
+    ASIO_ASSERT(!entries_.empty());
+    std::pop_heap(entries_.begin(), entries_.end(), entry_compare());
+    entry e(static_cast<entry&&>(entries_.back()));
+    entries_.pop_back();
+
+    if (will_run)
+    {
+      ++counters_.handlers_run;
+      if (e.deadline_ != (time_point::max)())
+      {
+        time_point now = chrono::steady_clock::now();
+        if (now > e.deadline_)
+        {
+          chrono::nanoseconds lateness =
+            chrono::duration_cast<chrono::nanoseconds>(now - e.deadline_);
+          ++counters_.deadlines_missed;
+          if (lateness > counters_.max_lateness)
+            counters_.max_lateness = lateness;
+          counters_.lateness.record(lateness);
+        }
+      }
+    }
+
+    return static_cast<executor_function&&>(e.function_);
+  }
+
+  // Get the number of functions waiting to be run.
+  std::size_t size()
+  {
+    mutex::scoped_lock lock(mutex_);
+    return entries_.size();
+  }
+
+  // Get a copy of the counters.
+  counters get_counters()
+  {
+    mutex::scoped_lock lock(mutex_);
+    return counters_;
+  }
+
+private:
+  struct entry
+  {
+    entry(const time_point& deadline,
+        uint64_t sequence, executor_function&& f)
+      : deadline_(deadline),
+        sequence_(sequence),
+        function_(static_cast<executor_function&&>(f))
+    {
+    }
+
+    entry(entry&& other) noexcept
+      : deadline_(other.deadline_),
+        sequence_(other.sequence_),
+        function_(static_cast<executor_function&&>(other.function_))
+    {
+    }
+
+    entry& operator=(entry&& other) noexcept
+    {
+      deadline_ = other.deadline_;
+      sequence_ = other.sequence_;
+      function_ = static_cast<executor_function&&>(other.function_);
+      return *this;
+    }
+
+    time_point deadline_;
+    uint64_t sequence_;
+    executor_function function_;
+  };
+
+  // Orders the heap so that the earliest deadline is at the front.
+  struct entry_compare
+  {
+    bool operator()(const entry& a, const entry& b) const
+    {
+      if (a.deadline_ != b.deadline_)
+        return a.deadline_ > b.deadline_;
+      return a.sequence_ > b.sequence_;
+    }
+  };
+
+  // Mutex to protect access to internal data.
+  mutex mutex_;
+
+  // The waiting functions, stored as a binary heap.
+  std::vector<entry> entries_;
+
+  // The sequence number to be given to the next function added.
+  uint64_t next_sequence_;
+
+  // The counters describing the functions that have been run.
+  counters counters_;
+};
+
+// A function object that is submitted to the underlying executor once for
+// each function added to a deadline_queue. When called, it runs whichever
+// function then has the earliest deadline. If it is destroyed without being
+// called, it destroys that function instead, so that the queue never holds
+// more functions than there are submissions outstanding.
+class deadline_queue_runner
+{
+public:
+  explicit deadline_queue_runner(const std::shared_ptr<deadline_queue>& q)
+    : queue_(q)
+  {
+  }
+
+  deadline_queue_runner(deadline_queue_runner&& other) noexcept
+    : queue_(static_cast<std::shared_ptr<deadline_queue>&&>(other.queue_))
+  {
+  }
+
+  ~deadline_queue_runner()
+  {
+    if (queue_)
+      executor_function f(queue_->pop(false));
+  }
+
+  void operator()()
+  {
+    std::shared_ptr<deadline_queue> q(
+        static_cast<std::shared_ptr<deadline_queue>&&>(queue_));
+    executor_function f(q->pop(true));
+    f();
+  }
+
+private:
+  std::shared_ptr<deadline_queue> queue_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_DEADLINE_QUEUE_HPP
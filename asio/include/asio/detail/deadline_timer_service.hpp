@@ -64,6 +64,7 @@ public:
     : private asio::detail::noncopyable
   {
     time_type expiry;
+    duration_type slack;
     bool might_have_pending_waits;
     typename timer_queue<TimeTraits, allocator_type>::per_timer_data timer_data;
   };
@@ -95,6 +96,7 @@ public:
   void construct(implementation_type& impl)
   {
     impl.expiry = time_type();
+    impl.slack = duration_type();
     impl.might_have_pending_waits = false;
   }
 
@@ -118,6 +120,9 @@ public:
     impl.expiry = other_impl.expiry;
     other_impl.expiry = time_type();
 
+    impl.slack = other_impl.slack;
+    other_impl.slack = duration_type();
+
     impl.might_have_pending_waits = other_impl.might_have_pending_waits;
     other_impl.might_have_pending_waits = false;
   }
@@ -137,6 +142,9 @@ public:
     impl.expiry = other_impl.expiry;
     other_impl.expiry = time_type();
 
+    impl.slack = other_impl.slack;
+    other_impl.slack = duration_type();
+
     impl.might_have_pending_waits = other_impl.might_have_pending_waits;
     other_impl.might_have_pending_waits = false;
   }
@@ -219,6 +227,7 @@ public:
   {
     std::size_t count = cancel(impl, ec);
     impl.expiry = expiry_time;
+    impl.slack = duration_type();
     ec = asio::error_code();
     return count;
   }
@@ -231,6 +240,18 @@ public:
         TimeTraits::add(TimeTraits::now(), expiry_time), ec);
   }
 
+  // Set the expiry time for the timer relative to now, allowing the timer to
+  // complete up to the specified slack after that time.
+  std::size_t expires_after_with_slack(implementation_type& impl,
+      const duration_type& expiry_time, const duration_type& slack,
+      asio::error_code& ec)
+  {
+    std::size_t count = expires_at(impl,
+        TimeTraits::add(TimeTraits::now(), expiry_time), ec);
+    impl.slack = slack;
+    return count;
+  }
+
   // Set the expiry time for the timer relative to now.
   std::size_t expires_from_now(implementation_type& impl,
       const duration_type& expiry_time, asio::error_code& ec)
@@ -278,6 +299,7 @@ public:
     ASIO_HANDLER_CREATION((scheduler_.context(),
           *p.p, "deadline_timer", &impl, 0, "async_wait"));
 
+    impl.timer_data.set_slack(impl.slack);
     scheduler_.schedule_timer(timer_queue_, impl.expiry, impl.timer_data, p.p);
     p.v = p.p = 0;
   }
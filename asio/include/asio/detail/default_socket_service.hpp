@@ -0,0 +1,57 @@
+//
+// detail/default_socket_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_DEFAULT_SOCKET_SERVICE_HPP
+#define ASIO_DETAIL_DEFAULT_SOCKET_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_WINDOWS_RUNTIME)
+# include "asio/detail/null_socket_service.hpp"
+#elif defined(ASIO_HAS_IOCP)
+# include "asio/detail/win_iocp_socket_service.hpp"
+#elif defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+# include "asio/detail/io_uring_socket_service.hpp"
+#else
+# include "asio/detail/reactive_socket_service.hpp"
+#endif
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Selects the service that implements sockets and acceptors of a protocol.
+// The primary template selects the platform's default service, and may be
+// specialised so that a protocol type uses another service.
+template <typename Protocol>
+struct default_socket_service
+{
+#if defined(ASIO_WINDOWS_RUNTIME)
+  typedef null_socket_service<Protocol> type;
+#elif defined(ASIO_HAS_IOCP)
+  typedef win_iocp_socket_service<Protocol> type;
+#elif defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  typedef io_uring_socket_service<Protocol> type;
+#else
+  typedef reactive_socket_service<Protocol> type;
+#endif
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_DEFAULT_SOCKET_SERVICE_HPP
@@ -143,6 +143,30 @@ ASIO_DECL bool non_blocking_write_at1(int d,
     uint64_t offset, const void* data, std::size_t size,
     asio::error_code& ec, std::size_t& bytes_transferred);
 
+// Advise that a range of a file will be read soon. If is_stream is true, the
+// range starts at the file's current position rather than at the offset.
+ASIO_DECL void readahead(int d, bool is_stream,
+    uint64_t offset, std::size_t size);
+
+// The type of synchronisation performed by sync().
+enum sync_type
+{
+  // Synchronise the file data and metadata.
+  sync_all_type,
+
+  // Synchronise the file data, and only the metadata needed to read it.
+  sync_data_type,
+
+  // Write out the dirty pages in a range of the file.
+  sync_range_type
+};
+
+// Synchronise a file, or a range of it, to disk. A size of 0 means the range
+// extends to the end of the file. Where ranges are not supported, the file
+// data is synchronised.
+ASIO_DECL int sync(int d, sync_type type, uint64_t offset,
+    uint64_t size, asio::error_code& ec);
+
 #endif // defined(ASIO_HAS_FILE)
 
 ASIO_DECL int ioctl(int d, state_type& state, long cmd,
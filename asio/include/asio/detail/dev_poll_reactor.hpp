@@ -191,6 +191,10 @@ private:
   // Helper function to remove a timer queue.
   ASIO_DECL void do_remove_timer_queue(timer_queue_base& queue);
 
+  // Sample the number of pending timers, if metrics are enabled. The lock must
+  // be held.
+  ASIO_DECL void record_pending_timers();
+
   // Get the timeout value for the /dev/poll DP_POLL operation. The timeout
   // value is returned as a number of milliseconds. A return value of -1
   // indicates that the poll should block indefinitely.
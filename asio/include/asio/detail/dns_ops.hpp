@@ -0,0 +1,131 @@
+//
+// detail/dns_ops.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_DNS_OPS_HPP
+#define ASIO_DETAIL_DNS_OPS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "asio/ip/address.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+namespace dns_ops {
+
+// The types of record that are queried.
+enum record_type { a_record = 1, aaaa_record = 28 };
+
+// Message size limits.
+enum
+{
+  // The size of a message header.
+  header_size = 12,
+
+  // The largest message that may be sent or received over UDP.
+  max_udp_message_size = 512,
+
+  // The largest query that is built.
+  max_query_size = header_size + 256 + 4
+};
+
+// Response codes.
+enum { no_error = 0, name_error = 3 };
+
+// The name servers and lookup options for stub resolution.
+struct resolver_config
+{
+  resolver_config()
+    : ndots(1),
+      timeout(5),
+      attempts(2),
+      has_ipv4(true),
+      has_ipv6(true)
+  {
+  }
+
+  // The name servers, in the order in which they are tried.
+  std::vector<asio::ip::address> servers;
+
+  // The domains that are appended to names with too few dots.
+  std::vector<std::string> search;
+
+  // The number of dots a name must contain to be tried as is before the
+  // search domains are applied.
+  unsigned int ndots;
+
+  // The time, in seconds, to wait for a name server to respond.
+  unsigned int timeout;
+
+  // The number of times each name server is tried.
+  unsigned int attempts;
+
+  // Whether the host has a non-loopback address of each family.
+  bool has_ipv4;
+  bool has_ipv6;
+};
+
+// A parsed response to a query.
+struct response
+{
+  // The response code.
+  int rcode;
+
+  // Whether the response was truncated.
+  bool truncated;
+
+  // The addresses found in the answer section.
+  std::vector<asio::ip::address> addresses;
+};
+
+// Parse the contents of a resolv.conf file.
+ASIO_DECL void parse_resolver_config(const char* text, resolver_config& config);
+
+// Read a resolv.conf file. Returns false if the file could not be read. The
+// address families configured on the host's interfaces are also determined.
+ASIO_DECL bool load_resolver_config(const char* path, resolver_config& config);
+
+// Determine the names to be queried for a host name, in order, by applying
+// the search domains.
+ASIO_DECL void candidate_names(const std::string& host,
+    const resolver_config& config, std::vector<std::string>& names);
+
+// Build a recursive query. Returns the length of the query, or 0 if the name
+// is not valid or does not fit.
+ASIO_DECL std::size_t build_query(unsigned short id, const std::string& name,
+    record_type type, unsigned char* buffer, std::size_t size);
+
+// Get the identifier of a message. The message must be at least header_size
+// bytes long.
+ASIO_DECL unsigned short message_id(const unsigned char* data);
+
+// Parse the response to a query. Returns false if the message is not a
+// response to the query for the specified name and type.
+ASIO_DECL bool parse_response(const unsigned char* data, std::size_t size,
+    const std::string& name, record_type type, response& result);
+
+} // namespace dns_ops
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/dns_ops.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_DETAIL_DNS_OPS_HPP
@@ -0,0 +1,606 @@
+//
+// detail/dns_resolve_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_DNS_RESOLVE_OP_HPP
+#define ASIO_DETAIL_DNS_RESOLVE_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if !defined(ASIO_WINDOWS_RUNTIME)
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "asio/associated_cancellation_slot.hpp"
+#include "asio/basic_datagram_socket.hpp"
+#include "asio/basic_stream_socket.hpp"
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/buffer.hpp"
+#include "asio/error.hpp"
+#include "asio/generic/datagram_protocol.hpp"
+#include "asio/generic/stream_protocol.hpp"
+#include "asio/post.hpp"
+#include "asio/read.hpp"
+#include "asio/strand.hpp"
+#include "asio/write.hpp"
+#include "asio/ip/basic_endpoint.hpp"
+#include "asio/ip/basic_resolver_query.hpp"
+#include "asio/ip/basic_resolver_results.hpp"
+#include "asio/ip/detail/endpoint.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/dns_ops.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/resolve_query_op.hpp"
+#include "asio/detail/resolver_thread_pool.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Resolves a host name by sending queries directly to the configured name
+// servers, using the I/O objects of the resolver's executor rather than a
+// thread from the resolver's pool. The A and AAAA queries for a name are sent
+// together on the same socket. A truncated response is retried over TCP. If
+// none of the candidate names can be resolved, the query is passed to
+// getaddrinfo so that other sources, such as the hosts file, are consulted.
+// The operation's internal handlers are serialised by a strand.
+template <typename Protocol, typename Handler, typename IoExecutor>
+class dns_resolve_op
+  : public std::enable_shared_from_this<
+      dns_resolve_op<Protocol, Handler, IoExecutor>>
+{
+public:
+  typedef asio::ip::basic_resolver_query<Protocol> query_type;
+  typedef asio::ip::basic_resolver_results<Protocol> results_type;
+
+  dns_resolve_op(socket_ops::weak_cancel_token_type cancel_token,
+      const query_type& qry,
+      const std::shared_ptr<const dns_ops::resolver_config>& config,
+      unsigned short port, resolver_thread_pool& thread_pool,
+      Handler& handler, const IoExecutor& io_ex)
+    : cancel_token_(cancel_token),
+      query_(qry),
+      config_(config),
+      port_(port),
+      thread_pool_(thread_pool),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex),
+      io_ex_(io_ex),
+      strand_(io_ex),
+      udp_socket_(strand_),
+      tcp_socket_(strand_),
+      timer_(strand_),
+      done_(false),
+      name_index_(0),
+      server_index_(0),
+      attempt_(0),
+      generation_(0),
+      num_queries_(0),
+      service_port_(static_cast<unsigned short>(
+            std::strtoul(qry.service_name().c_str(), 0, 10))),
+      random_(static_cast<std::uint_fast32_t>(
+            std::chrono::steady_clock::now().time_since_epoch().count()
+              ^ reinterpret_cast<std::uintptr_t>(this))),
+      buffer_(65535)
+  {
+    dns_ops::candidate_names(qry.host_name(), *config_, names_);
+
+    // With address_configured, a family is queried only if the host has a
+    // non-loopback address of that family.
+    int family = qry.hints().ai_family;
+    bool configured = (qry.hints().ai_flags & AI_ADDRCONFIG) != 0;
+    if (family == ASIO_OS_DEF(AF_INET) || (family == ASIO_OS_DEF(AF_UNSPEC)
+          && (!configured || config_->has_ipv4)))
+      queries_[num_queries_++].type_ = dns_ops::a_record;
+    if (family == ASIO_OS_DEF(AF_INET6) || (family == ASIO_OS_DEF(AF_UNSPEC)
+          && (!configured || config_->has_ipv6)))
+      queries_[num_queries_++].type_ = dns_ops::aaaa_record;
+  }
+
+  // Start the resolution. The first step is posted so that the handler is
+  // never called from within async_resolve.
+  void start()
+  {
+    std::shared_ptr<dns_resolve_op> self(this->shared_from_this());
+
+    // Optionally register for per-operation cancellation.
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler_);
+    if (slot.is_connected())
+      slot.template emplace<op_cancellation>(self);
+
+    asio::post(strand_, [self]{ self->start_name(); });
+  }
+
+private:
+  typedef asio::strand<IoExecutor> strand_type;
+  typedef asio::basic_datagram_socket<
+    asio::generic::datagram_protocol, strand_type> udp_socket_type;
+  typedef asio::basic_stream_socket<
+    asio::generic::stream_protocol, strand_type> tcp_socket_type;
+  typedef asio::basic_waitable_timer<std::chrono::steady_clock,
+    asio::wait_traits<std::chrono::steady_clock>, strand_type> timer_type;
+
+  // Cancellation handler that completes the operation on its strand.
+  class op_cancellation
+  {
+  public:
+    explicit op_cancellation(const std::shared_ptr<dns_resolve_op>& op)
+      : op_(op)
+    {
+    }
+
+    void operator()(cancellation_type_t type)
+    {
+      if (!!(type &
+            (cancellation_type::terminal
+              | cancellation_type::partial
+              | cancellation_type::total)))
+      {
+        if (std::shared_ptr<dns_resolve_op> self = op_.lock())
+        {
+          asio::post(self->strand_,
+              [self]
+              {
+                if (!self->done_)
+                  self->finish(asio::error::operation_aborted,
+                      results_type());
+              });
+        }
+      }
+    }
+
+  private:
+    std::weak_ptr<dns_resolve_op> op_;
+  };
+
+  // The state of the query for one record type.
+  struct query_state
+  {
+    dns_ops::record_type type_;
+    unsigned short id_;
+    bool answered_;
+    bool truncated_;
+    int rcode_;
+    std::vector<asio::ip::address> addresses_;
+
+    // The query, preceded by the two byte length used for TCP.
+    unsigned char message_[dns_ops::max_query_size + 2];
+    std::size_t length_;
+  };
+
+  bool cancelled() const
+  {
+    return cancel_token_.expired();
+  }
+
+  // Stop any outstanding socket and timer operations. Their handlers see that
+  // the generation has changed and do nothing.
+  void reset()
+  {
+    ++generation_;
+    asio::error_code ignored_ec;
+    udp_socket_.close(ignored_ec);
+    tcp_socket_.close(ignored_ec);
+    timer_.cancel();
+  }
+
+  // Start the queries for the current candidate name.
+  void start_name()
+  {
+    if (done_)
+      return;
+
+    reset();
+    if (cancelled())
+      return finish(asio::error::operation_aborted, results_type());
+
+    while (name_index_ < names_.size())
+    {
+      bool valid = true;
+      for (std::size_t i = 0; i < num_queries_ && valid; ++i)
+      {
+        query_state& q = queries_[i];
+        q.id_ = static_cast<unsigned short>(random_());
+        q.answered_ = false;
+        q.truncated_ = false;
+        q.rcode_ = dns_ops::no_error;
+        q.addresses_.clear();
+        q.length_ = dns_ops::build_query(q.id_, names_[name_index_],
+            q.type_, q.message_ + 2, dns_ops::max_query_size);
+        q.message_[0] = static_cast<unsigned char>(q.length_ >> 8);
+        q.message_[1] = static_cast<unsigned char>(q.length_ & 0xFF);
+        valid = q.length_ != 0;
+      }
+
+      if (valid && num_queries_ > 0)
+      {
+        server_index_ = 0;
+        attempt_ = 0;
+        return start_udp();
+      }
+
+      ++name_index_;
+    }
+
+    fallback();
+  }
+
+  // Send the unanswered queries to the current name server over UDP.
+  void start_udp()
+  {
+    reset();
+    if (all_answered())
+      return server_done();
+
+    asio::error_code ec;
+    asio::ip::detail::endpoint server(
+        config_->servers[server_index_], port_);
+    udp_socket_.open(asio::generic::datagram_protocol(
+          server.is_v4() ? ASIO_OS_DEF(AF_INET) : ASIO_OS_DEF(AF_INET6),
+          ASIO_OS_DEF(IPPROTO_UDP)), ec);
+    if (!ec)
+    {
+      udp_socket_.connect(asio::generic::datagram_protocol::endpoint(
+            server.data(), server.size(), ASIO_OS_DEF(IPPROTO_UDP)), ec);
+    }
+    if (ec)
+      return next_server();
+
+    std::shared_ptr<dns_resolve_op> self(this->shared_from_this());
+    std::size_t generation = generation_;
+    for (std::size_t i = 0; i < num_queries_; ++i)
+    {
+      query_state& q = queries_[i];
+      if (!q.answered_)
+      {
+        udp_socket_.async_send(asio::buffer(q.message_ + 2, q.length_),
+            [self, generation](const asio::error_code& e, std::size_t)
+            {
+              if (e && generation == self->generation_)
+                self->next_server();
+            });
+      }
+    }
+
+    start_timer();
+    start_udp_receive();
+  }
+
+  void start_udp_receive()
+  {
+    std::shared_ptr<dns_resolve_op> self(this->shared_from_this());
+    std::size_t generation = generation_;
+    udp_socket_.async_receive(asio::buffer(buffer_.data(),
+          dns_ops::max_udp_message_size),
+        [self, generation](const asio::error_code& e, std::size_t n)
+        {
+          if (generation == self->generation_)
+            self->handle_udp_receive(e, n);
+        });
+  }
+
+  void handle_udp_receive(const asio::error_code& ec, std::size_t n)
+  {
+    if (cancelled())
+      return finish(asio::error::operation_aborted, results_type());
+    if (ec)
+      return next_server();
+
+    handle_response(buffer_.data(), n, false);
+    if (all_answered())
+      server_done();
+    else
+      start_udp_receive();
+  }
+
+  // Limit the time spent waiting for the current name server.
+  void start_timer()
+  {
+    std::shared_ptr<dns_resolve_op> self(this->shared_from_this());
+    std::size_t generation = generation_;
+    timer_.expires_after(std::chrono::seconds(config_->timeout));
+    timer_.async_wait(
+        [self, generation](const asio::error_code& e)
+        {
+          if (!e && generation == self->generation_)
+          {
+            if (self->cancelled())
+              self->finish(asio::error::operation_aborted, results_type());
+            else
+              self->next_server();
+          }
+        });
+  }
+
+  // Record a response if it answers one of the outstanding queries.
+  void handle_response(const unsigned char* data, std::size_t n, bool tcp)
+  {
+    if (n < dns_ops::header_size)
+      return;
+
+    unsigned short id = dns_ops::message_id(data);
+    for (std::size_t i = 0; i < num_queries_; ++i)
+    {
+      query_state& q = queries_[i];
+      if (q.id_ == id && (tcp ? q.truncated_ : !q.answered_))
+      {
+        dns_ops::response r;
+        if (dns_ops::parse_response(data, n,
+              names_[name_index_], q.type_, r))
+        {
+          q.answered_ = true;
+          q.truncated_ = !tcp && r.truncated;
+          q.rcode_ = r.rcode;
+          q.addresses_.swap(r.addresses);
+        }
+        return;
+      }
+    }
+  }
+
+  bool all_answered() const
+  {
+    for (std::size_t i = 0; i < num_queries_; ++i)
+      if (!queries_[i].answered_)
+        return false;
+    return true;
+  }
+
+  bool any_truncated() const
+  {
+    for (std::size_t i = 0; i < num_queries_; ++i)
+      if (queries_[i].truncated_)
+        return true;
+    return false;
+  }
+
+  // All queries have been answered by the current name server.
+  void server_done()
+  {
+    if (any_truncated())
+      start_tcp();
+    else
+      evaluate();
+  }
+
+  // Repeat the truncated queries over TCP.
+  void start_tcp()
+  {
+    reset();
+
+    asio::error_code ec;
+    asio::ip::detail::endpoint server(
+        config_->servers[server_index_], port_);
+    tcp_socket_.open(asio::generic::stream_protocol(
+          server.is_v4() ? ASIO_OS_DEF(AF_INET) : ASIO_OS_DEF(AF_INET6),
+          ASIO_OS_DEF(IPPROTO_TCP)), ec);
+    if (ec)
+      return next_server();
+
+    tcp_message_.clear();
+    for (std::size_t i = 0; i < num_queries_; ++i)
+    {
+      query_state& q = queries_[i];
+      if (q.truncated_)
+        tcp_message_.insert(tcp_message_.end(),
+            q.message_, q.message_ + 2 + q.length_);
+    }
+
+    std::shared_ptr<dns_resolve_op> self(this->shared_from_this());
+    std::size_t generation = generation_;
+    start_timer();
+    tcp_socket_.async_connect(asio::generic::stream_protocol::endpoint(
+          server.data(), server.size(), ASIO_OS_DEF(IPPROTO_TCP)),
+        [self, generation](const asio::error_code& e)
+        {
+          if (generation != self->generation_)
+            return;
+          if (e)
+            return self->next_server();
+
+          asio::async_write(self->tcp_socket_,
+              asio::buffer(self->tcp_message_),
+              [self, generation](const asio::error_code& e, std::size_t)
+              {
+                if (generation != self->generation_)
+                  return;
+                if (e)
+                  return self->next_server();
+                self->start_tcp_receive();
+              });
+        });
+  }
+
+  void start_tcp_receive()
+  {
+    std::shared_ptr<dns_resolve_op> self(this->shared_from_this());
+    std::size_t generation = generation_;
+    asio::async_read(tcp_socket_, asio::buffer(buffer_.data(), 2),
+        [self, generation](const asio::error_code& e, std::size_t)
+        {
+          if (generation != self->generation_)
+            return;
+          if (e)
+            return self->next_server();
+
+          std::size_t length = (static_cast<std::size_t>(
+                self->buffer_[0]) << 8) | self->buffer_[1];
+          if (length < dns_ops::header_size)
+            return self->next_server();
+
+          asio::async_read(self->tcp_socket_,
+              asio::buffer(self->buffer_.data(), length),
+              [self, generation](const asio::error_code& e, std::size_t n)
+              {
+                if (generation != self->generation_)
+                  return;
+                if (self->cancelled())
+                  return self->finish(
+                      asio::error::operation_aborted, results_type());
+                if (e)
+                  return self->next_server();
+
+                self->handle_response(self->buffer_.data(), n, true);
+                if (self->any_truncated())
+                  self->start_tcp_receive();
+                else
+                  self->evaluate();
+              });
+        });
+  }
+
+  // Try the next name server, or the next attempt at the first name server.
+  void next_server()
+  {
+    reset();
+    if (cancelled())
+      return finish(asio::error::operation_aborted, results_type());
+
+    if (++server_index_ >= config_->servers.size())
+    {
+      server_index_ = 0;
+      if (++attempt_ >= config_->attempts)
+        return fallback();
+    }
+
+    start_udp();
+  }
+
+  // Act on the answers to the queries for the current name.
+  void evaluate()
+  {
+    reset();
+    if (cancelled())
+      return finish(asio::error::operation_aborted, results_type());
+
+    bool server_failure = false;
+    std::vector<asio::ip::basic_endpoint<Protocol>> endpoints;
+    for (std::size_t i = 0; i < num_queries_; ++i)
+    {
+      query_state& q = queries_[i];
+      if (q.rcode_ != dns_ops::no_error && q.rcode_ != dns_ops::name_error)
+        server_failure = true;
+      for (std::size_t j = 0; j < q.addresses_.size(); ++j)
+        endpoints.push_back(asio::ip::basic_endpoint<Protocol>(
+              q.addresses_[j], service_port_));
+    }
+
+    if (!endpoints.empty())
+    {
+      return finish(asio::error_code(), results_type::create(
+            endpoints.begin(), endpoints.end(),
+            query_.host_name(), query_.service_name()));
+    }
+
+    // A server that failed to answer is skipped. Otherwise, the name does not
+    // exist or has no addresses, and the next candidate name is tried.
+    if (server_failure)
+      return next_server();
+
+    ++name_index_;
+    start_name();
+  }
+
+  // Pass the query to getaddrinfo on the resolver's thread pool. The
+  // operation's cancellation handler is replaced by that of the new operation.
+  void fallback()
+  {
+    reset();
+    if (cancelled())
+      return finish(asio::error::operation_aborted, results_type());
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler_);
+
+    typedef resolve_query_op<Protocol, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler_),
+      op::ptr::allocate(handler_), 0 };
+    p.p = new (p.v) op(cancel_token_, query_,
+        thread_pool_.scheduler(), handler_, io_ex_);
+    done_ = true;
+
+    resolve_op* start_op = p.p;
+    if (slot.is_connected() && thread_pool_.background_lookups())
+      start_op = p.p->make_cancellable(slot);
+
+    ASIO_HANDLER_CREATION((thread_pool_.context(),
+          *p.p, "resolver", this, 0, "async_resolve"));
+
+    thread_pool_.start_resolve_op(start_op);
+    p.v = p.p = 0;
+  }
+
+  void finish(const asio::error_code& ec, const results_type& results)
+  {
+    reset();
+    done_ = true;
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler_);
+    if (slot.is_connected())
+      slot.clear();
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made.
+    detail::binder2<Handler, asio::error_code, results_type>
+      handler(handler_, ec, results);
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(work_));
+
+    ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, "..."));
+    w.complete(handler, handler.handler_);
+    ASIO_HANDLER_INVOCATION_END;
+  }
+
+  socket_ops::weak_cancel_token_type cancel_token_;
+  query_type query_;
+  std::shared_ptr<const dns_ops::resolver_config> config_;
+  unsigned short port_;
+  resolver_thread_pool& thread_pool_;
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+  IoExecutor io_ex_;
+  strand_type strand_;
+  udp_socket_type udp_socket_;
+  tcp_socket_type tcp_socket_;
+  timer_type timer_;
+  bool done_;
+  std::vector<std::string> names_;
+  std::size_t name_index_;
+  std::size_t server_index_;
+  unsigned int attempt_;
+  std::size_t generation_;
+  query_state queries_[2];
+  std::size_t num_queries_;
+  unsigned short service_port_;
+  std::minstd_rand random_;
+  std::vector<unsigned char> buffer_;
+  std::vector<unsigned char> tcp_message_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // !defined(ASIO_WINDOWS_RUNTIME)
+
+#endif // ASIO_DETAIL_DNS_RESOLVE_OP_HPP
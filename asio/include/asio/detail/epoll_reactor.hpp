@@ -52,13 +52,14 @@ private:
 
 public:
   enum op_types { read_op = 0, write_op = 1,
-    connect_op = 1, except_op = 2, max_ops = 3 };
+    connect_op = 1, except_op = 2, peer_closed_op = 3, max_ops = 4 };
 
   // Per-descriptor queues.
   struct descriptor_state : operation
   {
     descriptor_state* next_;
-    descriptor_state* prev_;
+    descriptor_state* next_free_;
+    bool live_;
 
     mutex mutex_;
     epoll_reactor* reactor_;
@@ -66,6 +67,7 @@ public:
     uint32_t registered_events_;
     op_queue<reactor_op> op_queue_[max_ops];
     bool try_speculative_[max_ops];
+    bool registration_pending_;
     bool shutdown_;
 
     ASIO_DECL descriptor_state(bool locking, int spin_count);
@@ -220,6 +222,14 @@ private:
   // Create the timerfd file descriptor. Does not throw.
   ASIO_DECL static int do_timerfd_create();
 
+  // Apply the configured busy poll parameters to the epoll file descriptor.
+  // Does not throw, and has no effect if the kernel does not support them.
+  ASIO_DECL void set_busy_poll_params();
+
+  // Get the events for which a descriptor is registered. Listening sockets
+  // are registered for exclusive wakeups when exclusive_listeners_ is set.
+  ASIO_DECL uint32_t registration_events(socket_type descriptor) const;
+
   // Allocate a new descriptor state object.
   ASIO_DECL descriptor_state* allocate_descriptor_state();
 
@@ -232,6 +242,10 @@ private:
   // Helper function to remove a timer queue.
   ASIO_DECL void do_remove_timer_queue(timer_queue_base& queue);
 
+  // Sample the number of pending timers, if metrics are enabled. The lock must
+  // be held.
+  ASIO_DECL void record_pending_timers();
+
   // Called to recalculate and update the timeout.
   ASIO_DECL void update_timeout();
 
@@ -273,10 +287,23 @@ private:
   // How any times to spin waiting for the I/O mutex.
   const int io_locking_spin_count_;
 
-  // Mutex to protect access to the registered descriptors.
-  mutex registered_descriptors_mutex_;
+  // The time, in microseconds, for which epoll_wait busy polls the device
+  // queues of the registered sockets. Zero disables busy polling.
+  const unsigned int busy_poll_usec_;
+
+  // The number of packets to process on each busy poll, or zero for the
+  // kernel default.
+  const unsigned int busy_poll_budget_;
+
+  // Whether to prefer busy polling over device interrupts.
+  const bool prefer_busy_poll_;
+
+  // Whether listening sockets are registered with EPOLLEXCLUSIVE, so that a
+  // listening socket shared by several reactors wakes only one of them.
+  const bool exclusive_listeners_;
 
-  // Keep track of all registered descriptors.
+  // Keep track of all registered descriptors. The pool may be used without
+  // locking.
   object_pool<descriptor_state, execution_context::allocator<void>>
     registered_descriptors_;
 
@@ -45,6 +45,18 @@ public:
     other.impl_ = 0;
   }
 
+  executor_function& operator=(executor_function&& other) noexcept
+  {
+    if (this != &other)
+    {
+      if (impl_)
+        impl_->complete_(impl_, false);
+      impl_ = other.impl_;
+      other.impl_ = 0;
+    }
+    return *this;
+  }
+
   ~executor_function()
   {
     if (impl_)
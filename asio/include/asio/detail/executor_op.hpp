@@ -38,6 +38,7 @@ public:
       handler_(static_cast<H&&>(h)),
       allocator_(allocator)
   {
+    this->set_latency_kind(latency_post);
   }
 
   static void do_complete(void* owner, Operation* base,
@@ -0,0 +1,128 @@
+//
+// detail/fiber_stack_cache.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_FIBER_STACK_CACHE_HPP
+#define ASIO_DETAIL_FIBER_STACK_CACHE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+#ifndef ASIO_FIBER_STACK_CACHE_SIZE
+# define ASIO_FIBER_STACK_CACHE_SIZE 16
+#endif // ASIO_FIBER_STACK_CACHE_SIZE
+
+// A per-thread cache of stacks for stackful coroutines. Each stack is mapped
+// with an inaccessible guard page below it, and its pages are committed only
+// when first touched. Unused stacks are linked through their own memory.
+class fiber_stack_cache
+  : private noncopyable
+{
+public:
+  // The maximum number of stacks held by a cache.
+  enum { max_stacks = ASIO_FIBER_STACK_CACHE_SIZE };
+
+  // Construct an empty cache.
+  fiber_stack_cache()
+    : head_(0),
+      count_(0)
+  {
+  }
+
+  // Destructor unmaps all cached stacks.
+  ~fiber_stack_cache()
+  {
+    if (head_)
+      clear();
+  }
+
+  // Take a cached stack with the specified usable size, which must be a
+  // multiple of the page size. Returns the lowest address of the stack's
+  // mapping, or null if no such stack is cached.
+  void* take(std::size_t size)
+  {
+    entry** e = &head_;
+    while (*e)
+    {
+      if ((*e)->size_ == size)
+      {
+        entry* found = *e;
+        *e = found->next_;
+        --count_;
+        return static_cast<unsigned char*>(static_cast<void*>(found + 1))
+          - size - guard_size();
+      }
+      e = &(*e)->next_;
+    }
+    return 0;
+  }
+
+  // Add a stack to the cache. Returns false if the cache is full, in which
+  // case the caller retains ownership of the stack.
+  bool put(void* base, std::size_t size)
+  {
+    if (count_ >= max_stacks)
+      return false;
+    entry* e = static_cast<entry*>(static_cast<void*>(
+          static_cast<unsigned char*>(base) + guard_size() + size)) - 1;
+    e->next_ = head_;
+    e->size_ = size;
+    head_ = e;
+    ++count_;
+    return true;
+  }
+
+  // Unmap all cached stacks.
+  ASIO_DECL void clear();
+
+  // Get the size of the guard region below each stack.
+  ASIO_DECL static std::size_t guard_size();
+
+  // Round a stack size up to a multiple of the page size.
+  ASIO_DECL static std::size_t round_size(std::size_t size);
+
+  // Map a stack with the specified usable size, which must be a multiple of
+  // the page size. Returns the lowest address of the mapping.
+  ASIO_DECL static void* map(std::size_t size);
+
+  // Unmap a stack.
+  ASIO_DECL static void unmap(void* base, std::size_t size);
+
+private:
+  // Header placed at the top of an unused stack.
+  struct entry
+  {
+    entry* next_;
+    std::size_t size_;
+  };
+
+  entry* head_;
+  std::size_t count_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/fiber_stack_cache.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_DETAIL_FIBER_STACK_CACHE_HPP
@@ -0,0 +1,144 @@
+//
+// detail/frame_slot_impl.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_FRAME_SLOT_IMPL_HPP
+#define ASIO_DETAIL_FRAME_SLOT_IMPL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include "asio/detail/atomic_count.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A single cached block of memory that is handed out to one allocation at a
+// time. While the block is in use, other allocations are refused and the
+// caller falls back to another allocator. When the block is deallocated it is
+// kept for the next allocation, and it is only replaced when a larger one is
+// needed.
+//
+// The object is reference counted. The owning frame_slot holds one reference
+// and each copy of frame_slot_allocator holds another, so that memory may be
+// returned after the frame_slot has been destroyed.
+class frame_slot_impl
+  : private noncopyable
+{
+public:
+  // The alignment of the cached block.
+  static constexpr std::size_t block_align = ASIO_DEFAULT_ALIGN;
+
+  // Create a new object, holding the caller's reference.
+  frame_slot_impl()
+    : ref_count_(1),
+      busy_(false),
+      block_(0),
+      size_(0)
+  {
+  }
+
+  // Releases a reference if construction of the owner throws.
+  struct release_on_throw
+  {
+    frame_slot_impl* impl_;
+    ~release_on_throw() { if (impl_) impl_->release(); }
+  };
+
+  // Add a reference.
+  void add_ref() noexcept
+  {
+    ref_count_up(ref_count_);
+  }
+
+  // Release a reference.
+  void release() noexcept
+  {
+    if (ref_count_down(ref_count_))
+      delete this;
+  }
+
+  // Get the size of the cached block.
+  std::size_t capacity() const noexcept
+  {
+    return size_.load(std::memory_order_relaxed);
+  }
+
+  // Obtain the cached block, growing it if it is too small. Returns 0 if the
+  // block is already in use.
+  void* try_allocate(std::size_t size)
+  {
+    if (busy_.exchange(true, std::memory_order_acquire))
+      return 0;
+
+    void* block = block_.load(std::memory_order_relaxed);
+    if (size_.load(std::memory_order_relaxed) < size)
+    {
+      // Give up the block if the allocation throws.
+      struct busy_guard
+      {
+        std::atomic<bool>* busy_;
+        ~busy_guard() { if (busy_) busy_->store(false); }
+      } guard = { &busy_ };
+
+      void* new_block = aligned_new(block_align, size);
+      guard.busy_ = 0;
+
+      // The new block is published before the old one is freed, so that
+      // try_deallocate never mistakes memory reusing the old address for the
+      // cached block.
+      block_.store(new_block, std::memory_order_release);
+      size_.store(size, std::memory_order_relaxed);
+      if (block)
+        aligned_delete(block);
+      block = new_block;
+    }
+
+    return block;
+  }
+
+  // Return the cached block to the slot. Returns false if the memory was not
+  // obtained from the slot.
+  bool try_deallocate(void* p) noexcept
+  {
+    if (p != block_.load(std::memory_order_acquire))
+      return false;
+
+    busy_.store(false, std::memory_order_release);
+    return true;
+  }
+
+private:
+  // Only release() may delete the object.
+  ~frame_slot_impl()
+  {
+    if (void* block = block_.load(std::memory_order_relaxed))
+      aligned_delete(block);
+  }
+
+  atomic_count ref_count_;
+  std::atomic<bool> busy_;
+  std::atomic<void*> block_;
+  std::atomic<std::size_t> size_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_FRAME_SLOT_IMPL_HPP
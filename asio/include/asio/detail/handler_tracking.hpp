@@ -26,6 +26,7 @@ class execution_context;
 #if defined(ASIO_CUSTOM_HANDLER_TRACKING)
 # include ASIO_CUSTOM_HANDLER_TRACKING
 #elif defined(ASIO_ENABLE_HANDLER_TRACKING)
+# include <cstddef>
 # include "asio/error_code.hpp"
 # include "asio/detail/cstdint.hpp"
 # include "asio/detail/static_mutex.hpp"
@@ -62,6 +63,12 @@ namespace detail {
 
 #elif defined(ASIO_ENABLE_HANDLER_TRACKING)
 
+# if defined(ASIO_ENABLE_BUFFERED_HANDLER_TRACKING)
+#  if !defined(ASIO_HANDLER_TRACKING_BUFFER_SIZE)
+#   define ASIO_HANDLER_TRACKING_BUFFER_SIZE 4096
+#  endif // !defined(ASIO_HANDLER_TRACKING_BUFFER_SIZE)
+# endif // defined(ASIO_ENABLE_BUFFERED_HANDLER_TRACKING)
+
 class handler_tracking
 {
 public:
@@ -183,9 +190,40 @@ public:
   // Write a line of output.
   ASIO_DECL static void write_line(const char* format, ...);
 
+  // The type of a function that receives drained lines of output.
+  typedef void (*drain_function)(const char* line,
+      std::size_t length, void* arg);
+
+  // Format the records buffered by all threads, in timestamp order, and pass
+  // each resulting line to the specified function. Returns the number of
+  // records drained. Does nothing unless buffered tracking is enabled.
+  ASIO_DECL static std::size_t drain(drain_function f, void* arg);
+
+  // Format the records buffered by all threads and write them to the standard
+  // error stream.
+  ASIO_DECL static std::size_t drain();
+
 private:
   struct tracking_state;
+  struct record;
+  struct record_buffer;
   ASIO_DECL static tracking_state* get_state();
+
+  // Write a record, either immediately as a line of output or by appending it
+  // to the calling thread's buffer.
+  ASIO_DECL static void write_record(const record& r);
+
+  // Format a record as a line of output.
+  ASIO_DECL static int format_record(const record& r,
+      char* line, std::size_t size);
+
+  // Format a line of output into the specified buffer.
+  ASIO_DECL static int format_line(char* line,
+      std::size_t size, const char* format, ...);
+
+  // Write formatted output to the standard error stream.
+  ASIO_DECL static void write_output(const char* line,
+      std::size_t length, void* arg);
 };
 
 # define ASIO_INHERIT_TRACKED_HANDLER \
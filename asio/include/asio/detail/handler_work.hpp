@@ -204,6 +204,74 @@ public:
   }
 };
 
+#if !defined(ASIO_NO_TS_EXECUTORS)
+
+// Specialisation for a handler whose associated executor is the native
+// executor of the same execution context as the I/O executor, such as the
+// intermediate handler of a composed operation. No outstanding work is taken
+// when the executors are equal and the I/O executor does not itself own work,
+// and the handler is then invoked directly.
+template <typename Executor, typename IoContext, typename PolymorphicExecutor>
+class handler_work_base<Executor, Executor, IoContext, PolymorphicExecutor,
+    enable_if_t<
+      is_same<
+        Executor,
+        typename IoContext::executor_type
+      >::value
+    >
+  >
+{
+public:
+  handler_work_base(bool base1_owns_work, const Executor& ex,
+      const Executor& candidate) noexcept
+    : executor_(ex),
+      owns_work_(base1_owns_work || ex != candidate)
+  {
+    if (owns_work_)
+      executor_.on_work_started();
+  }
+
+  handler_work_base(const handler_work_base& other) noexcept
+    : executor_(other.executor_),
+      owns_work_(other.owns_work_)
+  {
+    if (owns_work_)
+      executor_.on_work_started();
+  }
+
+  handler_work_base(handler_work_base&& other) noexcept
+    : executor_(static_cast<Executor&&>(other.executor_)),
+      owns_work_(other.owns_work_)
+  {
+    other.owns_work_ = false;
+  }
+
+  ~handler_work_base()
+  {
+    if (owns_work_)
+      executor_.on_work_finished();
+  }
+
+  bool owns_work() const noexcept
+  {
+    return owns_work_;
+  }
+
+  template <typename Function, typename Handler>
+  void dispatch(Function& function, Handler& handler)
+  {
+    asio::prefer(executor_,
+        execution::allocator((get_associated_allocator)(handler))
+      ).execute(static_cast<Function&&>(function));
+  }
+
+private:
+  Executor executor_;
+  bool owns_work_;
+};
+
+#endif // !defined(ASIO_NO_TS_EXECUTORS)
+
 template <typename Executor, typename IoContext>
 class handler_work_base<Executor, void, IoContext, Executor>
 {
@@ -16,7 +16,9 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
-#include <list>
+#include <cstddef>
+#include <cstdint>
+#include <new>
 #include <utility>
 #include "asio/detail/assert.hpp"
 #include "asio/detail/noncopyable.hpp"
@@ -48,7 +50,19 @@ inline std::size_t calculate_hash_value(SOCKET s)
 }
 #endif // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
 
-// Note: assumes K and V are POD types.
+// An open addressing hash map using Robin Hood hashing. Values are stored
+// inline in a single array of slots, so that no allocation is needed to insert
+// an element unless the table grows. Erasing an element shifts the elements
+// that follow it back by one slot, so no tombstones are left behind.
+//
+// The table does not wrap around. Instead, it has enough slots after the last
+// bucket for the longest permitted probe sequence. Elements therefore only ever
+// move towards the start of the table when another element is erased, and the
+// iterators visit slots from the end of the table towards the start. This
+// means that an element may be erased while iterating over the map, provided
+// that the iterator has been advanced past it first.
+//
+// Values are relocated within the table using move construction.
 template <typename K, typename V>
 class hash_map
   : private noncopyable
@@ -57,142 +71,197 @@ public:
   // The type of a value in the map.
   typedef std::pair<K, V> value_type;
 
+private:
+  // A slot in the table.
+  struct slot_type
+  {
+    slot_type() : distance_(0) {}
+
+    value_type* value()
+    {
+      return static_cast<value_type*>(static_cast<void*>(storage_));
+    }
+
+    // Zero if the slot is empty, otherwise one more than the distance of the
+    // slot from the element's home bucket.
+    unsigned char distance_;
+
+    // Storage for the element.
+    alignas(value_type) unsigned char storage_[sizeof(value_type)];
+  };
+
+  template <typename Value>
+  class basic_iterator
+  {
+  public:
+    basic_iterator()
+      : slots_(0),
+        position_(0)
+    {
+    }
+
+    template <typename OtherValue>
+    basic_iterator(const basic_iterator<OtherValue>& other)
+      : slots_(other.slots_),
+        position_(other.position_)
+    {
+    }
+
+    Value& operator*() const
+    {
+      return *slots_[position_ - 1].value();
+    }
+
+    Value* operator->() const
+    {
+      return slots_[position_ - 1].value();
+    }
+
+    basic_iterator& operator++()
+    {
+      while (--position_ > 0 && slots_[position_ - 1].distance_ == 0)
+      {
+      }
+      return *this;
+    }
+
+    basic_iterator operator++(int)
+    {
+      basic_iterator tmp(*this);
+      ++*this;
+      return tmp;
+    }
+
+    friend bool operator==(const basic_iterator& a, const basic_iterator& b)
+    {
+      return a.position_ == b.position_;
+    }
+
+    friend bool operator!=(const basic_iterator& a, const basic_iterator& b)
+    {
+      return a.position_ != b.position_;
+    }
+
+  private:
+    friend class hash_map;
+    template <typename> friend class basic_iterator;
+
+    basic_iterator(slot_type* slots, std::size_t position)
+      : slots_(slots),
+        position_(position)
+    {
+    }
+
+    // The slots of the table.
+    slot_type* slots_;
+
+    // One more than the index of the current slot, or zero at the end.
+    std::size_t position_;
+  };
+
+public:
   // The type of a non-const iterator over the hash map.
-  typedef typename std::list<value_type>::iterator iterator;
+  typedef basic_iterator<value_type> iterator;
 
   // The type of a const iterator over the hash map.
-  typedef typename std::list<value_type>::const_iterator const_iterator;
+  typedef basic_iterator<const value_type> const_iterator;
 
   // Constructor.
   hash_map()
     : size_(0),
-      buckets_(0),
-      num_buckets_(0)
+      slots_(0),
+      num_buckets_(0),
+      num_slots_(0),
+      shift_(0)
   {
   }
 
   // Destructor.
   ~hash_map()
   {
-    delete[] buckets_;
+    clear();
+    delete[] slots_;
   }
 
   // Get an iterator for the beginning of the map.
   iterator begin()
   {
-    return values_.begin();
+    return ++iterator(slots_, num_slots_ + 1);
   }
 
   // Get an iterator for the beginning of the map.
   const_iterator begin() const
   {
-    return values_.begin();
+    return ++const_iterator(slots_, num_slots_ + 1);
   }
 
   // Get an iterator for the end of the map.
   iterator end()
   {
-    return values_.end();
+    return iterator(slots_, 0);
   }
 
   // Get an iterator for the end of the map.
   const_iterator end() const
   {
-    return values_.end();
+    return const_iterator(slots_, 0);
   }
 
   // Check whether the map is empty.
   bool empty() const
   {
-    return values_.empty();
+    return size_ == 0;
   }
 
   // Find an entry in the map.
   iterator find(const K& k)
   {
-    if (num_buckets_)
-    {
-      size_t bucket = calculate_hash_value(k) % num_buckets_;
-      iterator it = buckets_[bucket].first;
-      if (it == values_.end())
-        return values_.end();
-      iterator end_it = buckets_[bucket].last;
-      ++end_it;
-      while (it != end_it)
-      {
-        if (it->first == k)
-          return it;
-        ++it;
-      }
-    }
-    return values_.end();
+    return iterator(slots_, find_position(k));
   }
 
   // Find an entry in the map.
   const_iterator find(const K& k) const
   {
-    if (num_buckets_)
-    {
-      size_t bucket = calculate_hash_value(k) % num_buckets_;
-      const_iterator it = buckets_[bucket].first;
-      if (it == values_.end())
-        return it;
-      const_iterator end_it = buckets_[bucket].last;
-      ++end_it;
-      while (it != end_it)
-      {
-        if (it->first == k)
-          return it;
-        ++it;
-      }
-    }
-    return values_.end();
+    return const_iterator(slots_, find_position(k));
   }
 
   // Insert a new entry into the map.
   std::pair<iterator, bool> insert(const value_type& v)
   {
-    if (size_ + 1 >= num_buckets_)
-      rehash(hash_size(size_ + 1));
-    size_t bucket = calculate_hash_value(v.first) % num_buckets_;
-    iterator it = buckets_[bucket].first;
-    if (it == values_.end())
-    {
-      buckets_[bucket].first = buckets_[bucket].last =
-        values_insert(values_.end(), v);
-      ++size_;
-      return std::pair<iterator, bool>(buckets_[bucket].last, true);
-    }
-    iterator end_it = buckets_[bucket].last;
-    ++end_it;
-    while (it != end_it)
-    {
-      if (it->first == v.first)
-        return std::pair<iterator, bool>(it, false);
-      ++it;
-    }
-    buckets_[bucket].last = values_insert(end_it, v);
+    if (std::size_t position = find_position(v.first))
+      return std::pair<iterator, bool>(iterator(slots_, position), false);
+
+    if (size_ + 1 > max_load())
+      rehash(num_buckets_ ? num_buckets_ * 2
+          : static_cast<std::size_t>(min_buckets));
+
+    value_type tmp(v);
+    place(tmp);
     ++size_;
-    return std::pair<iterator, bool>(buckets_[bucket].last, true);
+    return std::pair<iterator, bool>(
+        iterator(slots_, find_position(v.first)), true);
   }
 
   // Erase an entry from the map.
   void erase(iterator it)
   {
-    ASIO_ASSERT(it != values_.end());
-    ASIO_ASSERT(num_buckets_ != 0);
-
-    size_t bucket = calculate_hash_value(it->first) % num_buckets_;
-    bool is_first = (it == buckets_[bucket].first);
-    bool is_last = (it == buckets_[bucket].last);
-    if (is_first && is_last)
-      buckets_[bucket].first = buckets_[bucket].last = values_.end();
-    else if (is_first)
-      ++buckets_[bucket].first;
-    else if (is_last)
-      --buckets_[bucket].last;
-
-    values_erase(it);
+    ASIO_ASSERT(it != end());
+    ASIO_ASSERT(num_slots_ != 0);
+
+    std::size_t index = it.position_ - 1;
+    slots_[index].value()->~value_type();
+
+    // Shift the following elements back until one is found that is already in
+    // its home bucket.
+    while (index + 1 < num_slots_ && slots_[index + 1].distance_ > 1)
+    {
+      relocate(slots_[index + 1], slots_[index]);
+      slots_[index].distance_ =
+        static_cast<unsigned char>(slots_[index + 1].distance_ - 1);
+      ++index;
+    }
+
+    slots_[index].distance_ = 0;
     --size_;
   }
 
@@ -200,127 +269,165 @@ public:
   void erase(const K& k)
   {
     iterator it = find(k);
-    if (it != values_.end())
+    if (it != end())
       erase(it);
   }
 
   // Remove all entries from the map.
   void clear()
   {
-    // Clear the values.
-    values_.clear();
+    for (std::size_t i = 0; i < num_slots_; ++i)
+    {
+      if (slots_[i].distance_ != 0)
+      {
+        slots_[i].value()->~value_type();
+        slots_[i].distance_ = 0;
+      }
+    }
     size_ = 0;
-
-    // Initialise all buckets to empty.
-    iterator end_it = values_.end();
-    for (size_t i = 0; i < num_buckets_; ++i)
-      buckets_[i].first = buckets_[i].last = end_it;
   }
 
 private:
-  // Calculate the hash size for the specified number of elements.
-  static std::size_t hash_size(std::size_t num_elems)
+  // The initial number of buckets.
+  enum { min_buckets = 16 };
+
+  // The longest permitted probe sequence. If an element cannot be placed
+  // within this distance of its home bucket, the table is grown.
+  enum { max_distance = 64 };
+
+  // The maximum number of elements for the current number of buckets.
+  std::size_t max_load() const
   {
-    static std::size_t sizes[] =
-    {
-#if defined(ASIO_HASH_MAP_BUCKETS)
-      ASIO_HASH_MAP_BUCKETS
-#else // ASIO_HASH_MAP_BUCKETS
-      3, 13, 23, 53, 97, 193, 389, 769, 1543, 3079, 6151, 12289, 24593,
-      49157, 98317, 196613, 393241, 786433, 1572869, 3145739, 6291469,
-      12582917, 25165843
-#endif // ASIO_HASH_MAP_BUCKETS
-    };
-    const std::size_t nth_size = sizeof(sizes) / sizeof(std::size_t) - 1;
-    for (std::size_t i = 0; i < nth_size; ++i)
-      if (num_elems < sizes[i])
-        return sizes[i];
-    return sizes[nth_size];
+    return num_buckets_ - num_buckets_ / 4;
   }
 
-  // Re-initialise the hash from the values already contained in the list.
-  void rehash(std::size_t num_buckets)
+  // Get the home bucket for a key. Fibonacci hashing spreads keys that differ
+  // only in their low bits, such as descriptors, across the table.
+  std::size_t home_bucket(const K& k) const
   {
-    if (num_buckets == num_buckets_)
-      return;
-    ASIO_ASSERT(num_buckets != 0);
+    std::size_t h = calculate_hash_value(k);
+#if (SIZE_MAX > 0xFFFFFFFF)
+    h *= static_cast<std::size_t>(0x9E3779B97F4A7C15ULL);
+#else // (SIZE_MAX > 0xFFFFFFFF)
+    h *= static_cast<std::size_t>(0x9E3779B9UL);
+#endif // (SIZE_MAX > 0xFFFFFFFF)
+    return h >> shift_;
+  }
 
-    iterator end_iter = values_.end();
+  // Find the position of a key, as used by the iterators. Returns zero if the
+  // key is not in the map.
+  std::size_t find_position(const K& k) const
+  {
+    if (size_ == 0)
+      return 0;
 
-    // Update number of buckets and initialise all buckets to empty.
-    bucket_type* tmp = new bucket_type[num_buckets];
-    delete[] buckets_;
-    buckets_ = tmp;
-    num_buckets_ = num_buckets;
-    for (std::size_t i = 0; i < num_buckets_; ++i)
-      buckets_[i].first = buckets_[i].last = end_iter;
+    std::size_t index = home_bucket(k);
+    for (std::size_t distance = 1; index < num_slots_; ++index, ++distance)
+    {
+      // An element that is closer to its home bucket than the key would be
+      // means that the key is not present.
+      if (slots_[index].distance_ < distance)
+        return 0;
+      if (slots_[index].value()->first == k)
+        return index + 1;
+    }
+    return 0;
+  }
 
-    // Put all values back into the hash.
-    iterator iter = values_.begin();
-    while (iter != end_iter)
+  // Place an element that is not already in the map, growing the table if
+  // necessary. The element is moved from, and poorer elements are displaced
+  // using the Robin Hood rule.
+  void place(value_type& v)
+  {
+    std::size_t index = home_bucket(v.first);
+    std::size_t distance = 1;
+    for (;;)
     {
-      std::size_t bucket = calculate_hash_value(iter->first) % num_buckets_;
-      if (buckets_[bucket].last == end_iter)
+      if (index == num_slots_ || distance > max_distance)
       {
-        buckets_[bucket].first = buckets_[bucket].last = iter++;
+        // No room for the element. Grow the table and start again.
+        rehash(num_buckets_ * 2);
+        index = home_bucket(v.first);
+        distance = 1;
+        continue;
       }
-      else if (++buckets_[bucket].last == iter)
+
+      slot_type& s = slots_[index];
+      if (s.distance_ == 0)
       {
-        ++iter;
+        new (s.value()) value_type(std::move(v));
+        s.distance_ = static_cast<unsigned char>(distance);
+        return;
       }
-      else
+
+      if (s.distance_ < distance)
       {
-        values_.splice(buckets_[bucket].last, values_, iter++);
-        --buckets_[bucket].last;
+        // The current element is closer to its home bucket, so it gives up its
+        // slot and the search continues for a place to put it.
+        value_type displaced(std::move(*s.value()));
+        s.value()->~value_type();
+        new (s.value()) value_type(std::move(v));
+        v.~value_type();
+        new (&v) value_type(std::move(displaced));
+        std::size_t displaced_distance = s.distance_;
+        s.distance_ = static_cast<unsigned char>(distance);
+        distance = displaced_distance;
       }
+
+      ++index;
+      ++distance;
     }
   }
 
-  // Insert an element into the values list by splicing from the spares list,
-  // if a spare is available, and otherwise by inserting a new element.
-  iterator values_insert(iterator it, const value_type& v)
+  // Move an element from one slot to an empty slot.
+  static void relocate(slot_type& from, slot_type& to)
   {
-    if (spares_.empty())
-    {
-      return values_.insert(it, v);
-    }
-    else
-    {
-      spares_.front() = v;
-      values_.splice(it, spares_, spares_.begin());
-      return --it;
-    }
+    new (to.value()) value_type(std::move(*from.value()));
+    from.value()->~value_type();
   }
 
-  // Erase an element from the values list by splicing it to the spares list.
-  void values_erase(iterator it)
+  // Re-initialise the table with the specified number of buckets, which must
+  // be a power of two.
+  void rehash(std::size_t num_buckets)
   {
-    *it = value_type();
-    spares_.splice(spares_.begin(), values_, it);
-  }
+    ASIO_ASSERT(num_buckets != 0);
 
-  // The number of elements in the hash.
-  std::size_t size_;
+    slot_type* old_slots = slots_;
+    std::size_t old_num_slots = num_slots_;
 
-  // The list of all values in the hash map.
-  std::list<value_type> values_;
+    slots_ = new slot_type[num_buckets + max_distance];
+    num_buckets_ = num_buckets;
+    num_slots_ = num_buckets + max_distance;
+    shift_ = sizeof(std::size_t) * 8;
+    for (std::size_t n = num_buckets; n > 1; n >>= 1)
+      --shift_;
 
-  // The list of spare nodes waiting to be recycled. Assumes that POD types only
-  // are stored in the hash map.
-  std::list<value_type> spares_;
+    for (std::size_t i = 0; i < old_num_slots; ++i)
+    {
+      if (old_slots[i].distance_ != 0)
+      {
+        place(*old_slots[i].value());
+        old_slots[i].value()->~value_type();
+      }
+    }
 
-  // The type for a bucket in the hash table.
-  struct bucket_type
-  {
-    iterator first;
-    iterator last;
-  };
+    delete[] old_slots;
+  }
+
+  // The number of elements in the map.
+  std::size_t size_;
 
-  // The buckets in the hash.
-  bucket_type* buckets_;
+  // The slots of the table.
+  slot_type* slots_;
 
-  // The number of buckets in the hash.
+  // The number of home buckets. Always a power of two.
   std::size_t num_buckets_;
+
+  // The number of slots, including those after the last home bucket.
+  std::size_t num_slots_;
+
+  // The number of bits by which a hash value is shifted to obtain a bucket.
+  std::size_t shift_;
 };
 
 } // namespace detail
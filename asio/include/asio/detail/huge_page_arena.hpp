@@ -0,0 +1,183 @@
+//
+// detail/huge_page_arena.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_HUGE_PAGE_ARENA_HPP
+#define ASIO_DETAIL_HUGE_PAGE_ARENA_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_HUGE_PAGES)
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+#ifndef ASIO_HUGE_PAGE_ARENA_SIZE
+# define ASIO_HUGE_PAGE_ARENA_SIZE (std::size_t(64) << 30)
+#endif // ASIO_HUGE_PAGE_ARENA_SIZE
+
+// A process-wide arena of memory that is backed by huge pages, used for the
+// buffers and handler memory of execution contexts whose memory.huge_pages
+// configuration option is set. There is one arena for each kind of huge page.
+//
+// The address space for all arenas is reserved as a single region when the
+// first arena is created, so that any pointer may be tested cheaply for
+// membership, and pages are committed as the arenas grow. The region is
+// divided into units, each of which holds blocks of a single size, so that a
+// block's size is found from its address. Freed blocks are kept for reuse and
+// the memory is not returned to the system.
+class huge_page_arena
+  : private noncopyable
+{
+public:
+  // The kinds of huge page. The values are those of the memory.huge_pages
+  // configuration option.
+  enum mode
+  {
+    // Pages that the kernel may promote to transparent huge pages.
+    transparent = 1,
+
+    // Explicit 2MB huge pages from the hugetlbfs pool.
+    explicit_2mb = 2,
+
+    // Explicit 1GB huge pages from the hugetlbfs pool.
+    explicit_1gb = 3
+  };
+
+  // The alignment of every block.
+  enum { alignment = 64 };
+
+  // Get the arena for the specified mode, creating it on first use. Returns
+  // null if the mode is not valid or the address space cannot be reserved.
+  ASIO_DECL static huge_page_arena* get(int mode);
+
+  // Determine whether a block was allocated from an arena.
+  static bool contains(const void* p) noexcept
+  {
+    uintptr_t base = region_base().load(std::memory_order_relaxed);
+    return base != 0 && reinterpret_cast<uintptr_t>(p) - base
+      < static_cast<uintptr_t>(num_modes) * ASIO_HUGE_PAGE_ARENA_SIZE;
+  }
+
+  // Allocate a block of at least the specified size. Returns null if the
+  // arena is exhausted or its pages cannot be committed, in which case the
+  // caller should use the system allocator.
+  ASIO_DECL void* allocate(std::size_t size);
+
+  // Return a block to the arena from which it was allocated.
+  ASIO_DECL static void deallocate(void* p);
+
+private:
+  enum
+  {
+    // The number of kinds of huge page.
+    num_modes = 3,
+
+    // The size of the units into which the arena is divided.
+    unit_size = 64 * 1024,
+
+    // The largest block that is kept on a free list for its size.
+    max_small_size = 64 * 1024,
+
+    // The number of free lists for small blocks.
+    num_bins = max_small_size / alignment,
+
+    // The sizes of huge pages.
+    page_size_2mb = 1 << 21,
+    page_size_1gb = 1 << 30
+  };
+
+  // Construct an arena over the specified part of the reserved region.
+  ASIO_DECL huge_page_arena(int mode, unsigned char* base);
+
+  // Destructor, called only if the arena could not be initialised.
+  ASIO_DECL ~huge_page_arena();
+
+  // Get the arenas, indexed by mode.
+  ASIO_DECL static huge_page_arena** all_arenas();
+
+  // Commit the pages of the arena up to the specified address.
+  ASIO_DECL bool commit(unsigned char* end);
+
+  // Take the specified number of units from the unused part of the arena,
+  // recording the size of the blocks they hold. Returns null on failure.
+  ASIO_DECL unsigned char* take_units(
+      std::size_t count, std::size_t block_size);
+
+  // Get the address of the reserved region, or zero if none is reserved.
+  static std::atomic<uintptr_t>& region_base() noexcept
+  {
+    static std::atomic<uintptr_t> base(0);
+    return base;
+  }
+
+  // The free blocks and unused space for one size of small block.
+  struct bin
+  {
+    void* free_;
+    unsigned char* next_;
+    unsigned char* end_;
+  };
+
+  // The kind of huge page.
+  int mode_;
+
+  // The size of the pages with which the arena is committed.
+  std::size_t page_size_;
+
+  // The start of the arena's part of the reserved region.
+  unsigned char* base_;
+
+  // The first unit that has not been used.
+  unsigned char* unused_;
+
+  // The end of the committed part of the arena.
+  unsigned char* committed_;
+
+  // Whether committing pages has failed, after which no more are committed.
+  bool failed_;
+
+  // The size, in multiples of the alignment, of the blocks in each unit.
+  uint32_t* unit_sizes_;
+
+  // Protects the free lists and the unused part of the arena.
+  mutex mutex_;
+
+  // The free lists for small blocks, indexed by size.
+  bin bins_[num_bins];
+
+  // Free large blocks, keyed by size.
+  std::multimap<std::size_t, void*> large_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/huge_page_arena.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // defined(ASIO_HAS_HUGE_PAGES)
+
+#endif // ASIO_DETAIL_HUGE_PAGE_ARENA_HPP
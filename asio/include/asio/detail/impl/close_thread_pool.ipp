@@ -0,0 +1,132 @@
+//
+// detail/impl/close_thread_pool.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_CLOSE_THREAD_POOL_IPP
+#define ASIO_DETAIL_IMPL_CLOSE_THREAD_POOL_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if !defined(ASIO_HAS_IOCP) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
+#include "asio/config.hpp"
+#include "asio/detail/close_thread_pool.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class close_thread_pool::work_scheduler_runner
+{
+public:
+  work_scheduler_runner(scheduler& work_scheduler)
+    : work_scheduler_(work_scheduler)
+  {
+  }
+
+  void operator()()
+  {
+    asio::error_code ec;
+    work_scheduler_.run(ec);
+  }
+
+private:
+  scheduler& work_scheduler_;
+};
+
+close_thread_pool::close_thread_pool(execution_context& context)
+  : execution_context_service_base<close_thread_pool>(context),
+    scheduler_(asio::use_service<scheduler>(context)),
+    work_scheduler_(scheduler::internal(), context),
+    work_threads_(execution_context::allocator<void>(context)),
+    num_work_threads_(config(context).get("reactor", "close_threads", 1U)),
+    scheduler_locking_(config(context).get("scheduler", "locking", true)),
+    shutdown_(false)
+{
+  work_scheduler_.work_started();
+  if (num_work_threads_ == 0)
+    num_work_threads_ = 1;
+}
+
+close_thread_pool::~close_thread_pool()
+{
+  shutdown();
+}
+
+void close_thread_pool::shutdown()
+{
+  if (!shutdown_)
+  {
+    // The threads are joined only once any outstanding closes are performed,
+    // so that no descriptors are leaked.
+    work_scheduler_.work_finished();
+    work_threads_.join();
+    work_scheduler_.shutdown();
+    shutdown_ = true;
+  }
+}
+
+void close_thread_pool::notify_fork(execution_context::fork_event fork_ev)
+{
+  if (!work_threads_.empty())
+  {
+    if (fork_ev == execution_context::fork_prepare)
+    {
+      work_scheduler_.stop();
+      work_threads_.join();
+    }
+  }
+  else if (fork_ev != execution_context::fork_prepare)
+  {
+    work_scheduler_.restart();
+  }
+}
+
+void close_thread_pool::start_close_op(operation* op, bool is_continuation)
+{
+  scheduler_.work_started();
+  if (scheduler_locking_)
+  {
+    start_work_threads();
+    work_scheduler_.post_immediate_completion(op, is_continuation);
+  }
+  else
+  {
+    // Without locking the internal threads may not post to the scheduler, so
+    // the close is performed by the calling thread instead.
+    op->complete(&work_scheduler_, asio::error_code(), 0);
+  }
+}
+
+void close_thread_pool::start_work_threads()
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  if (work_threads_.empty())
+    for (unsigned int i = 0; i < num_work_threads_; ++i)
+      work_threads_.create_thread(work_scheduler_runner(work_scheduler_));
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // !defined(ASIO_HAS_IOCP)
+       //   && !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
+#endif // ASIO_DETAIL_IMPL_CLOSE_THREAD_POOL_IPP
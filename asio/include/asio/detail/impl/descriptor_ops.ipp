@@ -851,6 +851,68 @@ bool non_blocking_write_at1(int d, uint64_t offset,
   }
 }
 
+void readahead(int d, bool is_stream, uint64_t offset, std::size_t size)
+{
+  if (is_stream)
+  {
+    off_t position = ::lseek(d, 0, SEEK_CUR);
+    if (position < 0)
+      return;
+    offset = static_cast<uint64_t>(position);
+  }
+
+#if defined(POSIX_FADV_WILLNEED)
+  (void)::posix_fadvise(d, static_cast<off_t>(offset),
+      static_cast<off_t>(size), POSIX_FADV_WILLNEED);
+#elif defined(F_RDADVISE)
+  struct radvisory advice;
+  advice.ra_offset = static_cast<off_t>(offset);
+  advice.ra_count = size < INT_MAX ? static_cast<int>(size) : INT_MAX;
+  (void)::fcntl(d, F_RDADVISE, &advice);
+#else // defined(F_RDADVISE)
+  (void)d;
+  (void)offset;
+  (void)size;
+#endif // defined(F_RDADVISE)
+}
+
+int sync(int d, sync_type type, uint64_t offset,
+    uint64_t size, asio::error_code& ec)
+{
+  if (d == -1)
+  {
+    ec = asio::error::bad_descriptor;
+    return -1;
+  }
+
+  int result;
+  switch (type)
+  {
+  case sync_range_type:
+#if defined(SYNC_FILE_RANGE_WRITE)
+    result = ::sync_file_range(d, static_cast<off_t>(offset),
+        static_cast<off_t>(size), SYNC_FILE_RANGE_WAIT_BEFORE
+          | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+    break;
+#endif // defined(SYNC_FILE_RANGE_WRITE)
+    // Fall through.
+  case sync_data_type:
+#if defined(_POSIX_SYNCHRONIZED_IO) && (_POSIX_SYNCHRONIZED_IO > 0)
+    result = ::fdatasync(d);
+    break;
+#endif // defined(_POSIX_SYNCHRONIZED_IO) && (_POSIX_SYNCHRONIZED_IO > 0)
+    // Fall through.
+  default:
+    result = ::fsync(d);
+    break;
+  }
+
+  (void)offset;
+  (void)size;
+  get_last_error(ec, result != 0);
+  return result;
+}
+
 #endif // defined(ASIO_HAS_FILE)
 
 int ioctl(int d, state_type& state, long cmd,
@@ -63,6 +63,7 @@ void dev_poll_reactor::schedule_timer(
 
   bool earliest = queue.enqueue_timer(time, timer, op);
   scheduler_.work_started();
+  record_pending_timers();
   if (earliest)
     interrupter_.interrupt();
 }
@@ -76,6 +77,7 @@ std::size_t dev_poll_reactor::cancel_timer(
   asio::detail::mutex::scoped_lock lock(mutex_);
   op_queue<operation> ops;
   std::size_t n = queue.cancel_timer(timer, ops, max_cancelled);
+  record_pending_timers();
   lock.unlock();
   scheduler_.post_deferred_completions(ops);
   return n;
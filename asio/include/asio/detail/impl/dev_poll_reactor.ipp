@@ -313,6 +313,7 @@ void dev_poll_reactor::run(long usec, op_queue<operation>& ops)
   dp.dp_nfds = 128;
   dp.dp_timeout = timeout;
   int num_events = ::ioctl(dev_poll_fd_, DP_POLL, &dp);
+  scheduler_.metrics().record_task_run(num_events > 0 ? num_events : 0);
 
   lock.lock();
 
@@ -386,6 +387,7 @@ void dev_poll_reactor::run(long usec, op_queue<operation>& ops)
     }
   }
   timer_queues_.get_ready_timers(ops);
+  record_pending_timers();
 }
 
 void dev_poll_reactor::interrupt()
@@ -417,6 +419,12 @@ void dev_poll_reactor::do_remove_timer_queue(timer_queue_base& queue)
   timer_queues_.erase(&queue);
 }
 
+void dev_poll_reactor::record_pending_timers()
+{
+  if (scheduler_.metrics().enabled())
+    scheduler_.metrics().record_pending_timers(timer_queues_.total_size());
+}
+
 int dev_poll_reactor::get_timeout(int msec)
 {
   // By default we will wait no longer than 5 minutes. This will ensure that
@@ -0,0 +1,380 @@
+//
+// detail/impl/dns_ops.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_DNS_OPS_IPP
+#define ASIO_DETAIL_IMPL_DNS_OPS_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "asio/detail/dns_ops.hpp"
+#include "asio/detail/socket_types.hpp"
+
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+# include <ifaddrs.h>
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+namespace dns_ops {
+
+inline bool is_space(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+inline char to_lower(char c)
+{
+  return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// Split a line into whitespace-separated words.
+inline void split_words(const char* begin, const char* end,
+    std::vector<std::string>& words)
+{
+  words.clear();
+  while (begin != end)
+  {
+    while (begin != end && is_space(*begin))
+      ++begin;
+    const char* word = begin;
+    while (begin != end && !is_space(*begin))
+      ++begin;
+    if (word != begin)
+      words.push_back(std::string(word, begin));
+  }
+}
+
+// Parse the value of an option such as "ndots:2", clamped to a maximum.
+inline void parse_option(const std::string& word, const char* name,
+    unsigned int max_value, unsigned int& value)
+{
+  std::size_t length = std::strlen(name);
+  if (word.size() > length && word.compare(0, length, name) == 0
+      && word[length] == ':')
+  {
+    unsigned long n = std::strtoul(word.c_str() + length + 1, 0, 10);
+    value = static_cast<unsigned int>(n > max_value ? max_value : n);
+  }
+}
+
+// Remove a trailing dot from a name, and convert it to lower case.
+inline std::string normalise_name(const std::string& name)
+{
+  std::string result(name);
+  if (!result.empty() && result[result.size() - 1] == '.')
+    result.resize(result.size() - 1);
+  for (std::size_t i = 0; i < result.size(); ++i)
+    result[i] = to_lower(result[i]);
+  return result;
+}
+
+inline unsigned int read_u16(const unsigned char* p)
+{
+  return (static_cast<unsigned int>(p[0]) << 8) | p[1];
+}
+
+// Read a possibly compressed name starting at pos, which is advanced past the
+// name as it appears at that position. The name is appended to out in lower
+// case, if out is non-null.
+inline bool read_name(const unsigned char* data, std::size_t size,
+    std::size_t& pos, std::string* out)
+{
+  std::size_t p = pos;
+  bool jumped = false;
+  for (int jumps = 0; jumps < 64;)
+  {
+    if (p >= size)
+      return false;
+
+    unsigned int length = data[p];
+    if ((length & 0xC0) == 0xC0)
+    {
+      if (p + 1 >= size)
+        return false;
+      if (!jumped)
+        pos = p + 2;
+      p = ((length & 0x3F) << 8) | data[p + 1];
+      jumped = true;
+      ++jumps;
+    }
+    else if (length & 0xC0)
+    {
+      return false;
+    }
+    else if (length == 0)
+    {
+      if (!jumped)
+        pos = p + 1;
+      return true;
+    }
+    else
+    {
+      if (p + 1 + length > size)
+        return false;
+      if (out)
+      {
+        if (!out->empty())
+          out->push_back('.');
+        for (unsigned int i = 0; i < length; ++i)
+          out->push_back(to_lower(static_cast<char>(data[p + 1 + i])));
+      }
+      p += 1 + length;
+    }
+  }
+  return false;
+}
+
+void parse_resolver_config(const char* text, resolver_config& config)
+{
+  std::vector<std::string> words;
+  const char* line = text;
+  while (*line)
+  {
+    const char* end = line;
+    while (*end && *end != '\n')
+      ++end;
+
+    // Comments start with '#' or ';' and continue to the end of the line.
+    const char* comment = line;
+    while (comment != end && *comment != '#' && *comment != ';')
+      ++comment;
+
+    split_words(line, comment, words);
+    if (words.size() >= 2 && words[0] == "nameserver")
+    {
+      asio::error_code ec;
+      asio::ip::address server = asio::ip::make_address(words[1], ec);
+      if (!ec)
+        config.servers.push_back(server);
+    }
+    else if (words.size() >= 2 && words[0] == "domain")
+    {
+      config.search.assign(1, normalise_name(words[1]));
+    }
+    else if (words.size() >= 2 && words[0] == "search")
+    {
+      config.search.clear();
+      for (std::size_t i = 1; i < words.size(); ++i)
+        config.search.push_back(normalise_name(words[i]));
+    }
+    else if (words.size() >= 2 && words[0] == "options")
+    {
+      for (std::size_t i = 1; i < words.size(); ++i)
+      {
+        parse_option(words[i], "ndots", 15, config.ndots);
+        parse_option(words[i], "timeout", 30, config.timeout);
+        parse_option(words[i], "attempts", 5, config.attempts);
+      }
+    }
+
+    line = *end ? end + 1 : end;
+  }
+
+  if (config.timeout == 0)
+    config.timeout = 1;
+  if (config.attempts == 0)
+    config.attempts = 1;
+}
+
+bool load_resolver_config(const char* path, resolver_config& config)
+{
+  std::FILE* file = std::fopen(path, "r");
+  if (!file)
+    return false;
+
+  std::string text;
+  char buffer[1024];
+  while (std::size_t length = std::fread(buffer, 1, sizeof(buffer), file))
+    text.append(buffer, length);
+  std::fclose(file);
+
+  parse_resolver_config(text.c_str(), config);
+
+  // As for other resolvers, the local host is used when no name server is
+  // specified.
+  if (config.servers.empty())
+    config.servers.push_back(asio::ip::address_v4::loopback());
+
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  ifaddrs* addrs = 0;
+  if (::getifaddrs(&addrs) == 0)
+  {
+    config.has_ipv4 = false;
+    config.has_ipv6 = false;
+    for (ifaddrs* a = addrs; a; a = a->ifa_next)
+    {
+      if (a->ifa_addr && (a->ifa_flags & IFF_LOOPBACK) == 0)
+      {
+        if (a->ifa_addr->sa_family == AF_INET)
+          config.has_ipv4 = true;
+        else if (a->ifa_addr->sa_family == AF_INET6)
+          config.has_ipv6 = true;
+      }
+    }
+    ::freeifaddrs(addrs);
+
+    // A host with only loopback addresses queries both families.
+    if (!config.has_ipv4 && !config.has_ipv6)
+      config.has_ipv4 = config.has_ipv6 = true;
+  }
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+  return true;
+}
+
+void candidate_names(const std::string& host,
+    const resolver_config& config, std::vector<std::string>& names)
+{
+  names.clear();
+
+  // A name with a trailing dot is fully qualified.
+  if (!host.empty() && host[host.size() - 1] == '.')
+  {
+    names.push_back(host.substr(0, host.size() - 1));
+    return;
+  }
+
+  std::size_t dots = 0;
+  for (std::size_t i = 0; i < host.size(); ++i)
+    dots += host[i] == '.';
+
+  if (dots >= config.ndots)
+    names.push_back(host);
+  for (std::size_t i = 0; i < config.search.size(); ++i)
+    if (!config.search[i].empty())
+      names.push_back(host + "." + config.search[i]);
+  if (dots < config.ndots)
+    names.push_back(host);
+}
+
+std::size_t build_query(unsigned short id, const std::string& name,
+    record_type type, unsigned char* buffer, std::size_t size)
+{
+  if (size < max_query_size)
+    return 0;
+
+  std::memset(buffer, 0, header_size);
+  buffer[0] = static_cast<unsigned char>(id >> 8);
+  buffer[1] = static_cast<unsigned char>(id & 0xFF);
+  buffer[2] = 0x01; // Recursion desired.
+  buffer[5] = 1; // One question.
+
+  // Encode the name as a sequence of labels.
+  std::size_t pos = header_size;
+  std::size_t begin = 0;
+  while (begin < name.size())
+  {
+    std::size_t end = name.find('.', begin);
+    if (end == std::string::npos)
+      end = name.size();
+    std::size_t length = end - begin;
+    if (length == 0 || length > 63 || pos + 1 + length > header_size + 255)
+      return 0;
+    buffer[pos++] = static_cast<unsigned char>(length);
+    std::memcpy(buffer + pos, name.data() + begin, length);
+    pos += length;
+    begin = end + 1;
+  }
+  if (pos == header_size)
+    return 0;
+  buffer[pos++] = 0;
+
+  buffer[pos++] = 0;
+  buffer[pos++] = static_cast<unsigned char>(type);
+  buffer[pos++] = 0;
+  buffer[pos++] = 1; // Class IN.
+  return pos;
+}
+
+unsigned short message_id(const unsigned char* data)
+{
+  return static_cast<unsigned short>(read_u16(data));
+}
+
+bool parse_response(const unsigned char* data, std::size_t size,
+    const std::string& name, record_type type, response& result)
+{
+  if (size < header_size)
+    return false;
+
+  // The message must be a response to a standard query with one question.
+  unsigned int flags = read_u16(data + 2);
+  if ((flags & 0x8000) == 0 || (flags & 0x7800) != 0)
+    return false;
+  if (read_u16(data + 4) != 1)
+    return false;
+
+  result.rcode = static_cast<int>(flags & 0x000F);
+  result.truncated = (flags & 0x0200) != 0;
+  result.addresses.clear();
+
+  // The question must match the query.
+  std::size_t pos = header_size;
+  std::string question;
+  if (!read_name(data, size, pos, &question) || pos + 4 > size)
+    return false;
+  if (question != normalise_name(name)
+      || read_u16(data + pos) != static_cast<unsigned int>(type)
+      || read_u16(data + pos + 2) != 1)
+    return false;
+  pos += 4;
+
+  // Collect the addresses of the requested type from the answer section.
+  // Those of an alias's target follow the CNAME record.
+  unsigned int answers = read_u16(data + 6);
+  for (unsigned int i = 0; i < answers; ++i)
+  {
+    if (!read_name(data, size, pos, 0) || pos + 10 > size)
+      return result.truncated;
+
+    unsigned int rr_type = read_u16(data + pos);
+    unsigned int rr_class = read_u16(data + pos + 2);
+    std::size_t length = read_u16(data + pos + 8);
+    pos += 10;
+    if (pos + length > size)
+      return result.truncated;
+
+    if (rr_class == 1 && rr_type == static_cast<unsigned int>(type))
+    {
+      if (type == a_record && length == 4)
+      {
+        asio::ip::address_v4::bytes_type bytes;
+        std::memcpy(bytes.data(), data + pos, 4);
+        result.addresses.push_back(asio::ip::address_v4(bytes));
+      }
+      else if (type == aaaa_record && length == 16)
+      {
+        asio::ip::address_v6::bytes_type bytes;
+        std::memcpy(bytes.data(), data + pos, 16);
+        result.addresses.push_back(asio::ip::address_v6(bytes));
+      }
+    }
+
+    pos += length;
+  }
+
+  return true;
+}
+
+} // namespace dns_ops
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_IMPL_DNS_OPS_IPP
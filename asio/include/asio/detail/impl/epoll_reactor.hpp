@@ -60,6 +60,7 @@ void epoll_reactor::schedule_timer(timer_queue<TimeTraits, Allocator>& queue,
 
   bool earliest = queue.enqueue_timer(time, timer, op);
   scheduler_.work_started();
+  record_pending_timers();
   if (earliest)
     update_timeout();
 }
@@ -73,6 +74,7 @@ std::size_t epoll_reactor::cancel_timer(
   mutex::scoped_lock lock(mutex_);
   op_queue<operation> ops;
   std::size_t n = queue.cancel_timer(timer, ops, max_cancelled);
+  record_pending_timers();
   lock.unlock();
   scheduler_.post_deferred_completions(ops);
   return n;
@@ -21,10 +21,12 @@
 
 #include <cstddef>
 #include <sys/epoll.h>
+#include <sys/ioctl.h>
 #include "asio/config.hpp"
 #include "asio/detail/epoll_reactor.hpp"
 #include "asio/detail/scheduler.hpp"
 #include "asio/detail/throw_error.hpp"
+#include "asio/detail/usdt_probes.hpp"
 #include "asio/error.hpp"
 
 #if defined(ASIO_HAS_TIMERFD)
@@ -48,11 +50,17 @@ epoll_reactor::epoll_reactor(asio::execution_context& ctx)
     io_locking_(config(ctx).get("reactor", "io_locking", true)),
     io_locking_spin_count_(
         config(ctx).get("reactor", "io_locking_spin_count", 0)),
-    registered_descriptors_mutex_(mutex_.enabled(), mutex_.spin_count()),
+    busy_poll_usec_(config(ctx).get("reactor", "busy_poll_usec", 0U)),
+    busy_poll_budget_(config(ctx).get("reactor", "busy_poll_budget", 0U)),
+    prefer_busy_poll_(config(ctx).get("reactor", "prefer_busy_poll", false)),
+    exclusive_listeners_(
+        config(ctx).get("reactor", "exclusive_listeners", false)),
     registered_descriptors_(execution_context::allocator<void>(ctx),
         config(ctx).get("reactor", "preallocated_io_objects", 0U),
         io_locking_, io_locking_spin_count_)
 {
+  set_busy_poll_params();
+
   // Add the interrupter's descriptor to epoll.
   epoll_event ev = { 0, { 0 } };
   ev.events = EPOLLIN | EPOLLERR | EPOLLET;
@@ -85,12 +93,15 @@ void epoll_reactor::shutdown()
 
   op_queue<operation> ops;
 
-  while (descriptor_state* state = registered_descriptors_.first())
+  descriptor_state* state = registered_descriptors_.first();
+  while (state)
   {
     for (int i = 0; i < max_ops; ++i)
       ops.push(state->op_queue_[i]);
     state->shutdown_ = true;
+    descriptor_state* next_state = registered_descriptors_.next(state);
     registered_descriptors_.free(state);
+    state = next_state;
   }
 
   timer_queues_.get_all_timers(ops);
@@ -107,6 +118,7 @@ void epoll_reactor::notify_fork(
       ::close(epoll_fd_);
     epoll_fd_ = -1;
     epoll_fd_ = do_epoll_create();
+    set_busy_poll_params();
 
     if (timer_fd_ != -1)
       ::close(timer_fd_);
@@ -132,12 +144,17 @@ void epoll_reactor::notify_fork(
 
     update_timeout();
 
-    // Re-register all descriptors with epoll.
-    mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
+    // Re-register descriptors that have operations waiting on them. Idle
+    // descriptors, such as the parent's connections that a prefork child
+    // closes or never uses, are added when an operation is next started.
     for (descriptor_state* state = registered_descriptors_.first();
-        state != 0; state = state->next_)
+        state != 0; state = registered_descriptors_.next(state))
     {
-      if (state->registered_events_ != 0)
+      bool idle = true;
+      for (int i = 0; i < max_ops; ++i)
+        idle = idle && state->op_queue_[i].empty();
+      state->registration_pending_ = idle && state->registered_events_ != 0;
+      if (!idle && state->registered_events_ != 0)
       {
         ev.events = state->registered_events_;
         ev.data.ptr = state;
@@ -176,13 +193,23 @@ int epoll_reactor::register_descriptor(socket_type descriptor,
     descriptor_data->shutdown_ = false;
     for (int i = 0; i < max_ops; ++i)
       descriptor_data->try_speculative_[i] = true;
+    descriptor_data->registration_pending_ = false;
   }
 
   epoll_event ev = { 0, { 0 } };
-  ev.events = EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLPRI | EPOLLET;
+  ev.events = registration_events(descriptor);
   descriptor_data->registered_events_ = ev.events;
   ev.data.ptr = descriptor_data;
   int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, descriptor, &ev);
+#if defined(EPOLLEXCLUSIVE)
+  if (result != 0 && errno == EINVAL && (ev.events & EPOLLEXCLUSIVE))
+  {
+    // The kernel does not support exclusive wakeups.
+    ev.events = EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLPRI | EPOLLET;
+    descriptor_data->registered_events_ = ev.events;
+    result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, descriptor, &ev);
+  }
+#endif // defined(EPOLLEXCLUSIVE)
   if (result != 0)
   {
     if (errno == EPERM)
@@ -219,6 +246,7 @@ int epoll_reactor::register_internal_descriptor(
     descriptor_data->op_queue_[op_type].push(op);
     for (int i = 0; i < max_ops; ++i)
       descriptor_data->try_speculative_[i] = true;
+    descriptor_data->registration_pending_ = false;
   }
 
   epoll_event ev = { 0, { 0 } };
@@ -257,6 +285,8 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
     void (*on_immediate)(operation*, bool, const void*),
     const void* immediate_arg)
 {
+  ASIO_USDT_PROBE3(op_start, op, descriptor_data, op_type);
+
   if (!descriptor_data)
   {
     op->ec_ = asio::error::bad_descriptor;
@@ -272,6 +302,22 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
     return;
   }
 
+  if (descriptor_data->registration_pending_)
+  {
+    // The descriptor was idle when the process forked.
+    epoll_event ev = { 0, { 0 } };
+    ev.events = descriptor_data->registered_events_;
+    ev.data.ptr = descriptor_data;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, descriptor, &ev) != 0)
+    {
+      op->ec_ = asio::error_code(errno,
+          asio::error::get_system_category());
+      on_immediate(op, is_continuation, immediate_arg);
+      return;
+    }
+    descriptor_data->registration_pending_ = false;
+  }
+
   if (descriptor_data->op_queue_[op_type].empty())
   {
     if (allow_speculative
@@ -282,6 +328,8 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
       {
         if (reactor_op::status status = op->perform())
         {
+          ASIO_USDT_PROBE3(op_complete, op,
+              op->ec_.value(), op->bytes_transferred_);
           if (status == reactor_op::done_and_exhausted)
             if (descriptor_data->registered_events_ != 0)
               descriptor_data->try_speculative_[op_type] = false;
@@ -325,18 +373,30 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
       on_immediate(op, is_continuation, immediate_arg);
       return;
     }
-    else
+    else if (op_type != write_op
+        || descriptor_data->try_speculative_[op_type]
+        || (descriptor_data->registered_events_ & EPOLLOUT) == 0)
     {
       if (op_type == write_op)
       {
         descriptor_data->registered_events_ |= EPOLLOUT;
       }
+      else if (op_type == peer_closed_op)
+      {
+        // Peer closure is only reported once something waits for it.
+        descriptor_data->registered_events_ |= EPOLLRDHUP;
+      }
 
+      // The descriptor may already be ready, in which case an edge-triggered
+      // registration reports nothing further until it is re-armed.
       epoll_event ev = { 0, { 0 } };
       ev.events = descriptor_data->registered_events_;
       ev.data.ptr = descriptor_data;
       epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, descriptor, &ev);
     }
+
+    // Otherwise, the last write found the send buffer full, and so the
+    // registration will report the descriptor once space becomes available.
   }
 
   descriptor_data->op_queue_[op_type].push(op);
@@ -411,7 +471,8 @@ void epoll_reactor::deregister_descriptor(socket_type descriptor,
       // The descriptor will be automatically removed from the epoll set when
       // it is closed.
     }
-    else if (descriptor_data->registered_events_ != 0)
+    else if (descriptor_data->registered_events_ != 0
+        && !descriptor_data->registration_pending_)
     {
       epoll_event ev = { 0, { 0 } };
       epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, descriptor, &ev);
@@ -521,7 +582,11 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
 
   // Block on the epoll descriptor.
   epoll_event events[128];
+  ASIO_USDT_PROBE2(reactor_wait_entry, this,
+      timeout < 0 ? -1L : timeout * 1000L);
   int num_events = epoll_wait(epoll_fd_, events, 128, timeout);
+  ASIO_USDT_PROBE2(reactor_wait_exit, this, num_events);
+  scheduler_.metrics().record_task_run(num_events > 0 ? num_events : 0);
 
 #if defined(ASIO_ENABLE_HANDLER_TRACKING)
   // Trace the waiting events.
@@ -605,6 +670,7 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
   {
     mutex::scoped_lock common_lock(mutex_);
     timer_queues_.get_ready_timers(ops);
+    record_pending_timers();
 
 #if defined(ASIO_HAS_TIMERFD)
     if (timer_fd_ != -1)
@@ -675,15 +741,58 @@ int epoll_reactor::do_timerfd_create()
 #endif // defined(ASIO_HAS_TIMERFD)
 }
 
+uint32_t epoll_reactor::registration_events(socket_type descriptor) const
+{
+#if defined(EPOLLEXCLUSIVE) && defined(SO_ACCEPTCONN)
+  if (exclusive_listeners_)
+  {
+    // Sockets are registered when an operation first waits, by which time a
+    // socket used for accepting connections is already listening. An
+    // exclusive registration cannot be modified, and so it does not include
+    // EPOLLOUT or EPOLLPRI.
+    int listening = 0;
+    socklen_t length = sizeof(listening);
+    if (::getsockopt(descriptor, SOL_SOCKET,
+          SO_ACCEPTCONN, &listening, &length) == 0 && listening)
+      return EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLET | EPOLLEXCLUSIVE;
+  }
+#else // defined(EPOLLEXCLUSIVE) && defined(SO_ACCEPTCONN)
+  (void)descriptor;
+#endif // defined(EPOLLEXCLUSIVE) && defined(SO_ACCEPTCONN)
+
+  return EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLPRI | EPOLLET;
+}
+
+void epoll_reactor::set_busy_poll_params()
+{
+  if (busy_poll_usec_ == 0 && busy_poll_budget_ == 0 && !prefer_busy_poll_)
+    return;
+
+  // The layout of struct epoll_params from linux/eventpoll.h, which older C
+  // libraries do not provide. Requires Linux 6.9 or later.
+  struct params_type
+  {
+    uint32_t busy_poll_usecs;
+    uint16_t busy_poll_budget;
+    uint8_t prefer_busy_poll;
+    uint8_t pad;
+  };
+
+  params_type params = { 0, 0, 0, 0 };
+  params.busy_poll_usecs = static_cast<uint32_t>(busy_poll_usec_);
+  params.busy_poll_budget = static_cast<uint16_t>(
+      busy_poll_budget_ < 0xFFFF ? busy_poll_budget_ : 0xFFFF);
+  params.prefer_busy_poll = prefer_busy_poll_ ? 1 : 0;
+  ::ioctl(epoll_fd_, _IOW(0x8A, 0x01, params_type), &params);
+}
+
 epoll_reactor::descriptor_state* epoll_reactor::allocate_descriptor_state()
 {
-  mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
   return registered_descriptors_.alloc(io_locking_, io_locking_spin_count_);
 }
 
 void epoll_reactor::free_descriptor_state(epoll_reactor::descriptor_state* s)
 {
-  mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
   registered_descriptors_.free(s);
 }
 
@@ -699,6 +808,12 @@ void epoll_reactor::do_remove_timer_queue(timer_queue_base& queue)
   timer_queues_.erase(&queue);
 }
 
+void epoll_reactor::record_pending_timers()
+{
+  if (scheduler_.metrics().enabled())
+    scheduler_.metrics().record_pending_timers(timer_queues_.total_size());
+}
+
 void epoll_reactor::update_timeout()
 {
 #if defined(ASIO_HAS_TIMERFD)
@@ -784,7 +899,7 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
 
   // Exception operations must be processed first to ensure that any
   // out-of-band data is read before normal data.
-  static const int flag[max_ops] = { EPOLLIN, EPOLLOUT, EPOLLPRI };
+  static const int flag[max_ops] = { EPOLLIN, EPOLLOUT, EPOLLPRI, EPOLLRDHUP };
   for (int j = max_ops - 1; j >= 0; --j)
   {
     if (events & (flag[j] | EPOLLERR | EPOLLHUP))
@@ -794,6 +909,8 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
       {
         if (reactor_op::status status = op->perform())
         {
+          ASIO_USDT_PROBE3(op_complete, op,
+              op->ec_.value(), op->bytes_transferred_);
           op_queue_[j].pop();
           io_cleanup.ops_.push(op);
           if (status == reactor_op::done_and_exhausted)
@@ -825,6 +942,7 @@ void epoll_reactor::descriptor_state::do_complete(
     uint32_t events = static_cast<uint32_t>(bytes_transferred);
     if (operation* op = descriptor_data->perform_io(events))
     {
+      descriptor_data->reactor_->scheduler_.record_latency(op);
       op->complete(owner, ec, 0);
     }
   }
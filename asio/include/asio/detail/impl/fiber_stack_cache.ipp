@@ -0,0 +1,119 @@
+//
+// detail/impl/fiber_stack_cache.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_FIBER_STACK_CACHE_IPP
+#define ASIO_DETAIL_IMPL_FIBER_STACK_CACHE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <new>
+#if defined(ASIO_WINDOWS)
+# include "asio/detail/socket_types.hpp"
+#else // defined(ASIO_WINDOWS)
+# include <sys/mman.h>
+# include <unistd.h>
+#endif // defined(ASIO_WINDOWS)
+#include "asio/detail/fiber_stack_cache.hpp"
+#include "asio/detail/throw_exception.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+void fiber_stack_cache::clear()
+{
+  while (head_)
+  {
+    std::size_t size = head_->size_;
+    unmap(take(size), size);
+  }
+}
+
+std::size_t fiber_stack_cache::guard_size()
+{
+#if defined(ASIO_WINDOWS)
+  static const std::size_t size = []
+  {
+    SYSTEM_INFO info;
+    ::GetSystemInfo(&info);
+    return static_cast<std::size_t>(info.dwPageSize);
+  }();
+#else // defined(ASIO_WINDOWS)
+  static const std::size_t size =
+    static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+#endif // defined(ASIO_WINDOWS)
+  return size;
+}
+
+std::size_t fiber_stack_cache::round_size(std::size_t size)
+{
+  std::size_t page_size = guard_size();
+  return size == 0 ? page_size
+    : (size + page_size - 1) / page_size * page_size;
+}
+
+void* fiber_stack_cache::map(std::size_t size)
+{
+  std::size_t total = size + guard_size();
+
+#if defined(ASIO_WINDOWS)
+  void* base = ::VirtualAlloc(0, total, MEM_RESERVE | MEM_COMMIT,
+      PAGE_READWRITE);
+  if (!base)
+  {
+    std::bad_alloc ex;
+    asio::detail::throw_exception(ex);
+  }
+
+  DWORD old_protect;
+  ::VirtualProtect(base, guard_size(), PAGE_NOACCESS, &old_protect);
+#else // defined(ASIO_WINDOWS)
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+# if defined(MAP_NORESERVE)
+  flags |= MAP_NORESERVE;
+# endif // defined(MAP_NORESERVE)
+# if defined(MAP_STACK)
+  flags |= MAP_STACK;
+# endif // defined(MAP_STACK)
+  void* base = ::mmap(0, total, PROT_READ | PROT_WRITE, flags, -1, 0);
+  if (base == MAP_FAILED)
+  {
+    std::bad_alloc ex;
+    asio::detail::throw_exception(ex);
+  }
+
+  // The lowest page is made inaccessible so that an overflow faults rather
+  // than silently corrupting adjacent memory.
+  ::mprotect(base, guard_size(), PROT_NONE);
+#endif // defined(ASIO_WINDOWS)
+
+  return base;
+}
+
+void fiber_stack_cache::unmap(void* base, std::size_t size)
+{
+#if defined(ASIO_WINDOWS)
+  (void)size;
+  ::VirtualFree(base, 0, MEM_RELEASE);
+#else // defined(ASIO_WINDOWS)
+  ::munmap(base, size + guard_size());
+#endif // defined(ASIO_WINDOWS)
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_IMPL_FIBER_STACK_CACHE_IPP
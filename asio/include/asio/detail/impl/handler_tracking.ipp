@@ -23,6 +23,7 @@
 
 #elif defined(ASIO_ENABLE_HANDLER_TRACKING)
 
+#include <atomic>
 #include <cstdarg>
 #include <cstdio>
 #include "asio/detail/chrono.hpp"
@@ -30,6 +31,11 @@
 #include "asio/detail/handler_tracking.hpp"
 #include "asio/wait_traits.hpp"
 
+#if defined(ASIO_ENABLE_BUFFERED_HANDLER_TRACKING)
+# include <algorithm>
+# include <vector>
+#endif // defined(ASIO_ENABLE_BUFFERED_HANDLER_TRACKING)
+
 #if defined(ASIO_WINDOWS_RUNTIME)
 # include "asio/detail/socket_types.hpp"
 #elif !defined(ASIO_WINDOWS)
@@ -43,31 +49,118 @@ namespace detail {
 
 struct handler_tracking_timestamp
 {
-  uint64_t seconds;
-  uint64_t microseconds;
-
-  handler_tracking_timestamp()
+  // Get the current time, in microseconds from 1 Jan 1970 UTC.
+  static uint64_t now()
   {
     typedef chrono_time_traits<chrono::system_clock,
         asio::wait_traits<chrono::system_clock>> traits_helper;
     traits_helper::posix_time_duration now(
         chrono::system_clock::now().time_since_epoch());
-    seconds = static_cast<uint64_t>(now.total_seconds());
-    microseconds = static_cast<uint64_t>(now.total_microseconds() % 1000000);
+    return static_cast<uint64_t>(now.total_microseconds());
+  }
+};
+
+// A fixed-size record of a single tracking event. All strings referenced by a
+// record have static storage duration, so that formatting may be deferred.
+struct handler_tracking::record
+{
+  enum record_kind
+  {
+    creation_location_kind, // n^m, with flag set for the innermost location.
+    creation_kind,          // n*m
+    completion_kind,        // !n or ~n, with flag set if invoked.
+    invocation_begin_kind,  // >n, with flag giving the argument form.
+    invocation_end_kind,    // <n
+    operation_kind,         // n
+    reactor_operation_kind  // .n, with flag set if bytes were transferred.
+  };
+
+  enum invocation_form
+  {
+    no_args,
+    ec_arg,
+    ec_bytes_args,
+    ec_signal_args,
+    ec_text_args
+  };
+
+  uint64_t time_;
+  uint64_t id_;
+  uint64_t other_id_;
+  const char* text1_;
+  const char* text2_;
+  const void* object_;
+  uint64_t value_;
+  int ec_value_;
+  unsigned char kind_;
+  unsigned char flag_;
+
+  record()
+  {
+  }
+
+  explicit record(record_kind kind, uint64_t id = 0)
+    : time_(handler_tracking_timestamp::now()),
+      id_(id),
+      other_id_(0),
+      text1_(0),
+      text2_(0),
+      object_(0),
+      value_(0),
+      ec_value_(0),
+      kind_(static_cast<unsigned char>(kind)),
+      flag_(0)
+  {
+  }
+};
+
+#if defined(ASIO_ENABLE_BUFFERED_HANDLER_TRACKING)
+
+// A single-producer, single-consumer ring of records written by one thread.
+// Buffers are never freed, so that they may be drained after their owning
+// threads have exited.
+struct handler_tracking::record_buffer
+{
+  enum { capacity = ASIO_HANDLER_TRACKING_BUFFER_SIZE };
+
+  record_buffer* next_;
+  std::atomic<std::size_t> head_;
+  std::atomic<std::size_t> tail_;
+  std::atomic<uint64_t> dropped_;
+  record records_[capacity];
+
+  explicit record_buffer(record_buffer* next)
+    : next_(next),
+      head_(0),
+      tail_(0),
+      dropped_(0)
+  {
   }
 };
 
+#else // defined(ASIO_ENABLE_BUFFERED_HANDLER_TRACKING)
+
+struct handler_tracking::record_buffer
+{
+};
+
+#endif // defined(ASIO_ENABLE_BUFFERED_HANDLER_TRACKING)
+
 struct handler_tracking::tracking_state
 {
   static_mutex mutex_;
-  uint64_t next_id_;
+  static_mutex drain_mutex_;
+  std::atomic<uint64_t> next_id_;
   tss_ptr<completion>* current_completion_;
   tss_ptr<location>* current_location_;
+  tss_ptr<record_buffer>* current_buffer_;
+  record_buffer* buffers_;
 };
 
 handler_tracking::tracking_state* handler_tracking::get_state()
 {
-  static tracking_state state = { ASIO_STATIC_MUTEX_INIT, 1, 0, 0 };
+  static tracking_state state = { ASIO_STATIC_MUTEX_INIT,
+    ASIO_STATIC_MUTEX_INIT, {1}, 0, 0, 0, 0 };
   return &state;
 }
 
@@ -76,12 +169,15 @@ void handler_tracking::init()
   static tracking_state* state = get_state();
 
   state->mutex_.init();
+  state->drain_mutex_.init();
 
   static_mutex::scoped_lock lock(state->mutex_);
   if (state->current_completion_ == 0)
     state->current_completion_ = new tss_ptr<completion>;
   if (state->current_location_ == 0)
     state->current_location_ = new tss_ptr<location>;
+  if (state->current_buffer_ == 0)
+    state->current_buffer_ = new tss_ptr<record_buffer>;
 }
 
 handler_tracking::location::location(
@@ -108,42 +204,30 @@ void handler_tracking::creation(execution_context&,
 {
   static tracking_state* state = get_state();
 
-  static_mutex::scoped_lock lock(state->mutex_);
-  h.id_ = state->next_id_++;
-  lock.unlock();
+  h.id_ = state->next_id_.fetch_add(1, std::memory_order_relaxed);
 
-  handler_tracking_timestamp timestamp;
+  record r(record::creation_location_kind, h.id_);
 
-  uint64_t current_id = 0;
   if (completion* current_completion = *state->current_completion_)
-    current_id = current_completion->id_;
+    r.other_id_ = current_completion->id_;
 
   for (location* current_location = *state->current_location_;
       current_location; current_location = current_location->next_)
   {
-    write_line(
-#if defined(ASIO_WINDOWS)
-        "@asio|%I64u.%06I64u|%I64u^%I64u|%s%s%.80s%s(%.80s:%d)\n",
-#else // defined(ASIO_WINDOWS)
-        "@asio|%llu.%06llu|%llu^%llu|%s%s%.80s%s(%.80s:%d)\n",
-#endif // defined(ASIO_WINDOWS)
-        timestamp.seconds, timestamp.microseconds,
-        current_id, h.id_,
-        current_location == *state->current_location_ ? "in " : "called from ",
-        current_location->func_ ? "'" : "",
-        current_location->func_ ? current_location->func_ : "",
-        current_location->func_ ? "' " : "",
-        current_location->file_, current_location->line_);
+    r.text1_ = current_location->file_;
+    r.text2_ = current_location->func_;
+    r.value_ = static_cast<uint64_t>(current_location->line_);
+    r.flag_ = current_location == *state->current_location_;
+    write_record(r);
   }
 
-  write_line(
-#if defined(ASIO_WINDOWS)
-      "@asio|%I64u.%06I64u|%I64u*%I64u|%.20s@%p.%.50s\n",
-#else // defined(ASIO_WINDOWS)
-      "@asio|%llu.%06llu|%llu*%llu|%.20s@%p.%.50s\n",
-#endif // defined(ASIO_WINDOWS)
-      timestamp.seconds, timestamp.microseconds,
-      current_id, h.id_, object_type, object, op_name);
+  r.kind_ = record::creation_kind;
+  r.text1_ = object_type;
+  r.text2_ = op_name;
+  r.object_ = object;
+  r.value_ = 0;
+  r.flag_ = 0;
+  write_record(r);
 }
 
 handler_tracking::completion::completion(
@@ -159,16 +243,9 @@ handler_tracking::completion::~completion()
 {
   if (id_)
   {
-    handler_tracking_timestamp timestamp;
-
-    write_line(
-#if defined(ASIO_WINDOWS)
-        "@asio|%I64u.%06I64u|%c%I64u|\n",
-#else // defined(ASIO_WINDOWS)
-        "@asio|%llu.%06llu|%c%llu|\n",
-#endif // defined(ASIO_WINDOWS)
-        timestamp.seconds, timestamp.microseconds,
-        invoked_ ? '!' : '~', id_);
+    record r(record::completion_kind, id_);
+    r.flag_ = invoked_;
+    write_record(r);
   }
 
   *get_state()->current_completion_ = next_;
@@ -176,15 +253,9 @@ handler_tracking::completion::~completion()
 
 void handler_tracking::completion::invocation_begin()
 {
-  handler_tracking_timestamp timestamp;
-
-  write_line(
-#if defined(ASIO_WINDOWS)
-      "@asio|%I64u.%06I64u|>%I64u|\n",
-#else // defined(ASIO_WINDOWS)
-      "@asio|%llu.%06llu|>%llu|\n",
-#endif // defined(ASIO_WINDOWS)
-      timestamp.seconds, timestamp.microseconds, id_);
+  record r(record::invocation_begin_kind, id_);
+  r.flag_ = record::no_args;
+  write_record(r);
 
   invoked_ = true;
 }
@@ -192,16 +263,11 @@ void handler_tracking::completion::invocation_begin()
 void handler_tracking::completion::invocation_begin(
     const asio::error_code& ec)
 {
-  handler_tracking_timestamp timestamp;
-
-  write_line(
-#if defined(ASIO_WINDOWS)
-      "@asio|%I64u.%06I64u|>%I64u|ec=%.20s:%d\n",
-#else // defined(ASIO_WINDOWS)
-      "@asio|%llu.%06llu|>%llu|ec=%.20s:%d\n",
-#endif // defined(ASIO_WINDOWS)
-      timestamp.seconds, timestamp.microseconds,
-      id_, ec.category().name(), ec.value());
+  record r(record::invocation_begin_kind, id_);
+  r.flag_ = record::ec_arg;
+  r.text1_ = ec.category().name();
+  r.ec_value_ = ec.value();
+  write_record(r);
 
   invoked_ = true;
 }
@@ -209,17 +275,12 @@ void handler_tracking::completion::invocation_begin(
 void handler_tracking::completion::invocation_begin(
     const asio::error_code& ec, std::size_t bytes_transferred)
 {
-  handler_tracking_timestamp timestamp;
-
-  write_line(
-#if defined(ASIO_WINDOWS)
-      "@asio|%I64u.%06I64u|>%I64u|ec=%.20s:%d,bytes_transferred=%I64u\n",
-#else // defined(ASIO_WINDOWS)
-      "@asio|%llu.%06llu|>%llu|ec=%.20s:%d,bytes_transferred=%llu\n",
-#endif // defined(ASIO_WINDOWS)
-      timestamp.seconds, timestamp.microseconds,
-      id_, ec.category().name(), ec.value(),
-      static_cast<uint64_t>(bytes_transferred));
+  record r(record::invocation_begin_kind, id_);
+  r.flag_ = record::ec_bytes_args;
+  r.text1_ = ec.category().name();
+  r.ec_value_ = ec.value();
+  r.value_ = static_cast<uint64_t>(bytes_transferred);
+  write_record(r);
 
   invoked_ = true;
 }
@@ -227,16 +288,12 @@ void handler_tracking::completion::invocation_begin(
 void handler_tracking::completion::invocation_begin(
     const asio::error_code& ec, int signal_number)
 {
-  handler_tracking_timestamp timestamp;
-
-  write_line(
-#if defined(ASIO_WINDOWS)
-      "@asio|%I64u.%06I64u|>%I64u|ec=%.20s:%d,signal_number=%d\n",
-#else // defined(ASIO_WINDOWS)
-      "@asio|%llu.%06llu|>%llu|ec=%.20s:%d,signal_number=%d\n",
-#endif // defined(ASIO_WINDOWS)
-      timestamp.seconds, timestamp.microseconds,
-      id_, ec.category().name(), ec.value(), signal_number);
+  record r(record::invocation_begin_kind, id_);
+  r.flag_ = record::ec_signal_args;
+  r.text1_ = ec.category().name();
+  r.ec_value_ = ec.value();
+  r.value_ = static_cast<uint64_t>(signal_number);
+  write_record(r);
 
   invoked_ = true;
 }
@@ -244,16 +301,12 @@ void handler_tracking::completion::invocation_begin(
 void handler_tracking::completion::invocation_begin(
     const asio::error_code& ec, const char* arg)
 {
-  handler_tracking_timestamp timestamp;
-
-  write_line(
-#if defined(ASIO_WINDOWS)
-      "@asio|%I64u.%06I64u|>%I64u|ec=%.20s:%d,%.50s\n",
-#else // defined(ASIO_WINDOWS)
-      "@asio|%llu.%06llu|>%llu|ec=%.20s:%d,%.50s\n",
-#endif // defined(ASIO_WINDOWS)
-      timestamp.seconds, timestamp.microseconds,
-      id_, ec.category().name(), ec.value(), arg);
+  record r(record::invocation_begin_kind, id_);
+  r.flag_ = record::ec_text_args;
+  r.text1_ = ec.category().name();
+  r.text2_ = arg;
+  r.ec_value_ = ec.value();
+  write_record(r);
 
   invoked_ = true;
 }
@@ -262,15 +315,8 @@ void handler_tracking::completion::invocation_end()
 {
   if (id_)
   {
-    handler_tracking_timestamp timestamp;
-
-    write_line(
-#if defined(ASIO_WINDOWS)
-        "@asio|%I64u.%06I64u|<%I64u|\n",
-#else // defined(ASIO_WINDOWS)
-        "@asio|%llu.%06llu|<%llu|\n",
-#endif // defined(ASIO_WINDOWS)
-        timestamp.seconds, timestamp.microseconds, id_);
+    record r(record::invocation_end_kind, id_);
+    write_record(r);
 
     id_ = 0;
   }
@@ -282,20 +328,15 @@ void handler_tracking::operation(execution_context&,
 {
   static tracking_state* state = get_state();
 
-  handler_tracking_timestamp timestamp;
+  record r(record::operation_kind);
 
-  unsigned long long current_id = 0;
   if (completion* current_completion = *state->current_completion_)
-    current_id = current_completion->id_;
+    r.other_id_ = current_completion->id_;
 
-  write_line(
-#if defined(ASIO_WINDOWS)
-      "@asio|%I64u.%06I64u|%I64u|%.20s@%p.%.50s\n",
-#else // defined(ASIO_WINDOWS)
-      "@asio|%llu.%06llu|%llu|%.20s@%p.%.50s\n",
-#endif // defined(ASIO_WINDOWS)
-      timestamp.seconds, timestamp.microseconds,
-      current_id, object_type, object, op_name);
+  r.text1_ = object_type;
+  r.text2_ = op_name;
+  r.object_ = object;
+  write_record(r);
 }
 
 void handler_tracking::reactor_registration(execution_context& /*context*/,
@@ -317,33 +358,24 @@ void handler_tracking::reactor_operation(
     const tracked_handler& h, const char* op_name,
     const asio::error_code& ec)
 {
-  handler_tracking_timestamp timestamp;
-
-  write_line(
-#if defined(ASIO_WINDOWS)
-      "@asio|%I64u.%06I64u|.%I64u|%s,ec=%.20s:%d\n",
-#else // defined(ASIO_WINDOWS)
-      "@asio|%llu.%06llu|.%llu|%s,ec=%.20s:%d\n",
-#endif // defined(ASIO_WINDOWS)
-      timestamp.seconds, timestamp.microseconds,
-      h.id_, op_name, ec.category().name(), ec.value());
+  record r(record::reactor_operation_kind, h.id_);
+  r.text1_ = op_name;
+  r.text2_ = ec.category().name();
+  r.ec_value_ = ec.value();
+  write_record(r);
 }
 
 void handler_tracking::reactor_operation(
     const tracked_handler& h, const char* op_name,
     const asio::error_code& ec, std::size_t bytes_transferred)
 {
-  handler_tracking_timestamp timestamp;
-
-  write_line(
-#if defined(ASIO_WINDOWS)
-      "@asio|%I64u.%06I64u|.%I64u|%s,ec=%.20s:%d,bytes_transferred=%I64u\n",
-#else // defined(ASIO_WINDOWS)
-      "@asio|%llu.%06llu|.%llu|%s,ec=%.20s:%d,bytes_transferred=%llu\n",
-#endif // defined(ASIO_WINDOWS)
-      timestamp.seconds, timestamp.microseconds,
-      h.id_, op_name, ec.category().name(), ec.value(),
-      static_cast<uint64_t>(bytes_transferred));
+  record r(record::reactor_operation_kind, h.id_);
+  r.flag_ = 1;
+  r.text1_ = op_name;
+  r.text2_ = ec.category().name();
+  r.ec_value_ = ec.value();
+  r.value_ = static_cast<uint64_t>(bytes_transferred);
+  write_record(r);
 }
 
 void handler_tracking::write_line(const char* format, ...)
@@ -364,6 +396,280 @@ void handler_tracking::write_line(const char* format, ...)
 
   va_end(args);
 
+  if (length >= static_cast<int>(sizeof(line)))
+    length = static_cast<int>(sizeof(line)) - 1;
+  if (length > 0)
+    write_output(line, static_cast<std::size_t>(length), 0);
+}
+
+int handler_tracking::format_line(char* line,
+    std::size_t size, const char* format, ...)
+{
+  using namespace std; // For sprintf (or equivalent).
+
+  va_list args;
+  va_start(args, format);
+
+#if defined(ASIO_HAS_SNPRINTF)
+  int length = vsnprintf(line, size, format, args);
+#elif defined(ASIO_HAS_SECURE_RTL)
+  int length = vsprintf_s(line, size, format, args);
+#else // defined(ASIO_HAS_SECURE_RTL)
+  (void)size;
+  int length = vsprintf(line, format, args);
+#endif // defined(ASIO_HAS_SECURE_RTL)
+
+  va_end(args);
+
+  // Report the length of the (possibly truncated) line.
+  if (length >= static_cast<int>(size))
+    length = static_cast<int>(size) - 1;
+  return length;
+}
+
+#if defined(ASIO_ENABLE_BUFFERED_HANDLER_TRACKING)
+
+void handler_tracking::write_record(const record& r)
+{
+  static tracking_state* state = get_state();
+
+  record_buffer* buffer = *state->current_buffer_;
+  if (!buffer)
+  {
+    static_mutex::scoped_lock lock(state->mutex_);
+    buffer = new record_buffer(state->buffers_);
+    state->buffers_ = buffer;
+    *state->current_buffer_ = buffer;
+  }
+
+  std::size_t head = buffer->head_.load(std::memory_order_relaxed);
+  std::size_t tail = buffer->tail_.load(std::memory_order_acquire);
+  if (head - tail < record_buffer::capacity)
+  {
+    buffer->records_[head % record_buffer::capacity] = r;
+    buffer->head_.store(head + 1, std::memory_order_release);
+  }
+  else
+  {
+    buffer->dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+std::size_t handler_tracking::drain(drain_function f, void* arg)
+{
+  static tracking_state* state = get_state();
+
+  static_mutex::scoped_lock drain_lock(state->drain_mutex_);
+
+  static_mutex::scoped_lock lock(state->mutex_);
+  record_buffer* buffers = state->buffers_;
+  lock.unlock();
+
+  // Take the records from every buffer. Each buffer is already in timestamp
+  // order, so a stable sort interleaves the threads without reordering the
+  // records of any one thread.
+  std::vector<record> records;
+  uint64_t dropped = 0;
+  for (record_buffer* b = buffers; b; b = b->next_)
+  {
+    std::size_t tail = b->tail_.load(std::memory_order_relaxed);
+    std::size_t head = b->head_.load(std::memory_order_acquire);
+    for (std::size_t i = tail; i != head; ++i)
+      records.push_back(b->records_[i % record_buffer::capacity]);
+    b->tail_.store(head, std::memory_order_release);
+    dropped += b->dropped_.exchange(0, std::memory_order_relaxed);
+  }
+
+  struct compare
+  {
+    bool operator()(const record& a, const record& b) const
+    {
+      return a.time_ < b.time_;
+    }
+  };
+  std::stable_sort(records.begin(), records.end(), compare());
+
+  char line[256] = "";
+  if (dropped > 0)
+  {
+    int length = format_line(line, sizeof(line),
+#if defined(ASIO_WINDOWS)
+        "# asio: %I64u handler tracking records dropped\n",
+#else // defined(ASIO_WINDOWS)
+        "# asio: %llu handler tracking records dropped\n",
+#endif // defined(ASIO_WINDOWS)
+        dropped);
+    if (length > 0)
+      f(line, static_cast<std::size_t>(length), arg);
+  }
+
+  for (std::size_t i = 0; i < records.size(); ++i)
+  {
+    int length = format_record(records[i], line, sizeof(line));
+    if (length > 0)
+      f(line, static_cast<std::size_t>(length), arg);
+  }
+
+  return records.size();
+}
+
+#else // defined(ASIO_ENABLE_BUFFERED_HANDLER_TRACKING)
+
+void handler_tracking::write_record(const record& r)
+{
+  char line[256] = "";
+  int length = format_record(r, line, sizeof(line));
+  if (length > 0)
+    write_output(line, static_cast<std::size_t>(length), 0);
+}
+
+std::size_t handler_tracking::drain(drain_function, void*)
+{
+  return 0;
+}
+
+#endif // defined(ASIO_ENABLE_BUFFERED_HANDLER_TRACKING)
+
+std::size_t handler_tracking::drain()
+{
+  return drain(&handler_tracking::write_output, 0);
+}
+
+int handler_tracking::format_record(const record& r,
+    char* line, std::size_t size)
+{
+  uint64_t seconds = r.time_ / 1000000;
+  uint64_t microseconds = r.time_ % 1000000;
+
+  switch (r.kind_)
+  {
+  case record::creation_location_kind:
+    return format_line(line, size,
+#if defined(ASIO_WINDOWS)
+        "@asio|%I64u.%06I64u|%I64u^%I64u|%s%s%.80s%s(%.80s:%d)\n",
+#else // defined(ASIO_WINDOWS)
+        "@asio|%llu.%06llu|%llu^%llu|%s%s%.80s%s(%.80s:%d)\n",
+#endif // defined(ASIO_WINDOWS)
+        seconds, microseconds, r.other_id_, r.id_,
+        r.flag_ ? "in " : "called from ",
+        r.text2_ ? "'" : "", r.text2_ ? r.text2_ : "", r.text2_ ? "' " : "",
+        r.text1_, static_cast<int>(r.value_));
+
+  case record::creation_kind:
+    return format_line(line, size,
+#if defined(ASIO_WINDOWS)
+        "@asio|%I64u.%06I64u|%I64u*%I64u|%.20s@%p.%.50s\n",
+#else // defined(ASIO_WINDOWS)
+        "@asio|%llu.%06llu|%llu*%llu|%.20s@%p.%.50s\n",
+#endif // defined(ASIO_WINDOWS)
+        seconds, microseconds, r.other_id_, r.id_,
+        r.text1_, r.object_, r.text2_);
+
+  case record::completion_kind:
+    return format_line(line, size,
+#if defined(ASIO_WINDOWS)
+        "@asio|%I64u.%06I64u|%c%I64u|\n",
+#else // defined(ASIO_WINDOWS)
+        "@asio|%llu.%06llu|%c%llu|\n",
+#endif // defined(ASIO_WINDOWS)
+        seconds, microseconds, r.flag_ ? '!' : '~', r.id_);
+
+  case record::invocation_begin_kind:
+    switch (r.flag_)
+    {
+    case record::ec_arg:
+      return format_line(line, size,
+#if defined(ASIO_WINDOWS)
+          "@asio|%I64u.%06I64u|>%I64u|ec=%.20s:%d\n",
+#else // defined(ASIO_WINDOWS)
+          "@asio|%llu.%06llu|>%llu|ec=%.20s:%d\n",
+#endif // defined(ASIO_WINDOWS)
+          seconds, microseconds, r.id_, r.text1_, r.ec_value_);
+
+    case record::ec_bytes_args:
+      return format_line(line, size,
+#if defined(ASIO_WINDOWS)
+          "@asio|%I64u.%06I64u|>%I64u|ec=%.20s:%d,bytes_transferred=%I64u\n",
+#else // defined(ASIO_WINDOWS)
+          "@asio|%llu.%06llu|>%llu|ec=%.20s:%d,bytes_transferred=%llu\n",
+#endif // defined(ASIO_WINDOWS)
+          seconds, microseconds, r.id_, r.text1_, r.ec_value_, r.value_);
+
+    case record::ec_signal_args:
+      return format_line(line, size,
+#if defined(ASIO_WINDOWS)
+          "@asio|%I64u.%06I64u|>%I64u|ec=%.20s:%d,signal_number=%d\n",
+#else // defined(ASIO_WINDOWS)
+          "@asio|%llu.%06llu|>%llu|ec=%.20s:%d,signal_number=%d\n",
+#endif // defined(ASIO_WINDOWS)
+          seconds, microseconds, r.id_, r.text1_, r.ec_value_,
+          static_cast<int>(r.value_));
+
+    case record::ec_text_args:
+      return format_line(line, size,
+#if defined(ASIO_WINDOWS)
+          "@asio|%I64u.%06I64u|>%I64u|ec=%.20s:%d,%.50s\n",
+#else // defined(ASIO_WINDOWS)
+          "@asio|%llu.%06llu|>%llu|ec=%.20s:%d,%.50s\n",
+#endif // defined(ASIO_WINDOWS)
+          seconds, microseconds, r.id_, r.text1_, r.ec_value_, r.text2_);
+
+    default:
+      return format_line(line, size,
+#if defined(ASIO_WINDOWS)
+          "@asio|%I64u.%06I64u|>%I64u|\n",
+#else // defined(ASIO_WINDOWS)
+          "@asio|%llu.%06llu|>%llu|\n",
+#endif // defined(ASIO_WINDOWS)
+          seconds, microseconds, r.id_);
+    }
+
+  case record::invocation_end_kind:
+    return format_line(line, size,
+#if defined(ASIO_WINDOWS)
+        "@asio|%I64u.%06I64u|<%I64u|\n",
+#else // defined(ASIO_WINDOWS)
+        "@asio|%llu.%06llu|<%llu|\n",
+#endif // defined(ASIO_WINDOWS)
+        seconds, microseconds, r.id_);
+
+  case record::operation_kind:
+    return format_line(line, size,
+#if defined(ASIO_WINDOWS)
+        "@asio|%I64u.%06I64u|%I64u|%.20s@%p.%.50s\n",
+#else // defined(ASIO_WINDOWS)
+        "@asio|%llu.%06llu|%llu|%.20s@%p.%.50s\n",
+#endif // defined(ASIO_WINDOWS)
+        seconds, microseconds, r.other_id_, r.text1_, r.object_, r.text2_);
+
+  case record::reactor_operation_kind:
+    if (r.flag_)
+    {
+      return format_line(line, size,
+#if defined(ASIO_WINDOWS)
+          "@asio|%I64u.%06I64u|.%I64u|%s,ec=%.20s:%d,bytes_transferred=%I64u\n",
+#else // defined(ASIO_WINDOWS)
+          "@asio|%llu.%06llu|.%llu|%s,ec=%.20s:%d,bytes_transferred=%llu\n",
+#endif // defined(ASIO_WINDOWS)
+          seconds, microseconds, r.id_, r.text1_,
+          r.text2_, r.ec_value_, r.value_);
+    }
+    return format_line(line, size,
+#if defined(ASIO_WINDOWS)
+        "@asio|%I64u.%06I64u|.%I64u|%s,ec=%.20s:%d\n",
+#else // defined(ASIO_WINDOWS)
+        "@asio|%llu.%06llu|.%llu|%s,ec=%.20s:%d\n",
+#endif // defined(ASIO_WINDOWS)
+        seconds, microseconds, r.id_, r.text1_, r.text2_, r.ec_value_);
+
+  default:
+    return 0;
+  }
+}
+
+void handler_tracking::write_output(const char* line,
+    std::size_t length, void* /*arg*/)
+{
 #if defined(ASIO_WINDOWS_RUNTIME)
   wchar_t wline[256] = L"";
   mbstowcs_s(0, wline, sizeof(wline) / sizeof(wchar_t), line, length);
@@ -371,7 +677,8 @@ void handler_tracking::write_line(const char* format, ...)
 #elif defined(ASIO_WINDOWS)
   HANDLE stderr_handle = ::GetStdHandle(STD_ERROR_HANDLE);
   DWORD bytes_written = 0;
-  ::WriteFile(stderr_handle, line, length, &bytes_written, 0);
+  ::WriteFile(stderr_handle, line, static_cast<DWORD>(length),
+      &bytes_written, 0);
 #else // defined(ASIO_WINDOWS)
   ::write(STDERR_FILENO, line, length);
 #endif // defined(ASIO_WINDOWS)
@@ -0,0 +1,258 @@
+//
+// detail/impl/huge_page_arena.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_HUGE_PAGE_ARENA_IPP
+#define ASIO_DETAIL_IMPL_HUGE_PAGE_ARENA_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_HUGE_PAGES)
+
+#include <cstdlib>
+#include <new>
+#include <sys/mman.h>
+#include "asio/detail/huge_page_arena.hpp"
+#include "asio/detail/static_mutex.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+huge_page_arena* huge_page_arena::get(int mode)
+{
+  static_assert(ASIO_HUGE_PAGE_ARENA_SIZE % (std::size_t(1) << 30) == 0,
+      "ASIO_HUGE_PAGE_ARENA_SIZE must be a multiple of 1GB");
+
+  if (mode < transparent || mode > explicit_1gb)
+    return 0;
+
+  static static_mutex mutex = ASIO_STATIC_MUTEX_INIT;
+  mutex.init();
+  static_mutex::scoped_lock lock(mutex);
+
+  huge_page_arena** arenas = all_arenas();
+  if (!arenas[mode - 1])
+  {
+    uintptr_t region = region_base().load(std::memory_order_relaxed);
+    if (region == 0)
+    {
+      // Reserve the address space for all arenas, aligned so that each arena
+      // may be committed using the largest pages.
+      std::size_t size = num_modes * ASIO_HUGE_PAGE_ARENA_SIZE
+        + static_cast<std::size_t>(page_size_1gb);
+      int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#if defined(MAP_NORESERVE)
+      flags |= MAP_NORESERVE;
+#endif // defined(MAP_NORESERVE)
+      void* p = ::mmap(0, size, PROT_NONE, flags, -1, 0);
+      if (p == MAP_FAILED)
+        return 0;
+      region = (reinterpret_cast<uintptr_t>(p) + page_size_1gb - 1)
+        & ~static_cast<uintptr_t>(page_size_1gb - 1);
+      region_base().store(region, std::memory_order_release);
+    }
+
+    unsigned char* base = reinterpret_cast<unsigned char*>(region)
+      + (mode - 1) * ASIO_HUGE_PAGE_ARENA_SIZE;
+    huge_page_arena* a = new (std::nothrow) huge_page_arena(mode, base);
+    if (a && !a->unit_sizes_)
+    {
+      delete a;
+      a = 0;
+    }
+    arenas[mode - 1] = a;
+  }
+
+  return arenas[mode - 1];
+}
+
+void* huge_page_arena::allocate(std::size_t size)
+{
+  std::size_t rounded = size == 0 ? static_cast<std::size_t>(alignment)
+    : (size + alignment - 1) / alignment * alignment;
+
+  mutex::scoped_lock lock(mutex_);
+
+  if (rounded <= max_small_size)
+  {
+    bin& b = bins_[rounded / alignment - 1];
+    if (void* p = b.free_)
+    {
+      b.free_ = *static_cast<void**>(p);
+      return p;
+    }
+
+    if (!b.next_ || static_cast<std::size_t>(b.end_ - b.next_) < rounded)
+    {
+      // Take enough units for a batch of blocks of this size.
+      std::size_t count = (rounded * 16 + unit_size - 1) / unit_size;
+      unsigned char* run = take_units(count, rounded);
+      if (!run)
+        return 0;
+      b.next_ = run;
+      b.end_ = run + count * unit_size;
+    }
+
+    void* p = b.next_;
+    b.next_ += rounded;
+    return p;
+  }
+
+  rounded = (size + unit_size - 1) / unit_size * unit_size;
+  std::multimap<std::size_t, void*>::iterator i = large_.find(rounded);
+  if (i != large_.end())
+  {
+    void* p = i->second;
+    large_.erase(i);
+    return p;
+  }
+
+  return take_units(rounded / unit_size, rounded);
+}
+
+void huge_page_arena::deallocate(void* p)
+{
+  uintptr_t offset = reinterpret_cast<uintptr_t>(p)
+    - region_base().load(std::memory_order_relaxed);
+  huge_page_arena* a = all_arenas()[offset / ASIO_HUGE_PAGE_ARENA_SIZE];
+
+  std::size_t unit = (static_cast<unsigned char*>(p) - a->base_) / unit_size;
+  std::size_t size = static_cast<std::size_t>(
+      a->unit_sizes_[unit]) * alignment;
+
+  mutex::scoped_lock lock(a->mutex_);
+  if (size <= max_small_size)
+  {
+    bin& b = a->bins_[size / alignment - 1];
+    *static_cast<void**>(p) = b.free_;
+    b.free_ = p;
+  }
+  else
+  {
+    a->large_.insert(std::make_pair(size, p));
+  }
+}
+
+huge_page_arena::huge_page_arena(int mode, unsigned char* base)
+  : mode_(mode),
+    page_size_(mode == explicit_1gb
+        ? static_cast<std::size_t>(page_size_1gb)
+        : static_cast<std::size_t>(page_size_2mb)),
+    base_(base),
+    unused_(base),
+    committed_(base),
+    failed_(false),
+    unit_sizes_(static_cast<uint32_t*>(std::calloc(
+            ASIO_HUGE_PAGE_ARENA_SIZE / unit_size, sizeof(uint32_t))))
+{
+  for (int i = 0; i < num_bins; ++i)
+  {
+    bins_[i].free_ = 0;
+    bins_[i].next_ = 0;
+    bins_[i].end_ = 0;
+  }
+}
+
+huge_page_arena::~huge_page_arena()
+{
+  std::free(unit_sizes_);
+}
+
+bool huge_page_arena::commit(unsigned char* end)
+{
+  if (failed_)
+    return false;
+
+  std::size_t size = (static_cast<std::size_t>(end - committed_)
+      + page_size_ - 1) / page_size_ * page_size_;
+  if (static_cast<std::size_t>(base_ + ASIO_HUGE_PAGE_ARENA_SIZE
+        - committed_) < size)
+    return false;
+
+  if (mode_ == transparent)
+  {
+    if (::mprotect(committed_, size, PROT_READ | PROT_WRITE) != 0)
+    {
+      failed_ = true;
+      return false;
+    }
+#if defined(MADV_HUGEPAGE)
+    ::madvise(committed_, size, MADV_HUGEPAGE);
+#endif // defined(MADV_HUGEPAGE)
+  }
+  else
+  {
+#if defined(MAP_HUGETLB)
+# if !defined(MAP_HUGE_SHIFT)
+#  define MAP_HUGE_SHIFT 26
+# endif // !defined(MAP_HUGE_SHIFT)
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_HUGETLB
+      | ((mode_ == explicit_1gb ? 30 : 21) << MAP_HUGE_SHIFT);
+    if (::mmap(committed_, size, PROT_READ | PROT_WRITE,
+          flags, -1, 0) == MAP_FAILED)
+    {
+      // A failed fixed mapping may remove the reservation, which must be
+      // restored so that no other mapping is placed in the arena.
+      int reserve_flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED;
+# if defined(MAP_NORESERVE)
+      reserve_flags |= MAP_NORESERVE;
+# endif // defined(MAP_NORESERVE)
+      ::mmap(committed_, size, PROT_NONE, reserve_flags, -1, 0);
+      failed_ = true;
+      return false;
+    }
+#else // defined(MAP_HUGETLB)
+    failed_ = true;
+    return false;
+#endif // defined(MAP_HUGETLB)
+  }
+
+  committed_ += size;
+  return true;
+}
+
+unsigned char* huge_page_arena::take_units(
+    std::size_t count, std::size_t block_size)
+{
+  std::size_t size = count * unit_size;
+  if (static_cast<std::size_t>(base_ + ASIO_HUGE_PAGE_ARENA_SIZE
+        - unused_) < size)
+    return 0;
+
+  if (unused_ + size > committed_ && !commit(unused_ + size))
+    return 0;
+
+  unsigned char* run = unused_;
+  std::size_t first = (run - base_) / unit_size;
+  for (std::size_t i = 0; i < count; ++i)
+    unit_sizes_[first + i] = static_cast<uint32_t>(block_size / alignment);
+  unused_ += size;
+  return run;
+}
+
+huge_page_arena** huge_page_arena::all_arenas()
+{
+  static huge_page_arena* arenas[num_modes] = { 0, 0, 0 };
+  return arenas;
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_HUGE_PAGES)
+
+#endif // ASIO_DETAIL_IMPL_HUGE_PAGE_ARENA_IPP
@@ -61,6 +61,7 @@ void io_uring_service::schedule_timer(
 
   bool earliest = queue.enqueue_timer(time, timer, op);
   scheduler_.work_started();
+  record_pending_timers();
   if (earliest)
   {
     update_timeout();
@@ -77,6 +78,7 @@ std::size_t io_uring_service::cancel_timer(
   mutex::scoped_lock lock(mutex_);
   op_queue<operation> ops;
   std::size_t n = queue.cancel_timer(timer, ops, max_cancelled);
+  record_pending_timers();
   lock.unlock();
   scheduler_.post_deferred_completions(ops);
   return n;
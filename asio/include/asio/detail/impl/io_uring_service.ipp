@@ -19,12 +19,17 @@
 
 #if defined(ASIO_HAS_IO_URING)
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <sys/eventfd.h>
 #include "asio/detail/io_uring_service.hpp"
 #include "asio/detail/reactor_op.hpp"
 #include "asio/detail/scheduler.hpp"
+#include "asio/detail/scheduler_thread_info.hpp"
+#include "asio/detail/thread_context.hpp"
 #include "asio/detail/throw_error.hpp"
+#include "asio/detail/usdt_probes.hpp"
 #include "asio/error.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -38,6 +43,7 @@ io_uring_service::io_uring_service(asio::execution_context& ctx)
     mutex_(config(ctx).get("reactor", "registration_locking", true),
         config(ctx).get("reactor", "registration_locking_spin_count", 0)),
     outstanding_work_(0),
+    outstanding_batch_ops_(0),
     submit_sqes_op_(this),
     pending_sqes_(0),
     pending_submit_sqes_op_(false),
@@ -45,17 +51,35 @@ io_uring_service::io_uring_service(asio::execution_context& ctx)
     io_locking_(config(ctx).get("reactor", "io_locking", true)),
     io_locking_spin_count_(
         config(ctx).get("reactor", "io_locking_spin_count", 0)),
+    sqpoll_(config(ctx).get("io_uring", "sqpoll", false)),
+    sqpoll_cpu_(config(ctx).get("io_uring", "sqpoll_cpu", -1)),
+    sqpoll_idle_(config(ctx).get("io_uring", "sqpoll_idle", 0U)),
+    single_issuer_(config(ctx).get("io_uring", "single_issuer", false)),
+    defer_taskrun_(config(ctx).get("io_uring", "defer_taskrun", false)),
+    registered_files_(config(ctx).get("io_uring", "registered_files", 0U)),
+    ring_size_(get_ring_size(ctx)),
+    submit_batch_size_(config(ctx).get("io_uring", "submit_batch_size", 128)),
+    complete_batch_size_((std::max)(1,
+          config(ctx).get("io_uring", "complete_batch_size", 128))),
+    concurrent_reaping_(!defer_taskrun_
+        && config(ctx).get("io_uring", "concurrent_reaping", false)),
+    completion_mutex_(concurrent_reaping_),
+    adaptive_submit_(config(ctx).get("io_uring", "adaptive_submit", false)),
+    msg_ring_wakeups_(config(ctx).get("io_uring", "msg_ring_wakeups", true)),
+    capabilities_(0),
     timeout_(),
     registration_mutex_(mutex_.enabled()),
     registered_io_objects_(execution_context::allocator<void>(ctx),
         config(ctx).get("reactor", "preallocated_io_objects", 0U),
         io_locking_, io_locking_spin_count_),
+    next_registered_file_(0),
     reactor_(use_service<reactor>(ctx)),
     reactor_data_(),
     event_fd_(-1)
 {
   reactor_.init_task();
   init_ring();
+  init_registered_files();
   register_with_reactor();
 }
 
@@ -76,19 +100,24 @@ void io_uring_service::shutdown()
   op_queue<operation> ops;
 
   // Cancel all outstanding operations.
-  while (io_object* io_obj = registered_io_objects_.first())
+  io_object* io_obj = registered_io_objects_.first();
+  while (io_obj)
   {
     for (int i = 0; i < max_ops; ++i)
     {
-      if (!io_obj->queues_[i].op_queue_.empty())
+      if (!io_obj->queues_[i].op_queue_.empty()
+          || io_obj->queues_[i].multishot_)
       {
         ops.push(io_obj->queues_[i].op_queue_);
         if (::io_uring_sqe* sqe = get_sqe())
-          ::io_uring_prep_cancel(sqe, &io_obj->queues_[i], 0);
+          ::io_uring_prep_cancel(sqe, io_obj->queues_[i].user_data(), 0);
       }
+      io_obj->queues_[i].discard_multishot_results();
     }
     io_obj->shutdown_ = true;
+    io_object* next_io_obj = registered_io_objects_.next(io_obj);
     registered_io_objects_.free(io_obj);
+    io_obj = next_io_obj;
   }
 
   // Cancel the timeout operation.
@@ -104,6 +133,19 @@ void io_uring_service::shutdown()
       break;
   }
 
+  // Batch operations are not held in any I/O queue, so their entries must
+  // finish before the operations can be abandoned.
+  while (outstanding_batch_ops_ > 0)
+  {
+    ::io_uring_cqe* cqe = 0;
+    if (::io_uring_wait_cqe(&ring_, &cqe) != 0)
+      break;
+    void* ptr = ::io_uring_cqe_get_data(cqe);
+    if ((reinterpret_cast<std::uintptr_t>(ptr) & 2) != 0)
+      dispatch_cqe(ptr, cqe, ops);
+    ::io_uring_cqe_seen(&ring_, cqe);
+  }
+
   timer_queues_.get_all_timers(ops);
 
   scheduler_.abandon_operations(ops);
@@ -120,17 +162,18 @@ void io_uring_service::notify_fork(
       // after the fork completes.
       mutex::scoped_lock registration_lock(registration_mutex_);
       for (io_object* io_obj = registered_io_objects_.first();
-          io_obj != 0; io_obj = io_obj->next_)
+          io_obj != 0; io_obj = registered_io_objects_.next(io_obj))
       {
         mutex::scoped_lock io_object_lock(io_obj->mutex_);
         for (int i = 0; i < max_ops; ++i)
         {
-          if (!io_obj->queues_[i].op_queue_.empty()
+          if ((!io_obj->queues_[i].op_queue_.empty()
+                || io_obj->queues_[i].multishot_)
               && !io_obj->queues_[i].cancel_requested_)
           {
             mutex::scoped_lock lock(mutex_);
             if (::io_uring_sqe* sqe = get_sqe())
-              ::io_uring_prep_cancel(sqe, &io_obj->queues_[i], 0);
+              ::io_uring_prep_cancel(sqe, io_obj->queues_[i].user_data(), 0);
           }
         }
       }
@@ -148,20 +191,17 @@ void io_uring_service::notify_fork(
       // completed, or were explicitly cancelled. All others will be
       // automatically restarted.
       op_queue<operation> ops;
-      for (; outstanding_work_ > 0; --outstanding_work_)
+      while (outstanding_work_ > 0)
       {
         ::io_uring_cqe* cqe = 0;
         if (::io_uring_wait_cqe(&ring_, &cqe) != 0)
           break;
+        if ((cqe->flags & IORING_CQE_F_MORE) == 0)
+          --outstanding_work_;
         if (void* ptr = ::io_uring_cqe_get_data(cqe))
-        {
           if (ptr != this && ptr != &timer_queues_ && ptr != &timeout_)
-          {
-            io_queue* io_q = static_cast<io_queue*>(ptr);
-            io_q->set_result(cqe->res);
-            ops.push(io_q);
-          }
-        }
+            dispatch_cqe(ptr, cqe, ops);
+        ::io_uring_cqe_seen(&ring_, cqe);
       }
       scheduler_.post_deferred_completions(ops);
 
@@ -181,6 +221,7 @@ void io_uring_service::notify_fork(
       // The child process gets a new io_uring instance.
       ::io_uring_queue_exit(&ring_);
       init_ring();
+      init_registered_files();
       register_with_reactor();
     }
     break;
@@ -203,10 +244,14 @@ void io_uring_service::register_io_object(
 
   io_obj->service_ = this;
   io_obj->shutdown_ = false;
+  io_obj->descriptor_ = -1;
+  io_obj->registered_file_ = -1;
   for (int i = 0; i < max_ops; ++i)
   {
     io_obj->queues_[i].io_object_ = io_obj;
     io_obj->queues_[i].cancel_requested_ = false;
+    io_obj->queues_[i].multishot_ = false;
+    io_obj->queues_[i].multishot_posted_ = false;
   }
 }
 
@@ -220,19 +265,22 @@ void io_uring_service::register_internal_io_object(
 
   io_obj->service_ = this;
   io_obj->shutdown_ = false;
+  io_obj->descriptor_ = -1;
+  io_obj->registered_file_ = -1;
   for (int i = 0; i < max_ops; ++i)
   {
     io_obj->queues_[i].io_object_ = io_obj;
     io_obj->queues_[i].cancel_requested_ = false;
+    io_obj->queues_[i].multishot_ = false;
+    io_obj->queues_[i].multishot_posted_ = false;
   }
 
   io_obj->queues_[op_type].op_queue_.push(op);
   io_object_lock.unlock();
   mutex::scoped_lock lock(mutex_);
-  if (::io_uring_sqe* sqe = get_sqe())
+  if (::io_uring_sqe* sqe = get_sqe(op))
   {
-    op->prepare(sqe);
-    ::io_uring_sqe_set_data(sqe, &io_obj->queues_[op_type]);
+    prepare_op(&io_obj->queues_[op_type], op, sqe);
     post_submit_sqes_op(lock);
   }
   else
@@ -243,6 +291,46 @@ void io_uring_service::register_internal_io_object(
   }
 }
 
+void io_uring_service::register_file(
+    io_uring_service::per_io_object_data& io_obj, int descriptor)
+{
+  if (!io_obj || registered_files_ == 0)
+    return;
+
+  // Allocate an entry in the registered file table. If the table is full, the
+  // descriptor is used directly.
+  int registered_file = -1;
+  {
+    mutex::scoped_lock registration_lock(registration_mutex_);
+    if (!free_registered_files_.empty())
+    {
+      registered_file = free_registered_files_.back();
+      free_registered_files_.pop_back();
+    }
+    else if (next_registered_file_ < registered_files_)
+    {
+      registered_file = static_cast<int>(next_registered_file_++);
+    }
+    else
+    {
+      return;
+    }
+  }
+
+  int result = ::io_uring_register_files_update(&ring_,
+      static_cast<unsigned>(registered_file), &descriptor, 1);
+  if (result < 0)
+  {
+    mutex::scoped_lock registration_lock(registration_mutex_);
+    free_registered_files_.push_back(registered_file);
+    return;
+  }
+
+  mutex::scoped_lock io_object_lock(io_obj->mutex_);
+  io_obj->descriptor_ = descriptor;
+  io_obj->registered_file_ = registered_file;
+}
+
 void io_uring_service::register_buffers(const ::iovec* v, unsigned n)
 {
   int result = ::io_uring_register_buffers(&ring_, v, n);
@@ -254,15 +342,69 @@ void io_uring_service::register_buffers(const ::iovec* v, unsigned n)
   }
 }
 
+void io_uring_service::register_buffers_sparse(unsigned n)
+{
+  int result = ::io_uring_register_buffers_sparse(&ring_, n);
+  if (result < 0)
+  {
+    asio::error_code ec(-result,
+        asio::error::get_system_category());
+    asio::detail::throw_error(ec, "io_uring_register_buffers_sparse");
+  }
+}
+
+asio::error_code io_uring_service::update_buffers(unsigned offset,
+    const ::iovec* v, unsigned n, asio::error_code& ec)
+{
+  // The kernel keeps a replaced buffer mapped until the operations that are
+  // using it have completed.
+  int result = ::io_uring_register_buffers_update_tag(
+      &ring_, offset, v, 0, n);
+  if (result < 0)
+    ec.assign(-result, asio::error::get_system_category());
+  else
+    ec.assign(0, ec.category());
+  return ec;
+}
+
 void io_uring_service::unregister_buffers()
 {
   (void)::io_uring_unregister_buffers(&ring_);
 }
 
+::io_uring_buf_ring* io_uring_service::register_buffer_ring(
+    unsigned entries, int group_id)
+{
+  if ((capabilities_ & buffer_ring_capability) == 0)
+  {
+    asio::detail::throw_error(
+        asio::error::operation_not_supported, "io_uring_setup_buf_ring");
+  }
+
+  int result = 0;
+  ::io_uring_buf_ring* buf_ring =
+    ::io_uring_setup_buf_ring(&ring_, entries, group_id, 0, &result);
+  if (buf_ring == 0)
+  {
+    asio::error_code ec(-result,
+        asio::error::get_system_category());
+    asio::detail::throw_error(ec, "io_uring_setup_buf_ring");
+  }
+  return buf_ring;
+}
+
+void io_uring_service::unregister_buffer_ring(
+    ::io_uring_buf_ring* buf_ring, unsigned entries, int group_id)
+{
+  (void)::io_uring_free_buf_ring(&ring_, buf_ring, entries, group_id);
+}
+
 void io_uring_service::start_op(int op_type,
     io_uring_service::per_io_object_data& io_obj,
     io_uring_operation* op, bool is_continuation)
 {
+  ASIO_USDT_PROBE3(op_start, op, io_obj, op_type);
+
   if (!io_obj)
   {
     op->ec_ = asio::error::bad_descriptor;
@@ -279,30 +421,60 @@ void io_uring_service::start_op(int op_type,
     return;
   }
 
-  if (io_obj->queues_[op_type].op_queue_.empty())
+  io_queue& io_q = io_obj->queues_[op_type];
+  if (io_q.multishot_ || io_q.multishot_posted_
+      || !io_q.multishot_results_.empty())
+  {
+    if (op->has_link_timeout_)
+    {
+      // The operation would have no submission of its own to which the
+      // timeout could be linked. Callers use joins_multishot() to arrange for
+      // the timeout to be applied by other means before starting the
+      // operation, so this is reached only if a multishot submission was
+      // started concurrently.
+      io_object_lock.unlock();
+      op->ec_ = asio::error::operation_not_supported;
+      post_immediate_completion(op, is_continuation);
+      return;
+    }
+
+    // A multishot submission is outstanding, or its results are waiting to be
+    // delivered. The operation receives the next result in turn.
+    io_q.op_queue_.push(op);
+    scheduler_.work_started();
+    if (!io_q.multishot_results_.empty() && !io_q.multishot_posted_)
+    {
+      io_q.multishot_posted_ = true;
+      io_object_lock.unlock();
+      scheduler_.post_deferred_completion(&io_q);
+    }
+  }
+  else if (io_q.op_queue_.empty())
   {
     if (op->perform(false))
     {
+      ASIO_USDT_PROBE3(op_complete, op,
+          op->ec_.value(), op->bytes_transferred_);
       io_object_lock.unlock();
       scheduler_.post_immediate_completion(op, is_continuation);
     }
     else
     {
-      io_obj->queues_[op_type].op_queue_.push(op);
-      io_object_lock.unlock();
+      io_q.op_queue_.push(op);
       mutex::scoped_lock lock(mutex_);
-      if (::io_uring_sqe* sqe = get_sqe())
+      if (::io_uring_sqe* sqe = get_sqe(op))
       {
-        op->prepare(sqe);
-        ::io_uring_sqe_set_data(sqe, &io_obj->queues_[op_type]);
+        prepare_op(&io_q, op, sqe);
+        io_object_lock.unlock();
         scheduler_.work_started();
         post_submit_sqes_op(lock);
       }
       else
       {
         lock.unlock();
-        io_obj->queues_[op_type].set_result(-ENOBUFS);
-        post_immediate_completion(&io_obj->queues_[op_type], is_continuation);
+        io_object_lock.unlock();
+        io_q.set_result(-ENOBUFS);
+        post_immediate_completion(&io_q, is_continuation);
       }
     }
   }
@@ -313,6 +485,56 @@ void io_uring_service::start_op(int op_type,
   }
 }
 
+void io_uring_service::start_batch_op(
+    io_uring_service::per_io_object_data& io_obj,
+    io_uring_batch_operation* op, bool is_continuation)
+{
+  if (!io_obj)
+  {
+    op->ec_ = asio::error::bad_descriptor;
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  mutex::scoped_lock io_object_lock(io_obj->mutex_);
+
+  if (io_obj->shutdown_ || op->size_ == 0)
+  {
+    io_object_lock.unlock();
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  prepare_batch_op(io_obj, op);
+  io_object_lock.unlock();
+  finish_batch_op(op);
+}
+
+void io_uring_service::start_batch_op(
+    io_uring_batch_operation* op, bool is_continuation)
+{
+  if (op->size_ == 0)
+  {
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  prepare_batch_op(0, op);
+  finish_batch_op(op);
+}
+
+bool io_uring_service::joins_multishot(int op_type,
+    io_uring_service::per_io_object_data& io_obj)
+{
+  if (!io_obj)
+    return false;
+
+  mutex::scoped_lock io_object_lock(io_obj->mutex_);
+  io_queue& io_q = io_obj->queues_[op_type];
+  return io_q.multishot_ || io_q.multishot_posted_
+    || !io_q.multishot_results_.empty();
+}
+
 void io_uring_service::cancel_ops(io_uring_service::per_io_object_data& io_obj)
 {
   if (!io_obj)
@@ -351,7 +573,8 @@ void io_uring_service::cancel_ops_by_key(
           mutex::scoped_lock lock(mutex_);
           if (::io_uring_sqe* sqe = get_sqe())
           {
-            ::io_uring_prep_cancel(sqe, &io_obj->queues_[op_type], 0);
+            ::io_uring_prep_cancel(sqe,
+                io_obj->queues_[op_type].user_data(), 0);
             submit_sqes();
           }
         }
@@ -384,9 +607,18 @@ void io_uring_service::deregister_io_object(
   {
     op_queue<operation> ops;
     bool pending_cancelled_ops = do_cancel_ops(io_obj, ops);
+    for (int i = 0; i < max_ops; ++i)
+      io_obj->queues_[i].discard_multishot_results();
     io_obj->shutdown_ = true;
+    int registered_file = io_obj->registered_file_;
+    io_obj->registered_file_ = -1;
     io_object_lock.unlock();
     scheduler_.post_deferred_completions(ops);
+
+    // The table holds a reference to the descriptor's file, which must be
+    // released before the descriptor is closed.
+    if (registered_file >= 0)
+      unregister_file(registered_file);
     if (pending_cancelled_ops)
     {
       // There are still pending operations. Prevent cleanup_io_object from
@@ -419,6 +651,26 @@ void io_uring_service::cleanup_io_object(
 
 void io_uring_service::run(long usec, op_queue<operation>& ops)
 {
+  if (concurrent_reaping_ && usec <= 0)
+  {
+    // Wait in the kernel without consuming a completion, so that other threads
+    // can reap completions while this one is blocked. The completion queue is
+    // not peeked here, as its head is advanced by whichever thread reaps.
+    ASIO_USDT_PROBE2(reactor_wait_entry, this, usec);
+    if (usec != 0)
+      ::io_uring_enter(ring_.ring_fd, 0, 1, IORING_ENTER_GETEVENTS, 0);
+
+    mutex::scoped_lock completion_lock(completion_mutex_);
+    int count = reap_completions(completion_lock, true, ops);
+    ASIO_USDT_PROBE2(reactor_wait_exit, this, count);
+    (void)count;
+    return;
+  }
+
+  // A wait with a timeout holds the completion queue throughout, as its
+  // timeout entries must be seen by this thread.
+  mutex::scoped_lock completion_lock(completion_mutex_);
+
   __kernel_timespec ts;
   int local_ops = 0;
 
@@ -436,7 +688,13 @@ void io_uring_service::run(long usec, op_queue<operation>& ops)
     }
   }
 
+  // Deferred completion work is only run when the ring is entered to wait for
+  // or get events, so it must be flushed before peeking.
+  if (usec == 0 && defer_taskrun_)
+    ::io_uring_get_events(&ring_);
+
   ::io_uring_cqe* cqe = 0;
+  ASIO_USDT_PROBE2(reactor_wait_entry, this, usec);
   int result = (usec == 0)
     ? ::io_uring_peek_cqe(&ring_, &cqe)
     : ::io_uring_wait_cqe(&ring_, &cqe);
@@ -457,7 +715,9 @@ void io_uring_service::run(long usec, op_queue<operation>& ops)
   }
 
   bool check_timers = false;
+  bool timeout_expired = false;
   int count = 0;
+  int more_count = 0;
   while (result == 0 || local_ops > 0)
   {
     if (result == 0)
@@ -475,8 +735,7 @@ void io_uring_service::run(long usec, op_queue<operation>& ops)
         else if (ptr == &timeout_)
         {
           check_timers = true;
-          timeout_.tv_sec = 0;
-          timeout_.tv_nsec = 0;
+          timeout_expired = true;
         }
         else if (ptr == &ts)
         {
@@ -484,39 +743,48 @@ void io_uring_service::run(long usec, op_queue<operation>& ops)
         }
         else
         {
-          io_queue* io_q = static_cast<io_queue*>(ptr);
-          io_q->set_result(cqe->res);
-          ops.push(io_q);
+          dispatch_cqe(ptr, cqe, ops);
         }
       }
+      if ((cqe->flags & IORING_CQE_F_MORE) != 0)
+        ++more_count;
       ::io_uring_cqe_seen(&ring_, cqe);
       ++count;
     }
-    result = (count < complete_batch_size || local_ops > 0)
+    result = (count < complete_batch_size_ || local_ops > 0)
       ? ::io_uring_peek_cqe(&ring_, &cqe) : -EAGAIN;
   }
 
-  decrement(outstanding_work_, count);
+  // Completions flagged with IORING_CQE_F_MORE do not end a submission.
+  decrement(outstanding_work_, count - more_count);
+  scheduler_.metrics().record_task_run(count);
+  ASIO_USDT_PROBE2(reactor_wait_exit, this, count);
+  completion_lock.unlock();
 
   if (check_timers)
+    process_timers(timeout_expired, ops);
+}
+
+void io_uring_service::run_concurrently(op_queue<operation>& ops)
+{
+  // Completions are left to the thread that holds the completion queue.
+  if (completion_mutex_.try_lock())
   {
-    mutex::scoped_lock lock(mutex_);
-    timer_queues_.get_ready_timers(ops);
-    if (timeout_.tv_sec == 0 && timeout_.tv_nsec == 0)
-    {
-      timeout_ = get_timeout();
-      if (::io_uring_sqe* sqe = get_sqe())
-      {
-        ::io_uring_prep_timeout(sqe, &timeout_, 0, 0);
-        ::io_uring_sqe_set_data(sqe, &timeout_);
-        push_submit_sqes_op(ops);
-      }
-    }
+    mutex::scoped_lock completion_lock(
+        completion_mutex_, mutex::scoped_lock::adopt_lock);
+    reap_completions(completion_lock, false, ops);
   }
 }
 
 void io_uring_service::interrupt()
 {
+  // A thread running another io_uring-based scheduler wakes this ring with a
+  // message from its own ring, rather than submitting to this one.
+  if (msg_ring_wakeups_)
+    if (io_uring_service* source = calling_thread_service())
+      if (source != this && source->send_msg_ring(*this))
+        return;
+
   mutex::scoped_lock lock(mutex_);
   if (::io_uring_sqe* sqe = get_sqe())
   {
@@ -526,9 +794,129 @@ void io_uring_service::interrupt()
   submit_sqes();
 }
 
+int io_uring_service::reap_completions(mutex::scoped_lock& completion_lock,
+    bool running_task, op_queue<operation>& ops)
+{
+  bool check_timers = false;
+  bool timeout_expired = false;
+  int count = 0;
+  int more_count = 0;
+  ::io_uring_cqe* cqe = 0;
+  while (count < complete_batch_size_
+      && ::io_uring_peek_cqe(&ring_, &cqe) == 0)
+  {
+    if (void* ptr = ::io_uring_cqe_get_data(cqe))
+    {
+      if (ptr == this)
+      {
+        // The io_uring service was interrupted. The entry is left for the
+        // thread running the task, as the kernel may not wake that thread if
+        // the entry has already been consumed.
+        if (!running_task)
+          break;
+      }
+      else if (ptr == &timer_queues_)
+      {
+        check_timers = true;
+      }
+      else if (ptr == &timeout_)
+      {
+        check_timers = true;
+        timeout_expired = true;
+      }
+      else
+      {
+        dispatch_cqe(ptr, cqe, ops);
+      }
+    }
+    if ((cqe->flags & IORING_CQE_F_MORE) != 0)
+      ++more_count;
+    ::io_uring_cqe_seen(&ring_, cqe);
+    ++count;
+  }
+  completion_lock.unlock();
+
+  // Completions flagged with IORING_CQE_F_MORE do not end a submission.
+  decrement(outstanding_work_, count - more_count);
+  if (running_task || count > 0)
+    scheduler_.metrics().record_task_run(count);
+
+  if (check_timers)
+    process_timers(timeout_expired, ops);
+
+  return count;
+}
+
+void io_uring_service::process_timers(
+    bool timeout_expired, op_queue<operation>& ops)
+{
+  mutex::scoped_lock lock(mutex_);
+  if (timeout_expired)
+  {
+    timeout_.tv_sec = 0;
+    timeout_.tv_nsec = 0;
+  }
+  timer_queues_.get_ready_timers(ops);
+  record_pending_timers();
+  if (timeout_.tv_sec == 0 && timeout_.tv_nsec == 0)
+  {
+    timeout_ = get_timeout();
+    if (::io_uring_sqe* sqe = get_sqe())
+    {
+      ::io_uring_prep_timeout(sqe, &timeout_, 0, 0);
+      ::io_uring_sqe_set_data(sqe, &timeout_);
+      push_submit_sqes_op(ops);
+    }
+  }
+}
+
+unsigned io_uring_service::get_ring_size(asio::execution_context& ctx)
+{
+  if (unsigned size = config(ctx).get("io_uring", "ring_size", 0U))
+    return size;
+
+  // Creating the ring maps and locks memory for every entry, so by default it
+  // is sized for the expected concurrency rather than the largest possible
+  // load. It holds two submission batches, or one operation of each type for
+  // every preallocated I/O object if that is more. Entries that do not fit are
+  // submitted early, so a small ring costs system calls but never operations.
+  const unsigned max_size = 16384;
+  int batch = config(ctx).get("io_uring", "submit_batch_size", 128);
+  unsigned size = batch > 1 ? 2 * static_cast<unsigned>(batch) : 2;
+  unsigned objects = config(ctx).get("reactor", "preallocated_io_objects", 0U);
+  if (objects > max_size / max_ops)
+    size = max_size;
+  else if (objects * max_ops > size)
+    size = objects * max_ops;
+  return size < max_size ? size : max_size;
+}
+
 void io_uring_service::init_ring()
 {
-  int result = ::io_uring_queue_init(ring_size, &ring_, 0);
+  // Ring sizes above the kernel's limit are clamped rather than rejected.
+  ::io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  params.flags |= IORING_SETUP_CLAMP;
+  if (sqpoll_)
+  {
+    params.flags |= IORING_SETUP_SQPOLL;
+    params.sq_thread_idle = sqpoll_idle_;
+    if (sqpoll_cpu_ >= 0)
+    {
+      params.flags |= IORING_SETUP_SQ_AFF;
+      params.sq_thread_cpu = static_cast<unsigned>(sqpoll_cpu_);
+    }
+  }
+#if defined(IORING_SETUP_SINGLE_ISSUER)
+  if (single_issuer_ || defer_taskrun_)
+    params.flags |= IORING_SETUP_SINGLE_ISSUER;
+#endif // defined(IORING_SETUP_SINGLE_ISSUER)
+#if defined(IORING_SETUP_DEFER_TASKRUN)
+  if (defer_taskrun_)
+    params.flags |= IORING_SETUP_DEFER_TASKRUN;
+#endif // defined(IORING_SETUP_DEFER_TASKRUN)
+
+  int result = ::io_uring_queue_init_params(ring_size_, &ring_, &params);
   if (result < 0)
   {
     ring_.ring_fd = -1;
@@ -537,6 +925,11 @@ void io_uring_service::init_ring()
     asio::detail::throw_error(ec, "io_uring_queue_init");
   }
 
+  // Ring messages are used only if the kernel supports them.
+  init_capabilities(params);
+  if ((capabilities_ & msg_ring_capability) == 0)
+    msg_ring_wakeups_ = false;
+
 #if !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
   event_fd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
   if (event_fd_ < 0)
@@ -559,6 +952,99 @@ void io_uring_service::init_ring()
 #endif // !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
 }
 
+void io_uring_service::init_capabilities(const ::io_uring_params& params)
+{
+  capabilities_ = 0;
+
+#if defined(IORING_FEAT_FAST_POLL)
+  if ((params.features & IORING_FEAT_FAST_POLL) != 0)
+    capabilities_ |= fast_poll_capability;
+#else // defined(IORING_FEAT_FAST_POLL)
+  (void)params;
+#endif // defined(IORING_FEAT_FAST_POLL)
+
+  ::io_uring_probe* probe = ::io_uring_get_probe_ring(&ring_);
+  if (!probe)
+    return;
+
+  // Multishot accept and provided buffer rings have no opcodes of their own,
+  // and are inferred from the IORING_OP_SOCKET opcode that was added in the
+  // same kernel release (5.19). Likewise, multishot receive arrived alongside
+  // IORING_OP_SEND_ZC (6.0).
+#if defined(IORING_ACCEPT_MULTISHOT)
+  if (::io_uring_opcode_supported(probe, IORING_OP_SOCKET))
+    capabilities_ |= multishot_accept_capability | buffer_ring_capability;
+#endif // defined(IORING_ACCEPT_MULTISHOT)
+#if defined(IORING_CQE_F_NOTIF)
+  if (::io_uring_opcode_supported(probe, IORING_OP_SEND_ZC))
+    capabilities_ |= send_zc_capability;
+#endif // defined(IORING_CQE_F_NOTIF)
+#if defined(IORING_RECV_MULTISHOT)
+  if (::io_uring_opcode_supported(probe, IORING_OP_SEND_ZC))
+    capabilities_ |= multishot_recv_capability;
+#endif // defined(IORING_RECV_MULTISHOT)
+#if defined(IORING_MSG_RING_CQE_SKIP)
+  if (::io_uring_opcode_supported(probe, IORING_OP_MSG_RING))
+    capabilities_ |= msg_ring_capability;
+#endif // defined(IORING_MSG_RING_CQE_SKIP)
+  if (::io_uring_opcode_supported(probe, IORING_OP_CLOSE))
+    capabilities_ |= close_capability;
+  if (::io_uring_opcode_supported(probe, IORING_OP_SHUTDOWN))
+    capabilities_ |= shutdown_capability;
+
+  ::io_uring_free_probe(probe);
+}
+
+io_uring_service* io_uring_service::calling_thread_service()
+{
+#if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  // The default task of every scheduler is its context's io_uring service.
+  if (thread_info_base* this_thread =
+      thread_context::top_of_thread_call_stack())
+  {
+    return static_cast<io_uring_service*>(
+        static_cast<scheduler_thread_info*>(this_thread)->default_task);
+  }
+#endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  return 0;
+}
+
+bool io_uring_service::send_msg_ring(io_uring_service& target)
+{
+#if defined(IORING_MSG_RING_CQE_SKIP)
+  if (!msg_ring_wakeups_)
+    return false;
+
+  // The caller holds the target's scheduler lock, so this ring's lock is only
+  // tried. Blocking on it could deadlock with a thread that holds it while
+  // waking this ring's own scheduler.
+  if (!mutex_.try_lock())
+    return false;
+
+  ::io_uring_sqe* sqe = get_sqe();
+  if (!sqe)
+  {
+    mutex_.unlock();
+    return false;
+  }
+
+  // The message is delivered to the target as a completion carrying the
+  // target's own address, which the target treats as an interruption. The
+  // target counts it as outstanding work before it can arrive. The message
+  // operation's completion on this ring is likewise ignored.
+  increment(target.outstanding_work_, 1);
+  ::io_uring_prep_msg_ring(sqe, target.ring_.ring_fd,
+      0, reinterpret_cast<__u64>(&target), 0);
+  ::io_uring_sqe_set_data(sqe, this);
+  submit_sqes();
+  mutex_.unlock();
+  return true;
+#else // defined(IORING_MSG_RING_CQE_SKIP)
+  (void)target;
+  return false;
+#endif // defined(IORING_MSG_RING_CQE_SKIP)
+}
+
 #if !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
 class io_uring_service::event_fd_read_op :
   public reactor_op
@@ -615,15 +1101,56 @@ void io_uring_service::register_with_reactor()
 #endif // !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
 }
 
-io_uring_service::io_object* io_uring_service::allocate_io_object()
+void io_uring_service::init_registered_files()
 {
+  if (registered_files_ == 0)
+    return;
+
+  int result = ::io_uring_register_files_sparse(&ring_, registered_files_);
+  if (result < 0)
+  {
+    asio::error_code ec(-result,
+        asio::error::get_system_category());
+    asio::detail::throw_error(ec, "io_uring_register_files_sparse");
+  }
+
+  // Following a fork, the descriptors of existing I/O objects are added to the
+  // new ring's table at their previous positions.
   mutex::scoped_lock registration_lock(registration_mutex_);
+  for (io_object* io_obj = registered_io_objects_.first();
+      io_obj != 0; io_obj = registered_io_objects_.next(io_obj))
+  {
+    if (io_obj->registered_file_ >= 0)
+    {
+      result = ::io_uring_register_files_update(&ring_,
+          static_cast<unsigned>(io_obj->registered_file_),
+          &io_obj->descriptor_, 1);
+      if (result < 0)
+      {
+        free_registered_files_.push_back(io_obj->registered_file_);
+        io_obj->registered_file_ = -1;
+      }
+    }
+  }
+}
+
+void io_uring_service::unregister_file(int registered_file)
+{
+  int descriptor = -1;
+  (void)::io_uring_register_files_update(&ring_,
+      static_cast<unsigned>(registered_file), &descriptor, 1);
+
+  mutex::scoped_lock registration_lock(registration_mutex_);
+  free_registered_files_.push_back(registered_file);
+}
+
+io_uring_service::io_object* io_uring_service::allocate_io_object()
+{
   return registered_io_objects_.alloc(io_locking_, io_locking_spin_count_);
 }
 
 void io_uring_service::free_io_object(io_uring_service::io_object* io_obj)
 {
-  mutex::scoped_lock registration_lock(registration_mutex_);
   registered_io_objects_.free(io_obj);
 }
 
@@ -634,6 +1161,9 @@ bool io_uring_service::do_cancel_ops(
 
   for (int i = 0; i < max_ops; ++i)
   {
+    if (io_obj->queues_[i].multishot_ || io_obj->queues_[i].multishot_posted_)
+      cancel_op = true;
+
     if (io_uring_operation* first_op = io_obj->queues_[i].op_queue_.front())
     {
       cancel_op = true;
@@ -653,12 +1183,13 @@ bool io_uring_service::do_cancel_ops(
     mutex::scoped_lock lock(mutex_);
     for (int i = 0; i < max_ops; ++i)
     {
-      if (!io_obj->queues_[i].op_queue_.empty()
+      if ((!io_obj->queues_[i].op_queue_.empty()
+            || io_obj->queues_[i].multishot_)
           && !io_obj->queues_[i].cancel_requested_)
       {
         io_obj->queues_[i].cancel_requested_ = true;
         if (::io_uring_sqe* sqe = get_sqe())
-          ::io_uring_prep_cancel(sqe, &io_obj->queues_[i], 0);
+          ::io_uring_prep_cancel(sqe, io_obj->queues_[i].user_data(), 0);
       }
     }
     submit_sqes();
@@ -679,6 +1210,12 @@ void io_uring_service::do_remove_timer_queue(timer_queue_base& queue)
   timer_queues_.erase(&queue);
 }
 
+void io_uring_service::record_pending_timers()
+{
+  if (scheduler_.metrics().enabled())
+    scheduler_.metrics().record_pending_timers(timer_queues_.total_size());
+}
+
 void io_uring_service::update_timeout()
 {
   if (::io_uring_sqe* sqe = get_sqe())
@@ -713,11 +1250,133 @@ __kernel_timespec io_uring_service::get_timeout() const
   return sqe;
 }
 
+::io_uring_sqe* io_uring_service::get_sqe(io_uring_operation* op)
+{
+  if (op->has_link_timeout_ && ::io_uring_sq_space_left(&ring_) < 2)
+  {
+    submit_sqes();
+    if (::io_uring_sq_space_left(&ring_) < 2)
+      return 0;
+  }
+  return get_sqe();
+}
+
+void io_uring_service::prepare_op(io_queue* io_q,
+    io_uring_operation* op, ::io_uring_sqe* sqe)
+{
+  op->multishot_discard_func_ = 0;
+  op->prepare(sqe);
+  use_registered_file(io_q->io_object_, sqe);
+  if (op->multishot_discard_func_)
+  {
+    io_q->multishot_ = true;
+    io_q->multishot_discard_func_ = op->multishot_discard_func_;
+    io_q->multishot_context_ = op->multishot_context_;
+  }
+  ::io_uring_sqe_set_data(sqe, io_q->user_data());
+
+  if (op->has_link_timeout_ && !op->multishot_discard_func_)
+  {
+    // The timeout occupies the adjacent entry reserved by get_sqe(op). Its
+    // own completion carries no user data and is ignored.
+    if (::io_uring_sqe* timeout_sqe = get_sqe())
+    {
+      sqe->flags |= IOSQE_IO_LINK;
+      ::io_uring_prep_link_timeout(timeout_sqe,
+          &op->link_timeout_, IORING_TIMEOUT_ABS);
+    }
+  }
+}
+
+void io_uring_service::prepare_batch_op(
+    io_object* io_obj, io_uring_batch_operation* op)
+{
+  // An extra count is held while the entries are prepared, as earlier entries
+  // may complete if the submission queue fills and has to be flushed.
+  op->outstanding_ = static_cast<long>(op->size_) + 1;
+  increment(outstanding_batch_ops_, 1);
+  scheduler_.work_started();
+
+  mutex::scoped_lock lock(mutex_);
+  for (std::size_t i = 0; i < op->size_; ++i)
+  {
+    if (::io_uring_sqe* sqe = get_sqe())
+    {
+      op->prepare(i, sqe);
+      if (io_obj)
+        use_registered_file(io_obj, sqe);
+      ::io_uring_sqe_set_data(sqe,
+          reinterpret_cast<char*>(&op->slots_[i]) + 2);
+    }
+    else
+    {
+      op->complete_entry(i, -ENOBUFS);
+      ref_count_down(op->outstanding_);
+    }
+  }
+  submit_sqes();
+}
+
+void io_uring_service::finish_batch_op(io_uring_batch_operation* op)
+{
+  if (ref_count_down(op->outstanding_))
+  {
+    decrement(outstanding_batch_ops_, 1);
+    scheduler_.post_deferred_completion(op);
+  }
+}
+
+void io_uring_service::use_registered_file(
+    io_object* io_obj, ::io_uring_sqe* sqe)
+{
+  if (io_obj->registered_file_ >= 0 && sqe->fd == io_obj->descriptor_)
+  {
+    // Refer to the descriptor by its index in the registered file table.
+    sqe->fd = io_obj->registered_file_;
+    sqe->flags |= IOSQE_FIXED_FILE;
+  }
+}
+
+void io_uring_service::dispatch_cqe(void* ptr,
+    const ::io_uring_cqe* cqe, op_queue<operation>& ops)
+{
+  std::uintptr_t value = reinterpret_cast<std::uintptr_t>(ptr);
+  if ((value & 2) != 0)
+  {
+    // Each entry of a batch operation records its own result, and the
+    // operation completes with its last entry.
+    io_uring_batch_operation::slot* s =
+      reinterpret_cast<io_uring_batch_operation::slot*>(value - 2);
+    io_uring_batch_operation* op = s->op_;
+    op->complete_entry(static_cast<std::size_t>(s - op->slots_), cqe->res);
+    if (ref_count_down(op->outstanding_))
+    {
+      decrement(outstanding_batch_ops_, 1);
+      ops.push(op);
+    }
+  }
+  else if ((value & 1) != 0)
+  {
+    // Completions for multishot submissions are accumulated on the queue, so
+    // that the queue is never posted more than once.
+    io_queue* io_q = reinterpret_cast<io_queue*>(value - 1);
+    if (io_q->push_multishot_result(cqe->res, cqe->flags))
+      ops.push(io_q);
+  }
+  else
+  {
+    io_queue* io_q = static_cast<io_queue*>(ptr);
+    io_q->set_result(cqe->res);
+    ops.push(io_q);
+  }
+}
+
 void io_uring_service::submit_sqes()
 {
   if (pending_sqes_ != 0)
   {
     int result = ::io_uring_submit(&ring_);
+    scheduler_.metrics().record_submit(result > 0 ? result : 0);
     if (result > 0)
     {
       pending_sqes_ -= result;
@@ -726,9 +1385,26 @@ void io_uring_service::submit_sqes()
   }
 }
 
+int io_uring_service::submit_batch_size() const
+{
+  if (adaptive_submit_)
+  {
+    // When few operations are outstanding, latency is more important than
+    // throughput and entries are submitted as soon as they are prepared. The
+    // batch size grows with the load, up to the configured size.
+    long outstanding = outstanding_work_;
+    long batch_size = outstanding / 8;
+    if (batch_size < 1)
+      return 1;
+    if (batch_size < submit_batch_size_)
+      return static_cast<int>(batch_size);
+  }
+  return submit_batch_size_;
+}
+
 void io_uring_service::post_submit_sqes_op(mutex::scoped_lock& lock)
 {
-  if (pending_sqes_ >= submit_batch_size)
+  if (pending_sqes_ >= submit_batch_size())
   {
     submit_sqes();
   }
@@ -772,8 +1448,85 @@ void io_uring_service::submit_sqes_op::do_complete(void* owner, operation* base,
 }
 
 io_uring_service::io_queue::io_queue()
-  : operation(&io_uring_service::io_queue::do_complete)
+  : operation(&io_uring_service::io_queue::do_complete),
+    io_object_(0),
+    cancel_requested_(false),
+    multishot_(false),
+    multishot_posted_(false),
+    multishot_discard_func_(0),
+    multishot_context_(0)
+{
+}
+
+bool io_uring_service::io_queue::push_multishot_result(
+    int result, unsigned flags)
 {
+  mutex::scoped_lock io_object_lock(io_object_->mutex_);
+
+  multishot_result r = { result, flags };
+  multishot_results_.push_back(r);
+  if ((flags & IORING_CQE_F_MORE) == 0)
+    multishot_ = false;
+
+  if (multishot_posted_)
+    return false;
+  multishot_posted_ = true;
+  return true;
+}
+
+void io_uring_service::io_queue::deliver_multishot_results(
+    op_queue<operation>& ops)
+{
+  std::size_t n = 0;
+  while (n < multishot_results_.size())
+  {
+    const multishot_result& r = multishot_results_[n];
+    io_uring_operation* op = op_queue_.front();
+
+    // A cancellation is only reported if it was requested for a waiting
+    // operation. Otherwise the submission is simply restarted as required.
+    if (r.result_ == -ECANCELED && (!op || !cancel_requested_))
+    {
+      ++n;
+      continue;
+    }
+
+    if (!op)
+      break;
+
+    if (r.result_ < 0)
+    {
+      op->ec_.assign(-r.result_, asio::error::get_system_category());
+      op->bytes_transferred_ = 0;
+    }
+    else
+    {
+      op->ec_.assign(0, op->ec_.category());
+      op->bytes_transferred_ = static_cast<std::size_t>(r.result_);
+    }
+    op->cqe_flags_ = r.flags_;
+    ++n;
+
+    if (op->perform(true))
+    {
+      ASIO_USDT_PROBE3(op_complete, op,
+          op->ec_.value(), op->bytes_transferred_);
+      op_queue_.pop();
+      ops.push(op);
+    }
+  }
+
+  multishot_results_.erase(multishot_results_.begin(),
+      multishot_results_.begin() + n);
+}
+
+void io_uring_service::io_queue::discard_multishot_results()
+{
+  for (std::size_t i = 0; i < multishot_results_.size(); ++i)
+    if (multishot_results_[i].result_ >= 0 && multishot_discard_func_)
+      multishot_discard_func_(multishot_context_,
+          multishot_results_[i].result_, multishot_results_[i].flags_);
+  multishot_results_.clear();
 }
 
 struct io_uring_service::perform_io_cleanup_on_block_exit
@@ -821,7 +1574,29 @@ operation* io_uring_service::io_queue::perform_io(int result)
   perform_io_cleanup_on_block_exit io_cleanup(io_object_->service_);
   mutex::scoped_lock io_object_lock(io_object_->mutex_);
 
-  if (result != -ECANCELED || cancel_requested_)
+  if (multishot_posted_)
+  {
+    multishot_posted_ = false;
+    deliver_multishot_results(io_cleanup.ops_);
+
+    // Any cancellation remains in effect until the multishot submission ends,
+    // at which point it applies to all operations that are still waiting.
+    if (!multishot_)
+    {
+      if (cancel_requested_)
+      {
+        while (io_uring_operation* op = op_queue_.front())
+        {
+          op->ec_ = asio::error::operation_aborted;
+          op_queue_.pop();
+          io_cleanup.ops_.push(op);
+        }
+      }
+      cancel_requested_ = false;
+    }
+  }
+  else if (result != -ECANCELED || cancel_requested_
+      || (!op_queue_.empty() && op_queue_.front()->link_timeout_expired()))
   {
     if (io_uring_operation* op = op_queue_.front())
     {
@@ -841,24 +1616,29 @@ operation* io_uring_service::io_queue::perform_io(int result)
     {
       if (op->perform(io_cleanup.ops_.empty()))
       {
+        ASIO_USDT_PROBE3(op_complete, op,
+            op->ec_.value(), op->bytes_transferred_);
         op_queue_.pop();
         io_cleanup.ops_.push(op);
       }
       else
         break;
     }
-  }
 
-  cancel_requested_ = false;
+    cancel_requested_ = false;
+  }
+  else
+  {
+    cancel_requested_ = false;
+  }
 
-  if (!op_queue_.empty())
+  if (!op_queue_.empty() && !multishot_)
   {
     io_uring_service* service = io_object_->service_;
     mutex::scoped_lock lock(service->mutex_);
-    if (::io_uring_sqe* sqe = service->get_sqe())
+    if (::io_uring_sqe* sqe = service->get_sqe(op_queue_.front()))
     {
-      op_queue_.front()->prepare(sqe);
-      ::io_uring_sqe_set_data(sqe, this);
+      service->prepare_op(this, op_queue_.front(), sqe);
       service->post_submit_sqes_op(lock);
     }
     else
@@ -876,9 +1656,10 @@ operation* io_uring_service::io_queue::perform_io(int result)
   // The last operation to complete on a shut down object must free it.
   if (io_object_->shutdown_)
   {
+    discard_multishot_results();
     io_cleanup.io_object_to_free_ = io_object_;
     for (int i = 0; i < max_ops; ++i)
-      if (!io_object_->queues_[i].op_queue_.empty())
+      if (io_object_->queues_[i].busy())
         io_cleanup.io_object_to_free_ = 0;
   }
 
@@ -898,6 +1679,7 @@ void io_uring_service::io_queue::do_complete(void* owner, operation* base,
     int result = static_cast<int>(bytes_transferred);
     if (operation* op = io_q->perform_io(result))
     {
+      io_q->io_object_->service_->scheduler_.record_latency(op);
       op->complete(owner, ec, 0);
     }
   }
@@ -28,9 +28,18 @@ namespace detail {
 
 io_uring_socket_service_base::io_uring_socket_service_base(
     execution_context& context)
-  : io_uring_service_(asio::use_service<io_uring_service>(context))
+  : io_uring_service_(asio::use_service<io_uring_service>(context)),
+    unsupported_state_(0)
 {
   io_uring_service_.init_task();
+
+  // Options that request kernel features the ring lacks are ignored, so that
+  // their operations fall back to the plain opcodes.
+  int caps = io_uring_service_.capabilities();
+  if ((caps & io_uring_service::multishot_accept_capability) == 0)
+    unsupported_state_ |= socket_ops::multishot_accept;
+  if ((caps & io_uring_service::send_zc_capability) == 0)
+    unsupported_state_ |= socket_ops::zero_copy;
 }
 
 void io_uring_socket_service_base::base_shutdown()
@@ -43,6 +52,7 @@ void io_uring_socket_service_base::construct(
   impl.socket_ = invalid_socket;
   impl.state_ = 0;
   impl.io_object_data_ = 0;
+  impl.op_slots_ = 0;
 }
 
 void io_uring_socket_service_base::base_move_construct(
@@ -58,6 +68,47 @@ void io_uring_socket_service_base::base_move_construct(
 
   impl.io_object_data_ = other_impl.io_object_data_;
   other_impl.io_object_data_ = 0;
+
+  impl.op_slots_ = other_impl.op_slots_;
+  other_impl.op_slots_ = 0;
+}
+
+asio::error_code io_uring_socket_service_base::base_transfer(
+    io_uring_socket_service_base::base_implementation_type& impl,
+    io_uring_socket_service_base& other_service,
+    io_uring_socket_service_base::base_implementation_type& other_impl,
+    asio::error_code& ec)
+{
+  if (&other_service == this || other_impl.socket_ == invalid_socket)
+  {
+    base_move_assign(impl, other_service, other_impl);
+    ec = success_ec_;
+    return ec;
+  }
+
+  ASIO_HANDLER_OPERATION((other_service.io_uring_service_.context(),
+        "socket", &other_impl, other_impl.socket_, "transfer"));
+
+  // Any outstanding operations on the other implementation are cancelled.
+  other_service.io_uring_service_.deregister_io_object(
+      other_impl.io_object_data_);
+  other_service.io_uring_service_.cleanup_io_object(
+      other_impl.io_object_data_);
+
+  io_uring_service_.register_io_object(impl.io_object_data_);
+  io_uring_service_.register_file(impl.io_object_data_, other_impl.socket_);
+
+  impl.socket_ = other_impl.socket_;
+  other_impl.socket_ = invalid_socket;
+
+  impl.state_ = other_impl.state_;
+  other_impl.state_ = 0;
+
+  impl.op_slots_ = other_impl.op_slots_;
+  other_impl.op_slots_ = 0;
+
+  ec = success_ec_;
+  return ec;
 }
 
 void io_uring_socket_service_base::base_move_assign(
@@ -75,6 +126,9 @@ void io_uring_socket_service_base::base_move_assign(
 
   impl.io_object_data_ = other_impl.io_object_data_;
   other_impl.io_object_data_ = 0;
+
+  impl.op_slots_ = other_impl.op_slots_;
+  other_impl.op_slots_ = 0;
 }
 
 void io_uring_socket_service_base::destroy(
@@ -90,6 +144,10 @@ void io_uring_socket_service_base::destroy(
     socket_ops::close(impl.socket_, impl.state_, true, ignored_ec);
     io_uring_service_.cleanup_io_object(impl.io_object_data_);
   }
+
+  if (impl.op_slots_)
+    impl.op_slots_->release();
+  impl.op_slots_ = 0;
 }
 
 asio::error_code io_uring_socket_service_base::close(
@@ -115,11 +173,36 @@ asio::error_code io_uring_socket_service_base::close(
   // (Actually, POSIX says the state of the descriptor is unspecified. On
   // Linux the descriptor is apparently closed anyway; e.g. see
   //   http://lkml.org/lkml/2005/9/10/129
+  if (impl.op_slots_)
+    impl.op_slots_->release();
   construct(impl);
 
   return ec;
 }
 
+bool io_uring_socket_service_base::begin_close(
+    io_uring_socket_service_base::base_implementation_type& impl,
+    asio::error_code& ec)
+{
+  if (!is_open(impl) || (io_uring_service_.capabilities()
+        & io_uring_service::close_capability) == 0)
+  {
+    close(impl, ec);
+    return false;
+  }
+
+  ASIO_HANDLER_OPERATION((io_uring_service_.context(),
+        "socket", &impl, impl.socket_, "close"));
+
+  io_uring_service_.deregister_io_object(impl.io_object_data_);
+  io_uring_service_.cleanup_io_object(impl.io_object_data_);
+  if (impl.op_slots_)
+    impl.op_slots_->release();
+  construct(impl);
+
+  return true;
+}
+
 socket_type io_uring_socket_service_base::release(
     io_uring_socket_service_base::base_implementation_type& impl,
     asio::error_code& ec)
@@ -136,6 +219,8 @@ socket_type io_uring_socket_service_base::release(
   io_uring_service_.deregister_io_object(impl.io_object_data_);
   io_uring_service_.cleanup_io_object(impl.io_object_data_);
   socket_type sock = impl.socket_;
+  if (impl.op_slots_)
+    impl.op_slots_->release();
   construct(impl);
   ec = success_ec_;
   return sock;
@@ -174,6 +259,7 @@ asio::error_code io_uring_socket_service_base::do_open(
     return ec;
 
   io_uring_service_.register_io_object(impl.io_object_data_);
+  io_uring_service_.register_file(impl.io_object_data_, sock.get());
 
   impl.socket_ = sock.release();
   switch (type)
@@ -182,8 +268,7 @@ asio::error_code io_uring_socket_service_base::do_open(
   case SOCK_DGRAM: impl.state_ = socket_ops::datagram_oriented; break;
   default: impl.state_ = 0; break;
   }
-  ec = success_ec_;
-  return ec;
+  return init_non_blocking(impl, ec);
 }
 
 asio::error_code io_uring_socket_service_base::do_assign(
@@ -198,6 +283,7 @@ asio::error_code io_uring_socket_service_base::do_assign(
   }
 
   io_uring_service_.register_io_object(impl.io_object_data_);
+  io_uring_service_.register_file(impl.io_object_data_, native_socket);
 
   impl.socket_ = native_socket;
   switch (type)
@@ -207,6 +293,23 @@ asio::error_code io_uring_socket_service_base::do_assign(
   default: impl.state_ = 0; break;
   }
   impl.state_ |= socket_ops::possible_dup;
+  return init_non_blocking(impl, ec);
+}
+
+asio::error_code io_uring_socket_service_base::init_non_blocking(
+    io_uring_socket_service_base::base_implementation_type& impl,
+    asio::error_code& ec)
+{
+  // Without fast poll the kernel performs an operation that cannot complete
+  // immediately by blocking a worker thread. Operations instead wait for
+  // readiness with poll_add and then perform non-blocking system calls.
+  if ((io_uring_service_.capabilities()
+        & io_uring_service::fast_poll_capability) == 0)
+  {
+    if (!socket_ops::set_internal_non_blocking(
+          impl.socket_, impl.state_, true, ec))
+      return ec;
+  }
   ec = success_ec_;
   return ec;
 }
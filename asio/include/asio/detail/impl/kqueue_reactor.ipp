@@ -51,11 +51,12 @@ kqueue_reactor::kqueue_reactor(asio::execution_context& ctx)
         config(ctx).get("reactor", "registration_locking_spin_count", 0)),
     kqueue_fd_(do_kqueue_create()),
     interrupter_(),
+    num_deferred_changes_(0),
+    waiting_(false),
     shutdown_(false),
     io_locking_(config(ctx).get("reactor", "io_locking", true)),
     io_locking_spin_count_(
         config(ctx).get("reactor", "io_locking_spin_count", 0)),
-    registered_descriptors_mutex_(mutex_.enabled()),
     registered_descriptors_(execution_context::allocator<void>(ctx),
         config(ctx).get("reactor", "preallocated_io_objects", 0U),
         io_locking_, io_locking_spin_count_)
@@ -84,12 +85,15 @@ void kqueue_reactor::shutdown()
 
   op_queue<operation> ops;
 
-  while (descriptor_state* state = registered_descriptors_.first())
+  descriptor_state* state = registered_descriptors_.first();
+  while (state)
   {
     for (int i = 0; i < max_ops; ++i)
       ops.push(state->op_queue_[i]);
     state->shutdown_ = true;
+    descriptor_state* next_state = registered_descriptors_.next(state);
     registered_descriptors_.free(state);
+    state = next_state;
   }
 
   timer_queues_.get_all_timers(ops);
@@ -108,6 +112,12 @@ void kqueue_reactor::notify_fork(
 
     interrupter_.recreate();
 
+    // Deferred changes are superseded by the re-registration below.
+    {
+      mutex::scoped_lock lock(mutex_);
+      num_deferred_changes_ = 0;
+    }
+
     struct kevent events[2];
     ASIO_KQUEUE_EV_SET(&events[0], interrupter_.read_descriptor(),
         EVFILT_READ, EV_ADD, 0, 0, &interrupter_);
@@ -119,9 +129,8 @@ void kqueue_reactor::notify_fork(
     }
 
     // Re-register all descriptors with kqueue.
-    mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
     for (descriptor_state* state = registered_descriptors_.first();
-        state != 0; state = state->next_)
+        state != 0; state = registered_descriptors_.next(state))
     {
       if (state->num_kevents_ > 0)
       {
@@ -242,21 +251,32 @@ void kqueue_reactor::start_op(int op_type, socket_type descriptor,
 
       if (descriptor_data->num_kevents_ < num_kevents[op_type])
       {
-        struct kevent events[2];
-        ASIO_KQUEUE_EV_SET(&events[0], descriptor, EVFILT_READ,
-            EV_ADD | EV_CLEAR, 0, 0, descriptor_data);
-        ASIO_KQUEUE_EV_SET(&events[1], descriptor, EVFILT_WRITE,
-            EV_ADD | EV_CLEAR, 0, 0, descriptor_data);
-        if (::kevent(kqueue_fd_, events, num_kevents[op_type], 0, 0, 0) != -1)
+        // A deferred registration that fails is reported to the operation
+        // by the kevent call that submits it.
+        if (defer_registration(descriptor,
+              descriptor_data, num_kevents[op_type]))
         {
           descriptor_data->num_kevents_ = num_kevents[op_type];
         }
         else
         {
-          op->ec_ = asio::error_code(errno,
-              asio::error::get_system_category());
-          on_immediate(op, is_continuation, immediate_arg);
-          return;
+          struct kevent events[2];
+          ASIO_KQUEUE_EV_SET(&events[0], descriptor, EVFILT_READ,
+              EV_ADD | EV_CLEAR, 0, 0, descriptor_data);
+          ASIO_KQUEUE_EV_SET(&events[1], descriptor, EVFILT_WRITE,
+              EV_ADD | EV_CLEAR, 0, 0, descriptor_data);
+          if (::kevent(kqueue_fd_, events,
+                num_kevents[op_type], 0, 0, 0) != -1)
+          {
+            descriptor_data->num_kevents_ = num_kevents[op_type];
+          }
+          else
+          {
+            op->ec_ = asio::error_code(errno,
+                asio::error::get_system_category());
+            on_immediate(op, is_continuation, immediate_arg);
+            return;
+          }
         }
       }
     }
@@ -265,12 +285,16 @@ void kqueue_reactor::start_op(int op_type, socket_type descriptor,
       if (descriptor_data->num_kevents_ < num_kevents[op_type])
         descriptor_data->num_kevents_ = num_kevents[op_type];
 
-      struct kevent events[2];
-      ASIO_KQUEUE_EV_SET(&events[0], descriptor, EVFILT_READ,
-          EV_ADD | EV_CLEAR, 0, 0, descriptor_data);
-      ASIO_KQUEUE_EV_SET(&events[1], descriptor, EVFILT_WRITE,
-          EV_ADD | EV_CLEAR, 0, 0, descriptor_data);
-      ::kevent(kqueue_fd_, events, descriptor_data->num_kevents_, 0, 0, 0);
+      if (!defer_registration(descriptor,
+            descriptor_data, descriptor_data->num_kevents_))
+      {
+        struct kevent events[2];
+        ASIO_KQUEUE_EV_SET(&events[0], descriptor, EVFILT_READ,
+            EV_ADD | EV_CLEAR, 0, 0, descriptor_data);
+        ASIO_KQUEUE_EV_SET(&events[1], descriptor, EVFILT_WRITE,
+            EV_ADD | EV_CLEAR, 0, 0, descriptor_data);
+        ::kevent(kqueue_fd_, events, descriptor_data->num_kevents_, 0, 0, 0);
+      }
     }
   }
 
@@ -341,6 +365,10 @@ void kqueue_reactor::deregister_descriptor(socket_type descriptor,
 
   if (!descriptor_data->shutdown_)
   {
+    // Deferred changes must not be applied once the descriptor is closed, as
+    // the descriptor number may be reused.
+    discard_deferred_changes(descriptor_data);
+
     if (closing)
     {
       // The descriptor will be automatically removed from the kqueue when it
@@ -399,6 +427,8 @@ void kqueue_reactor::deregister_internal_descriptor(socket_type descriptor,
 
   if (!descriptor_data->shutdown_)
   {
+    discard_deferred_changes(descriptor_data);
+
     struct kevent events[2];
     ASIO_KQUEUE_EV_SET(&events[0], descriptor,
         EVFILT_READ, EV_DELETE, 0, 0, 0);
@@ -448,11 +478,27 @@ void kqueue_reactor::run(long usec, op_queue<operation>& ops)
   timespec timeout_buf = { 0, 0 };
   timespec* timeout = usec ? get_timeout(usec, timeout_buf) : &timeout_buf;
 
+  // Take the deferred changes so that they are submitted with the wait. While
+  // the thread is blocked, further changes are submitted immediately.
+  struct kevent changes[max_deferred_changes];
+  int num_changes = num_deferred_changes_;
+  for (int i = 0; i < num_changes; ++i)
+    changes[i] = deferred_changes_[i];
+  num_deferred_changes_ = 0;
+  waiting_ = true;
+
   lock.unlock();
 
-  // Block on the kqueue descriptor.
+  // Block on the kqueue descriptor. The event list is larger than the change
+  // list, so that a change that fails is always reported as an event.
   struct kevent events[128];
-  int num_events = kevent(kqueue_fd_, 0, 0, events, 128, timeout);
+  int num_events = kevent(kqueue_fd_,
+      changes, num_changes, events, 128, timeout);
+  scheduler_.metrics().record_task_run(num_events > 0 ? num_events : 0);
+
+  lock.lock();
+  waiting_ = false;
+  lock.unlock();
 
 #if defined(ASIO_ENABLE_HANDLER_TRACKING)
   // Trace the waiting events.
@@ -487,11 +533,19 @@ void kqueue_reactor::run(long usec, op_queue<operation>& ops)
     {
       interrupter_.reset();
     }
-    else
+    else if (ptr)
     {
       descriptor_state* descriptor_data = static_cast<descriptor_state*>(ptr);
       mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
 
+      if (events[i].flags & EV_ERROR)
+      {
+        // A deferred registration failed. The error is delivered to any
+        // pending operations below, and the registration is retried by the
+        // next operation to be started.
+        descriptor_data->num_kevents_ = 0;
+      }
+
       if (events[i].filter == EVFILT_WRITE
           && descriptor_data->num_kevents_ == 2
           && descriptor_data->op_queue_[write_op].empty())
@@ -531,7 +585,7 @@ void kqueue_reactor::run(long usec, op_queue<operation>& ops)
                 descriptor_data->op_queue_[j].pop();
                 ops.push(op);
               }
-              if (op->perform())
+              else if (op->perform())
               {
                 descriptor_data->op_queue_[j].pop();
                 ops.push(op);
@@ -547,6 +601,7 @@ void kqueue_reactor::run(long usec, op_queue<operation>& ops)
 
   lock.lock();
   timer_queues_.get_ready_timers(ops);
+  record_pending_timers();
 }
 
 void kqueue_reactor::interrupt()
@@ -554,6 +609,41 @@ void kqueue_reactor::interrupt()
   interrupter_.interrupt();
 }
 
+bool kqueue_reactor::defer_registration(socket_type descriptor,
+    descriptor_state* descriptor_data, int num_kevents)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  if (waiting_ || num_deferred_changes_ + num_kevents > max_deferred_changes)
+    return false;
+
+  // Only additions are deferred. These may be applied in any order, so any
+  // change that is submitted immediately does not need to wait for them.
+  ASIO_KQUEUE_EV_SET(&deferred_changes_[num_deferred_changes_++],
+      descriptor, EVFILT_READ, EV_ADD | EV_CLEAR, 0, 0, descriptor_data);
+  if (num_kevents > 1)
+  {
+    ASIO_KQUEUE_EV_SET(&deferred_changes_[num_deferred_changes_++],
+        descriptor, EVFILT_WRITE, EV_ADD | EV_CLEAR, 0, 0, descriptor_data);
+  }
+
+  return true;
+}
+
+void kqueue_reactor::discard_deferred_changes(
+    descriptor_state* descriptor_data)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  int n = 0;
+  for (int i = 0; i < num_deferred_changes_; ++i)
+  {
+    if (reinterpret_cast<void*>(deferred_changes_[i].udata) != descriptor_data)
+      deferred_changes_[n++] = deferred_changes_[i];
+  }
+  num_deferred_changes_ = n;
+}
+
 int kqueue_reactor::do_kqueue_create()
 {
   int fd = ::kqueue();
@@ -568,13 +658,11 @@ int kqueue_reactor::do_kqueue_create()
 
 kqueue_reactor::descriptor_state* kqueue_reactor::allocate_descriptor_state()
 {
-  mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
   return registered_descriptors_.alloc(io_locking_, io_locking_spin_count_);
 }
 
 void kqueue_reactor::free_descriptor_state(kqueue_reactor::descriptor_state* s)
 {
-  mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
   registered_descriptors_.free(s);
 }
 
@@ -590,6 +678,12 @@ void kqueue_reactor::do_remove_timer_queue(timer_queue_base& queue)
   timer_queues_.erase(&queue);
 }
 
+void kqueue_reactor::record_pending_timers()
+{
+  if (scheduler_.metrics().enabled())
+    scheduler_.metrics().record_pending_timers(timer_queues_.total_size());
+}
+
 timespec* kqueue_reactor::get_timeout(long usec, timespec& ts)
 {
   // By default we will wait no longer than 5 minutes. This will ensure that
@@ -0,0 +1,127 @@
+//
+// detail/impl/mirrored_memory.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_MIRRORED_MEMORY_IPP
+#define ASIO_DETAIL_IMPL_MIRRORED_MEMORY_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cerrno>
+#include <new>
+#include <stdexcept>
+#if defined(ASIO_HAS_MIRRORED_MEMORY)
+# include <sys/mman.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+# include <linux/memfd.h>
+#endif // defined(ASIO_HAS_MIRRORED_MEMORY)
+#include "asio/detail/mirrored_memory.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/detail/throw_exception.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+#if defined(ASIO_HAS_MIRRORED_MEMORY)
+
+mirrored_memory::mirrored_memory(std::size_t size)
+  : data_(0),
+    size_(0)
+{
+  std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  std::size_t max_pages = static_cast<std::size_t>(-1) / 2 / page_size;
+  if (size / page_size >= max_pages)
+  {
+    std::length_error ex("mirrored_memory too large");
+    asio::detail::throw_exception(ex);
+  }
+  size = size == 0 ? page_size : (size + page_size - 1) / page_size * page_size;
+
+  // The memory is backed by an anonymous file so that it can be mapped more
+  // than once. The file's descriptor is not needed once the mappings exist.
+  int fd = static_cast<int>(::syscall(__NR_memfd_create,
+        "asio_mirrored_memory", MFD_CLOEXEC));
+  if (fd == -1)
+  {
+    asio::error_code ec(errno,
+        asio::error::get_system_category());
+    asio::detail::throw_error(ec, "mirrored_memory");
+  }
+
+  if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+  {
+    asio::error_code ec(errno,
+        asio::error::get_system_category());
+    ::close(fd);
+    asio::detail::throw_error(ec, "mirrored_memory");
+  }
+
+  // Reserve enough address space for both mappings, then replace each half
+  // with a shared mapping of the file.
+  void* base = ::mmap(0, size * 2, PROT_NONE,
+      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (base == MAP_FAILED)
+  {
+    asio::error_code ec(errno,
+        asio::error::get_system_category());
+    ::close(fd);
+    asio::detail::throw_error(ec, "mirrored_memory");
+  }
+
+  unsigned char* data = static_cast<unsigned char*>(base);
+  if (::mmap(data, size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED
+      || ::mmap(data + size, size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+  {
+    asio::error_code ec(errno,
+        asio::error::get_system_category());
+    ::munmap(base, size * 2);
+    ::close(fd);
+    asio::detail::throw_error(ec, "mirrored_memory");
+  }
+
+  ::close(fd);
+  data_ = data;
+  size_ = size;
+}
+
+mirrored_memory::~mirrored_memory()
+{
+  ::munmap(data_, size_ * 2);
+}
+
+#else // defined(ASIO_HAS_MIRRORED_MEMORY)
+
+mirrored_memory::mirrored_memory(std::size_t size)
+  : data_(new unsigned char[size == 0 ? 1 : size]),
+    size_(size)
+{
+}
+
+mirrored_memory::~mirrored_memory()
+{
+  delete[] data_;
+}
+
+#endif // defined(ASIO_HAS_MIRRORED_MEMORY)
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_IMPL_MIRRORED_MEMORY_IPP
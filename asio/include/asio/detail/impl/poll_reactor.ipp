@@ -0,0 +1,380 @@
+//
+// detail/impl/poll_reactor.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_POLL_REACTOR_IPP
+#define ASIO_DETAIL_IMPL_POLL_REACTOR_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_POLL)
+
+#include "asio/detail/poll_reactor.hpp"
+#include "asio/detail/scheduler.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+poll_reactor::poll_reactor(asio::execution_context& ctx)
+  : asio::detail::execution_context_service_base<poll_reactor>(ctx),
+    scheduler_(use_service<scheduler>(ctx)),
+    mutex_(),
+    interrupter_(),
+    descriptors_changed_(true),
+    shutdown_(false)
+{
+  // The interrupter's descriptor is always the first entry.
+  ::pollfd ev = { 0, 0, 0 };
+  ev.fd = interrupter_.read_descriptor();
+  ev.events = POLLIN;
+  ev.revents = 0;
+  descriptors_.push_back(ev);
+}
+
+poll_reactor::~poll_reactor()
+{
+  shutdown();
+}
+
+void poll_reactor::shutdown()
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  shutdown_ = true;
+  lock.unlock();
+
+  op_queue<operation> ops;
+
+  for (int i = 0; i < max_ops; ++i)
+    op_queue_[i].get_all_operations(ops);
+
+  timer_queues_.get_all_timers(ops);
+
+  scheduler_.abandon_operations(ops);
+}
+
+void poll_reactor::notify_fork(
+    asio::execution_context::fork_event fork_ev)
+{
+  if (fork_ev == asio::execution_context::fork_child)
+  {
+    detail::mutex::scoped_lock lock(mutex_);
+
+    interrupter_.recreate();
+    descriptors_[0].fd = interrupter_.read_descriptor();
+    descriptors_changed_ = true;
+    interrupter_.interrupt();
+  }
+}
+
+void poll_reactor::init_task()
+{
+  scheduler_.init_task();
+}
+
+int poll_reactor::register_descriptor(socket_type, per_descriptor_data&)
+{
+  return 0;
+}
+
+int poll_reactor::register_internal_descriptor(int op_type,
+    socket_type descriptor, per_descriptor_data&, reactor_op* op)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+
+  op_queue_[op_type].enqueue_operation(descriptor, op);
+  update_descriptor_events(descriptor);
+  interrupter_.interrupt();
+
+  return 0;
+}
+
+void poll_reactor::move_descriptor(socket_type,
+    poll_reactor::per_descriptor_data&,
+    poll_reactor::per_descriptor_data&)
+{
+}
+
+void poll_reactor::call_post_immediate_completion(
+    operation* op, bool is_continuation, const void* self)
+{
+  static_cast<const poll_reactor*>(self)->post_immediate_completion(
+      op, is_continuation);
+}
+
+void poll_reactor::start_op(int op_type, socket_type descriptor,
+    poll_reactor::per_descriptor_data&, reactor_op* op,
+    bool is_continuation, bool allow_speculative,
+    void (*on_immediate)(operation*, bool, const void*),
+    const void* immediate_arg)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+
+  if (shutdown_)
+  {
+    on_immediate(op, is_continuation, immediate_arg);
+    return;
+  }
+
+  if (allow_speculative)
+  {
+    if (op_type != read_op || !op_queue_[except_op].has_operation(descriptor))
+    {
+      if (!op_queue_[op_type].has_operation(descriptor))
+      {
+        if (op->perform())
+        {
+          lock.unlock();
+          on_immediate(op, is_continuation, immediate_arg);
+          return;
+        }
+      }
+    }
+  }
+
+  bool first = op_queue_[op_type].enqueue_operation(descriptor, op);
+  scheduler_.work_started();
+  if (first)
+  {
+    update_descriptor_events(descriptor);
+    interrupter_.interrupt();
+  }
+}
+
+void poll_reactor::cancel_ops(socket_type descriptor,
+    poll_reactor::per_descriptor_data&)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  cancel_ops_unlocked(descriptor, asio::error::operation_aborted);
+}
+
+void poll_reactor::cancel_ops_by_key(socket_type descriptor,
+    poll_reactor::per_descriptor_data&,
+    int op_type, void* cancellation_key)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  op_queue<operation> ops;
+  bool need_interrupt = op_queue_[op_type].cancel_operations_by_key(
+      descriptor, ops, cancellation_key, asio::error::operation_aborted);
+  update_descriptor_events(descriptor);
+  scheduler_.post_deferred_completions(ops);
+  if (need_interrupt)
+    interrupter_.interrupt();
+}
+
+void poll_reactor::deregister_descriptor(socket_type descriptor,
+    poll_reactor::per_descriptor_data&, bool)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  cancel_ops_unlocked(descriptor, asio::error::operation_aborted);
+}
+
+void poll_reactor::deregister_internal_descriptor(
+    socket_type descriptor, poll_reactor::per_descriptor_data&)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+
+  // Destroy all operations associated with the descriptor.
+  op_queue<operation> ops;
+  asio::error_code ec;
+  for (int i = 0; i < max_ops; ++i)
+    op_queue_[i].cancel_operations(descriptor, ops, ec);
+  update_descriptor_events(descriptor);
+}
+
+void poll_reactor::cleanup_descriptor_data(
+    poll_reactor::per_descriptor_data&)
+{
+}
+
+void poll_reactor::run(long usec, op_queue<operation>& ops)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+
+  // We can return immediately if there's no work to do and the reactor is
+  // not supposed to block.
+  if (usec == 0 && op_queue_[read_op].empty() && op_queue_[write_op].empty()
+      && op_queue_[except_op].empty() && timer_queues_.all_empty())
+    return;
+
+  // Take a copy of the pollfd array if it has changed since the last call.
+  if (descriptors_changed_)
+  {
+    poll_descriptors_ = descriptors_;
+    descriptors_changed_ = false;
+  }
+
+  // Calculate timeout.
+  int timeout;
+  if (usec == 0)
+    timeout = 0;
+  else
+  {
+    timeout = (usec < 0) ? -1 : ((usec - 1) / 1000 + 1);
+    timeout = get_timeout(timeout);
+  }
+  lock.unlock();
+
+  // Block on the poll call until descriptors become ready.
+  int num_events = ::poll(&poll_descriptors_[0],
+      static_cast<nfds_t>(poll_descriptors_.size()), timeout);
+  scheduler_.metrics().record_task_run(num_events > 0 ? num_events : 0);
+
+  lock.lock();
+
+  // Dispatch the waiting events.
+  for (std::size_t i = 0; num_events > 0 && i < poll_descriptors_.size(); ++i)
+  {
+    short revents = poll_descriptors_[i].revents;
+    if (revents == 0)
+      continue;
+    --num_events;
+
+    if (i == 0)
+    {
+      // The first entry is always the interrupter.
+      if (!interrupter_.reset())
+      {
+        interrupter_.recreate();
+        descriptors_[0].fd = interrupter_.read_descriptor();
+        descriptors_changed_ = true;
+      }
+      continue;
+    }
+
+    // Exception operations must be processed first to ensure that any
+    // out-of-band data is read before normal data.
+    int descriptor = poll_descriptors_[i].fd;
+    if (revents & (POLLPRI | POLLERR | POLLHUP | POLLNVAL))
+      op_queue_[except_op].perform_operations(descriptor, ops);
+    if (revents & (POLLIN | POLLERR | POLLHUP | POLLNVAL))
+      op_queue_[read_op].perform_operations(descriptor, ops);
+    if (revents & (POLLOUT | POLLERR | POLLHUP | POLLNVAL))
+      op_queue_[write_op].perform_operations(descriptor, ops);
+
+    // Stop polling for events that no longer have any operations.
+    update_descriptor_events(descriptor);
+  }
+  timer_queues_.get_ready_timers(ops);
+  record_pending_timers();
+}
+
+void poll_reactor::interrupt()
+{
+  interrupter_.interrupt();
+}
+
+void poll_reactor::do_add_timer_queue(timer_queue_base& queue)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.insert(&queue);
+}
+
+void poll_reactor::do_remove_timer_queue(timer_queue_base& queue)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.erase(&queue);
+}
+
+void poll_reactor::record_pending_timers()
+{
+  if (scheduler_.metrics().enabled())
+    scheduler_.metrics().record_pending_timers(timer_queues_.total_size());
+}
+
+int poll_reactor::get_timeout(int msec)
+{
+  // By default we will wait no longer than 5 minutes. This will ensure that
+  // any changes to the system clock are detected after no longer than this.
+  const int max_msec = 5 * 60 * 1000;
+  return timer_queues_.wait_duration_msec(
+      (msec < 0 || max_msec < msec) ? max_msec : msec);
+}
+
+void poll_reactor::cancel_ops_unlocked(socket_type descriptor,
+    const asio::error_code& ec)
+{
+  bool need_interrupt = false;
+  op_queue<operation> ops;
+  for (int i = 0; i < max_ops; ++i)
+    need_interrupt = op_queue_[i].cancel_operations(
+        descriptor, ops, ec) || need_interrupt;
+  update_descriptor_events(descriptor);
+  scheduler_.post_deferred_completions(ops);
+  if (need_interrupt)
+    interrupter_.interrupt();
+}
+
+void poll_reactor::update_descriptor_events(socket_type descriptor)
+{
+  short events = 0;
+  if (op_queue_[read_op].has_operation(descriptor))
+    events |= POLLIN;
+  if (op_queue_[write_op].has_operation(descriptor))
+    events |= POLLOUT;
+  if (op_queue_[except_op].has_operation(descriptor))
+    events |= POLLPRI;
+
+  hash_map<socket_type, std::size_t>::iterator iter =
+    descriptor_index_.find(descriptor);
+  if (iter == descriptor_index_.end())
+  {
+    if (events != 0)
+    {
+      // Append a new entry to the array.
+      ::pollfd ev = { 0, 0, 0 };
+      ev.fd = descriptor;
+      ev.events = events;
+      ev.revents = 0;
+      descriptor_index_.insert(
+          hash_map<socket_type, std::size_t>::value_type(
+            descriptor, descriptors_.size()));
+      descriptors_.push_back(ev);
+      descriptors_changed_ = true;
+    }
+  }
+  else if (events != 0)
+  {
+    // Update the existing entry.
+    ::pollfd& ev = descriptors_[iter->second];
+    if (ev.events != events)
+    {
+      ev.events = events;
+      descriptors_changed_ = true;
+    }
+  }
+  else
+  {
+    // Remove the entry by moving the last entry into its place.
+    std::size_t index = iter->second;
+    descriptor_index_.erase(iter);
+    if (index != descriptors_.size() - 1)
+    {
+      descriptors_[index] = descriptors_.back();
+      descriptor_index_.find(descriptors_[index].fd)->second = index;
+    }
+    descriptors_.pop_back();
+    descriptors_changed_ = true;
+  }
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_POLL)
+
+#endif // ASIO_DETAIL_IMPL_POLL_REACTOR_IPP
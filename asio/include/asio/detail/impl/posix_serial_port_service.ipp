@@ -22,6 +22,10 @@
 #if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
 
 #include <cstring>
+#include <sys/ioctl.h>
+#if defined(__linux__)
+# include <linux/serial.h>
+#endif // defined(__linux__)
 #include "asio/detail/posix_serial_port_service.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -157,6 +161,63 @@ asio::error_code posix_serial_port_service::do_get_option(
   return ec;
 }
 
+asio::error_code posix_serial_port_service::set_option(
+    posix_serial_port_service::implementation_type& impl,
+    const serial_port_base::low_latency& option, asio::error_code& ec)
+{
+#if defined(TIOCGSERIAL) && defined(ASYNC_LOW_LATENCY)
+  int fd = descriptor_service_.native_handle(impl);
+  serial_struct serial;
+  int s = ::ioctl(fd, TIOCGSERIAL, &serial);
+  if (s >= 0)
+  {
+    if (option.value())
+      serial.flags |= ASYNC_LOW_LATENCY;
+    else
+      serial.flags &= ~ASYNC_LOW_LATENCY;
+    s = ::ioctl(fd, TIOCSSERIAL, &serial);
+  }
+  descriptor_ops::get_last_error(ec, s < 0);
+#else // defined(TIOCGSERIAL) && defined(ASYNC_LOW_LATENCY)
+  (void)impl;
+  (void)option;
+  ec = asio::error::operation_not_supported;
+#endif // defined(TIOCGSERIAL) && defined(ASYNC_LOW_LATENCY)
+  ASIO_ERROR_LOCATION(ec);
+  return ec;
+}
+
+asio::error_code posix_serial_port_service::get_option(
+    const posix_serial_port_service::implementation_type& impl,
+    serial_port_base::low_latency& option, asio::error_code& ec) const
+{
+#if defined(TIOCGSERIAL) && defined(ASYNC_LOW_LATENCY)
+  serial_struct serial;
+  int s = ::ioctl(descriptor_service_.native_handle(impl), TIOCGSERIAL, &serial);
+  descriptor_ops::get_last_error(ec, s < 0);
+  if (s >= 0)
+    option = serial_port_base::low_latency(
+        (serial.flags & ASYNC_LOW_LATENCY) != 0);
+#else // defined(TIOCGSERIAL) && defined(ASYNC_LOW_LATENCY)
+  (void)impl;
+  (void)option;
+  ec = asio::error::operation_not_supported;
+#endif // defined(TIOCGSERIAL) && defined(ASYNC_LOW_LATENCY)
+  ASIO_ERROR_LOCATION(ec);
+  return ec;
+}
+
+std::size_t posix_serial_port_service::available(
+    const posix_serial_port_service::implementation_type& impl,
+    asio::error_code& ec) const
+{
+  int value = 0;
+  int s = ::ioctl(descriptor_service_.native_handle(impl), FIONREAD, &value);
+  descriptor_ops::get_last_error(ec, s < 0);
+  ASIO_ERROR_LOCATION(ec);
+  return s < 0 ? 0 : static_cast<std::size_t>(value);
+}
+
 } // namespace detail
 } // namespace asio
 
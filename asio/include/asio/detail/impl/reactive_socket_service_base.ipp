@@ -30,7 +30,8 @@ namespace detail {
 
 reactive_socket_service_base::reactive_socket_service_base(
     execution_context& context)
-  : reactor_(use_service<reactor>(context))
+  : scheduler_(use_service<scheduler>(context)),
+    reactor_(use_service<reactor>(context))
 {
   reactor_.init_task();
 }
@@ -45,6 +46,8 @@ void reactive_socket_service_base::construct(
   impl.socket_ = invalid_socket;
   impl.state_ = 0;
   impl.reactor_data_ = reactor::per_descriptor_data();
+  impl.read_ahead_ = 0;
+  impl.op_slots_ = 0;
 }
 
 void reactive_socket_service_base::base_move_construct(
@@ -58,6 +61,12 @@ void reactive_socket_service_base::base_move_construct(
   impl.state_ = other_impl.state_;
   other_impl.state_ = 0;
 
+  impl.read_ahead_ = other_impl.read_ahead_;
+  other_impl.read_ahead_ = 0;
+
+  impl.op_slots_ = other_impl.op_slots_;
+  other_impl.op_slots_ = 0;
+
   reactor_.move_descriptor(impl.socket_,
       impl.reactor_data_, other_impl.reactor_data_);
 }
@@ -75,10 +84,65 @@ void reactive_socket_service_base::base_move_assign(
   impl.state_ = other_impl.state_;
   other_impl.state_ = 0;
 
+  impl.read_ahead_ = other_impl.read_ahead_;
+  other_impl.read_ahead_ = 0;
+
+  impl.op_slots_ = other_impl.op_slots_;
+  other_impl.op_slots_ = 0;
+
   other_service.reactor_.move_descriptor(impl.socket_,
       impl.reactor_data_, other_impl.reactor_data_);
 }
 
+asio::error_code reactive_socket_service_base::base_transfer(
+    reactive_socket_service_base::base_implementation_type& impl,
+    reactive_socket_service_base& other_service,
+    reactive_socket_service_base::base_implementation_type& other_impl,
+    asio::error_code& ec)
+{
+  if (&other_service == this || other_impl.socket_ == invalid_socket
+      || (other_impl.state_ & socket_ops::reactor_deferred))
+  {
+    base_move_assign(impl, other_service, other_impl);
+    ec = asio::error_code();
+    return ec;
+  }
+
+  // Add the descriptor to this reactor before removing it from the other, so
+  // that a change in readiness is always seen by one of them.
+  if (int err = reactor_.register_descriptor(
+        other_impl.socket_, impl.reactor_data_))
+  {
+    reactor_.cleanup_descriptor_data(impl.reactor_data_);
+    ec = asio::error_code(err,
+        asio::error::get_system_category());
+    return ec;
+  }
+
+  ASIO_HANDLER_OPERATION((other_service.reactor_.context(),
+        "socket", &other_impl, other_impl.socket_, "transfer"));
+
+  // Any outstanding operations on the other implementation are cancelled.
+  other_service.reactor_.deregister_descriptor(
+      other_impl.socket_, other_impl.reactor_data_, false);
+  other_service.reactor_.cleanup_descriptor_data(other_impl.reactor_data_);
+
+  impl.socket_ = other_impl.socket_;
+  other_impl.socket_ = invalid_socket;
+
+  impl.state_ = other_impl.state_;
+  other_impl.state_ = 0;
+
+  impl.read_ahead_ = other_impl.read_ahead_;
+  other_impl.read_ahead_ = 0;
+
+  impl.op_slots_ = other_impl.op_slots_;
+  other_impl.op_slots_ = 0;
+
+  ec = asio::error_code();
+  return ec;
+}
+
 void reactive_socket_service_base::destroy(
     reactive_socket_service_base::base_implementation_type& impl)
 {
@@ -95,6 +159,13 @@ void reactive_socket_service_base::destroy(
 
     reactor_.cleanup_descriptor_data(impl.reactor_data_);
   }
+
+  delete impl.read_ahead_;
+  impl.read_ahead_ = 0;
+
+  if (impl.op_slots_)
+    impl.op_slots_->release();
+  impl.op_slots_ = 0;
 }
 
 asio::error_code reactive_socket_service_base::close(
@@ -126,11 +197,37 @@ asio::error_code reactive_socket_service_base::close(
   // We'll just have to assume that other OSes follow the same behaviour. The
   // known exception is when Windows's closesocket() function fails with
   // WSAEWOULDBLOCK, but this case is handled inside socket_ops::close().
+  delete impl.read_ahead_;
+  if (impl.op_slots_)
+    impl.op_slots_->release();
   construct(impl);
 
   return ec;
 }
 
+bool reactive_socket_service_base::begin_close(
+    reactive_socket_service_base::base_implementation_type& impl)
+{
+  bool was_open = is_open(impl);
+  if (was_open)
+  {
+    ASIO_HANDLER_OPERATION((reactor_.context(),
+          "socket", &impl, impl.socket_, "close"));
+
+    // The descriptor remains open for now, so it must be removed from the
+    // reactor explicitly.
+    reactor_.deregister_descriptor(impl.socket_, impl.reactor_data_, false);
+    reactor_.cleanup_descriptor_data(impl.reactor_data_);
+  }
+
+  delete impl.read_ahead_;
+  if (impl.op_slots_)
+    impl.op_slots_->release();
+  construct(impl);
+
+  return was_open;
+}
+
 socket_type reactive_socket_service_base::release(
     reactive_socket_service_base::base_implementation_type& impl,
     asio::error_code& ec)
@@ -147,11 +244,81 @@ socket_type reactive_socket_service_base::release(
   reactor_.deregister_descriptor(impl.socket_, impl.reactor_data_, false);
   reactor_.cleanup_descriptor_data(impl.reactor_data_);
   socket_type sock = impl.socket_;
+  delete impl.read_ahead_;
+  if (impl.op_slots_)
+    impl.op_slots_->release();
   construct(impl);
   ec = asio::error_code();
   return sock;
 }
 
+asio::error_code reactive_socket_service_base::set_read_ahead(
+    reactive_socket_service_base::base_implementation_type& impl,
+    const void* optval, std::size_t optlen, asio::error_code& ec)
+{
+  if (!is_open(impl))
+  {
+    ec = asio::error::bad_descriptor;
+    return ec;
+  }
+
+  if ((impl.state_ & socket_ops::stream_oriented) == 0)
+  {
+    ec = asio::error::operation_not_supported;
+    return ec;
+  }
+
+  if (optlen != sizeof(int) || *static_cast<const int*>(optval) < 0)
+  {
+    ec = asio::error::invalid_argument;
+    return ec;
+  }
+
+  // The buffer may not be shrunk below the amount of data it holds.
+  std::size_t capacity = *static_cast<const int*>(optval);
+  std::size_t size = impl.read_ahead_ ? impl.read_ahead_->size() : 0;
+  if (capacity < size)
+  {
+    ec = asio::error::invalid_argument;
+    return ec;
+  }
+
+  socket_read_ahead* read_ahead = 0;
+  if (capacity > 0)
+  {
+    read_ahead = new socket_read_ahead(capacity);
+    if (impl.read_ahead_)
+      read_ahead->assign(*impl.read_ahead_);
+  }
+
+  delete impl.read_ahead_;
+  impl.read_ahead_ = read_ahead;
+  ec = asio::error_code();
+  return ec;
+}
+
+asio::error_code reactive_socket_service_base::get_read_ahead(
+    const reactive_socket_service_base::base_implementation_type& impl,
+    void* optval, std::size_t* optlen, asio::error_code& ec) const
+{
+  if (!is_open(impl))
+  {
+    ec = asio::error::bad_descriptor;
+    return ec;
+  }
+
+  if (*optlen != sizeof(int))
+  {
+    ec = asio::error::invalid_argument;
+    return ec;
+  }
+
+  *static_cast<int*>(optval) = impl.read_ahead_
+    ? static_cast<int>(impl.read_ahead_->capacity()) : 0;
+  ec = asio::error_code();
+  return ec;
+}
+
 asio::error_code reactive_socket_service_base::cancel(
     reactive_socket_service_base::base_implementation_type& impl,
     asio::error_code& ec)
@@ -184,13 +351,6 @@ asio::error_code reactive_socket_service_base::do_open(
   if (sock.get() == invalid_socket)
     return ec;
 
-  if (int err = reactor_.register_descriptor(sock.get(), impl.reactor_data_))
-  {
-    ec = asio::error_code(err,
-        asio::error::get_system_category());
-    return ec;
-  }
-
   impl.socket_ = sock.release();
   switch (type)
   {
@@ -198,6 +358,11 @@ asio::error_code reactive_socket_service_base::do_open(
   case SOCK_DGRAM: impl.state_ = socket_ops::datagram_oriented; break;
   default: impl.state_ = 0; break;
   }
+
+  // The socket is registered with the reactor when an asynchronous operation
+  // first needs to wait, so that sockets whose operations all complete
+  // immediately never pay for the registration.
+  impl.state_ |= socket_ops::reactor_deferred;
   ec = asio::error_code();
   return ec;
 }
@@ -213,14 +378,6 @@ asio::error_code reactive_socket_service_base::do_assign(
     return ec;
   }
 
-  if (int err = reactor_.register_descriptor(
-        native_socket, impl.reactor_data_))
-  {
-    ec = asio::error_code(err,
-        asio::error::get_system_category());
-    return ec;
-  }
-
   impl.socket_ = native_socket;
   switch (type)
   {
@@ -228,11 +385,27 @@ asio::error_code reactive_socket_service_base::do_assign(
   case SOCK_DGRAM: impl.state_ = socket_ops::datagram_oriented; break;
   default: impl.state_ = 0; break;
   }
-  impl.state_ |= socket_ops::possible_dup;
+  impl.state_ |= socket_ops::possible_dup | socket_ops::reactor_deferred;
   ec = asio::error_code();
   return ec;
 }
 
+bool reactive_socket_service_base::do_register(
+    reactive_socket_service_base::base_implementation_type& impl,
+    asio::error_code& ec)
+{
+  if (int err = reactor_.register_descriptor(impl.socket_, impl.reactor_data_))
+  {
+    reactor_.cleanup_descriptor_data(impl.reactor_data_);
+    ec = asio::error_code(err,
+        asio::error::get_system_category());
+    return false;
+  }
+
+  impl.state_ &= ~socket_ops::reactor_deferred;
+  return true;
+}
+
 void reactive_socket_service_base::do_start_op(
     reactive_socket_service_base::base_implementation_type& impl,
     int op_type, reactor_op* op, bool is_continuation,
@@ -240,6 +413,25 @@ void reactive_socket_service_base::do_start_op(
     void (*on_immediate)(operation* op, bool, const void*),
     const void* immediate_arg)
 {
+  if (op_type == reactor::read_op
+      && (impl.state_ & socket_ops::inline_completion)
+      && on_immediate == &reactor::call_post_immediate_completion)
+  {
+    // Reactor operations may complete immediately while the reactor holds a
+    // lock on the descriptor, so the handler is invoked only after the
+    // reactor returns.
+    deferred_immediate_completion deferred = { 0, false };
+    do_start_op(impl, op_type, op, is_continuation, allow_speculative, noop,
+        needs_non_blocking, &call_defer_immediate_completion, &deferred);
+    if (deferred.op_
+        && !scheduler_.dispatch_immediate_completion(deferred.op_))
+    {
+      reactor_.post_immediate_completion(
+          deferred.op_, deferred.is_continuation_);
+    }
+    return;
+  }
+
   if (!noop)
   {
     if ((impl.state_ & socket_ops::non_blocking)
@@ -247,6 +439,23 @@ void reactive_socket_service_base::do_start_op(
         || socket_ops::set_internal_non_blocking(
           impl.socket_, impl.state_, true, op->ec_))
     {
+      if (impl.state_ & socket_ops::reactor_deferred)
+      {
+        // No operation can be queued on an unregistered socket, so the
+        // operation may be attempted before registering.
+        if (allow_speculative && op->perform())
+        {
+          on_immediate(op, is_continuation, immediate_arg);
+          return;
+        }
+
+        if (!do_register(impl, op->ec_))
+        {
+          on_immediate(op, is_continuation, immediate_arg);
+          return;
+        }
+      }
+
       reactor_.start_op(op_type, impl.socket_, impl.reactor_data_, op,
           is_continuation, allow_speculative, on_immediate, immediate_arg);
       return;
@@ -256,6 +465,15 @@ void reactive_socket_service_base::do_start_op(
   on_immediate(op, is_continuation, immediate_arg);
 }
 
+void reactive_socket_service_base::call_defer_immediate_completion(
+    operation* op, bool is_continuation, const void* self)
+{
+  const deferred_immediate_completion* deferred =
+    static_cast<const deferred_immediate_completion*>(self);
+  deferred->op_ = op;
+  deferred->is_continuation_ = is_continuation;
+}
+
 void reactive_socket_service_base::do_start_accept_op(
     reactive_socket_service_base::base_implementation_type& impl,
     reactor_op* op, bool is_continuation, bool peer_is_open,
@@ -290,9 +508,14 @@ void reactive_socket_service_base::do_start_connect_op(
           || op->ec_ == asio::error::would_block)
       {
         op->ec_ = asio::error_code();
-        reactor_.start_op(reactor::connect_op, impl.socket_, impl.reactor_data_,
-            op, is_continuation, false, on_immediate, immediate_arg);
-        return;
+        if ((impl.state_ & socket_ops::reactor_deferred) == 0
+            || do_register(impl, op->ec_))
+        {
+          reactor_.start_op(reactor::connect_op, impl.socket_,
+              impl.reactor_data_, op, is_continuation, false,
+              on_immediate, immediate_arg);
+          return;
+        }
       }
     }
   }
@@ -17,6 +17,7 @@
 
 #include "asio/detail/config.hpp"
 #include "asio/config.hpp"
+#include "asio/ip/address.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/resolver_service_base.hpp"
 
@@ -28,6 +29,24 @@ namespace detail {
 resolver_service_base::resolver_service_base(execution_context& context)
   : thread_pool_(asio::use_service<resolver_thread_pool>(context))
 {
+#if !defined(ASIO_WINDOWS_RUNTIME)
+  dns_port_ = config(context).get("resolver", "dns_port",
+      static_cast<unsigned short>(53));
+
+  if (config(context).get("resolver", "dns", false))
+  {
+    char buffer[256];
+    const char* path = asio::use_service<config_service>(context).get_value(
+        "resolver", "dns_config_file", buffer, sizeof(buffer));
+    if (!path)
+      path = "/etc/resolv.conf";
+
+    std::shared_ptr<dns_ops::resolver_config> dns_config(
+        new dns_ops::resolver_config);
+    if (dns_ops::load_resolver_config(path, *dns_config))
+      dns_config_ = dns_config;
+  }
+#endif // !defined(ASIO_WINDOWS_RUNTIME)
 }
 
 resolver_service_base::~resolver_service_base()
@@ -71,6 +90,48 @@ void resolver_service_base::cancel(
   impl.reset(static_cast<void*>(0), socket_ops::noop_deleter());
 }
 
+#if !defined(ASIO_WINDOWS_RUNTIME)
+bool resolver_service_base::use_dns(const std::string& host,
+    const std::string& service, const addrinfo_type& hints) const
+{
+  if (!dns_config_ || host.empty())
+    return false;
+
+  // Only unqualified names and those in the DNS are resolved directly.
+  // Addresses, and names that refer to the local host, are handled by
+  // getaddrinfo.
+  asio::error_code ec;
+  asio::ip::make_address(host, ec);
+  if (!ec || host == "localhost" || host == "localhost."
+      || (host.size() > 10 && host.compare(host.size() - 10, 10,
+          ".localhost") == 0))
+    return false;
+
+  // The flags that need information beyond the addresses are not supported.
+  if (hints.ai_flags & (AI_CANONNAME | AI_NUMERICHOST))
+    return false;
+  if (hints.ai_family == ASIO_OS_DEF(AF_INET6)
+      && (hints.ai_flags & (AI_V4MAPPED | AI_ALL)))
+    return false;
+  if (hints.ai_family != ASIO_OS_DEF(AF_UNSPEC)
+      && hints.ai_family != ASIO_OS_DEF(AF_INET)
+      && hints.ai_family != ASIO_OS_DEF(AF_INET6))
+    return false;
+
+  // Service names are looked up by getaddrinfo.
+  if (service.size() > 5)
+    return false;
+  unsigned long port = 0;
+  for (std::size_t i = 0; i < service.size(); ++i)
+  {
+    if (service[i] < '0' || service[i] > '9')
+      return false;
+    port = port * 10 + (service[i] - '0');
+  }
+  return port <= 65535;
+}
+#endif // !defined(ASIO_WINDOWS_RUNTIME)
+
 } // namespace detail
 } // namespace asio
 
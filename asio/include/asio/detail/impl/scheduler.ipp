@@ -18,11 +18,14 @@
 #include "asio/detail/config.hpp"
 
 #include "asio/config.hpp"
+#include "asio/detail/chrono.hpp"
 #include "asio/detail/event.hpp"
 #include "asio/detail/limits.hpp"
+#include "asio/detail/memory_metrics_service.hpp"
 #include "asio/detail/scheduler.hpp"
 #include "asio/detail/scheduler_thread_info.hpp"
 #include "asio/detail/signal_blocker.hpp"
+#include "asio/detail/usdt_probes.hpp"
 
 #if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
 # include "asio/detail/io_uring_service.hpp"
@@ -59,8 +62,7 @@ struct scheduler::task_cleanup
   {
     if (this_thread_->private_outstanding_work > 0)
     {
-      asio::detail::increment(
-          scheduler_->outstanding_work_,
+      scheduler_->add_outstanding_work(
           this_thread_->private_outstanding_work);
     }
     this_thread_->private_outstanding_work = 0;
@@ -69,6 +71,7 @@ struct scheduler::task_cleanup
     // the operation queue.
     lock_->lock();
     scheduler_->task_interrupted_ = true;
+    scheduler_->record_queued(this_thread_->private_op_queue);
     scheduler_->op_queue_.push(this_thread_->private_op_queue);
     scheduler_->op_queue_.push(&scheduler_->task_operation_);
   }
@@ -78,14 +81,41 @@ struct scheduler::task_cleanup
   thread_info* this_thread_;
 };
 
+struct scheduler::concurrent_task_cleanup
+{
+  ~concurrent_task_cleanup()
+  {
+    if (this_thread_->private_outstanding_work > 0)
+    {
+      scheduler_->add_outstanding_work(
+          this_thread_->private_outstanding_work);
+    }
+    this_thread_->private_outstanding_work = 0;
+
+    // Enqueue the completed operations. The task itself remains with the
+    // thread that is running it.
+    lock_->lock();
+    scheduler_->record_queued(this_thread_->private_op_queue);
+    scheduler_->op_queue_.push(this_thread_->private_op_queue);
+  }
+
+  scheduler* scheduler_;
+  mutex::scoped_lock* lock_;
+  thread_info* this_thread_;
+};
+
 struct scheduler::work_cleanup
 {
   ~work_cleanup()
   {
-    if (this_thread_->private_outstanding_work > 1)
+    if (this_thread_->batch_work_count)
+    {
+      scheduler_->adjust_work_reserve(*this_thread_,
+          this_thread_->private_outstanding_work - 1);
+    }
+    else if (this_thread_->private_outstanding_work > 1)
     {
-      asio::detail::increment(
-          scheduler_->outstanding_work_,
+      scheduler_->add_outstanding_work(
           this_thread_->private_outstanding_work - 1);
     }
     else if (this_thread_->private_outstanding_work < 1)
@@ -98,6 +128,7 @@ struct scheduler::work_cleanup
     if (!this_thread_->private_op_queue.empty())
     {
       lock_->lock();
+      scheduler_->record_queued(this_thread_->private_op_queue);
       scheduler_->op_queue_.push(this_thread_->private_op_queue);
     }
 #endif // defined(ASIO_HAS_THREADS)
@@ -108,6 +139,36 @@ struct scheduler::work_cleanup
   thread_info* this_thread_;
 };
 
+struct scheduler::work_queue_cleanup
+{
+  ~work_queue_cleanup()
+  {
+#if defined(ASIO_HAS_THREADS)
+    if (this_thread_->private_work_queue)
+      scheduler_->release_work_queue(*this_thread_);
+#endif // defined(ASIO_HAS_THREADS)
+  }
+
+  scheduler* scheduler_;
+  thread_info* this_thread_;
+};
+
+struct scheduler::work_reserve_cleanup
+{
+  ~work_reserve_cleanup()
+  {
+    if (this_thread_->work_reserve > 0)
+    {
+      mutex::scoped_lock lock(scheduler_->mutex_);
+      scheduler_->release_work_reserve(lock, *this_thread_);
+    }
+    this_thread_->batch_work_count = false;
+  }
+
+  scheduler* scheduler_;
+  thread_info* this_thread_;
+};
+
 scheduler::scheduler(asio::execution_context& ctx,
     get_task_func_type get_task)
   : asio::detail::execution_context_service_base<scheduler>(ctx),
@@ -117,11 +178,50 @@ scheduler::scheduler(asio::execution_context& ctx,
     task_(0),
     get_task_(get_task),
     task_interrupted_(true),
+    concurrent_task_(false),
     stopped_(false),
     shutdown_(false),
     outstanding_work_(0),
+    priority_levels_(config(ctx).get("scheduler", "priority_levels", 0U)),
+    priority_lanes_(priority_levels_ > 1
+        ? new op_queue<operation>[priority_levels_ - 1] : 0),
+    priority_lane_ops_(0),
+    current_lane_(0),
+    lane_credit_(1),
     task_usec_(config(ctx).get("scheduler", "task_usec", -1L)),
-    wait_usec_(config(ctx).get("scheduler", "wait_usec", -1L))
+    wait_usec_(config(ctx).get("scheduler", "wait_usec", -1L)),
+    busy_poll_usec_(config(ctx).get("scheduler", "busy_poll_usec", 0L)),
+    inline_budget_(config(ctx).get("scheduler", "inline_budget", 0L)),
+    inline_budget_usec_(
+        config(ctx).get("scheduler", "inline_budget_usec", 0L)),
+    work_count_batch_(config(ctx).get("scheduler", "work_count_batch", 0L)),
+    idle_spin_usec_(config(ctx).get("scheduler", "idle_spin_usec", 0L)),
+    grow_func_(0),
+    grow_arg_(0),
+    grow_usec_(0),
+    backlogged_(false),
+#if defined(ASIO_HAS_HUGE_PAGES)
+    huge_page_arena_(huge_page_arena::get(
+          config(ctx).get("memory", "huge_pages", 0))),
+#endif // defined(ASIO_HAS_HUGE_PAGES)
+    memory_metrics_(memory_metrics_service::get(ctx)),
+    metrics_(config(ctx).get("scheduler", "metrics", false)),
+    queue_depth_(0),
+#if defined(ASIO_HAS_THREADS)
+    work_stealing_(!one_thread_ && mutex_.enabled()
+        && config(ctx).get("scheduler", "work_stealing", false)),
+    work_queue_capacity_(
+        config(ctx).get("scheduler", "work_queue_size", 256U)),
+    max_work_queues_(work_stealing_
+        ? config(ctx).get("scheduler", "max_work_queues", 64U) : 0U),
+    work_queues_(max_work_queues_ > 0
+        ? new work_queue_entry[max_work_queues_] : 0),
+    num_work_queues_(0),
+    idle_threads_(0),
+    work_queue_stopped_(false)
+#else // defined(ASIO_HAS_THREADS)
+    work_stealing_(false)
+#endif // defined(ASIO_HAS_THREADS)
 {
   ASIO_HANDLER_TRACKING_INIT;
 }
@@ -133,17 +233,54 @@ scheduler::scheduler(scheduler::internal, asio::execution_context& ctx)
     task_(0),
     get_task_(&scheduler::get_default_task),
     task_interrupted_(true),
+    concurrent_task_(false),
     stopped_(false),
     shutdown_(false),
     outstanding_work_(0),
+    priority_levels_(0),
+    priority_lanes_(0),
+    priority_lane_ops_(0),
+    current_lane_(0),
+    lane_credit_(1),
     task_usec_(-1L),
-    wait_usec_(-1L)
+    wait_usec_(-1L),
+    busy_poll_usec_(0L),
+    inline_budget_(0L),
+    inline_budget_usec_(0L),
+    work_count_batch_(0L),
+    idle_spin_usec_(0L),
+    grow_func_(0),
+    grow_arg_(0),
+    grow_usec_(0),
+    backlogged_(false),
+#if defined(ASIO_HAS_HUGE_PAGES)
+    huge_page_arena_(0),
+#endif // defined(ASIO_HAS_HUGE_PAGES)
+    memory_metrics_(0),
+    metrics_(false),
+    queue_depth_(0),
+    work_stealing_(false)
+#if defined(ASIO_HAS_THREADS)
+    , work_queue_capacity_(0),
+    max_work_queues_(0),
+    work_queues_(0),
+    num_work_queues_(0),
+    idle_threads_(0),
+    work_queue_stopped_(false)
+#endif // defined(ASIO_HAS_THREADS)
 {
   ASIO_HANDLER_TRACKING_INIT;
 }
 
 scheduler::~scheduler()
 {
+  delete[] priority_lanes_;
+#if defined(ASIO_HAS_THREADS)
+  std::size_t n = num_work_queues_.load(std::memory_order_relaxed);
+  for (std::size_t i = 0; i < n; ++i)
+    delete work_queues_[i].queue_;
+  delete[] work_queues_;
+#endif // defined(ASIO_HAS_THREADS)
 }
 
 void scheduler::shutdown()
@@ -160,9 +297,26 @@ void scheduler::shutdown()
     if (o != &task_operation_)
       o->destroy();
   }
+  for (unsigned int i = 1; i < priority_levels_; ++i)
+  {
+    while (operation* o = priority_lanes_[i - 1].front())
+    {
+      priority_lanes_[i - 1].pop();
+      o->destroy();
+    }
+  }
+  priority_lane_ops_ = 0;
+
+#if defined(ASIO_HAS_THREADS)
+  std::size_t n = num_work_queues_.load(std::memory_order_acquire);
+  for (std::size_t i = 0; i < n; ++i)
+    while (operation* o = work_queues_[i].queue_->steal())
+      o->destroy();
+#endif // defined(ASIO_HAS_THREADS)
 
   // Reset to initial state.
   task_ = 0;
+  concurrent_task_ = false;
 }
 
 void scheduler::init_task()
@@ -171,12 +325,18 @@ void scheduler::init_task()
   if (!shutdown_ && !task_)
   {
     task_ = get_task_(this->context());
+    concurrent_task_ = !one_thread_ && task_->supports_concurrent_run();
     op_queue_.push(&task_operation_);
     wake_one_thread_and_unlock(lock);
   }
 }
 
 std::size_t scheduler::run(asio::error_code& ec)
+{
+  return run_until_idle(-1, ec);
+}
+
+std::size_t scheduler::run_until_idle(long idle_usec, asio::error_code& ec)
 {
   ec = asio::error_code();
   if (outstanding_work_ == 0)
@@ -187,12 +347,32 @@ std::size_t scheduler::run(asio::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.idle_exit_usec = idle_usec;
+  init_thread_memory(this_thread);
   thread_call_stack::context ctx(this, this_thread);
 
+  // Threads that run the scheduler using run() are given their own work queue,
+  // if work stealing is enabled. A nested call has no queue of its own. It
+  // runs work from the shared queue, or steals from the per-thread queues,
+  // including that of the outer call.
+  work_queue_cleanup on_exit = { this, &this_thread };
+  (void)on_exit;
+#if defined(ASIO_HAS_THREADS)
+  if (work_stealing_ && !ctx.next_by_key())
+    acquire_work_queue(this_thread);
+#endif // defined(ASIO_HAS_THREADS)
+
+  // Threads that run the scheduler using run() count work in batches, if
+  // enabled. The reserve is returned when the thread leaves run().
+  work_reserve_cleanup on_reserve_exit = { this, &this_thread };
+  (void)on_reserve_exit;
+  this_thread.batch_work_count = work_count_batch_ > 0;
+
   mutex::scoped_lock lock(mutex_);
+  this_thread.default_task = default_task();
 
   std::size_t n = 0;
-  for (; do_run_one(lock, this_thread, ec); lock.lock())
+  for (; do_run_one(lock, this_thread, ec); )
     if (n != (std::numeric_limits<std::size_t>::max)())
       ++n;
   return n;
@@ -209,9 +389,11 @@ std::size_t scheduler::run_one(asio::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  init_thread_memory(this_thread);
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
+  this_thread.default_task = default_task();
 
   return do_run_one(lock, this_thread, ec);
 }
@@ -227,9 +409,11 @@ std::size_t scheduler::wait_one(long usec, asio::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  init_thread_memory(this_thread);
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
+  this_thread.default_task = default_task();
 
   return do_wait_one(lock, this_thread, usec, ec);
 }
@@ -245,9 +429,11 @@ std::size_t scheduler::poll(asio::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  init_thread_memory(this_thread);
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
+  this_thread.default_task = default_task();
 
 #if defined(ASIO_HAS_THREADS)
   // We want to support nested calls to poll() and poll_one(), so any handlers
@@ -255,7 +441,10 @@ std::size_t scheduler::poll(asio::error_code& ec)
   // queue now.
   if (one_thread_)
     if (thread_info* outer_info = static_cast<thread_info*>(ctx.next_by_key()))
+    {
+      record_queued(outer_info->private_op_queue);
       op_queue_.push(outer_info->private_op_queue);
+    }
 #endif // defined(ASIO_HAS_THREADS)
 
   std::size_t n = 0;
@@ -276,9 +465,11 @@ std::size_t scheduler::poll_one(asio::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  init_thread_memory(this_thread);
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
+  this_thread.default_task = default_task();
 
 #if defined(ASIO_HAS_THREADS)
   // We want to support nested calls to poll() and poll_one(), so any handlers
@@ -286,7 +477,10 @@ std::size_t scheduler::poll_one(asio::error_code& ec)
   // queue now.
   if (one_thread_)
     if (thread_info* outer_info = static_cast<thread_info*>(ctx.next_by_key()))
+    {
+      record_queued(outer_info->private_op_queue);
       op_queue_.push(outer_info->private_op_queue);
+    }
 #endif // defined(ASIO_HAS_THREADS)
 
   return do_poll_one(lock, this_thread, ec);
@@ -304,10 +498,23 @@ bool scheduler::stopped() const
   return stopped_;
 }
 
+void scheduler::set_elastic(long idle_spin_usec,
+    long grow_usec, scheduler::grow_func_type f, void* arg)
+{
+  mutex::scoped_lock lock(mutex_);
+  idle_spin_usec_ = idle_spin_usec;
+  grow_func_ = f;
+  grow_arg_ = arg;
+  grow_usec_ = grow_usec;
+}
+
 void scheduler::restart()
 {
   mutex::scoped_lock lock(mutex_);
   stopped_ = false;
+#if defined(ASIO_HAS_THREADS)
+  work_queue_stopped_.store(false, std::memory_order_relaxed);
+#endif // defined(ASIO_HAS_THREADS)
 }
 
 void scheduler::compensating_work_started()
@@ -322,6 +529,13 @@ bool scheduler::can_dispatch()
   return thread_call_stack::contains(this) != 0;
 }
 
+bool scheduler::can_dispatch_inline()
+{
+  thread_info_base* this_thread = thread_call_stack::contains(this);
+  return this_thread
+    && consume_inline_budget(*static_cast<thread_info*>(this_thread));
+}
+
 void scheduler::capture_current_exception()
 {
   if (thread_info_base* this_thread = thread_call_stack::contains(this))
@@ -331,6 +545,8 @@ void scheduler::capture_current_exception()
 void scheduler::post_immediate_completion(
     scheduler::operation* op, bool is_continuation)
 {
+  ASIO_USDT_PROBE2(scheduler_enqueue, this, op);
+
 #if defined(ASIO_HAS_THREADS)
   if (one_thread_ || is_continuation)
   {
@@ -346,14 +562,48 @@ void scheduler::post_immediate_completion(
 #endif // defined(ASIO_HAS_THREADS)
 
   work_started();
+#if defined(ASIO_HAS_THREADS)
+  if (work_stealing_ && push_work_queue_op(op))
+    return;
+#endif // defined(ASIO_HAS_THREADS)
+
   mutex::scoped_lock lock(mutex_);
+  record_queued(1);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
 }
 
+bool scheduler::dispatch_immediate_completion(scheduler::operation* op)
+{
+  // Bounds the stack growth when each handler starts another operation that
+  // is itself dispatched.
+  const int max_immediate_completion_depth = 16;
+
+  thread_info_base* this_thread = thread_call_stack::contains(this);
+  if (!this_thread)
+    return false;
+
+  thread_info* this_info = static_cast<thread_info*>(this_thread);
+  if (this_info->immediate_completion_depth >= max_immediate_completion_depth
+      || !consume_inline_budget(*this_info))
+    return false;
+
+  // Restore the depth even if the handler throws.
+  struct depth_guard
+  {
+    ~depth_guard() { --depth_; }
+    int& depth_;
+  } guard = { ++this_info->immediate_completion_depth };
+
+  op->complete(this, asio::error_code(), 0);
+  return true;
+}
+
 void scheduler::post_immediate_completions(std::size_t n,
     op_queue<scheduler::operation>& ops, bool is_continuation)
 {
+  ASIO_USDT_PROBE2(scheduler_enqueue, this, ops.front());
+
 #if defined(ASIO_HAS_THREADS)
   if (one_thread_ || is_continuation)
   {
@@ -369,14 +619,45 @@ void scheduler::post_immediate_completions(std::size_t n,
   (void)is_continuation;
 #endif // defined(ASIO_HAS_THREADS)
 
-  increment(outstanding_work_, static_cast<long>(n));
+  add_outstanding_work(static_cast<long>(n));
+#if defined(ASIO_HAS_THREADS)
+  if (work_stealing_ && push_work_queue_ops(ops))
+    return;
+#endif // defined(ASIO_HAS_THREADS)
+
   mutex::scoped_lock lock(mutex_);
+  record_queued(ops);
   op_queue_.push(ops);
+  wake_threads_and_unlock(lock, n);
+}
+
+void scheduler::post_prioritised_completion(scheduler::operation* op,
+    bool is_continuation, unsigned int priority)
+{
+  if (priority == 0 || priority_levels_ <= 1)
+  {
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  // Priorities beyond the configured number of levels share the highest lane.
+  if (priority >= priority_levels_)
+    priority = priority_levels_ - 1;
+
+  ASIO_USDT_PROBE2(scheduler_enqueue, this, op);
+
+  work_started();
+  mutex::scoped_lock lock(mutex_);
+  record_queued(1);
+  priority_lanes_[priority - 1].push(op);
+  ++priority_lane_ops_;
   wake_one_thread_and_unlock(lock);
 }
 
 void scheduler::post_deferred_completion(scheduler::operation* op)
 {
+  ASIO_USDT_PROBE2(scheduler_enqueue, this, op);
+
 #if defined(ASIO_HAS_THREADS)
   if (one_thread_)
   {
@@ -386,9 +667,13 @@ void scheduler::post_deferred_completion(scheduler::operation* op)
       return;
     }
   }
+
+  if (work_stealing_ && push_work_queue_op(op))
+    return;
 #endif // defined(ASIO_HAS_THREADS)
 
   mutex::scoped_lock lock(mutex_);
+  record_queued(1);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
 }
@@ -398,6 +683,8 @@ void scheduler::post_deferred_completions(
 {
   if (!ops.empty())
   {
+    ASIO_USDT_PROBE2(scheduler_enqueue, this, ops.front());
+
 #if defined(ASIO_HAS_THREADS)
     if (one_thread_)
     {
@@ -407,9 +694,13 @@ void scheduler::post_deferred_completions(
         return;
       }
     }
+
+    if (work_stealing_ && push_work_queue_ops(ops))
+      return;
 #endif // defined(ASIO_HAS_THREADS)
 
     mutex::scoped_lock lock(mutex_);
+    record_queued(ops);
     op_queue_.push(ops);
     wake_one_thread_and_unlock(lock);
   }
@@ -418,8 +709,11 @@ void scheduler::post_deferred_completions(
 void scheduler::do_dispatch(
     scheduler::operation* op)
 {
+  ASIO_USDT_PROBE2(scheduler_enqueue, this, op);
+
   work_started();
   mutex::scoped_lock lock(mutex_);
+  record_queued(1);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
 }
@@ -435,18 +729,57 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
     scheduler::thread_info& this_thread,
     const asio::error_code& ec)
 {
+#if defined(ASIO_HAS_THREADS)
+  // Prefer the thread's own work queue, without taking the lock, except when
+  // it is time to give the shared queue a turn.
+  if (work_queue* q = this_thread.private_work_queue)
+  {
+    if (++this_thread.private_work_queue_tick
+          % work_queue_fairness_interval != 0
+        && !work_queue_stopped_.load(std::memory_order_relaxed))
+    {
+      if (operation* o = q->take())
+      {
+        lock.unlock();
+        return do_run_work_queue_op(lock, this_thread, o, ec);
+      }
+    }
+  }
+#endif // defined(ASIO_HAS_THREADS)
+
+  lock.lock();
+
   while (!stopped_)
   {
+    if (priority_lane_ops_ != 0)
+      select_priority_lane();
+
     if (!op_queue_.empty())
     {
+      // Return the thread's reserve of work before running the task, as the
+      // task may block, so that other threads can tell when work runs out.
+      if (op_queue_.front() == &task_operation_
+          && this_thread.work_reserve > 0)
+      {
+        release_work_reserve(lock, this_thread);
+        continue;
+      }
+
       // Prepare to execute first handler from queue.
       operation* o = op_queue_.front();
       op_queue_.pop();
-      bool more_handlers = (!op_queue_.empty());
+      bool more_handlers = (!op_queue_.empty() || priority_lane_ops_ != 0);
+#if defined(ASIO_HAS_THREADS)
+      if (this_thread.private_work_queue)
+        more_handlers = more_handlers
+          || !this_thread.private_work_queue->empty();
+#endif // defined(ASIO_HAS_THREADS)
 
       if (o == &task_operation_)
       {
         task_interrupted_ = more_handlers || task_usec_ == 0;
+        if (!more_handlers)
+          backlogged_ = false;
 
         if (more_handlers && !one_thread_ && wait_usec_ != 0)
           wakeup_event_.unlock_and_signal_one(lock);
@@ -455,16 +788,27 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
 
         task_cleanup on_exit = { this, &lock, &this_thread };
         (void)on_exit;
+        scheduler_metrics::scoped_timer timer(
+            metrics_, scheduler_metrics::task_activity);
 
         // Run the task. May throw an exception. Only block if the operation
         // queue is empty and we're not polling, otherwise we want to return
-        // as soon as possible.
-        task_->run(more_handlers ? 0 : task_usec_,
-            this_thread.private_op_queue);
+        // as soon as possible. When busy polling, spin for a while before
+        // blocking.
+        if (more_handlers || task_usec_ == 0 || busy_poll_usec_ <= 0
+            || !busy_poll_task(lock, this_thread))
+        {
+          task_->run(more_handlers ? 0 : task_usec_,
+              this_thread.private_op_queue);
+        }
       }
       else
       {
         std::size_t task_result = o->task_result_;
+        record_dequeued();
+        this_thread.idle = false;
+        if (!more_handlers)
+          backlogged_ = false;
 
         if (more_handlers && !one_thread_)
           wake_one_thread_and_unlock(lock);
@@ -474,6 +818,12 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
         // Ensure the count of outstanding work is decremented on block exit.
         work_cleanup on_exit = { this, &lock, &this_thread };
         (void)on_exit;
+        scheduler_metrics::scoped_timer timer(
+            metrics_, scheduler_metrics::handler_activity);
+
+        record_latency(o);
+        reset_inline_budget(this_thread);
+        ASIO_USDT_PROBE3(scheduler_dequeue, this, o, task_result);
 
         // Complete the operation. May throw an exception. Deletes the object.
         o->complete(this, ec, task_result);
@@ -484,7 +834,84 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
     }
     else
     {
-      if (wait_usec_ == 0)
+      // Return the thread's reserve of work before going idle.
+      if (this_thread.work_reserve > 0)
+      {
+        release_work_reserve(lock, this_thread);
+        continue;
+      }
+
+      // The queue is empty, so the task is running in another thread. If the
+      // task allows it, look for completed operations before going idle.
+      if (concurrent_task_ && run_task_concurrently(lock, this_thread))
+        continue;
+
+      // On becoming idle, check for handlers for a while before blocking.
+      if (!this_thread.idle)
+      {
+        this_thread.idle = true;
+        backlogged_ = false;
+        if (idle_spin_usec_ > 0 || this_thread.idle_exit_usec >= 0)
+          this_thread.idle_start = chrono::steady_clock::now();
+        if (idle_spin_usec_ > 0 && idle_spin(lock, this_thread))
+          continue;
+      }
+
+      // Limit the wait so that the thread leaves once it has been idle for
+      // long enough.
+      long wait_usec = wait_usec_;
+      if (this_thread.idle_exit_usec >= 0)
+      {
+        long remaining_usec = this_thread.idle_exit_usec
+          - static_cast<long>(chrono::duration_cast<chrono::microseconds>(
+                chrono::steady_clock::now() - this_thread.idle_start).count());
+        if (remaining_usec <= 0)
+          return 0;
+        if (wait_usec < 0 || remaining_usec < wait_usec)
+          wait_usec = remaining_usec;
+      }
+
+#if defined(ASIO_HAS_THREADS)
+      if (work_stealing_)
+      {
+        // Look for work in the per-thread queues before going idle. Once the
+        // thread is counted as idle, it must check the queues once more so
+        // that a concurrent push does not go unnoticed.
+        lock.unlock();
+        operation* o = find_work_queue_op(this_thread);
+        if (!o)
+        {
+          lock.lock();
+          if (stopped_ || !op_queue_.empty() || priority_lane_ops_ != 0)
+            continue;
+          ++idle_threads_;
+          o = find_work_queue_op(this_thread);
+          if (!o)
+          {
+            if (wait_usec == 0)
+            {
+              lock.unlock();
+              lock.lock();
+            }
+            else
+            {
+              wakeup_event_.clear(lock);
+              if (wait_usec > 0)
+                wakeup_event_.wait_for_usec(lock, wait_usec);
+              else
+                wakeup_event_.wait(lock);
+            }
+            --idle_threads_;
+            continue;
+          }
+          --idle_threads_;
+          lock.unlock();
+        }
+        return do_run_work_queue_op(lock, this_thread, o, ec);
+      }
+#endif // defined(ASIO_HAS_THREADS)
+
+      if (wait_usec == 0)
       {
         lock.unlock();
         lock.lock();
@@ -492,8 +919,8 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
       else
       {
         wakeup_event_.clear(lock);
-        if (wait_usec_ > 0)
-          wakeup_event_.wait_for_usec(lock, wait_usec_);
+        if (wait_usec > 0)
+          wakeup_event_.wait_for_usec(lock, wait_usec);
         else
           wakeup_event_.wait(lock);
       }
@@ -510,6 +937,9 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
   if (stopped_)
     return 0;
 
+  if (priority_lane_ops_ != 0)
+    select_priority_lane();
+
   operation* o = op_queue_.front();
   if (o == 0)
   {
@@ -517,13 +947,15 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
     usec = (wait_usec_ >= 0 && wait_usec_ < usec) ? wait_usec_ : usec;
     wakeup_event_.wait_for_usec(lock, usec);
     usec = 0; // Wait at most once.
+    if (priority_lane_ops_ != 0)
+      select_priority_lane();
     o = op_queue_.front();
   }
 
   if (o == &task_operation_)
   {
     op_queue_.pop();
-    bool more_handlers = (!op_queue_.empty());
+    bool more_handlers = (!op_queue_.empty() || priority_lane_ops_ != 0);
 
     usec = (task_usec_ >= 0 && task_usec_ < usec) ? task_usec_ : usec;
     task_interrupted_ = more_handlers || usec == 0;
@@ -536,6 +968,8 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
     {
       task_cleanup on_exit = { this, &lock, &this_thread };
       (void)on_exit;
+      scheduler_metrics::scoped_timer timer(
+          metrics_, scheduler_metrics::task_activity);
 
       // Run the task. May throw an exception. Only block if the operation
       // queue is empty and we're not polling, otherwise we want to return
@@ -543,6 +977,8 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
       task_->run(more_handlers ? 0 : usec, this_thread.private_op_queue);
     }
 
+    if (priority_lane_ops_ != 0)
+      select_priority_lane();
     o = op_queue_.front();
     if (o == &task_operation_)
     {
@@ -556,7 +992,8 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
     return 0;
 
   op_queue_.pop();
-  bool more_handlers = (!op_queue_.empty());
+  bool more_handlers = (!op_queue_.empty() || priority_lane_ops_ != 0);
+  record_dequeued();
 
   std::size_t task_result = o->task_result_;
 
@@ -568,6 +1005,12 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
   // Ensure the count of outstanding work is decremented on block exit.
   work_cleanup on_exit = { this, &lock, &this_thread };
   (void)on_exit;
+  scheduler_metrics::scoped_timer timer(
+      metrics_, scheduler_metrics::handler_activity);
+
+  record_latency(o);
+  reset_inline_budget(this_thread);
+  ASIO_USDT_PROBE3(scheduler_dequeue, this, o, task_result);
 
   // Complete the operation. May throw an exception. Deletes the object.
   o->complete(this, ec, task_result);
@@ -583,6 +1026,9 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
   if (stopped_)
     return 0;
 
+  if (priority_lane_ops_ != 0)
+    select_priority_lane();
+
   operation* o = op_queue_.front();
   if (o == &task_operation_)
   {
@@ -592,6 +1038,8 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
     {
       task_cleanup c = { this, &lock, &this_thread };
       (void)c;
+      scheduler_metrics::scoped_timer timer(
+          metrics_, scheduler_metrics::task_activity);
 
       // Run the task. May throw an exception. Only block if the operation
       // queue is empty and we're not polling, otherwise we want to return
@@ -599,6 +1047,8 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
       task_->run(0, this_thread.private_op_queue);
     }
 
+    if (priority_lane_ops_ != 0)
+      select_priority_lane();
     o = op_queue_.front();
     if (o == &task_operation_)
     {
@@ -611,7 +1061,8 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
     return 0;
 
   op_queue_.pop();
-  bool more_handlers = (!op_queue_.empty());
+  bool more_handlers = (!op_queue_.empty() || priority_lane_ops_ != 0);
+  record_dequeued();
 
   std::size_t task_result = o->task_result_;
 
@@ -623,6 +1074,12 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
   // Ensure the count of outstanding work is decremented on block exit.
   work_cleanup on_exit = { this, &lock, &this_thread };
   (void)on_exit;
+  scheduler_metrics::scoped_timer timer(
+      metrics_, scheduler_metrics::handler_activity);
+
+  record_latency(o);
+  reset_inline_budget(this_thread);
+  ASIO_USDT_PROBE3(scheduler_dequeue, this, o, task_result);
 
   // Complete the operation. May throw an exception. Deletes the object.
   o->complete(this, ec, task_result);
@@ -631,10 +1088,81 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
   return 1;
 }
 
+bool scheduler::reserve_work(long n)
+{
+  thread_info_base* this_thread = thread_call_stack::contains(this);
+  if (!this_thread
+      || !static_cast<thread_info*>(this_thread)->batch_work_count)
+    return false;
+
+  adjust_work_reserve(*static_cast<thread_info*>(this_thread), n);
+  return true;
+}
+
+void scheduler::adjust_work_reserve(scheduler::thread_info& this_thread, long n)
+{
+  // Top up the reserve with a batch when it runs out. When the reserve grows
+  // beyond two batches, give back all but one batch. Since the thread keeps a
+  // batch, the count of outstanding work cannot reach zero here.
+  long reserve = this_thread.work_reserve - n;
+  if (reserve < 0)
+  {
+    add_outstanding_work(work_count_batch_ - reserve);
+    reserve = work_count_batch_;
+  }
+  else if (reserve > 2 * work_count_batch_)
+  {
+    add_outstanding_work(work_count_batch_ - reserve);
+    reserve = work_count_batch_;
+  }
+  this_thread.work_reserve = reserve;
+}
+
+void scheduler::release_work_reserve(mutex::scoped_lock& lock,
+    scheduler::thread_info& this_thread)
+{
+  long reserve = this_thread.work_reserve;
+  this_thread.work_reserve = 0;
+  if (add_outstanding_work(-reserve) == 0)
+    stop_all_threads(lock);
+}
+
+void scheduler::init_thread_memory(scheduler::thread_info& this_thread)
+{
+#if defined(ASIO_HAS_HUGE_PAGES)
+  this_thread.use_huge_page_arena(huge_page_arena_);
+#endif // defined(ASIO_HAS_HUGE_PAGES)
+  this_thread.use_memory_metrics(memory_metrics_);
+}
+
+void scheduler::reset_inline_budget(scheduler::thread_info& this_thread)
+{
+  this_thread.inline_completions = 0;
+  if (inline_budget_usec_ > 0)
+    this_thread.inline_budget_start = chrono::steady_clock::now();
+}
+
+bool scheduler::consume_inline_budget(scheduler::thread_info& this_thread)
+{
+  if (inline_budget_ > 0 && this_thread.inline_completions >= inline_budget_)
+    return false;
+
+  if (inline_budget_usec_ > 0 && chrono::steady_clock::now()
+      - this_thread.inline_budget_start
+        >= chrono::microseconds(inline_budget_usec_))
+    return false;
+
+  ++this_thread.inline_completions;
+  return true;
+}
+
 void scheduler::stop_all_threads(
     mutex::scoped_lock& lock)
 {
   stopped_ = true;
+#if defined(ASIO_HAS_THREADS)
+  work_queue_stopped_.store(true, std::memory_order_relaxed);
+#endif // defined(ASIO_HAS_THREADS)
   wakeup_event_.signal_all(lock);
 
   if (!task_interrupted_ && task_)
@@ -644,9 +1172,139 @@ void scheduler::stop_all_threads(
   }
 }
 
+bool scheduler::idle_spin(mutex::scoped_lock& lock,
+    scheduler::thread_info& this_thread)
+{
+  chrono::steady_clock::time_point deadline = this_thread.idle_start
+    + chrono::microseconds(idle_spin_usec_);
+
+  do
+  {
+    lock.unlock();
+    lock.lock();
+    if (stopped_ || !op_queue_.empty() || priority_lane_ops_ != 0)
+      return true;
+  } while (chrono::steady_clock::now() < deadline);
+
+  return false;
+}
+
+bool scheduler::run_task_concurrently(mutex::scoped_lock& lock,
+    scheduler::thread_info& this_thread)
+{
+  lock.unlock();
+
+  {
+    concurrent_task_cleanup on_exit = { this, &lock, &this_thread };
+    (void)on_exit;
+    scheduler_metrics::scoped_timer timer(
+        metrics_, scheduler_metrics::task_activity);
+
+    task_->run_concurrently(this_thread.private_op_queue);
+  }
+
+  return !op_queue_.empty();
+}
+
+bool scheduler::check_backlog()
+{
+  chrono::steady_clock::time_point now = chrono::steady_clock::now();
+  if (!backlogged_)
+  {
+    backlogged_ = true;
+    backlog_start_ = now;
+    return false;
+  }
+
+  if (now - backlog_start_ < chrono::microseconds(grow_usec_))
+    return false;
+
+  // Start measuring again, so that a further thread is added only if the
+  // backlog persists.
+  backlog_start_ = now;
+  return true;
+}
+
+bool scheduler::busy_poll_task(mutex::scoped_lock& lock,
+    scheduler::thread_info& this_thread)
+{
+  // The budget doubles each time spinning finds work and halves each time it
+  // does not, within a range below the configured maximum.
+  const long min_busy_poll_usec = busy_poll_usec_ / 32 + 1;
+  if (this_thread.busy_poll_usec <= 0)
+    this_thread.busy_poll_usec = busy_poll_usec_;
+
+  chrono::steady_clock::time_point deadline = chrono::steady_clock::now()
+    + chrono::microseconds(this_thread.busy_poll_usec);
+
+  for (;;)
+  {
+    task_->run(0, this_thread.private_op_queue);
+
+    bool found_work = !this_thread.private_op_queue.empty();
+    if (!found_work)
+    {
+      // Other threads interrupt the task when they post new handlers.
+      lock.lock();
+      found_work = task_interrupted_;
+      lock.unlock();
+    }
+
+    if (found_work)
+    {
+      this_thread.busy_poll_usec = this_thread.busy_poll_usec * 2;
+      if (this_thread.busy_poll_usec > busy_poll_usec_)
+        this_thread.busy_poll_usec = busy_poll_usec_;
+      return true;
+    }
+
+    if (chrono::steady_clock::now() >= deadline)
+    {
+      this_thread.busy_poll_usec = this_thread.busy_poll_usec / 2;
+      if (this_thread.busy_poll_usec < min_busy_poll_usec)
+        this_thread.busy_poll_usec = min_busy_poll_usec;
+      return false;
+    }
+  }
+}
+
+void scheduler::select_priority_lane()
+{
+  // Each lane's quantum is one more than its priority, so that a lane with
+  // priority p delivers up to p + 1 handlers per round. The loop terminates
+  // because at least one priority lane is non-empty.
+  for (;;)
+  {
+    if (lane_credit_ > 0)
+    {
+      if (current_lane_ == 0)
+      {
+        if (!op_queue_.empty())
+        {
+          --lane_credit_;
+          return;
+        }
+      }
+      else if (operation* o = priority_lanes_[current_lane_ - 1].front())
+      {
+        priority_lanes_[current_lane_ - 1].pop();
+        --priority_lane_ops_;
+        op_queue_.push_front(o);
+        --lane_credit_;
+        return;
+      }
+    }
+
+    current_lane_ = (current_lane_ + 1) % priority_levels_;
+    lane_credit_ = current_lane_ + 1;
+  }
+}
+
 void scheduler::wake_one_thread_and_unlock(
     mutex::scoped_lock& lock)
 {
+  bool grow = grow_func_ && check_backlog();
+
   if (wait_usec_ == 0 || !wakeup_event_.maybe_unlock_and_signal_one(lock))
   {
     if (!task_interrupted_ && task_)
@@ -656,6 +1314,172 @@ void scheduler::wake_one_thread_and_unlock(
     }
     lock.unlock();
   }
+
+  if (grow)
+    grow_func_(grow_arg_);
+}
+
+void scheduler::wake_threads_and_unlock(
+    mutex::scoped_lock& lock, std::size_t n)
+{
+  if (n <= 1)
+  {
+    wake_one_thread_and_unlock(lock);
+    return;
+  }
+
+  bool grow = grow_func_ && check_backlog();
+
+  if (wait_usec_ == 0
+      || !wakeup_event_.maybe_unlock_and_signal_some(lock, n))
+  {
+    if (!task_interrupted_ && task_)
+    {
+      task_interrupted_ = true;
+      task_->interrupt();
+    }
+    lock.unlock();
+  }
+
+  if (grow)
+    grow_func_(grow_arg_);
+}
+
+#if defined(ASIO_HAS_THREADS)
+std::size_t scheduler::do_run_work_queue_op(mutex::scoped_lock& lock,
+    scheduler::thread_info& this_thread, scheduler::operation* o,
+    const asio::error_code& ec)
+{
+  std::size_t task_result = o->task_result_;
+  this_thread.idle = false;
+
+  // Ensure the count of outstanding work is decremented on block exit.
+  work_cleanup on_exit = { this, &lock, &this_thread };
+  (void)on_exit;
+  scheduler_metrics::scoped_timer timer(
+      metrics_, scheduler_metrics::handler_activity);
+
+  record_latency(o);
+  reset_inline_budget(this_thread);
+  ASIO_USDT_PROBE3(scheduler_dequeue, this, o, task_result);
+
+  // Complete the operation. May throw an exception. Deletes the object.
+  o->complete(this, ec, task_result);
+  this_thread.rethrow_pending_exception();
+
+  return 1;
+}
+
+void scheduler::acquire_work_queue(scheduler::thread_info& this_thread)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  std::size_t n = num_work_queues_.load(std::memory_order_relaxed);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    if (!work_queues_[i].in_use_)
+    {
+      work_queues_[i].in_use_ = true;
+      this_thread.private_work_queue = work_queues_[i].queue_;
+      this_thread.private_work_queue_index = i;
+      return;
+    }
+  }
+
+  if (n < max_work_queues_)
+  {
+    work_queues_[n].queue_ = new work_queue(work_queue_capacity_);
+    work_queues_[n].in_use_ = true;
+    num_work_queues_.store(n + 1, std::memory_order_release);
+    this_thread.private_work_queue = work_queues_[n].queue_;
+    this_thread.private_work_queue_index = n;
+  }
+}
+
+void scheduler::release_work_queue(scheduler::thread_info& this_thread)
+{
+  op_queue<operation> ops;
+  while (operation* o = this_thread.private_work_queue->take())
+    ops.push(o);
+
+  mutex::scoped_lock lock(mutex_);
+  work_queues_[this_thread.private_work_queue_index].in_use_ = false;
+  this_thread.private_work_queue = 0;
+  if (!ops.empty())
+  {
+    record_queued(ops);
+    op_queue_.push(ops);
+    wake_one_thread_and_unlock(lock);
+  }
+}
+
+bool scheduler::push_work_queue_op(scheduler::operation* op)
+{
+  thread_info_base* this_thread = thread_call_stack::contains(this);
+  if (!this_thread)
+    return false;
+
+  work_queue* q = static_cast<thread_info*>(this_thread)->private_work_queue;
+  if (!q || !q->push(op))
+    return false;
+
+  // Pairs with the increment of idle_threads_ in do_run_one.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (idle_threads_.load(std::memory_order_relaxed) > 0)
+    wake_one_idle_thread();
+  return true;
+}
+
+bool scheduler::push_work_queue_ops(op_queue<scheduler::operation>& ops)
+{
+  op_queue<operation> remaining_ops;
+  while (operation* op = ops.front())
+  {
+    ops.pop();
+    if (!push_work_queue_op(op))
+    {
+      remaining_ops.push(op);
+      remaining_ops.push(ops);
+      break;
+    }
+  }
+  ops.push(remaining_ops);
+  return ops.empty();
+}
+
+scheduler::operation* scheduler::find_work_queue_op(
+    scheduler::thread_info& this_thread)
+{
+  work_queue* own_queue = this_thread.private_work_queue;
+  if (own_queue)
+    if (operation* o = own_queue->take())
+      return o;
+
+  // Start at a different victim each time to spread the stealing load.
+  std::size_t n = num_work_queues_.load(std::memory_order_acquire);
+  std::size_t start = ++this_thread.private_work_queue_tick;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    work_queue* q = work_queues_[(start + i) % n].queue_;
+    if (q != own_queue)
+      if (operation* o = q->steal())
+        return o;
+  }
+
+  return 0;
+}
+
+void scheduler::wake_one_idle_thread()
+{
+  mutex::scoped_lock lock(mutex_);
+  if (!wakeup_event_.maybe_unlock_and_signal_one(lock))
+    lock.unlock();
+}
+#endif // defined(ASIO_HAS_THREADS)
+
+scheduler_task* scheduler::default_task() const
+{
+  return get_task_ == &scheduler::get_default_task ? task_ : 0;
 }
 
 scheduler_task* scheduler::get_default_task(asio::execution_context& ctx)
@@ -21,6 +21,7 @@
   || (!defined(ASIO_HAS_DEV_POLL) \
       && !defined(ASIO_HAS_EPOLL) \
       && !defined(ASIO_HAS_KQUEUE) \
+      && !defined(ASIO_HAS_POLL) \
       && !defined(ASIO_WINDOWS_RUNTIME))
 
 #if defined(ASIO_HAS_IOCP)
@@ -72,6 +73,7 @@ void select_reactor::schedule_timer(
 
   bool earliest = queue.enqueue_timer(time, timer, op);
   scheduler_.work_started();
+  record_pending_timers();
   if (earliest)
     interrupter_.interrupt();
 }
@@ -85,6 +87,7 @@ std::size_t select_reactor::cancel_timer(
   asio::detail::mutex::scoped_lock lock(mutex_);
   op_queue<operation> ops;
   std::size_t n = queue.cancel_timer(timer, ops, max_cancelled);
+  record_pending_timers();
   lock.unlock();
   scheduler_.post_deferred_completions(ops);
   return n;
@@ -125,6 +128,7 @@ void select_reactor::move_timer(timer_queue<TimeTraits, Allocator>& queue,
        //   || (!defined(ASIO_HAS_DEV_POLL)
        //       && !defined(ASIO_HAS_EPOLL)
        //       && !defined(ASIO_HAS_KQUEUE)
+       //       && !defined(ASIO_HAS_POLL)
        //       && !defined(ASIO_WINDOWS_RUNTIME))
 
 #endif // ASIO_DETAIL_IMPL_SELECT_REACTOR_HPP
@@ -21,6 +21,7 @@
   || (!defined(ASIO_HAS_DEV_POLL) \
       && !defined(ASIO_HAS_EPOLL) \
       && !defined(ASIO_HAS_KQUEUE) \
+      && !defined(ASIO_HAS_POLL) \
       && !defined(ASIO_WINDOWS_RUNTIME))
 
 #include "asio/detail/fd_set_adapter.hpp"
@@ -263,6 +264,7 @@ void select_reactor::run(long usec, op_queue<operation>& ops)
   asio::error_code ec;
   int retval = socket_ops::select(static_cast<int>(max_fd + 1),
       fd_sets_[read_op], fd_sets_[write_op], fd_sets_[except_op], tv, ec);
+  scheduler_.metrics().record_task_run(retval > 0 ? retval : 0);
 
   // Reset the interrupter.
   if (retval > 0 && fd_sets_[read_op].is_set(interrupter_.read_descriptor()))
@@ -297,6 +299,7 @@ void select_reactor::run(long usec, op_queue<operation>& ops)
       fd_sets_[i].perform(op_queue_[i], ops);
   }
   timer_queues_.get_ready_timers(ops);
+  record_pending_timers();
 }
 
 void select_reactor::interrupt()
@@ -350,6 +353,12 @@ void select_reactor::do_remove_timer_queue(timer_queue_base& queue)
   timer_queues_.erase(&queue);
 }
 
+void select_reactor::record_pending_timers()
+{
+  if (scheduler_.metrics().enabled())
+    scheduler_.metrics().record_pending_timers(timer_queues_.total_size());
+}
+
 timeval* select_reactor::get_timeout(long usec, timeval& tv)
 {
   // By default we will wait no longer than 5 minutes. This will ensure that
@@ -384,6 +393,7 @@ void select_reactor::cancel_ops_unlocked(socket_type descriptor,
        //   || (!defined(ASIO_HAS_DEV_POLL)
        //       && !defined(ASIO_HAS_EPOLL)
        //       && !defined(ASIO_HAS_KQUEUE))
+       //       && !defined(ASIO_HAS_POLL)
        //       && !defined(ASIO_WINDOWS_RUNTIME))
 
 #endif // ASIO_DETAIL_IMPL_SELECT_REACTOR_IPP
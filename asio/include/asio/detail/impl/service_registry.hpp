@@ -25,8 +25,11 @@ Service& service_registry::use_service()
 {
   execution_context::service::key key;
   init_key<Service>(key, 0);
+  std::size_t slot = slot_index<Service>();
+  if (execution_context::service* service = find_in_slot(key, slot))
+    return *static_cast<Service*>(service);
   factory_type factory = &service_registry::create<Service, execution_context>;
-  return *static_cast<Service*>(do_use_service(key, factory, &owner_));
+  return *static_cast<Service*>(do_use_service(key, slot, factory, &owner_));
 }
 
 template <typename Service>
@@ -34,8 +37,11 @@ Service& service_registry::use_service(io_context& owner)
 {
   execution_context::service::key key;
   init_key<Service>(key, 0);
+  std::size_t slot = slot_index<Service>();
+  if (execution_context::service* service = find_in_slot(key, slot))
+    return *static_cast<Service*>(service);
   factory_type factory = &service_registry::create<Service, io_context>;
-  return *static_cast<Service*>(do_use_service(key, factory, &owner));
+  return *static_cast<Service*>(do_use_service(key, slot, factory, &owner));
 }
 
 template <typename Service, typename... Args>
@@ -55,7 +61,7 @@ void service_registry::add_service(Service* new_service)
 {
   execution_context::service::key key;
   init_key<Service>(key, 0);
-  return do_add_service(key, new_service);
+  return do_add_service(key, slot_index<Service>(), new_service);
 }
 
 template <typename Service>
@@ -63,9 +69,44 @@ bool service_registry::has_service() const
 {
   execution_context::service::key key;
   init_key<Service>(key, 0);
+  if (find_in_slot(key, slot_index<Service>()))
+    return true;
   return do_has_service(key);
 }
 
+template <typename Service>
+std::size_t service_registry::slot_index()
+{
+  static const std::size_t index = next_slot_index();
+  return index;
+}
+
+inline execution_context::service* service_registry::find_in_slot(
+    const execution_context::service::key& key, std::size_t slot) const
+{
+  if (slot >= ASIO_SERVICE_REGISTRY_SLOTS)
+    return 0;
+
+  // Slot numbers are assigned per program image, so a slot may hold a service
+  // for an unrelated type when services are used from more than one shared
+  // library. Only an identical key is accepted here, and anything else falls
+  // back to a search under the mutex.
+  execution_context::service* service =
+    slots_[slot].load(std::memory_order_acquire);
+  if (service && service->key_.type_info_ == key.type_info_
+      && service->key_.id_ == key.id_)
+    return service;
+  return 0;
+}
+
+inline void service_registry::set_slot(
+    std::size_t slot, execution_context::service* service)
+{
+  if (slot < ASIO_SERVICE_REGISTRY_SLOTS)
+    if (!slots_[slot].load(std::memory_order_relaxed))
+      slots_[slot].store(service, std::memory_order_release);
+}
+
 template <typename Service>
 inline void service_registry::init_key(
     execution_context::service::key& key, ...)
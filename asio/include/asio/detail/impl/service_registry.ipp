@@ -29,6 +29,8 @@ service_registry::service_registry(execution_context& owner)
   : owner_(owner),
     first_service_(0)
 {
+  for (std::size_t i = 0; i < ASIO_SERVICE_REGISTRY_SLOTS; ++i)
+    slots_[i].store(0, std::memory_order_relaxed);
 }
 
 service_registry::~service_registry()
@@ -52,6 +54,11 @@ void service_registry::destroy_services()
     execution_context::service* next_service = first_service_->next_;
     first_service_->destroy_(first_service_);
     first_service_ = next_service;
+
+    // A destructor may have looked up services that are not yet destroyed,
+    // so the lookup table is cleared after each service is destroyed.
+    for (std::size_t i = 0; i < ASIO_SERVICE_REGISTRY_SLOTS; ++i)
+      slots_[i].store(0, std::memory_order_relaxed);
   }
 }
 
@@ -84,6 +91,12 @@ void service_registry::notify_fork(execution_context::fork_event fork_ev)
       services[i - 1]->notify_fork(fork_ev);
 }
 
+std::size_t service_registry::next_slot_index()
+{
+  static std::atomic<std::size_t> next_index(0);
+  return next_index.fetch_add(1, std::memory_order_relaxed);
+}
+
 void service_registry::init_key_from_id(execution_context::service::key& key,
     const execution_context::id& id)
 {
@@ -116,7 +129,7 @@ service_registry::auto_service_ptr::~auto_service_ptr()
 }
 
 execution_context::service* service_registry::do_use_service(
-    const execution_context::service::key& key,
+    const execution_context::service::key& key, std::size_t slot,
     factory_type factory, void* owner)
 {
   asio::detail::mutex::scoped_lock lock(mutex_);
@@ -126,7 +139,10 @@ execution_context::service* service_registry::do_use_service(
   while (service)
   {
     if (keys_match(service->key_, key))
+    {
+      set_slot(slot, service);
       return service;
+    }
     service = service->next_;
   }
 
@@ -144,7 +160,10 @@ execution_context::service* service_registry::do_use_service(
   while (service)
   {
     if (keys_match(service->key_, key))
+    {
+      set_slot(slot, service);
       return service;
+    }
     service = service->next_;
   }
 
@@ -152,11 +171,12 @@ execution_context::service* service_registry::do_use_service(
   new_service.ptr_->next_ = first_service_;
   first_service_ = new_service.ptr_;
   new_service.ptr_ = 0;
+  set_slot(slot, first_service_);
   return first_service_;
 }
 
 void service_registry::do_add_service(
-    const execution_context::service::key& key,
+    const execution_context::service::key& key, std::size_t slot,
     execution_context::service* new_service)
 {
   if (&owner_ != &new_service->context())
@@ -179,6 +199,7 @@ void service_registry::do_add_service(
   new_service->key_ = key;
   new_service->next_ = first_service_;
   first_service_ = new_service;
+  set_slot(slot, new_service);
 }
 
 bool service_registry::do_has_service(
@@ -19,6 +19,7 @@
 
 #include <cstring>
 #include <stdexcept>
+#include "asio/config.hpp"
 #include "asio/detail/signal_blocker.hpp"
 #include "asio/detail/signal_set_service.hpp"
 #include "asio/detail/static_mutex.hpp"
@@ -30,6 +31,10 @@
 # include "asio/detail/reactor.hpp"
 #endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
 
+#if defined(ASIO_HAS_SIGNALFD)
+# include <sys/signalfd.h>
+#endif // defined(ASIO_HAS_SIGNALFD)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -119,14 +124,7 @@ public:
 
   static bool do_perform(io_uring_operation*, bool)
   {
-    signal_state* state = get_signal_state();
-
-    int fd = state->read_descriptor_;
-    int signal_number = 0;
-    while (::read(fd, &signal_number, sizeof(int)) == sizeof(int))
-      if (signal_number >= 0 && signal_number < max_signal_number)
-        signal_set_service::deliver_signal(signal_number);
-
+    read_signals();
     return false;
   }
 # else // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
@@ -137,31 +135,162 @@ public:
   }
 
   static status do_perform(reactor_op*)
+  {
+    read_signals();
+    return not_done;
+  }
+# endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
+  // Read all pending signal numbers from the pipe. Each write to the pipe is
+  // of a single int, and so is atomic, and the signals read together are
+  // delivered as one batch.
+  static void read_signals()
   {
     signal_state* state = get_signal_state();
 
     int fd = state->read_descriptor_;
-    int signal_number = 0;
-    while (::read(fd, &signal_number, sizeof(int)) == sizeof(int))
-      if (signal_number >= 0 && signal_number < max_signal_number)
-        signal_set_service::deliver_signal(signal_number);
+    int signal_numbers[64];
+    signed_size_type bytes = 0;
+    while ((bytes = ::read(fd, signal_numbers, sizeof(signal_numbers))) > 0)
+    {
+      signal_set_service::deliver_signals(signal_numbers,
+          static_cast<std::size_t>(bytes) / sizeof(int));
+    }
+  }
+
+  static void do_complete(void* /*owner*/, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    pipe_read_op* o(static_cast<pipe_read_op*>(base));
+    delete o;
+  }
+};
+
+# if defined(ASIO_HAS_SIGNALFD)
+class signal_set_service::signalfd_read_op :
+#  if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  public io_uring_operation
+#  else // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  public reactor_op
+#  endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+{
+public:
+#  if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  explicit signalfd_read_op(signal_set_service* service)
+    : io_uring_operation(asio::error_code(), &signalfd_read_op::do_prepare,
+        &signalfd_read_op::do_perform, signalfd_read_op::do_complete),
+      service_(service)
+  {
+  }
+
+  static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
+  {
+    signalfd_read_op* o(static_cast<signalfd_read_op*>(base));
+    ::io_uring_prep_poll_add(sqe, o->service_->signal_fd_, POLLIN);
+  }
+
+  static bool do_perform(io_uring_operation* base, bool)
+  {
+    static_cast<signalfd_read_op*>(base)->read_signals();
+    return false;
+  }
+#  else // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  explicit signalfd_read_op(signal_set_service* service)
+    : reactor_op(asio::error_code(),
+        &signalfd_read_op::do_perform, signalfd_read_op::do_complete),
+      service_(service)
+  {
+  }
 
+  static status do_perform(reactor_op* base)
+  {
+    static_cast<signalfd_read_op*>(base)->read_signals();
     return not_done;
   }
-# endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+#  endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
 
   static void do_complete(void* /*owner*/, operation* base,
       const asio::error_code& /*ec*/,
       std::size_t /*bytes_transferred*/)
   {
-    pipe_read_op* o(static_cast<pipe_read_op*>(base));
+    signalfd_read_op* o(static_cast<signalfd_read_op*>(base));
     delete o;
   }
+
+private:
+  // Read all pending signals from the signalfd. The signals read together are
+  // delivered as one batch, under the service's own mutex.
+  void read_signals()
+  {
+    enum { max_signals = 16 };
+    ::signalfd_siginfo info[max_signals];
+    signed_size_type bytes = 0;
+    while ((bytes = ::read(service_->signal_fd_, info, sizeof(info))) > 0)
+    {
+      std::size_t count = static_cast<std::size_t>(bytes) / sizeof(info[0]);
+
+      op_queue<operation> ops;
+      mutex::scoped_lock lock(service_->mutex_);
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        int signal_number = static_cast<int>(info[i].ssi_signo);
+        if (signal_number >= 0 && signal_number < max_signal_number)
+          service_->collect_signal(signal_number, ops);
+      }
+      service_->scheduler_.post_deferred_completions(ops);
+    }
+  }
+
+  signal_set_service* service_;
 };
+# endif // defined(ASIO_HAS_SIGNALFD)
 #endif // !defined(ASIO_WINDOWS)
        //   && !defined(ASIO_WINDOWS_RUNTIME)
        //   && !defined(__CYGWIN__)
 
+// Locks the state used for signal delivery. When signals are received using
+// a signalfd, this state is private to the service and is protected by the
+// service's own mutex. Otherwise it is shared with the signal handler and all
+// other services.
+class signal_set_service::state_lock
+  : private asio::detail::noncopyable
+{
+public:
+  explicit state_lock(signal_set_service* service)
+#if defined(ASIO_HAS_SIGNALFD)
+    : service_mutex_(service->use_signalfd_ ? &service->mutex_ : 0)
+#endif // defined(ASIO_HAS_SIGNALFD)
+  {
+    (void)service;
+#if defined(ASIO_HAS_SIGNALFD)
+    if (service_mutex_)
+    {
+      service_mutex_->lock();
+      return;
+    }
+#endif // defined(ASIO_HAS_SIGNALFD)
+    get_signal_state()->mutex_.lock();
+  }
+
+  ~state_lock()
+  {
+#if defined(ASIO_HAS_SIGNALFD)
+    if (service_mutex_)
+    {
+      service_mutex_->unlock();
+      return;
+    }
+#endif // defined(ASIO_HAS_SIGNALFD)
+    get_signal_state()->mutex_.unlock();
+  }
+
+private:
+#if defined(ASIO_HAS_SIGNALFD)
+  mutex* service_mutex_;
+#endif // defined(ASIO_HAS_SIGNALFD)
+};
+
 signal_set_service::signal_set_service(execution_context& context)
   : execution_context_service_base<signal_set_service>(context),
     scheduler_(asio::use_service<scheduler_impl>(context)),
@@ -173,6 +302,10 @@ signal_set_service::signal_set_service(execution_context& context)
 # else // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
     reactor_(asio::use_service<reactor>(context)),
 # endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+# if defined(ASIO_HAS_SIGNALFD)
+    use_signalfd_(config(context).get("signal", "signalfd", false)),
+    signal_fd_(-1),
+# endif // defined(ASIO_HAS_SIGNALFD)
 #endif // !defined(ASIO_WINDOWS)
        //   && !defined(ASIO_WINDOWS_RUNTIME)
        //   && !defined(__CYGWIN__)
@@ -181,6 +314,10 @@ signal_set_service::signal_set_service(execution_context& context)
 {
   get_signal_state()->mutex_.init();
 
+#if defined(ASIO_HAS_SIGNALFD)
+  sigemptyset(&signal_fd_mask_);
+#endif // defined(ASIO_HAS_SIGNALFD)
+
 #if !defined(ASIO_WINDOWS) \
   && !defined(ASIO_WINDOWS_RUNTIME) \
   && !defined(__CYGWIN__)
@@ -228,6 +365,19 @@ void signal_set_service::notify_fork(execution_context::fork_event fork_ev)
 #if !defined(ASIO_WINDOWS) \
   && !defined(ASIO_WINDOWS_RUNTIME) \
   && !defined(__CYGWIN__)
+# if defined(ASIO_HAS_SIGNALFD)
+  // The signalfd remains valid in the child, where it receives the signals
+  // sent to the child.
+  if (use_signalfd_)
+  {
+    if (fork_ev == execution_context::fork_prepare)
+      deregister_signal_fd();
+    else
+      register_signal_fd();
+    return;
+  }
+# endif // defined(ASIO_HAS_SIGNALFD)
+
   signal_state* state = get_signal_state();
   static_mutex::scoped_lock lock(state->mutex_);
 
@@ -330,7 +480,7 @@ asio::error_code signal_set_service::add(
 #endif // !defined(ASIO_HAS_SIGACTION)
 
   signal_state* state = get_signal_state();
-  static_mutex::scoped_lock lock(state->mutex_);
+  state_lock lock(this);
 
   // Find the appropriate place to insert the registration.
   registration** insertion_point = &impl.signals_;
@@ -346,6 +496,28 @@ asio::error_code signal_set_service::add(
   {
     registration* new_registration = new registration;
 
+#if defined(ASIO_HAS_SIGNALFD)
+    // Add the signal to the signalfd's mask if we're the first in this
+    // service. The signal's disposition is not changed.
+    if (use_signalfd_)
+    {
+      if (f != signal_set_base::flags::dont_care)
+      {
+        ec = asio::error::operation_not_supported;
+        delete new_registration;
+        return ec;
+      }
+      if (registrations_[signal_number] == 0)
+      {
+        if (update_signal_fd(signal_number, true, ec))
+        {
+          delete new_registration;
+          return ec;
+        }
+      }
+    }
+    else
+#endif // defined(ASIO_HAS_SIGNALFD)
 #if defined(ASIO_HAS_SIGNAL) || defined(ASIO_HAS_SIGACTION)
     // Register for the signal if we're the first.
     if (state->registration_count_[signal_number] == 0)
@@ -419,7 +591,10 @@ asio::error_code signal_set_service::add(
       registrations_[signal_number]->prev_in_table_ = new_registration;
     registrations_[signal_number] = new_registration;
 
-    ++state->registration_count_[signal_number];
+#if defined(ASIO_HAS_SIGNALFD)
+    if (!use_signalfd_)
+#endif // defined(ASIO_HAS_SIGNALFD)
+      ++state->registration_count_[signal_number];
   }
 
   ec = asio::error_code();
@@ -438,7 +613,7 @@ asio::error_code signal_set_service::remove(
   }
 
   signal_state* state = get_signal_state();
-  static_mutex::scoped_lock lock(state->mutex_);
+  state_lock lock(this);
 
   // Find the signal number in the list of registrations.
   registration** deletion_point = &impl.signals_;
@@ -451,6 +626,17 @@ asio::error_code signal_set_service::remove(
 
   if (reg != 0 && reg->signal_number_ == signal_number)
   {
+#if defined(ASIO_HAS_SIGNALFD)
+    // Remove the signal from the signalfd's mask if we're the last in this
+    // service.
+    if (use_signalfd_)
+    {
+      if (!reg->prev_in_table_ && !reg->next_in_table_)
+        if (update_signal_fd(signal_number, false, ec))
+          return ec;
+    }
+    else
+#endif // defined(ASIO_HAS_SIGNALFD)
 #if defined(ASIO_HAS_SIGNAL) || defined(ASIO_HAS_SIGACTION)
     // Set signal handler back to the default if we're the last.
     if (state->registration_count_[signal_number] == 1)
@@ -490,7 +676,10 @@ asio::error_code signal_set_service::remove(
     if (reg->next_in_table_)
       reg->next_in_table_->prev_in_table_ = reg->prev_in_table_;
 
-    --state->registration_count_[signal_number];
+#if defined(ASIO_HAS_SIGNALFD)
+    if (!use_signalfd_)
+#endif // defined(ASIO_HAS_SIGNALFD)
+      --state->registration_count_[signal_number];
 
     delete reg;
   }
@@ -504,10 +693,21 @@ asio::error_code signal_set_service::clear(
     asio::error_code& ec)
 {
   signal_state* state = get_signal_state();
-  static_mutex::scoped_lock lock(state->mutex_);
+  state_lock lock(this);
 
   while (registration* reg = impl.signals_)
   {
+#if defined(ASIO_HAS_SIGNALFD)
+    // Remove the signal from the signalfd's mask if we're the last in this
+    // service.
+    if (use_signalfd_)
+    {
+      if (!reg->prev_in_table_ && !reg->next_in_table_)
+        if (update_signal_fd(reg->signal_number_, false, ec))
+          return ec;
+    }
+    else
+#endif // defined(ASIO_HAS_SIGNALFD)
 #if defined(ASIO_HAS_SIGNAL) || defined(ASIO_HAS_SIGACTION)
     // Set signal handler back to the default if we're the last.
     if (state->registration_count_[reg->signal_number_] == 1)
@@ -544,7 +744,10 @@ asio::error_code signal_set_service::clear(
     if (reg->next_in_table_)
       reg->next_in_table_->prev_in_table_ = reg->prev_in_table_;
 
-    --state->registration_count_[reg->signal_number_];
+#if defined(ASIO_HAS_SIGNALFD)
+    if (!use_signalfd_)
+#endif // defined(ASIO_HAS_SIGNALFD)
+      --state->registration_count_[reg->signal_number_];
 
     impl.signals_ = reg->next_in_set_;
     delete reg;
@@ -563,8 +766,7 @@ asio::error_code signal_set_service::cancel(
 
   op_queue<operation> ops;
   {
-    signal_state* state = get_signal_state();
-    static_mutex::scoped_lock lock(state->mutex_);
+    state_lock lock(this);
 
     while (signal_op* op = impl.queue_.front())
     {
@@ -586,8 +788,7 @@ void signal_set_service::cancel_ops_by_key(
   op_queue<operation> ops;
   {
     op_queue<signal_op> other_ops;
-    signal_state* state = get_signal_state();
-    static_mutex::scoped_lock lock(state->mutex_);
+    state_lock lock(this);
 
     while (signal_op* op = impl.queue_.front())
     {
@@ -608,6 +809,12 @@ void signal_set_service::cancel_ops_by_key(
 }
 
 void signal_set_service::deliver_signal(int signal_number)
+{
+  deliver_signals(&signal_number, 1);
+}
+
+void signal_set_service::deliver_signals(
+    const int* signal_numbers, std::size_t count)
 {
   signal_state* state = get_signal_state();
   static_mutex::scoped_lock lock(state->mutex_);
@@ -617,34 +824,61 @@ void signal_set_service::deliver_signal(int signal_number)
   {
     op_queue<operation> ops;
 
-    registration* reg = service->registrations_[signal_number];
-    while (reg)
+    for (std::size_t i = 0; i < count; ++i)
+      if (signal_numbers[i] >= 0 && signal_numbers[i] < max_signal_number)
+        service->collect_signal(signal_numbers[i], ops);
+
+    service->scheduler_.post_deferred_completions(ops);
+
+    service = service->next_;
+  }
+}
+
+void signal_set_service::collect_signal(
+    int signal_number, op_queue<operation>& ops)
+{
+  registration* reg = registrations_[signal_number];
+  while (reg)
+  {
+    if (reg->queue_->empty())
     {
-      if (reg->queue_->empty())
-      {
-        ++reg->undelivered_;
-      }
-      else
+      ++reg->undelivered_;
+    }
+    else
+    {
+      while (signal_op* op = reg->queue_->front())
       {
-        while (signal_op* op = reg->queue_->front())
-        {
-          op->signal_number_ = signal_number;
-          reg->queue_->pop();
-          ops.push(op);
-        }
+        op->signal_number_ = signal_number;
+        reg->queue_->pop();
+        ops.push(op);
       }
-
-      reg = reg->next_in_table_;
     }
 
-    service->scheduler_.post_deferred_completions(ops);
-
-    service = service->next_;
+    reg = reg->next_in_table_;
   }
 }
 
 void signal_set_service::add_service(signal_set_service* service)
 {
+#if defined(ASIO_HAS_SIGNALFD)
+  // A service that uses a signalfd is not added to the list of services that
+  // receive signals from the signal handler.
+  if (service->use_signalfd_)
+  {
+    sigset_t mask;
+    sigemptyset(&mask);
+    service->signal_fd_ = ::signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (service->signal_fd_ == -1)
+    {
+      asio::error_code ec(errno,
+          asio::error::get_system_category());
+      asio::detail::throw_error(ec, "signal_set_service signalfd");
+    }
+    service->register_signal_fd();
+    return;
+  }
+#endif // defined(ASIO_HAS_SIGNALFD)
+
   signal_state* state = get_signal_state();
   static_mutex::scoped_lock lock(state->mutex_);
 
@@ -697,6 +931,19 @@ void signal_set_service::add_service(signal_set_service* service)
 
 void signal_set_service::remove_service(signal_set_service* service)
 {
+#if defined(ASIO_HAS_SIGNALFD)
+  if (service->use_signalfd_)
+  {
+    if (service->signal_fd_ != -1)
+    {
+      service->deregister_signal_fd();
+      ::close(service->signal_fd_);
+      service->signal_fd_ = -1;
+    }
+    return;
+  }
+#endif // defined(ASIO_HAS_SIGNALFD)
+
   signal_state* state = get_signal_state();
   static_mutex::scoped_lock lock(state->mutex_);
 
@@ -792,13 +1039,57 @@ void signal_set_service::close_descriptors()
        //   && !defined(__CYGWIN__)
 }
 
+#if defined(ASIO_HAS_SIGNALFD)
+asio::error_code signal_set_service::update_signal_fd(
+    int signal_number, bool add, asio::error_code& ec)
+{
+  sigset_t mask = signal_fd_mask_;
+  if (add)
+    sigaddset(&mask, signal_number);
+  else
+    sigdelset(&mask, signal_number);
+
+  if (::signalfd(signal_fd_, &mask, 0) == -1)
+  {
+    ec = asio::error_code(errno,
+        asio::error::get_system_category());
+    return ec;
+  }
+
+  signal_fd_mask_ = mask;
+  ec = asio::error_code();
+  return ec;
+}
+
+void signal_set_service::register_signal_fd()
+{
+# if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  io_uring_service_.register_internal_io_object(io_object_data_,
+      io_uring_service::read_op, new signalfd_read_op(this));
+# else // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  reactor_.register_internal_descriptor(reactor::read_op,
+      signal_fd_, reactor_data_, new signalfd_read_op(this));
+# endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+}
+
+void signal_set_service::deregister_signal_fd()
+{
+# if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  io_uring_service_.deregister_io_object(io_object_data_);
+  io_uring_service_.cleanup_io_object(io_object_data_);
+# else // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  reactor_.deregister_internal_descriptor(signal_fd_, reactor_data_);
+  reactor_.cleanup_descriptor_data(reactor_data_);
+# endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+}
+#endif // defined(ASIO_HAS_SIGNALFD)
+
 void signal_set_service::start_wait_op(
     signal_set_service::implementation_type& impl, signal_op* op)
 {
   scheduler_.work_started();
 
-  signal_state* state = get_signal_state();
-  static_mutex::scoped_lock lock(state->mutex_);
+  state_lock lock(this);
 
   registration* reg = impl.signals_;
   while (reg)
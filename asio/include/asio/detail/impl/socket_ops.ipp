@@ -26,6 +26,7 @@
 #include "asio/detail/assert.hpp"
 #include "asio/detail/socket_ops.hpp"
 #include "asio/error.hpp"
+#include "asio/transport_info.hpp"
 
 #if defined(ASIO_WINDOWS_RUNTIME)
 # include <codecvt>
@@ -45,6 +46,12 @@
 # include <malloc.h>
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1800)
 
+#if (defined(ASIO_WINDOWS) || defined(__CYGWIN__)) \
+  && !defined(ASIO_WINDOWS_APP) && !defined(ASIO_WINDOWS_RUNTIME)
+# include <mstcpip.h>
+#endif // (defined(ASIO_WINDOWS) || defined(__CYGWIN__))
+       //   && !defined(ASIO_WINDOWS_APP) && !defined(ASIO_WINDOWS_RUNTIME)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -96,6 +103,22 @@ inline void get_last_error(
   }
 }
 
+// Determine whether the error from a failed socket call means that the
+// operation would block. Such errors are always in the system category, so
+// only the native value is compared.
+inline bool is_would_block(const asio::error_code& ec)
+{
+  return ec.value() == asio::error::would_block
+    || ec.value() == asio::error::try_again;
+}
+
+// Determine whether the error from a failed socket call means that the call
+// was interrupted by a signal.
+inline bool is_interrupted(const asio::error_code& ec)
+{
+  return ec.value() == asio::error::interrupted;
+}
+
 template <typename SockLenType>
 inline socket_type call_accept(SockLenType msghdr::*,
     socket_type s, void* addr, std::size_t* addrlen)
@@ -153,8 +176,7 @@ socket_type sync_accept(socket_type s, state_type state,
       return new_socket;
 
     // Operation failed.
-    if (ec == asio::error::would_block
-        || ec == asio::error::try_again)
+    if (is_would_block(ec))
     {
       if (state & user_set_non_blocking)
         return invalid_socket;
@@ -243,12 +265,11 @@ bool non_blocking_accept(socket_type s,
       return true;
 
     // Retry operation if interrupted by signal.
-    if (ec == asio::error::interrupted)
+    if (is_interrupted(ec))
       continue;
 
     // Operation failed.
-    if (ec == asio::error::would_block
-        || ec == asio::error::try_again)
+    if (is_would_block(ec))
     {
       // Fall through to retry operation.
     }
@@ -323,9 +344,7 @@ int close(socket_type s, state_type& state,
 #endif // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
     get_last_error(ec, result != 0);
 
-    if (result != 0
-        && (ec == asio::error::would_block
-          || ec == asio::error::try_again))
+    if (result != 0 && is_would_block(ec))
     {
       // According to UNIX Network Programming Vol. 1, it is possible for
       // close() to fail with EWOULDBLOCK under certain circumstances. What
@@ -912,9 +931,7 @@ size_t sync_recv(socket_type s, state_type state, buf* bufs,
       return bytes;
 
     // Operation failed.
-    if ((state & user_set_non_blocking)
-        || (ec != asio::error::would_block
-          && ec != asio::error::try_again))
+    if ((state & user_set_non_blocking) || !is_would_block(ec))
       return 0;
 
     // Wait for socket to become ready.
@@ -957,9 +974,7 @@ size_t sync_recv1(socket_type s, state_type state, void* data,
       return bytes;
 
     // Operation failed.
-    if ((state & user_set_non_blocking)
-        || (ec != asio::error::would_block
-          && ec != asio::error::try_again))
+    if ((state & user_set_non_blocking) || !is_would_block(ec))
       return 0;
 
     // Wait for socket to become ready.
@@ -1026,12 +1041,11 @@ bool non_blocking_recv(socket_type s,
     }
 
     // Retry operation if interrupted by signal.
-    if (ec == asio::error::interrupted)
+    if (is_interrupted(ec))
       continue;
 
     // Check if we need to run the operation again.
-    if (ec == asio::error::would_block
-        || ec == asio::error::try_again)
+    if (is_would_block(ec))
       return false;
 
     // Operation failed.
@@ -1064,12 +1078,11 @@ bool non_blocking_recv1(socket_type s,
     }
 
     // Retry operation if interrupted by signal.
-    if (ec == asio::error::interrupted)
+    if (is_interrupted(ec))
       continue;
 
     // Check if we need to run the operation again.
-    if (ec == asio::error::would_block
-        || ec == asio::error::try_again)
+    if (is_would_block(ec))
       return false;
 
     // Operation failed.
@@ -1182,9 +1195,7 @@ size_t sync_recvfrom(socket_type s, state_type state, buf* bufs, size_t count,
       return bytes;
 
     // Operation failed.
-    if ((state & user_set_non_blocking)
-        || (ec != asio::error::would_block
-          && ec != asio::error::try_again))
+    if ((state & user_set_non_blocking) || !is_would_block(ec))
       return 0;
 
     // Wait for socket to become ready.
@@ -1214,9 +1225,7 @@ size_t sync_recvfrom1(socket_type s, state_type state, void* data, size_t size,
       return bytes;
 
     // Operation failed.
-    if ((state & user_set_non_blocking)
-        || (ec != asio::error::would_block
-          && ec != asio::error::try_again))
+    if ((state & user_set_non_blocking) || !is_would_block(ec))
       return 0;
 
     // Wait for socket to become ready.
@@ -1269,12 +1278,11 @@ bool non_blocking_recvfrom(socket_type s, buf* bufs,
     }
 
     // Retry operation if interrupted by signal.
-    if (ec == asio::error::interrupted)
+    if (is_interrupted(ec))
       continue;
 
     // Check if we need to run the operation again.
-    if (ec == asio::error::would_block
-        || ec == asio::error::try_again)
+    if (is_would_block(ec))
       return false;
 
     // Operation failed.
@@ -1301,12 +1309,11 @@ bool non_blocking_recvfrom1(socket_type s, void* data,
     }
 
     // Retry operation if interrupted by signal.
-    if (ec == asio::error::interrupted)
+    if (is_interrupted(ec))
       continue;
 
     // Check if we need to run the operation again.
-    if (ec == asio::error::would_block
-        || ec == asio::error::try_again)
+    if (is_would_block(ec))
       return false;
 
     // Operation failed.
@@ -1359,9 +1366,7 @@ size_t sync_recvmsg(socket_type s, state_type state,
       return bytes;
 
     // Operation failed.
-    if ((state & user_set_non_blocking)
-        || (ec != asio::error::would_block
-          && ec != asio::error::try_again))
+    if ((state & user_set_non_blocking) || !is_would_block(ec))
       return 0;
 
     // Wait for socket to become ready.
@@ -1414,12 +1419,11 @@ bool non_blocking_recvmsg(socket_type s,
     }
 
     // Retry operation if interrupted by signal.
-    if (ec == asio::error::interrupted)
+    if (is_interrupted(ec))
       continue;
 
     // Check if we need to run the operation again.
-    if (ec == asio::error::would_block
-        || ec == asio::error::try_again)
+    if (is_would_block(ec))
       return false;
 
     // Operation failed.
@@ -1521,9 +1525,7 @@ size_t sync_send(socket_type s, state_type state, const buf* bufs,
       return bytes;
 
     // Operation failed.
-    if ((state & user_set_non_blocking)
-        || (ec != asio::error::would_block
-          && ec != asio::error::try_again))
+    if ((state & user_set_non_blocking) || !is_would_block(ec))
       return 0;
 
     // Wait for socket to become ready.
@@ -1559,9 +1561,7 @@ size_t sync_send1(socket_type s, state_type state, const void* data,
       return bytes;
 
     // Operation failed.
-    if ((state & user_set_non_blocking)
-        || (ec != asio::error::would_block
-          && ec != asio::error::try_again))
+    if ((state & user_set_non_blocking) || !is_would_block(ec))
       return 0;
 
     // Wait for socket to become ready.
@@ -1609,12 +1609,11 @@ bool non_blocking_send(socket_type s,
     }
 
     // Retry operation if interrupted by signal.
-    if (ec == asio::error::interrupted)
+    if (is_interrupted(ec))
       continue;
 
     // Check if we need to run the operation again.
-    if (ec == asio::error::would_block
-        || ec == asio::error::try_again)
+    if (is_would_block(ec))
       return false;
 
     // Operation failed.
@@ -1640,12 +1639,11 @@ bool non_blocking_send1(socket_type s,
     }
 
     // Retry operation if interrupted by signal.
-    if (ec == asio::error::interrupted)
+    if (is_interrupted(ec))
       continue;
 
     // Check if we need to run the operation again.
-    if (ec == asio::error::would_block
-        || ec == asio::error::try_again)
+    if (is_would_block(ec))
       return false;
 
     // Operation failed.
@@ -1756,9 +1754,7 @@ size_t sync_sendto(socket_type s, state_type state,
       return bytes;
 
     // Operation failed.
-    if ((state & user_set_non_blocking)
-        || (ec != asio::error::would_block
-          && ec != asio::error::try_again))
+    if ((state & user_set_non_blocking) || !is_would_block(ec))
       return 0;
 
     // Wait for socket to become ready.
@@ -1789,9 +1785,7 @@ size_t sync_sendto1(socket_type s, state_type state,
       return bytes;
 
     // Operation failed.
-    if ((state & user_set_non_blocking)
-        || (ec != asio::error::would_block
-          && ec != asio::error::try_again))
+    if ((state & user_set_non_blocking) || !is_would_block(ec))
       return 0;
 
     // Wait for socket to become ready.
@@ -1821,12 +1815,11 @@ bool non_blocking_sendto(socket_type s,
     }
 
     // Retry operation if interrupted by signal.
-    if (ec == asio::error::interrupted)
+    if (is_interrupted(ec))
       continue;
 
     // Check if we need to run the operation again.
-    if (ec == asio::error::would_block
-        || ec == asio::error::try_again)
+    if (is_would_block(ec))
       return false;
 
     // Operation failed.
@@ -1854,12 +1847,11 @@ bool non_blocking_sendto1(socket_type s,
     }
 
     // Retry operation if interrupted by signal.
-    if (ec == asio::error::interrupted)
+    if (is_interrupted(ec))
       continue;
 
     // Check if we need to run the operation again.
-    if (ec == asio::error::would_block
-        || ec == asio::error::try_again)
+    if (is_would_block(ec))
       return false;
 
     // Operation failed.
@@ -1870,6 +1862,805 @@ bool non_blocking_sendto1(socket_type s,
 
 #endif // !defined(ASIO_HAS_IOCP)
 
+#if defined(ASIO_HAS_DATAGRAM_BATCH)
+
+signed_size_type recvmmsg(socket_type s, mmsghdr_type* msgs,
+    size_t count, int flags, asio::error_code& ec)
+{
+#if defined(ASIO_HAS_MMSG)
+  signed_size_type result = ::recvmmsg(s, msgs,
+      static_cast<unsigned int>(count), flags, 0);
+  get_last_error(ec, result < 0);
+  return result;
+#else // defined(ASIO_HAS_MMSG)
+  // Emulate the batch using one call per message. As with recvmmsg, an error
+  // after at least one message has been received is not reported.
+  size_t n = 0;
+  for (; n < count; ++n)
+  {
+    signed_size_type bytes = ::recvmsg(s, &msgs[n].msg_hdr, flags);
+    get_last_error(ec, bytes < 0);
+    if (bytes < 0)
+      break;
+    msgs[n].msg_len = static_cast<unsigned int>(bytes);
+  }
+  if (n == 0 && count > 0)
+    return socket_error_retval;
+  asio::error::clear(ec);
+  return static_cast<signed_size_type>(n);
+#endif // defined(ASIO_HAS_MMSG)
+}
+
+bool non_blocking_recvmmsg(socket_type s, mmsghdr_type* msgs,
+    size_t count, int flags, asio::error_code& ec, size_t& messages)
+{
+  for (;;)
+  {
+    // Read some messages.
+    signed_size_type result = socket_ops::recvmmsg(
+        s, msgs, count, flags, ec);
+
+    // Check if operation succeeded.
+    if (result >= 0)
+    {
+      messages = result;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (is_interrupted(ec))
+      continue;
+
+    // Check if we need to run the operation again.
+    if (is_would_block(ec))
+      return false;
+
+    // Operation failed.
+    messages = 0;
+    return true;
+  }
+}
+
+signed_size_type sendmmsg(socket_type s, mmsghdr_type* msgs,
+    size_t count, int flags, asio::error_code& ec)
+{
+#if defined(ASIO_HAS_MSG_NOSIGNAL)
+  flags |= MSG_NOSIGNAL;
+#endif // defined(ASIO_HAS_MSG_NOSIGNAL)
+#if defined(ASIO_HAS_MMSG)
+  signed_size_type result = ::sendmmsg(s, msgs,
+      static_cast<unsigned int>(count), flags);
+  get_last_error(ec, result < 0);
+  return result;
+#else // defined(ASIO_HAS_MMSG)
+  // Emulate the batch using one call per message. As with sendmmsg, an error
+  // after at least one message has been sent is not reported.
+  size_t n = 0;
+  for (; n < count; ++n)
+  {
+    signed_size_type bytes = ::sendmsg(s, &msgs[n].msg_hdr, flags);
+    get_last_error(ec, bytes < 0);
+    if (bytes < 0)
+      break;
+    msgs[n].msg_len = static_cast<unsigned int>(bytes);
+  }
+  if (n == 0 && count > 0)
+    return socket_error_retval;
+  asio::error::clear(ec);
+  return static_cast<signed_size_type>(n);
+#endif // defined(ASIO_HAS_MMSG)
+}
+
+bool non_blocking_sendmmsg(socket_type s, mmsghdr_type* msgs,
+    size_t count, int flags, asio::error_code& ec, size_t& messages)
+{
+  for (;;)
+  {
+    // Write some messages.
+    signed_size_type result = socket_ops::sendmmsg(
+        s, msgs, count, flags, ec);
+
+    // Check if operation succeeded.
+    if (result >= 0)
+    {
+      messages = result;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (is_interrupted(ec))
+      continue;
+
+    // Check if we need to run the operation again.
+    if (is_would_block(ec))
+      return false;
+
+    // Operation failed.
+    messages = 0;
+    return true;
+  }
+}
+
+#endif // defined(ASIO_HAS_DATAGRAM_BATCH)
+
+#if defined(ASIO_HAS_UDP_OFFLOAD)
+
+void init_send_segment_control(msghdr& msg,
+    segment_control_type& control, std::size_t segment_size)
+{
+  std::memset(&control, 0, sizeof(control));
+  msg.msg_control = control.data;
+  msg.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = ASIO_OS_DEF(IPPROTO_UDP);
+  cmsg->cmsg_type = ASIO_OS_DEF(UDP_SEGMENT);
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+  uint16_t value = static_cast<uint16_t>(segment_size);
+  std::memcpy(CMSG_DATA(cmsg), &value, sizeof(value));
+}
+
+void init_recv_segment_control(msghdr& msg, segment_control_type& control)
+{
+  msg.msg_control = control.data;
+  msg.msg_controllen = sizeof(control.data);
+}
+
+std::size_t get_recv_segment_size(
+    const msghdr& msg, std::size_t bytes_transferred)
+{
+  msghdr& m = const_cast<msghdr&>(msg);
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&m); cmsg; cmsg = CMSG_NXTHDR(&m, cmsg))
+  {
+    if (cmsg->cmsg_level == ASIO_OS_DEF(IPPROTO_UDP)
+        && cmsg->cmsg_type == ASIO_OS_DEF(UDP_GRO)
+        && cmsg->cmsg_len >= CMSG_LEN(sizeof(int)))
+    {
+      int value = 0;
+      std::memcpy(&value, CMSG_DATA(cmsg), sizeof(value));
+      if (value > 0)
+        return static_cast<std::size_t>(value);
+    }
+  }
+
+  // A datagram that was not coalesced is reported as a single segment.
+  return bytes_transferred;
+}
+
+signed_size_type send_segments(socket_type s, const buf* bufs,
+    size_t count, int flags, const void* addr, std::size_t addrlen,
+    std::size_t segment_size, asio::error_code& ec)
+{
+  msghdr msg = msghdr();
+  if (addr)
+  {
+    init_msghdr_msg_name(msg.msg_name, addr);
+    msg.msg_namelen = static_cast<int>(addrlen);
+  }
+  msg.msg_iov = const_cast<buf*>(bufs);
+  msg.msg_iovlen = static_cast<int>(count);
+  segment_control_type control;
+  init_send_segment_control(msg, control, segment_size);
+#if defined(ASIO_HAS_MSG_NOSIGNAL)
+  flags |= MSG_NOSIGNAL;
+#endif // defined(ASIO_HAS_MSG_NOSIGNAL)
+  signed_size_type result = ::sendmsg(s, &msg, flags);
+  get_last_error(ec, result < 0);
+  return result;
+}
+
+bool non_blocking_send_segments(socket_type s, const buf* bufs,
+    size_t count, int flags, const void* addr, std::size_t addrlen,
+    std::size_t segment_size, asio::error_code& ec,
+    size_t& bytes_transferred)
+{
+  for (;;)
+  {
+    // Write some data.
+    signed_size_type bytes = socket_ops::send_segments(s, bufs,
+        count, flags, addr, addrlen, segment_size, ec);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+    {
+      bytes_transferred = bytes;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (is_interrupted(ec))
+      continue;
+
+    // Check if we need to run the operation again.
+    if (is_would_block(ec))
+      return false;
+
+    // Operation failed.
+    bytes_transferred = 0;
+    return true;
+  }
+}
+
+signed_size_type recv_coalesced(socket_type s, buf* bufs, size_t count,
+    int flags, void* addr, std::size_t* addrlen,
+    std::size_t& segment_size, asio::error_code& ec)
+{
+  msghdr msg = msghdr();
+  if (addr)
+  {
+    init_msghdr_msg_name(msg.msg_name, addr);
+    msg.msg_namelen = static_cast<int>(*addrlen);
+  }
+  msg.msg_iov = bufs;
+  msg.msg_iovlen = static_cast<int>(count);
+  segment_control_type control;
+  init_recv_segment_control(msg, control);
+  signed_size_type result = ::recvmsg(s, &msg, flags);
+  get_last_error(ec, result < 0);
+  if (addr)
+    *addrlen = msg.msg_namelen;
+  segment_size = result > 0 ? get_recv_segment_size(msg, result) : 0;
+  return result;
+}
+
+bool non_blocking_recv_coalesced(socket_type s, buf* bufs, size_t count,
+    int flags, void* addr, std::size_t* addrlen, std::size_t& segment_size,
+    asio::error_code& ec, size_t& bytes_transferred)
+{
+  for (;;)
+  {
+    // Read some data.
+    signed_size_type bytes = socket_ops::recv_coalesced(s, bufs,
+        count, flags, addr, addrlen, segment_size, ec);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+    {
+      bytes_transferred = bytes;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (is_interrupted(ec))
+      continue;
+
+    // Check if we need to run the operation again.
+    if (is_would_block(ec))
+      return false;
+
+    // Operation failed.
+    bytes_transferred = 0;
+    return true;
+  }
+}
+
+#endif // defined(ASIO_HAS_UDP_OFFLOAD)
+
+#if defined(ASIO_HAS_PACKET_INFO)
+
+void init_send_packet_info_control(msghdr& msg,
+    packet_info_control_type& control, int family,
+    const packet_info_type& info)
+{
+  std::memset(&control, 0, sizeof(control));
+  msg.msg_control = control.data;
+  msg.msg_controllen = sizeof(control.data);
+  std::size_t length = 0;
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+
+  if (info.family != ASIO_OS_DEF(AF_UNSPEC) || info.interface_index != 0)
+  {
+    if (family == ASIO_OS_DEF(AF_INET6))
+    {
+      in6_pktinfo pktinfo = in6_pktinfo();
+      unsigned char* addr = static_cast<unsigned char*>(
+          static_cast<void*>(&pktinfo.ipi6_addr));
+      if (info.family == ASIO_OS_DEF(AF_INET6))
+        std::memcpy(addr, info.address, 16);
+      else if (info.family == ASIO_OS_DEF(AF_INET))
+      {
+        // Use the IPv4-mapped form of the address on a dual stack socket.
+        addr[10] = 0xFF;
+        addr[11] = 0xFF;
+        std::memcpy(addr + 12, info.address, 4);
+      }
+      pktinfo.ipi6_ifindex = info.interface_index;
+      cmsg->cmsg_level = ASIO_OS_DEF(IPPROTO_IPV6);
+      cmsg->cmsg_type = ASIO_OS_DEF(IPV6_PKTINFO);
+      cmsg->cmsg_len = CMSG_LEN(sizeof(pktinfo));
+      std::memcpy(CMSG_DATA(cmsg), &pktinfo, sizeof(pktinfo));
+      length += CMSG_SPACE(sizeof(pktinfo));
+    }
+    else
+    {
+      in_pktinfo pktinfo = in_pktinfo();
+      if (info.family == ASIO_OS_DEF(AF_INET))
+        std::memcpy(&pktinfo.ipi_spec_dst, info.address, 4);
+      pktinfo.ipi_ifindex = info.interface_index;
+      cmsg->cmsg_level = ASIO_OS_DEF(IPPROTO_IP);
+      cmsg->cmsg_type = ASIO_OS_DEF(IP_PKTINFO);
+      cmsg->cmsg_len = CMSG_LEN(sizeof(pktinfo));
+      std::memcpy(CMSG_DATA(cmsg), &pktinfo, sizeof(pktinfo));
+      length += CMSG_SPACE(sizeof(pktinfo));
+    }
+    cmsg = CMSG_NXTHDR(&msg, cmsg);
+  }
+
+  if (info.traffic_class >= 0)
+  {
+    int value = info.traffic_class;
+    cmsg->cmsg_level = family == ASIO_OS_DEF(AF_INET6)
+      ? ASIO_OS_DEF(IPPROTO_IPV6) : ASIO_OS_DEF(IPPROTO_IP);
+    cmsg->cmsg_type = family == ASIO_OS_DEF(AF_INET6)
+      ? ASIO_OS_DEF(IPV6_TCLASS) : ASIO_OS_DEF(IP_TOS);
+    cmsg->cmsg_len = CMSG_LEN(sizeof(value));
+    std::memcpy(CMSG_DATA(cmsg), &value, sizeof(value));
+    length += CMSG_SPACE(sizeof(value));
+  }
+
+  msg.msg_controllen = length;
+  if (length == 0)
+    msg.msg_control = 0;
+}
+
+void init_recv_packet_info_control(msghdr& msg,
+    packet_info_control_type& control)
+{
+  msg.msg_control = control.data;
+  msg.msg_controllen = sizeof(control.data);
+}
+
+void get_recv_packet_info(const msghdr& msg, packet_info_type& info)
+{
+  info.family = ASIO_OS_DEF(AF_UNSPEC);
+  info.interface_index = 0;
+  info.traffic_class = -1;
+
+  msghdr& m = const_cast<msghdr&>(msg);
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&m); cmsg; cmsg = CMSG_NXTHDR(&m, cmsg))
+  {
+    if (cmsg->cmsg_level == ASIO_OS_DEF(IPPROTO_IP)
+        && cmsg->cmsg_type == ASIO_OS_DEF(IP_PKTINFO)
+        && cmsg->cmsg_len >= CMSG_LEN(sizeof(in_pktinfo)))
+    {
+      in_pktinfo pktinfo;
+      std::memcpy(&pktinfo, CMSG_DATA(cmsg), sizeof(pktinfo));
+      info.family = ASIO_OS_DEF(AF_INET);
+      std::memcpy(info.address, &pktinfo.ipi_addr, 4);
+      info.interface_index = pktinfo.ipi_ifindex;
+    }
+    else if (cmsg->cmsg_level == ASIO_OS_DEF(IPPROTO_IPV6)
+        && cmsg->cmsg_type == ASIO_OS_DEF(IPV6_PKTINFO)
+        && cmsg->cmsg_len >= CMSG_LEN(sizeof(in6_pktinfo)))
+    {
+      in6_pktinfo pktinfo;
+      std::memcpy(&pktinfo, CMSG_DATA(cmsg), sizeof(pktinfo));
+      info.family = ASIO_OS_DEF(AF_INET6);
+      std::memcpy(info.address, &pktinfo.ipi6_addr, 16);
+      info.interface_index = pktinfo.ipi6_ifindex;
+    }
+    else if (cmsg->cmsg_level == ASIO_OS_DEF(IPPROTO_IP)
+        && cmsg->cmsg_type == ASIO_OS_DEF(IP_TOS)
+        && cmsg->cmsg_len >= CMSG_LEN(1))
+    {
+      // IP_RECVTOS delivers the type of service as a single byte.
+      info.traffic_class = *CMSG_DATA(cmsg);
+    }
+    else if (cmsg->cmsg_level == ASIO_OS_DEF(IPPROTO_IPV6)
+        && cmsg->cmsg_type == ASIO_OS_DEF(IPV6_TCLASS)
+        && cmsg->cmsg_len >= CMSG_LEN(sizeof(int)))
+    {
+      int value = 0;
+      std::memcpy(&value, CMSG_DATA(cmsg), sizeof(value));
+      info.traffic_class = value & 0xFF;
+    }
+  }
+}
+
+#endif // defined(ASIO_HAS_PACKET_INFO)
+
+#if defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+
+void init_recv_timestamp_control(msghdr& msg,
+    timestamp_control_type& control)
+{
+  msg.msg_control = control.data;
+  msg.msg_controllen = sizeof(control.data);
+}
+
+bool get_recv_timestamp(const msghdr& msg, socket_timestamp& ts)
+{
+  ts.kind = socket_timestamp::received;
+  ts.software = std::chrono::nanoseconds(0);
+  ts.hardware = std::chrono::nanoseconds(0);
+  ts.id = 0;
+
+  bool found = false;
+  msghdr& m = const_cast<msghdr&>(msg);
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&m); cmsg; cmsg = CMSG_NXTHDR(&m, cmsg))
+  {
+    if (cmsg->cmsg_level == ASIO_OS_DEF(SOL_SOCKET)
+        && cmsg->cmsg_type == ASIO_OS_DEF(SO_TIMESTAMPING)
+        && cmsg->cmsg_len >= CMSG_LEN(3 * sizeof(timespec)))
+    {
+      // The first element holds the software timestamp, and the third the
+      // raw hardware timestamp. The second is no longer used.
+      timespec values[3];
+      std::memcpy(values, CMSG_DATA(cmsg), sizeof(values));
+      ts.software = std::chrono::seconds(values[0].tv_sec)
+        + std::chrono::nanoseconds(values[0].tv_nsec);
+      ts.hardware = std::chrono::seconds(values[2].tv_sec)
+        + std::chrono::nanoseconds(values[2].tv_nsec);
+      found = true;
+    }
+    else if (((cmsg->cmsg_level == ASIO_OS_DEF(IPPROTO_IP)
+            && cmsg->cmsg_type == IP_RECVERR)
+          || (cmsg->cmsg_level == ASIO_OS_DEF(IPPROTO_IPV6)
+            && cmsg->cmsg_type == IPV6_RECVERR))
+        && cmsg->cmsg_len >= CMSG_LEN(sizeof(extended_error_type)))
+    {
+      extended_error_type err;
+      std::memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+      if (err.ee_origin == ASIO_OS_DEF(SO_EE_ORIGIN_TIMESTAMPING))
+      {
+        switch (err.ee_info)
+        {
+        case ASIO_OS_DEF(SCM_TSTAMP_SCHED):
+          ts.kind = socket_timestamp::scheduled;
+          break;
+        case ASIO_OS_DEF(SCM_TSTAMP_ACK):
+          ts.kind = socket_timestamp::acknowledged;
+          break;
+        default:
+          ts.kind = socket_timestamp::sent;
+          break;
+        }
+        ts.id = err.ee_data;
+      }
+    }
+  }
+
+  return found;
+}
+
+signed_size_type recv_timestamped(socket_type s, buf* bufs, size_t count,
+    int flags, void* addr, std::size_t* addrlen,
+    socket_timestamp& ts, asio::error_code& ec)
+{
+  msghdr msg = msghdr();
+  if (addr)
+  {
+    init_msghdr_msg_name(msg.msg_name, addr);
+    msg.msg_namelen = static_cast<int>(*addrlen);
+  }
+  msg.msg_iov = bufs;
+  msg.msg_iovlen = static_cast<int>(count);
+  timestamp_control_type control;
+  init_recv_timestamp_control(msg, control);
+  signed_size_type result = ::recvmsg(s, &msg, flags);
+  get_last_error(ec, result < 0);
+  if (addr)
+    *addrlen = msg.msg_namelen;
+  if (result >= 0)
+    get_recv_timestamp(msg, ts);
+  return result;
+}
+
+bool non_blocking_recv_timestamped(socket_type s, buf* bufs, size_t count,
+    int flags, void* addr, std::size_t* addrlen, socket_timestamp& ts,
+    asio::error_code& ec, size_t& bytes_transferred)
+{
+  for (;;)
+  {
+    // Read some data.
+    signed_size_type bytes = socket_ops::recv_timestamped(s, bufs,
+        count, flags, addr, addrlen, ts, ec);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+    {
+      bytes_transferred = bytes;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (is_interrupted(ec))
+      continue;
+
+    // Check if we need to run the operation again.
+    if (is_would_block(ec))
+      return false;
+
+    // Operation failed.
+    bytes_transferred = 0;
+    return true;
+  }
+}
+
+signed_size_type recv_tx_timestamp(socket_type s,
+    socket_timestamp& ts, asio::error_code& ec)
+{
+  for (;;)
+  {
+    // Any copy of the transmitted data is discarded.
+    msghdr msg = msghdr();
+    timestamp_control_type control;
+    init_recv_timestamp_control(msg, control);
+    signed_size_type result = ::recvmsg(s, &msg, MSG_ERRQUEUE | MSG_DONTWAIT);
+    get_last_error(ec, result < 0);
+    if (result < 0)
+      return result;
+
+    // Skip error queue entries that do not carry a transmit timestamp.
+    if (get_recv_timestamp(msg, ts) && ts.kind != socket_timestamp::received)
+      return result;
+  }
+}
+
+bool non_blocking_recv_tx_timestamp(socket_type s,
+    socket_timestamp& ts, asio::error_code& ec)
+{
+  for (;;)
+  {
+    // Read a timestamp from the error queue.
+    signed_size_type result = socket_ops::recv_tx_timestamp(s, ts, ec);
+
+    // Check if operation succeeded.
+    if (result >= 0)
+      return true;
+
+    // Retry operation if interrupted by signal.
+    if (is_interrupted(ec))
+      continue;
+
+    // Check if we need to run the operation again.
+    if (is_would_block(ec))
+      return false;
+
+    // Operation failed.
+    return true;
+  }
+}
+
+#endif // defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+
+bool non_blocking_recv_zero_copy_notifications(socket_type s,
+    std::size_t& pending, asio::error_code& ec)
+{
+  while (pending > 0)
+  {
+    union
+    {
+      std::size_t align;
+      char data[CMSG_SPACE(
+          sizeof(extended_error_type) + sizeof(sockaddr_in6_type))];
+    } control;
+    msghdr msg = msghdr();
+    msg.msg_control = control.data;
+    msg.msg_controllen = sizeof(control.data);
+    signed_size_type result = ::recvmsg(s, &msg, MSG_ERRQUEUE | MSG_DONTWAIT);
+    get_last_error(ec, result < 0);
+
+    if (result >= 0)
+    {
+      // Skip error queue entries that are not zero-copy notifications. Each
+      // notification covers a range of the sends made on the socket.
+      for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+          cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+      {
+        if (((cmsg->cmsg_level == ASIO_OS_DEF(IPPROTO_IP)
+                && cmsg->cmsg_type == IP_RECVERR)
+              || (cmsg->cmsg_level == ASIO_OS_DEF(IPPROTO_IPV6)
+                && cmsg->cmsg_type == IPV6_RECVERR))
+            && cmsg->cmsg_len >= CMSG_LEN(sizeof(extended_error_type)))
+        {
+          extended_error_type err;
+          std::memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+          if (err.ee_origin == ASIO_OS_DEF(SO_EE_ORIGIN_ZEROCOPY))
+          {
+            std::size_t sends = static_cast<std::size_t>(
+                static_cast<uint32_t>(err.ee_data - err.ee_info) + 1);
+            pending -= sends < pending ? sends : pending;
+          }
+        }
+      }
+      continue;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (is_interrupted(ec))
+      continue;
+
+    // Check if we need to run the operation again.
+    if (is_would_block(ec))
+      return false;
+
+    // Operation failed.
+    return true;
+  }
+
+  return true;
+}
+
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#if defined(ASIO_HAS_FD_PASSING)
+
+void init_send_fds_control(msghdr& msg,
+    fds_control_type& control, const local::passed_fds& fds)
+{
+  if (fds.count == 0)
+  {
+    msg.msg_control = 0;
+    msg.msg_controllen = 0;
+    return;
+  }
+
+  std::size_t fd_count = fds.count < local::passed_fds::max_fds
+    ? fds.count : static_cast<std::size_t>(local::passed_fds::max_fds);
+  std::memset(control.data, 0, sizeof(control.data));
+  msg.msg_control = control.data;
+  msg.msg_controllen = CMSG_SPACE(sizeof(int) * fd_count);
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = ASIO_OS_DEF(SOL_SOCKET);
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fd_count);
+  std::memcpy(CMSG_DATA(cmsg), fds.fds, sizeof(int) * fd_count);
+}
+
+void init_recv_fds_control(msghdr& msg, fds_control_type& control)
+{
+  msg.msg_control = control.data;
+  msg.msg_controllen = sizeof(control.data);
+}
+
+void get_recv_fds(const msghdr& msg, local::passed_fds& fds)
+{
+  fds.count = 0;
+  fds.truncated = (msg.msg_flags & MSG_CTRUNC) != 0;
+  fds.has_credentials = false;
+
+  msghdr& m = const_cast<msghdr&>(msg);
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&m); cmsg; cmsg = CMSG_NXTHDR(&m, cmsg))
+  {
+    if (cmsg->cmsg_level != ASIO_OS_DEF(SOL_SOCKET))
+      continue;
+
+    if (cmsg->cmsg_type == SCM_RIGHTS && cmsg->cmsg_len >= CMSG_LEN(0))
+    {
+      std::size_t n = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+      const unsigned char* data = CMSG_DATA(cmsg);
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        int fd;
+        std::memcpy(&fd, data + i * sizeof(int), sizeof(int));
+        if (!fds.push_back(fd))
+        {
+          ::close(fd);
+          fds.truncated = true;
+        }
+      }
+    }
+#if defined(SCM_CREDENTIALS)
+    else if (cmsg->cmsg_type == SCM_CREDENTIALS
+        && cmsg->cmsg_len >= CMSG_LEN(sizeof(ucred)))
+    {
+      ucred cred;
+      std::memcpy(&cred, CMSG_DATA(cmsg), sizeof(cred));
+      fds.has_credentials = true;
+      fds.pid = cred.pid;
+      fds.uid = cred.uid;
+      fds.gid = cred.gid;
+    }
+#endif // defined(SCM_CREDENTIALS)
+  }
+}
+
+signed_size_type send_fds(socket_type s, const buf* bufs, size_t count,
+    int flags, const local::passed_fds& fds, asio::error_code& ec)
+{
+  if (fds.count > local::passed_fds::max_fds)
+  {
+    ec = asio::error::invalid_argument;
+    return socket_error_retval;
+  }
+
+  msghdr msg = msghdr();
+  msg.msg_iov = const_cast<buf*>(bufs);
+  msg.msg_iovlen = static_cast<int>(count);
+  fds_control_type control;
+  init_send_fds_control(msg, control, fds);
+#if defined(ASIO_HAS_MSG_NOSIGNAL)
+  flags |= MSG_NOSIGNAL;
+#endif // defined(ASIO_HAS_MSG_NOSIGNAL)
+  signed_size_type result = ::sendmsg(s, &msg, flags);
+  get_last_error(ec, result < 0);
+  return result;
+}
+
+bool non_blocking_send_fds(socket_type s, const buf* bufs, size_t count,
+    int flags, const local::passed_fds& fds, asio::error_code& ec,
+    size_t& bytes_transferred)
+{
+  for (;;)
+  {
+    // Write some data, with the descriptors attached.
+    signed_size_type bytes = socket_ops::send_fds(s,
+        bufs, count, flags, fds, ec);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+    {
+      bytes_transferred = bytes;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (is_interrupted(ec))
+      continue;
+
+    // Check if we need to run the operation again.
+    if (is_would_block(ec))
+      return false;
+
+    // Operation failed.
+    bytes_transferred = 0;
+    return true;
+  }
+}
+
+signed_size_type recv_fds(socket_type s, buf* bufs, size_t count,
+    int flags, local::passed_fds& fds, asio::error_code& ec)
+{
+  msghdr msg = msghdr();
+  msg.msg_iov = bufs;
+  msg.msg_iovlen = static_cast<int>(count);
+  fds_control_type control;
+  init_recv_fds_control(msg, control);
+#if defined(MSG_CMSG_CLOEXEC)
+  flags |= MSG_CMSG_CLOEXEC;
+#endif // defined(MSG_CMSG_CLOEXEC)
+  signed_size_type result = ::recvmsg(s, &msg, flags);
+  get_last_error(ec, result < 0);
+  if (result >= 0)
+    get_recv_fds(msg, fds);
+  return result;
+}
+
+bool non_blocking_recv_fds(socket_type s, buf* bufs, size_t count,
+    int flags, local::passed_fds& fds, asio::error_code& ec,
+    size_t& bytes_transferred)
+{
+  for (;;)
+  {
+    // Read some data, and any descriptors passed with it.
+    signed_size_type bytes = socket_ops::recv_fds(s,
+        bufs, count, flags, fds, ec);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+    {
+      bytes_transferred = bytes;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (is_interrupted(ec))
+      continue;
+
+    // Check if we need to run the operation again.
+    if (is_would_block(ec))
+      return false;
+
+    // Operation failed.
+    bytes_transferred = 0;
+    return true;
+  }
+}
+
+#endif // defined(ASIO_HAS_FD_PASSING)
+
 socket_type socket(int af, int type, int protocol,
     asio::error_code& ec)
 {
@@ -1923,6 +2714,28 @@ inline int call_setsockopt(SockLenType msghdr::*,
       (const char*)optval, (SockLenType)optlen);
 }
 
+// Map a custom boolean socket option to its corresponding state flag.
+inline state_type custom_option_state(int optname)
+{
+  switch (optname)
+  {
+  case enable_connection_aborted_option:
+    return enable_connection_aborted;
+  case multishot_accept_option:
+    return multishot_accept;
+  case zero_copy_option:
+    return zero_copy;
+  case inline_completion_option:
+    return inline_completion;
+  case write_coalescing_option:
+    return write_coalescing;
+  case operation_slots_option:
+    return operation_slots;
+  default:
+    return 0;
+  }
+}
+
 int setsockopt(socket_type s, state_type& state, int level, int optname,
     const void* optval, std::size_t optlen, asio::error_code& ec)
 {
@@ -1938,8 +2751,15 @@ int setsockopt(socket_type s, state_type& state, int level, int optname,
     return socket_error_retval;
   }
 
+  if (level == custom_socket_option_level && optname == read_ahead_option)
+  {
+    // Implemented by the reactive socket service only.
+    ec = asio::error::operation_not_supported;
+    return socket_error_retval;
+  }
+
   if (level == custom_socket_option_level
-      && optname == enable_connection_aborted_option)
+      && custom_option_state(optname) != 0)
   {
     if (optlen != sizeof(int))
     {
@@ -1947,10 +2767,27 @@ int setsockopt(socket_type s, state_type& state, int level, int optname,
       return socket_error_retval;
     }
 
+    state_type flag = custom_option_state(optname);
     if (*static_cast<const int*>(optval))
-      state |= enable_connection_aborted;
+      state |= flag;
     else
-      state &= ~enable_connection_aborted;
+      state &= ~flag;
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    // The reactive backends send with MSG_ZEROCOPY only if the kernel accepts
+    // SO_ZEROCOPY for the socket. Otherwise the option is ignored.
+    if (flag == zero_copy)
+    {
+      state &= ~internal_zero_copy;
+      int enable = 1;
+      if ((state & zero_copy) != 0
+          && (state & (stream_oriented | datagram_oriented)) != 0
+          && ::setsockopt(s, ASIO_OS_DEF(SOL_SOCKET),
+            ASIO_OS_DEF(SO_ZEROCOPY), &enable, sizeof(enable)) == 0)
+        state |= internal_zero_copy;
+    }
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
     asio::error::clear(ec);
     return 0;
   }
@@ -2026,8 +2863,27 @@ int getsockopt(socket_type s, state_type state, int level, int optname,
     return socket_error_retval;
   }
 
+  if (level == custom_socket_option_level && optname == read_ahead_option)
+  {
+    // Implemented by the reactive socket service only.
+    ec = asio::error::operation_not_supported;
+    return socket_error_retval;
+  }
+
   if (level == custom_socket_option_level
-      && optname == enable_connection_aborted_option)
+      && optname == transport_info_option)
+  {
+    if (*optlen != sizeof(transport_info))
+    {
+      ec = asio::error::invalid_argument;
+      return socket_error_retval;
+    }
+
+    return get_transport_info(s, *static_cast<transport_info*>(optval), ec);
+  }
+
+  if (level == custom_socket_option_level
+      && custom_option_state(optname) != 0)
   {
     if (*optlen != sizeof(int))
     {
@@ -2035,7 +2891,8 @@ int getsockopt(socket_type s, state_type state, int level, int optname,
       return socket_error_retval;
     }
 
-    *static_cast<int*>(optval) = (state & enable_connection_aborted) ? 1 : 0;
+    state_type flag = custom_option_state(optname);
+    *static_cast<int*>(optval) = (state & flag) ? 1 : 0;
     asio::error::clear(ec);
     return 0;
   }
@@ -2117,6 +2974,87 @@ inline int call_getpeername(SockLenType msghdr::*,
   return result;
 }
 
+#if defined(__linux__)
+// The leading fields of struct tcp_info from linux/tcp.h. The C library's
+// definition may omit the fields that were added by newer kernels.
+struct linux_tcp_info
+{
+  uint8_t state_and_flags[8];
+  uint32_t rto, ato, snd_mss, rcv_mss;
+  uint32_t unacked, sacked, lost, retrans, fackets;
+  uint32_t last_data_sent, last_ack_sent, last_data_recv, last_ack_recv;
+  uint32_t pmtu, rcv_ssthresh, rtt, rttvar, snd_ssthresh, snd_cwnd;
+  uint32_t advmss, reordering, rcv_rtt, rcv_space, total_retrans;
+  uint64_t pacing_rate, max_pacing_rate, bytes_acked, bytes_received;
+  uint32_t segs_out, segs_in, notsent_bytes, min_rtt;
+  uint32_t data_segs_in, data_segs_out;
+  uint64_t delivery_rate;
+};
+#endif // defined(__linux__)
+
+int get_transport_info(socket_type s,
+    transport_info& info, asio::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = asio::error::bad_descriptor;
+    return socket_error_retval;
+  }
+
+  info = transport_info();
+
+#if defined(__linux__)
+  // An older kernel fills in only part of the structure, leaving the rest of
+  // the fields zero.
+  linux_tcp_info tcpi;
+  std::memset(&tcpi, 0, sizeof(tcpi));
+  socklen_t len = sizeof(tcpi);
+  int result = ::getsockopt(s, IPPROTO_TCP, TCP_INFO, &tcpi, &len);
+  get_last_error(ec, result != 0);
+  if (result == 0)
+  {
+    info.rtt = chrono::microseconds(tcpi.rtt);
+    info.rtt_variance = chrono::microseconds(tcpi.rttvar);
+    info.congestion_window =
+      static_cast<uint64_t>(tcpi.snd_cwnd) * tcpi.snd_mss;
+    info.retransmits = tcpi.total_retrans;
+    info.delivery_rate = tcpi.delivery_rate;
+  }
+  return result;
+#elif defined(__MACH__) && defined(__APPLE__) && defined(TCP_CONNECTION_INFO)
+  tcp_connection_info tcpi;
+  std::memset(&tcpi, 0, sizeof(tcpi));
+  socklen_t len = sizeof(tcpi);
+  int result = ::getsockopt(s, IPPROTO_TCP, TCP_CONNECTION_INFO, &tcpi, &len);
+  get_last_error(ec, result != 0);
+  if (result == 0)
+  {
+    info.rtt = chrono::milliseconds(tcpi.tcpi_srtt);
+    info.rtt_variance = chrono::milliseconds(tcpi.tcpi_rttvar);
+    info.congestion_window = tcpi.tcpi_snd_cwnd;
+    info.retransmits = tcpi.tcpi_txretransmitpackets;
+  }
+  return result;
+#elif (defined(ASIO_WINDOWS) || defined(__CYGWIN__)) && defined(SIO_TCP_INFO)
+  DWORD version = 0;
+  TCP_INFO_v0 tcpi;
+  DWORD bytes = 0;
+  int result = ::WSAIoctl(s, SIO_TCP_INFO, &version, sizeof(version),
+      &tcpi, sizeof(tcpi), &bytes, 0, 0);
+  get_last_error(ec, result != 0);
+  if (result == 0)
+  {
+    info.rtt = chrono::microseconds(tcpi.RttUs);
+    info.congestion_window = tcpi.Cwnd;
+    info.retransmits = tcpi.FastRetrans + tcpi.TimeoutEpisodes;
+  }
+  return result;
+#else
+  ec = asio::error::operation_not_supported;
+  return socket_error_retval;
+#endif
+}
+
 int getpeername(socket_type s, void* addr, std::size_t* addrlen,
     bool cached, asio::error_code& ec)
 {
@@ -2425,6 +3363,35 @@ int poll_error(socket_type s, state_type state,
   return result;
 }
 
+int poll_peer_closed(socket_type s, state_type state,
+    int msec, asio::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = asio::error::bad_descriptor;
+    return socket_error_retval;
+  }
+
+#if defined(POLLRDHUP)
+  pollfd fds;
+  fds.fd = s;
+  fds.events = POLLRDHUP;
+  fds.revents = 0;
+  int timeout = (state & user_set_non_blocking) ? 0 : msec;
+  int result = ::poll(&fds, 1, timeout);
+  get_last_error(ec, result < 0);
+  if (result == 0)
+    if (state & user_set_non_blocking)
+      ec = asio::error::would_block;
+  return result;
+#else // defined(POLLRDHUP)
+  (void)state;
+  (void)msec;
+  ec = asio::error::operation_not_supported;
+  return socket_error_retval;
+#endif // defined(POLLRDHUP)
+}
+
 int poll_connect(socket_type s, int msec, asio::error_code& ec)
 {
   if (s == invalid_socket)
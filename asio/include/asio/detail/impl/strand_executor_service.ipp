@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/config.hpp"
 #include "asio/detail/strand_executor_service.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -26,8 +27,9 @@ namespace detail {
 strand_executor_service::strand_executor_service(execution_context& ctx)
   : execution_context_service_base<strand_executor_service>(ctx),
     mutex_(),
-    salt_(0),
-    impl_list_(0)
+    impl_list_(0),
+    metrics_(config(ctx).get("scheduler", "metrics", false)),
+    max_queue_depth_(0)
 {
 }
 
@@ -40,11 +42,17 @@ void strand_executor_service::shutdown()
   strand_impl* impl = impl_list_;
   while (impl)
   {
-    impl->mutex_->lock();
-    impl->shutdown_ = true;
-    ops.push(impl->waiting_queue_);
+    scheduler_operation* waiting = impl->state_.exchange(
+        shutdown_state(), std::memory_order_acquire);
+    if (waiting == shutdown_state())
+      waiting = 0;
+    while (waiting && waiting != locked_state())
+    {
+      scheduler_operation* next = op_queue_access::next(waiting);
+      ops.push(waiting);
+      waiting = next;
+    }
     ops.push(impl->ready_queue_);
-    impl->mutex_->unlock();
     impl = impl->next_;
   }
 }
@@ -54,21 +62,10 @@ strand_executor_service::create_implementation()
 {
   execution_context::allocator<void> alloc(context());
   implementation_type new_impl = allocate_shared<strand_impl>(alloc);
-  new_impl->locked_ = false;
-  new_impl->shutdown_ = false;
+  new_impl->state_.store(0, std::memory_order_relaxed);
 
   asio::detail::mutex::scoped_lock lock(mutex_);
 
-  // Select a mutex from the pool of shared mutexes.
-  std::size_t salt = salt_++;
-  std::size_t mutex_index = reinterpret_cast<std::size_t>(new_impl.get());
-  mutex_index += (reinterpret_cast<std::size_t>(new_impl.get()) >> 3);
-  mutex_index ^= salt + 0x9e3779b9 + (mutex_index << 6) + (mutex_index >> 2);
-  mutex_index = mutex_index % num_mutexes;
-  if (!mutexes_[mutex_index])
-    mutexes_[mutex_index] = allocate_shared<mutex>(alloc);
-  new_impl->mutex_ = mutexes_[mutex_index].get();
-
   // Insert implementation into linked list of all implementations.
   new_impl->next_ = impl_list_;
   new_impl->prev_ = 0;
@@ -96,28 +93,30 @@ strand_executor_service::strand_impl::~strand_impl()
 bool strand_executor_service::enqueue(const implementation_type& impl,
     scheduler_operation* op)
 {
-  impl->mutex_->lock();
-  if (impl->shutdown_)
-  {
-    impl->mutex_->unlock();
-    op->destroy();
-    return false;
-  }
-  else if (impl->locked_)
-  {
-    // Some other function already holds the strand lock. Enqueue for later.
-    impl->waiting_queue_.push(op);
-    impl->mutex_->unlock();
-    return false;
-  }
-  else
+  scheduler_operation* state = impl->state_.load(std::memory_order_relaxed);
+  for (;;)
   {
-    // The function is acquiring the strand lock and so is responsible for
-    // scheduling the strand.
-    impl->locked_ = true;
-    impl->mutex_->unlock();
-    impl->ready_queue_.push(op);
-    return true;
+    if (state == shutdown_state())
+    {
+      op->destroy();
+      return false;
+    }
+    else if (state)
+    {
+      // Some other function already holds the strand lock. Enqueue for later.
+      op_queue_access::next(op, state == locked_state() ? 0 : state);
+      if (impl->state_.compare_exchange_weak(state, op,
+            std::memory_order_release, std::memory_order_relaxed))
+        return false;
+    }
+    else if (impl->state_.compare_exchange_weak(state, locked_state(),
+          std::memory_order_acquire, std::memory_order_relaxed))
+    {
+      // The function is acquiring the strand lock and so is responsible for
+      // scheduling the strand.
+      impl->ready_queue_.push(op);
+      return true;
+    }
   }
 }
 
@@ -129,11 +128,50 @@ bool strand_executor_service::running_in_this_thread(
 
 bool strand_executor_service::push_waiting_to_ready(implementation_type& impl)
 {
-  impl->mutex_->lock();
-  impl->ready_queue_.push(impl->waiting_queue_);
-  bool more_handlers = impl->locked_ = !impl->ready_queue_.empty();
-  impl->mutex_->unlock();
-  return more_handlers;
+  // Handlers may have been left in the ready queue if an upcall threw.
+  if (!impl->ready_queue_.empty())
+    return true;
+
+  scheduler_operation* state = impl->state_.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    if (state == shutdown_state())
+    {
+      return false;
+    }
+    else if (state == locked_state())
+    {
+      // No handlers are waiting, so release the strand lock.
+      if (impl->state_.compare_exchange_weak(state, 0,
+            std::memory_order_release, std::memory_order_relaxed))
+        return false;
+    }
+    else if (impl->state_.compare_exchange_weak(state, locked_state(),
+          std::memory_order_acquire, std::memory_order_relaxed))
+    {
+      // Take the waiting handlers, which are stacked in reverse order, and
+      // append them to the ready queue in the order they were submitted.
+      scheduler_operation* reversed = 0;
+      std::size_t depth = 0;
+      while (state)
+      {
+        scheduler_operation* next = op_queue_access::next(state);
+        op_queue_access::next(state, reversed);
+        reversed = state;
+        state = next;
+        ++depth;
+      }
+      if (impl->service_->metrics_)
+        impl->service_->record_queue_depth(depth);
+      while (reversed)
+      {
+        scheduler_operation* next = op_queue_access::next(reversed);
+        impl->ready_queue_.push(reversed);
+        reversed = next;
+      }
+      return true;
+    }
+  }
 }
 
 void strand_executor_service::run_ready_handlers(implementation_type& impl)
@@ -27,7 +27,10 @@ namespace detail {
 
 inline strand_service::strand_impl::strand_impl()
   : operation(&strand_service::do_complete),
-    locked_(false)
+    state_(0),
+    next_(0),
+    prev_(0),
+    service_(0)
 {
 }
 
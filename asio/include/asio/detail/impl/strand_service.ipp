@@ -31,12 +31,8 @@ struct strand_service::on_do_complete_exit
 
   ~on_do_complete_exit()
   {
-    impl_->mutex_.lock();
-    impl_->ready_queue_.push(impl_->waiting_queue_);
-    bool more_handlers = impl_->locked_ = !impl_->ready_queue_.empty();
-    impl_->mutex_.unlock();
-
-    if (more_handlers)
+    implementation_type self;
+    if (push_waiting_to_ready(impl_, self))
       owner_->post_immediate_completion(impl_, true);
   }
 };
@@ -46,7 +42,7 @@ strand_service::strand_service(asio::io_context& io_context)
     io_context_(io_context),
     io_context_impl_(asio::use_service<io_context_impl>(io_context)),
     mutex_(),
-    salt_(0)
+    impl_list_(0)
 {
 }
 
@@ -56,42 +52,164 @@ void strand_service::shutdown()
 
   asio::detail::mutex::scoped_lock lock(mutex_);
 
-  for (std::size_t i = 0; i < num_implementations; ++i)
+  strand_impl* impl = impl_list_;
+  while (impl)
   {
-    if (strand_impl* impl = implementations_[i].get())
+    operation* waiting = impl->state_.exchange(
+        shutdown_state(), std::memory_order_acquire);
+    if (waiting == shutdown_state())
+      waiting = 0;
+    while (waiting && waiting != locked_state())
     {
-      ops.push(impl->waiting_queue_);
-      ops.push(impl->ready_queue_);
+      operation* next = op_queue_access::next(waiting);
+      ops.push(waiting);
+      waiting = next;
     }
+    ops.push(impl->ready_queue_);
+
+    // Detach the implementation from the service, as strand objects may
+    // outlive the io_context.
+    strand_impl* next = impl->next_;
+    impl->next_ = 0;
+    impl->prev_ = 0;
+    impl->service_ = 0;
+    impl = next;
   }
+  impl_list_ = 0;
 }
 
 void strand_service::construct(strand_service::implementation_type& impl)
 {
+  // The implementation is not allocated using the io_context's allocator, as
+  // strand objects may outlive the io_context.
+  implementation_type new_impl = make_shared<strand_impl>();
+
   asio::detail::mutex::scoped_lock lock(mutex_);
 
-  std::size_t salt = salt_++;
-#if defined(ASIO_ENABLE_SEQUENTIAL_STRAND_ALLOCATION)
-  std::size_t index = salt;
-#else // defined(ASIO_ENABLE_SEQUENTIAL_STRAND_ALLOCATION)
-  std::size_t index = reinterpret_cast<std::size_t>(&impl);
-  index += (reinterpret_cast<std::size_t>(&impl) >> 3);
-  index ^= salt + 0x9e3779b9 + (index << 6) + (index >> 2);
-#endif // defined(ASIO_ENABLE_SEQUENTIAL_STRAND_ALLOCATION)
-  index = index % num_implementations;
-
-  if (!implementations_[index])
-  {
-    execution_context::allocator<void> alloc(context());
-    implementations_[index] = allocate_shared<strand_impl>(alloc);
-  }
-  impl = implementations_[index].get();
+  // Insert implementation into linked list of all implementations.
+  new_impl->next_ = impl_list_;
+  new_impl->prev_ = 0;
+  if (impl_list_)
+    impl_list_->prev_ = new_impl.get();
+  impl_list_ = new_impl.get();
+  new_impl->service_ = this;
+
+  impl = static_cast<implementation_type&&>(new_impl);
+}
+
+strand_service::strand_impl::~strand_impl()
+{
+  // The service has been shut down if the strand outlived its io_context.
+  if (!service_)
+    return;
+
+  asio::detail::mutex::scoped_lock lock(service_->mutex_);
+
+  // Remove implementation from linked list of all implementations.
+  if (service_->impl_list_ == this)
+    service_->impl_list_ = next_;
+  if (prev_)
+    prev_->next_ = next_;
+  if (next_)
+    next_->prev_= prev_;
 }
 
 bool strand_service::running_in_this_thread(
     const implementation_type& impl) const
 {
-  return call_stack<strand_impl>::contains(impl) != 0;
+  return call_stack<strand_impl>::contains(impl.get()) != 0;
+}
+
+bool strand_service::try_lock(implementation_type& impl)
+{
+  operation* state = 0;
+  if (impl->state_.compare_exchange_strong(state, locked_state(),
+        std::memory_order_acquire, std::memory_order_relaxed))
+  {
+    impl->self_ = impl;
+    return true;
+  }
+  return false;
+}
+
+bool strand_service::enqueue(implementation_type& impl, operation* op)
+{
+  operation* state = impl->state_.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    if (state == shutdown_state())
+    {
+      op->destroy();
+      return false;
+    }
+    else if (state)
+    {
+      // Some other handler already holds the strand lock. Enqueue for later.
+      op_queue_access::next(op, state == locked_state() ? 0 : state);
+      if (impl->state_.compare_exchange_weak(state, op,
+            std::memory_order_release, std::memory_order_relaxed))
+        return false;
+    }
+    else if (impl->state_.compare_exchange_weak(state, locked_state(),
+          std::memory_order_acquire, std::memory_order_relaxed))
+    {
+      // The handler is acquiring the strand lock and so is responsible for
+      // scheduling the strand.
+      impl->self_ = impl;
+      impl->ready_queue_.push(op);
+      return true;
+    }
+  }
+}
+
+bool strand_service::push_waiting_to_ready(
+    strand_impl* impl, implementation_type& self)
+{
+  // Handlers may have been left in the ready queue if an upcall threw.
+  if (!impl->ready_queue_.empty())
+    return true;
+
+  operation* state = impl->state_.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    if (state == shutdown_state())
+    {
+      self.swap(impl->self_);
+      return false;
+    }
+    else if (state == locked_state())
+    {
+      // No handlers are waiting, so release the strand lock. The reference
+      // must be given up first, as another thread may acquire the lock as
+      // soon as it is released.
+      self.swap(impl->self_);
+      if (impl->state_.compare_exchange_weak(state, 0,
+            std::memory_order_release, std::memory_order_relaxed))
+        return false;
+      impl->self_.swap(self);
+    }
+    else if (impl->state_.compare_exchange_weak(state, locked_state(),
+          std::memory_order_acquire, std::memory_order_relaxed))
+    {
+      // Take the waiting handlers, which are stacked in reverse order, and
+      // append them to the ready queue in the order they were submitted.
+      operation* reversed = 0;
+      while (state)
+      {
+        operation* next = op_queue_access::next(state);
+        op_queue_access::next(state, reversed);
+        reversed = state;
+        state = next;
+      }
+      while (reversed)
+      {
+        operation* next = op_queue_access::next(reversed);
+        impl->ready_queue_.push(reversed);
+        reversed = next;
+      }
+      return true;
+    }
+  }
 }
 
 struct strand_service::on_dispatch_exit
@@ -101,12 +219,8 @@ struct strand_service::on_dispatch_exit
 
   ~on_dispatch_exit()
   {
-    impl_->mutex_.lock();
-    impl_->ready_queue_.push(impl_->waiting_queue_);
-    bool more_handlers = impl_->locked_ = !impl_->ready_queue_.empty();
-    impl_->mutex_.unlock();
-
-    if (more_handlers)
+    implementation_type self;
+    if (push_waiting_to_ready(impl_, self))
       io_context_impl_->post_immediate_completion(impl_, false);
   }
 };
@@ -115,70 +229,38 @@ void strand_service::do_dispatch(implementation_type& impl, operation* op)
 {
   // If we are running inside the io_context, and no other handler already
   // holds the strand lock, then the handler can run immediately.
-  bool can_dispatch = io_context_impl_.can_dispatch();
-  impl->mutex_.lock();
-  if (can_dispatch && !impl->locked_)
+  if (io_context_impl_.can_dispatch() && try_lock(impl))
   {
-    // Immediate invocation is allowed.
-    impl->locked_ = true;
-    impl->mutex_.unlock();
-
     // Indicate that this strand is executing on the current thread.
-    call_stack<strand_impl>::context ctx(impl);
+    call_stack<strand_impl>::context ctx(impl.get());
 
     // Ensure the next handler, if any, is scheduled on block exit.
-    on_dispatch_exit on_exit = { &io_context_impl_, impl };
+    on_dispatch_exit on_exit = { &io_context_impl_, impl.get() };
     (void)on_exit;
 
     op->complete(&io_context_impl_, asio::error_code(), 0);
     return;
   }
 
-  if (impl->locked_)
-  {
-    // Some other handler already holds the strand lock. Enqueue for later.
-    impl->waiting_queue_.push(op);
-    impl->mutex_.unlock();
-  }
-  else
-  {
-    // The handler is acquiring the strand lock and so is responsible for
-    // scheduling the strand.
-    impl->locked_ = true;
-    impl->mutex_.unlock();
-    impl->ready_queue_.push(op);
-    io_context_impl_.post_immediate_completion(impl, false);
-  }
+  // Otherwise the handler is enqueued. If it acquires the strand lock then it
+  // is responsible for scheduling the strand.
+  if (enqueue(impl, op))
+    io_context_impl_.post_immediate_completion(impl.get(), false);
 }
 
 void strand_service::do_post(implementation_type& impl,
     operation* op, bool is_continuation)
 {
-  impl->mutex_.lock();
-  if (impl->locked_)
-  {
-    // Some other handler already holds the strand lock. Enqueue for later.
-    impl->waiting_queue_.push(op);
-    impl->mutex_.unlock();
-  }
-  else
-  {
-    // The handler is acquiring the strand lock and so is responsible for
-    // scheduling the strand.
-    impl->locked_ = true;
-    impl->mutex_.unlock();
-    impl->ready_queue_.push(op);
-    io_context_impl_.post_immediate_completion(impl, is_continuation);
-  }
+  if (enqueue(impl, op))
+    io_context_impl_.post_immediate_completion(impl.get(), is_continuation);
 }
 
 void strand_service::do_complete(void* owner, operation* base,
     const asio::error_code& ec, std::size_t /*bytes_transferred*/)
 {
+  strand_impl* impl = static_cast<strand_impl*>(base);
   if (owner)
   {
-    strand_impl* impl = static_cast<strand_impl*>(base);
-
     // Indicate that this strand is executing on the current thread.
     call_stack<strand_impl>::context ctx(impl);
 
@@ -195,6 +277,13 @@ void strand_service::do_complete(void* owner, operation* base,
       o->complete(owner, ec, 0);
     }
   }
+  else
+  {
+    // The strand was scheduled when the io_context was shut down, so give up
+    // the reference that kept it alive.
+    implementation_type self;
+    self.swap(impl->self_);
+  }
 }
 
 } // namespace detail
@@ -0,0 +1,274 @@
+//
+// detail/impl/thread_affinity.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_THREAD_AFFINITY_IPP
+#define ASIO_DETAIL_IMPL_THREAD_AFFINITY_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(__linux__)
+# include <errno.h>
+# include <sched.h>
+# include <cstdio>
+# include <cstdlib>
+#elif defined(ASIO_WINDOWS) \
+  && !defined(ASIO_WINDOWS_APP) \
+  && !defined(UNDER_CE)
+# include "asio/detail/socket_types.hpp"
+#endif
+
+#include "asio/detail/thread_affinity.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+void bind_this_thread_to_processor(std::size_t index, asio::error_code& ec)
+{
+#if defined(__linux__) && defined(CPU_SETSIZE)
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+  {
+    ec.assign(errno, asio::error::get_system_category());
+    return;
+  }
+
+  int count = CPU_COUNT(&allowed);
+  if (count <= 0)
+  {
+    ec = asio::error::invalid_argument;
+    return;
+  }
+
+  std::size_t target = index % static_cast<std::size_t>(count);
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+  {
+    if (CPU_ISSET(cpu, &allowed) && target-- == 0)
+    {
+      cpu_set_t selected;
+      CPU_ZERO(&selected);
+      CPU_SET(cpu, &selected);
+      if (::sched_setaffinity(0, sizeof(selected), &selected) != 0)
+        ec.assign(errno, asio::error::get_system_category());
+      else
+        ec = asio::error_code();
+      return;
+    }
+  }
+
+  ec = asio::error::invalid_argument;
+#elif defined(ASIO_WINDOWS) \
+  && !defined(ASIO_WINDOWS_APP) \
+  && !defined(UNDER_CE)
+  DWORD_PTR process_mask = 0, system_mask = 0;
+  if (!::GetProcessAffinityMask(::GetCurrentProcess(),
+        &process_mask, &system_mask))
+  {
+    DWORD last_error = ::GetLastError();
+    ec.assign(last_error, asio::error::get_system_category());
+    return;
+  }
+
+  std::size_t count = 0;
+  for (DWORD_PTR m = process_mask; m != 0; m &= m - 1)
+    ++count;
+  if (count == 0)
+  {
+    ec = asio::error::invalid_argument;
+    return;
+  }
+
+  std::size_t target = index % count;
+  DWORD_PTR mask = process_mask;
+  while (target-- > 0)
+    mask &= mask - 1;
+  mask &= ~(mask - 1);
+
+  if (!::SetThreadAffinityMask(::GetCurrentThread(), mask))
+  {
+    DWORD last_error = ::GetLastError();
+    ec.assign(last_error, asio::error::get_system_category());
+    return;
+  }
+
+  ec = asio::error_code();
+#else
+  (void)index;
+  ec = asio::error::operation_not_supported;
+#endif
+}
+
+#if defined(__linux__) && defined(CPU_SETSIZE)
+
+// Parse a sysfs list of the form "0-3,8,10-11". Returns the highest number in
+// the list, or -1 if the file cannot be read. Numbers are added to the set, if
+// one is supplied.
+inline long read_sysfs_number_list(const char* path, cpu_set_t* set)
+{
+  std::FILE* file = std::fopen(path, "r");
+  if (!file)
+    return -1;
+
+  char buffer[4096];
+  std::size_t length = std::fread(buffer, 1, sizeof(buffer) - 1, file);
+  std::fclose(file);
+  buffer[length] = 0;
+
+  long highest = -1;
+  const char* p = buffer;
+  while (*p >= '0' && *p <= '9')
+  {
+    char* end = 0;
+    long first = std::strtol(p, &end, 10);
+    long last = first;
+    if (*end == '-')
+      last = std::strtol(end + 1, &end, 10);
+    for (long n = first; n <= last; ++n)
+      if (set && n < CPU_SETSIZE)
+        CPU_SET(static_cast<int>(n), set);
+    if (last > highest)
+      highest = last;
+    p = (*end == ',') ? end + 1 : end;
+  }
+
+  return highest;
+}
+
+#endif // defined(__linux__) && defined(CPU_SETSIZE)
+
+void bind_this_thread_to_processors(const std::size_t* processors,
+    std::size_t count, asio::error_code& ec)
+{
+  if (count == 0)
+  {
+    ec = asio::error::invalid_argument;
+    return;
+  }
+
+#if defined(__linux__) && defined(CPU_SETSIZE)
+  cpu_set_t selected;
+  CPU_ZERO(&selected);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (processors[i] >= static_cast<std::size_t>(CPU_SETSIZE))
+    {
+      ec = asio::error::invalid_argument;
+      return;
+    }
+    CPU_SET(static_cast<int>(processors[i]), &selected);
+  }
+
+  if (::sched_setaffinity(0, sizeof(selected), &selected) != 0)
+  {
+    ec.assign(errno, asio::error::get_system_category());
+    return;
+  }
+
+# if defined(ASIO_HAS_NUMA)
+  numa_node_binding<>::tag_ = 0;
+# endif // defined(ASIO_HAS_NUMA)
+
+  ec = asio::error_code();
+#elif defined(ASIO_WINDOWS) \
+  && !defined(ASIO_WINDOWS_APP) \
+  && !defined(UNDER_CE)
+  DWORD_PTR mask = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (processors[i] >= sizeof(DWORD_PTR) * CHAR_BIT)
+    {
+      ec = asio::error::invalid_argument;
+      return;
+    }
+    mask |= static_cast<DWORD_PTR>(1) << processors[i];
+  }
+
+  if (!::SetThreadAffinityMask(::GetCurrentThread(), mask))
+  {
+    DWORD last_error = ::GetLastError();
+    ec.assign(last_error, asio::error::get_system_category());
+    return;
+  }
+
+  ec = asio::error_code();
+#else
+  (void)processors;
+  ec = asio::error::operation_not_supported;
+#endif
+}
+
+std::size_t numa_node_count()
+{
+#if defined(__linux__) && defined(CPU_SETSIZE)
+  long highest = read_sysfs_number_list(
+      "/sys/devices/system/node/online", 0);
+  return highest >= 0 ? static_cast<std::size_t>(highest) + 1 : 1;
+#else
+  return 1;
+#endif
+}
+
+void bind_this_thread_to_numa_node(std::size_t node, asio::error_code& ec)
+{
+#if defined(__linux__) && defined(CPU_SETSIZE)
+  char path[64];
+  std::snprintf(path, sizeof(path),
+      "/sys/devices/system/node/node%lu/cpulist",
+      static_cast<unsigned long>(node));
+
+  cpu_set_t selected;
+  CPU_ZERO(&selected);
+  if (read_sysfs_number_list(path, &selected) < 0)
+  {
+    // Without NUMA topology information, treat the system as a single node.
+    if (node != 0 || ::sched_getaffinity(0, sizeof(selected), &selected) != 0)
+    {
+      ec = asio::error::invalid_argument;
+      return;
+    }
+  }
+
+  if (CPU_COUNT(&selected) == 0)
+  {
+    ec = asio::error::invalid_argument;
+    return;
+  }
+
+  if (::sched_setaffinity(0, sizeof(selected), &selected) != 0)
+  {
+    ec.assign(errno, asio::error::get_system_category());
+    return;
+  }
+
+# if defined(ASIO_HAS_NUMA)
+  numa_node_binding<>::tag_ = node < UCHAR_MAX
+    ? static_cast<unsigned char>(node + 1) : 0;
+# endif // defined(ASIO_HAS_NUMA)
+
+  ec = asio::error_code();
+#else
+  (void)node;
+  ec = asio::error::operation_not_supported;
+#endif
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_IMPL_THREAD_AFFINITY_IPP
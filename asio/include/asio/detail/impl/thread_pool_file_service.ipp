@@ -0,0 +1,305 @@
+//
+// detail/impl/thread_pool_file_service.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_THREAD_POOL_FILE_SERVICE_IPP
+#define ASIO_DETAIL_IMPL_THREAD_POOL_FILE_SERVICE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_THREAD_POOL_FILE)
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include "asio/config.hpp"
+#include "asio/detail/thread_pool_file_service.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class thread_pool_file_service::work_scheduler_runner
+{
+public:
+  work_scheduler_runner(scheduler& work_scheduler)
+    : work_scheduler_(work_scheduler)
+  {
+  }
+
+  void operator()()
+  {
+    asio::error_code ec;
+    work_scheduler_.run(ec);
+  }
+
+private:
+  scheduler& work_scheduler_;
+};
+
+thread_pool_file_service::thread_pool_file_service(
+    execution_context& context)
+  : execution_context_service_base<thread_pool_file_service>(context),
+    scheduler_(asio::use_service<scheduler>(context)),
+    work_scheduler_(scheduler::internal(), context),
+    work_threads_(execution_context::allocator<void>(context)),
+    num_work_threads_(config(context).get("file", "threads", 4U)),
+    readahead_(config(context).get("file", "readahead", std::size_t(0))),
+    scheduler_locking_(config(context).get("scheduler", "locking", true)),
+    shutdown_(false)
+{
+  if (num_work_threads_ == 0)
+    num_work_threads_ = 1;
+  work_scheduler_.work_started();
+}
+
+thread_pool_file_service::~thread_pool_file_service()
+{
+  shutdown();
+}
+
+void thread_pool_file_service::shutdown()
+{
+  if (!shutdown_)
+  {
+    work_scheduler_.work_finished();
+    work_scheduler_.stop();
+    work_threads_.join();
+    work_scheduler_.shutdown();
+    shutdown_ = true;
+  }
+}
+
+void thread_pool_file_service::notify_fork(
+    execution_context::fork_event fork_ev)
+{
+  if (!work_threads_.empty())
+  {
+    if (fork_ev == execution_context::fork_prepare)
+    {
+      work_scheduler_.stop();
+      work_threads_.join();
+    }
+  }
+  else if (fork_ev != execution_context::fork_prepare)
+  {
+    work_scheduler_.restart();
+  }
+}
+
+asio::error_code thread_pool_file_service::open(
+    thread_pool_file_service::implementation_type& impl,
+    const char* path, file_base::flags open_flags,
+    asio::error_code& ec)
+{
+  if (is_open(impl))
+  {
+    ec = asio::error::already_open;
+    ASIO_ERROR_LOCATION(ec);
+    return ec;
+  }
+
+  descriptor_ops::state_type state = 0;
+  int fd = descriptor_ops::open(path, static_cast<int>(open_flags), 0777, ec);
+  if (fd < 0)
+  {
+    ASIO_ERROR_LOCATION(ec);
+    return ec;
+  }
+
+  // We're done. Take ownership of the file descriptor.
+  if (assign(impl, fd, ec))
+  {
+    asio::error_code ignored_ec;
+    descriptor_ops::close(fd, state, ignored_ec);
+    ASIO_ERROR_LOCATION(ec);
+    return ec;
+  }
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+  (void)::posix_fadvise(fd, 0, 0,
+      impl.is_stream_ ? POSIX_FADV_SEQUENTIAL : POSIX_FADV_RANDOM);
+#endif // defined(POSIX_FADV_SEQUENTIAL)
+
+  return ec;
+}
+
+asio::error_code thread_pool_file_service::assign(
+    thread_pool_file_service::implementation_type& impl,
+    const native_handle_type& native_descriptor,
+    asio::error_code& ec)
+{
+  if (is_open(impl))
+  {
+    ec = asio::error::already_open;
+    ASIO_ERROR_LOCATION(ec);
+    return ec;
+  }
+
+  impl.file_ = std::allocate_shared<thread_pool_file_state>(
+      execution_context::allocator<void>(context()), native_descriptor);
+  impl.descriptor_ = native_descriptor;
+  ec = asio::error_code();
+  return ec;
+}
+
+asio::error_code thread_pool_file_service::close(
+    thread_pool_file_service::implementation_type& impl,
+    asio::error_code& ec)
+{
+  if (is_open(impl))
+  {
+    ASIO_HANDLER_OPERATION((scheduler_.context(),
+          "file", &impl, impl.descriptor_, "close"));
+
+    impl.file_->close(ec);
+    impl.file_.reset();
+    impl.descriptor_ = -1;
+  }
+  else
+  {
+    ec = asio::error_code();
+  }
+
+  ASIO_ERROR_LOCATION(ec);
+  return ec;
+}
+
+thread_pool_file_service::native_handle_type
+thread_pool_file_service::release(
+    thread_pool_file_service::implementation_type& impl,
+    asio::error_code& ec)
+{
+  ec = asio::error_code();
+  if (!is_open(impl))
+    return -1;
+
+  ASIO_HANDLER_OPERATION((scheduler_.context(),
+        "file", &impl, impl.descriptor_, "release"));
+
+  int descriptor = impl.file_->release();
+  impl.file_.reset();
+  impl.descriptor_ = -1;
+  return descriptor;
+}
+
+asio::error_code thread_pool_file_service::cancel(
+    thread_pool_file_service::implementation_type& impl,
+    asio::error_code& ec)
+{
+  if (!is_open(impl))
+  {
+    ec = asio::error::bad_descriptor;
+    ASIO_ERROR_LOCATION(ec);
+    return ec;
+  }
+
+  ASIO_HANDLER_OPERATION((scheduler_.context(),
+        "file", &impl, impl.descriptor_, "cancel"));
+
+  impl.file_->cancel();
+  ec = asio::error_code();
+  return ec;
+}
+
+uint64_t thread_pool_file_service::size(
+    const thread_pool_file_service::implementation_type& impl,
+    asio::error_code& ec) const
+{
+  struct stat s;
+  int result = ::fstat(native_handle(impl), &s);
+  descriptor_ops::get_last_error(ec, result != 0);
+  ASIO_ERROR_LOCATION(ec);
+  return !ec ? s.st_size : 0;
+}
+
+asio::error_code thread_pool_file_service::resize(
+    thread_pool_file_service::implementation_type& impl,
+    uint64_t n, asio::error_code& ec)
+{
+  int result = ::ftruncate(native_handle(impl), n);
+  descriptor_ops::get_last_error(ec, result != 0);
+  ASIO_ERROR_LOCATION(ec);
+  return ec;
+}
+
+asio::error_code thread_pool_file_service::sync_all(
+    thread_pool_file_service::implementation_type& impl,
+    asio::error_code& ec)
+{
+  descriptor_ops::sync(native_handle(impl),
+      descriptor_ops::sync_all_type, 0, 0, ec);
+  ASIO_ERROR_LOCATION(ec);
+  return ec;
+}
+
+asio::error_code thread_pool_file_service::sync_data(
+    thread_pool_file_service::implementation_type& impl,
+    asio::error_code& ec)
+{
+  descriptor_ops::sync(native_handle(impl),
+      descriptor_ops::sync_data_type, 0, 0, ec);
+  ASIO_ERROR_LOCATION(ec);
+  return ec;
+}
+
+uint64_t thread_pool_file_service::seek(
+    thread_pool_file_service::implementation_type& impl, int64_t offset,
+    file_base::seek_basis whence, asio::error_code& ec)
+{
+  int64_t result = ::lseek(native_handle(impl), offset, whence);
+  descriptor_ops::get_last_error(ec, result < 0);
+  ASIO_ERROR_LOCATION(ec);
+  return !ec ? static_cast<uint64_t>(result) : 0;
+}
+
+void thread_pool_file_service::start_op(
+    thread_pool_file_service::implementation_type& impl,
+    thread_pool_file_op* op, bool is_continuation)
+{
+  if (!impl.file_)
+  {
+    op->ec_ = asio::error::bad_descriptor;
+    scheduler_.post_immediate_completion(op, is_continuation);
+  }
+  else if (!scheduler_locking_)
+  {
+    // Completions cannot be posted from another thread, so the operation is
+    // performed by the initiating thread.
+    op->perform();
+    scheduler_.post_immediate_completion(op, is_continuation);
+  }
+  else
+  {
+    start_work_threads();
+    scheduler_.work_started();
+    work_scheduler_.post_immediate_completion(op, false);
+  }
+}
+
+void thread_pool_file_service::start_work_threads()
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  if (work_threads_.empty())
+    for (unsigned int i = 0; i < num_work_threads_; ++i)
+      work_threads_.create_thread(work_scheduler_runner(work_scheduler_));
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_THREAD_POOL_FILE)
+
+#endif // ASIO_DETAIL_IMPL_THREAD_POOL_FILE_SERVICE_IPP
@@ -53,6 +53,12 @@ bool timer_queue<time_traits<boost::posix_time::ptime>,
   return impl_.empty();
 }
 
+std::size_t timer_queue<time_traits<boost::posix_time::ptime>,
+    execution_context::allocator<void>>::size() const
+{
+  return impl_.size();
+}
+
 long timer_queue<time_traits<boost::posix_time::ptime>,
     execution_context::allocator<void>>::wait_duration_msec(
       long max_duration) const
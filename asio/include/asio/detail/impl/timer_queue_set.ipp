@@ -65,6 +65,14 @@ bool timer_queue_set::all_empty() const
   return true;
 }
 
+std::size_t timer_queue_set::total_size() const
+{
+  std::size_t n = 0;
+  for (timer_queue_base* p = first_; p; p = p->next_)
+    n += p->size();
+  return n;
+}
+
 long timer_queue_set::wait_duration_msec(long max_duration) const
 {
   long min_duration = max_duration;
@@ -32,6 +32,7 @@ namespace detail {
 win_iocp_file_service::win_iocp_file_service(
     execution_context& context)
   : execution_context_service_base<win_iocp_file_service>(context),
+    iocp_service_(asio::use_service<win_iocp_io_context>(context)),
     handle_service_(context),
     nt_flush_buffers_file_ex_(0)
 {
@@ -93,6 +94,8 @@ asio::error_code win_iocp_file_service::open(
     flags |= FILE_FLAG_RANDOM_ACCESS;
   if ((open_flags & file_base::sync_all_on_write) != 0)
     flags |= FILE_FLAG_WRITE_THROUGH;
+  if ((open_flags & file_base::direct) != 0)
+    flags |= FILE_FLAG_NO_BUFFERING;
 
   impl.offset_ = 0;
   HANDLE handle = ::CreateFileA(path, access, share, 0, disposition, flags, 0);
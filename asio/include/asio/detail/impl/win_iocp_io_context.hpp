@@ -61,6 +61,7 @@ void win_iocp_io_context::schedule_timer(
 
   bool earliest = queue.enqueue_timer(time, timer, op);
   work_started();
+  record_pending_timers();
   if (earliest)
     update_timeout();
 }
@@ -78,6 +79,7 @@ std::size_t win_iocp_io_context::cancel_timer(
   mutex::scoped_lock lock(dispatch_mutex_);
   op_queue<win_iocp_operation> ops;
   std::size_t n = queue.cancel_timer(timer, ops, max_cancelled);
+  record_pending_timers();
   lock.unlock();
   post_deferred_completions(ops);
   return n;
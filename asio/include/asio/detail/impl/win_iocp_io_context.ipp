@@ -88,7 +88,8 @@ win_iocp_io_context::win_iocp_io_context(
     shutdown_(0),
     gqcs_timeout_(get_gqcs_timeout()),
     dispatch_required_(0),
-    concurrency_hint_(config(ctx).get("scheduler", "concurrency_hint", -1))
+    concurrency_hint_(config(ctx).get("scheduler", "concurrency_hint", -1)),
+    metrics_(config(ctx).get("scheduler", "metrics", false))
 {
   ASIO_HANDLER_TRACKING_INIT;
 
@@ -114,7 +115,8 @@ win_iocp_io_context::win_iocp_io_context(
     shutdown_(0),
     gqcs_timeout_(get_gqcs_timeout()),
     dispatch_required_(0),
-    concurrency_hint_(-1)
+    concurrency_hint_(-1),
+    metrics_(false)
 {
   ASIO_HANDLER_TRACKING_INIT;
 
@@ -427,6 +429,7 @@ size_t win_iocp_io_context::do_one(DWORD msec,
       op_queue<win_iocp_operation> ops;
       ops.push(completed_ops_);
       timer_queues_.get_ready_timers(ops);
+      record_pending_timers();
       post_deferred_completions(ops);
       update_timeout();
     }
@@ -435,11 +438,18 @@ size_t win_iocp_io_context::do_one(DWORD msec,
     DWORD bytes_transferred = 0;
     dword_ptr_t completion_key = 0;
     LPOVERLAPPED overlapped = 0;
-    ::SetLastError(0);
-    BOOL ok = ::GetQueuedCompletionStatus(iocp_.handle,
-        &bytes_transferred, &completion_key, &overlapped,
-        msec < gqcs_timeout_ ? msec : gqcs_timeout_);
-    DWORD last_error = ::GetLastError();
+    BOOL ok;
+    DWORD last_error;
+    {
+      scheduler_metrics::scoped_timer timer(
+          metrics_, scheduler_metrics::task_activity);
+      ::SetLastError(0);
+      ok = ::GetQueuedCompletionStatus(iocp_.handle,
+          &bytes_transferred, &completion_key, &overlapped,
+          msec < gqcs_timeout_ ? msec : gqcs_timeout_);
+      last_error = ::GetLastError();
+      metrics_.record_task_run(overlapped ? 1 : 0);
+    }
 
     if (overlapped)
     {
@@ -474,6 +484,8 @@ size_t win_iocp_io_context::do_one(DWORD msec,
         // Ensure the count of outstanding work is decremented on block exit.
         work_finished_on_block_exit on_exit = { this };
         (void)on_exit;
+        scheduler_metrics::scoped_timer timer(
+            metrics_, scheduler_metrics::handler_activity);
 
         op->complete(this, result_ec, bytes_transferred);
         this_thread.rethrow_pending_exception();
@@ -589,6 +601,12 @@ void win_iocp_io_context::do_remove_timer_queue(timer_queue_base& queue)
   timer_queues_.erase(&queue);
 }
 
+void win_iocp_io_context::record_pending_timers()
+{
+  if (metrics_.enabled())
+    metrics_.record_pending_timers(timer_queues_.total_size());
+}
+
 void win_iocp_io_context::update_timeout()
 {
   if (timer_thread_.joinable())
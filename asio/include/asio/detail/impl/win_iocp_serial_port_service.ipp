@@ -190,6 +190,25 @@ asio::error_code win_iocp_serial_port_service::do_get_option(
   return load(option, dcb, ec);
 }
 
+std::size_t win_iocp_serial_port_service::available(
+    const win_iocp_serial_port_service::implementation_type& impl,
+    asio::error_code& ec) const
+{
+  DWORD errors = 0;
+  ::COMSTAT status;
+  if (!::ClearCommError(handle_service_.native_handle(impl), &errors, &status))
+  {
+    DWORD last_error = ::GetLastError();
+    ec = asio::error_code(last_error,
+        asio::error::get_system_category());
+    ASIO_ERROR_LOCATION(ec);
+    return 0;
+  }
+
+  ec = asio::error_code();
+  return status.cbInQue;
+}
+
 } // namespace detail
 } // namespace asio
 
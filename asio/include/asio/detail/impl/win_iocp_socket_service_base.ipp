@@ -97,6 +97,26 @@ void win_iocp_socket_service_base::base_move_construct(
   impl_list_ = &impl;
 }
 
+asio::error_code win_iocp_socket_service_base::base_transfer(
+    win_iocp_socket_service_base::base_implementation_type& impl,
+    win_iocp_socket_service_base& other_service,
+    win_iocp_socket_service_base::base_implementation_type& other_impl,
+    asio::error_code& ec)
+{
+  if (&other_service.iocp_service_ == &iocp_service_
+      || other_impl.socket_ == invalid_socket)
+  {
+    base_move_assign(impl, other_service, other_impl);
+    ec = asio::error_code();
+    return ec;
+  }
+
+  // A socket remains associated with the I/O completion port on which it was
+  // first registered, so it cannot be moved to another io_context.
+  ec = asio::error::operation_not_supported;
+  return ec;
+}
+
 void win_iocp_socket_service_base::base_move_assign(
     win_iocp_socket_service_base::base_implementation_type& impl,
     win_iocp_socket_service_base& other_service,
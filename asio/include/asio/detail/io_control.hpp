@@ -75,6 +75,55 @@ private:
   detail::ioctl_arg_type value_;
 };
 
+#if defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
+
+// I/O control command for getting number of bytes not yet sent on a TCP
+// socket.
+class bytes_unsent
+{
+public:
+  // Default constructor.
+  bytes_unsent()
+    : value_(0)
+  {
+  }
+
+  // Get the name of the IO control command.
+  int name() const
+  {
+    return static_cast<int>(ASIO_OS_DEF(SIOCOUTQNSD));
+  }
+
+  // Set the value of the I/O control command.
+  void set(std::size_t value)
+  {
+    value_ = static_cast<detail::ioctl_arg_type>(value);
+  }
+
+  // Get the current value of the I/O control command.
+  std::size_t get() const
+  {
+    return static_cast<std::size_t>(value_);
+  }
+
+  // Get the address of the command data.
+  detail::ioctl_arg_type* data()
+  {
+    return &value_;
+  }
+
+  // Get the address of the command data.
+  const detail::ioctl_arg_type* data() const
+  {
+    return &value_;
+  }
+
+private:
+  detail::ioctl_arg_type value_;
+};
+
+#endif // defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
+
 } // namespace io_control
 } // namespace detail
 } // namespace asio
@@ -0,0 +1,115 @@
+//
+// detail/io_uring_batch_operation.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IO_URING_BATCH_OPERATION_HPP
+#define ASIO_DETAIL_IO_URING_BATCH_OPERATION_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_IO_URING)
+
+#include <liburing.h>
+#include "asio/detail/atomic_count.hpp"
+#include "asio/detail/operation.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// An operation made up of independent entries, each of which is submitted to
+// io_uring as a separate submission queue entry. Unlike an io_uring_operation,
+// a batch operation does not wait in an I/O object's queue, so all of its
+// entries are in flight at once. The operation completes when every entry has
+// completed.
+class io_uring_batch_operation
+  : public operation
+{
+public:
+  // Identifies an entry's submission. The address of a slot is used as the
+  // submission's user data.
+  struct slot
+  {
+    io_uring_batch_operation* op_;
+  };
+
+  // The error code to be passed to the completion handler.
+  asio::error_code ec_;
+
+  // The number of bytes transferred, to be passed to the completion handler.
+  std::size_t bytes_transferred_;
+
+  // Get the number of entries in the batch.
+  std::size_t size() const
+  {
+    return size_;
+  }
+
+  // Prepare the submission for an entry.
+  void prepare(std::size_t i, ::io_uring_sqe* sqe)
+  {
+    prepare_func_(this, i, sqe);
+  }
+
+  // Record the result of an entry.
+  void complete_entry(std::size_t i, int result)
+  {
+    complete_entry_func_(this, i, result);
+  }
+
+protected:
+  typedef void (*prepare_func_type)(
+      io_uring_batch_operation*, std::size_t, ::io_uring_sqe*);
+  typedef void (*complete_entry_func_type)(
+      io_uring_batch_operation*, std::size_t, int);
+
+  io_uring_batch_operation(const asio::error_code& success_ec,
+      std::size_t size, prepare_func_type prepare_func,
+      complete_entry_func_type complete_entry_func, func_type complete_func)
+    : operation(complete_func),
+      ec_(success_ec),
+      bytes_transferred_(0),
+      size_(size),
+      slots_(size ? new slot[size] : 0),
+      outstanding_(0),
+      prepare_func_(prepare_func),
+      complete_entry_func_(complete_entry_func)
+  {
+    for (std::size_t i = 0; i < size; ++i)
+      slots_[i].op_ = this;
+  }
+
+  ~io_uring_batch_operation()
+  {
+    delete[] slots_;
+  }
+
+private:
+  friend class io_uring_service;
+
+  std::size_t size_;
+  slot* slots_;
+  atomic_count outstanding_;
+  prepare_func_type prepare_func_;
+  complete_entry_func_type complete_entry_func_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_IO_URING)
+
+#endif // ASIO_DETAIL_IO_URING_BATCH_OPERATION_HPP
@@ -632,6 +632,20 @@ public:
     return async_read_some(impl, buffers, handler, io_ex);
   }
 
+  // Start a batch operation, submitting all of its entries together.
+  void start_batch_op(implementation_type& impl,
+      io_uring_batch_operation* op, bool is_continuation)
+  {
+    io_uring_service_.start_batch_op(impl.io_object_data_, op, is_continuation);
+  }
+
+  // Start an operation that is queued behind the descriptor's writes.
+  void start_write_op(implementation_type& impl,
+      io_uring_operation* op, bool is_continuation)
+  {
+    start_op(impl, io_uring_service::write_op, op, is_continuation, false);
+  }
+
 private:
   // Start the asynchronous operation.
   ASIO_DECL void start_op(implementation_type& impl, int op_type,
@@ -0,0 +1,208 @@
+//
+// detail/io_uring_file_batch_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IO_URING_FILE_BATCH_OP_HPP
+#define ASIO_DETAIL_IO_URING_FILE_BATCH_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_FILE) \
+  && defined(ASIO_HAS_IO_URING)
+
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/io_uring_batch_operation.hpp"
+#include "asio/detail/limits.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/error.hpp"
+#include "asio/file_base.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename Request>
+class io_uring_file_batch_op_base : public io_uring_batch_operation
+{
+public:
+  io_uring_file_batch_op_base(const asio::error_code& success_ec,
+      int descriptor, Request* requests, std::size_t count,
+      func_type complete_func)
+    : io_uring_batch_operation(success_ec, count,
+        &io_uring_file_batch_op_base::do_prepare,
+        &io_uring_file_batch_op_base::do_complete_entry, complete_func),
+      descriptor_(descriptor),
+      requests_(requests)
+  {
+    // Requests that are never submitted report that they were aborted.
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      requests_[i].error = asio::error::operation_aborted;
+      requests_[i].bytes_transferred = 0;
+    }
+  }
+
+  static void do_prepare(io_uring_batch_operation* base,
+      std::size_t i, ::io_uring_sqe* sqe)
+  {
+    ASIO_ASSUME(base != 0);
+    io_uring_file_batch_op_base* o(
+        static_cast<io_uring_file_batch_op_base*>(base));
+
+    prepare_request(sqe, o->descriptor_, o->requests_[i]);
+  }
+
+  static void do_complete_entry(io_uring_batch_operation* base,
+      std::size_t i, int result)
+  {
+    ASIO_ASSUME(base != 0);
+    io_uring_file_batch_op_base* o(
+        static_cast<io_uring_file_batch_op_base*>(base));
+
+    Request& request = o->requests_[i];
+    if (result < 0)
+    {
+      request.error = asio::error_code(-result,
+          asio::error::get_system_category());
+      request.bytes_transferred = 0;
+    }
+    else
+    {
+      request.error = o->ec_;
+      request.bytes_transferred = static_cast<std::size_t>(result);
+      check_eof(request);
+    }
+  }
+
+  // Combine the results of the requests into the operation's result.
+  void gather_results()
+  {
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+      if (!this->ec_ && requests_[i].error)
+        this->ec_ = requests_[i].error;
+      this->bytes_transferred_ += requests_[i].bytes_transferred;
+    }
+  }
+
+private:
+  static unsigned request_size(std::size_t n)
+  {
+    return n < (std::numeric_limits<unsigned>::max)()
+      ? static_cast<unsigned>(n) : (std::numeric_limits<unsigned>::max)();
+  }
+
+  static void prepare_request(::io_uring_sqe* sqe,
+      int descriptor, file_base::read_request& request)
+  {
+    ::io_uring_prep_read(sqe, descriptor, request.buffer.data(),
+        request_size(request.buffer.size()), request.offset);
+  }
+
+  static void prepare_request(::io_uring_sqe* sqe,
+      int descriptor, file_base::write_request& request)
+  {
+    ::io_uring_prep_write(sqe, descriptor, request.buffer.data(),
+        request_size(request.buffer.size()), request.offset);
+  }
+
+  static void check_eof(file_base::read_request& request)
+  {
+    if (request.bytes_transferred == 0 && request.buffer.size() != 0)
+      request.error = asio::error::eof;
+  }
+
+  static void check_eof(file_base::write_request&)
+  {
+  }
+
+  int descriptor_;
+  Request* requests_;
+};
+
+template <typename Request, typename Handler, typename IoExecutor>
+class io_uring_file_batch_op
+  : public io_uring_file_batch_op_base<Request>
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(io_uring_file_batch_op);
+
+  io_uring_file_batch_op(const asio::error_code& success_ec,
+      int descriptor, Request* requests, std::size_t count,
+      Handler& handler, const IoExecutor& io_ex)
+    : io_uring_file_batch_op_base<Request>(success_ec, descriptor,
+        requests, count, &io_uring_file_batch_op::do_complete),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    ASIO_ASSUME(base != 0);
+    io_uring_file_batch_op* o(static_cast<io_uring_file_batch_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    if (owner)
+      o->gather_results();
+
+    ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_FILE)
+       //   && defined(ASIO_HAS_IO_URING)
+
+#endif // ASIO_DETAIL_IO_URING_FILE_BATCH_OP_HPP
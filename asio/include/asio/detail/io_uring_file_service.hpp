@@ -24,6 +24,8 @@
 #include "asio/detail/cstdint.hpp"
 #include "asio/detail/descriptor_ops.hpp"
 #include "asio/detail/io_uring_descriptor_service.hpp"
+#include "asio/detail/io_uring_file_batch_op.hpp"
+#include "asio/detail/io_uring_file_sync_op.hpp"
 #include "asio/error.hpp"
 #include "asio/execution_context.hpp"
 #include "asio/file_base.hpp"
@@ -238,7 +240,106 @@ public:
         impl, offset, buffers, handler, io_ex);
   }
 
+  // Start an asynchronous batch of reads. The requests and their buffers must
+  // be valid for the lifetime of the asynchronous operation.
+  template <typename Handler, typename IoExecutor>
+  void async_read_batch_at(implementation_type& impl,
+      file_base::read_request* requests, std::size_t count,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    start_batch_op(impl, requests, count,
+        handler, io_ex, "async_read_batch_at");
+  }
+
+  // Start an asynchronous batch of writes. The requests and their buffers must
+  // be valid for the lifetime of the asynchronous operation.
+  template <typename Handler, typename IoExecutor>
+  void async_write_batch_at(implementation_type& impl,
+      file_base::write_request* requests, std::size_t count,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    start_batch_op(impl, requests, count,
+        handler, io_ex, "async_write_batch_at");
+  }
+
+  // Start an asynchronous synchronisation of the file to disk.
+  template <typename Handler, typename IoExecutor>
+  void async_sync_all(implementation_type& impl,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    start_sync_op(impl, descriptor_ops::sync_all_type, 0, 0,
+        handler, io_ex, "async_sync_all");
+  }
+
+  // Start an asynchronous synchronisation of the file data to disk.
+  template <typename Handler, typename IoExecutor>
+  void async_sync_data(implementation_type& impl,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    start_sync_op(impl, descriptor_ops::sync_data_type, 0, 0,
+        handler, io_ex, "async_sync_data");
+  }
+
+  // Start an asynchronous synchronisation of a range of the file to disk.
+  template <typename Handler, typename IoExecutor>
+  void async_sync_range(implementation_type& impl, uint64_t offset,
+      uint64_t size, Handler& handler, const IoExecutor& io_ex)
+  {
+    start_sync_op(impl, descriptor_ops::sync_range_type, offset, size,
+        handler, io_ex, "async_sync_range");
+  }
+
 private:
+  // Allocate and start a batch operation.
+  template <typename Request, typename Handler, typename IoExecutor>
+  void start_batch_op(implementation_type& impl, Request* requests,
+      std::size_t count, Handler& handler, const IoExecutor& io_ex,
+      const char* op_name)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_file_batch_op<Request, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, native_handle(impl),
+        requests, count, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((descriptor_service_.context(), *p.p,
+          "file", &impl, native_handle(impl), op_name));
+    (void)op_name;
+
+    descriptor_service_.start_batch_op(impl, p.p, is_continuation);
+    p.v = p.p = 0;
+  }
+
+  // Allocate and start a synchronisation operation. The operation is queued
+  // behind the file's outstanding writes. It is not submitted with a drain
+  // flag, as that would also wait for unrelated entries, such as socket reads.
+  template <typename Handler, typename IoExecutor>
+  void start_sync_op(implementation_type& impl,
+      descriptor_ops::sync_type type, uint64_t offset, uint64_t size,
+      Handler& handler, const IoExecutor& io_ex, const char* op_name)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_file_sync_op<Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, native_handle(impl),
+        type, offset, size, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((descriptor_service_.context(), *p.p,
+          "file", &impl, native_handle(impl), op_name));
+    (void)op_name;
+
+    descriptor_service_.start_write_op(impl, p.p, is_continuation);
+    p.v = p.p = 0;
+  }
+
   // The implementation used for initiating asynchronous operations.
   descriptor_service descriptor_service_;
 
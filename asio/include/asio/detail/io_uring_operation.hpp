@@ -20,6 +20,7 @@
 #if defined(ASIO_HAS_IO_URING)
 
 #include <liburing.h>
+#include "asio/detail/chrono.hpp"
 #include "asio/detail/cstdint.hpp"
 #include "asio/detail/operation.hpp"
 
@@ -41,6 +42,45 @@ public:
   // The operation key used for targeted cancellation.
   void* cancellation_key_;
 
+  // The flags from the completion queue entry, for multishot submissions.
+  unsigned cqe_flags_;
+
+  // The type of a function used to dispose of a multishot result that will
+  // never be delivered to an operation.
+  typedef void (*discard_func_type)(void* context, int result, unsigned flags);
+
+  // Set by the prepare function when the operation has been prepared as a
+  // multishot submission. Null for single-shot submissions.
+  discard_func_type multishot_discard_func_;
+
+  // The context passed to the discard function.
+  void* multishot_context_;
+
+  // Whether a timeout is to be linked to each submission of the operation.
+  bool has_link_timeout_;
+
+  // The absolute deadline of the linked timeout, on the monotonic clock.
+  __kernel_timespec link_timeout_;
+
+  // Link a timeout, expiring at the specified deadline, to the operation.
+  void set_link_timeout(const chrono::steady_clock::time_point& deadline)
+  {
+    chrono::nanoseconds ns = chrono::duration_cast<chrono::nanoseconds>(
+        deadline.time_since_epoch());
+    has_link_timeout_ = true;
+    link_timeout_.tv_sec = ns.count() / 1000000000;
+    link_timeout_.tv_nsec = ns.count() % 1000000000;
+  }
+
+  // Whether the deadline of the linked timeout has been reached.
+  bool link_timeout_expired() const
+  {
+    chrono::nanoseconds ns = chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch());
+    return has_link_timeout_ && ns.count()
+      >= link_timeout_.tv_sec * 1000000000 + link_timeout_.tv_nsec;
+  }
+
   // Prepare the operation.
   void prepare(::io_uring_sqe* sqe)
   {
@@ -50,7 +90,10 @@ public:
   // Perform actions associated with the operation. Returns true when complete.
   bool perform(bool after_completion)
   {
-    return perform_func_(this, after_completion);
+    bool result = perform_func_(this, after_completion);
+    if (result)
+      set_latency_ready();
+    return result;
   }
 
 protected:
@@ -64,6 +107,10 @@ protected:
       ec_(success_ec),
       bytes_transferred_(0),
       cancellation_key_(0),
+      cqe_flags_(0),
+      multishot_discard_func_(0),
+      multishot_context_(0),
+      has_link_timeout_(false),
       prepare_func_(prepare_func),
       perform_func_(perform_func)
   {
@@ -19,10 +19,12 @@
 
 #if defined(ASIO_HAS_IO_URING)
 
+#include <vector>
 #include <liburing.h>
 #include "asio/detail/atomic_count.hpp"
 #include "asio/detail/buffer_sequence_adapter.hpp"
 #include "asio/detail/conditionally_enabled_mutex.hpp"
+#include "asio/detail/io_uring_batch_operation.hpp"
 #include "asio/detail/io_uring_operation.hpp"
 #include "asio/detail/limits.hpp"
 #include "asio/detail/object_pool.hpp"
@@ -48,7 +50,21 @@ private:
   typedef conditionally_enabled_mutex mutex;
 
 public:
-  enum op_types { read_op = 0, write_op = 1, except_op = 2, max_ops = 3 };
+  enum op_types { read_op = 0, write_op = 1,
+    except_op = 2, peer_closed_op = 3, max_ops = 4 };
+
+  // Kernel features that are detected when the ring is created.
+  enum capability_bits
+  {
+    fast_poll_capability = 1,
+    multishot_accept_capability = 2,
+    multishot_recv_capability = 4,
+    send_zc_capability = 8,
+    buffer_ring_capability = 16,
+    msg_ring_capability = 32,
+    close_capability = 64,
+    shutdown_capability = 128
+  };
 
   class io_object;
 
@@ -57,28 +73,80 @@ public:
   {
     friend class io_uring_service;
 
+    // A completion received for a multishot submission.
+    struct multishot_result
+    {
+      int result_;
+      unsigned flags_;
+    };
+
     io_object* io_object_;
     op_queue<io_uring_operation> op_queue_;
     bool cancel_requested_;
 
+    // Whether a multishot submission is outstanding for the queue.
+    bool multishot_;
+
+    // Whether the queue has been posted to deliver multishot results.
+    bool multishot_posted_;
+
+    // Used to dispose of multishot results that are never delivered.
+    io_uring_operation::discard_func_type multishot_discard_func_;
+    void* multishot_context_;
+
+    // Multishot results that have not yet been delivered to an operation.
+    std::vector<multishot_result> multishot_results_;
+
     ASIO_DECL io_queue();
     void set_result(int r) { task_result_ = static_cast<unsigned>(r); }
     ASIO_DECL operation* perform_io(int result);
     ASIO_DECL static void do_complete(void* owner, operation* base,
         const asio::error_code& ec, std::size_t bytes_transferred);
+
+    // Get the user data used for the queue's current submission. Multishot
+    // submissions are tagged so that their completions can be identified.
+    void* user_data()
+    {
+      return multishot_ ? static_cast<void*>(reinterpret_cast<char*>(this) + 1)
+        : static_cast<void*>(this);
+    }
+
+    // Add a multishot result to the queue. Returns true if the queue needs to
+    // be posted for completion.
+    ASIO_DECL bool push_multishot_result(int result, unsigned flags);
+
+    // Deliver queued multishot results to waiting operations.
+    ASIO_DECL void deliver_multishot_results(op_queue<operation>& ops);
+
+    // Dispose of any multishot results that have not been delivered.
+    ASIO_DECL void discard_multishot_results();
+
+    // Whether the queue has a submission or multishot results outstanding.
+    bool busy() const
+    {
+      return !op_queue_.empty() || multishot_ || multishot_posted_;
+    }
   };
 
   // Per I/O object state.
   struct io_object
   {
     io_object* next_;
-    io_object* prev_;
+    io_object* next_free_;
+    bool live_;
 
     mutex mutex_;
     io_uring_service* service_;
     io_queue queues_[max_ops];
     bool shutdown_;
 
+    // The descriptor associated with the I/O object, if any.
+    int descriptor_;
+
+    // The descriptor's index in the registered file table, or -1 if the
+    // descriptor is not registered.
+    int registered_file_;
+
     ASIO_DECL io_object(bool locking, int spin_count);
   };
 
@@ -108,12 +176,33 @@ public:
   ASIO_DECL void register_internal_io_object(
       io_object*& io_obj, int op_type, io_uring_operation* op);
 
+  // Add the descriptor associated with an I/O object to the registered file
+  // table, if enabled. Operations on the I/O object then refer to the
+  // descriptor by its index in the table. The descriptor is removed from the
+  // table when the I/O object is deregistered.
+  ASIO_DECL void register_file(per_io_object_data& io_obj, int descriptor);
+
   // Register buffers with io_uring.
   ASIO_DECL void register_buffers(const ::iovec* v, unsigned n);
 
+  // Register a table of empty buffer slots with io_uring.
+  ASIO_DECL void register_buffers_sparse(unsigned n);
+
+  // Replace the buffers in a range of slots of the registered buffer table.
+  ASIO_DECL asio::error_code update_buffers(unsigned offset,
+      const ::iovec* v, unsigned n, asio::error_code& ec);
+
   // Unregister buffers from io_uring.
   ASIO_DECL void unregister_buffers();
 
+  // Create and register a ring of provided buffers with io_uring.
+  ASIO_DECL ::io_uring_buf_ring* register_buffer_ring(
+      unsigned entries, int group_id);
+
+  // Unregister and destroy a ring of provided buffers.
+  ASIO_DECL void unregister_buffer_ring(
+      ::io_uring_buf_ring* buf_ring, unsigned entries, int group_id);
+
   // Post an operation for immediate completion.
   void post_immediate_completion(operation* op, bool is_continuation);
 
@@ -122,6 +211,22 @@ public:
   ASIO_DECL void start_op(int op_type, per_io_object_data& io_obj,
       io_uring_operation* op, bool is_continuation);
 
+  // Determine whether a new operation of the given type would join an
+  // outstanding multishot submission, rather than having a submission of its
+  // own to which a timeout could be linked.
+  ASIO_DECL bool joins_multishot(int op_type, per_io_object_data& io_obj);
+
+  // Start a batch operation. All of the operation's entries are prepared and
+  // submitted to the io_uring together, without waiting for other operations
+  // on the I/O object.
+  ASIO_DECL void start_batch_op(per_io_object_data& io_obj,
+      io_uring_batch_operation* op, bool is_continuation);
+
+  // Start a batch operation that is not associated with an I/O object, such as
+  // one that closes a descriptor after its I/O object has been deregistered.
+  ASIO_DECL void start_batch_op(
+      io_uring_batch_operation* op, bool is_continuation);
+
   // Cancel all operations associated with the given I/O object. The handlers
   // associated with the I/O object will be invoked with the operation_aborted
   // error.
@@ -184,25 +289,52 @@ public:
   // Interrupt the io_uring wait.
   ASIO_DECL void interrupt();
 
-private:
-  // The hint to pass to io_uring_queue_init to size its data structures.
-  enum { ring_size = 16384 };
+  // Whether threads other than the one running the task may reap completions.
+  bool supports_concurrent_run() const
+  {
+    return concurrent_reaping_;
+  }
 
-  // The number of operations to submit in a batch.
-  enum { submit_batch_size = 128 };
+  // Reap completions without blocking, unless another thread is doing so.
+  ASIO_DECL void run_concurrently(op_queue<operation>& ops);
 
-  // The number of operations to complete in a batch.
-  enum { complete_batch_size = 128 };
+  // Get the kernel features supported by the ring, as capability_bits.
+  int capabilities() const
+  {
+    return capabilities_;
+  }
 
+private:
   // The type used for processing eventfd readiness notifications.
   class event_fd_read_op;
 
+  // Get the number of submission queue entries with which to create the ring.
+  ASIO_DECL static unsigned get_ring_size(asio::execution_context& ctx);
+
   // Initialise the ring.
   ASIO_DECL void init_ring();
 
+  // Determine the kernel features supported by the ring.
+  ASIO_DECL void init_capabilities(const ::io_uring_params& params);
+
+  // Get the io_uring service that is the task of the scheduler running on the
+  // current thread, if any.
+  ASIO_DECL static io_uring_service* calling_thread_service();
+
+  // Interrupt another service's io_uring wait by sending a message from this
+  // ring. Returns false if the message could not be sent.
+  ASIO_DECL bool send_msg_ring(io_uring_service& target);
+
   // Register the eventfd descriptor for readiness notifications.
   ASIO_DECL void register_with_reactor();
 
+  // Create the registered file table and add the descriptors of all
+  // registered I/O objects.
+  ASIO_DECL void init_registered_files();
+
+  // Remove a descriptor from the registered file table.
+  ASIO_DECL void unregister_file(int registered_file);
+
   // Allocate a new I/O object.
   ASIO_DECL io_object* allocate_io_object();
 
@@ -221,6 +353,20 @@ private:
   // Helper function to remove a timer queue.
   ASIO_DECL void do_remove_timer_queue(timer_queue_base& queue);
 
+  // Sample the number of pending timers, if metrics are enabled. The lock must
+  // be held.
+  ASIO_DECL void record_pending_timers();
+
+  // Reap up to a batch of completions. The completion queue lock must be held
+  // on entry, and is released before the completions are processed. Returns
+  // the number of completions reaped.
+  ASIO_DECL int reap_completions(mutex::scoped_lock& completion_lock,
+      bool running_task, op_queue<operation>& ops);
+
+  // Collect the timers that are ready, restarting the timeout operation if it
+  // has expired.
+  ASIO_DECL void process_timers(bool timeout_expired, op_queue<operation>& ops);
+
   // Called to recalculate and update the timeout.
   ASIO_DECL void update_timeout();
 
@@ -230,9 +376,38 @@ private:
   // Get a new submission queue entry, flushing the queue if necessary.
   ASIO_DECL ::io_uring_sqe* get_sqe();
 
+  // Get a submission queue entry for an operation, ensuring that there is
+  // room for the adjacent entry of any linked timeout.
+  ASIO_DECL ::io_uring_sqe* get_sqe(io_uring_operation* op);
+
+  // Prepare the operation at the head of an I/O queue for submission.
+  ASIO_DECL void prepare_op(io_queue* io_q,
+      io_uring_operation* op, ::io_uring_sqe* sqe);
+
+  // Prepare and submit the entries of a batch operation. The I/O object, if
+  // any, must be locked by the caller.
+  ASIO_DECL void prepare_batch_op(
+      io_object* io_obj, io_uring_batch_operation* op);
+
+  // Release the count held while a batch operation's entries were prepared.
+  ASIO_DECL void finish_batch_op(io_uring_batch_operation* op);
+
+  // Refer to an I/O object's descriptor by its index in the registered file
+  // table, if it has one.
+  ASIO_DECL void use_registered_file(io_object* io_obj, ::io_uring_sqe* sqe);
+
+  // Dispatch a completion queue entry that belongs to an I/O queue or to an
+  // entry of a batch operation.
+  ASIO_DECL void dispatch_cqe(void* ptr,
+      const ::io_uring_cqe* cqe, op_queue<operation>& ops);
+
   // Submit pending submission queue entries.
   ASIO_DECL void submit_sqes();
 
+  // Get the number of pending entries at which they are submitted directly,
+  // rather than by posting an operation.
+  ASIO_DECL int submit_batch_size() const;
+
   // Post an operation to submit the pending submission queue entries.
   ASIO_DECL void post_submit_sqes_op(mutex::scoped_lock& lock);
 
@@ -263,6 +438,9 @@ private:
   // The count of unfinished work.
   atomic_count outstanding_work_;
 
+  // The number of batch operations with entries that have not completed.
+  atomic_count outstanding_batch_ops_;
+
   // The operation used to submit the pending submission queue entries.
   submit_sqes_op submit_sqes_op_;
 
@@ -281,6 +459,51 @@ private:
   // How any times to spin waiting for the I/O mutex.
   const int io_locking_spin_count_;
 
+  // Whether the submission queue is polled by a kernel thread.
+  const bool sqpoll_;
+
+  // The CPU to which the submission queue polling thread is bound, or -1.
+  const int sqpoll_cpu_;
+
+  // The time, in milliseconds, before an idle polling thread goes to sleep.
+  const unsigned sqpoll_idle_;
+
+  // Whether only a single thread submits to the ring.
+  const bool single_issuer_;
+
+  // Whether completion work is deferred until the ring is waited on.
+  const bool defer_taskrun_;
+
+  // The number of entries in the registered file table.
+  const unsigned registered_files_;
+
+  // The hint to pass to io_uring_queue_init to size its data structures.
+  const unsigned ring_size_;
+
+  // The number of operations to submit in a batch.
+  const int submit_batch_size_;
+
+  // The number of completions reaped by each run of the task. A smaller batch
+  // returns the task to the scheduler sooner, so that reaping passes between
+  // the threads running the io_context.
+  const int complete_batch_size_;
+
+  // Whether idle threads reap completions while another thread runs the task.
+  const bool concurrent_reaping_;
+
+  // Mutex to protect the consumption of the completion queue. Only enabled
+  // when completions are reaped concurrently.
+  mutex completion_mutex_;
+
+  // Whether the batch size is adapted to the number of outstanding operations.
+  const bool adaptive_submit_;
+
+  // Whether other io_uring services may be interrupted using ring messages.
+  bool msg_ring_wakeups_;
+
+  // The kernel features supported by the ring.
+  int capabilities_;
+
   // The timer queues.
   timer_queue_set timer_queues_;
 
@@ -288,13 +511,21 @@ private:
   // operation is outstanding.
   __kernel_timespec timeout_;
 
-  // Mutex to protect access to the registered I/O objects.
+  // Mutex to protect access to the registered file table.
   mutex registration_mutex_;
 
-  // Keep track of all registered I/O objects.
+  // Keep track of all registered I/O objects. The pool may be used without
+  // locking.
   object_pool<io_object, execution_context::allocator<void>>
     registered_io_objects_;
 
+  // The unused entries in the registered file table that have previously been
+  // allocated. Protected by the registration mutex.
+  std::vector<int> free_registered_files_;
+
+  // The next registered file table entry that has never been allocated.
+  unsigned next_registered_file_;
+
   // Helper class to do post-perform_io cleanup.
   struct perform_io_cleanup_on_block_exit;
   friend struct perform_io_cleanup_on_block_exit;
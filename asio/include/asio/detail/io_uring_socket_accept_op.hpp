@@ -51,6 +51,7 @@ public:
       peer_endpoint_(peer_endpoint),
       addrlen_(peer_endpoint ? peer_endpoint->capacity() : 0)
   {
+    set_latency_kind(latency_accept);
   }
 
   static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
@@ -63,6 +64,15 @@ public:
     {
       ::io_uring_prep_poll_add(sqe, o->socket_, POLLIN);
     }
+#if defined(IORING_ACCEPT_MULTISHOT)
+    else if ((o->state_ & socket_ops::multishot_accept) != 0)
+    {
+      // The peer address is not captured by a multishot accept, as the
+      // submission outlives the operation that prepared it.
+      ::io_uring_prep_multishot_accept(sqe, o->socket_, 0, 0, 0);
+      o->multishot_discard_func_ = &io_uring_socket_accept_op_base::do_discard;
+    }
+#endif // defined(IORING_ACCEPT_MULTISHOT)
     else
     {
       ::io_uring_prep_accept(sqe, o->socket_,
@@ -96,11 +106,33 @@ public:
     }
 
     if (after_completion && !o->ec_)
+    {
       o->new_socket_.reset(static_cast<int>(o->bytes_transferred_));
+      if (o->multishot_discard_func_ && o->peer_endpoint_)
+      {
+        asio::error_code ec;
+        std::size_t addrlen = o->peer_endpoint_->capacity();
+        if (socket_ops::getpeername(o->new_socket_.get(),
+              o->peer_endpoint_->data(), &addrlen, false, ec) == 0)
+          o->addrlen_ = static_cast<socklen_t>(addrlen);
+        else
+          o->addrlen_ = 0;
+      }
+    }
 
     return after_completion;
   }
 
+  static void do_discard(void*, int result, unsigned /*flags*/)
+  {
+    if (result >= 0)
+    {
+      asio::error_code ignored_ec;
+      socket_ops::state_type state = 0;
+      socket_ops::close(result, state, true, ignored_ec);
+    }
+  }
+
   void do_assign()
   {
     if (new_socket_.get() != invalid_socket)
@@ -45,6 +45,7 @@ public:
       socket_(socket),
       endpoint_(endpoint)
   {
+    set_latency_kind(latency_connect);
   }
 
   static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
@@ -0,0 +1,243 @@
+//
+// detail/io_uring_socket_recv_all_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IO_URING_SOCKET_RECV_ALL_OP_HPP
+#define ASIO_DETAIL_IO_URING_SOCKET_RECV_ALL_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_IO_URING) && defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/consuming_buffers.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/io_uring_operation.hpp"
+#include "asio/detail/limits.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/socket_op_slots.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename MutableBufferSequence, typename MutableBufferIterator>
+class io_uring_socket_recv_all_op_base : public io_uring_operation
+{
+public:
+  io_uring_socket_recv_all_op_base(const asio::error_code& success_ec,
+      socket_type socket, socket_ops::state_type state,
+      const MutableBufferSequence& buffers,
+      socket_base::message_flags flags, func_type complete_func)
+    : io_uring_operation(success_ec,
+        &io_uring_socket_recv_all_op_base::do_prepare,
+        &io_uring_socket_recv_all_op_base::do_perform, complete_func),
+      socket_(socket),
+      state_(state),
+      buffers_(buffers),
+      flags_(flags),
+      msghdr_()
+  {
+    set_latency_kind(latency_receive);
+  }
+
+  static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
+  {
+    ASIO_ASSUME(base != 0);
+    io_uring_socket_recv_all_op_base* o(
+        static_cast<io_uring_socket_recv_all_op_base*>(base));
+
+    if ((o->state_ & socket_ops::internal_non_blocking) != 0)
+    {
+      ::io_uring_prep_poll_add(sqe, o->socket_, POLLIN);
+    }
+    else
+    {
+      // With MSG_WAITALL the kernel keeps the receive pending until all of the
+      // prepared buffers have been filled, so that a single submission and
+      // completion suffice for an exact read.
+      o->prepare_buffers(o->buffers_.prepare(
+            (std::numeric_limits<std::size_t>::max)()));
+      ::io_uring_prep_recvmsg(sqe, o->socket_,
+          &o->msghdr_, o->flags_ | MSG_WAITALL);
+    }
+  }
+
+  static bool do_perform(io_uring_operation* base, bool after_completion)
+  {
+    ASIO_ASSUME(base != 0);
+    io_uring_socket_recv_all_op_base* o(
+        static_cast<io_uring_socket_recv_all_op_base*>(base));
+
+    if (after_completion && o->ec_ && o->ec_ != asio::error::would_block)
+    {
+      o->bytes_transferred_ = o->buffers_.total_consumed();
+      return true;
+    }
+
+    if ((o->state_ & socket_ops::internal_non_blocking) != 0)
+    {
+      for (;;)
+      {
+        std::size_t bytes_transferred = 0;
+        if (!o->receive_some(o->buffers_.prepare(
+                (std::numeric_limits<std::size_t>::max)()), bytes_transferred))
+          return false;
+
+        if (o->ec_)
+          break;
+
+        o->buffers_.consume(bytes_transferred);
+        if (o->buffers_.empty())
+          break;
+      }
+
+      o->bytes_transferred_ = o->buffers_.total_consumed();
+      return true;
+    }
+
+    if (!after_completion)
+      return false;
+
+    if (o->ec_ == asio::error::would_block)
+    {
+      o->state_ |= socket_ops::internal_non_blocking;
+      return false;
+    }
+
+    // A short receive, such as one interrupted by a signal, is continued by
+    // submitting the operation again, without returning to the scheduler.
+    std::size_t bytes_transferred = o->bytes_transferred_;
+    o->buffers_.consume(bytes_transferred);
+    o->bytes_transferred_ = o->buffers_.total_consumed();
+    if (bytes_transferred == 0 && !o->buffers_.empty())
+    {
+      o->ec_ = asio::error::eof;
+      return true;
+    }
+    return o->buffers_.empty();
+  }
+
+private:
+  template <typename Buffers>
+  void prepare_buffers(const Buffers& buffers)
+  {
+    buffer_sequence_adapter<asio::mutable_buffer, Buffers> bufs(buffers);
+    for (std::size_t i = 0; i < bufs.count(); ++i)
+      bufs_[i] = bufs.buffers()[i];
+    msghdr_.msg_iov = bufs_;
+    msghdr_.msg_iovlen = static_cast<int>(bufs.count());
+  }
+
+  template <typename Buffers>
+  bool receive_some(const Buffers& buffers, std::size_t& bytes_transferred)
+  {
+    buffer_sequence_adapter<asio::mutable_buffer, Buffers> bufs(buffers);
+    return socket_ops::non_blocking_recv(socket_, bufs.buffers(),
+        bufs.count(), flags_, true, ec_, bytes_transferred);
+  }
+
+  socket_type socket_;
+  socket_ops::state_type state_;
+  consuming_buffers<asio::mutable_buffer,
+    MutableBufferSequence, MutableBufferIterator> buffers_;
+  socket_base::message_flags flags_;
+  socket_ops::buf bufs_[buffer_sequence_adapter_base::max_buffers];
+  msghdr msghdr_;
+};
+
+template <typename MutableBufferSequence, typename MutableBufferIterator,
+    typename Handler, typename IoExecutor>
+class io_uring_socket_recv_all_op
+  : public io_uring_socket_recv_all_op_base<
+      MutableBufferSequence, MutableBufferIterator>
+{
+public:
+  ASIO_DEFINE_SLOTTED_HANDLER_PTR(
+      socket_op_slots::read_slot, io_uring_socket_recv_all_op);
+
+  io_uring_socket_recv_all_op(const asio::error_code& success_ec,
+      int socket, socket_ops::state_type state,
+      const MutableBufferSequence& buffers, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+    : io_uring_socket_recv_all_op_base<
+        MutableBufferSequence, MutableBufferIterator>(
+        success_ec, socket, state, buffers, flags,
+        &io_uring_socket_recv_all_op::do_complete),
+      slots_(0),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    ASIO_ASSUME(base != 0);
+    io_uring_socket_recv_all_op* o
+      (static_cast<io_uring_socket_recv_all_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o, o->slots_ };
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+  // The op slots that hold the operation's memory, if any.
+  socket_op_slots* slots_;
+
+private:
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_IO_URING) && defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+
+#endif // ASIO_DETAIL_IO_URING_SOCKET_RECV_ALL_OP_HPP
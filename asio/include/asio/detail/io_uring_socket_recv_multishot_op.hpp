@@ -0,0 +1,202 @@
+//
+// detail/io_uring_socket_recv_multishot_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IO_URING_SOCKET_RECV_MULTISHOT_OP_HPP
+#define ASIO_DETAIL_IO_URING_SOCKET_RECV_MULTISHOT_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_IO_URING)
+
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/io_uring_operation.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/provided_buffer_ring.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class io_uring_socket_recv_multishot_op_base : public io_uring_operation
+{
+public:
+  io_uring_socket_recv_multishot_op_base(const asio::error_code& success_ec,
+      int socket, socket_ops::state_type state, provided_buffer_ring& ring,
+      socket_base::message_flags flags, func_type complete_func)
+    : io_uring_operation(success_ec,
+        &io_uring_socket_recv_multishot_op_base::do_prepare,
+        &io_uring_socket_recv_multishot_op_base::do_perform, complete_func),
+      socket_(socket),
+      state_(state),
+      ring_(ring),
+      flags_(flags),
+      buffer_id_(0)
+  {
+    set_latency_kind(latency_receive);
+  }
+
+  static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
+  {
+    ASIO_ASSUME(base != 0);
+    io_uring_socket_recv_multishot_op_base* o(
+        static_cast<io_uring_socket_recv_multishot_op_base*>(base));
+
+#if defined(IORING_RECV_MULTISHOT)
+    // Buffers are selected by the kernel as data arrives, so the submission
+    // may remain armed after this operation completes.
+    ::io_uring_prep_recv_multishot(sqe, o->socket_, 0, 0, o->flags_);
+    sqe->flags |= IOSQE_BUFFER_SELECT;
+    sqe->buf_group = static_cast<unsigned short>(o->ring_.group_id());
+    o->multishot_discard_func_ =
+      &io_uring_socket_recv_multishot_op_base::do_discard;
+    o->multishot_context_ = &o->ring_;
+#else // defined(IORING_RECV_MULTISHOT)
+    ::io_uring_prep_nop(sqe);
+#endif // defined(IORING_RECV_MULTISHOT)
+  }
+
+  static bool do_perform(io_uring_operation* base, bool after_completion)
+  {
+    ASIO_ASSUME(base != 0);
+    io_uring_socket_recv_multishot_op_base* o(
+        static_cast<io_uring_socket_recv_multishot_op_base*>(base));
+
+    if (!after_completion)
+    {
+#if defined(IORING_RECV_MULTISHOT)
+      // Buffer selection cannot be combined with a user-requested
+      // non-blocking mode, which relies on a readiness test.
+      if ((o->state_ & socket_ops::internal_non_blocking) == 0)
+        return false;
+#endif // defined(IORING_RECV_MULTISHOT)
+      o->ec_ = asio::error::operation_not_supported;
+      return true;
+    }
+
+#if defined(IORING_RECV_MULTISHOT)
+    if ((o->cqe_flags_ & IORING_CQE_F_BUFFER) != 0)
+    {
+      o->buffer_id_ = o->cqe_flags_ >> IORING_CQE_BUFFER_SHIFT;
+      if (o->ec_ || o->bytes_transferred_ == 0)
+        o->ring_.recycle(o->buffer_id_);
+    }
+#endif // defined(IORING_RECV_MULTISHOT)
+
+    if (!o->ec_ && o->bytes_transferred_ == 0)
+      if ((o->state_ & socket_ops::stream_oriented) != 0)
+        o->ec_ = asio::error::eof;
+
+    return true;
+  }
+
+  static void do_discard(void* context, int result, unsigned flags)
+  {
+#if defined(IORING_RECV_MULTISHOT)
+    (void)result;
+    if ((flags & IORING_CQE_F_BUFFER) != 0)
+      static_cast<provided_buffer_ring*>(context)->recycle(
+          flags >> IORING_CQE_BUFFER_SHIFT);
+#else // defined(IORING_RECV_MULTISHOT)
+    (void)context;
+    (void)result;
+    (void)flags;
+#endif // defined(IORING_RECV_MULTISHOT)
+  }
+
+private:
+  int socket_;
+  socket_ops::state_type state_;
+  provided_buffer_ring& ring_;
+  socket_base::message_flags flags_;
+
+protected:
+  std::size_t buffer_id_;
+};
+
+template <typename Handler, typename IoExecutor>
+class io_uring_socket_recv_multishot_op
+  : public io_uring_socket_recv_multishot_op_base
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(io_uring_socket_recv_multishot_op);
+
+  io_uring_socket_recv_multishot_op(const asio::error_code& success_ec,
+      int socket, socket_ops::state_type state, provided_buffer_ring& ring,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+    : io_uring_socket_recv_multishot_op_base(success_ec, socket, state,
+        ring, flags, &io_uring_socket_recv_multishot_op::do_complete),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    ASIO_ASSUME(base != 0);
+    io_uring_socket_recv_multishot_op* o
+      (static_cast<io_uring_socket_recv_multishot_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder3<Handler, asio::error_code, std::size_t, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_, o->buffer_id_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_IO_URING)
+
+#endif // ASIO_DETAIL_IO_URING_SOCKET_RECV_MULTISHOT_OP_HPP
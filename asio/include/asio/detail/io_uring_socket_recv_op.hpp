@@ -21,6 +21,7 @@
 
 #include "asio/detail/bind_handler.hpp"
 #include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/socket_op_slots.hpp"
 #include "asio/detail/socket_ops.hpp"
 #include "asio/detail/fenced_block.hpp"
 #include "asio/detail/handler_work.hpp"
@@ -50,8 +51,12 @@ public:
       bufs_(buffers),
       msghdr_()
   {
-    msghdr_.msg_iov = bufs_.buffers();
-    msghdr_.msg_iovlen = static_cast<int>(bufs_.count());
+    set_latency_kind(latency_receive);
+    if (!bufs_.is_single_buffer)
+    {
+      msghdr_.msg_iov = bufs_.buffers();
+      msghdr_.msg_iovlen = static_cast<int>(bufs_.count());
+    }
   }
 
   static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
@@ -72,6 +77,14 @@ public:
           o->bufs_.buffers()->iov_base, o->bufs_.buffers()->iov_len,
           -1, o->bufs_.registered_id().native_handle());
     }
+    else if (o->bufs_.is_single_buffer)
+    {
+      // A single buffer, as used by connected datagram sockets for each
+      // packet, needs no msghdr.
+      ::io_uring_prep_recv(sqe, o->socket_,
+          o->bufs_.buffers()->iov_base, o->bufs_.buffers()->iov_len,
+          o->flags_);
+    }
     else
     {
       ::io_uring_prep_recvmsg(sqe, o->socket_, &o->msghdr_, o->flags_);
@@ -137,7 +150,8 @@ class io_uring_socket_recv_op
   : public io_uring_socket_recv_op_base<MutableBufferSequence>
 {
 public:
-  ASIO_DEFINE_HANDLER_PTR(io_uring_socket_recv_op);
+  ASIO_DEFINE_SLOTTED_HANDLER_PTR(
+      socket_op_slots::read_slot, io_uring_socket_recv_op);
 
   io_uring_socket_recv_op(const asio::error_code& success_ec,
       int socket, socket_ops::state_type state,
@@ -145,6 +159,7 @@ public:
       Handler& handler, const IoExecutor& io_ex)
     : io_uring_socket_recv_op_base<MutableBufferSequence>(success_ec,
         socket, state, buffers, flags, &io_uring_socket_recv_op::do_complete),
+      slots_(0),
       handler_(static_cast<Handler&&>(handler)),
       work_(handler_, io_ex)
   {
@@ -158,7 +173,7 @@ public:
     ASIO_ASSUME(base != 0);
     io_uring_socket_recv_op* o
       (static_cast<io_uring_socket_recv_op*>(base));
-    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    ptr p = { asio::detail::addressof(o->handler_), o, o, o->slots_ };
 
     ASIO_HANDLER_COMPLETION((*o));
 
@@ -190,6 +205,9 @@ public:
     }
   }
 
+  // The op slots that hold the operation's memory, if any.
+  socket_op_slots* slots_;
+
 private:
   Handler handler_;
   handler_work<Handler, IoExecutor> work_;
@@ -51,6 +51,7 @@ public:
       bufs_(buffers),
       msghdr_()
   {
+    set_latency_kind(latency_receive);
     msghdr_.msg_iov = bufs_.buffers();
     msghdr_.msg_iovlen = static_cast<int>(bufs_.count());
   }
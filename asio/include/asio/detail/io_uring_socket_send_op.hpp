@@ -21,6 +21,7 @@
 
 #include "asio/detail/bind_handler.hpp"
 #include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/socket_op_slots.hpp"
 #include "asio/detail/socket_ops.hpp"
 #include "asio/detail/fenced_block.hpp"
 #include "asio/detail/handler_work.hpp"
@@ -48,10 +49,15 @@ public:
       buffers_(buffers),
       flags_(flags),
       bufs_(buffers),
-      msghdr_()
+      msghdr_(),
+      zero_copy_bytes_(0)
   {
-    msghdr_.msg_iov = bufs_.buffers();
-    msghdr_.msg_iovlen = static_cast<int>(bufs_.count());
+    set_latency_kind(latency_send);
+    if (!bufs_.is_single_buffer)
+    {
+      msghdr_.msg_iov = bufs_.buffers();
+      msghdr_.msg_iovlen = static_cast<int>(bufs_.count());
+    }
   }
 
   static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
@@ -64,6 +70,27 @@ public:
     {
       ::io_uring_prep_poll_add(sqe, o->socket_, POLLOUT);
     }
+#if defined(IORING_CQE_F_NOTIF)
+    else if ((o->state_ & socket_ops::zero_copy) != 0
+        && !o->bufs_.is_registered_buffer
+        && o->bufs_.total_size() >= zero_copy_threshold)
+    {
+      // The kernel posts a second, notification completion once it no longer
+      // needs the buffers. The submission is treated as multishot so that the
+      // operation only completes when that notification arrives.
+      if (o->bufs_.is_single_buffer)
+      {
+        ::io_uring_prep_send_zc(sqe, o->socket_,
+            o->bufs_.buffers()->iov_base, o->bufs_.buffers()->iov_len,
+            o->flags_, 0);
+      }
+      else
+      {
+        ::io_uring_prep_sendmsg_zc(sqe, o->socket_, &o->msghdr_, o->flags_);
+      }
+      o->multishot_discard_func_ = &io_uring_socket_send_op_base::do_discard;
+    }
+#endif // defined(IORING_CQE_F_NOTIF)
     else if (o->bufs_.is_single_buffer
         && o->bufs_.is_registered_buffer && o->flags_ == 0)
     {
@@ -71,6 +98,14 @@ public:
           o->bufs_.buffers()->iov_base, o->bufs_.buffers()->iov_len,
           -1, o->bufs_.registered_id().native_handle());
     }
+    else if (o->bufs_.is_single_buffer)
+    {
+      // A single buffer, as used by connected datagram sockets for each
+      // packet, needs no msghdr.
+      ::io_uring_prep_send(sqe, o->socket_,
+          o->bufs_.buffers()->iov_base, o->bufs_.buffers()->iov_len,
+          o->flags_);
+    }
     else
     {
       ::io_uring_prep_sendmsg(sqe, o->socket_, &o->msghdr_, o->flags_);
@@ -100,6 +135,26 @@ public:
       }
     }
 
+#if defined(IORING_CQE_F_NOTIF)
+    if (after_completion && o->multishot_discard_func_)
+    {
+      if ((o->cqe_flags_ & IORING_CQE_F_NOTIF) != 0)
+      {
+        // The buffers have been released, so report the original result.
+        o->ec_ = o->zero_copy_ec_;
+        o->bytes_transferred_ = o->zero_copy_bytes_;
+        return true;
+      }
+      else if ((o->cqe_flags_ & IORING_CQE_F_MORE) != 0)
+      {
+        // Wait for the notification before completing.
+        o->zero_copy_ec_ = o->ec_;
+        o->zero_copy_bytes_ = o->bytes_transferred_;
+        return false;
+      }
+    }
+#endif // defined(IORING_CQE_F_NOTIF)
+
     if (o->ec_ && o->ec_ == asio::error::would_block)
     {
       o->state_ |= socket_ops::internal_non_blocking;
@@ -109,13 +164,23 @@ public:
     return after_completion;
   }
 
+  static void do_discard(void*, int, unsigned)
+  {
+    // Zero-copy send completions hold no resources.
+  }
+
 private:
+  // Sends smaller than this are copied, as pinning pages costs more.
+  enum { zero_copy_threshold = 16384 };
+
   socket_type socket_;
   socket_ops::state_type state_;
   ConstBufferSequence buffers_;
   socket_base::message_flags flags_;
   buffer_sequence_adapter<asio::const_buffer, ConstBufferSequence> bufs_;
   msghdr msghdr_;
+  asio::error_code zero_copy_ec_;
+  std::size_t zero_copy_bytes_;
 };
 
 template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
@@ -123,7 +188,8 @@ class io_uring_socket_send_op
   : public io_uring_socket_send_op_base<ConstBufferSequence>
 {
 public:
-  ASIO_DEFINE_HANDLER_PTR(io_uring_socket_send_op);
+  ASIO_DEFINE_SLOTTED_HANDLER_PTR(
+      socket_op_slots::write_slot, io_uring_socket_send_op);
 
   io_uring_socket_send_op(const asio::error_code& success_ec,
       int socket, socket_ops::state_type state,
@@ -131,6 +197,7 @@ public:
       Handler& handler, const IoExecutor& io_ex)
     : io_uring_socket_send_op_base<ConstBufferSequence>(success_ec,
         socket, state, buffers, flags, &io_uring_socket_send_op::do_complete),
+      slots_(0),
       handler_(static_cast<Handler&&>(handler)),
       work_(handler_, io_ex)
   {
@@ -144,7 +211,7 @@ public:
     ASIO_ASSUME(base != 0);
     io_uring_socket_send_op* o
       (static_cast<io_uring_socket_send_op*>(base));
-    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    ptr p = { asio::detail::addressof(o->handler_), o, o, o->slots_ };
 
     ASIO_HANDLER_COMPLETION((*o));
 
@@ -176,6 +243,9 @@ public:
     }
   }
 
+  // The op slots that hold the operation's memory, if any.
+  socket_op_slots* slots_;
+
 private:
   Handler handler_;
   handler_work<Handler, IoExecutor> work_;
@@ -29,11 +29,20 @@
 #include "asio/detail/memory.hpp"
 #include "asio/detail/io_uring_null_buffers_op.hpp"
 #include "asio/detail/io_uring_service.hpp"
+#include "asio/detail/io_uring_socket_close_op.hpp"
+#include "asio/detail/io_uring_socket_recv_all_op.hpp"
+#include "asio/detail/io_uring_socket_recv_multishot_op.hpp"
+#include "asio/detail/io_uring_socket_recv_fds_op.hpp"
 #include "asio/detail/io_uring_socket_recv_op.hpp"
 #include "asio/detail/io_uring_socket_recvmsg_op.hpp"
+#include "asio/detail/io_uring_socket_send_all_op.hpp"
+#include "asio/detail/io_uring_socket_send_fds_op.hpp"
 #include "asio/detail/io_uring_socket_send_op.hpp"
+#include "asio/detail/io_uring_socket_shutdown_op.hpp"
 #include "asio/detail/io_uring_wait_op.hpp"
+#include "asio/detail/linked_timeout.hpp"
 #include "asio/detail/socket_holder.hpp"
+#include "asio/detail/socket_op_slots.hpp"
 #include "asio/detail/socket_ops.hpp"
 #include "asio/detail/socket_types.hpp"
 
@@ -59,6 +68,9 @@ public:
 
     // Per I/O object data used by the io_uring_service.
     io_uring_service::per_io_object_data io_object_data_;
+
+    // The memory reserved for operations, if enabled.
+    socket_op_slots* op_slots_;
   };
 
   // Constructor.
@@ -79,6 +91,14 @@ public:
       io_uring_socket_service_base& other_service,
       base_implementation_type& other_impl);
 
+  // Move a socket implementation that belongs to another service into an
+  // empty implementation, moving the socket's registration to this service's
+  // io_uring instance. On failure, neither implementation is changed.
+  ASIO_DECL asio::error_code base_transfer(
+      base_implementation_type& impl,
+      io_uring_socket_service_base& other_service,
+      base_implementation_type& other_impl, asio::error_code& ec);
+
   // Destroy a socket implementation.
   ASIO_DECL void destroy(base_implementation_type& impl);
 
@@ -182,6 +202,9 @@ public:
     case socket_base::wait_error:
       socket_ops::poll_error(impl.socket_, impl.state_, -1, ec);
       break;
+    case socket_base::wait_peer_closed:
+      socket_ops::poll_peer_closed(impl.socket_, impl.state_, -1, ec);
+      break;
     default:
       ec = asio::error::invalid_argument;
       break;
@@ -218,6 +241,12 @@ public:
       op_type = io_uring_service::except_op;
       poll_flags = POLLPRI | POLLERR | POLLHUP;
       break;
+#if defined(POLLRDHUP)
+    case socket_base::wait_peer_closed:
+      op_type = io_uring_service::peer_closed_op;
+      poll_flags = POLLRDHUP | POLLERR | POLLHUP;
+      break;
+#endif // defined(POLLRDHUP)
     default:
       op_type = -1;
       poll_flags = -1;
@@ -246,6 +275,65 @@ public:
     p.v = p.p = 0;
   }
 
+  // Start an asynchronous close. The socket is closed at once, as far as the
+  // implementation is concerned, but the descriptor is closed by submitting
+  // an IORING_OP_CLOSE operation.
+  template <typename Handler, typename IoExecutor>
+  void async_close(base_implementation_type& impl,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_close_op<Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_close"));
+
+    if (begin_close(impl, p.p->ec_))
+      io_uring_service_.start_batch_op(p.p, is_continuation);
+    else
+      io_uring_service_.post_immediate_completion(p.p, is_continuation);
+    p.v = p.p = 0;
+  }
+
+  // Start an asynchronous shutdown by submitting an IORING_OP_SHUTDOWN
+  // operation.
+  template <typename Handler, typename IoExecutor>
+  void async_shutdown(base_implementation_type& impl,
+      socket_base::shutdown_type what, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_shutdown_op<Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_, what, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_shutdown"));
+
+    if ((io_uring_service_.capabilities()
+          & io_uring_service::shutdown_capability) != 0)
+    {
+      io_uring_service_.start_batch_op(
+          impl.io_object_data_, p.p, is_continuation);
+    }
+    else
+    {
+      socket_ops::shutdown(impl.socket_, what, p.p->ec_);
+      io_uring_service_.post_immediate_completion(p.p, is_continuation);
+    }
+    p.v = p.p = 0;
+  }
+
   // Send the given data to the peer.
   template <typename ConstBufferSequence>
   size_t send(base_implementation_type& impl,
@@ -292,13 +380,19 @@ public:
     associated_cancellation_slot_t<Handler> slot
       = asio::get_associated_cancellation_slot(handler);
 
+    chrono::steady_clock::time_point link_timeout;
+    bool has_link_timeout = get_link_timeout(impl,
+        io_uring_service::write_op, handler, link_timeout);
+
     // Allocate and construct an operation to wrap the handler.
     typedef io_uring_socket_send_op<
         ConstBufferSequence, Handler, IoExecutor> op;
+    socket_op_slots* slots = op::ptr::slots_for(op_slots(impl));
     typename op::ptr p = { asio::detail::addressof(handler),
-      op::ptr::allocate(handler), 0 };
+      op::ptr::allocate(handler, slots), 0, slots };
     p.p = new (p.v) op(success_ec_, impl.socket_,
         impl.state_, buffers, flags, handler, io_ex);
+    p.p->slots_ = slots;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected())
@@ -308,6 +402,10 @@ public:
             &impl.io_object_data_, io_uring_service::write_op);
     }
 
+    // Optionally link a timeout requested by the handler.
+    if (has_link_timeout)
+      p.p->set_link_timeout(link_timeout);
+
     ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
           "socket", &impl, impl.socket_, "async_send"));
 
@@ -318,6 +416,132 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(ASIO_HAS_SOCKET_SEND_ALL)
+  // Start an asynchronous send that completes only once all of the data has
+  // been sent, or an error occurs. The data being sent must be valid for the
+  // lifetime of the asynchronous operation.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_send_all(base_implementation_type& impl,
+      const ConstBufferSequence& buffers, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_send_all_op<ConstBufferSequence,
+        decltype(asio::buffer_sequence_begin(buffers)),
+        Handler, IoExecutor> op;
+    socket_op_slots* slots = op::ptr::slots_for(op_slots(impl));
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler, slots), 0, slots };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        impl.state_, buffers, flags, handler, io_ex);
+    p.p->slots_ = slots;
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(&io_uring_service_,
+            &impl.io_object_data_, io_uring_service::write_op);
+    }
+
+    ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_send_all"));
+
+    start_op(impl, io_uring_service::write_op, p.p, is_continuation,
+        buffer_sequence_adapter<asio::const_buffer,
+          ConstBufferSequence>::all_empty(buffers));
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_SOCKET_SEND_ALL)
+
+#if defined(ASIO_HAS_FD_PASSING)
+  // Start an asynchronous send that passes file descriptors with the data.
+  // The data being sent and the descriptors must be valid for the lifetime of
+  // the asynchronous operation.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_send_fds(base_implementation_type& impl,
+      const ConstBufferSequence& buffers, const local::passed_fds* fds,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_send_fds_op<
+        ConstBufferSequence, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        impl.state_, buffers, fds, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(&io_uring_service_,
+            &impl.io_object_data_, io_uring_service::write_op);
+    }
+
+    ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_send_fds"));
+
+    start_op(impl, io_uring_service::write_op, p.p, is_continuation, false);
+    p.v = p.p = 0;
+  }
+
+  // Start an asynchronous receive that also receives any file descriptors
+  // passed with the data. The buffers and the descriptor storage must be
+  // valid for the lifetime of the asynchronous operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_fds(base_implementation_type& impl,
+      const MutableBufferSequence& buffers, local::passed_fds* fds,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_recv_fds_op<
+        MutableBufferSequence, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        impl.state_, buffers, fds, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(&io_uring_service_,
+            &impl.io_object_data_, io_uring_service::read_op);
+    }
+
+    ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_receive_fds"));
+
+    start_op(impl, io_uring_service::read_op, p.p, is_continuation,
+        ((impl.state_ & socket_ops::stream_oriented) != 0
+          && buffer_sequence_adapter<asio::mutable_buffer,
+            MutableBufferSequence>::all_empty(buffers)));
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_FD_PASSING)
+
   // Start an asynchronous wait until data can be sent without blocking.
   template <typename Handler, typename IoExecutor>
   void async_send(base_implementation_type& impl, const null_buffers&,
@@ -329,6 +553,10 @@ public:
     associated_cancellation_slot_t<Handler> slot
       = asio::get_associated_cancellation_slot(handler);
 
+    chrono::steady_clock::time_point link_timeout;
+    bool has_link_timeout = get_link_timeout(impl,
+        io_uring_service::write_op, handler, link_timeout);
+
     // Allocate and construct an operation to wrap the handler.
     typedef io_uring_null_buffers_op<Handler, IoExecutor> op;
     typename op::ptr p = { asio::detail::addressof(handler),
@@ -343,6 +571,10 @@ public:
             &impl.io_object_data_, io_uring_service::write_op);
     }
 
+    // Optionally link a timeout requested by the handler.
+    if (has_link_timeout)
+      p.p->set_link_timeout(link_timeout);
+
     ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
           "socket", &impl, impl.socket_, "async_send(null_buffers)"));
 
@@ -400,13 +632,19 @@ public:
     associated_cancellation_slot_t<Handler> slot
       = asio::get_associated_cancellation_slot(handler);
 
+    chrono::steady_clock::time_point link_timeout;
+    bool has_link_timeout =
+      get_link_timeout(impl, op_type, handler, link_timeout);
+
     // Allocate and construct an operation to wrap the handler.
     typedef io_uring_socket_recv_op<
         MutableBufferSequence, Handler, IoExecutor> op;
+    socket_op_slots* slots = op::ptr::slots_for(op_slots(impl));
     typename op::ptr p = { asio::detail::addressof(handler),
-      op::ptr::allocate(handler), 0 };
+      op::ptr::allocate(handler, slots), 0, slots };
     p.p = new (p.v) op(success_ec_, impl.socket_,
         impl.state_, buffers, flags, handler, io_ex);
+    p.p->slots_ = slots;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected())
@@ -416,6 +654,10 @@ public:
             &io_uring_service_, &impl.io_object_data_, op_type);
     }
 
+    // Optionally link a timeout requested by the handler.
+    if (has_link_timeout)
+      p.p->set_link_timeout(link_timeout);
+
     ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
           "socket", &impl, impl.socket_, "async_receive"));
 
@@ -451,6 +693,10 @@ public:
     associated_cancellation_slot_t<Handler> slot
       = asio::get_associated_cancellation_slot(handler);
 
+    chrono::steady_clock::time_point link_timeout;
+    bool has_link_timeout =
+      get_link_timeout(impl, op_type, handler, link_timeout);
+
     // Allocate and construct an operation to wrap the handler.
     typedef io_uring_null_buffers_op<Handler, IoExecutor> op;
     typename op::ptr p = { asio::detail::addressof(handler),
@@ -465,6 +711,10 @@ public:
             &io_uring_service_, &impl.io_object_data_, op_type);
     }
 
+    // Optionally link a timeout requested by the handler.
+    if (has_link_timeout)
+      p.p->set_link_timeout(link_timeout);
+
     ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
           "socket", &impl, impl.socket_, "async_receive(null_buffers)"));
 
@@ -472,6 +722,93 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+  // Start an asynchronous receive that completes only when the buffers have
+  // been filled, an error occurs, or the peer closes the connection. The
+  // buffers must be valid for the lifetime of the asynchronous operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_all(base_implementation_type& impl,
+      const MutableBufferSequence& buffers, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_recv_all_op<MutableBufferSequence,
+        decltype(asio::buffer_sequence_begin(buffers)),
+        Handler, IoExecutor> op;
+    socket_op_slots* slots = op::ptr::slots_for(op_slots(impl));
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler, slots), 0, slots };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        impl.state_, buffers, flags, handler, io_ex);
+    p.p->slots_ = slots;
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(&io_uring_service_,
+            &impl.io_object_data_, io_uring_service::read_op);
+    }
+
+    ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_receive_all"));
+
+    start_op(impl, io_uring_service::read_op, p.p, is_continuation,
+        buffer_sequence_adapter<asio::mutable_buffer,
+          MutableBufferSequence>::all_empty(buffers));
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+
+#if defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+  // Start an asynchronous receive into a buffer selected from a ring.
+  template <typename Handler, typename IoExecutor>
+  void async_receive_multishot(base_implementation_type& impl,
+      provided_buffer_ring& ring, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_recv_multishot_op<Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        impl.state_, ring, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(
+            &io_uring_service_, &impl.io_object_data_,
+            io_uring_service::read_op);
+    }
+
+    ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_receive_multishot"));
+
+    bool supported = (io_uring_service_.capabilities()
+        & io_uring_service::multishot_recv_capability) != 0;
+    if (!supported)
+      p.p->ec_ = asio::error::operation_not_supported;
+
+    start_op(impl, io_uring_service::read_op, p.p, is_continuation, !supported);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+
   // Receive some data with associated flags. Returns the number of bytes
   // received.
   template <typename MutableBufferSequence>
@@ -595,6 +932,40 @@ public:
   }
 
 protected:
+  // Deregister the socket and reset the implementation, leaving the caller
+  // to close the descriptor. Returns false if the descriptor has instead been
+  // closed here, either because the socket was not open or because the kernel
+  // does not support closing descriptors through io_uring.
+  ASIO_DECL bool begin_close(base_implementation_type& impl,
+      asio::error_code& ec);
+
+  // Get the socket's op slots if the operation_slots option is enabled,
+  // creating them on first use.
+  socket_op_slots* op_slots(base_implementation_type& impl)
+  {
+    if ((impl.state_ & socket_ops::operation_slots) == 0)
+      return 0;
+    if (!impl.op_slots_)
+      impl.op_slots_ = new socket_op_slots;
+    return impl.op_slots_;
+  }
+
+  // Get the deadline of a timeout that the handler asks to have linked to the
+  // operation. If the operation would join an outstanding multishot
+  // submission, to which no timeout can be linked, the handler is instead told
+  // to apply the timeout itself.
+  template <typename Handler>
+  bool get_link_timeout(base_implementation_type& impl, int op_type,
+      Handler& handler, chrono::steady_clock::time_point& deadline)
+  {
+    if (!linked_timeout<Handler>::get(handler, deadline))
+      return false;
+    if (!io_uring_service_.joins_multishot(op_type, impl.io_object_data_))
+      return true;
+    linked_timeout<Handler>::decline(handler);
+    return false;
+  }
+
   // Open a new socket implementation.
   ASIO_DECL asio::error_code do_open(
       base_implementation_type& impl, int af,
@@ -605,6 +976,10 @@ protected:
       base_implementation_type& impl, int type,
       const native_handle_type& native_socket, asio::error_code& ec);
 
+  // Make the socket non-blocking if the ring cannot poll for readiness itself.
+  ASIO_DECL asio::error_code init_non_blocking(
+      base_implementation_type& impl, asio::error_code& ec);
+
   // Start the asynchronous read or write operation.
   ASIO_DECL void start_op(base_implementation_type& impl, int op_type,
       io_uring_operation* op, bool is_continuation, bool noop);
@@ -645,6 +1020,9 @@ protected:
   // The io_uring_service that performs event demultiplexing for the service.
   io_uring_service& io_uring_service_;
 
+  // The state flags for options that the ring does not support.
+  socket_ops::state_type unsupported_state_;
+
   // Cached success value to avoid accessing category singleton.
   const asio::error_code success_ec_;
 };
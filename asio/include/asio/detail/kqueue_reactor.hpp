@@ -69,7 +69,8 @@ public:
       : mutex_(locking, spin_count) {}
 
     descriptor_state* next_;
-    descriptor_state* prev_;
+    descriptor_state* next_free_;
+    bool live_;
 
     mutex mutex_;
     int descriptor_;
@@ -227,9 +228,25 @@ private:
   // Helper function to remove a timer queue.
   ASIO_DECL void do_remove_timer_queue(timer_queue_base& queue);
 
+  // Sample the number of pending timers, if metrics are enabled. The lock must
+  // be held.
+  ASIO_DECL void record_pending_timers();
+
   // Get the timeout value for the kevent call.
   ASIO_DECL timespec* get_timeout(long usec, timespec& ts);
 
+  // Add the registration of a descriptor's filters to the changes that are
+  // submitted with the next call to kevent that waits for events. Returns
+  // false if the registration must instead be submitted immediately.
+  ASIO_DECL bool defer_registration(socket_type descriptor,
+      descriptor_state* descriptor_data, int num_kevents);
+
+  // Discard any deferred changes for a descriptor that is being deregistered.
+  ASIO_DECL void discard_deferred_changes(descriptor_state* descriptor_data);
+
+  // The maximum number of changes that may be deferred.
+  enum { max_deferred_changes = 64 };
+
   // The scheduler used to post completions.
   scheduler& scheduler_;
 
@@ -242,6 +259,17 @@ private:
   // The interrupter is used to break a blocking kevent call.
   select_interrupter interrupter_;
 
+  // Changes that are to be submitted with the next call to kevent that waits
+  // for events. Protected by mutex_.
+  struct kevent deferred_changes_[max_deferred_changes];
+
+  // The number of deferred changes. Protected by mutex_.
+  int num_deferred_changes_;
+
+  // Whether a thread is blocked waiting for events, in which case changes
+  // cannot be deferred. Protected by mutex_.
+  bool waiting_;
+
   // The timer queues.
   timer_queue_set timer_queues_;
 
@@ -254,10 +282,8 @@ private:
   // How any times to spin waiting for the I/O mutex.
   const int io_locking_spin_count_;
 
-  // Mutex to protect access to the registered descriptors.
-  mutex registered_descriptors_mutex_;
-
-  // Keep track of all registered descriptors.
+  // Keep track of all registered descriptors. The pool may be used without
+  // locking.
   object_pool<descriptor_state, execution_context::allocator<void>>
     registered_descriptors_;
 };
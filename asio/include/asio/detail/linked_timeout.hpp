@@ -0,0 +1,63 @@
+//
+// detail/linked_timeout.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_LINKED_TIMEOUT_HPP
+#define ASIO_DETAIL_LINKED_TIMEOUT_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// An initiation function object declares the nested type linked_timeout_support
+// when every operation it starts will apply a timeout obtained from the
+// handler through linked_timeout<>, so that cancel_after does not need a timer.
+template <typename Initiation, typename = void>
+struct supports_linked_timeout : false_type
+{
+};
+
+template <typename Initiation>
+struct supports_linked_timeout<Initiation,
+    void_t<typename Initiation::linked_timeout_support>> : true_type
+{
+};
+
+// Obtains the absolute deadline, if any, that the handler asks to have linked
+// to the operation's submission. An operation that cannot link the timeout
+// after all calls decline() before the handler is moved, so that the handler
+// applies the timeout by other means.
+template <typename Handler>
+struct linked_timeout
+{
+  static bool get(const Handler&, chrono::steady_clock::time_point&) noexcept
+  {
+    return false;
+  }
+
+  static void decline(Handler&)
+  {
+  }
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_LINKED_TIMEOUT_HPP
@@ -0,0 +1,125 @@
+//
+// detail/memory_metrics.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_MEMORY_METRICS_HPP
+#define ASIO_DETAIL_MEMORY_METRICS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Counters describing the memory allocated on behalf of an execution context,
+// divided by the purpose of the memory. All counters are updated using relaxed
+// atomic operations. An instance exists only for a context that enables the
+// counters, so that when they are disabled an update costs a single branch on
+// a null pointer.
+class memory_metrics
+  : private noncopyable
+{
+public:
+  // The purposes for which memory is counted.
+  enum kind
+  {
+    operation_memory,
+    awaitable_frame_memory,
+    executor_function_memory,
+    cancellation_signal_memory,
+    parallel_group_memory,
+    timed_cancel_memory,
+    promise_memory,
+    registered_buffer_memory,
+    ssl_buffer_memory,
+    num_kinds
+  };
+
+  // The values of the counters for one kind of memory.
+  struct counters
+  {
+    uint64_t allocations;
+    uint64_t cache_hits;
+    uint64_t deallocations;
+    uint64_t bytes_allocated;
+    uint64_t bytes_deallocated;
+  };
+
+  // Constructor.
+  memory_metrics()
+  {
+    for (int i = 0; i < num_kinds; ++i)
+    {
+      entries_[i].allocations_.store(0, std::memory_order_relaxed);
+      entries_[i].cache_hits_.store(0, std::memory_order_relaxed);
+      entries_[i].deallocations_.store(0, std::memory_order_relaxed);
+      entries_[i].bytes_allocated_.store(0, std::memory_order_relaxed);
+      entries_[i].bytes_deallocated_.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  // Record the allocation of a block, and whether it was taken from a cache.
+  void record_allocation(int k, std::size_t bytes, bool cache_hit)
+  {
+    entry& e = entries_[k];
+    e.allocations_.fetch_add(1, std::memory_order_relaxed);
+    e.bytes_allocated_.fetch_add(bytes, std::memory_order_relaxed);
+    if (cache_hit)
+      e.cache_hits_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Record the deallocation of a block.
+  void record_deallocation(int k, std::size_t bytes)
+  {
+    entry& e = entries_[k];
+    e.deallocations_.fetch_add(1, std::memory_order_relaxed);
+    e.bytes_deallocated_.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  // Get the counters for one kind of memory.
+  counters get(int k) const
+  {
+    const entry& e = entries_[k];
+    counters c;
+    c.allocations = e.allocations_.load(std::memory_order_relaxed);
+    c.cache_hits = e.cache_hits_.load(std::memory_order_relaxed);
+    c.deallocations = e.deallocations_.load(std::memory_order_relaxed);
+    c.bytes_allocated = e.bytes_allocated_.load(std::memory_order_relaxed);
+    c.bytes_deallocated = e.bytes_deallocated_.load(std::memory_order_relaxed);
+    return c;
+  }
+
+private:
+  struct entry
+  {
+    std::atomic<uint64_t> allocations_;
+    std::atomic<uint64_t> cache_hits_;
+    std::atomic<uint64_t> deallocations_;
+    std::atomic<uint64_t> bytes_allocated_;
+    std::atomic<uint64_t> bytes_deallocated_;
+  };
+
+  entry entries_[num_kinds];
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_MEMORY_METRICS_HPP
@@ -0,0 +1,66 @@
+//
+// detail/memory_metrics_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_MEMORY_METRICS_SERVICE_HPP
+#define ASIO_DETAIL_MEMORY_METRICS_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/config.hpp"
+#include "asio/detail/memory_metrics.hpp"
+#include "asio/execution_context.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Owns the memory counters of an execution context whose memory.statistics
+// configuration option is set.
+class memory_metrics_service
+  : public execution_context_service_base<memory_metrics_service>
+{
+public:
+  // Constructor.
+  explicit memory_metrics_service(execution_context& ctx)
+    : execution_context_service_base<memory_metrics_service>(ctx),
+      enabled_(config(ctx).get("memory", "statistics", false))
+  {
+  }
+
+  // Destroy all user-defined handler objects owned by the service.
+  void shutdown()
+  {
+  }
+
+  // Get the counters for the specified context, or null if they are disabled.
+  static memory_metrics* get(execution_context& ctx)
+  {
+    memory_metrics_service& s = use_service<memory_metrics_service>(ctx);
+    return s.enabled_ ? &s.metrics_ : 0;
+  }
+
+private:
+  // Whether the counters are maintained.
+  const bool enabled_;
+
+  // The counters.
+  memory_metrics metrics_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_MEMORY_METRICS_SERVICE_HPP
@@ -0,0 +1,76 @@
+//
+// detail/mirrored_memory.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_MIRRORED_MEMORY_HPP
+#define ASIO_DETAIL_MIRRORED_MEMORY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A block of memory that, where supported, is mapped twice into consecutive
+// regions of the address space. An access at data() + size() + n then refers
+// to the same byte as data() + n, so that any range of up to size() bytes
+// starting within the block is contiguous, even when it wraps around the end.
+class mirrored_memory
+  : private noncopyable
+{
+public:
+  // Whether the memory is mapped twice. When false, the block is an ordinary
+  // allocation of size() bytes and accesses must not go beyond its end.
+#if defined(ASIO_HAS_MIRRORED_MEMORY)
+  static constexpr bool is_mirrored = true;
+#else // defined(ASIO_HAS_MIRRORED_MEMORY)
+  static constexpr bool is_mirrored = false;
+#endif // defined(ASIO_HAS_MIRRORED_MEMORY)
+
+  // Allocate a block of at least the specified size. Mirrored blocks are
+  // rounded up to a multiple of the page size.
+  ASIO_DECL explicit mirrored_memory(std::size_t size);
+
+  // Destructor.
+  ASIO_DECL ~mirrored_memory();
+
+  // Get a pointer to the beginning of the block.
+  unsigned char* data() const noexcept
+  {
+    return data_;
+  }
+
+  // Get the size of the block.
+  std::size_t size() const noexcept
+  {
+    return size_;
+  }
+
+private:
+  unsigned char* data_;
+  std::size_t size_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/mirrored_memory.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_DETAIL_MIRRORED_MEMORY_HPP
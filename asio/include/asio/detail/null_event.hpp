@@ -68,6 +68,13 @@ public:
     return false;
   }
 
+  // If there are waiters, unlock the mutex and signal up to n of them.
+  template <typename Lock>
+  bool maybe_unlock_and_signal_some(Lock&, std::size_t)
+  {
+    return false;
+  }
+
   // Reset the event.
   template <typename Lock>
   void clear(Lock&)
@@ -77,6 +77,15 @@ public:
   {
   }
 
+  // Move a socket implementation that belongs to another service into an
+  // empty implementation.
+  asio::error_code transfer(implementation_type&,
+      null_socket_service&, implementation_type&, asio::error_code& ec)
+  {
+    ec = asio::error::operation_not_supported;
+    return ec;
+  }
+
   // Move-construct a new socket implementation from another protocol type.
   template <typename Protocol1>
   void converting_move_construct(implementation_type&,
@@ -16,13 +16,34 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
 #include "asio/detail/memory.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/thread_context.hpp"
 
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
 namespace detail {
 
+// A pool of objects that are reused rather than destroyed. The alloc() and
+// free() functions may be called concurrently from any thread, and do not
+// normally block.
+//
+// Free objects are cached in a small number of shards. A thread uses the shard
+// selected by its thread context, or the next shard that is not in use by
+// another thread, so that threads do not serialise on a single lock. When a
+// shard holds too many free objects, a batch of them is returned to a shared
+// lock-free list, from which an empty shard takes all objects at once and then
+// returns all but one batch. Taking the whole list with a single exchange
+// avoids the ABA problem. A mutex is only locked when a new object must be
+// allocated.
+//
+// The Object type must have the data members:
+//   Object* next_;       // Used by the pool to link all objects.
+//   Object* next_free_;  // Used by the pool to link free objects.
+//   bool live_;          // Whether the object is currently allocated.
 template <typename Object, typename Allocator>
 class object_pool
 {
@@ -32,91 +53,225 @@ public:
   object_pool(const Allocator& allocator,
       unsigned int preallocated, Args... args)
     : allocator_(allocator),
-      live_list_(0),
-      free_list_(0)
+      all_list_(0),
+      shared_free_list_(0)
   {
+    for (std::size_t i = 0; i < num_shards; ++i)
+    {
+      shards_[i].busy_.store(false, std::memory_order_relaxed);
+      shards_[i].free_list_ = 0;
+      shards_[i].size_ = 0;
+    }
+
+    Object* free_list = 0;
     while (preallocated > 0)
     {
-      Object* o = allocate_object<Object>(allocator_, args...);
-      o->next_ = free_list_;
-      o->prev_ = 0;
-      free_list_ = o;
+      Object* o = create_object(args...);
+      o->next_free_ = free_list;
+      free_list = o;
       --preallocated;
     }
+    shared_free_list_.store(free_list, std::memory_order_relaxed);
   }
 
   // Destructor destroys all objects.
   ~object_pool()
   {
-    destroy_list(live_list_);
-    destroy_list(free_list_);
+    while (all_list_)
+    {
+      Object* o = all_list_;
+      all_list_ = o->next_;
+      deallocate_object(allocator_, o);
+    }
   }
 
-  // Get the object at the start of the live list.
+  // Get the first live object. Must not be called concurrently with alloc().
   Object* first()
   {
-    return live_list_;
+    return next_live(all_list_);
+  }
+
+  // Get the live object that follows the given object. Must not be called
+  // concurrently with alloc().
+  Object* next(Object* o)
+  {
+    return next_live(o->next_);
   }
 
   // Allocate a new object with an argument.
   template <typename... Args>
   Object* alloc(Args... args)
   {
-    Object* o = free_list_;
-    if (o)
-      free_list_ = free_list_->next_;
-    else
-      o = allocate_object<Object>(allocator_, args...);
+    Object* o = 0;
+    if (shard* s = acquire_shard())
+    {
+      if (!s->free_list_)
+      {
+        // Take all of the objects that have been returned to the shared list.
+        // Keep one batch and return the rest, so that a shard whose thread
+        // stops allocating does not hold on to objects that others need.
+        s->free_list_ = shared_free_list_.exchange(
+            0, std::memory_order_acquire);
+        Object* last = 0;
+        for (Object* p = s->free_list_; p; p = p->next_free_)
+        {
+          if (++s->size_ == batch_size)
+            last = p;
+        }
+        if (last && last->next_free_)
+        {
+          Object* rest_first = last->next_free_;
+          Object* rest_last = rest_first;
+          while (rest_last->next_free_)
+            rest_last = rest_last->next_free_;
+          last->next_free_ = 0;
+          s->size_ = batch_size;
+          push_shared(rest_first, rest_last);
+        }
+      }
+
+      o = s->free_list_;
+      if (o)
+      {
+        s->free_list_ = o->next_free_;
+        --s->size_;
+      }
+
+      release_shard(s);
+    }
 
-    o->next_ = live_list_;
-    o->prev_ = 0;
-    if (live_list_)
-      live_list_->prev_ = o;
-    live_list_ = o;
+    if (!o)
+      o = create_object(args...);
 
+    o->live_ = true;
     return o;
   }
 
-  // Free an object. Moves it to the free list. No destructors are run.
+  // Free an object. Moves it to a free list. No destructors are run.
   void free(Object* o)
   {
-    if (live_list_ == o)
-      live_list_ = o->next_;
-
-    if (o->prev_)
-      o->prev_->next_ = o->next_;
+    o->live_ = false;
 
-    if (o->next_)
-      o->next_->prev_ = o->prev_;
+    if (shard* s = acquire_shard())
+    {
+      o->next_free_ = s->free_list_;
+      s->free_list_ = o;
+      if (++s->size_ >= 2 * batch_size)
+      {
+        // Return a batch of objects to the shared list, so that they may be
+        // reused by other threads.
+        Object* batch_first = s->free_list_;
+        Object* batch_last = batch_first;
+        for (std::size_t i = 1; i < batch_size; ++i)
+          batch_last = batch_last->next_free_;
+        s->free_list_ = batch_last->next_free_;
+        s->size_ -= batch_size;
+        push_shared(batch_first, batch_last);
+      }
 
-    o->next_ = free_list_;
-    o->prev_ = 0;
-    free_list_ = o;
+      release_shard(s);
+    }
+    else
+    {
+      push_shared(o, o);
+    }
   }
 
 private:
   object_pool(const object_pool&) = delete;
   object_pool& operator=(const object_pool&) = delete;
 
-  // Helper function to destroy all elements in a list.
-  void destroy_list(Object* list)
+  // The number of shards in which free objects are cached.
+  static constexpr std::size_t num_shards = 8;
+
+  // The number of objects moved to the shared list at a time.
+  static constexpr std::size_t batch_size = 16;
+
+  // A cache of free objects.
+  struct shard
   {
-    while (list)
+    // Whether a thread is using the shard.
+    std::atomic<bool> busy_;
+
+    // The free objects in the shard.
+    Object* free_list_;
+
+    // The number of objects in the free list.
+    std::size_t size_;
+
+    // Keeps shards on separate cache lines.
+    char padding_[64];
+  };
+
+  // Allocate a new object and add it to the list of all objects.
+  template <typename... Args>
+  Object* create_object(Args... args)
+  {
+    mutex::scoped_lock lock(mutex_);
+    Object* o = allocate_object<Object>(allocator_, args...);
+    o->next_ = all_list_;
+    o->next_free_ = 0;
+    o->live_ = false;
+    all_list_ = o;
+    return o;
+  }
+
+  // Find the first live object in a list.
+  static Object* next_live(Object* o)
+  {
+    while (o && !o->live_)
+      o = o->next_;
+    return o;
+  }
+
+  // Acquire exclusive use of a shard, starting with the one selected by the
+  // calling thread. Returns null if every shard is in use.
+  shard* acquire_shard()
+  {
+    std::size_t h = reinterpret_cast<std::size_t>(
+        thread_context::top_of_thread_call_stack());
+    h = (h >> 4) ^ (h >> 12) ^ (h >> 20);
+    for (std::size_t i = 0; i < num_shards; ++i)
     {
-      Object* o = list;
-      list = o->next_;
-      deallocate_object(allocator_, o);
+      shard* s = &shards_[(h + i) % num_shards];
+      if (!s->busy_.load(std::memory_order_relaxed)
+          && !s->busy_.exchange(true, std::memory_order_acquire))
+        return s;
     }
+    return 0;
+  }
+
+  // Release a shard acquired by acquire_shard().
+  static void release_shard(shard* s)
+  {
+    s->busy_.store(false, std::memory_order_release);
+  }
+
+  // Push a list of objects on to the shared list.
+  void push_shared(Object* first, Object* last)
+  {
+    Object* head = shared_free_list_.load(std::memory_order_relaxed);
+    do
+    {
+      last->next_free_ = head;
+    } while (!shared_free_list_.compare_exchange_weak(head, first,
+          std::memory_order_release, std::memory_order_relaxed));
   }
 
   // The execution_context allocator used to manage pooled object memory.
   Allocator allocator_;
 
-  // The list of live objects.
-  Object* live_list_;
+  // Mutex to protect allocation of new objects.
+  mutex mutex_;
+
+  // The list of all objects, both live and free.
+  Object* all_list_;
+
+  // The shards in which free objects are cached.
+  shard shards_[num_shards];
 
-  // The free list.
-  Object* free_list_;
+  // Free objects that may be taken by any shard.
+  std::atomic<Object*> shared_free_list_;
 };
 
 } // namespace detail
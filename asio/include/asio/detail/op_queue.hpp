@@ -15,6 +15,7 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include <cstddef>
 #include "asio/detail/noncopyable.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -115,6 +116,15 @@ public:
     }
   }
 
+  // Push an operation on to the front of the queue.
+  void push_front(Operation* h)
+  {
+    op_queue_access::next(h, front_);
+    front_ = h;
+    if (back_ == 0)
+      back_ = h;
+  }
+
   // Push all operations from another queue on to the back of the queue. The
   // source queue may contain operations of a derived type.
   template <typename OtherOperation>
@@ -138,6 +148,15 @@ public:
     return front_ == 0;
   }
 
+  // Count the operations in the queue. Linear in the length of the queue.
+  std::size_t count() const
+  {
+    std::size_t n = 0;
+    for (Operation* o = front_; o; o = op_queue_access::next(o))
+      ++n;
+    return n;
+  }
+
   // Test whether an operation is already enqueued.
   bool is_enqueued(Operation* o) const
   {
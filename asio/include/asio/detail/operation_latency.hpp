@@ -0,0 +1,173 @@
+//
+// detail/operation_latency.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_OPERATION_LATENCY_HPP
+#define ASIO_DETAIL_OPERATION_LATENCY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_ENABLE_LATENCY_HISTOGRAMS)
+# include <atomic>
+# include "asio/detail/chrono.hpp"
+# include "asio/detail/cstdint.hpp"
+# include "asio/detail/noncopyable.hpp"
+# include "asio/latency_histogram.hpp"
+#endif // defined(ASIO_ENABLE_LATENCY_HISTOGRAMS)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// The types of operation for which latencies are recorded.
+enum latency_kind
+{
+  latency_receive,
+  latency_send,
+  latency_accept,
+  latency_connect,
+  latency_timer,
+  latency_post,
+  latency_kinds,
+  latency_none = latency_kinds
+};
+
+#if defined(ASIO_ENABLE_LATENCY_HISTOGRAMS)
+
+// The times at which an operation was initiated and became ready to run, in
+// nanoseconds of the steady clock.
+class latency_stamp
+{
+public:
+  latency_stamp()
+    : kind_(latency_none),
+      start_(0),
+      ready_(0)
+  {
+  }
+
+  // Record the type of the operation and the time of its initiation. A posted
+  // function is ready to run as soon as it is initiated.
+  void set_kind(latency_kind kind)
+  {
+    kind_ = kind;
+    start_ = now();
+    ready_ = kind == latency_post ? start_ : 0;
+  }
+
+  // Record the time at which the operation first became ready to run.
+  void set_ready()
+  {
+    if (kind_ != latency_none && ready_ == 0)
+      ready_ = now();
+  }
+
+  latency_kind kind() const
+  {
+    return kind_;
+  }
+
+  uint64_t start() const
+  {
+    return start_;
+  }
+
+  uint64_t ready() const
+  {
+    return ready_;
+  }
+
+  static uint64_t now()
+  {
+    return static_cast<uint64_t>(
+        chrono::duration_cast<chrono::nanoseconds>(
+          chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+private:
+  latency_kind kind_;
+  uint64_t start_;
+  uint64_t ready_;
+};
+
+// Histograms of the time from initiation to completion, and from completion
+// to invocation, for each type of operation. Buckets are updated using relaxed
+// atomic operations so that any thread may record an operation.
+class latency_recorder
+  : private noncopyable
+{
+public:
+  latency_recorder()
+  {
+    for (std::size_t k = 0; k < latency_kinds; ++k)
+    {
+      for (std::size_t i = 0; i < latency_histogram::num_buckets; ++i)
+      {
+        completion_[k][i].store(0, std::memory_order_relaxed);
+        invocation_[k][i].store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Record the latencies of an operation that is about to be invoked. An
+  // operation that did not become ready through a completion, such as one that
+  // was cancelled, is not recorded.
+  void record(const latency_stamp& stamp)
+  {
+    if (stamp.kind() != latency_none && stamp.ready() != 0)
+    {
+      uint64_t now = latency_stamp::now();
+      add(completion_[stamp.kind()], stamp.ready() - stamp.start());
+      add(invocation_[stamp.kind()],
+          now > stamp.ready() ? now - stamp.ready() : 0);
+    }
+  }
+
+  // Copy the histograms for one type of operation.
+  void snapshot(latency_kind kind, latency_histogram& completion,
+      latency_histogram& invocation) const
+  {
+    copy(completion_[kind], completion);
+    copy(invocation_[kind], invocation);
+  }
+
+private:
+  typedef std::atomic<uint64_t> buckets[latency_histogram::num_buckets];
+
+  static void add(buckets& b, uint64_t nsec)
+  {
+    std::size_t index = latency_histogram::bucket_index(
+        chrono::nanoseconds(static_cast<chrono::nanoseconds::rep>(nsec)));
+    b[index].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  static void copy(const buckets& b, latency_histogram& h)
+  {
+    for (std::size_t i = 0; i < latency_histogram::num_buckets; ++i)
+      if (uint64_t count = b[i].load(std::memory_order_relaxed))
+        h.record(latency_histogram::bucket_lower_bound(i), count);
+  }
+
+  buckets completion_[latency_kinds];
+  buckets invocation_[latency_kinds];
+};
+
+#endif // defined(ASIO_ENABLE_LATENCY_HISTOGRAMS)
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_OPERATION_LATENCY_HPP
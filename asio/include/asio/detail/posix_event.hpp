@@ -98,6 +98,24 @@ public:
     return false;
   }
 
+  // If there are waiters, unlock the mutex and signal up to n of them.
+  template <typename Lock>
+  bool maybe_unlock_and_signal_some(Lock& lock, std::size_t n)
+  {
+    ASIO_ASSERT(lock.locked());
+    ASIO_ASSERT(n > 0);
+    state_ |= 1;
+    if (state_ > 1)
+    {
+      std::size_t waiters = state_ >> 1;
+      lock.unlock();
+      for (std::size_t i = 0; i < n && i < waiters; ++i)
+        ::pthread_cond_signal(&cond_); // Ignore EINVAL.
+      return true;
+    }
+    return false;
+  }
+
   // Reset the event.
   template <typename Lock>
   void clear(Lock& lock)
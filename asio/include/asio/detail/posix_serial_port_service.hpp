@@ -146,6 +146,18 @@ public:
         &option, ec);
   }
 
+  // Set the low latency option on the serial port.
+  ASIO_DECL asio::error_code set_option(implementation_type& impl,
+      const serial_port_base::low_latency& option, asio::error_code& ec);
+
+  // Get the low latency option from the serial port.
+  ASIO_DECL asio::error_code get_option(const implementation_type& impl,
+      serial_port_base::low_latency& option, asio::error_code& ec) const;
+
+  // Determine the number of bytes available for reading.
+  ASIO_DECL std::size_t available(const implementation_type& impl,
+      asio::error_code& ec) const;
+
   // Send a break sequence to the serial port.
   asio::error_code send_break(implementation_type& impl,
       asio::error_code& ec)
@@ -47,6 +47,7 @@ public:
       peer_endpoint_(peer_endpoint),
       addrlen_(peer_endpoint ? peer_endpoint->capacity() : 0)
   {
+    set_latency_kind(latency_accept);
   }
 
   static status do_perform(reactor_op* base)
@@ -0,0 +1,133 @@
+//
+// detail/reactive_socket_close_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTIVE_SOCKET_CLOSE_OP_HPP
+#define ASIO_DETAIL_REACTIVE_SOCKET_CLOSE_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/operation.hpp"
+#include "asio/detail/scheduler.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Closes a descriptor on an internal thread, and then completes on the
+// scheduler. An operation that has no descriptor completes with its stored
+// result.
+template <typename Handler, typename IoExecutor>
+class reactive_socket_close_op : public operation
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(reactive_socket_close_op);
+
+  reactive_socket_close_op(scheduler& sched, socket_type socket,
+      socket_ops::state_type state, Handler& handler, const IoExecutor& io_ex)
+    : operation(&reactive_socket_close_op::do_complete),
+      scheduler_(sched),
+      socket_(socket),
+      state_(state),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  ~reactive_socket_close_op()
+  {
+    // Ensure that the descriptor is not leaked if the operation is destroyed
+    // before the close has been performed.
+    if (socket_ != invalid_socket)
+    {
+      asio::error_code ignored_ec;
+      socket_ops::close(socket_, state_, true, ignored_ec);
+    }
+  }
+
+  // The error code to be passed to the completion handler.
+  asio::error_code ec_;
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the operation object.
+    ASIO_ASSUME(base != 0);
+    reactive_socket_close_op* o(static_cast<reactive_socket_close_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    if (owner && owner != &o->scheduler_ && o->socket_ != invalid_socket)
+    {
+      // The operation is being run on an internal thread. Time to perform
+      // the close.
+      socket_ops::close(o->socket_, o->state_, false, o->ec_);
+      o->socket_ = invalid_socket;
+
+      // Pass operation back to main scheduler for completion.
+      o->scheduler_.post_deferred_completion(o);
+      p.v = p.p = 0;
+    }
+    else
+    {
+      ASIO_HANDLER_COMPLETION((*o));
+
+      // Take ownership of the operation's outstanding work.
+      handler_work<Handler, IoExecutor> w(
+          static_cast<handler_work<Handler, IoExecutor>&&>(
+            o->work_));
+
+      ASIO_ERROR_LOCATION(o->ec_);
+
+      // Make a copy of the handler so that the memory can be deallocated
+      // before the upcall is made. Even if we're not about to make an upcall,
+      // a sub-object of the handler may be the true owner of the memory
+      // associated with the handler. Consequently, a local copy of the handler
+      // is required to ensure that any owning sub-object remains valid until
+      // after we have deallocated the memory here.
+      detail::binder1<Handler, asio::error_code>
+        handler(o->handler_, o->ec_);
+      p.h = asio::detail::addressof(handler.handler_);
+      p.reset();
+
+      // Make the upcall if required.
+      if (owner)
+      {
+        fenced_block b(fenced_block::half);
+        ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_));
+        w.complete(handler, handler.handler_);
+        ASIO_HANDLER_INVOCATION_END;
+      }
+    }
+  }
+
+private:
+  scheduler& scheduler_;
+  socket_type socket_;
+  socket_ops::state_type state_;
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_REACTIVE_SOCKET_CLOSE_OP_HPP
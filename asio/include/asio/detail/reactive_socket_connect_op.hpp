@@ -38,6 +38,7 @@ public:
         &reactive_socket_connect_op_base::do_perform, complete_func),
       socket_(socket)
   {
+    set_latency_kind(latency_connect);
   }
 
   static status do_perform(reactor_op* base)
@@ -0,0 +1,244 @@
+//
+// detail/reactive_socket_recv_all_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTIVE_SOCKET_RECV_ALL_OP_HPP
+#define ASIO_DETAIL_REACTIVE_SOCKET_RECV_ALL_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/consuming_buffers.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/limits.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/reactor_op.hpp"
+#include "asio/detail/socket_op_slots.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename MutableBufferSequence, typename MutableBufferIterator>
+class reactive_socket_recv_all_op_base : public reactor_op
+{
+public:
+  reactive_socket_recv_all_op_base(const asio::error_code& success_ec,
+      socket_type socket, const MutableBufferSequence& buffers,
+      socket_base::message_flags flags, func_type complete_func)
+    : reactor_op(success_ec,
+        &reactive_socket_recv_all_op_base::do_perform, complete_func),
+      socket_(socket),
+      buffers_(buffers),
+      flags_(flags)
+  {
+    set_latency_kind(latency_receive);
+  }
+
+  // Mark data that has already been placed into the buffers as received.
+  // Returns true if the buffers have been filled.
+  bool consume(std::size_t bytes_transferred)
+  {
+    buffers_.consume(bytes_transferred);
+    this->bytes_transferred_ = buffers_.total_consumed();
+    return buffers_.empty();
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    ASIO_ASSUME(base != 0);
+    reactive_socket_recv_all_op_base* o(
+        static_cast<reactive_socket_recv_all_op_base*>(base));
+
+    // Receiving continues within the reactor until the buffers are filled or
+    // the socket would block, rather than completing with a partial result.
+    status result = done;
+    while (!o->buffers_.empty())
+    {
+      socket_ops::buf bufs[max_buffers];
+      std::size_t count = prepare_native(o->buffers_.prepare(
+            (std::numeric_limits<std::size_t>::max)()), bufs);
+
+      std::size_t bytes_transferred = 0;
+      if (!socket_ops::non_blocking_recv(o->socket_,
+            bufs, count, o->flags_, true, o->ec_, bytes_transferred))
+      {
+        result = not_done;
+        break;
+      }
+
+      o->buffers_.consume(bytes_transferred);
+      if (o->ec_)
+      {
+        if (o->ec_ == asio::error::eof)
+          result = done_and_exhausted;
+        break;
+      }
+    }
+
+    o->bytes_transferred_ = o->buffers_.total_consumed();
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_recv_all",
+          o->ec_, o->bytes_transferred_));
+
+    return result;
+  }
+
+private:
+  // The maximum number of buffers received into by a single system call.
+  enum { max_buffers = buffer_sequence_adapter_base::max_buffers };
+
+  template <typename Buffers>
+  static std::size_t prepare_native(const Buffers& buffers,
+      socket_ops::buf* bufs)
+  {
+    std::size_t count = 0;
+    for (auto iter = asio::buffer_sequence_begin(buffers),
+        end = asio::buffer_sequence_end(buffers);
+        iter != end && count < max_buffers; ++iter)
+    {
+      asio::mutable_buffer buffer(*iter);
+      if (buffer.size() > 0)
+        socket_ops::init_buf(bufs[count++], buffer.data(), buffer.size());
+    }
+    return count;
+  }
+
+  socket_type socket_;
+  consuming_buffers<asio::mutable_buffer,
+    MutableBufferSequence, MutableBufferIterator> buffers_;
+  socket_base::message_flags flags_;
+};
+
+template <typename MutableBufferSequence, typename MutableBufferIterator,
+    typename Handler, typename IoExecutor>
+class reactive_socket_recv_all_op :
+  public reactive_socket_recv_all_op_base<
+    MutableBufferSequence, MutableBufferIterator>
+{
+public:
+  typedef Handler handler_type;
+  typedef IoExecutor io_executor_type;
+
+  ASIO_DEFINE_SLOTTED_HANDLER_PTR(
+      socket_op_slots::read_slot, reactive_socket_recv_all_op);
+
+  reactive_socket_recv_all_op(const asio::error_code& success_ec,
+      socket_type socket, const MutableBufferSequence& buffers,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+    : reactive_socket_recv_all_op_base<
+        MutableBufferSequence, MutableBufferIterator>(success_ec, socket,
+        buffers, flags, &reactive_socket_recv_all_op::do_complete),
+      slots_(0),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    ASIO_ASSUME(base != 0);
+    reactive_socket_recv_all_op* o(
+        static_cast<reactive_socket_recv_all_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o, o->slots_ };
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+  static void do_immediate(operation* base, bool, const void* io_ex)
+  {
+    // Take ownership of the handler object.
+    ASIO_ASSUME(base != 0);
+    reactive_socket_recv_all_op* o(
+        static_cast<reactive_socket_recv_all_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o, o->slots_ };
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    immediate_handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+    w.complete(handler, handler.handler_, io_ex);
+    ASIO_HANDLER_INVOCATION_END;
+  }
+
+  // The op slots that hold the operation's memory, if any.
+  socket_op_slots* slots_;
+
+private:
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+
+#endif // ASIO_DETAIL_REACTIVE_SOCKET_RECV_ALL_OP_HPP
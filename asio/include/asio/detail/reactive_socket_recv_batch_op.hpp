@@ -0,0 +1,205 @@
+//
+// detail/reactive_socket_recv_batch_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTIVE_SOCKET_RECV_BATCH_OP_HPP
+#define ASIO_DETAIL_REACTIVE_SOCKET_RECV_BATCH_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_DATAGRAM_BATCH)
+
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/datagram_batch.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/reactor_op.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename MutableBufferSequence, typename Endpoint>
+class reactive_socket_recv_batch_op_base : public reactor_op
+{
+public:
+  reactive_socket_recv_batch_op_base(const asio::error_code& success_ec,
+      socket_type socket, const MutableBufferSequence& buffers,
+      Endpoint* sender_endpoints, std::size_t* sizes, ip::packet_info* infos,
+      socket_base::message_flags flags, func_type complete_func)
+    : reactor_op(success_ec,
+        &reactive_socket_recv_batch_op_base::do_perform, complete_func),
+      socket_(socket),
+      buffers_(buffers),
+      sender_endpoints_(sender_endpoints),
+      sizes_(sizes),
+      infos_(infos),
+      flags_(flags)
+  {
+    set_latency_kind(latency_receive);
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    ASIO_ASSUME(base != 0);
+    reactive_socket_recv_batch_op_base* o(
+        static_cast<reactive_socket_recv_batch_op_base*>(base));
+
+    typedef buffer_sequence_adapter<asio::mutable_buffer,
+        MutableBufferSequence> bufs_type;
+
+    bufs_type bufs(o->buffers_);
+    datagram_batch<Endpoint> batch;
+    batch.prepare(bufs.buffers(), bufs.count(),
+        o->sender_endpoints_, o->infos_);
+
+    status result = socket_ops::non_blocking_recvmmsg(o->socket_,
+        batch.messages(), batch.count(), o->flags_,
+        o->ec_, o->bytes_transferred_) ? done : not_done;
+
+    if (result && !o->ec_)
+    {
+      batch.complete(o->bytes_transferred_,
+          o->sender_endpoints_, o->sizes_, o->infos_);
+    }
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_recvmmsg",
+          o->ec_, o->bytes_transferred_));
+
+    return result;
+  }
+
+private:
+  socket_type socket_;
+  MutableBufferSequence buffers_;
+  Endpoint* sender_endpoints_;
+  std::size_t* sizes_;
+  ip::packet_info* infos_;
+  socket_base::message_flags flags_;
+};
+
+template <typename MutableBufferSequence, typename Endpoint,
+    typename Handler, typename IoExecutor>
+class reactive_socket_recv_batch_op :
+  public reactive_socket_recv_batch_op_base<MutableBufferSequence, Endpoint>
+{
+public:
+  typedef Handler handler_type;
+  typedef IoExecutor io_executor_type;
+
+  ASIO_DEFINE_HANDLER_PTR(reactive_socket_recv_batch_op);
+
+  reactive_socket_recv_batch_op(const asio::error_code& success_ec,
+      socket_type socket, const MutableBufferSequence& buffers,
+      Endpoint* sender_endpoints, std::size_t* sizes, ip::packet_info* infos,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+    : reactive_socket_recv_batch_op_base<MutableBufferSequence, Endpoint>(
+        success_ec, socket, buffers, sender_endpoints, sizes, infos, flags,
+        &reactive_socket_recv_batch_op::do_complete),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    ASIO_ASSUME(base != 0);
+    reactive_socket_recv_batch_op* o(
+        static_cast<reactive_socket_recv_batch_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+  static void do_immediate(operation* base, bool, const void* io_ex)
+  {
+    // Take ownership of the handler object.
+    ASIO_ASSUME(base != 0);
+    reactive_socket_recv_batch_op* o(
+        static_cast<reactive_socket_recv_batch_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    immediate_handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+    w.complete(handler, handler.handler_, io_ex);
+    ASIO_HANDLER_INVOCATION_END;
+  }
+
+private:
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_DATAGRAM_BATCH)
+
+#endif // ASIO_DETAIL_REACTIVE_SOCKET_RECV_BATCH_OP_HPP
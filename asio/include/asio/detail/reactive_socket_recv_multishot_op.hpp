@@ -0,0 +1,210 @@
+//
+// detail/reactive_socket_recv_multishot_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTIVE_SOCKET_RECV_MULTISHOT_OP_HPP
+#define ASIO_DETAIL_REACTIVE_SOCKET_RECV_MULTISHOT_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/reactor_op.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/provided_buffer_ring.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class reactive_socket_recv_multishot_op_base : public reactor_op
+{
+public:
+  reactive_socket_recv_multishot_op_base(const asio::error_code& success_ec,
+      socket_type socket, socket_ops::state_type state,
+      provided_buffer_ring& ring, socket_base::message_flags flags,
+      func_type complete_func)
+    : reactor_op(success_ec,
+        &reactive_socket_recv_multishot_op_base::do_perform, complete_func),
+      socket_(socket),
+      state_(state),
+      ring_(ring),
+      flags_(flags),
+      buffer_id_(0)
+  {
+    set_latency_kind(latency_receive);
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    ASIO_ASSUME(base != 0);
+    reactive_socket_recv_multishot_op_base* o(
+        static_cast<reactive_socket_recv_multishot_op_base*>(base));
+
+    // A buffer is only taken from the ring once data has arrived. If the ring
+    // is exhausted the operation fails, as it would with io_uring.
+    if (!o->ring_.acquire(o->buffer_id_))
+    {
+      asio::error_code ec;
+      int result = socket_ops::poll_read(o->socket_,
+          socket_ops::user_set_non_blocking, 0, ec);
+      if (result == 0)
+        return not_done;
+      o->ec_ = result < 0 ? ec : asio::error::no_buffer_space;
+      o->bytes_transferred_ = 0;
+      return done;
+    }
+
+    mutable_buffer b = o->ring_.buffer(o->buffer_id_);
+    status result = socket_ops::non_blocking_recv1(o->socket_,
+        b.data(), b.size(), o->flags_,
+        (o->state_ & socket_ops::stream_oriented) != 0,
+        o->ec_, o->bytes_transferred_) ? done : not_done;
+
+    if (result == not_done || o->ec_)
+      o->ring_.recycle(o->buffer_id_);
+
+    if (result == done)
+      if ((o->state_ & socket_ops::stream_oriented) != 0)
+        if (o->bytes_transferred_ == 0)
+          result = done_and_exhausted;
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_recv",
+          o->ec_, o->bytes_transferred_));
+
+    return result;
+  }
+
+private:
+  socket_type socket_;
+  socket_ops::state_type state_;
+  provided_buffer_ring& ring_;
+  socket_base::message_flags flags_;
+
+protected:
+  std::size_t buffer_id_;
+};
+
+template <typename Handler, typename IoExecutor>
+class reactive_socket_recv_multishot_op :
+  public reactive_socket_recv_multishot_op_base
+{
+public:
+  typedef Handler handler_type;
+  typedef IoExecutor io_executor_type;
+
+  ASIO_DEFINE_HANDLER_PTR(reactive_socket_recv_multishot_op);
+
+  reactive_socket_recv_multishot_op(const asio::error_code& success_ec,
+      socket_type socket, socket_ops::state_type state,
+      provided_buffer_ring& ring, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+    : reactive_socket_recv_multishot_op_base(success_ec, socket, state,
+        ring, flags, &reactive_socket_recv_multishot_op::do_complete),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    ASIO_ASSUME(base != 0);
+    reactive_socket_recv_multishot_op* o(
+        static_cast<reactive_socket_recv_multishot_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder3<Handler, asio::error_code, std::size_t, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_, o->buffer_id_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+  static void do_immediate(operation* base, bool, const void* io_ex)
+  {
+    // Take ownership of the handler object.
+    ASIO_ASSUME(base != 0);
+    reactive_socket_recv_multishot_op* o(
+        static_cast<reactive_socket_recv_multishot_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    immediate_handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder3<Handler, asio::error_code, std::size_t, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_, o->buffer_id_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+    w.complete(handler, handler.handler_, io_ex);
+    ASIO_HANDLER_INVOCATION_END;
+  }
+
+private:
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+
+#endif // ASIO_DETAIL_REACTIVE_SOCKET_RECV_MULTISHOT_OP_HPP
@@ -23,6 +23,7 @@
 #include "asio/detail/handler_work.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/reactor_op.hpp"
+#include "asio/detail/socket_op_slots.hpp"
 #include "asio/detail/socket_ops.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -45,6 +46,7 @@ public:
       buffers_(buffers),
       flags_(flags)
   {
+    set_latency_kind(latency_receive);
   }
 
   static status do_perform(reactor_op* base)
@@ -100,7 +102,8 @@ public:
   typedef Handler handler_type;
   typedef IoExecutor io_executor_type;
 
-  ASIO_DEFINE_HANDLER_PTR(reactive_socket_recv_op);
+  ASIO_DEFINE_SLOTTED_HANDLER_PTR(
+      socket_op_slots::read_slot, reactive_socket_recv_op);
 
   reactive_socket_recv_op(const asio::error_code& success_ec,
       socket_type socket, socket_ops::state_type state,
@@ -108,6 +111,7 @@ public:
       Handler& handler, const IoExecutor& io_ex)
     : reactive_socket_recv_op_base<MutableBufferSequence>(success_ec, socket,
         state, buffers, flags, &reactive_socket_recv_op::do_complete),
+      slots_(0),
       handler_(static_cast<Handler&&>(handler)),
       work_(handler_, io_ex)
   {
@@ -120,7 +124,7 @@ public:
     // Take ownership of the handler object.
     ASIO_ASSUME(base != 0);
     reactive_socket_recv_op* o(static_cast<reactive_socket_recv_op*>(base));
-    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    ptr p = { asio::detail::addressof(o->handler_), o, o, o->slots_ };
 
     ASIO_HANDLER_COMPLETION((*o));
 
@@ -157,7 +161,7 @@ public:
     // Take ownership of the handler object.
     ASIO_ASSUME(base != 0);
     reactive_socket_recv_op* o(static_cast<reactive_socket_recv_op*>(base));
-    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    ptr p = { asio::detail::addressof(o->handler_), o, o, o->slots_ };
 
     ASIO_HANDLER_COMPLETION((*o));
 
@@ -184,6 +188,9 @@ public:
     ASIO_HANDLER_INVOCATION_END;
   }
 
+  // The op slots that hold the operation's memory, if any.
+  socket_op_slots* slots_;
+
 private:
   Handler handler_;
   handler_work<Handler, IoExecutor> work_;
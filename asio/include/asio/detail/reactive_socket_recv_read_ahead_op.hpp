@@ -0,0 +1,201 @@
+//
+// detail/reactive_socket_recv_read_ahead_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTIVE_SOCKET_RECV_READ_AHEAD_OP_HPP
+#define ASIO_DETAIL_REACTIVE_SOCKET_RECV_READ_AHEAD_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/reactor_op.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/detail/socket_read_ahead.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Receives on a stream socket into the caller's buffers followed by the
+// socket's read-ahead buffer. Data that is already held in the read-ahead
+// buffer is returned without performing a system call.
+template <typename MutableBufferSequence>
+class reactive_socket_recv_read_ahead_op_base : public reactor_op
+{
+public:
+  reactive_socket_recv_read_ahead_op_base(const asio::error_code& success_ec,
+      socket_type socket, socket_read_ahead* read_ahead,
+      const MutableBufferSequence& buffers, func_type complete_func)
+    : reactor_op(success_ec,
+        &reactive_socket_recv_read_ahead_op_base::do_perform, complete_func),
+      socket_(socket),
+      read_ahead_(read_ahead),
+      buffers_(buffers)
+  {
+    set_latency_kind(latency_receive);
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    ASIO_ASSUME(base != 0);
+    reactive_socket_recv_read_ahead_op_base* o(
+        static_cast<reactive_socket_recv_read_ahead_op_base*>(base));
+
+    if (!o->read_ahead_->empty())
+    {
+      o->bytes_transferred_ = o->read_ahead_->read(o->buffers_);
+      return done;
+    }
+
+    socket_ops::buf bufs[socket_read_ahead::max_buffers];
+    std::size_t buffers_size = 0;
+    std::size_t count = o->read_ahead_->prepare(
+        o->buffers_, bufs, buffers_size);
+
+    status result = socket_ops::non_blocking_recv(o->socket_,
+        bufs, count, 0, true, o->ec_, o->bytes_transferred_)
+      ? done : not_done;
+
+    // A receive that does not fill all of the buffers has drained the socket,
+    // so there is no point in trying the next receive speculatively.
+    if (result == done)
+    {
+      if (o->bytes_transferred_ < buffers_size + o->read_ahead_->capacity())
+        result = done_and_exhausted;
+      o->bytes_transferred_ = o->read_ahead_->commit(
+          o->bytes_transferred_, buffers_size);
+    }
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_recv",
+          o->ec_, o->bytes_transferred_));
+
+    return result;
+  }
+
+private:
+  socket_type socket_;
+  socket_read_ahead* read_ahead_;
+  MutableBufferSequence buffers_;
+};
+
+template <typename MutableBufferSequence, typename Handler, typename IoExecutor>
+class reactive_socket_recv_read_ahead_op :
+  public reactive_socket_recv_read_ahead_op_base<MutableBufferSequence>
+{
+public:
+  typedef Handler handler_type;
+  typedef IoExecutor io_executor_type;
+
+  ASIO_DEFINE_HANDLER_PTR(reactive_socket_recv_read_ahead_op);
+
+  reactive_socket_recv_read_ahead_op(const asio::error_code& success_ec,
+      socket_type socket, socket_read_ahead* read_ahead,
+      const MutableBufferSequence& buffers, Handler& handler,
+      const IoExecutor& io_ex)
+    : reactive_socket_recv_read_ahead_op_base<MutableBufferSequence>(
+        success_ec, socket, read_ahead, buffers,
+        &reactive_socket_recv_read_ahead_op::do_complete),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    ASIO_ASSUME(base != 0);
+    reactive_socket_recv_read_ahead_op* o(
+        static_cast<reactive_socket_recv_read_ahead_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+  static void do_immediate(operation* base, bool, const void* io_ex)
+  {
+    // Take ownership of the handler object.
+    ASIO_ASSUME(base != 0);
+    reactive_socket_recv_read_ahead_op* o(
+        static_cast<reactive_socket_recv_read_ahead_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    immediate_handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+    w.complete(handler, handler.handler_, io_ex);
+    ASIO_HANDLER_INVOCATION_END;
+  }
+
+private:
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_REACTIVE_SOCKET_RECV_READ_AHEAD_OP_HPP
@@ -46,6 +46,7 @@ public:
       sender_endpoint_(endpoint),
       flags_(flags)
   {
+    set_latency_kind(latency_receive);
   }
 
   static status do_perform(reactor_op* base)
@@ -46,6 +46,7 @@ public:
       in_flags_(in_flags),
       out_flags_(out_flags)
   {
+    set_latency_kind(latency_receive);
   }
 
   static status do_perform(reactor_op* base)
@@ -0,0 +1,385 @@
+//
+// detail/reactive_socket_send_all_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTIVE_SOCKET_SEND_ALL_OP_HPP
+#define ASIO_DETAIL_REACTIVE_SOCKET_SEND_ALL_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SOCKET_SEND_ALL)
+
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/consuming_buffers.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/limits.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/op_queue.hpp"
+#include "asio/detail/reactor_op.hpp"
+#include "asio/detail/socket_op_slots.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// The part of a send-all operation that does not depend on the buffer type.
+// When write coalescing is enabled, the operation at the front of the
+// reactor's queue gathers the buffers of the coalescing send-all operations
+// queued behind it, so that all of them are sent with a single system call.
+class reactive_socket_send_all_op_common : public reactor_op
+{
+public:
+  // The maximum number of buffers sent by a single system call.
+  enum { max_buffers = buffer_sequence_adapter_base::max_buffers };
+
+  static status do_perform(reactor_op* base)
+  {
+    ASIO_ASSUME(base != 0);
+    reactive_socket_send_all_op_common* o(
+        static_cast<reactive_socket_send_all_op_common*>(base));
+
+    // Keep sending until all of the data has been transferred or the socket's
+    // send buffer is full. The reactor resumes the operation once the socket
+    // is writable again, without involving the scheduler.
+    for (;;)
+    {
+      socket_ops::buf bufs[max_buffers];
+      reactive_socket_send_all_op_common* batch[max_buffers];
+      std::size_t batch_sizes[max_buffers];
+      std::size_t batch_length = 0;
+
+      // An operation that had all of its data sent as part of an earlier
+      // operation's batch is already complete.
+      if (o->bytes_transferred_ >= o->total_size_)
+        break;
+
+      std::size_t size = 0;
+      std::size_t count = o->prepare_func_(o, bufs, max_buffers, size);
+      batch[batch_length] = o;
+      batch_sizes[batch_length++] = size;
+
+      // Data from the following operations may be added only once all of the
+      // data from the preceding ones is in the batch.
+      if (o->coalesce_ && o->bytes_transferred_ + size == o->total_size_)
+      {
+        for (reactor_op* next = op_queue_access::next(
+              static_cast<reactor_op*>(o)); next && count < max_buffers;
+            next = op_queue_access::next(next))
+        {
+          if (!next->is_performed_by(
+                &reactive_socket_send_all_op_common::do_perform))
+            break;
+          reactive_socket_send_all_op_common* n(
+              static_cast<reactive_socket_send_all_op_common*>(next));
+          if (!n->coalesce_)
+            break;
+
+          std::size_t next_size = 0;
+          count += n->prepare_func_(n,
+              bufs + count, max_buffers - count, next_size);
+          batch[batch_length] = n;
+          batch_sizes[batch_length++] = next_size;
+          if (n->bytes_transferred_ + next_size < n->total_size_)
+            break;
+        }
+      }
+
+      int flags = o->flags_;
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+      // Sends smaller than the threshold are copied, as pinning pages costs
+      // more than copying the data.
+      std::size_t batch_size = 0;
+      for (std::size_t i = 0; i < batch_length; ++i)
+        batch_size += batch_sizes[i];
+      bool zero_copy = o->zero_copy_ && batch_size >= zero_copy_threshold;
+      if (zero_copy)
+        flags |= ASIO_OS_DEF(MSG_ZEROCOPY);
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+      std::size_t bytes_transferred = 0;
+      if (!socket_ops::non_blocking_send(o->socket_,
+            bufs, count, flags, o->ec_, bytes_transferred))
+        return not_done;
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+      if (zero_copy && o->ec_ == asio::error::no_buffer_space)
+      {
+        // The kernel could not pin the pages, so copy the data instead.
+        o->zero_copy_ = false;
+        continue;
+      }
+      else if (zero_copy && !o->ec_ && bytes_transferred > 0)
+        ++o->zero_copy_pending_;
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+      if (o->ec_)
+        break;
+
+      if (bytes_transferred == 0)
+        break;
+
+      // Divide the transferred data between the operations in the batch.
+      for (std::size_t i = 0; i < batch_length && bytes_transferred > 0; ++i)
+      {
+        std::size_t n = bytes_transferred < batch_sizes[i]
+          ? bytes_transferred : batch_sizes[i];
+        batch[i]->consume_func_(batch[i], n);
+        bytes_transferred -= n;
+      }
+    }
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    // Once all of the data has been sent, the operation completes when the
+    // kernel reports on the error queue that it has released the buffers of
+    // every zero-copy send. The buffers of any operations whose data was sent
+    // in the same batch are released before those operations complete.
+    if (!o->ec_ && o->zero_copy_pending_ > 0)
+    {
+      asio::error_code ec;
+      if (!socket_ops::non_blocking_recv_zero_copy_notifications(
+            o->socket_, o->zero_copy_pending_, ec))
+        return not_done;
+      o->ec_ = ec;
+    }
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_send_all",
+          o->ec_, o->bytes_transferred_));
+
+    return done;
+  }
+
+protected:
+  typedef std::size_t (*prepare_func_type)(reactive_socket_send_all_op_common*,
+      socket_ops::buf*, std::size_t, std::size_t&);
+  typedef void (*consume_func_type)(
+      reactive_socket_send_all_op_common*, std::size_t);
+
+  reactive_socket_send_all_op_common(const asio::error_code& success_ec,
+      socket_type socket, std::size_t total_size,
+      socket_base::message_flags flags, bool coalesce, bool zero_copy,
+      prepare_func_type prepare_func, consume_func_type consume_func,
+      func_type complete_func)
+    : reactor_op(success_ec,
+        &reactive_socket_send_all_op_common::do_perform, complete_func),
+      socket_(socket),
+      total_size_(total_size),
+      flags_(flags),
+      coalesce_(coalesce),
+      zero_copy_(zero_copy),
+      zero_copy_pending_(0),
+      prepare_func_(prepare_func),
+      consume_func_(consume_func)
+  {
+    set_latency_kind(latency_send);
+  }
+
+private:
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  enum { zero_copy_threshold = 16384 };
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+  socket_type socket_;
+  std::size_t total_size_;
+  socket_base::message_flags flags_;
+  bool coalesce_;
+  bool zero_copy_;
+  std::size_t zero_copy_pending_;
+  prepare_func_type prepare_func_;
+  consume_func_type consume_func_;
+};
+
+template <typename ConstBufferSequence, typename ConstBufferIterator>
+class reactive_socket_send_all_op_base
+  : public reactive_socket_send_all_op_common
+{
+public:
+  reactive_socket_send_all_op_base(const asio::error_code& success_ec,
+      socket_type socket, const ConstBufferSequence& buffers,
+      socket_base::message_flags flags, bool coalesce, bool zero_copy,
+      func_type complete_func)
+    : reactive_socket_send_all_op_common(success_ec, socket,
+        asio::buffer_size(buffers), flags, coalesce, zero_copy,
+        &reactive_socket_send_all_op_base::do_prepare,
+        &reactive_socket_send_all_op_base::do_consume, complete_func),
+      buffers_(buffers)
+  {
+  }
+
+private:
+  // Fill the native buffers with the data that remains to be sent. Returns
+  // the number of native buffers used.
+  static std::size_t do_prepare(reactive_socket_send_all_op_common* base,
+      socket_ops::buf* bufs, std::size_t max_bufs, std::size_t& size)
+  {
+    reactive_socket_send_all_op_base* o(
+        static_cast<reactive_socket_send_all_op_base*>(base));
+    return prepare_native(o->buffers_.prepare(
+          (std::numeric_limits<std::size_t>::max)()), bufs, max_bufs, size);
+  }
+
+  template <typename Buffers>
+  static std::size_t prepare_native(const Buffers& buffers,
+      socket_ops::buf* bufs, std::size_t max_bufs, std::size_t& size)
+  {
+    std::size_t count = 0;
+    size = 0;
+    for (auto iter = asio::buffer_sequence_begin(buffers),
+        end = asio::buffer_sequence_end(buffers);
+        iter != end && count < max_bufs; ++iter)
+    {
+      asio::const_buffer buffer(*iter);
+      if (buffer.size() > 0)
+      {
+        socket_ops::init_buf(bufs[count++], buffer.data(), buffer.size());
+        size += buffer.size();
+      }
+    }
+    return count;
+  }
+
+  // Record that some of the data has been sent.
+  static void do_consume(reactive_socket_send_all_op_common* base,
+      std::size_t bytes_transferred)
+  {
+    reactive_socket_send_all_op_base* o(
+        static_cast<reactive_socket_send_all_op_base*>(base));
+    o->buffers_.consume(bytes_transferred);
+    o->bytes_transferred_ = o->buffers_.total_consumed();
+  }
+
+  consuming_buffers<asio::const_buffer,
+    ConstBufferSequence, ConstBufferIterator> buffers_;
+};
+
+template <typename ConstBufferSequence, typename ConstBufferIterator,
+    typename Handler, typename IoExecutor>
+class reactive_socket_send_all_op :
+  public reactive_socket_send_all_op_base<
+      ConstBufferSequence, ConstBufferIterator>
+{
+public:
+  typedef Handler handler_type;
+  typedef IoExecutor io_executor_type;
+
+  ASIO_DEFINE_SLOTTED_HANDLER_PTR(
+      socket_op_slots::write_slot, reactive_socket_send_all_op);
+
+  reactive_socket_send_all_op(const asio::error_code& success_ec,
+      socket_type socket, const ConstBufferSequence& buffers,
+      socket_base::message_flags flags, bool coalesce, bool zero_copy,
+      Handler& handler, const IoExecutor& io_ex)
+    : reactive_socket_send_all_op_base<
+        ConstBufferSequence, ConstBufferIterator>(
+        success_ec, socket, buffers, flags, coalesce, zero_copy,
+        &reactive_socket_send_all_op::do_complete),
+      slots_(0),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    ASIO_ASSUME(base != 0);
+    reactive_socket_send_all_op* o(
+        static_cast<reactive_socket_send_all_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o, o->slots_ };
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+  static void do_immediate(operation* base, bool, const void* io_ex)
+  {
+    // Take ownership of the handler object.
+    ASIO_ASSUME(base != 0);
+    reactive_socket_send_all_op* o(
+        static_cast<reactive_socket_send_all_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o, o->slots_ };
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    immediate_handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+    w.complete(handler, handler.handler_, io_ex);
+    ASIO_HANDLER_INVOCATION_END;
+  }
+
+  // The op slots that hold the operation's memory, if any.
+  socket_op_slots* slots_;
+
+private:
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_SOCKET_SEND_ALL)
+
+#endif // ASIO_DETAIL_REACTIVE_SOCKET_SEND_ALL_OP_HPP
@@ -23,6 +23,7 @@
 #include "asio/detail/handler_work.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/reactor_op.hpp"
+#include "asio/detail/socket_op_slots.hpp"
 #include "asio/detail/socket_ops.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -43,8 +44,10 @@ public:
       socket_(socket),
       state_(state),
       buffers_(buffers),
-      flags_(flags)
+      flags_(flags),
+      zero_copy_pending_(0)
   {
+    set_latency_kind(latency_send);
   }
 
   static status do_perform(reactor_op* base)
@@ -56,12 +59,35 @@ public:
     typedef buffer_sequence_adapter<asio::const_buffer,
         ConstBufferSequence> bufs_type;
 
+    int flags = o->flags_;
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    if (o->zero_copy_pending_ > 0)
+    {
+      // The data has been sent, and the operation completes once the kernel
+      // reports on the error queue that it has released the buffers.
+      asio::error_code ec;
+      if (!socket_ops::non_blocking_recv_zero_copy_notifications(
+            o->socket_, o->zero_copy_pending_, ec))
+        return not_done;
+      if (ec)
+        o->ec_ = ec;
+      return done;
+    }
+
+    // Sends smaller than the threshold are copied, as pinning pages costs
+    // more than copying the data.
+    bool zero_copy = (o->state_ & socket_ops::internal_zero_copy) != 0
+      && bufs_type(o->buffers_).total_size() >= zero_copy_threshold;
+    if (zero_copy)
+      flags |= ASIO_OS_DEF(MSG_ZEROCOPY);
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
     status result;
     if (bufs_type::is_single_buffer)
     {
       result = socket_ops::non_blocking_send1(o->socket_,
           bufs_type::first(o->buffers_).data(),
-          bufs_type::first(o->buffers_).size(), o->flags_,
+          bufs_type::first(o->buffers_).size(), flags,
           o->ec_, o->bytes_transferred_) ? done : not_done;
 
       if (result == done)
@@ -73,7 +99,7 @@ public:
     {
       bufs_type bufs(o->buffers_);
       result = socket_ops::non_blocking_send(o->socket_,
-            bufs.buffers(), bufs.count(), o->flags_,
+            bufs.buffers(), bufs.count(), flags,
             o->ec_, o->bytes_transferred_) ? done : not_done;
 
       if (result == done)
@@ -85,14 +111,37 @@ public:
     ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_send",
           o->ec_, o->bytes_transferred_));
 
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    if (zero_copy && result != not_done)
+    {
+      if (o->ec_ == asio::error::no_buffer_space)
+      {
+        // The kernel could not pin the pages, so copy the data instead.
+        o->state_ &= ~socket_ops::internal_zero_copy;
+        return do_perform(base);
+      }
+      else if (!o->ec_)
+      {
+        // Wait for the notification, which may already have arrived.
+        o->zero_copy_pending_ = 1;
+        return do_perform(base);
+      }
+    }
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
     return result;
   }
 
 private:
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  enum { zero_copy_threshold = 16384 };
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
   socket_type socket_;
   socket_ops::state_type state_;
   ConstBufferSequence buffers_;
   socket_base::message_flags flags_;
+  std::size_t zero_copy_pending_;
 };
 
 template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
@@ -103,7 +152,8 @@ public:
   typedef Handler handler_type;
   typedef IoExecutor io_executor_type;
 
-  ASIO_DEFINE_HANDLER_PTR(reactive_socket_send_op);
+  ASIO_DEFINE_SLOTTED_HANDLER_PTR(
+      socket_op_slots::write_slot, reactive_socket_send_op);
 
   reactive_socket_send_op(const asio::error_code& success_ec,
       socket_type socket, socket_ops::state_type state,
@@ -111,6 +161,7 @@ public:
       Handler& handler, const IoExecutor& io_ex)
     : reactive_socket_send_op_base<ConstBufferSequence>(success_ec, socket,
         state, buffers, flags, &reactive_socket_send_op::do_complete),
+      slots_(0),
       handler_(static_cast<Handler&&>(handler)),
       work_(handler_, io_ex)
   {
@@ -123,7 +174,7 @@ public:
     // Take ownership of the handler object.
     ASIO_ASSUME(base != 0);
     reactive_socket_send_op* o(static_cast<reactive_socket_send_op*>(base));
-    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    ptr p = { asio::detail::addressof(o->handler_), o, o, o->slots_ };
 
     ASIO_HANDLER_COMPLETION((*o));
 
@@ -160,7 +211,7 @@ public:
     // Take ownership of the handler object.
     ASIO_ASSUME(base != 0);
     reactive_socket_send_op* o(static_cast<reactive_socket_send_op*>(base));
-    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    ptr p = { asio::detail::addressof(o->handler_), o, o, o->slots_ };
 
     ASIO_HANDLER_COMPLETION((*o));
 
@@ -187,6 +238,9 @@ public:
     ASIO_HANDLER_INVOCATION_END;
   }
 
+  // The op slots that hold the operation's memory, if any.
+  socket_op_slots* slots_;
+
 private:
   Handler handler_;
   handler_work<Handler, IoExecutor> work_;
@@ -45,6 +45,7 @@ public:
       destination_(endpoint),
       flags_(flags)
   {
+    set_latency_kind(latency_send);
   }
 
   static status do_perform(reactor_op* base)
@@ -30,7 +30,12 @@
 #include "asio/detail/reactive_null_buffers_op.hpp"
 #include "asio/detail/reactive_socket_accept_op.hpp"
 #include "asio/detail/reactive_socket_connect_op.hpp"
+#include "asio/detail/reactive_socket_recv_batch_op.hpp"
+#include "asio/detail/reactive_socket_recv_coalesced_op.hpp"
+#include "asio/detail/reactive_socket_recv_timestamped_op.hpp"
 #include "asio/detail/reactive_socket_recvfrom_op.hpp"
+#include "asio/detail/reactive_socket_send_batch_op.hpp"
+#include "asio/detail/reactive_socket_send_segments_op.hpp"
 #include "asio/detail/reactive_socket_sendto_op.hpp"
 #include "asio/detail/reactive_socket_service_base.hpp"
 #include "asio/detail/reactor.hpp"
@@ -108,6 +113,22 @@ public:
     other_impl.protocol_ = endpoint_type().protocol();
   }
 
+  // Move a socket implementation that belongs to another service, possibly
+  // in another execution context, into an empty implementation.
+  asio::error_code transfer(implementation_type& impl,
+      reactive_socket_service& other_service,
+      implementation_type& other_impl, asio::error_code& ec)
+  {
+    if (!this->base_transfer(impl, other_service, other_impl, ec))
+    {
+      impl.protocol_ = other_impl.protocol_;
+      other_impl.protocol_ = endpoint_type().protocol();
+    }
+
+    ASIO_ERROR_LOCATION(ec);
+    return ec;
+  }
+
   // Move-construct a new socket implementation from another protocol type.
   template <typename Protocol1>
   void converting_move_construct(implementation_type& impl,
@@ -166,6 +187,13 @@ public:
   asio::error_code set_option(implementation_type& impl,
       const Option& option, asio::error_code& ec)
   {
+    if (option.level(impl.protocol_) == custom_socket_option_level
+        && option.name(impl.protocol_) == read_ahead_option)
+    {
+      return set_read_ahead(impl, option.data(impl.protocol_),
+          option.size(impl.protocol_), ec);
+    }
+
     socket_ops::setsockopt(impl.socket_, impl.state_,
         option.level(impl.protocol_), option.name(impl.protocol_),
         option.data(impl.protocol_), option.size(impl.protocol_), ec);
@@ -180,6 +208,15 @@ public:
       Option& option, asio::error_code& ec) const
   {
     std::size_t size = option.size(impl.protocol_);
+    if (option.level(impl.protocol_) == custom_socket_option_level
+        && option.name(impl.protocol_) == read_ahead_option)
+    {
+      get_read_ahead(impl, option.data(impl.protocol_), &size, ec);
+      if (!ec)
+        option.resize(impl.protocol_, size);
+      return ec;
+    }
+
     socket_ops::getsockopt(impl.socket_, impl.state_,
         option.level(impl.protocol_), option.name(impl.protocol_),
         option.data(impl.protocol_), &size, ec);
@@ -345,6 +382,92 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(ASIO_HAS_DATAGRAM_BATCH)
+  // Start an asynchronous send of a batch of datagrams, one from each buffer.
+  // The buffers, destinations and packet information must all be valid for
+  // the lifetime of the asynchronous operation.
+  template <typename ConstBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_send_batch(implementation_type& impl,
+      const ConstBufferSequence& buffers, const endpoint_type* destinations,
+      const ip::packet_info* infos, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_send_batch_op<ConstBufferSequence,
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        buffers, destinations, infos, impl.protocol_.family(),
+        flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, &impl.reactor_data_, impl.socket_, reactor::write_op);
+    }
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_send_batch"));
+
+    start_op(impl, reactor::write_op, p.p,
+        is_continuation, true, false, true, &io_ex, 0);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_DATAGRAM_BATCH)
+
+#if defined(ASIO_HAS_UDP_OFFLOAD)
+  // Start an asynchronous send of data that is split into datagrams of
+  // segment_size bytes. The destination may be null if the socket is
+  // connected. The buffers must be valid for the lifetime of the asynchronous
+  // operation.
+  template <typename ConstBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_send_segments(implementation_type& impl,
+      const ConstBufferSequence& buffers, std::size_t segment_size,
+      const endpoint_type* destination, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_send_segments_op<ConstBufferSequence,
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        buffers, segment_size, destination, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, &impl.reactor_data_, impl.socket_, reactor::write_op);
+    }
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_send_segments"));
+
+    start_op(impl, reactor::write_op, p.p,
+        is_continuation, true, false, true, &io_ex, 0);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_UDP_OFFLOAD)
+
   // Receive a datagram with the endpoint of the sender. Returns the number of
   // bytes received.
   template <typename MutableBufferSequence>
@@ -475,6 +598,138 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(ASIO_HAS_DATAGRAM_BATCH)
+  // Start an asynchronous receive of a batch of datagrams, one into each
+  // buffer. The buffers, sender_endpoints, sizes and packet information must
+  // all be valid for the lifetime of the asynchronous operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_batch(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type* sender_endpoints,
+      std::size_t* sizes, ip::packet_info* infos,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recv_batch_op<MutableBufferSequence,
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_, buffers,
+        sender_endpoints, sizes, infos, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, &impl.reactor_data_, impl.socket_, reactor::read_op);
+    }
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_receive_batch"));
+
+    start_op(impl, reactor::read_op, p.p,
+        is_continuation, true, false, true, &io_ex, 0);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_DATAGRAM_BATCH)
+
+#if defined(ASIO_HAS_UDP_OFFLOAD)
+  // Start an asynchronous receive of datagrams that may have been coalesced
+  // by the kernel. The sender_endpoint may be null. The buffers and
+  // sender_endpoint object must both be valid for the lifetime of the
+  // asynchronous operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_coalesced(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type* sender_endpoint,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recv_coalesced_op<MutableBufferSequence,
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_, buffers,
+        sender_endpoint, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, &impl.reactor_data_, impl.socket_, reactor::read_op);
+    }
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_receive_coalesced"));
+
+    start_op(impl, reactor::read_op, p.p,
+        is_continuation, true, false, true, &io_ex, 0);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_UDP_OFFLOAD)
+
+#if defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+  // Start an asynchronous receive that also reports the timestamp generated
+  // for the received data. The sender_endpoint may be null. The buffers,
+  // sender_endpoint and timestamp objects must all be valid for the lifetime
+  // of the asynchronous operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_timestamped(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type* sender_endpoint,
+      socket_timestamp* timestamp, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    bool is_stream = (impl.state_ & socket_ops::stream_oriented) != 0;
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recv_timestamped_op<MutableBufferSequence,
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_, buffers, sender_endpoint,
+        timestamp, flags, is_stream, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, &impl.reactor_data_, impl.socket_, reactor::read_op);
+    }
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_receive_timestamped"));
+
+    start_op(impl, reactor::read_op, p.p, is_continuation, true,
+        (is_stream && buffer_sequence_adapter<asio::mutable_buffer,
+          MutableBufferSequence>::all_empty(buffers)), true, &io_ex, 0);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+
   // Accept a new connection.
   template <typename Socket>
   asio::error_code accept(implementation_type& impl,
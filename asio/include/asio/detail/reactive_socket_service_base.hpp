@@ -28,16 +28,27 @@
 #include "asio/execution_context.hpp"
 #include "asio/socket_base.hpp"
 #include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/close_thread_pool.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/reactive_null_buffers_op.hpp"
+#include "asio/detail/reactive_socket_close_op.hpp"
+#include "asio/detail/reactive_socket_recv_all_op.hpp"
+#include "asio/detail/reactive_socket_recv_multishot_op.hpp"
 #include "asio/detail/reactive_socket_recv_op.hpp"
+#include "asio/detail/reactive_socket_recv_fds_op.hpp"
+#include "asio/detail/reactive_socket_recv_read_ahead_op.hpp"
 #include "asio/detail/reactive_socket_recvmsg_op.hpp"
+#include "asio/detail/reactive_socket_send_all_op.hpp"
+#include "asio/detail/reactive_socket_send_fds_op.hpp"
 #include "asio/detail/reactive_socket_send_op.hpp"
 #include "asio/detail/reactive_wait_op.hpp"
 #include "asio/detail/reactor.hpp"
 #include "asio/detail/reactor_op.hpp"
+#include "asio/detail/scheduler.hpp"
 #include "asio/detail/socket_holder.hpp"
+#include "asio/detail/socket_op_slots.hpp"
 #include "asio/detail/socket_ops.hpp"
+#include "asio/detail/socket_read_ahead.hpp"
 #include "asio/detail/socket_types.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -62,6 +73,12 @@ public:
 
     // Per-descriptor data used by the reactor.
     reactor::per_descriptor_data reactor_data_;
+
+    // The read-ahead buffer, if enabled.
+    socket_read_ahead* read_ahead_;
+
+    // The memory reserved for operations, if enabled.
+    socket_op_slots* op_slots_;
   };
 
   // Constructor.
@@ -82,6 +99,14 @@ public:
       reactive_socket_service_base& other_service,
       base_implementation_type& other_impl);
 
+  // Move a socket implementation that belongs to another service into an
+  // empty implementation, moving the socket's registration to this service's
+  // reactor. On failure, neither implementation is changed.
+  ASIO_DECL asio::error_code base_transfer(
+      base_implementation_type& impl,
+      reactive_socket_service_base& other_service,
+      base_implementation_type& other_impl, asio::error_code& ec);
+
   // Destroy a socket implementation.
   ASIO_DECL void destroy(base_implementation_type& impl);
 
@@ -120,9 +145,22 @@ public:
   std::size_t available(const base_implementation_type& impl,
       asio::error_code& ec) const
   {
-    return socket_ops::available(impl.socket_, ec);
+    std::size_t bytes = socket_ops::available(impl.socket_, ec);
+    if (!ec && impl.read_ahead_)
+      bytes += impl.read_ahead_->size();
+    return bytes;
   }
 
+  // Set the size of the read-ahead buffer. A size of zero disables it.
+  ASIO_DECL asio::error_code set_read_ahead(
+      base_implementation_type& impl, const void* optval,
+      std::size_t optlen, asio::error_code& ec);
+
+  // Get the size of the read-ahead buffer.
+  ASIO_DECL asio::error_code get_read_ahead(
+      const base_implementation_type& impl, void* optval,
+      std::size_t* optlen, asio::error_code& ec) const;
+
   // Place the socket into the state where it will listen for new connections.
   asio::error_code listen(base_implementation_type& impl,
       int backlog, asio::error_code& ec)
@@ -177,7 +215,10 @@ public:
     switch (w)
     {
     case socket_base::wait_read:
-      socket_ops::poll_read(impl.socket_, impl.state_, -1, ec);
+      if (has_read_ahead_data(impl))
+        asio::error::clear(ec);
+      else
+        socket_ops::poll_read(impl.socket_, impl.state_, -1, ec);
       break;
     case socket_base::wait_write:
       socket_ops::poll_write(impl.socket_, impl.state_, -1, ec);
@@ -185,6 +226,9 @@ public:
     case socket_base::wait_error:
       socket_ops::poll_error(impl.socket_, impl.state_, -1, ec);
       break;
+    case socket_base::wait_peer_closed:
+      socket_ops::poll_peer_closed(impl.socket_, impl.state_, -1, ec);
+      break;
     default:
       ec = asio::error::invalid_argument;
       break;
@@ -226,6 +270,18 @@ public:
     case socket_base::wait_error:
       op_type = reactor::except_op;
       break;
+#if defined(ASIO_HAS_EPOLL)
+    case socket_base::wait_peer_closed:
+      op_type = reactor::peer_closed_op;
+      break;
+#else // defined(ASIO_HAS_EPOLL)
+    case socket_base::wait_peer_closed:
+      p.p->ec_ = asio::error::operation_not_supported;
+      start_op(impl, reactor::read_op, p.p,
+          is_continuation, false, true, false, &io_ex, 0);
+      p.v = p.p = 0;
+      return;
+#endif // defined(ASIO_HAS_EPOLL)
     default:
       p.p->ec_ = asio::error::invalid_argument;
       start_op(impl, reactor::read_op, p.p,
@@ -242,8 +298,65 @@ public:
             &reactor_, &impl.reactor_data_, impl.socket_, op_type);
     }
 
-    start_op(impl, op_type, p.p, is_continuation,
-        false, false, false, &io_ex, 0);
+    start_op(impl, op_type, p.p, is_continuation, false,
+        op_type == reactor::read_op && has_read_ahead_data(impl),
+        false, &io_ex, 0);
+    p.v = p.p = 0;
+  }
+
+  // Start an asynchronous close. The socket is closed at once, as far as the
+  // implementation is concerned, but the descriptor is closed on an internal
+  // thread so that a close that blocks does not hold up the reactor.
+  template <typename Handler, typename IoExecutor>
+  void async_close(base_implementation_type& impl,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_close_op<Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(scheduler_, impl.socket_,
+        impl.state_, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_close"));
+
+    if (begin_close(impl))
+    {
+      use_service<close_thread_pool>(reactor_.context()).start_close_op(
+          p.p, is_continuation);
+    }
+    else
+    {
+      scheduler_.post_immediate_completion(p.p, is_continuation);
+    }
+    p.v = p.p = 0;
+  }
+
+  // Start an asynchronous shutdown. A shutdown does not block, so it is
+  // performed immediately and the result is passed to the handler.
+  template <typename Handler, typename IoExecutor>
+  void async_shutdown(base_implementation_type& impl,
+      socket_base::shutdown_type what, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_close_op<Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(scheduler_, invalid_socket, 0, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_shutdown"));
+
+    socket_ops::shutdown(impl.socket_, what, p.p->ec_);
+    scheduler_.post_immediate_completion(p.p, is_continuation);
     p.v = p.p = 0;
   }
 
@@ -296,10 +409,12 @@ public:
     // Allocate and construct an operation to wrap the handler.
     typedef reactive_socket_send_op<
         ConstBufferSequence, Handler, IoExecutor> op;
+    socket_op_slots* slots = op::ptr::slots_for(op_slots(impl));
     typename op::ptr p = { asio::detail::addressof(handler),
-      op::ptr::allocate(handler), 0 };
+      op::ptr::allocate(handler, slots), 0, slots };
     p.p = new (p.v) op(success_ec_, impl.socket_,
         impl.state_, buffers, flags, handler, io_ex);
+    p.p->slots_ = slots;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected())
@@ -319,6 +434,138 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(ASIO_HAS_SOCKET_SEND_ALL)
+  // Start an asynchronous send that completes only once all of the data has
+  // been sent, or an error occurs. The data being sent must be valid for the
+  // lifetime of the asynchronous operation.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_send_all(base_implementation_type& impl,
+      const ConstBufferSequence& buffers, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // With write coalescing, the operation is queued rather than sent
+    // speculatively so that it may be sent together with those that follow.
+    bool coalesce = flags == 0
+      && (impl.state_ & socket_ops::write_coalescing) != 0;
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_send_all_op<ConstBufferSequence,
+        decltype(asio::buffer_sequence_begin(buffers)),
+        Handler, IoExecutor> op;
+    socket_op_slots* slots = op::ptr::slots_for(op_slots(impl));
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler, slots), 0, slots };
+    p.p = new (p.v) op(success_ec_, impl.socket_, buffers, flags, coalesce,
+        (impl.state_ & socket_ops::internal_zero_copy) != 0, handler, io_ex);
+    p.p->slots_ = slots;
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, &impl.reactor_data_, impl.socket_, reactor::write_op);
+    }
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_send_all"));
+
+    start_op(impl, reactor::write_op, p.p, is_continuation, !coalesce,
+        buffer_sequence_adapter<asio::const_buffer,
+          ConstBufferSequence>::all_empty(buffers), true, &io_ex, 0);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_SOCKET_SEND_ALL)
+
+#if defined(ASIO_HAS_FD_PASSING)
+  // Start an asynchronous send that passes file descriptors with the data.
+  // The data being sent and the descriptors must be valid for the lifetime of
+  // the asynchronous operation.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_send_fds(base_implementation_type& impl,
+      const ConstBufferSequence& buffers, const local::passed_fds* fds,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_send_fds_op<
+        ConstBufferSequence, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        impl.state_, buffers, fds, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, &impl.reactor_data_, impl.socket_, reactor::write_op);
+    }
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_send_fds"));
+
+    start_op(impl, reactor::write_op, p.p,
+        is_continuation, true, false, true, &io_ex, 0);
+    p.v = p.p = 0;
+  }
+
+  // Start an asynchronous receive that also receives any file descriptors
+  // passed with the data. The buffers and the descriptor storage must be
+  // valid for the lifetime of the asynchronous operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_fds(base_implementation_type& impl,
+      const MutableBufferSequence& buffers, local::passed_fds* fds,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recv_fds_op<
+        MutableBufferSequence, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        impl.state_, buffers, fds, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, &impl.reactor_data_, impl.socket_, reactor::read_op);
+    }
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_receive_fds"));
+
+    start_op(impl, reactor::read_op, p.p, is_continuation, true,
+        ((impl.state_ & socket_ops::stream_oriented)
+          && buffer_sequence_adapter<asio::mutable_buffer,
+            MutableBufferSequence>::all_empty(buffers)), true, &io_ex, 0);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_FD_PASSING)
+
   // Start an asynchronous wait until data can be sent without blocking.
   template <typename Handler, typename IoExecutor>
   void async_send(base_implementation_type& impl, const null_buffers&,
@@ -361,7 +608,23 @@ public:
     typedef buffer_sequence_adapter<asio::mutable_buffer,
         MutableBufferSequence> bufs_type;
 
-    if (bufs_type::is_single_buffer)
+    if (impl.read_ahead_ && flags == 0)
+    {
+      if (!impl.read_ahead_->empty())
+      {
+        asio::error::clear(ec);
+        return impl.read_ahead_->read(buffers);
+      }
+
+      socket_ops::buf bufs[socket_read_ahead::max_buffers];
+      std::size_t buffers_size = 0;
+      std::size_t count = impl.read_ahead_->prepare(
+          buffers, bufs, buffers_size);
+      return impl.read_ahead_->commit(
+          socket_ops::sync_recv(impl.socket_, impl.state_, bufs, count,
+            0, bufs_type::all_empty(buffers), ec), buffers_size);
+    }
+    else if (bufs_type::is_single_buffer)
     {
       return socket_ops::sync_recv1(impl.socket_,
           impl.state_, bufs_type::first(buffers).data(),
@@ -380,7 +643,10 @@ public:
       socket_base::message_flags, asio::error_code& ec)
   {
     // Wait for socket to become ready.
-    socket_ops::poll_read(impl.socket_, impl.state_, -1, ec);
+    if (has_read_ahead_data(impl))
+      asio::error::clear(ec);
+    else
+      socket_ops::poll_read(impl.socket_, impl.state_, -1, ec);
 
     return 0;
   }
@@ -393,6 +659,12 @@ public:
       const MutableBufferSequence& buffers, socket_base::message_flags flags,
       Handler& handler, const IoExecutor& io_ex)
   {
+    if (impl.read_ahead_ && flags == 0)
+    {
+      async_receive_read_ahead(impl, buffers, handler, io_ex);
+      return;
+    }
+
     bool is_continuation =
       asio_handler_cont_helpers::is_continuation(handler);
 
@@ -402,10 +674,12 @@ public:
     // Allocate and construct an operation to wrap the handler.
     typedef reactive_socket_recv_op<
         MutableBufferSequence, Handler, IoExecutor> op;
+    socket_op_slots* slots = op::ptr::slots_for(op_slots(impl));
     typename op::ptr p = { asio::detail::addressof(handler),
-      op::ptr::allocate(handler), 0 };
+      op::ptr::allocate(handler, slots), 0, slots };
     p.p = new (p.v) op(success_ec_, impl.socket_,
         impl.state_, buffers, flags, handler, io_ex);
+    p.p->slots_ = slots;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected())
@@ -461,9 +735,99 @@ public:
     start_op(impl,
         (flags & socket_base::message_out_of_band)
           ? reactor::except_op : reactor::read_op,
-        p.p, is_continuation, false, false, false, &io_ex, 0);
+        p.p, is_continuation, false,
+        (flags & socket_base::message_out_of_band) == 0
+          && has_read_ahead_data(impl), false, &io_ex, 0);
+    p.v = p.p = 0;
+  }
+
+#if defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+  // Start an asynchronous receive that completes only when the buffers have
+  // been filled, an error occurs, or the peer closes the connection. The
+  // buffers must be valid for the lifetime of the asynchronous operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_all(base_implementation_type& impl,
+      const MutableBufferSequence& buffers, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recv_all_op<MutableBufferSequence,
+        decltype(asio::buffer_sequence_begin(buffers)),
+        Handler, IoExecutor> op;
+    socket_op_slots* slots = op::ptr::slots_for(op_slots(impl));
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler, slots), 0, slots };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        buffers, flags, handler, io_ex);
+    p.p->slots_ = slots;
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, &impl.reactor_data_, impl.socket_, reactor::read_op);
+    }
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_receive_all"));
+
+    // Data already held in the read-ahead buffer is consumed first, and may
+    // be enough to complete the operation without waiting for the socket.
+    bool noop = buffer_sequence_adapter<asio::mutable_buffer,
+        MutableBufferSequence>::all_empty(buffers);
+    if (!noop && flags == 0 && has_read_ahead_data(impl))
+      noop = p.p->consume(impl.read_ahead_->read(buffers));
+
+    start_op(impl, reactor::read_op, p.p,
+        is_continuation, true, noop, true, &io_ex, 0);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+
+#if defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+  // Start an asynchronous receive into a buffer selected from a ring.
+  template <typename Handler, typename IoExecutor>
+  void async_receive_multishot(base_implementation_type& impl,
+      provided_buffer_ring& ring, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recv_multishot_op<Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        impl.state_, ring, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, &impl.reactor_data_, impl.socket_, reactor::read_op);
+    }
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_receive_multishot"));
+
+    start_op(impl, reactor::read_op, p.p,
+        is_continuation, true, false, true, &io_ex, 0);
     p.v = p.p = 0;
   }
+#endif // defined(ASIO_HAS_PROVIDED_BUFFER_RING)
 
   // Receive some data with associated flags. Returns the number of bytes
   // received.
@@ -580,6 +944,74 @@ public:
   }
 
 protected:
+  // Deregister the socket and reset the implementation, leaving the caller
+  // to close the descriptor. Returns false if the socket was not open.
+  ASIO_DECL bool begin_close(base_implementation_type& impl);
+
+  // Determine whether the socket holds data in its read-ahead buffer.
+  static bool has_read_ahead_data(const base_implementation_type& impl)
+  {
+    return impl.read_ahead_ && !impl.read_ahead_->empty();
+  }
+
+  // Get the socket's op slots if the operation_slots option is enabled,
+  // creating them on first use.
+  socket_op_slots* op_slots(base_implementation_type& impl)
+  {
+    if ((impl.state_ & socket_ops::operation_slots) == 0)
+      return 0;
+    if (!impl.op_slots_)
+      impl.op_slots_ = new socket_op_slots;
+    return impl.op_slots_;
+  }
+
+  // Start an asynchronous receive using the socket's read-ahead buffer.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_read_ahead(base_implementation_type& impl,
+      const MutableBufferSequence& buffers,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recv_read_ahead_op<
+        MutableBufferSequence, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        impl.read_ahead_, buffers, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, &impl.reactor_data_, impl.socket_, reactor::read_op);
+    }
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_receive"));
+
+    // Data already held in the read-ahead buffer completes the operation
+    // without waiting for the socket to become ready.
+    bool noop = buffer_sequence_adapter<asio::mutable_buffer,
+        MutableBufferSequence>::all_empty(buffers);
+    if (!noop && !impl.read_ahead_->empty())
+    {
+      p.p->bytes_transferred_ = impl.read_ahead_->read(buffers);
+      noop = true;
+    }
+
+    start_op(impl, reactor::read_op, p.p,
+        is_continuation, true, noop, true, &io_ex, 0);
+    p.v = p.p = 0;
+  }
+
   // Open a new socket implementation.
   ASIO_DECL asio::error_code do_open(
       base_implementation_type& impl, int af,
@@ -590,6 +1022,11 @@ protected:
       base_implementation_type& impl, int type,
       const native_handle_type& native_socket, asio::error_code& ec);
 
+  // Register the socket with the reactor, if registration was deferred when
+  // the socket was opened or assigned. Returns false on failure.
+  ASIO_DECL bool do_register(base_implementation_type& impl,
+      asio::error_code& ec);
+
   // Start the asynchronous read or write operation.
   ASIO_DECL void do_start_op(base_implementation_type& impl,
       int op_type, reactor_op* op, bool is_continuation,
@@ -732,6 +1169,21 @@ protected:
     int op_type_;
   };
 
+  // Records an operation for immediate completion, so that it may be invoked
+  // once the reactor has released its locks.
+  struct deferred_immediate_completion
+  {
+    mutable operation* op_;
+    mutable bool is_continuation_;
+  };
+
+  // Record an operation that is ready for immediate completion.
+  ASIO_DECL static void call_defer_immediate_completion(
+      operation* op, bool is_continuation, const void* self);
+
+  // The scheduler used to dispatch immediate completions.
+  scheduler& scheduler_;
+
   // The selector that performs event demultiplexing for the service.
   reactor& reactor_;
 
@@ -27,6 +27,8 @@
 # include "asio/detail/kqueue_reactor.hpp"
 #elif defined(ASIO_HAS_DEV_POLL)
 # include "asio/detail/dev_poll_reactor.hpp"
+#elif defined(ASIO_HAS_POLL)
+# include "asio/detail/poll_reactor.hpp"
 #else
 # include "asio/detail/select_reactor.hpp"
 #endif
@@ -44,6 +46,8 @@ typedef epoll_reactor reactor;
 typedef kqueue_reactor reactor;
 #elif defined(ASIO_HAS_DEV_POLL)
 typedef dev_poll_reactor reactor;
+#elif defined(ASIO_HAS_POLL)
+typedef poll_reactor reactor;
 #else
 typedef select_reactor reactor;
 #endif
@@ -43,7 +43,16 @@ public:
   // Perform the operation. Returns true if it is finished.
   status perform()
   {
-    return perform_func_(this);
+    status result = perform_func_(this);
+    if (result != not_done)
+      set_latency_ready();
+    return result;
+  }
+
+  // Determine whether the operation is performed by the given function.
+  bool is_performed_by(status (*perform_func)(reactor_op*)) const
+  {
+    return perform_func_ == perform_func;
   }
 
 protected:
@@ -38,6 +38,7 @@ public:
   {
     mapped_type() {}
     mapped_type(const mapped_type&) {}
+    mapped_type(mapped_type&& other) { push(other); }
     void operator=(const mapped_type&) {}
   };
 
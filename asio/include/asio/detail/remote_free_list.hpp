@@ -0,0 +1,136 @@
+//
+// detail/remote_free_list.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REMOTE_FREE_LIST_HPP
+#define ASIO_DETAIL_REMOTE_FREE_LIST_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/static_mutex.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A list of the memory blocks that were allocated by one thread and released
+// by others. Other threads push blocks onto the list without locking, and the
+// owning thread takes the whole list at once, so that blocks migrate back to
+// the thread that allocates them in batches.
+//
+// Blocks refer to the list of the thread that allocated them, and so a list
+// may be used after its owner has exited. Lists are therefore never freed.
+// When its owner exits, a list is closed, so that no more blocks are pushed
+// onto it, and is kept for reuse by a later thread.
+class remote_free_list
+  : private noncopyable
+{
+public:
+  // Obtain an open, empty list for the calling thread.
+  static remote_free_list* acquire()
+  {
+    registry& r = get_registry();
+    r.mutex_.init();
+    static_mutex::scoped_lock lock(r.mutex_);
+    remote_free_list* list = r.unused_;
+    if (list)
+      r.unused_ = list->next_unused_;
+    else
+      list = new remote_free_list;
+    list->next_unused_ = 0;
+    list->head_.store(0, std::memory_order_release);
+    return list;
+  }
+
+  // Close a list and keep it for reuse. Returns the blocks that were on the
+  // list, linked through their first words.
+  static void* release(remote_free_list* list)
+  {
+    void* blocks = list->head_.exchange(closed(), std::memory_order_acquire);
+    registry& r = get_registry();
+    static_mutex::scoped_lock lock(r.mutex_);
+    list->next_unused_ = r.unused_;
+    r.unused_ = list;
+    return blocks;
+  }
+
+  // Push a block onto the list, overwriting its first word. Returns false if
+  // the list is closed.
+  bool push(void* block)
+  {
+    void* head = head_.load(std::memory_order_relaxed);
+    do
+    {
+      if (head == closed())
+        return false;
+      *static_cast<void**>(block) = head;
+    } while (!head_.compare_exchange_weak(head, block,
+          std::memory_order_release, std::memory_order_relaxed));
+    return true;
+  }
+
+  // Take all of the blocks on the list, linked through their first words. Must
+  // only be called by the owning thread.
+  void* take()
+  {
+    if (head_.load(std::memory_order_relaxed) == 0)
+      return 0;
+    return head_.exchange(0, std::memory_order_acquire);
+  }
+
+private:
+  remote_free_list()
+    : head_(0),
+      next_unused_(0)
+  {
+  }
+
+  struct registry
+  {
+    static_mutex mutex_;
+    remote_free_list* unused_;
+  };
+
+  static registry& get_registry()
+  {
+    static registry r = { ASIO_STATIC_MUTEX_INIT, 0 };
+    return r;
+  }
+
+  // The value of the head of a closed list.
+  static void* closed()
+  {
+    static char sentinel;
+    return &sentinel;
+  }
+
+  // Keeps the head, which is written by other threads, on its own cache line.
+  char padding1_[64];
+
+  // The most recently pushed block.
+  std::atomic<void*> head_;
+
+  char padding2_[64];
+
+  // The next list that is available for reuse.
+  remote_free_list* next_unused_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_REMOTE_FREE_LIST_HPP
@@ -16,11 +16,13 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/associated_cancellation_slot.hpp"
 #include "asio/detail/bind_handler.hpp"
 #include "asio/detail/fenced_block.hpp"
 #include "asio/detail/handler_alloc_helpers.hpp"
 #include "asio/detail/handler_work.hpp"
 #include "asio/detail/memory.hpp"
+#include "asio/detail/resolve_lookup_op.hpp"
 #include "asio/detail/resolve_op.hpp"
 #include "asio/detail/socket_ops.hpp"
 #include "asio/error.hpp"
@@ -60,10 +62,39 @@ public:
       endpoint_(endpoint),
       scheduler_(sched),
       handler_(static_cast<Handler&&>(handler)),
-      work_(handler_, io_ex)
+      work_(handler_, io_ex),
+      lookup_(0)
   {
   }
 
+  ~resolve_endpoint_op()
+  {
+    delete lookup_;
+  }
+
+  // Perform the endpoint resolution in a separate lookup, so that the
+  // operation may be cancelled while the lookup is in progress. Returns the
+  // lookup, which is to be started in place of the operation.
+  template <typename Slot>
+  resolve_op* make_cancellable(Slot& slot)
+  {
+    lookup_ = new lookup_op(this, scheduler_, cancel_token_, endpoint_);
+    slot.template emplace<resolve_op_cancellation<resolve_endpoint_op>>(this);
+    return lookup_;
+  }
+
+  // Complete the operation with operation_aborted if its lookup is still in
+  // progress.
+  void cancel()
+  {
+    if (lookup_ && lookup_->abandon())
+    {
+      lookup_ = 0;
+      ec_ = asio::error::operation_aborted;
+      scheduler_.post_deferred_completion(this);
+    }
+  }
+
   static void do_complete(void* owner, operation* base,
       const asio::error_code& /*ec*/,
       std::size_t /*bytes_transferred*/)
@@ -97,6 +128,13 @@ public:
 
       ASIO_HANDLER_COMPLETION((*o));
 
+      // Take the result of a separate lookup.
+      if (o->lookup_)
+      {
+        o->ec_ = o->lookup_->ec_;
+        o->results_ = o->lookup_->lookup().results_;
+      }
+
       // Take ownership of the operation's outstanding work.
       handler_work<Handler, IoExecutor> w(
           static_cast<handler_work<Handler, IoExecutor>&&>(
@@ -111,6 +149,13 @@ public:
       detail::binder2<Handler, asio::error_code, results_type>
         handler(o->handler_, o->ec_, o->results_);
       p.h = asio::detail::addressof(handler.handler_);
+
+      // The cancellation handler refers to the operation, so it must not
+      // outlive it.
+      associated_cancellation_slot_t<Handler> slot
+        = asio::get_associated_cancellation_slot(handler.handler_);
+      if (slot.is_connected())
+        slot.clear();
       p.reset();
 
       if (owner)
@@ -124,12 +169,40 @@ public:
   }
 
 private:
+  // The blocking part of the operation, when performed separately.
+  struct lookup
+  {
+    lookup(const socket_ops::weak_cancel_token_type& cancel_token,
+        const endpoint_type& endpoint)
+      : cancel_token_(cancel_token),
+        endpoint_(endpoint)
+    {
+    }
+
+    void perform(asio::error_code& ec)
+    {
+      char host_name[NI_MAXHOST] = "";
+      char service_name[NI_MAXSERV] = "";
+      socket_ops::background_getnameinfo(cancel_token_, endpoint_.data(),
+          endpoint_.size(), host_name, NI_MAXHOST, service_name, NI_MAXSERV,
+          endpoint_.protocol().type(), ec);
+      results_ = results_type::create(endpoint_, host_name, service_name);
+    }
+
+    socket_ops::weak_cancel_token_type cancel_token_;
+    endpoint_type endpoint_;
+    results_type results_;
+  };
+
+  typedef resolve_lookup_op<lookup> lookup_op;
+
   socket_ops::weak_cancel_token_type cancel_token_;
   endpoint_type endpoint_;
   scheduler_impl& scheduler_;
   Handler handler_;
   handler_work<Handler, IoExecutor> work_;
   results_type results_;
+  lookup_op* lookup_;
 };
 
 } // namespace detail
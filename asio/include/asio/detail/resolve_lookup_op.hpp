@@ -0,0 +1,145 @@
+//
+// detail/resolve_lookup_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_RESOLVE_LOOKUP_OP_HPP
+#define ASIO_DETAIL_RESOLVE_LOOKUP_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include "asio/cancellation_type.hpp"
+#include "asio/error.hpp"
+#include "asio/detail/resolve_op.hpp"
+
+#if defined(ASIO_HAS_IOCP)
+# include "asio/detail/win_iocp_io_context.hpp"
+#else // defined(ASIO_HAS_IOCP)
+# include "asio/detail/scheduler.hpp"
+#endif // defined(ASIO_HAS_IOCP)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Performs the blocking part of a resolve operation on behalf of an owning
+// operation. The lookup is allocated separately from the owner so that, if the
+// owner is cancelled, its handler may be delivered while the lookup is still
+// running on the resolver's thread. The abandoned lookup's results are then
+// discarded when it finishes.
+template <typename Lookup>
+class resolve_lookup_op : public resolve_op
+{
+public:
+#if defined(ASIO_HAS_IOCP)
+  typedef class win_iocp_io_context scheduler_impl;
+#else
+  typedef class scheduler scheduler_impl;
+#endif
+
+  template <typename... Args>
+  resolve_lookup_op(resolve_op* owner, scheduler_impl& sched, Args&&... args)
+    : resolve_op(&resolve_lookup_op::do_complete),
+      owner_(owner),
+      scheduler_(sched),
+      state_(pending),
+      lookup_(static_cast<Args&&>(args)...)
+  {
+  }
+
+  // Abandon the lookup. Returns true if it was still in progress, in which
+  // case the lookup no longer refers to the owner and the caller is
+  // responsible for completing it.
+  bool abandon()
+  {
+    int expected = pending;
+    return state_.compare_exchange_strong(expected,
+        abandoned, std::memory_order_acq_rel);
+  }
+
+  // Get the lookup, once it has finished.
+  Lookup& lookup()
+  {
+    return lookup_;
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    ASIO_ASSUME(base != 0);
+    resolve_lookup_op* o(static_cast<resolve_lookup_op*>(base));
+
+    // Perform the blocking lookup on the worker io_context, unless the owner
+    // has already been cancelled.
+    if (owner && o->state_.load(std::memory_order_acquire) == pending)
+      o->lookup_.perform(o->ec_);
+
+    int expected = pending;
+    if (o->state_.compare_exchange_strong(expected,
+          finished, std::memory_order_acq_rel))
+    {
+      // The owner takes ownership of the lookup and destroys it when it
+      // completes.
+      if (owner)
+        o->scheduler_.post_deferred_completion(o->owner_);
+      else
+        o->owner_->destroy();
+    }
+    else
+    {
+      // The owner has already completed.
+      delete o;
+    }
+  }
+
+private:
+  enum { pending, abandoned, finished };
+
+  resolve_op* owner_;
+  scheduler_impl& scheduler_;
+  std::atomic<int> state_;
+  Lookup lookup_;
+};
+
+// Cancellation handler for resolve operations that use a separate lookup.
+template <typename Op>
+class resolve_op_cancellation
+{
+public:
+  explicit resolve_op_cancellation(Op* op)
+    : op_(op)
+  {
+  }
+
+  void operator()(cancellation_type_t type)
+  {
+    if (!!(type &
+          (cancellation_type::terminal
+            | cancellation_type::partial
+            | cancellation_type::total)))
+    {
+      op_->cancel();
+    }
+  }
+
+private:
+  Op* op_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_RESOLVE_LOOKUP_OP_HPP
@@ -16,11 +16,13 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/associated_cancellation_slot.hpp"
 #include "asio/detail/bind_handler.hpp"
 #include "asio/detail/fenced_block.hpp"
 #include "asio/detail/handler_alloc_helpers.hpp"
 #include "asio/detail/handler_work.hpp"
 #include "asio/detail/memory.hpp"
+#include "asio/detail/resolve_lookup_op.hpp"
 #include "asio/detail/resolve_op.hpp"
 #include "asio/detail/socket_ops.hpp"
 #include "asio/error.hpp"
@@ -62,7 +64,8 @@ public:
       scheduler_(sched),
       handler_(static_cast<Handler&&>(handler)),
       work_(handler_, io_ex),
-      addrinfo_(0)
+      addrinfo_(0),
+      lookup_(0)
   {
   }
 
@@ -70,6 +73,30 @@ public:
   {
     if (addrinfo_)
       socket_ops::freeaddrinfo(addrinfo_);
+    delete lookup_;
+  }
+
+  // Perform the host resolution in a separate lookup, so that the operation
+  // may be cancelled while the lookup is in progress. Returns the lookup,
+  // which is to be started in place of the operation.
+  template <typename Slot>
+  resolve_op* make_cancellable(Slot& slot)
+  {
+    lookup_ = new lookup_op(this, scheduler_, cancel_token_, query_);
+    slot.template emplace<resolve_op_cancellation<resolve_query_op>>(this);
+    return lookup_;
+  }
+
+  // Complete the operation with operation_aborted if its lookup is still in
+  // progress.
+  void cancel()
+  {
+    if (lookup_ && lookup_->abandon())
+    {
+      lookup_ = 0;
+      ec_ = asio::error::operation_aborted;
+      scheduler_.post_deferred_completion(this);
+    }
   }
 
   static void do_complete(void* owner, operation* base,
@@ -102,6 +129,14 @@ public:
 
       ASIO_HANDLER_COMPLETION((*o));
 
+      // Take the result of a separate lookup.
+      if (o->lookup_)
+      {
+        o->ec_ = o->lookup_->ec_;
+        o->addrinfo_ = o->lookup_->lookup().addrinfo_;
+        o->lookup_->lookup().addrinfo_ = 0;
+      }
+
       // Take ownership of the operation's outstanding work.
       handler_work<Handler, IoExecutor> w(
           static_cast<handler_work<Handler, IoExecutor>&&>(
@@ -121,6 +156,13 @@ public:
         handler.arg2_ = results_type::create(o->addrinfo_,
             o->query_.host_name(), o->query_.service_name());
       }
+
+      // The cancellation handler refers to the operation, so it must not
+      // outlive it.
+      associated_cancellation_slot_t<Handler> slot
+        = asio::get_associated_cancellation_slot(handler.handler_);
+      if (slot.is_connected())
+        slot.clear();
       p.reset();
 
       if (owner)
@@ -134,12 +176,44 @@ public:
   }
 
 private:
+  // The blocking part of the operation, when performed separately.
+  struct lookup
+  {
+    lookup(const socket_ops::weak_cancel_token_type& cancel_token,
+        const query_type& qry)
+      : cancel_token_(cancel_token),
+        query_(qry),
+        addrinfo_(0)
+    {
+    }
+
+    ~lookup()
+    {
+      if (addrinfo_)
+        socket_ops::freeaddrinfo(addrinfo_);
+    }
+
+    void perform(asio::error_code& ec)
+    {
+      socket_ops::background_getaddrinfo(cancel_token_,
+          query_.host_name().c_str(), query_.service_name().c_str(),
+          query_.hints(), &addrinfo_, ec);
+    }
+
+    socket_ops::weak_cancel_token_type cancel_token_;
+    query_type query_;
+    asio::detail::addrinfo_type* addrinfo_;
+  };
+
+  typedef resolve_lookup_op<lookup> lookup_op;
+
   socket_ops::weak_cancel_token_type cancel_token_;
   query_type query_;
   scheduler_impl& scheduler_;
   Handler handler_;
   handler_work<Handler, IoExecutor> work_;
   asio::detail::addrinfo_type* addrinfo_;
+  lookup_op* lookup_;
 };
 
 } // namespace detail
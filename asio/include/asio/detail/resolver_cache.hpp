@@ -0,0 +1,297 @@
+//
+// detail/resolver_cache.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_RESOLVER_CACHE_HPP
+#define ASIO_DETAIL_RESOLVER_CACHE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "asio/any_completion_handler.hpp"
+#include "asio/config.hpp"
+#include "asio/error.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/ip/basic_resolver_results.hpp"
+#include "asio/ip/resolver_base.hpp"
+#include "asio/detail/mutex.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Holds the results of forward resolutions, shared by all caching resolvers of
+// a protocol within an execution context. The entries are divided between a
+// number of shards, each with its own mutex, so that threads resolving
+// different names rarely contend. An entry that is being resolved holds the
+// handlers waiting for it, so that concurrent lookups of the same name
+// require only one resolution.
+template <typename Protocol>
+class resolver_cache
+  : public execution_context_service_base<resolver_cache<Protocol>>
+{
+public:
+  // The results type.
+  typedef asio::ip::basic_resolver_results<Protocol> results_type;
+
+  // The type of a handler waiting for a resolution to complete.
+  typedef any_completion_handler<
+    void(asio::error_code, results_type)> waiter_type;
+
+  // The outcome of a lookup.
+  enum lookup_status
+  {
+    // The results were found in the cache.
+    cached,
+
+    // The name is already being resolved, and the waiter will be called when
+    // the resolution completes.
+    joined,
+
+    // The caller must resolve the name, and then call complete().
+    started
+  };
+
+  // Constructor.
+  resolver_cache(execution_context& context)
+    : execution_context_service_base<resolver_cache<Protocol>>(context),
+      ttl_(std::chrono::milliseconds(
+            config(context).get("resolver", "cache_ttl", 30000U))),
+      negative_ttl_(std::chrono::milliseconds(
+            config(context).get("resolver", "cache_negative_ttl", 5000U))),
+      max_shard_entries_(
+          config(context).get("resolver", "cache_size", 1024U)
+            / num_shards + 1)
+  {
+  }
+
+  // Destroy all user-defined handler objects owned by the service.
+  void shutdown()
+  {
+    for (std::size_t i = 0; i < num_shards; ++i)
+    {
+      std::vector<waiter_type> waiters;
+      {
+        mutex::scoped_lock lock(shards_[i].mutex_);
+        typename entry_map::iterator iter = shards_[i].entries_.begin();
+        for (; iter != shards_[i].entries_.end(); ++iter)
+          for (std::size_t j = 0; j < iter->second.waiters_.size(); ++j)
+            waiters.push_back(std::move(iter->second.waiters_[j]));
+        shards_[i].entries_.clear();
+      }
+      // The waiters are destroyed here, outside the lock.
+    }
+  }
+
+  // Form the key under which the results of a resolution are cached.
+  static std::string make_key(const std::string& host,
+      const std::string& service, asio::ip::resolver_base::flags flags)
+  {
+    std::string key;
+    key.reserve(host.size() + service.size() + 2 + sizeof(flags));
+    key.append(host);
+    key.push_back('\0');
+    key.append(service);
+    key.push_back('\0');
+    key.append(reinterpret_cast<const char*>(&flags), sizeof(flags));
+    return key;
+  }
+
+  // Find unexpired results for a key. A cached error is returned as ec.
+  bool find(const std::string& key,
+      results_type& results, asio::error_code& ec)
+  {
+    shard& s = shard_for(key);
+    mutex::scoped_lock lock(s.mutex_);
+    typename entry_map::iterator iter = s.entries_.find(key);
+    if (iter == s.entries_.end() || !is_fresh(iter->second, clock::now()))
+      return false;
+    results = iter->second.results_;
+    ec = iter->second.ec_;
+    return true;
+  }
+
+  // Find unexpired results for a key or, if there are none, add the waiter to
+  // the entry for the key. The waiter is left unchanged if the results are
+  // found in the cache.
+  lookup_status lookup(const std::string& key, waiter_type& waiter,
+      results_type& results, asio::error_code& ec)
+  {
+    shard& s = shard_for(key);
+    mutex::scoped_lock lock(s.mutex_);
+    entry& e = s.entries_[key];
+    if (e.pending_)
+    {
+      e.waiters_.push_back(std::move(waiter));
+      return joined;
+    }
+
+    if (is_fresh(e, clock::now()))
+    {
+      results = e.results_;
+      ec = e.ec_;
+      return cached;
+    }
+
+    e.pending_ = true;
+    e.waiters_.push_back(std::move(waiter));
+    return started;
+  }
+
+  // Record the outcome of a resolution that was started by lookup(), and pass
+  // it to the waiters. Successful results are cached for the configured
+  // lifetime. A name that does not exist is cached for the configured negative
+  // lifetime, and no other errors are cached.
+  void complete(const std::string& key,
+      const asio::error_code& ec, const results_type& results)
+  {
+    std::vector<waiter_type> waiters;
+    {
+      shard& s = shard_for(key);
+      mutex::scoped_lock lock(s.mutex_);
+      typename entry_map::iterator iter = s.entries_.find(key);
+      if (iter == s.entries_.end())
+        return;
+
+      waiters.swap(iter->second.waiters_);
+      iter->second.pending_ = false;
+      store(s, iter, ec, results);
+    }
+
+    for (std::size_t i = 0; i < waiters.size(); ++i)
+      std::move(waiters[i])(ec, results);
+  }
+
+  // Record the outcome of a synchronous resolution. It is discarded if the
+  // name is being resolved asynchronously.
+  void insert(const std::string& key,
+      const asio::error_code& ec, const results_type& results)
+  {
+    shard& s = shard_for(key);
+    mutex::scoped_lock lock(s.mutex_);
+    typename entry_map::iterator iter =
+      s.entries_.insert(typename entry_map::value_type(key, entry())).first;
+    if (!iter->second.pending_)
+      store(s, iter, ec, results);
+  }
+
+private:
+  typedef std::chrono::steady_clock clock;
+
+  // The number of shards.
+  enum { num_shards = 16 };
+
+  // A cache entry.
+  struct entry
+  {
+    entry()
+      : pending_(false)
+    {
+    }
+
+    results_type results_;
+    asio::error_code ec_;
+    clock::time_point expiry_;
+    bool pending_;
+    std::vector<waiter_type> waiters_;
+  };
+
+  typedef std::unordered_map<std::string, entry> entry_map;
+
+  // A shard of the cache.
+  struct shard
+  {
+    mutex mutex_;
+    entry_map entries_;
+  };
+
+  // Get the shard that holds a key.
+  shard& shard_for(const std::string& key)
+  {
+    return shards_[std::hash<std::string>()(key) % num_shards];
+  }
+
+  // Determine whether an entry holds results that may be used.
+  static bool is_fresh(const entry& e, clock::time_point now)
+  {
+    return !e.pending_ && e.expiry_ > now;
+  }
+
+  // Store the outcome of a resolution in an entry, or remove the entry if the
+  // outcome is not to be cached. The shard's mutex must be locked.
+  void store(shard& s, typename entry_map::iterator iter,
+      const asio::error_code& ec, const results_type& results)
+  {
+    clock::duration lifetime = !ec ? ttl_
+      : ec == asio::error::host_not_found ? negative_ttl_
+      : clock::duration::zero();
+    if (lifetime > clock::duration::zero())
+    {
+      clock::time_point now = clock::now();
+      iter->second.results_ = results;
+      iter->second.ec_ = ec;
+      iter->second.expiry_ = now + lifetime;
+      if (s.entries_.size() > max_shard_entries_)
+        purge(s, now);
+    }
+    else
+    {
+      s.entries_.erase(iter);
+    }
+  }
+
+  // Remove the expired entries from a shard. If the shard remains full, the
+  // entries that are not being resolved are removed.
+  void purge(shard& s, clock::time_point now)
+  {
+    for (int pass = 0; pass < 2; ++pass)
+    {
+      typename entry_map::iterator iter = s.entries_.begin();
+      while (iter != s.entries_.end())
+      {
+        if (!iter->second.pending_ && (pass > 0 || iter->second.expiry_ <= now))
+          iter = s.entries_.erase(iter);
+        else
+          ++iter;
+      }
+
+      if (s.entries_.size() <= max_shard_entries_)
+        break;
+    }
+  }
+
+  // The lifetime of successful results.
+  clock::duration ttl_;
+
+  // The lifetime of host_not_found errors.
+  clock::duration negative_ttl_;
+
+  // The number of entries that a shard may hold before it is purged.
+  std::size_t max_shard_entries_;
+
+  // The shards.
+  shard shards_[num_shards];
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_RESOLVER_CACHE_HPP
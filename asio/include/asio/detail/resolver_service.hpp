@@ -19,8 +19,11 @@
 
 #if !defined(ASIO_WINDOWS_RUNTIME)
 
+#include "asio/associated_allocator.hpp"
+#include "asio/associated_cancellation_slot.hpp"
 #include "asio/ip/basic_resolver_query.hpp"
 #include "asio/ip/basic_resolver_results.hpp"
+#include "asio/detail/dns_resolve_op.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/resolve_endpoint_op.hpp"
 #include "asio/detail/resolve_query_op.hpp"
@@ -82,16 +85,34 @@ public:
   void async_resolve(implementation_type& impl, const query_type& qry,
       Handler& handler, const IoExecutor& io_ex)
   {
+    if (use_dns(qry.host_name(), qry.service_name(), qry.hints()))
+    {
+      typedef dns_resolve_op<Protocol, Handler, IoExecutor> dns_op;
+      std::shared_ptr<dns_op> o(std::allocate_shared<dns_op>(
+            (get_associated_allocator)(handler), impl, qry,
+            dns_config_, dns_port_, thread_pool_, handler, io_ex));
+      o->start();
+      return;
+    }
+
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
     // Allocate and construct an operation to wrap the handler.
     typedef resolve_query_op<Protocol, Handler, IoExecutor> op;
     typename op::ptr p = { asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
     p.p = new (p.v) op(impl, qry, thread_pool_.scheduler(), handler, io_ex);
 
+    // Optionally register for per-operation cancellation.
+    resolve_op* start_op = p.p;
+    if (slot.is_connected() && thread_pool_.background_lookups())
+      start_op = p.p->make_cancellable(slot);
+
     ASIO_HANDLER_CREATION((thread_pool_.context(),
           *p.p, "resolver", &impl, 0, "async_resolve"));
 
-    thread_pool_.start_resolve_op(p.p);
+    thread_pool_.start_resolve_op(start_op);
     p.v = p.p = 0;
   }
 
@@ -115,6 +136,9 @@ public:
   void async_resolve(implementation_type& impl, const endpoint_type& endpoint,
       Handler& handler, const IoExecutor& io_ex)
   {
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
     // Allocate and construct an operation to wrap the handler.
     typedef resolve_endpoint_op<Protocol, Handler, IoExecutor> op;
     typename op::ptr p = { asio::detail::addressof(handler),
@@ -122,10 +146,15 @@ public:
     p.p = new (p.v) op(impl, endpoint,
         thread_pool_.scheduler(), handler, io_ex);
 
+    // Optionally register for per-operation cancellation.
+    resolve_op* start_op = p.p;
+    if (slot.is_connected() && thread_pool_.background_lookups())
+      start_op = p.p->make_cancellable(slot);
+
     ASIO_HANDLER_CREATION((thread_pool_.context(),
           *p.p, "resolver", &impl, 0, "async_resolve"));
 
-    thread_pool_.start_resolve_op(p.p);
+    thread_pool_.start_resolve_op(start_op);
     p.v = p.p = 0;
   }
 };
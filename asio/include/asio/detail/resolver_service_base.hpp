@@ -16,8 +16,11 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <memory>
+#include <string>
 #include "asio/error.hpp"
 #include "asio/execution_context.hpp"
+#include "asio/detail/dns_ops.hpp"
 #include "asio/detail/noncopyable.hpp"
 #include "asio/detail/resolve_op.hpp"
 #include "asio/detail/resolver_thread_pool.hpp"
@@ -107,6 +110,17 @@ protected:
   private:
     asio::detail::addrinfo_type* ai_;
   };
+
+  // Determine whether a query may be resolved by sending queries directly to
+  // the configured name servers.
+  ASIO_DECL bool use_dns(const std::string& host,
+      const std::string& service, const addrinfo_type& hints) const;
+
+  // The name server configuration, if direct queries are enabled.
+  std::shared_ptr<const dns_ops::resolver_config> dns_config_;
+
+  // The port on which the name servers are queried.
+  unsigned short dns_port_;
 #endif // !defined(ASIO_WINDOWS_RUNTIME)
 
   // Private thread pool used for performing asynchronous host resolution.
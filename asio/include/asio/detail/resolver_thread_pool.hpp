@@ -58,6 +58,13 @@ public:
   // Helper function to start an asynchronous resolve operation.
   ASIO_DECL void start_resolve_op(resolve_op* op);
 
+  // Whether lookups are performed on the internal threads. Otherwise, resolve
+  // operations complete with operation_not_supported.
+  bool background_lookups() const
+  {
+    return scheduler_locking_;
+  }
+
   // Get the underlying scheduler implementation.
   scheduler_impl& scheduler()
   {
@@ -22,11 +22,16 @@
 #include "asio/detail/atomic_count.hpp"
 #include "asio/detail/conditionally_enabled_event.hpp"
 #include "asio/detail/conditionally_enabled_mutex.hpp"
+#include "asio/detail/huge_page_arena.hpp"
+#include "asio/detail/memory_metrics.hpp"
 #include "asio/detail/op_queue.hpp"
+#include "asio/detail/operation_latency.hpp"
+#include "asio/detail/scheduler_metrics.hpp"
 #include "asio/detail/scheduler_operation.hpp"
 #include "asio/detail/scheduler_task.hpp"
 #include "asio/detail/thread.hpp"
 #include "asio/detail/thread_context.hpp"
+#include "asio/detail/work_stealing_queue.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -68,6 +73,21 @@ public:
   // Run the event loop until interrupted or no more work.
   ASIO_DECL std::size_t run(asio::error_code& ec);
 
+  // Run the event loop until interrupted, no more work, or the calling thread
+  // has been idle for the specified time. A negative time means no limit.
+  ASIO_DECL std::size_t run_until_idle(long idle_usec, asio::error_code& ec);
+
+  // The type of a function that is called to add a thread.
+  typedef void (*grow_func_type)(void*);
+
+  // Configure the scheduler for a pool of threads that varies in size. Idle
+  // threads check for handlers for the specified time before they block. The
+  // function is called, without the lock held, whenever the queue has held
+  // handlers for at least the specified time. Must be called before any
+  // thread runs.
+  ASIO_DECL void set_elastic(long idle_spin_usec,
+      long grow_usec, grow_func_type f, void* arg);
+
   // Run until interrupted or one operation is performed.
   ASIO_DECL std::size_t run_one(asio::error_code& ec);
 
@@ -93,7 +113,8 @@ public:
   // Notify that some work has started.
   void work_started()
   {
-    ++outstanding_work_;
+    if (work_count_batch_ <= 0 || !reserve_work(1))
+      add_outstanding_work(1);
   }
 
   // Used to compensate for a forthcoming work_finished call. Must be called
@@ -103,13 +124,26 @@ public:
   // Notify that some work has finished.
   void work_finished()
   {
-    if (--outstanding_work_ == 0)
-      stop();
+    if (work_count_batch_ <= 0 || !reserve_work(-1))
+      if (add_outstanding_work(-1) == 0)
+        stop();
+  }
+
+  // Get the current amount of outstanding work. When work counts are batched,
+  // this includes the work reserved by threads running the scheduler.
+  std::size_t outstanding_work() const
+  {
+    return static_cast<std::size_t>(static_cast<long>(outstanding_work_));
   }
 
   // Return whether a handler can be dispatched immediately.
   ASIO_DECL bool can_dispatch();
 
+  // Return whether a handler can be dispatched immediately without exceeding
+  // the calling thread's budget for inline completions. If so, the handler is
+  // counted against the budget.
+  ASIO_DECL bool can_dispatch_inline();
+
   /// Capture the current exception so it can be rethrown from a run function.
   ASIO_DECL void capture_current_exception();
 
@@ -118,11 +152,24 @@ public:
   ASIO_DECL void post_immediate_completion(
       operation* op, bool is_continuation);
 
+  // Invoke the given operation on the calling thread, provided that the thread
+  // is running the scheduler and is not already too deeply nested within such
+  // invocations and has not exhausted its budget for inline completions.
+  // Returns false, without invoking the operation, otherwise.
+  ASIO_DECL bool dispatch_immediate_completion(operation* op);
+
   // Request invocation of the given operations and return immediately. Assumes
   // that work_started() has not yet been called for the operations.
   ASIO_DECL void post_immediate_completions(std::size_t n,
       op_queue<operation>& ops, bool is_continuation);
 
+  // Request invocation of the given operation at the given priority and
+  // return immediately. Assumes that work_started() has not yet been called
+  // for the operation. The priority is ignored unless priority lanes have
+  // been enabled.
+  ASIO_DECL void post_prioritised_completion(operation* op,
+      bool is_continuation, unsigned int priority);
+
   // Request invocation of the given operation and return immediately. Assumes
   // that work_started() was previously called for the operation.
   ASIO_DECL void post_deferred_completion(operation* op);
@@ -139,6 +186,30 @@ public:
   // work_started() was previously called for the operations.
   ASIO_DECL void abandon_operations(op_queue<operation>& ops);
 
+  // Get the counters describing the activity of the scheduler and its task.
+  scheduler_metrics& metrics()
+  {
+    return metrics_;
+  }
+
+  // Record the latencies of an operation that is about to be invoked.
+  void record_latency(operation* op)
+  {
+#if defined(ASIO_ENABLE_LATENCY_HISTOGRAMS)
+    latency_.record(op->latency());
+#else // defined(ASIO_ENABLE_LATENCY_HISTOGRAMS)
+    (void)op;
+#endif // defined(ASIO_ENABLE_LATENCY_HISTOGRAMS)
+  }
+
+#if defined(ASIO_ENABLE_LATENCY_HISTOGRAMS)
+  // Get the latency histograms of the operations invoked by the scheduler.
+  const latency_recorder& latency() const
+  {
+    return latency_;
+  }
+#endif // defined(ASIO_ENABLE_LATENCY_HISTOGRAMS)
+
 private:
   // The mutex type used by this scheduler.
   typedef conditionally_enabled_mutex mutex;
@@ -164,14 +235,148 @@ private:
   // Stop the task and all idle threads.
   ASIO_DECL void stop_all_threads(mutex::scoped_lock& lock);
 
+  // Prepare the calling thread's recycling cache to allocate memory on behalf
+  // of the scheduler.
+  ASIO_DECL void init_thread_memory(thread_info& this_thread);
+
+  // Restore the calling thread's budget for inline completions, as it is about
+  // to run a handler taken from a queue.
+  ASIO_DECL void reset_inline_budget(thread_info& this_thread);
+
+  // Count an inline completion against the calling thread's budget. Returns
+  // false if the budget is exhausted.
+  ASIO_DECL bool consume_inline_budget(thread_info& this_thread);
+
+  // Check for handlers without blocking, for up to the idle spin time after
+  // the thread became idle. Returns true if handlers arrived or the scheduler
+  // was stopped. The lock must be held on entry, and is held on exit.
+  ASIO_DECL bool idle_spin(mutex::scoped_lock& lock, thread_info& this_thread);
+
+  // Called when the queue holds handlers that are waiting for a thread.
+  // Returns true if the queue has held handlers for long enough that a thread
+  // should be added. The lock must be held.
+  ASIO_DECL bool check_backlog();
+
+  // Repeatedly run the task without blocking, for up to the calling thread's
+  // busy-poll budget. Returns true if the task produced operations or was
+  // interrupted. The lock must not be held on entry, and is not held on exit.
+  ASIO_DECL bool busy_poll_task(mutex::scoped_lock& lock,
+      thread_info& this_thread);
+
+  // Run the task without blocking while another thread is running it. Returns
+  // true if the task produced operations. The lock must be held on entry, and
+  // is held on exit.
+  ASIO_DECL bool run_task_concurrently(mutex::scoped_lock& lock,
+      thread_info& this_thread);
+
+#if defined(ASIO_HAS_THREADS)
+  // The type of the per-thread work queues used when work stealing.
+  typedef work_stealing_queue<operation> work_queue;
+
+  // Run an operation taken from a per-thread work queue. The lock must not be
+  // held on entry.
+  ASIO_DECL std::size_t do_run_work_queue_op(mutex::scoped_lock& lock,
+      thread_info& this_thread, operation* o, const asio::error_code& ec);
+
+  // Assign a per-thread work queue to the calling thread, if one is available.
+  ASIO_DECL void acquire_work_queue(thread_info& this_thread);
+
+  // Move any remaining operations from the calling thread's work queue to the
+  // shared queue, and return the work queue to the pool.
+  ASIO_DECL void release_work_queue(thread_info& this_thread);
+
+  // Attempt to add an operation to the calling thread's work queue.
+  ASIO_DECL bool push_work_queue_op(operation* op);
+
+  // Attempt to add operations to the calling thread's work queue. Returns true
+  // if all operations were added, otherwise leaves the remainder in ops.
+  ASIO_DECL bool push_work_queue_ops(op_queue<operation>& ops);
+
+  // Take an operation from the calling thread's work queue or, failing that,
+  // steal one from another thread's work queue.
+  ASIO_DECL operation* find_work_queue_op(thread_info& this_thread);
+
+  // Wake a single idle thread so that it can steal work.
+  ASIO_DECL void wake_one_idle_thread();
+#endif // defined(ASIO_HAS_THREADS)
+
   // Wake a single idle thread, or the task, and always unlock the mutex.
   ASIO_DECL void wake_one_thread_and_unlock(
       mutex::scoped_lock& lock);
 
+  // Wake up to n idle threads, or the task if there are none, and always
+  // unlock the mutex.
+  ASIO_DECL void wake_threads_and_unlock(
+      mutex::scoped_lock& lock, std::size_t n);
+
+  // Use deficit round robin to choose between the priority lanes and the main
+  // queue. If a priority lane's handler is chosen, it is moved to the front of
+  // the main queue. The lock must be held, and priority_lane_ops_ non-zero.
+  ASIO_DECL void select_priority_lane();
+
+  // Record that operations are about to be added to the shared queue, when
+  // metrics are enabled. The lock must be held.
+  void record_queued(std::size_t n)
+  {
+    if (metrics_.enabled())
+      metrics_.record_queue_depth(queue_depth_ += n);
+  }
+
+  // Record that operations are about to be added to the shared queue, when
+  // metrics are enabled. The lock must be held.
+  void record_queued(const op_queue<operation>& ops)
+  {
+    if (metrics_.enabled())
+      metrics_.record_queue_depth(queue_depth_ += ops.count());
+  }
+
+  // Record that a handler has been removed from the shared queue, when metrics
+  // are enabled. The lock must be held.
+  void record_dequeued()
+  {
+    if (metrics_.enabled())
+      --queue_depth_;
+  }
+
+  // Get the task, if it is the default task for the execution context. The
+  // caller must hold the lock.
+  ASIO_DECL scheduler_task* default_task() const;
+
   // Get the default task.
   ASIO_DECL static scheduler_task* get_default_task(
       asio::execution_context& ctx);
 
+  // Add to the count of unfinished work, returning the new count. A scheduler
+  // without locking is only used from one thread, so the count is then
+  // updated without an atomic read-modify-write.
+  long add_outstanding_work(long n)
+  {
+#if defined(ASIO_HAS_THREADS)
+    if (!mutex_.enabled())
+    {
+      long count = outstanding_work_.load(std::memory_order_relaxed) + n;
+      outstanding_work_.store(count, std::memory_order_relaxed);
+      return count;
+    }
+#endif // defined(ASIO_HAS_THREADS)
+    return outstanding_work_ += n;
+  }
+
+  // Account for n units of work started, or -n units finished, against the
+  // calling thread's reserve. Returns false if the calling thread is not
+  // batching work counts, in which case the caller must update the count.
+  ASIO_DECL bool reserve_work(long n);
+
+  // Account for n units of work started, or -n units finished, against the
+  // thread's reserve, exchanging a batch with the outstanding work count when
+  // the reserve runs out or grows too large.
+  ASIO_DECL void adjust_work_reserve(thread_info& this_thread, long n);
+
+  // Return the thread's reserve to the outstanding work count, stopping the
+  // scheduler if no work remains. The lock must be held.
+  ASIO_DECL void release_work_reserve(
+      mutex::scoped_lock& lock, thread_info& this_thread);
+
   // Helper class to run the scheduler in its own thread.
   class thread_function;
   friend class thread_function;
@@ -180,10 +385,22 @@ private:
   struct task_cleanup;
   friend struct task_cleanup;
 
+  // Helper class to enqueue operations after running the task concurrently.
+  struct concurrent_task_cleanup;
+  friend struct concurrent_task_cleanup;
+
   // Helper class to call work-related operations on block exit.
   struct work_cleanup;
   friend struct work_cleanup;
 
+  // Helper class to release a per-thread work queue on block exit.
+  struct work_queue_cleanup;
+  friend struct work_queue_cleanup;
+
+  // Helper class to release a thread's reserve of work on block exit.
+  struct work_reserve_cleanup;
+  friend struct work_reserve_cleanup;
+
   // Whether to optimise for single-threaded use cases.
   const bool one_thread_;
 
@@ -208,6 +425,9 @@ private:
   // Whether the task has been interrupted.
   bool task_interrupted_;
 
+  // Whether idle threads run the task while another thread is running it.
+  bool concurrent_task_;
+
   // Flag to indicate that the dispatcher has been stopped.
   bool stopped_;
 
@@ -220,11 +440,113 @@ private:
   // The queue of handlers that are ready to be delivered.
   op_queue<operation> op_queue_;
 
+  // The number of priority levels. Priority lanes are enabled only if this is
+  // greater than 1.
+  const unsigned int priority_levels_;
+
+  // The queues of handlers for each priority above 0. Handlers with the
+  // default priority of 0 are delivered from op_queue_.
+  op_queue<operation>* priority_lanes_;
+
+  // The number of handlers waiting in the priority lanes.
+  std::size_t priority_lane_ops_;
+
+  // The lane whose turn it is, where 0 denotes op_queue_, and the number of
+  // handlers it may still deliver before the next lane's turn.
+  unsigned int current_lane_;
+  unsigned int lane_credit_;
+
   // The time limit on running the scheduler task, in microseconds.
   const long task_usec_;
 
   // The time limit on waiting when the queue is empty, in microseconds.
   const long wait_usec_;
+
+  // The maximum time to spin on the task before blocking, in microseconds.
+  const long busy_poll_usec_;
+
+  // The number of handlers, and the time in microseconds, that a thread may
+  // run inline after taking a handler from the queue, before further handlers
+  // must go through the queue. Zero means no limit.
+  const long inline_budget_;
+  const long inline_budget_usec_;
+
+  // The number of units of work that a thread in run() takes from, or gives
+  // back to, the outstanding work count at once. Batching is disabled if this
+  // is not positive.
+  const long work_count_batch_;
+
+  // The time, in microseconds, that an idle thread checks for handlers before
+  // it blocks.
+  long idle_spin_usec_;
+
+  // The function called to add a thread, its argument, and the time for which
+  // the queue must hold handlers before it is called.
+  grow_func_type grow_func_;
+  void* grow_arg_;
+  long grow_usec_;
+
+  // Whether the queue has held handlers since a thread last found it empty,
+  // and the time at which this began.
+  bool backlogged_;
+  chrono::steady_clock::time_point backlog_start_;
+
+#if defined(ASIO_HAS_HUGE_PAGES)
+  // The arena from which threads running the scheduler allocate handler
+  // memory, or null to use the system allocator.
+  huge_page_arena* const huge_page_arena_;
+#endif // defined(ASIO_HAS_HUGE_PAGES)
+
+  // The counters in which threads running the scheduler record the memory
+  // they allocate, or null if they are disabled.
+  memory_metrics* const memory_metrics_;
+
+  // Counters describing the activity of the scheduler and its task.
+  scheduler_metrics metrics_;
+
+  // The number of handlers in the shared queue, maintained only when metrics
+  // are enabled.
+  std::size_t queue_depth_;
+
+#if defined(ASIO_ENABLE_LATENCY_HISTOGRAMS)
+  // The latency histograms of the operations invoked by the scheduler.
+  latency_recorder latency_;
+#endif // defined(ASIO_ENABLE_LATENCY_HISTOGRAMS)
+
+  // Whether per-thread work queues with work stealing are enabled.
+  const bool work_stealing_;
+
+#if defined(ASIO_HAS_THREADS)
+  // The number of operations a thread takes from its own work queue before it
+  // checks the shared queue, to ensure the task and other handlers progress.
+  enum { work_queue_fairness_interval = 61 };
+
+  // An entry in the pool of per-thread work queues.
+  struct work_queue_entry
+  {
+    work_queue* queue_;
+    bool in_use_;
+  };
+
+  // The capacity of each per-thread work queue.
+  const std::size_t work_queue_capacity_;
+
+  // The maximum number of per-thread work queues.
+  const std::size_t max_work_queues_;
+
+  // The pool of per-thread work queues. Entries are never removed, so that
+  // other threads may safely steal from any entry below num_work_queues_.
+  work_queue_entry* work_queues_;
+
+  // The number of entries in the pool that have been allocated.
+  std::atomic<std::size_t> num_work_queues_;
+
+  // The number of threads that are waiting for work on the wakeup event.
+  std::atomic<long> idle_threads_;
+
+  // Mirrors stopped_ so that it may be checked without holding the lock.
+  std::atomic<bool> work_queue_stopped_;
+#endif // defined(ASIO_HAS_THREADS)
 };
 
 } // namespace detail
@@ -0,0 +1,211 @@
+//
+// detail/scheduler_metrics.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_SCHEDULER_METRICS_HPP
+#define ASIO_DETAIL_SCHEDULER_METRICS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Counters describing the activity of a scheduler and its task. All counters
+// are updated using relaxed atomic operations, and only when enabled, so that
+// a disabled instance costs a single well-predicted branch at each update.
+class scheduler_metrics
+  : private noncopyable
+{
+public:
+  // The activities that may be timed.
+  enum activity { handler_activity, task_activity };
+
+  // Constructor.
+  explicit scheduler_metrics(bool enabled)
+    : enabled_(enabled),
+      handlers_run_(0),
+      max_queue_depth_(0),
+      handler_nsec_(0),
+      task_nsec_(0),
+      task_runs_(0),
+      task_events_(0),
+      submit_calls_(0),
+      submitted_entries_(0),
+      pending_timers_(0)
+  {
+  }
+
+  // Whether the counters are updated.
+  bool enabled() const
+  {
+    return enabled_;
+  }
+
+  // Record the depth of the ready queue, updating the high-water mark.
+  void record_queue_depth(std::size_t depth)
+  {
+    if (enabled_)
+    {
+      uint64_t value = max_queue_depth_.load(std::memory_order_relaxed);
+      while (depth > value && !max_queue_depth_.compare_exchange_weak(
+            value, depth, std::memory_order_relaxed))
+      {
+      }
+    }
+  }
+
+  // Record one run of the task and the number of events it reaped.
+  void record_task_run(std::size_t events)
+  {
+    if (enabled_)
+    {
+      task_runs_.fetch_add(1, std::memory_order_relaxed);
+      task_events_.fetch_add(events, std::memory_order_relaxed);
+    }
+  }
+
+  // Record one submission to the kernel and the number of entries submitted.
+  void record_submit(std::size_t entries)
+  {
+    if (enabled_)
+    {
+      submit_calls_.fetch_add(1, std::memory_order_relaxed);
+      submitted_entries_.fetch_add(entries, std::memory_order_relaxed);
+    }
+  }
+
+  // Record the number of timers that are waiting to expire.
+  void record_pending_timers(std::size_t timers)
+  {
+    if (enabled_)
+      pending_timers_.store(timers, std::memory_order_relaxed);
+  }
+
+  // Times an activity, and counts it if it is a handler, from construction
+  // until destruction.
+  class scoped_timer
+    : private noncopyable
+  {
+  public:
+    scoped_timer(scheduler_metrics& metrics, activity a)
+      : metrics_(metrics.enabled_ ? &metrics : 0),
+        activity_(a)
+    {
+      if (metrics_)
+        start_ = chrono::steady_clock::now();
+    }
+
+    ~scoped_timer()
+    {
+      if (metrics_)
+      {
+        uint64_t nsec = chrono::duration_cast<chrono::nanoseconds>(
+            chrono::steady_clock::now() - start_).count();
+        if (activity_ == handler_activity)
+        {
+          metrics_->handlers_run_.fetch_add(1, std::memory_order_relaxed);
+          metrics_->handler_nsec_.fetch_add(nsec, std::memory_order_relaxed);
+        }
+        else
+        {
+          metrics_->task_nsec_.fetch_add(nsec, std::memory_order_relaxed);
+        }
+      }
+    }
+
+  private:
+    scheduler_metrics* metrics_;
+    activity activity_;
+    chrono::steady_clock::time_point start_;
+  };
+
+  // The number of handlers that have been run.
+  uint64_t handlers_run() const
+  {
+    return handlers_run_.load(std::memory_order_relaxed);
+  }
+
+  // The largest observed depth of the ready queue.
+  uint64_t max_queue_depth() const
+  {
+    return max_queue_depth_.load(std::memory_order_relaxed);
+  }
+
+  // The total time spent running handlers, in nanoseconds.
+  uint64_t handler_nsec() const
+  {
+    return handler_nsec_.load(std::memory_order_relaxed);
+  }
+
+  // The total time spent running the task, including waiting, in nanoseconds.
+  uint64_t task_nsec() const
+  {
+    return task_nsec_.load(std::memory_order_relaxed);
+  }
+
+  // The number of times the task has been run.
+  uint64_t task_runs() const
+  {
+    return task_runs_.load(std::memory_order_relaxed);
+  }
+
+  // The total number of events reaped by the task.
+  uint64_t task_events() const
+  {
+    return task_events_.load(std::memory_order_relaxed);
+  }
+
+  // The number of submissions to the kernel.
+  uint64_t submit_calls() const
+  {
+    return submit_calls_.load(std::memory_order_relaxed);
+  }
+
+  // The total number of entries submitted to the kernel.
+  uint64_t submitted_entries() const
+  {
+    return submitted_entries_.load(std::memory_order_relaxed);
+  }
+
+  // The number of timers that were waiting when last sampled.
+  uint64_t pending_timers() const
+  {
+    return pending_timers_.load(std::memory_order_relaxed);
+  }
+
+private:
+  const bool enabled_;
+  std::atomic<uint64_t> handlers_run_;
+  std::atomic<uint64_t> max_queue_depth_;
+  std::atomic<uint64_t> handler_nsec_;
+  std::atomic<uint64_t> task_nsec_;
+  std::atomic<uint64_t> task_runs_;
+  std::atomic<uint64_t> task_events_;
+  std::atomic<uint64_t> submit_calls_;
+  std::atomic<uint64_t> submitted_entries_;
+  std::atomic<uint64_t> pending_timers_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_SCHEDULER_METRICS_HPP
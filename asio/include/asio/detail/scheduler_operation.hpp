@@ -18,6 +18,7 @@
 #include "asio/error_code.hpp"
 #include "asio/detail/handler_tracking.hpp"
 #include "asio/detail/op_queue.hpp"
+#include "asio/detail/operation_latency.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -44,6 +45,33 @@ public:
     func_(0, this, asio::error_code(), 0);
   }
 
+  // Record the type of operation for the latency histograms, and that the
+  // operation has been initiated.
+  void set_latency_kind(latency_kind kind)
+  {
+#if defined(ASIO_ENABLE_LATENCY_HISTOGRAMS)
+    latency_.set_kind(kind);
+#else // defined(ASIO_ENABLE_LATENCY_HISTOGRAMS)
+    (void)kind;
+#endif // defined(ASIO_ENABLE_LATENCY_HISTOGRAMS)
+  }
+
+  // Record that the operation has completed and is ready to be invoked.
+  void set_latency_ready()
+  {
+#if defined(ASIO_ENABLE_LATENCY_HISTOGRAMS)
+    latency_.set_ready();
+#endif // defined(ASIO_ENABLE_LATENCY_HISTOGRAMS)
+  }
+
+#if defined(ASIO_ENABLE_LATENCY_HISTOGRAMS)
+  // Get the times at which the operation was initiated and became ready.
+  const latency_stamp& latency() const
+  {
+    return latency_;
+  }
+#endif // defined(ASIO_ENABLE_LATENCY_HISTOGRAMS)
+
 protected:
   typedef void (*func_type)(void*,
       scheduler_operation*,
@@ -65,6 +93,9 @@ private:
   friend class op_queue_access;
   scheduler_operation* next_;
   func_type func_;
+#if defined(ASIO_ENABLE_LATENCY_HISTOGRAMS)
+  latency_stamp latency_;
+#endif // defined(ASIO_ENABLE_LATENCY_HISTOGRAMS)
 protected:
   friend class scheduler;
   unsigned int task_result_; // Passed into bytes transferred.
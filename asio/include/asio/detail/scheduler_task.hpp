@@ -34,6 +34,19 @@ public:
   // Interrupt the task.
   virtual void interrupt() = 0;
 
+  // Whether other threads may call run_concurrently() while one thread is
+  // running the task.
+  virtual bool supports_concurrent_run() const
+  {
+    return false;
+  }
+
+  // Run the task once without blocking, from a thread other than the one that
+  // is running it.
+  virtual void run_concurrently(op_queue<scheduler_operation>&)
+  {
+  }
+
 protected:
   // Prevent deletion through this type.
   ~scheduler_task()
@@ -15,8 +15,10 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include "asio/detail/chrono.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/thread_info_base.hpp"
+#include "asio/detail/work_stealing_queue.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -25,11 +27,65 @@ namespace detail {
 
 class scheduler;
 class scheduler_operation;
+class scheduler_task;
 
 struct scheduler_thread_info : public thread_info_base
 {
+  scheduler_thread_info()
+    : default_task(0),
+      busy_poll_usec(0),
+      immediate_completion_depth(0),
+      inline_completions(0),
+      batch_work_count(false),
+      work_reserve(0),
+      idle(false),
+      idle_exit_usec(-1)
+#if defined(ASIO_HAS_THREADS)
+    , private_work_queue(0),
+    private_work_queue_index(0),
+    private_work_queue_tick(0)
+#endif // defined(ASIO_HAS_THREADS)
+  {
+  }
+
   op_queue<scheduler_operation> private_op_queue;
   long private_outstanding_work;
+
+  // The task of the scheduler running on the thread, if it is the default
+  // task for the scheduler's execution context.
+  scheduler_task* default_task;
+
+  // The current busy-poll budget, adapted to how often spinning finds work.
+  long busy_poll_usec;
+
+  // The number of nested immediate completions running on the thread.
+  int immediate_completion_depth;
+
+  // The number of handlers run inline, rather than through the queue, since
+  // the thread last took a handler from the queue, and the time at which it
+  // did so.
+  long inline_completions;
+  chrono::steady_clock::time_point inline_budget_start;
+
+  // Whether work started and finished on the thread is counted against the
+  // thread's reserve, which is the number of units of work included in the
+  // scheduler's outstanding work count on behalf of the thread but not yet
+  // used.
+  bool batch_work_count;
+  long work_reserve;
+
+  // Whether the thread has found no handlers since it last ran one, the time
+  // at which it became idle, and the time after which an idle thread leaves
+  // the scheduler, or a negative value if it does not.
+  bool idle;
+  chrono::steady_clock::time_point idle_start;
+  long idle_exit_usec;
+
+#if defined(ASIO_HAS_THREADS)
+  work_stealing_queue<scheduler_operation>* private_work_queue;
+  std::size_t private_work_queue_index;
+  unsigned int private_work_queue_tick;
+#endif // defined(ASIO_HAS_THREADS)
 };
 
 } // namespace detail
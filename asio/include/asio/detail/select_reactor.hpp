@@ -21,6 +21,7 @@
   || (!defined(ASIO_HAS_DEV_POLL) \
       && !defined(ASIO_HAS_EPOLL) \
       && !defined(ASIO_HAS_KQUEUE) \
+      && !defined(ASIO_HAS_POLL) \
       && !defined(ASIO_WINDOWS_RUNTIME))
 
 #include <cstddef>
@@ -204,6 +205,10 @@ private:
   // Helper function to remove a timer queue.
   ASIO_DECL void do_remove_timer_queue(timer_queue_base& queue);
 
+  // Sample the number of pending timers, if metrics are enabled. The lock must
+  // be held.
+  ASIO_DECL void record_pending_timers();
+
   // Get the timeout value for the select call.
   ASIO_DECL timeval* get_timeout(long usec, timeval& tv);
 
@@ -287,6 +292,7 @@ private:
        //   || (!defined(ASIO_HAS_DEV_POLL)
        //       && !defined(ASIO_HAS_EPOLL)
        //       && !defined(ASIO_HAS_KQUEUE)
+       //       && !defined(ASIO_HAS_POLL)
        //       && !defined(ASIO_WINDOWS_RUNTIME))
 
 #endif // ASIO_DETAIL_SELECT_REACTOR_HPP
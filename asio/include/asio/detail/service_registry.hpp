@@ -16,6 +16,8 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
 #include <typeinfo>
 #include "asio/detail/mutex.hpp"
 #include "asio/detail/noncopyable.hpp"
@@ -33,6 +35,10 @@ namespace detail {
 template <typename T>
 class typeid_wrapper {};
 
+#ifndef ASIO_SERVICE_REGISTRY_SLOTS
+# define ASIO_SERVICE_REGISTRY_SLOTS 64
+#endif // ASIO_SERVICE_REGISTRY_SLOTS
+
 class service_registry
   : private noncopyable
 {
@@ -103,6 +109,22 @@ private:
       const service_id<Service>& /*id*/);
 #endif // !defined(ASIO_NO_TYPEID)
 
+  // Get the lookup slot assigned to a service type. Slots are assigned in the
+  // order in which the service types are first used.
+  template <typename Service>
+  static std::size_t slot_index();
+
+  // Assign the next unused lookup slot.
+  ASIO_DECL static std::size_t next_slot_index();
+
+  // Find a service using the lock-free lookup table. Returns 0 if the slot is
+  // not populated, or if it holds a service with a different key.
+  execution_context::service* find_in_slot(
+      const execution_context::service::key& key, std::size_t slot) const;
+
+  // Record a service in the lookup table.
+  void set_slot(std::size_t slot, execution_context::service* service);
+
   // Check if a service matches the given id.
   ASIO_DECL static bool keys_match(
       const execution_context::service::key& key1,
@@ -137,22 +159,27 @@ private:
   // create a new service object automatically if no such object already
   // exists. Ownership of the service object is not transferred to the caller.
   ASIO_DECL execution_context::service* do_use_service(
-      const execution_context::service::key& key,
+      const execution_context::service::key& key, std::size_t slot,
       factory_type factory, void* owner);
 
   // Add a service object. Throws on error, in which case ownership of the
   // object is retained by the caller.
   ASIO_DECL void do_add_service(
-      const execution_context::service::key& key,
+      const execution_context::service::key& key, std::size_t slot,
       execution_context::service* new_service);
 
   // Check whether a service object with the specified key already exists.
   ASIO_DECL bool do_has_service(
       const execution_context::service::key& key) const;
 
-  // Mutex to protect access to internal data.
+  // Mutex to protect access to internal data. Services are only looked up
+  // under the mutex when they are not found in the lookup table.
   mutable asio::detail::mutex mutex_;
 
+  // Lookup table of services, indexed by the slot assigned to the service
+  // type. Entries are written under the mutex and read without it.
+  std::atomic<execution_context::service*> slots_[ASIO_SERVICE_REGISTRY_SLOTS];
+
   // The owner of this service registry and the services it contains.
   execution_context& owner_;
 
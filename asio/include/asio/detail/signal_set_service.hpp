@@ -26,6 +26,7 @@
 #include "asio/signal_set_base.hpp"
 #include "asio/detail/handler_alloc_helpers.hpp"
 #include "asio/detail/memory.hpp"
+#include "asio/detail/mutex.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/signal_handler.hpp"
 #include "asio/detail/signal_op.hpp"
@@ -199,7 +200,18 @@ public:
   // Deliver notification that a particular signal occurred.
   ASIO_DECL static void deliver_signal(int signal_number);
 
+  // Deliver notification that several signals occurred.
+  ASIO_DECL static void deliver_signals(
+      const int* signal_numbers, std::size_t count);
+
 private:
+  // Helper class used to lock the state used for signal delivery.
+  class state_lock;
+
+  // Helper function to complete waiting operations for a signal, or record it
+  // as undelivered. The state must be locked.
+  ASIO_DECL void collect_signal(int signal_number, op_queue<operation>& ops);
+
   // Helper function to add a service to the global signal state.
   ASIO_DECL static void add_service(signal_set_service* service);
 
@@ -268,6 +280,35 @@ private:
   // The per-descriptor reactor data used for the pipe.
   reactor::per_descriptor_data reactor_data_;
 # endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
+# if defined(ASIO_HAS_SIGNALFD)
+  // The type used for processing signalfd readiness notifications.
+  class signalfd_read_op;
+
+  // Helper function to add or remove a signal from the signalfd's mask.
+  ASIO_DECL asio::error_code update_signal_fd(int signal_number,
+      bool add, asio::error_code& ec);
+
+  // Helper function to register the signalfd for readiness notifications.
+  ASIO_DECL void register_signal_fd();
+
+  // Helper function to deregister the signalfd.
+  ASIO_DECL void deregister_signal_fd();
+
+  // Whether signals are received using a signalfd owned by this service,
+  // rather than using a signal handler shared by all services.
+  bool use_signalfd_;
+
+  // The signalfd, or -1 if not used.
+  int signal_fd_;
+
+  // The signals that are received using the signalfd.
+  sigset_t signal_fd_mask_;
+
+  // Mutex protecting the state used for signal delivery when the signalfd is
+  // used.
+  mutex mutex_;
+# endif // defined(ASIO_HAS_SIGNALFD)
 #endif // !defined(ASIO_WINDOWS)
        //   && !defined(ASIO_WINDOWS_RUNTIME)
        //   && !defined(__CYGWIN__)
@@ -0,0 +1,210 @@
+//
+// detail/socket_op_slots.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_SOCKET_OP_SLOTS_HPP
+#define ASIO_DETAIL_SOCKET_OP_SLOTS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include "asio/associated_allocator.hpp"
+#include "asio/detail/atomic_count.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Memory reserved by a socket for its asynchronous operations, with one slot
+// for a read operation and one for a write operation. Most sockets have no
+// more than one operation outstanding in each direction, so an operation's
+// memory is returned to its slot on completion and is then reused by the next
+// operation in the same direction, whatever the handler type.
+//
+// The object is reference counted. The socket holds one reference, and each
+// block of memory handed out holds another, so that operations that complete
+// after the socket is closed may still return their memory.
+class socket_op_slots
+  : private noncopyable
+{
+public:
+  // The slot used by an operation.
+  enum slot_type { read_slot = 0, write_slot = 1 };
+
+  // The space reserved before the memory given to an operation, which also
+  // determines the alignment of that memory.
+  static constexpr std::size_t header_size = ASIO_DEFAULT_ALIGN;
+
+  // Determine whether the slots may be used for an operation with the given
+  // alignment, whose handler has the given associated allocator. Handlers
+  // with their own allocators continue to use them.
+  template <typename Allocator>
+  static constexpr bool usable_with(std::size_t align)
+  {
+    return is_same<Allocator, std::allocator<void>>::value
+      && align <= header_size;
+  }
+
+  // Create a new object, holding the caller's reference.
+  socket_op_slots()
+    : ref_count_(1)
+  {
+    blocks_[read_slot] = 0;
+    blocks_[write_slot] = 0;
+  }
+
+  // Release the caller's reference.
+  void release() noexcept
+  {
+    if (ref_count_down(ref_count_))
+      delete this;
+  }
+
+  // Obtain memory for an operation, reusing the memory held in the slot if it
+  // is large enough. The memory holds a reference to the object until it is
+  // deallocated.
+  void* allocate(slot_type slot, std::size_t size)
+  {
+    void* block = blocks_[slot].exchange(0, std::memory_order_acquire);
+    if (block && static_cast<header*>(block)->size < size)
+    {
+      aligned_delete(block);
+      block = 0;
+    }
+
+    if (!block)
+    {
+      block = aligned_new(header_size, header_size + size);
+      static_cast<header*>(block)->size = size;
+    }
+
+    ref_count_up(ref_count_);
+    return static_cast<unsigned char*>(block) + header_size;
+  }
+
+  // Return memory to its slot, and release the reference that it holds. If
+  // the slot is already occupied the memory is freed.
+  void deallocate(slot_type slot, void* p) noexcept
+  {
+    void* block = static_cast<unsigned char*>(p) - header_size;
+    block = blocks_[slot].exchange(block, std::memory_order_acq_rel);
+    if (block)
+      aligned_delete(block);
+    release();
+  }
+
+private:
+  // Only release() may delete the object.
+  ~socket_op_slots()
+  {
+    if (void* block = blocks_[read_slot].load(std::memory_order_relaxed))
+      aligned_delete(block);
+    if (void* block = blocks_[write_slot].load(std::memory_order_relaxed))
+      aligned_delete(block);
+  }
+
+  // The header that precedes the memory given to an operation.
+  struct header
+  {
+    std::size_t size;
+  };
+
+  atomic_count ref_count_;
+  std::atomic<void*> blocks_[2];
+};
+
+} // namespace detail
+} // namespace asio
+
+// Defines a handler_ptr type for an operation whose memory may be obtained
+// from a socket's op slots. The operation must have a slots_ member that
+// records where its memory came from.
+#define ASIO_DEFINE_SLOTTED_HANDLER_PTR(slot, op) \
+  struct ptr \
+  { \
+    Handler* h; \
+    op* v; \
+    op* p; \
+    ::asio::detail::socket_op_slots* s; \
+    ~ptr() \
+    { \
+      reset(); \
+    } \
+    static ::asio::detail::socket_op_slots* slots_for( \
+        ::asio::detail::socket_op_slots* s) \
+    { \
+      return ::asio::detail::socket_op_slots::usable_with< \
+        typename ::asio::associated_allocator<Handler>::type>( \
+          alignof(op)) ? s : 0; \
+    } \
+    static op* allocate(Handler& handler, \
+        ::asio::detail::socket_op_slots* s) \
+    { \
+      if (s) \
+        return static_cast<op*>(s->allocate(slot, sizeof(op))); \
+      typedef typename ::asio::associated_allocator< \
+        Handler>::type associated_allocator_type; \
+      typedef typename ::asio::detail::get_recycling_allocator< \
+        associated_allocator_type, \
+        ::asio::detail::thread_info_base::default_tag>::type \
+          default_allocator_type; \
+      ASIO_REBIND_ALLOC(default_allocator_type, op) a( \
+            ::asio::detail::get_recycling_allocator< \
+              associated_allocator_type, \
+              ::asio::detail::thread_info_base::default_tag>::get( \
+                ::asio::get_associated_allocator(handler))); \
+      return a.allocate(1); \
+    } \
+    void reset() \
+    { \
+      if (p) \
+      { \
+        p->~op(); \
+        p = 0; \
+      } \
+      if (v) \
+      { \
+        if (s) \
+        { \
+          s->deallocate(slot, v); \
+        } \
+        else \
+        { \
+          typedef typename ::asio::associated_allocator< \
+            Handler>::type associated_allocator_type; \
+          typedef typename ::asio::detail::get_recycling_allocator< \
+            associated_allocator_type, \
+            ::asio::detail::thread_info_base::default_tag>::type \
+              default_allocator_type; \
+          ASIO_REBIND_ALLOC(default_allocator_type, op) a( \
+                ::asio::detail::get_recycling_allocator< \
+                  associated_allocator_type, \
+                  ::asio::detail::thread_info_base::default_tag>::get( \
+                    ::asio::get_associated_allocator(*h))); \
+          a.deallocate(static_cast<op*>(v), 1); \
+        } \
+        v = 0; \
+      } \
+    } \
+  } \
+  /**/
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_SOCKET_OP_SLOTS_HPP
@@ -21,9 +21,20 @@
 #include "asio/detail/memory.hpp"
 #include "asio/detail/socket_types.hpp"
 
+#if defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+# include "asio/socket_timestamp.hpp"
+#endif // defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+
+#if defined(ASIO_HAS_FD_PASSING)
+# include "asio/local/passed_fds.hpp"
+#endif // defined(ASIO_HAS_FD_PASSING)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
+
+struct transport_info;
+
 namespace detail {
 namespace socket_ops {
 
@@ -52,10 +63,31 @@ enum
   datagram_oriented = 32,
 
   // The socket may have been dup()-ed.
-  possible_dup = 64
+  possible_dup = 64,
+
+  // User wants accept operations to use a multishot submission, if supported.
+  multishot_accept = 128,
+
+  // User wants large sends to avoid copying data, if supported.
+  zero_copy = 256,
+
+  // User wants speculative receives to invoke their handlers inline.
+  inline_completion = 512,
+
+  // User wants queued sends to be coalesced into a single system call.
+  write_coalescing = 1024,
+
+  // User wants operations to reuse memory reserved by the socket.
+  operation_slots = 2048,
+
+  // The socket has not yet been registered with the reactor.
+  reactor_deferred = 4096,
+
+  // SO_ZEROCOPY has been enabled, so large sends may use MSG_ZEROCOPY.
+  internal_zero_copy = 8192
 };
 
-typedef unsigned char state_type;
+typedef unsigned short state_type;
 
 struct noop_deleter { void operator()(void*) {} };
 typedef shared_ptr<void> shared_cancel_token_type;
@@ -279,6 +311,192 @@ ASIO_DECL bool non_blocking_sendto1(socket_type s, const void* data,
 
 #endif // !defined(ASIO_HAS_IOCP)
 
+#if defined(ASIO_HAS_DATAGRAM_BATCH)
+
+ASIO_DECL signed_size_type recvmmsg(socket_type s, mmsghdr_type* msgs,
+    size_t count, int flags, asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_recvmmsg(socket_type s, mmsghdr_type* msgs,
+    size_t count, int flags, asio::error_code& ec, size_t& messages);
+
+ASIO_DECL signed_size_type sendmmsg(socket_type s, mmsghdr_type* msgs,
+    size_t count, int flags, asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_sendmmsg(socket_type s, mmsghdr_type* msgs,
+    size_t count, int flags, asio::error_code& ec, size_t& messages);
+
+#endif // defined(ASIO_HAS_DATAGRAM_BATCH)
+
+#if defined(ASIO_HAS_UDP_OFFLOAD)
+
+// Storage for a control message that carries a UDP segment size. The size_t
+// member gives the buffer the alignment required for a cmsghdr.
+union segment_control_type
+{
+  std::size_t align;
+  char data[CMSG_SPACE(sizeof(int))];
+};
+
+ASIO_DECL void init_send_segment_control(msghdr& msg,
+    segment_control_type& control, std::size_t segment_size);
+
+ASIO_DECL void init_recv_segment_control(msghdr& msg,
+    segment_control_type& control);
+
+ASIO_DECL std::size_t get_recv_segment_size(
+    const msghdr& msg, std::size_t bytes_transferred);
+
+ASIO_DECL signed_size_type send_segments(socket_type s,
+    const buf* bufs, size_t count, int flags, const void* addr,
+    std::size_t addrlen, std::size_t segment_size, asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_send_segments(socket_type s,
+    const buf* bufs, size_t count, int flags, const void* addr,
+    std::size_t addrlen, std::size_t segment_size,
+    asio::error_code& ec, size_t& bytes_transferred);
+
+ASIO_DECL signed_size_type recv_coalesced(socket_type s,
+    buf* bufs, size_t count, int flags, void* addr, std::size_t* addrlen,
+    std::size_t& segment_size, asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_recv_coalesced(socket_type s,
+    buf* bufs, size_t count, int flags, void* addr, std::size_t* addrlen,
+    std::size_t& segment_size, asio::error_code& ec,
+    size_t& bytes_transferred);
+
+#endif // defined(ASIO_HAS_UDP_OFFLOAD)
+
+#if defined(ASIO_HAS_PACKET_INFO)
+
+// The local address, interface and traffic class of a single datagram.
+struct packet_info_type
+{
+  // The family of the address, or AF_UNSPEC if there is no address.
+  int family;
+  unsigned char address[16];
+  unsigned int interface_index;
+
+  // The traffic class, or -1 if there is none.
+  int traffic_class;
+};
+
+// Storage for the control messages that carry packet information. The size_t
+// member gives the buffer the alignment required for a cmsghdr.
+union packet_info_control_type
+{
+  std::size_t align;
+  char data[CMSG_SPACE(sizeof(in6_pktinfo)) + CMSG_SPACE(sizeof(int))];
+};
+
+ASIO_DECL void init_send_packet_info_control(msghdr& msg,
+    packet_info_control_type& control, int family,
+    const packet_info_type& info);
+
+ASIO_DECL void init_recv_packet_info_control(msghdr& msg,
+    packet_info_control_type& control);
+
+ASIO_DECL void get_recv_packet_info(const msghdr& msg, packet_info_type& info);
+
+#endif // defined(ASIO_HAS_PACKET_INFO)
+
+#if defined(ASIO_HAS_SOCKET_TIMESTAMPING) || defined(ASIO_HAS_MSG_ZEROCOPY)
+
+// The layout of struct sock_extended_err from linux/errqueue.h.
+struct extended_error_type
+{
+  uint32_t ee_errno;
+  uint8_t ee_origin;
+  uint8_t ee_type;
+  uint8_t ee_code;
+  uint8_t ee_pad;
+  uint32_t ee_info;
+  uint32_t ee_data;
+};
+
+#endif // defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+       //   || defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#if defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+
+// Storage for the control messages that carry a timestamp and, for the error
+// queue, the extended error that describes it. The size_t member gives the
+// buffer the alignment required for a cmsghdr.
+union timestamp_control_type
+{
+  std::size_t align;
+  char data[CMSG_SPACE(3 * sizeof(timespec))
+    + CMSG_SPACE(sizeof(extended_error_type) + sizeof(sockaddr_in6_type))];
+};
+
+ASIO_DECL void init_recv_timestamp_control(msghdr& msg,
+    timestamp_control_type& control);
+
+ASIO_DECL bool get_recv_timestamp(const msghdr& msg, socket_timestamp& ts);
+
+ASIO_DECL signed_size_type recv_timestamped(socket_type s,
+    buf* bufs, size_t count, int flags, void* addr, std::size_t* addrlen,
+    socket_timestamp& ts, asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_recv_timestamped(socket_type s,
+    buf* bufs, size_t count, int flags, void* addr, std::size_t* addrlen,
+    socket_timestamp& ts, asio::error_code& ec, size_t& bytes_transferred);
+
+ASIO_DECL signed_size_type recv_tx_timestamp(socket_type s,
+    socket_timestamp& ts, asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_recv_tx_timestamp(socket_type s,
+    socket_timestamp& ts, asio::error_code& ec);
+
+#endif // defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+
+ASIO_DECL bool non_blocking_recv_zero_copy_notifications(socket_type s,
+    std::size_t& pending, asio::error_code& ec);
+
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#if defined(ASIO_HAS_FD_PASSING)
+
+// Storage for the control messages that carry passed file descriptors and,
+// where supported, the sender's credentials. The size_t member gives the
+// buffer the alignment required for a cmsghdr.
+union fds_control_type
+{
+  std::size_t align;
+  char data[CMSG_SPACE(sizeof(int) * local::passed_fds::max_fds)
+#if defined(SCM_CREDENTIALS)
+    + CMSG_SPACE(sizeof(ucred))
+#endif // defined(SCM_CREDENTIALS)
+    ];
+};
+
+ASIO_DECL void init_send_fds_control(msghdr& msg,
+    fds_control_type& control, const local::passed_fds& fds);
+
+ASIO_DECL void init_recv_fds_control(msghdr& msg,
+    fds_control_type& control);
+
+ASIO_DECL void get_recv_fds(const msghdr& msg, local::passed_fds& fds);
+
+ASIO_DECL signed_size_type send_fds(socket_type s, const buf* bufs,
+    size_t count, int flags, const local::passed_fds& fds,
+    asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_send_fds(socket_type s, const buf* bufs,
+    size_t count, int flags, const local::passed_fds& fds,
+    asio::error_code& ec, size_t& bytes_transferred);
+
+ASIO_DECL signed_size_type recv_fds(socket_type s, buf* bufs,
+    size_t count, int flags, local::passed_fds& fds,
+    asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_recv_fds(socket_type s, buf* bufs,
+    size_t count, int flags, local::passed_fds& fds,
+    asio::error_code& ec, size_t& bytes_transferred);
+
+#endif // defined(ASIO_HAS_FD_PASSING)
+
 ASIO_DECL socket_type socket(int af, int type, int protocol,
     asio::error_code& ec);
 
@@ -290,6 +508,9 @@ ASIO_DECL int getsockopt(socket_type s, state_type state,
     int level, int optname, void* optval,
     size_t* optlen, asio::error_code& ec);
 
+ASIO_DECL int get_transport_info(socket_type s,
+    transport_info& info, asio::error_code& ec);
+
 ASIO_DECL int getpeername(socket_type s, void* addr,
     std::size_t* addrlen, bool cached, asio::error_code& ec);
 
@@ -308,6 +529,9 @@ ASIO_DECL int poll_read(socket_type s,
 ASIO_DECL int poll_write(socket_type s,
     state_type state, int msec, asio::error_code& ec);
 
+ASIO_DECL int poll_peer_closed(socket_type s,
+    state_type state, int msec, asio::error_code& ec);
+
 ASIO_DECL int poll_error(socket_type s,
     state_type state, int msec, asio::error_code& ec);
 
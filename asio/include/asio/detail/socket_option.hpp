@@ -307,6 +307,67 @@ private:
   detail::linger_type value_;
 };
 
+// Helper template for implementing options whose value is a structure that
+// may only be obtained.
+template <int Level, int Name, typename T>
+class structure
+{
+public:
+  // Default constructor.
+  structure()
+    : value_()
+  {
+  }
+
+  // Get the current value of the structure option.
+  const T& value() const
+  {
+    return value_;
+  }
+
+  // Get the level of the socket option.
+  template <typename Protocol>
+  int level(const Protocol&) const
+  {
+    return Level;
+  }
+
+  // Get the name of the socket option.
+  template <typename Protocol>
+  int name(const Protocol&) const
+  {
+    return Name;
+  }
+
+  // Get the address of the structure data.
+  template <typename Protocol>
+  T* data(const Protocol&)
+  {
+    return &value_;
+  }
+
+  // Get the size of the structure data.
+  template <typename Protocol>
+  std::size_t size(const Protocol&) const
+  {
+    return sizeof(value_);
+  }
+
+  // Set the size of the structure data.
+  template <typename Protocol>
+  void resize(const Protocol&, std::size_t s)
+  {
+    if (s != sizeof(value_))
+    {
+      std::length_error ex("structure socket option resize");
+      asio::detail::throw_exception(ex);
+    }
+  }
+
+private:
+  T value_;
+};
+
 } // namespace socket_option
 } // namespace detail
 } // namespace asio
@@ -0,0 +1,146 @@
+//
+// detail/socket_read_ahead.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_SOCKET_READ_AHEAD_HPP
+#define ASIO_DETAIL_SOCKET_READ_AHEAD_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <cstring>
+#include "asio/buffer.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/socket_types.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Holds data that was received on a stream socket ahead of the reads that
+// will consume it. A receive places the free space after the caller's own
+// buffers, so that a single system call satisfies the read and fills the
+// read-ahead buffer with whatever else the socket has available.
+class socket_read_ahead
+  : buffer_sequence_adapter_base,
+    private noncopyable
+{
+public:
+  // The maximum number of native buffers used by a receive.
+  enum { max_buffers = buffer_sequence_adapter_base::max_buffers + 1 };
+
+  // Construct a buffer with the given capacity.
+  explicit socket_read_ahead(std::size_t capacity)
+    : data_(new unsigned char[capacity]),
+      capacity_(capacity),
+      begin_(0),
+      end_(0)
+  {
+  }
+
+  // Destructor.
+  ~socket_read_ahead()
+  {
+    delete[] data_;
+  }
+
+  // Get the capacity of the buffer.
+  std::size_t capacity() const
+  {
+    return capacity_;
+  }
+
+  // Get the number of bytes held in the buffer.
+  std::size_t size() const
+  {
+    return end_ - begin_;
+  }
+
+  // Determine whether the buffer holds any data.
+  bool empty() const
+  {
+    return begin_ == end_;
+  }
+
+  // Take over the data held by another buffer, which must fit.
+  void assign(socket_read_ahead& other)
+  {
+    std::size_t n = other.size();
+    if (n > 0)
+      std::memcpy(data_, other.data_ + other.begin_, n);
+    begin_ = 0;
+    end_ = n;
+    other.begin_ = other.end_ = 0;
+  }
+
+  // Copy buffered data to the caller's buffers, consuming it.
+  template <typename MutableBufferSequence>
+  std::size_t read(const MutableBufferSequence& buffers)
+  {
+    std::size_t n = asio::buffer_copy(buffers,
+        asio::const_buffer(data_ + begin_, end_ - begin_));
+    begin_ += n;
+    if (begin_ == end_)
+      begin_ = end_ = 0;
+    return n;
+  }
+
+  // Copy buffered data to a registered buffer, consuming it.
+  std::size_t read(const mutable_registered_buffer& buffer)
+  {
+    return read(buffer.buffer());
+  }
+
+  // Prepare the native buffers for a receive, placing the buffer's storage
+  // after the caller's buffers. Must only be called when the buffer is empty.
+  // Returns the number of native buffers.
+  template <typename MutableBufferSequence>
+  std::size_t prepare(const MutableBufferSequence& buffers,
+      native_buffer_type* native_buffers, std::size_t& buffers_size)
+  {
+    buffer_sequence_adapter<asio::mutable_buffer,
+        MutableBufferSequence> bufs(buffers);
+    std::size_t count = bufs.count();
+    for (std::size_t i = 0; i < count; ++i)
+      native_buffers[i] = bufs.buffers()[i];
+    init_native_buffer(native_buffers[count],
+        asio::mutable_buffer(data_, capacity_));
+    buffers_size = bufs.total_size();
+    return count + 1;
+  }
+
+  // Record the result of a receive. Returns the number of bytes that were
+  // placed in the caller's buffers.
+  std::size_t commit(std::size_t bytes_transferred, std::size_t buffers_size)
+  {
+    if (bytes_transferred <= buffers_size)
+      return bytes_transferred;
+    begin_ = 0;
+    end_ = bytes_transferred - buffers_size;
+    return buffers_size;
+  }
+
+private:
+  unsigned char* data_;
+  std::size_t capacity_;
+  std::size_t begin_;
+  std::size_t end_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_SOCKET_READ_AHEAD_HPP
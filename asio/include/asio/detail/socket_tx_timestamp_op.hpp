@@ -0,0 +1,161 @@
+//
+// detail/socket_tx_timestamp_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_SOCKET_TX_TIMESTAMP_OP_HPP
+#define ASIO_DETAIL_SOCKET_TX_TIMESTAMP_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+
+#include "asio/associator.hpp"
+#include "asio/immediate.hpp"
+#include "asio/socket_base.hpp"
+#include "asio/socket_timestamp.hpp"
+#include "asio/detail/base_from_cancellation_state.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/handler_tracking.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Reads a transmit timestamp from a socket's error queue, waiting for the
+// socket to report an error condition whenever the queue is empty.
+template <typename Socket, typename Handler>
+class socket_tx_timestamp_op
+  : public base_from_cancellation_state<Handler>
+{
+public:
+  socket_tx_timestamp_op(Socket& s, socket_timestamp* timestamp,
+      Handler& handler)
+    : base_from_cancellation_state<Handler>(handler),
+      socket_(s),
+      timestamp_(timestamp),
+      start_(0),
+      complete_(false),
+      handler_(static_cast<Handler&&>(handler))
+  {
+  }
+
+  socket_tx_timestamp_op(socket_tx_timestamp_op&& other)
+    : base_from_cancellation_state<Handler>(
+        static_cast<base_from_cancellation_state<Handler>&&>(other)),
+      socket_(other.socket_),
+      timestamp_(other.timestamp_),
+      start_(other.start_),
+      complete_(other.complete_),
+      handler_(static_cast<Handler&&>(other.handler_))
+  {
+  }
+
+  // Start the operation.
+  void start()
+  {
+    start_ = 1;
+    (*this)(asio::error_code());
+  }
+
+  // Resume the operation after waiting for the error queue to be readable.
+  void operator()(asio::error_code ec)
+  {
+    if (!complete_)
+    {
+      if (!ec && start_ == 0 && this->cancelled() != cancellation_type::none)
+        ec = error::operation_aborted;
+
+      if (!ec && !socket_.is_open())
+        ec = error::bad_descriptor;
+
+      if (!ec && !socket_ops::non_blocking_recv_tx_timestamp(
+            socket_.native_handle(), *timestamp_, ec))
+      {
+        ASIO_HANDLER_LOCATION((__FILE__, __LINE__,
+              "async_receive_tx_timestamp"));
+        start_ = 0;
+        socket_.async_wait(socket_base::wait_error,
+            static_cast<socket_tx_timestamp_op&&>(*this));
+        return;
+      }
+
+      if (start_)
+      {
+        ASIO_HANDLER_LOCATION((__FILE__, __LINE__,
+              "async_receive_tx_timestamp"));
+        start_ = 0;
+        complete_ = true;
+        asio::async_immediate(socket_.get_executor(),
+            asio::detail::bind_handler(
+              static_cast<socket_tx_timestamp_op&&>(*this), ec));
+        return;
+      }
+    }
+
+    static_cast<Handler&&>(handler_)(
+        static_cast<const asio::error_code&>(ec));
+  }
+
+//private:
+  Socket& socket_;
+  socket_timestamp* timestamp_;
+  int start_;
+  bool complete_;
+  Handler handler_;
+};
+
+template <typename Socket, typename Handler>
+inline bool asio_handler_is_continuation(
+    socket_tx_timestamp_op<Socket, Handler>* this_handler)
+{
+  return this_handler->start_ == 0 ? true
+    : asio_handler_cont_helpers::is_continuation(this_handler->handler_);
+}
+
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <template <typename, typename> class Associator,
+    typename Socket, typename Handler, typename DefaultCandidate>
+struct associator<Associator,
+    detail::socket_tx_timestamp_op<Socket, Handler>,
+    DefaultCandidate>
+  : Associator<Handler, DefaultCandidate>
+{
+  static typename Associator<Handler, DefaultCandidate>::type get(
+      const detail::socket_tx_timestamp_op<Socket, Handler>& h) noexcept
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static auto get(const detail::socket_tx_timestamp_op<Socket, Handler>& h,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<Handler, DefaultCandidate>::get(h.handler_, c))
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+
+#endif // ASIO_DETAIL_SOCKET_TX_TIMESTAMP_OP_HPP
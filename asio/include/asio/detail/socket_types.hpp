@@ -330,6 +330,15 @@ typedef ssize_t signed_size_type;
 #else // defined(ASIO_HAS_SSIZE_T)
 typedef int signed_size_type;
 #endif // defined(ASIO_HAS_SSIZE_T)
+#if defined(ASIO_HAS_MMSG)
+typedef mmsghdr mmsghdr_type;
+#else // defined(ASIO_HAS_MMSG)
+struct mmsghdr_type
+{
+  msghdr msg_hdr;
+  unsigned int msg_len;
+};
+#endif // defined(ASIO_HAS_MMSG)
 # define ASIO_OS_DEF(c) ASIO_OS_DEF_##c
 # define ASIO_OS_DEF_AF_UNSPEC AF_UNSPEC
 # define ASIO_OS_DEF_AF_INET AF_INET
@@ -367,7 +376,127 @@ typedef int signed_size_type;
 # define ASIO_OS_DEF_SO_SNDLOWAT SO_SNDLOWAT
 # define ASIO_OS_DEF_SO_RCVLOWAT SO_RCVLOWAT
 # define ASIO_OS_DEF_SO_REUSEADDR SO_REUSEADDR
+# if defined(ASIO_HAS_SO_REUSEPORT)
+#  define ASIO_OS_DEF_SO_REUSEPORT SO_REUSEPORT
+# endif // defined(ASIO_HAS_SO_REUSEPORT)
+# if defined(ASIO_HAS_SO_BUSY_POLL)
+// Values from asm-generic/socket.h, which older C libraries do not provide.
+#  if defined(SO_BUSY_POLL)
+#   define ASIO_OS_DEF_SO_BUSY_POLL SO_BUSY_POLL
+#  else // defined(SO_BUSY_POLL)
+#   define ASIO_OS_DEF_SO_BUSY_POLL 46
+#  endif // defined(SO_BUSY_POLL)
+#  if defined(SO_PREFER_BUSY_POLL)
+#   define ASIO_OS_DEF_SO_PREFER_BUSY_POLL SO_PREFER_BUSY_POLL
+#  else // defined(SO_PREFER_BUSY_POLL)
+#   define ASIO_OS_DEF_SO_PREFER_BUSY_POLL 69
+#  endif // defined(SO_PREFER_BUSY_POLL)
+#  if defined(SO_BUSY_POLL_BUDGET)
+#   define ASIO_OS_DEF_SO_BUSY_POLL_BUDGET SO_BUSY_POLL_BUDGET
+#  else // defined(SO_BUSY_POLL_BUDGET)
+#   define ASIO_OS_DEF_SO_BUSY_POLL_BUDGET 70
+#  endif // defined(SO_BUSY_POLL_BUDGET)
+# endif // defined(ASIO_HAS_SO_BUSY_POLL)
+# if defined(ASIO_HAS_SO_MAX_PACING_RATE)
+// Value from asm-generic/socket.h, which older C libraries do not provide.
+#  if defined(SO_MAX_PACING_RATE)
+#   define ASIO_OS_DEF_SO_MAX_PACING_RATE SO_MAX_PACING_RATE
+#  else // defined(SO_MAX_PACING_RATE)
+#   define ASIO_OS_DEF_SO_MAX_PACING_RATE 47
+#  endif // defined(SO_MAX_PACING_RATE)
+# endif // defined(ASIO_HAS_SO_MAX_PACING_RATE)
+# if defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+// Values from asm-generic/socket.h, linux/net_tstamp.h and linux/errqueue.h,
+// which older C libraries do not provide.
+#  if defined(SO_TIMESTAMPING)
+#   define ASIO_OS_DEF_SO_TIMESTAMPING SO_TIMESTAMPING
+#  else // defined(SO_TIMESTAMPING)
+#   define ASIO_OS_DEF_SO_TIMESTAMPING 37
+#  endif // defined(SO_TIMESTAMPING)
+#  define ASIO_OS_DEF_SOF_TIMESTAMPING_TX_HARDWARE 0x1
+#  define ASIO_OS_DEF_SOF_TIMESTAMPING_TX_SOFTWARE 0x2
+#  define ASIO_OS_DEF_SOF_TIMESTAMPING_RX_HARDWARE 0x4
+#  define ASIO_OS_DEF_SOF_TIMESTAMPING_RX_SOFTWARE 0x8
+#  define ASIO_OS_DEF_SOF_TIMESTAMPING_SOFTWARE 0x10
+#  define ASIO_OS_DEF_SOF_TIMESTAMPING_RAW_HARDWARE 0x40
+#  define ASIO_OS_DEF_SOF_TIMESTAMPING_OPT_ID 0x80
+#  define ASIO_OS_DEF_SOF_TIMESTAMPING_TX_SCHED 0x100
+#  define ASIO_OS_DEF_SOF_TIMESTAMPING_TX_ACK 0x200
+#  define ASIO_OS_DEF_SOF_TIMESTAMPING_OPT_TSONLY 0x800
+#  define ASIO_OS_DEF_SO_EE_ORIGIN_TIMESTAMPING 4
+#  define ASIO_OS_DEF_SCM_TSTAMP_SND 0
+#  define ASIO_OS_DEF_SCM_TSTAMP_SCHED 1
+#  define ASIO_OS_DEF_SCM_TSTAMP_ACK 2
+# endif // defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+# if defined(ASIO_HAS_MSG_ZEROCOPY)
+// Values from asm-generic/socket.h, linux/socket.h and linux/errqueue.h,
+// which older C libraries do not provide.
+#  if defined(SO_ZEROCOPY)
+#   define ASIO_OS_DEF_SO_ZEROCOPY SO_ZEROCOPY
+#  else // defined(SO_ZEROCOPY)
+#   define ASIO_OS_DEF_SO_ZEROCOPY 60
+#  endif // defined(SO_ZEROCOPY)
+#  if defined(MSG_ZEROCOPY)
+#   define ASIO_OS_DEF_MSG_ZEROCOPY MSG_ZEROCOPY
+#  else // defined(MSG_ZEROCOPY)
+#   define ASIO_OS_DEF_MSG_ZEROCOPY 0x4000000
+#  endif // defined(MSG_ZEROCOPY)
+#  define ASIO_OS_DEF_SO_EE_ORIGIN_ZEROCOPY 5
+# endif // defined(ASIO_HAS_MSG_ZEROCOPY)
 # define ASIO_OS_DEF_TCP_NODELAY TCP_NODELAY
+# if defined(ASIO_HAS_TCP_FASTOPEN)
+// Values from linux/tcp.h and linux/socket.h, which older C libraries do not
+// provide.
+#  if defined(TCP_FASTOPEN)
+#   define ASIO_OS_DEF_TCP_FASTOPEN TCP_FASTOPEN
+#  else // defined(TCP_FASTOPEN)
+#   define ASIO_OS_DEF_TCP_FASTOPEN 23
+#  endif // defined(TCP_FASTOPEN)
+#  if defined(MSG_FASTOPEN)
+#   define ASIO_OS_DEF_MSG_FASTOPEN MSG_FASTOPEN
+#  else // defined(MSG_FASTOPEN)
+#   define ASIO_OS_DEF_MSG_FASTOPEN 0x20000000
+#  endif // defined(MSG_FASTOPEN)
+# endif // defined(ASIO_HAS_TCP_FASTOPEN)
+# if defined(ASIO_HAS_TCP_DEFER_ACCEPT)
+#  define ASIO_OS_DEF_TCP_DEFER_ACCEPT TCP_DEFER_ACCEPT
+# endif // defined(ASIO_HAS_TCP_DEFER_ACCEPT)
+# if defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
+// Values from linux/tcp.h and linux/sockios.h, which older C libraries do not
+// provide.
+#  if defined(TCP_NOTSENT_LOWAT)
+#   define ASIO_OS_DEF_TCP_NOTSENT_LOWAT TCP_NOTSENT_LOWAT
+#  else // defined(TCP_NOTSENT_LOWAT)
+#   define ASIO_OS_DEF_TCP_NOTSENT_LOWAT 25
+#  endif // defined(TCP_NOTSENT_LOWAT)
+#  if defined(SIOCOUTQNSD)
+#   define ASIO_OS_DEF_SIOCOUTQNSD SIOCOUTQNSD
+#  else // defined(SIOCOUTQNSD)
+#   define ASIO_OS_DEF_SIOCOUTQNSD 0x894B
+#  endif // defined(SIOCOUTQNSD)
+# endif // defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
+# if defined(ASIO_HAS_UDP_OFFLOAD)
+// Values from linux/udp.h, which older C libraries do not provide.
+#  if defined(UDP_SEGMENT)
+#   define ASIO_OS_DEF_UDP_SEGMENT UDP_SEGMENT
+#  else // defined(UDP_SEGMENT)
+#   define ASIO_OS_DEF_UDP_SEGMENT 103
+#  endif // defined(UDP_SEGMENT)
+#  if defined(UDP_GRO)
+#   define ASIO_OS_DEF_UDP_GRO UDP_GRO
+#  else // defined(UDP_GRO)
+#   define ASIO_OS_DEF_UDP_GRO 104
+#  endif // defined(UDP_GRO)
+# endif // defined(ASIO_HAS_UDP_OFFLOAD)
+# if defined(ASIO_HAS_PACKET_INFO)
+#  define ASIO_OS_DEF_IP_PKTINFO IP_PKTINFO
+#  define ASIO_OS_DEF_IP_TOS IP_TOS
+#  define ASIO_OS_DEF_IP_RECVTOS IP_RECVTOS
+#  define ASIO_OS_DEF_IPV6_PKTINFO IPV6_PKTINFO
+#  define ASIO_OS_DEF_IPV6_RECVPKTINFO IPV6_RECVPKTINFO
+#  define ASIO_OS_DEF_IPV6_TCLASS IPV6_TCLASS
+#  define ASIO_OS_DEF_IPV6_RECVTCLASS IPV6_RECVTCLASS
+# endif // defined(ASIO_HAS_PACKET_INFO)
 # define ASIO_OS_DEF_IP_MULTICAST_IF IP_MULTICAST_IF
 # define ASIO_OS_DEF_IP_MULTICAST_TTL IP_MULTICAST_TTL
 # define ASIO_OS_DEF_IP_MULTICAST_LOOP IP_MULTICAST_LOOP
@@ -418,6 +547,13 @@ const int max_iov_len = 16;
 const int custom_socket_option_level = 0xA5100000;
 const int enable_connection_aborted_option = 1;
 const int always_fail_option = 2;
+const int multishot_accept_option = 3;
+const int zero_copy_option = 4;
+const int inline_completion_option = 5;
+const int read_ahead_option = 6;
+const int write_coalescing_option = 7;
+const int operation_slots_option = 8;
+const int transport_info_option = 9;
 
 } // namespace detail
 } // namespace asio
@@ -16,7 +16,9 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <atomic>
 #include "asio/detail/atomic_count.hpp"
+#include "asio/detail/cstdint.hpp"
 #include "asio/detail/executor_op.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/mutex.hpp"
@@ -45,22 +47,26 @@ public:
   private:
     friend class strand_executor_service;
 
-    // Mutex to protect access to internal data.
-    mutex* mutex_;
-
-    // Indicates whether the strand is currently "locked" by a handler. This
-    // means that there is a handler upcall in progress, or that the strand
-    // itself has been scheduled in order to invoke some pending handlers.
-    bool locked_;
-
-    // Indicates that the strand has been shut down and will accept no further
-    // handlers.
-    bool shutdown_;
-
-    // The handlers that are waiting on the strand but should not be run until
-    // after the next time the strand is scheduled. This queue must only be
-    // modified while the mutex is locked.
-    op_queue<scheduler_operation> waiting_queue_;
+    // The state of the strand, combining its "locked" flag with the handlers
+    // that are waiting on the strand but should not be run until after the
+    // next time the strand is scheduled. The value is one of:
+    //
+    // - null, when the strand is not locked;
+    //
+    // - locked_state(), when the strand is "locked" by a handler but no other
+    //   handlers are waiting. This means that there is a handler upcall in
+    //   progress, or that the strand itself has been scheduled in order to
+    //   invoke some pending handlers;
+    //
+    // - a pointer to the most recently enqueued waiting handler, when the
+    //   strand is locked. The waiting handlers form an intrusive stack, in
+    //   reverse order of submission, terminated by a null pointer;
+    //
+    // - shutdown_state(), when the strand has been shut down and will accept
+    //   no further handlers.
+    //
+    // Handlers are added using a compare-and-swap, so no lock is required.
+    std::atomic<scheduler_operation*> state_;
 
     // The handlers that are ready to be run. Logically speaking, these are the
     // handlers that hold the strand's lock. The ready queue is only modified
@@ -121,11 +127,30 @@ public:
   ASIO_DECL static bool running_in_this_thread(
       const implementation_type& impl);
 
+  // Get the largest number of handlers observed waiting on a strand, when
+  // metrics are enabled.
+  std::size_t max_queue_depth() const
+  {
+    return max_queue_depth_.load(std::memory_order_relaxed);
+  }
+
 private:
   friend class strand_impl;
   template <typename F, typename Allocator> class allocator_binder;
   template <typename Executor, typename = void> class invoker;
 
+  // Special values of strand_impl::state_. Operations are at least
+  // pointer-aligned, so these never compare equal to a real operation.
+  static scheduler_operation* locked_state()
+  {
+    return reinterpret_cast<scheduler_operation*>(static_cast<uintptr_t>(1));
+  }
+
+  static scheduler_operation* shutdown_state()
+  {
+    return reinterpret_cast<scheduler_operation*>(static_cast<uintptr_t>(2));
+  }
+
   // Adds a function to the strand. Returns true if it acquires the lock.
   ASIO_DECL static bool enqueue(const implementation_type& impl,
       scheduler_operation* op);
@@ -137,6 +162,16 @@ private:
   // Invokes all ready-to-run handlers.
   ASIO_DECL static void run_ready_handlers(implementation_type& impl);
 
+  // Update the largest number of handlers observed waiting on a strand.
+  void record_queue_depth(std::size_t depth)
+  {
+    std::size_t value = max_queue_depth_.load(std::memory_order_relaxed);
+    while (depth > value && !max_queue_depth_.compare_exchange_weak(
+          value, depth, std::memory_order_relaxed))
+    {
+    }
+  }
+
   // Helper function to request invocation of the given function.
   template <typename Executor, typename Function, typename Allocator>
   static void do_execute(const implementation_type& impl, Executor& ex,
@@ -145,18 +180,14 @@ private:
   // Mutex to protect access to the service-wide state.
   mutex mutex_;
 
-  // Number of mutexes shared between all strand objects.
-  enum { num_mutexes = 193 };
-
-  // Pool of mutexes.
-  shared_ptr<mutex> mutexes_[num_mutexes];
-
-  // Extra value used when hashing to prevent recycled memory locations from
-  // getting the same mutex.
-  std::size_t salt_;
-
   // The head of a linked list of all implementations.
   strand_impl* impl_list_;
+
+  // Whether metrics are enabled.
+  const bool metrics_;
+
+  // The largest number of handlers observed waiting on a strand.
+  std::atomic<std::size_t> max_queue_depth_;
 };
 
 } // namespace detail
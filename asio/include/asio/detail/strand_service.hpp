@@ -16,7 +16,10 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <atomic>
 #include "asio/io_context.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/memory.hpp"
 #include "asio/detail/mutex.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/operation.hpp"
@@ -45,6 +48,7 @@ public:
   {
   public:
     strand_impl();
+    ASIO_DECL ~strand_impl();
 
   private:
     // Only this service will have access to the internal values.
@@ -52,26 +56,47 @@ public:
     friend struct on_do_complete_exit;
     friend struct on_dispatch_exit;
 
-    // Mutex to protect access to internal data.
-    asio::detail::mutex mutex_;
-
-    // Indicates whether the strand is currently "locked" by a handler. This
-    // means that there is a handler upcall in progress, or that the strand
-    // itself has been scheduled in order to invoke some pending handlers.
-    bool locked_;
-
-    // The handlers that are waiting on the strand but should not be run until
-    // after the next time the strand is scheduled. This queue must only be
-    // modified while the mutex is locked.
-    op_queue<operation> waiting_queue_;
+    // The state of the strand, combining its "locked" flag with the handlers
+    // that are waiting on the strand but should not be run until after the
+    // next time the strand is scheduled. The value is one of:
+    //
+    // - null, when the strand is not locked;
+    //
+    // - locked_state(), when the strand is "locked" by a handler but no other
+    //   handlers are waiting. This means that there is a handler upcall in
+    //   progress, or that the strand itself has been scheduled in order to
+    //   invoke some pending handlers;
+    //
+    // - a pointer to the most recently enqueued waiting handler, when the
+    //   strand is locked. The waiting handlers form an intrusive stack, in
+    //   reverse order of submission, terminated by a null pointer;
+    //
+    // - shutdown_state(), when the service has been shut down and will accept
+    //   no further handlers.
+    //
+    // Handlers are added using a compare-and-swap, so no lock is required.
+    std::atomic<operation*> state_;
 
     // The handlers that are ready to be run. Logically speaking, these are the
     // handlers that hold the strand's lock. The ready queue is only modified
     // from within the strand and so may be accessed without locking the mutex.
     op_queue<operation> ready_queue_;
+
+    // Keeps the implementation alive while the strand is locked, so that the
+    // strand may be scheduled after all strand objects have been destroyed.
+    // Only modified by the holder of the strand's lock.
+    shared_ptr<strand_impl> self_;
+
+    // Pointers to adjacent handle implementations in linked list.
+    strand_impl* next_;
+    strand_impl* prev_;
+
+    // The strand service in where the implementation is held. Cleared when
+    // the service is shut down.
+    strand_service* service_;
   };
 
-  typedef strand_impl* implementation_type;
+  typedef shared_ptr<strand_impl> implementation_type;
 
   // Construct a new strand service for the specified io_context.
   ASIO_DECL explicit strand_service(asio::io_context& io_context);
@@ -95,6 +120,31 @@ public:
       const implementation_type& impl) const;
 
 private:
+  // Special values of strand_impl::state_. Operations are at least
+  // pointer-aligned, so these never compare equal to a real operation.
+  static operation* locked_state()
+  {
+    return reinterpret_cast<operation*>(static_cast<uintptr_t>(1));
+  }
+
+  static operation* shutdown_state()
+  {
+    return reinterpret_cast<operation*>(static_cast<uintptr_t>(2));
+  }
+
+  // Acquires the strand lock if it is not already held. Returns true if the
+  // lock is acquired.
+  ASIO_DECL static bool try_lock(implementation_type& impl);
+
+  // Adds a handler to the strand. Returns true if it acquires the lock.
+  ASIO_DECL static bool enqueue(implementation_type& impl, operation* op);
+
+  // Transfers waiting handlers to the ready queue. Returns true if one or more
+  // handlers are ready to run. Otherwise releases the strand lock, and moves
+  // the reference that kept the implementation alive into self.
+  ASIO_DECL static bool push_waiting_to_ready(
+      strand_impl* impl, implementation_type& self);
+
   // Helper function to dispatch a handler.
   ASIO_DECL void do_dispatch(implementation_type& impl, operation* op);
 
@@ -112,22 +162,11 @@ private:
   // The io_context implementation used to post completions.
   io_context_impl& io_context_impl_;
 
-  // Mutex to protect access to the array of implementations.
+  // Mutex to protect access to the list of implementations.
   asio::detail::mutex mutex_;
 
-  // Number of implementations shared between all strand objects.
-#if defined(ASIO_STRAND_IMPLEMENTATIONS)
-  enum { num_implementations = ASIO_STRAND_IMPLEMENTATIONS };
-#else // defined(ASIO_STRAND_IMPLEMENTATIONS)
-  enum { num_implementations = 193 };
-#endif // defined(ASIO_STRAND_IMPLEMENTATIONS)
-
-  // Pool of implementations.
-  shared_ptr<strand_impl> implementations_[num_implementations];
-
-  // Extra value used when hashing to prevent recycled memory locations from
-  // getting the same strand implementation.
-  std::size_t salt_;
+  // The head of a linked list of all implementations.
+  strand_impl* impl_list_;
 };
 
 } // namespace detail
@@ -0,0 +1,85 @@
+//
+// detail/thread_affinity.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_THREAD_AFFINITY_HPP
+#define ASIO_DETAIL_THREAD_AFFINITY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <climits>
+#include <cstddef>
+#include "asio/error_code.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Bind the calling thread to a single processor. The processor is chosen from
+// those on which the process is permitted to run, using the index modulo the
+// number of such processors. Fails with operation_not_supported on platforms
+// that do not allow thread affinity to be set.
+ASIO_DECL void bind_this_thread_to_processor(
+    std::size_t index, asio::error_code& ec);
+
+// Bind the calling thread to a set of processors, identified by their system
+// processor numbers. The thread is no longer considered to belong to a NUMA
+// node.
+ASIO_DECL void bind_this_thread_to_processors(const std::size_t* processors,
+    std::size_t count, asio::error_code& ec);
+
+// Get the number of NUMA nodes in the system. Returns 1 where NUMA topology
+// information is not available.
+ASIO_DECL std::size_t numa_node_count();
+
+// Bind the calling thread to the processors of a NUMA node, and record the
+// node so that the thread's memory caches retain only node-local blocks.
+ASIO_DECL void bind_this_thread_to_numa_node(
+    std::size_t node, asio::error_code& ec);
+
+#if defined(ASIO_HAS_NUMA)
+
+// Holds a tag identifying the NUMA node to which the calling thread is bound.
+// The tag is the node number plus one, or zero if the thread is not bound to
+// a node (or the node number is too large to be tagged).
+template <typename T = void>
+struct numa_node_binding
+{
+  static ASIO_THREAD_KEYWORD unsigned char tag_;
+};
+
+template <typename T>
+ASIO_THREAD_KEYWORD unsigned char numa_node_binding<T>::tag_ = 0;
+
+#endif // defined(ASIO_HAS_NUMA)
+
+// Get the tag of the NUMA node to which the calling thread is bound.
+inline unsigned char this_thread_numa_node_tag()
+{
+#if defined(ASIO_HAS_NUMA)
+  return numa_node_binding<>::tag_;
+#else // defined(ASIO_HAS_NUMA)
+  return 0;
+#endif // defined(ASIO_HAS_NUMA)
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/thread_affinity.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_DETAIL_THREAD_AFFINITY_HPP
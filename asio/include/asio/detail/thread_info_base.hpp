@@ -18,8 +18,20 @@
 #include "asio/detail/config.hpp"
 #include <climits>
 #include <cstddef>
+#include <cstring>
+#include "asio/detail/fiber_stack_cache.hpp"
+#include "asio/detail/huge_page_arena.hpp"
 #include "asio/detail/memory.hpp"
+#include "asio/detail/memory_metrics.hpp"
 #include "asio/detail/noncopyable.hpp"
+#include "asio/detail/thread_affinity.hpp"
+
+#if defined(ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE)
+# if !defined(ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
+#  define ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES 1
+# endif // !defined(ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
+# include "asio/detail/remote_free_list.hpp"
+#endif // defined(ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE)
 
 #if !defined(ASIO_NO_EXCEPTIONS)
 # include <exception>
@@ -35,6 +47,42 @@ namespace detail {
 # define ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE 2
 #endif // ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE
 
+#if defined(ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
+# ifndef ASIO_RECYCLING_ALLOCATOR_SIZE_CLASS_DEPTH
+#  define ASIO_RECYCLING_ALLOCATOR_SIZE_CLASS_DEPTH 16
+# endif // ASIO_RECYCLING_ALLOCATOR_SIZE_CLASS_DEPTH
+# ifndef ASIO_RECYCLING_ALLOCATOR_MAX_SIZE_CLASS
+#  define ASIO_RECYCLING_ALLOCATOR_MAX_SIZE_CLASS 4096
+# endif // ASIO_RECYCLING_ALLOCATOR_MAX_SIZE_CLASS
+#endif // defined(ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
+
+// Counters describing the use of a thread's recycling cache.
+struct recycling_cache_statistics
+{
+  std::size_t allocations;
+  std::size_t cache_hits;
+  std::size_t deallocations;
+  std::size_t bytes_allocated;
+  std::size_t bytes_deallocated;
+  std::size_t cache_releases;
+  std::size_t remote_releases;
+  std::size_t remote_returns;
+  std::size_t cached_blocks;
+  std::size_t cached_bytes;
+};
+
+#if defined(ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
+
+// Get the number of power-of-two size classes from min_bytes up to max_bytes.
+constexpr int recycling_size_class_count(
+    std::size_t max_bytes, std::size_t min_bytes)
+{
+  return max_bytes > min_bytes
+    ? 1 + recycling_size_class_count(max_bytes / 2, min_bytes) : 1;
+}
+
+#endif // defined(ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
+
 class thread_info_base
   : private noncopyable
 {
@@ -44,8 +92,10 @@ public:
     enum
     {
       cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
+      size_classes = 1,
       begin_mem_index = 0,
-      end_mem_index = cache_size
+      end_mem_index = cache_size,
+      memory_kind = memory_metrics::operation_memory
     };
   };
 
@@ -54,8 +104,10 @@ public:
     enum
     {
       cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
+      size_classes = 1,
       begin_mem_index = default_tag::end_mem_index,
-      end_mem_index = begin_mem_index + cache_size
+      end_mem_index = begin_mem_index + cache_size,
+      memory_kind = memory_metrics::awaitable_frame_memory
     };
   };
 
@@ -64,8 +116,10 @@ public:
     enum
     {
       cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
+      size_classes = 1,
       begin_mem_index = awaitable_frame_tag::end_mem_index,
-      end_mem_index = begin_mem_index + cache_size
+      end_mem_index = begin_mem_index + cache_size,
+      memory_kind = memory_metrics::executor_function_memory
     };
   };
 
@@ -74,8 +128,10 @@ public:
     enum
     {
       cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
+      size_classes = 0,
       begin_mem_index = executor_function_tag::end_mem_index,
-      end_mem_index = begin_mem_index + cache_size
+      end_mem_index = begin_mem_index + cache_size,
+      memory_kind = memory_metrics::cancellation_signal_memory
     };
   };
 
@@ -84,8 +140,10 @@ public:
     enum
     {
       cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
+      size_classes = 0,
       begin_mem_index = cancellation_signal_tag::end_mem_index,
-      end_mem_index = begin_mem_index + cache_size
+      end_mem_index = begin_mem_index + cache_size,
+      memory_kind = memory_metrics::parallel_group_memory
     };
   };
 
@@ -94,20 +152,51 @@ public:
     enum
     {
       cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
+      size_classes = 0,
       begin_mem_index = parallel_group_tag::end_mem_index,
-      end_mem_index = begin_mem_index + cache_size
+      end_mem_index = begin_mem_index + cache_size,
+      memory_kind = memory_metrics::timed_cancel_memory
     };
   };
 
-  enum { max_mem_index = timed_cancel_tag::end_mem_index };
+  struct promise_tag
+  {
+    enum
+    {
+      cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
+      size_classes = 1,
+      begin_mem_index = timed_cancel_tag::end_mem_index,
+      end_mem_index = begin_mem_index + cache_size,
+      memory_kind = memory_metrics::promise_memory
+    };
+  };
+
+  enum { max_mem_index = promise_tag::end_mem_index };
 
   thread_info_base()
+    : numa_node_tag_(this_thread_numa_node_tag())
 #if !defined(ASIO_NO_EXCEPTIONS)
-    : has_pending_exception_(0)
+    , has_pending_exception_(0)
 #endif // !defined(ASIO_NO_EXCEPTIONS)
   {
     for (int i = 0; i < max_mem_index; ++i)
       reusable_memory_[i] = 0;
+#if defined(ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
+    for (int i = 0; i < num_size_classes; ++i)
+    {
+      size_classes_[i].head_ = 0;
+      size_classes_[i].count_ = 0;
+    }
+#endif // defined(ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
+    recycling_cache_statistics empty = {};
+    statistics_ = empty;
+    memory_metrics_ = 0;
+#if defined(ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE)
+    remote_free_list_ = 0;
+#endif // defined(ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE)
+#if defined(ASIO_HAS_HUGE_PAGES)
+    huge_page_arena_ = 0;
+#endif // defined(ASIO_HAS_HUGE_PAGES)
   }
 
   ~thread_info_base()
@@ -118,8 +207,30 @@ public:
       // it is significantly faster when using a tight io_context::poll() loop
       // in latency sensitive applications.
       if (reusable_memory_[i])
-        aligned_delete(reusable_memory_[i]);
+        delete_block(reusable_memory_[i]);
+    }
+#if defined(ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE)
+    if (remote_free_list_)
+    {
+      void* pointer = remote_free_list::release(remote_free_list_);
+      while (pointer)
+      {
+        void* next = *static_cast<void**>(pointer);
+        delete_block(pointer);
+        pointer = next;
+      }
+    }
+#endif // defined(ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE)
+#if defined(ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
+    for (int i = 0; i < num_size_classes; ++i)
+    {
+      while (void* pointer = size_classes_[i].head_)
+      {
+        size_classes_[i].head_ = *static_cast<void**>(pointer);
+        delete_block(pointer);
+      }
     }
+#endif // defined(ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
   }
 
   static void* allocate(thread_info_base* this_thread,
@@ -138,6 +249,13 @@ public:
   static void* allocate(Purpose, thread_info_base* this_thread,
       std::size_t size, std::size_t align = ASIO_DEFAULT_ALIGN)
   {
+#if defined(ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
+    if (Purpose::size_classes
+        && size + size_class_overhead <= max_size_class_bytes)
+      return size_class_allocate(this_thread,
+          Purpose::memory_kind, size, align);
+#endif // defined(ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
+
     std::size_t chunks = (size + chunk_size - 1) / chunk_size;
 
     if (this_thread)
@@ -154,6 +272,10 @@ public:
           {
             this_thread->reusable_memory_[mem_index] = 0;
             mem[size] = mem[0];
+#if defined(ASIO_HAS_NUMA)
+            mem[size + 1] = mem[1];
+#endif // defined(ASIO_HAS_NUMA)
+            count_allocation(this_thread, Purpose::memory_kind, size, true);
             return pointer;
           }
         }
@@ -166,15 +288,22 @@ public:
         {
           void* const pointer = this_thread->reusable_memory_[mem_index];
           this_thread->reusable_memory_[mem_index] = 0;
-          aligned_delete(pointer);
+          delete_block(pointer);
           break;
         }
       }
     }
 
-    void* const pointer = aligned_new(align, chunks * chunk_size + 1);
+    void* const pointer = new_block(this_thread, align,
+        chunks * chunk_size + tag_size);
     unsigned char* const mem = static_cast<unsigned char*>(pointer);
     mem[size] = (chunks <= UCHAR_MAX) ? static_cast<unsigned char>(chunks) : 0;
+#if defined(ASIO_HAS_NUMA)
+    // The block is first touched by this thread, and so is local to its node.
+    mem[size + 1] = this_thread ? this_thread->numa_node_tag_
+      : this_thread_numa_node_tag();
+#endif // defined(ASIO_HAS_NUMA)
+    count_allocation(this_thread, Purpose::memory_kind, size, false);
     return pointer;
   }
 
@@ -182,9 +311,21 @@ public:
   static void deallocate(Purpose, thread_info_base* this_thread,
       void* pointer, std::size_t size)
   {
+#if defined(ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
+    if (Purpose::size_classes
+        && size + size_class_overhead <= max_size_class_bytes)
+    {
+      size_class_deallocate(this_thread,
+          Purpose::memory_kind, pointer, size);
+      return;
+    }
+#endif // defined(ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
+
+    count_deallocation(this_thread, Purpose::memory_kind, size);
+
     if (size <= chunk_size * UCHAR_MAX)
     {
-      if (this_thread)
+      if (this_thread && this_thread->owns_node_of(pointer, size))
       {
         for (int mem_index = Purpose::begin_mem_index;
             mem_index < Purpose::end_mem_index; ++mem_index)
@@ -192,6 +333,9 @@ public:
           if (this_thread->reusable_memory_[mem_index] == 0)
           {
             unsigned char* const mem = static_cast<unsigned char*>(pointer);
+#if defined(ASIO_HAS_NUMA)
+            mem[1] = mem[size + 1];
+#endif // defined(ASIO_HAS_NUMA)
             mem[0] = mem[size];
             this_thread->reusable_memory_[mem_index] = pointer;
             return;
@@ -200,7 +344,47 @@ public:
       }
     }
 
-    aligned_delete(pointer);
+    if (this_thread)
+      ++this_thread->statistics_.cache_releases;
+    delete_block(pointer);
+  }
+
+  // Get the counters for this thread's recycling cache. The numbers of cached
+  // blocks and bytes are maintained only by the size-class cache.
+  recycling_cache_statistics statistics() const
+  {
+    recycling_cache_statistics result = statistics_;
+#if defined(ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
+    for (int i = 0; i < num_size_classes; ++i)
+    {
+      result.cached_blocks += size_classes_[i].count_;
+      result.cached_bytes += size_classes_[i].count_
+        * (static_cast<std::size_t>(min_size_class_bytes) << i);
+    }
+#endif // defined(ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
+    return result;
+  }
+
+  // Also count the thread's allocations and deallocations in the specified
+  // counters, if not null.
+  void use_memory_metrics(memory_metrics* metrics)
+  {
+    memory_metrics_ = metrics;
+  }
+
+#if defined(ASIO_HAS_HUGE_PAGES)
+  // Allocate the blocks that are not found in the cache from the specified
+  // arena, or from the system allocator if the arena is null.
+  void use_huge_page_arena(huge_page_arena* arena)
+  {
+    huge_page_arena_ = arena;
+  }
+#endif // defined(ASIO_HAS_HUGE_PAGES)
+
+  // Get the cache of stacks for stackful coroutines run by this thread.
+  fiber_stack_cache& fiber_stacks()
+  {
+    return fiber_stacks_;
   }
 
   void capture_current_exception()
@@ -244,7 +428,272 @@ private:
 #else // defined(ASIO_HAS_IO_URING)
   enum { chunk_size = 4 };
 #endif // defined(ASIO_HAS_IO_URING)
+
+  // Each block carries a trailing chunk count and, where NUMA is supported, a
+  // tag identifying the node of the thread that allocated it.
+#if defined(ASIO_HAS_NUMA)
+  enum { tag_size = 2 };
+#else // defined(ASIO_HAS_NUMA)
+  enum { tag_size = 1 };
+#endif // defined(ASIO_HAS_NUMA)
+
+  // Allocate memory for a block, using the thread's huge page arena if it has
+  // one.
+  static void* new_block(thread_info_base* this_thread,
+      std::size_t align, std::size_t size)
+  {
+#if defined(ASIO_HAS_HUGE_PAGES)
+    if (this_thread && this_thread->huge_page_arena_
+        && align <= huge_page_arena::alignment)
+      if (void* pointer = this_thread->huge_page_arena_->allocate(size))
+        return pointer;
+#else // defined(ASIO_HAS_HUGE_PAGES)
+    (void)this_thread;
+#endif // defined(ASIO_HAS_HUGE_PAGES)
+    return aligned_new(align, size);
+  }
+
+  // Count an allocation in the thread's statistics and, if enabled, in the
+  // counters of the context that the thread is running.
+  static void count_allocation(thread_info_base* this_thread,
+      int kind, std::size_t size, bool cache_hit)
+  {
+    if (this_thread)
+    {
+      ++this_thread->statistics_.allocations;
+      this_thread->statistics_.bytes_allocated += size;
+      if (cache_hit)
+        ++this_thread->statistics_.cache_hits;
+      if (this_thread->memory_metrics_)
+        this_thread->memory_metrics_->record_allocation(kind, size, cache_hit);
+    }
+  }
+
+  // Count a deallocation in the thread's statistics and, if enabled, in the
+  // counters of the context that the thread is running.
+  static void count_deallocation(thread_info_base* this_thread,
+      int kind, std::size_t size)
+  {
+    if (this_thread)
+    {
+      ++this_thread->statistics_.deallocations;
+      this_thread->statistics_.bytes_deallocated += size;
+      if (this_thread->memory_metrics_)
+        this_thread->memory_metrics_->record_deallocation(kind, size);
+    }
+  }
+
+  // Free the memory for a block.
+  static void delete_block(void* pointer)
+  {
+#if defined(ASIO_HAS_HUGE_PAGES)
+    if (huge_page_arena::contains(pointer))
+    {
+      huge_page_arena::deallocate(pointer);
+      return;
+    }
+#endif // defined(ASIO_HAS_HUGE_PAGES)
+    aligned_delete(pointer);
+  }
+
+  // Whether a block may be cached by this thread. A thread bound to a NUMA
+  // node caches only blocks allocated on that node, so that a block released
+  // by another node's thread is returned to the system allocator rather than
+  // being reused remotely.
+  bool owns_node_of(void* pointer, std::size_t size) const
+  {
+#if defined(ASIO_HAS_NUMA)
+    return numa_node_tag_ == 0 || static_cast<unsigned char*>(
+        pointer)[size + tag_size - 1] == numa_node_tag_;
+#else // defined(ASIO_HAS_NUMA)
+    (void)pointer;
+    (void)size;
+    return true;
+#endif // defined(ASIO_HAS_NUMA)
+  }
+
+#if defined(ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
+  // The size classes are powers of two, from min_size_class_bytes up to
+  // ASIO_RECYCLING_ALLOCATOR_MAX_SIZE_CLASS. Each class holds a free list of
+  // up to ASIO_RECYCLING_ALLOCATOR_SIZE_CLASS_DEPTH blocks, linked through
+  // their first word. As the class is determined by the size passed to both
+  // allocate and deallocate, blocks need no header.
+  //
+  // When ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE is defined, each block also
+  // carries a trailing pointer to the remote_free_list of the thread that
+  // allocated it. A block released by another thread is pushed onto that
+  // list, rather than into the releasing thread's cache, and the owner moves
+  // the whole list into its cache when an allocation misses.
+#if defined(ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE)
+  enum { size_class_overhead = tag_size + sizeof(remote_free_list*) };
+#else // defined(ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE)
+  enum { size_class_overhead = tag_size };
+#endif // defined(ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE)
+
+  enum
+  {
+    min_size_class_bytes = 32,
+    max_size_class_bytes = ASIO_RECYCLING_ALLOCATOR_MAX_SIZE_CLASS,
+    size_class_depth = ASIO_RECYCLING_ALLOCATOR_SIZE_CLASS_DEPTH
+  };
+
+  enum
+  {
+    num_size_classes = recycling_size_class_count(
+        ASIO_RECYCLING_ALLOCATOR_MAX_SIZE_CLASS, min_size_class_bytes)
+  };
+
+  struct size_class
+  {
+    void* head_;
+    std::size_t count_;
+  };
+
+  static int size_class_index(std::size_t bytes)
+  {
+    int index = 0;
+    for (std::size_t capacity = min_size_class_bytes;
+        capacity < bytes; capacity <<= 1)
+      ++index;
+    return index;
+  }
+
+  static void* size_class_allocate(thread_info_base* this_thread,
+      int kind, std::size_t size, std::size_t align)
+  {
+    const int index = size_class_index(size + size_class_overhead);
+
+    void* pointer = 0;
+    if (this_thread)
+    {
+      size_class& c = this_thread->size_classes_[index];
+#if defined(ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE)
+      if (!c.head_)
+        this_thread->reclaim_remote_frees();
+#endif // defined(ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE)
+      if (c.head_ && reinterpret_cast<std::size_t>(c.head_) % align == 0)
+      {
+        pointer = c.head_;
+        c.head_ = *static_cast<void**>(pointer);
+        --c.count_;
+      }
+    }
+
+    count_allocation(this_thread, kind, size, pointer != 0);
+    if (!pointer)
+    {
+      pointer = new_block(this_thread, align,
+          static_cast<std::size_t>(min_size_class_bytes) << index);
+    }
+
+#if defined(ASIO_HAS_NUMA)
+    static_cast<unsigned char*>(pointer)[size + tag_size - 1] = this_thread
+      ? this_thread->numa_node_tag_ : this_thread_numa_node_tag();
+#endif // defined(ASIO_HAS_NUMA)
+
+#if defined(ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE)
+    // The list is obtained on first use, as a thread_info_base is created for
+    // each call to run() or poll().
+    remote_free_list* owner = 0;
+    if (this_thread)
+    {
+      if (!this_thread->remote_free_list_)
+        this_thread->remote_free_list_ = remote_free_list::acquire();
+      owner = this_thread->remote_free_list_;
+    }
+    std::memcpy(static_cast<unsigned char*>(pointer) + size + tag_size,
+        &owner, sizeof(owner));
+#endif // defined(ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE)
+
+    return pointer;
+  }
+
+  static void size_class_deallocate(thread_info_base* this_thread,
+      int kind, void* pointer, std::size_t size)
+  {
+    const int index = size_class_index(size + size_class_overhead);
+    count_deallocation(this_thread, kind, size);
+
+#if defined(ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE)
+    remote_free_list* owner;
+    std::memcpy(&owner, static_cast<unsigned char*>(pointer)
+        + size + tag_size, sizeof(owner));
+    if (owner && (!this_thread || owner != this_thread->remote_free_list_))
+    {
+      // The size class is kept in the second word, for use by the owner.
+      static_cast<void**>(pointer)[1] = reinterpret_cast<void*>(
+          static_cast<std::size_t>(index));
+      if (owner->push(pointer))
+      {
+        if (this_thread)
+          ++this_thread->statistics_.remote_releases;
+        return;
+      }
+    }
+#endif // defined(ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE)
+
+    if (this_thread)
+    {
+      size_class& c = this_thread->size_classes_[index];
+      if (c.count_ < size_class_depth
+          && this_thread->owns_node_of(pointer, size))
+      {
+        *static_cast<void**>(pointer) = c.head_;
+        c.head_ = pointer;
+        ++c.count_;
+        return;
+      }
+      ++this_thread->statistics_.cache_releases;
+    }
+
+    delete_block(pointer);
+  }
+
+#if defined(ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE)
+  // Move the blocks that other threads have returned into the cache.
+  void reclaim_remote_frees()
+  {
+    if (!remote_free_list_)
+      return;
+
+    void* pointer = remote_free_list_->take();
+    while (pointer)
+    {
+      void** const words = static_cast<void**>(pointer);
+      void* const next = words[0];
+      size_class& c = size_classes_[
+        reinterpret_cast<std::size_t>(words[1])];
+      ++statistics_.remote_returns;
+      if (c.count_ < size_class_depth)
+      {
+        words[0] = c.head_;
+        c.head_ = pointer;
+        ++c.count_;
+      }
+      else
+      {
+        ++statistics_.cache_releases;
+        delete_block(pointer);
+      }
+      pointer = next;
+    }
+  }
+
+  remote_free_list* remote_free_list_;
+#endif // defined(ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE)
+
+  size_class size_classes_[num_size_classes];
+#endif // defined(ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
+
+  recycling_cache_statistics statistics_;
+  memory_metrics* memory_metrics_;
+
   void* reusable_memory_[max_mem_index];
+  unsigned char numa_node_tag_;
+#if defined(ASIO_HAS_HUGE_PAGES)
+  huge_page_arena* huge_page_arena_;
+#endif // defined(ASIO_HAS_HUGE_PAGES)
+  fiber_stack_cache fiber_stacks_;
 
 #if !defined(ASIO_NO_EXCEPTIONS)
   int has_pending_exception_;
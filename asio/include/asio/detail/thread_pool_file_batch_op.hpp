@@ -0,0 +1,273 @@
+//
+// detail/thread_pool_file_batch_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_THREAD_POOL_FILE_BATCH_OP_HPP
+#define ASIO_DETAIL_THREAD_POOL_FILE_BATCH_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_THREAD_POOL_FILE)
+
+#include "asio/detail/atomic_count.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/descriptor_ops.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/thread_pool_file_op.hpp"
+#include "asio/error.hpp"
+#include "asio/file_base.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename Request>
+class thread_pool_file_batch_op_base : public thread_pool_file_op
+{
+public:
+  // A range of the batch's requests, performed by a single worker thread.
+  class chunk : public operation
+  {
+  public:
+    chunk()
+      : operation(&chunk::do_complete),
+        op_(0),
+        begin_(0),
+        end_(0)
+    {
+    }
+
+    static void do_complete(void* owner, operation* base,
+        const asio::error_code& /*ec*/,
+        std::size_t /*bytes_transferred*/)
+    {
+      ASIO_ASSUME(base != 0);
+      chunk* c(static_cast<chunk*>(base));
+      c->op_->complete_chunk(owner, c->begin_, c->end_);
+    }
+
+  private:
+    friend class thread_pool_file_batch_op_base;
+
+    thread_pool_file_batch_op_base* op_;
+    std::size_t begin_;
+    std::size_t end_;
+  };
+
+  thread_pool_file_batch_op_base(
+      const std::shared_ptr<thread_pool_file_state>& file, scheduler& sched,
+      Request* requests, std::size_t count, func_type complete_func)
+    : thread_pool_file_op(file, sched,
+        &thread_pool_file_batch_op_base::do_perform, complete_func),
+      requests_(requests),
+      count_(count),
+      chunks_(0),
+      outstanding_(0),
+      abandoned_(false)
+  {
+    // Requests that are never performed report that they were aborted.
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      requests_[i].error = asio::error::operation_aborted;
+      requests_[i].bytes_transferred = 0;
+    }
+  }
+
+  ~thread_pool_file_batch_op_base()
+  {
+    delete[] chunks_;
+  }
+
+  // Get the number of requests in the batch.
+  std::size_t size() const
+  {
+    return count_;
+  }
+
+  // Divide the requests into at most max_chunks chunks, so that they may be
+  // performed by separate worker threads. Returns the number of chunks.
+  std::size_t divide(std::size_t max_chunks)
+  {
+    std::size_t n = max_chunks < count_ ? max_chunks : count_;
+    chunks_ = new chunk[n];
+    outstanding_ = static_cast<long>(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      chunks_[i].op_ = this;
+      chunks_[i].begin_ = count_ * i / n;
+      chunks_[i].end_ = count_ * (i + 1) / n;
+    }
+    return n;
+  }
+
+  // Get a chunk of the requests.
+  operation* chunk_at(std::size_t i)
+  {
+    return &chunks_[i];
+  }
+
+  static void do_perform(thread_pool_file_op* base, int descriptor)
+  {
+    ASIO_ASSUME(base != 0);
+    thread_pool_file_batch_op_base* o(
+        static_cast<thread_pool_file_batch_op_base*>(base));
+
+    o->perform_requests(descriptor, 0, o->count_);
+  }
+
+  // Combine the results of the requests into the operation's result.
+  void gather_results()
+  {
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+      if (!this->ec_ && requests_[i].error)
+        this->ec_ = requests_[i].error;
+      this->bytes_transferred_ += requests_[i].bytes_transferred;
+    }
+  }
+
+private:
+  // Perform a chunk of the requests, completing the batch when the last chunk
+  // is done. If any chunk was destroyed without being run, the worker threads
+  // are being shut down and the batch is destroyed without an upcall.
+  void complete_chunk(void* owner, std::size_t begin, std::size_t end)
+  {
+    if (owner)
+    {
+      int descriptor = file_->begin(generation_);
+      if (descriptor != -1)
+      {
+        perform_requests(descriptor, begin, end);
+        file_->end();
+      }
+    }
+    else
+      abandoned_ = true;
+
+    if (ref_count_down(outstanding_))
+    {
+      if (abandoned_)
+        destroy();
+      else
+        scheduler_.post_deferred_completion(this);
+    }
+  }
+
+  void perform_requests(int descriptor, std::size_t begin, std::size_t end)
+  {
+    for (std::size_t i = begin; i < end; ++i)
+      perform_request(descriptor, requests_[i]);
+  }
+
+  static void perform_request(int descriptor, file_base::read_request& r)
+  {
+    r.bytes_transferred = descriptor_ops::sync_read_at1(descriptor, 0,
+        r.offset, r.buffer.data(), r.buffer.size(), r.error);
+  }
+
+  static void perform_request(int descriptor, file_base::write_request& r)
+  {
+    r.bytes_transferred = descriptor_ops::sync_write_at1(descriptor, 0,
+        r.offset, r.buffer.data(), r.buffer.size(), r.error);
+  }
+
+  Request* requests_;
+  std::size_t count_;
+  chunk* chunks_;
+  atomic_count outstanding_;
+  bool abandoned_;
+};
+
+template <typename Request, typename Handler, typename IoExecutor>
+class thread_pool_file_batch_op
+  : public thread_pool_file_batch_op_base<Request>
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(thread_pool_file_batch_op);
+
+  thread_pool_file_batch_op(
+      const std::shared_ptr<thread_pool_file_state>& file, scheduler& sched,
+      Request* requests, std::size_t count,
+      Handler& handler, const IoExecutor& io_ex)
+    : thread_pool_file_batch_op_base<Request>(file, sched,
+        requests, count, &thread_pool_file_batch_op::do_complete),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    ASIO_ASSUME(base != 0);
+    thread_pool_file_batch_op* o(
+        static_cast<thread_pool_file_batch_op*>(base));
+
+    // The undivided operation is being run on a worker thread. Time to
+    // perform the requests.
+    if (o->perform_on_worker(owner))
+      return;
+
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    if (owner)
+      o->gather_results();
+
+    ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_THREAD_POOL_FILE)
+
+#endif // ASIO_DETAIL_THREAD_POOL_FILE_BATCH_OP_HPP
@@ -0,0 +1,196 @@
+//
+// detail/thread_pool_file_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_THREAD_POOL_FILE_OP_HPP
+#define ASIO_DETAIL_THREAD_POOL_FILE_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_THREAD_POOL_FILE)
+
+#include "asio/detail/descriptor_ops.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/operation.hpp"
+#include "asio/detail/scheduler.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// The state of an open file that is shared with the file's outstanding
+// operations. A descriptor that is closed while operations are using it is
+// not closed until the last of them finishes, so that a worker thread never
+// performs an operation on a descriptor that has been reused.
+class thread_pool_file_state
+  : private noncopyable
+{
+public:
+  explicit thread_pool_file_state(int descriptor)
+    : descriptor_(descriptor),
+      generation_(0),
+      running_(0),
+      closing_(false)
+  {
+  }
+
+  // Get the current generation. Operations started before a cancellation
+  // belong to an earlier generation.
+  unsigned long generation()
+  {
+    mutex::scoped_lock lock(mutex_);
+    return generation_;
+  }
+
+  // Begin performing an operation, returning the descriptor to use. Returns -1
+  // if the operation has been cancelled or the file has been closed.
+  int begin(unsigned long generation)
+  {
+    mutex::scoped_lock lock(mutex_);
+    if (closing_ || generation != generation_)
+      return -1;
+    ++running_;
+    return descriptor_;
+  }
+
+  // Finish performing an operation.
+  void end()
+  {
+    mutex::scoped_lock lock(mutex_);
+    if (--running_ == 0 && closing_ && descriptor_ != -1)
+    {
+      descriptor_ops::state_type state = 0;
+      asio::error_code ignored_ec;
+      descriptor_ops::close(descriptor_, state, ignored_ec);
+      descriptor_ = -1;
+    }
+  }
+
+  // Cause operations that have not yet begun to fail with operation_aborted.
+  void cancel()
+  {
+    mutex::scoped_lock lock(mutex_);
+    ++generation_;
+  }
+
+  // Close the descriptor, or defer closing it until the running operations
+  // have finished.
+  asio::error_code close(asio::error_code& ec)
+  {
+    mutex::scoped_lock lock(mutex_);
+    closing_ = true;
+    ++generation_;
+    if (running_ == 0 && descriptor_ != -1)
+    {
+      descriptor_ops::state_type state = 0;
+      descriptor_ops::close(descriptor_, state, ec);
+      descriptor_ = -1;
+    }
+    else
+      asio::error::clear(ec);
+    return ec;
+  }
+
+  // Release ownership of the descriptor.
+  int release()
+  {
+    mutex::scoped_lock lock(mutex_);
+    closing_ = true;
+    ++generation_;
+    int descriptor = descriptor_;
+    descriptor_ = -1;
+    return descriptor;
+  }
+
+private:
+  mutex mutex_;
+  int descriptor_;
+  unsigned long generation_;
+  std::size_t running_;
+  bool closing_;
+};
+
+// An operation that is performed on a worker thread and then passed back to
+// the owning scheduler for completion.
+class thread_pool_file_op
+  : public operation
+{
+public:
+  // The error code to be passed to the completion handler.
+  asio::error_code ec_;
+
+  // The number of bytes transferred, to be passed to the completion handler.
+  std::size_t bytes_transferred_;
+
+  // Perform the blocking part of the operation.
+  void perform()
+  {
+    int descriptor = file_->begin(generation_);
+    if (descriptor == -1)
+    {
+      ec_ = asio::error::operation_aborted;
+      return;
+    }
+
+    perform_func_(this, descriptor);
+    file_->end();
+  }
+
+protected:
+  typedef void (*perform_func_type)(thread_pool_file_op*, int);
+
+  thread_pool_file_op(const std::shared_ptr<thread_pool_file_state>& file,
+      scheduler& sched, perform_func_type perform_func,
+      func_type complete_func)
+    : operation(complete_func),
+      bytes_transferred_(0),
+      file_(file),
+      generation_(file ? file->generation() : 0),
+      scheduler_(sched),
+      perform_func_(perform_func)
+  {
+  }
+
+  // If the operation is being run by a worker thread, perform it and pass it
+  // back to the owning scheduler for completion.
+  bool perform_on_worker(void* owner)
+  {
+    if (owner && owner != &scheduler_)
+    {
+      perform();
+      scheduler_.post_deferred_completion(this);
+      return true;
+    }
+    return false;
+  }
+
+  std::shared_ptr<thread_pool_file_state> file_;
+  unsigned long generation_;
+  scheduler& scheduler_;
+
+private:
+  perform_func_type perform_func_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_THREAD_POOL_FILE)
+
+#endif // ASIO_DETAIL_THREAD_POOL_FILE_OP_HPP
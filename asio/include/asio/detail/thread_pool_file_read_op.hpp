@@ -0,0 +1,166 @@
+//
+// detail/thread_pool_file_read_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_THREAD_POOL_FILE_READ_OP_HPP
+#define ASIO_DETAIL_THREAD_POOL_FILE_READ_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_THREAD_POOL_FILE)
+
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/descriptor_ops.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/thread_pool_file_op.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename MutableBufferSequence>
+class thread_pool_file_read_op_base : public thread_pool_file_op
+{
+public:
+  thread_pool_file_read_op_base(
+      const std::shared_ptr<thread_pool_file_state>& file, scheduler& sched,
+      bool is_stream, uint64_t offset, std::size_t readahead,
+      const MutableBufferSequence& buffers, func_type complete_func)
+    : thread_pool_file_op(file, sched,
+        &thread_pool_file_read_op_base::do_perform, complete_func),
+      is_stream_(is_stream),
+      offset_(offset),
+      readahead_(readahead),
+      buffers_(buffers)
+  {
+  }
+
+  static void do_perform(thread_pool_file_op* base, int descriptor)
+  {
+    ASIO_ASSUME(base != 0);
+    thread_pool_file_read_op_base* o(
+        static_cast<thread_pool_file_read_op_base*>(base));
+
+    typedef buffer_sequence_adapter<asio::mutable_buffer,
+        MutableBufferSequence> bufs_type;
+
+    bufs_type bufs(o->buffers_);
+    if (o->is_stream_)
+    {
+      o->bytes_transferred_ = descriptor_ops::sync_read(descriptor, 0,
+          bufs.buffers(), bufs.count(), bufs.all_empty(), o->ec_);
+    }
+    else
+    {
+      o->bytes_transferred_ = descriptor_ops::sync_read_at(descriptor, 0,
+          o->offset_, bufs.buffers(), bufs.count(), bufs.all_empty(), o->ec_);
+    }
+
+    // Start reading the data that follows into the page cache, so that it is
+    // available when the next read is performed.
+    if (o->readahead_ > 0 && o->bytes_transferred_ > 0)
+    {
+      descriptor_ops::readahead(descriptor, o->is_stream_,
+          o->offset_ + o->bytes_transferred_, o->readahead_);
+    }
+  }
+
+private:
+  bool is_stream_;
+  uint64_t offset_;
+  std::size_t readahead_;
+  MutableBufferSequence buffers_;
+};
+
+template <typename MutableBufferSequence, typename Handler, typename IoExecutor>
+class thread_pool_file_read_op
+  : public thread_pool_file_read_op_base<MutableBufferSequence>
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(thread_pool_file_read_op);
+
+  thread_pool_file_read_op(
+      const std::shared_ptr<thread_pool_file_state>& file, scheduler& sched,
+      bool is_stream, uint64_t offset, std::size_t readahead,
+      const MutableBufferSequence& buffers,
+      Handler& handler, const IoExecutor& io_ex)
+    : thread_pool_file_read_op_base<MutableBufferSequence>(file, sched,
+        is_stream, offset, readahead, buffers,
+        &thread_pool_file_read_op::do_complete),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    ASIO_ASSUME(base != 0);
+    thread_pool_file_read_op* o(static_cast<thread_pool_file_read_op*>(base));
+
+    // The operation is being run on a worker thread. Time to perform the read.
+    if (o->perform_on_worker(owner))
+      return;
+
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_THREAD_POOL_FILE)
+
+#endif // ASIO_DETAIL_THREAD_POOL_FILE_READ_OP_HPP
@@ -0,0 +1,493 @@
+//
+// detail/thread_pool_file_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_THREAD_POOL_FILE_SERVICE_HPP
+#define ASIO_DETAIL_THREAD_POOL_FILE_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_THREAD_POOL_FILE)
+
+#include <string>
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/descriptor_ops.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/scheduler.hpp"
+#include "asio/detail/thread_group.hpp"
+#include "asio/detail/thread_pool_file_batch_op.hpp"
+#include "asio/detail/thread_pool_file_op.hpp"
+#include "asio/detail/thread_pool_file_read_op.hpp"
+#include "asio/detail/thread_pool_file_sync_op.hpp"
+#include "asio/detail/thread_pool_file_write_op.hpp"
+#include "asio/error.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/file_base.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Provide file support by performing blocking operations on a private pool of
+// worker threads. The operations' handlers are completed by the owning
+// scheduler.
+class thread_pool_file_service :
+  public execution_context_service_base<thread_pool_file_service>
+{
+public:
+  // The native type of a file.
+  typedef int native_handle_type;
+
+  // The implementation type of the file.
+  class implementation_type
+    : private asio::detail::noncopyable
+  {
+  public:
+    // Default constructor.
+    implementation_type()
+      : descriptor_(-1),
+        is_stream_(false)
+    {
+    }
+
+  private:
+    // Only this service will have access to the internal values.
+    friend class thread_pool_file_service;
+
+    // The native descriptor representation.
+    int descriptor_;
+
+    // The state shared with the file's outstanding operations.
+    std::shared_ptr<thread_pool_file_state> file_;
+
+    // Whether the file is stream-oriented.
+    bool is_stream_;
+  };
+
+  ASIO_DECL thread_pool_file_service(execution_context& context);
+
+  // Destructor.
+  ASIO_DECL ~thread_pool_file_service();
+
+  // Destroy all user-defined handler objects owned by the service.
+  ASIO_DECL void shutdown();
+
+  // Perform any fork-related housekeeping.
+  ASIO_DECL void notify_fork(execution_context::fork_event fork_ev);
+
+  // Construct a new file implementation.
+  void construct(implementation_type& impl)
+  {
+    impl.descriptor_ = -1;
+    impl.is_stream_ = false;
+  }
+
+  // Move-construct a new file implementation.
+  void move_construct(implementation_type& impl,
+      implementation_type& other_impl)
+  {
+    impl.descriptor_ = other_impl.descriptor_;
+    other_impl.descriptor_ = -1;
+    impl.file_ = static_cast<std::shared_ptr<thread_pool_file_state>&&>(
+        other_impl.file_);
+    impl.is_stream_ = other_impl.is_stream_;
+  }
+
+  // Move-assign from another file implementation.
+  void move_assign(implementation_type& impl,
+      thread_pool_file_service& /*other_service*/,
+      implementation_type& other_impl)
+  {
+    destroy(impl);
+    move_construct(impl, other_impl);
+  }
+
+  // Destroy a file implementation.
+  void destroy(implementation_type& impl)
+  {
+    asio::error_code ignored_ec;
+    close(impl, ignored_ec);
+  }
+
+  // Open the file using the specified path name.
+  ASIO_DECL asio::error_code open(implementation_type& impl,
+      const char* path, file_base::flags open_flags,
+      asio::error_code& ec);
+
+  // Assign a native descriptor to a file implementation.
+  ASIO_DECL asio::error_code assign(implementation_type& impl,
+      const native_handle_type& native_descriptor,
+      asio::error_code& ec);
+
+  // Set whether the implementation is stream-oriented.
+  void set_is_stream(implementation_type& impl, bool is_stream)
+  {
+    impl.is_stream_ = is_stream;
+  }
+
+  // Determine whether the file is open.
+  bool is_open(const implementation_type& impl) const
+  {
+    return impl.descriptor_ != -1;
+  }
+
+  // Destroy a file implementation.
+  ASIO_DECL asio::error_code close(implementation_type& impl,
+      asio::error_code& ec);
+
+  // Get the native file representation.
+  native_handle_type native_handle(const implementation_type& impl) const
+  {
+    return impl.descriptor_;
+  }
+
+  // Release ownership of the native descriptor representation.
+  ASIO_DECL native_handle_type release(implementation_type& impl,
+      asio::error_code& ec);
+
+  // Cancel all operations associated with the file.
+  ASIO_DECL asio::error_code cancel(implementation_type& impl,
+      asio::error_code& ec);
+
+  // Get the size of the file.
+  ASIO_DECL uint64_t size(const implementation_type& impl,
+      asio::error_code& ec) const;
+
+  // Alter the size of the file.
+  ASIO_DECL asio::error_code resize(implementation_type& impl,
+      uint64_t n, asio::error_code& ec);
+
+  // Synchronise the file to disk.
+  ASIO_DECL asio::error_code sync_all(implementation_type& impl,
+      asio::error_code& ec);
+
+  // Synchronise the file data to disk.
+  ASIO_DECL asio::error_code sync_data(implementation_type& impl,
+      asio::error_code& ec);
+
+  // Seek to a position in the file.
+  ASIO_DECL uint64_t seek(implementation_type& impl, int64_t offset,
+      file_base::seek_basis whence, asio::error_code& ec);
+
+  // Write the given data. Returns the number of bytes written.
+  template <typename ConstBufferSequence>
+  size_t write_some(implementation_type& impl,
+      const ConstBufferSequence& buffers, asio::error_code& ec)
+  {
+    typedef buffer_sequence_adapter<asio::const_buffer,
+        ConstBufferSequence> bufs_type;
+
+    bufs_type bufs(buffers);
+    return descriptor_ops::sync_write(impl.descriptor_, 0,
+        bufs.buffers(), bufs.count(), bufs.all_empty(), ec);
+  }
+
+  // Start an asynchronous write. The data being written must be valid for the
+  // lifetime of the asynchronous operation.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_write_some(implementation_type& impl,
+      const ConstBufferSequence& buffers,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    start_write_op(impl, true, 0, buffers,
+        handler, io_ex, "async_write_some");
+  }
+
+  // Write the given data at the specified location. Returns the number of
+  // bytes written.
+  template <typename ConstBufferSequence>
+  size_t write_some_at(implementation_type& impl, uint64_t offset,
+      const ConstBufferSequence& buffers, asio::error_code& ec)
+  {
+    typedef buffer_sequence_adapter<asio::const_buffer,
+        ConstBufferSequence> bufs_type;
+
+    bufs_type bufs(buffers);
+    return descriptor_ops::sync_write_at(impl.descriptor_, 0,
+        offset, bufs.buffers(), bufs.count(), bufs.all_empty(), ec);
+  }
+
+  // Start an asynchronous write at the specified location. The data being
+  // written must be valid for the lifetime of the asynchronous operation.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_write_some_at(implementation_type& impl,
+      uint64_t offset, const ConstBufferSequence& buffers,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    start_write_op(impl, false, offset, buffers,
+        handler, io_ex, "async_write_some_at");
+  }
+
+  // Read some data. Returns the number of bytes read.
+  template <typename MutableBufferSequence>
+  size_t read_some(implementation_type& impl,
+      const MutableBufferSequence& buffers, asio::error_code& ec)
+  {
+    typedef buffer_sequence_adapter<asio::mutable_buffer,
+        MutableBufferSequence> bufs_type;
+
+    bufs_type bufs(buffers);
+    return descriptor_ops::sync_read(impl.descriptor_, 0,
+        bufs.buffers(), bufs.count(), bufs.all_empty(), ec);
+  }
+
+  // Start an asynchronous read. The buffer for the data being read must be
+  // valid for the lifetime of the asynchronous operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_read_some(implementation_type& impl,
+      const MutableBufferSequence& buffers,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    start_read_op(impl, true, 0, buffers,
+        handler, io_ex, "async_read_some");
+  }
+
+  // Read some data. Returns the number of bytes read.
+  template <typename MutableBufferSequence>
+  size_t read_some_at(implementation_type& impl, uint64_t offset,
+      const MutableBufferSequence& buffers, asio::error_code& ec)
+  {
+    typedef buffer_sequence_adapter<asio::mutable_buffer,
+        MutableBufferSequence> bufs_type;
+
+    bufs_type bufs(buffers);
+    return descriptor_ops::sync_read_at(impl.descriptor_, 0,
+        offset, bufs.buffers(), bufs.count(), bufs.all_empty(), ec);
+  }
+
+  // Start an asynchronous read. The buffer for the data being read must be
+  // valid for the lifetime of the asynchronous operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_read_some_at(implementation_type& impl,
+      uint64_t offset, const MutableBufferSequence& buffers,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    start_read_op(impl, false, offset, buffers,
+        handler, io_ex, "async_read_some_at");
+  }
+
+  // Start an asynchronous batch of reads. The requests and their buffers must
+  // be valid for the lifetime of the asynchronous operation.
+  template <typename Handler, typename IoExecutor>
+  void async_read_batch_at(implementation_type& impl,
+      file_base::read_request* requests, std::size_t count,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    start_batch_op(impl, requests, count,
+        handler, io_ex, "async_read_batch_at");
+  }
+
+  // Start an asynchronous batch of writes. The requests and their buffers must
+  // be valid for the lifetime of the asynchronous operation.
+  template <typename Handler, typename IoExecutor>
+  void async_write_batch_at(implementation_type& impl,
+      file_base::write_request* requests, std::size_t count,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    start_batch_op(impl, requests, count,
+        handler, io_ex, "async_write_batch_at");
+  }
+
+  // Start an asynchronous synchronisation of the file to disk.
+  template <typename Handler, typename IoExecutor>
+  void async_sync_all(implementation_type& impl,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    start_sync_op(impl, descriptor_ops::sync_all_type, 0, 0,
+        handler, io_ex, "async_sync_all");
+  }
+
+  // Start an asynchronous synchronisation of the file data to disk.
+  template <typename Handler, typename IoExecutor>
+  void async_sync_data(implementation_type& impl,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    start_sync_op(impl, descriptor_ops::sync_data_type, 0, 0,
+        handler, io_ex, "async_sync_data");
+  }
+
+  // Start an asynchronous synchronisation of a range of the file to disk.
+  template <typename Handler, typename IoExecutor>
+  void async_sync_range(implementation_type& impl, uint64_t offset,
+      uint64_t size, Handler& handler, const IoExecutor& io_ex)
+  {
+    start_sync_op(impl, descriptor_ops::sync_range_type, offset, size,
+        handler, io_ex, "async_sync_range");
+  }
+
+private:
+  // Allocate and start a read operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void start_read_op(implementation_type& impl, bool is_stream,
+      uint64_t offset, const MutableBufferSequence& buffers,
+      Handler& handler, const IoExecutor& io_ex, const char* op_name)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef thread_pool_file_read_op<
+        MutableBufferSequence, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(impl.file_, scheduler_, is_stream,
+        offset, readahead_, buffers, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((scheduler_.context(), *p.p, "file",
+          &impl, impl.descriptor_, op_name));
+    (void)op_name;
+
+    start_op(impl, p.p, is_continuation);
+    p.v = p.p = 0;
+  }
+
+  // Allocate and start a write operation.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void start_write_op(implementation_type& impl, bool is_stream,
+      uint64_t offset, const ConstBufferSequence& buffers,
+      Handler& handler, const IoExecutor& io_ex, const char* op_name)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef thread_pool_file_write_op<
+        ConstBufferSequence, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(impl.file_, scheduler_,
+        is_stream, offset, buffers, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((scheduler_.context(), *p.p, "file",
+          &impl, impl.descriptor_, op_name));
+    (void)op_name;
+
+    start_op(impl, p.p, is_continuation);
+    p.v = p.p = 0;
+  }
+
+  // Allocate and start a batch operation.
+  template <typename Request, typename Handler, typename IoExecutor>
+  void start_batch_op(implementation_type& impl, Request* requests,
+      std::size_t count, Handler& handler, const IoExecutor& io_ex,
+      const char* op_name)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef thread_pool_file_batch_op<Request, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(impl.file_, scheduler_,
+        requests, count, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((scheduler_.context(), *p.p, "file",
+          &impl, impl.descriptor_, op_name));
+    (void)op_name;
+
+    if (impl.file_ && count > 1 && scheduler_locking_)
+    {
+      // Divide the batch between the worker threads.
+      std::size_t n = p.p->divide(num_work_threads_);
+      start_work_threads();
+      scheduler_.work_started();
+      for (std::size_t i = 0; i < n; ++i)
+        work_scheduler_.post_immediate_completion(p.p->chunk_at(i), false);
+    }
+    else
+    {
+      start_op(impl, p.p, is_continuation);
+    }
+    p.v = p.p = 0;
+  }
+
+  // Allocate and start a synchronisation operation.
+  template <typename Handler, typename IoExecutor>
+  void start_sync_op(implementation_type& impl,
+      descriptor_ops::sync_type type, uint64_t offset, uint64_t size,
+      Handler& handler, const IoExecutor& io_ex, const char* op_name)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef thread_pool_file_sync_op<Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(impl.file_, scheduler_,
+        type, offset, size, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((scheduler_.context(), *p.p, "file",
+          &impl, impl.descriptor_, op_name));
+    (void)op_name;
+
+    start_op(impl, p.p, is_continuation);
+    p.v = p.p = 0;
+  }
+
+  // Start an operation on a worker thread.
+  ASIO_DECL void start_op(implementation_type& impl,
+      thread_pool_file_op* op, bool is_continuation);
+
+  // Helper class to run the work scheduler in a thread.
+  class work_scheduler_runner;
+
+  // Start the work threads if they're not already running.
+  ASIO_DECL void start_work_threads();
+
+  // The scheduler used to complete operations.
+  scheduler& scheduler_;
+
+  // Mutex to protect access to internal data.
+  asio::detail::mutex mutex_;
+
+  // Private scheduler used for performing blocking file operations.
+  scheduler work_scheduler_;
+
+  // Threads used for running the work scheduler's run loop.
+  thread_group<execution_context::allocator<void>> work_threads_;
+
+  // The number of threads used to run the work scheduler.
+  unsigned int num_work_threads_;
+
+  // The number of bytes to read ahead after each read.
+  std::size_t readahead_;
+
+  // Whether the scheduler locking is enabled.
+  bool scheduler_locking_;
+
+  // Whether the service has been shut down.
+  bool shutdown_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/thread_pool_file_service.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // defined(ASIO_HAS_THREAD_POOL_FILE)
+
+#endif // ASIO_DETAIL_THREAD_POOL_FILE_SERVICE_HPP
@@ -0,0 +1,138 @@
+//
+// detail/thread_pool_file_sync_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_THREAD_POOL_FILE_SYNC_OP_HPP
+#define ASIO_DETAIL_THREAD_POOL_FILE_SYNC_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_THREAD_POOL_FILE)
+
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/descriptor_ops.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/thread_pool_file_op.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class thread_pool_file_sync_op_base : public thread_pool_file_op
+{
+public:
+  thread_pool_file_sync_op_base(
+      const std::shared_ptr<thread_pool_file_state>& file, scheduler& sched,
+      descriptor_ops::sync_type type, uint64_t offset, uint64_t size,
+      func_type complete_func)
+    : thread_pool_file_op(file, sched,
+        &thread_pool_file_sync_op_base::do_perform, complete_func),
+      type_(type),
+      offset_(offset),
+      size_(size)
+  {
+  }
+
+  static void do_perform(thread_pool_file_op* base, int descriptor)
+  {
+    ASIO_ASSUME(base != 0);
+    thread_pool_file_sync_op_base* o(
+        static_cast<thread_pool_file_sync_op_base*>(base));
+
+    descriptor_ops::sync(descriptor, o->type_, o->offset_, o->size_, o->ec_);
+  }
+
+private:
+  descriptor_ops::sync_type type_;
+  uint64_t offset_;
+  uint64_t size_;
+};
+
+template <typename Handler, typename IoExecutor>
+class thread_pool_file_sync_op : public thread_pool_file_sync_op_base
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(thread_pool_file_sync_op);
+
+  thread_pool_file_sync_op(
+      const std::shared_ptr<thread_pool_file_state>& file, scheduler& sched,
+      descriptor_ops::sync_type type, uint64_t offset, uint64_t size,
+      Handler& handler, const IoExecutor& io_ex)
+    : thread_pool_file_sync_op_base(file, sched, type, offset, size,
+        &thread_pool_file_sync_op::do_complete),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    ASIO_ASSUME(base != 0);
+    thread_pool_file_sync_op* o(static_cast<thread_pool_file_sync_op*>(base));
+
+    // The operation is being run on a worker thread. Time to synchronise.
+    if (o->perform_on_worker(owner))
+      return;
+
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder1<Handler, asio::error_code>
+      handler(o->handler_, o->ec_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_THREAD_POOL_FILE)
+
+#endif // ASIO_DETAIL_THREAD_POOL_FILE_SYNC_OP_HPP
@@ -24,6 +24,7 @@
 #include "asio/detail/completion_payload.hpp"
 #include "asio/detail/completion_payload_handler.hpp"
 #include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/linked_timeout.hpp"
 #include "asio/detail/type_traits.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -54,7 +55,8 @@ public:
       cancellation_type_(cancel_type),
       cancel_proxy_(nullptr),
       has_payload_(false),
-      has_pending_timer_wait_(true)
+      has_pending_timer_wait_(true),
+      has_linked_timeout_(false)
   {
   }
 
@@ -76,22 +78,53 @@ public:
       timed_cancel_op_handler<timed_cancel_op, Signatures...>;
     op_handler_type op_handler(this);
 
-    using timer_handler_type =
-      timed_cancel_timer_handler<timed_cancel_op>;
-    timer_handler_type timer_handler(this);
-
     associated_cancellation_slot_t<Handler> slot
       = (get_associated_cancellation_slot)(handler_);
     if (slot.is_connected())
       cancel_proxy_ = &slot.template emplace<cancel_proxy>(this);
 
-    timer_.async_wait(static_cast<timer_handler_type&&>(timer_handler));
+    if (start_linked_timeout(supports_linked_timeout<decay_t<Initiation>>()))
+    {
+      // The operation applies the timeout itself, so the timer is never
+      // started and there is no timer handler to share the state.
+      has_pending_timer_wait_ = false;
+      --ref_count_;
+    }
+    else
+    {
+      using timer_handler_type =
+        timed_cancel_timer_handler<timed_cancel_op>;
+      timer_.async_wait(timer_handler_type(this));
+    }
+
     async_initiate<op_handler_type, Signatures...>(
         static_cast<Initiation&&>(initiation),
         static_cast<op_handler_type&>(op_handler),
         static_cast<Args&&>(args)...);
   }
 
+  bool get_linked_timeout(
+      chrono::steady_clock::time_point& deadline) const noexcept
+  {
+    deadline = linked_timeout_;
+    return has_linked_timeout_;
+  }
+
+  // Called by an operation that cannot apply the linked timeout, before the
+  // operation has been started. The timer is used instead.
+  void decline_linked_timeout()
+  {
+    if (has_linked_timeout_)
+    {
+      has_linked_timeout_ = false;
+      has_pending_timer_wait_ = true;
+      ++ref_count_;
+      using timer_handler_type =
+        timed_cancel_timer_handler<timed_cancel_op>;
+      timer_.async_wait(timer_handler_type(this));
+    }
+  }
+
   template <typename Message>
   void handle_op(Message&& message)
   {
@@ -155,6 +188,31 @@ public:
 //private:
   typedef completion_payload<Signatures...> payload_type;
 
+  bool start_linked_timeout(false_type)
+  {
+    return false;
+  }
+
+  bool start_linked_timeout(true_type)
+  {
+    typedef remove_reference_t<Timer> timer_type;
+
+    // A linked timeout cancels the operation as a terminal cancellation would,
+    // so other cancellation types must still be delivered via the timer.
+    if (!(cancellation_type_ & (cancellation_type::terminal
+            | cancellation_type::partial | cancellation_type::total)))
+      return false;
+
+    if (timer_.expiry() == (timer_type::time_point::max)())
+      return false;
+
+    linked_timeout_ = chrono::steady_clock::now()
+      + chrono::duration_cast<chrono::steady_clock::duration>(
+          timer_.expiry() - timer_type::clock_type::now());
+    has_linked_timeout_ = true;
+    return true;
+  }
+
   struct cancel_proxy
   {
     cancel_proxy(timed_cancel_op* op)
@@ -202,6 +260,10 @@ public:
 
   // Whether the asynchronous wait on the timer is still pending
   bool has_pending_timer_wait_;
+
+  // The absolute deadline applied by the operation in place of the timer.
+  chrono::steady_clock::time_point linked_timeout_;
+  bool has_linked_timeout_;
 };
 
 template <typename Op, typename R, typename... Args>
@@ -306,6 +368,22 @@ public:
   Op* op_;
 };
 
+template <typename Op, typename... Signatures>
+struct linked_timeout<timed_cancel_op_handler<Op, Signatures...>>
+{
+  static bool get(const timed_cancel_op_handler<Op, Signatures...>& h,
+      chrono::steady_clock::time_point& deadline) noexcept
+  {
+    return h.op_ ? h.op_->get_linked_timeout(deadline) : false;
+  }
+
+  static void decline(timed_cancel_op_handler<Op, Signatures...>& h)
+  {
+    if (h.op_)
+      h.op_->decline_linked_timeout();
+  }
+};
+
 } // namespace detail
 
 template <template <typename, typename> class Associator,
@@ -0,0 +1,138 @@
+//
+// detail/timeout_timer_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_TIMEOUT_TIMER_OP_HPP
+#define ASIO_DETAIL_TIMEOUT_TIMER_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/bind_allocator.hpp"
+#include "asio/cancellation_type.hpp"
+#include "asio/error.hpp"
+#include "asio/frame_slot.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// The state of a basic_timeout_timer. It is shared with the wait operation, so
+// that an operation completing after the timer has been destroyed does not
+// refer to the timer object.
+template <typename Clock, typename WaitTraits, typename Executor>
+class timeout_timer_state
+  : private noncopyable
+{
+public:
+  typedef typename Clock::time_point time_point;
+
+  template <typename Arg>
+  explicit timeout_timer_state(Arg& arg)
+    : timer_(arg),
+      expiry_(),
+      cancellations_(0)
+  {
+  }
+
+  // The underlying timer. It is only moved to the current expiry time when a
+  // wait starts, when it fires early, or when the expiry time is brought
+  // forward.
+  basic_waitable_timer<Clock, WaitTraits, Executor> timer_;
+
+  // The expiry time of the timeout.
+  time_point expiry_;
+
+  // Counts the calls to cancel(), so that a wait may tell a cancellation apart
+  // from the underlying timer being moved.
+  std::size_t cancellations_;
+
+  // Memory for the underlying timer's wait operation, which is reused by each
+  // wait.
+  frame_slot slot_;
+};
+
+template <typename Clock, typename WaitTraits, typename Executor>
+class timeout_timer_wait_op
+{
+public:
+  typedef timeout_timer_state<Clock, WaitTraits, Executor> state_type;
+
+  explicit timeout_timer_wait_op(const shared_ptr<state_type>& state)
+    : state_(state),
+      cancellations_(state->cancellations_),
+      started_(false)
+  {
+  }
+
+  template <typename Self>
+  void operator()(Self& self, asio::error_code ec = asio::error_code())
+  {
+    if (started_)
+    {
+      if (ec == asio::error::operation_aborted)
+      {
+        // The underlying timer is also cancelled when the expiry time is
+        // brought forward, in which case the wait continues.
+        if (self.cancelled() != cancellation_type::none
+            || state_->cancellations_ != cancellations_)
+        {
+          complete(self, ec);
+          return;
+        }
+      }
+      else if (ec || !(Clock::now() < state_->expiry_))
+      {
+        complete(self, ec);
+        return;
+      }
+      else if (state_->cancellations_ != cancellations_)
+      {
+        // The timer was cancelled after the underlying timer fired early.
+        complete(self, asio::error::operation_aborted);
+        return;
+      }
+    }
+
+    // Wait until the current expiry time, which may have been pushed back
+    // since the underlying timer was last set.
+    started_ = true;
+    if (state_->timer_.expiry() != state_->expiry_)
+      state_->timer_.expires_at(state_->expiry_);
+    state_->timer_.async_wait(
+        asio::bind_allocator(state_->slot_.get_allocator(),
+          static_cast<Self&&>(self)));
+  }
+
+private:
+  template <typename Self>
+  void complete(Self& self, const asio::error_code& ec)
+  {
+    state_.reset();
+    self.complete(ec);
+  }
+
+  shared_ptr<state_type> state_;
+  std::size_t cancellations_;
+  bool started_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_TIMEOUT_TIMER_OP_HPP
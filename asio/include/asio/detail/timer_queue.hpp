@@ -23,6 +23,7 @@
 #include "asio/detail/limits.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/timer_queue_base.hpp"
+#include "asio/detail/usdt_probes.hpp"
 #include "asio/detail/wait_op.hpp"
 #include "asio/error.hpp"
 
@@ -31,7 +32,7 @@
 namespace asio {
 namespace detail {
 
-template <typename TimeTraits, typename Allocator>
+template <typename TimeTraits, typename Allocator, bool>
 class timer_queue
   : public timer_queue_base
 {
@@ -47,17 +48,31 @@ public:
   {
   public:
     per_timer_data() :
+      expiry_(), slack_(),
       heap_index_((std::numeric_limits<std::size_t>::max)()),
       next_(0), prev_(0)
     {
     }
 
+    // Set the amount of time by which completion of the timer may be delayed.
+    // Takes effect when the timer is next added to the queue.
+    void set_slack(const duration_type& slack)
+    {
+      slack_ = slack;
+    }
+
   private:
     friend class timer_queue;
 
     // The operations waiting on the timer.
     op_queue<wait_op> op_queue_;
 
+    // The earliest time at which the timer may complete.
+    time_type expiry_;
+
+    // The amount of time by which completion of the timer may be delayed.
+    duration_type slack_;
+
     // The index of the timer in the heap.
     std::size_t heap_index_;
 
@@ -78,6 +93,11 @@ public:
   // Add a new timer to the queue. Returns true if this is the timer that is
   // earliest in the queue, in which case the reactor's event demultiplexing
   // function call may need to be interrupted and restarted.
+  //
+  // The heap is ordered by the latest time at which each timer may complete,
+  // i.e. its expiry time plus slack. When woken, the queue completes timers in
+  // heap order until it finds one whose expiry time has not yet been reached,
+  // so that timers with slack are batched with those that fall due earlier.
   bool enqueue_timer(const time_type& time, per_timer_data& timer, wait_op* op)
   {
     // Enqueue the timer object.
@@ -92,8 +112,11 @@ public:
       {
         // Put the new timer at the correct position in the heap. This is done
         // first since push_back() can throw due to allocation failure.
+        timer.expiry_ = time;
         timer.heap_index_ = heap_.size();
-        heap_entry entry = { time, &timer };
+        heap_entry entry = { TimeTraits::add(time, timer.slack_), &timer };
+        if (TimeTraits::less_than(entry.time_, time))
+          entry.time_ = time;
         heap_.push_back(entry);
         up_heap(heap_.size() - 1);
       }
@@ -119,6 +142,12 @@ public:
     return timers_ == 0;
   }
 
+  // Get the number of timers in the queue.
+  virtual std::size_t size() const
+  {
+    return heap_.size();
+  }
+
   // Get the time for the timer that is earliest in the queue.
   virtual long wait_duration_msec(long max_duration) const
   {
@@ -149,13 +178,16 @@ public:
     if (!heap_.empty())
     {
       const time_type now = TimeTraits::now();
-      while (!heap_.empty() && !TimeTraits::less_than(now, heap_[0].time_))
+      while (!heap_.empty()
+          && !TimeTraits::less_than(now, heap_[0].timer_->expiry_))
       {
         per_timer_data* timer = heap_[0].timer_;
         while (wait_op* op = timer->op_queue_.front())
         {
           timer->op_queue_.pop();
           op->ec_ = asio::error_code();
+          op->set_latency_ready();
+          ASIO_USDT_PROBE2(timer_fire, this, op);
           ops.push(op);
         }
         remove_timer(*timer);
@@ -228,6 +260,8 @@ public:
   {
     target.op_queue_.push(source.op_queue_);
 
+    target.expiry_ = source.expiry_;
+    target.slack_ = source.slack_;
     target.heap_index_ = source.heap_index_;
     source.heap_index_ = (std::numeric_limits<std::size_t>::max)();
 
@@ -372,7 +406,7 @@ private:
 
   struct heap_entry
   {
-    // The time when the timer should fire.
+    // The latest time when the timer should fire.
     time_type time_;
 
     // The associated timer with enqueued operations.
@@ -390,4 +424,6 @@ private:
 
 #include "asio/detail/pop_options.hpp"
 
+#include "asio/detail/timer_wheel_queue.hpp"
+
 #endif // ASIO_DETAIL_TIMER_QUEUE_HPP
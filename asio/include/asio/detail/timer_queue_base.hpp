@@ -16,9 +16,11 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <cstddef>
 #include "asio/detail/noncopyable.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/operation.hpp"
+#include "asio/detail/type_traits.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -38,6 +40,9 @@ public:
   // Whether there are no timers in the queue.
   virtual bool empty() const = 0;
 
+  // Get the number of timers in the queue.
+  virtual std::size_t size() const = 0;
+
   // Get the time to wait until the next timer.
   virtual long wait_duration_msec(long max_duration) const = 0;
 
@@ -57,7 +62,24 @@ private:
   timer_queue_base* next_;
 };
 
-template <typename TimeTraits, typename Allocator>
+// Determine the resolution, in microseconds, of the timer wheel that holds
+// the timers for the given time traits. A resolution of zero selects the
+// heap-based timer queue.
+template <typename TimeTraits, typename = void>
+struct timer_wheel_resolution
+  : integral_constant<long, 0>
+{
+};
+
+template <typename TimeTraits>
+struct timer_wheel_resolution<TimeTraits,
+    void_t<decltype(TimeTraits::timer_wheel_resolution)>>
+  : integral_constant<long, TimeTraits::timer_wheel_resolution>
+{
+};
+
+template <typename TimeTraits, typename Allocator,
+    bool = (timer_wheel_resolution<TimeTraits>::value > 0)>
 class timer_queue;
 
 } // namespace detail
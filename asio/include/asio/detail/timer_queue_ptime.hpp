@@ -66,6 +66,9 @@ public:
   // Whether there are no timers in the queue.
   ASIO_DECL virtual bool empty() const;
 
+  // Get the number of timers in the queue.
+  ASIO_DECL virtual std::size_t size() const;
+
   // Get the time for the timer that is earliest in the queue.
   ASIO_DECL virtual long wait_duration_msec(long max_duration) const;
 
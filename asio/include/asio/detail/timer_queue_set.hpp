@@ -38,6 +38,9 @@ public:
   // Determine whether all queues are empty.
   ASIO_DECL bool all_empty() const;
 
+  // Get the total number of timers in all queues.
+  ASIO_DECL std::size_t total_size() const;
+
   // Get the wait duration in milliseconds.
   ASIO_DECL long wait_duration_msec(long max_duration) const;
 
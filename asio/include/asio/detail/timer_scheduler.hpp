@@ -30,6 +30,8 @@
 # include "asio/detail/kqueue_reactor.hpp"
 #elif defined(ASIO_HAS_DEV_POLL)
 # include "asio/detail/dev_poll_reactor.hpp"
+#elif defined(ASIO_HAS_POLL)
+# include "asio/detail/poll_reactor.hpp"
 #else
 # include "asio/detail/select_reactor.hpp"
 #endif
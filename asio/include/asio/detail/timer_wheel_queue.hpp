@@ -0,0 +1,526 @@
+//
+// detail/timer_wheel_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_TIMER_WHEEL_QUEUE_HPP
+#define ASIO_DETAIL_TIMER_WHEEL_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/limits.hpp"
+#include "asio/detail/op_queue.hpp"
+#include "asio/detail/timer_queue_base.hpp"
+#include "asio/detail/usdt_probes.hpp"
+#include "asio/detail/wait_op.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Template specialisation for time traits that select a timer wheel. Timers
+// are held in a hierarchical timer wheel, where each level has 64 slots and
+// each slot of a level spans all 64 slots of the level below. A timer is put
+// in the level given by the most significant 6-bit group in which its expiry
+// tick differs from the current tick, so that scheduling and cancelling a
+// timer take constant time. As the current tick advances into a slot of a
+// higher level, that slot's timers are cascaded into the lower levels.
+// Occupancy bitmaps allow the current tick to skip directly to the next slot
+// that holds timers.
+//
+// Expiry times are rounded up to the resolution of the wheel, so timers never
+// fire early but may fire up to one resolution late.
+template <typename TimeTraits, typename Allocator>
+class timer_queue<TimeTraits, Allocator, true>
+  : public timer_queue_base
+{
+public:
+  // The time type.
+  typedef typename TimeTraits::time_type time_type;
+
+  // The duration type.
+  typedef typename TimeTraits::duration_type duration_type;
+
+  // Per-timer data.
+  class per_timer_data
+  {
+  public:
+    per_timer_data() :
+      slack_(), tick_(0),
+      slot_((std::numeric_limits<std::size_t>::max)()),
+      next_(0), prev_(0)
+    {
+    }
+
+    // Set the amount of time by which completion of the timer may be delayed.
+    // Takes effect when the timer is next added to the queue.
+    void set_slack(const duration_type& slack)
+    {
+      slack_ = slack;
+    }
+
+  private:
+    friend class timer_queue;
+
+    // The operations waiting on the timer.
+    op_queue<wait_op> op_queue_;
+
+    // The amount of time by which completion of the timer may be delayed.
+    duration_type slack_;
+
+    // The tick at which the timer expires.
+    uint64_t tick_;
+
+    // The index of the slot that holds the timer.
+    std::size_t slot_;
+
+    // Pointers to adjacent timers in the slot's linked list.
+    per_timer_data* next_;
+    per_timer_data* prev_;
+  };
+
+  // Constructor.
+  timer_queue(const Allocator&, std::size_t /*heap_reserve*/)
+    : epoch_(TimeTraits::now()),
+      current_tick_(0),
+      reported_tick_((std::numeric_limits<uint64_t>::max)()),
+      count_(0)
+  {
+    for (std::size_t i = 0; i < num_slots; ++i)
+      slots_[i] = 0;
+    for (std::size_t i = 0; i < num_levels; ++i)
+      occupied_[i] = 0;
+  }
+
+  // Add a new timer to the queue. Returns true if the new timer expires before
+  // the time last reported by wait_duration_msec() or wait_duration_usec(), in
+  // which case the reactor's event demultiplexing function call may need to be
+  // interrupted and restarted.
+  bool enqueue_timer(const time_type& time, per_timer_data& timer, wait_op* op)
+  {
+    // Enqueue the timer object.
+    if (timer.slot_ == no_slot)
+    {
+      // When the wheel is empty, bring the current tick up to date so that
+      // new timers are placed in the lowest possible level.
+      if (count_ == 0)
+        current_tick_ = ticks_until(TimeTraits::now(), false) + 1;
+
+      // Where slack permits, choose the tick with the most trailing zero bits
+      // so that timers with overlapping ranges tend to share a tick.
+      timer.tick_ = ticks_until(time, true);
+      uint64_t latest = ticks_until(TimeTraits::add(time, timer.slack_), false);
+      while (latest > timer.tick_ && (latest & (latest - 1)) >= timer.tick_)
+        latest &= latest - 1;
+      if (latest > timer.tick_)
+        timer.tick_ = latest;
+      link_timer(timer);
+      ++count_;
+    }
+
+    // Enqueue the individual timer operation.
+    timer.op_queue_.push(op);
+
+    // Interrupt reactor only if newly added timer expires before the reactor
+    // is next due to wake.
+    return timer.tick_ < reported_tick_ && timer.op_queue_.front() == op;
+  }
+
+  // Whether there are no timers in the queue.
+  virtual bool empty() const
+  {
+    return count_ == 0;
+  }
+
+  // Get the number of timers in the queue.
+  virtual std::size_t size() const
+  {
+    return count_;
+  }
+
+  // Get the time for the timer that is earliest in the queue.
+  virtual long wait_duration_msec(long max_duration) const
+  {
+    int64_t usec = 0;
+    if (!next_wait_usec(usec))
+      return max_duration;
+    int64_t msec = (usec + 999) / 1000;
+    return msec > max_duration ? max_duration : static_cast<long>(msec);
+  }
+
+  // Get the time for the timer that is earliest in the queue.
+  virtual long wait_duration_usec(long max_duration) const
+  {
+    int64_t usec = 0;
+    if (!next_wait_usec(usec))
+      return max_duration;
+    return usec > max_duration ? max_duration : static_cast<long>(usec);
+  }
+
+  // Dequeue all timers not later than the current time.
+  virtual void get_ready_timers(op_queue<operation>& ops)
+  {
+    if (count_ == 0)
+      return;
+
+    // Timers that had already expired when they were scheduled.
+    while (per_timer_data* timer = slots_[due_slot])
+      complete_timer(*timer, ops);
+
+    const uint64_t now_tick = ticks_until(TimeTraits::now(), false);
+    for (;;)
+    {
+      uint64_t tick = next_event_tick();
+      if (tick > now_tick)
+        break;
+
+      // Cascade the timers from any higher level slots that begin at this
+      // tick. Higher levels go first, as their timers may cascade into the
+      // lower level slots that also begin at this tick.
+      current_tick_ = tick;
+      for (std::size_t level = num_levels - 1; level > 0; --level)
+      {
+        if ((tick & level_mask(level)) == 0)
+        {
+          std::size_t slot = level * slots_per_level
+            + static_cast<std::size_t>(
+                (tick >> (level * level_bits)) & (slots_per_level - 1));
+          per_timer_data* timer = slots_[slot];
+          while (timer)
+          {
+            per_timer_data* next = timer->next_;
+            unlink_timer(*timer);
+            link_timer(*timer);
+            timer = next;
+          }
+        }
+      }
+
+      // Complete the timers that expire at this tick.
+      std::size_t slot = static_cast<std::size_t>(
+          tick & (slots_per_level - 1));
+      while (per_timer_data* timer = slots_[slot])
+        complete_timer(*timer, ops);
+
+      current_tick_ = tick + 1;
+    }
+
+    // No timers expire before the next event, so it is safe to skip ahead.
+    if (current_tick_ <= now_tick)
+      current_tick_ = now_tick + 1;
+  }
+
+  // Dequeue all timers.
+  virtual void get_all_timers(op_queue<operation>& ops)
+  {
+    for (std::size_t i = 0; i < num_slots; ++i)
+    {
+      while (per_timer_data* timer = slots_[i])
+      {
+        slots_[i] = timer->next_;
+        ops.push(timer->op_queue_);
+        timer->slot_ = no_slot;
+        timer->next_ = 0;
+        timer->prev_ = 0;
+      }
+    }
+
+    for (std::size_t i = 0; i < num_levels; ++i)
+      occupied_[i] = 0;
+    count_ = 0;
+  }
+
+  // Cancel and dequeue operations for the given timer.
+  std::size_t cancel_timer(per_timer_data& timer, op_queue<operation>& ops,
+      std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)())
+  {
+    std::size_t num_cancelled = 0;
+    if (timer.slot_ != no_slot)
+    {
+      while (wait_op* op = (num_cancelled != max_cancelled)
+          ? timer.op_queue_.front() : 0)
+      {
+        op->ec_ = asio::error::operation_aborted;
+        timer.op_queue_.pop();
+        ops.push(op);
+        ++num_cancelled;
+      }
+      if (timer.op_queue_.empty())
+        remove_timer(timer);
+    }
+    return num_cancelled;
+  }
+
+  // Cancel and dequeue a specific operation for the given timer.
+  void cancel_timer_by_key(per_timer_data* timer,
+      op_queue<operation>& ops, void* cancellation_key)
+  {
+    if (timer->slot_ != no_slot)
+    {
+      op_queue<wait_op> other_ops;
+      while (wait_op* op = timer->op_queue_.front())
+      {
+        timer->op_queue_.pop();
+        if (op->cancellation_key_ == cancellation_key)
+        {
+          op->ec_ = asio::error::operation_aborted;
+          ops.push(op);
+        }
+        else
+          other_ops.push(op);
+      }
+      timer->op_queue_.push(other_ops);
+      if (timer->op_queue_.empty())
+        remove_timer(*timer);
+    }
+  }
+
+  // Move operations from one timer to another, empty timer.
+  void move_timer(per_timer_data& target, per_timer_data& source)
+  {
+    target.op_queue_.push(source.op_queue_);
+
+    target.slack_ = source.slack_;
+    target.tick_ = source.tick_;
+    target.slot_ = source.slot_;
+    source.slot_ = no_slot;
+
+    if (target.slot_ != no_slot && slots_[target.slot_] == &source)
+      slots_[target.slot_] = &target;
+    if (source.prev_)
+      source.prev_->next_ = &target;
+    if (source.next_)
+      source.next_->prev_= &target;
+    target.next_ = source.next_;
+    target.prev_ = source.prev_;
+    source.next_ = 0;
+    source.prev_ = 0;
+  }
+
+private:
+  // The number of bits of the tick used to select a slot in each level.
+  static constexpr std::size_t level_bits = 6;
+
+  // The number of slots in each level.
+  static constexpr std::size_t slots_per_level = 64;
+
+  // The number of levels needed to cover all 64 bits of the tick.
+  static constexpr std::size_t num_levels = 11;
+
+  // The slot that holds timers that had expired when they were scheduled.
+  static constexpr std::size_t due_slot = num_levels * slots_per_level;
+
+  // The total number of slots.
+  static constexpr std::size_t num_slots = due_slot + 1;
+
+  // The slot index used for timers that are not in the wheel.
+  static constexpr std::size_t no_slot =
+    (std::numeric_limits<std::size_t>::max)();
+
+  // The resolution of the wheel, in microseconds.
+  static constexpr int64_t resolution =
+    timer_wheel_resolution<TimeTraits>::value;
+
+  // Get the mask of the tick bits below the start of a level's slot.
+  static uint64_t level_mask(std::size_t level)
+  {
+    return (uint64_t(1) << (level * level_bits)) - 1;
+  }
+
+  // Get the index of the lowest set bit in a non-zero value.
+  static std::size_t lowest_bit(uint64_t value)
+  {
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_ctzll(value));
+#else // defined(__GNUC__)
+    std::size_t bit = 0;
+    while ((value & 1) == 0)
+    {
+      value >>= 1;
+      ++bit;
+    }
+    return bit;
+#endif // defined(__GNUC__)
+  }
+
+  // Get the number of microseconds from the epoch to the given time.
+  int64_t usec_until(const time_type& time) const
+  {
+    return TimeTraits::to_posix_duration(
+        TimeTraits::subtract(time, epoch_)).total_microseconds();
+  }
+
+  // Convert a time into a number of ticks since the epoch, rounding up or down
+  // to a whole tick.
+  uint64_t ticks_until(const time_type& time, bool round_up) const
+  {
+    int64_t usec = usec_until(time);
+    if (usec <= 0)
+      return 0;
+    if (round_up)
+      return static_cast<uint64_t>(usec / resolution
+          + (usec % resolution != 0 ? 1 : 0));
+    return static_cast<uint64_t>(usec / resolution);
+  }
+
+  // Find the next tick at which a slot holding timers begins. Returns the
+  // maximum tick value if there are no timers in the wheel.
+  uint64_t next_event_tick() const
+  {
+    uint64_t result = (std::numeric_limits<uint64_t>::max)();
+    for (std::size_t level = 0; level < num_levels; ++level)
+    {
+      // Slots before the current position in a level are empty. The slot at
+      // the current position in a higher level may hold timers only when the
+      // current tick is at the start of that slot, as they have not yet been
+      // cascaded.
+      std::size_t shift = level * level_bits;
+      std::size_t index = static_cast<std::size_t>(
+          (current_tick_ >> shift) & (slots_per_level - 1));
+      if (level > 0 && (current_tick_ & level_mask(level)) != 0)
+        ++index;
+
+      uint64_t mask = (index < slots_per_level)
+        ? occupied_[level] & (~uint64_t(0) << index) : 0;
+      if (mask)
+      {
+        uint64_t base = (level + 1 < num_levels)
+          ? current_tick_ & ~level_mask(level + 1) : 0;
+        uint64_t tick = base
+          + (static_cast<uint64_t>(lowest_bit(mask)) << shift);
+        if (tick < result)
+          result = tick;
+      }
+    }
+    return result;
+  }
+
+  // Determine the number of microseconds until the next event. Returns false
+  // if there are no timers.
+  bool next_wait_usec(int64_t& usec) const
+  {
+    if (count_ == 0)
+    {
+      reported_tick_ = (std::numeric_limits<uint64_t>::max)();
+      return false;
+    }
+
+    if (slots_[due_slot])
+    {
+      reported_tick_ = 0;
+      usec = 0;
+      return true;
+    }
+
+    reported_tick_ = next_event_tick();
+    int64_t target = static_cast<int64_t>(reported_tick_) * resolution;
+    int64_t now = usec_until(TimeTraits::now());
+    usec = (target > now) ? target - now : 0;
+    return true;
+  }
+
+  // Add a timer to the slot determined by its expiry tick.
+  void link_timer(per_timer_data& timer)
+  {
+    std::size_t slot = due_slot;
+    if (timer.tick_ >= current_tick_)
+    {
+      uint64_t diff = timer.tick_ ^ current_tick_;
+      std::size_t level = 0;
+      while (diff >= slots_per_level)
+      {
+        diff >>= level_bits;
+        ++level;
+      }
+      std::size_t index = static_cast<std::size_t>(
+          (timer.tick_ >> (level * level_bits)) & (slots_per_level - 1));
+      slot = level * slots_per_level + index;
+      occupied_[level] |= uint64_t(1) << index;
+    }
+
+    timer.slot_ = slot;
+    timer.next_ = slots_[slot];
+    timer.prev_ = 0;
+    if (slots_[slot])
+      slots_[slot]->prev_ = &timer;
+    slots_[slot] = &timer;
+  }
+
+  // Remove a timer from its slot.
+  void unlink_timer(per_timer_data& timer)
+  {
+    std::size_t slot = timer.slot_;
+    if (slots_[slot] == &timer)
+      slots_[slot] = timer.next_;
+    if (timer.prev_)
+      timer.prev_->next_ = timer.next_;
+    if (timer.next_)
+      timer.next_->prev_= timer.prev_;
+    if (slot != due_slot && slots_[slot] == 0)
+    {
+      occupied_[slot / slots_per_level] &=
+        ~(uint64_t(1) << (slot % slots_per_level));
+    }
+    timer.slot_ = no_slot;
+    timer.next_ = 0;
+    timer.prev_ = 0;
+  }
+
+  // Remove a timer from the wheel.
+  void remove_timer(per_timer_data& timer)
+  {
+    unlink_timer(timer);
+    --count_;
+  }
+
+  // Dequeue all operations for an expired timer and remove it from the wheel.
+  void complete_timer(per_timer_data& timer, op_queue<operation>& ops)
+  {
+    while (wait_op* op = timer.op_queue_.front())
+    {
+      timer.op_queue_.pop();
+      op->ec_ = asio::error_code();
+      op->set_latency_ready();
+      ASIO_USDT_PROBE2(timer_fire, this, op);
+      ops.push(op);
+    }
+    remove_timer(timer);
+  }
+
+  // The time from which ticks are counted.
+  const time_type epoch_;
+
+  // All ticks before the current tick have been processed.
+  uint64_t current_tick_;
+
+  // The tick at which the reactor was last told to wake.
+  mutable uint64_t reported_tick_;
+
+  // The number of timers in the wheel.
+  std::size_t count_;
+
+  // The heads of the linked lists of timers in each slot.
+  per_timer_data* slots_[num_slots];
+
+  // Bitmaps of the occupied slots in each level.
+  uint64_t occupied_[num_levels];
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_TIMER_WHEEL_QUEUE_HPP
@@ -85,6 +85,8 @@ using std::is_function;
 
 using std::is_integral;
 
+using std::is_lvalue_reference;
+
 using std::is_move_constructible;
 
 using std::is_nothrow_copy_constructible;
@@ -0,0 +1,47 @@
+//
+// detail/usdt_probes.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_USDT_PROBES_HPP
+#define ASIO_DETAIL_USDT_PROBES_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+// Static probes in the "asio" provider, for use by tracing tools such as
+// bpftrace, perf and SystemTap. Each probe compiles to a single nop plus a
+// note that describes the locations of its arguments, so that the probes cost
+// almost nothing until a tracer attaches to them. All arguments are integers
+// or pointers.
+
+#if defined(ASIO_HAS_USDT_PROBES)
+
+# include <sys/sdt.h>
+
+# define ASIO_USDT_PROBE1(name, a1) \
+  STAP_PROBE1(asio, name, a1)
+
+# define ASIO_USDT_PROBE2(name, a1, a2) \
+  STAP_PROBE2(asio, name, a1, a2)
+
+# define ASIO_USDT_PROBE3(name, a1, a2, a3) \
+  STAP_PROBE3(asio, name, a1, a2, a3)
+
+#else // defined(ASIO_HAS_USDT_PROBES)
+
+# define ASIO_USDT_PROBE1(name, a1) (void)0
+# define ASIO_USDT_PROBE2(name, a1, a2) (void)0
+# define ASIO_USDT_PROBE3(name, a1, a2, a3) (void)0
+
+#endif // defined(ASIO_HAS_USDT_PROBES)
+
+#endif // ASIO_DETAIL_USDT_PROBES_HPP
@@ -38,6 +38,7 @@ protected:
     : operation(func),
       cancellation_key_(0)
   {
+    set_latency_kind(latency_timer);
   }
 };
 
@@ -95,6 +95,32 @@ public:
     return false;
   }
 
+  // If there are waiters, unlock the mutex and signal up to n of them. The
+  // auto-reset event wakes only one waiter however many times it is set, so
+  // all waiters are woken when more than one is wanted.
+  template <typename Lock>
+  bool maybe_unlock_and_signal_some(Lock& lock, std::size_t n)
+  {
+    ASIO_ASSERT(lock.locked());
+    ASIO_ASSERT(n > 0);
+    state_ |= 1;
+    if (state_ > 1)
+    {
+      if (n > 1 && state_ > 3)
+      {
+        ::SetEvent(events_[0]);
+        lock.unlock();
+      }
+      else
+      {
+        lock.unlock();
+        ::SetEvent(events_[1]);
+      }
+      return true;
+    }
+    return false;
+  }
+
   // Reset the event.
   template <typename Lock>
   void clear(Lock& lock)
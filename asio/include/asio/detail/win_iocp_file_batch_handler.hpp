@@ -0,0 +1,174 @@
+//
+// detail/win_iocp_file_batch_handler.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_WIN_IOCP_FILE_BATCH_HANDLER_HPP
+#define ASIO_DETAIL_WIN_IOCP_FILE_BATCH_HANDLER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_FILE) \
+  && defined(ASIO_HAS_WINDOWS_RANDOM_ACCESS_HANDLE)
+
+#include "asio/detail/atomic_count.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/error.hpp"
+#include "asio/file_base.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// The state shared by the requests of a batch. Overlapped operations on a
+// handle do not wait for one another, so each request is started as a
+// separate operation and the batch completes when the last of them does.
+template <typename Request, typename Handler, typename IoExecutor>
+class win_iocp_file_batch_state
+  : private noncopyable
+{
+public:
+  win_iocp_file_batch_state(Request* requests, std::size_t count,
+      Handler& handler, const IoExecutor& io_ex)
+    : requests_(requests),
+      count_(count),
+      refs_(1),
+      abandoned_(false),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+    // Requests that are never started report that they were aborted.
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      requests_[i].error = asio::error::operation_aborted;
+      requests_[i].bytes_transferred = 0;
+    }
+  }
+
+  Request* requests() const
+  {
+    return requests_;
+  }
+
+  std::size_t size() const
+  {
+    return count_;
+  }
+
+  void add_ref()
+  {
+    ref_count_up(refs_);
+  }
+
+  // Release a reference to the state, completing the batch when the last
+  // reference is released. If any request's operation was destroyed without
+  // being invoked, the owning context is being shut down and the handler is
+  // destroyed without an upcall.
+  void release(bool invoked)
+  {
+    if (!invoked)
+      abandoned_ = true;
+
+    if (!ref_count_down(refs_))
+      return;
+
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(work_));
+
+    asio::error_code ec;
+    std::size_t bytes_transferred = 0;
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+      if (!ec && requests_[i].error)
+        ec = requests_[i].error;
+      bytes_transferred += requests_[i].bytes_transferred;
+    }
+
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(handler_, ec, bytes_transferred);
+    bool abandoned = abandoned_;
+    delete this;
+
+    if (!abandoned)
+    {
+      fenced_block b(fenced_block::half);
+      w.complete(handler, handler.handler_);
+    }
+  }
+
+private:
+  Request* requests_;
+  std::size_t count_;
+  atomic_count refs_;
+  bool abandoned_;
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+// The handler for one request of a batch.
+template <typename Request, typename Handler, typename IoExecutor>
+class win_iocp_file_batch_handler
+{
+public:
+  typedef win_iocp_file_batch_state<Request, Handler, IoExecutor> state_type;
+
+  win_iocp_file_batch_handler(state_type* state, std::size_t index)
+    : state_(state),
+      index_(index)
+  {
+    state_->add_ref();
+  }
+
+  win_iocp_file_batch_handler(win_iocp_file_batch_handler&& other)
+    : state_(other.state_),
+      index_(other.index_)
+  {
+    other.state_ = 0;
+  }
+
+  ~win_iocp_file_batch_handler()
+  {
+    if (state_)
+      state_->release(false);
+  }
+
+  void operator()(const asio::error_code& ec, std::size_t bytes_transferred)
+  {
+    if (index_ < state_->size())
+    {
+      Request& request = state_->requests()[index_];
+      request.error = ec;
+      request.bytes_transferred = bytes_transferred;
+    }
+    state_type* state = state_;
+    state_ = 0;
+    state->release(true);
+  }
+
+private:
+  state_type* state_;
+  std::size_t index_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_FILE)
+       //   && defined(ASIO_HAS_WINDOWS_RANDOM_ACCESS_HANDLE)
+
+#endif // ASIO_DETAIL_WIN_IOCP_FILE_BATCH_HANDLER_HPP
@@ -21,7 +21,10 @@
 
 #include <string>
 #include "asio/detail/cstdint.hpp"
+#include "asio/detail/win_iocp_file_batch_handler.hpp"
+#include "asio/detail/win_iocp_file_sync_op.hpp"
 #include "asio/detail/win_iocp_handle_service.hpp"
+#include "asio/detail/win_iocp_io_context.hpp"
 #include "asio/error.hpp"
 #include "asio/execution_context.hpp"
 #include "asio/file_base.hpp"
@@ -247,7 +250,122 @@ public:
     handle_service_.async_read_some_at(impl, offset, buffers, handler, io_ex);
   }
 
+  // Start an asynchronous batch of reads. The requests, and the buffers they
+  // refer to, must be valid for the lifetime of the asynchronous operation.
+  template <typename Handler, typename IoExecutor>
+  void async_read_batch_at(implementation_type& impl,
+      file_base::read_request* requests, std::size_t count,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    typedef win_iocp_file_batch_handler<
+        file_base::read_request, Handler, IoExecutor> batch_handler;
+    typename batch_handler::state_type* state =
+      new typename batch_handler::state_type(
+          requests, count, handler, io_ex);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      batch_handler h(state, i);
+      handle_service_.async_read_some_at(impl,
+          requests[i].offset, requests[i].buffer, h, io_ex);
+    }
+    if (count == 0)
+    {
+      // An empty operation ensures that the handler is not invoked from
+      // within the initiating function.
+      batch_handler h(state, 0);
+      handle_service_.async_read_some_at(impl,
+          0, asio::mutable_buffer(), h, io_ex);
+    }
+    state->release(true);
+  }
+
+  // Start an asynchronous batch of writes. The requests, and the buffers they
+  // refer to, must be valid for the lifetime of the asynchronous operation.
+  template <typename Handler, typename IoExecutor>
+  void async_write_batch_at(implementation_type& impl,
+      file_base::write_request* requests, std::size_t count,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    typedef win_iocp_file_batch_handler<
+        file_base::write_request, Handler, IoExecutor> batch_handler;
+    typename batch_handler::state_type* state =
+      new typename batch_handler::state_type(
+          requests, count, handler, io_ex);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      batch_handler h(state, i);
+      handle_service_.async_write_some_at(impl,
+          requests[i].offset, requests[i].buffer, h, io_ex);
+    }
+    if (count == 0)
+    {
+      // An empty operation ensures that the handler is not invoked from
+      // within the initiating function.
+      batch_handler h(state, 0);
+      handle_service_.async_write_some_at(impl,
+          0, asio::const_buffer(), h, io_ex);
+    }
+    state->release(true);
+  }
+
+  // Start an asynchronous synchronisation of the file to disk.
+  template <typename Handler, typename IoExecutor>
+  void async_sync_all(implementation_type& impl,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    asio::error_code ec;
+    sync_all(impl, ec);
+    complete_sync_op(impl, ec, handler, io_ex, "async_sync_all");
+  }
+
+  // Start an asynchronous synchronisation of the file data to disk.
+  template <typename Handler, typename IoExecutor>
+  void async_sync_data(implementation_type& impl,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    asio::error_code ec;
+    sync_data(impl, ec);
+    complete_sync_op(impl, ec, handler, io_ex, "async_sync_data");
+  }
+
+  // Start an asynchronous synchronisation of a range of the file to disk.
+  // Windows cannot flush part of a file, so the file data is synchronised.
+  template <typename Handler, typename IoExecutor>
+  void async_sync_range(implementation_type& impl, uint64_t,
+      uint64_t, Handler& handler, const IoExecutor& io_ex)
+  {
+    asio::error_code ec;
+    sync_data(impl, ec);
+    complete_sync_op(impl, ec, handler, io_ex, "async_sync_range");
+  }
+
 private:
+  // Post the result of a synchronisation. The flush functions have no
+  // overlapped form, so the flush is performed by the initiating thread.
+  template <typename Handler, typename IoExecutor>
+  void complete_sync_op(implementation_type& impl,
+      const asio::error_code& ec, Handler& handler,
+      const IoExecutor& io_ex, const char* op_name)
+  {
+    // Allocate and construct an operation to wrap the handler.
+    typedef win_iocp_file_sync_op<Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(handler, io_ex);
+
+    ASIO_HANDLER_CREATION((iocp_service_.context(), *p.p, "file",
+          &impl, reinterpret_cast<uintmax_t>(native_handle(impl)), op_name));
+    (void)impl;
+    (void)op_name;
+
+    iocp_service_.work_started();
+    iocp_service_.on_completion(p.p, ec);
+    p.v = p.p = 0;
+  }
+
+  // The IO completion port used for delivering results.
+  win_iocp_io_context& iocp_service_;
+
   // The implementation used for initiating asynchronous operations.
   win_iocp_handle_service handle_service_;
 
@@ -22,6 +22,7 @@
 #include "asio/detail/limits.hpp"
 #include "asio/detail/mutex.hpp"
 #include "asio/detail/op_queue.hpp"
+#include "asio/detail/scheduler_metrics.hpp"
 #include "asio/detail/socket_types.hpp"
 #include "asio/detail/thread.hpp"
 #include "asio/detail/thread_context.hpp"
@@ -113,9 +114,23 @@ public:
       stop();
   }
 
+  // Get the current amount of outstanding work.
+  std::size_t outstanding_work() const
+  {
+    return static_cast<std::size_t>(::InterlockedExchangeAdd(
+          const_cast<long*>(&outstanding_work_), 0));
+  }
+
   // Return whether a handler can be dispatched immediately.
   ASIO_DECL bool can_dispatch();
 
+  // Return whether a handler can be dispatched immediately. The budget for
+  // inline completions is not supported, so this is the same as can_dispatch.
+  bool can_dispatch_inline()
+  {
+    return can_dispatch();
+  }
+
   /// Capture the current exception so it can be rethrown from a run function.
   ASIO_DECL void capture_current_exception();
 
@@ -127,6 +142,24 @@ public:
     post_deferred_completion(op);
   }
 
+  // Request invocation of the given operation at the given priority and
+  // return immediately. Assumes that work_started() has not yet been called
+  // for the operation. Priorities are not supported, and are ignored.
+  void post_prioritised_completion(win_iocp_operation* op,
+      bool is_continuation, unsigned int)
+  {
+    post_immediate_completion(op, is_continuation);
+  }
+
+  // Request invocation of the given operations and return immediately. Assumes
+  // that work_started() has not yet been called for the operations.
+  void post_immediate_completions(std::size_t n,
+      op_queue<win_iocp_operation>& ops, bool)
+  {
+    ::InterlockedExchangeAdd(&outstanding_work_, static_cast<long>(n));
+    post_deferred_completions(ops);
+  }
+
   // Request invocation of the given operation and return immediately. Assumes
   // that work_started() was previously called for the operation.
   ASIO_DECL void post_deferred_completion(win_iocp_operation* op);
@@ -163,6 +196,12 @@ public:
   // that work_started() was previously called for the operations.
   ASIO_DECL void abandon_operations(op_queue<operation>& ops);
 
+  // Get the counters describing the activity of the io_context.
+  scheduler_metrics& metrics()
+  {
+    return metrics_;
+  }
+
   // Called after starting an overlapped I/O operation that did not complete
   // immediately. The caller must have already called work_started() prior to
   // starting the operation.
@@ -239,6 +278,10 @@ private:
   // Helper function to remove a timer queue.
   ASIO_DECL void do_remove_timer_queue(timer_queue_base& queue);
 
+  // Sample the number of pending timers, if metrics are enabled. The dispatch
+  // mutex must be held.
+  ASIO_DECL void record_pending_timers();
+
   // Called to recalculate and update the timeout.
   ASIO_DECL void update_timeout();
 
@@ -327,6 +370,9 @@ private:
 
   // The concurrency hint used to initialise the io_context.
   const int concurrency_hint_;
+
+  // Counters describing the activity of the io_context.
+  scheduler_metrics metrics_;
 };
 
 } // namespace detail
@@ -21,6 +21,7 @@
 
 #include "asio/detail/handler_tracking.hpp"
 #include "asio/detail/op_queue.hpp"
+#include "asio/detail/operation_latency.hpp"
 #include "asio/detail/socket_types.hpp"
 #include "asio/error_code.hpp"
 
@@ -51,6 +52,15 @@ public:
     func_(0, this, asio::error_code(), 0);
   }
 
+  // Latency histograms are not recorded for this implementation.
+  void set_latency_kind(latency_kind)
+  {
+  }
+
+  void set_latency_ready()
+  {
+  }
+
   void reset()
   {
     Internal = 0;
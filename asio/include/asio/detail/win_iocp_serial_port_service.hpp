@@ -23,6 +23,7 @@
 #include <string>
 #include "asio/error.hpp"
 #include "asio/execution_context.hpp"
+#include "asio/serial_port_base.hpp"
 #include "asio/detail/win_iocp_handle_service.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -132,6 +133,28 @@ public:
         &option, ec);
   }
 
+  // Set the low latency option on the serial port.
+  asio::error_code set_option(implementation_type&,
+      const serial_port_base::low_latency&, asio::error_code& ec)
+  {
+    ec = asio::error::operation_not_supported;
+    ASIO_ERROR_LOCATION(ec);
+    return ec;
+  }
+
+  // Get the low latency option from the serial port.
+  asio::error_code get_option(const implementation_type&,
+      serial_port_base::low_latency&, asio::error_code& ec) const
+  {
+    ec = asio::error::operation_not_supported;
+    ASIO_ERROR_LOCATION(ec);
+    return ec;
+  }
+
+  // Determine the number of bytes available for reading.
+  ASIO_DECL std::size_t available(const implementation_type& impl,
+      asio::error_code& ec) const;
+
   // Send a break sequence to the serial port.
   asio::error_code send_break(implementation_type&,
       asio::error_code& ec)
@@ -174,6 +174,28 @@ public:
     other_impl.remote_endpoint_ = endpoint_type();
   }
 
+  // Move a socket implementation that belongs to another service, possibly
+  // in another execution context, into an empty implementation.
+  asio::error_code transfer(implementation_type& impl,
+      win_iocp_socket_service& other_service,
+      implementation_type& other_impl, asio::error_code& ec)
+  {
+    if (!this->base_transfer(impl, other_service, other_impl, ec))
+    {
+      impl.protocol_ = other_impl.protocol_;
+      other_impl.protocol_ = endpoint_type().protocol();
+
+      impl.have_remote_endpoint_ = other_impl.have_remote_endpoint_;
+      other_impl.have_remote_endpoint_ = false;
+
+      impl.remote_endpoint_ = other_impl.remote_endpoint_;
+      other_impl.remote_endpoint_ = endpoint_type();
+    }
+
+    ASIO_ERROR_LOCATION(ec);
+    return ec;
+  }
+
   // Move-construct a new socket implementation from another protocol type.
   template <typename Protocol1>
   void converting_move_construct(implementation_type& impl,
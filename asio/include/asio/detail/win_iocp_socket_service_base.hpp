@@ -102,6 +102,13 @@ public:
       win_iocp_socket_service_base& other_service,
       base_implementation_type& other_impl);
 
+  // Move a socket implementation that belongs to another service into an
+  // empty implementation. On failure, neither implementation is changed.
+  ASIO_DECL asio::error_code base_transfer(
+      base_implementation_type& impl,
+      win_iocp_socket_service_base& other_service,
+      base_implementation_type& other_impl, asio::error_code& ec);
+
   // Destroy a socket implementation.
   ASIO_DECL void destroy(base_implementation_type& impl);
 
@@ -199,6 +206,9 @@ public:
     case socket_base::wait_error:
       socket_ops::poll_error(impl.socket_, impl.state_, -1, ec);
       break;
+    case socket_base::wait_peer_closed:
+      socket_ops::poll_peer_closed(impl.socket_, impl.state_, -1, ec);
+      break;
     default:
       ec = asio::error::invalid_argument;
       break;
@@ -251,6 +261,10 @@ public:
         op_type = select_reactor::read_op;
         start_reactor_op(impl, select_reactor::except_op, p.p);
         break;
+      case socket_base::wait_peer_closed:
+        p.p->ec_ = asio::error::operation_not_supported;
+        iocp_service_.post_immediate_completion(p.p, is_continuation);
+        break;
       default:
         p.p->ec_ = asio::error::invalid_argument;
         iocp_service_.post_immediate_completion(p.p, is_continuation);
@@ -267,6 +281,53 @@ public:
     }
   }
 
+  // Start an asynchronous close. The socket is closed immediately and the
+  // result is passed to the handler.
+  template <typename Handler, typename IoExecutor>
+  void async_close(base_implementation_type& impl,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef win_iocp_wait_op<Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(impl.cancel_token_, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((context_, *p.p, "socket",
+          &impl, impl.socket_, "async_close"));
+
+    close(impl, p.p->ec_);
+    iocp_service_.post_immediate_completion(p.p, is_continuation);
+    p.v = p.p = 0;
+  }
+
+  // Start an asynchronous shutdown. The socket is shut down immediately and
+  // the result is passed to the handler.
+  template <typename Handler, typename IoExecutor>
+  void async_shutdown(base_implementation_type& impl,
+      socket_base::shutdown_type what, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef win_iocp_wait_op<Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(impl.cancel_token_, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((context_, *p.p, "socket",
+          &impl, impl.socket_, "async_shutdown"));
+
+    socket_ops::shutdown(impl.socket_, what, p.p->ec_);
+    iocp_service_.post_immediate_completion(p.p, is_continuation);
+    p.v = p.p = 0;
+  }
+
   // Send the given data to the peer. Returns the number of bytes sent.
   template <typename ConstBufferSequence>
   size_t send(base_implementation_type& impl,
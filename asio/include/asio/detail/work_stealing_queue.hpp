@@ -0,0 +1,140 @@
+//
+// detail/work_stealing_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_WORK_STEALING_QUEUE_HPP
+#define ASIO_DETAIL_WORK_STEALING_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_THREADS)
+
+#include <atomic>
+#include <cstddef>
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A bounded, lock-free, single-owner work-stealing queue. Only the owning
+// thread may call push(), which adds to the bottom. Operations are removed
+// from the top, by the owner using take() and by any other thread using
+// steal(), so that they run in the order in which they were pushed. The
+// implementation follows the Chase-Lev algorithm, as formulated for the C11
+// memory model by Le, Pop, Cohen and Zappa Nardelli.
+template <typename Operation>
+class work_stealing_queue
+  : private noncopyable
+{
+public:
+  // Construct with a capacity that is rounded up to a power of two.
+  explicit work_stealing_queue(std::size_t capacity)
+    : top_(0),
+      bottom_(0),
+      mask_(0),
+      buffer_(0)
+  {
+    std::size_t size = 2;
+    while (size < capacity)
+      size <<= 1;
+    mask_ = static_cast<long>(size - 1);
+    buffer_ = new std::atomic<Operation*>[size];
+    for (std::size_t i = 0; i < size; ++i)
+      buffer_[i].store(0, std::memory_order_relaxed);
+  }
+
+  // Destructor. Any operations that remain in the queue are not destroyed.
+  ~work_stealing_queue()
+  {
+    delete[] buffer_;
+  }
+
+  // Add an operation to the bottom of the queue. Returns false if the queue is
+  // full. Must only be called by the owning thread.
+  bool push(Operation* op)
+  {
+    long b = bottom_.load(std::memory_order_relaxed);
+    long t = top_.load(std::memory_order_acquire);
+    if (b - t > mask_)
+      return false;
+    buffer_[b & mask_].store(op, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // Remove an operation from the top of the queue. Returns null if the queue
+  // is empty. Unlike steal(), retries when another thread wins the race for an
+  // operation. Must only be called by the owning thread.
+  Operation* take()
+  {
+    while (!empty())
+      if (Operation* op = steal())
+        return op;
+    return 0;
+  }
+
+  // Remove an operation from the top of the queue. Returns null if the queue
+  // is empty or if another thread won the race for the operation. May be
+  // called from any thread.
+  Operation* steal()
+  {
+    long t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    long b = bottom_.load(std::memory_order_acquire);
+    if (t < b)
+    {
+      Operation* op = buffer_[t & mask_].load(std::memory_order_relaxed);
+      if (top_.compare_exchange_strong(t, t + 1,
+            std::memory_order_seq_cst, std::memory_order_relaxed))
+        return op;
+    }
+    return 0;
+  }
+
+  // Determine whether the queue appears to be empty. The result is only a
+  // snapshot when called concurrently with other threads.
+  bool empty() const
+  {
+    long b = bottom_.load(std::memory_order_relaxed);
+    long t = top_.load(std::memory_order_relaxed);
+    return b <= t;
+  }
+
+private:
+  // The index of the next operation to be stolen.
+  std::atomic<long> top_;
+
+  // Padding to keep the owner-only index on a separate cache line.
+  char padding_[64 - sizeof(std::atomic<long>)];
+
+  // The index one past the most recently pushed operation.
+  std::atomic<long> bottom_;
+
+  // The mask used to map indices to buffer positions.
+  long mask_;
+
+  // The circular buffer of operations.
+  std::atomic<Operation*>* buffer_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_THREADS)
+
+#endif // ASIO_DETAIL_WORK_STEALING_QUEUE_HPP
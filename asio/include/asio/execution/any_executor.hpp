@@ -500,10 +500,7 @@ public:
           == execution::blocking.always))
   {
     any_executor_base::construct_object(ex,
-        integral_constant<bool,
-          sizeof(Executor) <= sizeof(object_type)
-            && alignment_of<Executor>::value <= alignment_of<object_type>::value
-        >());
+        is_stored_inline<Executor>());
   }
 
   template <ASIO_EXECUTION_EXECUTOR Executor>
@@ -514,10 +511,7 @@ public:
           == execution::blocking.always))
   {
     any_executor_base::construct_object(std::nothrow, ex,
-        integral_constant<bool,
-          sizeof(Executor) <= sizeof(object_type)
-            && alignment_of<Executor>::value <= alignment_of<object_type>::value
-        >());
+        is_stored_inline<Executor>());
     if (target_ == 0)
     {
       object_fns_ = 0;
@@ -704,6 +698,17 @@ public:
       ? static_cast<const Executor*>(target_) : 0;
   }
 
+  // Get a pointer to the target executor if it is of the specified type, by
+  // comparing the function table rather than the type identity. This is for
+  // use on fast paths only. A null result does not mean that the target is of
+  // some other type, as the table may differ across shared library boundaries.
+  template <typename Executor>
+  const Executor* fast_target() const noexcept
+  {
+    return target_fns_ == target_fns_table<Executor>(false)
+      ? static_cast<const Executor*>(target_) : 0;
+  }
+
 #if !defined(ASIO_NO_TYPEID)
   const std::type_info& target_type() const
   {
@@ -1196,6 +1201,17 @@ private:
       alignment_of<asio::detail::shared_ptr<void>>::value
     >::type object_type;
 
+  // Determine whether a target executor is stored within the object_ member,
+  // rather than in separately allocated memory.
+  template <typename Executor>
+  struct is_stored_inline :
+    integral_constant<bool,
+      sizeof(Executor) <= sizeof(object_type)
+        && alignment_of<Executor>::value <= alignment_of<object_type>::value
+    >
+  {
+  };
+
   object_type object_;
   const object_fns* object_fns_;
   void* target_;
@@ -0,0 +1,218 @@
+//
+// execution/priority.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXECUTION_PRIORITY_HPP
+#define ASIO_EXECUTION_PRIORITY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/execution/executor.hpp"
+#include "asio/is_applicable_property.hpp"
+#include "asio/traits/query_static_constexpr_member.hpp"
+#include "asio/traits/static_query.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+#if defined(GENERATING_DOCUMENTATION)
+
+namespace execution {
+
+/// A property to describe the priority with which submitted function objects
+/// should be run, relative to other function objects submitted to the same
+/// execution context.
+/**
+ * Larger values denote higher priorities. The default priority is 0. An
+ * executor that does not support priorities ignores the property when it is
+ * preferred.
+ */
+struct priority_t
+{
+  /// The priority_t property applies to executors.
+  template <typename T>
+  static constexpr bool is_applicable_property_v = is_executor_v<T>;
+
+  /// The priority_t property cannot be required.
+  static constexpr bool is_requirable = false;
+
+  /// The priority_t property can be preferred.
+  static constexpr bool is_preferable = true;
+
+  /// The type returned by queries against an @c any_executor.
+  typedef unsigned int polymorphic_query_result_type;
+
+  /// Default constructor, denoting the default priority of 0.
+  constexpr priority_t();
+
+  /// Obtain the priority value stored in the priority_t property object.
+  constexpr unsigned int value() const;
+
+  /// Create a priority_t object with a different priority value.
+  constexpr priority_t operator()(unsigned int p) const;
+};
+
+/// A special value used for accessing the priority_t property.
+constexpr priority_t priority;
+
+} // namespace execution
+
+#else // defined(GENERATING_DOCUMENTATION)
+
+namespace execution {
+namespace detail {
+
+template <int I = 0>
+struct priority_t
+{
+#if defined(ASIO_HAS_VARIABLE_TEMPLATES)
+  template <typename T>
+  static constexpr bool is_applicable_property_v = is_executor<T>::value;
+#endif // defined(ASIO_HAS_VARIABLE_TEMPLATES)
+
+  static constexpr bool is_requirable = false;
+  static constexpr bool is_preferable = true;
+  typedef unsigned int polymorphic_query_result_type;
+
+  constexpr priority_t()
+    : value_(0)
+  {
+  }
+
+  template <typename T>
+  struct static_proxy
+  {
+#if defined(ASIO_HAS_DEDUCED_QUERY_STATIC_CONSTEXPR_MEMBER_TRAIT)
+    struct type
+    {
+      template <typename P>
+      static constexpr auto query(P&& p)
+        noexcept(
+          noexcept(
+            conditional_t<true, T, P>::query(static_cast<P&&>(p))
+          )
+        )
+        -> decltype(
+          conditional_t<true, T, P>::query(static_cast<P&&>(p))
+        )
+      {
+        return T::query(static_cast<P&&>(p));
+      }
+    };
+#else // defined(ASIO_HAS_DEDUCED_QUERY_STATIC_CONSTEXPR_MEMBER_TRAIT)
+    typedef T type;
+#endif // defined(ASIO_HAS_DEDUCED_QUERY_STATIC_CONSTEXPR_MEMBER_TRAIT)
+  };
+
+  template <typename T>
+  struct query_static_constexpr_member :
+    traits::query_static_constexpr_member<
+      typename static_proxy<T>::type, priority_t> {};
+
+#if defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT) \
+  && defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+  template <typename T>
+  static constexpr typename query_static_constexpr_member<T>::result_type
+  static_query()
+    noexcept(query_static_constexpr_member<T>::is_noexcept)
+  {
+    return query_static_constexpr_member<T>::value();
+  }
+
+  template <typename E, typename T = decltype(priority_t::static_query<E>())>
+  static constexpr const T static_query_v = priority_t::static_query<E>();
+#endif // defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT)
+       //   && defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+  constexpr unsigned int value() const
+  {
+    return value_;
+  }
+
+  constexpr priority_t operator()(unsigned int p) const
+  {
+    return priority_t(p);
+  }
+
+private:
+  explicit constexpr priority_t(unsigned int p)
+    : value_(p)
+  {
+  }
+
+  unsigned int value_;
+};
+
+#if defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT) \
+  && defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+template <int I> template <typename E, typename T>
+const T priority_t<I>::static_query_v;
+#endif // defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT)
+       //   && defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+} // namespace detail
+
+typedef detail::priority_t<> priority_t;
+
+ASIO_INLINE_VARIABLE constexpr priority_t priority;
+
+} // namespace execution
+
+#if !defined(ASIO_HAS_VARIABLE_TEMPLATES)
+
+template <typename T>
+struct is_applicable_property<T, execution::priority_t>
+  : integral_constant<bool, execution::is_executor<T>::value>
+{
+};
+
+#endif // !defined(ASIO_HAS_VARIABLE_TEMPLATES)
+
+namespace traits {
+
+#if !defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT) \
+  || !defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+template <typename T>
+struct static_query<T, execution::priority_t,
+  enable_if_t<
+    execution::detail::priority_t<0>::
+      query_static_constexpr_member<T>::is_valid
+  >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = true;
+
+  typedef typename execution::detail::priority_t<0>::
+    query_static_constexpr_member<T>::result_type result_type;
+
+  static constexpr result_type value()
+  {
+    return execution::detail::priority_t<0>::
+      query_static_constexpr_member<T>::value();
+  }
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT)
+       //   || !defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+} // namespace traits
+
+#endif // defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXECUTION_PRIORITY_HPP
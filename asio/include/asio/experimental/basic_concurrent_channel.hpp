@@ -104,6 +104,7 @@ class basic_concurrent_channel
 private:
   class initiate_async_send;
   class initiate_async_receive;
+  class initiate_async_receive_batch;
   typedef detail::channel_service<asio::detail::mutex> service_type;
   typedef typename service_type::template implementation_type<
       Traits, Signatures...>::payload_type payload_type;
@@ -383,6 +384,18 @@ public:
   auto async_send(Args&&... args,
       CompletionToken&& token);
 
+  /// Try to send a message for each element of a range without blocking.
+  /**
+   * Each message is formed from the leading arguments @c args followed by an
+   * element of the range. The elements of an rvalue range are moved. All of the
+   * messages are sent under a single acquisition of the channel's lock, and
+   * sending stops at the first message that cannot be sent.
+   *
+   * @returns The number of messages that were sent.
+   */
+  template <typename Range, typename... Args>
+  std::size_t try_send_batch(Range&& range, const Args&... args);
+
 #endif // defined(GENERATING_DOCUMENTATION)
 
   /// Try to receive a message without blocking.
@@ -413,6 +426,45 @@ public:
         static_cast<CompletionToken&&>(token));
   }
 
+  /// Asynchronously receive a batch of messages.
+  /**
+   * Receives as many of the available messages as will fit in the array
+   * @c values, so that a consumer that has fallen behind pays for one
+   * completion, and one acquisition of the channel's lock, per batch rather
+   * than per message. If no message is available, the operation waits for one.
+   *
+   * Each message must have the form <tt>void(T)</tt> or
+   * <tt>void(asio::error_code, T)</tt>, and its value is assigned to the next
+   * element of @c values. Receiving stops at the first message that carries
+   * an error, and that error is passed to the completion handler.
+   *
+   * @param values The array into which the received values are stored. The
+   * array must remain valid until the completion handler is called.
+   *
+   * @param max_count The number of elements in @c values.
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   */
+  template <typename T,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code, std::size_t))
+        CompletionToken ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  auto async_receive_batch(T* values, std::size_t max_count,
+      CompletionToken&& token
+        ASIO_DEFAULT_COMPLETION_TOKEN(Executor))
+#if !defined(GENERATING_DOCUMENTATION)
+    -> decltype(
+        async_initiate<CompletionToken,
+          void (asio::error_code, std::size_t)>(
+            declval<initiate_async_receive_batch>(), token,
+            values, max_count))
+#endif // !defined(GENERATING_DOCUMENTATION)
+  {
+    return async_initiate<CompletionToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_batch(this), token, values, max_count);
+  }
+
 private:
   // Disallow copying and assignment.
   basic_concurrent_channel(
@@ -495,6 +547,34 @@ private:
     basic_concurrent_channel* self_;
   };
 
+  class initiate_async_receive_batch
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_batch(basic_concurrent_channel* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReceiveHandler, typename T>
+    void operator()(ReceiveHandler&& handler,
+        T* values, std::size_t max_count) const
+    {
+      asio::detail::non_const_lvalue<ReceiveHandler> handler2(handler);
+      self_->service_->async_receive_batch(self_->impl_,
+          values, max_count, handler2.value, self_->get_executor());
+    }
+
+  private:
+    basic_concurrent_channel* self_;
+  };
+
   // The service associated with the I/O object.
   service_type* service_;
 
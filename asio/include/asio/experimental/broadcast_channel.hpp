@@ -0,0 +1,570 @@
+//
+// experimental/broadcast_channel.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_BROADCAST_CHANNEL_HPP
+#define ASIO_EXPERIMENTAL_BROADCAST_CHANNEL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <memory>
+#include "asio/any_io_executor.hpp"
+#include "asio/associated_cancellation_slot.hpp"
+#include "asio/async_result.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/experimental/detail/broadcast_channel_state.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+
+/// A channel that delivers every message to each of its subscribers.
+/**
+ * The broadcast_channel class template is used to publish messages to any
+ * number of subscribers. Each message is a shared, immutable payload of type
+ * @c std::shared_ptr<const T>. A message is stored once, in a fixed-capacity
+ * ring, and every subscriber receives the same payload object. Subscribers
+ * keep only a cursor into the ring, so the cost of a send does not depend on
+ * the size of the payload.
+ *
+ * A subscriber receives the messages sent after it subscribes. When a message
+ * is sent while a subscriber has not yet received the oldest message in the
+ * ring, the channel acts according to its broadcast_overflow policy.
+ *
+ * For example:
+ * @code broadcast_channel<std::string> ch(ctx, 16);
+ * broadcast_channel<std::string>::subscriber sub = ch.subscribe();
+ *
+ * ch.try_send(std::make_shared<const std::string>("hello"));
+ *
+ * sub.async_receive(
+ *     [](error_code ec, std::shared_ptr<const std::string> msg)
+ *     {
+ *       if (!ec)
+ *         std::cout << *msg << "\n";
+ *     }); @endcode
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ *
+ * The channel and its subscribers share state that is protected by a mutex.
+ * Moving a channel or subscriber must not be performed concurrently with any
+ * other operation on that object.
+ */
+template <typename T, typename Executor = any_io_executor>
+class broadcast_channel
+{
+private:
+  class initiate_async_send;
+  typedef detail::broadcast_channel_state<T> state_type;
+
+public:
+  /// The type of the executor associated with the channel.
+  typedef Executor executor_type;
+
+  /// Rebinds the channel type to another executor.
+  template <typename Executor1>
+  struct rebind_executor
+  {
+    /// The channel type when rebound to the specified executor.
+    typedef broadcast_channel<T, Executor1> other;
+  };
+
+  /// The type of a message payload.
+  typedef std::shared_ptr<const T> payload_type;
+
+  class subscriber;
+
+  /// Construct a broadcast_channel.
+  /**
+   * @param ex The I/O executor that the channel will use, by default, to
+   * dispatch handlers for any asynchronous operations performed on the channel
+   * and its subscribers.
+   *
+   * @param capacity The maximum number of messages held for subscribers that
+   * have not yet received them. A capacity of zero is treated as one.
+   *
+   * @param policy The action taken when a subscriber falls behind.
+   */
+  broadcast_channel(const executor_type& ex, std::size_t capacity,
+      broadcast_overflow policy = broadcast_overflow::drop)
+    : state_(std::make_shared<state_type>(capacity, policy)),
+      executor_(ex)
+  {
+  }
+
+  /// Construct a broadcast_channel.
+  /**
+   * @param context An execution context which provides the I/O executor that
+   * the channel will use, by default, to dispatch handlers for any asynchronous
+   * operations performed on the channel and its subscribers.
+   *
+   * @param capacity The maximum number of messages held for subscribers that
+   * have not yet received them. A capacity of zero is treated as one.
+   *
+   * @param policy The action taken when a subscriber falls behind.
+   */
+  template <typename ExecutionContext>
+  broadcast_channel(ExecutionContext& context, std::size_t capacity,
+      broadcast_overflow policy = broadcast_overflow::drop,
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value,
+        defaulted_constraint
+      > = defaulted_constraint())
+    : state_(std::make_shared<state_type>(capacity, policy)),
+      executor_(context.get_executor())
+  {
+  }
+
+  /// Move-construct a broadcast_channel from another.
+  /**
+   * @note Following the move, the moved-from object may only be destroyed or
+   * assigned to.
+   */
+  broadcast_channel(broadcast_channel&& other)
+    : state_(static_cast<std::shared_ptr<state_type>&&>(other.state_)),
+      executor_(other.executor_)
+  {
+  }
+
+  /// Move-assign a broadcast_channel from another.
+  /**
+   * Closes the channel previously owned by the target object.
+   *
+   * @note Following the move, the moved-from object may only be destroyed or
+   * assigned to.
+   */
+  broadcast_channel& operator=(broadcast_channel&& other)
+  {
+    if (this != &other)
+    {
+      if (state_)
+        state_->close();
+      state_ = static_cast<std::shared_ptr<state_type>&&>(other.state_);
+      executor_.~executor_type();
+      new (&executor_) executor_type(other.executor_);
+    }
+    return *this;
+  }
+
+  /// Destructor.
+  /**
+   * Closes the channel. Subscribers remain valid, and receive any messages
+   * that are still buffered before their operations fail with
+   * @c asio::experimental::error::channel_closed.
+   */
+  ~broadcast_channel()
+  {
+    if (state_)
+      state_->close();
+  }
+
+  /// Get the executor associated with the object.
+  const executor_type& get_executor() noexcept
+  {
+    return executor_;
+  }
+
+  /// Get the capacity of the channel's ring.
+  std::size_t capacity() const noexcept
+  {
+    return state_->capacity();
+  }
+
+  /// Get the action taken when a subscriber falls behind.
+  broadcast_overflow policy() const noexcept
+  {
+    return state_->policy();
+  }
+
+  /// Determine whether the channel is open.
+  bool is_open() const
+  {
+    return state_->is_open();
+  }
+
+  /// Close the channel.
+  /**
+   * Outstanding send operations complete with the error
+   * @c asio::experimental::error::channel_closed. Subscribers receive any
+   * messages that are still buffered before their receive operations complete
+   * with the same error.
+   */
+  void close()
+  {
+    state_->close();
+  }
+
+  /// Get the number of subscribers.
+  std::size_t subscriber_count() const
+  {
+    return state_->subscriber_count();
+  }
+
+  /// Add a subscriber.
+  /**
+   * The subscriber receives the messages sent after this function returns.
+   */
+  subscriber subscribe()
+  {
+    return subscriber(state_, executor_);
+  }
+
+  /// Try to send a message without blocking.
+  /**
+   * Fails if the channel is closed, or if the policy is
+   * broadcast_overflow::block and a subscriber has not yet received the oldest
+   * buffered message.
+   *
+   * @returns @c true on success, @c false on failure.
+   */
+  bool try_send(payload_type payload)
+  {
+    return state_->try_send(payload);
+  }
+
+  /// Asynchronously send a message.
+  /**
+   * The operation waits only when the policy is broadcast_overflow::block.
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        CompletionToken ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  auto async_send(payload_type payload,
+      CompletionToken&& token
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+    -> decltype(
+        async_initiate<CompletionToken, void (asio::error_code)>(
+          declval<initiate_async_send>(), token, declval<payload_type>()))
+  {
+    return async_initiate<CompletionToken, void (asio::error_code)>(
+        initiate_async_send(this), token,
+        static_cast<payload_type&&>(payload));
+  }
+
+private:
+  // Disallow copying and assignment.
+  broadcast_channel(const broadcast_channel&) = delete;
+  broadcast_channel& operator=(const broadcast_channel&) = delete;
+
+  // Helper class used to implement per-operation cancellation.
+  class op_cancellation
+  {
+  public:
+    explicit op_cancellation(state_type* state)
+      : state_(state)
+    {
+    }
+
+    void operator()(cancellation_type_t type)
+    {
+      if (!!(type &
+            (cancellation_type::terminal
+              | cancellation_type::partial
+              | cancellation_type::total)))
+      {
+        state_->cancel_by_key(this);
+      }
+    }
+
+  private:
+    state_type* state_;
+  };
+
+  class initiate_async_send
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send(broadcast_channel* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename SendHandler>
+    void operator()(SendHandler&& handler, payload_type&& payload) const
+    {
+      typedef decay_t<SendHandler> handler_type;
+      asio::detail::non_const_lvalue<SendHandler> handler2(handler);
+
+      associated_cancellation_slot_t<handler_type> slot
+        = asio::get_associated_cancellation_slot(handler2.value);
+
+      // Allocate and construct an operation to wrap the handler.
+      typedef detail::channel_send_op<payload_type,
+        handler_type, Executor> op;
+      typename op::ptr p = { asio::detail::addressof(handler2.value),
+        op::ptr::allocate(handler2.value), 0 };
+      p.p = new (p.v) op(static_cast<payload_type&&>(payload),
+          handler2.value, self_->get_executor());
+
+      // Optionally register for per-operation cancellation.
+      if (slot.is_connected())
+      {
+        p.p->cancellation_key_ =
+          &slot.template emplace<op_cancellation>(self_->state_.get());
+      }
+
+      ASIO_HANDLER_CREATION((asio::query(self_->get_executor(),
+              execution::context), *p.p, "broadcast_channel",
+            self_->state_.get(), 0, "async_send"));
+
+      self_->state_->start_send_op(p.p);
+      p.v = p.p = 0;
+    }
+
+  private:
+    broadcast_channel* self_;
+  };
+
+  // The state shared with the subscribers.
+  std::shared_ptr<state_type> state_;
+
+  // The associated executor.
+  Executor executor_;
+};
+
+/// A subscription to a broadcast_channel.
+/**
+ * A subscriber is obtained from broadcast_channel::subscribe() and receives,
+ * in order, the messages sent to the channel after it was created. Destroying
+ * the subscriber ends the subscription and cancels its outstanding receive
+ * operations.
+ */
+template <typename T, typename Executor>
+class broadcast_channel<T, Executor>::subscriber
+{
+private:
+  class initiate_async_receive;
+  typedef typename state_type::subscriber_type subscriber_type;
+  typedef typename state_type::receive_payload_type receive_payload_type;
+
+public:
+  /// The type of the executor associated with the subscriber.
+  typedef Executor executor_type;
+
+  /// Move-construct a subscriber from another.
+  /**
+   * @note Following the move, the moved-from object may only be destroyed or
+   * assigned to.
+   */
+  subscriber(subscriber&& other)
+    : state_(static_cast<std::shared_ptr<state_type>&&>(other.state_)),
+      subscriber_(other.subscriber_),
+      executor_(other.executor_)
+  {
+    other.subscriber_ = 0;
+  }
+
+  /// Move-assign a subscriber from another.
+  /**
+   * Ends the subscription previously owned by the target object.
+   *
+   * @note Following the move, the moved-from object may only be destroyed or
+   * assigned to.
+   */
+  subscriber& operator=(subscriber&& other)
+  {
+    if (this != &other)
+    {
+      if (subscriber_)
+        state_->unsubscribe(subscriber_);
+      state_ = static_cast<std::shared_ptr<state_type>&&>(other.state_);
+      subscriber_ = other.subscriber_;
+      other.subscriber_ = 0;
+      executor_.~executor_type();
+      new (&executor_) executor_type(other.executor_);
+    }
+    return *this;
+  }
+
+  /// Destructor.
+  /**
+   * Ends the subscription. Outstanding receive operations complete with the
+   * error @c asio::experimental::error::channel_cancelled.
+   */
+  ~subscriber()
+  {
+    if (subscriber_)
+      state_->unsubscribe(subscriber_);
+  }
+
+  /// Get the executor associated with the object.
+  const executor_type& get_executor() noexcept
+  {
+    return executor_;
+  }
+
+  /// Get the number of messages that this subscriber has missed.
+  /**
+   * Messages are missed only under the broadcast_overflow::drop policy, when
+   * they are overwritten before the subscriber receives them.
+   */
+  uint64_t dropped() const
+  {
+    return state_->dropped(subscriber_);
+  }
+
+  /// Determine whether the subscriber is still connected.
+  /**
+   * A subscriber is disconnected under the broadcast_overflow::disconnect
+   * policy, when a message would overwrite one it has not yet received.
+   */
+  bool is_connected() const
+  {
+    return state_->is_connected(subscriber_);
+  }
+
+  /// Cancel all asynchronous receive operations waiting on the subscriber.
+  /**
+   * Outstanding receive operations complete with the error
+   * @c asio::experimental::error::channel_cancelled.
+   */
+  void cancel()
+  {
+    state_->cancel(subscriber_);
+  }
+
+  /// Try to receive a message without blocking.
+  /**
+   * The handler is called with the signature
+   * <tt>void(asio::error_code, std::shared_ptr<const T>)</tt>. If the channel
+   * is closed and no buffered messages remain, or the subscriber has been
+   * disconnected, the handler receives the error
+   * @c asio::experimental::error::channel_closed.
+   *
+   * @returns @c true if the handler was called, @c false if no message is
+   * available.
+   */
+  template <typename Handler>
+  bool try_receive(Handler&& handler)
+  {
+    return state_->try_receive(subscriber_,
+        static_cast<Handler&&>(handler));
+  }
+
+  /// Asynchronously receive a message.
+  /**
+   * @par Completion Signature
+   * @code void(asio::error_code, std::shared_ptr<const T>) @endcode
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code, payload_type))
+        CompletionToken ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  auto async_receive(
+      CompletionToken&& token
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+    -> decltype(
+        async_initiate<CompletionToken,
+          void (asio::error_code, payload_type)>(
+            declval<initiate_async_receive>(), token))
+  {
+    return async_initiate<CompletionToken,
+      void (asio::error_code, payload_type)>(
+        initiate_async_receive(this), token);
+  }
+
+private:
+  friend class broadcast_channel;
+
+  subscriber(const std::shared_ptr<state_type>& state,
+      const executor_type& ex)
+    : state_(state),
+      subscriber_(state->subscribe()),
+      executor_(ex)
+  {
+  }
+
+  // Disallow copying and assignment.
+  subscriber(const subscriber&) = delete;
+  subscriber& operator=(const subscriber&) = delete;
+
+  class initiate_async_receive
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive(subscriber* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReceiveHandler>
+    void operator()(ReceiveHandler&& handler) const
+    {
+      typedef decay_t<ReceiveHandler> handler_type;
+      asio::detail::non_const_lvalue<ReceiveHandler> handler2(handler);
+
+      associated_cancellation_slot_t<handler_type> slot
+        = asio::get_associated_cancellation_slot(handler2.value);
+
+      // Allocate and construct an operation to wrap the handler.
+      typedef detail::channel_receive_op<receive_payload_type,
+        handler_type, Executor> op;
+      typename op::ptr p = { asio::detail::addressof(handler2.value),
+        op::ptr::allocate(handler2.value), 0 };
+      p.p = new (p.v) op(handler2.value, self_->get_executor());
+
+      // Optionally register for per-operation cancellation.
+      if (slot.is_connected())
+      {
+        p.p->cancellation_key_ =
+          &slot.template emplace<op_cancellation>(self_->state_.get());
+      }
+
+      ASIO_HANDLER_CREATION((asio::query(self_->get_executor(),
+              execution::context), *p.p, "broadcast_channel",
+            self_->state_.get(), 0, "async_receive"));
+
+      self_->state_->start_receive_op(self_->subscriber_, p.p);
+      p.v = p.p = 0;
+    }
+
+  private:
+    subscriber* self_;
+  };
+
+  // The state shared with the channel and other subscribers.
+  std::shared_ptr<state_type> state_;
+
+  // This subscriber's cursor within the shared state.
+  subscriber_type* subscriber_;
+
+  // The associated executor.
+  Executor executor_;
+};
+
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXPERIMENTAL_BROADCAST_CHANNEL_HPP
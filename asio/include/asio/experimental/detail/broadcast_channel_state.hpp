@@ -0,0 +1,453 @@
+//
+// experimental/detail/broadcast_channel_state.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_DETAIL_BROADCAST_CHANNEL_STATE_HPP
+#define ASIO_EXPERIMENTAL_DETAIL_BROADCAST_CHANNEL_STATE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "asio/cancellation_type.hpp"
+#include "asio/detail/completion_message.hpp"
+#include "asio/detail/completion_payload.hpp"
+#include "asio/detail/completion_payload_handler.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/op_queue.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/error_code.hpp"
+#include "asio/experimental/channel_error.hpp"
+#include "asio/experimental/detail/channel_receive_op.hpp"
+#include "asio/experimental/detail/channel_send_op.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+
+/// The action taken by a broadcast channel when a message is sent while a
+/// subscriber has not yet received the oldest buffered message.
+enum class broadcast_overflow
+{
+  /// Overwrite the oldest message. The lagging subscriber skips the messages
+  /// it missed and the number skipped is added to its dropped() count.
+  drop,
+
+  /// Wait until every subscriber has received the oldest message.
+  block,
+
+  /// Disconnect the lagging subscriber. Its receive operations complete with
+  /// the error @c asio::experimental::error::channel_closed.
+  disconnect
+};
+
+namespace detail {
+
+// The state shared by a broadcast channel and its subscribers. Messages are
+// held in a single ring of shared payloads, and each subscriber keeps only the
+// sequence number of the next message it will receive.
+template <typename T>
+class broadcast_channel_state
+{
+public:
+  typedef std::shared_ptr<const T> payload_type;
+  typedef void receive_signature(asio::error_code, payload_type);
+  typedef asio::detail::completion_payload<receive_signature>
+    receive_payload_type;
+
+  // The per-subscriber cursor.
+  struct subscriber_type
+  {
+    uint64_t next_;
+    uint64_t dropped_;
+    bool connected_;
+    asio::detail::op_queue<channel_operation> waiters_;
+    subscriber_type* prev_;
+    subscriber_type* next_subscriber_;
+  };
+
+  broadcast_channel_state(std::size_t capacity, broadcast_overflow policy)
+    : ring_(capacity > 0 ? capacity : 1),
+      policy_(policy),
+      write_seq_(0),
+      subscribers_(0),
+      subscriber_count_(0),
+      open_(true)
+  {
+  }
+
+  ~broadcast_channel_state()
+  {
+    while (channel_operation* op = send_waiters_.front())
+    {
+      send_waiters_.pop();
+      op->destroy();
+    }
+
+    while (subscriber_type* s = subscribers_)
+    {
+      subscribers_ = s->next_subscriber_;
+      while (channel_operation* op = s->waiters_.front())
+      {
+        s->waiters_.pop();
+        op->destroy();
+      }
+      delete s;
+    }
+  }
+
+  std::size_t capacity() const noexcept
+  {
+    return ring_.size();
+  }
+
+  broadcast_overflow policy() const noexcept
+  {
+    return policy_;
+  }
+
+  bool is_open()
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    return open_;
+  }
+
+  std::size_t subscriber_count()
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    return subscriber_count_;
+  }
+
+  // Add a subscriber that will receive messages sent from now on.
+  subscriber_type* subscribe()
+  {
+    subscriber_type* s = new subscriber_type;
+    s->dropped_ = 0;
+    s->prev_ = 0;
+
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    s->next_ = write_seq_;
+    s->connected_ = true;
+    s->next_subscriber_ = subscribers_;
+    if (subscribers_)
+      subscribers_->prev_ = s;
+    subscribers_ = s;
+    ++subscriber_count_;
+    return s;
+  }
+
+  // Remove a subscriber, cancelling any receive operations it has pending.
+  void unsubscribe(subscriber_type* s)
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    if (s->prev_)
+      s->prev_->next_subscriber_ = s->next_subscriber_;
+    else
+      subscribers_ = s->next_subscriber_;
+    if (s->next_subscriber_)
+      s->next_subscriber_->prev_ = s->prev_;
+    --subscriber_count_;
+    complete_waiters(s, error::channel_cancelled);
+    admit_waiting_sends();
+    lock.unlock();
+
+    delete s;
+  }
+
+  uint64_t dropped(subscriber_type* s)
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    return s->dropped_;
+  }
+
+  bool is_connected(subscriber_type* s)
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    return s->connected_;
+  }
+
+  // Close the channel. Waiting senders fail, and subscribers fail once they
+  // have received the messages that are still buffered.
+  void close()
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    open_ = false;
+
+    while (channel_operation* op = send_waiters_.front())
+    {
+      send_waiters_.pop();
+      static_cast<channel_send<payload_type>*>(op)->close();
+    }
+
+    for (subscriber_type* s = subscribers_; s; s = s->next_subscriber_)
+      complete_waiters(s, error::channel_closed);
+  }
+
+  // Cancel the receive operations pending on a single subscriber.
+  void cancel(subscriber_type* s)
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    complete_waiters(s, error::channel_cancelled);
+  }
+
+  // Cancel the operation associated with the specified cancellation key.
+  void cancel_by_key(void* cancellation_key)
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+
+    asio::detail::op_queue<channel_operation> other_ops;
+    while (channel_operation* op = send_waiters_.front())
+    {
+      send_waiters_.pop();
+      if (op->cancellation_key_ == cancellation_key)
+        static_cast<channel_send<payload_type>*>(op)->cancel();
+      else
+        other_ops.push(op);
+    }
+    send_waiters_.push(other_ops);
+
+    for (subscriber_type* s = subscribers_; s; s = s->next_subscriber_)
+    {
+      while (channel_operation* op = s->waiters_.front())
+      {
+        s->waiters_.pop();
+        if (op->cancellation_key_ == cancellation_key)
+          complete(op, error::channel_cancelled, payload_type());
+        else
+          other_ops.push(op);
+      }
+      s->waiters_.push(other_ops);
+    }
+  }
+
+  // Send a message without waiting. Fails if the channel is closed, or if the
+  // policy is to block and the message cannot be buffered.
+  bool try_send(payload_type& payload)
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    if (!open_)
+      return false;
+    if (policy_ == broadcast_overflow::block
+        && (!send_waiters_.empty() || full()))
+      return false;
+    publish(payload);
+    return true;
+  }
+
+  // Start an asynchronous send operation.
+  void start_send_op(channel_send<payload_type>* send_op)
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    if (!open_)
+    {
+      send_op->close();
+      return;
+    }
+
+    if (policy_ == broadcast_overflow::block
+        && (!send_waiters_.empty() || full()))
+    {
+      send_waiters_.push(send_op);
+      return;
+    }
+
+    payload_type payload(send_op->get_payload());
+    publish(payload);
+    lock.unlock();
+
+    send_op->immediate();
+  }
+
+  // Receive a message without waiting.
+  template <typename Handler>
+  bool try_receive(subscriber_type* s, Handler&& handler)
+  {
+    asio::error_code ec;
+    payload_type payload;
+
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    if (!next_message(s, payload))
+    {
+      if (s->connected_ && open_)
+        return false;
+      ec = error::channel_closed;
+    }
+    lock.unlock();
+
+    asio::detail::non_const_lvalue<Handler> handler2(handler);
+    asio::detail::completion_payload_handler<
+      receive_payload_type, decay_t<Handler>>(
+        receive_payload_type(
+          asio::detail::completion_message<receive_signature>(
+            0, ec, static_cast<payload_type&&>(payload))),
+        handler2.value)();
+    return true;
+  }
+
+  // Start an asynchronous receive operation.
+  void start_receive_op(subscriber_type* s,
+      channel_receive<receive_payload_type>* receive_op)
+  {
+    asio::error_code ec;
+    payload_type payload;
+
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    if (!next_message(s, payload))
+    {
+      if (s->connected_ && open_)
+      {
+        s->waiters_.push(receive_op);
+        return;
+      }
+      ec = error::channel_closed;
+    }
+    lock.unlock();
+
+    receive_op->immediate(
+        receive_payload_type(
+          asio::detail::completion_message<receive_signature>(
+            0, ec, static_cast<payload_type&&>(payload))));
+  }
+
+private:
+  // Determine whether sending would overwrite a message that a connected
+  // subscriber has not yet received. The caller must hold the lock.
+  bool full() const
+  {
+    for (subscriber_type* s = subscribers_; s; s = s->next_subscriber_)
+      if (s->connected_ && write_seq_ - s->next_ >= ring_.size())
+        return true;
+    return false;
+  }
+
+  // Add a message to the ring and hand it to any waiting receivers. The caller
+  // must hold the lock.
+  void publish(payload_type& payload)
+  {
+    // A message sent while there are no subscribers is never observed.
+    if (!subscribers_)
+      return;
+
+    for (subscriber_type* s = subscribers_; s; s = s->next_subscriber_)
+    {
+      if (!s->waiters_.empty())
+      {
+        // A subscriber only waits once it has received every buffered
+        // message, so the new message is the one it is waiting for.
+        channel_operation* op = s->waiters_.front();
+        s->waiters_.pop();
+        ++s->next_;
+        complete(op, asio::error_code(), payload);
+      }
+      else if (policy_ == broadcast_overflow::disconnect
+          && s->connected_ && write_seq_ - s->next_ >= ring_.size())
+      {
+        s->connected_ = false;
+      }
+    }
+
+    ring_[write_seq_ % ring_.size()] = static_cast<payload_type&&>(payload);
+    ++write_seq_;
+  }
+
+  // Obtain the next message for a subscriber, if one is available. The caller
+  // must hold the lock.
+  bool next_message(subscriber_type* s, payload_type& payload)
+  {
+    if (!s->connected_ || s->next_ == write_seq_)
+      return false;
+
+    uint64_t oldest = write_seq_ > ring_.size() ? write_seq_ - ring_.size() : 0;
+    if (s->next_ < oldest)
+    {
+      s->dropped_ += oldest - s->next_;
+      s->next_ = oldest;
+    }
+
+    payload = ring_[s->next_++ % ring_.size()];
+    admit_waiting_sends();
+    return true;
+  }
+
+  // Publish the messages of waiting senders while there is room for them. The
+  // caller must hold the lock.
+  void admit_waiting_sends()
+  {
+    while (channel_operation* op = send_waiters_.front())
+    {
+      if (full())
+        return;
+      send_waiters_.pop();
+      channel_send<payload_type>* send_op =
+        static_cast<channel_send<payload_type>*>(op);
+      payload_type payload(send_op->get_payload());
+      publish(payload);
+      send_op->post();
+    }
+  }
+
+  // Complete all receive operations waiting on a subscriber. The caller must
+  // hold the lock.
+  void complete_waiters(subscriber_type* s, const asio::error_code& ec)
+  {
+    while (channel_operation* op = s->waiters_.front())
+    {
+      s->waiters_.pop();
+      complete(op, ec, payload_type());
+    }
+  }
+
+  static void complete(channel_operation* op,
+      const asio::error_code& ec, const payload_type& payload)
+  {
+    static_cast<channel_receive<receive_payload_type>*>(op)->post(
+        receive_payload_type(
+          asio::detail::completion_message<receive_signature>(
+            0, ec, payload)));
+  }
+
+  // Mutex to protect access to the state.
+  asio::detail::mutex mutex_;
+
+  // The ring of the most recently sent messages.
+  std::vector<payload_type> ring_;
+
+  // The action taken when a subscriber falls a full ring behind.
+  const broadcast_overflow policy_;
+
+  // The sequence number to be given to the next message sent.
+  uint64_t write_seq_;
+
+  // The head of a linked list of subscribers.
+  subscriber_type* subscribers_;
+
+  // The number of subscribers in the list.
+  std::size_t subscriber_count_;
+
+  // Whether the channel is open.
+  bool open_;
+
+  // Send operations waiting for room in the ring.
+  asio::detail::op_queue<channel_operation> send_waiters_;
+};
+
+} // namespace detail
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXPERIMENTAL_DETAIL_BROADCAST_CHANNEL_STATE_HPP
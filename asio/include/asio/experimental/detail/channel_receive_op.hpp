@@ -16,6 +16,8 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/associator.hpp"
 #include "asio/detail/bind_handler.hpp"
 #include "asio/detail/completion_handler.hpp"
 #include "asio/detail/handler_alloc_helpers.hpp"
@@ -117,8 +119,108 @@ private:
   channel_operation::handler_work<Handler, IoExecutor> work_;
 };
 
+// Stores the values of received messages into a caller-supplied array. A
+// message is either a value, an error code, or an error code and a value.
+// Receiving stops at the first message that carries an error.
+template <typename T>
+class channel_batch_receiver
+{
+public:
+  explicit channel_batch_receiver(T* values)
+    : values_(values),
+      count_(0)
+  {
+  }
+
+  void operator()(const asio::error_code& ec)
+  {
+    ec_ = ec;
+  }
+
+  template <typename U>
+  enable_if_t<
+    !is_same<decay_t<U>, asio::error_code>::value
+  > operator()(U&& u)
+  {
+    values_[count_++] = static_cast<U&&>(u);
+  }
+
+  template <typename U>
+  void operator()(const asio::error_code& ec, U&& u)
+  {
+    if (ec)
+      ec_ = ec;
+    else
+      values_[count_++] = static_cast<U&&>(u);
+  }
+
+  std::size_t count() const noexcept
+  {
+    return count_;
+  }
+
+  const asio::error_code& error() const noexcept
+  {
+    return ec_;
+  }
+
+private:
+  T* values_;
+  std::size_t count_;
+  asio::error_code ec_;
+};
+
+// Adapts a batch receive handler so that it may wait for a single message
+// using an ordinary receive operation.
+template <typename Handler, typename T>
+class channel_batch_handler
+{
+public:
+  channel_batch_handler(Handler&& handler, T* values)
+    : handler_(static_cast<Handler&&>(handler)),
+      values_(values)
+  {
+  }
+
+  template <typename... Args>
+  void operator()(Args&&... args)
+  {
+    channel_batch_receiver<T> receiver(values_);
+    receiver(static_cast<Args&&>(args)...);
+    static_cast<Handler&&>(handler_)(receiver.error(), receiver.count());
+  }
+
+//private:
+  Handler handler_;
+  T* values_;
+};
+
 } // namespace detail
 } // namespace experimental
+
+template <template <typename, typename> class Associator,
+    typename Handler, typename T, typename DefaultCandidate>
+struct associator<Associator,
+    experimental::detail::channel_batch_handler<Handler, T>,
+    DefaultCandidate>
+  : Associator<Handler, DefaultCandidate>
+{
+  static typename Associator<Handler, DefaultCandidate>::type get(
+      const experimental::detail::channel_batch_handler<Handler, T>& h)
+    noexcept
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static auto get(
+      const experimental::detail::channel_batch_handler<Handler, T>& h,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<Handler, DefaultCandidate>::get(h.handler_, c))
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
 } // namespace asio
 
 #include "asio/detail/pop_options.hpp"
@@ -16,6 +16,8 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <cstddef>
+#include <iterator>
 #include "asio/async_result.hpp"
 #include "asio/detail/completion_message.hpp"
 #include "asio/detail/type_traits.hpp"
@@ -27,6 +29,23 @@ namespace asio {
 namespace experimental {
 namespace detail {
 
+// The type used to pass an element of a range to a message constructor. The
+// elements of an rvalue range are moved.
+template <typename Range>
+struct channel_batch_element
+{
+  typedef decltype(*std::begin(declval<Range&>())) reference;
+
+  typedef conditional_t<is_lvalue_reference<Range>::value,
+      reference, remove_reference_t<reference>&&> type;
+
+  template <typename T>
+  static type forward(T& t)
+  {
+    return static_cast<type>(t);
+  }
+};
+
 template <typename Derived, typename Executor, typename... Signatures>
 class channel_send_functions;
 
@@ -86,6 +105,20 @@ public:
         self->impl_, count, true, static_cast<Args2&&>(args)...);
   }
 
+  template <typename Range, typename... Args2>
+  enable_if_t<
+    is_constructible<asio::detail::completion_message<R(Args...)>,
+      int, const Args2&...,
+      typename channel_batch_element<Range>::type>::value,
+    std::size_t
+  > try_send_batch(Range&& range, const Args2&... args)
+  {
+    typedef asio::detail::completion_message<R(Args...)> message_type;
+    Derived* self = static_cast<Derived*>(this);
+    return self->service_->template try_send_batch<message_type>(
+        self->impl_, static_cast<Range&&>(range), args...);
+  }
+
   template <
       ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
         CompletionToken ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(Executor)>
@@ -115,6 +148,8 @@ class channel_send_functions<Derived, Executor, R(Args...), Signatures...> :
 {
 public:
   using channel_send_functions<Derived, Executor, Signatures...>::try_send;
+  using channel_send_functions<Derived, Executor,
+    Signatures...>::try_send_batch;
   using channel_send_functions<Derived, Executor, Signatures...>::async_send;
 
   template <typename... Args2>
@@ -169,6 +204,20 @@ public:
         self->impl_, count, true, static_cast<Args2&&>(args)...);
   }
 
+  template <typename Range, typename... Args2>
+  enable_if_t<
+    is_constructible<asio::detail::completion_message<R(Args...)>,
+      int, const Args2&...,
+      typename channel_batch_element<Range>::type>::value,
+    std::size_t
+  > try_send_batch(Range&& range, const Args2&... args)
+  {
+    typedef asio::detail::completion_message<R(Args...)> message_type;
+    Derived* self = static_cast<Derived*>(this);
+    return self->service_->template try_send_batch<message_type>(
+        self->impl_, static_cast<Range&&>(range), args...);
+  }
+
   template <
       ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
         CompletionToken ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(Executor)>
@@ -37,6 +37,11 @@ public:
     return static_cast<Payload&&>(payload_);
   }
 
+  Payload& payload()
+  {
+    return payload_;
+  }
+
   void immediate()
   {
     func_(this, immediate_op, 0);
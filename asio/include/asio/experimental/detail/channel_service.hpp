@@ -25,6 +25,7 @@
 #include "asio/detail/op_queue.hpp"
 #include "asio/execution_context.hpp"
 #include "asio/experimental/detail/channel_receive_op.hpp"
+#include "asio/experimental/detail/channel_send_functions.hpp"
 #include "asio/experimental/detail/channel_send_op.hpp"
 #include "asio/experimental/detail/has_signature.hpp"
 
@@ -147,6 +148,13 @@ public:
   std::size_t try_send_n(implementation_type<Traits, Signatures...>& impl,
       std::size_t count, bool via_dispatch, Args&&... args);
 
+  // Synchronously send a new value into the channel for each element of a
+  // range, stopping when the channel can accept no more.
+  template <typename Message, typename Traits,
+      typename... Signatures, typename Range, typename... Args>
+  std::size_t try_send_batch(implementation_type<Traits, Signatures...>& impl,
+      Range&& range, const Args&... args);
+
   // Asynchronously send a new value into the channel.
   template <typename Traits, typename... Signatures,
       typename Handler, typename IoExecutor>
@@ -219,6 +227,50 @@ public:
     p.v = p.p = 0;
   }
 
+  // Synchronously receive as many values as are available, up to the limit
+  // of the receiver, without waiting.
+  template <typename Traits, typename... Signatures, typename T>
+  void try_receive_batch(implementation_type<Traits, Signatures...>& impl,
+      std::size_t max_count, channel_batch_receiver<T>& receiver);
+
+  // Asynchronously receive a batch of values from the channel.
+  template <typename Traits, typename... Signatures,
+      typename T, typename Handler, typename IoExecutor>
+  void async_receive_batch(implementation_type<Traits, Signatures...>& impl,
+      T* values, std::size_t max_count, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    channel_batch_receiver<T> receiver(values);
+    try_receive_batch(impl, max_count, receiver);
+
+    // If nothing is available, wait for a single value.
+    if (receiver.count() == 0 && !receiver.error() && max_count > 0)
+    {
+      channel_batch_handler<Handler, T> batch_handler(
+          static_cast<Handler&&>(handler), values);
+      async_receive(impl, batch_handler, io_ex);
+      return;
+    }
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef asio::detail::completion_payload<
+      void(asio::error_code, std::size_t)> payload_type;
+    typedef channel_receive_op<payload_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(handler, io_ex);
+
+    ASIO_HANDLER_CREATION((this->context(), *p.p,
+          "channel", &impl, 0, "async_receive_batch"));
+
+    op* o = p.p;
+    p.v = p.p = 0;
+    o->immediate(payload_type(
+          asio::detail::completion_message<
+            void(asio::error_code, std::size_t)>(
+              0, receiver.error(), receiver.count())));
+  }
+
 private:
   // Helper function object to handle a closed notification.
   template <typename Payload, typename Signature>
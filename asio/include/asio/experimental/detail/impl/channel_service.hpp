@@ -430,6 +430,56 @@ std::size_t channel_service<Mutex>::try_send_n(
   return count;
 }
 
+template <typename Mutex>
+template <typename Message, typename Traits,
+    typename... Signatures, typename Range, typename... Args>
+std::size_t channel_service<Mutex>::try_send_batch(
+    channel_service<Mutex>::implementation_type<Traits, Signatures...>& impl,
+    Range&& range, const Args&... args)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+
+  typename Mutex::scoped_lock lock(impl.mutex_);
+
+  std::size_t count = 0;
+  for (auto i = std::begin(range), e = std::end(range); i != e; ++i, ++count)
+  {
+    switch (impl.send_state_)
+    {
+    case buffer:
+      {
+        impl.buffer_push(Message(0, args...,
+              channel_batch_element<Range>::forward(*i)));
+        impl.receive_state_ = buffer;
+        if (impl.buffer_size() == impl.max_buffer_size_)
+          impl.send_state_ = block;
+        break;
+      }
+    case waiter:
+      {
+        payload_type payload(Message(0, args...,
+              channel_batch_element<Range>::forward(*i)));
+        channel_receive<payload_type>* receive_op =
+          static_cast<channel_receive<payload_type>*>(impl.waiters_.front());
+        impl.waiters_.pop();
+        if (impl.waiters_.empty())
+          impl.send_state_ = impl.max_buffer_size_ ? buffer : block;
+        receive_op->post(static_cast<payload_type&&>(payload));
+        break;
+      }
+    case block:
+    case closed:
+    default:
+      {
+        return count;
+      }
+    }
+  }
+
+  return count;
+}
+
 template <typename Mutex>
 template <typename Traits, typename... Signatures>
 void channel_service<Mutex>::start_send_op(
@@ -546,6 +596,64 @@ bool channel_service<Mutex>::try_receive(
   }
 }
 
+template <typename Mutex>
+template <typename Traits, typename... Signatures, typename T>
+void channel_service<Mutex>::try_receive_batch(
+    channel_service<Mutex>::implementation_type<Traits, Signatures...>& impl,
+    std::size_t max_count, channel_batch_receiver<T>& receiver)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+
+  typename Mutex::scoped_lock lock(impl.mutex_);
+
+  while (receiver.count() < max_count && !receiver.error())
+  {
+    switch (impl.receive_state_)
+    {
+    case buffer:
+      {
+        payload_type payload(impl.buffer_front());
+        if (channel_send<payload_type>* send_op =
+            static_cast<channel_send<payload_type>*>(impl.waiters_.front()))
+        {
+          impl.buffer_pop();
+          impl.buffer_push(send_op->get_payload());
+          impl.waiters_.pop();
+          send_op->post();
+        }
+        else
+        {
+          impl.buffer_pop();
+          if (impl.buffer_size() == 0)
+            impl.receive_state_ = (impl.send_state_ == closed) ? closed : block;
+          impl.send_state_ = (impl.send_state_ == closed) ? closed : buffer;
+        }
+        payload.receive(receiver);
+        break;
+      }
+    case waiter:
+      {
+        channel_send<payload_type>* send_op =
+          static_cast<channel_send<payload_type>*>(impl.waiters_.front());
+        payload_type payload = send_op->get_payload();
+        impl.waiters_.pop();
+        if (impl.waiters_.front() == 0)
+          impl.receive_state_ = (impl.send_state_ == closed) ? closed : block;
+        send_op->post();
+        payload.receive(receiver);
+        break;
+      }
+    case block:
+    case closed:
+    default:
+      {
+        return;
+      }
+    }
+  }
+}
+
 template <typename Mutex>
 template <typename Traits, typename... Signatures>
 void channel_service<Mutex>::start_receive_op(
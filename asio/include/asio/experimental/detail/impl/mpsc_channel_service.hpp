@@ -0,0 +1,605 @@
+//
+// experimental/detail/impl/mpsc_channel_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_DETAIL_IMPL_MPSC_CHANNEL_SERVICE_HPP
+#define ASIO_EXPERIMENTAL_DETAIL_IMPL_MPSC_CHANNEL_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+namespace detail {
+
+inline mpsc_channel_service::mpsc_channel_service(
+    asio::execution_context& ctx)
+  : asio::detail::execution_context_service_base<mpsc_channel_service>(ctx),
+    mutex_(),
+    impl_list_(0)
+{
+}
+
+inline void mpsc_channel_service::shutdown()
+{
+  // Abandon all pending operations.
+  asio::detail::op_queue<channel_operation> ops;
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  base_implementation_type* impl = impl_list_;
+  while (impl)
+  {
+    ops.push(impl->receive_waiters_);
+    ops.push(impl->send_waiters_);
+    impl = impl->next_;
+  }
+}
+
+template <typename Traits, typename... Signatures>
+void mpsc_channel_service::construct(
+    mpsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    std::size_t max_buffer_size)
+{
+  impl.closed_.store(false, std::memory_order_relaxed);
+  impl.buffer_.allocate(max_buffer_size);
+  base_insert(impl);
+}
+
+template <typename Traits, typename... Signatures>
+void mpsc_channel_service::destroy(
+    mpsc_channel_service::implementation_type<Traits, Signatures...>& impl)
+{
+  cancel(impl);
+  impl.buffer_.clear();
+  base_destroy(impl);
+}
+
+template <typename Traits, typename... Signatures>
+void mpsc_channel_service::move_construct(
+    mpsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    mpsc_channel_service::implementation_type<
+      Traits, Signatures...>& other_impl)
+{
+  impl.closed_.store(other_impl.closed_.load(
+        std::memory_order_relaxed), std::memory_order_relaxed);
+  other_impl.closed_.store(false, std::memory_order_relaxed);
+  impl.buffer_.swap(other_impl.buffer_);
+  base_insert(impl);
+}
+
+template <typename Traits, typename... Signatures>
+void mpsc_channel_service::move_assign(
+    mpsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    mpsc_channel_service& other_service,
+    mpsc_channel_service::implementation_type<
+      Traits, Signatures...>& other_impl)
+{
+  cancel(impl);
+
+  if (this != &other_service)
+    base_destroy(impl);
+
+  impl.closed_.store(other_impl.closed_.load(
+        std::memory_order_relaxed), std::memory_order_relaxed);
+  other_impl.closed_.store(false, std::memory_order_relaxed);
+  impl.buffer_.allocate(0);
+  impl.buffer_.swap(other_impl.buffer_);
+
+  if (this != &other_service)
+    other_service.base_insert(impl);
+}
+
+inline void mpsc_channel_service::base_insert(
+    mpsc_channel_service::base_implementation_type& impl)
+{
+  // Insert implementation into linked list of all implementations.
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  impl.next_ = impl_list_;
+  impl.prev_ = 0;
+  if (impl_list_)
+    impl_list_->prev_ = &impl;
+  impl_list_ = &impl;
+}
+
+inline void mpsc_channel_service::base_destroy(
+    mpsc_channel_service::base_implementation_type& impl)
+{
+  // Remove implementation from linked list of all implementations.
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  if (impl_list_ == &impl)
+    impl_list_ = impl.next_;
+  if (impl.prev_)
+    impl.prev_->next_ = impl.next_;
+  if (impl.next_)
+    impl.next_->prev_= impl.prev_;
+  impl.next_ = 0;
+  impl.prev_ = 0;
+}
+
+template <typename Traits, typename... Signatures>
+inline std::size_t mpsc_channel_service::capacity(
+    const mpsc_channel_service::implementation_type<
+      Traits, Signatures...>& impl) const noexcept
+{
+  return impl.buffer_.capacity();
+}
+
+inline bool mpsc_channel_service::is_open(
+    const mpsc_channel_service::base_implementation_type& impl)
+  const noexcept
+{
+  return !impl.closed_.load(std::memory_order_acquire);
+}
+
+template <typename Traits, typename... Signatures>
+void mpsc_channel_service::reset(
+    mpsc_channel_service::implementation_type<Traits, Signatures...>& impl)
+{
+  cancel(impl);
+
+  asio::detail::mutex::scoped_lock lock(impl.mutex_);
+
+  impl.buffer_.clear();
+  impl.closed_.store(false, std::memory_order_release);
+}
+
+template <typename Traits, typename... Signatures>
+void mpsc_channel_service::close(
+    mpsc_channel_service::implementation_type<Traits, Signatures...>& impl)
+{
+  asio::detail::mutex::scoped_lock lock(impl.mutex_);
+
+  // Waiting receive operations are completed once no messages remain.
+  impl.closed_.store(true, std::memory_order_release);
+  transfer(impl);
+}
+
+template <typename Traits, typename... Signatures>
+void mpsc_channel_service::cancel(
+    mpsc_channel_service::implementation_type<Traits, Signatures...>& impl)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::traits_type traits_type;
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+
+  asio::detail::mutex::scoped_lock lock(impl.mutex_);
+
+  while (channel_operation* op = impl.send_waiters_.front())
+  {
+    impl.send_waiters_.pop();
+    static_cast<channel_send<payload_type>*>(op)->cancel();
+  }
+
+  while (channel_operation* op = impl.receive_waiters_.front())
+  {
+    impl.receive_waiters_.pop();
+    traits_type::invoke_receive_cancelled(
+        post_receive<payload_type,
+          typename traits_type::receive_cancelled_signature>(
+            static_cast<channel_receive<payload_type>*>(op)));
+  }
+
+  impl.send_waiting_.store(false, std::memory_order_relaxed);
+  impl.receive_waiting_.store(false, std::memory_order_relaxed);
+}
+
+template <typename Traits, typename... Signatures>
+void mpsc_channel_service::cancel_by_key(
+    mpsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    void* cancellation_key)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::traits_type traits_type;
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+
+  asio::detail::mutex::scoped_lock lock(impl.mutex_);
+
+  asio::detail::op_queue<channel_operation> other_ops;
+  while (channel_operation* op = impl.send_waiters_.front())
+  {
+    impl.send_waiters_.pop();
+    if (op->cancellation_key_ == cancellation_key)
+      static_cast<channel_send<payload_type>*>(op)->cancel();
+    else
+      other_ops.push(op);
+  }
+  impl.send_waiters_.push(other_ops);
+
+  while (channel_operation* op = impl.receive_waiters_.front())
+  {
+    impl.receive_waiters_.pop();
+    if (op->cancellation_key_ == cancellation_key)
+    {
+      traits_type::invoke_receive_cancelled(
+          post_receive<payload_type,
+            typename traits_type::receive_cancelled_signature>(
+              static_cast<channel_receive<payload_type>*>(op)));
+    }
+    else
+      other_ops.push(op);
+  }
+  impl.receive_waiters_.push(other_ops);
+
+  impl.send_waiting_.store(!impl.send_waiters_.empty(),
+      std::memory_order_relaxed);
+  impl.receive_waiting_.store(!impl.receive_waiters_.empty(),
+      std::memory_order_relaxed);
+}
+
+template <typename Traits, typename... Signatures>
+inline bool mpsc_channel_service::ready(
+    const mpsc_channel_service::implementation_type<
+      Traits, Signatures...>& impl) const noexcept
+{
+  return !impl.buffer_.empty()
+    || impl.send_waiting_.load(std::memory_order_acquire)
+    || impl.closed_.load(std::memory_order_acquire);
+}
+
+template <typename Message, typename Traits,
+    typename... Signatures, typename... Args>
+bool mpsc_channel_service::try_send(
+    mpsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    bool via_dispatch, Args&&... args)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+
+  if (impl.closed_.load(std::memory_order_acquire))
+    return false;
+
+  // Avoid consuming the arguments when the message cannot be buffered.
+  if (impl.buffer_.full()
+      && !impl.receive_waiting_.load(std::memory_order_acquire))
+    return false;
+
+  payload_type payload(Message(0, static_cast<Args&&>(args)...));
+  return try_send_payload(impl, payload, via_dispatch);
+}
+
+template <typename Message, typename Traits,
+    typename... Signatures, typename... Args>
+std::size_t mpsc_channel_service::try_send_n(
+    mpsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    std::size_t count, bool via_dispatch, Args&&... args)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+
+  if (count == 0 || impl.closed_.load(std::memory_order_acquire))
+    return 0;
+
+  // Avoid consuming the arguments when no message can be buffered.
+  if (impl.buffer_.full()
+      && !impl.receive_waiting_.load(std::memory_order_acquire))
+    return 0;
+
+  payload_type payload(Message(0, static_cast<Args&&>(args)...));
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    payload_type tmp(payload);
+    if (!try_send_payload(impl, tmp, via_dispatch))
+      return i;
+  }
+
+  return count;
+}
+
+template <typename Message, typename Traits,
+    typename... Signatures, typename Range, typename... Args>
+std::size_t mpsc_channel_service::try_send_batch(
+    mpsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    Range&& range, const Args&... args)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+
+  // The ring is lock-free, so each message is sent individually.
+  std::size_t count = 0;
+  for (auto i = std::begin(range), e = std::end(range); i != e; ++i, ++count)
+  {
+    if (impl.closed_.load(std::memory_order_acquire))
+      return count;
+
+    // Avoid consuming the element when no message can be buffered.
+    if (impl.buffer_.full()
+        && !impl.receive_waiting_.load(std::memory_order_acquire))
+      return count;
+
+    payload_type payload(Message(0, args...,
+          channel_batch_element<Range>::forward(*i)));
+    if (!try_send_payload(impl, payload, false))
+      return count;
+  }
+
+  return count;
+}
+
+template <typename Traits, typename... Signatures>
+bool mpsc_channel_service::try_send_payload(
+    mpsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    typename mpsc_channel_service::implementation_type<
+      Traits, Signatures...>::payload_type& payload, bool via_dispatch)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+  typedef typename implementation_type<Traits,
+      Signatures...>::buffer_type buffer_type;
+
+  if (impl.buffer_.try_push(payload))
+  {
+    // Pairs with the fence in start_receive_op, so that either this thread
+    // sees the waiting receiver, or the receiver sees the new value.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (impl.receive_waiting_.load(std::memory_order_relaxed))
+    {
+      asio::detail::mutex::scoped_lock lock(impl.mutex_);
+      if (via_dispatch && impl.receive_waiters_.front())
+      {
+        typename buffer_type::value_holder value;
+        if (impl.buffer_.try_pop(value))
+        {
+          channel_receive<payload_type>* receive_op =
+            static_cast<channel_receive<payload_type>*>(
+                impl.receive_waiters_.front());
+          impl.receive_waiters_.pop();
+          transfer(impl);
+          lock.unlock();
+          receive_op->dispatch(static_cast<payload_type&&>(value.get()));
+          return true;
+        }
+      }
+      transfer(impl);
+    }
+    return true;
+  }
+
+  // An unbuffered channel hands the value directly to a waiting receiver.
+  if (impl.buffer_.capacity() == 0
+      && impl.receive_waiting_.load(std::memory_order_acquire))
+  {
+    asio::detail::mutex::scoped_lock lock(impl.mutex_);
+    if (channel_receive<payload_type>* receive_op =
+        static_cast<channel_receive<payload_type>*>(
+          impl.receive_waiters_.front()))
+    {
+      impl.receive_waiters_.pop();
+      transfer(impl);
+      lock.unlock();
+      if (via_dispatch)
+        receive_op->dispatch(static_cast<payload_type&&>(payload));
+      else
+        receive_op->post(static_cast<payload_type&&>(payload));
+      return true;
+    }
+  }
+
+  return false;
+}
+
+template <typename Traits, typename... Signatures>
+void mpsc_channel_service::wake_receivers(
+    mpsc_channel_service::implementation_type<Traits, Signatures...>& impl)
+{
+  // Pairs with the fence in start_receive_op.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (impl.receive_waiting_.load(std::memory_order_relaxed))
+  {
+    asio::detail::mutex::scoped_lock lock(impl.mutex_);
+    transfer(impl);
+  }
+}
+
+template <typename Traits, typename... Signatures>
+void mpsc_channel_service::wake_senders(
+    mpsc_channel_service::implementation_type<Traits, Signatures...>& impl)
+{
+  // Pairs with the fence in start_send_op.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (impl.send_waiting_.load(std::memory_order_relaxed))
+  {
+    asio::detail::mutex::scoped_lock lock(impl.mutex_);
+    transfer(impl);
+  }
+}
+
+template <typename Traits, typename... Signatures>
+void mpsc_channel_service::transfer(
+    mpsc_channel_service::implementation_type<Traits, Signatures...>& impl)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::traits_type traits_type;
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+  typedef typename implementation_type<Traits,
+      Signatures...>::buffer_type buffer_type;
+
+  for (;;)
+  {
+    // Move the messages of waiting senders into the buffer while there is
+    // space available.
+    while (channel_send<payload_type>* send_op =
+        static_cast<channel_send<payload_type>*>(impl.send_waiters_.front()))
+    {
+      if (!impl.buffer_.try_push(send_op->payload()))
+        break;
+      impl.send_waiters_.pop();
+      send_op->post();
+    }
+
+    channel_receive<payload_type>* receive_op =
+      static_cast<channel_receive<payload_type>*>(
+          impl.receive_waiters_.front());
+    if (!receive_op)
+      break;
+
+    typename buffer_type::value_holder value;
+    if (impl.buffer_.try_pop(value))
+    {
+      impl.receive_waiters_.pop();
+      receive_op->post(static_cast<payload_type&&>(value.get()));
+    }
+    else if (channel_send<payload_type>* send_op =
+        static_cast<channel_send<payload_type>*>(impl.send_waiters_.front()))
+    {
+      // The channel is unbuffered, so the message passes directly from the
+      // sender to the receiver.
+      impl.send_waiters_.pop();
+      impl.receive_waiters_.pop();
+      receive_op->post(send_op->get_payload());
+      send_op->post();
+    }
+    else
+    {
+      // No messages remain, so a closed channel completes the receivers.
+      if (impl.closed_.load(std::memory_order_relaxed))
+      {
+        while (channel_operation* op = impl.receive_waiters_.front())
+        {
+          impl.receive_waiters_.pop();
+          traits_type::invoke_receive_closed(
+              post_receive<payload_type,
+                typename traits_type::receive_closed_signature>(
+                  static_cast<channel_receive<payload_type>*>(op)));
+        }
+      }
+      break;
+    }
+  }
+
+  impl.send_waiting_.store(!impl.send_waiters_.empty(),
+      std::memory_order_relaxed);
+  impl.receive_waiting_.store(!impl.receive_waiters_.empty(),
+      std::memory_order_relaxed);
+}
+
+template <typename Traits, typename... Signatures>
+void mpsc_channel_service::start_send_op(
+    mpsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    channel_send<typename implementation_type<
+      Traits, Signatures...>::payload_type>* send_op)
+{
+  if (impl.closed_.load(std::memory_order_acquire))
+  {
+    send_op->close();
+    return;
+  }
+
+  if (impl.buffer_.try_push(send_op->payload()))
+  {
+    wake_receivers(impl);
+    send_op->immediate();
+    return;
+  }
+
+  asio::detail::mutex::scoped_lock lock(impl.mutex_);
+
+  impl.send_waiters_.push(send_op);
+  impl.send_waiting_.store(true, std::memory_order_relaxed);
+
+  // Pairs with the fence in wake_senders, so that either this thread sees the
+  // space made by a receiver, or the receiver sees the waiting sender.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  transfer(impl);
+}
+
+template <typename Traits, typename... Signatures, typename Handler>
+bool mpsc_channel_service::try_receive(
+    mpsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    Handler&& handler)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+  typedef typename implementation_type<Traits,
+      Signatures...>::buffer_type buffer_type;
+
+  typename buffer_type::value_holder value;
+  if (impl.buffer_.try_pop(value))
+  {
+    wake_senders(impl);
+  }
+  else
+  {
+    if (!impl.send_waiting_.load(std::memory_order_acquire))
+      return false;
+
+    asio::detail::mutex::scoped_lock lock(impl.mutex_);
+    transfer(impl);
+    if (!impl.buffer_.try_pop(value))
+    {
+      // The channel is unbuffered, so take the message directly from a
+      // waiting sender.
+      channel_send<payload_type>* send_op =
+        static_cast<channel_send<payload_type>*>(impl.send_waiters_.front());
+      if (!send_op)
+        return false;
+      payload_type payload(send_op->get_payload());
+      impl.send_waiters_.pop();
+      send_op->post();
+      transfer(impl);
+      lock.unlock();
+      asio::detail::non_const_lvalue<Handler> handler2(handler);
+      asio::detail::completion_payload_handler<
+        payload_type, decay_t<Handler>>(
+          static_cast<payload_type&&>(payload), handler2.value)();
+      return true;
+    }
+    transfer(impl);
+  }
+
+  asio::detail::non_const_lvalue<Handler> handler2(handler);
+  asio::detail::completion_payload_handler<
+    payload_type, decay_t<Handler>>(
+      static_cast<payload_type&&>(value.get()), handler2.value)();
+  return true;
+}
+
+template <typename Traits, typename... Signatures>
+void mpsc_channel_service::start_receive_op(
+    mpsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    channel_receive<typename implementation_type<
+      Traits, Signatures...>::payload_type>* receive_op)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+  typedef typename implementation_type<Traits,
+      Signatures...>::buffer_type buffer_type;
+
+  typename buffer_type::value_holder value;
+  if (impl.buffer_.try_pop(value))
+  {
+    wake_senders(impl);
+    receive_op->immediate(static_cast<payload_type&&>(value.get()));
+    return;
+  }
+
+  asio::detail::mutex::scoped_lock lock(impl.mutex_);
+
+  impl.receive_waiters_.push(receive_op);
+  impl.receive_waiting_.store(true, std::memory_order_relaxed);
+
+  // Pairs with the fence in try_send_payload and wake_receivers, so that
+  // either this thread sees the new value, or the sender sees the waiting
+  // receiver.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  transfer(impl);
+}
+
+} // namespace detail
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXPERIMENTAL_DETAIL_IMPL_MPSC_CHANNEL_SERVICE_HPP
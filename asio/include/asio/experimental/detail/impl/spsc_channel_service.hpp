@@ -0,0 +1,592 @@
+//
+// experimental/detail/impl/spsc_channel_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_DETAIL_IMPL_SPSC_CHANNEL_SERVICE_HPP
+#define ASIO_EXPERIMENTAL_DETAIL_IMPL_SPSC_CHANNEL_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+namespace detail {
+
+inline spsc_channel_service::spsc_channel_service(
+    asio::execution_context& ctx)
+  : asio::detail::execution_context_service_base<spsc_channel_service>(ctx),
+    mutex_(),
+    impl_list_(0)
+{
+}
+
+inline void spsc_channel_service::shutdown()
+{
+  // Abandon all pending operations.
+  asio::detail::op_queue<channel_operation> ops;
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  base_implementation_type* impl = impl_list_;
+  while (impl)
+  {
+    if (channel_operation* op = impl->receive_waiter_.exchange(
+          0, std::memory_order_acquire))
+      ops.push(op);
+    if (channel_operation* op = impl->send_waiter_.exchange(
+          0, std::memory_order_acquire))
+      ops.push(op);
+    impl = impl->next_;
+  }
+}
+
+template <typename Traits, typename... Signatures>
+void spsc_channel_service::construct(
+    spsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    std::size_t max_buffer_size)
+{
+  // The ring needs at least one slot to pass a message between the two sides.
+  impl.closed_.store(false, std::memory_order_relaxed);
+  impl.buffer_.allocate(max_buffer_size > 0 ? max_buffer_size : 1);
+  base_insert(impl);
+}
+
+template <typename Traits, typename... Signatures>
+void spsc_channel_service::destroy(
+    spsc_channel_service::implementation_type<Traits, Signatures...>& impl)
+{
+  cancel(impl);
+  impl.buffer_.clear();
+  base_destroy(impl);
+}
+
+template <typename Traits, typename... Signatures>
+void spsc_channel_service::move_construct(
+    spsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    spsc_channel_service::implementation_type<
+      Traits, Signatures...>& other_impl)
+{
+  impl.closed_.store(other_impl.closed_.load(
+        std::memory_order_relaxed), std::memory_order_relaxed);
+  other_impl.closed_.store(false, std::memory_order_relaxed);
+  impl.buffer_.swap(other_impl.buffer_);
+  base_insert(impl);
+}
+
+template <typename Traits, typename... Signatures>
+void spsc_channel_service::move_assign(
+    spsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    spsc_channel_service& other_service,
+    spsc_channel_service::implementation_type<
+      Traits, Signatures...>& other_impl)
+{
+  cancel(impl);
+
+  if (this != &other_service)
+    base_destroy(impl);
+
+  impl.closed_.store(other_impl.closed_.load(
+        std::memory_order_relaxed), std::memory_order_relaxed);
+  other_impl.closed_.store(false, std::memory_order_relaxed);
+  impl.buffer_.allocate(0);
+  impl.buffer_.swap(other_impl.buffer_);
+
+  if (this != &other_service)
+    other_service.base_insert(impl);
+}
+
+inline void spsc_channel_service::base_insert(
+    spsc_channel_service::base_implementation_type& impl)
+{
+  // Insert implementation into linked list of all implementations.
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  impl.next_ = impl_list_;
+  impl.prev_ = 0;
+  if (impl_list_)
+    impl_list_->prev_ = &impl;
+  impl_list_ = &impl;
+}
+
+inline void spsc_channel_service::base_destroy(
+    spsc_channel_service::base_implementation_type& impl)
+{
+  // Remove implementation from linked list of all implementations.
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  if (impl_list_ == &impl)
+    impl_list_ = impl.next_;
+  if (impl.prev_)
+    impl.prev_->next_ = impl.next_;
+  if (impl.next_)
+    impl.next_->prev_= impl.prev_;
+  impl.next_ = 0;
+  impl.prev_ = 0;
+}
+
+template <typename Traits, typename... Signatures>
+inline std::size_t spsc_channel_service::capacity(
+    const spsc_channel_service::implementation_type<
+      Traits, Signatures...>& impl) const noexcept
+{
+  return impl.buffer_.capacity();
+}
+
+inline bool spsc_channel_service::is_open(
+    const spsc_channel_service::base_implementation_type& impl)
+  const noexcept
+{
+  return !impl.closed_.load(std::memory_order_acquire);
+}
+
+template <typename Traits, typename... Signatures>
+void spsc_channel_service::reset(
+    spsc_channel_service::implementation_type<Traits, Signatures...>& impl)
+{
+  cancel(impl);
+  impl.buffer_.clear();
+  impl.closed_.store(false, std::memory_order_release);
+}
+
+template <typename Traits, typename... Signatures>
+void spsc_channel_service::close(
+    spsc_channel_service::implementation_type<Traits, Signatures...>& impl)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::traits_type traits_type;
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+  typedef typename implementation_type<Traits,
+      Signatures...>::buffer_type buffer_type;
+
+  impl.closed_.store(true, std::memory_order_release);
+
+  // Pairs with the fences in park_send_op and park_receive_op, so that either
+  // this thread sees the parked operation, or the operation sees the close.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if (channel_operation* op = impl.send_waiter_.exchange(
+        0, std::memory_order_acquire))
+    static_cast<channel_send<payload_type>*>(op)->close();
+
+  // A waiting receive operation takes a buffered message if there is one.
+  if (channel_operation* op = impl.receive_waiter_.exchange(
+        0, std::memory_order_acquire))
+  {
+    channel_receive<payload_type>* receive_op =
+      static_cast<channel_receive<payload_type>*>(op);
+    typename buffer_type::value_holder value;
+    if (impl.buffer_.try_pop(value))
+      receive_op->post(static_cast<payload_type&&>(value.get()));
+    else
+    {
+      traits_type::invoke_receive_closed(
+          post_receive<payload_type,
+            typename traits_type::receive_closed_signature>(receive_op));
+    }
+  }
+}
+
+template <typename Traits, typename... Signatures>
+void spsc_channel_service::cancel(
+    spsc_channel_service::implementation_type<Traits, Signatures...>& impl)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::traits_type traits_type;
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+
+  if (channel_operation* op = impl.send_waiter_.exchange(
+        0, std::memory_order_acquire))
+    static_cast<channel_send<payload_type>*>(op)->cancel();
+
+  if (channel_operation* op = impl.receive_waiter_.exchange(
+        0, std::memory_order_acquire))
+  {
+    traits_type::invoke_receive_cancelled(
+        post_receive<payload_type,
+          typename traits_type::receive_cancelled_signature>(
+            static_cast<channel_receive<payload_type>*>(op)));
+  }
+}
+
+template <typename Traits, typename... Signatures>
+void spsc_channel_service::cancel_by_key(
+    spsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    void* cancellation_key)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::traits_type traits_type;
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+
+  // An operation that does not match the key is parked again. Parking
+  // rechecks the channel state, since the operation may have become ready
+  // while it was claimed here.
+  if (channel_operation* op = impl.send_waiter_.exchange(
+        0, std::memory_order_acquire))
+  {
+    channel_send<payload_type>* send_op =
+      static_cast<channel_send<payload_type>*>(op);
+    if (op->cancellation_key_ == cancellation_key)
+      send_op->cancel();
+    else
+      park_send_op(impl, send_op, false);
+  }
+
+  if (channel_operation* op = impl.receive_waiter_.exchange(
+        0, std::memory_order_acquire))
+  {
+    channel_receive<payload_type>* receive_op =
+      static_cast<channel_receive<payload_type>*>(op);
+    if (op->cancellation_key_ == cancellation_key)
+    {
+      traits_type::invoke_receive_cancelled(
+          post_receive<payload_type,
+            typename traits_type::receive_cancelled_signature>(receive_op));
+    }
+    else
+      park_receive_op(impl, receive_op, false);
+  }
+}
+
+template <typename Traits, typename... Signatures>
+inline bool spsc_channel_service::ready(
+    const spsc_channel_service::implementation_type<
+      Traits, Signatures...>& impl) const noexcept
+{
+  return !impl.buffer_.empty()
+    || impl.closed_.load(std::memory_order_acquire);
+}
+
+template <typename Message, typename Traits,
+    typename... Signatures, typename... Args>
+bool spsc_channel_service::try_send(
+    spsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    bool via_dispatch, Args&&... args)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+
+  if (impl.closed_.load(std::memory_order_acquire))
+    return false;
+
+  // Avoid consuming the arguments when the message cannot be buffered.
+  if (impl.buffer_.full())
+    return false;
+
+  payload_type payload(Message(0, static_cast<Args&&>(args)...));
+  return try_send_payload(impl, payload, via_dispatch);
+}
+
+template <typename Message, typename Traits,
+    typename... Signatures, typename... Args>
+std::size_t spsc_channel_service::try_send_n(
+    spsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    std::size_t count, bool via_dispatch, Args&&... args)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+
+  if (count == 0 || impl.closed_.load(std::memory_order_acquire))
+    return 0;
+
+  // Avoid consuming the arguments when no message can be buffered.
+  if (impl.buffer_.full())
+    return 0;
+
+  payload_type payload(Message(0, static_cast<Args&&>(args)...));
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    payload_type tmp(payload);
+    if (!try_send_payload(impl, tmp, via_dispatch))
+      return i;
+  }
+
+  return count;
+}
+
+template <typename Message, typename Traits,
+    typename... Signatures, typename Range, typename... Args>
+std::size_t spsc_channel_service::try_send_batch(
+    spsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    Range&& range, const Args&... args)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+
+  std::size_t count = 0;
+  for (auto i = std::begin(range), e = std::end(range); i != e; ++i, ++count)
+  {
+    if (impl.closed_.load(std::memory_order_acquire))
+      return count;
+
+    // Avoid consuming the element when no message can be buffered.
+    if (impl.buffer_.full())
+      return count;
+
+    payload_type payload(Message(0, args...,
+          channel_batch_element<Range>::forward(*i)));
+    if (!try_send_payload(impl, payload, false))
+      return count;
+  }
+
+  return count;
+}
+
+template <typename Traits, typename... Signatures>
+bool spsc_channel_service::try_send_payload(
+    spsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    typename spsc_channel_service::implementation_type<
+      Traits, Signatures...>::payload_type& payload, bool via_dispatch)
+{
+  if (!impl.buffer_.try_push(payload))
+    return false;
+
+  wake_receiver(impl, via_dispatch);
+  return true;
+}
+
+template <typename Traits, typename... Signatures>
+void spsc_channel_service::wake_receiver(
+    spsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    bool via_dispatch)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::traits_type traits_type;
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+  typedef typename implementation_type<Traits,
+      Signatures...>::buffer_type buffer_type;
+
+  // Pairs with the fence in park_receive_op, so that either this thread sees
+  // the parked receiver, or the receiver sees the new value. The receiver is
+  // signalled only when it is parked, and the completion is delivered through
+  // its own executor.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!impl.receive_waiter_.load(std::memory_order_relaxed))
+    return;
+
+  channel_operation* op = impl.receive_waiter_.exchange(
+      0, std::memory_order_acquire);
+  if (!op)
+    return;
+
+  channel_receive<payload_type>* receive_op =
+    static_cast<channel_receive<payload_type>*>(op);
+  typename buffer_type::value_holder value;
+  if (impl.buffer_.try_pop(value))
+  {
+    wake_sender(impl);
+    if (via_dispatch)
+      receive_op->dispatch(static_cast<payload_type&&>(value.get()));
+    else
+      receive_op->post(static_cast<payload_type&&>(value.get()));
+  }
+  else if (impl.closed_.load(std::memory_order_acquire))
+  {
+    traits_type::invoke_receive_closed(
+        post_receive<payload_type,
+          typename traits_type::receive_closed_signature>(receive_op));
+  }
+  else
+    park_receive_op(impl, receive_op, false);
+}
+
+template <typename Traits, typename... Signatures>
+void spsc_channel_service::wake_sender(
+    spsc_channel_service::implementation_type<Traits, Signatures...>& impl)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+
+  // Pairs with the fence in park_send_op, so that either this thread sees the
+  // parked sender, or the sender sees the space made in the buffer.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!impl.send_waiter_.load(std::memory_order_relaxed))
+    return;
+
+  channel_operation* op = impl.send_waiter_.exchange(
+      0, std::memory_order_acquire);
+  if (!op)
+    return;
+
+  channel_send<payload_type>* send_op =
+    static_cast<channel_send<payload_type>*>(op);
+  if (impl.closed_.load(std::memory_order_acquire))
+    send_op->close();
+  else if (impl.buffer_.try_push(send_op->payload()))
+  {
+    wake_receiver(impl, false);
+    send_op->post();
+  }
+  else
+    park_send_op(impl, send_op, false);
+}
+
+template <typename Traits, typename... Signatures>
+void spsc_channel_service::park_receive_op(
+    spsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    channel_receive<typename implementation_type<
+      Traits, Signatures...>::payload_type>* receive_op, bool is_immediate)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::traits_type traits_type;
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+  typedef typename implementation_type<Traits,
+      Signatures...>::buffer_type buffer_type;
+
+  for (;;)
+  {
+    impl.receive_waiter_.store(receive_op, std::memory_order_release);
+
+    // Pairs with the fences in wake_receiver and close.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (impl.buffer_.empty() && !impl.closed_.load(std::memory_order_relaxed))
+      return;
+
+    // A value or a close arrived while parking. Unless the other side has
+    // already claimed the operation, complete it here.
+    if (!impl.receive_waiter_.exchange(0, std::memory_order_acquire))
+      return;
+
+    typename buffer_type::value_holder value;
+    if (impl.buffer_.try_pop(value))
+    {
+      wake_sender(impl);
+      if (is_immediate)
+        receive_op->immediate(static_cast<payload_type&&>(value.get()));
+      else
+        receive_op->post(static_cast<payload_type&&>(value.get()));
+      return;
+    }
+
+    if (impl.closed_.load(std::memory_order_acquire))
+    {
+      traits_type::invoke_receive_closed(
+          post_receive<payload_type,
+            typename traits_type::receive_closed_signature>(receive_op));
+      return;
+    }
+  }
+}
+
+template <typename Traits, typename... Signatures>
+void spsc_channel_service::park_send_op(
+    spsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    channel_send<typename implementation_type<
+      Traits, Signatures...>::payload_type>* send_op, bool is_immediate)
+{
+  for (;;)
+  {
+    impl.send_waiter_.store(send_op, std::memory_order_release);
+
+    // Pairs with the fences in wake_sender and close.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (impl.buffer_.full() && !impl.closed_.load(std::memory_order_relaxed))
+      return;
+
+    // Space or a close arrived while parking. Unless the other side has
+    // already claimed the operation, complete it here.
+    if (!impl.send_waiter_.exchange(0, std::memory_order_acquire))
+      return;
+
+    if (impl.closed_.load(std::memory_order_acquire))
+    {
+      send_op->close();
+      return;
+    }
+
+    if (impl.buffer_.try_push(send_op->payload()))
+    {
+      wake_receiver(impl, false);
+      if (is_immediate)
+        send_op->immediate();
+      else
+        send_op->post();
+      return;
+    }
+  }
+}
+
+template <typename Traits, typename... Signatures>
+void spsc_channel_service::start_send_op(
+    spsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    channel_send<typename implementation_type<
+      Traits, Signatures...>::payload_type>* send_op)
+{
+  if (impl.closed_.load(std::memory_order_acquire))
+  {
+    send_op->close();
+    return;
+  }
+
+  if (impl.buffer_.try_push(send_op->payload()))
+  {
+    wake_receiver(impl, false);
+    send_op->immediate();
+    return;
+  }
+
+  park_send_op(impl, send_op, true);
+}
+
+template <typename Traits, typename... Signatures, typename Handler>
+bool spsc_channel_service::try_receive(
+    spsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    Handler&& handler)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+  typedef typename implementation_type<Traits,
+      Signatures...>::buffer_type buffer_type;
+
+  typename buffer_type::value_holder value;
+  if (!impl.buffer_.try_pop(value))
+    return false;
+
+  wake_sender(impl);
+
+  asio::detail::non_const_lvalue<Handler> handler2(handler);
+  asio::detail::completion_payload_handler<
+    payload_type, decay_t<Handler>>(
+      static_cast<payload_type&&>(value.get()), handler2.value)();
+  return true;
+}
+
+template <typename Traits, typename... Signatures>
+void spsc_channel_service::start_receive_op(
+    spsc_channel_service::implementation_type<Traits, Signatures...>& impl,
+    channel_receive<typename implementation_type<
+      Traits, Signatures...>::payload_type>* receive_op)
+{
+  typedef typename implementation_type<Traits,
+      Signatures...>::payload_type payload_type;
+  typedef typename implementation_type<Traits,
+      Signatures...>::buffer_type buffer_type;
+
+  typename buffer_type::value_holder value;
+  if (impl.buffer_.try_pop(value))
+  {
+    wake_sender(impl);
+    receive_op->immediate(static_cast<payload_type&&>(value.get()));
+    return;
+  }
+
+  park_receive_op(impl, receive_op, true);
+}
+
+} // namespace detail
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXPERIMENTAL_DETAIL_IMPL_SPSC_CHANNEL_SERVICE_HPP
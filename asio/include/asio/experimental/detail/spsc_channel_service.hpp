@@ -0,0 +1,390 @@
+//
+// experimental/detail/spsc_channel_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_DETAIL_SPSC_CHANNEL_SERVICE_HPP
+#define ASIO_EXPERIMENTAL_DETAIL_SPSC_CHANNEL_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include "asio/associated_cancellation_slot.hpp"
+#include "asio/cancellation_type.hpp"
+#include "asio/detail/bounded_spsc_queue.hpp"
+#include "asio/detail/completion_message.hpp"
+#include "asio/detail/completion_payload.hpp"
+#include "asio/detail/completion_payload_handler.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/op_queue.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/experimental/detail/channel_receive_op.hpp"
+#include "asio/experimental/detail/channel_send_functions.hpp"
+#include "asio/experimental/detail/channel_send_op.hpp"
+#include "asio/experimental/detail/has_signature.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+namespace detail {
+
+// A channel service for exactly one producer and one consumer. Messages are
+// held in a wait-free ring and no mutex is taken by sends or receives. Each
+// side may park at most one operation, in an atomic slot. The other side checks
+// the slot only after it changes the ring, and claims the parked operation with
+// an atomic exchange. Whoever claims a parked operation also takes over that
+// side's role in the ring until the operation is completed or parked again.
+class spsc_channel_service
+  : public asio::detail::execution_context_service_base<spsc_channel_service>
+{
+public:
+  // The base implementation type of all channels.
+  struct base_implementation_type
+  {
+    // Default constructor.
+    base_implementation_type()
+      : closed_(false),
+        receive_waiter_(0),
+        send_waiter_(0),
+        next_(0),
+        prev_(0)
+    {
+    }
+
+    // Whether the channel has been closed.
+    std::atomic<bool> closed_;
+
+    // The receive operation, if any, that is waiting for a message.
+    std::atomic<channel_operation*> receive_waiter_;
+
+    // The send operation, if any, that is waiting for space in the buffer.
+    std::atomic<channel_operation*> send_waiter_;
+
+    // Pointers to adjacent channel implementations in linked list.
+    base_implementation_type* next_;
+    base_implementation_type* prev_;
+  };
+
+  // The implementation for a specific value type.
+  template <typename Traits, typename... Signatures>
+  struct implementation_type;
+
+  // Constructor.
+  spsc_channel_service(asio::execution_context& ctx);
+
+  // Destroy all user-defined handler objects owned by the service.
+  void shutdown();
+
+  // Construct a new channel implementation.
+  template <typename Traits, typename... Signatures>
+  void construct(implementation_type<Traits, Signatures...>& impl,
+      std::size_t max_buffer_size);
+
+  // Destroy a channel implementation.
+  template <typename Traits, typename... Signatures>
+  void destroy(implementation_type<Traits, Signatures...>& impl);
+
+  // Move-construct a new channel implementation.
+  template <typename Traits, typename... Signatures>
+  void move_construct(implementation_type<Traits, Signatures...>& impl,
+      implementation_type<Traits, Signatures...>& other_impl);
+
+  // Move-assign from another channel implementation.
+  template <typename Traits, typename... Signatures>
+  void move_assign(implementation_type<Traits, Signatures...>& impl,
+      spsc_channel_service& other_service,
+      implementation_type<Traits, Signatures...>& other_impl);
+
+  // Get the capacity of the channel.
+  template <typename Traits, typename... Signatures>
+  std::size_t capacity(
+      const implementation_type<Traits, Signatures...>& impl) const noexcept;
+
+  // Determine whether the channel is open.
+  bool is_open(const base_implementation_type& impl) const noexcept;
+
+  // Reset the channel to its initial state.
+  template <typename Traits, typename... Signatures>
+  void reset(implementation_type<Traits, Signatures...>& impl);
+
+  // Close the channel.
+  template <typename Traits, typename... Signatures>
+  void close(implementation_type<Traits, Signatures...>& impl);
+
+  // Cancel all operations associated with the channel.
+  template <typename Traits, typename... Signatures>
+  void cancel(implementation_type<Traits, Signatures...>& impl);
+
+  // Cancel the operation associated with the channel that has the given key.
+  template <typename Traits, typename... Signatures>
+  void cancel_by_key(implementation_type<Traits, Signatures...>& impl,
+      void* cancellation_key);
+
+  // Determine whether a value can be read from the channel without blocking.
+  template <typename Traits, typename... Signatures>
+  bool ready(
+      const implementation_type<Traits, Signatures...>& impl) const noexcept;
+
+  // Synchronously send a new value into the channel.
+  template <typename Message, typename Traits,
+      typename... Signatures, typename... Args>
+  bool try_send(implementation_type<Traits, Signatures...>& impl,
+      bool via_dispatch, Args&&... args);
+
+  // Synchronously send a number of new values into the channel.
+  template <typename Message, typename Traits,
+      typename... Signatures, typename... Args>
+  std::size_t try_send_n(implementation_type<Traits, Signatures...>& impl,
+      std::size_t count, bool via_dispatch, Args&&... args);
+
+  // Synchronously send a new value into the channel for each element of a
+  // range, stopping when the channel can accept no more.
+  template <typename Message, typename Traits,
+      typename... Signatures, typename Range, typename... Args>
+  std::size_t try_send_batch(implementation_type<Traits, Signatures...>& impl,
+      Range&& range, const Args&... args);
+
+  // Asynchronously send a new value into the channel.
+  template <typename Traits, typename... Signatures,
+      typename Handler, typename IoExecutor>
+  void async_send(implementation_type<Traits, Signatures...>& impl,
+      typename implementation_type<Traits,
+        Signatures...>::payload_type&& payload,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef channel_send_op<
+      typename implementation_type<Traits, Signatures...>::payload_type,
+        Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(static_cast<typename implementation_type<
+          Traits, Signatures...>::payload_type&&>(payload), handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<op_cancellation<Traits, Signatures...>>(
+            this, &impl);
+    }
+
+    ASIO_HANDLER_CREATION((this->context(), *p.p,
+          "channel", &impl, 0, "async_send"));
+
+    start_send_op(impl, p.p);
+    p.v = p.p = 0;
+  }
+
+  // Synchronously receive a value from the channel.
+  template <typename Traits, typename... Signatures, typename Handler>
+  bool try_receive(implementation_type<Traits, Signatures...>& impl,
+      Handler&& handler);
+
+  // Asynchronously receive a value from the channel.
+  template <typename Traits, typename... Signatures,
+      typename Handler, typename IoExecutor>
+  void async_receive(implementation_type<Traits, Signatures...>& impl,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    associated_cancellation_slot_t<Handler> slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef channel_receive_op<
+      typename implementation_type<Traits, Signatures...>::payload_type,
+        Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<op_cancellation<Traits, Signatures...>>(
+            this, &impl);
+    }
+
+    ASIO_HANDLER_CREATION((this->context(), *p.p,
+          "channel", &impl, 0, "async_receive"));
+
+    start_receive_op(impl, p.p);
+    p.v = p.p = 0;
+  }
+
+private:
+  // Helper function object to handle a closed notification.
+  template <typename Payload, typename Signature>
+  struct post_receive
+  {
+    explicit post_receive(channel_receive<Payload>* op)
+      : op_(op)
+    {
+    }
+
+    template <typename... Args>
+    void operator()(Args&&... args)
+    {
+      op_->post(
+          asio::detail::completion_message<Signature>(0,
+            static_cast<Args&&>(args)...));
+    }
+
+    channel_receive<Payload>* op_;
+  };
+
+  // Insert an implementation into the linked list of all implementations.
+  void base_insert(base_implementation_type& impl);
+
+  // Destroy a base channel implementation.
+  void base_destroy(base_implementation_type& impl);
+
+  // Helper function to send a payload without waiting.
+  template <typename Traits, typename... Signatures>
+  bool try_send_payload(implementation_type<Traits, Signatures...>& impl,
+      typename implementation_type<Traits,
+        Signatures...>::payload_type& payload, bool via_dispatch);
+
+  // Helper function to complete a parked receive operation after a value has
+  // been added to the buffer.
+  template <typename Traits, typename... Signatures>
+  void wake_receiver(implementation_type<Traits, Signatures...>& impl,
+      bool via_dispatch);
+
+  // Helper function to complete a parked send operation after a value has
+  // been removed from the buffer.
+  template <typename Traits, typename... Signatures>
+  void wake_sender(implementation_type<Traits, Signatures...>& impl);
+
+  // Helper function to park a receive operation. The caller must hold the
+  // consumer's role in the buffer.
+  template <typename Traits, typename... Signatures>
+  void park_receive_op(implementation_type<Traits, Signatures...>& impl,
+      channel_receive<typename implementation_type<
+        Traits, Signatures...>::payload_type>* receive_op, bool is_immediate);
+
+  // Helper function to park a send operation. The caller must hold the
+  // producer's role in the buffer.
+  template <typename Traits, typename... Signatures>
+  void park_send_op(implementation_type<Traits, Signatures...>& impl,
+      channel_send<typename implementation_type<
+        Traits, Signatures...>::payload_type>* send_op, bool is_immediate);
+
+  // Helper function to start an asynchronous put operation.
+  template <typename Traits, typename... Signatures>
+  void start_send_op(implementation_type<Traits, Signatures...>& impl,
+      channel_send<typename implementation_type<
+        Traits, Signatures...>::payload_type>* send_op);
+
+  // Helper function to start an asynchronous get operation.
+  template <typename Traits, typename... Signatures>
+  void start_receive_op(implementation_type<Traits, Signatures...>& impl,
+      channel_receive<typename implementation_type<
+        Traits, Signatures...>::payload_type>* receive_op);
+
+  // Helper class used to implement per-operation cancellation.
+  template <typename Traits, typename... Signatures>
+  class op_cancellation
+  {
+  public:
+    op_cancellation(spsc_channel_service* s,
+        implementation_type<Traits, Signatures...>* impl)
+      : service_(s),
+        impl_(impl)
+    {
+    }
+
+    void operator()(cancellation_type_t type)
+    {
+      if (!!(type &
+            (cancellation_type::terminal
+              | cancellation_type::partial
+              | cancellation_type::total)))
+      {
+        service_->cancel_by_key(*impl_, this);
+      }
+    }
+
+  private:
+    spsc_channel_service* service_;
+    implementation_type<Traits, Signatures...>* impl_;
+  };
+
+  // Mutex to protect access to the linked list of implementations.
+  asio::detail::mutex mutex_;
+
+  // The head of a linked list of all implementations.
+  base_implementation_type* impl_list_;
+};
+
+// The implementation for a specific value type.
+template <typename Traits, typename... Signatures>
+struct spsc_channel_service::implementation_type : base_implementation_type
+{
+  // The traits type associated with the channel.
+  typedef typename Traits::template rebind<Signatures...>::other traits_type;
+
+  // Type of an element stored in the buffer.
+  typedef conditional_t<
+      has_signature<
+        typename traits_type::receive_cancelled_signature,
+        Signatures...
+      >::value,
+      conditional_t<
+        has_signature<
+          typename traits_type::receive_closed_signature,
+          Signatures...
+        >::value,
+        asio::detail::completion_payload<Signatures...>,
+        asio::detail::completion_payload<
+          Signatures...,
+          typename traits_type::receive_closed_signature
+        >
+      >,
+      conditional_t<
+        has_signature<
+          typename traits_type::receive_closed_signature,
+          Signatures...,
+          typename traits_type::receive_cancelled_signature
+        >::value,
+        asio::detail::completion_payload<
+          Signatures...,
+          typename traits_type::receive_cancelled_signature
+        >,
+        asio::detail::completion_payload<
+          Signatures...,
+          typename traits_type::receive_cancelled_signature,
+          typename traits_type::receive_closed_signature
+        >
+      >
+    > payload_type;
+
+  // The type of the buffer.
+  typedef asio::detail::bounded_spsc_queue<payload_type> buffer_type;
+
+  // Buffered values.
+  buffer_type buffer_;
+};
+
+} // namespace detail
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/experimental/detail/impl/spsc_channel_service.hpp"
+
+#endif // ASIO_EXPERIMENTAL_DETAIL_SPSC_CHANNEL_SERVICE_HPP
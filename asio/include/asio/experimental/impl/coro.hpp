@@ -21,6 +21,7 @@
 #include "asio/associated_cancellation_slot.hpp"
 #include "asio/bind_allocator.hpp"
 #include "asio/deferred.hpp"
+#include "asio/detail/call_stack.hpp"
 #include "asio/experimental/detail/coro_completion_handler.hpp"
 #include "asio/detail/push_options.hpp"
 
@@ -33,6 +34,27 @@ struct coro;
 
 namespace detail {
 
+// Records the coroutines that are being resumed from within the initiating
+// function of an async_resume operation on the current thread.
+typedef asio::detail::call_stack<const void> coro_initiation_call_stack;
+
+// Delivers the result of an async_resume operation. The completion handler
+// must be posted if the coroutine suspended from within the initiating
+// function. Otherwise it is dispatched, so that a coroutine that yields from
+// the completion of an operation on the handler's executor resumes its caller
+// without another trip through the scheduler.
+template <execution::executor Executor,
+    typename CompletionToken, typename... Args>
+partial_coro complete_coroutine(Executor exec, CompletionToken token,
+    const void* key, Args&&... args) noexcept
+{
+  if (coro_initiation_call_stack::contains(key))
+    post(exec, asio::append(std::move(token), std::move(args)...));
+  else
+    dispatch(exec, asio::append(std::move(token), std::move(args)...));
+  co_return;
+}
+
 struct coro_cancellation_source
 {
   cancellation_slot slot;
@@ -1078,7 +1100,8 @@ struct coro<Yield, Return, Executor, Allocator>::initiate_async_resume
       auto ch = detail::coroutine_handle<promise_type>::from_promise(*the_coro);
       assert(ch && !ch.done());
 
-      the_coro->awaited_from = post_coroutine(std::move(exec), std::move(h));
+      the_coro->awaited_from = detail::complete_coroutine(
+          std::move(exec), std::move(h), the_coro).handle;
       the_coro->reset_error();
       ch.resume();
     };
@@ -1099,8 +1122,8 @@ struct coro<Yield, Return, Executor, Allocator>::initiate_async_resume
       auto ch = detail::coroutine_handle<promise_type>::from_promise(*the_coro);
       assert(ch && !ch.done());
 
-      the_coro->awaited_from = detail::post_coroutine(
-          exec, std::move(h), the_coro->result_).handle;
+      the_coro->awaited_from = detail::complete_coroutine(
+          exec, std::move(h), the_coro, the_coro->result_).handle;
       the_coro->reset_error();
       ch.resume();
     };
@@ -1131,8 +1154,8 @@ struct coro<Yield, Return, Executor, Allocator>::initiate_async_resume
               detail::coro_error<error_type>::done()));
       else
       {
-        the_coro->awaited_from = detail::post_coroutine(
-            exec, std::move(h), the_coro->error_).handle;
+        the_coro->awaited_from = detail::complete_coroutine(
+            exec, std::move(h), the_coro, the_coro->error_).handle;
         the_coro->reset_error();
         ch.resume();
       }
@@ -1165,8 +1188,8 @@ struct coro<Yield, Return, Executor, Allocator>::initiate_async_resume
               detail::coro_error<error_type>::done(), result_type{}));
       else
       {
-        the_coro->awaited_from = detail::post_coroutine(
-            exec, std::move(h), the_coro->error_, the_coro->result_).handle;
+        the_coro->awaited_from = detail::complete_coroutine(exec,
+            std::move(h), the_coro, the_coro->error_, the_coro->result_).handle;
         the_coro->reset_error();
         ch.resume();
       }
@@ -1183,6 +1206,7 @@ struct coro<Yield, Return, Executor, Allocator>::initiate_async_resume
     coro_->cancel = &coro_->cancel_source.emplace();
     coro_->cancel->state = cancellation_state(
         coro_->cancel->slot = get_associated_cancellation_slot(handler));
+    detail::coro_initiation_call_stack::context ctx(coro_);
     asio::dispatch(get_executor(),
         handle(exec, std::forward<WaitHandler>(handler),
           std::integral_constant<bool, is_noexcept>{},
@@ -1199,6 +1223,7 @@ struct coro<Yield, Return, Executor, Allocator>::initiate_async_resume
     coro_->cancel = &coro_->cancel_source.emplace();
     coro_->cancel->state = cancellation_state(
         coro_->cancel->slot = get_associated_cancellation_slot(handler));
+    detail::coro_initiation_call_stack::context ctx(coro_);
     asio::dispatch(get_executor(),
         [h = handle(exec, std::forward<WaitHandler>(handler),
             std::integral_constant<bool, is_noexcept>{},
@@ -17,10 +17,10 @@
 
 #include "asio/detail/config.hpp"
 #include <atomic>
-#include <deque>
 #include <memory>
 #include <new>
 #include <tuple>
+#include "asio/associated_allocator.hpp"
 #include "asio/associated_cancellation_slot.hpp"
 #include "asio/detail/recycling_allocator.hpp"
 #include "asio/detail/type_traits.hpp"
@@ -366,12 +366,18 @@ void parallel_group_launch(Condition cancellation_condition, Handler handler,
   associated_cancellation_slot_t<Handler> slot
     = asio::get_associated_cancellation_slot(handler);
 
-  // Create the shared state for the operation.
+  // Create the shared state for the operation. The state holds the results of
+  // all operations inline, and is allocated using the handler's associated
+  // allocator, which defaults to the recycling allocator.
   typedef parallel_group_state<Condition, Handler, Ops...> state_type;
+  typedef asio::detail::get_recycling_allocator<
+      associated_allocator_t<Handler>,
+      asio::detail::thread_info_base::parallel_group_tag> alloc_helper;
+  typename std::allocator_traits<typename alloc_helper::type>::template
+    rebind_alloc<state_type> alloc(alloc_helper::get(
+        asio::get_associated_allocator(handler)));
   std::shared_ptr<state_type> state = std::allocate_shared<state_type>(
-      asio::detail::recycling_allocator<state_type,
-        asio::detail::thread_info_base::parallel_group_tag>(),
-      std::move(cancellation_condition), std::move(handler));
+      alloc, std::move(cancellation_condition), std::move(handler));
 
   // Initiate each individual operation in the group.
   int fold[] = { 0,
@@ -393,6 +399,73 @@ void parallel_group_launch(Condition cancellation_condition, Handler handler,
         Condition, Handler, Ops...>>(state);
 }
 
+// Contiguous storage for a fixed number of default-constructed elements,
+// obtained in a single allocation from the ranged group's allocator.
+template <typename T, typename Allocator>
+class ranged_parallel_group_array
+{
+public:
+  typedef typename std::allocator_traits<Allocator>::template
+    rebind_alloc<T> allocator_type;
+
+  ranged_parallel_group_array(std::size_t size, const Allocator& allocator)
+    : allocator_(allocator),
+      data_(std::allocator_traits<allocator_type>::allocate(allocator_, size)),
+      size_(size)
+  {
+    for (std::size_t i = 0; i < size_; ++i)
+      new (data_ + i) T();
+  }
+
+  ranged_parallel_group_array(ranged_parallel_group_array&& other) noexcept
+    : allocator_(std::move(other.allocator_)),
+      data_(other.data_),
+      size_(other.size_)
+  {
+    other.data_ = 0;
+    other.size_ = 0;
+  }
+
+  ranged_parallel_group_array& operator=(
+      const ranged_parallel_group_array&) = delete;
+
+  ~ranged_parallel_group_array()
+  {
+    if (data_)
+    {
+      for (std::size_t i = 0; i < size_; ++i)
+        data_[i].~T();
+      std::allocator_traits<allocator_type>::deallocate(
+          allocator_, data_, size_);
+    }
+  }
+
+  std::size_t size() const noexcept
+  {
+    return size_;
+  }
+
+  T& operator[](std::size_t i) noexcept
+  {
+    return data_[i];
+  }
+
+  T* begin() noexcept
+  {
+    return data_;
+  }
+
+  T* end() noexcept
+  {
+    return data_ + size_;
+  }
+
+private:
+  allocator_type allocator_;
+  T* data_;
+  std::size_t size_;
+};
+
 // Proxy completion handler for the ranged group of parallel operations.
 // Unpacks and recombines the individual operations' results, and invokes the
 // user's completion handler.
@@ -422,10 +495,8 @@ struct ranged_parallel_group_completion_handler
       allocator_(allocator),
       completion_order_(size, 0,
           ASIO_REBIND_ALLOC(Allocator, std::size_t)(allocator)),
-      args_(ASIO_REBIND_ALLOC(Allocator, op_result_type)(allocator))
+      args_(size, allocator)
   {
-    for (std::size_t i = 0; i < size; ++i)
-      args_.emplace_back();
   }
 
   executor_type get_executor() const noexcept
@@ -482,8 +553,7 @@ struct ranged_parallel_group_completion_handler
   Allocator allocator_;
   std::vector<std::size_t,
     ASIO_REBIND_ALLOC(Allocator, std::size_t)> completion_order_;
-  std::deque<op_result_type,
-    ASIO_REBIND_ALLOC(Allocator, op_result_type)> args_;
+  ranged_parallel_group_array<op_result_type, Allocator> args_;
 };
 
 // Shared state for the parallel group.
@@ -494,14 +564,10 @@ struct ranged_parallel_group_state
       std::size_t size, const Allocator& allocator)
     : cancellations_requested_(size),
       outstanding_(size),
-      cancellation_signals_(
-          ASIO_REBIND_ALLOC(Allocator,
-            asio::cancellation_signal)(allocator)),
+      cancellation_signals_(size, allocator),
       cancellation_condition_(std::move(c)),
       handler_(std::move(h), size, allocator)
   {
-    for (std::size_t i = 0; i < size; ++i)
-      cancellation_signals_.emplace_back();
   }
 
   // The number of operations that have completed so far. Used to determine the
@@ -524,9 +590,8 @@ struct ranged_parallel_group_state
   std::atomic<unsigned int> outstanding_;
 
   // The cancellation signals for each operation in the group.
-  std::deque<asio::cancellation_signal,
-    ASIO_REBIND_ALLOC(Allocator, asio::cancellation_signal)>
-      cancellation_signals_;
+  ranged_parallel_group_array<asio::cancellation_signal, Allocator>
+    cancellation_signals_;
 
   // The cancellation condition is used to determine whether the results from an
   // individual operation warrant a cancellation request for the whole group.
@@ -696,13 +761,17 @@ void ranged_parallel_group_launch(Condition cancellation_condition,
   // The type of the asynchronous operation.
   typedef decay_t<decltype(*declval<typename Range::iterator>())> op_type;
 
-  // Create the shared state for the operation.
+  // Create the shared state for the operation. The state is allocated using
+  // the group's allocator, unless that is the default std::allocator, in which
+  // case the recycling allocator is used.
   typedef ranged_parallel_group_state<Condition,
     Handler, op_type, Allocator> state_type;
+  typedef asio::detail::get_recycling_allocator<Allocator,
+      asio::detail::thread_info_base::parallel_group_tag> alloc_helper;
+  typename std::allocator_traits<typename alloc_helper::type>::template
+    rebind_alloc<state_type> alloc(alloc_helper::get(allocator));
   std::shared_ptr<state_type> state = std::allocate_shared<state_type>(
-      asio::detail::recycling_allocator<state_type,
-        asio::detail::thread_info_base::parallel_group_tag>(),
-      std::move(cancellation_condition),
+      alloc, std::move(cancellation_condition),
       std::move(handler), range.size(), allocator);
 
   std::size_t idx = 0;
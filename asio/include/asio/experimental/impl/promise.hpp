@@ -17,6 +17,8 @@
 
 #include "asio/detail/config.hpp"
 #include "asio/cancellation_signal.hpp"
+#include "asio/detail/recycling_allocator.hpp"
+#include "asio/detail/thread_info_base.hpp"
 #include "asio/detail/utility.hpp"
 #include "asio/error.hpp"
 #include "asio/system_error.hpp"
@@ -86,7 +88,7 @@ struct promise_impl<void(Ts...), Executor, Allocator>
 
   struct completion_base
   {
-    virtual void invoke(Ts&&...ts) = 0;
+    virtual void invoke(void* inline_storage, Ts&&...ts) = 0;
   };
 
   template<typename Alloc, typename WaitHandler_>
@@ -94,7 +96,7 @@ struct promise_impl<void(Ts...), Executor, Allocator>
   {
     WaitHandler_ handler;
     Alloc allocator;
-    void invoke(Ts&&... ts)
+    void invoke(void* inline_storage, Ts&&... ts)
     {
       auto h = std::move(handler);
 
@@ -104,7 +106,8 @@ struct promise_impl<void(Ts...), Executor, Allocator>
 
       alloc_t alloc_{allocator};
       this->~completion_impl();
-      std::allocator_traits<alloc_t>::deallocate(alloc_, this, 1u);
+      if (static_cast<void*>(this) != inline_storage)
+        std::allocator_traits<alloc_t>::deallocate(alloc_, this, 1u);
       std::move(h)(std::forward<Ts>(ts)...);
     }
 
@@ -131,9 +134,29 @@ struct promise_impl<void(Ts...), Executor, Allocator>
     using alloc_t = typename std::allocator_traits<
       typename asio::decay<Alloc>::type>::template rebind_alloc<impl_t>;
 
-    alloc_t alloc_{alloc};
-    auto p = std::allocator_traits<alloc_t>::allocate(alloc_, 1u);
-    completion = new (p) impl_t(std::forward<Alloc>(alloc),
+    // Small completions are held inline, in the promise's own state.
+    set_completion_impl<impl_t, alloc_t>(
+        integral_constant<bool,
+          sizeof(impl_t) <= sizeof(completion_opt)
+            && alignof(impl_t) <= alignof(decltype(completion_opt))>(),
+        std::forward<Alloc>(alloc), std::forward<Handler>(handler));
+  }
+
+  template<typename Impl, typename ImplAlloc,
+      typename Alloc, typename Handler>
+  void set_completion_impl(true_type, Alloc&& alloc, Handler&& handler)
+  {
+    completion = new (&completion_opt) Impl(std::forward<Alloc>(alloc),
+        std::forward<Handler>(handler));
+  }
+
+  template<typename Impl, typename ImplAlloc,
+      typename Alloc, typename Handler>
+  void set_completion_impl(false_type, Alloc&& alloc, Handler&& handler)
+  {
+    ImplAlloc alloc_{alloc};
+    auto p = std::allocator_traits<ImplAlloc>::allocate(alloc_, 1u);
+    completion = new (p) Impl(std::forward<Alloc>(alloc),
         std::forward<Handler>(handler));
   }
 
@@ -141,7 +164,8 @@ struct promise_impl<void(Ts...), Executor, Allocator>
   void complete(T_&&... ts)
   {
     assert(completion);
-    std::exchange(completion, nullptr)->invoke(std::forward<T_>(ts)...);
+    std::exchange(completion, nullptr)->invoke(
+        &completion_opt, std::forward<T_>(ts)...);
   }
 
   template<std::size_t... Idx>
@@ -195,11 +219,21 @@ struct promise_handler<void(Ts...), Executor, Allocator>
 {
   using promise_type = promise<void(Ts...), Executor, Allocator>;
 
+  // The state, including the storage for the result, is a single allocation.
+  // The recycling allocator is used when no other allocator is specified.
+  typedef asio::detail::get_recycling_allocator<Allocator,
+      asio::detail::thread_info_base::promise_tag> alloc_helper;
+
+  typedef typename std::allocator_traits<
+      typename alloc_helper::type>::template rebind_alloc<
+        promise_impl<void(Ts...), Executor, Allocator>> impl_allocator_type;
+
   promise_handler(
       Allocator allocator, Executor executor) // get_associated_allocator(exec)
     : impl_(
         std::allocate_shared<promise_impl<void(Ts...), Executor, Allocator>>(
-          allocator, allocator, executor))
+          impl_allocator_type(alloc_helper::get(allocator)),
+          allocator, executor))
   {
   }
 
@@ -239,7 +273,7 @@ struct promise_handler<void(Ts...), Executor, Allocator>
       void(Ts...), allocator_type, executor_type>::result_type ;
 
     new (&impl_->result) result_type(std::move(ts)...);
-    impl_->done = true;
+    impl_->done.store(true, std::memory_order_release);
 
     if (impl_->completion)
       impl_->complete_with_result();
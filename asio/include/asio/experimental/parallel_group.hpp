@@ -269,6 +269,10 @@ public:
  *    }
  *  );
  * @endcode
+ *
+ * The results of the operations are held inline in the group's state, which
+ * is obtained in a single allocation using the completion handler's associated
+ * allocator.
  */
 template <typename... Ops>
 ASIO_NODISCARD inline parallel_group<Ops...>
@@ -399,7 +403,10 @@ make_parallel_group(Range&& range,
 
 /// Create a group of operations that may be launched in parallel.
 /**
- * @param allocator Specifies the allocator to be used with the result vectors.
+ * @param allocator Specifies the allocator to be used with the result vectors
+ * and with the group's internal state. An allocator that draws on storage
+ * provided by the caller, such as an arena, allows the group to run without
+ * using the default allocator.
  *
  * @param range A range containing the operations to be launched.
  *
@@ -106,7 +106,7 @@ struct promise<void(Ts...), Executor,  Allocator>
   /// Cancel the promise. Usually done through the destructor.
   void cancel(cancellation_type level = cancellation_type::all)
   {
-    if (impl_ && !impl_->done)
+    if (impl_ && !impl_->done.load(std::memory_order_acquire))
     {
       asio::dispatch(impl_->executor,
           [level, impl = impl_]{ impl->cancel.emit(level); });
@@ -116,7 +116,7 @@ struct promise<void(Ts...), Executor,  Allocator>
   /// Check if the promise is completed already.
   bool completed() const noexcept
   {
-    return impl_ && impl_->done;
+    return impl_ && impl_->done.load(std::memory_order_acquire);
   }
 
   /// Wait for the promise to become ready.
@@ -169,7 +169,7 @@ private:
 
       auto cancel = get_associated_cancellation_slot(handler);
 
-      if (self_->done)
+      if (self_->done.load(std::memory_order_acquire))
       {
         auto exec = asio::get_associated_executor(
             handler, self_->get_executor());
@@ -0,0 +1,93 @@
+//
+// experimental/receive_stream.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXPERIMENTAL_RECEIVE_STREAM_HPP
+#define ASIO_EXPERIMENTAL_RECEIVE_STREAM_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_DATAGRAM_BATCH) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include "asio/as_tuple.hpp"
+#include "asio/basic_datagram_socket.hpp"
+#include "asio/datagram_arena.hpp"
+#include "asio/deferred.hpp"
+#include "asio/error.hpp"
+#include "asio/experimental/coro.hpp"
+#include "asio/detail/throw_error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace experimental {
+
+/// Create a generator that yields the datagrams received by a socket.
+/**
+ * This function returns a resumable coroutine that receives batches of
+ * datagrams into an arena, using basic_datagram_socket::async_receive_arena(),
+ * and yields the header of each datagram in turn. Each resumption yields the
+ * next datagram from the current batch, and a new batch is received only
+ * once the current one has been consumed. As a result, receiving a datagram
+ * requires neither a separate asynchronous operation nor a separate buffer.
+ *
+ * The generator completes when the receive operation fails with
+ * asio::error::operation_aborted, such as when the socket is closed or
+ * cancelled. Any other error is thrown from the resumption.
+ *
+ * @param socket The socket from which datagrams are received.
+ *
+ * @param arena The arena that holds each batch. A yielded datagram's data may
+ * be accessed using <tt>arena.payload(packet)</tt>, and remains valid until
+ * the generator is next resumed.
+ *
+ * @param flags Flags specifying how the receive calls are to be made.
+ *
+ * @note The socket and arena must outlive the generator.
+ *
+ * @par Example
+ * @code
+ * asio::datagram_arena<asio::ip::udp> arena(32, 1500);
+ * auto packets = asio::experimental::receive_stream(socket, arena);
+ * while (auto p = co_await packets.async_resume(asio::use_awaitable))
+ *   parse(arena.payload(*p), p->endpoint);
+ * @endcode
+ */
+template <typename Protocol, typename Executor>
+coro<typename datagram_arena<Protocol>::packet, void, Executor>
+receive_stream(basic_datagram_socket<Protocol, Executor>& socket,
+    datagram_arena<Protocol>& arena, socket_base::message_flags flags = 0)
+{
+  for (;;)
+  {
+    auto [ec, n] = co_await socket.async_receive_arena(
+        arena, flags, as_tuple(deferred));
+    if (ec == asio::error::operation_aborted)
+      co_return;
+    asio::detail::throw_error(ec, "receive_stream");
+
+    for (std::size_t i = 0; i < n; ++i)
+      co_yield arena[i];
+  }
+}
+
+} // namespace experimental
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_DATAGRAM_BATCH)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_EXPERIMENTAL_RECEIVE_STREAM_HPP
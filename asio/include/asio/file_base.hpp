@@ -20,6 +20,11 @@
 #if defined(ASIO_HAS_FILE) \
   || defined(GENERATING_DOCUMENTATION)
 
+#include <cstddef>
+#include "asio/buffer.hpp"
+#include "asio/error_code.hpp"
+#include "asio/detail/cstdint.hpp"
+
 #if !defined(ASIO_WINDOWS)
 # include <fcntl.h>
 #endif // !defined(ASIO_WINDOWS)
@@ -62,6 +67,12 @@ public:
   /// Open the file so that write operations automatically synchronise the file
   /// data and metadata to disk.
   static const flags sync_all_on_write = implementation_defined;
+
+  /// Open the file for direct I/O, so that data is transferred without being
+  /// cached by the operating system. The buffers, offsets and lengths used for
+  /// reads and writes must be aligned to the device's block size, as provided
+  /// by aligned_buffer.
+  static const flags direct = implementation_defined;
 #else
   enum flags
   {
@@ -73,7 +84,8 @@ public:
     create = 16,
     exclusive = 32,
     truncate = 64,
-    sync_all_on_write = 128
+    sync_all_on_write = 128,
+    direct = 256
 #else // defined(ASIO_WINDOWS)
     read_only = O_RDONLY,
     write_only = O_WRONLY,
@@ -82,7 +94,12 @@ public:
     create = O_CREAT,
     exclusive = O_EXCL,
     truncate = O_TRUNC,
-    sync_all_on_write = O_SYNC
+    sync_all_on_write = O_SYNC,
+# if defined(O_DIRECT)
+    direct = O_DIRECT
+# else // defined(O_DIRECT)
+    direct = 0
+# endif // defined(O_DIRECT)
 #endif // defined(ASIO_WINDOWS)
   };
 
@@ -149,6 +166,79 @@ public:
 #endif
   };
 
+  /// Describes one read in a batch of reads at specified offsets.
+  /**
+   * A batch of read requests is passed to
+   * basic_random_access_file::async_read_batch_at(). The @c error and
+   * @c bytes_transferred members are set when the batch completes.
+   */
+  struct read_request
+  {
+    /// Default constructor.
+    read_request() noexcept
+      : offset(0),
+        bytes_transferred(0)
+    {
+    }
+
+    /// Construct a request to read the specified buffer at an offset.
+    read_request(uint64_t o, const mutable_buffer& b) noexcept
+      : offset(o),
+        buffer(b),
+        bytes_transferred(0)
+    {
+    }
+
+    /// The offset at which the data is read.
+    uint64_t offset;
+
+    /// The buffer into which the data is read.
+    mutable_buffer buffer;
+
+    /// The result of the read. Set to error::eof when the offset is at or
+    /// beyond the end of the file.
+    asio::error_code error;
+
+    /// The number of bytes read.
+    std::size_t bytes_transferred;
+  };
+
+  /// Describes one write in a batch of writes at specified offsets.
+  /**
+   * A batch of write requests is passed to
+   * basic_random_access_file::async_write_batch_at(). The @c error and
+   * @c bytes_transferred members are set when the batch completes.
+   */
+  struct write_request
+  {
+    /// Default constructor.
+    write_request() noexcept
+      : offset(0),
+        bytes_transferred(0)
+    {
+    }
+
+    /// Construct a request to write the specified buffer at an offset.
+    write_request(uint64_t o, const const_buffer& b) noexcept
+      : offset(o),
+        buffer(b),
+        bytes_transferred(0)
+    {
+    }
+
+    /// The offset at which the data is written.
+    uint64_t offset;
+
+    /// The data to be written.
+    const_buffer buffer;
+
+    /// The result of the write.
+    asio::error_code error;
+
+    /// The number of bytes written.
+    std::size_t bytes_transferred;
+  };
+
 protected:
   /// Protected destructor to prevent deletion through this type.
   ~file_base()
@@ -0,0 +1,296 @@
+//
+// frame_slot.hpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_FRAME_SLOT_HPP
+#define ASIO_FRAME_SLOT_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/frame_slot_impl.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/recycling_allocator.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+template <typename T>
+class frame_slot_allocator;
+
+/// Memory kept by an object, such as a connection, for the frame of the
+/// asynchronous operation that it repeatedly starts.
+/**
+ * A frame_slot caches one block of memory. When the slot's allocator is the
+ * associated allocator of a completion handler, the first allocation made for
+ * the operation, such as the coroutine frame created by asio::co_composed,
+ * takes the cached block. When that memory is deallocated the block is kept in
+ * the slot, so that the next invocation of the operation reuses it without a
+ * trip to the heap. The block is only replaced when a larger one is needed.
+ *
+ * While the block is in use, other allocations made through the slot's
+ * allocator, such as those of the operations started by a coroutine, are
+ * obtained in the same way as for asio::recycling_allocator.
+ *
+ * The slot's memory is released when both the frame_slot and every copy of its
+ * allocator have been destroyed.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ *
+ * @par Example
+ * @code class connection
+ * {
+ * public:
+ *   void start()
+ *   {
+ *     async_read_message(socket_, buffer_,
+ *         asio::bind_allocator(frame_slot_.get_allocator(),
+ *           [this](asio::error_code ec, std::size_t)
+ *           {
+ *             if (!ec)
+ *               start();
+ *           }));
+ *   }
+ *
+ * private:
+ *   asio::ip::tcp::socket socket_;
+ *   std::string buffer_;
+ *   asio::frame_slot frame_slot_;
+ * }; @endcode
+ */
+class frame_slot
+  : private noncopyable
+{
+public:
+  /// Construct a slot with no cached memory.
+  frame_slot()
+    : impl_(new detail::frame_slot_impl)
+  {
+  }
+
+  /// Construct a slot that caches a block of the specified size.
+  /**
+   * @param capacity The size, in bytes, of the block to allocate up front.
+   */
+  explicit frame_slot(std::size_t capacity)
+    : impl_(new detail::frame_slot_impl)
+  {
+    detail::frame_slot_impl::release_on_throw guard = { impl_ };
+    impl_->try_deallocate(impl_->try_allocate(capacity));
+    guard.impl_ = 0;
+  }
+
+  /// Destructor.
+  /**
+   * Memory that is in use through the slot's allocator remains valid until it
+   * is deallocated.
+   */
+  ~frame_slot()
+  {
+    impl_->release();
+  }
+
+  /// Get an allocator that allocates from the slot.
+  frame_slot_allocator<void> get_allocator() const noexcept;
+
+  /// Get the size, in bytes, of the cached block of memory.
+  std::size_t capacity() const noexcept
+  {
+    return impl_->capacity();
+  }
+
+private:
+  template <typename> friend class frame_slot_allocator;
+
+  detail::frame_slot_impl* impl_;
+};
+
+/// An allocator that obtains memory from a frame_slot.
+/**
+ * The first allocation made through a frame_slot_allocator reuses the slot's
+ * cached block, if the block is not already in use. Other allocations are
+ * obtained in the same way as for asio::recycling_allocator.
+ */
+template <typename T>
+class frame_slot_allocator
+{
+public:
+  /// The type of object allocated by the allocator.
+  typedef T value_type;
+
+  /// Rebind the allocator to another value_type.
+  template <typename U>
+  struct rebind
+  {
+    /// The rebound @c allocator type.
+    typedef frame_slot_allocator<U> other;
+  };
+
+  /// Construct an allocator that obtains memory from the specified slot.
+  explicit frame_slot_allocator(const frame_slot& slot) noexcept
+    : impl_(slot.impl_)
+  {
+    impl_->add_ref();
+  }
+
+  /// Copy constructor.
+  frame_slot_allocator(const frame_slot_allocator& other) noexcept
+    : impl_(other.impl_)
+  {
+    impl_->add_ref();
+  }
+
+  /// Converting constructor.
+  template <typename U>
+  frame_slot_allocator(const frame_slot_allocator<U>& other) noexcept
+    : impl_(other.impl_)
+  {
+    impl_->add_ref();
+  }
+
+  /// Destructor.
+  ~frame_slot_allocator()
+  {
+    impl_->release();
+  }
+
+  /// Assignment operator.
+  frame_slot_allocator& operator=(const frame_slot_allocator& other) noexcept
+  {
+    other.impl_->add_ref();
+    impl_->release();
+    impl_ = other.impl_;
+    return *this;
+  }
+
+  /// Equality operator. Returns true if the allocators share a slot.
+  template <typename U>
+  bool operator==(const frame_slot_allocator<U>& other) const noexcept
+  {
+    return impl_ == other.impl_;
+  }
+
+  /// Inequality operator. Returns true if the allocators use different slots.
+  template <typename U>
+  bool operator!=(const frame_slot_allocator<U>& other) const noexcept
+  {
+    return impl_ != other.impl_;
+  }
+
+  /// Allocate memory for the specified number of values.
+  T* allocate(std::size_t n)
+  {
+    if (alignof(T) <= detail::frame_slot_impl::block_align)
+      if (void* p = impl_->try_allocate(sizeof(T) * n))
+        return static_cast<T*>(p);
+    return detail::recycling_allocator<T>().allocate(n);
+  }
+
+  /// Deallocate memory for the specified number of values.
+  void deallocate(T* p, std::size_t n)
+  {
+    if (!impl_->try_deallocate(p))
+      detail::recycling_allocator<T>().deallocate(p, n);
+  }
+
+private:
+  template <typename> friend class frame_slot_allocator;
+
+  detail::frame_slot_impl* impl_;
+};
+
+/// A proto-allocator that obtains memory from a frame_slot.
+template <>
+class frame_slot_allocator<void>
+{
+public:
+  /// No values are allocated by a proto-allocator.
+  typedef void value_type;
+
+  /// Rebind the allocator to another value_type.
+  template <typename U>
+  struct rebind
+  {
+    /// The rebound @c allocator type.
+    typedef frame_slot_allocator<U> other;
+  };
+
+  /// Construct an allocator that obtains memory from the specified slot.
+  explicit frame_slot_allocator(const frame_slot& slot) noexcept
+    : impl_(slot.impl_)
+  {
+    impl_->add_ref();
+  }
+
+  /// Copy constructor.
+  frame_slot_allocator(const frame_slot_allocator& other) noexcept
+    : impl_(other.impl_)
+  {
+    impl_->add_ref();
+  }
+
+  /// Converting constructor.
+  template <typename U>
+  frame_slot_allocator(const frame_slot_allocator<U>& other) noexcept
+    : impl_(other.impl_)
+  {
+    impl_->add_ref();
+  }
+
+  /// Destructor.
+  ~frame_slot_allocator()
+  {
+    impl_->release();
+  }
+
+  /// Assignment operator.
+  frame_slot_allocator& operator=(const frame_slot_allocator& other) noexcept
+  {
+    other.impl_->add_ref();
+    impl_->release();
+    impl_ = other.impl_;
+    return *this;
+  }
+
+  /// Equality operator. Returns true if the allocators share a slot.
+  template <typename U>
+  bool operator==(const frame_slot_allocator<U>& other) const noexcept
+  {
+    return impl_ == other.impl_;
+  }
+
+  /// Inequality operator. Returns true if the allocators use different slots.
+  template <typename U>
+  bool operator!=(const frame_slot_allocator<U>& other) const noexcept
+  {
+    return impl_ != other.impl_;
+  }
+
+private:
+  template <typename> friend class frame_slot_allocator;
+
+  detail::frame_slot_impl* impl_;
+};
+
+inline frame_slot_allocator<void> frame_slot::get_allocator() const noexcept
+{
+  return frame_slot_allocator<void>(*this);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_FRAME_SLOT_HPP
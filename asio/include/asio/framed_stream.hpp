@@ -0,0 +1,655 @@
+//
+// framed_stream.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_FRAMED_STREAM_HPP
+#define ASIO_FRAMED_STREAM_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <vector>
+#include "asio/append.hpp"
+#include "asio/async_result.hpp"
+#include "asio/buffer.hpp"
+#include "asio/buffers_cat.hpp"
+#include "asio/compose.hpp"
+#include "asio/error.hpp"
+#include "asio/immediate.hpp"
+#include "asio/ring_buffer.hpp"
+#include "asio/write.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Reads and writes length-prefixed frames on a stream.
+/**
+ * The framed_stream class template carries a sequence of messages, or
+ * frames, over the next layer. Each frame is sent as a four-byte header
+ * holding the length of the payload as an unsigned integer in network byte
+ * order, followed by the payload.
+ *
+ * Incoming data is read into a ring_buffer with as large a read as the free
+ * space allows, so that a header, its payload, and any frames that follow
+ * are usually received together. A frame is returned as a buffer that refers
+ * to the payload in place, without copying it. The payload remains valid
+ * until the next read of a frame, or until the framed_stream is destroyed.
+ * The capacity of the ring buffer limits the size of a frame that may be
+ * received.
+ *
+ * Frames are written with gathered writes that send the headers together with
+ * the caller's payloads, again without copying them. Several frames may be
+ * written with a single operation.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code
+ * asio::framed_stream<asio::ip::tcp::socket> stream(std::move(socket));
+ *
+ * void read_loop()
+ * {
+ *   stream.async_read_frame(
+ *       [](asio::error_code ec, asio::const_buffer frame)
+ *       {
+ *         if (!ec)
+ *         {
+ *           handle_message(frame.data(), frame.size());
+ *           read_loop();
+ *         }
+ *       });
+ * }
+ * @endcode
+ */
+template <typename Stream>
+class framed_stream
+  : private noncopyable
+{
+private:
+  class read_frame_op;
+  template <typename ConstBufferSequence> class write_frame_op;
+  class write_frames_op;
+
+public:
+  /// The type of the next layer.
+  typedef remove_reference_t<Stream> next_layer_type;
+
+  /// The type of the lowest layer.
+  typedef typename next_layer_type::lowest_layer_type lowest_layer_type;
+
+  /// The type of the executor associated with the object.
+  typedef typename lowest_layer_type::executor_type executor_type;
+
+  /// The size of the header that precedes each frame, in bytes.
+  static constexpr std::size_t header_size = 4;
+
+  /// The default capacity of the buffer that receives incoming frames.
+  static constexpr std::size_t default_buffer_size = 65536;
+
+  /// Construct, passing the specified argument to initialise the next layer.
+  /**
+   * @param a The argument used to initialise the next layer.
+   *
+   * @param buffer_size The minimum capacity of the buffer that receives
+   * incoming frames, in bytes.
+   */
+  template <typename Arg>
+  explicit framed_stream(Arg&& a,
+      std::size_t buffer_size = default_buffer_size)
+    : next_layer_(static_cast<Arg&&>(a)),
+      in_(buffer_size),
+      frame_size_(0)
+  {
+  }
+
+  /// Get a reference to the next layer.
+  next_layer_type& next_layer()
+  {
+    return next_layer_;
+  }
+
+  /// Get a reference to the lowest layer.
+  lowest_layer_type& lowest_layer()
+  {
+    return next_layer_.lowest_layer();
+  }
+
+  /// Get a const reference to the lowest layer.
+  const lowest_layer_type& lowest_layer() const
+  {
+    return next_layer_.lowest_layer();
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() noexcept
+  {
+    return next_layer_.lowest_layer().get_executor();
+  }
+
+  /// Get the size of the largest frame payload that may be received.
+  std::size_t max_frame_size() const noexcept
+  {
+    return in_.capacity() - header_size;
+  }
+
+  /// Close the stream.
+  void close()
+  {
+    next_layer_.close();
+  }
+
+  /// Close the stream.
+  ASIO_SYNC_OP_VOID close(asio::error_code& ec)
+  {
+    next_layer_.close(ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Read a frame from the stream, blocking until it has been received.
+  /// Returns a buffer that refers to the frame's payload. Throws an exception
+  /// on failure.
+  const_buffer read_frame()
+  {
+    asio::error_code ec;
+    const_buffer frame = read_frame(ec);
+    asio::detail::throw_error(ec, "read_frame");
+    return frame;
+  }
+
+  /// Read a frame from the stream, blocking until it has been received.
+  /// Returns a buffer that refers to the frame's payload, or an empty buffer
+  /// if an error occurred.
+  /**
+   * The returned buffer remains valid until the next read of a frame.
+   *
+   * Fails with asio::error::message_size if the frame is larger than
+   * max_frame_size(), after which no further frames may be read.
+   */
+  const_buffer read_frame(asio::error_code& ec)
+  {
+    consume_frame();
+    while (!parse_frame(ec))
+    {
+      if (ec)
+        return const_buffer();
+
+      dynamic_ring_buffer in(in_);
+      std::size_t pos = in.size();
+      std::size_t space = in.capacity() - pos;
+      in.grow(space);
+      std::size_t n = next_layer_.read_some(in.data(pos, space), ec);
+      in.shrink(space - n);
+      if (ec)
+        return const_buffer();
+    }
+    return frame();
+  }
+
+  /// Start an asynchronous read of a frame.
+  /**
+   * This function is used to asynchronously read a frame from the stream. It
+   * is an initiating function for an @ref asynchronous_operation, and always
+   * returns immediately. If a complete frame has already been received, the
+   * operation completes without reading from the next layer.
+   *
+   * The program must ensure that no other read of a frame is performed until
+   * this operation completes. The frame passed to the completion handler
+   * remains valid until the next read of a frame.
+   *
+   * Fails with asio::error::message_size if the frame is larger than
+   * max_frame_size(), after which no further frames may be read.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the frame has been
+   * received. The function signature of the completion handler must be:
+   * @code void handler(
+   *   asio::error_code ec, // Result of operation.
+   *   asio::const_buffer frame // The frame's payload.
+   * ); @endcode
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, asio::const_buffer) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * if they are also supported by the @c Stream type's @c async_read_some
+   * operation.
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        const_buffer)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_read_frame(
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_compose<ReadToken, void (asio::error_code, const_buffer)>(
+        declval<read_frame_op>(), token, declval<next_layer_type&>()))
+  {
+    return async_compose<ReadToken, void (asio::error_code, const_buffer)>(
+        read_frame_op(this), token, next_layer_);
+  }
+
+  /// Write a frame to the stream, blocking until it has been sent. Returns the
+  /// number of bytes written, including the header. Throws an exception on
+  /// failure.
+  template <typename ConstBufferSequence>
+  std::size_t write_frame(const ConstBufferSequence& payload)
+  {
+    asio::error_code ec;
+    std::size_t n = write_frame(payload, ec);
+    asio::detail::throw_error(ec, "write_frame");
+    return n;
+  }
+
+  /// Write a frame to the stream, blocking until it has been sent. Returns the
+  /// number of bytes written, including the header.
+  /**
+   * Fails with asio::error::message_size if the payload is too large to be
+   * described by a header.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t write_frame(const ConstBufferSequence& payload,
+      asio::error_code& ec)
+  {
+    if (!encode_header(write_header_, asio::buffer_size(payload), ec))
+      return 0;
+    return asio::write(next_layer_,
+        asio::buffers_cat(asio::buffer(write_header_), payload), ec);
+  }
+
+  /// Start an asynchronous write of a frame.
+  /**
+   * This function is used to asynchronously write a frame to the stream. It
+   * is an initiating function for an @ref asynchronous_operation, and always
+   * returns immediately. The header and the payload are sent with a gathered
+   * write.
+   *
+   * The program must ensure that no other write is performed until this
+   * operation completes.
+   *
+   * @param payload The frame's payload. Although the buffers object may be
+   * copied as necessary, ownership of the underlying memory blocks is retained
+   * by the caller, which must guarantee that they remain valid until the
+   * completion handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the write completes. The
+   * function signature of the completion handler must be:
+   * @code void handler(
+   *   // Result of operation.
+   *   asio::error_code ec,
+   *
+   *   // Number of bytes written, including the header.
+   *   std::size_t bytes_transferred
+   * ); @endcode
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * if it is also supported by the @c Stream type's @c async_write_some
+   * operation.
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_write_frame(const ConstBufferSequence& payload,
+      WriteToken&& token = default_completion_token_t<executor_type>(),
+      constraint_t<
+        is_const_buffer_sequence<ConstBufferSequence>::value
+      > = 0)
+    -> decltype(
+      async_compose<WriteToken, void (asio::error_code, std::size_t)>(
+        declval<write_frame_op<ConstBufferSequence>>(),
+        token, declval<next_layer_type&>()))
+  {
+    return async_compose<WriteToken, void (asio::error_code, std::size_t)>(
+        write_frame_op<ConstBufferSequence>(this, payload), token, next_layer_);
+  }
+
+  /// Start an asynchronous write of several frames.
+  /**
+   * This function is used to asynchronously write a sequence of frames to the
+   * stream with a single gathered write. It is an initiating function for an
+   * @ref asynchronous_operation, and always returns immediately.
+   *
+   * The program must ensure that no other write is performed until this
+   * operation completes.
+   *
+   * @param frames A ConstBufferSequence in which each element is the payload
+   * of one frame. Although the buffers object may be copied as necessary,
+   * ownership of the underlying memory blocks is retained by the caller, which
+   * must guarantee that they remain valid until the completion handler is
+   * called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the write completes. The
+   * function signature of the completion handler must be:
+   * @code void handler(
+   *   // Result of operation.
+   *   asio::error_code ec,
+   *
+   *   // Number of bytes written, including the headers.
+   *   std::size_t bytes_transferred
+   * ); @endcode
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * if it is also supported by the @c Stream type's @c async_write_some
+   * operation.
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_write_frames(const ConstBufferSequence& frames,
+      WriteToken&& token = default_completion_token_t<executor_type>(),
+      constraint_t<
+        is_const_buffer_sequence<ConstBufferSequence>::value
+      > = 0)
+    -> decltype(
+      async_compose<WriteToken, void (asio::error_code, std::size_t)>(
+        declval<write_frames_op>(), token, declval<next_layer_type&>()))
+  {
+    asio::error_code ec;
+    prepare_frames(frames, ec);
+    return async_compose<WriteToken, void (asio::error_code, std::size_t)>(
+        write_frames_op(this, ec), token, next_layer_);
+  }
+
+private:
+  // Encode a header describing a payload of the given size.
+  static bool encode_header(unsigned char (&header)[header_size],
+      std::size_t size, asio::error_code& ec)
+  {
+    if (size > 0xFFFFFFFFu)
+    {
+      ec = asio::error::message_size;
+      return false;
+    }
+
+    header[0] = static_cast<unsigned char>((size >> 24) & 0xFF);
+    header[1] = static_cast<unsigned char>((size >> 16) & 0xFF);
+    header[2] = static_cast<unsigned char>((size >> 8) & 0xFF);
+    header[3] = static_cast<unsigned char>(size & 0xFF);
+    ec = asio::error_code();
+    return true;
+  }
+
+  // Remove the frame returned by the previous read from the buffer.
+  void consume_frame()
+  {
+    in_.consume(frame_size_);
+    frame_size_ = 0;
+  }
+
+  // Determine whether a complete frame is held in the buffer.
+  bool parse_frame(asio::error_code& ec)
+  {
+    ec = asio::error_code();
+    if (in_.size() < header_size)
+      return false;
+
+    const unsigned char* p =
+      static_cast<const unsigned char*>(in_.data().data());
+    std::size_t size = (static_cast<std::size_t>(p[0]) << 24)
+      | (static_cast<std::size_t>(p[1]) << 16)
+      | (static_cast<std::size_t>(p[2]) << 8)
+      | static_cast<std::size_t>(p[3]);
+    if (size > max_frame_size())
+    {
+      ec = asio::error::message_size;
+      return false;
+    }
+
+    if (in_.size() < header_size + size)
+      return false;
+
+    frame_size_ = header_size + size;
+    return true;
+  }
+
+  // Get the payload of the frame found by parse_frame().
+  const_buffer frame() const
+  {
+    return asio::buffer(in_.data() + header_size, frame_size_ - header_size);
+  }
+
+  // Encode the headers for a sequence of frames, and build the buffers that
+  // interleave them with the payloads.
+  template <typename ConstBufferSequence>
+  void prepare_frames(const ConstBufferSequence& frames,
+      asio::error_code& ec)
+  {
+    write_headers_.clear();
+    write_buffers_.clear();
+
+    auto end = asio::buffer_sequence_end(frames);
+    for (auto i = asio::buffer_sequence_begin(frames); i != end; ++i)
+    {
+      const_buffer payload(*i);
+      write_headers_.resize(write_headers_.size() + 1);
+      if (!encode_header(write_headers_.back().bytes, payload.size(), ec))
+        return;
+    }
+
+    std::size_t index = 0;
+    for (auto i = asio::buffer_sequence_begin(frames); i != end; ++i)
+    {
+      write_buffers_.push_back(asio::buffer(write_headers_[index++].bytes));
+      write_buffers_.push_back(const_buffer(*i));
+    }
+  }
+
+  // Reads from the next layer until a complete frame has been received.
+  class read_frame_op
+  {
+  public:
+    explicit read_frame_op(framed_stream* stream)
+      : stream_(stream),
+        space_(0),
+        state_(starting)
+    {
+    }
+
+    template <typename Self>
+    void operator()(Self& self,
+        asio::error_code ec = asio::error_code(), std::size_t n = 0)
+    {
+      switch (state_)
+      {
+      case starting:
+        stream_->consume_frame();
+        break;
+
+      case reading:
+        dynamic_ring_buffer(stream_->in_).shrink(space_ - n);
+        if (ec)
+        {
+          self.complete(ec, const_buffer());
+          return;
+        }
+        break;
+
+      default:
+        self.complete(ec_, ec_ ? const_buffer() : stream_->frame());
+        return;
+      }
+
+      bool complete = stream_->parse_frame(ec);
+      if (complete || ec)
+      {
+        if (state_ == starting)
+        {
+          state_ = immediate;
+          ec_ = ec;
+          asio::async_immediate(stream_->get_executor(),
+              static_cast<Self&&>(self));
+          return;
+        }
+
+        self.complete(ec, ec ? const_buffer() : stream_->frame());
+        return;
+      }
+
+      state_ = reading;
+      dynamic_ring_buffer in(stream_->in_);
+      std::size_t pos = in.size();
+      space_ = in.capacity() - pos;
+      in.grow(space_);
+      stream_->next_layer_.async_read_some(
+          in.data(pos, space_), static_cast<Self&&>(self));
+    }
+
+  private:
+    enum state { starting, reading, immediate };
+
+    framed_stream* stream_;
+    std::size_t space_;
+    asio::error_code ec_;
+    state state_;
+  };
+
+  // Writes a header and a payload with a single gathered write.
+  template <typename ConstBufferSequence>
+  class write_frame_op
+  {
+  public:
+    write_frame_op(framed_stream* stream, const ConstBufferSequence& payload)
+      : stream_(stream),
+        payload_(payload),
+        started_(false)
+    {
+    }
+
+    template <typename Self>
+    void operator()(Self& self,
+        asio::error_code ec = asio::error_code(), std::size_t n = 0)
+    {
+      if (!started_)
+      {
+        started_ = true;
+        if (!encode_header(stream_->write_header_,
+              asio::buffer_size(payload_), ec))
+        {
+          asio::async_immediate(stream_->get_executor(),
+              asio::append(static_cast<Self&&>(self), ec, std::size_t(0)));
+          return;
+        }
+
+        asio::async_write(stream_->next_layer_,
+            asio::buffers_cat(asio::buffer(stream_->write_header_), payload_),
+            static_cast<Self&&>(self));
+        return;
+      }
+
+      self.complete(ec, n);
+    }
+
+  private:
+    framed_stream* stream_;
+    ConstBufferSequence payload_;
+    bool started_;
+  };
+
+  // Writes the buffers built by prepare_frames() with a single gathered
+  // write.
+  class write_frames_op
+  {
+  public:
+    write_frames_op(framed_stream* stream, const asio::error_code& ec)
+      : stream_(stream),
+        ec_(ec),
+        started_(false)
+    {
+    }
+
+    template <typename Self>
+    void operator()(Self& self,
+        asio::error_code ec = asio::error_code(), std::size_t n = 0)
+    {
+      if (!started_)
+      {
+        started_ = true;
+        if (ec_)
+        {
+          asio::async_immediate(stream_->get_executor(),
+              asio::append(static_cast<Self&&>(self), ec_, std::size_t(0)));
+          return;
+        }
+
+        asio::async_write(stream_->next_layer_,
+            stream_->write_buffers_, static_cast<Self&&>(self));
+        return;
+      }
+
+      self.complete(ec, n);
+    }
+
+  private:
+    framed_stream* stream_;
+    asio::error_code ec_;
+    bool started_;
+  };
+
+  // A header in the sequence of frames being written.
+  struct header
+  {
+    unsigned char bytes[header_size];
+  };
+
+  /// The next layer.
+  Stream next_layer_;
+
+  // The buffer that receives incoming frames.
+  ring_buffer in_;
+
+  // The size of the frame, including its header, that was returned by the
+  // last read. It is removed from the buffer by the next read.
+  std::size_t frame_size_;
+
+  // The header of a single frame being written.
+  unsigned char write_header_[header_size];
+
+  // The headers, and the interleaved headers and payloads, of a sequence of
+  // frames being written.
+  std::vector<header> write_headers_;
+  std::vector<const_buffer> write_buffers_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_FRAMED_STREAM_HPP
@@ -0,0 +1,253 @@
+//
+// impl/accept_batch.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_ACCEPT_BATCH_HPP
+#define ASIO_IMPL_ACCEPT_BATCH_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/any_io_executor.hpp"
+#include "asio/associator.hpp"
+#include "asio/immediate.hpp"
+#include "asio/io_context_pool.hpp"
+#include "asio/socket_base.hpp"
+#include "asio/detail/base_from_cancellation_state.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/handler_tracking.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+namespace detail
+{
+  template <typename Protocol, typename Executor, typename AcceptBatchHandler>
+  class accept_batch_op
+    : public base_from_cancellation_state<AcceptBatchHandler>
+  {
+  public:
+    typedef typename Protocol::socket peer_type;
+
+    accept_batch_op(basic_socket_acceptor<Protocol, Executor>& a,
+        std::size_t max_n, io_context_pool* targets,
+        AcceptBatchHandler& handler)
+      : base_from_cancellation_state<AcceptBatchHandler>(handler),
+        acceptor_(a),
+        max_n_(max_n),
+        targets_(targets),
+        start_(0),
+        handler_(static_cast<AcceptBatchHandler&&>(handler))
+    {
+    }
+
+    accept_batch_op(accept_batch_op&& other)
+      : base_from_cancellation_state<AcceptBatchHandler>(
+          static_cast<base_from_cancellation_state<AcceptBatchHandler>&&>(
+            other)),
+        acceptor_(other.acceptor_),
+        max_n_(other.max_n_),
+        targets_(other.targets_),
+        local_endpoint_(other.local_endpoint_),
+        sockets_(static_cast<std::vector<peer_type>&&>(other.sockets_)),
+        start_(other.start_),
+        handler_(static_cast<AcceptBatchHandler&&>(other.handler_))
+    {
+    }
+
+    // Start the operation.
+    void start()
+    {
+      start_ = 1;
+      asio::error_code ec;
+      if (max_n_ > 0)
+      {
+        local_endpoint_ = acceptor_.local_endpoint(ec);
+        if (!ec && !acceptor_.native_non_blocking())
+          acceptor_.native_non_blocking(true, ec);
+        if (!ec)
+          return (*this)(ec);
+      }
+
+      immediate(ec);
+    }
+
+    // Accept the pending connections after the acceptor becomes readable.
+    void operator()(asio::error_code ec)
+    {
+      if (!ec && start_ == 0 && this->cancelled() != cancellation_type::none)
+        ec = error::operation_aborted;
+
+      while (!ec && sockets_.size() < max_n_)
+      {
+        socket_type new_socket = socket_ops::accept(
+            acceptor_.native_handle(), 0, 0, ec);
+        if (new_socket == invalid_socket)
+        {
+          if (ec == asio::error::would_block
+              || ec == asio::error::try_again)
+          {
+            if (!sockets_.empty())
+            {
+              ec = asio::error_code();
+              break;
+            }
+
+            ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_accept_batch"));
+            start_ = 0;
+            acceptor_.async_wait(socket_base::wait_read,
+                static_cast<accept_batch_op&&>(*this));
+            return;
+          }
+
+          // The peer reset the connection before it could be accepted.
+          if (ec == asio::error::connection_aborted)
+          {
+            ec = asio::error_code();
+            continue;
+          }
+
+          break;
+        }
+
+        peer_type peer(targets_
+            ? any_io_executor(targets_->get_executor())
+            : any_io_executor(acceptor_.get_executor()));
+        peer.assign(local_endpoint_.protocol(), new_socket, ec);
+        if (ec)
+        {
+          socket_ops::state_type state = 0;
+          asio::error_code ignored_ec;
+          socket_ops::close(new_socket, state, true, ignored_ec);
+          break;
+        }
+
+        sockets_.push_back(static_cast<peer_type&&>(peer));
+      }
+
+      // Connections that were accepted before an error are not discarded.
+      if (!sockets_.empty())
+        ec = asio::error_code();
+
+      if (start_)
+        return immediate(ec);
+
+      static_cast<AcceptBatchHandler&&>(handler_)(
+          static_cast<const asio::error_code&>(ec),
+          static_cast<std::vector<peer_type>&&>(sockets_));
+    }
+
+    // Complete the operation after an immediate completion.
+    void operator()(asio::error_code ec, int)
+    {
+      static_cast<AcceptBatchHandler&&>(handler_)(
+          static_cast<const asio::error_code&>(ec),
+          static_cast<std::vector<peer_type>&&>(sockets_));
+    }
+
+  //private:
+    // Deliver the result as an immediate completion.
+    void immediate(const asio::error_code& ec)
+    {
+      ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_accept_batch"));
+      start_ = 0;
+      asio::async_immediate(acceptor_.get_executor(),
+          asio::detail::bind_handler(
+            static_cast<accept_batch_op&&>(*this), ec, 0));
+    }
+
+    basic_socket_acceptor<Protocol, Executor>& acceptor_;
+    std::size_t max_n_;
+    io_context_pool* targets_;
+    typename Protocol::endpoint local_endpoint_;
+    std::vector<peer_type> sockets_;
+    int start_;
+    AcceptBatchHandler handler_;
+  };
+
+  template <typename Protocol, typename Executor, typename AcceptBatchHandler>
+  inline bool asio_handler_is_continuation(
+      accept_batch_op<Protocol, Executor, AcceptBatchHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Protocol, typename Executor>
+  class initiate_async_accept_batch
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_accept_batch(
+        basic_socket_acceptor<Protocol, Executor>& a)
+      : acceptor_(a)
+    {
+    }
+
+    executor_type get_executor() const noexcept
+    {
+      return acceptor_.get_executor();
+    }
+
+    template <typename AcceptBatchHandler>
+    void operator()(AcceptBatchHandler&& handler,
+        std::size_t max_n, io_context_pool* targets) const
+    {
+      non_const_lvalue<AcceptBatchHandler> handler2(handler);
+      accept_batch_op<Protocol, Executor, decay_t<AcceptBatchHandler>>(
+          acceptor_, max_n, targets, handler2.value).start();
+    }
+
+  private:
+    basic_socket_acceptor<Protocol, Executor>& acceptor_;
+  };
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <template <typename, typename> class Associator,
+    typename Protocol, typename Executor, typename AcceptBatchHandler,
+    typename DefaultCandidate>
+struct associator<Associator,
+    detail::accept_batch_op<Protocol, Executor, AcceptBatchHandler>,
+    DefaultCandidate>
+  : Associator<AcceptBatchHandler, DefaultCandidate>
+{
+  static typename Associator<AcceptBatchHandler, DefaultCandidate>::type get(
+      const detail::accept_batch_op<Protocol, Executor, AcceptBatchHandler>& h)
+    noexcept
+  {
+    return Associator<AcceptBatchHandler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static auto get(
+      const detail::accept_batch_op<Protocol, Executor, AcceptBatchHandler>& h,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<AcceptBatchHandler, DefaultCandidate>::get(
+          h.handler_, c))
+  {
+    return Associator<AcceptBatchHandler, DefaultCandidate>::get(
+        h.handler_, c);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_ACCEPT_BATCH_HPP
@@ -21,6 +21,7 @@
 #include <tuple>
 #include "asio/cancellation_signal.hpp"
 #include "asio/cancellation_state.hpp"
+#include "asio/detail/awaitable_frame_arena.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/thread_context.hpp"
 #include "asio/detail/thread_info_base.hpp"
@@ -87,7 +88,17 @@ template <typename Executor>
 class awaitable_frame_base
 {
 public:
-#if !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+#if !defined(ASIO_DISABLE_AWAITABLE_FRAME_ARENA)
+  void* operator new(std::size_t size)
+  {
+    return awaitable_frame_arena::allocate_frame(size);
+  }
+
+  void operator delete(void* pointer, std::size_t size)
+  {
+    awaitable_frame_arena::deallocate_frame(pointer, size);
+  }
+#elif !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
   void* operator new(std::size_t size)
   {
     return asio::detail::thread_info_base::allocate(
@@ -103,7 +114,7 @@ public:
         asio::detail::thread_context::top_of_thread_call_stack(),
         pointer, size);
   }
-#endif // !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+#endif // !defined(ASIO_DISABLE_AWAITABLE_FRAME_ARENA)
 
   // The frame starts in a suspended state until the awaitable_thread object
   // pumps the stack.
@@ -112,7 +123,8 @@ public:
     return suspend_always();
   }
 
-  // On final suspension the frame is popped from the top of the stack.
+  // On final suspension the frame is popped from the top of the stack, and
+  // control is transferred directly to the caller's frame, if any.
   auto final_suspend() noexcept
   {
     struct result
@@ -124,9 +136,11 @@ public:
         return false;
       }
 
-      void await_suspend(coroutine_handle<void>) noexcept
+      coroutine_handle<void> await_suspend(coroutine_handle<void>) noexcept
       {
+        awaitable_frame_base* caller = this->this_->caller_;
         this->this_->pop_frame();
+        return caller ? this->this_->transfer_to(caller) : noop_coroutine();
       }
 
       void await_resume() const noexcept
@@ -489,8 +503,13 @@ public:
   {
     void (*after_suspend_fn_)(void*) = nullptr;
     void *after_suspend_arg_ = nullptr;
+    std::size_t transfers_ = 0;
   };
 
+  // The maximum number of direct transfers between frames within a single
+  // resumption by the awaitable thread's pump.
+  static constexpr std::size_t max_transfers = 16;
+
   void resume()
   {
     resume_context context;
@@ -500,6 +519,19 @@ public:
       context.after_suspend_fn_(context.after_suspend_arg_);
   }
 
+  // Get the handle to which the currently running frame should transfer
+  // control, so that the target frame runs without first returning to the
+  // pump. Unless the compiler optimises the transfer as a tail call, each one
+  // consumes stack, so after max_transfers the pump resumes the target
+  // instead.
+  coroutine_handle<void> transfer_to(awaitable_frame_base* target) noexcept
+  {
+    target->resume_context_ = resume_context_;
+    if (resume_context_ && ++resume_context_->transfers_ <= max_transfers)
+      return target->coro_;
+    return noop_coroutine();
+  }
+
   void after_suspend(void (*fn)(void*), void* arg)
   {
     resume_context_->after_suspend_fn_ = fn;
@@ -602,6 +634,9 @@ class awaitable_frame<awaitable_thread_entry_point, Executor>
 public:
   awaitable_frame()
     : top_of_stack_(0),
+#if !defined(ASIO_DISABLE_AWAITABLE_FRAME_ARENA)
+      arena_(0),
+#endif // !defined(ASIO_DISABLE_AWAITABLE_FRAME_ARENA)
       has_executor_(false),
       has_context_switched_(false),
       throw_if_cancelled_(true)
@@ -612,6 +647,10 @@ public:
   {
     if (has_executor_)
       u_.executor_.~Executor();
+#if !defined(ASIO_DISABLE_AWAITABLE_FRAME_ARENA)
+    if (arena_)
+      arena_->release();
+#endif // !defined(ASIO_DISABLE_AWAITABLE_FRAME_ARENA)
   }
 
   awaitable<awaitable_thread_entry_point, Executor> get_return_object()
@@ -646,6 +685,9 @@ private:
   } u_;
 
   awaitable_frame_base<Executor>* top_of_stack_;
+#if !defined(ASIO_DISABLE_AWAITABLE_FRAME_ARENA)
+  awaitable_frame_arena* arena_;
+#endif // !defined(ASIO_DISABLE_AWAITABLE_FRAME_ARENA)
   asio::cancellation_slot parent_cancellation_slot_;
   asio::cancellation_state cancellation_state_;
   bool has_executor_;
@@ -750,6 +792,20 @@ public:
     return bottom_of_stack_.frame_->cancellation_state_.slot();
   }
 
+  // Allocate the frames of this thread of execution from a stack arena.
+  void use_frame_arena(std::size_t chunk_size)
+  {
+#if !defined(ASIO_DISABLE_AWAITABLE_FRAME_ARENA)
+    if (!bottom_of_stack_.frame_->arena_)
+    {
+      bottom_of_stack_.frame_->arena_ =
+        awaitable_frame_arena::create(chunk_size);
+    }
+#else // !defined(ASIO_DISABLE_AWAITABLE_FRAME_ARENA)
+    (void)chunk_size;
+#endif // !defined(ASIO_DISABLE_AWAITABLE_FRAME_ARENA)
+  }
+
   // Launch a new thread of execution.
   void launch()
   {
@@ -764,6 +820,10 @@ protected:
   // has been transferred to another resumable_thread object.
   void pump()
   {
+#if !defined(ASIO_DISABLE_AWAITABLE_FRAME_ARENA)
+    awaitable_frame_arena::scope arena_scope(bottom_of_stack_.frame_->arena_);
+#endif // !defined(ASIO_DISABLE_AWAITABLE_FRAME_ARENA)
+
     do
       bottom_of_stack_.frame_->top_of_stack_->resume();
     while (bottom_of_stack_.frame_ && bottom_of_stack_.frame_->top_of_stack_);
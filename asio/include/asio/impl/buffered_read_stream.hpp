@@ -28,6 +28,7 @@ namespace asio {
 template <typename Stream>
 std::size_t buffered_read_stream<Stream>::fill()
 {
+  storage_.prepare_fill();
   detail::buffer_resize_guard<detail::buffered_stream_storage>
     resize_guard(storage_);
   std::size_t previous_size = storage_.size();
@@ -36,12 +37,15 @@ std::size_t buffered_read_stream<Stream>::fill()
           storage_.data() + previous_size,
           storage_.size() - previous_size)));
   resize_guard.commit();
+  storage_.record_fill(storage_.size() - previous_size,
+      storage_.capacity() - previous_size);
   return storage_.size() - previous_size;
 }
 
 template <typename Stream>
 std::size_t buffered_read_stream<Stream>::fill(asio::error_code& ec)
 {
+  storage_.prepare_fill();
   detail::buffer_resize_guard<detail::buffered_stream_storage>
     resize_guard(storage_);
   std::size_t previous_size = storage_.size();
@@ -51,6 +55,8 @@ std::size_t buffered_read_stream<Stream>::fill(asio::error_code& ec)
           storage_.size() - previous_size),
         ec));
   resize_guard.commit();
+  storage_.record_fill(storage_.size() - previous_size,
+      storage_.capacity() - previous_size);
   return storage_.size() - previous_size;
 }
 
@@ -86,6 +92,8 @@ namespace detail
         const std::size_t bytes_transferred)
     {
       storage_.resize(previous_size_ + bytes_transferred);
+      storage_.record_fill(bytes_transferred,
+          storage_.capacity() - previous_size_);
       static_cast<ReadHandler&&>(handler_)(ec, bytes_transferred);
     }
 
@@ -130,6 +138,7 @@ namespace detail
       ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
 
       non_const_lvalue<ReadHandler> handler2(handler);
+      storage->prepare_fill();
       std::size_t previous_size = storage->size();
       storage->resize(storage->capacity());
       next_layer_.async_read_some(
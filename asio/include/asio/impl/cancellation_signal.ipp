@@ -27,8 +27,15 @@ namespace asio {
 cancellation_signal::~cancellation_signal()
 {
   if (handler_)
+    deallocate(handler_->destroy());
+  deallocate(spare_);
+}
+
+void cancellation_signal::deallocate(
+    std::pair<void*, std::size_t> mem) noexcept
+{
+  if (mem.first && mem.first != storage_)
   {
-    std::pair<void*, std::size_t> mem = handler_->destroy();
     detail::thread_info_base::deallocate(
         detail::thread_info_base::cancellation_signal_tag(),
         detail::thread_context::top_of_thread_call_stack(),
@@ -36,39 +43,54 @@ cancellation_signal::~cancellation_signal()
   }
 }
 
+void cancellation_signal::retain(
+    std::pair<void*, std::size_t> mem) noexcept
+{
+  if (mem.first == storage_)
+    return;
+  if (mem.second > spare_.second)
+    std::swap(mem, spare_);
+  deallocate(mem);
+}
+
 void cancellation_slot::clear()
 {
-  if (handler_ != 0 && *handler_ != 0)
+  if (signal_ != 0 && signal_->handler_ != 0)
   {
-    std::pair<void*, std::size_t> mem = (*handler_)->destroy();
-    detail::thread_info_base::deallocate(
-        detail::thread_info_base::cancellation_signal_tag(),
-        detail::thread_context::top_of_thread_call_stack(),
-        mem.first, mem.second);
-    *handler_ = 0;
+    signal_->retain(signal_->handler_->destroy());
+    signal_->handler_ = 0;
   }
 }
 
 std::pair<void*, std::size_t> cancellation_slot::prepare_memory(
     std::size_t size, std::size_t align)
 {
-  assert(handler_);
+  assert(signal_);
   std::pair<void*, std::size_t> mem;
-  if (*handler_)
+  if (signal_->handler_)
   {
-    mem = (*handler_)->destroy();
-    *handler_ = 0;
+    signal_->retain(signal_->handler_->destroy());
+    signal_->handler_ = 0;
   }
+
+  // Use the signal's own storage if the handler fits, so that most handlers
+  // are installed without allocating memory.
+  if (size <= cancellation_signal::storage_size
+      && align <= cancellation_signal::storage_align)
+  {
+    mem.first = signal_->storage_;
+    mem.second = cancellation_signal::storage_size;
+    return mem;
+  }
+
+  // Otherwise reuse the memory kept from an earlier large handler if it is
+  // big enough.
+  mem = signal_->spare_;
+  signal_->spare_ = std::pair<void*, std::size_t>();
   if (size > mem.second
       || reinterpret_cast<std::size_t>(mem.first) % align != 0)
   {
-    if (mem.first)
-    {
-      detail::thread_info_base::deallocate(
-          detail::thread_info_base::cancellation_signal_tag(),
-          detail::thread_context::top_of_thread_call_stack(),
-          mem.first, mem.second);
-    }
+    signal_->deallocate(mem);
     mem.first = detail::thread_info_base::allocate(
         detail::thread_info_base::cancellation_signal_tag(),
         detail::thread_context::top_of_thread_call_stack(),
@@ -81,12 +103,7 @@ std::pair<void*, std::size_t> cancellation_slot::prepare_memory(
 cancellation_slot::auto_delete_helper::~auto_delete_helper()
 {
   if (mem.first)
-  {
-    detail::thread_info_base::deallocate(
-        detail::thread_info_base::cancellation_signal_tag(),
-        detail::thread_context::top_of_thread_call_stack(),
-        mem.first, mem.second);
-  }
+    signal->deallocate(mem);
 }
 
 } // namespace asio
@@ -16,9 +16,13 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/associated_allocator.hpp"
 #include "asio/associated_cancellation_slot.hpp"
 #include "asio/awaitable.hpp"
+#include "asio/awaitable_arena_allocator.hpp"
+#include "asio/detail/atomic_count.hpp"
 #include "asio/detail/memory.hpp"
+#include "asio/detail/noncopyable.hpp"
 #include "asio/detail/recycling_allocator.hpp"
 #include "asio/dispatch.hpp"
 #include "asio/execution/outstanding_work.hpp"
@@ -242,31 +246,143 @@ private:
   awaitable<T, Executor> awaitable_;
 };
 
+// A cancellation signal that may outlive the co_spawn cancellation handler
+// while an emission is pending on the handler's associated executor. Only the
+// handler adds references, so when it holds the sole reference it may destroy
+// the signal without an atomic read-modify-write. As a result, a co_spawn
+// operation that is never cancelled performs no atomic operations here.
+class co_spawn_shared_signal
+  : private noncopyable
+{
+public:
+  typedef recycling_allocator<co_spawn_shared_signal,
+      thread_info_base::cancellation_signal_tag> allocator_type;
+
+  // Create a new signal, holding the caller's reference.
+  static co_spawn_shared_signal* create()
+  {
+    return new (allocator_type().allocate(1)) co_spawn_shared_signal;
+  }
+
+  cancellation_signal& signal()
+  {
+    return signal_;
+  }
+
+  // Add a reference. Must be called only by the holder of the owner's
+  // reference.
+  void add_ref()
+  {
+    ref_count_up(ref_count_);
+  }
+
+  // Release the owner's reference.
+  void release_owner()
+  {
+    if (ref_count_is_unique(ref_count_))
+      destroy();
+    else
+      release();
+  }
+
+  // Release a reference added by add_ref().
+  void release()
+  {
+    if (ref_count_down(ref_count_))
+      destroy();
+  }
+
+private:
+  co_spawn_shared_signal()
+    : ref_count_(1)
+  {
+  }
+
+  void destroy()
+  {
+    this->~co_spawn_shared_signal();
+    allocator_type().deallocate(this, 1);
+  }
+
+  atomic_count ref_count_;
+  cancellation_signal signal_;
+};
+
+// Function object that emits a co_spawn_shared_signal.
+class co_spawn_emit_signal
+{
+public:
+  co_spawn_emit_signal(co_spawn_shared_signal* sig, cancellation_type_t type)
+    : signal_(sig),
+      type_(type)
+  {
+    signal_->add_ref();
+  }
+
+  co_spawn_emit_signal(const co_spawn_emit_signal& other)
+    : signal_(other.signal_),
+      type_(other.type_)
+  {
+    signal_->add_ref();
+  }
+
+  co_spawn_emit_signal(co_spawn_emit_signal&& other) noexcept
+    : signal_(other.signal_),
+      type_(other.type_)
+  {
+    other.signal_ = 0;
+  }
+
+  ~co_spawn_emit_signal()
+  {
+    if (signal_)
+      signal_->release();
+  }
+
+  void operator()()
+  {
+    signal_->signal().emit(type_);
+  }
+
+private:
+  co_spawn_emit_signal& operator=(const co_spawn_emit_signal&) = delete;
+
+  co_spawn_shared_signal* signal_;
+  cancellation_type_t type_;
+};
+
 template <typename Handler, typename Executor, typename = void>
 class co_spawn_cancellation_handler
 {
 public:
   co_spawn_cancellation_handler(const Handler&, const Executor& ex)
-    : signal_(detail::allocate_shared<cancellation_signal>(
-          detail::recycling_allocator<cancellation_signal,
-            detail::thread_info_base::cancellation_signal_tag>())),
+    : signal_(co_spawn_shared_signal::create()),
       ex_(ex)
   {
   }
 
+  ~co_spawn_cancellation_handler()
+  {
+    signal_->release_owner();
+  }
+
   cancellation_slot slot()
   {
-    return signal_->slot();
+    return signal_->signal().slot();
   }
 
   void operator()(cancellation_type_t type)
   {
-    shared_ptr<cancellation_signal> sig = signal_;
-    asio::dispatch(ex_, [sig, type]{ sig->emit(type); });
+    asio::dispatch(ex_, co_spawn_emit_signal(signal_, type));
   }
 
 private:
-  shared_ptr<cancellation_signal> signal_;
+  co_spawn_cancellation_handler(
+      const co_spawn_cancellation_handler&) = delete;
+  co_spawn_cancellation_handler& operator=(
+      const co_spawn_cancellation_handler&) = delete;
+
+  co_spawn_shared_signal* signal_;
   Executor ex_;
 };
 
@@ -299,6 +415,19 @@ private:
   cancellation_signal signal_;
 };
 
+template <typename Allocator>
+inline std::size_t co_spawn_frame_arena_chunk_size(const Allocator&)
+{
+  return 0;
+}
+
+template <typename T>
+inline std::size_t co_spawn_frame_arena_chunk_size(
+    const awaitable_arena_allocator<T>& a)
+{
+  return a.chunk_size() > 0 ? a.chunk_size() : 1;
+}
+
 template <typename Executor>
 class initiate_co_spawn
 {
@@ -337,11 +466,17 @@ public:
 
     cancellation_state cancel_state(proxy_slot);
 
+    std::size_t arena_chunk_size = (co_spawn_frame_arena_chunk_size)(
+        (get_associated_allocator)(handler));
+
     auto a = (co_spawn_entry_point)(static_cast<awaitable_type*>(nullptr),
         co_spawn_state<handler_type, Executor, function_type>(
           std::forward<Handler>(handler), ex_, std::forward<F>(f)));
-    awaitable_handler<executor_type, void>(std::move(a),
-        ex_, proxy_slot, cancel_state).launch();
+    awaitable_handler<executor_type, void> h(std::move(a),
+        ex_, proxy_slot, cancel_state);
+    if (arena_chunk_size)
+      h.use_frame_arena(arena_chunk_size);
+    h.launch();
   }
 
 private:
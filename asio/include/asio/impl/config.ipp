@@ -63,10 +63,16 @@ public:
       if (std::strcmp(key, "concurrency_hint") == 0)
       {
         std::snprintf(value, value_len, "%d",
-            ASIO_CONCURRENCY_HINT_IS_SPECIAL(concurrency_hint_)
+            ASIO_CONCURRENCY_HINT_IS_WORK_STEALING(concurrency_hint_)
+              ? 0 : ASIO_CONCURRENCY_HINT_IS_SPECIAL(concurrency_hint_)
               ? 1 : concurrency_hint_);
         return value;
       }
+      else if (std::strcmp(key, "work_stealing") == 0)
+      {
+        return ASIO_CONCURRENCY_HINT_IS_WORK_STEALING(
+            concurrency_hint_) ? "1" : "0";
+      }
       else if (std::strcmp(key, "locking") == 0)
       {
         return ASIO_CONCURRENCY_HINT_IS_LOCKING(
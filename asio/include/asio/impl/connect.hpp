@@ -16,7 +16,18 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <algorithm>
+#include <memory>
+#include <vector>
+#include "asio/append.hpp"
+#include "asio/associated_allocator.hpp"
+#include "asio/associated_cancellation_slot.hpp"
+#include "asio/associated_executor.hpp"
 #include "asio/associator.hpp"
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/bind_executor.hpp"
+#include "asio/dispatch.hpp"
+#include "asio/executor_work_guard.hpp"
+#include "asio/strand.hpp"
 #include "asio/detail/base_from_cancellation_state.hpp"
 #include "asio/detail/bind_handler.hpp"
 #include "asio/detail/handler_cont_helpers.hpp"
@@ -571,6 +582,279 @@ namespace detail
   private:
     basic_socket<Protocol, Executor>& socket_;
   };
+
+  // Reorder a sequence of endpoints so that address families alternate,
+  // starting with the family of the first endpoint.
+  template <typename Endpoint, typename Iterator>
+  void interleave_address_families(Iterator begin,
+      Iterator end, std::vector<Endpoint>& endpoints)
+  {
+    std::vector<Endpoint> first_family;
+    std::vector<Endpoint> other_families;
+    for (Iterator iter = begin; iter != end; ++iter)
+    {
+      Endpoint endpoint(*iter);
+      if (first_family.empty()
+          || endpoint.protocol().family()
+            == first_family.front().protocol().family())
+        first_family.push_back(endpoint);
+      else
+        other_families.push_back(endpoint);
+    }
+
+    endpoints.clear();
+    endpoints.reserve(first_family.size() + other_families.size());
+    for (std::size_t i = 0;
+        i < first_family.size() || i < other_families.size(); ++i)
+    {
+      if (i < first_family.size())
+        endpoints.push_back(first_family[i]);
+      if (i < other_families.size())
+        endpoints.push_back(other_families[i]);
+    }
+  }
+
+  // The shared state of a staggered connect operation. The handlers of the
+  // connection attempts and the attempt timer are serialised by a strand.
+  template <typename Protocol, typename Executor, typename Handler>
+  class staggered_connect_state
+    : public std::enable_shared_from_this<
+        staggered_connect_state<Protocol, Executor, Handler>>
+  {
+  public:
+    typedef typename Protocol::endpoint endpoint_type;
+    typedef typename Protocol::socket::template
+      rebind_executor<Executor>::other socket_type;
+    typedef basic_waitable_timer<std::chrono::steady_clock,
+      wait_traits<std::chrono::steady_clock>, Executor> timer_type;
+    typedef associated_executor_t<Handler, Executor> handler_executor_type;
+
+    template <typename EndpointSequence>
+    staggered_connect_state(basic_socket<Protocol, Executor>& sock,
+        const EndpointSequence& endpoints, const staggered_connect& options,
+        Handler& handler)
+      : socket_(sock),
+        strand_(sock.get_executor()),
+        timer_(sock.get_executor()),
+        attempt_delay_(options.attempt_delay()),
+        next_(0),
+        pending_(0),
+        timer_generation_(0),
+        done_(false),
+        work_(asio::make_work_guard(handler, sock.get_executor())),
+        handler_(static_cast<Handler&&>(handler))
+    {
+      detail::interleave_address_families(
+          endpoints.begin(), endpoints.end(), endpoints_);
+      attempts_.reserve(endpoints_.size());
+    }
+
+    // Start the first attempt. It is posted so that the handler is never
+    // called from within the initiating function.
+    void start()
+    {
+      std::shared_ptr<staggered_connect_state> self(this->shared_from_this());
+
+      associated_cancellation_slot_t<Handler> slot
+        = asio::get_associated_cancellation_slot(handler_);
+      if (slot.is_connected())
+        slot.template emplace<cancellation_handler>(self);
+
+      asio::post(strand_, [self]{ self->start_attempt(); });
+    }
+
+  private:
+    // Cancels the operation on its strand.
+    class cancellation_handler
+    {
+    public:
+      explicit cancellation_handler(
+          const std::shared_ptr<staggered_connect_state>& state)
+        : state_(state)
+      {
+      }
+
+      void operator()(cancellation_type_t type)
+      {
+        if (!!(type &
+              (cancellation_type::terminal
+                | cancellation_type::partial)))
+        {
+          if (std::shared_ptr<staggered_connect_state> self = state_.lock())
+            asio::post(self->strand_, [self]{ self->cancel(); });
+        }
+      }
+
+    private:
+      std::weak_ptr<staggered_connect_state> state_;
+    };
+
+    // Start a connection attempt to the next endpoint and, if any endpoints
+    // remain, arm the timer for the attempt after it.
+    void start_attempt()
+    {
+      if (done_)
+        return;
+
+      while (next_ < endpoints_.size())
+      {
+        std::size_t index = next_++;
+        attempts_.emplace_back(socket_.get_executor());
+
+        asio::error_code ec;
+        attempts_[index].open(endpoints_[index].protocol(), ec);
+        if (ec)
+        {
+          last_ec_ = ec;
+          continue;
+        }
+
+        std::shared_ptr<staggered_connect_state> self(
+            this->shared_from_this());
+        ++pending_;
+        ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_connect"));
+        attempts_[index].async_connect(endpoints_[index],
+            asio::bind_executor(strand_,
+              [self, index](const asio::error_code& e)
+              {
+                self->handle_connect(index, e);
+              }));
+
+        if (next_ < endpoints_.size())
+        {
+          std::size_t generation = ++timer_generation_;
+          timer_.expires_after(attempt_delay_);
+          timer_.async_wait(
+              asio::bind_executor(strand_,
+                [self, generation](const asio::error_code& e)
+                {
+                  if (!e && generation == self->timer_generation_)
+                    self->start_attempt();
+                }));
+        }
+
+        return;
+      }
+
+      if (pending_ == 0)
+      {
+        complete(last_ec_ ? last_ec_ : asio::error::not_found,
+            endpoint_type());
+      }
+    }
+
+    void handle_connect(std::size_t index, const asio::error_code& ec)
+    {
+      --pending_;
+      if (done_)
+        return;
+
+      asio::error_code ignored_ec;
+      if (!ec)
+      {
+        // The first attempt to succeed wins. The others are cancelled.
+        for (std::size_t i = 0; i < attempts_.size(); ++i)
+          if (i != index)
+            attempts_[i].close(ignored_ec);
+        socket_ = static_cast<basic_socket<Protocol, Executor>&&>(
+            attempts_[index]);
+        complete(ec, endpoints_[index]);
+        return;
+      }
+
+      // A failed attempt starts the next one without waiting for the timer.
+      last_ec_ = ec;
+      attempts_[index].close(ignored_ec);
+      start_attempt();
+    }
+
+    void cancel()
+    {
+      if (done_)
+        return;
+
+      asio::error_code ignored_ec;
+      for (std::size_t i = 0; i < attempts_.size(); ++i)
+        attempts_[i].close(ignored_ec);
+      complete(asio::error::operation_aborted, endpoint_type());
+    }
+
+    void complete(const asio::error_code& ec, const endpoint_type& endpoint)
+    {
+      done_ = true;
+      ++timer_generation_;
+      timer_.cancel();
+
+      // The cancellation handler is not needed once the operation completes.
+      associated_cancellation_slot_t<Handler> slot
+        = asio::get_associated_cancellation_slot(handler_);
+      if (slot.is_connected())
+        slot.clear();
+
+      handler_executor_type ex(work_.get_executor());
+      asio::dispatch(ex, asio::append(static_cast<Handler&&>(handler_),
+            ec, endpoint));
+      work_.reset();
+    }
+
+    basic_socket<Protocol, Executor>& socket_;
+    strand<Executor> strand_;
+    timer_type timer_;
+    std::chrono::steady_clock::duration attempt_delay_;
+    std::vector<endpoint_type> endpoints_;
+    std::vector<socket_type> attempts_;
+    std::size_t next_;
+    std::size_t pending_;
+    std::size_t timer_generation_;
+    asio::error_code last_ec_;
+    bool done_;
+    executor_work_guard<handler_executor_type> work_;
+    Handler handler_;
+  };
+
+  template <typename Protocol, typename Executor>
+  class initiate_async_staggered_connect
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_staggered_connect(
+        basic_socket<Protocol, Executor>& s)
+      : socket_(s)
+    {
+    }
+
+    executor_type get_executor() const noexcept
+    {
+      return socket_.get_executor();
+    }
+
+    template <typename RangeConnectHandler, typename EndpointSequence>
+    void operator()(RangeConnectHandler&& handler,
+        const EndpointSequence& endpoints,
+        const staggered_connect& options) const
+    {
+      // If you get an error on the following line it means that your
+      // handler does not meet the documented type requirements for an
+      // RangeConnectHandler.
+      ASIO_RANGE_CONNECT_HANDLER_CHECK(RangeConnectHandler,
+          handler, typename Protocol::endpoint) type_check;
+
+      asio::error_code ignored_ec;
+      socket_.close(ignored_ec);
+
+      typedef staggered_connect_state<Protocol, Executor,
+        decay_t<RangeConnectHandler>> state_type;
+      non_const_lvalue<RangeConnectHandler> handler2(handler);
+      std::shared_ptr<state_type> state(std::allocate_shared<state_type>(
+            (get_associated_allocator)(handler2.value),
+            socket_, endpoints, options, handler2.value));
+      state->start();
+    }
+
+  private:
+    basic_socket<Protocol, Executor>& socket_;
+  };
 } // namespace detail
 
 #if !defined(GENERATING_DOCUMENTATION)
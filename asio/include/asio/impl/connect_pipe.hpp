@@ -38,9 +38,26 @@ void connect_pipe(basic_readable_pipe<Executor1>& read_end,
 template <typename Executor1, typename Executor2>
 ASIO_SYNC_OP_VOID connect_pipe(basic_readable_pipe<Executor1>& read_end,
     basic_writable_pipe<Executor2>& write_end, asio::error_code& ec)
+{
+  return asio::connect_pipe(read_end, write_end, 0, ec);
+}
+
+template <typename Executor1, typename Executor2>
+void connect_pipe(basic_readable_pipe<Executor1>& read_end,
+    basic_writable_pipe<Executor2>& write_end, std::size_t capacity)
+{
+  asio::error_code ec;
+  asio::connect_pipe(read_end, write_end, capacity, ec);
+  asio::detail::throw_error(ec, "connect_pipe");
+}
+
+template <typename Executor1, typename Executor2>
+ASIO_SYNC_OP_VOID connect_pipe(basic_readable_pipe<Executor1>& read_end,
+    basic_writable_pipe<Executor2>& write_end, std::size_t capacity,
+    asio::error_code& ec)
 {
   detail::native_pipe_handle p[2];
-  detail::create_pipe(p, ec);
+  detail::create_pipe(p, capacity, ec);
   if (ec)
     ASIO_SYNC_OP_VOID_RETURN(ec);
 
@@ -34,6 +34,7 @@
 #  endif // !defined(ASIO_NO_DEFAULT_LINKED_LIBS)
 # endif // _WIN32_WINNT >= 0x601
 #else // defined(ASIO_HAS_IOCP)
+# include <fcntl.h>
 # include "asio/detail/descriptor_ops.hpp"
 #endif // defined(ASIO_HAS_IOCP)
 
@@ -42,7 +43,8 @@
 namespace asio {
 namespace detail {
 
-void create_pipe(native_pipe_handle p[2], asio::error_code& ec)
+void create_pipe(native_pipe_handle p[2],
+    std::size_t capacity, asio::error_code& ec)
 {
 #if defined(ASIO_HAS_IOCP)
   using namespace std; // For sprintf and memcmp.
@@ -65,9 +67,16 @@ void create_pipe(native_pipe_handle p[2], asio::error_code& ec)
       L"\\\\.\\pipe\\asio-A0812896-741A-484D-AF23-BE51BF620E22-%u-%ld-%ld",
       static_cast<unsigned int>(::GetCurrentProcessId()), n1, n2);
 
+  DWORD buffer_size = 8192;
+  if (capacity > 0)
+  {
+    buffer_size = capacity > 0xFFFFFFFF
+      ? 0xFFFFFFFF : static_cast<DWORD>(capacity);
+  }
+
   p[0] = ::CreateNamedPipeW(pipe_name,
       PIPE_ACCESS_INBOUND | FILE_FLAG_OVERLAPPED,
-      0, 1, 8192, 8192, 0, 0);
+      0, 1, buffer_size, buffer_size, 0, 0);
 
   if (p[0] == INVALID_HANDLE_VALUE)
   {
@@ -125,6 +134,23 @@ void create_pipe(native_pipe_handle p[2], asio::error_code& ec)
 #else // defined(ASIO_HAS_IOCP)
   int result = ::pipe(p);
   detail::descriptor_ops::get_last_error(ec, result != 0);
+
+# if defined(F_SETPIPE_SZ)
+  if (!ec && capacity > 0)
+  {
+    int size = capacity > 0x7FFFFFFF
+      ? 0x7FFFFFFF : static_cast<int>(capacity);
+    result = ::fcntl(p[1], F_SETPIPE_SZ, size);
+    detail::descriptor_ops::get_last_error(ec, result < 0);
+    if (ec)
+    {
+      close_pipe(p[0]);
+      close_pipe(p[1]);
+    }
+  }
+# else // defined(F_SETPIPE_SZ)
+  (void)capacity;
+# endif // defined(F_SETPIPE_SZ)
 #endif // defined(ASIO_HAS_IOCP)
 }
 
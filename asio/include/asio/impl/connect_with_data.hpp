@@ -0,0 +1,310 @@
+//
+// impl/connect_with_data.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_CONNECT_WITH_DATA_HPP
+#define ASIO_IMPL_CONNECT_WITH_DATA_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/associator.hpp"
+#include "asio/completion_condition.hpp"
+#include "asio/immediate.hpp"
+#include "asio/socket_base.hpp"
+#include "asio/detail/base_from_cancellation_state.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/consuming_buffers.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/handler_tracking.hpp"
+#include "asio/detail/handler_type_requirements.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/socket_types.hpp"
+
+#if defined(ASIO_HAS_TCP_FASTOPEN)
+# include <cerrno>
+#endif // defined(ASIO_HAS_TCP_FASTOPEN)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+namespace detail
+{
+  template <typename Protocol, typename Executor,
+      typename ConstBufferSequence, typename WriteHandler>
+  class connect_with_data_op
+    : public base_from_cancellation_state<WriteHandler>
+  {
+  public:
+    connect_with_data_op(basic_stream_socket<Protocol, Executor>& s,
+        const typename Protocol::endpoint& peer_endpoint,
+        const ConstBufferSequence& buffers, WriteHandler& handler)
+      : base_from_cancellation_state<WriteHandler>(handler),
+        socket_(s),
+        endpoint_(peer_endpoint),
+        buffers_(buffers),
+        start_(0),
+        check_connect_(false),
+        handler_(static_cast<WriteHandler&&>(handler))
+    {
+    }
+
+    connect_with_data_op(connect_with_data_op&& other)
+      : base_from_cancellation_state<WriteHandler>(
+          static_cast<base_from_cancellation_state<WriteHandler>&&>(other)),
+        socket_(other.socket_),
+        endpoint_(other.endpoint_),
+        buffers_(static_cast<buffers_type&&>(other.buffers_)),
+        start_(other.start_),
+        check_connect_(other.check_connect_),
+        handler_(static_cast<WriteHandler&&>(other.handler_))
+    {
+    }
+
+    // Start the operation.
+    void start()
+    {
+      start_ = 1;
+      asio::error_code ec;
+      if (!socket_.is_open())
+        socket_.open(endpoint_.protocol(), ec);
+
+#if defined(ASIO_HAS_TCP_FASTOPEN)
+      if (!ec && !buffers_.empty() && fast_open(ec))
+        return;
+#endif // defined(ASIO_HAS_TCP_FASTOPEN)
+
+      if (ec)
+        return immediate(ec, 0);
+
+      ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_connect_with_data"));
+      start_ = 0;
+      socket_.async_connect(endpoint_,
+          static_cast<connect_with_data_op&&>(*this));
+    }
+
+    // Resume the operation once the connection has been established.
+    void operator()(asio::error_code ec)
+    {
+#if defined(ASIO_HAS_TCP_FASTOPEN)
+      if (!ec && check_connect_)
+      {
+        // The socket became writable, so the handshake has finished.
+        int connect_error = 0;
+        socklen_t len = sizeof(connect_error);
+        if (::getsockopt(socket_.native_handle(), SOL_SOCKET,
+              SO_ERROR, &connect_error, &len) != 0)
+          connect_error = errno;
+        if (connect_error)
+        {
+          ec = asio::error_code(connect_error,
+              asio::error::get_system_category());
+        }
+      }
+      check_connect_ = false;
+#endif // defined(ASIO_HAS_TCP_FASTOPEN)
+
+      (*this)(ec, 0);
+    }
+
+    // Write the data remaining after the connection has been initiated.
+    void operator()(asio::error_code ec, std::size_t bytes_transferred)
+    {
+      buffers_.consume(bytes_transferred);
+      if (!ec && !buffers_.empty())
+      {
+        if (this->cancelled() != cancellation_type::none)
+        {
+          ec = error::operation_aborted;
+        }
+        else
+        {
+          ASIO_HANDLER_LOCATION((__FILE__, __LINE__,
+                "async_connect_with_data"));
+          start_ = 0;
+          socket_.async_write_some(buffers_.prepare(default_max_transfer_size),
+              static_cast<connect_with_data_op&&>(*this));
+          return;
+        }
+      }
+
+      static_cast<WriteHandler&&>(handler_)(
+          static_cast<const asio::error_code&>(ec),
+          static_cast<const std::size_t&>(buffers_.total_consumed()));
+    }
+
+  //private:
+#if defined(ASIO_HAS_TCP_FASTOPEN)
+    // Initiate the connection with the first part of the data in the SYN.
+    // Returns false if the caller should fall back to a normal connect.
+    bool fast_open(asio::error_code& ec)
+    {
+      if (!socket_.native_non_blocking())
+      {
+        socket_.native_non_blocking(true, ec);
+        if (ec)
+          return false;
+      }
+
+      typedef decltype(buffers_.prepare(0)) prepared_type;
+      prepared_type prepared(buffers_.prepare(default_max_transfer_size));
+      buffer_sequence_adapter<const_buffer, prepared_type> bufs(prepared);
+
+      msghdr msg = msghdr();
+      msg.msg_name = endpoint_.data();
+      msg.msg_namelen = static_cast<socklen_t>(endpoint_.size());
+      msg.msg_iov = bufs.buffers();
+      msg.msg_iovlen = static_cast<int>(bufs.count());
+
+      for (;;)
+      {
+        signed_size_type n = ::sendmsg(socket_.native_handle(), &msg,
+            ASIO_OS_DEF(MSG_FASTOPEN) | MSG_NOSIGNAL);
+        if (n >= 0)
+        {
+          // The data has been queued, and is sent in the SYN if the client
+          // holds a cookie for the server.
+          immediate(ec, static_cast<std::size_t>(n));
+          return true;
+        }
+
+        switch (errno)
+        {
+        case EINTR:
+          continue;
+        case EINPROGRESS:
+          // The SYN has been sent without data.
+          ASIO_HANDLER_LOCATION((__FILE__, __LINE__,
+                "async_connect_with_data"));
+          start_ = 0;
+          check_connect_ = true;
+          socket_.async_wait(socket_base::wait_write,
+              static_cast<connect_with_data_op&&>(*this));
+          return true;
+        case EOPNOTSUPP:
+          // Fast Open is disabled for clients or unsupported by the protocol.
+          return false;
+        default:
+          ec = asio::error_code(errno, asio::error::get_system_category());
+          return false;
+        }
+      }
+    }
+#endif // defined(ASIO_HAS_TCP_FASTOPEN)
+
+    // Deliver the result as an immediate completion.
+    void immediate(const asio::error_code& ec, std::size_t bytes_transferred)
+    {
+      ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_connect_with_data"));
+      start_ = 0;
+      asio::async_immediate(socket_.get_executor(),
+          asio::detail::bind_handler(
+            static_cast<connect_with_data_op&&>(*this),
+            ec, bytes_transferred));
+    }
+
+    typedef asio::detail::consuming_buffers<const_buffer, ConstBufferSequence,
+        decltype(asio::buffer_sequence_begin(
+            declval<const ConstBufferSequence&>()))> buffers_type;
+
+    basic_stream_socket<Protocol, Executor>& socket_;
+    typename Protocol::endpoint endpoint_;
+    buffers_type buffers_;
+    int start_;
+    bool check_connect_;
+    WriteHandler handler_;
+  };
+
+  template <typename Protocol, typename Executor,
+      typename ConstBufferSequence, typename WriteHandler>
+  inline bool asio_handler_is_continuation(
+      connect_with_data_op<Protocol, Executor,
+        ConstBufferSequence, WriteHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Protocol, typename Executor>
+  class initiate_async_connect_with_data
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_connect_with_data(
+        basic_stream_socket<Protocol, Executor>& s)
+      : socket_(s)
+    {
+    }
+
+    executor_type get_executor() const noexcept
+    {
+      return socket_.get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(WriteHandler&& handler,
+        const typename Protocol::endpoint& peer_endpoint,
+        const ConstBufferSequence& buffers) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      non_const_lvalue<WriteHandler> handler2(handler);
+      connect_with_data_op<Protocol, Executor, ConstBufferSequence,
+        decay_t<WriteHandler>>(socket_, peer_endpoint,
+          buffers, handler2.value).start();
+    }
+
+  private:
+    basic_stream_socket<Protocol, Executor>& socket_;
+  };
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <template <typename, typename> class Associator,
+    typename Protocol, typename Executor, typename ConstBufferSequence,
+    typename WriteHandler, typename DefaultCandidate>
+struct associator<Associator,
+    detail::connect_with_data_op<Protocol, Executor,
+      ConstBufferSequence, WriteHandler>,
+    DefaultCandidate>
+  : Associator<WriteHandler, DefaultCandidate>
+{
+  static typename Associator<WriteHandler, DefaultCandidate>::type get(
+      const detail::connect_with_data_op<Protocol, Executor,
+        ConstBufferSequence, WriteHandler>& h) noexcept
+  {
+    return Associator<WriteHandler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static auto get(
+      const detail::connect_with_data_op<Protocol, Executor,
+        ConstBufferSequence, WriteHandler>& h,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<WriteHandler, DefaultCandidate>::get(
+          h.handler_, c))
+  {
+    return Associator<WriteHandler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_CONNECT_WITH_DATA_HPP
@@ -21,6 +21,7 @@
 #include "asio/detail/fenced_block.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
 #include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/op_queue.hpp"
 #include "asio/detail/service_registry.hpp"
 #include "asio/detail/throw_error.hpp"
 #include "asio/detail/type_traits.hpp"
@@ -153,7 +154,8 @@ io_context::basic_executor_type<Allocator, Bits>::operator=(
 {
   if (this != &other)
   {
-    static_cast<Allocator&>(*this) = static_cast<const Allocator&>(other);
+    static_cast<storage_type&>(*this) =
+      static_cast<const storage_type&>(other);
     io_context* old_io_context = context_ptr();
     target_ = other.target_;
     if (Bits & outstanding_work_tracked)
@@ -174,7 +176,7 @@ io_context::basic_executor_type<Allocator, Bits>::operator=(
 {
   if (this != &other)
   {
-    static_cast<Allocator&>(*this) = static_cast<Allocator&&>(other);
+    static_cast<storage_type&>(*this) = static_cast<storage_type&&>(other);
     io_context* old_io_context = context_ptr();
     target_ = other.target_;
     if (Bits & outstanding_work_tracked)
@@ -203,7 +205,8 @@ void io_context::basic_executor_type<Allocator, Bits>::execute(
 
   // Invoke immediately if the blocking.possibly property is enabled and we are
   // already inside the thread pool.
-  if ((bits() & blocking_never) == 0 && context_ptr()->impl_.can_dispatch())
+  if ((bits() & blocking_never) == 0
+      && context_ptr()->impl_.can_dispatch_inline())
   {
     // Make a local, non-const copy of the function.
     function_type tmp(static_cast<Function&&>(f));
@@ -236,11 +239,63 @@ void io_context::basic_executor_type<Allocator, Bits>::execute(
   ASIO_HANDLER_CREATION((*context_ptr(), *p.p,
         "io_context", context_ptr(), 0, "execute"));
 
-  context_ptr()->impl_.post_immediate_completion(p.p,
-      (bits() & relationship_continuation) != 0);
+  if (Bits & prioritised)
+  {
+    context_ptr()->impl_.post_prioritised_completion(p.p,
+        (bits() & relationship_continuation) != 0, this->priority_value());
+  }
+  else
+  {
+    context_ptr()->impl_.post_immediate_completion(p.p,
+        (bits() & relationship_continuation) != 0);
+  }
   p.v = p.p = 0;
 }
 
+template <typename Allocator, uintptr_t Bits>
+template <typename Range>
+void io_context::basic_executor_type<Allocator, Bits>::post_batch(
+    Range&& fs) const
+{
+  // Allocate and construct an operation to wrap each function. If an
+  // allocation fails, the operations already constructed are destroyed by
+  // the queue without being invoked.
+  detail::op_queue<detail::operation> ops;
+  std::size_t n = 0;
+  for (auto&& f : fs)
+  {
+    typedef decay_t<decltype(f)> function_type;
+    typedef detail::executor_op<function_type, Allocator, detail::operation> op;
+    typename op::ptr p = {
+        detail::addressof(static_cast<const Allocator&>(*this)),
+        op::ptr::allocate(static_cast<const Allocator&>(*this)), 0 };
+    p.p = new (p.v) op(std::move(f), static_cast<const Allocator&>(*this));
+
+    ASIO_HANDLER_CREATION((*context_ptr(), *p.p,
+          "io_context", context_ptr(), 0, "post_batch"));
+
+    ops.push(p.p);
+    p.v = p.p = 0;
+    ++n;
+  }
+
+  if ((Bits & prioritised) && this->priority_value() != 0)
+  {
+    // Each operation must be queued in its priority lane.
+    while (detail::operation* o = ops.front())
+    {
+      ops.pop();
+      context_ptr()->impl_.post_prioritised_completion(o,
+          (bits() & relationship_continuation) != 0, this->priority_value());
+    }
+  }
+  else if (n > 0)
+  {
+    context_ptr()->impl_.post_immediate_completions(n, ops,
+        (bits() & relationship_continuation) != 0);
+  }
+}
+
 #if !defined(ASIO_NO_TS_EXECUTORS)
 template <typename Allocator, uintptr_t Bits>
 inline io_context& io_context::basic_executor_type<
@@ -271,7 +326,7 @@ void io_context::basic_executor_type<Allocator, Bits>::dispatch(
   typedef decay_t<Function> function_type;
 
   // Invoke immediately if we are already inside the thread pool.
-  if (context_ptr()->impl_.can_dispatch())
+  if (context_ptr()->impl_.can_dispatch_inline())
   {
     // Make a local, non-const copy of the function.
     function_type tmp(static_cast<Function&&>(f));
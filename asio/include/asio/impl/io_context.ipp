@@ -20,7 +20,9 @@
 #include "asio/io_context.hpp"
 #include "asio/detail/concurrency_hint.hpp"
 #include "asio/detail/limits.hpp"
+#include "asio/detail/operation_latency.hpp"
 #include "asio/detail/service_registry.hpp"
+#include "asio/detail/strand_executor_service.hpp"
 #include "asio/detail/throw_error.hpp"
 
 #if defined(ASIO_HAS_IOCP)
@@ -103,6 +105,46 @@ void io_context::restart()
   impl_.restart();
 }
 
+io_context::metrics_snapshot io_context::get_metrics()
+{
+  detail::scheduler_metrics& m = impl_.metrics();
+  metrics_snapshot s;
+  s.enabled = m.enabled();
+  s.handlers_run = m.handlers_run();
+  s.max_queue_depth = m.max_queue_depth();
+  s.handler_time = chrono::nanoseconds(m.handler_nsec());
+  s.reactor_time = chrono::nanoseconds(m.task_nsec());
+  s.reactor_runs = m.task_runs();
+  s.reactor_events = m.task_events();
+  s.ring_submits = m.submit_calls();
+  s.ring_submitted_entries = m.submitted_entries();
+  s.pending_timers = m.pending_timers();
+  execution_context& ctx = *this;
+  s.max_strand_queue_depth =
+    asio::has_service<detail::strand_executor_service>(ctx)
+      ? asio::use_service<detail::strand_executor_service>(ctx)
+        .max_queue_depth()
+      : 0;
+  return s;
+}
+
+io_context::operation_latency io_context::get_operation_latency(
+    latency_operation op)
+{
+  static_assert(static_cast<int>(post_operation) + 1
+      == static_cast<int>(detail::latency_kinds),
+      "latency_operation must match detail::latency_kind");
+
+  operation_latency l;
+#if defined(ASIO_ENABLE_LATENCY_HISTOGRAMS) && !defined(ASIO_HAS_IOCP)
+  impl_.latency().snapshot(static_cast<detail::latency_kind>(op),
+      l.completion, l.invocation);
+#else // defined(ASIO_ENABLE_LATENCY_HISTOGRAMS) && !defined(ASIO_HAS_IOCP)
+  (void)op;
+#endif // defined(ASIO_ENABLE_LATENCY_HISTOGRAMS) && !defined(ASIO_HAS_IOCP)
+  return l;
+}
+
 io_context::service::service(asio::io_context& owner)
   : execution_context::service(owner)
 {
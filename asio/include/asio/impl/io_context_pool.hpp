@@ -0,0 +1,100 @@
+//
+// impl/io_context_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_IO_CONTEXT_POOL_HPP
+#define ASIO_IMPL_IO_CONTEXT_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/throw_error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+template <typename Protocol>
+std::vector<io_context_pool::acceptor<Protocol>> io_context_pool::listen(
+    const typename Protocol::endpoint& endpoint,
+    distribution dist, int backlog)
+{
+  asio::error_code ec;
+  std::vector<acceptor<Protocol>> acceptors =
+    this->listen<Protocol>(endpoint, dist, backlog, ec);
+  asio::detail::throw_error(ec, "listen");
+  return acceptors;
+}
+
+template <typename Protocol>
+std::vector<io_context_pool::acceptor<Protocol>> io_context_pool::listen(
+    const typename Protocol::endpoint& endpoint,
+    distribution dist, int backlog, asio::error_code& ec)
+{
+  std::vector<acceptor<Protocol>> acceptors;
+
+#if defined(ASIO_HAS_SO_REUSEPORT)
+  // All acceptors are bound to the endpoint chosen for the first, in case the
+  // specified endpoint has an unspecified port.
+  typename Protocol::endpoint bind_endpoint = endpoint;
+
+  acceptors.reserve(contexts_.size());
+  for (std::size_t i = 0; i < contexts_.size(); ++i)
+  {
+    acceptors.push_back(acceptor<Protocol>(contexts_[i]->get_executor()));
+    acceptor<Protocol>& a = acceptors.back();
+
+    a.open(endpoint.protocol(), ec);
+    if (!ec)
+      a.set_option(socket_base::reuse_address(true), ec);
+    if (!ec)
+      a.set_option(socket_base::reuse_port(true), ec);
+    if (!ec)
+      a.bind(bind_endpoint, ec);
+    if (!ec && i == 0)
+      bind_endpoint = a.local_endpoint(ec);
+    if (!ec)
+      a.listen(backlog, ec);
+    if (ec)
+    {
+      acceptors.clear();
+      return acceptors;
+    }
+  }
+
+  // The steering program belongs to the reuseport group, and so is attached
+  // only once all sockets have joined the group.
+  if (dist == distribute_by_cpu)
+  {
+    attach_cpu_distribution(acceptors.front().native_handle(),
+        acceptors.size(), ec);
+    if (ec)
+    {
+      acceptors.clear();
+      return acceptors;
+    }
+  }
+
+  ec = asio::error_code();
+#else // defined(ASIO_HAS_SO_REUSEPORT)
+  (void)endpoint;
+  (void)dist;
+  (void)backlog;
+  ec = asio::error::operation_not_supported;
+#endif // defined(ASIO_HAS_SO_REUSEPORT)
+
+  return acceptors;
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_IO_CONTEXT_POOL_HPP
@@ -0,0 +1,225 @@
+//
+// impl/io_context_pool.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_IO_CONTEXT_POOL_IPP
+#define ASIO_IMPL_IO_CONTEXT_POOL_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <exception>
+#include <limits>
+#include "asio/io_context_pool.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/detail/thread.hpp"
+#include "asio/detail/thread_affinity.hpp"
+
+#if defined(ASIO_HAS_REUSEPORT_CBPF)
+# include <linux/filter.h>
+#endif // defined(ASIO_HAS_REUSEPORT_CBPF)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+struct io_context_pool::thread_function
+{
+  io_context* context_;
+  std::size_t index_;
+  bool bind_to_processor_;
+
+  void operator()()
+  {
+    if (bind_to_processor_)
+    {
+      asio::error_code ec;
+      detail::bind_this_thread_to_processor(index_, ec);
+    }
+
+#if !defined(ASIO_NO_EXCEPTIONS)
+    try
+    {
+#endif// !defined(ASIO_NO_EXCEPTIONS)
+      context_->run();
+#if !defined(ASIO_NO_EXCEPTIONS)
+    }
+    catch (...)
+    {
+      std::terminate();
+    }
+#endif// !defined(ASIO_NO_EXCEPTIONS)
+  }
+};
+
+io_context_pool::io_context_pool()
+  : io_context_pool(detail::thread::hardware_concurrency(), true)
+{
+}
+
+io_context_pool::io_context_pool(std::size_t pool_size,
+    bool bind_to_processors)
+  : io_context_pool(pool_size, round_robin, bind_to_processors)
+{
+}
+
+io_context_pool::io_context_pool(std::size_t pool_size,
+    load_balancing lb, bool bind_to_processors)
+  : threads_(std::allocator<void>()),
+    next_context_(0),
+    load_balancing_(lb)
+{
+  if (pool_size == 0)
+    pool_size = 1;
+  for (std::size_t i = 0; i < pool_size; ++i)
+    contexts_.push_back(std::unique_ptr<io_context>(new io_context(1)));
+  draining_.reset(new detail::atomic_count[pool_size]());
+  start(bind_to_processors);
+}
+
+io_context_pool::~io_context_pool()
+{
+  stop();
+  join();
+}
+
+std::size_t io_context_pool::outstanding_work(
+    std::size_t index) const noexcept
+{
+  return asio::use_service<detail::io_context_impl>(
+      *contexts_[index]).outstanding_work();
+}
+
+void io_context_pool::drain(std::size_t index)
+{
+  draining_[index] = 1;
+  work_[index].reset();
+}
+
+void io_context_pool::drain()
+{
+  for (std::size_t i = 0; i < contexts_.size(); ++i)
+    drain(i);
+}
+
+void io_context_pool::stop()
+{
+  for (std::size_t i = 0; i < contexts_.size(); ++i)
+    contexts_[i]->stop();
+}
+
+void io_context_pool::join()
+{
+  work_.clear();
+  threads_.join();
+}
+
+void io_context_pool::start(bool bind_to_processors)
+{
+  work_.reserve(contexts_.size());
+  for (std::size_t i = 0; i < contexts_.size(); ++i)
+    work_.push_back(asio::make_work_guard(*contexts_[i]));
+
+  for (std::size_t i = 0; i < contexts_.size(); ++i)
+  {
+    thread_function f = { contexts_[i].get(), i, bind_to_processors };
+    threads_.create_thread(f);
+  }
+}
+
+std::size_t io_context_pool::choose() noexcept
+{
+  const std::size_t size = contexts_.size();
+  const std::size_t next = static_cast<std::size_t>(next_context_++);
+
+  if (load_balancing_ == least_outstanding_work)
+  {
+    // Start the scan at a different position each time, so that ties are
+    // broken in turn.
+    std::size_t best = size;
+    std::size_t best_work = (std::numeric_limits<std::size_t>::max)();
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      std::size_t index = (next + i) % size;
+      if (!is_draining(index))
+      {
+        std::size_t work = outstanding_work(index);
+        if (work < best_work)
+        {
+          best = index;
+          best_work = work;
+        }
+      }
+    }
+    if (best != size)
+      return best;
+  }
+  else if (load_balancing_ == power_of_two_choices && size > 1)
+  {
+    // Derive two distinct positions from a scrambled counter value.
+    std::size_t bits = static_cast<std::size_t>(
+        (static_cast<unsigned long long>(next) * 0x9E3779B97F4A7C15ULL) >> 17);
+    std::size_t first = bits % size;
+    std::size_t second = (first + 1 + (bits / size) % (size - 1)) % size;
+    if (is_draining(first))
+      first = second;
+    if (is_draining(second))
+      second = first;
+    if (!is_draining(first))
+    {
+      return outstanding_work(second) < outstanding_work(first)
+        ? second : first;
+    }
+  }
+
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    std::size_t index = (next + i) % size;
+    if (!is_draining(index))
+      return index;
+  }
+  return next % size;
+}
+
+void io_context_pool::attach_cpu_distribution(
+    detail::socket_type handle,
+    std::size_t num_sockets, asio::error_code& ec)
+{
+#if defined(ASIO_HAS_REUSEPORT_CBPF) && defined(SO_ATTACH_REUSEPORT_CBPF)
+  // Return the receiving processor's number, modulo the number of sockets, as
+  // the index of the socket within the reuseport group.
+  ::sock_filter code[] =
+  {
+    { BPF_LD | BPF_W | BPF_ABS, 0, 0,
+      static_cast<__u32>(SKF_AD_OFF + SKF_AD_CPU) },
+    { BPF_ALU | BPF_MOD | BPF_K, 0, 0, static_cast<__u32>(num_sockets) },
+    { BPF_RET | BPF_A, 0, 0, 0 }
+  };
+
+  ::sock_fprog program;
+  program.len = sizeof(code) / sizeof(code[0]);
+  program.filter = code;
+
+  detail::socket_ops::state_type state = 0;
+  detail::socket_ops::setsockopt(handle, state, SOL_SOCKET,
+      SO_ATTACH_REUSEPORT_CBPF, &program, sizeof(program), ec);
+#else // defined(ASIO_HAS_REUSEPORT_CBPF) && defined(SO_ATTACH_REUSEPORT_CBPF)
+  (void)handle;
+  (void)num_sockets;
+  ec = asio::error::operation_not_supported;
+#endif // defined(ASIO_HAS_REUSEPORT_CBPF) && defined(SO_ATTACH_REUSEPORT_CBPF)
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_IO_CONTEXT_POOL_IPP
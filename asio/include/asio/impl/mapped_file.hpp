@@ -0,0 +1,107 @@
+//
+// impl/mapped_file.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_MAPPED_FILE_HPP
+#define ASIO_IMPL_MAPPED_FILE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/post.hpp"
+#include "asio/system_executor.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Performs a prefetch on a thread of the system_context, and then posts the
+// composed operation back to its own executor for completion.
+template <typename Self>
+class mapped_file_prefetch_work
+{
+public:
+  mapped_file_prefetch_work(Self& self, const mapped_file* file,
+      uint64_t offset, std::size_t size)
+    : self_(static_cast<Self&&>(self)),
+      file_(file),
+      offset_(offset),
+      size_(size)
+  {
+  }
+
+  void operator()()
+  {
+    file_->prefetch(offset_, size_);
+    asio::post(static_cast<Self&&>(self_));
+  }
+
+private:
+  Self self_;
+  const mapped_file* file_;
+  uint64_t offset_;
+  std::size_t size_;
+};
+
+class initiate_async_prefetch
+{
+public:
+  initiate_async_prefetch(const mapped_file* file,
+      uint64_t offset, std::size_t size)
+    : file_(file),
+      offset_(offset),
+      size_(size),
+      started_(false)
+  {
+  }
+
+  template <typename Self>
+  void operator()(Self& self)
+  {
+    if (!started_)
+    {
+      started_ = true;
+      if (file_->is_open())
+      {
+        asio::post(asio::system_executor(),
+            mapped_file_prefetch_work<Self>(self, file_, offset_, size_));
+        return;
+      }
+
+      ec_ = asio::error::bad_descriptor;
+      asio::post(static_cast<Self&&>(self));
+      return;
+    }
+
+    self.complete(ec_);
+  }
+
+private:
+  const mapped_file* file_;
+  uint64_t offset_;
+  std::size_t size_;
+  bool started_;
+  asio::error_code ec_;
+};
+
+} // namespace detail
+
+inline detail::initiate_async_prefetch mapped_file::make_prefetch(
+    uint64_t offset, std::size_t size) const
+{
+  return detail::initiate_async_prefetch(this, offset, size);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_MAPPED_FILE_HPP
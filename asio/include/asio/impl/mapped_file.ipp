@@ -0,0 +1,327 @@
+//
+// impl/mapped_file.ipp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_MAPPED_FILE_IPP
+#define ASIO_IMPL_MAPPED_FILE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_MAPPED_FILE)
+
+#include <cerrno>
+#include <limits>
+#if defined(ASIO_WINDOWS)
+# include "asio/detail/socket_types.hpp"
+#else // defined(ASIO_WINDOWS)
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif // defined(ASIO_WINDOWS)
+#include "asio/mapped_file.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+#if defined(ASIO_WINDOWS)
+
+namespace detail {
+
+// Emulation of the declarations needed to use PrefetchVirtualMemory, which
+// is looked up at runtime as it is not available prior to Windows 8.
+struct mapped_file_memory_range
+{
+  void* virtual_address;
+  SIZE_T number_of_bytes;
+};
+
+typedef BOOL (__stdcall *prefetch_virtual_memory_fn)(
+    HANDLE, ULONG_PTR, mapped_file_memory_range*, ULONG);
+
+} // namespace detail
+
+ASIO_SYNC_OP_VOID mapped_file::open(
+    const char* path, asio::error_code& ec)
+{
+  if (is_open())
+  {
+    ec = asio::error::already_open;
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  HANDLE handle = ::CreateFileA(path, GENERIC_READ,
+      FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+      0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+  if (handle == INVALID_HANDLE_VALUE)
+  {
+    DWORD last_error = ::GetLastError();
+    ec.assign(last_error, asio::error::get_system_category());
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  LARGE_INTEGER file_size;
+  if (!::GetFileSizeEx(handle, &file_size))
+  {
+    DWORD last_error = ::GetLastError();
+    ec.assign(last_error, asio::error::get_system_category());
+    ::CloseHandle(handle);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  if (static_cast<ULONGLONG>(file_size.QuadPart)
+      > (std::numeric_limits<std::size_t>::max)())
+  {
+    ec = asio::error::no_memory;
+    ::CloseHandle(handle);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  // An empty file cannot be mapped.
+  void* data = 0;
+  if (file_size.QuadPart > 0)
+  {
+    HANDLE mapping = ::CreateFileMappingA(handle, 0, PAGE_READONLY, 0, 0, 0);
+    if (mapping)
+    {
+      data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      if (!data)
+      {
+        DWORD last_error = ::GetLastError();
+        ec.assign(last_error, asio::error::get_system_category());
+      }
+      ::CloseHandle(mapping);
+    }
+    else
+    {
+      DWORD last_error = ::GetLastError();
+      ec.assign(last_error, asio::error::get_system_category());
+    }
+
+    if (!data)
+    {
+      ::CloseHandle(handle);
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+  }
+
+  data_ = data;
+  size_ = static_cast<std::size_t>(file_size.QuadPart);
+  handle_ = handle;
+  ec = asio::error_code();
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+ASIO_SYNC_OP_VOID mapped_file::close(asio::error_code& ec)
+{
+  ec = asio::error_code();
+  if (data_ && !::UnmapViewOfFile(data_))
+  {
+    DWORD last_error = ::GetLastError();
+    ec.assign(last_error, asio::error::get_system_category());
+  }
+
+  if (is_open() && !::CloseHandle(handle_) && !ec)
+  {
+    DWORD last_error = ::GetLastError();
+    ec.assign(last_error, asio::error::get_system_category());
+  }
+
+  data_ = 0;
+  size_ = 0;
+  handle_ = invalid_handle();
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+ASIO_SYNC_OP_VOID mapped_file::advise(advice a,
+    uint64_t offset, std::size_t size, asio::error_code& ec) const
+{
+  ec = asio::error_code();
+  if (a != will_need || offset >= size_ || size == 0)
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+
+  if (size > size_ - offset)
+    size = static_cast<std::size_t>(size_ - offset);
+
+  // Windows has no equivalent of the other hints for a file mapping.
+  if (FARPROC prefetch_ptr = ::GetProcAddress(
+        ::GetModuleHandleA("KERNEL32"), "PrefetchVirtualMemory"))
+  {
+    detail::prefetch_virtual_memory_fn prefetch_fn;
+    *reinterpret_cast<FARPROC*>(&prefetch_fn) = prefetch_ptr;
+
+    detail::mapped_file_memory_range range;
+    range.virtual_address = static_cast<char*>(const_cast<void*>(data_))
+      + static_cast<std::size_t>(offset);
+    range.number_of_bytes = size;
+    if (!prefetch_fn(::GetCurrentProcess(), 1, &range, 0))
+    {
+      DWORD last_error = ::GetLastError();
+      ec.assign(last_error, asio::error::get_system_category());
+    }
+  }
+
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+std::size_t mapped_file::page_size()
+{
+  SYSTEM_INFO system_info;
+  ::GetSystemInfo(&system_info);
+  return system_info.dwPageSize;
+}
+
+#else // defined(ASIO_WINDOWS)
+
+ASIO_SYNC_OP_VOID mapped_file::open(
+    const char* path, asio::error_code& ec)
+{
+  if (is_open())
+  {
+    ec = asio::error::already_open;
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  int flags = O_RDONLY;
+#if defined(O_CLOEXEC)
+  flags |= O_CLOEXEC;
+#endif // defined(O_CLOEXEC)
+  int fd = ::open(path, flags);
+  if (fd == -1)
+  {
+    ec = asio::error_code(errno, asio::error::get_system_category());
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  struct stat s;
+  if (::fstat(fd, &s) != 0)
+  {
+    ec = asio::error_code(errno, asio::error::get_system_category());
+    ::close(fd);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  if (static_cast<uint64_t>(s.st_size)
+      > (std::numeric_limits<std::size_t>::max)())
+  {
+    ec = asio::error::no_memory;
+    ::close(fd);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  // An empty file cannot be mapped.
+  void* data = 0;
+  if (s.st_size > 0)
+  {
+    data = ::mmap(0, static_cast<std::size_t>(s.st_size),
+        PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED)
+    {
+      ec = asio::error_code(errno, asio::error::get_system_category());
+      ::close(fd);
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+  }
+
+  data_ = data;
+  size_ = static_cast<std::size_t>(s.st_size);
+  handle_ = fd;
+  ec = asio::error_code();
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+ASIO_SYNC_OP_VOID mapped_file::close(asio::error_code& ec)
+{
+  ec = asio::error_code();
+  if (data_ && ::munmap(const_cast<void*>(data_), size_) != 0)
+    ec = asio::error_code(errno, asio::error::get_system_category());
+
+  if (is_open() && ::close(handle_) != 0 && !ec)
+    ec = asio::error_code(errno, asio::error::get_system_category());
+
+  data_ = 0;
+  size_ = 0;
+  handle_ = invalid_handle();
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+ASIO_SYNC_OP_VOID mapped_file::advise(advice a,
+    uint64_t offset, std::size_t size, asio::error_code& ec) const
+{
+  ec = asio::error_code();
+  if (offset >= size_ || size == 0)
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+
+  if (size > size_ - offset)
+    size = static_cast<std::size_t>(size_ - offset);
+
+  // The range passed to the operating system must begin on a page boundary.
+  std::size_t begin = static_cast<std::size_t>(offset);
+  std::size_t aligned_begin = begin - begin % page_size();
+  size += begin - aligned_begin;
+  void* addr = static_cast<char*>(const_cast<void*>(data_)) + aligned_begin;
+
+  int hint = POSIX_MADV_NORMAL;
+  switch (a)
+  {
+  case sequential: hint = POSIX_MADV_SEQUENTIAL; break;
+  case random: hint = POSIX_MADV_RANDOM; break;
+  case will_need: hint = POSIX_MADV_WILLNEED; break;
+  case dont_need: hint = POSIX_MADV_DONTNEED; break;
+  default: break;
+  }
+
+  // Unlike most functions, posix_madvise returns the error rather than
+  // setting errno.
+  int result = ::posix_madvise(addr, size, hint);
+  if (result != 0)
+    ec = asio::error_code(result, asio::error::get_system_category());
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+std::size_t mapped_file::page_size()
+{
+  return static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+}
+
+#endif // defined(ASIO_WINDOWS)
+
+void mapped_file::prefetch(uint64_t offset, std::size_t size) const
+{
+  if (offset >= size_ || size == 0)
+    return;
+
+  if (size > size_ - offset)
+    size = static_cast<std::size_t>(size_ - offset);
+
+  asio::error_code ignored_ec;
+  advise(will_need, offset, size, ignored_ec);
+
+  // Touch one byte of each page so that the thread blocks until the page has
+  // been read. The hint alone may be acted on asynchronously, or ignored.
+  std::size_t page = page_size();
+  std::size_t begin = static_cast<std::size_t>(offset);
+  std::size_t end = begin + size;
+  const volatile char* p = static_cast<const volatile char*>(data_);
+  for (std::size_t i = begin - begin % page; i < end; i += page)
+    (void)p[i];
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_MAPPED_FILE)
+
+#endif // ASIO_IMPL_MAPPED_FILE_IPP
@@ -0,0 +1,258 @@
+//
+// impl/parallel_for.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_PARALLEL_FOR_HPP
+#define ASIO_IMPL_PARALLEL_FOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <atomic>
+#include <memory>
+#include "asio/associated_allocator.hpp"
+#include "asio/associated_executor.hpp"
+#include "asio/dispatch.hpp"
+#include "asio/post.hpp"
+#include "asio/prefer.hpp"
+#include "asio/query.hpp"
+#include "asio/require.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/thread.hpp"
+#include "asio/execution/allocator.hpp"
+#include "asio/execution/blocking.hpp"
+#include "asio/execution/occupancy.hpp"
+#include "asio/execution/outstanding_work.hpp"
+#include "asio/execution/relationship.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Get the number of workers to use for an executor that reports its
+// occupancy, such as a thread_pool executor.
+template <typename Executor>
+inline std::size_t parallel_for_concurrency(const Executor& ex,
+    enable_if_t<
+      can_query<const Executor&, execution::occupancy_t>::value
+    >* = 0)
+{
+  std::size_t n = asio::query(ex, execution::occupancy);
+  return n ? n : 1;
+}
+
+// Get the number of workers to use for any other executor.
+template <typename Executor>
+inline std::size_t parallel_for_concurrency(const Executor&,
+    enable_if_t<
+      !can_query<const Executor&, execution::occupancy_t>::value
+    >* = 0)
+{
+  std::size_t n = thread::hardware_concurrency();
+  return n ? n : 1;
+}
+
+// The state shared by all workers of a parallel_for operation.
+template <typename Handler, typename Executor, typename Function>
+class parallel_for_state
+{
+public:
+  template <typename H, typename F>
+  parallel_for_state(H&& handler, const Executor& ex, F&& f,
+      std::size_t size, std::size_t chunk_size, std::size_t num_workers)
+    : handler_work_(asio::prefer(
+          (get_associated_executor)(handler, ex),
+          execution::outstanding_work.tracked)),
+      handler_(static_cast<H&&>(handler)),
+      function_(new (function_storage_) Function(static_cast<F&&>(f))),
+      size_(size),
+      chunk_size_(chunk_size),
+      next_(0),
+      workers_(num_workers),
+      failed_(false),
+      exception_()
+  {
+  }
+
+  ~parallel_for_state()
+  {
+    destroy_function();
+  }
+
+  // Claim and run chunks of indices until there are none left, then complete
+  // the operation if this is the last worker to finish.
+  void run()
+  {
+    while (!failed_.load(std::memory_order_relaxed))
+    {
+      std::size_t begin = next_.fetch_add(
+          chunk_size_, std::memory_order_relaxed);
+      if (begin >= size_)
+        break;
+      std::size_t end = (size_ - begin > chunk_size_)
+        ? begin + chunk_size_ : size_;
+
+#if !defined(ASIO_NO_EXCEPTIONS)
+      try
+      {
+#endif // !defined(ASIO_NO_EXCEPTIONS)
+        for (std::size_t i = begin; i != end; ++i)
+          (*function_)(i);
+#if !defined(ASIO_NO_EXCEPTIONS)
+      }
+      catch (...)
+      {
+        if (!failed_.exchange(true, std::memory_order_relaxed))
+          exception_ = std::current_exception();
+      }
+#endif // !defined(ASIO_NO_EXCEPTIONS)
+    }
+
+    if (workers_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      destroy_function();
+      asio::dispatch(handler_work_,
+          asio::detail::bind_handler(std::move(handler_), exception_));
+    }
+  }
+
+private:
+  void destroy_function()
+  {
+    if (function_)
+    {
+      function_->~Function();
+      function_ = 0;
+    }
+  }
+
+  // Keeps the handler's executor busy until the handler has been called.
+  decay_t<
+    prefer_result_t<associated_executor_t<Handler, Executor>,
+      execution::outstanding_work_t::tracked_t>
+  > handler_work_;
+
+  // The completion handler.
+  Handler handler_;
+
+  // The function object, which is destroyed before the handler is called.
+  alignas(Function) unsigned char function_storage_[sizeof(Function)];
+  Function* function_;
+
+  // The number of indices, and the number claimed at a time by a worker.
+  const std::size_t size_;
+  const std::size_t chunk_size_;
+
+  // The first index of the next chunk to be claimed.
+  std::atomic<std::size_t> next_;
+
+  // The number of workers that have not yet finished.
+  std::atomic<std::size_t> workers_;
+
+  // Whether the function object has thrown an exception.
+  std::atomic<bool> failed_;
+
+  // The first exception thrown by the function object.
+  std::exception_ptr exception_;
+};
+
+// A function object, submitted to the executor once for each worker.
+template <typename State>
+class parallel_for_worker
+{
+public:
+  explicit parallel_for_worker(const std::shared_ptr<State>& state)
+    : state_(state)
+  {
+  }
+
+  void operator()()
+  {
+    state_->run();
+  }
+
+private:
+  std::shared_ptr<State> state_;
+};
+
+template <typename Executor>
+class initiate_parallel_for
+{
+public:
+  typedef Executor executor_type;
+
+  explicit initiate_parallel_for(const Executor& ex)
+    : ex_(ex)
+  {
+  }
+
+  executor_type get_executor() const noexcept
+  {
+    return ex_;
+  }
+
+  template <typename Handler, typename Function>
+  void operator()(Handler&& handler, std::size_t n, Function&& f) const
+  {
+    typedef decay_t<Handler> handler_type;
+    typedef decay_t<Function> function_type;
+    typedef parallel_for_state<handler_type, Executor, function_type>
+      state_type;
+
+    if (n == 0)
+    {
+      asio::post(ex_, asio::detail::bind_handler(
+            static_cast<Handler&&>(handler), std::exception_ptr()));
+      return;
+    }
+
+    // Use several chunks per worker, so that the work remains balanced if
+    // some indices take longer than others.
+    std::size_t num_workers = (parallel_for_concurrency)(ex_);
+    std::size_t chunk_size = n / (num_workers * 4);
+    if (chunk_size == 0)
+      chunk_size = 1;
+    std::size_t num_chunks = n / chunk_size + (n % chunk_size != 0);
+    if (num_workers > num_chunks)
+      num_workers = num_chunks;
+
+    associated_allocator_t<handler_type> alloc(
+        (get_associated_allocator)(handler));
+
+    typedef typename std::allocator_traits<
+      associated_allocator_t<handler_type>>::template
+        rebind_alloc<state_type> state_allocator_type;
+
+    std::shared_ptr<state_type> state =
+      std::allocate_shared<state_type>(state_allocator_type(alloc),
+          static_cast<Handler&&>(handler), ex_,
+          static_cast<Function&&>(f), n, chunk_size, num_workers);
+
+    for (std::size_t i = 0; i < num_workers; ++i)
+    {
+      asio::prefer(
+          asio::require(ex_, execution::blocking.never),
+          execution::relationship.fork,
+          execution::allocator(alloc)
+        ).execute(parallel_for_worker<state_type>(state));
+    }
+  }
+
+private:
+  Executor ex_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_PARALLEL_FOR_HPP
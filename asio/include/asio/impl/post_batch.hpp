@@ -0,0 +1,100 @@
+//
+// impl/post_batch.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_POST_BATCH_HPP
+#define ASIO_IMPL_POST_BATCH_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <memory>
+#include <utility>
+#include "asio/execution/blocking.hpp"
+#include "asio/require.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Determine whether an executor can submit a range of function objects in a
+// single operation.
+template <typename Executor, typename Range, typename = void>
+struct has_post_batch_member : false_type
+{
+};
+
+template <typename Executor, typename Range>
+struct has_post_batch_member<Executor, Range,
+  void_t<
+    decltype(declval<const Executor&>().post_batch(declval<Range>()))
+  >> : true_type
+{
+};
+
+template <typename Executor, typename Range>
+inline void post_batch_impl(const Executor& ex, Range&& fs,
+    enable_if_t<
+      has_post_batch_member<Executor, Range>::value
+    >* = 0)
+{
+  asio::require(ex, execution::blocking.never).post_batch(
+      static_cast<Range&&>(fs));
+}
+
+template <typename Executor, typename Range>
+inline void post_batch_impl(const Executor& ex, Range&& fs,
+    enable_if_t<
+      !has_post_batch_member<Executor, Range>::value
+        && execution::is_executor<Executor>::value
+    >* = 0)
+{
+  auto ex2 = asio::require(ex, execution::blocking.never);
+  for (auto&& f : fs)
+    ex2.execute(std::move(f));
+}
+
+template <typename Executor, typename Range>
+inline void post_batch_impl(const Executor& ex, Range&& fs,
+    enable_if_t<
+      !has_post_batch_member<Executor, Range>::value
+        && !execution::is_executor<Executor>::value
+    >* = 0)
+{
+  for (auto&& f : fs)
+    ex.post(std::move(f), std::allocator<void>());
+}
+
+} // namespace detail
+
+template <typename Executor, typename Range>
+inline void post_batch(const Executor& ex, Range&& fs,
+    constraint_t<
+      execution::is_executor<Executor>::value || is_executor<Executor>::value
+    >)
+{
+  detail::post_batch_impl(ex, static_cast<Range&&>(fs));
+}
+
+template <typename ExecutionContext, typename Range>
+inline void post_batch(ExecutionContext& ctx, Range&& fs,
+    constraint_t<
+      is_convertible<ExecutionContext&, execution_context&>::value
+    >)
+{
+  detail::post_batch_impl(ctx.get_executor(), static_cast<Range&&>(fs));
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_POST_BATCH_HPP
@@ -0,0 +1,131 @@
+//
+// impl/provided_buffer_ring.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_PROVIDED_BUFFER_RING_IPP
+#define ASIO_IMPL_PROVIDED_BUFFER_RING_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+
+#include "asio/detail/throw_error.hpp"
+#include "asio/error.hpp"
+#include "asio/provided_buffer_ring.hpp"
+
+#if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+# include "asio/detail/scheduler.hpp"
+# include "asio/detail/io_uring_service.hpp"
+#endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+provided_buffer_ring::~provided_buffer_ring()
+{
+#if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  service_->unregister_buffer_ring(buf_ring_, entries_, group_id_);
+#endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  delete[] storage_;
+}
+
+void provided_buffer_ring::recycle(std::size_t id)
+{
+  detail::mutex::scoped_lock lock(mutex_);
+#if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  ::io_uring_buf_ring_add(buf_ring_, storage_ + id * buffer_size_,
+      static_cast<unsigned>(buffer_size_), static_cast<unsigned short>(id),
+      ::io_uring_buf_ring_mask(entries_), 0);
+  ::io_uring_buf_ring_advance(buf_ring_, 1);
+#else // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  free_buffers_.push_back(id);
+#endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+}
+
+bool provided_buffer_ring::acquire(std::size_t& id)
+{
+#if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  // Buffers are selected by the kernel.
+  (void)id;
+  return false;
+#else // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  detail::mutex::scoped_lock lock(mutex_);
+  if (free_buffers_.empty())
+    return false;
+  id = free_buffers_.back();
+  free_buffers_.pop_back();
+  return true;
+#endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+}
+
+void provided_buffer_ring::init(execution_context& ctx,
+    std::size_t buffer_count, std::size_t buffer_size, int group_id)
+{
+  storage_ = 0;
+  buffer_count_ = buffer_count;
+  buffer_size_ = buffer_size;
+  group_id_ = group_id;
+
+  if (buffer_count == 0 || buffer_count > 32768 || buffer_size == 0
+      || buffer_size > static_cast<unsigned>(-1) / 2 || group_id < 0
+      || group_id > 0xFFFF)
+  {
+    asio::error_code ec(asio::error::invalid_argument);
+    asio::detail::throw_error(ec, "provided_buffer_ring");
+  }
+
+#if !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  free_buffers_.reserve(buffer_count);
+#endif // !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
+  storage_ = new unsigned char[buffer_count * buffer_size];
+
+#if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  entries_ = 1;
+  while (entries_ < buffer_count)
+    entries_ <<= 1;
+
+  service_ = &use_service<detail::io_uring_service>(ctx);
+  try
+  {
+    buf_ring_ = service_->register_buffer_ring(entries_, group_id);
+  }
+  catch (...)
+  {
+    delete[] storage_;
+    throw;
+  }
+
+  int mask = ::io_uring_buf_ring_mask(entries_);
+  for (std::size_t i = 0; i < buffer_count; ++i)
+  {
+    ::io_uring_buf_ring_add(buf_ring_, storage_ + i * buffer_size,
+        static_cast<unsigned>(buffer_size), static_cast<unsigned short>(i),
+        mask, static_cast<int>(i));
+  }
+  ::io_uring_buf_ring_advance(buf_ring_, static_cast<int>(buffer_count));
+#else // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  (void)ctx;
+  for (std::size_t i = buffer_count; i > 0; --i)
+    free_buffers_.push_back(i - 1);
+#endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+
+#endif // ASIO_IMPL_PROVIDED_BUFFER_RING_IPP
@@ -35,6 +35,11 @@
 
 namespace asio {
 
+#if defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+template <typename Protocol, typename Executor>
+class basic_stream_socket;
+#endif // defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+
 namespace detail
 {
   template <typename SyncReadStream, typename MutableBufferSequence,
@@ -452,6 +457,21 @@ namespace detail
           asio::error_code(), 0, 1);
   }
 
+#if defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+  // When the buffers are to be filled from a stream socket, partial receives
+  // are continued by the socket's backend. This avoids a round trip through
+  // the scheduler for each partial transfer.
+  template <typename Protocol, typename Executor,
+      typename MutableBufferSequence, typename MutableBufferIterator,
+      typename ReadHandler>
+  inline void start_read_op(basic_stream_socket<Protocol, Executor>& stream,
+      const MutableBufferSequence& buffers, const MutableBufferIterator&,
+      transfer_all_t&, ReadHandler& handler)
+  {
+    stream.async_receive_all(buffers, static_cast<ReadHandler&&>(handler));
+  }
+#endif // defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+
   template <typename AsyncReadStream>
   class initiate_async_read
   {
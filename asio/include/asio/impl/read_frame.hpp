@@ -0,0 +1,239 @@
+//
+// impl/read_frame.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_READ_FRAME_HPP
+#define ASIO_IMPL_READ_FRAME_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <memory>
+#include "asio/associator.hpp"
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/completion_condition.hpp"
+#include "asio/detail/base_from_cancellation_state.hpp"
+#include "asio/detail/consuming_buffers.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/handler_tracking.hpp"
+#include "asio/detail/handler_type_requirements.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+namespace detail
+{
+  template <typename AsyncReadStream, typename MutableBufferSequence,
+      typename MutableBufferIterator, typename ReadHandler>
+  class read_frame_op
+    : public base_from_cancellation_state<ReadHandler>
+  {
+  public:
+    typedef basic_waitable_timer<std::chrono::steady_clock,
+      wait_traits<std::chrono::steady_clock>,
+      typename AsyncReadStream::executor_type> timer_type;
+
+    read_frame_op(AsyncReadStream& stream,
+        const MutableBufferSequence& buffers,
+        const std::chrono::steady_clock::duration& gap, ReadHandler& handler)
+      : base_from_cancellation_state<ReadHandler>(handler),
+        stream_(stream),
+        buffers_(buffers),
+        gap_(gap),
+        start_(0),
+        handler_(static_cast<ReadHandler&&>(handler))
+    {
+    }
+
+    read_frame_op(read_frame_op&& other)
+      : base_from_cancellation_state<ReadHandler>(
+          static_cast<base_from_cancellation_state<ReadHandler>&&>(other)),
+        stream_(other.stream_),
+        buffers_(static_cast<buffers_type&&>(other.buffers_)),
+        gap_(other.gap_),
+        timer_(static_cast<std::unique_ptr<timer_type>&&>(other.timer_)),
+        start_(other.start_),
+        handler_(static_cast<ReadHandler&&>(other.handler_))
+    {
+    }
+
+    // Called when a read completes. The first read waits for the start of a
+    // frame, and subsequent reads collect the data that arrived during a gap.
+    void operator()(asio::error_code ec,
+        std::size_t bytes_transferred, int start = 0)
+    {
+      switch (start_ = start)
+      {
+        case 1:
+        {
+          ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_read_frame"));
+          stream_.async_read_some(
+              buffers_.prepare(default_max_transfer_size),
+              static_cast<read_frame_op&&>(*this));
+        }
+        return; default:
+        buffers_.consume(bytes_transferred);
+        if (ec || bytes_transferred == 0 || buffers_.empty())
+          break;
+        if (this->cancelled() != cancellation_type::none)
+        {
+          ec = error::operation_aborted;
+          break;
+        }
+
+        // Wait to see whether more data arrives within the gap.
+        if (!timer_.get())
+          timer_.reset(new timer_type(stream_.get_executor()));
+        timer_->expires_after(gap_);
+        {
+          ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_read_frame"));
+          timer_->async_wait(static_cast<read_frame_op&&>(*this));
+        }
+        return;
+      }
+
+      complete(ec);
+    }
+
+    // Called when a gap has elapsed.
+    void operator()(asio::error_code ec)
+    {
+      start_ = 0;
+      std::size_t available = 0;
+      if (!ec && this->cancelled() != cancellation_type::none)
+        ec = error::operation_aborted;
+      if (!ec)
+        available = stream_.available(ec);
+
+      if (ec || available == 0)
+      {
+        complete(ec);
+        return;
+      }
+
+      ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_read_frame"));
+      stream_.async_read_some(buffers_.prepare(available),
+          static_cast<read_frame_op&&>(*this));
+    }
+
+  //private:
+    typedef asio::detail::consuming_buffers<mutable_buffer,
+        MutableBufferSequence, MutableBufferIterator> buffers_type;
+
+    void complete(const asio::error_code& ec)
+    {
+      timer_.reset();
+      static_cast<ReadHandler&&>(handler_)(ec,
+          static_cast<const std::size_t&>(buffers_.total_consumed()));
+    }
+
+    AsyncReadStream& stream_;
+    buffers_type buffers_;
+    std::chrono::steady_clock::duration gap_;
+    std::unique_ptr<timer_type> timer_;
+    int start_;
+    ReadHandler handler_;
+  };
+
+  template <typename AsyncReadStream, typename MutableBufferSequence,
+      typename MutableBufferIterator, typename ReadHandler>
+  inline bool asio_handler_is_continuation(
+      read_frame_op<AsyncReadStream, MutableBufferSequence,
+        MutableBufferIterator, ReadHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename AsyncReadStream, typename MutableBufferSequence,
+      typename MutableBufferIterator, typename ReadHandler>
+  inline void start_read_frame_op(AsyncReadStream& stream,
+      const MutableBufferSequence& buffers, const MutableBufferIterator&,
+      const std::chrono::steady_clock::duration& gap, ReadHandler& handler)
+  {
+    read_frame_op<AsyncReadStream, MutableBufferSequence,
+      MutableBufferIterator, ReadHandler>(
+        stream, buffers, gap, handler)(asio::error_code(), 0, 1);
+  }
+
+  template <typename AsyncReadStream>
+  class initiate_async_read_frame
+  {
+  public:
+    typedef typename AsyncReadStream::executor_type executor_type;
+
+    explicit initiate_async_read_frame(AsyncReadStream& stream)
+      : stream_(stream)
+    {
+    }
+
+    executor_type get_executor() const noexcept
+    {
+      return stream_.get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ReadHandler&& handler,
+        const MutableBufferSequence& buffers,
+        const std::chrono::steady_clock::duration& gap) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      non_const_lvalue<ReadHandler> handler2(handler);
+      start_read_frame_op(stream_, buffers,
+          asio::buffer_sequence_begin(buffers), gap, handler2.value);
+    }
+
+  private:
+    AsyncReadStream& stream_;
+  };
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <template <typename, typename> class Associator,
+    typename AsyncReadStream, typename MutableBufferSequence,
+    typename MutableBufferIterator, typename ReadHandler,
+    typename DefaultCandidate>
+struct associator<Associator,
+    detail::read_frame_op<AsyncReadStream, MutableBufferSequence,
+      MutableBufferIterator, ReadHandler>,
+    DefaultCandidate>
+  : Associator<ReadHandler, DefaultCandidate>
+{
+  static typename Associator<ReadHandler, DefaultCandidate>::type get(
+      const detail::read_frame_op<AsyncReadStream, MutableBufferSequence,
+        MutableBufferIterator, ReadHandler>& h) noexcept
+  {
+    return Associator<ReadHandler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static auto get(
+      const detail::read_frame_op<AsyncReadStream, MutableBufferSequence,
+        MutableBufferIterator, ReadHandler>& h,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<ReadHandler, DefaultCandidate>::get(h.handler_, c))
+  {
+    return Associator<ReadHandler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_READ_FRAME_HPP
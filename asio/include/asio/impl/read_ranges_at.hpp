@@ -0,0 +1,437 @@
+//
+// impl/read_ranges_at.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_READ_RANGES_AT_HPP
+#define ASIO_IMPL_READ_RANGES_AT_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <algorithm>
+#include <new>
+#include "asio/associated_allocator.hpp"
+#include "asio/buffer.hpp"
+#include "asio/cancellation_type.hpp"
+#include "asio/immediate.hpp"
+#include "asio/recycling_allocator.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Determines whether a device can start a batch of reads.
+template <typename Device, typename = void>
+struct read_ranges_has_batch : false_type
+{
+};
+
+template <typename Device>
+struct read_ranges_has_batch<Device,
+    void_t<decltype(declval<Device&>().async_read_batch_at(
+      declval<file_base::read_request*>(), std::size_t(),
+      declval<void (*)(asio::error_code, std::size_t)>()))>>
+  : true_type
+{
+};
+
+// A set of adjacent ranges that are read as one.
+struct read_ranges_segment
+{
+  read_ranges_segment()
+    : index(0),
+      offset(0),
+      bytes_transferred(0),
+      first(0),
+      count(0)
+  {
+  }
+
+  // Whether the segment is complete.
+  bool finished() const
+  {
+    return !!error || bytes_transferred == buffer.size();
+  }
+
+  // The index of a request. The requests are visited in order of offset.
+  std::size_t index;
+
+  // The range to be read.
+  uint64_t offset;
+  mutable_buffer buffer;
+
+  // The result of reading the range.
+  std::size_t bytes_transferred;
+  asio::error_code error;
+
+  // The position and number of the requests that make up the segment.
+  std::size_t first;
+  std::size_t count;
+};
+
+// The storage used by a read_ranges_at_op. The segments and the batch of
+// reads in progress immediately follow the derived object that records the
+// allocator.
+class read_ranges_state
+  : private noncopyable
+{
+public:
+  read_ranges_segment* segments()
+  {
+    return segments_;
+  }
+
+  file_base::read_request* pending()
+  {
+    return pending_;
+  }
+
+  read_ranges_segment* segments_;
+  file_base::read_request* pending_;
+  std::size_t count_;
+  void (*destroy_)(read_ranges_state*);
+};
+
+template <typename Allocator>
+class read_ranges_state_impl : public read_ranges_state
+{
+public:
+  typedef typename std::allocator_traits<Allocator>::template
+    rebind_alloc<read_ranges_segment> allocator_type;
+
+  static read_ranges_state* create(const Allocator& a, std::size_t count)
+  {
+    allocator_type alloc(a);
+    std::size_t len = units(sizeof(read_ranges_state_impl)) + count
+      + units(count * sizeof(file_base::read_request));
+    read_ranges_segment* p = alloc.allocate(len);
+    read_ranges_state_impl* state = new (p) read_ranges_state_impl(a, len);
+    state->segments_ = p + units(sizeof(read_ranges_state_impl));
+    state->pending_ = reinterpret_cast<file_base::read_request*>(
+        state->segments_ + count);
+    state->count_ = count;
+    state->destroy_ = &read_ranges_state_impl::do_destroy;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      new (state->segments() + i) read_ranges_segment;
+      new (state->pending() + i) file_base::read_request;
+    }
+    return state;
+  }
+
+private:
+  read_ranges_state_impl(const Allocator& a, std::size_t len)
+    : allocator_(a),
+      length_(len)
+  {
+  }
+
+  static std::size_t units(std::size_t n)
+  {
+    return (n + sizeof(read_ranges_segment) - 1) / sizeof(read_ranges_segment);
+  }
+
+  static void do_destroy(read_ranges_state* base)
+  {
+    read_ranges_state_impl* state = static_cast<read_ranges_state_impl*>(base);
+    for (std::size_t i = 0; i < state->count_; ++i)
+    {
+      state->segments()[i].~read_ranges_segment();
+      state->pending()[i].~read_request();
+    }
+    allocator_type alloc(state->allocator_);
+    std::size_t len = state->length_;
+    state->~read_ranges_state_impl();
+    alloc.deallocate(reinterpret_cast<read_ranges_segment*>(state), len);
+  }
+
+  Allocator allocator_;
+  std::size_t length_;
+};
+
+// Owns a read_ranges_state.
+class read_ranges_state_ptr
+{
+public:
+  read_ranges_state_ptr() noexcept
+    : p_(0)
+  {
+  }
+
+  read_ranges_state_ptr(read_ranges_state_ptr&& other) noexcept
+    : p_(other.p_)
+  {
+    other.p_ = 0;
+  }
+
+  ~read_ranges_state_ptr()
+  {
+    reset();
+  }
+
+  template <typename Allocator>
+  void reset(const Allocator& a, std::size_t count)
+  {
+    reset();
+    p_ = read_ranges_state_impl<Allocator>::create(a, count);
+  }
+
+  void reset() noexcept
+  {
+    if (p_)
+      p_->destroy_(p_);
+    p_ = 0;
+  }
+
+  read_ranges_state* operator->() const noexcept
+  {
+    return p_;
+  }
+
+private:
+  read_ranges_state_ptr(const read_ranges_state_ptr&) = delete;
+  read_ranges_state_ptr& operator=(const read_ranges_state_ptr&) = delete;
+
+  read_ranges_state* p_;
+};
+
+template <typename AsyncRandomAccessReadDevice>
+class read_ranges_at_op
+{
+public:
+  read_ranges_at_op(AsyncRandomAccessReadDevice& device,
+      file_base::read_request* requests, std::size_t count)
+    : device_(device),
+      requests_(requests),
+      count_(count),
+      num_segments_(0),
+      next_(0),
+      state_(starting)
+  {
+  }
+
+  template <typename Self>
+  void operator()(Self& self,
+      asio::error_code ec = asio::error_code(), std::size_t n = 0)
+  {
+    switch (state_)
+    {
+    case starting:
+      if (count_ > 0)
+      {
+        storage_.reset(asio::get_associated_allocator(self,
+              recycling_allocator<void>()), count_);
+        make_segments();
+        if (start_reads(self))
+          return;
+      }
+      state_ = finishing;
+      asio::async_immediate(device_.get_executor(), static_cast<Self&&>(self));
+      return;
+
+    case reading_batch:
+      {
+        file_base::read_request* pending = storage_->pending();
+        for (std::size_t i = 0, j = 0; i < num_segments_; ++i)
+        {
+          read_ranges_segment& segment = storage_->segments()[i];
+          if (!segment.finished())
+          {
+            segment.bytes_transferred += pending[j].bytes_transferred;
+            segment.error = pending[j].error;
+            if (!segment.error && pending[j].bytes_transferred == 0
+                && !segment.finished())
+              segment.error = asio::error::eof;
+            ++j;
+          }
+        }
+      }
+      if (start_reads(self))
+        return;
+      break;
+
+    case reading_one:
+      {
+        read_ranges_segment& segment = storage_->segments()[next_];
+        segment.bytes_transferred += n;
+        segment.error = ec;
+        if (!ec && n == 0 && !segment.finished())
+          segment.error = asio::error::eof;
+      }
+      if (start_reads(self))
+        return;
+      break;
+
+    default:
+      break;
+    }
+
+    finish(self);
+  }
+
+private:
+  enum state { starting, reading_batch, reading_one, finishing };
+
+  // Sort the requests by offset, and merge those that are adjacent both in
+  // the device and in memory.
+  void make_segments()
+  {
+    read_ranges_segment* segments = storage_->segments();
+    for (std::size_t i = 0; i < count_; ++i)
+      segments[i].index = i;
+
+    const file_base::read_request* requests = requests_;
+    std::sort(segments, segments + count_,
+        [requests](const read_ranges_segment& a, const read_ranges_segment& b)
+        {
+          return requests[a.index].offset < requests[b.index].offset;
+        });
+
+    num_segments_ = 0;
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+      const file_base::read_request& request = requests_[segments[i].index];
+      if (num_segments_ > 0)
+      {
+        read_ranges_segment& last = segments[num_segments_ - 1];
+        if (last.offset + last.buffer.size() == request.offset
+            && static_cast<char*>(last.buffer.data())
+              + last.buffer.size() == request.buffer.data())
+        {
+          last.buffer = mutable_buffer(last.buffer.data(),
+              last.buffer.size() + request.buffer.size());
+          ++last.count;
+          continue;
+        }
+      }
+
+      read_ranges_segment& segment = segments[num_segments_++];
+      segment.offset = request.offset;
+      segment.buffer = request.buffer;
+      segment.first = i;
+      segment.count = 1;
+    }
+  }
+
+  // Start reading the segments that are not yet complete. Returns false if
+  // there are none.
+  template <typename Self>
+  bool start_reads(Self& self)
+  {
+    if (self.cancelled() != cancellation_type::none)
+    {
+      for (std::size_t i = 0; i < num_segments_; ++i)
+      {
+        read_ranges_segment& segment = storage_->segments()[i];
+        if (!segment.finished())
+          segment.error = asio::error::operation_aborted;
+      }
+      return false;
+    }
+
+    return start_reads(self, read_ranges_has_batch<
+        AsyncRandomAccessReadDevice>());
+  }
+
+  template <typename Self>
+  bool start_reads(Self& self, true_type)
+  {
+    file_base::read_request* pending = storage_->pending();
+    std::size_t num_pending = 0;
+    for (std::size_t i = 0; i < num_segments_; ++i)
+    {
+      read_ranges_segment& segment = storage_->segments()[i];
+      if (!segment.finished())
+      {
+        pending[num_pending++] = file_base::read_request(
+            segment.offset + segment.bytes_transferred,
+            segment.buffer + segment.bytes_transferred);
+      }
+    }
+
+    if (num_pending == 0)
+      return false;
+
+    state_ = reading_batch;
+    device_.async_read_batch_at(pending, num_pending,
+        static_cast<Self&&>(self));
+    return true;
+  }
+
+  template <typename Self>
+  bool start_reads(Self& self, false_type)
+  {
+    while (next_ < num_segments_ && storage_->segments()[next_].finished())
+      ++next_;
+
+    if (next_ == num_segments_)
+      return false;
+
+    read_ranges_segment& segment = storage_->segments()[next_];
+    state_ = reading_one;
+    device_.async_read_some_at(segment.offset + segment.bytes_transferred,
+        segment.buffer + segment.bytes_transferred,
+        static_cast<Self&&>(self));
+    return true;
+  }
+
+  // Pass the results of the segments back to the requests.
+  template <typename Self>
+  void finish(Self& self)
+  {
+    asio::error_code ec;
+    std::size_t ec_index = count_;
+    std::size_t total_transferred = 0;
+    for (std::size_t i = 0; i < num_segments_; ++i)
+    {
+      const read_ranges_segment& segment = storage_->segments()[i];
+      std::size_t position = 0;
+      for (std::size_t j = 0; j < segment.count; ++j)
+      {
+        std::size_t index = storage_->segments()[segment.first + j].index;
+        file_base::read_request& request = requests_[index];
+        std::size_t size = request.buffer.size();
+        std::size_t n = segment.bytes_transferred > position
+          ? (std::min)(size, segment.bytes_transferred - position) : 0;
+        request.bytes_transferred = n;
+        request.error = n < size ? segment.error : asio::error_code();
+        total_transferred += n;
+        position += size;
+        if (request.error && index < ec_index)
+        {
+          ec = request.error;
+          ec_index = index;
+        }
+      }
+    }
+
+    storage_.reset();
+    self.complete(ec, total_transferred);
+  }
+
+  AsyncRandomAccessReadDevice& device_;
+  file_base::read_request* requests_;
+  std::size_t count_;
+  std::size_t num_segments_;
+  std::size_t next_;
+  state state_;
+  read_ranges_state_ptr storage_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_READ_RANGES_AT_HPP
@@ -24,6 +24,7 @@
 #include "asio/buffers_iterator.hpp"
 #include "asio/detail/base_from_cancellation_state.hpp"
 #include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_search.hpp"
 #include "asio/detail/handler_cont_helpers.hpp"
 #include "asio/detail/handler_tracking.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
@@ -37,38 +38,6 @@ namespace asio {
 
 namespace detail
 {
-  // Algorithm that finds a subsequence of equal values in a sequence. Returns
-  // (iterator,true) if a full match was found, in which case the iterator
-  // points to the beginning of the match. Returns (iterator,false) if a
-  // partial match was found at the end of the first sequence, in which case
-  // the iterator points to the beginning of the partial match. Returns
-  // (last1,false) if no full or partial match was found.
-  template <typename Iterator1, typename Iterator2>
-  std::pair<Iterator1, bool> partial_search(
-      Iterator1 first1, Iterator1 last1, Iterator2 first2, Iterator2 last2)
-  {
-    for (Iterator1 iter1 = first1; iter1 != last1; ++iter1)
-    {
-      Iterator1 test_iter1 = iter1;
-      Iterator2 test_iter2 = first2;
-      for (;; ++test_iter1, ++test_iter2)
-      {
-        if (test_iter2 == last2)
-          return std::make_pair(iter1, true);
-        if (test_iter1 == last1)
-        {
-          if (test_iter2 != first2)
-            return std::make_pair(iter1, false);
-          else
-            break;
-        }
-        if (*test_iter1 != *test_iter2)
-          break;
-      }
-    }
-    return std::make_pair(last1, false);
-  }
-
 #if !defined(ASIO_NO_EXTENSIONS)
 #if defined(ASIO_HAS_BOOST_REGEX)
   struct regex_match_flags
@@ -121,24 +90,22 @@ std::size_t read_until(SyncReadStream& s,
   {
     // Determine the range of the data to be searched.
     typedef typename DynamicBuffer_v1::const_buffers_type buffers_type;
-    typedef buffers_iterator<buffers_type> iterator;
     buffers_type data_buffers = b.data();
-    iterator begin = iterator::begin(data_buffers);
-    iterator start_pos = begin + search_position;
-    iterator end = iterator::end(data_buffers);
+    std::size_t end = b.size();
 
     // Look for a match.
-    iterator iter = std::find(start_pos, end, delim);
-    if (iter != end)
+    std::size_t match = detail::buffer_find(
+        data_buffers, search_position, delim);
+    if (match != end)
     {
       // Found a match. We're done.
       ec = asio::error_code();
-      return iter - begin + 1;
+      return match + 1;
     }
     else
     {
       // No match. Next search can start with the new data.
-      search_position = end - begin;
+      search_position = end;
     }
 
     // Check if buffer is full.
@@ -195,33 +162,31 @@ std::size_t read_until(SyncReadStream& s,
   {
     // Determine the range of the data to be searched.
     typedef typename DynamicBuffer_v1::const_buffers_type buffers_type;
-    typedef buffers_iterator<buffers_type> iterator;
     buffers_type data_buffers = b.data();
-    iterator begin = iterator::begin(data_buffers);
-    iterator start_pos = begin + search_position;
-    iterator end = iterator::end(data_buffers);
+    std::size_t end = b.size();
 
     // Look for a match.
-    std::pair<iterator, bool> result = detail::partial_search(
-        start_pos, end, delim.begin(), delim.end());
+    std::pair<std::size_t, bool> result =
+      detail::buffer_partial_search(data_buffers,
+          search_position, delim.data(), delim.length());
     if (result.first != end)
     {
       if (result.second)
       {
         // Full match. We're done.
         ec = asio::error_code();
-        return result.first - begin + delim.length();
+        return result.first + delim.length();
       }
       else
       {
         // Partial match. Next search needs to start from beginning of match.
-        search_position = result.first - begin;
+        search_position = result.first;
       }
     }
     else
     {
       // No match. Next search can start with the new data.
-      search_position = end - begin;
+      search_position = end;
     }
 
     // Check if buffer is full.
@@ -520,25 +485,23 @@ std::size_t read_until(SyncReadStream& s, DynamicBuffer_v2 buffers,
   {
     // Determine the range of the data to be searched.
     typedef typename DynamicBuffer_v2::const_buffers_type buffers_type;
-    typedef buffers_iterator<buffers_type> iterator;
     buffers_type data_buffers =
       const_cast<const DynamicBuffer_v2&>(b).data(0, b.size());
-    iterator begin = iterator::begin(data_buffers);
-    iterator start_pos = begin + search_position;
-    iterator end = iterator::end(data_buffers);
+    std::size_t end = b.size();
 
     // Look for a match.
-    iterator iter = std::find(start_pos, end, delim);
-    if (iter != end)
+    std::size_t match = detail::buffer_find(
+        data_buffers, search_position, delim);
+    if (match != end)
     {
       // Found a match. We're done.
       ec = asio::error_code();
-      return iter - begin + 1;
+      return match + 1;
     }
     else
     {
       // No match. Next search can start with the new data.
-      search_position = end - begin;
+      search_position = end;
     }
 
     // Check if buffer is full.
@@ -589,34 +552,32 @@ std::size_t read_until(SyncReadStream& s, DynamicBuffer_v2 buffers,
   {
     // Determine the range of the data to be searched.
     typedef typename DynamicBuffer_v2::const_buffers_type buffers_type;
-    typedef buffers_iterator<buffers_type> iterator;
     buffers_type data_buffers =
       const_cast<const DynamicBuffer_v2&>(b).data(0, b.size());
-    iterator begin = iterator::begin(data_buffers);
-    iterator start_pos = begin + search_position;
-    iterator end = iterator::end(data_buffers);
+    std::size_t end = b.size();
 
     // Look for a match.
-    std::pair<iterator, bool> result = detail::partial_search(
-        start_pos, end, delim.begin(), delim.end());
+    std::pair<std::size_t, bool> result =
+      detail::buffer_partial_search(data_buffers,
+          search_position, delim.data(), delim.length());
     if (result.first != end)
     {
       if (result.second)
       {
         // Full match. We're done.
         ec = asio::error_code();
-        return result.first - begin + delim.length();
+        return result.first + delim.length();
       }
       else
       {
         // Partial match. Next search needs to start from beginning of match.
-        search_position = result.first - begin;
+        search_position = result.first;
       }
     }
     else
     {
       // No match. Next search can start with the new data.
-      search_position = end - begin;
+      search_position = end;
     }
 
     // Check if buffer is full.
@@ -871,18 +832,16 @@ namespace detail
             // Determine the range of the data to be searched.
             typedef typename DynamicBuffer_v1::const_buffers_type
               buffers_type;
-            typedef buffers_iterator<buffers_type> iterator;
             buffers_type data_buffers = buffers_.data();
-            iterator begin = iterator::begin(data_buffers);
-            iterator start_pos = begin + search_position_;
-            iterator end = iterator::end(data_buffers);
+            std::size_t end = buffers_.size();
 
             // Look for a match.
-            iterator iter = std::find(start_pos, end, delim_);
-            if (iter != end)
+            std::size_t match = detail::buffer_find(
+                data_buffers, search_position_, delim_);
+            if (match != end)
             {
               // Found a match. We're done.
-              search_position_ = iter - begin + 1;
+              search_position_ = match + 1;
               bytes_to_read = 0;
             }
 
@@ -897,7 +856,7 @@ namespace detail
             else
             {
               // Next search can start with the new data.
-              search_position_ = end - begin;
+              search_position_ = end;
               bytes_to_read = std::min<std::size_t>(
                     std::max<std::size_t>(512,
                       buffers_.capacity() - buffers_.size()),
@@ -1088,19 +1047,17 @@ namespace detail
             // Determine the range of the data to be searched.
             typedef typename DynamicBuffer_v1::const_buffers_type
               buffers_type;
-            typedef buffers_iterator<buffers_type> iterator;
             buffers_type data_buffers = buffers_.data();
-            iterator begin = iterator::begin(data_buffers);
-            iterator start_pos = begin + search_position_;
-            iterator end = iterator::end(data_buffers);
+            std::size_t end = buffers_.size();
 
             // Look for a match.
-            std::pair<iterator, bool> result = detail::partial_search(
-                start_pos, end, delim_.begin(), delim_.end());
+            std::pair<std::size_t, bool> result =
+              detail::buffer_partial_search(data_buffers,
+                  search_position_, delim_.data(), delim_.length());
             if (result.first != end && result.second)
             {
               // Full match. We're done.
-              search_position_ = result.first - begin + delim_.length();
+              search_position_ = result.first + delim_.length();
               bytes_to_read = 0;
             }
 
@@ -1118,12 +1075,12 @@ namespace detail
               {
                 // Partial match. Next search needs to start from beginning of
                 // match.
-                search_position_ = result.first - begin;
+                search_position_ = result.first;
               }
               else
               {
                 // Next search can start with the new data.
-                search_position_ = end - begin;
+                search_position_ = end;
               }
 
               bytes_to_read = std::min<std::size_t>(
@@ -1784,20 +1741,18 @@ namespace detail
             // Determine the range of the data to be searched.
             typedef typename DynamicBuffer_v2::const_buffers_type
               buffers_type;
-            typedef buffers_iterator<buffers_type> iterator;
             buffers_type data_buffers =
               const_cast<const DynamicBuffer_v2&>(buffers_).data(
                   0, buffers_.size());
-            iterator begin = iterator::begin(data_buffers);
-            iterator start_pos = begin + search_position_;
-            iterator end = iterator::end(data_buffers);
+            std::size_t end = buffers_.size();
 
             // Look for a match.
-            iterator iter = std::find(start_pos, end, delim_);
-            if (iter != end)
+            std::size_t match = detail::buffer_find(
+                data_buffers, search_position_, delim_);
+            if (match != end)
             {
               // Found a match. We're done.
-              search_position_ = iter - begin + 1;
+              search_position_ = match + 1;
               bytes_to_read_ = 0;
             }
 
@@ -1812,7 +1767,7 @@ namespace detail
             else
             {
               // Next search can start with the new data.
-              search_position_ = end - begin;
+              search_position_ = end;
               bytes_to_read_ = std::min<std::size_t>(
                     std::max<std::size_t>(512,
                       buffers_.capacity() - buffers_.size()),
@@ -2008,21 +1963,19 @@ namespace detail
             // Determine the range of the data to be searched.
             typedef typename DynamicBuffer_v2::const_buffers_type
               buffers_type;
-            typedef buffers_iterator<buffers_type> iterator;
             buffers_type data_buffers =
               const_cast<const DynamicBuffer_v2&>(buffers_).data(
                   0, buffers_.size());
-            iterator begin = iterator::begin(data_buffers);
-            iterator start_pos = begin + search_position_;
-            iterator end = iterator::end(data_buffers);
+            std::size_t end = buffers_.size();
 
             // Look for a match.
-            std::pair<iterator, bool> result = detail::partial_search(
-                start_pos, end, delim_.begin(), delim_.end());
+            std::pair<std::size_t, bool> result =
+              detail::buffer_partial_search(data_buffers,
+                  search_position_, delim_.data(), delim_.length());
             if (result.first != end && result.second)
             {
               // Full match. We're done.
-              search_position_ = result.first - begin + delim_.length();
+              search_position_ = result.first + delim_.length();
               bytes_to_read_ = 0;
             }
 
@@ -2040,12 +1993,12 @@ namespace detail
               {
                 // Partial match. Next search needs to start from beginning of
                 // match.
-                search_position_ = result.first - begin;
+                search_position_ = result.first;
               }
               else
               {
                 // Next search can start with the new data.
-                search_position_ = end - begin;
+                search_position_ = end;
               }
 
               bytes_to_read_ = std::min<std::size_t>(
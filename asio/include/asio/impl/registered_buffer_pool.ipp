@@ -0,0 +1,227 @@
+//
+// impl/registered_buffer_pool.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_REGISTERED_BUFFER_POOL_IPP
+#define ASIO_IMPL_REGISTERED_BUFFER_POOL_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <functional>
+#include <thread>
+#include "asio/config.hpp"
+#include "asio/detail/huge_page_arena.hpp"
+#include "asio/detail/memory_metrics_service.hpp"
+#include "asio/detail/thread.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/error.hpp"
+#include "asio/registered_buffer_pool.hpp"
+
+#if defined(ASIO_HAS_IO_URING)
+# include "asio/detail/scheduler.hpp"
+# include "asio/detail/io_uring_service.hpp"
+#endif // defined(ASIO_HAS_IO_URING)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+registered_buffer_pool::~registered_buffer_pool()
+{
+#if defined(ASIO_HAS_IO_URING)
+  if (service_)
+    service_->unregister_buffers();
+#endif // defined(ASIO_HAS_IO_URING)
+  for (std::size_t i = 0; i < lists_.size(); ++i)
+    delete lists_[i];
+  free_storage();
+}
+
+std::size_t registered_buffer_pool::available() const
+{
+  std::size_t n = 0;
+  for (std::size_t i = 0; i < lists_.size(); ++i)
+  {
+    detail::mutex::scoped_lock lock(lists_[i]->mutex_);
+    n += lists_[i]->size_;
+  }
+  return n;
+}
+
+mutable_registered_buffer registered_buffer_pool::acquire()
+{
+  asio::error_code ec;
+  mutable_registered_buffer b = acquire(ec);
+  asio::detail::throw_error(ec, "acquire");
+  return b;
+}
+
+mutable_registered_buffer registered_buffer_pool::acquire(
+    asio::error_code& ec)
+{
+  // Try the calling thread's list first, then take from the others in turn.
+  std::size_t first = this_thread_list();
+  for (std::size_t i = 0; i < lists_.size(); ++i)
+  {
+    free_list& list = *lists_[(first + i) % lists_.size()];
+    detail::mutex::scoped_lock lock(list.mutex_);
+    if (list.head_ != end_of_list)
+    {
+      std::size_t index = static_cast<std::size_t>(list.head_);
+      list.head_ = next_[index];
+      --list.size_;
+      ec.assign(0, ec.category());
+      return make_block(index);
+    }
+  }
+
+  ec = asio::error::no_buffer_space;
+  return mutable_registered_buffer();
+}
+
+void registered_buffer_pool::release(const mutable_registered_buffer& b)
+{
+  std::size_t index = static_cast<std::size_t>(
+      static_cast<unsigned char*>(b.data()) - storage_) / block_size_;
+
+  free_list& list = *lists_[this_thread_list()];
+  detail::mutex::scoped_lock lock(list.mutex_);
+  next_[index] = list.head_;
+  list.head_ = static_cast<int>(index);
+  ++list.size_;
+}
+
+void registered_buffer_pool::init(execution_context& ctx,
+    std::size_t block_count, std::size_t block_size)
+{
+  storage_ = 0;
+  block_count_ = block_count;
+  block_size_ = block_size;
+  scope_ = &ctx;
+  memory_metrics_ = 0;
+#if defined(ASIO_HAS_IO_URING)
+  service_ = 0;
+#endif // defined(ASIO_HAS_IO_URING)
+
+  if (block_count == 0 || block_count > 16384 || block_size == 0
+      || block_size > static_cast<std::size_t>(-1) / block_count)
+  {
+    asio::error_code ec(asio::error::invalid_argument);
+    asio::detail::throw_error(ec, "registered_buffer_pool");
+  }
+
+  std::size_t list_count = detail::thread::hardware_concurrency();
+  if (list_count == 0)
+    list_count = 1;
+  else if (list_count > block_count)
+    list_count = block_count;
+
+  next_.resize(block_count);
+  lists_.reserve(list_count);
+  try
+  {
+    for (std::size_t i = 0; i < list_count; ++i)
+      lists_.push_back(new free_list);
+#if defined(ASIO_HAS_HUGE_PAGES)
+    if (detail::huge_page_arena* arena = detail::huge_page_arena::get(
+          config(ctx).get("memory", "huge_pages", 0)))
+      storage_ = static_cast<unsigned char*>(
+          arena->allocate(block_count * block_size));
+    if (!storage_)
+#endif // defined(ASIO_HAS_HUGE_PAGES)
+    storage_ = new unsigned char[block_count * block_size];
+  }
+  catch (...)
+  {
+    for (std::size_t i = 0; i < lists_.size(); ++i)
+      delete lists_[i];
+    throw;
+  }
+
+  // Deal the blocks out across the free lists, so that each list starts with
+  // a contiguous range of blocks.
+  std::size_t per_list = block_count / list_count;
+  for (std::size_t i = 0, index = 0; i < list_count; ++i)
+  {
+    std::size_t n = per_list + (i < block_count % list_count ? 1 : 0);
+    lists_[i]->head_ = static_cast<int>(index);
+    lists_[i]->size_ = n;
+    for (std::size_t j = 1; j < n; ++j, ++index)
+      next_[index] = static_cast<int>(index + 1);
+    next_[index++] = end_of_list;
+  }
+
+  memory_metrics_ = detail::memory_metrics_service::get(ctx);
+  if (memory_metrics_)
+  {
+    memory_metrics_->record_allocation(detail::memory_metrics::
+        registered_buffer_memory, block_count * block_size, false);
+  }
+
+#if defined(ASIO_HAS_IO_URING)
+  try
+  {
+    std::vector<iovec> iovecs(block_count);
+    for (std::size_t i = 0; i < block_count; ++i)
+    {
+      iovecs[i].iov_base = storage_ + i * block_size;
+      iovecs[i].iov_len = block_size;
+    }
+
+    detail::io_uring_service* service =
+      &use_service<detail::io_uring_service>(ctx);
+    service->register_buffers(&iovecs[0],
+        static_cast<unsigned>(iovecs.size()));
+    service_ = service;
+  }
+  catch (...)
+  {
+    for (std::size_t i = 0; i < lists_.size(); ++i)
+      delete lists_[i];
+    free_storage();
+    throw;
+  }
+#endif // defined(ASIO_HAS_IO_URING)
+}
+
+void registered_buffer_pool::free_storage()
+{
+  if (memory_metrics_)
+  {
+    memory_metrics_->record_deallocation(detail::memory_metrics::
+        registered_buffer_memory, block_count_ * block_size_);
+    memory_metrics_ = 0;
+  }
+
+#if defined(ASIO_HAS_HUGE_PAGES)
+  if (detail::huge_page_arena::contains(storage_))
+  {
+    detail::huge_page_arena::deallocate(storage_);
+    return;
+  }
+#endif // defined(ASIO_HAS_HUGE_PAGES)
+  delete[] storage_;
+}
+
+std::size_t registered_buffer_pool::this_thread_list() const
+{
+  if (lists_.size() == 1)
+    return 0;
+  return std::hash<std::thread::id>()(std::this_thread::get_id())
+    % lists_.size();
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_REGISTERED_BUFFER_POOL_IPP
@@ -0,0 +1,518 @@
+//
+// impl/relay.hpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_RELAY_HPP
+#define ASIO_IMPL_RELAY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <array>
+#include <new>
+#include "asio/associated_allocator.hpp"
+#include "asio/basic_stream_socket.hpp"
+#include "asio/buffer.hpp"
+#include "asio/cancellation_type.hpp"
+#include "asio/deferred.hpp"
+#include "asio/immediate.hpp"
+#include "asio/recycling_allocator.hpp"
+#include "asio/socket_base.hpp"
+#include "asio/write.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/experimental/parallel_group.hpp"
+#if defined(ASIO_HAS_SPLICE)
+# include "asio/connect_pipe.hpp"
+# include "asio/readable_pipe.hpp"
+# include "asio/splice.hpp"
+# include "asio/writable_pipe.hpp"
+#endif // defined(ASIO_HAS_SPLICE)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Shuts down the sending side of a stream that provides a socket-style
+// shutdown member function.
+template <typename Stream, typename = void>
+struct relay_shutdown
+{
+  static void shutdown_send(Stream&)
+  {
+  }
+};
+
+template <typename Stream>
+struct relay_shutdown<Stream,
+    void_t<decltype(declval<Stream&>().shutdown(
+      socket_base::shutdown_send, declval<asio::error_code&>()))>>
+{
+  static void shutdown_send(Stream& s)
+  {
+    asio::error_code ec;
+    s.shutdown(socket_base::shutdown_send, ec);
+  }
+};
+
+// Determines whether data may be spliced between two streams.
+template <typename Stream>
+struct relay_is_socket : false_type
+{
+};
+
+template <typename Protocol, typename Executor>
+struct relay_is_socket<basic_stream_socket<Protocol, Executor>> : true_type
+{
+};
+
+template <typename StreamA, typename StreamB>
+struct relay_can_splice
+  : integral_constant<bool,
+#if defined(ASIO_HAS_SPLICE)
+      relay_is_socket<StreamA>::value && relay_is_socket<StreamB>::value
+#else // defined(ASIO_HAS_SPLICE)
+      false
+#endif // defined(ASIO_HAS_SPLICE)
+    >
+{
+};
+
+// The pipes and buffers used by a relay. The buffers immediately follow the
+// derived object that records the allocator.
+class relay_state
+  : private noncopyable
+{
+public:
+  template <typename Executor>
+  relay_state(const Executor& ex, std::size_t buffer_size)
+    : data_(0),
+      buffer_size_(buffer_size)
+#if defined(ASIO_HAS_SPLICE)
+      , a_to_b_read_(ex),
+      a_to_b_write_(ex),
+      b_to_a_read_(ex),
+      b_to_a_write_(ex)
+#endif // defined(ASIO_HAS_SPLICE)
+  {
+    (void)ex;
+  }
+
+  // Get the buffer used for one direction.
+  mutable_buffer buffer(int direction)
+  {
+    return mutable_buffer(data_ + (direction ? buffer_size_ : 0), buffer_size_);
+  }
+
+  unsigned char* data_;
+  std::size_t buffer_size_;
+  void (*destroy_)(relay_state*);
+
+#if defined(ASIO_HAS_SPLICE)
+  readable_pipe a_to_b_read_;
+  writable_pipe a_to_b_write_;
+  readable_pipe b_to_a_read_;
+  writable_pipe b_to_a_write_;
+#endif // defined(ASIO_HAS_SPLICE)
+};
+
+template <typename Allocator>
+class relay_state_impl : public relay_state
+{
+public:
+  typedef typename std::allocator_traits<Allocator>::template
+    rebind_alloc<relay_state_impl> allocator_type;
+
+  template <typename Executor>
+  static relay_state* create(const Allocator& a,
+      const Executor& ex, std::size_t buffer_size)
+  {
+    allocator_type alloc(a);
+    std::size_t len = 1 + (2 * buffer_size + sizeof(relay_state_impl) - 1)
+      / sizeof(relay_state_impl);
+    relay_state_impl* p = alloc.allocate(len);
+    try
+    {
+      return new (p) relay_state_impl(a, ex, buffer_size, len);
+    }
+    catch (...)
+    {
+      alloc.deallocate(p, len);
+      throw;
+    }
+  }
+
+private:
+  template <typename Executor>
+  relay_state_impl(const Allocator& a, const Executor& ex,
+      std::size_t buffer_size, std::size_t len)
+    : relay_state(ex, buffer_size),
+      allocator_(a),
+      length_(len)
+  {
+    this->data_ = reinterpret_cast<unsigned char*>(this + 1);
+    this->destroy_ = &relay_state_impl::do_destroy;
+  }
+
+  static void do_destroy(relay_state* base)
+  {
+    relay_state_impl* p = static_cast<relay_state_impl*>(base);
+    allocator_type alloc(p->allocator_);
+    std::size_t len = p->length_;
+    p->~relay_state_impl();
+    alloc.deallocate(p, len);
+  }
+
+  Allocator allocator_;
+  std::size_t length_;
+};
+
+// Owns a relay_state.
+class relay_state_ptr
+{
+public:
+  relay_state_ptr() noexcept
+    : p_(0)
+  {
+  }
+
+  relay_state_ptr(relay_state_ptr&& other) noexcept
+    : p_(other.p_)
+  {
+    other.p_ = 0;
+  }
+
+  ~relay_state_ptr()
+  {
+    reset();
+  }
+
+  template <typename Allocator, typename Executor>
+  void reset(const Allocator& a, const Executor& ex, std::size_t buffer_size)
+  {
+    reset();
+    p_ = relay_state_impl<Allocator>::create(a, ex, buffer_size);
+  }
+
+  void reset() noexcept
+  {
+    if (p_)
+      p_->destroy_(p_);
+    p_ = 0;
+  }
+
+  relay_state* operator->() const noexcept
+  {
+    return p_;
+  }
+
+private:
+  relay_state_ptr(const relay_state_ptr&) = delete;
+  relay_state_ptr& operator=(const relay_state_ptr&) = delete;
+
+  relay_state* p_;
+};
+
+// Copies data in one direction through a buffer.
+template <typename Source, typename Dest>
+class relay_copy_op
+{
+public:
+  relay_copy_op(Source& source, Dest& dest,
+      const mutable_buffer& buffer, bool half_close)
+    : source_(source),
+      dest_(dest),
+      buffer_(buffer),
+      half_close_(half_close),
+      total_transferred_(0),
+      state_(starting)
+  {
+  }
+
+  template <typename Self>
+  void operator()(Self& self,
+      asio::error_code ec = asio::error_code(), std::size_t n = 0)
+  {
+    switch (state_)
+    {
+    case reading:
+      if (ec == asio::error::eof)
+      {
+        if (half_close_)
+          relay_shutdown<Dest>::shutdown_send(dest_);
+        self.complete(asio::error_code(), total_transferred_);
+        return;
+      }
+      if (ec)
+      {
+        self.complete(ec, total_transferred_);
+        return;
+      }
+      state_ = writing;
+      asio::async_write(dest_, asio::buffer(buffer_, n),
+          static_cast<Self&&>(self));
+      return;
+
+    case writing:
+      total_transferred_ += n;
+      if (ec)
+      {
+        self.complete(ec, total_transferred_);
+        return;
+      }
+      // Fall through.
+
+    default:
+      state_ = reading;
+      source_.async_read_some(buffer_, static_cast<Self&&>(self));
+      return;
+    }
+  }
+
+private:
+  enum state { starting, reading, writing };
+
+  Source& source_;
+  Dest& dest_;
+  mutable_buffer buffer_;
+  bool half_close_;
+  std::size_t total_transferred_;
+  state state_;
+};
+
+#if defined(ASIO_HAS_SPLICE)
+
+// Moves data in one direction from a socket into a pipe, and from the pipe
+// into the other socket.
+template <typename Source, typename Dest>
+class relay_splice_op
+{
+public:
+  relay_splice_op(Source& source, Dest& dest, readable_pipe& pipe_read,
+      writable_pipe& pipe_write, std::size_t max_bytes, bool half_close)
+    : source_(source),
+      dest_(dest),
+      pipe_read_(pipe_read),
+      pipe_write_(pipe_write),
+      max_bytes_(max_bytes),
+      pending_(0),
+      half_close_(half_close),
+      total_transferred_(0),
+      state_(starting)
+  {
+  }
+
+  template <typename Self>
+  void operator()(Self& self,
+      asio::error_code ec = asio::error_code(), std::size_t n = 0)
+  {
+    switch (state_)
+    {
+    case splicing_in:
+      if (ec == asio::error::eof)
+      {
+        if (half_close_)
+          relay_shutdown<Dest>::shutdown_send(dest_);
+        self.complete(asio::error_code(), total_transferred_);
+        return;
+      }
+      if (ec)
+      {
+        self.complete(ec, total_transferred_);
+        return;
+      }
+      pending_ = n;
+      state_ = splicing_out;
+      asio::async_splice(pipe_read_, dest_, pending_,
+          static_cast<Self&&>(self));
+      return;
+
+    case splicing_out:
+      pending_ -= n;
+      total_transferred_ += n;
+      if (ec)
+      {
+        self.complete(ec, total_transferred_);
+        return;
+      }
+      if (pending_ > 0)
+      {
+        asio::async_splice(pipe_read_, dest_, pending_,
+            static_cast<Self&&>(self));
+        return;
+      }
+      // Fall through.
+
+    default:
+      state_ = splicing_in;
+      asio::async_splice(source_, pipe_write_, max_bytes_,
+          static_cast<Self&&>(self));
+      return;
+    }
+  }
+
+private:
+  enum state { starting, splicing_in, splicing_out };
+
+  Source& source_;
+  Dest& dest_;
+  readable_pipe& pipe_read_;
+  writable_pipe& pipe_write_;
+  std::size_t max_bytes_;
+  std::size_t pending_;
+  bool half_close_;
+  std::size_t total_transferred_;
+  state state_;
+};
+
+#endif // defined(ASIO_HAS_SPLICE)
+
+// Determines whether to cancel the other direction when one finishes.
+class relay_condition
+{
+public:
+  explicit relay_condition(bool half_close)
+    : half_close_(half_close)
+  {
+  }
+
+  cancellation_type_t operator()(const asio::error_code& ec,
+      std::size_t) const noexcept
+  {
+    return ec || !half_close_
+      ? cancellation_type::terminal : cancellation_type::none;
+  }
+
+private:
+  bool half_close_;
+};
+
+// Runs both directions of a relay, and waits for them to finish.
+template <typename StreamA, typename StreamB>
+class relay_op
+{
+public:
+  relay_op(StreamA& a, StreamB& b, const relay_options& options)
+    : a_(a),
+      b_(b),
+      options_(options),
+      started_(false)
+  {
+  }
+
+  template <typename Self>
+  void operator()(Self& self)
+  {
+    if (started_)
+    {
+      self.complete(asio::error::invalid_argument, 0, 0);
+      return;
+    }
+
+    started_ = true;
+    if (options_.buffer_size == 0)
+    {
+      asio::async_immediate(a_.get_executor(), static_cast<Self&&>(self));
+      return;
+    }
+
+    if (start_splice(self, relay_can_splice<StreamA, StreamB>()))
+      return;
+
+    state_.reset(asio::get_associated_allocator(self,
+          recycling_allocator<void>()), a_.get_executor(),
+        options_.buffer_size);
+
+    experimental::make_parallel_group(
+        async_compose<const deferred_t&, void (asio::error_code, std::size_t)>(
+          relay_copy_op<StreamA, StreamB>(a_, b_,
+            state_->buffer(0), options_.half_close), deferred, a_),
+        async_compose<const deferred_t&, void (asio::error_code, std::size_t)>(
+          relay_copy_op<StreamB, StreamA>(b_, a_,
+            state_->buffer(1), options_.half_close), deferred, b_)
+      ).async_wait(relay_condition(options_.half_close),
+        static_cast<Self&&>(self));
+  }
+
+  template <typename Self>
+  void operator()(Self& self, std::array<std::size_t, 2> order,
+      asio::error_code ec_a, std::size_t a_to_b,
+      asio::error_code ec_b, std::size_t b_to_a)
+  {
+    state_.reset();
+
+    // The direction that finished first determines the result. When half
+    // close is in use, the other direction ran to its own conclusion.
+    const asio::error_code& first = order[0] == 0 ? ec_a : ec_b;
+    const asio::error_code& second = order[0] == 0 ? ec_b : ec_a;
+    asio::error_code ec = first;
+    if (!ec && options_.half_close)
+      ec = second;
+
+    self.complete(ec, a_to_b, b_to_a);
+  }
+
+private:
+  template <typename Self>
+  bool start_splice(Self&, false_type)
+  {
+    return false;
+  }
+
+#if defined(ASIO_HAS_SPLICE)
+  template <typename Self>
+  bool start_splice(Self& self, true_type)
+  {
+    if (!options_.use_splice)
+      return false;
+
+    state_.reset(asio::get_associated_allocator(self,
+          recycling_allocator<void>()), a_.get_executor(), 0);
+
+    asio::error_code ec;
+    connect_pipe(state_->a_to_b_read_, state_->a_to_b_write_, ec);
+    if (!ec)
+      connect_pipe(state_->b_to_a_read_, state_->b_to_a_write_, ec);
+    if (ec)
+    {
+      state_.reset();
+      return false;
+    }
+
+    experimental::make_parallel_group(
+        async_compose<const deferred_t&, void (asio::error_code, std::size_t)>(
+          relay_splice_op<StreamA, StreamB>(a_, b_, state_->a_to_b_read_,
+            state_->a_to_b_write_, options_.buffer_size,
+            options_.half_close), deferred, a_),
+        async_compose<const deferred_t&, void (asio::error_code, std::size_t)>(
+          relay_splice_op<StreamB, StreamA>(b_, a_, state_->b_to_a_read_,
+            state_->b_to_a_write_, options_.buffer_size,
+            options_.half_close), deferred, b_)
+      ).async_wait(relay_condition(options_.half_close),
+        static_cast<Self&&>(self));
+    return true;
+  }
+#endif // defined(ASIO_HAS_SPLICE)
+
+  StreamA& a_;
+  StreamB& b_;
+  relay_options options_;
+  bool started_;
+  relay_state_ptr state_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_RELAY_HPP
@@ -0,0 +1,353 @@
+//
+// impl/sendfile.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_SENDFILE_HPP
+#define ASIO_IMPL_SENDFILE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/associator.hpp"
+#include "asio/immediate.hpp"
+#include "asio/socket_base.hpp"
+#include "asio/detail/base_from_cancellation_state.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/handler_tracking.hpp"
+#include "asio/detail/handler_type_requirements.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+
+#if defined(ASIO_HAS_WINDOWS_OVERLAPPED_PTR)
+# include "asio/windows/overlapped_ptr.hpp"
+#else // defined(ASIO_HAS_WINDOWS_OVERLAPPED_PTR)
+# include <cerrno>
+# include <sys/sendfile.h>
+#endif // defined(ASIO_HAS_WINDOWS_OVERLAPPED_PTR)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+namespace detail
+{
+#if defined(ASIO_HAS_WINDOWS_OVERLAPPED_PTR)
+
+  template <typename Socket, typename File, typename SendfileHandler>
+  class sendfile_op
+  {
+  public:
+    sendfile_op(Socket& s, File& file, uint64_t offset,
+        std::size_t count, SendfileHandler& handler)
+      : socket_(s),
+        file_(file),
+        offset_(offset),
+        remaining_(count),
+        chunk_(0),
+        total_transferred_(0),
+        start_(0),
+        handler_(static_cast<SendfileHandler&&>(handler))
+    {
+    }
+
+    sendfile_op(sendfile_op&& other)
+      : socket_(other.socket_),
+        file_(other.file_),
+        offset_(other.offset_),
+        remaining_(other.remaining_),
+        chunk_(other.chunk_),
+        total_transferred_(other.total_transferred_),
+        start_(other.start_),
+        handler_(static_cast<SendfileHandler&&>(other.handler_))
+    {
+    }
+
+    // Start the operation.
+    void start()
+    {
+      start_ = 1;
+      if (remaining_ == 0)
+      {
+        ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_sendfile"));
+        start_ = 0;
+        asio::async_immediate(socket_.get_executor(),
+            asio::detail::bind_handler(static_cast<sendfile_op&&>(*this),
+              asio::error_code(), std::size_t(0)));
+        return;
+      }
+
+      transmit();
+    }
+
+    // Continue the operation after a TransmitFile call completes.
+    void operator()(asio::error_code ec, std::size_t bytes_transferred)
+    {
+      offset_ += bytes_transferred;
+      remaining_ -= bytes_transferred;
+      total_transferred_ += bytes_transferred;
+
+      if (!ec && remaining_ > 0)
+      {
+        // TransmitFile sends less than requested only at the end of the file.
+        if (bytes_transferred < chunk_)
+          ec = asio::error::eof;
+        else
+          return transmit();
+      }
+
+      static_cast<SendfileHandler&&>(handler_)(
+          static_cast<const asio::error_code&>(ec),
+          static_cast<const std::size_t&>(total_transferred_));
+    }
+
+  //private:
+    // Start a TransmitFile call for the next chunk of the file.
+    void transmit()
+    {
+      ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_sendfile"));
+
+      // TransmitFile can send at most 2^31 - 2 bytes per call.
+      chunk_ = remaining_ < 0x7FFFFFFE ? remaining_ : 0x7FFFFFFE;
+      SOCKET s = socket_.native_handle();
+      HANDLE h = file_.native_handle();
+      uint64_t offset = offset_;
+      DWORD chunk = static_cast<DWORD>(chunk_);
+
+      start_ = 0;
+      windows::overlapped_ptr ptr(socket_.get_executor(),
+          static_cast<sendfile_op&&>(*this));
+      ptr.get()->Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+      ptr.get()->OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+      BOOL ok = ::TransmitFile(s, h, chunk, 0, ptr.get(), 0, 0);
+      DWORD last_error = ::GetLastError();
+      if (!ok && last_error != ERROR_IO_PENDING
+          && last_error != WSA_IO_PENDING)
+      {
+        asio::error_code ec(last_error, asio::error::get_system_category());
+        ptr.complete(ec, 0);
+      }
+      else
+      {
+        ptr.release();
+      }
+    }
+
+    Socket& socket_;
+    File& file_;
+    uint64_t offset_;
+    std::size_t remaining_;
+    std::size_t chunk_;
+    std::size_t total_transferred_;
+    int start_;
+    SendfileHandler handler_;
+  };
+
+#else // defined(ASIO_HAS_WINDOWS_OVERLAPPED_PTR)
+
+  template <typename Socket, typename File, typename SendfileHandler>
+  class sendfile_op
+    : public base_from_cancellation_state<SendfileHandler>
+  {
+  public:
+    sendfile_op(Socket& s, File& file, uint64_t offset,
+        std::size_t count, SendfileHandler& handler)
+      : base_from_cancellation_state<SendfileHandler>(handler),
+        socket_(s),
+        file_(file),
+        offset_(offset),
+        remaining_(count),
+        total_transferred_(0),
+        start_(0),
+        handler_(static_cast<SendfileHandler&&>(handler))
+    {
+    }
+
+    sendfile_op(sendfile_op&& other)
+      : base_from_cancellation_state<SendfileHandler>(
+          static_cast<base_from_cancellation_state<SendfileHandler>&&>(other)),
+        socket_(other.socket_),
+        file_(other.file_),
+        offset_(other.offset_),
+        remaining_(other.remaining_),
+        total_transferred_(other.total_transferred_),
+        start_(other.start_),
+        handler_(static_cast<SendfileHandler&&>(other.handler_))
+    {
+    }
+
+    // Start the operation.
+    void start()
+    {
+      start_ = 1;
+      asio::error_code ec;
+      if (remaining_ > 0 && !socket_.native_non_blocking())
+        socket_.native_non_blocking(true, ec);
+      if (ec || remaining_ == 0)
+        return immediate(ec);
+
+      (*this)(ec);
+    }
+
+    // Resume the operation after waiting for the socket to become writable.
+    void operator()(asio::error_code ec)
+    {
+      if (!ec && start_ == 0 && this->cancelled() != cancellation_type::none)
+        ec = error::operation_aborted;
+
+      while (!ec && remaining_ > 0)
+      {
+        // Linux transfers at most 0x7ffff000 bytes per call.
+        std::size_t chunk = remaining_ < 0x7ffff000 ? remaining_ : 0x7ffff000;
+        off_t offset = static_cast<off_t>(offset_);
+        ssize_t n = ::sendfile(socket_.native_handle(),
+            file_.native_handle(), &offset, chunk);
+        if (n < 0)
+        {
+          if (errno == EINTR)
+            continue;
+          if (errno == EAGAIN || errno == EWOULDBLOCK)
+          {
+            ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_sendfile"));
+            start_ = 0;
+            socket_.async_wait(socket_base::wait_write,
+                static_cast<sendfile_op&&>(*this));
+            return;
+          }
+          ec = asio::error_code(errno, asio::error::get_system_category());
+        }
+        else if (n == 0)
+        {
+          ec = asio::error::eof;
+        }
+        else
+        {
+          offset_ += static_cast<std::size_t>(n);
+          remaining_ -= static_cast<std::size_t>(n);
+          total_transferred_ += static_cast<std::size_t>(n);
+        }
+      }
+
+      if (start_)
+        return immediate(ec);
+
+      static_cast<SendfileHandler&&>(handler_)(
+          static_cast<const asio::error_code&>(ec),
+          static_cast<const std::size_t&>(total_transferred_));
+    }
+
+    // Complete the operation after an immediate completion.
+    void operator()(asio::error_code ec, std::size_t)
+    {
+      static_cast<SendfileHandler&&>(handler_)(
+          static_cast<const asio::error_code&>(ec),
+          static_cast<const std::size_t&>(total_transferred_));
+    }
+
+  //private:
+    // Deliver the result as an immediate completion.
+    void immediate(const asio::error_code& ec)
+    {
+      ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_sendfile"));
+      start_ = 0;
+      std::size_t bytes_transferred = total_transferred_;
+      asio::async_immediate(socket_.get_executor(),
+          asio::detail::bind_handler(static_cast<sendfile_op&&>(*this),
+            ec, bytes_transferred));
+    }
+
+    Socket& socket_;
+    File& file_;
+    uint64_t offset_;
+    std::size_t remaining_;
+    std::size_t total_transferred_;
+    int start_;
+    SendfileHandler handler_;
+  };
+
+#endif // defined(ASIO_HAS_WINDOWS_OVERLAPPED_PTR)
+
+  template <typename Socket, typename File, typename SendfileHandler>
+  inline bool asio_handler_is_continuation(
+      sendfile_op<Socket, File, SendfileHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Socket, typename File>
+  class initiate_async_sendfile
+  {
+  public:
+    typedef typename Socket::executor_type executor_type;
+
+    initiate_async_sendfile(Socket& s, File& file)
+      : socket_(s),
+        file_(file)
+    {
+    }
+
+    executor_type get_executor() const noexcept
+    {
+      return socket_.get_executor();
+    }
+
+    template <typename SendfileHandler>
+    void operator()(SendfileHandler&& handler,
+        uint64_t offset, std::size_t count) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(SendfileHandler, handler) type_check;
+
+      non_const_lvalue<SendfileHandler> handler2(handler);
+      sendfile_op<Socket, File, decay_t<SendfileHandler>>(
+          socket_, file_, offset, count, handler2.value).start();
+    }
+
+  private:
+    Socket& socket_;
+    File& file_;
+  };
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <template <typename, typename> class Associator,
+    typename Socket, typename File, typename SendfileHandler,
+    typename DefaultCandidate>
+struct associator<Associator,
+    detail::sendfile_op<Socket, File, SendfileHandler>,
+    DefaultCandidate>
+  : Associator<SendfileHandler, DefaultCandidate>
+{
+  static typename Associator<SendfileHandler, DefaultCandidate>::type get(
+      const detail::sendfile_op<Socket, File, SendfileHandler>& h) noexcept
+  {
+    return Associator<SendfileHandler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static auto get(const detail::sendfile_op<Socket, File, SendfileHandler>& h,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<SendfileHandler, DefaultCandidate>::get(
+          h.handler_, c))
+  {
+    return Associator<SendfileHandler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_SENDFILE_HPP
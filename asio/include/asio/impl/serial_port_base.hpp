@@ -52,6 +52,27 @@ inline unsigned int serial_port_base::character_size::value() const
   return value_;
 }
 
+inline unsigned int serial_port_base::read_timing::min_chars() const
+{
+  return min_chars_;
+}
+
+inline std::chrono::milliseconds
+serial_port_base::read_timing::inter_char_timeout() const
+{
+  return inter_char_timeout_;
+}
+
+inline serial_port_base::low_latency::low_latency(bool enabled)
+  : value_(enabled)
+{
+}
+
+inline bool serial_port_base::low_latency::value() const
+{
+  return value_;
+}
+
 } // namespace asio
 
 #include "asio/detail/pop_options.hpp"
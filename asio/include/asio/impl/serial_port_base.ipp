@@ -543,6 +543,52 @@ ASIO_SYNC_OP_VOID serial_port_base::character_size::load(
   ASIO_SYNC_OP_VOID_RETURN(ec);
 }
 
+serial_port_base::read_timing::read_timing(unsigned int min_chars,
+    std::chrono::milliseconds inter_char_timeout)
+  : min_chars_(min_chars),
+    inter_char_timeout_(inter_char_timeout)
+{
+  if (min_chars > 255 || inter_char_timeout.count() < 0
+      || inter_char_timeout > std::chrono::milliseconds(25500))
+  {
+    std::out_of_range ex("invalid read_timing value");
+    asio::detail::throw_exception(ex);
+  }
+}
+
+ASIO_SYNC_OP_VOID serial_port_base::read_timing::store(
+    ASIO_OPTION_STORAGE& storage, asio::error_code& ec) const
+{
+#if defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+  (void)storage;
+  ec = asio::error::operation_not_supported;
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+#else
+  // VTIME is measured in tenths of a second.
+  storage.c_cc[VMIN] = static_cast<cc_t>(min_chars_);
+  storage.c_cc[VTIME] = static_cast<cc_t>(
+      (inter_char_timeout_.count() + 99) / 100);
+  ec = asio::error_code();
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+#endif
+}
+
+ASIO_SYNC_OP_VOID serial_port_base::read_timing::load(
+    const ASIO_OPTION_STORAGE& storage, asio::error_code& ec)
+{
+#if defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+  (void)storage;
+  ec = asio::error::operation_not_supported;
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+#else
+  min_chars_ = storage.c_cc[VMIN];
+  inter_char_timeout_ = std::chrono::milliseconds(
+      static_cast<long>(storage.c_cc[VTIME]) * 100);
+  ec = asio::error_code();
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+#endif
+}
+
 } // namespace asio
 
 #include "asio/detail/pop_options.hpp"
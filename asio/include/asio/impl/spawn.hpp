@@ -24,9 +24,12 @@
 #include "asio/bind_executor.hpp"
 #include "asio/detail/atomic_count.hpp"
 #include "asio/detail/bind_handler.hpp"
+#include "asio/detail/fiber_stack_cache.hpp"
 #include "asio/detail/handler_cont_helpers.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/noncopyable.hpp"
+#include "asio/detail/thread_context.hpp"
+#include "asio/detail/thread_info_base.hpp"
 #include "asio/detail/type_traits.hpp"
 #include "asio/detail/utility.hpp"
 #include "asio/disposition.hpp"
@@ -52,6 +55,47 @@ inline void spawned_thread_rethrow(void* ex)
 
 #if defined(ASIO_HAS_BOOST_CONTEXT_FIBER)
 
+// Stack allocator that maps stacks with a guard page, and caches released
+// stacks for reuse by the thread that released them.
+class pooled_fiber_stack_allocator
+{
+public:
+  explicit pooled_fiber_stack_allocator(
+      std::size_t size = boost::context::stack_traits::default_size())
+    : size_(fiber_stack_cache::round_size(size))
+  {
+  }
+
+  boost::context::stack_context allocate()
+  {
+    void* base = 0;
+    if (thread_info_base* this_thread =
+        thread_context::top_of_thread_call_stack())
+      base = this_thread->fiber_stacks().take(size_);
+    if (!base)
+      base = fiber_stack_cache::map(size_);
+
+    boost::context::stack_context sctx;
+    sctx.size = size_;
+    sctx.sp = static_cast<unsigned char*>(base)
+      + fiber_stack_cache::guard_size() + size_;
+    return sctx;
+  }
+
+  void deallocate(boost::context::stack_context& sctx) noexcept
+  {
+    void* base = static_cast<unsigned char*>(sctx.sp)
+      - sctx.size - fiber_stack_cache::guard_size();
+    thread_info_base* this_thread =
+      thread_context::top_of_thread_call_stack();
+    if (!this_thread || !this_thread->fiber_stacks().put(base, sctx.size))
+      fiber_stack_cache::unmap(base, sctx.size);
+  }
+
+private:
+  std::size_t size_;
+};
+
 // Spawned thread implementation using Boost.Context's fiber.
 class spawned_fiber_thread : public spawned_thread_base
 {
@@ -89,7 +133,7 @@ public:
       cancellation_slot parent_cancel_slot = cancellation_slot(),
       cancellation_state cancel_state = cancellation_state())
   {
-    return spawn(allocator_arg_t(), boost::context::fixedsize_stack(),
+    return spawn(allocator_arg_t(), pooled_fiber_stack_allocator(),
         static_cast<F&&>(f), parent_cancel_slot, cancel_state);
   }
 
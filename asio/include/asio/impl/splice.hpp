@@ -0,0 +1,697 @@
+//
+// impl/splice.hpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_SPLICE_HPP
+#define ASIO_IMPL_SPLICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include "asio/associator.hpp"
+#include "asio/basic_readable_pipe.hpp"
+#include "asio/basic_stream_socket.hpp"
+#include "asio/basic_writable_pipe.hpp"
+#include "asio/immediate.hpp"
+#include "asio/post.hpp"
+#include "asio/detail/base_from_cancellation_state.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/consuming_buffers.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/handler_tracking.hpp"
+#include "asio/detail/handler_type_requirements.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#if defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+# include "asio/posix/basic_stream_descriptor.hpp"
+#endif // defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+#if defined(ASIO_HAS_FILE)
+# include "asio/basic_stream_file.hpp"
+#endif // defined(ASIO_HAS_FILE)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+namespace detail
+{
+  // Describes how to splice to and from each supported type of I/O object.
+  template <typename T>
+  struct splice_traits;
+
+  template <typename Protocol, typename Executor>
+  struct splice_traits<basic_stream_socket<Protocol, Executor>>
+  {
+    typedef basic_stream_socket<Protocol, Executor> object_type;
+
+    static constexpr bool is_pipe = false;
+    static constexpr bool can_wait = true;
+
+    static void prepare(object_type& s, asio::error_code& ec)
+    {
+      if (!s.native_non_blocking())
+        s.native_non_blocking(true, ec);
+    }
+
+    template <typename Handler>
+    static void async_wait_read(object_type& s, Handler&& handler)
+    {
+      s.async_wait(socket_base::wait_read, static_cast<Handler&&>(handler));
+    }
+
+    template <typename Handler>
+    static void async_wait_write(object_type& s, Handler&& handler)
+    {
+      s.async_wait(socket_base::wait_write, static_cast<Handler&&>(handler));
+    }
+  };
+
+  template <typename Executor>
+  struct splice_traits<basic_readable_pipe<Executor>>
+  {
+    typedef basic_readable_pipe<Executor> object_type;
+
+    static constexpr bool is_pipe = true;
+    static constexpr bool can_wait = true;
+
+    // The pipe is accessed using SPLICE_F_NONBLOCK.
+    static void prepare(object_type&, asio::error_code&)
+    {
+    }
+
+    template <typename Handler>
+    static void async_wait_read(object_type& p, Handler&& handler)
+    {
+      p.async_wait(static_cast<Handler&&>(handler));
+    }
+  };
+
+  template <typename Executor>
+  struct splice_traits<basic_writable_pipe<Executor>>
+  {
+    typedef basic_writable_pipe<Executor> object_type;
+
+    static constexpr bool is_pipe = true;
+    static constexpr bool can_wait = true;
+
+    // The pipe is accessed using SPLICE_F_NONBLOCK.
+    static void prepare(object_type&, asio::error_code&)
+    {
+    }
+
+    template <typename Handler>
+    static void async_wait_write(object_type& p, Handler&& handler)
+    {
+      p.async_wait(static_cast<Handler&&>(handler));
+    }
+  };
+
+#if defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+  template <typename Executor>
+  struct splice_traits<posix::basic_stream_descriptor<Executor>>
+  {
+    typedef posix::basic_stream_descriptor<Executor> object_type;
+
+    static constexpr bool is_pipe = false;
+    static constexpr bool can_wait = true;
+
+    static void prepare(object_type& d, asio::error_code& ec)
+    {
+      if (!d.native_non_blocking())
+        d.native_non_blocking(true, ec);
+    }
+
+    template <typename Handler>
+    static void async_wait_read(object_type& d, Handler&& handler)
+    {
+      d.async_wait(posix::descriptor_base::wait_read,
+          static_cast<Handler&&>(handler));
+    }
+
+    template <typename Handler>
+    static void async_wait_write(object_type& d, Handler&& handler)
+    {
+      d.async_wait(posix::descriptor_base::wait_write,
+          static_cast<Handler&&>(handler));
+    }
+  };
+#endif // defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+
+#if defined(ASIO_HAS_FILE)
+  template <typename Executor>
+  struct splice_traits<basic_stream_file<Executor>>
+  {
+    typedef basic_stream_file<Executor> object_type;
+
+    static constexpr bool is_pipe = false;
+
+    // Regular files are always ready, and splice() uses and updates the file
+    // position shared with the file's other operations.
+    static constexpr bool can_wait = false;
+
+    static void prepare(object_type&, asio::error_code&)
+    {
+    }
+
+    template <typename Handler>
+    static void async_wait_read(object_type& f, Handler&& handler)
+    {
+      asio::post(f.get_executor(), asio::detail::bind_handler(
+            static_cast<Handler&&>(handler), asio::error_code()));
+    }
+
+    template <typename Handler>
+    static void async_wait_write(object_type& f, Handler&& handler)
+    {
+      asio::post(f.get_executor(), asio::detail::bind_handler(
+            static_cast<Handler&&>(handler), asio::error_code()));
+    }
+  };
+#endif // defined(ASIO_HAS_FILE)
+
+  // Owns the pipe through which data passes when neither end is a pipe.
+  class splice_pipe
+  {
+  public:
+    splice_pipe()
+    {
+      fds_[0] = fds_[1] = -1;
+    }
+
+    splice_pipe(splice_pipe&& other) noexcept
+    {
+      fds_[0] = other.fds_[0];
+      fds_[1] = other.fds_[1];
+      other.fds_[0] = other.fds_[1] = -1;
+    }
+
+    ~splice_pipe()
+    {
+      if (fds_[0] != -1)
+        ::close(fds_[0]);
+      if (fds_[1] != -1)
+        ::close(fds_[1]);
+    }
+
+    asio::error_code open(asio::error_code& ec)
+    {
+      if (::pipe2(fds_, O_NONBLOCK | O_CLOEXEC) != 0)
+      {
+        ec = asio::error_code(errno, asio::error::get_system_category());
+        fds_[0] = fds_[1] = -1;
+      }
+      else
+        ec.assign(0, ec.category());
+      return ec;
+    }
+
+    int read_end() const noexcept
+    {
+      return fds_[0];
+    }
+
+    int write_end() const noexcept
+    {
+      return fds_[1];
+    }
+
+  private:
+    splice_pipe(const splice_pipe&) = delete;
+    splice_pipe& operator=(const splice_pipe&) = delete;
+
+    int fds_[2];
+  };
+
+  template <typename Source, typename Dest, typename SpliceHandler>
+  class splice_op
+    : public base_from_cancellation_state<SpliceHandler>
+  {
+  public:
+    // Data is spliced directly when either end is a pipe.
+    static constexpr bool is_direct =
+      splice_traits<Source>::is_pipe || splice_traits<Dest>::is_pipe;
+
+    splice_op(Source& source, Dest& dest,
+        std::size_t max_bytes, SpliceHandler& handler)
+      : base_from_cancellation_state<SpliceHandler>(handler),
+        source_(source),
+        dest_(dest),
+        max_bytes_(max_bytes),
+        pending_(0),
+        total_transferred_(0),
+        start_(0),
+        state_(is_direct ? splice_direct : splice_in),
+        handler_(static_cast<SpliceHandler&&>(handler))
+    {
+    }
+
+    splice_op(splice_op&& other)
+      : base_from_cancellation_state<SpliceHandler>(
+          static_cast<base_from_cancellation_state<SpliceHandler>&&>(other)),
+        source_(other.source_),
+        dest_(other.dest_),
+        max_bytes_(other.max_bytes_),
+        pipe_(static_cast<splice_pipe&&>(other.pipe_)),
+        pending_(other.pending_),
+        total_transferred_(other.total_transferred_),
+        start_(other.start_),
+        state_(other.state_),
+        handler_(static_cast<SpliceHandler&&>(other.handler_))
+    {
+    }
+
+    // Start the operation.
+    void start()
+    {
+      start_ = 1;
+      asio::error_code ec;
+      if (max_bytes_ > 0)
+      {
+        if (!is_direct)
+          pipe_.open(ec);
+        if (!ec)
+          splice_traits<Source>::prepare(source_, ec);
+        if (!ec)
+          splice_traits<Dest>::prepare(dest_, ec);
+      }
+      if (ec || max_bytes_ == 0)
+        return immediate(ec);
+
+      (*this)(ec);
+    }
+
+    // Resume the operation after waiting for the source or destination.
+    void operator()(asio::error_code ec)
+    {
+      if (!ec && start_ == 0 && this->cancelled() != cancellation_type::none)
+        ec = error::operation_aborted;
+
+      while (!ec)
+      {
+        int result = perform(ec);
+        if (result == want_source)
+        {
+          ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_splice"));
+          start_ = 0;
+          state_ |= waited_source;
+          splice_traits<Source>::async_wait_read(
+              source_, static_cast<splice_op&&>(*this));
+          return;
+        }
+        else if (result == want_dest)
+        {
+          ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_splice"));
+          start_ = 0;
+          state_ &= ~waited_source;
+          splice_traits<Dest>::async_wait_write(
+              dest_, static_cast<splice_op&&>(*this));
+          return;
+        }
+        else if (result == done)
+          break;
+      }
+
+      if (start_)
+        return immediate(ec);
+
+      static_cast<SpliceHandler&&>(handler_)(
+          static_cast<const asio::error_code&>(ec),
+          static_cast<const std::size_t&>(total_transferred_));
+    }
+
+    // Complete the operation after an immediate completion.
+    void operator()(asio::error_code ec, std::size_t)
+    {
+      static_cast<SpliceHandler&&>(handler_)(
+          static_cast<const asio::error_code&>(ec),
+          static_cast<const std::size_t&>(total_transferred_));
+    }
+
+  //private:
+    enum { done, again, want_source, want_dest };
+
+    enum
+    {
+      // The step being performed.
+      splice_direct = 0, splice_in = 1, splice_out = 2, step_mask = 3,
+
+      // Set when the most recent wait was for the source.
+      waited_source = 4
+    };
+
+    // Perform one splice call.
+    int perform(asio::error_code& ec)
+    {
+      int fd_in, fd_out;
+      std::size_t length;
+      switch (state_ & step_mask)
+      {
+      case splice_direct:
+        fd_in = source_.native_handle();
+        fd_out = dest_.native_handle();
+        length = max_bytes_;
+        break;
+      case splice_in:
+        fd_in = source_.native_handle();
+        fd_out = pipe_.write_end();
+        length = max_bytes_;
+        break;
+      default:
+        fd_in = pipe_.read_end();
+        fd_out = dest_.native_handle();
+        length = pending_;
+        break;
+      }
+
+      ssize_t n = ::splice(fd_in, 0, fd_out, 0, length,
+          SPLICE_F_NONBLOCK | SPLICE_F_MOVE);
+      if (n < 0)
+      {
+        if (errno == EINTR)
+          return again;
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+          return would_block();
+        ec = asio::error_code(errno, asio::error::get_system_category());
+        return done;
+      }
+
+      switch (state_ & step_mask)
+      {
+      case splice_direct:
+        if (n == 0)
+          ec = asio::error::eof;
+        total_transferred_ = static_cast<std::size_t>(n);
+        return done;
+      case splice_in:
+        if (n == 0)
+        {
+          ec = asio::error::eof;
+          return done;
+        }
+        pending_ = static_cast<std::size_t>(n);
+        state_ = splice_out;
+        return again;
+      default:
+        pending_ -= static_cast<std::size_t>(n);
+        total_transferred_ += static_cast<std::size_t>(n);
+        return pending_ == 0 ? done : again;
+      }
+    }
+
+    // Determine which end to wait for after a splice would block.
+    int would_block()
+    {
+      switch (state_ & step_mask)
+      {
+      case splice_in:
+        // The internal pipe is empty, so the source has no data.
+        return want_source;
+      case splice_out:
+        // The internal pipe holds data, so the destination is full.
+        return want_dest;
+      default:
+        // Either end may be the cause. Wait for each in turn, starting with
+        // the source.
+        if (!splice_traits<Source>::can_wait)
+          return want_dest;
+        if (!splice_traits<Dest>::can_wait)
+          return want_source;
+        return (state_ & waited_source) ? want_dest : want_source;
+      }
+    }
+
+    // Deliver the result as an immediate completion.
+    void immediate(const asio::error_code& ec)
+    {
+      ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_splice"));
+      start_ = 0;
+      std::size_t bytes_transferred = total_transferred_;
+      asio::async_immediate(source_.get_executor(),
+          asio::detail::bind_handler(static_cast<splice_op&&>(*this),
+            ec, bytes_transferred));
+    }
+
+    Source& source_;
+    Dest& dest_;
+    std::size_t max_bytes_;
+    splice_pipe pipe_;
+    std::size_t pending_;
+    std::size_t total_transferred_;
+    int start_;
+    int state_;
+    SpliceHandler handler_;
+  };
+
+  template <typename Source, typename Dest, typename SpliceHandler>
+  inline bool asio_handler_is_continuation(
+      splice_op<Source, Dest, SpliceHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Source, typename Dest>
+  class initiate_async_splice
+  {
+  public:
+    typedef typename Source::executor_type executor_type;
+
+    initiate_async_splice(Source& source, Dest& dest)
+      : source_(source),
+        dest_(dest)
+    {
+    }
+
+    executor_type get_executor() const noexcept
+    {
+      return source_.get_executor();
+    }
+
+    template <typename SpliceHandler>
+    void operator()(SpliceHandler&& handler, std::size_t max_bytes) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(SpliceHandler, handler) type_check;
+
+      non_const_lvalue<SpliceHandler> handler2(handler);
+      splice_op<Source, Dest, decay_t<SpliceHandler>>(
+          source_, dest_, max_bytes, handler2.value).start();
+    }
+
+  private:
+    Source& source_;
+    Dest& dest_;
+  };
+
+  template <typename Executor, typename ConstBufferSequence,
+      typename VmspliceHandler>
+  class vmsplice_op
+    : public base_from_cancellation_state<VmspliceHandler>
+  {
+  public:
+    vmsplice_op(basic_writable_pipe<Executor>& pipe,
+        const ConstBufferSequence& buffers, VmspliceHandler& handler)
+      : base_from_cancellation_state<VmspliceHandler>(handler),
+        pipe_(pipe),
+        buffers_(buffers),
+        start_(0),
+        handler_(static_cast<VmspliceHandler&&>(handler))
+    {
+    }
+
+    vmsplice_op(vmsplice_op&& other)
+      : base_from_cancellation_state<VmspliceHandler>(
+          static_cast<base_from_cancellation_state<VmspliceHandler>&&>(other)),
+        pipe_(other.pipe_),
+        buffers_(static_cast<buffers_type&&>(other.buffers_)),
+        start_(other.start_),
+        handler_(static_cast<VmspliceHandler&&>(other.handler_))
+    {
+    }
+
+    // Start the operation.
+    void start()
+    {
+      start_ = 1;
+      (*this)(asio::error_code());
+    }
+
+    // Resume the operation after waiting for the pipe to become writable.
+    void operator()(asio::error_code ec)
+    {
+      if (!ec && start_ == 0 && this->cancelled() != cancellation_type::none)
+        ec = error::operation_aborted;
+
+      while (!ec && !buffers_.empty())
+      {
+        buffer_sequence_adapter<const_buffer,
+          decltype(buffers_.prepare(0))>
+            bufs(buffers_.prepare(~std::size_t(0)));
+
+        ssize_t n = ::vmsplice(pipe_.native_handle(), bufs.buffers(),
+            bufs.count(), SPLICE_F_GIFT | SPLICE_F_NONBLOCK);
+        if (n < 0)
+        {
+          if (errno == EINTR)
+            continue;
+          if (errno == EAGAIN || errno == EWOULDBLOCK)
+          {
+            ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_vmsplice"));
+            start_ = 0;
+            pipe_.async_wait(static_cast<vmsplice_op&&>(*this));
+            return;
+          }
+          ec = asio::error_code(errno, asio::error::get_system_category());
+        }
+        else
+          buffers_.consume(static_cast<std::size_t>(n));
+      }
+
+      if (start_)
+      {
+        ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_vmsplice"));
+        start_ = 0;
+        std::size_t bytes_transferred = buffers_.total_consumed();
+        asio::async_immediate(pipe_.get_executor(),
+            asio::detail::bind_handler(static_cast<vmsplice_op&&>(*this),
+              ec, bytes_transferred));
+        return;
+      }
+
+      static_cast<VmspliceHandler&&>(handler_)(
+          static_cast<const asio::error_code&>(ec),
+          static_cast<const std::size_t&>(buffers_.total_consumed()));
+    }
+
+    // Complete the operation after an immediate completion.
+    void operator()(asio::error_code ec, std::size_t)
+    {
+      static_cast<VmspliceHandler&&>(handler_)(
+          static_cast<const asio::error_code&>(ec),
+          static_cast<const std::size_t&>(buffers_.total_consumed()));
+    }
+
+  //private:
+    typedef asio::detail::consuming_buffers<const_buffer, ConstBufferSequence,
+      decltype(asio::buffer_sequence_begin(
+          declval<const ConstBufferSequence&>()))> buffers_type;
+
+    basic_writable_pipe<Executor>& pipe_;
+    buffers_type buffers_;
+    int start_;
+    VmspliceHandler handler_;
+  };
+
+  template <typename Executor, typename ConstBufferSequence,
+      typename VmspliceHandler>
+  inline bool asio_handler_is_continuation(
+      vmsplice_op<Executor, ConstBufferSequence, VmspliceHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Executor>
+  class initiate_async_vmsplice
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_vmsplice(basic_writable_pipe<Executor>& pipe)
+      : pipe_(pipe)
+    {
+    }
+
+    executor_type get_executor() const noexcept
+    {
+      return pipe_.get_executor();
+    }
+
+    template <typename VmspliceHandler, typename ConstBufferSequence>
+    void operator()(VmspliceHandler&& handler,
+        const ConstBufferSequence& buffers) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(VmspliceHandler, handler) type_check;
+
+      non_const_lvalue<VmspliceHandler> handler2(handler);
+      vmsplice_op<Executor, ConstBufferSequence, decay_t<VmspliceHandler>>(
+          pipe_, buffers, handler2.value).start();
+    }
+
+  private:
+    basic_writable_pipe<Executor>& pipe_;
+  };
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <template <typename, typename> class Associator,
+    typename Source, typename Dest, typename SpliceHandler,
+    typename DefaultCandidate>
+struct associator<Associator,
+    detail::splice_op<Source, Dest, SpliceHandler>,
+    DefaultCandidate>
+  : Associator<SpliceHandler, DefaultCandidate>
+{
+  static typename Associator<SpliceHandler, DefaultCandidate>::type get(
+      const detail::splice_op<Source, Dest, SpliceHandler>& h) noexcept
+  {
+    return Associator<SpliceHandler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static auto get(const detail::splice_op<Source, Dest, SpliceHandler>& h,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<SpliceHandler, DefaultCandidate>::get(h.handler_, c))
+  {
+    return Associator<SpliceHandler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
+template <template <typename, typename> class Associator,
+    typename Executor, typename ConstBufferSequence,
+    typename VmspliceHandler, typename DefaultCandidate>
+struct associator<Associator,
+    detail::vmsplice_op<Executor, ConstBufferSequence, VmspliceHandler>,
+    DefaultCandidate>
+  : Associator<VmspliceHandler, DefaultCandidate>
+{
+  static typename Associator<VmspliceHandler, DefaultCandidate>::type get(
+      const detail::vmsplice_op<Executor, ConstBufferSequence,
+        VmspliceHandler>& h) noexcept
+  {
+    return Associator<VmspliceHandler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static auto get(
+      const detail::vmsplice_op<Executor, ConstBufferSequence,
+        VmspliceHandler>& h,
+      const DefaultCandidate& c) noexcept
+    -> decltype(
+      Associator<VmspliceHandler, DefaultCandidate>::get(h.handler_, c))
+  {
+    return Associator<VmspliceHandler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_SPLICE_HPP
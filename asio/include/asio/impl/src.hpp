@@ -29,23 +29,33 @@
 #include "asio/impl/execution_context.ipp"
 #include "asio/impl/executor.ipp"
 #include "asio/impl/io_context.ipp"
+#include "asio/impl/io_context_pool.ipp"
+#include "asio/impl/mapped_file.ipp"
 #include "asio/impl/multiple_exceptions.ipp"
+#include "asio/impl/provided_buffer_ring.ipp"
+#include "asio/impl/registered_buffer_pool.ipp"
 #include "asio/impl/serial_port_base.ipp"
 #include "asio/impl/system_context.ipp"
 #include "asio/impl/thread_pool.ipp"
 #include "asio/detail/impl/buffer_sequence_adapter.ipp"
+#include "asio/detail/impl/close_thread_pool.ipp"
 #include "asio/detail/impl/descriptor_ops.ipp"
 #include "asio/detail/impl/dev_poll_reactor.ipp"
+#include "asio/detail/impl/dns_ops.ipp"
 #include "asio/detail/impl/epoll_reactor.ipp"
 #include "asio/detail/impl/eventfd_select_interrupter.ipp"
+#include "asio/detail/impl/fiber_stack_cache.ipp"
 #include "asio/detail/impl/handler_tracking.ipp"
+#include "asio/detail/impl/huge_page_arena.ipp"
 #include "asio/detail/impl/io_uring_descriptor_service.ipp"
 #include "asio/detail/impl/io_uring_file_service.ipp"
 #include "asio/detail/impl/io_uring_socket_service_base.ipp"
 #include "asio/detail/impl/io_uring_service.ipp"
 #include "asio/detail/impl/kqueue_reactor.ipp"
+#include "asio/detail/impl/mirrored_memory.ipp"
 #include "asio/detail/impl/null_event.ipp"
 #include "asio/detail/impl/pipe_select_interrupter.ipp"
+#include "asio/detail/impl/poll_reactor.ipp"
 #include "asio/detail/impl/posix_event.ipp"
 #include "asio/detail/impl/posix_mutex.ipp"
 #include "asio/detail/impl/posix_serial_port_service.ipp"
@@ -63,7 +73,9 @@
 #include "asio/detail/impl/socket_select_interrupter.ipp"
 #include "asio/detail/impl/strand_executor_service.ipp"
 #include "asio/detail/impl/strand_service.ipp"
+#include "asio/detail/impl/thread_affinity.ipp"
 #include "asio/detail/impl/thread_context.ipp"
+#include "asio/detail/impl/thread_pool_file_service.ipp"
 #include "asio/detail/impl/throw_error.ipp"
 #include "asio/detail/impl/timer_queue_ptime.ipp"
 #include "asio/detail/impl/timer_queue_set.ipp"
@@ -90,6 +102,7 @@
 #include "asio/ip/impl/host_name.ipp"
 #include "asio/ip/impl/network_v4.ipp"
 #include "asio/ip/impl/network_v6.ipp"
+#include "asio/ip/detail/impl/address_chars.ipp"
 #include "asio/ip/detail/impl/endpoint.ipp"
 #include "asio/local/detail/impl/endpoint.ipp"
 
@@ -25,9 +25,13 @@ namespace asio {
 struct system_context::thread_function
 {
   detail::scheduler* scheduler_;
+  const thread_pool::placement* placement_;
+  std::size_t index_;
 
   void operator()()
   {
+    placement_->apply(index_);
+
 #if !defined(ASIO_NO_EXCEPTIONS)
     try
     {
@@ -44,16 +48,59 @@ struct system_context::thread_function
   }
 };
 
+struct system_context::configuration
+{
+  configuration()
+    : created_(false)
+  {
+  }
+
+  detail::mutex mutex_;
+  options options_;
+  bool created_;
+};
+
+bool system_context::configure(const options& opts)
+{
+  configuration& config = get_configuration();
+  detail::mutex::scoped_lock lock(config.mutex_);
+  if (config.created_)
+    return false;
+  config.options_ = opts;
+  return true;
+}
+
+system_context::configuration& system_context::get_configuration()
+{
+  static configuration config;
+  return config;
+}
+
 system_context::system_context()
   : scheduler_(add_scheduler(new detail::scheduler(*this))),
-    threads_(std::allocator<void>())
+    threads_(std::allocator<void>()),
+    threads_started_(false)
 {
   scheduler_.work_started();
 
-  thread_function f = { &scheduler_ };
-  num_threads_ = detail::thread::hardware_concurrency() * 2;
-  num_threads_ = num_threads_ ? num_threads_ : 2;
-  threads_.create_threads(f, num_threads_);
+  bool lazy_start = false;
+  {
+    configuration& config = get_configuration();
+    detail::mutex::scoped_lock lock(config.mutex_);
+    config.created_ = true;
+    num_threads_ = config.options_.num_threads_;
+    placement_ = config.options_.placement_;
+    lazy_start = config.options_.lazy_start_;
+  }
+
+  if (num_threads_ == 0)
+  {
+    num_threads_ = detail::thread::hardware_concurrency() * 2;
+    num_threads_ = num_threads_ ? num_threads_ : 2;
+  }
+
+  if (!lazy_start)
+    do_start_threads();
 }
 
 system_context::~system_context()
@@ -79,6 +126,20 @@ void system_context::join()
   threads_.join();
 }
 
+void system_context::do_start_threads()
+{
+  detail::mutex::scoped_lock lock(mutex_);
+  if (!threads_started_.load(std::memory_order_relaxed))
+  {
+    for (std::size_t i = 0; i < num_threads_; ++i)
+    {
+      thread_function f = { &scheduler_, &placement_, i };
+      threads_.create_thread(f);
+    }
+    threads_started_.store(true, std::memory_order_release);
+  }
+}
+
 detail::scheduler& system_context::add_scheduler(detail::scheduler* s)
 {
   detail::scoped_ptr<detail::scheduler> scoped_impl(s);
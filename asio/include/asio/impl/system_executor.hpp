@@ -112,6 +112,7 @@ void basic_system_executor<Blocking, Relationship, Allocator>::do_execute(
           "system_executor", &ctx, 0, "execute(blk=never,rel=fork)"));
   }
 
+  ctx.start_threads();
   ctx.scheduler_.post_immediate_completion(p.p,
       is_same<Relationship, execution::relationship_t::continuation_t>::value);
   p.v = p.p = 0;
@@ -148,6 +149,7 @@ void basic_system_executor<Blocking, Relationship, Allocator>::post(
   ASIO_HANDLER_CREATION((ctx, *p.p,
         "system_executor", &this->context(), 0, "post"));
 
+  ctx.start_threads();
   ctx.scheduler_.post_immediate_completion(p.p, false);
   p.v = p.p = 0;
 }
@@ -167,6 +169,7 @@ void basic_system_executor<Blocking, Relationship, Allocator>::defer(
   ASIO_HANDLER_CREATION((ctx, *p.p,
         "system_executor", &this->context(), 0, "defer"));
 
+  ctx.start_threads();
   ctx.scheduler_.post_immediate_completion(p.p, true);
   p.v = p.p = 0;
 }
@@ -20,6 +20,7 @@
 #include "asio/detail/executor_op.hpp"
 #include "asio/detail/fenced_block.hpp"
 #include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/op_queue.hpp"
 #include "asio/detail/type_traits.hpp"
 #include "asio/execution_context.hpp"
 
@@ -68,6 +69,34 @@ thread_pool::thread_pool(allocator_arg_t,
   start();
 }
 
+template <typename Allocator>
+thread_pool::thread_pool(allocator_arg_t, const Allocator& a,
+    std::size_t num_threads, const placement& where)
+  : execution_context(std::allocator_arg, a,
+      config_from_concurrency_hint(num_threads == 1 ? 1 : 0)),
+    scheduler_(asio::make_service<detail::scheduler>(*this)),
+    threads_(allocator<void>(*this)),
+    num_threads_(clamp_thread_pool_size(num_threads)),
+    joinable_(true),
+    placement_(where)
+{
+  start();
+}
+
+template <typename Allocator>
+thread_pool::thread_pool(allocator_arg_t,
+    const Allocator& a, const elastic& limits)
+  : execution_context(std::allocator_arg, a,
+      config_from_concurrency_hint(limits.max_threads_ == 1 ? 1 : 0)),
+    scheduler_(asio::make_service<detail::scheduler>(*this)),
+    threads_(allocator<void>(*this)),
+    num_threads_(clamp_thread_pool_size(limits.min_threads_)),
+    joinable_(true)
+{
+  start_elastic(limits);
+  start();
+}
+
 inline thread_pool::executor_type
 thread_pool::get_executor() noexcept
 {
@@ -139,7 +168,7 @@ void thread_pool::basic_executor_type<Allocator,
 
   // Invoke immediately if the blocking.possibly property is enabled and we are
   // already inside the thread pool.
-  if ((bits_ & blocking_never) == 0 && pool_->scheduler_.can_dispatch())
+  if ((bits_ & blocking_never) == 0 && pool_->scheduler_.can_dispatch_inline())
   {
     // Make a local, non-const copy of the function.
     function_type tmp(static_cast<Function&&>(f));
@@ -221,6 +250,39 @@ void thread_pool::basic_executor_type<Allocator,
   op.wait();
 }
 
+template <typename Allocator, unsigned int Bits>
+template <typename Range>
+void thread_pool::basic_executor_type<Allocator, Bits>::post_batch(
+    Range&& fs) const
+{
+  // Allocate and construct an operation to wrap each function. If an
+  // allocation fails, the operations already constructed are destroyed by
+  // the queue without being invoked.
+  detail::op_queue<detail::scheduler_operation> ops;
+  std::size_t n = 0;
+  for (auto&& f : fs)
+  {
+    typedef decay_t<decltype(f)> function_type;
+    typedef detail::executor_op<function_type, Allocator> op;
+    typename op::ptr p = { detail::addressof(allocator_),
+        op::ptr::allocate(allocator_), 0 };
+    p.p = new (p.v) op(std::move(f), allocator_);
+
+    ASIO_HANDLER_CREATION((*pool_, *p.p,
+          "thread_pool", pool_, 0, "post_batch"));
+
+    ops.push(p.p);
+    p.v = p.p = 0;
+    ++n;
+  }
+
+  if (n > 0)
+  {
+    pool_->scheduler_.post_immediate_completions(n, ops,
+        (bits_ & relationship_continuation) != 0);
+  }
+}
+
 #if !defined(ASIO_NO_TS_EXECUTORS)
 template <typename Allocator, unsigned int Bits>
 inline thread_pool& thread_pool::basic_executor_type<
@@ -251,7 +313,7 @@ void thread_pool::basic_executor_type<Allocator, Bits>::dispatch(
   typedef decay_t<Function> function_type;
 
   // Invoke immediately if we are already inside the thread pool.
-  if (pool_->scheduler_.can_dispatch())
+  if (pool_->scheduler_.can_dispatch_inline())
   {
     // Make a local, non-const copy of the function.
     function_type tmp(static_cast<Function&&>(f));
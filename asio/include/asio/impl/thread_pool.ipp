@@ -18,6 +18,9 @@
 #include "asio/detail/config.hpp"
 #include <stdexcept>
 #include "asio/thread_pool.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/thread.hpp"
+#include "asio/detail/thread_affinity.hpp"
 #include "asio/detail/throw_exception.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -27,15 +30,25 @@ namespace asio {
 struct thread_pool::thread_function
 {
   detail::scheduler* scheduler_;
+  const placement* placement_;
+  std::size_t index_;
+  thread_pool* pool_;
+  elastic_thread* elastic_thread_;
 
   void operator()()
   {
+    if (placement_)
+      placement_->apply(index_);
+
 #if !defined(ASIO_NO_EXCEPTIONS)
     try
     {
 #endif// !defined(ASIO_NO_EXCEPTIONS)
       asio::error_code ec;
-      scheduler_->run(ec);
+      if (elastic_thread_)
+        scheduler_->run_until_idle(pool_->elastic_->shrink_usec_, ec);
+      else
+        scheduler_->run(ec);
 #if !defined(ASIO_NO_EXCEPTIONS)
     }
     catch (...)
@@ -43,9 +56,64 @@ struct thread_pool::thread_function
       std::terminate();
     }
 #endif// !defined(ASIO_NO_EXCEPTIONS)
+
+    if (elastic_thread_)
+      pool_->retire(elastic_thread_);
+  }
+};
+
+struct thread_pool::elastic_thread
+{
+  elastic_thread(thread_pool* pool, std::size_t index)
+    : next_(pool->elastic_->threads_),
+      finished_(false),
+      thread_(function(pool, this, index))
+  {
+  }
+
+  static thread_function function(thread_pool* pool,
+      elastic_thread* self, std::size_t index)
+  {
+    thread_function f = { &pool->scheduler_,
+      pool->placement_.type_ == placement::unbound ? 0 : &pool->placement_,
+      index, pool, self };
+    return f;
   }
+
+  elastic_thread* next_;
+  bool finished_;
+  detail::thread thread_;
 };
 
+thread_pool::placement thread_pool::placement::all_numa_nodes()
+{
+  std::vector<std::size_t> nodes(detail::numa_node_count());
+  for (std::size_t i = 0; i < nodes.size(); ++i)
+    nodes[i] = i;
+  return placement(by_numa_node,
+      static_cast<std::vector<std::size_t>&&>(nodes));
+}
+
+void thread_pool::placement::apply(std::size_t thread_index) const
+{
+  asio::error_code ec;
+  switch (type_)
+  {
+  case by_processor_set:
+    detail::bind_this_thread_to_processors(ids_.data(), ids_.size(), ec);
+    break;
+  case by_numa_node:
+    if (!ids_.empty())
+    {
+      detail::bind_this_thread_to_numa_node(
+          ids_[thread_index % ids_.size()], ec);
+    }
+    break;
+  default:
+    break;
+  }
+}
+
 #if !defined(ASIO_NO_TS_EXECUTORS)
 
 long thread_pool::default_thread_pool_size()
@@ -97,6 +165,29 @@ thread_pool::thread_pool(std::size_t num_threads,
   start();
 }
 
+thread_pool::thread_pool(std::size_t num_threads, const placement& where)
+  : execution_context(config_from_concurrency_hint(num_threads == 1 ? 1 : 0)),
+    scheduler_(asio::make_service<detail::scheduler>(*this)),
+    threads_(allocator<void>(*this)),
+    num_threads_(clamp_thread_pool_size(num_threads)),
+    joinable_(true),
+    placement_(where)
+{
+  start();
+}
+
+thread_pool::thread_pool(const elastic& limits)
+  : execution_context(
+      config_from_concurrency_hint(limits.max_threads_ == 1 ? 1 : 0)),
+    scheduler_(asio::make_service<detail::scheduler>(*this)),
+    threads_(allocator<void>(*this)),
+    num_threads_(clamp_thread_pool_size(limits.min_threads_)),
+    joinable_(true)
+{
+  start_elastic(limits);
+  start();
+}
+
 thread_pool::~thread_pool()
 {
   stop();
@@ -107,8 +198,82 @@ thread_pool::~thread_pool()
 void thread_pool::start()
 {
   scheduler_.work_started();
-  thread_function f = { &scheduler_ };
-  threads_.create_threads(f, static_cast<std::size_t>(num_threads_));
+  if (placement_.type_ == placement::unbound)
+  {
+    thread_function f = { &scheduler_, 0, 0, this, 0 };
+    threads_.create_threads(f, static_cast<std::size_t>(num_threads_));
+  }
+  else
+  {
+    std::size_t n = static_cast<std::size_t>(num_threads_);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      thread_function f = { &scheduler_, &placement_, i, this, 0 };
+      threads_.create_thread(f);
+    }
+  }
+}
+
+void thread_pool::start_elastic(const elastic& limits)
+{
+  if (limits.max_threads_ > limits.min_threads_)
+  {
+    elastic_.reset(new elastic_state(limits));
+    scheduler_.set_elastic(limits.spin_usec_,
+        limits.grow_usec_, &thread_pool::grow, this);
+  }
+  else
+  {
+    scheduler_.set_elastic(limits.spin_usec_, 0, 0, 0);
+  }
+}
+
+void thread_pool::grow(void* owner)
+{
+  thread_pool* pool = static_cast<thread_pool*>(owner);
+  elastic_state& state = *pool->elastic_;
+  detail::mutex::scoped_lock lock(state.mutex_);
+
+  // Reclaim the threads that have exited.
+  elastic_thread** t = &state.threads_;
+  while (*t)
+  {
+    if ((*t)->finished_)
+    {
+      elastic_thread* tmp = *t;
+      *t = tmp->next_;
+      tmp->thread_.join();
+      detail::deallocate_object(allocator<void>(*pool), tmp);
+    }
+    else
+      t = &(*t)->next_;
+  }
+
+  std::size_t n = static_cast<std::size_t>(pool->num_threads_);
+  if (state.stopped_ || n >= state.max_threads_)
+    return;
+
+#if !defined(ASIO_NO_EXCEPTIONS)
+  try
+  {
+#endif// !defined(ASIO_NO_EXCEPTIONS)
+    state.threads_ = detail::allocate_object<elastic_thread>(
+        allocator<void>(*pool), pool, n);
+    ++pool->num_threads_;
+#if !defined(ASIO_NO_EXCEPTIONS)
+  }
+  catch (...)
+  {
+    // The pool continues with its existing threads.
+  }
+#endif// !defined(ASIO_NO_EXCEPTIONS)
+}
+
+void thread_pool::retire(elastic_thread* t)
+{
+  detail::mutex::scoped_lock lock(elastic_->mutex_);
+  t->finished_ = true;
+  --num_threads_;
 }
 
 void thread_pool::stop()
@@ -119,7 +284,7 @@ void thread_pool::stop()
 void thread_pool::attach()
 {
   ++num_threads_;
-  thread_function f = { &scheduler_ };
+  thread_function f = { &scheduler_, 0, 0, this, 0 };
   f();
 }
 
@@ -130,6 +295,34 @@ void thread_pool::join()
     joinable_ = false;
     scheduler_.work_finished();
     threads_.join();
+    if (elastic_.get())
+      join_elastic_threads();
+  }
+}
+
+void thread_pool::join_elastic_threads()
+{
+  for (;;)
+  {
+    elastic_thread* threads;
+    {
+      detail::mutex::scoped_lock lock(elastic_->mutex_);
+      threads = elastic_->threads_;
+      elastic_->threads_ = 0;
+      if (!threads)
+      {
+        elastic_->stopped_ = true;
+        return;
+      }
+    }
+
+    while (threads)
+    {
+      elastic_thread* tmp = threads;
+      threads = tmp->next_;
+      tmp->thread_.join();
+      detail::deallocate_object(allocator<void>(*this), tmp);
+    }
   }
 }
 
@@ -492,6 +492,89 @@ private:
   return_type future_;
 };
 
+// Return value from use_future::operator() when passed a future_slot.
+template <typename T>
+class future_slot_token
+{
+public:
+  explicit future_slot_token(future_slot<T>& slot)
+    : slot_(&slot)
+  {
+  }
+
+//private:
+  future_slot<T>* slot_;
+};
+
+// Completion handlers produced from the use_future completion token, when
+// passed a future_slot. The arguments are mapped to the slot's value in the
+// same way that promise_handler maps them to a promise.
+template <typename T>
+class future_slot_handler
+{
+public:
+  typedef void result_type;
+
+  explicit future_slot_handler(future_slot_token<T> token)
+    : slot_(token.slot_)
+  {
+  }
+
+  void operator()()
+  {
+    slot_->set_value();
+  }
+
+  template <typename Arg0, typename... ArgN>
+  void operator()(Arg0&& arg0, ArgN&&... argn)
+  {
+    this->complete(is_disposition<decay_t<Arg0>>(),
+        static_cast<Arg0&&>(arg0), static_cast<ArgN&&>(argn)...);
+  }
+
+private:
+  template <typename Disposition, typename... Args>
+  void complete(true_type, Disposition&& d, Args&&... args)
+  {
+    if (d != no_error)
+    {
+      slot_->set_exception(
+          (to_exception_ptr)(static_cast<Disposition&&>(d)));
+    }
+    else
+      this->set_result(static_cast<Args&&>(args)...);
+  }
+
+  template <typename... Args>
+  void complete(false_type, Args&&... args)
+  {
+    this->set_result(static_cast<Args&&>(args)...);
+  }
+
+  void set_result()
+  {
+    slot_->set_value();
+  }
+
+  template <typename Arg>
+  void set_result(Arg&& arg)
+  {
+    slot_->set_value(static_cast<Arg&&>(arg));
+  }
+
+  template <typename Arg0, typename Arg1, typename... ArgN>
+  void set_result(Arg0&& arg0, Arg1&& arg1, ArgN&&... argn)
+  {
+    slot_->set_value(
+        std::forward_as_tuple(
+          static_cast<Arg0&&>(arg0),
+          static_cast<Arg1&&>(arg1),
+          static_cast<ArgN&&>(argn)...));
+  }
+
+  future_slot<T>* slot_;
+};
+
 } // namespace detail
 
 template <typename Allocator> template <typename Function>
@@ -502,6 +585,13 @@ use_future_t<Allocator>::operator()(Function&& f) const
       static_cast<Function&&>(f), allocator_);
 }
 
+template <typename Allocator> template <typename T>
+inline detail::future_slot_token<T>
+use_future_t<Allocator>::operator()(future_slot<T>& slot) const
+{
+  return detail::future_slot_token<T>(slot);
+}
+
 #if !defined(GENERATING_DOCUMENTATION)
 
 template <typename Allocator, typename Result, typename... Args>
@@ -535,6 +625,28 @@ public:
   }
 };
 
+template <typename T, typename Result, typename... Args>
+class async_result<detail::future_slot_token<T>, Result(Args...)>
+{
+public:
+  static_assert(
+      is_same<std::future<T>,
+        typename detail::promise_handler_selector<
+          void(decay_t<Args>...)>::future_type>::value,
+      "future_slot value type must match the operation's result");
+
+  typedef detail::future_slot_handler<T> completion_handler_type;
+  typedef void return_type;
+
+  explicit async_result(completion_handler_type&)
+  {
+  }
+
+  void get()
+  {
+  }
+};
+
 namespace traits {
 
 #if !defined(ASIO_HAS_DEDUCED_EQUALITY_COMPARABLE_TRAIT)
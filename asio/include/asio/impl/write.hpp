@@ -33,6 +33,11 @@
 
 namespace asio {
 
+#if defined(ASIO_HAS_SOCKET_SEND_ALL)
+template <typename Protocol, typename Executor>
+class basic_stream_socket;
+#endif // defined(ASIO_HAS_SOCKET_SEND_ALL)
+
 namespace detail
 {
   template <typename SyncWriteStream, typename ConstBufferSequence,
@@ -417,6 +422,21 @@ namespace detail
           asio::error_code(), 0, 1);
   }
 
+#if defined(ASIO_HAS_SOCKET_SEND_ALL)
+  // When all of the data is to be written to a stream socket, partial sends
+  // are continued by the socket's backend. This avoids a round trip through
+  // the scheduler for each partial transfer.
+  template <typename Protocol, typename Executor,
+      typename ConstBufferSequence, typename ConstBufferIterator,
+      typename WriteHandler>
+  inline void start_write_op(basic_stream_socket<Protocol, Executor>& stream,
+      const ConstBufferSequence& buffers, const ConstBufferIterator&,
+      transfer_all_t&, WriteHandler& handler)
+  {
+    stream.async_send_all(buffers, static_cast<WriteHandler&&>(handler));
+  }
+#endif // defined(ASIO_HAS_SOCKET_SEND_ALL)
+
   template <typename AsyncWriteStream>
   class initiate_async_write
   {
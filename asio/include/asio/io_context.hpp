@@ -27,6 +27,7 @@
 #include "asio/error_code.hpp"
 #include "asio/execution.hpp"
 #include "asio/execution_context.hpp"
+#include "asio/latency_histogram.hpp"
 
 #if defined(ASIO_WINDOWS) || defined(__CYGWIN__)
 # include "asio/detail/winsock_init.hpp"
@@ -58,8 +59,44 @@ namespace detail {
     static constexpr uintptr_t blocking_never = 1;
     static constexpr uintptr_t relationship_continuation = 2;
     static constexpr uintptr_t outstanding_work_tracked = 4;
+    static constexpr uintptr_t prioritised = 8;
     static constexpr uintptr_t runtime_bits = 3;
   };
+
+  // Holds the allocator of an io_context executor and, for executor types to
+  // which the priority property has been applied, the priority. Other executor
+  // types do not pay for the priority's storage.
+  template <typename Allocator, bool Prioritised>
+  struct io_context_executor_storage : Allocator
+  {
+    io_context_executor_storage(const Allocator& a,
+        unsigned int priority) noexcept
+      : Allocator(a),
+        priority_(priority)
+    {
+    }
+
+    unsigned int priority_value() const noexcept
+    {
+      return priority_;
+    }
+
+    unsigned int priority_;
+  };
+
+  template <typename Allocator>
+  struct io_context_executor_storage<Allocator, false> : Allocator
+  {
+    io_context_executor_storage(const Allocator& a, unsigned int) noexcept
+      : Allocator(a)
+    {
+    }
+
+    unsigned int priority_value() const noexcept
+    {
+      return 0;
+    }
+  };
 } // namespace detail
 
 /// Provides core I/O functionality.
@@ -218,6 +255,100 @@ public:
   /// The type used to count the number of handlers executed by the context.
   typedef std::size_t count_type;
 
+  /// A snapshot of the counters that describe the activity of an io_context.
+  /**
+   * The counters are maintained only if the io_context is constructed with
+   * the @c "scheduler" / @c "metrics" configuration option set to @c true.
+   * Otherwise they are all zero. Counters are updated using relaxed atomic
+   * operations, so a snapshot taken while the io_context is running may
+   * combine values from slightly different times.
+   */
+  struct metrics_snapshot
+  {
+    /// Whether the io_context maintains its counters.
+    bool enabled;
+
+    /// The number of handlers that have been run. Handlers that a strand runs
+    /// together, one after another, are counted once.
+    uint64_t handlers_run;
+
+    /// The largest number of handlers observed in the io_context's shared
+    /// queue of ready handlers. Handlers in per-thread work queues are not
+    /// included.
+    uint64_t max_queue_depth;
+
+    /// The total time spent running handlers.
+    chrono::nanoseconds handler_time;
+
+    /// The total time spent running the reactor, including time spent
+    /// waiting for events.
+    chrono::nanoseconds reactor_time;
+
+    /// The number of times the reactor has been run.
+    uint64_t reactor_runs;
+
+    /// The total number of events, such as epoll events or io_uring
+    /// completions, obtained by the reactor. Dividing by @c reactor_runs
+    /// gives the average number of events obtained on each wakeup.
+    uint64_t reactor_events;
+
+    /// The number of times submission queue entries have been submitted to the
+    /// kernel, when using the io_uring backend.
+    uint64_t ring_submits;
+
+    /// The total number of submission queue entries submitted to the kernel,
+    /// when using the io_uring backend.
+    uint64_t ring_submitted_entries;
+
+    /// The number of timers that were waiting to expire when the reactor last
+    /// sampled them.
+    uint64_t pending_timers;
+
+    /// The largest number of handlers observed waiting on a strand created
+    /// using asio::strand.
+    uint64_t max_strand_queue_depth;
+  };
+
+  /// The types of asynchronous operation for which latencies are recorded.
+  enum latency_operation
+  {
+    /// Socket receive operations, on stream or datagram sockets.
+    receive_operation,
+
+    /// Socket send operations, on stream or datagram sockets.
+    send_operation,
+
+    /// Socket accept operations.
+    accept_operation,
+
+    /// Socket connect operations.
+    connect_operation,
+
+    /// Timer wait operations.
+    timer_operation,
+
+    /// Functions submitted using post(), defer(), or dispatch() when they
+    /// cannot run immediately.
+    post_operation
+  };
+
+  /// Latency histograms for one type of asynchronous operation.
+  /**
+   * The histograms are recorded only if the program is compiled with
+   * @c ASIO_ENABLE_LATENCY_HISTOGRAMS defined. Otherwise they are empty.
+   */
+  struct operation_latency
+  {
+    /// The time from initiation of each operation until it completed, as
+    /// observed by the reactor, io_uring, or timer queue. For a posted
+    /// function this is always zero.
+    latency_histogram completion;
+
+    /// The time from completion of each operation until its handler was
+    /// invoked, which is spent waiting in the io_context's queues.
+    latency_histogram invocation;
+  };
+
   /// Constructor.
   ASIO_DECL io_context();
 
@@ -473,6 +604,43 @@ public:
    */
   ASIO_DECL void restart();
 
+  /// Obtain a snapshot of the counters that describe the io_context's
+  /// activity.
+  /**
+   * This function may be called from any thread, including while other
+   * threads are running the io_context.
+   *
+   * @par Example
+   * @code asio::io_context io_context(
+   *     asio::config_from_string("scheduler.metrics=1"));
+   * ...
+   * asio::io_context::metrics_snapshot m = io_context.get_metrics();
+   * std::cout << m.reactor_events / (m.reactor_runs ? m.reactor_runs : 1)
+   *   << " events per wakeup\n"; @endcode
+   */
+  ASIO_DECL metrics_snapshot get_metrics();
+
+  /// Obtain the latency histograms for one type of asynchronous operation.
+  /**
+   * This function may be called from any thread, including while other
+   * threads are running the io_context. Comparing the two histograms shows
+   * whether latency is due to the operating system or to queueing within the
+   * io_context.
+   *
+   * Operations are recorded when their handlers are invoked by the
+   * io_context. Operations that are cancelled or abandoned, and functions run
+   * by a strand, are not recorded. Latencies are not recorded on Windows when
+   * using I/O completion ports.
+   *
+   * @par Example
+   * @code asio::io_context::operation_latency l =
+   *   io_context.get_operation_latency(
+   *     asio::io_context::receive_operation);
+   * std::cout << "p99 queueing: "
+   *   << l.invocation.value_at_percentile(99).count() << "ns\n"; @endcode
+   */
+  ASIO_DECL operation_latency get_operation_latency(latency_operation op);
+
 #if !defined(ASIO_NO_DEPRECATED)
   /// (Deprecated: Use asio::bind_executor().) Create a new handler that
   /// automatically dispatches the wrapped handler on the io_context.
@@ -529,12 +697,14 @@ private:
 /// Executor implementation type used to submit functions to an io_context.
 template <typename Allocator, uintptr_t Bits>
 class io_context::basic_executor_type :
-  detail::io_context_bits, Allocator
+  detail::io_context_bits,
+  detail::io_context_executor_storage<Allocator,
+    (Bits & detail::io_context_bits::prioritised) != 0>
 {
 public:
   /// Copy constructor.
   basic_executor_type(const basic_executor_type& other) noexcept
-    : Allocator(static_cast<const Allocator&>(other)),
+    : storage_type(static_cast<const storage_type&>(other)),
       target_(other.target_)
   {
     if (Bits & outstanding_work_tracked)
@@ -544,7 +714,7 @@ public:
 
   /// Move constructor.
   basic_executor_type(basic_executor_type&& other) noexcept
-    : Allocator(static_cast<Allocator&&>(other)),
+    : storage_type(static_cast<storage_type&&>(other)),
       target_(other.target_)
   {
     if (Bits & outstanding_work_tracked)
@@ -584,7 +754,7 @@ private:
   constexpr basic_executor_type require(execution::blocking_t::possibly_t) const
   {
     return basic_executor_type(context_ptr(),
-        *this, bits() & ~blocking_never);
+        *this, bits() & ~blocking_never, this->priority_value());
   }
 
   /// Obtain an executor with the @c blocking.never property.
@@ -600,7 +770,7 @@ private:
   constexpr basic_executor_type require(execution::blocking_t::never_t) const
   {
     return basic_executor_type(context_ptr(),
-        *this, bits() | blocking_never);
+        *this, bits() | blocking_never, this->priority_value());
   }
 
   /// Obtain an executor with the @c relationship.fork property.
@@ -616,7 +786,7 @@ private:
   constexpr basic_executor_type require(execution::relationship_t::fork_t) const
   {
     return basic_executor_type(context_ptr(),
-        *this, bits() & ~relationship_continuation);
+        *this, bits() & ~relationship_continuation, this->priority_value());
   }
 
   /// Obtain an executor with the @c relationship.continuation property.
@@ -633,7 +803,7 @@ private:
       execution::relationship_t::continuation_t) const
   {
     return basic_executor_type(context_ptr(),
-        *this, bits() | relationship_continuation);
+        *this, bits() | relationship_continuation, this->priority_value());
   }
 
   /// Obtain an executor with the @c outstanding_work.tracked property.
@@ -651,7 +821,7 @@ private:
   require(execution::outstanding_work_t::tracked_t) const
   {
     return basic_executor_type<Allocator, Bits | outstanding_work_tracked>(
-        context_ptr(), *this, bits());
+        context_ptr(), *this, bits(), this->priority_value());
   }
 
   /// Obtain an executor with the @c outstanding_work.untracked property.
@@ -669,7 +839,7 @@ private:
   require(execution::outstanding_work_t::untracked_t) const
   {
     return basic_executor_type<Allocator, Bits & ~outstanding_work_tracked>(
-        context_ptr(), *this, bits());
+        context_ptr(), *this, bits(), this->priority_value());
   }
 
   /// Obtain an executor with the specified @c allocator property.
@@ -687,7 +857,7 @@ private:
   require(execution::allocator_t<OtherAllocator> a) const
   {
     return basic_executor_type<OtherAllocator, Bits>(
-        context_ptr(), a.value(), bits());
+        context_ptr(), a.value(), bits(), this->priority_value());
   }
 
   /// Obtain an executor with the default @c allocator property.
@@ -703,8 +873,31 @@ private:
   constexpr basic_executor_type<std::allocator<void>, Bits>
   require(execution::allocator_t<void>) const
   {
-    return basic_executor_type<std::allocator<void>, Bits>(
-        context_ptr(), std::allocator<void>(), bits());
+    return basic_executor_type<std::allocator<void>, Bits>(context_ptr(),
+        std::allocator<void>(), bits(), this->priority_value());
+  }
+
+  /// Obtain an executor with the specified @c priority property.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * asio::prefer customisation point.
+   *
+   * Function objects submitted through the resulting executor are delivered
+   * from the io_context's priority lanes, if these have been enabled using the
+   * @c scheduler.priority_levels configuration option. Otherwise, the priority
+   * is ignored.
+   *
+   * For example:
+   * @code auto ex1 = my_io_context.get_executor();
+   * auto ex2 = asio::prefer(ex1,
+   *     asio::execution::priority(1)); @endcode
+   */
+  constexpr basic_executor_type<Allocator,
+      ASIO_UNSPECIFIED(Bits | prioritised)>
+  require(execution::priority_t p) const
+  {
+    return basic_executor_type<Allocator, Bits | prioritised>(
+        context_ptr(), *this, bits(), p.value());
   }
 
 #if !defined(GENERATING_DOCUMENTATION)
@@ -833,6 +1026,21 @@ private:
     return static_cast<const Allocator&>(*this);
   }
 
+  /// Query the current value of the @c priority property.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * asio::query customisation point.
+   *
+   * For example:
+   * @code auto ex = my_io_context.get_executor();
+   * unsigned int p = asio::query(ex,
+   *     asio::execution::priority); @endcode
+   */
+  unsigned int query(execution::priority_t) const noexcept
+  {
+    return this->priority_value();
+  }
+
 public:
   /// Determine whether the io_context is running in the current thread.
   /**
@@ -849,7 +1057,8 @@ public:
       const basic_executor_type& b) noexcept
   {
     return a.target_ == b.target_
-      && static_cast<const Allocator&>(a) == static_cast<const Allocator&>(b);
+      && static_cast<const Allocator&>(a) == static_cast<const Allocator&>(b)
+      && a.priority_value() == b.priority_value();
   }
 
   /// Compare two executors for inequality.
@@ -860,13 +1069,32 @@ public:
       const basic_executor_type& b) noexcept
   {
     return a.target_ != b.target_
-      || static_cast<const Allocator&>(a) != static_cast<const Allocator&>(b);
+      || static_cast<const Allocator&>(a) != static_cast<const Allocator&>(b)
+      || a.priority_value() != b.priority_value();
   }
 
   /// Execution function.
   template <typename Function>
   void execute(Function&& f) const;
 
+  /// Request the io_context to execute each function object in a range.
+  /**
+   * This function is used to ask the io_context to execute the function
+   * objects in the given range. None of the function objects will be executed
+   * inside @c post_batch(), regardless of the executor's blocking property.
+   *
+   * All of the function objects are added to the io_context's queue together,
+   * in a single operation, and up to one idle thread is woken for each of
+   * them. This avoids the synchronisation cost of submitting each function
+   * object separately.
+   *
+   * @param fs A range of function objects, each of which is called as if by
+   * <tt>f()</tt>. The function objects are moved from, unless the range is
+   * const, in which case they are copied.
+   */
+  template <typename Range>
+  void post_batch(Range&& fs) const;
+
 #if !defined(ASIO_NO_TS_EXECUTORS)
 public:
   /// Obtain the underlying execution context.
@@ -946,9 +1174,13 @@ private:
   friend class io_context;
   template <typename, uintptr_t> friend class basic_executor_type;
 
+  // The base class that holds the allocator and priority.
+  typedef detail::io_context_executor_storage<Allocator,
+    (Bits & prioritised) != 0> storage_type;
+
   // Constructor used by io_context::get_executor().
   explicit basic_executor_type(io_context& i) noexcept
-    : Allocator(),
+    : storage_type(Allocator(), 0),
       target_(reinterpret_cast<uintptr_t>(&i))
   {
     if (Bits & outstanding_work_tracked)
@@ -956,9 +1188,9 @@ private:
   }
 
   // Constructor used by require().
-  basic_executor_type(io_context* i,
-      const Allocator& a, uintptr_t bits) noexcept
-    : Allocator(a),
+  basic_executor_type(io_context* i, const Allocator& a,
+      uintptr_t bits, unsigned int priority) noexcept
+    : storage_type(a, priority),
       target_(reinterpret_cast<uintptr_t>(i) | bits)
   {
     if (Bits & outstanding_work_tracked)
@@ -1165,6 +1397,18 @@ struct require_member<
       OtherAllocator, Bits> result_type;
 };
 
+template <typename Allocator, uintptr_t Bits>
+struct require_member<
+    asio::io_context::basic_executor_type<Allocator, Bits>,
+    asio::execution::priority_t
+  > : asio::detail::io_context_bits
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = false;
+  typedef asio::io_context::basic_executor_type<
+      Allocator, Bits | prioritised> result_type;
+};
+
 #endif // !defined(ASIO_HAS_DEDUCED_REQUIRE_MEMBER_TRAIT)
 
 #if !defined(ASIO_HAS_DEDUCED_QUERY_STATIC_CONSTEXPR_MEMBER_TRAIT)
@@ -1286,6 +1530,17 @@ struct query_member<
   typedef Allocator result_type;
 };
 
+template <typename Allocator, uintptr_t Bits>
+struct query_member<
+    asio::io_context::basic_executor_type<Allocator, Bits>,
+    asio::execution::priority_t
+  >
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = true;
+  typedef unsigned int result_type;
+};
+
 #endif // !defined(ASIO_HAS_DEDUCED_QUERY_MEMBER_TRAIT)
 
 } // namespace traits
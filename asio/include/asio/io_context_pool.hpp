@@ -0,0 +1,356 @@
+//
+// io_context_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IO_CONTEXT_POOL_HPP
+#define ASIO_IO_CONTEXT_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "asio/basic_socket_acceptor.hpp"
+#include "asio/detail/atomic_count.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/socket_types.hpp"
+#include "asio/detail/thread_group.hpp"
+#include "asio/error.hpp"
+#include "asio/executor_work_guard.hpp"
+#include "asio/io_context.hpp"
+#include "asio/socket_base.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A pool of io_context objects, each run by a single thread.
+/**
+ * The io_context_pool class provides the "one io_context per core" model, in
+ * which each io_context is run by its own thread and every I/O object is
+ * served only by the thread that owns it. Since no state is shared between
+ * the threads, handlers need no synchronisation and there is no contention on
+ * a shared scheduler.
+ *
+ * By default, each thread is bound to a separate processor. The pool's
+ * listen() function creates one acceptor for each io_context, all bound to the
+ * same endpoint using the socket_base::reuse_port option, so that the kernel
+ * distributes incoming connections between the threads without waking them
+ * all.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe, with the exception of the join() and drain()
+ * functions, which must not be called at the same time as other calls to
+ * join() or drain().
+ *
+ * @par Example
+ * @code asio::io_context_pool pool;
+ *
+ * std::vector<asio::io_context_pool::acceptor<asio::ip::tcp>> acceptors
+ *   = pool.listen<asio::ip::tcp>(
+ *       asio::ip::tcp::endpoint(asio::ip::tcp::v4(), 8080),
+ *       asio::io_context_pool::distribute_by_cpu);
+ *
+ * for (auto& acceptor : acceptors)
+ *   start_accept(acceptor);
+ *
+ * pool.join(); @endcode
+ */
+class io_context_pool
+  : private noncopyable
+{
+public:
+  /// The type of the executor used by the io_context objects in the pool.
+  typedef io_context::executor_type executor_type;
+
+  /// The type of an acceptor created by listen().
+  template <typename Protocol>
+  using acceptor = basic_socket_acceptor<Protocol, executor_type>;
+
+  /// The strategy used to distribute incoming connections between acceptors.
+  enum distribution
+  {
+    /// The kernel selects an acceptor using a hash of the connection's
+    /// addresses and ports.
+    distribute_by_hash,
+
+    /// Each connection is accepted by the acceptor whose io_context is run on
+    /// the processor that received the connection's packets. Processors are
+    /// matched to acceptors by their number modulo the size of the pool, so
+    /// this is most effective when the pool has one io_context for each
+    /// processor, and network interrupts are spread across the processors.
+    /// Requires Linux.
+    distribute_by_cpu
+  };
+
+  /// The strategy used by get_executor() and get_io_context() to choose an
+  /// io_context.
+  enum load_balancing
+  {
+    /// Choose each io_context in turn.
+    round_robin,
+
+    /// Choose the io_context with the least outstanding work. Outstanding work
+    /// includes each pending asynchronous operation and each queued handler,
+    /// so this favours the io_context serving the fewest active connections.
+    least_outstanding_work,
+
+    /// Choose two io_context objects at random and use the one with less
+    /// outstanding work. This is almost as effective as
+    /// least_outstanding_work, but it examines only two io_context objects
+    /// regardless of the size of the pool.
+    power_of_two_choices
+  };
+
+  /// Constructs a pool with one io_context for each processor.
+  /**
+   * Each thread is bound to a separate processor.
+   */
+  ASIO_DECL io_context_pool();
+
+  /// Constructs a pool with a specified number of io_context objects.
+  /**
+   * @param pool_size The number of io_context objects, and threads, required.
+   *
+   * @param bind_to_processors Whether to bind each thread to a separate
+   * processor. Threads are assigned to the processors on which the process is
+   * permitted to run, in order, wrapping around if there are more threads than
+   * processors. Failure to bind a thread is not reported, and the thread then
+   * runs wherever the operating system schedules it.
+   */
+  ASIO_DECL explicit io_context_pool(std::size_t pool_size,
+      bool bind_to_processors = true);
+
+  /// Constructs a pool with a specified number of io_context objects and a
+  /// load balancing strategy.
+  /**
+   * @param pool_size The number of io_context objects, and threads, required.
+   *
+   * @param lb The strategy used by get_executor() and get_io_context() to
+   * choose an io_context.
+   *
+   * @param bind_to_processors Whether to bind each thread to a separate
+   * processor.
+   */
+  ASIO_DECL io_context_pool(std::size_t pool_size,
+      load_balancing lb, bool bind_to_processors = true);
+
+  /// Destructor.
+  /**
+   * Automatically stops and joins the pool, if not explicitly done beforehand.
+   */
+  ASIO_DECL ~io_context_pool();
+
+  /// Get the number of io_context objects in the pool.
+  std::size_t size() const noexcept
+  {
+    return contexts_.size();
+  }
+
+  /// Get the io_context at the specified position in the pool.
+  /**
+   * @param index The position of the io_context, which must be less than
+   * size().
+   */
+  io_context& get_io_context(std::size_t index) noexcept
+  {
+    return *contexts_[index];
+  }
+
+  /// Get an executor for the io_context at the specified position in the pool.
+  /**
+   * @param index The position of the io_context, which must be less than
+   * size().
+   */
+  executor_type get_executor(std::size_t index) noexcept
+  {
+    return contexts_[index]->get_executor();
+  }
+
+  /// Get an io_context chosen by the pool's load balancing strategy.
+  /**
+   * This function is used to distribute I/O objects that are not created by
+   * listen(). An io_context that is being drained is not chosen, unless every
+   * io_context in the pool is being drained.
+   */
+  io_context& get_io_context() noexcept
+  {
+    return *contexts_[choose()];
+  }
+
+  /// Get an executor for an io_context chosen by the pool's load balancing
+  /// strategy.
+  /**
+   * With the default round_robin strategy, successive calls return executors
+   * for each io_context in turn. An io_context that is being drained is not
+   * chosen, unless every io_context in the pool is being drained.
+   */
+  executor_type get_executor() noexcept
+  {
+    return contexts_[choose()]->get_executor();
+  }
+
+  /// Get the amount of outstanding work for the io_context at the specified
+  /// position in the pool.
+  /**
+   * @param index The position of the io_context, which must be less than
+   * size().
+   *
+   * @returns The number of pending asynchronous operations, queued handlers
+   * and work guards, including the pool's own work guard if the io_context is
+   * not being drained. The value may be out of date as soon as it is returned.
+   */
+  ASIO_DECL std::size_t outstanding_work(std::size_t index) const noexcept;
+
+  /// Drain the io_context at the specified position in the pool.
+  /**
+   * This function stops the pool from choosing the io_context for new work,
+   * and releases the work that keeps it running. Its thread exits once its
+   * existing work, such as the connections it serves, has completed. The
+   * io_context may still be used explicitly through get_io_context(index) or
+   * get_executor(index) while it has outstanding work.
+   *
+   * This function must not be called at the same time as join().
+   *
+   * @param index The position of the io_context, which must be less than
+   * size().
+   */
+  ASIO_DECL void drain(std::size_t index);
+
+  /// Drain all of the io_context objects in the pool.
+  /**
+   * This function releases the work that keeps the io_context objects
+   * running, so that each thread exits once its io_context has no outstanding
+   * work. Unlike stop(), pending handlers are still invoked. The function
+   * does not block. Call join() to wait for the threads to exit.
+   *
+   * This function must not be called at the same time as join().
+   */
+  ASIO_DECL void drain();
+
+  /// Stop the io_context objects in the pool.
+  /**
+   * This function stops each io_context as soon as possible. As a result of
+   * calling @c stop(), pending handlers may never be invoked.
+   */
+  ASIO_DECL void stop();
+
+  /// Joins the threads.
+  /**
+   * This function blocks until the threads in the pool have completed. If
+   * stop() is not called prior to @c join(), the @c join() call will wait
+   * until no io_context in the pool has outstanding work.
+   */
+  ASIO_DECL void join();
+
+  /// Create one acceptor for each io_context, all listening on an endpoint.
+  /**
+   * This function opens an acceptor for each io_context in the pool, sets the
+   * socket_base::reuse_address and socket_base::reuse_port options, binds it
+   * to the specified endpoint and puts it in the listening state. The
+   * acceptor at position @c i of the result uses the io_context at position
+   * @c i of the pool.
+   *
+   * @param endpoint The endpoint on which to listen.
+   *
+   * @param dist The strategy for distributing connections between the
+   * acceptors.
+   *
+   * @param backlog The maximum length of each acceptor's queue of pending
+   * connections.
+   *
+   * @returns The acceptors, in pool order.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename Protocol>
+  std::vector<acceptor<Protocol>> listen(
+      const typename Protocol::endpoint& endpoint,
+      distribution dist = distribute_by_hash,
+      int backlog = socket_base::max_listen_connections);
+
+  /// Create one acceptor for each io_context, all listening on an endpoint.
+  /**
+   * This function opens an acceptor for each io_context in the pool, sets the
+   * socket_base::reuse_address and socket_base::reuse_port options, binds it
+   * to the specified endpoint and puts it in the listening state. The
+   * acceptor at position @c i of the result uses the io_context at position
+   * @c i of the pool.
+   *
+   * @param endpoint The endpoint on which to listen.
+   *
+   * @param dist The strategy for distributing connections between the
+   * acceptors.
+   *
+   * @param backlog The maximum length of each acceptor's queue of pending
+   * connections.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The acceptors, in pool order. Empty if an error occurred.
+   */
+  template <typename Protocol>
+  std::vector<acceptor<Protocol>> listen(
+      const typename Protocol::endpoint& endpoint,
+      distribution dist, int backlog, asio::error_code& ec);
+
+private:
+  struct thread_function;
+
+  // Start the threads in the pool.
+  ASIO_DECL void start(bool bind_to_processors);
+
+  // Choose an io_context using the load balancing strategy.
+  ASIO_DECL std::size_t choose() noexcept;
+
+  // Determine whether the io_context at the specified position is draining.
+  bool is_draining(std::size_t index) const noexcept
+  {
+    return static_cast<long>(draining_[index]) != 0;
+  }
+
+  // Attach a program that steers each connection to the socket whose index in
+  // the reuseport group matches the receiving processor.
+  ASIO_DECL static void attach_cpu_distribution(
+      detail::socket_type handle,
+      std::size_t num_sockets, asio::error_code& ec);
+
+  // The io_context objects in the pool.
+  std::vector<std::unique_ptr<io_context>> contexts_;
+
+  // Work that keeps each io_context running until the pool is joined.
+  std::vector<executor_work_guard<executor_type>> work_;
+
+  // The threads in the pool.
+  detail::thread_group<std::allocator<void>> threads_;
+
+  // The position of the io_context for the next call to get_executor().
+  detail::atomic_count next_context_;
+
+  // The strategy used to choose an io_context.
+  load_balancing load_balancing_;
+
+  // Flags that are set for each io_context that is being drained.
+  std::unique_ptr<detail::atomic_count[]> draining_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/io_context_pool.hpp"
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/impl/io_context_pool.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_IO_CONTEXT_POOL_HPP
@@ -0,0 +1,188 @@
+//
+// io_uring_capabilities.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IO_URING_CAPABILITIES_HPP
+#define ASIO_IO_URING_CAPABILITIES_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/execution_context.hpp"
+
+#if defined(ASIO_HAS_IO_URING)
+# include "asio/io_context.hpp"
+# include "asio/detail/io_uring_service.hpp"
+#endif // defined(ASIO_HAS_IO_URING)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// The io_uring features supported by the running kernel.
+/**
+ * The io_uring_capabilities class reports the features that were detected when
+ * an execution context's io_uring instance was created. The detection is
+ * performed at run time, so that a single program makes use of the features
+ * of newer kernels while continuing to run on older ones.
+ *
+ * Features that are not supported are not used. The
+ * socket_base::multishot_accept and socket_base::zero_copy options are ignored,
+ * and sockets use the ordinary accept and send operations. Without fast poll,
+ * socket operations wait for readiness and then perform non-blocking system
+ * calls, rather than occupying a kernel worker thread. Creating a
+ * provided_buffer_ring fails with asio::error::operation_not_supported when
+ * buffer rings are not supported, and a multishot receive fails with the same
+ * error when that is not supported. Without support for closing or shutting
+ * down sockets, the async_close and async_shutdown functions perform the
+ * operation immediately and then post the completion handler.
+ *
+ * All features are reported as unsupported when io_uring is not available.
+ *
+ * @par Example
+ * @code asio::io_uring_capabilities caps(io_context);
+ * if (caps.zero_copy_send())
+ *   socket.set_option(asio::socket_base::zero_copy(true)); @endcode
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ */
+class io_uring_capabilities
+{
+public:
+  /// Query the features supported by an execution context's io_uring instance.
+  /**
+   * When io_uring is available, this creates the execution context's io_uring
+   * instance if it does not already exist.
+   *
+   * @throws asio::system_error Thrown on failure to create the io_uring
+   * instance.
+   */
+  explicit io_uring_capabilities(execution_context& context)
+    : capabilities_(query(context))
+  {
+  }
+
+  /// Whether io_uring is available.
+  static constexpr bool available() noexcept
+  {
+#if defined(ASIO_HAS_IO_URING)
+    return true;
+#else // defined(ASIO_HAS_IO_URING)
+    return false;
+#endif // defined(ASIO_HAS_IO_URING)
+  }
+
+  /// Whether the kernel polls for readiness internally when a socket operation
+  /// cannot complete immediately.
+  bool fast_poll() const noexcept
+  {
+    return has(fast_poll_bit);
+  }
+
+  /// Whether a single submission may accept multiple connections.
+  bool multishot_accept() const noexcept
+  {
+    return has(multishot_accept_bit);
+  }
+
+  /// Whether a single submission may receive multiple times into provided
+  /// buffers.
+  bool multishot_receive() const noexcept
+  {
+    return has(multishot_recv_bit);
+  }
+
+  /// Whether data may be sent without being copied.
+  bool zero_copy_send() const noexcept
+  {
+    return has(send_zc_bit);
+  }
+
+  /// Whether rings of provided buffers may be registered.
+  bool provided_buffer_rings() const noexcept
+  {
+    return has(buffer_ring_bit);
+  }
+
+  /// Whether a ring may send messages to another ring.
+  bool ring_messages() const noexcept
+  {
+    return has(msg_ring_bit);
+  }
+
+  /// Whether descriptors may be closed by the kernel, without blocking the
+  /// calling thread, when a socket's async_close function is used.
+  bool async_close() const noexcept
+  {
+    return has(close_bit);
+  }
+
+  /// Whether sockets may be shut down by the kernel when a socket's
+  /// async_shutdown function is used.
+  bool async_shutdown() const noexcept
+  {
+    return has(shutdown_bit);
+  }
+
+private:
+#if defined(ASIO_HAS_IO_URING)
+  typedef detail::io_uring_service service_type;
+
+  enum
+  {
+    fast_poll_bit = service_type::fast_poll_capability,
+    multishot_accept_bit = service_type::multishot_accept_capability,
+    multishot_recv_bit = service_type::multishot_recv_capability,
+    send_zc_bit = service_type::send_zc_capability,
+    buffer_ring_bit = service_type::buffer_ring_capability,
+    msg_ring_bit = service_type::msg_ring_capability,
+    close_bit = service_type::close_capability,
+    shutdown_bit = service_type::shutdown_capability
+  };
+#else // defined(ASIO_HAS_IO_URING)
+  enum
+  {
+    fast_poll_bit = 1,
+    multishot_accept_bit = 2,
+    multishot_recv_bit = 4,
+    send_zc_bit = 8,
+    buffer_ring_bit = 16,
+    msg_ring_bit = 32,
+    close_bit = 64,
+    shutdown_bit = 128
+  };
+#endif // defined(ASIO_HAS_IO_URING)
+
+  static int query(execution_context& context)
+  {
+#if defined(ASIO_HAS_IO_URING)
+    return use_service<service_type>(context).capabilities();
+#else // defined(ASIO_HAS_IO_URING)
+    (void)context;
+    return 0;
+#endif // defined(ASIO_HAS_IO_URING)
+  }
+
+  bool has(int capability) const noexcept
+  {
+    return (capabilities_ & capability) != 0;
+  }
+
+  int capabilities_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IO_URING_CAPABILITIES_HPP
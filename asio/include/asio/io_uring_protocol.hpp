@@ -0,0 +1,107 @@
+//
+// io_uring_protocol.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IO_URING_PROTOCOL_HPP
+#define ASIO_IO_URING_PROTOCOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/default_socket_service.hpp"
+
+#if defined(ASIO_HAS_IO_URING)
+# include "asio/detail/io_uring_socket_service.hpp"
+#endif // defined(ASIO_HAS_IO_URING)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Adapts a protocol so that its sockets and acceptors use io_uring.
+/**
+ * When the library is built with io_uring support (@c ASIO_HAS_IO_URING) and
+ * epoll is also enabled, io_uring is used only for files, and sockets use the
+ * epoll reactor. Sockets and acceptors of an io_uring_protocol type instead
+ * perform their operations using io_uring, so that the io_uring socket
+ * implementation can be used for a subset of the connections in a process.
+ * Where io_uring is not available, or is already the default backend,
+ * sockets of the adapted protocol use the same implementation as those of the
+ * underlying protocol.
+ *
+ * An io_uring_protocol object may be constructed from an object of the
+ * underlying protocol, and so may be passed wherever the underlying protocol
+ * is used to open a socket. The adapted protocol uses the same endpoint type.
+ *
+ * @par Example
+ * Accepting a fraction of connections into sockets that use io_uring:
+ * @code typedef asio::basic_stream_socket<
+ *     asio::io_uring_protocol<asio::ip::tcp>> uring_socket;
+ *
+ * if (use_io_uring)
+ * {
+ *   uring_socket socket(io_context);
+ *   acceptor.accept(socket);
+ *   ...
+ * }
+ * else
+ * {
+ *   asio::ip::tcp::socket socket(io_context);
+ *   acceptor.accept(socket);
+ *   ...
+ * } @endcode
+ */
+template <typename Protocol>
+class io_uring_protocol
+  : public Protocol
+{
+public:
+  /// The underlying protocol type.
+  typedef Protocol protocol_type;
+
+  /// The type of an endpoint.
+  typedef typename Protocol::endpoint endpoint;
+
+  /// Construct from an object of the underlying protocol.
+  io_uring_protocol(const Protocol& protocol) noexcept
+    : Protocol(protocol)
+  {
+  }
+
+  /// Whether sockets of the adapted protocol use io_uring.
+#if defined(ASIO_HAS_IO_URING)
+  static constexpr bool uses_io_uring = true;
+#else // defined(ASIO_HAS_IO_URING)
+  static constexpr bool uses_io_uring = false;
+#endif // defined(ASIO_HAS_IO_URING)
+};
+
+#if !defined(GENERATING_DOCUMENTATION)
+#if defined(ASIO_HAS_IO_URING)
+
+namespace detail {
+
+template <typename Protocol>
+struct default_socket_service<io_uring_protocol<Protocol>>
+{
+  typedef io_uring_socket_service<io_uring_protocol<Protocol>> type;
+};
+
+} // namespace detail
+
+#endif // defined(ASIO_HAS_IO_URING)
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IO_URING_PROTOCOL_HPP
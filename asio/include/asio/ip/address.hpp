@@ -47,6 +47,14 @@ namespace ip {
 class address
 {
 public:
+  /// The maximum number of characters in the string form of an address.
+#if defined(GENERATING_DOCUMENTATION)
+  static const std::size_t max_string_length = 78;
+#else
+  ASIO_STATIC_CONSTANT(std::size_t,
+      max_string_length = address_v6::max_string_length);
+#endif
+
   /// Default constructor.
   ASIO_DECL address() noexcept;
 
@@ -206,6 +214,54 @@ ASIO_DECL address make_address(string_view str,
 #endif // defined(ASIO_HAS_STRING_VIEW)
        //  || defined(GENERATING_DOCUMENTATION)
 
+/// Write an address to a character range.
+/**
+ * The address is written in the same form as address::to_string(), but
+ * without allocating memory. No null terminator is written.
+ *
+ * @param first The beginning of the range to which the address is written.
+ *
+ * @param last The end of the range. A range of address::max_string_length
+ * characters is always large enough.
+ *
+ * @param addr The address to be written.
+ *
+ * @param ec Set to asio::error::no_buffer_space if the range is too
+ * small.
+ *
+ * @returns A pointer to the end of the characters written, or @c first if an
+ * error occurred.
+ *
+ * @relates address
+ */
+ASIO_DECL char* to_chars(char* first, char* last,
+    const address& addr, asio::error_code& ec) noexcept;
+
+/// Read an IPv4 or IPv6 address from a character range.
+/**
+ * An address in dotted decimal form is read as an IPv4 address. Otherwise,
+ * the characters are read as an IPv6 address. The address may be followed by
+ * other characters. Unlike make_address(), this function does not allocate
+ * memory.
+ *
+ * @param first The beginning of the range from which the address is read.
+ *
+ * @param last The end of the range.
+ *
+ * @param addr Set to the address that was read. Unchanged if an error
+ * occurred.
+ *
+ * @param ec Set to asio::error::invalid_argument if the range does not begin
+ * with a valid address.
+ *
+ * @returns A pointer to the first character that was not parsed, or @c first
+ * if an error occurred.
+ *
+ * @relates address
+ */
+ASIO_DECL const char* from_chars(const char* first, const char* last,
+    address& addr, asio::error_code& ec) noexcept;
+
 #if !defined(ASIO_NO_IOSTREAM)
 
 /// Output an address as a string.
@@ -60,6 +60,13 @@ public:
   typedef asio::detail::array<unsigned char, 4> bytes_type;
 #endif
 
+  /// The maximum number of characters in the string form of an address.
+#if defined(GENERATING_DOCUMENTATION)
+  static const std::size_t max_string_length = 15;
+#else
+  ASIO_STATIC_CONSTANT(std::size_t, max_string_length = 15);
+#endif
+
   /// Default constructor.
   /**
    * Initialises the @c address_v4 object such that:
@@ -318,6 +325,54 @@ ASIO_DECL address_v4 make_address_v4(string_view str,
 #endif // defined(ASIO_HAS_STRING_VIEW)
        //  || defined(GENERATING_DOCUMENTATION)
 
+/// Write an IPv4 address to a character range in dotted decimal form.
+/**
+ * Unlike address_v4::to_string(), this function does not allocate memory. No
+ * null terminator is written.
+ *
+ * @param first The beginning of the range to which the address is written.
+ *
+ * @param last The end of the range. A range of address_v4::max_string_length
+ * characters is always large enough.
+ *
+ * @param addr The address to be written.
+ *
+ * @param ec Set to asio::error::no_buffer_space if the range is too
+ * small.
+ *
+ * @returns A pointer to the end of the characters written, or @c first if an
+ * error occurred.
+ *
+ * @relates address_v4
+ */
+ASIO_DECL char* to_chars(char* first, char* last,
+    const address_v4& addr, asio::error_code& ec) noexcept;
+
+/// Read an IPv4 address in dotted decimal form from a character range.
+/**
+ * This function parses the longest sequence of digits and dots at the start
+ * of the range. The range does not need to be null terminated, and the
+ * address may be followed by other characters, such as a port number. Unlike
+ * make_address_v4(), this function does not allocate memory.
+ *
+ * @param first The beginning of the range from which the address is read.
+ *
+ * @param last The end of the range.
+ *
+ * @param addr Set to the address that was read. Unchanged if an error
+ * occurred.
+ *
+ * @param ec Set to asio::error::invalid_argument if the range does not begin
+ * with a valid address.
+ *
+ * @returns A pointer to the first character that was not parsed, or @c first
+ * if an error occurred.
+ *
+ * @relates address_v4
+ */
+ASIO_DECL const char* from_chars(const char* first, const char* last,
+    address_v4& addr, asio::error_code& ec) noexcept;
+
 #if !defined(ASIO_NO_IOSTREAM)
 
 /// Output an address as a string.
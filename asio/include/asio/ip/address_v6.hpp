@@ -63,6 +63,14 @@ public:
   typedef asio::detail::array<unsigned char, 16> bytes_type;
 #endif
 
+  /// The maximum number of characters in the string form of an address,
+  /// including any scope id.
+#if defined(GENERATING_DOCUMENTATION)
+  static const std::size_t max_string_length = 78;
+#else
+  ASIO_STATIC_CONSTANT(std::size_t, max_string_length = 78);
+#endif
+
   /// Default constructor.
   /**
    * Initialises the @c address_v6 object such that:
@@ -284,6 +292,57 @@ ASIO_DECL address_v6 make_address_v6(string_view str,
 #endif // defined(ASIO_HAS_STRING_VIEW)
        //  || defined(GENERATING_DOCUMENTATION)
 
+/// Write an IPv6 address to a character range.
+/**
+ * The address is written in the same form as address_v6::to_string(),
+ * including any scope id, but without allocating memory. No null terminator is
+ * written.
+ *
+ * @param first The beginning of the range to which the address is written.
+ *
+ * @param last The end of the range. A range of address_v6::max_string_length
+ * characters is always large enough.
+ *
+ * @param addr The address to be written.
+ *
+ * @param ec Set to asio::error::no_buffer_space if the range is too
+ * small.
+ *
+ * @returns A pointer to the end of the characters written, or @c first if an
+ * error occurred.
+ *
+ * @relates address_v6
+ */
+ASIO_DECL char* to_chars(char* first, char* last,
+    const address_v6& addr, asio::error_code& ec) noexcept;
+
+/// Read an IPv6 address from a character range.
+/**
+ * This function parses the longest sequence of characters at the start of the
+ * range that may form an IPv6 address, followed by an optional scope id
+ * introduced by a '%' character. The range does not need to be null
+ * terminated, and the address may be followed by other characters, such as a
+ * closing bracket. Unlike make_address_v6(), this function does not allocate
+ * memory.
+ *
+ * @param first The beginning of the range from which the address is read.
+ *
+ * @param last The end of the range.
+ *
+ * @param addr Set to the address that was read. Unchanged if an error
+ * occurred.
+ *
+ * @param ec Set to asio::error::invalid_argument if the range does not begin
+ * with a valid address.
+ *
+ * @returns A pointer to the first character that was not parsed, or @c first
+ * if an error occurred.
+ *
+ * @relates address_v6
+ */
+ASIO_DECL const char* from_chars(const char* first, const char* last,
+    address_v6& addr, asio::error_code& ec) noexcept;
+
 /// Tag type used for distinguishing overloads that deal in IPv4-mapped IPv6
 /// addresses.
 enum v4_mapped_t { v4_mapped };
@@ -0,0 +1,975 @@
+//
+// ip/basic_connection_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_BASIC_CONNECTION_POOL_HPP
+#define ASIO_IP_BASIC_CONNECTION_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include "asio/any_completion_handler.hpp"
+#include "asio/append.hpp"
+#include "asio/associated_executor.hpp"
+#include "asio/async_result.hpp"
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/buffer.hpp"
+#include "asio/connect.hpp"
+#include "asio/dispatch.hpp"
+#include "asio/error.hpp"
+#include "asio/executor_work_guard.hpp"
+#include "asio/post.hpp"
+#include "asio/wait_traits.hpp"
+#include "asio/ip/caching_resolver.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/string_view.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+
+#if !defined(ASIO_IP_BASIC_CONNECTION_POOL_FWD_DECL)
+#define ASIO_IP_BASIC_CONNECTION_POOL_FWD_DECL
+
+// Forward declaration.
+template <typename Stream>
+class basic_connection_pool;
+
+#endif // !defined(ASIO_IP_BASIC_CONNECTION_POOL_FWD_DECL)
+
+/// Traits that adapt a stream type for use with basic_connection_pool.
+/**
+ * A connection pool calls the traits' @c async_handshake function once a new
+ * connection has been established, so that a protocol layered over the socket
+ * may complete its own handshake before the connection is used. By default no
+ * handshake is performed. The traits are specialised for ssl::stream in
+ * @c asio/ssl/connection_pool.hpp.
+ */
+template <typename Stream>
+struct connection_pool_traits
+{
+  /// Start the handshake on a newly connected stream.
+  /**
+   * @param s The stream, whose lowest layer has been connected.
+   *
+   * @param host The host name that was used to connect the stream.
+   *
+   * @param handler The handler to be called with an @c asio::error_code when
+   * the handshake completes.
+   */
+  template <typename Handler>
+  static void async_handshake(Stream& s,
+      const std::string& host, Handler&& handler)
+  {
+    (void)host;
+    asio::post(s.get_executor(),
+        asio::append(static_cast<Handler&&>(handler), asio::error_code()));
+  }
+};
+
+/// Keeps established connections for reuse by later requests.
+/**
+ * The basic_connection_pool class template hands out connections to hosts,
+ * identified by host and service name, in the form of leases. When a lease is
+ * released its connection is returned to the pool, where it is held idle and
+ * handed out again by a later acquisition for the same host, avoiding the cost
+ * of resolving the name, connecting and performing any handshake.
+ *
+ * @li An idle connection is checked continuously by a read that is kept
+ * outstanding on it. Should the peer close the connection, or send data that
+ * was not requested, the connection is discarded.
+ *
+ * @li An idle connection is closed once it has been idle for the idle timeout.
+ * The timeouts are held in a timer wheel, so that many idle connections may be
+ * tracked at little cost.
+ *
+ * @li No more than the maximum idle count of connections are held idle for
+ * each host. The least recently used connection is closed to make room.
+ *
+ * @li When an acquisition finds no idle connection, and a connection to the
+ * same host is already being established, the acquisition waits for that
+ * attempt rather than starting another. Once a connection succeeds, further
+ * connections are established in parallel for the remaining waiters. If it
+ * fails, the error is reported to every waiter, so that an unreachable host
+ * is not flooded with attempts.
+ *
+ * Names are resolved using a caching_resolver. Streams are constructed from
+ * the pool's executor, together with any argument given to the pool's
+ * constructor, and their handshake is performed using connection_pool_traits.
+ *
+ * On destruction, the pool closes its idle connections and completes any
+ * pending acquisitions with asio::error::operation_aborted. Leases may
+ * outlive the pool, in which case their connections are closed on release.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe. The pool and its leases must be used only from
+ * within the pool's executor. When the executor's context is run on several
+ * threads, use a strand.
+ *
+ * @par Example
+ * @code
+ * asio::ip::tcp::connection_pool pool(my_context.get_executor());
+ * ...
+ * pool.async_acquire("example.com", "http",
+ *     [](asio::error_code ec, asio::ip::tcp::connection_pool::lease l)
+ *     {
+ *       if (!ec)
+ *         send_request(std::move(l));
+ *     });
+ * @endcode
+ */
+template <typename Stream>
+class basic_connection_pool
+  : private noncopyable
+{
+private:
+  class initiate_async_acquire;
+  struct connection;
+  struct host_entry;
+  struct state;
+
+public:
+  /// The type of the pooled streams.
+  typedef Stream stream_type;
+
+  /// The type of the executor associated with the object.
+  typedef typename Stream::executor_type executor_type;
+
+  /// The type of the lowest layer of the pooled streams.
+  typedef typename Stream::lowest_layer_type lowest_layer_type;
+
+  /// The protocol type.
+  typedef typename lowest_layer_type::protocol_type protocol_type;
+
+  /// The duration type used for the idle timeout.
+  typedef chrono::steady_clock::duration duration;
+
+  /// Grants exclusive use of a pooled connection.
+  /**
+   * A lease is obtained from basic_connection_pool::async_acquire(). When the
+   * lease is released or destroyed its connection is returned to the pool,
+   * unless the connection has been closed or discard() was called. No
+   * operation should be outstanding on the stream at that time.
+   */
+  class lease
+  {
+  public:
+    /// Construct a lease that holds no connection.
+    lease() noexcept
+      : conn_(),
+        reused_(false)
+    {
+    }
+
+    /// Move-construct a lease from another.
+    lease(lease&& other) noexcept
+      : state_(static_cast<std::shared_ptr<state>&&>(other.state_)),
+        conn_(static_cast<std::shared_ptr<connection>&&>(other.conn_)),
+        reused_(other.reused_)
+    {
+    }
+
+    /// Move-assign a lease from another.
+    /**
+     * Any connection held by this lease is first returned to the pool.
+     */
+    lease& operator=(lease&& other) noexcept
+    {
+      if (this != &other)
+      {
+        release();
+        state_ = static_cast<std::shared_ptr<state>&&>(other.state_);
+        conn_ = static_cast<std::shared_ptr<connection>&&>(other.conn_);
+        reused_ = other.reused_;
+      }
+      return *this;
+    }
+
+    /// Destructor returns any connection to the pool.
+    ~lease()
+    {
+      release();
+    }
+
+    /// Determine whether the lease holds a connection.
+    explicit operator bool() const noexcept
+    {
+      return !!conn_;
+    }
+
+    /// Get the stream of the leased connection.
+    stream_type& stream() const noexcept
+    {
+      return conn_->stream_;
+    }
+
+    /// Get the stream of the leased connection.
+    stream_type& operator*() const noexcept
+    {
+      return conn_->stream_;
+    }
+
+    /// Get the stream of the leased connection.
+    stream_type* operator->() const noexcept
+    {
+      return &conn_->stream_;
+    }
+
+    /// Determine whether the connection was used by an earlier lease.
+    /**
+     * A request sent on a reused connection may fail because the peer closed
+     * the connection just before the request arrived. Requests that are safe
+     * to repeat may then be retried on a new connection.
+     */
+    bool reused() const noexcept
+    {
+      return reused_;
+    }
+
+    /// Return the connection to the pool.
+    void release()
+    {
+      if (conn_)
+      {
+        std::shared_ptr<connection> conn;
+        conn.swap(conn_);
+        std::shared_ptr<state> s;
+        s.swap(state_);
+        s->release(conn);
+      }
+    }
+
+    /// Close the connection rather than returning it to the pool.
+    /**
+     * This function should be called when the connection is no longer in a
+     * state where it may be used for another request, such as after an error
+     * or when the peer has indicated that it will close the connection.
+     */
+    void discard()
+    {
+      if (conn_)
+      {
+        asio::error_code ignored_ec;
+        conn_->stream_.lowest_layer().close(ignored_ec);
+        release();
+      }
+    }
+
+  private:
+    friend class basic_connection_pool;
+
+    lease(const std::shared_ptr<state>& s,
+        const std::shared_ptr<connection>& conn, bool reused)
+      : state_(s),
+        conn_(conn),
+        reused_(reused)
+    {
+    }
+
+    std::shared_ptr<state> state_;
+    std::shared_ptr<connection> conn_;
+    bool reused_;
+  };
+
+  /// Construct a pool whose streams are constructed from an executor.
+  /**
+   * @param ex The I/O executor used by the pool and its streams.
+   */
+  explicit basic_connection_pool(const executor_type& ex)
+    : state_(std::make_shared<state>(ex,
+          std::function<stream_type()>(stream_factory(ex))))
+  {
+  }
+
+  /// Construct a pool whose streams are constructed from an executor and an
+  /// argument.
+  /**
+   * @param ex The I/O executor used by the pool and its streams.
+   *
+   * @param arg An argument passed, after the executor, to the constructor of
+   * each stream. For example, the ssl::context used by an ssl::stream. The
+   * argument is held by reference and must outlive the pool.
+   */
+  template <typename Arg>
+  basic_connection_pool(const executor_type& ex, Arg& arg)
+    : state_(std::make_shared<state>(ex,
+          std::function<stream_type()>(
+            stream_factory_with_arg<Arg>(ex, &arg))))
+  {
+  }
+
+  /// Destructor.
+  /**
+   * Closes the idle connections and completes any pending acquisitions with
+   * asio::error::operation_aborted.
+   */
+  ~basic_connection_pool()
+  {
+    state_->shutdown();
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() const noexcept
+  {
+    return state_->executor_;
+  }
+
+  /// Get the maximum number of idle connections held for each host.
+  std::size_t max_idle() const noexcept
+  {
+    return state_->max_idle_;
+  }
+
+  /// Set the maximum number of idle connections held for each host.
+  /**
+   * The new maximum applies when connections are next returned to the pool.
+   * The default is 8.
+   */
+  void set_max_idle(std::size_t n) noexcept
+  {
+    state_->max_idle_ = n;
+  }
+
+  /// Get the time for which a connection is held idle before it is closed.
+  duration idle_timeout() const noexcept
+  {
+    return state_->idle_timeout_;
+  }
+
+  /// Set the time for which a connection is held idle before it is closed.
+  /**
+   * The new timeout applies when connections are next returned to the pool.
+   * The default is 60 seconds. A timeout of zero holds idle connections until
+   * they are closed by the peer or evicted.
+   */
+  void set_idle_timeout(const duration& timeout) noexcept
+  {
+    state_->idle_timeout_ = timeout;
+  }
+
+  /// Get the number of connections held idle by the pool.
+  std::size_t idle_count() const noexcept
+  {
+    return state_->idle_count_;
+  }
+
+  /// Close all idle connections.
+  void clear()
+  {
+    state_->clear();
+  }
+
+  /// Start an asynchronous operation to obtain a connection to a host.
+  /**
+   * This function is used to obtain a lease on an idle connection to the
+   * specified host and service or, if there is none, on a new connection.
+   * It always returns immediately.
+   *
+   * @param host A string identifying a location. May be a descriptive name or
+   * a numeric address string.
+   *
+   * @param service A string identifying the requested service. This may be a
+   * descriptive name or a numeric string corresponding to a port number.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the connection is
+   * available. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   basic_connection_pool::lease l // The leased connection.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, basic_connection_pool::lease) @endcode
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        lease)) AcquireToken = default_completion_token_t<executor_type>>
+  auto async_acquire(ASIO_STRING_VIEW_PARAM host,
+      ASIO_STRING_VIEW_PARAM service,
+      AcquireToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      asio::async_initiate<AcquireToken, void (asio::error_code, lease)>(
+        declval<initiate_async_acquire>(), token,
+        declval<std::string>(), declval<std::string>()))
+  {
+    return asio::async_initiate<AcquireToken,
+      void (asio::error_code, lease)>(
+        initiate_async_acquire(state_.get()), token,
+        static_cast<std::string>(host), static_cast<std::string>(service));
+  }
+
+private:
+  // The type of a handler waiting for a connection.
+  typedef any_completion_handler<void(asio::error_code, lease)> waiter_type;
+
+  // The timer type used for idle timeouts.
+  typedef basic_waitable_timer<chrono::steady_clock,
+      timer_wheel_traits<chrono::steady_clock>, executor_type> timer_type;
+
+  // The list type used to hold connections.
+  typedef std::list<std::shared_ptr<connection>> connection_list;
+
+  // Constructs the pool's streams from the executor.
+  class stream_factory
+  {
+  public:
+    explicit stream_factory(const executor_type& ex)
+      : ex_(ex)
+    {
+    }
+
+    stream_type operator()() const
+    {
+      return stream_type(ex_);
+    }
+
+  private:
+    executor_type ex_;
+  };
+
+  // Constructs the pool's streams from the executor and an argument.
+  template <typename Arg>
+  class stream_factory_with_arg
+  {
+  public:
+    stream_factory_with_arg(const executor_type& ex, Arg* arg)
+      : ex_(ex),
+        arg_(arg)
+    {
+    }
+
+    stream_type operator()() const
+    {
+      return stream_type(ex_, *arg_);
+    }
+
+  private:
+    executor_type ex_;
+    Arg* arg_;
+  };
+
+  // The states through which a connection passes.
+  enum connection_status
+  {
+    // The connection is being established.
+    connecting,
+
+    // The connection is held idle, with its health check outstanding.
+    idle,
+
+    // The connection has been taken for a waiter, and is awaiting the
+    // completion of its cancelled health check.
+    claimed,
+
+    // The connection is held by a lease.
+    leased,
+
+    // The connection has been closed.
+    closed
+  };
+
+  // A connection, with the state used to manage it while it is idle.
+  struct connection
+  {
+    connection(stream_type&& s, const std::string& key)
+      : stream_(static_cast<stream_type&&>(s)),
+        timer_(stream_.get_executor()),
+        key_(key),
+        status_(connecting),
+        idle_id_(0),
+        probe_(0)
+    {
+    }
+
+    void close()
+    {
+      status_ = closed;
+      asio::error_code ignored_ec;
+      stream_.lowest_layer().close(ignored_ec);
+      timer_.cancel();
+    }
+
+    stream_type stream_;
+    timer_type timer_;
+    std::string key_;
+    typename connection_list::iterator pos_;
+    connection_status status_;
+    unsigned long idle_id_;
+    waiter_type claimant_;
+    char probe_;
+  };
+
+  // The connections and waiters for a host.
+  struct host_entry
+  {
+    host_entry()
+      : connecting_(0),
+        claimed_(0),
+        reachable_(false)
+    {
+    }
+
+    std::string host_;
+    std::string service_;
+    connection_list idle_;
+    connection_list pending_;
+    std::deque<waiter_type> waiters_;
+    std::size_t connecting_;
+    std::size_t claimed_;
+    bool reachable_;
+  };
+
+  // Waits for a connection, and keeps the handler's executor busy while it
+  // does so.
+  template <typename Handler>
+  class waiting_handler
+  {
+  public:
+    waiting_handler(Handler&& handler, const executor_type& ex)
+      : work_(asio::make_work_guard(handler, ex)),
+        handler_(static_cast<Handler&&>(handler))
+    {
+    }
+
+    void operator()(asio::error_code ec, lease l)
+    {
+      typename associated_executor<Handler, executor_type>::type ex(
+          work_.get_executor());
+      asio::dispatch(ex, asio::append(static_cast<Handler&&>(handler_),
+            ec, static_cast<lease&&>(l)));
+      work_.reset();
+    }
+
+  private:
+    executor_work_guard<
+      typename associated_executor<Handler, executor_type>::type> work_;
+    Handler handler_;
+  };
+
+  // Resolves, connects and performs the handshake for a new connection.
+  class connect_handler
+  {
+  public:
+    connect_handler(const std::shared_ptr<state>& s,
+        const std::shared_ptr<connection>& conn, const std::string& host)
+      : state_(s),
+        conn_(conn),
+        host_(host)
+    {
+    }
+
+    void operator()(const asio::error_code& ec,
+        const basic_resolver_results<protocol_type>& results)
+    {
+      if (ec || conn_->status_ != connecting)
+        state_->complete_connect(conn_, ec);
+      else
+        asio::async_connect(conn_->stream_.lowest_layer(),
+            results, static_cast<connect_handler&&>(*this));
+    }
+
+    void operator()(const asio::error_code& ec,
+        const typename protocol_type::endpoint&)
+    {
+      if (ec || conn_->status_ != connecting)
+        state_->complete_connect(conn_, ec);
+      else
+        connection_pool_traits<stream_type>::async_handshake(conn_->stream_,
+            host_, static_cast<connect_handler&&>(*this));
+    }
+
+    void operator()(const asio::error_code& ec)
+    {
+      state_->complete_connect(conn_, ec);
+    }
+
+  private:
+    std::shared_ptr<state> state_;
+    std::shared_ptr<connection> conn_;
+    std::string host_;
+  };
+
+  // Handles the completion of an idle connection's health check.
+  class health_handler
+  {
+  public:
+    health_handler(const std::shared_ptr<state>& s,
+        const std::shared_ptr<connection>& conn)
+      : state_(s),
+        conn_(conn),
+        idle_id_(conn->idle_id_)
+    {
+    }
+
+    void operator()(const asio::error_code& ec, std::size_t)
+    {
+      state_->complete_health_check(conn_, idle_id_, ec);
+    }
+
+  private:
+    std::shared_ptr<state> state_;
+    std::shared_ptr<connection> conn_;
+    unsigned long idle_id_;
+  };
+
+  // Handles the expiry of an idle connection's timeout.
+  class idle_timeout_handler
+  {
+  public:
+    idle_timeout_handler(const std::shared_ptr<state>& s,
+        const std::shared_ptr<connection>& conn)
+      : state_(s),
+        conn_(conn),
+        idle_id_(conn->idle_id_)
+    {
+    }
+
+    void operator()(const asio::error_code& ec)
+    {
+      if (!ec && conn_->status_ == idle && conn_->idle_id_ == idle_id_)
+        state_->remove_idle(conn_);
+    }
+
+  private:
+    std::shared_ptr<state> state_;
+    std::shared_ptr<connection> conn_;
+    unsigned long idle_id_;
+  };
+
+  // The state of the pool, which is shared with its leases and outstanding
+  // operations so that they may outlive the pool object.
+  struct state
+    : std::enable_shared_from_this<state>
+  {
+    state(const executor_type& ex,
+        std::function<stream_type()>&& make_stream)
+      : executor_(ex),
+        make_stream_(static_cast<std::function<stream_type()>&&>(make_stream)),
+        resolver_(ex),
+        max_idle_(8),
+        idle_timeout_(chrono::seconds(60)),
+        idle_count_(0),
+        shut_down_(false)
+    {
+    }
+
+    // Serve a waiter from an idle connection or, if there is none, from a new
+    // connection.
+    void acquire(const std::string& host,
+        const std::string& service, waiter_type&& waiter)
+    {
+      if (shut_down_)
+      {
+        asio::post(executor_, asio::append(
+              static_cast<waiter_type&&>(waiter),
+              asio::error::operation_aborted, lease()));
+        return;
+      }
+
+      std::string key(host);
+      key += '\0';
+      key += service;
+      host_entry& entry = hosts_[key];
+      entry.host_ = host;
+      entry.service_ = service;
+      serve(key, entry, static_cast<waiter_type&&>(waiter));
+    }
+
+    void serve(const std::string& key,
+        host_entry& entry, waiter_type&& waiter)
+    {
+      if (!entry.idle_.empty())
+      {
+        // Take the most recently used connection. It is handed to the waiter
+        // once its health check has been cancelled, unless the check fails.
+        std::shared_ptr<connection> conn = entry.idle_.front();
+        entry.idle_.pop_front();
+        --idle_count_;
+        ++entry.claimed_;
+        conn->status_ = claimed;
+        conn->claimant_ = static_cast<waiter_type&&>(waiter);
+        conn->timer_.cancel();
+        asio::error_code ignored_ec;
+        conn->stream_.lowest_layer().cancel(ignored_ec);
+        return;
+      }
+
+      entry.waiters_.push_back(static_cast<waiter_type&&>(waiter));
+      start_connects(key, entry);
+    }
+
+    // Start enough connections for the waiters. Until a connection to the
+    // host succeeds, only one is attempted at a time.
+    void start_connects(const std::string& key, host_entry& entry)
+    {
+      std::size_t wanted = entry.reachable_ ? entry.waiters_.size() : 1;
+      while (entry.connecting_ < wanted)
+      {
+        std::shared_ptr<connection> conn =
+          std::make_shared<connection>(make_stream_(), key);
+        entry.pending_.push_front(conn);
+        conn->pos_ = entry.pending_.begin();
+        ++entry.connecting_;
+        resolver_.async_resolve(entry.host_, entry.service_,
+            connect_handler(this->shared_from_this(), conn, entry.host_));
+      }
+    }
+
+    void complete_connect(const std::shared_ptr<connection>& conn,
+        asio::error_code ec)
+    {
+      if (conn->status_ != connecting)
+        return;
+
+      typename std::map<std::string, host_entry>::iterator iter =
+        hosts_.find(conn->key_);
+      host_entry& entry = iter->second;
+      entry.pending_.erase(conn->pos_);
+      --entry.connecting_;
+
+      if (ec)
+      {
+        conn->close();
+        entry.reachable_ = false;
+        if (entry.connecting_ == 0)
+        {
+          std::deque<waiter_type> waiters;
+          waiters.swap(entry.waiters_);
+          erase_if_unused(iter);
+          for (std::size_t i = 0; i < waiters.size(); ++i)
+            static_cast<waiter_type&&>(waiters[i])(ec, lease());
+        }
+        return;
+      }
+
+      entry.reachable_ = true;
+      if (entry.waiters_.empty())
+      {
+        make_idle(entry, conn);
+        return;
+      }
+
+      waiter_type waiter(static_cast<waiter_type&&>(entry.waiters_.front()));
+      entry.waiters_.pop_front();
+      conn->status_ = leased;
+      start_connects(conn->key_, entry);
+      static_cast<waiter_type&&>(waiter)(ec,
+          lease(this->shared_from_this(), conn, false));
+    }
+
+    // Hold a connection idle, with its health check and timeout.
+    void make_idle(host_entry& entry, const std::shared_ptr<connection>& conn)
+    {
+      if (!conn->stream_.lowest_layer().is_open() || max_idle_ == 0)
+      {
+        conn->close();
+        return;
+      }
+
+      entry.idle_.push_front(conn);
+      conn->pos_ = entry.idle_.begin();
+      conn->status_ = idle;
+      ++conn->idle_id_;
+      ++idle_count_;
+
+      while (entry.idle_.size() > max_idle_)
+      {
+        entry.idle_.back()->close();
+        entry.idle_.pop_back();
+        --idle_count_;
+      }
+
+      conn->stream_.async_read_some(asio::buffer(&conn->probe_, 1),
+          health_handler(this->shared_from_this(), conn));
+
+      if (idle_timeout_ > duration::zero())
+      {
+        conn->timer_.expires_after(idle_timeout_);
+        conn->timer_.async_wait(
+            idle_timeout_handler(this->shared_from_this(), conn));
+      }
+    }
+
+    void complete_health_check(const std::shared_ptr<connection>& conn,
+        unsigned long idle_id, const asio::error_code& ec)
+    {
+      if (conn->idle_id_ != idle_id)
+        return;
+
+      if (conn->status_ == claimed)
+      {
+        waiter_type waiter(static_cast<waiter_type&&>(conn->claimant_));
+        if (shut_down_)
+        {
+          conn->close();
+          static_cast<waiter_type&&>(waiter)(
+              asio::error::operation_aborted, lease());
+          return;
+        }
+
+        host_entry& entry = hosts_.find(conn->key_)->second;
+        --entry.claimed_;
+        if (ec == asio::error::operation_aborted)
+        {
+          conn->status_ = leased;
+          static_cast<waiter_type&&>(waiter)(asio::error_code(),
+              lease(this->shared_from_this(), conn, true));
+        }
+        else
+        {
+          // The connection failed while it was being claimed, so the waiter
+          // is served again.
+          conn->close();
+          serve(conn->key_, entry, static_cast<waiter_type&&>(waiter));
+        }
+      }
+      else if (conn->status_ == idle)
+      {
+        // The peer closed the connection or sent unexpected data.
+        remove_idle(conn);
+      }
+    }
+
+    void remove_idle(const std::shared_ptr<connection>& conn)
+    {
+      typename std::map<std::string, host_entry>::iterator iter =
+        hosts_.find(conn->key_);
+      iter->second.idle_.erase(conn->pos_);
+      --idle_count_;
+      conn->close();
+      erase_if_unused(iter);
+    }
+
+    void release(const std::shared_ptr<connection>& conn)
+    {
+      if (shut_down_)
+      {
+        conn->close();
+        return;
+      }
+
+      make_idle(hosts_[conn->key_], conn);
+    }
+
+    void erase_if_unused(
+        typename std::map<std::string, host_entry>::iterator iter)
+    {
+      if (iter->second.idle_.empty() && iter->second.pending_.empty()
+          && iter->second.waiters_.empty() && iter->second.claimed_ == 0)
+        hosts_.erase(iter);
+    }
+
+    void clear()
+    {
+      typename std::map<std::string, host_entry>::iterator iter =
+        hosts_.begin();
+      while (iter != hosts_.end())
+      {
+        typename std::map<std::string, host_entry>::iterator next = iter;
+        ++next;
+        connection_list& idle_list = iter->second.idle_;
+        for (typename connection_list::iterator i = idle_list.begin();
+            i != idle_list.end(); ++i)
+          (*i)->close();
+        idle_list.clear();
+        erase_if_unused(iter);
+        iter = next;
+      }
+      idle_count_ = 0;
+    }
+
+    void shutdown()
+    {
+      shut_down_ = true;
+      clear();
+
+      typename std::map<std::string, host_entry>::iterator iter =
+        hosts_.begin();
+      for (; iter != hosts_.end(); ++iter)
+      {
+        connection_list& pending = iter->second.pending_;
+        for (typename connection_list::iterator i = pending.begin();
+            i != pending.end(); ++i)
+          (*i)->close();
+
+        std::deque<waiter_type>& waiters = iter->second.waiters_;
+        for (std::size_t i = 0; i < waiters.size(); ++i)
+          asio::post(executor_, asio::append(
+                static_cast<waiter_type&&>(waiters[i]),
+                asio::error::operation_aborted, lease()));
+      }
+      hosts_.clear();
+      resolver_.cancel();
+    }
+
+    executor_type executor_;
+    std::function<stream_type()> make_stream_;
+    caching_resolver<protocol_type, executor_type> resolver_;
+    std::map<std::string, host_entry> hosts_;
+    std::size_t max_idle_;
+    duration idle_timeout_;
+    std::size_t idle_count_;
+    bool shut_down_;
+  };
+
+  class initiate_async_acquire
+  {
+  public:
+    typedef typename basic_connection_pool::executor_type executor_type;
+
+    explicit initiate_async_acquire(state* s)
+      : state_(s)
+    {
+    }
+
+    executor_type get_executor() const noexcept
+    {
+      return state_->executor_;
+    }
+
+    template <typename AcquireHandler>
+    void operator()(AcquireHandler&& handler,
+        const std::string& host, const std::string& service) const
+    {
+      state_->acquire(host, service,
+          waiter_type(waiting_handler<decay_t<AcquireHandler>>(
+              static_cast<AcquireHandler&&>(handler), state_->executor_)));
+    }
+
+  private:
+    state* state_;
+  };
+
+  std::shared_ptr<state> state_;
+};
+
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IP_BASIC_CONNECTION_POOL_HPP
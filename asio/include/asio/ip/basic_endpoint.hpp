@@ -20,6 +20,7 @@
 #include "asio/detail/cstdint.hpp"
 #include "asio/ip/address.hpp"
 #include "asio/ip/detail/endpoint.hpp"
+#include "asio/ip/endpoint_key.hpp"
 
 #if !defined(ASIO_NO_IOSTREAM)
 # include <iosfwd>
@@ -60,6 +61,14 @@ public:
   typedef asio::detail::socket_addr_type data_type;
 #endif
 
+  /// The maximum number of characters in the string form of an endpoint.
+#if defined(GENERATING_DOCUMENTATION)
+  static const std::size_t max_string_length = 86;
+#else
+  ASIO_STATIC_CONSTANT(std::size_t, max_string_length
+      = asio::ip::detail::endpoint::max_string_length);
+#endif
+
   /// Default constructor.
   basic_endpoint() noexcept
     : impl_()
@@ -234,6 +243,57 @@ private:
   asio::ip::detail::endpoint impl_;
 };
 
+/// Write an endpoint to a character range.
+/**
+ * The endpoint is written as the address, a ':' character and the decimal port
+ * number. An IPv6 address is enclosed in brackets, as in "[::1]:80". No null
+ * terminator is written, and no memory is allocated.
+ *
+ * @param first The beginning of the range to which the endpoint is written.
+ *
+ * @param last The end of the range. A range of
+ * basic_endpoint::max_string_length characters is always large enough.
+ *
+ * @param endpoint The endpoint to be written.
+ *
+ * @param ec Set to asio::error::no_buffer_space if the range is too
+ * small.
+ *
+ * @returns A pointer to the end of the characters written, or @c first if an
+ * error occurred.
+ *
+ * @relates asio::ip::basic_endpoint
+ */
+template <typename InternetProtocol>
+char* to_chars(char* first, char* last,
+    const basic_endpoint<InternetProtocol>& endpoint,
+    asio::error_code& ec) noexcept;
+
+/// Read an endpoint from a character range.
+/**
+ * This function reads an endpoint in the form written by to_chars() from the
+ * start of the range. The endpoint may be followed by other characters.
+ *
+ * @param first The beginning of the range from which the endpoint is read.
+ *
+ * @param last The end of the range.
+ *
+ * @param endpoint Set to the endpoint that was read. Unchanged if an error
+ * occurred.
+ *
+ * @param ec Set to asio::error::invalid_argument if the range does not begin
+ * with a valid endpoint.
+ *
+ * @returns A pointer to the first character that was not parsed, or @c first
+ * if an error occurred.
+ *
+ * @relates asio::ip::basic_endpoint
+ */
+template <typename InternetProtocol>
+const char* from_chars(const char* first, const char* last,
+    basic_endpoint<InternetProtocol>& endpoint,
+    asio::error_code& ec) noexcept;
+
 #if !defined(ASIO_NO_IOSTREAM)
 
 /// Output an endpoint as a string.
@@ -267,9 +327,7 @@ struct hash<asio::ip::basic_endpoint<InternetProtocol>>
       const asio::ip::basic_endpoint<InternetProtocol>& ep)
     const noexcept
   {
-    std::size_t hash1 = std::hash<asio::ip::address>()(ep.address());
-    std::size_t hash2 = std::hash<unsigned short>()(ep.port());
-    return hash1 ^ (hash2 + 0x9e3779b9 + (hash1 << 6) + (hash1 >> 2));
+    return asio::ip::endpoint_key(ep).hash();
   }
 };
 
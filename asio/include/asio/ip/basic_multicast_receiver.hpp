@@ -0,0 +1,724 @@
+//
+// ip/basic_multicast_receiver.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_BASIC_MULTICAST_RECEIVER_HPP
+#define ASIO_IP_BASIC_MULTICAST_RECEIVER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_MULTICAST_RECEIVER) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include "asio/any_io_executor.hpp"
+#include "asio/basic_datagram_socket.hpp"
+#include "asio/buffer.hpp"
+#include "asio/compose.hpp"
+#include "asio/error.hpp"
+#include "asio/ip/address.hpp"
+#include "asio/ip/multicast.hpp"
+#include "asio/ip/udp.hpp"
+#include "asio/post.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/detail/socket_option.hpp"
+#include "asio/detail/socket_types.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+
+/// Receives datagrams for many multicast groups on a single socket.
+/**
+ * The basic_multicast_receiver class template joins any number of multicast
+ * groups on one UDP socket, and dispatches each received datagram to a
+ * handler registered for the group to which it was sent. The destination
+ * address of each datagram is obtained from the @c IP_PKTINFO (or
+ * @c IPV6_PKTINFO) control message, and datagrams are received in batches
+ * using @c recvmmsg where supported. A single outstanding receive operation
+ * therefore serves all of the groups, where joining each group on its own
+ * socket would require one socket and one receive operation per group.
+ *
+ * Group handlers are called from within the receive operation, before its
+ * completion handler is called, and must not call join(), leave() or close().
+ * Datagrams sent to groups without a handler are discarded.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code
+ * asio::ip::multicast_receiver receiver(my_context);
+ * receiver.open(asio::ip::udp::endpoint(asio::ip::udp::v4(), 30001));
+ * for (const auto& group : groups)
+ *   receiver.join(group,
+ *       [](const asio::ip::multicast_receiver::datagram& d)
+ *       {
+ *         handle_update(d.group, d.data);
+ *       });
+ * receiver.async_receive(
+ *     [](asio::error_code ec, std::size_t n)
+ *     {
+ *       ...
+ *     });
+ * @endcode
+ */
+template <typename Executor = any_io_executor>
+class basic_multicast_receiver
+{
+private:
+  class receive_op;
+
+public:
+  /// The type of the executor associated with the object.
+  typedef Executor executor_type;
+
+  /// Rebinds the receiver type to another executor.
+  template <typename Executor1>
+  struct rebind_executor
+  {
+    /// The receiver type when rebound to the specified executor.
+    typedef basic_multicast_receiver<Executor1> other;
+  };
+
+  /// The type of the underlying socket.
+  typedef basic_datagram_socket<udp, Executor> socket_type;
+
+  /// The endpoint type.
+  typedef udp::endpoint endpoint_type;
+
+  /// A datagram received for a group.
+  struct datagram
+  {
+    /// The group to which the datagram was sent.
+    address group;
+
+    /// The endpoint of the sender of the datagram.
+    endpoint_type sender;
+
+    /// The data of the datagram. Valid only during the call to the group
+    /// handler.
+    const_buffer data;
+
+    /// Whether the datagram was truncated to fit into the receive buffer.
+    bool truncated;
+  };
+
+  /// The type of a handler that is called for each datagram sent to a group.
+  typedef std::function<void (const datagram&)> group_handler;
+
+  /// The maximum number of datagrams received by a single operation.
+  static constexpr std::size_t max_batch_size = 64;
+
+  /// Construct a receiver without opening it.
+  explicit basic_multicast_receiver(const executor_type& ex)
+    : socket_(ex),
+      batch_size_(0),
+      max_datagram_size_(0)
+  {
+  }
+
+  /// Construct a receiver without opening it.
+  template <typename ExecutionContext>
+  explicit basic_multicast_receiver(ExecutionContext& context,
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      > = 0)
+    : socket_(context),
+      batch_size_(0),
+      max_datagram_size_(0)
+  {
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() noexcept
+  {
+    return socket_.get_executor();
+  }
+
+  /// Get the underlying socket.
+  /**
+   * The socket may be used to set further options, such as the size of the
+   * receive buffer. It must not be used to receive datagrams.
+   */
+  socket_type& socket() noexcept
+  {
+    return socket_;
+  }
+
+  /// Open the receiver.
+  /**
+   * Opens the socket and binds it to the specified endpoint, which is
+   * typically the unspecified address and the port to which the groups'
+   * datagrams are sent.
+   *
+   * @param listen_endpoint The endpoint to which the socket is bound.
+   *
+   * @param batch_size The maximum number of datagrams received by a single
+   * operation, between 1 and @c max_batch_size.
+   *
+   * @param max_datagram_size The size of the buffer for each datagram.
+   * Larger datagrams are truncated.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void open(const endpoint_type& listen_endpoint,
+      std::size_t batch_size = 32, std::size_t max_datagram_size = 2048)
+  {
+    asio::error_code ec;
+    open(listen_endpoint, batch_size, max_datagram_size, ec);
+    asio::detail::throw_error(ec, "open");
+  }
+
+  /// Open the receiver.
+  /**
+   * Opens the socket and binds it to the specified endpoint, which is
+   * typically the unspecified address and the port to which the groups'
+   * datagrams are sent.
+   *
+   * @param listen_endpoint The endpoint to which the socket is bound.
+   *
+   * @param batch_size The maximum number of datagrams received by a single
+   * operation, between 1 and @c max_batch_size.
+   *
+   * @param max_datagram_size The size of the buffer for each datagram.
+   * Larger datagrams are truncated.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID open(const endpoint_type& listen_endpoint,
+      std::size_t batch_size, std::size_t max_datagram_size,
+      asio::error_code& ec)
+  {
+    if (socket_.is_open())
+    {
+      ec = asio::error::already_open;
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    if (batch_size == 0 || batch_size > max_batch_size
+        || max_datagram_size == 0)
+    {
+      ec = asio::error::invalid_argument;
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    socket_.open(listen_endpoint.protocol(), ec);
+    if (!ec)
+      socket_.set_option(socket_base::reuse_address(true), ec);
+    if (!ec)
+      enable_destination_address(listen_endpoint.protocol(), ec);
+    if (!ec)
+      socket_.non_blocking(true, ec);
+    if (!ec)
+      socket_.bind(listen_endpoint, ec);
+    if (ec)
+    {
+      asio::error_code ignored_ec;
+      socket_.close(ignored_ec);
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    batch_size_ = batch_size;
+    max_datagram_size_ = max_datagram_size;
+    payload_.resize(batch_size * max_datagram_size);
+    bufs_.resize(batch_size);
+    senders_.resize(batch_size);
+    controls_.resize(batch_size);
+    messages_.resize(batch_size);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Determine whether the receiver is open.
+  bool is_open() const noexcept
+  {
+    return socket_.is_open();
+  }
+
+  /// Close the receiver.
+  /**
+   * Any asynchronous receive operation is cancelled immediately, and will
+   * complete with the asio::error::operation_aborted error. All groups are
+   * left and their handlers are destroyed.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void close()
+  {
+    asio::error_code ec;
+    close(ec);
+    asio::detail::throw_error(ec, "close");
+  }
+
+  /// Close the receiver.
+  /**
+   * Any asynchronous receive operation is cancelled immediately, and will
+   * complete with the asio::error::operation_aborted error. All groups are
+   * left and their handlers are destroyed.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID close(asio::error_code& ec)
+  {
+    socket_.close(ec);
+    groups_.clear();
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Cancel any asynchronous receive operation.
+  /**
+   * @throws asio::system_error Thrown on failure.
+   */
+  void cancel()
+  {
+    socket_.cancel();
+  }
+
+  /// Join a multicast group.
+  /**
+   * @param group The multicast group to join. For an IPv6 group, the address's
+   * scope identifier selects the interface.
+   *
+   * @param handler The handler to be called for each datagram sent to the
+   * group. The function signature of the handler must be:
+   * @code void handler(
+   *   const basic_multicast_receiver::datagram& d
+   * ); @endcode
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename GroupHandler>
+  void join(const address& group, GroupHandler&& handler)
+  {
+    asio::error_code ec;
+    join(group, static_cast<GroupHandler&&>(handler), ec);
+    asio::detail::throw_error(ec, "join");
+  }
+
+  /// Join a multicast group.
+  /**
+   * @param group The multicast group to join. For an IPv6 group, the address's
+   * scope identifier selects the interface.
+   *
+   * @param handler The handler to be called for each datagram sent to the
+   * group. The function signature of the handler must be:
+   * @code void handler(
+   *   const basic_multicast_receiver::datagram& d
+   * ); @endcode
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  template <typename GroupHandler>
+  ASIO_SYNC_OP_VOID join(const address& group,
+      GroupHandler&& handler, asio::error_code& ec)
+  {
+    if (group.is_v4())
+    {
+      join(group.to_v4(), address_v4::any(),
+          static_cast<GroupHandler&&>(handler), ec);
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    if (groups_.count(group))
+    {
+      ec = asio::error::already_open;
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    socket_.set_option(multicast::join_group(group), ec);
+    if (!ec)
+    {
+      group_state& state = groups_[group];
+      state.handler = static_cast<GroupHandler&&>(handler);
+    }
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Join an IPv4 multicast group on the specified interface.
+  /**
+   * @param group The multicast group to join.
+   *
+   * @param interface_address The address of the interface on which to join
+   * the group.
+   *
+   * @param handler The handler to be called for each datagram sent to the
+   * group. The function signature of the handler must be:
+   * @code void handler(
+   *   const basic_multicast_receiver::datagram& d
+   * ); @endcode
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename GroupHandler>
+  void join(const address_v4& group, const address_v4& interface_address,
+      GroupHandler&& handler)
+  {
+    asio::error_code ec;
+    join(group, interface_address, static_cast<GroupHandler&&>(handler), ec);
+    asio::detail::throw_error(ec, "join");
+  }
+
+  /// Join an IPv4 multicast group on the specified interface.
+  /**
+   * @param group The multicast group to join.
+   *
+   * @param interface_address The address of the interface on which to join
+   * the group.
+   *
+   * @param handler The handler to be called for each datagram sent to the
+   * group. The function signature of the handler must be:
+   * @code void handler(
+   *   const basic_multicast_receiver::datagram& d
+   * ); @endcode
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  template <typename GroupHandler>
+  ASIO_SYNC_OP_VOID join(const address_v4& group,
+      const address_v4& interface_address, GroupHandler&& handler,
+      asio::error_code& ec)
+  {
+    if (groups_.count(address(group)))
+    {
+      ec = asio::error::already_open;
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    socket_.set_option(multicast::join_group(group, interface_address), ec);
+    if (!ec)
+    {
+      group_state& state = groups_[address(group)];
+      state.handler = static_cast<GroupHandler&&>(handler);
+      state.interface_address = interface_address;
+    }
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Leave a multicast group.
+  /**
+   * @param group The multicast group to leave. The group's handler is
+   * destroyed.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void leave(const address& group)
+  {
+    asio::error_code ec;
+    leave(group, ec);
+    asio::detail::throw_error(ec, "leave");
+  }
+
+  /// Leave a multicast group.
+  /**
+   * @param group The multicast group to leave. The group's handler is
+   * destroyed.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID leave(const address& group, asio::error_code& ec)
+  {
+    typename group_map::iterator iter = groups_.find(group);
+    if (iter == groups_.end())
+    {
+      ec = asio::error::not_found;
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    if (group.is_v4())
+      socket_.set_option(multicast::leave_group(
+            group.to_v4(), iter->second.interface_address), ec);
+    else
+      socket_.set_option(multicast::leave_group(group), ec);
+    groups_.erase(iter);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Get the number of groups that have been joined.
+  std::size_t group_count() const noexcept
+  {
+    return groups_.size();
+  }
+
+  /// Start an asynchronous operation to receive and dispatch datagrams.
+  /**
+   * This function is used to asynchronously receive a batch of datagrams and
+   * to call the handler of the group to which each datagram was sent. It is
+   * an initiating function for an @ref asynchronous_operation, and always
+   * returns immediately.
+   *
+   * At most one receive operation may be outstanding at a time.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t datagrams // Number of datagrams dispatched.
+   * ); @endcode
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @note The operation completes once at least one datagram has been
+   * received, whether or not any of the datagrams were sent to a joined
+   * group.
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code, std::size_t))
+        ReceiveToken = default_completion_token_t<executor_type>>
+  auto async_receive(
+      ReceiveToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_compose<ReceiveToken, void (asio::error_code, std::size_t)>(
+        declval<receive_op>(), token, declval<socket_type&>()))
+  {
+    return async_compose<ReceiveToken,
+      void (asio::error_code, std::size_t)>(
+        receive_op(this), token, socket_);
+  }
+
+private:
+  // Disallow copying and assignment.
+  basic_multicast_receiver(const basic_multicast_receiver&) = delete;
+  basic_multicast_receiver& operator=(
+      const basic_multicast_receiver&) = delete;
+
+  struct group_state
+  {
+    group_handler handler;
+    address_v4 interface_address;
+  };
+
+  typedef std::unordered_map<address, group_state> group_map;
+
+  // Storage for a control message carrying the destination address.
+  union control_type
+  {
+    cmsghdr header;
+    char data[CMSG_SPACE(sizeof(in6_pktinfo))];
+  };
+
+  // Request the destination address of each received datagram, and receive
+  // only the groups joined on this socket.
+  void enable_destination_address(const udp& protocol, asio::error_code& ec)
+  {
+    if (protocol == udp::v4())
+    {
+      socket_.set_option(asio::detail::socket_option::boolean<
+          IPPROTO_IP, IP_PKTINFO>(true), ec);
+#if defined(IP_MULTICAST_ALL)
+      if (!ec)
+        socket_.set_option(asio::detail::socket_option::boolean<
+            IPPROTO_IP, IP_MULTICAST_ALL>(false), ec);
+#endif // defined(IP_MULTICAST_ALL)
+    }
+    else
+    {
+      socket_.set_option(asio::detail::socket_option::boolean<
+          IPPROTO_IPV6, IPV6_RECVPKTINFO>(true), ec);
+#if defined(IPV6_MULTICAST_ALL)
+      if (!ec)
+        socket_.set_option(asio::detail::socket_option::boolean<
+            IPPROTO_IPV6, IPV6_MULTICAST_ALL>(false), ec);
+#endif // defined(IPV6_MULTICAST_ALL)
+    }
+  }
+
+  // Receive a batch without blocking. Returns false if no datagrams are ready.
+  bool try_receive(asio::error_code& ec, std::size_t& messages)
+  {
+    for (std::size_t i = 0; i < batch_size_; ++i)
+    {
+      bufs_[i].iov_base = &payload_[i * max_datagram_size_];
+      bufs_[i].iov_len = max_datagram_size_;
+      messages_[i].msg_hdr = msghdr();
+      messages_[i].msg_hdr.msg_name = senders_[i].data();
+      messages_[i].msg_hdr.msg_namelen =
+        static_cast<socklen_t>(senders_[i].capacity());
+      messages_[i].msg_hdr.msg_iov = &bufs_[i];
+      messages_[i].msg_hdr.msg_iovlen = 1;
+      messages_[i].msg_hdr.msg_control = controls_[i].data;
+      messages_[i].msg_hdr.msg_controllen = sizeof(controls_[i].data);
+      messages_[i].msg_len = 0;
+    }
+
+    return asio::detail::socket_ops::non_blocking_recvmmsg(
+        socket_.native_handle(), messages_.data(), batch_size_,
+        0, ec, messages);
+  }
+
+  // Get the destination address of a received datagram.
+  static bool destination(msghdr& msg, address& group)
+  {
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+      if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO)
+      {
+        in_pktinfo info;
+        std::memcpy(&info, CMSG_DATA(cmsg), sizeof(info));
+        group = address_v4(asio::detail::socket_ops::network_to_host_long(
+              info.ipi_addr.s_addr));
+        return true;
+      }
+      else if (cmsg->cmsg_level == IPPROTO_IPV6
+          && cmsg->cmsg_type == IPV6_PKTINFO)
+      {
+        in6_pktinfo info;
+        std::memcpy(&info, CMSG_DATA(cmsg), sizeof(info));
+        address_v6::bytes_type bytes;
+        std::memcpy(bytes.data(), info.ipi6_addr.s6_addr, 16);
+        address_v6 v6(bytes);
+        group = v6.is_v4_mapped()
+          ? address(make_address_v4(v4_mapped, v6)) : address(v6);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Call the group handler for each received datagram. Returns the number of
+  // datagrams for which a handler was called.
+  std::size_t dispatch(std::size_t messages)
+  {
+    std::size_t dispatched = 0;
+    datagram d;
+    for (std::size_t i = 0; i < messages && i < batch_size_; ++i)
+    {
+      msghdr& msg = messages_[i].msg_hdr;
+      if (!destination(msg, d.group))
+        continue;
+
+      typename group_map::iterator iter = groups_.find(d.group);
+      if (iter == groups_.end() || !iter->second.handler)
+        continue;
+
+      senders_[i].resize(msg.msg_namelen);
+      std::size_t length = messages_[i].msg_len;
+      d.sender = senders_[i];
+      d.data = asio::buffer(&payload_[i * max_datagram_size_],
+          length < max_datagram_size_ ? length : max_datagram_size_);
+      d.truncated = (msg.msg_flags & MSG_TRUNC) != 0;
+      iter->second.handler(d);
+      ++dispatched;
+    }
+    return dispatched;
+  }
+
+  // Receives a batch, waiting for the socket to become readable when no
+  // datagrams are ready. When no wait is needed on the first attempt, the
+  // dispatch is posted so that group handlers are not called from within
+  // async_receive().
+  class receive_op
+  {
+  public:
+    explicit receive_op(basic_multicast_receiver* receiver)
+      : receiver_(receiver),
+        started_(false),
+        received_(false),
+        messages_(0)
+    {
+    }
+
+    template <typename Self>
+    void operator()(Self& self, asio::error_code ec = asio::error_code())
+    {
+      if (!started_)
+      {
+        started_ = true;
+        if (!receiver_->socket_.is_open())
+        {
+          asio::post(receiver_->socket_.get_executor(),
+              static_cast<Self&&>(self));
+        }
+        else if (receiver_->try_receive(ec_, messages_))
+        {
+          received_ = true;
+          asio::post(receiver_->socket_.get_executor(),
+              static_cast<Self&&>(self));
+        }
+        else
+        {
+          receiver_->socket_.async_wait(socket_base::wait_read,
+              static_cast<Self&&>(self));
+        }
+        return;
+      }
+
+      if (received_)
+      {
+        ec = ec_;
+      }
+      else
+      {
+        if (!ec && !receiver_->socket_.is_open())
+          ec = asio::error::bad_descriptor;
+
+        if (!ec && !receiver_->try_receive(ec, messages_))
+        {
+          receiver_->socket_.async_wait(socket_base::wait_read,
+              static_cast<Self&&>(self));
+          return;
+        }
+      }
+
+      std::size_t dispatched = ec ? 0 : receiver_->dispatch(messages_);
+      self.complete(ec, dispatched);
+    }
+
+  private:
+    basic_multicast_receiver* receiver_;
+    bool started_;
+    bool received_;
+    asio::error_code ec_;
+    std::size_t messages_;
+  };
+
+  socket_type socket_;
+  std::size_t batch_size_;
+  std::size_t max_datagram_size_;
+  std::vector<unsigned char> payload_;
+  std::vector<asio::detail::socket_ops::buf> bufs_;
+  std::vector<endpoint_type> senders_;
+  std::vector<control_type> controls_;
+  std::vector<asio::detail::mmsghdr_type> messages_;
+  group_map groups_;
+};
+
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_MULTICAST_RECEIVER)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_IP_BASIC_MULTICAST_RECEIVER_HPP
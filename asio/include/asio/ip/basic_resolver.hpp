@@ -626,6 +626,19 @@ public:
    * @par Completion Signature
    * @code void(asio::error_code, results_type) @endcode
    *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   *
+   * A lookup that is in progress when the operation is cancelled continues on
+   * the resolver's internal thread, and its result is discarded.
+   *
    * @note On POSIX systems, host names may be locally defined in the file
    * <tt>/etc/hosts</tt>. On Windows, host names may be defined in the file
    * <tt>c:\\windows\\system32\\drivers\\etc\\hosts</tt>. Remote host name
@@ -695,6 +708,19 @@ public:
    * @par Completion Signature
    * @code void(asio::error_code, results_type) @endcode
    *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   *
+   * A lookup that is in progress when the operation is cancelled continues on
+   * the resolver's internal thread, and its result is discarded.
+   *
    * @note On POSIX systems, host names may be locally defined in the file
    * <tt>/etc/hosts</tt>. On Windows, host names may be defined in the file
    * <tt>c:\\windows\\system32\\drivers\\etc\\hosts</tt>. Remote host name
@@ -766,6 +792,19 @@ public:
    * @par Completion Signature
    * @code void(asio::error_code, results_type) @endcode
    *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   *
+   * A lookup that is in progress when the operation is cancelled continues on
+   * the resolver's internal thread, and its result is discarded.
+   *
    * @note On POSIX systems, host names may be locally defined in the file
    * <tt>/etc/hosts</tt>. On Windows, host names may be defined in the file
    * <tt>c:\\windows\\system32\\drivers\\etc\\hosts</tt>. Remote host name
@@ -838,6 +877,19 @@ public:
    * @par Completion Signature
    * @code void(asio::error_code, results_type) @endcode
    *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   *
+   * A lookup that is in progress when the operation is cancelled continues on
+   * the resolver's internal thread, and its result is discarded.
+   *
    * @note On POSIX systems, host names may be locally defined in the file
    * <tt>/etc/hosts</tt>. On Windows, host names may be defined in the file
    * <tt>c:\\windows\\system32\\drivers\\etc\\hosts</tt>. Remote host name
@@ -942,6 +994,19 @@ public:
    *
    * @par Completion Signature
    * @code void(asio::error_code, results_type) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   *
+   * A lookup that is in progress when the operation is cancelled continues on
+   * the resolver's internal thread, and its result is discarded.
    */
   template <
       ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
@@ -18,6 +18,7 @@
 #include "asio/detail/config.hpp"
 #include <string>
 #include "asio/detail/string_view.hpp"
+#include "asio/ip/detail/resolver_entries.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -52,11 +53,21 @@ public:
   basic_resolver_entry(const endpoint_type& ep,
       ASIO_STRING_VIEW_PARAM host, ASIO_STRING_VIEW_PARAM service)
     : endpoint_(ep),
-      host_name_(static_cast<std::string>(host)),
-      service_name_(static_cast<std::string>(service))
+      names_(detail::resolver_names::create(
+            host.data(), host.size(), service.data(), service.size()))
   {
   }
 
+#if !defined(GENERATING_DOCUMENTATION)
+  // Construct with an endpoint and names that are shared with other entries.
+  basic_resolver_entry(const endpoint_type& ep,
+      detail::resolver_names_ptr names) noexcept
+    : endpoint_(ep),
+      names_(static_cast<detail::resolver_names_ptr&&>(names))
+  {
+  }
+#endif // !defined(GENERATING_DOCUMENTATION)
+
   /// Get the endpoint associated with the entry.
   endpoint_type endpoint() const
   {
@@ -72,7 +83,8 @@ public:
   /// Get the host name associated with the entry.
   std::string host_name() const
   {
-    return host_name_;
+    return names_.get() ? std::string(names_.get()->host_name(),
+        names_.get()->host_name_length()) : std::string();
   }
 
   /// Get the host name associated with the entry.
@@ -81,13 +93,14 @@ public:
       const Allocator& alloc = Allocator()) const
   {
     return std::basic_string<char, std::char_traits<char>, Allocator>(
-        host_name_.c_str(), alloc);
+        names_.get() ? names_.get()->host_name() : "", alloc);
   }
 
   /// Get the service name associated with the entry.
   std::string service_name() const
   {
-    return service_name_;
+    return names_.get() ? std::string(names_.get()->service_name(),
+        names_.get()->service_name_length()) : std::string();
   }
 
   /// Get the service name associated with the entry.
@@ -96,13 +109,12 @@ public:
       const Allocator& alloc = Allocator()) const
   {
     return std::basic_string<char, std::char_traits<char>, Allocator>(
-        service_name_.c_str(), alloc);
+        names_.get() ? names_.get()->service_name() : "", alloc);
   }
 
 private:
   endpoint_type endpoint_;
-  std::string host_name_;
-  std::string service_name_;
+  detail::resolver_names_ptr names_;
 };
 
 } // namespace ip
@@ -25,6 +25,7 @@
 #include "asio/detail/socket_ops.hpp"
 #include "asio/detail/socket_types.hpp"
 #include "asio/ip/basic_resolver_entry.hpp"
+#include "asio/ip/detail/resolver_entries.hpp"
 
 #if defined(ASIO_WINDOWS_RUNTIME)
 # include "asio/detail/winrt_utils.hpp"
@@ -174,8 +175,10 @@ protected:
     return (*values_)[index_];
   }
 
-  typedef std::vector<basic_resolver_entry<InternetProtocol>> values_type;
-  typedef asio::detail::shared_ptr<values_type> values_ptr_type;
+  typedef detail::resolver_entries<
+    basic_resolver_entry<InternetProtocol>> values_type;
+  typedef detail::resolver_entries_ptr<
+    basic_resolver_entry<InternetProtocol>> values_ptr_type;
   values_ptr_type values_;
   std::size_t index_;
 };
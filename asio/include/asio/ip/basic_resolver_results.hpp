@@ -18,6 +18,8 @@
 #include "asio/detail/config.hpp"
 #include <cstddef>
 #include <cstring>
+#include <iterator>
+#include <string>
 #include "asio/detail/socket_ops.hpp"
 #include "asio/detail/socket_types.hpp"
 #include "asio/ip/basic_resolver_iterator.hpp"
@@ -121,11 +123,23 @@ public:
     if (!address_info)
       return results;
 
-    std::string actual_host_name = host_name;
+    const char* actual_host_name = host_name.c_str();
+    std::size_t actual_host_name_length = host_name.size();
     if (address_info->ai_canonname)
+    {
       actual_host_name = address_info->ai_canonname;
+      actual_host_name_length = std::strlen(address_info->ai_canonname);
+    }
 
-    results.values_.reset(new values_type);
+    std::size_t count = 0;
+    for (asio::detail::addrinfo_type* ai = address_info; ai; ai = ai->ai_next)
+      if (ai->ai_family == ASIO_OS_DEF(AF_INET)
+          || ai->ai_family == ASIO_OS_DEF(AF_INET6))
+        ++count;
+
+    results.values_.reset(values_type::create(count,
+          actual_host_name, actual_host_name_length,
+          service_name.data(), service_name.size()));
 
     while (address_info)
     {
@@ -137,13 +151,14 @@ public:
         endpoint.resize(static_cast<std::size_t>(address_info->ai_addrlen));
         memcpy(endpoint.data(), address_info->ai_addr,
             address_info->ai_addrlen);
-        results.values_->push_back(
-            basic_resolver_entry<InternetProtocol>(endpoint,
-              actual_host_name, service_name));
+        results.values_->push_back(endpoint);
       }
       address_info = address_info->ai_next;
     }
 
+    if (results.values_->empty())
+      results.values_.reset();
+
     return results;
   }
 
@@ -152,10 +167,10 @@ public:
       const std::string& host_name, const std::string& service_name)
   {
     basic_resolver_results results;
-    results.values_.reset(new values_type);
-    results.values_->push_back(
-        basic_resolver_entry<InternetProtocol>(
-          endpoint, host_name, service_name));
+    results.values_.reset(values_type::create(1,
+          host_name.data(), host_name.size(),
+          service_name.data(), service_name.size()));
+    results.values_->push_back(endpoint);
     return results;
   }
 
@@ -168,13 +183,12 @@ public:
     basic_resolver_results results;
     if (begin != end)
     {
-      results.values_.reset(new values_type);
+      std::size_t count = static_cast<std::size_t>(std::distance(begin, end));
+      results.values_.reset(values_type::create(count,
+            host_name.data(), host_name.size(),
+            service_name.data(), service_name.size()));
       for (EndpointIterator ep_iter = begin; ep_iter != end; ++ep_iter)
-      {
-        results.values_->push_back(
-            basic_resolver_entry<InternetProtocol>(
-              *ep_iter, host_name, service_name));
-      }
+        results.values_->push_back(*ep_iter);
     }
     return results;
   }
@@ -190,7 +204,9 @@ public:
     basic_resolver_results results;
     if (endpoints->Size)
     {
-      results.values_.reset(new values_type);
+      results.values_.reset(values_type::create(endpoints->Size,
+            host_name.data(), host_name.size(),
+            service_name.data(), service_name.size()));
       for (unsigned int i = 0; i < endpoints->Size; ++i)
       {
         auto pair = endpoints->GetAt(i);
@@ -206,15 +222,15 @@ public:
           continue;
 
         results.values_->push_back(
-            basic_resolver_entry<InternetProtocol>(
-              typename InternetProtocol::endpoint(
-                ip::make_address(
-                  asio::detail::winrt_utils::string(
-                    pair->RemoteHostName->CanonicalName)),
-                asio::detail::winrt_utils::integer(
-                  pair->RemoteServiceName)),
-              host_name, service_name));
+            typename InternetProtocol::endpoint(
+              ip::make_address(
+                asio::detail::winrt_utils::string(
+                  pair->RemoteHostName->CanonicalName)),
+              asio::detail::winrt_utils::integer(
+                pair->RemoteServiceName)));
       }
+      if (results.values_->empty())
+        results.values_.reset();
     }
     return results;
   }
@@ -230,7 +246,7 @@ public:
   /// Get the maximum number of entries permitted in a results range.
   size_type max_size() const noexcept
   {
-    return this->values_ ? this->values_->max_size() : values_type().max_size();
+    return values_type::max_size();
   }
 
   /// Determine whether the results range is empty.
@@ -292,7 +308,8 @@ public:
   }
 
 private:
-  typedef std::vector<basic_resolver_entry<InternetProtocol>> values_type;
+  typedef typename basic_resolver_iterator<InternetProtocol>::values_type
+    values_type;
 };
 
 } // namespace ip
@@ -0,0 +1,459 @@
+//
+// ip/caching_resolver.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_CACHING_RESOLVER_HPP
+#define ASIO_IP_CACHING_RESOLVER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <string>
+#include <utility>
+#include "asio/any_io_executor.hpp"
+#include "asio/append.hpp"
+#include "asio/associated_executor.hpp"
+#include "asio/async_result.hpp"
+#include "asio/dispatch.hpp"
+#include "asio/error.hpp"
+#include "asio/executor_work_guard.hpp"
+#include "asio/post.hpp"
+#include "asio/ip/basic_resolver.hpp"
+#include "asio/detail/resolver_cache.hpp"
+#include "asio/detail/string_view.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+
+/// Provides endpoint resolution with a cache of recent results.
+/**
+ * The caching_resolver class template performs forward resolution of host and
+ * service names, as does basic_resolver, but first consults a cache of the
+ * results of recent resolutions. The cache is shared by all caching resolvers
+ * for a protocol that use the same execution context, and may be used from
+ * several threads at once.
+ *
+ * @li Successful results are cached for the time given by the @c "resolver" /
+ * @c "cache_ttl" configuration option, in milliseconds.
+ *
+ * @li A host_not_found error is cached for the time given by the @c
+ * "resolver" / @c "cache_negative_ttl" configuration option, in milliseconds.
+ * Other errors are not cached.
+ *
+ * @li When a name is already being resolved, a lookup of the same name waits
+ * for that resolution to complete, rather than starting another.
+ *
+ * As the underlying resolution functions do not report the lifetime of a
+ * record, cached results may be used after the record itself has changed.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+template <typename InternetProtocol, typename Executor = any_io_executor>
+class caching_resolver
+  : public resolver_base
+{
+private:
+  class initiate_async_resolve;
+
+  typedef asio::detail::resolver_cache<InternetProtocol> cache_type;
+
+public:
+  /// The type of the executor associated with the object.
+  typedef Executor executor_type;
+
+  /// Rebinds the resolver type to another executor.
+  template <typename Executor1>
+  struct rebind_executor
+  {
+    /// The resolver type when rebound to the specified executor.
+    typedef caching_resolver<InternetProtocol, Executor1> other;
+  };
+
+  /// The protocol type.
+  typedef InternetProtocol protocol_type;
+
+  /// The endpoint type.
+  typedef typename InternetProtocol::endpoint endpoint_type;
+
+  /// The results type.
+  typedef basic_resolver_results<InternetProtocol> results_type;
+
+  /// Construct with executor.
+  /**
+   * This constructor creates a caching_resolver.
+   *
+   * @param ex The I/O executor that the resolver will use, by default, to
+   * dispatch handlers for any asynchronous operations performed on the
+   * resolver.
+   */
+  explicit caching_resolver(const executor_type& ex)
+    : resolver_(ex),
+      cache_(&asio::use_service<cache_type>(get_context(ex)))
+  {
+  }
+
+  /// Construct with execution context.
+  /**
+   * This constructor creates a caching_resolver.
+   *
+   * @param context An execution context which provides the I/O executor that
+   * the resolver will use, by default, to dispatch handlers for any
+   * asynchronous operations performed on the resolver.
+   */
+  template <typename ExecutionContext>
+  explicit caching_resolver(ExecutionContext& context,
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      > = 0)
+    : resolver_(context),
+      cache_(&asio::use_service<cache_type>(context))
+  {
+  }
+
+  /// Move-construct a caching_resolver from another.
+  /**
+   * @note Following the move, the moved-from object is in the same state as if
+   * constructed using the @c caching_resolver(const executor_type&)
+   * constructor.
+   */
+  caching_resolver(caching_resolver&& other)
+    : resolver_(std::move(other.resolver_)),
+      cache_(other.cache_)
+  {
+  }
+
+  /// Move-assign a caching_resolver from another.
+  /**
+   * Any asynchronous resolve operations started by this object are cancelled.
+   */
+  caching_resolver& operator=(caching_resolver&& other)
+  {
+    resolver_ = std::move(other.resolver_);
+    cache_ = other.cache_;
+    return *this;
+  }
+
+  /// Destroys the resolver.
+  /**
+   * This function destroys the resolver, cancelling any outstanding
+   * asynchronous resolve operations started by this object, as if by calling
+   * @c cancel.
+   */
+  ~caching_resolver()
+  {
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() noexcept
+  {
+    return resolver_.get_executor();
+  }
+
+  /// Cancel any asynchronous operations that are waiting on the resolver.
+  /**
+   * This function forces the completion of any pending asynchronous
+   * resolutions started by this object. The handlers for the cancelled
+   * operations, including those of any other caching resolver waiting for the
+   * same name, will be invoked with the asio::error::operation_aborted error
+   * code.
+   */
+  void cancel()
+  {
+    resolver_.cancel();
+  }
+
+  /// Perform forward resolution of a query to a list of entries.
+  /**
+   * This function is used to resolve host and service names into a list of
+   * endpoint entries, using cached results where they are available.
+   *
+   * @param host A string identifying a location. May be a descriptive name or
+   * a numeric address string.
+   *
+   * @param service A string identifying the requested service. This may be a
+   * descriptive name or a numeric string corresponding to a port number.
+   *
+   * @param resolve_flags A set of flags that determine how name resolution
+   * should be performed.
+   *
+   * @returns A range object representing the list of endpoint entries.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  results_type resolve(ASIO_STRING_VIEW_PARAM host,
+      ASIO_STRING_VIEW_PARAM service,
+      resolver_base::flags resolve_flags = resolver_base::flags())
+  {
+    asio::error_code ec;
+    results_type r = resolve(host, service, resolve_flags, ec);
+    asio::detail::throw_error(ec, "resolve");
+    return r;
+  }
+
+  /// Perform forward resolution of a query to a list of entries.
+  /**
+   * This function is used to resolve host and service names into a list of
+   * endpoint entries, using cached results where they are available. A
+   * synchronous resolution does not wait for one that is in progress.
+   *
+   * @param host A string identifying a location. May be a descriptive name or
+   * a numeric address string.
+   *
+   * @param service A string identifying the requested service. This may be a
+   * descriptive name or a numeric string corresponding to a port number.
+   *
+   * @param resolve_flags A set of flags that determine how name resolution
+   * should be performed.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns A range object representing the list of endpoint entries. An
+   * empty range is returned if an error occurs.
+   */
+  results_type resolve(ASIO_STRING_VIEW_PARAM host,
+      ASIO_STRING_VIEW_PARAM service, resolver_base::flags resolve_flags,
+      asio::error_code& ec)
+  {
+    std::string key = cache_type::make_key(static_cast<std::string>(host),
+        static_cast<std::string>(service), resolve_flags);
+
+    results_type results;
+    if (!cache_->find(key, results, ec))
+    {
+      results = resolver_.resolve(host, service, resolve_flags, ec);
+      cache_->insert(key, ec, results);
+    }
+    return results;
+  }
+
+  /// Asynchronously perform forward resolution of a query to a list of
+  /// entries.
+  /**
+   * This function is used to resolve host and service names into a list of
+   * endpoint entries, using cached results where they are available. It is an
+   * initiating function for an @ref asynchronous_operation, and always returns
+   * immediately.
+   *
+   * @param host A string identifying a location. May be a descriptive name or
+   * a numeric address string.
+   *
+   * @param service A string identifying the requested service. This may be a
+   * descriptive name or a numeric string corresponding to a port number.
+   *
+   * @param resolve_flags A set of flags that determine how name resolution
+   * should be performed.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the resolve completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   results_type results // Resolved endpoints as a range.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, results_type) @endcode
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        results_type)) ResolveToken = default_completion_token_t<executor_type>>
+  auto async_resolve(ASIO_STRING_VIEW_PARAM host,
+      ASIO_STRING_VIEW_PARAM service, resolver_base::flags resolve_flags,
+      ResolveToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      asio::async_initiate<ResolveToken,
+        void (asio::error_code, results_type)>(
+          declval<initiate_async_resolve>(), token,
+          declval<std::string>(), declval<std::string>(), resolve_flags))
+  {
+    return asio::async_initiate<ResolveToken,
+      void (asio::error_code, results_type)>(
+        initiate_async_resolve(this), token,
+        static_cast<std::string>(host),
+        static_cast<std::string>(service), resolve_flags);
+  }
+
+  /// Asynchronously perform forward resolution of a query to a list of
+  /// entries.
+  /**
+   * This function is used to resolve host and service names into a list of
+   * endpoint entries, using cached results where they are available. It is
+   * equivalent to calling <tt>async_resolve(host, service,
+   * resolver_base::flags(), token)</tt>.
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, results_type) @endcode
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        results_type)) ResolveToken = default_completion_token_t<executor_type>>
+  auto async_resolve(ASIO_STRING_VIEW_PARAM host,
+      ASIO_STRING_VIEW_PARAM service,
+      ResolveToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      asio::async_initiate<ResolveToken,
+        void (asio::error_code, results_type)>(
+          declval<initiate_async_resolve>(), token,
+          declval<std::string>(), declval<std::string>(),
+          resolver_base::flags()))
+  {
+    return async_resolve(host, service, resolver_base::flags(),
+        static_cast<ResolveToken&&>(token));
+  }
+
+private:
+  // Disallow copying and assignment.
+  caching_resolver(const caching_resolver&) = delete;
+  caching_resolver& operator=(const caching_resolver&) = delete;
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      enable_if_t<execution::is_executor<T>::value>* = 0)
+  {
+    return asio::query(t, execution::context);
+  }
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      enable_if_t<!execution::is_executor<T>::value>* = 0)
+  {
+    return t.context();
+  }
+
+  // Waits for a resolution that may have been started by another object, and
+  // keeps the handler's executor busy while it does so.
+  template <typename Handler>
+  class waiting_handler
+  {
+  public:
+    waiting_handler(Handler&& handler, const executor_type& ex)
+      : work_(asio::make_work_guard(handler, ex)),
+        handler_(static_cast<Handler&&>(handler))
+    {
+    }
+
+    void operator()(asio::error_code ec, results_type results)
+    {
+      typename associated_executor<Handler, executor_type>::type ex(
+          work_.get_executor());
+      asio::dispatch(ex, asio::append(static_cast<Handler&&>(handler_),
+            ec, static_cast<results_type&&>(results)));
+      work_.reset();
+    }
+
+  private:
+    executor_work_guard<
+      typename associated_executor<Handler, executor_type>::type> work_;
+    Handler handler_;
+  };
+
+  // Passes the results of a resolution to the cache.
+  class resolve_handler
+  {
+  public:
+    resolve_handler(cache_type* cache, std::string&& key)
+      : cache_(cache),
+        key_(static_cast<std::string&&>(key))
+    {
+    }
+
+    void operator()(const asio::error_code& ec, const results_type& results)
+    {
+      cache_->complete(key_, ec, results);
+    }
+
+  private:
+    cache_type* cache_;
+    std::string key_;
+  };
+
+  class initiate_async_resolve
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_resolve(caching_resolver* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ResolveHandler>
+    void operator()(ResolveHandler&& handler, const std::string& host,
+        const std::string& service, resolver_base::flags resolve_flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ResolveHandler.
+      ASIO_RESOLVE_HANDLER_CHECK(
+          ResolveHandler, handler, results_type) type_check;
+
+      std::string key = cache_type::make_key(host, service, resolve_flags);
+
+      asio::error_code ec;
+      results_type results;
+      if (!self_->cache_->find(key, results, ec))
+      {
+        typename cache_type::waiter_type waiter(
+            waiting_handler<decay_t<ResolveHandler>>(
+              static_cast<ResolveHandler&&>(handler), self_->get_executor()));
+        switch (self_->cache_->lookup(key, waiter, results, ec))
+        {
+        case cache_type::started:
+          self_->resolver_.async_resolve(host, service, resolve_flags,
+              resolve_handler(self_->cache_, static_cast<std::string&&>(key)));
+          return;
+        case cache_type::joined:
+          return;
+        case cache_type::cached:
+        default:
+          asio::post(self_->get_executor(),
+              asio::append(static_cast<typename cache_type::waiter_type&&>(
+                  waiter), ec, results));
+          return;
+        }
+      }
+
+      asio::post(self_->get_executor(),
+          asio::append(static_cast<ResolveHandler&&>(handler), ec, results));
+    }
+
+  private:
+    caching_resolver* self_;
+  };
+
+  basic_resolver<InternetProtocol, Executor> resolver_;
+  cache_type* cache_;
+};
+
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IP_CACHING_RESOLVER_HPP
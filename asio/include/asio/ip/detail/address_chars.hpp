@@ -0,0 +1,89 @@
+//
+// ip/detail/address_chars.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_DETAIL_ADDRESS_CHARS_HPP
+#define ASIO_IP_DETAIL_ADDRESS_CHARS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+namespace detail {
+
+// Conversions between IP addresses and their textual form that do not depend
+// on the operating system. The output and input formats are those of the
+// POSIX inet_ntop and inet_pton functions.
+
+// Write the dotted decimal form of an IPv4 address. The output buffer must
+// have space for at least 15 characters. Returns the end of the output.
+ASIO_DECL char* format_address_v4(
+    const unsigned char* bytes, char* out) noexcept;
+
+// Write the RFC 5952 form of an IPv6 address, without a scope id. The output
+// buffer must have space for at least 45 characters. Returns the end of the
+// output.
+ASIO_DECL char* format_address_v6(
+    const unsigned char* bytes, char* out) noexcept;
+
+// Write a scope id, including the leading '%'. Link-local addresses use the
+// interface name where one is available. The output buffer must have space
+// for at least max_scope_id_chars characters. Returns the end of the output.
+enum { max_scope_id_chars = 33 };
+ASIO_DECL char* format_scope_id(const unsigned char* bytes,
+    unsigned long scope_id, char* out) noexcept;
+
+// Return the end of the longest prefix of a range that consists only of
+// characters that may appear in an IPv4 address.
+ASIO_DECL const char* scan_address_v4(
+    const char* first, const char* last) noexcept;
+
+// Return the end of the longest prefix of a range that consists only of
+// characters that may appear in an IPv6 address, excluding any scope id.
+ASIO_DECL const char* scan_address_v6(
+    const char* first, const char* last) noexcept;
+
+// Return the end of the longest prefix of a range that consists only of
+// characters that may appear in a scope id, excluding the leading '%'.
+ASIO_DECL const char* scan_scope_id(
+    const char* first, const char* last) noexcept;
+
+// Parse exactly the characters in a range as an IPv4 address. Returns false if
+// the characters are not a valid address.
+ASIO_DECL bool parse_address_v4(const char* first,
+    const char* last, unsigned char* bytes) noexcept;
+
+// Parse exactly the characters in a range as an IPv6 address without a scope
+// id. Returns false if the characters are not a valid address.
+ASIO_DECL bool parse_address_v6(const char* first,
+    const char* last, unsigned char* bytes) noexcept;
+
+// Parse the characters in a range as a scope id, excluding the leading '%'.
+// Link-local addresses may use an interface name. Otherwise, the leading
+// digits give the scope id and any other characters are ignored.
+ASIO_DECL void parse_scope_id(const unsigned char* bytes, const char* first,
+    const char* last, unsigned long& scope_id) noexcept;
+
+} // namespace detail
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/ip/detail/impl/address_chars.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_IP_DETAIL_ADDRESS_CHARS_HPP
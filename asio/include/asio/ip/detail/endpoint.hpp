@@ -113,6 +113,19 @@ public:
     return data_.base.sa_family == ASIO_OS_DEF(AF_INET);
   }
 
+  // The maximum number of characters in the string form of an endpoint.
+  enum { max_string_length = asio::ip::address::max_string_length + 8 };
+
+  // Write the endpoint to a character range as "address:port", with an IPv6
+  // address enclosed in brackets. Returns the end of the characters written.
+  ASIO_DECL char* to_chars(char* first, char* last,
+      asio::error_code& ec) const noexcept;
+
+  // Read an endpoint in the form written by to_chars from the start of a
+  // character range. Returns the first character that was not parsed.
+  ASIO_DECL const char* from_chars(const char* first,
+      const char* last, asio::error_code& ec) noexcept;
+
 #if !defined(ASIO_NO_IOSTREAM)
   // Convert to a string.
   ASIO_DECL std::string to_string() const;
@@ -0,0 +1,378 @@
+//
+// ip/detail/impl/address_chars.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_DETAIL_IMPL_ADDRESS_CHARS_IPP
+#define ASIO_IP_DETAIL_IMPL_ADDRESS_CHARS_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstring>
+#include "asio/detail/socket_types.hpp"
+#include "asio/ip/detail/address_chars.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+namespace detail {
+
+namespace address_chars {
+
+// Classification of input characters, indexed by the character's value.
+enum
+{
+  decimal = 1,  // 0-9
+  hex = 2,      // 0-9, a-f, A-F
+  v6 = 4,       // 0-9, a-f, A-F, ':', '.'
+  scope = 8     // 0-9, a-z, A-Z, '-', '.', '_'
+};
+
+inline unsigned char classify(char c) noexcept
+{
+  static const unsigned char table[128] =
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    // ' ' to '/'
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 8, 12, 0,
+    // '0' to '?'
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 4, 0, 0, 0, 0, 0,
+    // '@' to 'O'
+    0, 14, 14, 14, 14, 14, 14, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    // 'P' to '_'
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 0, 0, 0, 0, 8,
+    // '`' to 'o'
+    0, 14, 14, 14, 14, 14, 14, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    // 'p' to DEL
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 0, 0, 0, 0, 0
+  };
+
+  unsigned char u = static_cast<unsigned char>(c);
+  return u < 128 ? table[u] : 0;
+}
+
+inline int hex_value(char c) noexcept
+{
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  return (c | 0x20) - 'a' + 10;
+}
+
+inline bool is_link_local(const unsigned char* bytes) noexcept
+{
+  return (bytes[0] == 0xfe && (bytes[1] & 0xc0) == 0x80)
+    || (bytes[0] == 0xff && (bytes[1] & 0x0f) == 0x02);
+}
+
+inline char* format_decimal(unsigned long value, char* out) noexcept
+{
+  char digits[24];
+  char* p = digits + sizeof(digits);
+  do
+  {
+    *--p = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  std::size_t n = digits + sizeof(digits) - p;
+  std::memcpy(out, p, n);
+  return out + n;
+}
+
+} // namespace address_chars
+
+char* format_address_v4(const unsigned char* bytes, char* out) noexcept
+{
+  for (int i = 0; i < 4; ++i)
+  {
+    unsigned int value = bytes[i];
+    if (i != 0)
+      *out++ = '.';
+    if (value >= 100)
+    {
+      *out++ = static_cast<char>('0' + value / 100);
+      value %= 100;
+      *out++ = static_cast<char>('0' + value / 10);
+    }
+    else if (value >= 10)
+      *out++ = static_cast<char>('0' + value / 10);
+    *out++ = static_cast<char>('0' + value % 10);
+  }
+  return out;
+}
+
+char* format_address_v6(const unsigned char* bytes, char* out) noexcept
+{
+  static const char hex_digits[] = "0123456789abcdef";
+
+  unsigned int words[8];
+  for (int i = 0; i < 8; ++i)
+    words[i] = (bytes[2 * i] << 8) | bytes[2 * i + 1];
+
+  // Find the first longest run of two or more zero words.
+  int best_base = -1, best_len = 0;
+  for (int i = 0; i < 8;)
+  {
+    if (words[i] != 0)
+    {
+      ++i;
+      continue;
+    }
+    int base = i;
+    while (i < 8 && words[i] == 0)
+      ++i;
+    if (i - base > best_len)
+      best_base = base, best_len = i - base;
+  }
+  if (best_len < 2)
+    best_base = -1, best_len = 0;
+
+  for (int i = 0; i < 8; ++i)
+  {
+    if (i == best_base)
+    {
+      *out++ = ':';
+      i += best_len - 1;
+      continue;
+    }
+
+    if (i != 0)
+      *out++ = ':';
+
+    // IPv4-mapped and IPv4-compatible addresses end in dotted decimal form.
+    if (i == 6 && best_base == 0
+        && (best_len == 6 || (best_len == 5 && words[5] == 0xffff)))
+      return format_address_v4(bytes + 12, out);
+
+    unsigned int word = words[i];
+    if (word >= 0x1000)
+      *out++ = hex_digits[word >> 12];
+    if (word >= 0x100)
+      *out++ = hex_digits[(word >> 8) & 0xf];
+    if (word >= 0x10)
+      *out++ = hex_digits[(word >> 4) & 0xf];
+    *out++ = hex_digits[word & 0xf];
+  }
+
+  if (best_base != -1 && best_base + best_len == 8)
+    *out++ = ':';
+
+  return out;
+}
+
+char* format_scope_id(const unsigned char* bytes,
+    unsigned long scope_id, char* out) noexcept
+{
+  *out++ = '%';
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  if (address_chars::is_link_local(bytes))
+  {
+    char if_name[IF_NAMESIZE > 32 ? IF_NAMESIZE : 32];
+    if (::if_indextoname(static_cast<unsigned>(scope_id), if_name) != 0)
+    {
+      std::size_t n = std::strlen(if_name);
+      if (n < max_scope_id_chars)
+      {
+        std::memcpy(out, if_name, n);
+        return out + n;
+      }
+    }
+  }
+#else // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  (void)bytes;
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  return address_chars::format_decimal(scope_id, out);
+}
+
+const char* scan_address_v4(const char* first, const char* last) noexcept
+{
+  while (first != last && (*first == '.'
+        || (address_chars::classify(*first) & address_chars::decimal)))
+    ++first;
+  return first;
+}
+
+const char* scan_address_v6(const char* first, const char* last) noexcept
+{
+  while (first != last
+      && (address_chars::classify(*first) & address_chars::v6))
+    ++first;
+  return first;
+}
+
+const char* scan_scope_id(const char* first, const char* last) noexcept
+{
+  while (first != last
+      && (address_chars::classify(*first) & address_chars::scope))
+    ++first;
+  return first;
+}
+
+bool parse_address_v4(const char* first,
+    const char* last, unsigned char* bytes) noexcept
+{
+  // Exactly four decimal octets separated by dots. An octet may not have a
+  // leading zero.
+  for (int i = 0; i < 4; ++i)
+  {
+    if (i != 0)
+    {
+      if (first == last || *first != '.')
+        return false;
+      ++first;
+    }
+
+    if (first == last
+        || !(address_chars::classify(*first) & address_chars::decimal))
+      return false;
+
+    unsigned int value = *first++ - '0';
+    if (value != 0)
+    {
+      for (int j = 0; j < 2 && first != last
+          && (address_chars::classify(*first) & address_chars::decimal); ++j)
+        value = value * 10 + (*first++ - '0');
+      if (value > 255)
+        return false;
+    }
+
+    bytes[i] = static_cast<unsigned char>(value);
+  }
+
+  return first == last;
+}
+
+bool parse_address_v6(const char* first,
+    const char* last, unsigned char* bytes) noexcept
+{
+  unsigned char tmp[16] = { 0 };
+  unsigned char* tp = tmp;
+  unsigned char* const endp = tmp + 16;
+  unsigned char* colonp = 0;
+
+  // A leading "::" requires special handling.
+  if (first == last)
+    return false;
+  if (*first == ':')
+  {
+    if (++first == last || *first != ':')
+      return false;
+  }
+
+  const char* curtok = first;
+  int digits_seen = 0;
+  unsigned int value = 0;
+  while (first != last)
+  {
+    char c = *first++;
+    if (address_chars::classify(c) & address_chars::hex)
+    {
+      if (digits_seen == 4)
+        return false;
+      value = (value << 4) | address_chars::hex_value(c);
+      ++digits_seen;
+      continue;
+    }
+
+    if (c == ':')
+    {
+      curtok = first;
+      if (digits_seen == 0)
+      {
+        if (colonp)
+          return false;
+        colonp = tp;
+        continue;
+      }
+      if (first == last || tp + 2 > endp)
+        return false;
+      *tp++ = static_cast<unsigned char>(value >> 8);
+      *tp++ = static_cast<unsigned char>(value);
+      digits_seen = 0;
+      value = 0;
+      continue;
+    }
+
+    // The address may end in dotted decimal form.
+    if (c == '.' && tp + 4 <= endp && parse_address_v4(curtok, last, tp))
+    {
+      tp += 4;
+      digits_seen = 0;
+      break;
+    }
+
+    return false;
+  }
+
+  if (digits_seen > 0)
+  {
+    if (tp + 2 > endp)
+      return false;
+    *tp++ = static_cast<unsigned char>(value >> 8);
+    *tp++ = static_cast<unsigned char>(value);
+  }
+
+  if (colonp)
+  {
+    // The "::" must stand for at least one zero word.
+    if (tp == endp)
+      return false;
+    std::size_t n = tp - colonp;
+    std::memmove(endp - n, colonp, n);
+    std::memset(colonp, 0, endp - n - colonp);
+    tp = endp;
+  }
+
+  if (tp != endp)
+    return false;
+
+  std::memcpy(bytes, tmp, 16);
+  return true;
+}
+
+void parse_scope_id(const unsigned char* bytes, const char* first,
+    const char* last, unsigned long& scope_id) noexcept
+{
+  scope_id = 0;
+
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  // Link-local addresses may name an interface.
+  if (address_chars::is_link_local(bytes))
+  {
+    char if_name[IF_NAMESIZE > 32 ? IF_NAMESIZE : 32];
+    std::size_t n = last - first;
+    if (n < sizeof(if_name))
+    {
+      std::memcpy(if_name, first, n);
+      if_name[n] = 0;
+      scope_id = ::if_nametoindex(if_name);
+      if (scope_id != 0)
+        return;
+    }
+  }
+#else // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  (void)bytes;
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+  // Otherwise use the leading digits, as atoi would.
+  for (; first != last
+      && (address_chars::classify(*first) & address_chars::decimal); ++first)
+    scope_id = (scope_id * 10 + (*first - '0')) & 0xFFFFFFFFUL;
+}
+
+} // namespace detail
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IP_DETAIL_IMPL_ADDRESS_CHARS_IPP
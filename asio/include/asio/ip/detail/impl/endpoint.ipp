@@ -17,9 +17,6 @@
 
 #include "asio/detail/config.hpp"
 #include <cstring>
-#if !defined(ASIO_NO_IOSTREAM)
-# include <sstream>
-#endif // !defined(ASIO_NO_IOSTREAM)
 #include "asio/detail/socket_ops.hpp"
 #include "asio/detail/throw_error.hpp"
 #include "asio/error.hpp"
@@ -171,18 +168,95 @@ bool operator<(const endpoint& e1, const endpoint& e2) noexcept
   return e1.port() < e2.port();
 }
 
-#if !defined(ASIO_NO_IOSTREAM)
-std::string endpoint::to_string() const
+char* endpoint::to_chars(char* first, char* last,
+    asio::error_code& ec) const noexcept
 {
-  std::ostringstream tmp_os;
-  tmp_os.imbue(std::locale::classic());
-  if (is_v4())
-    tmp_os << address();
+  char str[max_string_length];
+  char* p = str;
+  if (!is_v4())
+    *p++ = '[';
+  p = asio::ip::to_chars(p, str + max_string_length, address(), ec);
+  if (!is_v4())
+    *p++ = ']';
+  *p++ = ':';
+
+  char digits[5];
+  char* d = digits + sizeof(digits);
+  unsigned short port_num = port();
+  do
+  {
+    *--d = static_cast<char>('0' + port_num % 10);
+    port_num /= 10;
+  } while (port_num != 0);
+  std::size_t n = digits + sizeof(digits) - d;
+  std::memcpy(p, d, n);
+  p += n;
+
+  std::size_t length = static_cast<std::size_t>(p - str);
+  if (static_cast<std::size_t>(last - first) < length)
+  {
+    ec = asio::error::no_buffer_space;
+    return first;
+  }
+  std::memcpy(first, str, length);
+  asio::error::clear(ec);
+  return first + length;
+}
+
+const char* endpoint::from_chars(const char* first,
+    const char* last, asio::error_code& ec) noexcept
+{
+  const char* p = first;
+  asio::ip::address addr;
+  if (p != last && *p == '[')
+  {
+    asio::ip::address_v6 v6_addr;
+    p = asio::ip::from_chars(p + 1, last, v6_addr, ec);
+    if (ec || p == last || *p != ']')
+    {
+      ec = asio::error::invalid_argument;
+      return first;
+    }
+    addr = v6_addr;
+    ++p;
+  }
   else
-    tmp_os << '[' << address() << ']';
-  tmp_os << ':' << port();
+  {
+    asio::ip::address_v4 v4_addr;
+    p = asio::ip::from_chars(p, last, v4_addr, ec);
+    if (ec)
+      return first;
+    addr = v4_addr;
+  }
+
+  if (p == last || *p != ':' || ++p == last || *p < '0' || *p > '9')
+  {
+    ec = asio::error::invalid_argument;
+    return first;
+  }
+
+  unsigned long port_num = 0;
+  for (; p != last && *p >= '0' && *p <= '9'; ++p)
+  {
+    port_num = port_num * 10 + (*p - '0');
+    if (port_num > 0xFFFF)
+    {
+      ec = asio::error::invalid_argument;
+      return first;
+    }
+  }
+
+  *this = endpoint(addr, static_cast<unsigned short>(port_num));
+  asio::error::clear(ec);
+  return p;
+}
 
-  return tmp_os.str();
+#if !defined(ASIO_NO_IOSTREAM)
+std::string endpoint::to_string() const
+{
+  char str[max_string_length];
+  asio::error_code ec;
+  return std::string(str, to_chars(str, str + max_string_length, ec));
 }
 #endif // !defined(ASIO_NO_IOSTREAM)
 
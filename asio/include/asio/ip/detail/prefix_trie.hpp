@@ -0,0 +1,297 @@
+//
+// ip/detail/prefix_trie.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_DETAIL_PREFIX_TRIE_HPP
+#define ASIO_IP_DETAIL_PREFIX_TRIE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <memory>
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+namespace detail {
+
+// A key of up to 128 bits, stored most significant bit first.
+struct prefix_key
+{
+  uint64_t hi;
+  uint64_t lo;
+
+  // Get the bit at the specified position, counting from the most significant
+  // bit.
+  unsigned bit(unsigned pos) const noexcept
+  {
+    return pos < 64
+      ? static_cast<unsigned>((hi >> (63 - pos)) & 1)
+      : static_cast<unsigned>((lo >> (127 - pos)) & 1);
+  }
+
+  // Clear all bits after the specified prefix length.
+  prefix_key masked(unsigned len) const noexcept
+  {
+    const uint64_t ones = ~uint64_t(0);
+    prefix_key k;
+    k.hi = len >= 64 ? hi : (len == 0 ? 0 : hi & (ones << (64 - len)));
+    k.lo = len >= 128 ? lo : (len <= 64 ? 0 : lo & (ones << (128 - len)));
+    return k;
+  }
+
+  // Determine whether the first len bits of two keys are equal.
+  static bool matches(const prefix_key& a,
+      const prefix_key& b, unsigned len) noexcept
+  {
+    prefix_key diff = { a.hi ^ b.hi, a.lo ^ b.lo };
+    diff = diff.masked(len);
+    return diff.hi == 0 && diff.lo == 0;
+  }
+
+  // Get the number of leading bits that two keys have in common.
+  static unsigned common_length(const prefix_key& a,
+      const prefix_key& b) noexcept
+  {
+    unsigned len = 0;
+    uint64_t diff = a.hi ^ b.hi;
+    if (diff == 0)
+    {
+      len = 64;
+      diff = a.lo ^ b.lo;
+      if (diff == 0)
+        return 128;
+    }
+    while ((diff & (uint64_t(1) << 63)) == 0)
+    {
+      diff <<= 1;
+      ++len;
+    }
+    return len;
+  }
+};
+
+// A path-compressed binary trie mapping prefixes to values. Each node holds a
+// prefix, and has at most two children whose prefixes extend it. A node
+// without a value exists only to join two children.
+template <typename T>
+class prefix_trie
+  : private asio::detail::noncopyable
+{
+public:
+  prefix_trie() noexcept
+    : size_(0)
+  {
+  }
+
+  prefix_trie(prefix_trie&& other) noexcept
+    : root_(static_cast<std::unique_ptr<node>&&>(other.root_)),
+      size_(other.size_)
+  {
+    other.size_ = 0;
+  }
+
+  prefix_trie& operator=(prefix_trie&& other) noexcept
+  {
+    root_ = static_cast<std::unique_ptr<node>&&>(other.root_);
+    size_ = other.size_;
+    other.size_ = 0;
+    return *this;
+  }
+
+  // Make this trie a copy of another.
+  void assign(const prefix_trie& other)
+  {
+    std::unique_ptr<node> root(clone(other.root_.get()));
+    root_ = static_cast<std::unique_ptr<node>&&>(root);
+    size_ = other.size_;
+  }
+
+  std::size_t size() const noexcept
+  {
+    return size_;
+  }
+
+  void clear() noexcept
+  {
+    root_.reset();
+    size_ = 0;
+  }
+
+  // Insert a value for a prefix. Returns the value for the prefix, and whether
+  // a new value was inserted.
+  template <typename U>
+  T* insert(const prefix_key& k, unsigned len, U&& value, bool& inserted)
+  {
+    prefix_key key = k.masked(len);
+    std::unique_ptr<node>* p = &root_;
+    while (*p)
+    {
+      node* n = p->get();
+      unsigned common = prefix_key::common_length(n->key, key);
+      if (common > len)
+        common = len;
+      if (common < n->len)
+      {
+        // The new prefix diverges from this node's prefix, or is a prefix of
+        // it. Either way, a new node is needed above this one.
+        std::unique_ptr<node> m(new node(key.masked(common), common));
+        unsigned n_bit = n->key.bit(common);
+        m->child[n_bit] = static_cast<std::unique_ptr<node>&&>(*p);
+        if (common == len)
+        {
+          m->value.reset(new T(static_cast<U&&>(value)));
+          *p = static_cast<std::unique_ptr<node>&&>(m);
+          inserted = true;
+          ++size_;
+          return (*p)->value.get();
+        }
+
+        std::unique_ptr<node> leaf(new node(key, len));
+        leaf->value.reset(new T(static_cast<U&&>(value)));
+        T* result = leaf->value.get();
+        m->child[1 - n_bit] = static_cast<std::unique_ptr<node>&&>(leaf);
+        *p = static_cast<std::unique_ptr<node>&&>(m);
+        inserted = true;
+        ++size_;
+        return result;
+      }
+
+      if (n->len == len)
+      {
+        inserted = !n->value;
+        if (inserted)
+        {
+          n->value.reset(new T(static_cast<U&&>(value)));
+          ++size_;
+        }
+        return n->value.get();
+      }
+
+      p = &n->child[key.bit(n->len)];
+    }
+
+    p->reset(new node(key, len));
+    (*p)->value.reset(new T(static_cast<U&&>(value)));
+    inserted = true;
+    ++size_;
+    return (*p)->value.get();
+  }
+
+  // Remove the value for a prefix. Returns whether a value was removed.
+  bool erase(const prefix_key& k, unsigned len)
+  {
+    prefix_key key = k.masked(len);
+    std::unique_ptr<node>* parent = 0;
+    std::unique_ptr<node>* p = &root_;
+    while (*p && (*p)->len < len
+        && prefix_key::matches((*p)->key, key, (*p)->len))
+    {
+      parent = p;
+      p = &(*p)->child[key.bit((*p)->len)];
+    }
+
+    node* n = p->get();
+    if (!n || n->len != len || !n->value
+        || !prefix_key::matches(n->key, key, len))
+      return false;
+
+    n->value.reset();
+    --size_;
+    collapse(*p);
+    if (parent && !*p)
+      collapse(*parent);
+    return true;
+  }
+
+  // Find the value for an exact prefix.
+  T* find(const prefix_key& k, unsigned len) const noexcept
+  {
+    prefix_key key = k.masked(len);
+    const node* n = root_.get();
+    while (n && n->len < len && prefix_key::matches(n->key, key, n->len))
+      n = n->child[key.bit(n->len)].get();
+    if (n && n->len == len && prefix_key::matches(n->key, key, len))
+      return n->value.get();
+    return 0;
+  }
+
+  // Find the value for the longest prefix that matches a key of the specified
+  // length.
+  T* lookup(const prefix_key& key, unsigned len) const noexcept
+  {
+    T* best = 0;
+    const node* n = root_.get();
+    while (n && n->len <= len && prefix_key::matches(n->key, key, n->len))
+    {
+      if (n->value)
+        best = n->value.get();
+      if (n->len == len)
+        break;
+      n = n->child[key.bit(n->len)].get();
+    }
+    return best;
+  }
+
+private:
+  struct node
+  {
+    node(const prefix_key& k, unsigned l)
+      : key(k),
+        len(l)
+    {
+    }
+
+    prefix_key key;
+    unsigned len;
+    std::unique_ptr<T> value;
+    std::unique_ptr<node> child[2];
+  };
+
+  // Remove a node that has no value, if it has fewer than two children.
+  static void collapse(std::unique_ptr<node>& p)
+  {
+    node* n = p.get();
+    if (!n || n->value || (n->child[0] && n->child[1]))
+      return;
+    std::unique_ptr<node> child = static_cast<std::unique_ptr<node>&&>(
+        n->child[0] ? n->child[0] : n->child[1]);
+    p = static_cast<std::unique_ptr<node>&&>(child);
+  }
+
+  // Make a deep copy of a subtree.
+  static node* clone(const node* n)
+  {
+    if (!n)
+      return 0;
+    std::unique_ptr<node> copy(new node(n->key, n->len));
+    if (n->value)
+      copy->value.reset(new T(*n->value));
+    for (int i = 0; i < 2; ++i)
+      copy->child[i].reset(clone(n->child[i].get()));
+    return copy.release();
+  }
+
+  std::unique_ptr<node> root_;
+  std::size_t size_;
+};
+
+} // namespace detail
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IP_DETAIL_PREFIX_TRIE_HPP
@@ -0,0 +1,387 @@
+//
+// ip/detail/resolver_entries.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_DETAIL_RESOLVER_ENTRIES_HPP
+#define ASIO_IP_DETAIL_RESOLVER_ENTRIES_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <utility>
+#include "asio/detail/atomic_count.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+namespace detail {
+
+// The host and service names shared by resolver entries. The characters of
+// both names immediately follow the object, or the block that contains it.
+class resolver_names
+  : private asio::detail::noncopyable
+{
+public:
+  // Create a names object that owns its own allocation.
+  static resolver_names* create(const char* host, std::size_t host_len,
+      const char* service, std::size_t service_len)
+  {
+    void* p = ::operator new(
+        sizeof(resolver_names) + host_len + service_len + 2);
+    resolver_names* names = new (p) resolver_names(&resolver_names::destroy);
+    names->store(reinterpret_cast<char*>(names + 1),
+        host, host_len, service, service_len);
+    return names;
+  }
+
+  void add_ref() noexcept
+  {
+    asio::detail::ref_count_up(ref_count_);
+  }
+
+  void release() noexcept
+  {
+    if (asio::detail::ref_count_down(ref_count_))
+      destroy_(this);
+  }
+
+  // Get the host name, which is null-terminated.
+  const char* host_name() const noexcept
+  {
+    return chars_;
+  }
+
+  std::size_t host_name_length() const noexcept
+  {
+    return host_len_;
+  }
+
+  // Get the service name, which is null-terminated.
+  const char* service_name() const noexcept
+  {
+    return chars_ + host_len_ + 1;
+  }
+
+  std::size_t service_name_length() const noexcept
+  {
+    return service_len_;
+  }
+
+protected:
+  explicit resolver_names(void (*destroy_fn)(resolver_names*)) noexcept
+    : destroy_(destroy_fn),
+      chars_(0),
+      host_len_(0),
+      service_len_(0)
+  {
+    ref_count_ = 1;
+  }
+
+  ~resolver_names()
+  {
+  }
+
+  // Copy the names into the specified storage.
+  void store(char* chars, const char* host, std::size_t host_len,
+      const char* service, std::size_t service_len) noexcept
+  {
+    if (host_len)
+      std::memcpy(chars, host, host_len);
+    chars[host_len] = 0;
+    if (service_len)
+      std::memcpy(chars + host_len + 1, service, service_len);
+    chars[host_len + 1 + service_len] = 0;
+    chars_ = chars;
+    host_len_ = host_len;
+    service_len_ = service_len;
+  }
+
+private:
+  static void destroy(resolver_names* names) noexcept
+  {
+    names->~resolver_names();
+    ::operator delete(names);
+  }
+
+  asio::detail::atomic_count ref_count_;
+  void (*destroy_)(resolver_names*);
+  const char* chars_;
+  std::size_t host_len_;
+  std::size_t service_len_;
+};
+
+// A counted reference to a resolver_names object.
+class resolver_names_ptr
+{
+public:
+  resolver_names_ptr() noexcept
+    : p_(0)
+  {
+  }
+
+  // Take ownership of an existing reference.
+  explicit resolver_names_ptr(resolver_names* p) noexcept
+    : p_(p)
+  {
+  }
+
+  resolver_names_ptr(const resolver_names_ptr& other) noexcept
+    : p_(other.p_)
+  {
+    if (p_)
+      p_->add_ref();
+  }
+
+  resolver_names_ptr(resolver_names_ptr&& other) noexcept
+    : p_(other.p_)
+  {
+    other.p_ = 0;
+  }
+
+  ~resolver_names_ptr()
+  {
+    if (p_)
+      p_->release();
+  }
+
+  resolver_names_ptr& operator=(const resolver_names_ptr& other) noexcept
+  {
+    resolver_names_ptr tmp(other);
+    std::swap(p_, tmp.p_);
+    return *this;
+  }
+
+  resolver_names_ptr& operator=(resolver_names_ptr&& other) noexcept
+  {
+    resolver_names_ptr tmp(static_cast<resolver_names_ptr&&>(other));
+    std::swap(p_, tmp.p_);
+    return *this;
+  }
+
+  resolver_names* get() const noexcept
+  {
+    return p_;
+  }
+
+private:
+  resolver_names* p_;
+};
+
+// The entries of a set of resolver results, held in a single allocation
+// together with the names that they share. The entries are counted
+// separately from the names, so that an entry copied out of the results keeps
+// the names alive after the results are destroyed.
+template <typename Entry>
+class resolver_entries
+  : public resolver_names
+{
+public:
+  typedef Entry value_type;
+  typedef typename Entry::endpoint_type endpoint_type;
+
+  // Create an empty block with space for the specified number of entries.
+  static resolver_entries* create(std::size_t capacity,
+      const char* host, std::size_t host_len,
+      const char* service, std::size_t service_len)
+  {
+    std::size_t chars_offset = entries_offset() + capacity * sizeof(Entry);
+    void* p = ::operator new(chars_offset + host_len + service_len + 2);
+    resolver_entries* block = new (p) resolver_entries;
+    block->store(static_cast<char*>(p) + chars_offset,
+        host, host_len, service, service_len);
+    return block;
+  }
+
+  // Add an entry. The number of entries must be less than the capacity.
+  void push_back(const endpoint_type& endpoint) noexcept
+  {
+    this->add_ref();
+    new (entries() + size_) Entry(endpoint, resolver_names_ptr(this));
+    ++size_;
+  }
+
+  std::size_t size() const noexcept
+  {
+    return size_;
+  }
+
+  bool empty() const noexcept
+  {
+    return size_ == 0;
+  }
+
+  static std::size_t max_size() noexcept
+  {
+    return (std::numeric_limits<std::size_t>::max)() / sizeof(Entry);
+  }
+
+  const Entry& operator[](std::size_t i) const noexcept
+  {
+    return entries()[i];
+  }
+
+  void add_results_ref() noexcept
+  {
+    asio::detail::ref_count_up(results_count_);
+  }
+
+  void release_results() noexcept
+  {
+    if (asio::detail::ref_count_down(results_count_))
+    {
+      for (std::size_t i = 0; i < size_; ++i)
+        entries()[i].~Entry();
+      size_ = 0;
+      this->release();
+    }
+  }
+
+private:
+  resolver_entries() noexcept
+    : resolver_names(&resolver_entries::destroy),
+      size_(0)
+  {
+    results_count_ = 1;
+  }
+
+  static std::size_t entries_offset() noexcept
+  {
+    return (sizeof(resolver_entries) + alignof(Entry) - 1)
+      / alignof(Entry) * alignof(Entry);
+  }
+
+  Entry* entries() const noexcept
+  {
+    return reinterpret_cast<Entry*>(
+        reinterpret_cast<char*>(const_cast<resolver_entries*>(this))
+          + entries_offset());
+  }
+
+  // Called when the last reference to the names is released, after the
+  // entries have been destroyed.
+  static void destroy(resolver_names* names) noexcept
+  {
+    resolver_entries* block = static_cast<resolver_entries*>(names);
+    block->~resolver_entries();
+    ::operator delete(block);
+  }
+
+  asio::detail::atomic_count results_count_;
+  std::size_t size_;
+};
+
+// A counted reference to the entries of a set of resolver results.
+template <typename Entry>
+class resolver_entries_ptr
+{
+public:
+  resolver_entries_ptr() noexcept
+    : p_(0)
+  {
+  }
+
+  resolver_entries_ptr(const resolver_entries_ptr& other) noexcept
+    : p_(other.p_)
+  {
+    if (p_)
+      p_->add_results_ref();
+  }
+
+  resolver_entries_ptr(resolver_entries_ptr&& other) noexcept
+    : p_(other.p_)
+  {
+    other.p_ = 0;
+  }
+
+  ~resolver_entries_ptr()
+  {
+    if (p_)
+      p_->release_results();
+  }
+
+  resolver_entries_ptr& operator=(const resolver_entries_ptr& other) noexcept
+  {
+    resolver_entries_ptr tmp(other);
+    swap(tmp);
+    return *this;
+  }
+
+  resolver_entries_ptr& operator=(resolver_entries_ptr&& other) noexcept
+  {
+    resolver_entries_ptr tmp(static_cast<resolver_entries_ptr&&>(other));
+    swap(tmp);
+    return *this;
+  }
+
+  // Release the current block, and take ownership of a newly created one.
+  void reset(resolver_entries<Entry>* p = 0) noexcept
+  {
+    resolver_entries_ptr tmp;
+    tmp.p_ = p;
+    swap(tmp);
+  }
+
+  void swap(resolver_entries_ptr& other) noexcept
+  {
+    resolver_entries<Entry>* tmp = p_;
+    p_ = other.p_;
+    other.p_ = tmp;
+  }
+
+  resolver_entries<Entry>* operator->() const noexcept
+  {
+    return p_;
+  }
+
+  resolver_entries<Entry>& operator*() const noexcept
+  {
+    return *p_;
+  }
+
+  explicit operator bool() const noexcept
+  {
+    return p_ != 0;
+  }
+
+  bool operator!() const noexcept
+  {
+    return p_ == 0;
+  }
+
+  friend bool operator==(const resolver_entries_ptr& a,
+      const resolver_entries_ptr& b) noexcept
+  {
+    return a.p_ == b.p_;
+  }
+
+  friend bool operator!=(const resolver_entries_ptr& a,
+      const resolver_entries_ptr& b) noexcept
+  {
+    return a.p_ != b.p_;
+  }
+
+private:
+  resolver_entries<Entry>* p_;
+};
+
+} // namespace detail
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IP_DETAIL_RESOLVER_ENTRIES_HPP
@@ -0,0 +1,276 @@
+//
+// ip/endpoint_key.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_ENDPOINT_KEY_HPP
+#define ASIO_IP_ENDPOINT_KEY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstring>
+#include <functional>
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/socket_types.hpp"
+#include "asio/ip/address.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+
+template <typename InternetProtocol>
+class basic_endpoint;
+
+/// A compact, normalised key for an IP endpoint.
+/**
+ * The asio::ip::endpoint_key class holds the address, scope id, port and
+ * address family of an endpoint in a fixed-size, trivially copyable form. It
+ * is intended for use as the key of a hash table or ordered container, such as
+ * a table of peers on a datagram socket. Keys are cheaper to construct, copy,
+ * compare and hash than asio::ip::basic_endpoint, which stores a native
+ * socket address.
+ *
+ * Two keys are equal if and only if the endpoints from which they were made
+ * are equal. In particular, an IPv4 endpoint and an endpoint with the
+ * corresponding IPv4-mapped IPv6 address have different keys.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+class endpoint_key
+{
+public:
+  /// Default constructor. The key is that of a default-constructed endpoint.
+  endpoint_key() noexcept
+    : family_(4),
+      reserved_(0),
+      port_(0),
+      scope_id_(0)
+  {
+    std::memset(bytes_, 0, sizeof(bytes_));
+    bytes_[10] = bytes_[11] = 0xFF;
+  }
+
+  /// Construct a key from an address and port number.
+  endpoint_key(const asio::ip::address& addr,
+      unsigned short port_num) noexcept
+    : reserved_(0),
+      port_(port_num)
+  {
+    if (addr.is_v4())
+    {
+      address_v4::bytes_type v4_bytes = addr.to_v4().to_bytes();
+      set_v4(v4_bytes.data());
+    }
+    else
+    {
+      address_v6 v6_addr = addr.to_v6();
+      address_v6::bytes_type v6_bytes = v6_addr.to_bytes();
+      set_v6(v6_bytes.data(), v6_addr.scope_id());
+    }
+  }
+
+  /// Construct a key from an endpoint.
+  template <typename InternetProtocol>
+  explicit endpoint_key(
+      const basic_endpoint<InternetProtocol>& endpoint) noexcept
+    : reserved_(0)
+  {
+    if (endpoint.data()->sa_family == ASIO_OS_DEF(AF_INET))
+    {
+      asio::detail::sockaddr_in4_type v4;
+      std::memcpy(&v4, endpoint.data(), sizeof(v4));
+      set_v4(reinterpret_cast<const unsigned char*>(&v4.sin_addr));
+      set_port(reinterpret_cast<const unsigned char*>(&v4.sin_port));
+    }
+    else
+    {
+      asio::detail::sockaddr_in6_type v6;
+      std::memcpy(&v6, endpoint.data(), sizeof(v6));
+      set_v6(reinterpret_cast<const unsigned char*>(&v6.sin6_addr),
+          static_cast<scope_id_type>(v6.sin6_scope_id));
+      set_port(reinterpret_cast<const unsigned char*>(&v6.sin6_port));
+    }
+  }
+
+  /// Determine whether the key is for an IPv4 endpoint.
+  bool is_v4() const noexcept
+  {
+    return family_ == 4;
+  }
+
+  /// Determine whether the key is for an IPv6 endpoint.
+  bool is_v6() const noexcept
+  {
+    return family_ == 6;
+  }
+
+  /// Get the address of the endpoint.
+  asio::ip::address address() const noexcept
+  {
+    if (is_v4())
+    {
+      address_v4::bytes_type v4_bytes = {
+        { bytes_[12], bytes_[13], bytes_[14], bytes_[15] } };
+      return address_v4(v4_bytes);
+    }
+
+    address_v6::bytes_type v6_bytes;
+    std::memcpy(v6_bytes.data(), bytes_, sizeof(bytes_));
+    return address_v6(v6_bytes, scope_id_);
+  }
+
+  /// Get the port number of the endpoint, in the host's byte order.
+  unsigned short port() const noexcept
+  {
+    return port_;
+  }
+
+  /// Get the endpoint from which the key was made.
+  template <typename InternetProtocol>
+  basic_endpoint<InternetProtocol> to_endpoint() const noexcept
+  {
+    return basic_endpoint<InternetProtocol>(address(), port_);
+  }
+
+  /// Get a hash value for the key.
+  std::size_t hash() const noexcept
+  {
+    std::size_t seed = 0;
+    for (std::size_t i = 0; i < sizeof(bytes_); i += 4)
+      combine(seed, load_4_bytes(bytes_ + i));
+    combine(seed, scope_id_);
+    combine(seed, (static_cast<std::size_t>(family_) << 16) | port_);
+    return seed;
+  }
+
+  /// Compare two keys for equality.
+  friend bool operator==(const endpoint_key& k1,
+      const endpoint_key& k2) noexcept
+  {
+    return k1.port_ == k2.port_ && k1.family_ == k2.family_
+      && k1.scope_id_ == k2.scope_id_
+      && std::memcmp(k1.bytes_, k2.bytes_, sizeof(k1.bytes_)) == 0;
+  }
+
+  /// Compare two keys for inequality.
+  friend bool operator!=(const endpoint_key& k1,
+      const endpoint_key& k2) noexcept
+  {
+    return !(k1 == k2);
+  }
+
+  /// Compare keys for ordering.
+  /**
+   * IPv4 keys are ordered before IPv6 keys. Otherwise, keys are ordered by
+   * address, then by scope id and then by port number.
+   */
+  friend bool operator<(const endpoint_key& k1,
+      const endpoint_key& k2) noexcept
+  {
+    if (k1.family_ != k2.family_)
+      return k1.family_ < k2.family_;
+    int cmp = std::memcmp(k1.bytes_, k2.bytes_, sizeof(k1.bytes_));
+    if (cmp != 0)
+      return cmp < 0;
+    if (k1.scope_id_ != k2.scope_id_)
+      return k1.scope_id_ < k2.scope_id_;
+    return k1.port_ < k2.port_;
+  }
+
+  /// Compare keys for ordering.
+  friend bool operator>(const endpoint_key& k1,
+      const endpoint_key& k2) noexcept
+  {
+    return k2 < k1;
+  }
+
+  /// Compare keys for ordering.
+  friend bool operator<=(const endpoint_key& k1,
+      const endpoint_key& k2) noexcept
+  {
+    return !(k2 < k1);
+  }
+
+  /// Compare keys for ordering.
+  friend bool operator>=(const endpoint_key& k1,
+      const endpoint_key& k2) noexcept
+  {
+    return !(k1 < k2);
+  }
+
+private:
+  // IPv4 addresses are held in IPv4-mapped form.
+  void set_v4(const unsigned char* v4_bytes) noexcept
+  {
+    family_ = 4;
+    scope_id_ = 0;
+    std::memset(bytes_, 0, 10);
+    bytes_[10] = bytes_[11] = 0xFF;
+    std::memcpy(bytes_ + 12, v4_bytes, 4);
+  }
+
+  void set_v6(const unsigned char* v6_bytes,
+      scope_id_type scope_id) noexcept
+  {
+    family_ = 6;
+    scope_id_ = scope_id;
+    std::memcpy(bytes_, v6_bytes, 16);
+  }
+
+  // Set the port from a value in network byte order.
+  void set_port(const unsigned char* port_bytes) noexcept
+  {
+    port_ = static_cast<uint_least16_t>((port_bytes[0] << 8) | port_bytes[1]);
+  }
+
+  static std::size_t load_4_bytes(const unsigned char* bytes) noexcept
+  {
+    return (static_cast<std::size_t>(bytes[0]) << 24)
+      | (static_cast<std::size_t>(bytes[1]) << 16)
+      | (static_cast<std::size_t>(bytes[2]) << 8)
+      | static_cast<std::size_t>(bytes[3]);
+  }
+
+  static void combine(std::size_t& seed, std::size_t value) noexcept
+  {
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  }
+
+  unsigned char bytes_[16];
+  unsigned char family_;
+  unsigned char reserved_;
+  uint_least16_t port_;
+  scope_id_type scope_id_;
+};
+
+} // namespace ip
+} // namespace asio
+
+namespace std {
+
+template <>
+struct hash<asio::ip::endpoint_key>
+{
+  std::size_t operator()(const asio::ip::endpoint_key& key)
+    const noexcept
+  {
+    return key.hash();
+  }
+};
+
+} // namespace std
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IP_ENDPOINT_KEY_HPP
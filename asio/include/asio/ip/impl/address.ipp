@@ -139,17 +139,62 @@ address make_address(const std::string& str,
 
 address make_address(string_view str)
 {
-  return make_address(static_cast<std::string>(str));
+  asio::error_code ec;
+  address addr = make_address(str, ec);
+  asio::detail::throw_error(ec);
+  return addr;
 }
 
 address make_address(string_view str,
     asio::error_code& ec) noexcept
 {
-  return make_address(static_cast<std::string>(str), ec);
+  asio::ip::address_v6 ipv6_address =
+    asio::ip::make_address_v6(str, ec);
+  if (!ec)
+    return address(ipv6_address);
+
+  asio::ip::address_v4 ipv4_address =
+    asio::ip::make_address_v4(str, ec);
+  if (!ec)
+    return address(ipv4_address);
+
+  return address();
 }
 
 #endif // defined(ASIO_HAS_STRING_VIEW)
 
+char* to_chars(char* first, char* last,
+    const address& addr, asio::error_code& ec) noexcept
+{
+  if (addr.is_v6())
+    return to_chars(first, last, addr.to_v6(), ec);
+  return to_chars(first, last, addr.to_v4(), ec);
+}
+
+const char* from_chars(const char* first, const char* last,
+    address& addr, asio::error_code& ec) noexcept
+{
+  // An address in dotted decimal form begins with digits and then a '.'.
+  const char* p = first;
+  while (p != last && *p >= '0' && *p <= '9')
+    ++p;
+
+  if (p != first && p != last && *p == '.')
+  {
+    asio::ip::address_v4 ipv4_address;
+    const char* end = from_chars(first, last, ipv4_address, ec);
+    if (!ec)
+      addr = address(ipv4_address);
+    return end;
+  }
+
+  asio::ip::address_v6 ipv6_address;
+  const char* end = from_chars(first, last, ipv6_address, ec);
+  if (!ec)
+    addr = address(ipv6_address);
+  return end;
+}
+
 asio::ip::address_v4 address::to_v4() const
 {
   if (type_ != ipv4)
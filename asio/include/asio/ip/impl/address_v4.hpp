@@ -26,7 +26,10 @@ template <typename Elem, typename Traits>
 std::basic_ostream<Elem, Traits>& operator<<(
     std::basic_ostream<Elem, Traits>& os, const address_v4& addr)
 {
-  return os << addr.to_string().c_str();
+  char str[address_v4::max_string_length + 1];
+  asio::error_code ec;
+  *asio::ip::to_chars(str, str + address_v4::max_string_length, addr, ec) = 0;
+  return os << str;
 }
 
 } // namespace ip
@@ -17,6 +17,7 @@
 
 #include "asio/detail/config.hpp"
 #include <climits>
+#include <cstring>
 #include <limits>
 #include <stdexcept>
 #include "asio/error.hpp"
@@ -24,6 +25,7 @@
 #include "asio/detail/throw_error.hpp"
 #include "asio/detail/throw_exception.hpp"
 #include "asio/ip/address_v4.hpp"
+#include "asio/ip/detail/address_chars.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -72,15 +74,10 @@ address_v4::uint_type address_v4::to_uint() const noexcept
 
 std::string address_v4::to_string() const
 {
-  asio::error_code ec;
-  char addr_str[asio::detail::max_addr_v4_str_len];
-  const char* addr =
-    asio::detail::socket_ops::inet_ntop(
-        ASIO_OS_DEF(AF_INET), &addr_, addr_str,
-        asio::detail::max_addr_v4_str_len, 0, ec);
-  if (addr == 0)
-    asio::detail::throw_error(ec);
-  return addr;
+  char addr_str[max_string_length];
+  bytes_type bytes = to_bytes();
+  return std::string(addr_str,
+      ip::detail::format_address_v4(bytes.data(), addr_str));
 }
 
 bool address_v4::is_loopback() const noexcept
@@ -98,6 +95,23 @@ bool address_v4::is_multicast() const noexcept
   return (to_uint() & 0xF0000000) == 0xE0000000;
 }
 
+namespace detail {
+
+inline address_v4 make_address_v4(const char* first,
+    const char* last, asio::error_code& ec) noexcept
+{
+  address_v4::bytes_type bytes;
+  if (!ip::detail::parse_address_v4(first, last, bytes.data()))
+  {
+    ec = asio::error::invalid_argument;
+    return address_v4();
+  }
+  asio::error::clear(ec);
+  return address_v4(bytes);
+}
+
+} // namespace detail
+
 address_v4 make_address_v4(const char* str)
 {
   asio::error_code ec;
@@ -109,11 +123,7 @@ address_v4 make_address_v4(const char* str)
 address_v4 make_address_v4(const char* str,
     asio::error_code& ec) noexcept
 {
-  address_v4::bytes_type bytes;
-  if (asio::detail::socket_ops::inet_pton(
-        ASIO_OS_DEF(AF_INET), str, &bytes, 0, ec) <= 0)
-    return address_v4();
-  return address_v4(bytes);
+  return ip::detail::make_address_v4(str, str + std::strlen(str), ec);
 }
 
 address_v4 make_address_v4(const std::string& str)
@@ -124,24 +134,61 @@ address_v4 make_address_v4(const std::string& str)
 address_v4 make_address_v4(const std::string& str,
     asio::error_code& ec) noexcept
 {
-  return make_address_v4(str.c_str(), ec);
+  return ip::detail::make_address_v4(
+      str.data(), str.data() + str.size(), ec);
 }
 
 #if defined(ASIO_HAS_STRING_VIEW)
 
 address_v4 make_address_v4(string_view str)
 {
-  return make_address_v4(static_cast<std::string>(str));
+  asio::error_code ec;
+  address_v4 addr = make_address_v4(str, ec);
+  asio::detail::throw_error(ec);
+  return addr;
 }
 
 address_v4 make_address_v4(string_view str,
     asio::error_code& ec) noexcept
 {
-  return make_address_v4(static_cast<std::string>(str), ec);
+  return ip::detail::make_address_v4(
+      str.data(), str.data() + str.size(), ec);
 }
 
 #endif // defined(ASIO_HAS_STRING_VIEW)
 
+char* to_chars(char* first, char* last,
+    const address_v4& addr, asio::error_code& ec) noexcept
+{
+  char addr_str[address_v4::max_string_length];
+  address_v4::bytes_type bytes = addr.to_bytes();
+  std::size_t length = static_cast<std::size_t>(
+      ip::detail::format_address_v4(bytes.data(), addr_str) - addr_str);
+  if (static_cast<std::size_t>(last - first) < length)
+  {
+    ec = asio::error::no_buffer_space;
+    return first;
+  }
+  std::memcpy(first, addr_str, length);
+  asio::error::clear(ec);
+  return first + length;
+}
+
+const char* from_chars(const char* first, const char* last,
+    address_v4& addr, asio::error_code& ec) noexcept
+{
+  const char* end = ip::detail::scan_address_v4(first, last);
+  address_v4::bytes_type bytes;
+  if (!ip::detail::parse_address_v4(first, end, bytes.data()))
+  {
+    ec = asio::error::invalid_argument;
+    return first;
+  }
+  addr = address_v4(bytes);
+  asio::error::clear(ec);
+  return end;
+}
+
 } // namespace ip
 } // namespace asio
 
@@ -25,6 +25,7 @@
 #include "asio/error.hpp"
 #include "asio/ip/address_v6.hpp"
 #include "asio/ip/bad_address_cast.hpp"
+#include "asio/ip/detail/address_chars.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -92,15 +93,11 @@ address_v6::bytes_type address_v6::to_bytes() const noexcept
 
 std::string address_v6::to_string() const
 {
-  asio::error_code ec;
-  char addr_str[asio::detail::max_addr_v6_str_len];
-  const char* addr =
-    asio::detail::socket_ops::inet_ntop(
-        ASIO_OS_DEF(AF_INET6), &addr_, addr_str,
-        asio::detail::max_addr_v6_str_len, scope_id_, ec);
-  if (addr == 0)
-    asio::detail::throw_error(ec);
-  return addr;
+  char addr_str[max_string_length];
+  char* end = ip::detail::format_address_v6(addr_.s6_addr, addr_str);
+  if (scope_id_ != 0)
+    end = ip::detail::format_scope_id(addr_.s6_addr, scope_id_, end);
+  return std::string(addr_str, end);
 }
 
 bool address_v6::is_loopback() const noexcept
@@ -204,6 +201,33 @@ address_v6 address_v6::loopback() noexcept
   return tmp;
 }
 
+namespace detail {
+
+inline address_v6 make_address_v6(const char* first,
+    const char* last, asio::error_code& ec) noexcept
+{
+  // Everything following a '%' names the scope.
+  const char* percent = first;
+  while (percent != last && *percent != '%')
+    ++percent;
+
+  address_v6::bytes_type bytes;
+  if (!ip::detail::parse_address_v6(first, percent, bytes.data()))
+  {
+    ec = asio::error::invalid_argument;
+    return address_v6();
+  }
+
+  unsigned long scope_id = 0;
+  if (percent != last)
+    ip::detail::parse_scope_id(bytes.data(), percent + 1, last, scope_id);
+
+  asio::error::clear(ec);
+  return address_v6(bytes, static_cast<scope_id_type>(scope_id));
+}
+
+} // namespace detail
+
 address_v6 make_address_v6(const char* str)
 {
   asio::error_code ec;
@@ -215,12 +239,7 @@ address_v6 make_address_v6(const char* str)
 address_v6 make_address_v6(const char* str,
     asio::error_code& ec) noexcept
 {
-  address_v6::bytes_type bytes;
-  unsigned long scope_id = 0;
-  if (asio::detail::socket_ops::inet_pton(
-        ASIO_OS_DEF(AF_INET6), str, &bytes[0], &scope_id, ec) <= 0)
-    return address_v6();
-  return address_v6(bytes, static_cast<scope_id_type>(scope_id));
+  return ip::detail::make_address_v6(str, str + std::strlen(str), ec);
 }
 
 address_v6 make_address_v6(const std::string& str)
@@ -231,24 +250,77 @@ address_v6 make_address_v6(const std::string& str)
 address_v6 make_address_v6(const std::string& str,
     asio::error_code& ec) noexcept
 {
-  return make_address_v6(str.c_str(), ec);
+  return ip::detail::make_address_v6(
+      str.data(), str.data() + str.size(), ec);
 }
 
 #if defined(ASIO_HAS_STRING_VIEW)
 
 address_v6 make_address_v6(string_view str)
 {
-  return make_address_v6(static_cast<std::string>(str));
+  asio::error_code ec;
+  address_v6 addr = make_address_v6(str, ec);
+  asio::detail::throw_error(ec);
+  return addr;
 }
 
 address_v6 make_address_v6(string_view str,
     asio::error_code& ec) noexcept
 {
-  return make_address_v6(static_cast<std::string>(str), ec);
+  return ip::detail::make_address_v6(
+      str.data(), str.data() + str.size(), ec);
 }
 
 #endif // defined(ASIO_HAS_STRING_VIEW)
 
+char* to_chars(char* first, char* last,
+    const address_v6& addr, asio::error_code& ec) noexcept
+{
+  char addr_str[address_v6::max_string_length];
+  address_v6::bytes_type bytes = addr.to_bytes();
+  char* end = ip::detail::format_address_v6(bytes.data(), addr_str);
+  if (addr.scope_id() != 0)
+    end = ip::detail::format_scope_id(bytes.data(), addr.scope_id(), end);
+  std::size_t length = static_cast<std::size_t>(end - addr_str);
+  if (static_cast<std::size_t>(last - first) < length)
+  {
+    ec = asio::error::no_buffer_space;
+    return first;
+  }
+  std::memcpy(first, addr_str, length);
+  asio::error::clear(ec);
+  return first + length;
+}
+
+const char* from_chars(const char* first, const char* last,
+    address_v6& addr, asio::error_code& ec) noexcept
+{
+  const char* end = ip::detail::scan_address_v6(first, last);
+  address_v6::bytes_type bytes;
+  if (!ip::detail::parse_address_v6(first, end, bytes.data()))
+  {
+    ec = asio::error::invalid_argument;
+    return first;
+  }
+
+  unsigned long scope_id = 0;
+  if (end != last && *end == '%')
+  {
+    const char* scope_end = ip::detail::scan_scope_id(end + 1, last);
+    if (scope_end == end + 1)
+    {
+      ec = asio::error::invalid_argument;
+      return first;
+    }
+    ip::detail::parse_scope_id(bytes.data(), end + 1, scope_end, scope_id);
+    end = scope_end;
+  }
+
+  addr = address_v6(bytes, static_cast<scope_id_type>(scope_id));
+  asio::error::clear(ec);
+  return end;
+}
+
 address_v4 make_address_v4(
     v4_mapped_t, const address_v6& v6_addr)
 {
@@ -15,29 +15,53 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
-#if !defined(ASIO_NO_IOSTREAM)
-
-#include "asio/detail/throw_error.hpp"
-
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
 namespace ip {
 
+template <typename InternetProtocol>
+char* to_chars(char* first, char* last,
+    const basic_endpoint<InternetProtocol>& endpoint,
+    asio::error_code& ec) noexcept
+{
+  asio::ip::detail::endpoint tmp_ep(endpoint.address(), endpoint.port());
+  return tmp_ep.to_chars(first, last, ec);
+}
+
+template <typename InternetProtocol>
+const char* from_chars(const char* first, const char* last,
+    basic_endpoint<InternetProtocol>& endpoint,
+    asio::error_code& ec) noexcept
+{
+  asio::ip::detail::endpoint tmp_ep;
+  const char* end = tmp_ep.from_chars(first, last, ec);
+  if (!ec)
+    endpoint = basic_endpoint<InternetProtocol>(
+        tmp_ep.address(), tmp_ep.port());
+  return end;
+}
+
+#if !defined(ASIO_NO_IOSTREAM)
+
 template <typename Elem, typename Traits, typename InternetProtocol>
 std::basic_ostream<Elem, Traits>& operator<<(
     std::basic_ostream<Elem, Traits>& os,
     const basic_endpoint<InternetProtocol>& endpoint)
 {
-  asio::ip::detail::endpoint tmp_ep(endpoint.address(), endpoint.port());
-  return os << tmp_ep.to_string().c_str();
+  char str[basic_endpoint<InternetProtocol>::max_string_length + 1];
+  asio::error_code ec;
+  *asio::ip::to_chars(str,
+      str + basic_endpoint<InternetProtocol>::max_string_length,
+      endpoint, ec) = 0;
+  return os << str;
 }
 
+#endif // !defined(ASIO_NO_IOSTREAM)
+
 } // namespace ip
 } // namespace asio
 
 #include "asio/detail/pop_options.hpp"
 
-#endif // !defined(ASIO_NO_IOSTREAM)
-
 #endif // ASIO_IP_IMPL_BASIC_ENDPOINT_HPP
@@ -0,0 +1,37 @@
+//
+// ip/multicast_receiver.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_MULTICAST_RECEIVER_HPP
+#define ASIO_IP_MULTICAST_RECEIVER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_MULTICAST_RECEIVER) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include "asio/ip/basic_multicast_receiver.hpp"
+
+namespace asio {
+namespace ip {
+
+/// Typedef for the typical usage of a multicast receiver.
+typedef basic_multicast_receiver<> multicast_receiver;
+
+} // namespace ip
+} // namespace asio
+
+#endif // defined(ASIO_HAS_MULTICAST_RECEIVER)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_IP_MULTICAST_RECEIVER_HPP
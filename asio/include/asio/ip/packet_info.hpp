@@ -0,0 +1,164 @@
+//
+// ip/packet_info.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_PACKET_INFO_HPP
+#define ASIO_IP_PACKET_INFO_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/ip/address.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+
+/// Describes the addressing and traffic class of a single IP datagram.
+/**
+ * The asio::ip::packet_info class holds the per-datagram information carried
+ * in ancillary data by the batched datagram operations.
+ *
+ * On receive, the local address is the destination address of the datagram,
+ * and the interface index identifies the interface on which it arrived. These
+ * are filled in only when the ip::udp::receive_packet_info option is enabled.
+ * The traffic class is filled in only when the ip::udp::receive_traffic_class
+ * option is enabled.
+ *
+ * On send, a local address that is not unspecified selects the source address
+ * of the datagram, and a non-zero interface index selects the outgoing
+ * interface. The traffic class is applied only when it has been set.
+ *
+ * The traffic class is the IPv4 type of service byte or the IPv6 traffic class
+ * byte. It is made up of a six bit differentiated services code point (DSCP)
+ * and a two bit explicit congestion notification (ECN) codepoint.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+class packet_info
+{
+public:
+  /// Explicit congestion notification codepoints.
+  enum ecn_codepoint
+  {
+    /// Not ECN-capable transport.
+    not_ect = 0,
+
+    /// ECN-capable transport, ECT(1).
+    ect1 = 1,
+
+    /// ECN-capable transport, ECT(0).
+    ect0 = 2,
+
+    /// Congestion experienced.
+    ce = 3
+  };
+
+  /// Default constructor.
+  packet_info() noexcept
+    : interface_index_(0),
+      traffic_class_(0),
+      has_traffic_class_(false)
+  {
+  }
+
+  /// Get the local address.
+  const ip::address& local_address() const noexcept
+  {
+    return local_address_;
+  }
+
+  /// Set the local address.
+  void local_address(const ip::address& addr) noexcept
+  {
+    local_address_ = addr;
+  }
+
+  /// Get the interface index.
+  unsigned int interface_index() const noexcept
+  {
+    return interface_index_;
+  }
+
+  /// Set the interface index.
+  void interface_index(unsigned int index) noexcept
+  {
+    interface_index_ = index;
+  }
+
+  /// Determine whether the traffic class is present.
+  bool has_traffic_class() const noexcept
+  {
+    return has_traffic_class_;
+  }
+
+  /// Get the traffic class.
+  unsigned char traffic_class() const noexcept
+  {
+    return traffic_class_;
+  }
+
+  /// Set the traffic class.
+  void traffic_class(unsigned char value) noexcept
+  {
+    traffic_class_ = value;
+    has_traffic_class_ = true;
+  }
+
+  /// Remove the traffic class.
+  void clear_traffic_class() noexcept
+  {
+    traffic_class_ = 0;
+    has_traffic_class_ = false;
+  }
+
+  /// Get the differentiated services code point from the traffic class.
+  unsigned char dscp() const noexcept
+  {
+    return static_cast<unsigned char>(traffic_class_ >> 2);
+  }
+
+  /// Set the differentiated services code point in the traffic class.
+  void dscp(unsigned char value) noexcept
+  {
+    traffic_class(static_cast<unsigned char>(
+          ((value & 0x3F) << 2) | (traffic_class_ & 0x03)));
+  }
+
+  /// Get the ECN codepoint from the traffic class.
+  ecn_codepoint ecn() const noexcept
+  {
+    return static_cast<ecn_codepoint>(traffic_class_ & 0x03);
+  }
+
+  /// Set the ECN codepoint in the traffic class.
+  void ecn(ecn_codepoint value) noexcept
+  {
+    traffic_class(static_cast<unsigned char>(
+          (traffic_class_ & 0xFC) | (value & 0x03)));
+  }
+
+private:
+  ip::address local_address_;
+  unsigned int interface_index_;
+  unsigned char traffic_class_;
+  bool has_traffic_class_;
+};
+
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IP_PACKET_INFO_HPP
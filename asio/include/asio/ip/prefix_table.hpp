@@ -0,0 +1,285 @@
+//
+// ip/prefix_table.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_PREFIX_TABLE_HPP
+#define ASIO_IP_PREFIX_TABLE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/ip/address.hpp"
+#include "asio/ip/network_v4.hpp"
+#include "asio/ip/network_v6.hpp"
+#include "asio/ip/detail/prefix_trie.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+
+/// A table that maps IP networks to values, and finds the longest matching
+/// network for an address.
+/**
+ * The asio::ip::prefix_table class template holds a set of IPv4 and IPv6
+ * networks, each with an associated value, such as the rules of an access
+ * control list or a routing table. Given an address, the lookup() function
+ * returns the value of the most specific network that contains it.
+ *
+ * The networks are held in a path-compressed binary trie for each address
+ * family. A lookup visits at most one node per bit of the address, and in
+ * practice far fewer, regardless of the number of networks in the table.
+ *
+ * Networks are keyed by their canonical form, so that, for example,
+ * <tt>10.1.2.3/8</tt> and <tt>10.0.0.0/8</tt> are the same network. IPv4
+ * networks match only IPv4 addresses, and IPv6 networks match only IPv6
+ * addresses. In particular, an IPv4-mapped IPv6 address is matched only
+ * against the IPv6 networks.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe. However, any number of threads may call the
+ * const member functions concurrently.
+ */
+template <typename T>
+class prefix_table
+{
+public:
+  /// The type of the values held in the table.
+  typedef T mapped_type;
+
+  /// Construct an empty table.
+  prefix_table() noexcept
+  {
+  }
+
+  /// Copy constructor.
+  prefix_table(const prefix_table& other)
+  {
+    v4_.assign(other.v4_);
+    v6_.assign(other.v6_);
+  }
+
+  /// Move constructor.
+  prefix_table(prefix_table&& other) noexcept
+    : v4_(static_cast<detail::prefix_trie<T>&&>(other.v4_)),
+      v6_(static_cast<detail::prefix_trie<T>&&>(other.v6_))
+  {
+  }
+
+  /// Copy assignment.
+  prefix_table& operator=(const prefix_table& other)
+  {
+    if (this != &other)
+    {
+      prefix_table tmp(other);
+      *this = static_cast<prefix_table&&>(tmp);
+    }
+    return *this;
+  }
+
+  /// Move assignment.
+  prefix_table& operator=(prefix_table&& other) noexcept
+  {
+    v4_ = static_cast<detail::prefix_trie<T>&&>(other.v4_);
+    v6_ = static_cast<detail::prefix_trie<T>&&>(other.v6_);
+    return *this;
+  }
+
+  /// Get the number of networks in the table.
+  std::size_t size() const noexcept
+  {
+    return v4_.size() + v6_.size();
+  }
+
+  /// Determine whether the table is empty.
+  bool empty() const noexcept
+  {
+    return size() == 0;
+  }
+
+  /// Remove all networks from the table.
+  void clear() noexcept
+  {
+    v4_.clear();
+    v6_.clear();
+  }
+
+  /// Add an IPv4 network to the table.
+  /**
+   * @returns @c true if the network was added, or @c false if the table
+   * already contained the network, in which case its value is unchanged.
+   */
+  bool insert(const network_v4& net, const T& value)
+  {
+    bool inserted = false;
+    v4_.insert(key(net.network()), net.prefix_length(), value, inserted);
+    return inserted;
+  }
+
+  /// Add an IPv4 network to the table.
+  /**
+   * @returns @c true if the network was added, or @c false if the table
+   * already contained the network, in which case its value is unchanged.
+   */
+  bool insert(const network_v4& net, T&& value)
+  {
+    bool inserted = false;
+    v4_.insert(key(net.network()), net.prefix_length(),
+        static_cast<T&&>(value), inserted);
+    return inserted;
+  }
+
+  /// Add an IPv6 network to the table.
+  /**
+   * @returns @c true if the network was added, or @c false if the table
+   * already contained the network, in which case its value is unchanged.
+   */
+  bool insert(const network_v6& net, const T& value)
+  {
+    bool inserted = false;
+    v6_.insert(key(net.network()), net.prefix_length(), value, inserted);
+    return inserted;
+  }
+
+  /// Add an IPv6 network to the table.
+  /**
+   * @returns @c true if the network was added, or @c false if the table
+   * already contained the network, in which case its value is unchanged.
+   */
+  bool insert(const network_v6& net, T&& value)
+  {
+    bool inserted = false;
+    v6_.insert(key(net.network()), net.prefix_length(),
+        static_cast<T&&>(value), inserted);
+    return inserted;
+  }
+
+  /// Remove an IPv4 network from the table.
+  /**
+   * @returns @c true if the network was removed, or @c false if the table did
+   * not contain it.
+   */
+  bool erase(const network_v4& net)
+  {
+    return v4_.erase(key(net.network()), net.prefix_length());
+  }
+
+  /// Remove an IPv6 network from the table.
+  /**
+   * @returns @c true if the network was removed, or @c false if the table did
+   * not contain it.
+   */
+  bool erase(const network_v6& net)
+  {
+    return v6_.erase(key(net.network()), net.prefix_length());
+  }
+
+  /// Get the value for an IPv4 network.
+  /**
+   * @returns A pointer to the value, or a null pointer if the table does not
+   * contain the network. Less specific networks are not considered.
+   */
+  T* find(const network_v4& net) noexcept
+  {
+    return v4_.find(key(net.network()), net.prefix_length());
+  }
+
+  /// Get the value for an IPv4 network.
+  /**
+   * @returns A pointer to the value, or a null pointer if the table does not
+   * contain the network. Less specific networks are not considered.
+   */
+  const T* find(const network_v4& net) const noexcept
+  {
+    return v4_.find(key(net.network()), net.prefix_length());
+  }
+
+  /// Get the value for an IPv6 network.
+  /**
+   * @returns A pointer to the value, or a null pointer if the table does not
+   * contain the network. Less specific networks are not considered.
+   */
+  T* find(const network_v6& net) noexcept
+  {
+    return v6_.find(key(net.network()), net.prefix_length());
+  }
+
+  /// Get the value for an IPv6 network.
+  /**
+   * @returns A pointer to the value, or a null pointer if the table does not
+   * contain the network. Less specific networks are not considered.
+   */
+  const T* find(const network_v6& net) const noexcept
+  {
+    return v6_.find(key(net.network()), net.prefix_length());
+  }
+
+  /// Find the value of the longest network that contains an IPv4 address.
+  /**
+   * @returns A pointer to the value, or a null pointer if no network in the
+   * table contains the address.
+   */
+  const T* lookup(const address_v4& addr) const noexcept
+  {
+    return v4_.lookup(key(addr), 32);
+  }
+
+  /// Find the value of the longest network that contains an IPv6 address.
+  /**
+   * @returns A pointer to the value, or a null pointer if no network in the
+   * table contains the address.
+   */
+  const T* lookup(const address_v6& addr) const noexcept
+  {
+    return v6_.lookup(key(addr), 128);
+  }
+
+  /// Find the value of the longest network that contains an address.
+  /**
+   * @returns A pointer to the value, or a null pointer if no network in the
+   * table contains the address.
+   */
+  const T* lookup(const address& addr) const noexcept
+  {
+    return addr.is_v4() ? lookup(addr.to_v4()) : lookup(addr.to_v6());
+  }
+
+private:
+  static detail::prefix_key key(const address_v4& addr) noexcept
+  {
+    detail::prefix_key k = { uint64_t(addr.to_uint()) << 32, 0 };
+    return k;
+  }
+
+  static detail::prefix_key key(const address_v6& addr) noexcept
+  {
+    address_v6::bytes_type bytes = addr.to_bytes();
+    detail::prefix_key k = { 0, 0 };
+    for (int i = 0; i < 8; ++i)
+    {
+      k.hi = (k.hi << 8) | bytes[i];
+      k.lo = (k.lo << 8) | bytes[i + 8];
+    }
+    return k;
+  }
+
+  detail::prefix_trie<T> v4_;
+  detail::prefix_trie<T> v6_;
+};
+
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IP_PREFIX_TABLE_HPP
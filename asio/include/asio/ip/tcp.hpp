@@ -19,6 +19,7 @@
 #include "asio/basic_socket_acceptor.hpp"
 #include "asio/basic_socket_iostream.hpp"
 #include "asio/basic_stream_socket.hpp"
+#include "asio/detail/io_control.hpp"
 #include "asio/detail/socket_option.hpp"
 #include "asio/detail/socket_types.hpp"
 #include "asio/ip/basic_endpoint.hpp"
@@ -31,6 +32,15 @@
 namespace asio {
 namespace ip {
 
+#if !defined(ASIO_IP_BASIC_CONNECTION_POOL_FWD_DECL)
+#define ASIO_IP_BASIC_CONNECTION_POOL_FWD_DECL
+
+// Forward declaration.
+template <typename Stream>
+class basic_connection_pool;
+
+#endif // !defined(ASIO_IP_BASIC_CONNECTION_POOL_FWD_DECL)
+
 /// Encapsulates the flags needed for TCP.
 /**
  * The asio::ip::tcp class contains flags necessary for TCP sockets.
@@ -87,6 +97,12 @@ public:
   /// The TCP resolver type.
   typedef basic_resolver<tcp> resolver;
 
+  /// The TCP connection pool type.
+  /**
+   * The pool is defined in @c asio/ip/basic_connection_pool.hpp.
+   */
+  typedef basic_connection_pool<socket> connection_pool;
+
 #if !defined(ASIO_NO_IOSTREAM)
   /// The TCP iostream type.
   typedef basic_socket_iostream<tcp> iostream;
@@ -125,6 +141,165 @@ public:
     ASIO_OS_DEF(IPPROTO_TCP), ASIO_OS_DEF(TCP_NODELAY)> no_delay;
 #endif
 
+#if defined(ASIO_HAS_TCP_FASTOPEN) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Socket option for the length of the TCP Fast Open queue.
+  /**
+   * Implements the IPPROTO_TCP/TCP_FASTOPEN socket option. When set on an
+   * acceptor to a non-zero value, the acceptor accepts data carried in the
+   * SYN of a connection from a client that presents a valid Fast Open cookie.
+   * The value is the maximum number of such connections that may be pending
+   * the completion of their handshake. The option must be set before the
+   * acceptor starts listening. Linux only.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::acceptor acceptor(my_context);
+   * acceptor.open(asio::ip::tcp::v4());
+   * acceptor.bind(endpoint);
+   * asio::ip::tcp::fast_open option(256);
+   * acceptor.set_option(option);
+   * acceptor.listen();
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * asio::ip::tcp::fast_open option;
+   * acceptor.get_option(option);
+   * int queue_length = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined fast_open;
+#else
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(IPPROTO_TCP), ASIO_OS_DEF(TCP_FASTOPEN)> fast_open;
+#endif
+#endif // defined(ASIO_HAS_TCP_FASTOPEN)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#if defined(ASIO_HAS_TCP_DEFER_ACCEPT) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Socket option to defer accepting a connection until data arrives.
+  /**
+   * Implements the IPPROTO_TCP/TCP_DEFER_ACCEPT socket option. When set on an
+   * acceptor, a connection is not returned by accept until the client has
+   * sent data on it, or until the given number of seconds has elapsed. This
+   * avoids waking the server for connections on which it would only wait for
+   * a request. Linux only.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * asio::ip::tcp::defer_accept option(5);
+   * acceptor.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * asio::ip::tcp::defer_accept option;
+   * acceptor.get_option(option);
+   * int seconds = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined defer_accept;
+#else
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(IPPROTO_TCP), ASIO_OS_DEF(TCP_DEFER_ACCEPT)> defer_accept;
+#endif
+#endif // defined(ASIO_HAS_TCP_DEFER_ACCEPT)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#if defined(ASIO_HAS_TCP_NOTSENT_LOWAT) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Socket option to limit the data that is queued but not yet sent.
+  /**
+   * Implements the IPPROTO_TCP/TCP_NOTSENT_LOWAT socket option. When set on a
+   * socket, the socket is reported as ready for writing only while the number
+   * of bytes written to it but not yet sent is below the given value, and a
+   * non-blocking write fails with asio::error::would_block once it is reached.
+   * This applies equally to the reactor and io_uring backends, so that an
+   * asynchronous wait using asio::socket_base::wait_write, and the background
+   * write of a write_queue, are resumed only when the backlog has drained
+   * below the mark. Linux only.
+   *
+   * Keeping the mark small, such as the amount of data sent in one round
+   * trip, means that data waits in the application rather than in the kernel,
+   * where it may still be reprioritised or discarded.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::ip::tcp::not_sent_low_watermark option(16384);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::ip::tcp::not_sent_low_watermark option;
+   * socket.get_option(option);
+   * int bytes = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined not_sent_low_watermark;
+#else
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(IPPROTO_TCP), ASIO_OS_DEF(TCP_NOTSENT_LOWAT)>
+      not_sent_low_watermark;
+#endif
+
+  /// IO control command to get the number of bytes not yet sent.
+  /**
+   * Implements the SIOCOUTQNSD IO control command, which obtains the number of
+   * bytes that have been written to a connected socket but not yet sent to
+   * the peer. Unlike the data held in the send buffer, this does not include
+   * data that has been sent but not acknowledged. Linux only.
+   *
+   * @par Example
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::ip::tcp::bytes_unsent command;
+   * socket.io_control(command);
+   * std::size_t bytes_unsent = command.get();
+   * @endcode
+   *
+   * @par Concepts:
+   * IO_Control_Command, Size_IO_Control_Command.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined bytes_unsent;
+#else
+  typedef asio::detail::io_control::bytes_unsent bytes_unsent;
+#endif
+#endif // defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Compare two protocols for equality.
   friend bool operator==(const tcp& p1, const tcp& p2)
   {
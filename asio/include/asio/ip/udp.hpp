@@ -17,11 +17,14 @@
 
 #include "asio/detail/config.hpp"
 #include "asio/basic_datagram_socket.hpp"
+#include "asio/detail/socket_option.hpp"
 #include "asio/detail/socket_types.hpp"
 #include "asio/ip/basic_endpoint.hpp"
 #include "asio/ip/basic_resolver.hpp"
 #include "asio/ip/basic_resolver_iterator.hpp"
 #include "asio/ip/basic_resolver_query.hpp"
+#include "asio/ip/packet_info.hpp"
+#include "asio/ip/detail/socket_option.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -78,6 +81,164 @@ public:
   /// The UDP socket type.
   typedef basic_datagram_socket<udp> socket;
 
+#if defined(ASIO_HAS_UDP_OFFLOAD) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Socket option to set the default UDP segment size for sends.
+  /**
+   * Implements the IPPROTO_UDP/UDP_SEGMENT socket option. When non-zero, each
+   * send on the socket is split by the kernel into datagrams of the specified
+   * size. See also basic_datagram_socket::async_send_segments(), which
+   * specifies the segment size for a single send.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::ip::udp::segment_size option(1200);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::ip::udp::segment_size option;
+   * socket.get_option(option);
+   * int size = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined segment_size;
+#else
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(IPPROTO_UDP), ASIO_OS_DEF(UDP_SEGMENT)> segment_size;
+#endif
+
+  /// Socket option to enable UDP generic receive offload.
+  /**
+   * Implements the IPPROTO_UDP/UDP_GRO socket option. When enabled, the kernel
+   * may coalesce consecutive datagrams from the same sender, which are then
+   * received using basic_datagram_socket::async_receive_coalesced().
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::ip::udp::receive_offload option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::ip::udp::receive_offload option;
+   * socket.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined receive_offload;
+#else
+  typedef asio::detail::socket_option::boolean<
+    ASIO_OS_DEF(IPPROTO_UDP), ASIO_OS_DEF(UDP_GRO)> receive_offload;
+#endif
+#endif // defined(ASIO_HAS_UDP_OFFLOAD)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+  /// The per-datagram packet information type.
+  typedef asio::ip::packet_info packet_info;
+
+#if defined(ASIO_HAS_PACKET_INFO) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Socket option to receive the destination address of each datagram.
+  /**
+   * Implements the IPPROTO_IP/IP_PKTINFO or IPPROTO_IPV6/IPV6_RECVPKTINFO
+   * socket option. When enabled, the local address and interface of each
+   * datagram are reported in the packet information passed to
+   * basic_datagram_socket::async_receive_batch().
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::ip::udp::receive_packet_info option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::ip::udp::receive_packet_info option;
+   * socket.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined receive_packet_info;
+#else
+  typedef asio::ip::detail::socket_option::multicast_enable_loopback<
+    ASIO_OS_DEF(IPPROTO_IP), ASIO_OS_DEF(IP_PKTINFO),
+    ASIO_OS_DEF(IPPROTO_IPV6), ASIO_OS_DEF(IPV6_RECVPKTINFO)>
+      receive_packet_info;
+#endif
+
+  /// Socket option to receive the traffic class of each datagram.
+  /**
+   * Implements the IPPROTO_IP/IP_RECVTOS or IPPROTO_IPV6/IPV6_RECVTCLASS
+   * socket option. When enabled, the traffic class of each datagram, including
+   * its ECN codepoint, is reported in the packet information passed to
+   * basic_datagram_socket::async_receive_batch().
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::ip::udp::receive_traffic_class option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::ip::udp::receive_traffic_class option;
+   * socket.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined receive_traffic_class;
+#else
+  typedef asio::ip::detail::socket_option::multicast_enable_loopback<
+    ASIO_OS_DEF(IPPROTO_IP), ASIO_OS_DEF(IP_RECVTOS),
+    ASIO_OS_DEF(IPPROTO_IPV6), ASIO_OS_DEF(IPV6_RECVTCLASS)>
+      receive_traffic_class;
+#endif
+#endif // defined(ASIO_HAS_PACKET_INFO)
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// The UDP resolver type.
   typedef basic_resolver<udp> resolver;
 
@@ -0,0 +1,212 @@
+//
+// latency_histogram.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_LATENCY_HISTOGRAM_HPP
+#define ASIO_LATENCY_HISTOGRAM_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/cstdint.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A histogram of latencies, with buckets of bounded relative width.
+/**
+ * The latency_histogram class counts durations using buckets whose width is
+ * proportional to their magnitude, in the manner of an HDR histogram. Values
+ * below 16 nanoseconds each have their own bucket. Above that, each power of
+ * two is split into 16 buckets, so that the value reported for a bucket is
+ * within 6.25% of any value counted in it. Values of 2^45 nanoseconds (about
+ * 9.8 hours) or more are counted in the last bucket.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+class latency_histogram
+{
+public:
+  /// The number of buckets into which each power of two is divided.
+  static constexpr std::size_t sub_buckets = 16;
+
+  /// The total number of buckets.
+  static constexpr std::size_t num_buckets = 672;
+
+  /// Construct an empty histogram.
+  latency_histogram() noexcept
+    : counts_()
+  {
+  }
+
+  /// Get the index of the bucket in which a value is counted.
+  static std::size_t bucket_index(chrono::nanoseconds value) noexcept
+  {
+    if (value.count() < static_cast<chrono::nanoseconds::rep>(sub_buckets))
+      return value.count() > 0 ? static_cast<std::size_t>(value.count()) : 0;
+
+    uint64_t v = static_cast<uint64_t>(value.count());
+    std::size_t exponent = 0;
+    for (std::size_t shift = 32; shift > 0; shift /= 2)
+    {
+      if ((v >> exponent) >> shift)
+        exponent += shift;
+    }
+
+    std::size_t index = (exponent - 3) * sub_buckets
+      + static_cast<std::size_t>((v >> (exponent - 4)) - sub_buckets);
+    return index < num_buckets ? index : num_buckets - 1;
+  }
+
+  /// Get the smallest value that is counted in a bucket.
+  static chrono::nanoseconds bucket_lower_bound(std::size_t bucket) noexcept
+  {
+    if (bucket < sub_buckets)
+      return chrono::nanoseconds(static_cast<chrono::nanoseconds::rep>(bucket));
+
+    std::size_t exponent = bucket / sub_buckets + 3;
+    uint64_t mantissa = bucket % sub_buckets + sub_buckets;
+    return chrono::nanoseconds(
+        static_cast<chrono::nanoseconds::rep>(mantissa << (exponent - 4)));
+  }
+
+  /// Get the largest value that is counted in a bucket.
+  /**
+   * The last bucket also counts all larger values.
+   */
+  static chrono::nanoseconds bucket_upper_bound(std::size_t bucket) noexcept
+  {
+    if (bucket < sub_buckets)
+      return chrono::nanoseconds(static_cast<chrono::nanoseconds::rep>(bucket));
+
+    std::size_t exponent = bucket / sub_buckets + 3;
+    return bucket_lower_bound(bucket) + chrono::nanoseconds(
+        (static_cast<chrono::nanoseconds::rep>(1) << (exponent - 4)) - 1);
+  }
+
+  /// Count a value.
+  void record(chrono::nanoseconds value, uint64_t count = 1) noexcept
+  {
+    counts_[bucket_index(value)] += count;
+  }
+
+  /// Add the counts of another histogram to this one.
+  latency_histogram& operator+=(const latency_histogram& other) noexcept
+  {
+    for (std::size_t i = 0; i < num_buckets; ++i)
+      counts_[i] += other.counts_[i];
+    return *this;
+  }
+
+  /// Get the number of values counted in a bucket.
+  uint64_t bucket_count(std::size_t bucket) const noexcept
+  {
+    return counts_[bucket];
+  }
+
+  /// Get the total number of values counted.
+  uint64_t total_count() const noexcept
+  {
+    uint64_t total = 0;
+    for (std::size_t i = 0; i < num_buckets; ++i)
+      total += counts_[i];
+    return total;
+  }
+
+  /// Get the smallest value in the bucket of the smallest counted value.
+  /**
+   * @returns Zero if no values have been counted.
+   */
+  chrono::nanoseconds min_value() const noexcept
+  {
+    for (std::size_t i = 0; i < num_buckets; ++i)
+      if (counts_[i])
+        return bucket_lower_bound(i);
+    return chrono::nanoseconds(0);
+  }
+
+  /// Get the largest value in the bucket of the largest counted value.
+  /**
+   * @returns Zero if no values have been counted.
+   */
+  chrono::nanoseconds max_value() const noexcept
+  {
+    for (std::size_t i = num_buckets; i > 0; --i)
+      if (counts_[i - 1])
+        return bucket_upper_bound(i - 1);
+    return chrono::nanoseconds(0);
+  }
+
+  /// Get the mean of the counted values, using the midpoint of each bucket.
+  /**
+   * @returns Zero if no values have been counted.
+   */
+  chrono::nanoseconds mean() const noexcept
+  {
+    double total = 0;
+    double sum = 0;
+    for (std::size_t i = 0; i < num_buckets; ++i)
+    {
+      if (counts_[i])
+      {
+        double midpoint = (bucket_lower_bound(i).count()
+            + bucket_upper_bound(i).count()) / 2.0;
+        total += static_cast<double>(counts_[i]);
+        sum += midpoint * static_cast<double>(counts_[i]);
+      }
+    }
+    return chrono::nanoseconds(total > 0
+        ? static_cast<chrono::nanoseconds::rep>(sum / total) : 0);
+  }
+
+  /// Get the value below which a given percentage of the counted values lie.
+  /**
+   * @param percentile The percentage, from 0 to 100.
+   *
+   * @returns The largest value in the bucket containing the requested
+   * percentile, or zero if no values have been counted.
+   */
+  chrono::nanoseconds value_at_percentile(double percentile) const noexcept
+  {
+    uint64_t total = total_count();
+    if (total == 0)
+      return chrono::nanoseconds(0);
+
+    double fraction = percentile < 0 ? 0 : percentile > 100 ? 1
+      : percentile / 100;
+    uint64_t target = static_cast<uint64_t>(fraction * total + 0.5);
+    if (target == 0)
+      target = 1;
+
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < num_buckets; ++i)
+    {
+      seen += counts_[i];
+      if (seen >= target)
+        return bucket_upper_bound(i);
+    }
+    return bucket_upper_bound(num_buckets - 1);
+  }
+
+private:
+  uint64_t counts_[num_buckets];
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_LATENCY_HISTOGRAM_HPP
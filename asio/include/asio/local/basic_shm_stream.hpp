@@ -0,0 +1,951 @@
+//
+// local/basic_shm_stream.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_LOCAL_BASIC_SHM_STREAM_HPP
+#define ASIO_LOCAL_BASIC_SHM_STREAM_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SHM_STREAM) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cerrno>
+#include <cstddef>
+#include <new>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/memfd.h>
+#include "asio/any_io_executor.hpp"
+#include "asio/buffer.hpp"
+#include "asio/compose.hpp"
+#include "asio/error.hpp"
+#include "asio/local/detail/shm_ring.hpp"
+#include "asio/local/passed_fds.hpp"
+#include "asio/posix/basic_stream_descriptor.hpp"
+#include "asio/post.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace local {
+
+/// Provides a stream between processes on the same host using shared memory.
+/**
+ * The basic_shm_stream class template provides a bidirectional byte stream
+ * between two co-located processes, or between two parts of one process. Each
+ * direction is a single-producer, single-consumer ring in memory that is
+ * mapped by both ends, so that data is copied once into the ring by the
+ * sender and once out of it by the receiver, with no system call per message
+ * while the peer is keeping up.
+ *
+ * An end that finds the ring it reads from empty, or the ring it writes to
+ * full, sleeps on an @c eventfd that is registered with the reactor. Each end
+ * has separate descriptors for these two waits, so that a read and a write may
+ * sleep at the same time. The peer writes to a descriptor only when it sees
+ * that the corresponding wait is in progress.
+ *
+ * One end creates the stream using create(). The descriptors returned by
+ * handles() are then passed to the peer, for example using
+ * basic_stream_socket::async_send_fds(), and the peer uses attach() to open
+ * the other end. Within a single process, connect_pair() performs both steps.
+ *
+ * The class meets the requirements of the AsyncReadStream, AsyncWriteStream,
+ * SyncReadStream and SyncWriteStream type requirements, and so may be used
+ * with asio::async_read(), asio::async_write() and ssl::stream.
+ *
+ * @note The stream does not detect the termination of a peer process that
+ * exits without closing its end. Applications that require this should keep
+ * a local socket open alongside the stream.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Concepts:
+ * AsyncReadStream, AsyncWriteStream, Stream, SyncReadStream, SyncWriteStream.
+ */
+template <typename Executor = any_io_executor>
+class basic_shm_stream
+{
+private:
+  template <typename> class read_op;
+  template <typename> class write_op;
+
+public:
+  /// The type of the executor associated with the object.
+  typedef Executor executor_type;
+
+  /// Rebinds the stream type to another executor.
+  template <typename Executor1>
+  struct rebind_executor
+  {
+    /// The stream type when rebound to the specified executor.
+    typedef basic_shm_stream<Executor1> other;
+  };
+
+  /// A basic_shm_stream is always the lowest layer.
+  typedef basic_shm_stream lowest_layer_type;
+
+  /// Construct a stream without opening it.
+  explicit basic_shm_stream(const executor_type& ex)
+    : read_event_(ex),
+      write_event_(ex),
+      memory_fd_(-1),
+      peer_read_event_fd_(-1),
+      peer_write_event_fd_(-1),
+      side_(0),
+      memory_(0),
+      memory_size_(0),
+      capacity_(0)
+  {
+  }
+
+  /// Construct a stream without opening it.
+  template <typename ExecutionContext>
+  explicit basic_shm_stream(ExecutionContext& context,
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      > = 0)
+    : read_event_(context),
+      write_event_(context),
+      memory_fd_(-1),
+      peer_read_event_fd_(-1),
+      peer_write_event_fd_(-1),
+      side_(0),
+      memory_(0),
+      memory_size_(0),
+      capacity_(0)
+  {
+  }
+
+  /// Destructor. Closes the stream.
+  ~basic_shm_stream()
+  {
+    asio::error_code ec;
+    close(ec);
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() noexcept
+  {
+    return read_event_.get_executor();
+  }
+
+  /// Get a reference to the lowest layer.
+  lowest_layer_type& lowest_layer() noexcept
+  {
+    return *this;
+  }
+
+  /// Get a const reference to the lowest layer.
+  const lowest_layer_type& lowest_layer() const noexcept
+  {
+    return *this;
+  }
+
+  /// Create a new stream and open this end of it.
+  /**
+   * @param capacity The number of bytes that may be buffered in each
+   * direction. Rounded up to a multiple of the page size.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void create(std::size_t capacity = 65536)
+  {
+    asio::error_code ec;
+    create(capacity, ec);
+    asio::detail::throw_error(ec, "create");
+  }
+
+  /// Create a new stream and open this end of it.
+  /**
+   * @param capacity The number of bytes that may be buffered in each
+   * direction. Rounded up to a multiple of the page size.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID create(std::size_t capacity, asio::error_code& ec)
+  {
+    if (is_open())
+    {
+      ec = asio::error::already_open;
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    capacity = capacity == 0 ? page_size
+      : (capacity + page_size - 1) / page_size * page_size;
+    std::size_t size = page_size + 2 * capacity;
+
+    int fds[5] = { -1, -1, -1, -1, -1 };
+    fds[0] = static_cast<int>(::syscall(__NR_memfd_create,
+          "asio_shm_stream", MFD_CLOEXEC));
+    if (fds[0] != -1 && ::ftruncate(fds[0], static_cast<off_t>(size)) == 0)
+    {
+      for (int i = 1; i < 5; ++i)
+        if ((fds[i] = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) == -1)
+          break;
+    }
+
+    if (fds[4] == -1)
+    {
+      ec = asio::error_code(errno, asio::error::get_system_category());
+      close_fds(fds);
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    void* memory = ::mmap(0, size, PROT_READ | PROT_WRITE,
+        MAP_SHARED, fds[0], 0);
+    if (memory == MAP_FAILED)
+    {
+      ec = asio::error_code(errno, asio::error::get_system_category());
+      close_fds(fds);
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    detail::shm_ring_header* header =
+      new (memory) detail::shm_ring_header();
+    header->magic = detail::shm_ring_header::magic_value;
+    header->capacity = capacity;
+
+    open_side(0, fds, memory, size, capacity, ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Open the peer's end of a stream created by another basic_shm_stream.
+  /**
+   * @param handles The descriptors obtained from handles() on the end that
+   * created the stream. Ownership of the descriptors is transferred to this
+   * object, even if the function fails.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void attach(const passed_fds& handles)
+  {
+    asio::error_code ec;
+    attach(handles, ec);
+    asio::detail::throw_error(ec, "attach");
+  }
+
+  /// Open the peer's end of a stream created by another basic_shm_stream.
+  /**
+   * @param handles The descriptors obtained from handles() on the end that
+   * created the stream. Ownership of the descriptors is transferred to this
+   * object, even if the function fails.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID attach(const passed_fds& handles,
+      asio::error_code& ec)
+  {
+    int fds[5] = { -1, -1, -1, -1, -1 };
+    for (std::size_t i = 0; i < handles.count; ++i)
+    {
+      if (i < 5)
+        fds[i] = handles.fds[i];
+      else
+        ::close(handles.fds[i]);
+    }
+
+    if (is_open())
+    {
+      ec = asio::error::already_open;
+      close_fds(fds);
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    if (handles.count != 5)
+    {
+      ec = asio::error::invalid_argument;
+      close_fds(fds);
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    struct stat st;
+    if (::fstat(fds[0], &st) != 0)
+    {
+      ec = asio::error_code(errno, asio::error::get_system_category());
+      close_fds(fds);
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    std::size_t size = static_cast<std::size_t>(st.st_size);
+    if (size < page_size)
+    {
+      ec = asio::error::invalid_argument;
+      close_fds(fds);
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    void* memory = ::mmap(0, size, PROT_READ | PROT_WRITE,
+        MAP_SHARED, fds[0], 0);
+    if (memory == MAP_FAILED)
+    {
+      ec = asio::error_code(errno, asio::error::get_system_category());
+      close_fds(fds);
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    detail::shm_ring_header* header =
+      static_cast<detail::shm_ring_header*>(memory);
+    std::size_t capacity = static_cast<std::size_t>(header->capacity);
+    if (header->magic != detail::shm_ring_header::magic_value
+        || capacity == 0 || capacity > (size - page_size) / 2)
+    {
+      ec = asio::error::invalid_argument;
+      ::munmap(memory, size);
+      close_fds(fds);
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    open_side(1, fds, memory, size, capacity, ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Get the descriptors to be passed to the peer.
+  /**
+   * The returned descriptors remain owned by this object. They are the memory
+   * shared by the two ends and the four descriptors used for notification.
+   */
+  passed_fds handles() noexcept
+  {
+    passed_fds result;
+    if (memory_)
+    {
+      int own_fds[2] = { read_event_.native_handle(),
+        write_event_.native_handle() };
+      int peer_fds[2] = { peer_read_event_fd_, peer_write_event_fd_ };
+      result.push_back(memory_fd_);
+      for (int i = 0; i < 2; ++i)
+        result.push_back(side_ == 0 ? own_fds[i] : peer_fds[i]);
+      for (int i = 0; i < 2; ++i)
+        result.push_back(side_ == 0 ? peer_fds[i] : own_fds[i]);
+    }
+    return result;
+  }
+
+  /// Determine whether the stream is open.
+  bool is_open() const noexcept
+  {
+    return memory_ != 0;
+  }
+
+  /// Get the number of bytes that may be buffered in each direction.
+  std::size_t capacity() const noexcept
+  {
+    return capacity_;
+  }
+
+  /// Close this end of the stream.
+  /**
+   * Any asynchronous operations are cancelled immediately, and will complete
+   * with the asio::error::operation_aborted error. Once the peer has read
+   * any data already written, its reads complete with asio::error::eof, and
+   * its writes complete with asio::error::broken_pipe.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void close()
+  {
+    asio::error_code ec;
+    close(ec);
+    asio::detail::throw_error(ec, "close");
+  }
+
+  /// Close this end of the stream.
+  /**
+   * Any asynchronous operations are cancelled immediately, and will complete
+   * with the asio::error::operation_aborted error. Once the peer has read
+   * any data already written, its reads complete with asio::error::eof, and
+   * its writes complete with asio::error::broken_pipe.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID close(asio::error_code& ec)
+  {
+    if (memory_)
+    {
+      tx_.close_writer();
+      rx_.close_reader();
+      notify_peer(peer_read_event_fd_);
+      notify_peer(peer_write_event_fd_);
+      ::munmap(memory_, memory_size_);
+      ::close(memory_fd_);
+      ::close(peer_read_event_fd_);
+      ::close(peer_write_event_fd_);
+      memory_ = 0;
+      memory_size_ = 0;
+      memory_fd_ = -1;
+      peer_read_event_fd_ = -1;
+      peer_write_event_fd_ = -1;
+      capacity_ = 0;
+    }
+    asio::error_code write_ec;
+    write_event_.close(write_ec);
+    read_event_.close(ec);
+    if (!ec)
+      ec = write_ec;
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Cancel all asynchronous operations associated with the stream.
+  /**
+   * @throws asio::system_error Thrown on failure.
+   */
+  void cancel()
+  {
+    read_event_.cancel();
+    write_event_.cancel();
+  }
+
+  /// Write some data to the stream.
+  /**
+   * This function is used to write data to the stream. The function call
+   * will block until one or more bytes of the data has been written
+   * successfully, or until an error occurs.
+   *
+   * @param buffers The data to be written.
+   *
+   * @returns The number of bytes written.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t write_some(const ConstBufferSequence& buffers)
+  {
+    asio::error_code ec;
+    std::size_t n = write_some(buffers, ec);
+    asio::detail::throw_error(ec, "write_some");
+    return n;
+  }
+
+  /// Write some data to the stream.
+  /**
+   * This function is used to write data to the stream. The function call
+   * will block until one or more bytes of the data has been written
+   * successfully, or until an error occurs.
+   *
+   * @param buffers The data to be written.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes written. Returns 0 if an error occurred.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t write_some(const ConstBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    ec = asio::error_code();
+    std::size_t n = 0;
+    while (!perform_write(buffers, n, ec))
+      if (prepare_write_wait())
+        wait_event(write_event_, ec);
+    return n;
+  }
+
+  /// Start an asynchronous write.
+  /**
+   * This function is used to asynchronously write data to the stream. It is
+   * an initiating function for an @ref asynchronous_operation, and always
+   * returns immediately.
+   *
+   * At most one write operation may be outstanding at a time.
+   *
+   * @param buffers The data to be written to the stream. Although the buffers
+   * object may be copied as necessary, ownership of the underlying buffers is
+   * retained by the caller, which must guarantee that they remain valid until
+   * the completion handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the write completes.
+   * The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes written.
+   * ); @endcode
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_write_some(const ConstBufferSequence& buffers,
+      WriteToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_compose<WriteToken, void (asio::error_code, std::size_t)>(
+        declval<write_op<ConstBufferSequence>>(), token,
+        declval<posix::basic_stream_descriptor<Executor>&>()))
+  {
+    return async_compose<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        write_op<ConstBufferSequence>(this, buffers), token, write_event_);
+  }
+
+  /// Read some data from the stream.
+  /**
+   * This function is used to read data from the stream. The function call
+   * will block until one or more bytes of data has been read successfully,
+   * or until an error occurs.
+   *
+   * @param buffers The buffers into which the data will be read.
+   *
+   * @returns The number of bytes read.
+   *
+   * @throws asio::system_error Thrown on failure. An error code of
+   * asio::error::eof indicates that the peer closed its end.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers)
+  {
+    asio::error_code ec;
+    std::size_t n = read_some(buffers, ec);
+    asio::detail::throw_error(ec, "read_some");
+    return n;
+  }
+
+  /// Read some data from the stream.
+  /**
+   * This function is used to read data from the stream. The function call
+   * will block until one or more bytes of data has been read successfully,
+   * or until an error occurs.
+   *
+   * @param buffers The buffers into which the data will be read.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes read. Returns 0 if an error occurred.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    ec = asio::error_code();
+    std::size_t n = 0;
+    while (!perform_read(buffers, n, ec))
+      if (prepare_read_wait())
+        wait_event(read_event_, ec);
+    return n;
+  }
+
+  /// Start an asynchronous read.
+  /**
+   * This function is used to asynchronously read data from the stream. It is
+   * an initiating function for an @ref asynchronous_operation, and always
+   * returns immediately.
+   *
+   * At most one read operation may be outstanding at a time.
+   *
+   * @param buffers The buffers into which the data will be read. Although the
+   * buffers object may be copied as necessary, ownership of the underlying
+   * buffers is retained by the caller, which must guarantee that they remain
+   * valid until the completion handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the read completes.
+   * The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes read.
+   * ); @endcode
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_read_some(const MutableBufferSequence& buffers,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_compose<ReadToken, void (asio::error_code, std::size_t)>(
+        declval<read_op<MutableBufferSequence>>(), token,
+        declval<posix::basic_stream_descriptor<Executor>&>()))
+  {
+    return async_compose<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        read_op<MutableBufferSequence>(this, buffers), token, read_event_);
+  }
+
+private:
+  // Disallow copying and assignment.
+  basic_shm_stream(const basic_shm_stream&) = delete;
+  basic_shm_stream& operator=(const basic_shm_stream&) = delete;
+
+  static void close_fds(int fds[5])
+  {
+    for (int i = 0; i < 5; ++i)
+      if (fds[i] != -1)
+        ::close(fds[i]);
+  }
+
+  // Take ownership of the descriptors and mapping for one end. Side 0 writes
+  // to ring 0 and sleeps on the first pair of event descriptors, the first of
+  // which is used to wait for data and the second to wait for space.
+  void open_side(int side, int fds[5], void* memory,
+      std::size_t memory_size, std::size_t capacity, asio::error_code& ec)
+  {
+    read_event_.assign(fds[1 + 2 * side], ec);
+    if (!ec)
+    {
+      fds[1 + 2 * side] = -1;
+      write_event_.assign(fds[2 + 2 * side], ec);
+      if (ec)
+      {
+        asio::error_code ignored_ec;
+        read_event_.close(ignored_ec);
+      }
+    }
+
+    if (ec)
+    {
+      ::munmap(memory, memory_size);
+      close_fds(fds);
+      return;
+    }
+
+    std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    detail::shm_ring_header* header =
+      static_cast<detail::shm_ring_header*>(memory);
+    unsigned char* data = static_cast<unsigned char*>(memory) + page_size;
+    tx_.reset(&header->rings[side], data + side * capacity, capacity);
+    rx_.reset(&header->rings[1 - side], data + (1 - side) * capacity, capacity);
+
+    memory_fd_ = fds[0];
+    peer_read_event_fd_ = fds[3 - 2 * side];
+    peer_write_event_fd_ = fds[4 - 2 * side];
+    side_ = side;
+    memory_ = memory;
+    memory_size_ = memory_size;
+    capacity_ = capacity;
+  }
+
+  // Wake the peer if it is sleeping on the given descriptor.
+  static void notify_peer(int peer_event_fd) noexcept
+  {
+    uint64_t one = 1;
+    ssize_t result = ::write(peer_event_fd, &one, sizeof(one));
+    (void)result;
+  }
+
+  // Consume any notification received from the peer.
+  static void drain_event(
+      posix::basic_stream_descriptor<Executor>& event) noexcept
+  {
+    uint64_t value = 0;
+    ssize_t result = ::read(event.native_handle(), &value, sizeof(value));
+    (void)result;
+  }
+
+  // Block until notified by the peer.
+  static void wait_event(posix::basic_stream_descriptor<Executor>& event,
+      asio::error_code& ec)
+  {
+    pollfd fd = pollfd();
+    fd.fd = event.native_handle();
+    fd.events = POLLIN;
+    if (::poll(&fd, 1, -1) < 0 && errno != EINTR)
+      ec = asio::error_code(errno, asio::error::get_system_category());
+    else
+      drain_event(event);
+  }
+
+  // Attempt a write. Returns true when the write is finished.
+  template <typename ConstBufferSequence>
+  bool perform_write(const ConstBufferSequence& buffers,
+      std::size_t& bytes_transferred, asio::error_code& ec)
+  {
+    if (ec)
+      return true;
+
+    if (!memory_)
+    {
+      ec = asio::error::bad_descriptor;
+      return true;
+    }
+
+    if (tx_.reader_closed())
+    {
+      ec = asio::error::broken_pipe;
+      return true;
+    }
+
+    if (asio::buffer_size(buffers) == 0)
+      return true;
+
+    bytes_transferred = tx_.write(buffers);
+    if (bytes_transferred == 0)
+      return false;
+
+    if (tx_.take_reader_waiting())
+      notify_peer(peer_read_event_fd_);
+    return true;
+  }
+
+  // Prepare to wait for space. Returns false if space is already available.
+  bool prepare_write_wait()
+  {
+    tx_.set_writer_waiting();
+    return tx_.writable() == 0 && !tx_.reader_closed();
+  }
+
+  // Attempt a read. Returns true when the read is finished.
+  template <typename MutableBufferSequence>
+  bool perform_read(const MutableBufferSequence& buffers,
+      std::size_t& bytes_transferred, asio::error_code& ec)
+  {
+    if (ec)
+      return true;
+
+    if (!memory_)
+    {
+      ec = asio::error::bad_descriptor;
+      return true;
+    }
+
+    if (asio::buffer_size(buffers) == 0)
+      return true;
+
+    // The peer sets the closed flag after writing its final data, and so the
+    // flag is checked first to avoid missing any of that data.
+    bool closed = rx_.writer_closed();
+    bytes_transferred = rx_.read(buffers);
+    if (bytes_transferred == 0)
+    {
+      if (closed)
+        ec = asio::error::eof;
+      return closed;
+    }
+
+    if (rx_.take_writer_waiting())
+      notify_peer(peer_write_event_fd_);
+    return true;
+  }
+
+  // Prepare to wait for data. Returns false if data is already available.
+  bool prepare_read_wait()
+  {
+    rx_.set_reader_waiting();
+    return rx_.readable() == 0 && !rx_.writer_closed();
+  }
+
+  // Writes data to the ring, sleeping on the write event descriptor while the
+  // ring is full. When no wait is needed on the first attempt, the operation
+  // is posted so that it does not complete from within async_write_some().
+  template <typename ConstBufferSequence>
+  class write_op
+  {
+  public:
+    write_op(basic_shm_stream* stream, const ConstBufferSequence& buffers)
+      : stream_(stream),
+        buffers_(buffers),
+        started_(false)
+    {
+    }
+
+    template <typename Self>
+    void operator()(Self& self, asio::error_code ec = asio::error_code())
+    {
+      if (!started_)
+      {
+        started_ = true;
+        if (!stream_->memory_ || asio::buffer_size(buffers_) == 0
+            || stream_->tx_.writable() > 0 || !stream_->prepare_write_wait())
+          asio::post(stream_->get_executor(), static_cast<Self&&>(self));
+        else
+          stream_->write_event_.async_wait(posix::descriptor_base::wait_read,
+              static_cast<Self&&>(self));
+        return;
+      }
+
+      if (!ec && stream_->memory_)
+        drain_event(stream_->write_event_);
+
+      std::size_t n = 0;
+      while (!stream_->perform_write(buffers_, n, ec))
+      {
+        if (stream_->prepare_write_wait())
+        {
+          stream_->write_event_.async_wait(posix::descriptor_base::wait_read,
+              static_cast<Self&&>(self));
+          return;
+        }
+      }
+
+      self.complete(ec, n);
+    }
+
+  private:
+    basic_shm_stream* stream_;
+    ConstBufferSequence buffers_;
+    bool started_;
+  };
+
+  // Reads data from the ring, sleeping on the read event descriptor while the
+  // ring is empty. When no wait is needed on the first attempt, the operation
+  // is posted so that it does not complete from within async_read_some().
+  template <typename MutableBufferSequence>
+  class read_op
+  {
+  public:
+    read_op(basic_shm_stream* stream, const MutableBufferSequence& buffers)
+      : stream_(stream),
+        buffers_(buffers),
+        started_(false)
+    {
+    }
+
+    template <typename Self>
+    void operator()(Self& self, asio::error_code ec = asio::error_code())
+    {
+      if (!started_)
+      {
+        started_ = true;
+        if (!stream_->memory_ || asio::buffer_size(buffers_) == 0
+            || stream_->rx_.readable() > 0 || !stream_->prepare_read_wait())
+          asio::post(stream_->get_executor(), static_cast<Self&&>(self));
+        else
+          stream_->read_event_.async_wait(posix::descriptor_base::wait_read,
+              static_cast<Self&&>(self));
+        return;
+      }
+
+      if (!ec && stream_->memory_)
+        drain_event(stream_->read_event_);
+
+      std::size_t n = 0;
+      while (!stream_->perform_read(buffers_, n, ec))
+      {
+        if (stream_->prepare_read_wait())
+        {
+          stream_->read_event_.async_wait(posix::descriptor_base::wait_read,
+              static_cast<Self&&>(self));
+          return;
+        }
+      }
+
+      self.complete(ec, n);
+    }
+
+  private:
+    basic_shm_stream* stream_;
+    MutableBufferSequence buffers_;
+    bool started_;
+  };
+
+  posix::basic_stream_descriptor<Executor> read_event_;
+  posix::basic_stream_descriptor<Executor> write_event_;
+  int memory_fd_;
+  int peer_read_event_fd_;
+  int peer_write_event_fd_;
+  int side_;
+  void* memory_;
+  std::size_t memory_size_;
+  std::size_t capacity_;
+  detail::shm_ring tx_;
+  detail::shm_ring rx_;
+};
+
+/// Create a connected pair of shared-memory streams.
+template <typename Executor1, typename Executor2>
+void connect_pair(basic_shm_stream<Executor1>& stream1,
+    basic_shm_stream<Executor2>& stream2, std::size_t capacity = 65536);
+
+/// Create a connected pair of shared-memory streams.
+template <typename Executor1, typename Executor2>
+ASIO_SYNC_OP_VOID connect_pair(basic_shm_stream<Executor1>& stream1,
+    basic_shm_stream<Executor2>& stream2, std::size_t capacity,
+    asio::error_code& ec);
+
+template <typename Executor1, typename Executor2>
+inline void connect_pair(basic_shm_stream<Executor1>& stream1,
+    basic_shm_stream<Executor2>& stream2, std::size_t capacity)
+{
+  asio::error_code ec;
+  connect_pair(stream1, stream2, capacity, ec);
+  asio::detail::throw_error(ec, "connect_pair");
+}
+
+template <typename Executor1, typename Executor2>
+inline ASIO_SYNC_OP_VOID connect_pair(basic_shm_stream<Executor1>& stream1,
+    basic_shm_stream<Executor2>& stream2, std::size_t capacity,
+    asio::error_code& ec)
+{
+  stream1.create(capacity, ec);
+  if (ec)
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+
+  passed_fds handles = stream1.handles();
+  passed_fds copies;
+  for (std::size_t i = 0; i < handles.count; ++i)
+  {
+    int fd = ::fcntl(handles.fds[i], F_DUPFD_CLOEXEC, 0);
+    if (fd == -1)
+    {
+      ec = asio::error_code(errno, asio::error::get_system_category());
+      for (std::size_t j = 0; j < copies.count; ++j)
+        ::close(copies.fds[j]);
+      asio::error_code ignored_ec;
+      stream1.close(ignored_ec);
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+    copies.push_back(fd);
+  }
+
+  stream2.attach(copies, ec);
+  if (ec)
+  {
+    asio::error_code ignored_ec;
+    stream1.close(ignored_ec);
+  }
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+} // namespace local
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_SHM_STREAM)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_LOCAL_BASIC_SHM_STREAM_HPP
@@ -0,0 +1,236 @@
+//
+// local/detail/shm_ring.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_LOCAL_DETAIL_SHM_RING_HPP
+#define ASIO_LOCAL_DETAIL_SHM_RING_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SHM_STREAM)
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include "asio/buffer.hpp"
+#include "asio/detail/cstdint.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace local {
+namespace detail {
+
+// The shared state of one direction of a shared-memory stream. The fields
+// written by the producer and by the consumer are kept on separate cache
+// lines. The positions increase without wrapping and are reduced modulo the
+// capacity to find a byte's offset in the ring.
+struct shm_ring_control
+{
+  // Written by the producer.
+  std::atomic<uint64_t> write_pos;
+  std::atomic<uint32_t> reader_waiting;
+  std::atomic<uint32_t> writer_closed;
+  char producer_padding[64 - sizeof(uint64_t) - 2 * sizeof(uint32_t)];
+
+  // Written by the consumer.
+  std::atomic<uint64_t> read_pos;
+  std::atomic<uint32_t> writer_waiting;
+  std::atomic<uint32_t> reader_closed;
+  char consumer_padding[64 - sizeof(uint64_t) - 2 * sizeof(uint32_t)];
+};
+
+// The layout at the start of the shared memory. The data for the two rings
+// follows the header, first for ring 0 and then for ring 1.
+struct shm_ring_header
+{
+  enum { magic_value = 0x6173696f };
+
+  uint32_t magic;
+  uint32_t reserved;
+  uint64_t capacity;
+  char padding[64 - 2 * sizeof(uint32_t) - sizeof(uint64_t)];
+  shm_ring_control rings[2];
+};
+
+// Accesses one direction of a shared-memory stream. The producer and the
+// consumer may be in different processes, so all shared state is held in the
+// mapped memory and accessed using lock-free atomics.
+//
+// A side that finds the ring empty (or full) sets its waiting flag and checks
+// again before sleeping. The other side clears the flag after it publishes a
+// new position, and notifies the sleeper if the flag was set. All of these
+// accesses are sequentially consistent, so at least one side sees the other's
+// update and a notification cannot be lost.
+class shm_ring
+{
+public:
+  shm_ring()
+    : control_(0),
+      data_(0),
+      capacity_(0)
+  {
+  }
+
+  void reset(shm_ring_control* control, unsigned char* data,
+      std::size_t capacity) noexcept
+  {
+    control_ = control;
+    data_ = data;
+    capacity_ = capacity;
+  }
+
+  // Get the number of bytes that may be read. Called only by the consumer.
+  std::size_t readable() const noexcept
+  {
+    return static_cast<std::size_t>(
+        control_->write_pos.load(std::memory_order_seq_cst)
+          - control_->read_pos.load(std::memory_order_relaxed));
+  }
+
+  // Get the number of bytes that may be written. Called only by the producer.
+  std::size_t writable() const noexcept
+  {
+    return capacity_ - static_cast<std::size_t>(
+        control_->write_pos.load(std::memory_order_relaxed)
+          - control_->read_pos.load(std::memory_order_seq_cst));
+  }
+
+  // Copy data out of the ring and release the space to the producer. Returns
+  // the number of bytes copied. Called only by the consumer.
+  template <typename MutableBufferSequence>
+  std::size_t read(const MutableBufferSequence& buffers) noexcept
+  {
+    uint64_t pos = control_->read_pos.load(std::memory_order_relaxed);
+    std::size_t available = readable();
+    std::size_t total = 0;
+    auto iter = asio::buffer_sequence_begin(buffers);
+    auto end = asio::buffer_sequence_end(buffers);
+    for (; iter != end && total < available; ++iter)
+    {
+      asio::mutable_buffer buffer(*iter);
+      std::size_t n = buffer.size() < available - total
+        ? buffer.size() : available - total;
+      if (n > 0)
+        copy_out(pos + total, static_cast<unsigned char*>(buffer.data()), n);
+      total += n;
+    }
+    if (total > 0)
+      control_->read_pos.store(pos + total, std::memory_order_seq_cst);
+    return total;
+  }
+
+  // Copy data into the ring and publish it to the consumer. Returns the number
+  // of bytes copied. Called only by the producer.
+  template <typename ConstBufferSequence>
+  std::size_t write(const ConstBufferSequence& buffers) noexcept
+  {
+    uint64_t pos = control_->write_pos.load(std::memory_order_relaxed);
+    std::size_t space = writable();
+    std::size_t total = 0;
+    auto iter = asio::buffer_sequence_begin(buffers);
+    auto end = asio::buffer_sequence_end(buffers);
+    for (; iter != end && total < space; ++iter)
+    {
+      asio::const_buffer buffer(*iter);
+      std::size_t n = buffer.size() < space - total
+        ? buffer.size() : space - total;
+      if (n > 0)
+        copy_in(pos + total,
+            static_cast<const unsigned char*>(buffer.data()), n);
+      total += n;
+    }
+    if (total > 0)
+      control_->write_pos.store(pos + total, std::memory_order_seq_cst);
+    return total;
+  }
+
+  // Record that the consumer is about to wait for data.
+  void set_reader_waiting() noexcept
+  {
+    control_->reader_waiting.store(1, std::memory_order_seq_cst);
+  }
+
+  // Record that the producer is about to wait for space.
+  void set_writer_waiting() noexcept
+  {
+    control_->writer_waiting.store(1, std::memory_order_seq_cst);
+  }
+
+  // Determine whether the consumer must be notified of new data.
+  bool take_reader_waiting() noexcept
+  {
+    return control_->reader_waiting.load(std::memory_order_seq_cst) != 0
+      && control_->reader_waiting.exchange(0, std::memory_order_seq_cst) != 0;
+  }
+
+  // Determine whether the producer must be notified of new space.
+  bool take_writer_waiting() noexcept
+  {
+    return control_->writer_waiting.load(std::memory_order_seq_cst) != 0
+      && control_->writer_waiting.exchange(0, std::memory_order_seq_cst) != 0;
+  }
+
+  // Mark the ring as having no further data.
+  void close_writer() noexcept
+  {
+    control_->writer_closed.store(1, std::memory_order_seq_cst);
+  }
+
+  // Mark the ring as having no further reads.
+  void close_reader() noexcept
+  {
+    control_->reader_closed.store(1, std::memory_order_seq_cst);
+  }
+
+  bool writer_closed() const noexcept
+  {
+    return control_->writer_closed.load(std::memory_order_seq_cst) != 0;
+  }
+
+  bool reader_closed() const noexcept
+  {
+    return control_->reader_closed.load(std::memory_order_seq_cst) != 0;
+  }
+
+private:
+  void copy_out(uint64_t pos, unsigned char* to, std::size_t n) noexcept
+  {
+    std::size_t offset = static_cast<std::size_t>(pos % capacity_);
+    std::size_t first = n < capacity_ - offset ? n : capacity_ - offset;
+    std::memcpy(to, data_ + offset, first);
+    std::memcpy(to + first, data_, n - first);
+  }
+
+  void copy_in(uint64_t pos, const unsigned char* from, std::size_t n) noexcept
+  {
+    std::size_t offset = static_cast<std::size_t>(pos % capacity_);
+    std::size_t first = n < capacity_ - offset ? n : capacity_ - offset;
+    std::memcpy(data_ + offset, from, first);
+    std::memcpy(data_, from + first, n - first);
+  }
+
+  shm_ring_control* control_;
+  unsigned char* data_;
+  std::size_t capacity_;
+};
+
+} // namespace detail
+} // namespace local
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_SHM_STREAM)
+
+#endif // ASIO_LOCAL_DETAIL_SHM_RING_HPP
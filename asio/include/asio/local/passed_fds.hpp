@@ -0,0 +1,128 @@
+//
+// local/passed_fds.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_LOCAL_PASSED_FDS_HPP
+#define ASIO_LOCAL_PASSED_FDS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_FD_PASSING) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include "asio/detail/socket_option.hpp"
+#include "asio/detail/socket_types.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace local {
+
+/// File descriptors, and the sender's credentials, passed with a message on a
+/// local socket.
+/**
+ * A passed_fds object names the descriptors to be sent by operations such as
+ * basic_stream_socket::async_send_fds(), and receives the descriptors passed
+ * to operations such as basic_stream_socket::async_receive_fds().
+ *
+ * Sending a descriptor does not transfer ownership of it. Received
+ * descriptors are new descriptors in the receiving process, are opened with
+ * the close-on-exec flag where supported, and must be closed by the receiver.
+ */
+struct passed_fds
+{
+  /// The maximum number of descriptors passed with a single message.
+  static constexpr std::size_t max_fds = 253;
+
+  /// Construct an object that holds no descriptors.
+  passed_fds() noexcept
+    : count(0),
+      truncated(false),
+      has_credentials(false),
+      pid(0),
+      uid(0),
+      gid(0)
+  {
+  }
+
+  /// Add a descriptor. Returns false if the object is already full.
+  bool push_back(int fd) noexcept
+  {
+    if (count >= max_fds)
+      return false;
+    fds[count++] = fd;
+    return true;
+  }
+
+  /// The number of descriptors held in @c fds.
+  std::size_t count;
+
+  /// The descriptors.
+  int fds[max_fds];
+
+  /// Whether the received descriptors were truncated. The kernel closes any
+  /// descriptors that did not fit.
+  bool truncated;
+
+  /// Whether the sender's credentials were received. Credentials are passed
+  /// once enabled on the receiving socket using the pass_credentials socket
+  /// option.
+  bool has_credentials;
+
+  /// The sender's process ID.
+  pid_t pid;
+
+  /// The sender's user ID.
+  uid_t uid;
+
+  /// The sender's group ID.
+  gid_t gid;
+};
+
+#if defined(SO_PASSCRED) \
+  || defined(GENERATING_DOCUMENTATION)
+/// Socket option to receive the sender's credentials with each message.
+/**
+ * Implements the SOL_SOCKET/SO_PASSCRED socket option.
+ *
+ * @par Examples
+ * Setting the option:
+ * @code
+ * asio::local::stream_protocol::socket socket(my_context);
+ * ...
+ * asio::local::pass_credentials option(true);
+ * socket.set_option(option);
+ * @endcode
+ *
+ * @par Concepts:
+ * Socket_Option, Boolean_Socket_Option.
+ */
+#if defined(GENERATING_DOCUMENTATION)
+typedef implementation_defined pass_credentials;
+#else
+typedef asio::detail::socket_option::boolean<
+  ASIO_OS_DEF(SOL_SOCKET), SO_PASSCRED> pass_credentials;
+#endif
+#endif // defined(SO_PASSCRED)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+} // namespace local
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_FD_PASSING)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_LOCAL_PASSED_FDS_HPP
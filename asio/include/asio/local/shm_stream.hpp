@@ -0,0 +1,37 @@
+//
+// local/shm_stream.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_LOCAL_SHM_STREAM_HPP
+#define ASIO_LOCAL_SHM_STREAM_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SHM_STREAM) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include "asio/local/basic_shm_stream.hpp"
+
+namespace asio {
+namespace local {
+
+/// Typedef for the typical usage of a shared-memory stream.
+typedef basic_shm_stream<> shm_stream;
+
+} // namespace local
+} // namespace asio
+
+#endif // defined(ASIO_HAS_SHM_STREAM)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_LOCAL_SHM_STREAM_HPP
@@ -0,0 +1,476 @@
+//
+// mapped_file.hpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_MAPPED_FILE_HPP
+#define ASIO_MAPPED_FILE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_MAPPED_FILE) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include <string>
+#include "asio/async_result.hpp"
+#include "asio/buffer.hpp"
+#include "asio/compose.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/error.hpp"
+#include "asio/execution/executor.hpp"
+#include "asio/is_executor.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class initiate_async_prefetch;
+
+} // namespace detail
+
+/// A read-only view of a file that is mapped into memory.
+/**
+ * A mapped file maps the whole of a file into the address space of the
+ * process, so that its contents may be used as buffers without first being
+ * copied out of the operating system's page cache. Windows onto the file are
+ * obtained as const_buffer objects, and so may be passed directly to
+ * operations such as asio::async_write().
+ *
+ * The file remains open while it is mapped. Its descriptor or handle is
+ * available through native_handle(), so that the mapped file may also be
+ * passed to asio::async_sendfile().
+ *
+ * Accessing the memory of a file that is truncated by another process while
+ * it is mapped may raise a signal, such as @c SIGBUS, on POSIX platforms.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code
+ * asio::mapped_file content("/var/www/index.html");
+ * content.advise(asio::mapped_file::sequential);
+ * asio::async_write(socket, content.view(0, content.size()), handler);
+ * @endcode
+ */
+class mapped_file
+{
+public:
+  /// The native representation of the file.
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined native_handle_type;
+#elif defined(ASIO_WINDOWS)
+  typedef void* native_handle_type;
+#else
+  typedef int native_handle_type;
+#endif
+
+  /// Hints about how the mapped memory will be accessed.
+  enum advice
+  {
+    /// No particular access pattern.
+    normal,
+
+    /// The memory will be read from beginning to end.
+    sequential,
+
+    /// The memory will be read in no particular order.
+    random,
+
+    /// The memory will be needed soon.
+    will_need,
+
+    /// The memory will not be needed soon.
+    dont_need
+  };
+
+  /// Construct a mapped file that does not refer to any file.
+  mapped_file() noexcept
+    : data_(0),
+      size_(0),
+      handle_(invalid_handle())
+  {
+  }
+
+  /// Construct and map a file.
+  /**
+   * This constructor opens the specified file for reading and maps it into
+   * memory.
+   *
+   * @param path The path name identifying the file to be mapped.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  explicit mapped_file(const char* path)
+    : data_(0),
+      size_(0),
+      handle_(invalid_handle())
+  {
+    asio::error_code ec;
+    open(path, ec);
+    asio::detail::throw_error(ec, "open");
+  }
+
+  /// Construct and map a file.
+  /**
+   * This constructor opens the specified file for reading and maps it into
+   * memory.
+   *
+   * @param path The path name identifying the file to be mapped.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  explicit mapped_file(const std::string& path)
+    : data_(0),
+      size_(0),
+      handle_(invalid_handle())
+  {
+    asio::error_code ec;
+    open(path.c_str(), ec);
+    asio::detail::throw_error(ec, "open");
+  }
+
+  /// Move-construct a mapped file from another.
+  mapped_file(mapped_file&& other) noexcept
+    : data_(other.data_),
+      size_(other.size_),
+      handle_(other.handle_)
+  {
+    other.data_ = 0;
+    other.size_ = 0;
+    other.handle_ = invalid_handle();
+  }
+
+  /// Move-assign a mapped file from another.
+  mapped_file& operator=(mapped_file&& other) noexcept
+  {
+    if (this != &other)
+    {
+      asio::error_code ignored_ec;
+      close(ignored_ec);
+      data_ = other.data_;
+      size_ = other.size_;
+      handle_ = other.handle_;
+      other.data_ = 0;
+      other.size_ = 0;
+      other.handle_ = invalid_handle();
+    }
+    return *this;
+  }
+
+  /// Destroy the mapped file, unmapping and closing it.
+  ~mapped_file()
+  {
+    asio::error_code ignored_ec;
+    close(ignored_ec);
+  }
+
+  /// Open and map a file.
+  /**
+   * This function opens the specified file for reading and maps it into
+   * memory. An empty file is opened but not mapped.
+   *
+   * @param path The path name identifying the file to be mapped.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void open(const char* path)
+  {
+    asio::error_code ec;
+    open(path, ec);
+    asio::detail::throw_error(ec, "open");
+  }
+
+  /// Open and map a file.
+  /**
+   * This function opens the specified file for reading and maps it into
+   * memory. An empty file is opened but not mapped.
+   *
+   * @param path The path name identifying the file to be mapped.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID open(const char* path,
+      asio::error_code& ec);
+
+  /// Open and map a file.
+  /**
+   * This function opens the specified file for reading and maps it into
+   * memory. An empty file is opened but not mapped.
+   *
+   * @param path The path name identifying the file to be mapped.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void open(const std::string& path)
+  {
+    open(path.c_str());
+  }
+
+  /// Open and map a file.
+  /**
+   * This function opens the specified file for reading and maps it into
+   * memory. An empty file is opened but not mapped.
+   *
+   * @param path The path name identifying the file to be mapped.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID open(const std::string& path,
+      asio::error_code& ec)
+  {
+    open(path.c_str(), ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Determine whether the file is open.
+  bool is_open() const noexcept
+  {
+    return handle_ != invalid_handle();
+  }
+
+  /// Unmap and close the file.
+  /**
+   * Buffers obtained from the mapped file are invalidated.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void close()
+  {
+    asio::error_code ec;
+    close(ec);
+    asio::detail::throw_error(ec, "close");
+  }
+
+  /// Unmap and close the file.
+  /**
+   * Buffers obtained from the mapped file are invalidated.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID close(asio::error_code& ec);
+
+  /// Get the native file representation.
+  /**
+   * This function may be used to obtain the underlying representation of the
+   * file, which remains open while the file is mapped.
+   */
+  native_handle_type native_handle() const noexcept
+  {
+    return handle_;
+  }
+
+  /// Get a pointer to the beginning of the mapped memory.
+  const void* data() const noexcept
+  {
+    return data_;
+  }
+
+  /// Get the size of the mapped file.
+  std::size_t size() const noexcept
+  {
+    return size_;
+  }
+
+  /// Get a window onto the mapped file.
+  /**
+   * @param offset The offset of the beginning of the window.
+   *
+   * @param size The size of the window, in bytes.
+   *
+   * @returns A buffer that represents the part of the window that lies within
+   * the file. The buffer is empty if @c offset is beyond the end of the file.
+   */
+  const_buffer view(uint64_t offset, std::size_t size) const noexcept
+  {
+    if (offset >= size_)
+      return const_buffer();
+    std::size_t available = size_ - static_cast<std::size_t>(offset);
+    return const_buffer(static_cast<const char*>(data_) + offset,
+        size < available ? size : available);
+  }
+
+  /// Give the operating system a hint about how the memory will be used.
+  /**
+   * @param a The expected pattern of access.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void advise(advice a) const
+  {
+    asio::error_code ec;
+    advise(a, 0, size_, ec);
+    asio::detail::throw_error(ec, "advise");
+  }
+
+  /// Give the operating system a hint about how part of the memory will be
+  /// used.
+  /**
+   * @param a The expected pattern of access.
+   *
+   * @param offset The offset of the beginning of the range.
+   *
+   * @param size The size of the range, in bytes.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void advise(advice a, uint64_t offset, std::size_t size) const
+  {
+    asio::error_code ec;
+    advise(a, offset, size, ec);
+    asio::detail::throw_error(ec, "advise");
+  }
+
+  /// Give the operating system a hint about how part of the memory will be
+  /// used.
+  /**
+   * Hints that are not supported by the operating system are ignored.
+   *
+   * @param a The expected pattern of access.
+   *
+   * @param offset The offset of the beginning of the range.
+   *
+   * @param size The size of the range, in bytes.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID advise(advice a, uint64_t offset,
+      std::size_t size, asio::error_code& ec) const;
+
+  /// Read part of the file into memory.
+  /**
+   * This function blocks until the pages in the range have been read from
+   * the file into memory, so that they may subsequently be accessed without
+   * blocking. The operating system may discard the pages again under memory
+   * pressure.
+   *
+   * @param offset The offset of the beginning of the range.
+   *
+   * @param size The size of the range, in bytes.
+   */
+  ASIO_DECL void prefetch(uint64_t offset, std::size_t size) const;
+
+  /// Start an asynchronous read of part of the file into memory.
+  /**
+   * This function is used to read the pages in a range of the file into
+   * memory, as if by prefetch(), without blocking the calling thread. It is an
+   * initiating function for an @ref asynchronous_operation, and always returns
+   * immediately.
+   *
+   * The pages are read by a thread of the system_context, and the completion
+   * handler is then called through the executor @c ex, or the handler's
+   * associated executor.
+   *
+   * @param ex The executor that is used to track outstanding work and to call
+   * the completion handler.
+   *
+   * @param offset The offset of the beginning of the range.
+   *
+   * @param size The size of the range, in bytes.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the pages have been read.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error // Result of operation.
+   * ); @endcode
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   *
+   * @note The mapped file must remain open until the completion handler is
+   * called.
+   */
+  template <typename Executor,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        PrefetchToken = default_completion_token_t<Executor>>
+  auto async_prefetch(const Executor& ex, uint64_t offset, std::size_t size,
+      PrefetchToken&& token = default_completion_token_t<Executor>(),
+      constraint_t<
+        execution::is_executor<Executor>::value
+          || is_executor<Executor>::value
+      > = 0)
+    -> decltype(
+      async_compose<PrefetchToken, void (asio::error_code)>(
+        declval<detail::initiate_async_prefetch>(), token, ex))
+  {
+    return async_compose<PrefetchToken, void (asio::error_code)>(
+        make_prefetch(offset, size), token, ex);
+  }
+
+  /// Get the size of a page of memory.
+  ASIO_DECL static std::size_t page_size();
+
+private:
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  static native_handle_type invalid_handle() noexcept
+  {
+#if defined(ASIO_WINDOWS)
+    return reinterpret_cast<void*>(~static_cast<uintptr_t>(0));
+#else // defined(ASIO_WINDOWS)
+    return -1;
+#endif // defined(ASIO_WINDOWS)
+  }
+
+  inline detail::initiate_async_prefetch make_prefetch(
+      uint64_t offset, std::size_t size) const;
+
+  const void* data_;
+  std::size_t size_;
+  native_handle_type handle_;
+};
+
+/// Create a new non-modifiable buffer that represents a mapped file.
+/**
+ * @returns <tt>const_buffer(f.data(), f.size())</tt>.
+ */
+ASIO_NODISCARD inline const_buffer buffer(const mapped_file& f) noexcept
+{
+  return const_buffer(f.data(), f.size());
+}
+
+/// Create a new non-modifiable buffer that represents a mapped file.
+/**
+ * @returns A const_buffer value equivalent to:
+ * @code const_buffer(
+ *     f.data(),
+ *     min(f.size(), max_size_in_bytes)); @endcode
+ */
+ASIO_NODISCARD inline const_buffer buffer(const mapped_file& f,
+    std::size_t max_size_in_bytes) noexcept
+{
+  return const_buffer(f.data(),
+      f.size() < max_size_in_bytes ? f.size() : max_size_in_bytes);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/mapped_file.hpp"
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/impl/mapped_file.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // defined(ASIO_HAS_MAPPED_FILE)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_MAPPED_FILE_HPP
@@ -0,0 +1,148 @@
+//
+// memory_statistics.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_MEMORY_STATISTICS_HPP
+#define ASIO_MEMORY_STATISTICS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/memory_metrics_service.hpp"
+#include "asio/execution_context.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Counters describing the memory allocated for one purpose.
+struct memory_usage
+{
+  /// The number of blocks allocated.
+  uint64_t allocations;
+
+  /// The number of allocations that were satisfied from a cache.
+  uint64_t cache_hits;
+
+  /// The number of blocks deallocated.
+  uint64_t deallocations;
+
+  /// The total size, in bytes, requested by the allocations.
+  uint64_t bytes_allocated;
+
+  /// The total size, in bytes, of the deallocated blocks.
+  uint64_t bytes_deallocated;
+};
+
+/// Statistics describing the memory allocated on behalf of an execution
+/// context.
+/**
+ * The counters are maintained only if the execution context is constructed
+ * with the @c "memory" / @c "statistics" configuration option set to
+ * @c true. Otherwise they are all zero.
+ *
+ * Memory for handlers and other objects is counted when it is allocated or
+ * deallocated by a thread that is running the context, and is counted against
+ * the context that the thread is running. A block that is deallocated by some
+ * other thread is not counted as deallocated. Counters are updated using
+ * relaxed atomic operations, so a snapshot taken while the context is running
+ * may combine values from slightly different times.
+ */
+struct memory_statistics
+{
+  /// Whether the execution context maintains its counters.
+  bool enabled;
+
+  /// The memory used for asynchronous operations, and for completion handlers
+  /// allocated using the handler's associated allocator when that is the
+  /// default recycling allocator.
+  memory_usage operations;
+
+  /// The memory used for coroutine frames.
+  memory_usage awaitable_frames;
+
+  /// The memory used for type-erased function objects, such as those that
+  /// hold the functions submitted to a deadline_executor.
+  memory_usage executor_functions;
+
+  /// The memory used for the handlers of cancellation signals.
+  memory_usage cancellation_signals;
+
+  /// The memory used by parallel groups of operations.
+  memory_usage parallel_groups;
+
+  /// The memory used by operations started with a timeout.
+  memory_usage timed_cancels;
+
+  /// The memory used by promises.
+  memory_usage promises;
+
+  /// The storage of registered_buffer_pool objects associated with the
+  /// context. Each pool is counted as a single block.
+  memory_usage registered_buffers;
+
+  /// The buffers of SSL streams whose executors refer to the context. A buffer
+  /// taken from the shared pool of free buffers is counted as a cache hit.
+  memory_usage ssl_buffers;
+};
+
+/// Obtain the statistics describing the memory allocated on behalf of an
+/// execution context.
+/**
+ * This function may be called from any thread, including while other threads
+ * are running the execution context.
+ *
+ * @par Example
+ * @code asio::io_context io_context(
+ *     asio::config_from_string("memory.statistics=1"));
+ * ...
+ * asio::memory_statistics s = asio::get_memory_statistics(io_context);
+ * std::cout << s.operations.bytes_allocated - s.operations.bytes_deallocated
+ *   << " bytes of operations outstanding\n"; @endcode
+ */
+inline memory_statistics get_memory_statistics(execution_context& ctx)
+{
+  memory_statistics result = {};
+  if (detail::memory_metrics* m = detail::memory_metrics_service::get(ctx))
+  {
+    memory_usage* usage[detail::memory_metrics::num_kinds] =
+    {
+      &result.operations,
+      &result.awaitable_frames,
+      &result.executor_functions,
+      &result.cancellation_signals,
+      &result.parallel_groups,
+      &result.timed_cancels,
+      &result.promises,
+      &result.registered_buffers,
+      &result.ssl_buffers
+    };
+
+    result.enabled = true;
+    for (int i = 0; i < detail::memory_metrics::num_kinds; ++i)
+    {
+      detail::memory_metrics::counters c = m->get(i);
+      usage[i]->allocations = c.allocations;
+      usage[i]->cache_hits = c.cache_hits;
+      usage[i]->deallocations = c.deallocations;
+      usage[i]->bytes_allocated = c.bytes_allocated;
+      usage[i]->bytes_deallocated = c.bytes_deallocated;
+    }
+  }
+  return result;
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_MEMORY_STATISTICS_HPP
@@ -0,0 +1,35 @@
+//
+// packet_ring.hpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_PACKET_RING_HPP
+#define ASIO_PACKET_RING_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_PACKET_RING) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include "asio/basic_packet_ring.hpp"
+
+namespace asio {
+
+/// Typedef for the typical usage of a packet ring.
+typedef basic_packet_ring<> packet_ring;
+
+} // namespace asio
+
+#endif // defined(ASIO_HAS_PACKET_RING)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_PACKET_RING_HPP
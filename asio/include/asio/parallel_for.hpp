@@ -0,0 +1,176 @@
+//
+// parallel_for.hpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_PARALLEL_FOR_HPP
+#define ASIO_PARALLEL_FOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <exception>
+#include "asio/async_result.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/execution/executor.hpp"
+#include "asio/execution_context.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename Executor> class initiate_parallel_for;
+
+} // namespace detail
+
+/**
+ * @defgroup parallel_for asio::parallel_for
+ *
+ * @brief The @c parallel_for function runs a function object for each index in
+ * a range, using the threads of an executor's execution context.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to run a function for each index in a
+/// range.
+/**
+ * This function calls @c f(i) for each @c i in the range <tt>[0, n)</tt>,
+ * using as many of the threads running the executor's execution context as
+ * are available. It is an initiating function for an @ref
+ * asynchronous_operation, and always returns immediately.
+ *
+ * A single shared record of the work is allocated, and a small number of
+ * worker functions are submitted to the executor. For a thread_pool, one
+ * worker is submitted for each thread in the pool, as determined by the
+ * executor's @c execution::occupancy property. For other executors, one
+ * worker is submitted for each hardware thread. Each worker repeatedly claims
+ * the next chunk of indices using an atomic increment, so that the work is
+ * balanced between the threads without any locking, and without a separate
+ * submission for each index.
+ *
+ * @param ex The executor used to run the function object.
+ *
+ * @param n The number of indices.
+ *
+ * @param f The function object to be called. It is called as if by
+ * <tt>f(i)</tt>, where @c i is a @c std::size_t, and may be called
+ * concurrently from several threads. A decay-copy of the function object is
+ * made, which is destroyed before the completion handler is called.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the operation completes.
+ * Potential completion tokens include @ref use_future, @ref use_awaitable,
+ * @ref yield_context, or a function object with the correct completion
+ * signature. The function signature of the completion handler must be:
+ * @code void handler(
+ *   // The exception thrown by the function object, if any.
+ *   std::exception_ptr e
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the completion handler will not be invoked from within this function.
+ *
+ * @par Completion Signature
+ * @code void(std::exception_ptr) @endcode
+ *
+ * If the function object throws an exception, no further chunks are claimed,
+ * and the first exception thrown is passed to the completion handler once
+ * the chunks that are already running have finished.
+ *
+ * @par Example
+ * @code
+ * asio::thread_pool pool(8);
+ * std::vector<double> results(64);
+ * asio::parallel_for(pool.get_executor(), results.size(),
+ *     [&](std::size_t i)
+ *     {
+ *       results[i] = process(requests[i]);
+ *     },
+ *     [](std::exception_ptr e)
+ *     {
+ *       // ...
+ *     });
+ * @endcode
+ */
+template <typename Executor, typename Function,
+    ASIO_COMPLETION_TOKEN_FOR(void (std::exception_ptr)) CompletionToken
+      = default_completion_token_t<Executor>>
+inline auto parallel_for(const Executor& ex, std::size_t n, Function&& f,
+    CompletionToken&& token = default_completion_token_t<Executor>(),
+    constraint_t<
+      execution::is_executor<Executor>::value
+    > = 0)
+  -> decltype(
+    async_initiate<CompletionToken, void (std::exception_ptr)>(
+      declval<detail::initiate_parallel_for<Executor>>(),
+      token, n, static_cast<Function&&>(f)))
+{
+  return async_initiate<CompletionToken, void (std::exception_ptr)>(
+      detail::initiate_parallel_for<Executor>(ex),
+      token, n, static_cast<Function&&>(f));
+}
+
+/// Start an asynchronous operation to run a function for each index in a
+/// range.
+/**
+ * This function calls @c f(i) for each @c i in the range <tt>[0, n)</tt>,
+ * using the threads running the execution context. It is equivalent to
+ * <tt>parallel_for(ctx.get_executor(), n, f, token)</tt>.
+ *
+ * @param ctx The execution context used to run the function object.
+ *
+ * @param n The number of indices.
+ *
+ * @param f The function object to be called. It is called as if by
+ * <tt>f(i)</tt>, where @c i is a @c std::size_t, and may be called
+ * concurrently from several threads.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the operation completes.
+ * The function signature of the completion handler must be:
+ * @code void handler(
+ *   // The exception thrown by the function object, if any.
+ *   std::exception_ptr e
+ * ); @endcode
+ *
+ * @par Completion Signature
+ * @code void(std::exception_ptr) @endcode
+ */
+template <typename ExecutionContext, typename Function,
+    ASIO_COMPLETION_TOKEN_FOR(void (std::exception_ptr)) CompletionToken
+      = default_completion_token_t<typename ExecutionContext::executor_type>>
+inline auto parallel_for(ExecutionContext& ctx, std::size_t n, Function&& f,
+    CompletionToken&& token = default_completion_token_t<
+      typename ExecutionContext::executor_type>(),
+    constraint_t<
+      is_convertible<ExecutionContext&, execution_context&>::value
+    > = 0)
+  -> decltype(
+    async_initiate<CompletionToken, void (std::exception_ptr)>(
+      declval<detail::initiate_parallel_for<
+        typename ExecutionContext::executor_type>>(),
+      token, n, static_cast<Function&&>(f)))
+{
+  return async_initiate<CompletionToken, void (std::exception_ptr)>(
+      detail::initiate_parallel_for<
+        typename ExecutionContext::executor_type>(ctx.get_executor()),
+      token, n, static_cast<Function&&>(f));
+}
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/parallel_for.hpp"
+
+#endif // ASIO_PARALLEL_FOR_HPP
@@ -0,0 +1,119 @@
+//
+// pooled_allocator.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_POOLED_ALLOCATOR_HPP
+#define ASIO_POOLED_ALLOCATOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <limits>
+#include <new>
+#include "asio/buffered_stream_pool.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// An allocator that obtains memory from a buffered_stream_pool.
+/**
+ * The pooled_allocator class template allows the storage of a container to be
+ * recycled through a buffered_stream_pool. Memory is allocated in blocks whose
+ * sizes are powers of two, and a block that is deallocated is held by the pool
+ * and reused by any later allocation that rounds up to the same size.
+ *
+ * This allows the storage of objects that are repeatedly created and
+ * destroyed, such as the basic_streambuf used by each connection of a server,
+ * to be reused rather than obtained from the heap:
+ * @code asio::buffered_stream_pool pool;
+ * ...
+ * asio::basic_streambuf<asio::pooled_allocator<char>> b(
+ *     65536, asio::pooled_allocator<char>(pool)); @endcode
+ * As the streambuf grows, each larger block is taken from the pool. When the
+ * streambuf is destroyed its block is returned to the pool, and the next
+ * streambuf that grows to the same capacity reuses it.
+ *
+ * The pool must outlive every allocator that refers to it, and all memory
+ * allocated through them.
+ */
+template <typename T>
+class pooled_allocator
+{
+public:
+  /// The type of object allocated by the pooled allocator.
+  typedef T value_type;
+
+  /// Rebind the allocator to another value_type.
+  template <typename U>
+  struct rebind
+  {
+    /// The rebound @c allocator type.
+    typedef pooled_allocator<U> other;
+  };
+
+  /// Construct an allocator that obtains memory from the specified pool.
+  explicit pooled_allocator(buffered_stream_pool& pool) noexcept
+    : pool_(&pool)
+  {
+  }
+
+  /// Converting constructor.
+  template <typename U>
+  pooled_allocator(const pooled_allocator<U>& other) noexcept
+    : pool_(other.pool_)
+  {
+  }
+
+  /// Get the pool from which memory is obtained.
+  buffered_stream_pool& pool() const noexcept
+  {
+    return *pool_;
+  }
+
+  /// Equality operator. Returns true if both allocators use the same pool.
+  bool operator==(const pooled_allocator& other) const noexcept
+  {
+    return pool_ == other.pool_;
+  }
+
+  /// Inequality operator.
+  bool operator!=(const pooled_allocator& other) const noexcept
+  {
+    return pool_ != other.pool_;
+  }
+
+  /// Allocate memory for the specified number of values.
+  T* allocate(std::size_t n)
+  {
+    if (n > (std::numeric_limits<std::size_t>::max)() / sizeof(T))
+      throw std::bad_alloc();
+    return static_cast<T*>(pool_->allocate(n * sizeof(T)));
+  }
+
+  /// Deallocate memory for the specified number of values.
+  void deallocate(T* p, std::size_t n)
+  {
+    pool_->deallocate(p, n * sizeof(T));
+  }
+
+private:
+  template <typename> friend class pooled_allocator;
+
+  buffered_stream_pool* pool_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_POOLED_ALLOCATOR_HPP
@@ -0,0 +1,102 @@
+//
+// post_batch.hpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_POST_BATCH_HPP
+#define ASIO_POST_BATCH_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/execution/executor.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/is_executor.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/**
+ * @defgroup post_batch asio::post_batch
+ *
+ * @brief Submits a range of function objects for execution, without waiting
+ * for any of them to complete.
+ */
+/*@{*/
+
+/// Submits a range of function objects for execution on the specified
+/// executor.
+/**
+ * This function submits each function object in the range for execution on
+ * the specified executor. None of the function objects will be executed
+ * inside @c post_batch().
+ *
+ * The function objects are executed as if by
+ * @code asio::require(ex, execution::blocking.never).execute(std::move(f)); @endcode
+ * Unlike @c post, the function objects' associated executors are not used.
+ *
+ * When the executor is an io_context or thread_pool executor, the function
+ * objects are added to the execution context's queue together, using a single
+ * lock acquisition, and up to one idle thread is woken for each of them. This
+ * makes @c post_batch much cheaper than calling @c post for each function
+ * object when fanning out work, such as broadcasting a message to many
+ * subscribers. For other executors, each function object is submitted in
+ * turn.
+ *
+ * @param ex The target executor.
+ *
+ * @param fs A range of function objects, each of which is called as if by
+ * <tt>f()</tt>. The function objects are moved from, unless the range is
+ * const, in which case they are copied.
+ *
+ * @par Example
+ * @code std::vector<std::function<void()>> handlers;
+ * for (auto& s : subscribers)
+ *   handlers.emplace_back([&s, msg]{ s.deliver(msg); });
+ * asio::post_batch(pool.get_executor(), handlers); @endcode
+ */
+template <typename Executor, typename Range>
+void post_batch(const Executor& ex, Range&& fs,
+    constraint_t<
+      execution::is_executor<Executor>::value || is_executor<Executor>::value
+    > = 0);
+
+/// Submits a range of function objects for execution on the specified
+/// execution context.
+/**
+ * This function submits each function object in the range for execution on
+ * the specified execution context. None of the function objects will be
+ * executed inside @c post_batch().
+ *
+ * @param ctx An execution context, from which the target executor is obtained.
+ *
+ * @param fs A range of function objects, each of which is called as if by
+ * <tt>f()</tt>. The function objects are moved from, unless the range is
+ * const, in which case they are copied.
+ *
+ * @returns <tt>post_batch(ctx.get_executor(), fs)</tt>.
+ */
+template <typename ExecutionContext, typename Range>
+void post_batch(ExecutionContext& ctx, Range&& fs,
+    constraint_t<
+      is_convertible<ExecutionContext&, execution_context&>::value
+    > = 0);
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/post_batch.hpp"
+
+#endif // ASIO_POST_BATCH_HPP
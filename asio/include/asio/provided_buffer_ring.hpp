@@ -0,0 +1,231 @@
+//
+// provided_buffer_ring.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_PROVIDED_BUFFER_RING_HPP
+#define ASIO_PROVIDED_BUFFER_RING_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_PROVIDED_BUFFER_RING) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include <vector>
+#include "asio/buffer.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/execution/context.hpp"
+#include "asio/execution/executor.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/is_executor.hpp"
+#include "asio/query.hpp"
+
+#if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+# include <liburing.h>
+#endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+#if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+class io_uring_service;
+#endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
+} // namespace detail
+
+/// A fixed-size pool of equally sized buffers that is lent to receive
+/// operations only when data arrives.
+/**
+ * A provided buffer ring is used with operations such as
+ * basic_stream_socket::async_receive_multishot(). Rather than supplying a
+ * buffer when the operation is started, the operation selects a free buffer
+ * from the ring at the point that data is received, and reports the
+ * selected buffer's identifier to the completion handler. Once the
+ * application has finished with the data it must return the buffer to the
+ * ring by calling recycle().
+ *
+ * When the io_uring backend is in use, the ring is registered with the kernel
+ * (IORING_REGISTER_PBUF_RING) and buffer selection is performed by the kernel.
+ * Other backends select from the ring once the socket is ready to read.
+ *
+ * The ring must outlive all operations that use it. Each ring registered with
+ * an execution context must have a distinct group identifier.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ */
+class provided_buffer_ring
+  : private detail::noncopyable
+{
+public:
+  /// Create a ring of buffers for an executor's execution context.
+  /**
+   * @param ex The executor whose execution context the ring is used with.
+   *
+   * @param buffer_count The number of buffers in the ring. Must be between 1
+   * and 32768.
+   *
+   * @param buffer_size The size of each buffer, in bytes.
+   *
+   * @param group_id The identifier of the buffer group.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename Executor>
+  provided_buffer_ring(const Executor& ex, std::size_t buffer_count,
+      std::size_t buffer_size, int group_id = 0,
+      constraint_t<
+        is_executor<Executor>::value || execution::is_executor<Executor>::value
+      > = 0)
+  {
+    init(provided_buffer_ring::get_context(ex),
+        buffer_count, buffer_size, group_id);
+  }
+
+  /// Create a ring of buffers for an execution context.
+  /**
+   * @param ctx The execution context the ring is used with.
+   *
+   * @param buffer_count The number of buffers in the ring. Must be between 1
+   * and 32768.
+   *
+   * @param buffer_size The size of each buffer, in bytes.
+   *
+   * @param group_id The identifier of the buffer group.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename ExecutionContext>
+  provided_buffer_ring(ExecutionContext& ctx, std::size_t buffer_count,
+      std::size_t buffer_size, int group_id = 0,
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      > = 0)
+  {
+    init(ctx, buffer_count, buffer_size, group_id);
+  }
+
+  /// Destroys the ring, unregistering it if required.
+  ASIO_DECL ~provided_buffer_ring();
+
+  /// Get the number of buffers in the ring.
+  std::size_t buffer_count() const noexcept
+  {
+    return buffer_count_;
+  }
+
+  /// Get the size of each buffer in the ring.
+  std::size_t buffer_size() const noexcept
+  {
+    return buffer_size_;
+  }
+
+  /// Get the identifier of the buffer group.
+  int group_id() const noexcept
+  {
+    return group_id_;
+  }
+
+  /// Get the buffer with the specified identifier.
+  mutable_buffer buffer(std::size_t id) const noexcept
+  {
+    return mutable_buffer(storage_ + id * buffer_size_, buffer_size_);
+  }
+
+  /// Get the first @c n bytes of the buffer with the specified identifier.
+  /**
+   * This is typically used with the number of bytes received, as reported to
+   * the completion handler of a receive operation.
+   */
+  mutable_buffer buffer(std::size_t id, std::size_t n) const noexcept
+  {
+    return mutable_buffer(storage_ + id * buffer_size_,
+        n < buffer_size_ ? n : buffer_size_);
+  }
+
+  /// Return a buffer to the ring so that it may be used again.
+  ASIO_DECL void recycle(std::size_t id);
+
+#if !defined(GENERATING_DOCUMENTATION)
+  // Take a free buffer from the ring. Used by the reactor-based backends.
+  ASIO_DECL bool acquire(std::size_t& id);
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+private:
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      enable_if_t<execution::is_executor<T>::value>* = 0)
+  {
+    return asio::query(t, execution::context);
+  }
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      enable_if_t<!execution::is_executor<T>::value>* = 0)
+  {
+    return t.context();
+  }
+
+  // Allocate the buffers and register the ring.
+  ASIO_DECL void init(execution_context& ctx, std::size_t buffer_count,
+      std::size_t buffer_size, int group_id);
+
+  // Protects the ring's free list.
+  detail::mutex mutex_;
+
+  // The memory that backs all buffers in the ring.
+  unsigned char* storage_;
+
+  // The number of buffers in the ring.
+  std::size_t buffer_count_;
+
+  // The size of each buffer.
+  std::size_t buffer_size_;
+
+  // The identifier of the buffer group.
+  int group_id_;
+
+#if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  // The service with which the ring is registered.
+  detail::io_uring_service* service_;
+
+  // The ring shared with the kernel.
+  ::io_uring_buf_ring* buf_ring_;
+
+  // The number of entries in the kernel ring.
+  unsigned entries_;
+#else // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  // The identifiers of buffers that are not currently in use.
+  std::vector<std::size_t> free_buffers_;
+#endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/impl/provided_buffer_ring.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_PROVIDED_BUFFER_RING_HPP
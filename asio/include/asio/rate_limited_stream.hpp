@@ -0,0 +1,340 @@
+//
+// rate_limited_stream.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_RATE_LIMITED_STREAM_HPP
+#define ASIO_RATE_LIMITED_STREAM_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/async_result.hpp"
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/buffer.hpp"
+#include "asio/buffers_prefix.hpp"
+#include "asio/compose.hpp"
+#include "asio/error.hpp"
+#include "asio/rate_limiter.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Adds rate limiting to the writes performed on a stream.
+/**
+ * The rate_limited_stream class template paces the writes performed on the
+ * next layer using a rate_limiter, which may be shared by several streams to
+ * limit their combined rate. Each write reserves up to the limiter's burst size
+ * of bytes, waits on a timer until the reservation may be sent, and writes no
+ * more than the reserved bytes to the next layer. Bytes that the next layer
+ * does not accept are returned to the limiter.
+ *
+ * Reads are passed through to the next layer without limit.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * Limiting the combined rate of several replication connections:
+ * @code
+ * asio::rate_limiter limiter(50 * 1024 * 1024, 256 * 1024);
+ * asio::rate_limited_stream<asio::ip::tcp::socket> stream1(my_context, limiter);
+ * asio::rate_limited_stream<asio::ip::tcp::socket> stream2(my_context, limiter);
+ * ...
+ * asio::async_write(stream1, data1, handler1);
+ * asio::async_write(stream2, data2, handler2);
+ * @endcode
+ *
+ * @par Concepts:
+ * AsyncReadStream, AsyncWriteStream, Stream, SyncReadStream, SyncWriteStream.
+ */
+template <typename Stream>
+class rate_limited_stream
+  : private noncopyable
+{
+private:
+  template <typename ConstBufferSequence> class write_some_op;
+
+public:
+  /// The type of the next layer.
+  typedef remove_reference_t<Stream> next_layer_type;
+
+  /// The type of the lowest layer.
+  typedef typename next_layer_type::lowest_layer_type lowest_layer_type;
+
+  /// The type of the executor associated with the object.
+  typedef typename lowest_layer_type::executor_type executor_type;
+
+private:
+  // The timer type used to wait for reservations.
+  typedef basic_waitable_timer<rate_limiter::clock_type,
+      wait_traits<rate_limiter::clock_type>, executor_type> timer_type;
+
+public:
+  /// Construct, passing the specified argument to initialise the next layer.
+  /**
+   * @param a The argument used to initialise the next layer.
+   *
+   * @param limiter The limiter used to pace writes. The limiter must outlive
+   * the stream.
+   */
+  template <typename Arg>
+  rate_limited_stream(Arg&& a, rate_limiter& limiter)
+    : next_layer_(static_cast<Arg&&>(a)),
+      limiter_(limiter),
+      timer_(next_layer_.lowest_layer().get_executor())
+  {
+  }
+
+  /// Get a reference to the next layer.
+  next_layer_type& next_layer()
+  {
+    return next_layer_;
+  }
+
+  /// Get a reference to the lowest layer.
+  lowest_layer_type& lowest_layer()
+  {
+    return next_layer_.lowest_layer();
+  }
+
+  /// Get a const reference to the lowest layer.
+  const lowest_layer_type& lowest_layer() const
+  {
+    return next_layer_.lowest_layer();
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() noexcept
+  {
+    return next_layer_.lowest_layer().get_executor();
+  }
+
+  /// Get the limiter used to pace writes.
+  rate_limiter& limiter() noexcept
+  {
+    return limiter_;
+  }
+
+  /// Close the stream.
+  void close()
+  {
+    next_layer_.close();
+  }
+
+  /// Close the stream.
+  ASIO_SYNC_OP_VOID close(asio::error_code& ec)
+  {
+    next_layer_.close(ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Write the given data to the stream, blocking until the limiter allows it
+  /// to be sent. Returns the number of bytes written. Throws an exception on
+  /// failure.
+  template <typename ConstBufferSequence>
+  std::size_t write_some(const ConstBufferSequence& buffers)
+  {
+    asio::error_code ec;
+    std::size_t n = write_some(buffers, ec);
+    asio::detail::throw_error(ec, "write_some");
+    return n;
+  }
+
+  /// Write the given data to the stream, blocking until the limiter allows it
+  /// to be sent. Returns the number of bytes written, or 0 if an error
+  /// occurred.
+  template <typename ConstBufferSequence>
+  std::size_t write_some(const ConstBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    std::size_t reserved = reservation_size(buffers);
+    if (reserved == 0)
+      return next_layer_.write_some(buffers, ec);
+
+    timer_.expires_at(limiter_.reserve(reserved));
+    timer_.wait(ec);
+    if (ec)
+    {
+      limiter_.refund(reserved);
+      return 0;
+    }
+
+    std::size_t n = next_layer_.write_some(
+        asio::buffers_prefix(reserved, buffers), ec);
+    limiter_.refund(reserved - n);
+    return n;
+  }
+
+  /// Start an asynchronous write. The data being written must be valid for the
+  /// lifetime of the asynchronous operation.
+  /**
+   * The write waits until the limiter allows the data to be sent, and writes
+   * no more than the limiter's burst size of bytes.
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * if they are also supported by the @c Stream type's @c async_write_some
+   * operation.
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler = default_completion_token_t<executor_type>>
+  auto async_write_some(const ConstBufferSequence& buffers,
+      WriteHandler&& handler = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_compose<WriteHandler, void (asio::error_code, std::size_t)>(
+        declval<write_some_op<ConstBufferSequence>>(),
+        handler, declval<timer_type&>()))
+  {
+    return async_compose<WriteHandler, void (asio::error_code, std::size_t)>(
+        write_some_op<ConstBufferSequence>(this, buffers), handler, timer_);
+  }
+
+  /// Read some data from the stream. Returns the number of bytes read. Throws
+  /// an exception on failure.
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers)
+  {
+    return next_layer_.read_some(buffers);
+  }
+
+  /// Read some data from the stream. Returns the number of bytes read or 0 if
+  /// an error occurred.
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    return next_layer_.read_some(buffers, ec);
+  }
+
+  /// Start an asynchronous read. The buffer into which the data will be read
+  /// must be valid for the lifetime of the asynchronous operation.
+  /**
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler = default_completion_token_t<executor_type>>
+  auto async_read_some(const MutableBufferSequence& buffers,
+      ReadHandler&& handler = default_completion_token_t<executor_type>())
+    -> decltype(
+      declval<conditional_t<true, Stream&, ReadHandler>>().async_read_some(
+        buffers, static_cast<ReadHandler&&>(handler)))
+  {
+    return next_layer_.async_read_some(buffers,
+        static_cast<ReadHandler&&>(handler));
+  }
+
+private:
+  // Get the number of bytes to reserve for a write of the given data.
+  template <typename ConstBufferSequence>
+  std::size_t reservation_size(const ConstBufferSequence& buffers) const
+  {
+    std::size_t size = asio::buffer_size(buffers);
+    std::size_t burst_size = limiter_.burst_size();
+    return size < burst_size ? size : burst_size;
+  }
+
+  // Waits on the timer until the reservation may be sent, and then writes the
+  // reserved bytes to the next layer.
+  template <typename ConstBufferSequence>
+  class write_some_op
+  {
+  public:
+    write_some_op(rate_limited_stream* stream,
+        const ConstBufferSequence& buffers)
+      : stream_(stream),
+        buffers_(buffers),
+        reserved_(0),
+        state_(starting)
+    {
+    }
+
+    template <typename Self>
+    void operator()(Self& self,
+        asio::error_code ec = asio::error_code(), std::size_t n = 0)
+    {
+      switch (state_)
+      {
+      case starting:
+        reserved_ = stream_->reservation_size(buffers_);
+        if (reserved_ == 0)
+        {
+          state_ = writing;
+          stream_->next_layer_.async_write_some(
+              buffers_, static_cast<Self&&>(self));
+          return;
+        }
+        state_ = waiting;
+        stream_->timer_.expires_at(stream_->limiter_.reserve(reserved_));
+        stream_->timer_.async_wait(static_cast<Self&&>(self));
+        return;
+
+      case waiting:
+        if (ec)
+        {
+          stream_->limiter_.refund(reserved_);
+          self.complete(ec, 0);
+          return;
+        }
+        state_ = writing;
+        stream_->next_layer_.async_write_some(
+            asio::buffers_prefix(reserved_, buffers_),
+            static_cast<Self&&>(self));
+        return;
+
+      default:
+        stream_->limiter_.refund(reserved_ - n);
+        self.complete(ec, n);
+        return;
+      }
+    }
+
+  private:
+    enum state { starting, waiting, writing };
+
+    rate_limited_stream* stream_;
+    ConstBufferSequence buffers_;
+    std::size_t reserved_;
+    state state_;
+  };
+
+  /// The next layer.
+  Stream next_layer_;
+
+  // The limiter used to pace writes.
+  rate_limiter& limiter_;
+
+  // The timer used to wait for reservations.
+  timer_type timer_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_RATE_LIMITED_STREAM_HPP
@@ -0,0 +1,184 @@
+//
+// rate_limiter.hpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_RATE_LIMITER_HPP
+#define ASIO_RATE_LIMITER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A token bucket that limits the rate at which data is sent.
+/**
+ * The rate_limiter class paces the data sent by one or more sockets, so that
+ * their combined rate does not exceed a configured number of bytes per second.
+ * Up to a burst size of bytes may be sent without delay after the limiter has
+ * been idle.
+ *
+ * A sender calls reserve() with the number of bytes it is about to send, and
+ * waits on a timer until the returned time before sending them. Waiting on a
+ * timer lets the io_context run other work in the meantime, and the send
+ * times are calculated from a single schedule rather than accumulated from
+ * successive sleeps, so that timer lateness does not reduce the rate.
+ *
+ * Stream sockets are most easily paced by wrapping them in a
+ * rate_limited_stream, which performs the reservation and wait for each
+ * write. Where only a per-socket limit is required, the kernel may pace the
+ * socket itself using socket_base::max_pacing_rate.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ *
+ * @par Example
+ * Pacing the datagrams sent by a UDP socket:
+ * @code
+ * asio::rate_limiter limiter(1024 * 1024, 64 * 1024);
+ * asio::steady_timer timer(my_context);
+ * ...
+ * timer.expires_at(limiter.reserve(asio::buffer_size(datagram)));
+ * timer.async_wait(
+ *     [&](asio::error_code ec)
+ *     {
+ *       if (!ec)
+ *         socket.async_send_to(datagram, destination, handler);
+ *     });
+ * @endcode
+ */
+class rate_limiter
+  : private detail::noncopyable
+{
+public:
+  /// The clock type used to schedule sends.
+  typedef chrono::steady_clock clock_type;
+
+  /// Construct with the specified rate and burst size.
+  /**
+   * @param rate The rate, in bytes per second, at which data may be sent. A
+   * rate of zero disables the limit.
+   *
+   * @param burst_size The number of bytes that may be sent without delay
+   * after the limiter has been idle.
+   */
+  rate_limiter(std::size_t rate, std::size_t burst_size)
+    : rate_(rate),
+      burst_size_(burst_size == 0 ? 1 : burst_size),
+      tat_(clock_type::now())
+  {
+  }
+
+  /// Get the rate, in bytes per second, at which data may be sent.
+  std::size_t rate() const
+  {
+    detail::mutex::scoped_lock lock(mutex_);
+    return rate_;
+  }
+
+  /// Get the number of bytes that may be sent without delay.
+  std::size_t burst_size() const
+  {
+    detail::mutex::scoped_lock lock(mutex_);
+    return burst_size_;
+  }
+
+  /// Change the rate and burst size.
+  /**
+   * The new values apply to subsequent reservations. Reservations that have
+   * already been made are not affected.
+   *
+   * @param rate The rate, in bytes per second, at which data may be sent. A
+   * rate of zero disables the limit.
+   *
+   * @param burst_size The number of bytes that may be sent without delay
+   * after the limiter has been idle.
+   */
+  void set_rate(std::size_t rate, std::size_t burst_size)
+  {
+    detail::mutex::scoped_lock lock(mutex_);
+    rate_ = rate;
+    burst_size_ = burst_size == 0 ? 1 : burst_size;
+  }
+
+  /// Reserve the right to send the specified number of bytes.
+  /**
+   * @param n The number of bytes to be sent.
+   *
+   * @returns The time at which the bytes may be sent. The time is not earlier
+   * than the current time. A reservation for more than burst_size() bytes is
+   * delayed by the time taken to send the excess at the configured rate.
+   */
+  clock_type::time_point reserve(std::size_t n)
+  {
+    clock_type::time_point now = clock_type::now();
+    detail::mutex::scoped_lock lock(mutex_);
+    if (rate_ == 0)
+      return now;
+
+    // The theoretical arrival time of the next byte may not fall behind the
+    // current time, as unused capacity is limited to the burst size.
+    if (tat_ < now)
+      tat_ = now;
+    tat_ += duration_of(n);
+    clock_type::time_point ready = tat_ - duration_of(burst_size_);
+    return ready < now ? now : ready;
+  }
+
+  /// Return part of a reservation that was not used.
+  /**
+   * Call this function when fewer bytes were sent than were reserved, so that
+   * the unused capacity is available to subsequent reservations.
+   *
+   * @param n The number of reserved bytes that were not sent.
+   */
+  void refund(std::size_t n)
+  {
+    detail::mutex::scoped_lock lock(mutex_);
+    if (rate_ != 0)
+      tat_ -= duration_of(n);
+  }
+
+private:
+  // Get the time taken to send the specified number of bytes at the
+  // configured rate.
+  clock_type::duration duration_of(std::size_t n) const
+  {
+    return chrono::duration_cast<clock_type::duration>(
+        chrono::duration<double>(static_cast<double>(n) / rate_));
+  }
+
+  // Mutex to protect access to the internal data.
+  mutable detail::mutex mutex_;
+
+  // The rate, in bytes per second.
+  std::size_t rate_;
+
+  // The number of bytes that may be sent without delay.
+  std::size_t burst_size_;
+
+  // The theoretical arrival time, at which all reserved bytes will have been
+  // sent at the configured rate.
+  clock_type::time_point tat_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_RATE_LIMITER_HPP
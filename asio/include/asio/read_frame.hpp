@@ -0,0 +1,156 @@
+//
+// read_frame.hpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_READ_FRAME_HPP
+#define ASIO_READ_FRAME_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <chrono>
+#include <cstddef>
+#include "asio/async_result.hpp"
+#include "asio/buffer.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename> class initiate_async_read_frame;
+
+} // namespace detail
+
+/**
+ * @defgroup async_read_frame asio::async_read_frame
+ *
+ * @brief The @c async_read_frame function is a composed asynchronous operation
+ * that reads a frame of data, delimited by a gap in the incoming data, from a
+ * stream.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to read a frame of data from a stream.
+/**
+ * This function is used to asynchronously read a frame of data from a stream,
+ * where the end of a frame is indicated by a period in which no data arrives.
+ * This is how many serial protocols, such as Modbus RTU, delimit messages. It
+ * is an initiating function for an @ref asynchronous_operation, and always
+ * returns immediately. The asynchronous operation will continue until one of
+ * the following conditions is true:
+ *
+ * @li At least one byte has been read, and then no more data arrives within
+ * the specified gap.
+ *
+ * @li The supplied buffers are full. That is, the bytes transferred is equal to
+ * the sum of the buffer sizes.
+ *
+ * @li An error occurred.
+ *
+ * The operation waits for the first byte of a frame without a time limit. Once
+ * data has arrived it sleeps for the specified gap and then reads whatever has
+ * arrived in the meantime, so that a frame is received with at most one wakeup
+ * per gap rather than one per byte.
+ *
+ * This operation is implemented in terms of one or more calls to the stream's
+ * async_read_some and available functions, and is known as a <em>composed
+ * operation</em>. The program must ensure that the stream performs no other
+ * read operations until this operation completes.
+ *
+ * @param s The stream from which the data is to be read. The type must support
+ * the AsyncReadStream concept, and provide a member function
+ * <tt>std::size_t available(asio::error_code&)</tt>, as
+ * asio::basic_serial_port and asio::basic_stream_socket do.
+ *
+ * @param buffers One or more buffers into which the data will be read. The sum
+ * of the buffer sizes indicates the maximum size of a frame. Although the
+ * buffers object may be copied as necessary, ownership of the underlying
+ * memory blocks is retained by the caller, which must guarantee that they
+ * remain valid until the completion handler is called.
+ *
+ * @param gap The period without data that marks the end of a frame.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the read completes.
+ * Potential completion tokens include @ref use_future, @ref use_awaitable,
+ * @ref yield_context, or a function object with the correct completion
+ * signature. The function signature of the completion handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const asio::error_code& error,
+ *
+ *   // Number of bytes copied into the buffers. If an error
+ *   // occurred, this will be the number of bytes successfully
+ *   // transferred prior to the error.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the completion handler will not be invoked from within this function.
+ * On immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::async_immediate().
+ *
+ * @par Completion Signature
+ * @code void(asio::error_code, std::size_t) @endcode
+ *
+ * @par Example
+ * @code
+ * asio::async_read_frame(port, asio::buffer(frame),
+ *     std::chrono::milliseconds(4),
+ *     [](asio::error_code ec, std::size_t n)
+ *     {
+ *       // ...
+ *     });
+ * @endcode
+ *
+ * @par Per-Operation Cancellation
+ * This asynchronous operation supports cancellation for the following
+ * asio::cancellation_type values:
+ *
+ * @li @c cancellation_type::terminal
+ *
+ * if it is also supported by the @c AsyncReadStream type's
+ * @c async_read_some operation.
+ */
+template <typename AsyncReadStream, typename MutableBufferSequence,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) ReadToken = default_completion_token_t<
+        typename AsyncReadStream::executor_type>>
+inline auto async_read_frame(AsyncReadStream& s,
+    const MutableBufferSequence& buffers,
+    const std::chrono::steady_clock::duration& gap,
+    ReadToken&& token = default_completion_token_t<
+      typename AsyncReadStream::executor_type>(),
+    constraint_t<
+      is_mutable_buffer_sequence<MutableBufferSequence>::value
+    > = 0)
+  -> decltype(
+    async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        declval<detail::initiate_async_read_frame<AsyncReadStream>>(),
+        token, buffers, gap))
+{
+  return async_initiate<ReadToken,
+    void (asio::error_code, std::size_t)>(
+      detail::initiate_async_read_frame<AsyncReadStream>(s),
+      token, buffers, gap);
+}
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/read_frame.hpp"
+
+#endif // ASIO_READ_FRAME_HPP
@@ -0,0 +1,140 @@
+//
+// read_ranges_at.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_READ_RANGES_AT_HPP
+#define ASIO_READ_RANGES_AT_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_FILE) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include "asio/async_result.hpp"
+#include "asio/compose.hpp"
+#include "asio/error.hpp"
+#include "asio/file_base.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename AsyncRandomAccessReadDevice> class read_ranges_at_op;
+
+} // namespace detail
+
+/**
+ * @defgroup async_read_ranges_at asio::async_read_ranges_at
+ *
+ * @brief The @c async_read_ranges_at function is a composed asynchronous
+ * operation that reads many ranges of a device at once.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to read many ranges at specified offsets.
+/**
+ * This function is used to asynchronously read a number of ranges, each from
+ * its own offset. It is an initiating function for an @ref
+ * asynchronous_operation, and always returns immediately.
+ *
+ * As for async_read_at(), each range is read until its buffer is full or an
+ * error occurs. Ranges that are adjacent both in the device and in memory,
+ * such as consecutive chunks of a file read into one block of memory, are
+ * merged and read as one. If the device provides an @c async_read_batch_at
+ * member function, as basic_random_access_file does, the outstanding reads
+ * are started together as a single batch, which on io_uring is submitted to
+ * the kernel in one system call. Otherwise, they are read one after another
+ * using the device's @c async_read_some_at function.
+ *
+ * @param d The device from which the data is to be read. The type must
+ * support the AsyncRandomAccessReadDevice concept.
+ *
+ * @param requests A pointer to an array of read requests, in any order. Each
+ * request's @c error and @c bytes_transferred members are set to the result
+ * of reading its range. Ownership of the requests and of the buffers they
+ * refer to is retained by the caller, which must guarantee that they remain
+ * valid until the completion handler is called.
+ *
+ * @param count The number of requests in the array.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the reads complete.
+ * Potential completion tokens include @ref use_future, @ref use_awaitable,
+ * @ref yield_context, or a function object with the correct completion
+ * signature. The function signature of the completion handler must be:
+ * @code void handler(
+ *   // The error of the first request that failed, if any.
+ *   const asio::error_code& error,
+ *
+ *   // The total number of bytes read by all requests.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the completion handler will not be invoked from within this function.
+ * On immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::async_immediate().
+ *
+ * @par Completion Signature
+ * @code void(asio::error_code, std::size_t) @endcode
+ *
+ * @par Example
+ * @code
+ * std::vector<char> chunks(total_size);
+ * std::vector<asio::file_base::read_request> requests;
+ * for (const column_chunk& c : columns)
+ *   requests.emplace_back(c.offset,
+ *       asio::buffer(chunks.data() + c.position, c.size));
+ * asio::async_read_ranges_at(file, requests.data(), requests.size(), handler);
+ * @endcode
+ *
+ * @par Per-Operation Cancellation
+ * This asynchronous operation supports cancellation for the following
+ * asio::cancellation_type values:
+ *
+ * @li @c cancellation_type::terminal
+ *
+ * if it is also supported by the device's @c async_read_batch_at or
+ * @c async_read_some_at operation.
+ */
+template <typename AsyncRandomAccessReadDevice,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) ReadToken = default_completion_token_t<
+        typename AsyncRandomAccessReadDevice::executor_type>>
+inline auto async_read_ranges_at(AsyncRandomAccessReadDevice& d,
+    file_base::read_request* requests, std::size_t count,
+    ReadToken&& token = default_completion_token_t<
+      typename AsyncRandomAccessReadDevice::executor_type>())
+  -> decltype(
+    async_compose<ReadToken, void (asio::error_code, std::size_t)>(
+      declval<detail::read_ranges_at_op<AsyncRandomAccessReadDevice>>(),
+      token, d))
+{
+  return async_compose<ReadToken, void (asio::error_code, std::size_t)>(
+      detail::read_ranges_at_op<AsyncRandomAccessReadDevice>(
+        d, requests, count), token, d);
+}
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/read_ranges_at.hpp"
+
+#endif // defined(ASIO_HAS_FILE)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_READ_RANGES_AT_HPP
@@ -0,0 +1,35 @@
+//
+// readiness_set.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_READINESS_SET_HPP
+#define ASIO_READINESS_SET_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_READINESS_SET) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include "asio/basic_readiness_set.hpp"
+
+namespace asio {
+
+/// Typedef for the typical usage of a readiness set.
+typedef basic_readiness_set<> readiness_set;
+
+} // namespace asio
+
+#endif // defined(ASIO_HAS_READINESS_SET)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_READINESS_SET_HPP
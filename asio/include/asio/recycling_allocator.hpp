@@ -27,6 +27,30 @@ namespace asio {
  * The @recycling_allocator uses a simple strategy where a limited number of
  * small memory blocks are cached in thread-local storage, if the current
  * thread is running an @c io_context or is part of a @c thread_pool.
+ *
+ * By default, up to two blocks of any small size are cached (this number may
+ * be changed by defining @c ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE). When
+ * @c ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES is defined, the cache instead
+ * keeps a free list for each power-of-two size class from 32 bytes up to
+ * @c ASIO_RECYCLING_ALLOCATOR_MAX_SIZE_CLASS (default 4096), each holding up
+ * to @c ASIO_RECYCLING_ALLOCATOR_SIZE_CLASS_DEPTH (default 16) blocks. The
+ * size-class cache also serves the memory used for completion handlers,
+ * coroutine frames and type-erased function objects.
+ *
+ * Both caches maintain usage statistics for each thread, which may be
+ * obtained by calling asio::get_recycling_allocator_statistics(). Statistics
+ * for all threads running an execution context, divided by the purpose of the
+ * memory, may be obtained by calling asio::get_memory_statistics().
+ *
+ * Defining @c ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE enables the size-class
+ * cache and returns blocks that are released by a thread other than the one
+ * that allocated them to the allocating thread. Such blocks are otherwise
+ * kept by the releasing thread, or returned to the system allocator when its
+ * cache is full, and so a thread that allocates blocks for consumption by
+ * other threads finds its own cache empty. Returned blocks are collected by
+ * the allocating thread, without locking, when an allocation misses its
+ * cache. Each block is enlarged by the size of a pointer, which identifies
+ * the allocating thread.
  */
 template <typename T>
 class recycling_allocator
@@ -131,6 +155,71 @@ public:
   }
 };
 
+/// Usage statistics for the recycling cache of the calling thread.
+struct recycling_allocator_statistics
+{
+  /// The number of blocks allocated.
+  std::size_t allocations;
+
+  /// The number of allocations that were satisfied from the cache.
+  std::size_t cache_hits;
+
+  /// The number of blocks deallocated.
+  std::size_t deallocations;
+
+  /// The total size, in bytes, requested by the allocations.
+  std::size_t bytes_allocated;
+
+  /// The total size, in bytes, of the deallocated blocks.
+  std::size_t bytes_deallocated;
+
+  /// The number of deallocated blocks that were returned to the system
+  /// allocator, rather than cached, because the cache was full.
+  std::size_t cache_releases;
+
+  /// The number of deallocated blocks that were returned to the thread that
+  /// allocated them.
+  std::size_t remote_releases;
+
+  /// The number of blocks that other threads returned to this thread's cache.
+  std::size_t remote_returns;
+
+  /// The number of blocks currently held in the cache.
+  std::size_t cached_blocks;
+
+  /// The total size, in bytes, of the blocks currently held in the cache.
+  std::size_t cached_bytes;
+};
+
+/// Obtain the usage statistics for the calling thread's recycling cache.
+/**
+ * Statistics cover the memory allocated while the calling thread runs an
+ * @c io_context or is part of a @c thread_pool. At other times all values are
+ * zero. The numbers of cached blocks and bytes, and of blocks returned between
+ * threads, are maintained only by the size-class cache, which is enabled by
+ * defining @c ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES.
+ */
+inline recycling_allocator_statistics get_recycling_allocator_statistics()
+{
+  recycling_allocator_statistics result = {};
+  if (detail::thread_info_base* this_thread
+      = detail::thread_context::top_of_thread_call_stack())
+  {
+    detail::recycling_cache_statistics s = this_thread->statistics();
+    result.allocations = s.allocations;
+    result.cache_hits = s.cache_hits;
+    result.deallocations = s.deallocations;
+    result.bytes_allocated = s.bytes_allocated;
+    result.bytes_deallocated = s.bytes_deallocated;
+    result.cache_releases = s.cache_releases;
+    result.remote_releases = s.remote_releases;
+    result.remote_returns = s.remote_returns;
+    result.cached_blocks = s.cached_blocks;
+    result.cached_bytes = s.cached_bytes;
+  }
+  return result;
+}
+
 } // namespace asio
 
 #include "asio/detail/pop_options.hpp"
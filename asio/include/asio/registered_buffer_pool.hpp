@@ -0,0 +1,273 @@
+//
+// registered_buffer_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_REGISTERED_BUFFER_POOL_HPP
+#define ASIO_REGISTERED_BUFFER_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <vector>
+#include "asio/buffer_registration.hpp"
+#include "asio/detail/memory_metrics.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/error_code.hpp"
+#include "asio/execution/context.hpp"
+#include "asio/execution/executor.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/is_executor.hpp"
+#include "asio/query.hpp"
+#include "asio/registered_buffer.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+#if defined(ASIO_HAS_IO_URING)
+class io_uring_service;
+#endif // defined(ASIO_HAS_IO_URING)
+
+} // namespace detail
+
+/// A pool of equally sized buffers that are registered with an execution
+/// context.
+/**
+ * A registered buffer pool allocates a single slab of memory, divides it into
+ * equally sized blocks, and registers each block with the execution context.
+ * Blocks are lent to the application by acquire() and returned by release().
+ *
+ * The buffers returned by acquire() are mutable_registered_buffer objects, and
+ * so may be passed directly to basic_stream_socket::async_read_some(),
+ * basic_stream_socket::async_write_some() and the other read and write
+ * operations. When the io_uring backend is in use these operations perform
+ * fixed-buffer I/O, avoiding the cost of mapping the buffer into the kernel
+ * for each operation. Other backends perform ordinary I/O on the same memory,
+ * so that a program has a single code path on all platforms.
+ *
+ * Free blocks are held on a number of free lists, one for each hardware
+ * thread. A thread acquires from and releases to the list selected by its
+ * thread identifier, and takes blocks from the other lists only when its own
+ * list is empty.
+ *
+ * The pool must outlive all operations that use its buffers. For portability,
+ * applications should assume that only one pool or buffer_registration is
+ * permitted per execution context.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ *
+ * @par Example
+ * @code
+ * asio::registered_buffer_pool pool(my_io_context, 1024, 16384);
+ *
+ * asio::mutable_registered_buffer b = pool.acquire();
+ * my_socket.async_read_some(b,
+ *     [&pool, b](asio::error_code ec, std::size_t n)
+ *     {
+ *       // ... process the first n bytes of b ...
+ *       pool.release(b);
+ *     });
+ * @endcode
+ */
+class registered_buffer_pool
+  : detail::buffer_registration_base,
+    private detail::noncopyable
+{
+public:
+  /// Create a pool of buffers for an executor's execution context.
+  /**
+   * @param ex The executor whose execution context the pool is used with.
+   *
+   * @param block_count The number of buffers in the pool. Must be between 1
+   * and 16384.
+   *
+   * @param block_size The size of each buffer, in bytes.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename Executor>
+  registered_buffer_pool(const Executor& ex, std::size_t block_count,
+      std::size_t block_size,
+      constraint_t<
+        is_executor<Executor>::value || execution::is_executor<Executor>::value
+      > = 0)
+  {
+    init(registered_buffer_pool::get_context(ex), block_count, block_size);
+  }
+
+  /// Create a pool of buffers for an execution context.
+  /**
+   * @param ctx The execution context the pool is used with.
+   *
+   * @param block_count The number of buffers in the pool. Must be between 1
+   * and 16384.
+   *
+   * @param block_size The size of each buffer, in bytes.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename ExecutionContext>
+  registered_buffer_pool(ExecutionContext& ctx, std::size_t block_count,
+      std::size_t block_size,
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      > = 0)
+  {
+    init(ctx, block_count, block_size);
+  }
+
+  /// Destroys the pool, unregistering its buffers if required.
+  ASIO_DECL ~registered_buffer_pool();
+
+  /// Get the number of buffers in the pool.
+  std::size_t block_count() const noexcept
+  {
+    return block_count_;
+  }
+
+  /// Get the size of each buffer in the pool.
+  std::size_t block_size() const noexcept
+  {
+    return block_size_;
+  }
+
+  /// Determine whether the buffers are registered with the kernel.
+  /**
+   * @returns @c true if operations on the buffers use fixed-buffer I/O, and
+   * @c false if the pool is a plain slab of memory.
+   */
+  bool is_registered() const noexcept
+  {
+#if defined(ASIO_HAS_IO_URING)
+    return service_ != 0;
+#else // defined(ASIO_HAS_IO_URING)
+    return false;
+#endif // defined(ASIO_HAS_IO_URING)
+  }
+
+  /// Get the number of buffers not currently in use.
+  ASIO_DECL std::size_t available() const;
+
+  /// Take a buffer from the pool.
+  /**
+   * @returns A buffer of block_size() bytes.
+   *
+   * @throws asio::system_error Thrown with asio::error::no_buffer_space
+   * if all buffers are in use.
+   */
+  ASIO_DECL mutable_registered_buffer acquire();
+
+  /// Take a buffer from the pool.
+  /**
+   * @param ec Set to asio::error::no_buffer_space if all buffers are in
+   * use.
+   *
+   * @returns A buffer of block_size() bytes, or an empty buffer if an error
+   * occurred.
+   */
+  ASIO_DECL mutable_registered_buffer acquire(asio::error_code& ec);
+
+  /// Return a buffer to the pool so that it may be used again.
+  /**
+   * @param b A buffer obtained from acquire(). The buffer may have been
+   * advanced using @c operator+=.
+   */
+  ASIO_DECL void release(const mutable_registered_buffer& b);
+
+private:
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      enable_if_t<execution::is_executor<T>::value>* = 0)
+  {
+    return asio::query(t, execution::context);
+  }
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      enable_if_t<!execution::is_executor<T>::value>* = 0)
+  {
+    return t.context();
+  }
+
+  // Allocate the buffers and register them.
+  ASIO_DECL void init(execution_context& ctx,
+      std::size_t block_count, std::size_t block_size);
+
+  // Free the memory that backs the buffers.
+  ASIO_DECL void free_storage();
+
+  // Get the index of the free list used by the calling thread.
+  ASIO_DECL std::size_t this_thread_list() const;
+
+  // Get the buffer for the block with the specified index.
+  mutable_registered_buffer make_block(std::size_t index) const noexcept
+  {
+    return this->make_buffer(
+        mutable_buffer(storage_ + index * block_size_, block_size_),
+        scope_, static_cast<int>(index));
+  }
+
+  // Marks the end of a free list.
+  enum { end_of_list = -1 };
+
+  // A list of free blocks. The blocks are linked through next_.
+  struct free_list
+  {
+    mutable detail::mutex mutex_;
+    int head_;
+    std::size_t size_;
+  };
+
+  // The memory that backs all buffers in the pool.
+  unsigned char* storage_;
+
+  // The number of buffers in the pool.
+  std::size_t block_count_;
+
+  // The size of each buffer.
+  std::size_t block_size_;
+
+  // The scope of the registered buffer identifiers.
+  const void* scope_;
+
+  // The counters in which the storage is recorded, or null if they are
+  // disabled.
+  detail::memory_metrics* memory_metrics_;
+
+  // For each free block, the index of the next block in the same free list.
+  std::vector<int> next_;
+
+  // The free lists.
+  std::vector<free_list*> lists_;
+
+#if defined(ASIO_HAS_IO_URING)
+  // The service with which the buffers are registered.
+  detail::io_uring_service* service_;
+#endif // defined(ASIO_HAS_IO_URING)
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/impl/registered_buffer_pool.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_REGISTERED_BUFFER_POOL_HPP
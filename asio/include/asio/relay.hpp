@@ -0,0 +1,182 @@
+//
+// relay.hpp
+// ~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_RELAY_HPP
+#define ASIO_RELAY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/async_result.hpp"
+#include "asio/compose.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename StreamA, typename StreamB> class relay_op;
+
+} // namespace detail
+
+/// Options that control the behaviour of asio::async_relay.
+struct relay_options
+{
+  /// Construct with the default options.
+  relay_options() noexcept
+    : buffer_size(16384),
+      half_close(true),
+      use_splice(true)
+  {
+  }
+
+  /// The size of the buffer used for each direction, in bytes. When data is
+  /// spliced, the maximum number of bytes moved by each splice.
+  std::size_t buffer_size;
+
+  /// Whether the end of the data in one direction is passed on by shutting
+  /// down the sending side of the other stream, while data continues to flow
+  /// in the other direction. When false, the relay finishes as soon as either
+  /// stream reaches the end of its data.
+  bool half_close;
+
+  /// Whether data is moved using the Linux @c splice system call when both
+  /// streams are sockets.
+  bool use_splice;
+};
+
+/**
+ * @defgroup async_relay asio::async_relay
+ *
+ * @brief The @c async_relay function is a composed asynchronous operation that
+ * copies data in both directions between two streams.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to copy data in both directions between
+/// two streams.
+/**
+ * This function is used to asynchronously relay data between two streams, as
+ * a proxy does. Data read from each stream is written to the other, in both
+ * directions at once. It is an initiating function for an @ref
+ * asynchronous_operation, and always returns immediately. The asynchronous
+ * operation will continue until one of the following conditions is true:
+ *
+ * @li Both streams have reached the end of their data, if
+ * relay_options::half_close is true.
+ *
+ * @li Either stream has reached the end of its data, if
+ * relay_options::half_close is false.
+ *
+ * @li An error occurred in either direction.
+ *
+ * If relay_options::buffer_size is zero, the operation completes immediately
+ * with the asio::error::invalid_argument error.
+ *
+ * When a stream reaches the end of its data and relay_options::half_close is
+ * true, the other stream's sending side is shut down, if it provides a
+ * socket-style @c shutdown member function, so that the peer sees the end of
+ * the data. When the operation finishes for any other reason, the direction
+ * that is still in progress is cancelled. Neither stream is closed.
+ *
+ * Each direction uses a single buffer for the whole relay. The buffers are
+ * obtained in one allocation, using the completion handler's associated
+ * allocator. On Linux, if both streams are basic_stream_socket objects and
+ * relay_options::use_splice is true, data is instead moved through a pipe
+ * for each direction using the @c splice system call, without being copied
+ * to user space.
+ *
+ * This operation is implemented in terms of zero or more calls to the
+ * streams' async_read_some and async_write_some functions, and is known as a
+ * <em>composed operation</em>. The program must ensure that the streams
+ * perform no other operations until this operation completes.
+ *
+ * @param a The first stream. The type must support the AsyncReadStream and
+ * AsyncWriteStream concepts.
+ *
+ * @param b The second stream. The type must support the AsyncReadStream and
+ * AsyncWriteStream concepts.
+ *
+ * @param options The options that control the relay.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the relay completes.
+ * Potential completion tokens include @ref use_future, @ref use_awaitable,
+ * @ref yield_context, or a function object with the correct completion
+ * signature. The function signature of the completion handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const asio::error_code& error,
+ *
+ *   // Number of bytes written to b, which were read from a.
+ *   std::size_t a_to_b,
+ *
+ *   // Number of bytes written to a, which were read from b.
+ *   std::size_t b_to_a
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the completion handler will not be invoked from within this function.
+ * On immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::async_immediate().
+ *
+ * @par Completion Signature
+ * @code void(asio::error_code, std::size_t, std::size_t) @endcode
+ *
+ * @par Example
+ * @code
+ * asio::async_relay(client_socket, upstream_socket, asio::relay_options(),
+ *     [](asio::error_code ec, std::size_t up, std::size_t down)
+ *     {
+ *       // ...
+ *     });
+ * @endcode
+ *
+ * @par Per-Operation Cancellation
+ * This asynchronous operation supports cancellation for the following
+ * asio::cancellation_type values:
+ *
+ * @li @c cancellation_type::terminal
+ *
+ * if it is also supported by the streams' @c async_read_some and
+ * @c async_write_some operations.
+ */
+template <typename AsyncStreamA, typename AsyncStreamB,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t, std::size_t)) RelayToken = default_completion_token_t<
+        typename AsyncStreamA::executor_type>>
+inline auto async_relay(AsyncStreamA& a, AsyncStreamB& b,
+    const relay_options& options,
+    RelayToken&& token = default_completion_token_t<
+      typename AsyncStreamA::executor_type>())
+  -> decltype(
+    async_compose<RelayToken,
+      void (asio::error_code, std::size_t, std::size_t)>(
+        declval<detail::relay_op<AsyncStreamA, AsyncStreamB>>(),
+        token, a, b))
+{
+  return async_compose<RelayToken,
+    void (asio::error_code, std::size_t, std::size_t)>(
+      detail::relay_op<AsyncStreamA, AsyncStreamB>(a, b, options),
+      token, a, b);
+}
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/relay.hpp"
+
+#endif // ASIO_RELAY_HPP
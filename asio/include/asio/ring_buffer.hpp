@@ -0,0 +1,338 @@
+//
+// ring_buffer.hpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_RING_BUFFER_HPP
+#define ASIO_RING_BUFFER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include "asio/buffer.hpp"
+#include "asio/detail/mirrored_memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/throw_exception.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+class dynamic_ring_buffer;
+
+/// Fixed-capacity storage for a stream of bytes, held in a ring.
+/**
+ * The ring_buffer class holds a sequence of bytes that is appended to at the
+ * end and consumed from the beginning, as when reading from a stream and
+ * parsing what was read. Its storage has a fixed capacity and is used as a
+ * ring, so consuming data never moves the data that remains.
+ *
+ * Where the platform supports it, the storage is mapped twice into
+ * consecutive regions of virtual memory, and the data is always presented as
+ * a single contiguous buffer even when it wraps around the end of the ring.
+ * On Linux this uses an anonymous memfd file, and the capacity is rounded up
+ * to a multiple of the page size. On other platforms the storage is an
+ * ordinary allocation, and the data is moved to the beginning of the storage
+ * when more space is needed at the end.
+ *
+ * A ring_buffer is used with the read and write operations through a
+ * dynamic_ring_buffer object, which is usually created by calling
+ * asio::dynamic_buffer().
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * Reading lines from a socket:
+ * @code
+ * asio::ring_buffer ring(65536);
+ * for (;;)
+ * {
+ *   std::size_t n = asio::read_until(sock,
+ *       asio::dynamic_buffer(ring), '\n');
+ *   process_line(ring.data(), n);
+ *   ring.consume(n);
+ * }
+ * @endcode
+ */
+class ring_buffer
+  : private detail::noncopyable
+{
+public:
+  /// Construct a ring buffer with at least the specified capacity.
+  /**
+   * @param capacity The minimum capacity of the buffer, in bytes.
+   *
+   * @throws asio::system_error Thrown if the storage could not be allocated.
+   */
+  explicit ring_buffer(std::size_t capacity)
+    : memory_(capacity),
+      begin_(0),
+      size_(0)
+  {
+  }
+
+  /// Get the number of bytes held in the buffer.
+  std::size_t size() const noexcept
+  {
+    return size_;
+  }
+
+  /// Get the capacity of the buffer.
+  std::size_t capacity() const noexcept
+  {
+    return memory_.size();
+  }
+
+  /// Determine whether the buffer is empty.
+  bool empty() const noexcept
+  {
+    return size_ == 0;
+  }
+
+  /// Get a buffer that represents the bytes held in the buffer.
+  /**
+   * @note The returned buffer is invalidated by any member function, or
+   * dynamic_ring_buffer operation, that modifies the data.
+   */
+  mutable_buffer data() noexcept
+  {
+    return mutable_buffer(memory_.data() + begin_, size_);
+  }
+
+  /// Get a buffer that represents the bytes held in the buffer.
+  /**
+   * @note The returned buffer is invalidated by any member function, or
+   * dynamic_ring_buffer operation, that modifies the data.
+   */
+  const_buffer data() const noexcept
+  {
+    return const_buffer(memory_.data() + begin_, size_);
+  }
+
+  /// Remove bytes from the beginning of the buffer.
+  /**
+   * If @c n is greater than the size of the buffer, the buffer is emptied.
+   */
+  void consume(std::size_t n) noexcept
+  {
+    if (n >= size_)
+    {
+      begin_ = 0;
+      size_ = 0;
+      return;
+    }
+
+    begin_ += n;
+    size_ -= n;
+    if (begin_ >= memory_.size())
+      begin_ -= memory_.size();
+  }
+
+  /// Remove all bytes from the buffer.
+  void clear() noexcept
+  {
+    begin_ = 0;
+    size_ = 0;
+  }
+
+private:
+  friend class dynamic_ring_buffer;
+
+  // Append n bytes to the end of the data, which must fit within the buffer's
+  // capacity.
+  void grow(std::size_t n)
+  {
+    if (!detail::mirrored_memory::is_mirrored
+        && begin_ + size_ + n > memory_.size())
+    {
+      std::memmove(memory_.data(), memory_.data() + begin_, size_);
+      begin_ = 0;
+    }
+
+    size_ += n;
+  }
+
+  // Remove n bytes from the end of the data.
+  void shrink(std::size_t n) noexcept
+  {
+    size_ = n > size_ ? 0 : size_ - n;
+    if (size_ == 0)
+      begin_ = 0;
+  }
+
+  detail::mirrored_memory memory_;
+  std::size_t begin_;
+  std::size_t size_;
+};
+
+/// Adapt a ring_buffer to the DynamicBuffer_v2 requirements.
+/**
+ * The dynamic_ring_buffer class stores a reference to a ring_buffer object.
+ * The ring buffer's data is the underlying memory of the dynamic buffer, and
+ * it may grow up to the capacity of the ring buffer. Because the data is held
+ * at a fixed position in the ring, consume() never moves the data that
+ * remains.
+ */
+class dynamic_ring_buffer
+{
+public:
+  /// The type used to represent a sequence of constant buffers that refers to
+  /// the underlying memory.
+  typedef const_buffer const_buffers_type;
+
+  /// The type used to represent a sequence of mutable buffers that refers to
+  /// the underlying memory.
+  typedef mutable_buffer mutable_buffers_type;
+
+  /// Construct a dynamic buffer from a ring buffer.
+  /**
+   * @param r The ring buffer to be used as backing storage for the dynamic
+   * buffer. The object stores a reference to the ring buffer and the user is
+   * responsible for ensuring that the ring buffer object remains valid while
+   * the dynamic_ring_buffer object, and copies of the object, are in use.
+   */
+  explicit dynamic_ring_buffer(ring_buffer& r) noexcept
+    : ring_(r)
+  {
+  }
+
+  /// @b DynamicBuffer_v2: Copy construct a dynamic buffer.
+  dynamic_ring_buffer(const dynamic_ring_buffer& other) noexcept
+    : ring_(other.ring_)
+  {
+  }
+
+  /// @b DynamicBuffer_v2: Get the current size of the underlying memory.
+  std::size_t size() const noexcept
+  {
+    return ring_.size();
+  }
+
+  /// Get the maximum size of the dynamic buffer.
+  /**
+   * @returns The capacity of the ring buffer.
+   */
+  std::size_t max_size() const noexcept
+  {
+    return ring_.capacity();
+  }
+
+  /// Get the maximum size that the buffer may grow to without triggering
+  /// reallocation.
+  /**
+   * @returns The capacity of the ring buffer.
+   */
+  std::size_t capacity() const noexcept
+  {
+    return ring_.capacity();
+  }
+
+  /// @b DynamicBuffer_v2: Get a sequence of buffers that represents the
+  /// underlying memory.
+  /**
+   * @param pos Position of the first byte to represent in the buffer sequence
+   *
+   * @param n The number of bytes to return in the buffer sequence. If the
+   * underlying memory is shorter, the buffer sequence represents as many bytes
+   * as are available.
+   *
+   * @returns An object of type @c mutable_buffers_type that satisfies
+   * MutableBufferSequence requirements, representing the ring buffer's data.
+   *
+   * @note The returned object is invalidated by any @c dynamic_ring_buffer
+   * or @c ring_buffer member function that modifies the data.
+   */
+  mutable_buffers_type data(std::size_t pos, std::size_t n) noexcept
+  {
+    return mutable_buffers_type(asio::buffer(ring_.data() + pos, n));
+  }
+
+  /// @b DynamicBuffer_v2: Get a sequence of buffers that represents the
+  /// underlying memory.
+  /**
+   * @param pos Position of the first byte to represent in the buffer sequence
+   *
+   * @param n The number of bytes to return in the buffer sequence. If the
+   * underlying memory is shorter, the buffer sequence represents as many bytes
+   * as are available.
+   *
+   * @note The returned object is invalidated by any @c dynamic_ring_buffer
+   * or @c ring_buffer member function that modifies the data.
+   */
+  const_buffers_type data(std::size_t pos, std::size_t n) const noexcept
+  {
+    const ring_buffer& r = ring_;
+    return const_buffers_type(asio::buffer(r.data() + pos, n));
+  }
+
+  /// @b DynamicBuffer_v2: Grow the underlying memory by the specified number of
+  /// bytes.
+  /**
+   * Extends the ring buffer's data by @c n bytes at the end.
+   *
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   */
+  void grow(std::size_t n)
+  {
+    if (max_size() - size() < n)
+    {
+      std::length_error ex("dynamic_ring_buffer too long");
+      asio::detail::throw_exception(ex);
+    }
+
+    ring_.grow(n);
+  }
+
+  /// @b DynamicBuffer_v2: Shrink the underlying memory by the specified number
+  /// of bytes.
+  /**
+   * Removes @c n bytes from the end of the ring buffer's data. If @c n is
+   * greater than the current size of the data, the ring buffer is emptied.
+   */
+  void shrink(std::size_t n)
+  {
+    ring_.shrink(n);
+  }
+
+  /// @b DynamicBuffer_v2: Consume the specified number of bytes from the
+  /// beginning of the underlying memory.
+  /**
+   * Removes @c n bytes from the beginning of the ring buffer's data. If @c n
+   * is greater than the current size of the data, the ring buffer is emptied.
+   */
+  void consume(std::size_t n)
+  {
+    ring_.consume(n);
+  }
+
+private:
+  ring_buffer& ring_;
+};
+
+/// Create a new dynamic buffer that represents the given ring buffer.
+/**
+ * @returns <tt>dynamic_ring_buffer(data)</tt>.
+ */
+ASIO_NODISCARD inline dynamic_ring_buffer dynamic_buffer(
+    ring_buffer& data) noexcept
+{
+  return dynamic_ring_buffer(data);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_RING_BUFFER_HPP
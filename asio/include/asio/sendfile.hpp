@@ -0,0 +1,158 @@
+//
+// sendfile.hpp
+// ~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SENDFILE_HPP
+#define ASIO_SENDFILE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SENDFILE) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include "asio/async_result.hpp"
+#include "asio/error.hpp"
+#include "asio/detail/cstdint.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename Socket, typename File> class initiate_async_sendfile;
+
+} // namespace detail
+
+/**
+ * @defgroup async_sendfile asio::async_sendfile
+ *
+ * @brief The @c async_sendfile function is a composed asynchronous operation
+ * that sends the contents of a file on a stream socket, without copying the
+ * data through user space.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to send part of a file on a stream socket.
+/**
+ * This function is used to asynchronously send @c count bytes of a file,
+ * starting at @c offset, on a stream socket. On Linux the data is transferred
+ * using the @c sendfile system call. On Windows it is transferred using the
+ * @c TransmitFile function. It is an initiating function for an @ref
+ * asynchronous_operation, and always returns immediately.
+ *
+ * The operation continues until all @c count bytes have been sent, the end
+ * of the file is reached, or an error occurs. The file's current position, if
+ * any, is neither used nor changed.
+ *
+ * On Linux, the operation waits for the socket to become writable using the
+ * socket's @c async_wait operation, and so works with both the io_uring and
+ * reactor based backends. The socket is placed into non-blocking mode. Data
+ * that is not in the page cache is read from the storage device by the
+ * calling thread, which may block.
+ *
+ * @param s The stream socket to which the data is sent. The object must remain
+ * valid until the completion handler is called.
+ *
+ * @param file The file from which the data is read. This may be any object
+ * with a @c native_handle() member function that returns a file descriptor or
+ * handle that is open for reading, such as a basic_random_access_file, a
+ * basic_stream_file or a windows::basic_random_access_handle. The object must
+ * remain valid until the completion handler is called.
+ *
+ * @param offset The offset in the file at which to start reading.
+ *
+ * @param count The number of bytes to be sent.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the operation completes.
+ * Potential completion tokens include @ref use_future, @ref use_awaitable,
+ * @ref yield_context, or a function object with the correct completion
+ * signature. The function signature of the completion handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const asio::error_code& error,
+ *
+ *   // Number of bytes sent. If an error occurred, this will be the
+ *   // number of bytes successfully sent prior to the error.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the completion handler will not be invoked from within this function.
+ * On immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::async_immediate().
+ *
+ * @par Completion Signature
+ * @code void(asio::error_code, std::size_t) @endcode
+ *
+ * An error code of asio::error::eof indicates that the end of the file was
+ * reached before @c count bytes were sent.
+ *
+ * @par Example
+ * @code
+ * asio::random_access_file file(my_context, "index.html",
+ *     asio::random_access_file::read_only);
+ * asio::async_sendfile(socket, file, 0, file.size(),
+ *     [](asio::error_code ec, std::size_t n)
+ *     {
+ *       // ...
+ *     });
+ * @endcode
+ *
+ * @par Kernel TLS
+ * When an ssl::stream has handed its connection to the kernel using
+ * ssl::stream::use_kernel_tls(), and ssl::stream::kernel_tls_send_active()
+ * returns @c true, the file may be sent by passing the stream's @c
+ * next_layer() to this function. The kernel encrypts the data as it is sent.
+ * Any data written using the stream's own operations must have completed
+ * first.
+ *
+ * @par Per-Operation Cancellation
+ * On Linux, this asynchronous operation supports cancellation for the
+ * following asio::cancellation_type values:
+ *
+ * @li @c cancellation_type::terminal
+ *
+ * @note This function is available only on Linux and Windows.
+ */
+template <typename Socket, typename File,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) SendfileToken = default_completion_token_t<
+        typename Socket::executor_type>>
+inline auto async_sendfile(Socket& s, File& file, uint64_t offset,
+    std::size_t count, SendfileToken&& token = default_completion_token_t<
+      typename Socket::executor_type>())
+  -> decltype(
+    async_initiate<SendfileToken,
+      void (asio::error_code, std::size_t)>(
+        declval<detail::initiate_async_sendfile<Socket, File>>(),
+        token, offset, count))
+{
+  return async_initiate<SendfileToken,
+    void (asio::error_code, std::size_t)>(
+      detail::initiate_async_sendfile<Socket, File>(s, file),
+      token, offset, count);
+}
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/sendfile.hpp"
+
+#endif // defined(ASIO_HAS_SENDFILE)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_SENDFILE_HPP
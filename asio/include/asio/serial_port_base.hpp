@@ -25,6 +25,7 @@
 # include <termios.h>
 #endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
 
+#include <chrono>
 #include "asio/detail/socket_types.hpp"
 #include "asio/error_code.hpp"
 
@@ -143,6 +144,58 @@ public:
     unsigned int value_;
   };
 
+  /// Serial port option to control how many characters a read waits for.
+  /**
+   * Implements changing the minimum number of characters for a read (the
+   * @c VMIN setting) and the inter-character timeout (the @c VTIME setting)
+   * for a given serial port.
+   *
+   * When the timeout is zero, some operating systems, such as Linux, do not
+   * report a serial port as ready to read until at least the minimum number of
+   * characters has been received. This reduces the number of wakeups needed
+   * to receive a message of known length. The timeout has a resolution of 100
+   * milliseconds and a maximum of 25.5 seconds, and is rounded up.
+   *
+   * @note This option is not supported on Windows, where setting it fails with
+   * asio::error::operation_not_supported.
+   */
+  class read_timing
+  {
+  public:
+    ASIO_DECL explicit read_timing(unsigned int min_chars = 1,
+        std::chrono::milliseconds inter_char_timeout
+          = std::chrono::milliseconds(0));
+    unsigned int min_chars() const;
+    std::chrono::milliseconds inter_char_timeout() const;
+    ASIO_DECL ASIO_SYNC_OP_VOID store(
+        ASIO_OPTION_STORAGE& storage,
+        asio::error_code& ec) const;
+    ASIO_DECL ASIO_SYNC_OP_VOID load(
+        const ASIO_OPTION_STORAGE& storage,
+        asio::error_code& ec);
+  private:
+    unsigned int min_chars_;
+    std::chrono::milliseconds inter_char_timeout_;
+  };
+
+  /// Serial port option to request low latency from the driver.
+  /**
+   * Implements changing the @c ASYNC_LOW_LATENCY flag of a given serial port,
+   * which asks the driver to pass received characters on immediately rather
+   * than batching them. Changing the flag typically requires privileges.
+   *
+   * @note This option is supported only on Linux. Elsewhere, setting or
+   * getting it fails with asio::error::operation_not_supported.
+   */
+  class low_latency
+  {
+  public:
+    explicit low_latency(bool enabled = false);
+    bool value() const;
+  private:
+    bool value_;
+  };
+
 protected:
   /// Protected destructor to prevent deletion through this type.
   ~serial_port_base()
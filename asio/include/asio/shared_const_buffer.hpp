@@ -0,0 +1,281 @@
+//
+// shared_const_buffer.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SHARED_CONST_BUFFER_HPP
+#define ASIO_SHARED_CONST_BUFFER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include "asio/buffer.hpp"
+#include "asio/recycling_allocator.hpp"
+#include "asio/detail/atomic_count.hpp"
+#include "asio/detail/memory.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// The header of the memory that holds the data of a shared_const_buffer. The
+// data immediately follows the derived object that records the allocator.
+struct shared_const_buffer_block
+{
+  atomic_count ref_count;
+  void (*destroy)(shared_const_buffer_block*);
+};
+
+template <typename Allocator>
+struct shared_const_buffer_block_impl : shared_const_buffer_block
+{
+  typedef typename std::allocator_traits<Allocator>::template
+    rebind_alloc<shared_const_buffer_block_impl> allocator_type;
+
+  shared_const_buffer_block_impl(const Allocator& a, std::size_t len)
+    : allocator_(a),
+      length_(len)
+  {
+    this->ref_count = 1;
+    this->destroy = &shared_const_buffer_block_impl::do_destroy;
+  }
+
+  // The number of objects allocated to hold a block and n bytes of data.
+  static std::size_t length(std::size_t n)
+  {
+    return 1 + (n + sizeof(shared_const_buffer_block_impl) - 1)
+      / sizeof(shared_const_buffer_block_impl);
+  }
+
+  static shared_const_buffer_block_impl* create(
+      const Allocator& a, const void* data, std::size_t n)
+  {
+    allocator_type alloc(a);
+    std::size_t len = length(n);
+    shared_const_buffer_block_impl* p = alloc.allocate(len);
+    new (p) shared_const_buffer_block_impl(a, len);
+    if (n > 0)
+      std::memcpy(p->data(), data, n);
+    return p;
+  }
+
+  unsigned char* data() noexcept
+  {
+    return reinterpret_cast<unsigned char*>(this + 1);
+  }
+
+  static void do_destroy(shared_const_buffer_block* base)
+  {
+    shared_const_buffer_block_impl* p =
+      static_cast<shared_const_buffer_block_impl*>(base);
+    allocator_type alloc(p->allocator_);
+    std::size_t len = p->length_;
+    p->~shared_const_buffer_block_impl();
+    alloc.deallocate(p, len);
+  }
+
+  Allocator allocator_;
+  std::size_t length_;
+};
+
+} // namespace detail
+
+/// A reference-counted, non-modifiable buffer.
+/**
+ * The shared_const_buffer class holds a copy of some data in a single
+ * allocation, together with a reference count. Copying a shared_const_buffer
+ * adds a reference to the same data rather than copying it, and the memory is
+ * released when the last copy is destroyed. Sending the same data to many
+ * connections therefore costs one allocation, and one reference count
+ * increment for each outstanding write.
+ *
+ * A shared_const_buffer is convertible to const_buffer, and so may be passed
+ * directly to operations such as asio::async_write(), which keep a copy of
+ * it, and hence the data, until they complete. A container of
+ * shared_const_buffer objects, such as @c std::vector, is a
+ * ConstBufferSequence that may be used to write several shared buffers with
+ * a single operation.
+ *
+ * By default the memory is obtained from asio::recycling_allocator, which
+ * reuses memory cached by the threads running an @c io_context.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe. Copies of a shared_const_buffer that refer to
+ * the same data may be used and destroyed concurrently from different
+ * threads.
+ *
+ * @par Example
+ * Delivering one message to every participant of a chat room:
+ * @code
+ * asio::shared_const_buffer msg(data, length);
+ * for (auto& p : participants)
+ *   asio::async_write(p->socket(), msg, handler);
+ * @endcode
+ */
+class shared_const_buffer
+{
+public:
+  /// Construct an empty buffer.
+  shared_const_buffer() noexcept
+    : block_(0),
+      buffer_()
+  {
+  }
+
+  /// Construct a buffer that holds a copy of the specified data.
+  shared_const_buffer(const void* data, std::size_t size)
+    : block_(0),
+      buffer_()
+  {
+    init(data, size, recycling_allocator<void>());
+  }
+
+  /// Construct a buffer that holds a copy of the specified data, using the
+  /// specified allocator to obtain the memory.
+  template <typename Allocator>
+  shared_const_buffer(const void* data, std::size_t size, const Allocator& a)
+    : block_(0),
+      buffer_()
+  {
+    init(data, size, a);
+  }
+
+  /// Construct a buffer that holds a copy of the data in the specified
+  /// buffer.
+  explicit shared_const_buffer(const const_buffer& b)
+    : block_(0),
+      buffer_()
+  {
+    init(b.data(), b.size(), recycling_allocator<void>());
+  }
+
+  /// Construct a buffer that holds a copy of the data in the specified
+  /// buffer, using the specified allocator to obtain the memory.
+  template <typename Allocator>
+  shared_const_buffer(const const_buffer& b, const Allocator& a)
+    : block_(0),
+      buffer_()
+  {
+    init(b.data(), b.size(), a);
+  }
+
+  /// Copy constructor adds a reference to the data.
+  shared_const_buffer(const shared_const_buffer& other) noexcept
+    : block_(other.block_),
+      buffer_(other.buffer_)
+  {
+    if (block_)
+      detail::ref_count_up(block_->ref_count);
+  }
+
+  /// Move constructor.
+  shared_const_buffer(shared_const_buffer&& other) noexcept
+    : block_(other.block_),
+      buffer_(other.buffer_)
+  {
+    other.block_ = 0;
+    other.buffer_ = const_buffer();
+  }
+
+  /// Destructor releases the reference to the data.
+  ~shared_const_buffer()
+  {
+    release();
+  }
+
+  /// Copy assignment adds a reference to the data.
+  shared_const_buffer& operator=(const shared_const_buffer& other) noexcept
+  {
+    if (other.block_)
+      detail::ref_count_up(other.block_->ref_count);
+    release();
+    block_ = other.block_;
+    buffer_ = other.buffer_;
+    return *this;
+  }
+
+  /// Move assignment.
+  shared_const_buffer& operator=(shared_const_buffer&& other) noexcept
+  {
+    if (this != &other)
+    {
+      release();
+      block_ = other.block_;
+      buffer_ = other.buffer_;
+      other.block_ = 0;
+      other.buffer_ = const_buffer();
+    }
+    return *this;
+  }
+
+  /// Get a pointer to the beginning of the data.
+  const void* data() const noexcept
+  {
+    return buffer_.data();
+  }
+
+  /// Get the size of the data.
+  std::size_t size() const noexcept
+  {
+    return buffer_.size();
+  }
+
+  /// Get the number of shared_const_buffer objects that refer to the data.
+  /**
+   * Returns 0 for an empty buffer.
+   */
+  long use_count() const noexcept
+  {
+    return block_ ? static_cast<long>(block_->ref_count) : 0;
+  }
+
+  /// Convert to a const_buffer that refers to the data.
+  operator const_buffer() const noexcept
+  {
+    return buffer_;
+  }
+
+private:
+  template <typename Allocator>
+  void init(const void* data, std::size_t size, const Allocator& a)
+  {
+    typedef typename std::allocator_traits<Allocator>::template
+      rebind_alloc<unsigned char> byte_allocator_type;
+    typedef detail::shared_const_buffer_block_impl<
+      byte_allocator_type> impl_type;
+
+    if (size > 0)
+    {
+      impl_type* p = impl_type::create(byte_allocator_type(a), data, size);
+      block_ = p;
+      buffer_ = const_buffer(p->data(), size);
+    }
+  }
+
+  void release() noexcept
+  {
+    if (block_ && detail::ref_count_down(block_->ref_count))
+      block_->destroy(block_);
+  }
+
+  detail::shared_const_buffer_block* block_;
+  const_buffer buffer_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_SHARED_CONST_BUFFER_HPP
@@ -88,7 +88,13 @@ public:
     wait_write,
 
     /// Wait for a socket to have error conditions pending.
-    wait_error
+    wait_error,
+
+    /// Wait for the peer to close the connection, or to shut down its side of
+    /// it, without reading any data. Supported on Linux, where it uses
+    /// @c EPOLLRDHUP or @c POLLRDHUP. Elsewhere the wait fails with
+    /// asio::error::operation_not_supported.
+    wait_peer_closed
   };
 
   /// Socket option to permit sending of broadcast messages.
@@ -396,6 +402,305 @@ public:
       reuse_address;
 #endif
 
+#if defined(ASIO_HAS_SO_REUSEPORT) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Socket option to allow multiple sockets to be bound to the same address
+  /// and port.
+  /**
+   * Implements the SOL_SOCKET/SO_REUSEPORT socket option. On Linux, incoming
+   * connections and datagrams are distributed between all of the sockets
+   * bound to the address, allowing each socket to be served by a separate
+   * thread.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * asio::socket_base::reuse_port option(true);
+   * acceptor.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * asio::socket_base::reuse_port option;
+   * acceptor.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined reuse_port;
+#else
+  typedef asio::detail::socket_option::boolean<
+    ASIO_OS_DEF(SOL_SOCKET), ASIO_OS_DEF(SO_REUSEPORT)>
+      reuse_port;
+#endif
+#endif // defined(ASIO_HAS_SO_REUSEPORT)
+      //   || defined(GENERATING_DOCUMENTATION)
+
+#if defined(ASIO_HAS_SO_BUSY_POLL) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Socket option for the time to busy poll the device queue when receiving.
+  /**
+   * Implements the SOL_SOCKET/SO_BUSY_POLL socket option. The value is the
+   * approximate time, in microseconds, for which a blocking receive or a poll
+   * of the socket spins on the network device's receive queue before waiting
+   * for an interrupt. Setting a value greater than the system default
+   * requires the CAP_NET_ADMIN capability. Linux only.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::socket_base::busy_poll option(50);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::socket_base::busy_poll option;
+   * socket.get_option(option);
+   * int usec = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined busy_poll;
+#else
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(SOL_SOCKET), ASIO_OS_DEF(SO_BUSY_POLL)>
+      busy_poll;
+#endif
+
+  /// Socket option to prefer busy polling over interrupts.
+  /**
+   * Implements the SOL_SOCKET/SO_PREFER_BUSY_POLL socket option. When set,
+   * and the device is configured to defer its interrupts, the device queue is
+   * served only by busy polling while the application keeps polling it.
+   * Requires Linux 5.11 or later.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::socket_base::prefer_busy_poll option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::socket_base::prefer_busy_poll option;
+   * socket.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined prefer_busy_poll;
+#else
+  typedef asio::detail::socket_option::boolean<
+    ASIO_OS_DEF(SOL_SOCKET), ASIO_OS_DEF(SO_PREFER_BUSY_POLL)>
+      prefer_busy_poll;
+#endif
+
+  /// Socket option for the number of packets processed by each busy poll.
+  /**
+   * Implements the SOL_SOCKET/SO_BUSY_POLL_BUDGET socket option. Setting a
+   * value greater than the system default requires the CAP_NET_ADMIN
+   * capability. Requires Linux 5.11 or later.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::socket_base::busy_poll_budget option(16);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::socket_base::busy_poll_budget option;
+   * socket.get_option(option);
+   * int budget = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined busy_poll_budget;
+#else
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(SOL_SOCKET), ASIO_OS_DEF(SO_BUSY_POLL_BUDGET)>
+      busy_poll_budget;
+#endif
+#endif // defined(ASIO_HAS_SO_BUSY_POLL)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#if defined(ASIO_HAS_SO_MAX_PACING_RATE) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Socket option for the maximum rate at which the kernel sends data.
+  /**
+   * Implements the SOL_SOCKET/SO_MAX_PACING_RATE socket option. The value is
+   * the maximum transmit rate, in bytes per second, at which the kernel paces
+   * the socket's packets. Pacing is performed by the TCP stack or by the fq
+   * queueing discipline. A value of -1 removes the limit. Linux only.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::socket_base::max_pacing_rate option(10 * 1024 * 1024);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::socket_base::max_pacing_rate option;
+   * socket.get_option(option);
+   * int bytes_per_second = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined max_pacing_rate;
+#else
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(SOL_SOCKET), ASIO_OS_DEF(SO_MAX_PACING_RATE)>
+      max_pacing_rate;
+#endif
+#endif // defined(ASIO_HAS_SO_MAX_PACING_RATE)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#if defined(ASIO_HAS_SOCKET_TIMESTAMPING) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Socket option to enable kernel and hardware timestamps.
+  /**
+   * Implements the SOL_SOCKET/SO_TIMESTAMPING socket option. The value is a
+   * bitmask of the @c timestamp_ flags below, selecting which timestamps are
+   * generated and which are reported. Hardware timestamps also require the
+   * network device to be configured for timestamping. Linux only.
+   *
+   * Receive timestamps are reported by operations such as
+   * basic_datagram_socket::async_receive_from_timestamped(). Transmit
+   * timestamps are queued on the socket's error queue, and are reported by
+   * basic_socket::async_receive_tx_timestamp().
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::socket_base::timestamping option(
+   *     asio::socket_base::timestamp_rx_software
+   *     | asio::socket_base::timestamp_software);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::socket_base::timestamping option;
+   * socket.get_option(option);
+   * int flags = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined timestamping;
+#else
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(SOL_SOCKET), ASIO_OS_DEF(SO_TIMESTAMPING)>
+      timestamping;
+#endif
+
+#if defined(GENERATING_DOCUMENTATION)
+  /// Generate timestamps when data is passed to the network device.
+  static const int timestamp_tx_hardware = implementation_defined;
+
+  /// Generate timestamps when data leaves the kernel.
+  static const int timestamp_tx_software = implementation_defined;
+
+  /// Generate timestamps when data enters the packet scheduler.
+  static const int timestamp_tx_sched = implementation_defined;
+
+  /// Generate timestamps when all data has been acknowledged. TCP only.
+  static const int timestamp_tx_ack = implementation_defined;
+
+  /// Generate timestamps when data is received by the network device.
+  static const int timestamp_rx_hardware = implementation_defined;
+
+  /// Generate timestamps when data enters the kernel.
+  static const int timestamp_rx_software = implementation_defined;
+
+  /// Report software timestamps.
+  static const int timestamp_software = implementation_defined;
+
+  /// Report raw hardware timestamps.
+  static const int timestamp_raw_hardware = implementation_defined;
+
+  /// Identify each transmitted packet or byte range in its timestamps.
+  static const int timestamp_opt_id = implementation_defined;
+
+  /// Report transmit timestamps without a copy of the transmitted data.
+  static const int timestamp_opt_tsonly = implementation_defined;
+#else
+  ASIO_STATIC_CONSTANT(int, timestamp_tx_hardware
+      = ASIO_OS_DEF(SOF_TIMESTAMPING_TX_HARDWARE));
+  ASIO_STATIC_CONSTANT(int, timestamp_tx_software
+      = ASIO_OS_DEF(SOF_TIMESTAMPING_TX_SOFTWARE));
+  ASIO_STATIC_CONSTANT(int, timestamp_tx_sched
+      = ASIO_OS_DEF(SOF_TIMESTAMPING_TX_SCHED));
+  ASIO_STATIC_CONSTANT(int, timestamp_tx_ack
+      = ASIO_OS_DEF(SOF_TIMESTAMPING_TX_ACK));
+  ASIO_STATIC_CONSTANT(int, timestamp_rx_hardware
+      = ASIO_OS_DEF(SOF_TIMESTAMPING_RX_HARDWARE));
+  ASIO_STATIC_CONSTANT(int, timestamp_rx_software
+      = ASIO_OS_DEF(SOF_TIMESTAMPING_RX_SOFTWARE));
+  ASIO_STATIC_CONSTANT(int, timestamp_software
+      = ASIO_OS_DEF(SOF_TIMESTAMPING_SOFTWARE));
+  ASIO_STATIC_CONSTANT(int, timestamp_raw_hardware
+      = ASIO_OS_DEF(SOF_TIMESTAMPING_RAW_HARDWARE));
+  ASIO_STATIC_CONSTANT(int, timestamp_opt_id
+      = ASIO_OS_DEF(SOF_TIMESTAMPING_OPT_ID));
+  ASIO_STATIC_CONSTANT(int, timestamp_opt_tsonly
+      = ASIO_OS_DEF(SOF_TIMESTAMPING_OPT_TSONLY));
+#endif
+#endif // defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Socket option to specify whether the socket lingers on close if unsent
   /// data is present.
   /**
@@ -503,6 +808,289 @@ public:
     enable_connection_aborted;
 #endif
 
+  /// Socket option to request multishot accept operations.
+  /**
+   * Implements a custom socket option that determines whether or not accept
+   * operations may be implemented using a single, repeating submission to the
+   * operating system. This is only supported by the io_uring backend, which
+   * queues accepted connections until there is an accept operation to receive
+   * them. The peer endpoint, if requested, is obtained using getpeername().
+   * Other backends, and kernels that do not support multishot accept, ignore
+   * the option. By default the option is false.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * asio::socket_base::multishot_accept option(true);
+   * acceptor.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * asio::socket_base::multishot_accept option;
+   * acceptor.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined multishot_accept;
+#else
+  typedef asio::detail::socket_option::boolean<
+    asio::detail::custom_socket_option_level,
+    asio::detail::multishot_accept_option>
+    multishot_accept;
+#endif
+
+  /// Socket option to request zero-copy sends.
+  /**
+   * Implements a custom socket option that determines whether or not large
+   * send operations may transmit directly from the caller's buffers, rather
+   * than first copying the data into the kernel. On Linux, sends of at least
+   * 16 KiB use IORING_OP_SEND_ZC with the io_uring backend, and MSG_ZEROCOPY
+   * with the reactive backends, which also enable SO_ZEROCOPY on the socket.
+   * A send operation then completes only after the kernel has released the
+   * buffers. The option is ignored on other platforms, and by kernels or
+   * sockets that do not support zero-copy sends. By default the option is
+   * false.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::socket_base::zero_copy option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::socket_base::zero_copy option;
+   * socket.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined zero_copy;
+#else
+  typedef asio::detail::socket_option::boolean<
+    asio::detail::custom_socket_option_level,
+    asio::detail::zero_copy_option>
+    zero_copy;
+#endif
+
+  /// Socket option to invoke handlers inline for speculative receives.
+  /**
+   * Implements a custom socket option that determines whether or not a receive
+   * operation that completes as soon as it is started invokes its completion
+   * handler from within the initiating function, rather than posting the
+   * handler to the scheduler. This is done only when the initiating function
+   * is called from a thread that is running the socket's I/O context, which
+   * is typically the case when a receive is started from within the
+   * completion handler of the previous one. The depth of such nested
+   * invocations is limited, and further completions are posted as usual.
+   * The option applies only to the reactor-based backends, and does not
+   * affect handlers that have an associated immediate executor. By default
+   * the option is false.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::socket_base::inline_completion option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::socket_base::inline_completion option;
+   * socket.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined inline_completion;
+#else
+  typedef asio::detail::socket_option::boolean<
+    asio::detail::custom_socket_option_level,
+    asio::detail::inline_completion_option>
+    inline_completion;
+#endif
+
+  /// Socket option to receive data ahead of the reads that consume it.
+  /**
+   * Implements a custom socket option that sets the size, in bytes, of a
+   * read-ahead buffer owned by a stream socket. When the buffer is enabled, a
+   * receive operation without flags reads into the caller's buffers followed
+   * by the read-ahead buffer, so that a single system call drains whatever
+   * data the socket has available. Subsequent receive operations are then
+   * satisfied from the read-ahead buffer, without a system call, until it is
+   * empty. Waiting for the socket to become readable completes immediately
+   * while the buffer holds data, and the data is included in the value
+   * returned by @c available().
+   *
+   * The option is supported only by the reactor-based backends, and only for
+   * stream sockets. It must not be changed while a receive operation is
+   * outstanding. Receive operations with flags, or that are not directly on
+   * the socket's buffers, such as @c async_receive_multishot(), do not
+   * consume the buffered data and should not be mixed with ordinary receives
+   * while the buffer is enabled. A size of zero disables the buffer, and a
+   * size smaller than the amount of buffered data is rejected with
+   * asio::error::invalid_argument. Any buffered data is discarded when the
+   * socket is closed or released. By default the option is zero.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::socket_base::read_ahead option(65536);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::socket_base::read_ahead option;
+   * socket.get_option(option);
+   * int size = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined read_ahead;
+#else
+  typedef asio::detail::socket_option::integer<
+    asio::detail::custom_socket_option_level,
+    asio::detail::read_ahead_option>
+    read_ahead;
+#endif
+
+  /// Socket option to coalesce queued writes into a single system call.
+  /**
+   * Implements a custom socket option that determines whether or not
+   * operations that send all of their data on a stream socket, such as
+   * basic_stream_socket::async_send_all() and the asio::async_write()
+   * operations that use it, are coalesced. When the option is enabled, such
+   * an operation is not sent as soon as it is started. It is instead queued
+   * until the socket is next found to be writable, which for a writable
+   * socket is the next time the reactor runs. The data of all of the queued
+   * operations is then sent with a single system call, in the order in which
+   * the operations were started, and each operation's completion handler is
+   * invoked individually once its own data has been sent. This reduces the
+   * number of system calls made by programs that issue several small writes
+   * from within the same handler, at the cost of deferring the first write.
+   *
+   * The option is supported only by the reactor-based backends, and applies
+   * only to operations started without flags. Other backends ignore the
+   * option. By default the option is false.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::socket_base::write_coalescing option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::socket_base::write_coalescing option;
+   * socket.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined write_coalescing;
+#else
+  typedef asio::detail::socket_option::boolean<
+    asio::detail::custom_socket_option_level,
+    asio::detail::write_coalescing_option>
+    write_coalescing;
+#endif
+
+  /// Socket option to reserve memory for the socket's asynchronous operations.
+  /**
+   * Implements a custom socket option that determines whether or not the
+   * socket reserves memory for its asynchronous send and receive operations.
+   * When the option is enabled, the socket keeps one slot for the memory of a
+   * receive operation and one for the memory of a send operation. An
+   * operation's memory is returned to its slot when the operation completes,
+   * and is reused by the next operation in the same direction, regardless of
+   * the type of its completion handler. A socket that has no more than one
+   * operation outstanding in each direction then performs its steady-state
+   * I/O without allocating memory.
+   *
+   * The slots are used only by operations whose completion handlers do not
+   * have an associated allocator. Operations that are started while a slot's
+   * memory is in use allocate their memory in the usual way.
+   *
+   * The option is supported by the reactor-based and io_uring backends.
+   * Other backends ignore the option. The option is cleared when the socket
+   * is closed. By default the option is false.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::socket_base::operation_slots option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::socket_base::operation_slots option;
+   * socket.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined operation_slots;
+#else
+  typedef asio::detail::socket_option::boolean<
+    asio::detail::custom_socket_option_level,
+    asio::detail::operation_slots_option>
+    operation_slots;
+#endif
+
   /// IO control command to get the amount of data that can be read without
   /// blocking.
   /**
@@ -0,0 +1,83 @@
+//
+// socket_timestamp.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SOCKET_TIMESTAMP_HPP
+#define ASIO_SOCKET_TIMESTAMP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SOCKET_TIMESTAMPING) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <chrono>
+#include "asio/detail/cstdint.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A kernel timestamp reported for data sent or received on a socket.
+/**
+ * Timestamps are generated by the kernel, or by the network device, once they
+ * have been enabled using the socket_base::timestamping socket option. They
+ * are reported by operations such as
+ * basic_datagram_socket::async_receive_from_timestamped() and
+ * basic_socket::async_receive_tx_timestamp().
+ *
+ * A timestamp that was not generated is reported as zero.
+ */
+struct socket_timestamp
+{
+  /// The point in the data path at which a timestamp is generated.
+  enum kind_type
+  {
+    /// The data was received.
+    received,
+
+    /// Transmitted data entered the packet scheduler.
+    scheduled,
+
+    /// Transmitted data was passed to the network device.
+    sent,
+
+    /// Transmitted data was acknowledged by the peer. TCP only.
+    acknowledged
+  };
+
+  /// The point at which the timestamp was generated.
+  kind_type kind;
+
+  /// The software timestamp, as the time since the system clock's epoch.
+  std::chrono::nanoseconds software;
+
+  /// The raw hardware timestamp from the network device's clock.
+  std::chrono::nanoseconds hardware;
+
+  /// The identifier of the transmitted data.
+  /**
+   * When socket_base::timestamp_opt_id is enabled, this is the byte offset of
+   * the data for stream sockets, or a counter of sent datagrams otherwise.
+   * Zero for received data.
+   */
+  uint32_t id;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_SOCKET_TIMESTAMP_HPP
@@ -0,0 +1,254 @@
+//
+// splice.hpp
+// ~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SPLICE_HPP
+#define ASIO_SPLICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SPLICE) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include "asio/async_result.hpp"
+#include "asio/basic_writable_pipe.hpp"
+#include "asio/buffer.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename Source, typename Dest> class initiate_async_splice;
+template <typename Executor> class initiate_async_vmsplice;
+
+} // namespace detail
+
+/**
+ * @defgroup async_splice asio::async_splice
+ *
+ * @brief The @c async_splice function is a composed asynchronous operation
+ * that moves data from one I/O object to another without copying it through
+ * user space.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to move data from one I/O object to
+/// another.
+/**
+ * This function is used to asynchronously move data from a source I/O object
+ * to a destination I/O object using the Linux @c splice system call, so that
+ * the data is not copied to or from user space. It is an initiating function
+ * for an @ref asynchronous_operation, and always returns immediately.
+ *
+ * The operation reads at most @c max_bytes bytes of the data that is
+ * available from the source, and continues until all of the data that was
+ * read has been written to the destination, or until an error occurs.
+ *
+ * The source may be a basic_stream_socket, a basic_readable_pipe, a
+ * posix::basic_stream_descriptor or a basic_stream_file. The destination may
+ * be a basic_stream_socket, a basic_writable_pipe, a
+ * posix::basic_stream_descriptor or a basic_stream_file. If neither object is
+ * a pipe, the data passes through a pipe that is created for the duration of
+ * the operation. Applications that move data repeatedly between two sockets
+ * may avoid this cost by creating a pipe once, and splicing from the source
+ * socket into the pipe and from the pipe into the destination socket.
+ *
+ * The operation waits for the source or destination to become ready using
+ * the objects' @c async_wait operations, and so works with both the io_uring
+ * and reactor based backends. Sockets are placed into non-blocking mode.
+ * Reads from and writes to files are performed without waiting, and may
+ * block the calling thread while the file's data is read from or written to
+ * the storage device.
+ *
+ * @param source The object from which the data is read. The object must
+ * remain valid until the completion handler is called.
+ *
+ * @param dest The object to which the data is written. The object must remain
+ * valid until the completion handler is called.
+ *
+ * @param max_bytes The maximum number of bytes to be moved.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the operation completes.
+ * Potential completion tokens include @ref use_future, @ref use_awaitable,
+ * @ref yield_context, or a function object with the correct completion
+ * signature. The function signature of the completion handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const asio::error_code& error,
+ *
+ *   // Number of bytes written to the destination. If an error
+ *   // occurred, this will be the number of bytes successfully
+ *   // written prior to the error.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the completion handler will not be invoked from within this function.
+ * On immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::async_immediate().
+ *
+ * @par Completion Signature
+ * @code void(asio::error_code, std::size_t) @endcode
+ *
+ * An error code of asio::error::eof indicates that the source has reached
+ * the end of its data.
+ *
+ * @par Example
+ * @code
+ * asio::async_splice(client_socket, upstream_socket, 65536,
+ *     [](asio::error_code ec, std::size_t n)
+ *     {
+ *       // ...
+ *     });
+ * @endcode
+ *
+ * @par Per-Operation Cancellation
+ * This asynchronous operation supports cancellation for the following
+ * asio::cancellation_type values:
+ *
+ * @li @c cancellation_type::terminal
+ *
+ * If an operation is cancelled after data has been read from the source, any
+ * of that data which has not yet been written to the destination is lost.
+ *
+ * @note This function is available only on Linux.
+ */
+template <typename Source, typename Dest,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) SpliceToken = default_completion_token_t<
+        typename Source::executor_type>>
+inline auto async_splice(Source& source, Dest& dest, std::size_t max_bytes,
+    SpliceToken&& token = default_completion_token_t<
+      typename Source::executor_type>())
+  -> decltype(
+    async_initiate<SpliceToken,
+      void (asio::error_code, std::size_t)>(
+        declval<detail::initiate_async_splice<Source, Dest>>(),
+        token, max_bytes))
+{
+  return async_initiate<SpliceToken,
+    void (asio::error_code, std::size_t)>(
+      detail::initiate_async_splice<Source, Dest>(source, dest),
+      token, max_bytes);
+}
+
+/*@}*/
+
+/**
+ * @defgroup async_vmsplice asio::async_vmsplice
+ *
+ * @brief The @c async_vmsplice function is a composed asynchronous operation
+ * that writes user memory to a pipe without copying it.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to write user memory to a pipe without
+/// copying it.
+/**
+ * This function is used to asynchronously write all of the supplied buffers
+ * to a pipe using the Linux @c vmsplice system call with @c SPLICE_F_GIFT, so
+ * that the pages of memory are referenced by the pipe rather than being
+ * copied into it. It is an initiating function for an @ref
+ * asynchronous_operation, and always returns immediately.
+ *
+ * The operation continues until all of the data has been written, or until
+ * an error occurs. It waits for the pipe to become writable using the pipe's
+ * @c async_wait operation, and so works with both the io_uring and reactor
+ * based backends.
+ *
+ * @param pipe The pipe to which the data is written. The object must remain
+ * valid until the completion handler is called.
+ *
+ * @param buffers One or more buffers containing the data to be written.
+ * Although the buffers object may be copied as necessary, ownership of the
+ * underlying memory blocks is retained by the caller. Since the pipe refers to
+ * the memory itself, the memory must not be modified or freed until the data
+ * has been consumed by the pipe's reader, even after the completion handler is
+ * called. For the pages to be given to the kernel rather than copied, buffers
+ * should begin and end on page boundaries.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the write completes.
+ * Potential completion tokens include @ref use_future, @ref use_awaitable,
+ * @ref yield_context, or a function object with the correct completion
+ * signature. The function signature of the completion handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const asio::error_code& error,
+ *
+ *   // Number of bytes written to the pipe. If an error occurred,
+ *   // this will be the number of bytes successfully written prior
+ *   // to the error.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the completion handler will not be invoked from within this function.
+ * On immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::async_immediate().
+ *
+ * @par Completion Signature
+ * @code void(asio::error_code, std::size_t) @endcode
+ *
+ * @par Example
+ * @code
+ * asio::async_vmsplice(pipe, asio::buffer(pages.data(), pages.size()),
+ *     [](asio::error_code ec, std::size_t n)
+ *     {
+ *       // ...
+ *     });
+ * @endcode
+ *
+ * @par Per-Operation Cancellation
+ * This asynchronous operation supports cancellation for the following
+ * asio::cancellation_type values:
+ *
+ * @li @c cancellation_type::terminal
+ *
+ * @note This function is available only on Linux.
+ */
+template <typename Executor, typename ConstBufferSequence,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) WriteToken = default_completion_token_t<Executor>>
+inline auto async_vmsplice(basic_writable_pipe<Executor>& pipe,
+    const ConstBufferSequence& buffers,
+    WriteToken&& token = default_completion_token_t<Executor>(),
+    constraint_t<
+      is_const_buffer_sequence<ConstBufferSequence>::value
+    > = 0)
+  -> decltype(
+    async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        declval<detail::initiate_async_vmsplice<Executor>>(),
+        token, buffers))
+{
+  return async_initiate<WriteToken,
+    void (asio::error_code, std::size_t)>(
+      detail::initiate_async_vmsplice<Executor>(pipe),
+      token, buffers);
+}
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/splice.hpp"
+
+#endif // defined(ASIO_HAS_SPLICE)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_SPLICE_HPP
@@ -15,12 +15,17 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include "asio/ssl/connection_pool.hpp"
 #include "asio/ssl/context.hpp"
 #include "asio/ssl/context_base.hpp"
+#include "asio/ssl/dtls_acceptor.hpp"
+#include "asio/ssl/dtls_stream.hpp"
 #include "asio/ssl/error.hpp"
 #include "asio/ssl/host_name_verification.hpp"
+#include "asio/ssl/session_cache.hpp"
 #include "asio/ssl/stream.hpp"
 #include "asio/ssl/stream_base.hpp"
+#include "asio/ssl/trust_store.hpp"
 #include "asio/ssl/verify_context.hpp"
 #include "asio/ssl/verify_mode.hpp"
 
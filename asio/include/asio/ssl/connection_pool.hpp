@@ -0,0 +1,101 @@
+//
+// ssl/connection_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_CONNECTION_POOL_HPP
+#define ASIO_SSL_CONNECTION_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <string>
+#include "asio/append.hpp"
+#include "asio/error.hpp"
+#include "asio/post.hpp"
+#include "asio/ip/address.hpp"
+#include "asio/ip/basic_connection_pool.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/ssl/error.hpp"
+#include "asio/ssl/stream.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+
+/// Traits that adapt ssl::stream for use with basic_connection_pool.
+/**
+ * Before the client handshake is performed on a new connection, the host name
+ * is set as the stream's server name indication, and as the name against
+ * which the peer certificate is checked when the context verifies the peer.
+ * Numeric addresses are checked against the certificate's IP addresses and
+ * are not sent as a server name.
+ *
+ * Because the server name identifies the session in an ssl::session_cache,
+ * new connections to a host resume the sessions of earlier connections when
+ * the context uses such a cache.
+ */
+template <typename Stream>
+struct connection_pool_traits<asio::ssl::stream<Stream>>
+{
+  /// Start the client handshake on a newly connected stream.
+  template <typename Handler>
+  static void async_handshake(asio::ssl::stream<Stream>& s,
+      const std::string& host, Handler&& handler)
+  {
+    SSL* ssl = s.native_handle();
+    X509_VERIFY_PARAM* param = SSL_get0_param(ssl);
+
+    asio::error_code ec;
+    asio::ip::make_address(host, ec);
+    int result = ec
+      ? (SSL_set_tlsext_host_name(ssl, host.c_str())
+          && X509_VERIFY_PARAM_set1_host(param, host.c_str(), 0))
+      : X509_VERIFY_PARAM_set1_ip_asc(param, host.c_str());
+    if (result != 1)
+    {
+      ec = asio::error_code(static_cast<int>(::ERR_get_error()),
+          asio::error::get_ssl_category());
+      asio::post(s.get_executor(),
+          asio::append(static_cast<Handler&&>(handler), ec));
+      return;
+    }
+
+    s.async_handshake(asio::ssl::stream_base::client,
+        static_cast<Handler&&>(handler));
+  }
+};
+
+} // namespace ip
+
+namespace ssl {
+
+/// The type of a pool of SSL connections over TCP.
+/**
+ * The pool is constructed from an executor and the ssl::context used by its
+ * streams:
+ *
+ * @code
+ * asio::ssl::context ctx(asio::ssl::context::tls_client);
+ * ctx.set_default_verify_paths();
+ * ctx.set_verify_mode(asio::ssl::verify_peer);
+ * asio::ssl::connection_pool pool(my_context.get_executor(), ctx);
+ * @endcode
+ */
+typedef asio::ip::basic_connection_pool<
+  stream<asio::ip::tcp::socket>> connection_pool;
+
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_SSL_CONNECTION_POOL_HPP
@@ -25,6 +25,7 @@
 #include "asio/ssl/detail/openssl_init.hpp"
 #include "asio/ssl/detail/password_callback.hpp"
 #include "asio/ssl/detail/verify_callback.hpp"
+#include "asio/ssl/session_cache.hpp"
 #include "asio/ssl/verify_mode.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -32,6 +33,8 @@
 namespace asio {
 namespace ssl {
 
+class trust_store;
+
 class context
   : public context_base,
     private noncopyable
@@ -709,7 +712,83 @@ public:
   ASIO_SYNC_OP_VOID set_password_callback(PasswordCallback callback,
       asio::error_code& ec);
 
+  /// Use a session cache that may be shared with other contexts.
+  /**
+   * This function is used to store the sessions established by streams using
+   * the context in the specified cache, and to resume sessions found in the
+   * cache. Sessions established using one context may be resumed by any other
+   * context that uses the same cache.
+   *
+   * @param cache The session cache to be used. The cache must outlive the
+   * context.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Calls @c SSL_CTX_set_session_cache_mode, @c SSL_CTX_sess_set_new_cb,
+   * @c SSL_CTX_sess_set_get_cb, @c SSL_CTX_sess_set_remove_cb and
+   * @c SSL_CTX_set_tlsext_ticket_key_evp_cb, and replaces the session ID
+   * context set using @c SSL_CTX_set_session_id_context.
+   */
+  ASIO_DECL void set_session_cache(session_cache& cache);
+
+  /// Use a session cache that may be shared with other contexts.
+  /**
+   * This function is used to store the sessions established by streams using
+   * the context in the specified cache, and to resume sessions found in the
+   * cache. Sessions established using one context may be resumed by any other
+   * context that uses the same cache.
+   *
+   * @param cache The session cache to be used. The cache must outlive the
+   * context.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note Calls @c SSL_CTX_set_session_cache_mode, @c SSL_CTX_sess_set_new_cb,
+   * @c SSL_CTX_sess_set_get_cb, @c SSL_CTX_sess_set_remove_cb and
+   * @c SSL_CTX_set_tlsext_ticket_key_evp_cb, and replaces the session ID
+   * context set using @c SSL_CTX_set_session_id_context.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID set_session_cache(
+      session_cache& cache, asio::error_code& ec);
+
+  /// Use a trust store that may be shared with other contexts.
+  /**
+   * This function is used to replace the context's own store of certificate
+   * authorities with the specified store. The context holds a reference to
+   * the store, so that the store remains valid for as long as the context
+   * uses it. Chain verifications are cached if the store has a verification
+   * cache.
+   *
+   * @param store The trust store to be used.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Calls @c SSL_CTX_set_cert_store and
+   * @c SSL_CTX_set_cert_verify_callback.
+   */
+  ASIO_DECL void set_trust_store(const trust_store& store);
+
+  /// Use a trust store that may be shared with other contexts.
+  /**
+   * This function is used to replace the context's own store of certificate
+   * authorities with the specified store. The context holds a reference to
+   * the store, so that the store remains valid for as long as the context
+   * uses it. Chain verifications are cached if the store has a verification
+   * cache.
+   *
+   * @param store The trust store to be used.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note Calls @c SSL_CTX_set_cert_store and
+   * @c SSL_CTX_set_cert_verify_callback.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID set_trust_store(
+      const trust_store& store, asio::error_code& ec);
+
 private:
+  friend class trust_store;
+
   struct bio_cleanup;
   struct x509_cleanup;
   struct evp_pkey_cleanup;
@@ -101,7 +101,16 @@ public:
     tls_client,
 
     /// TLS server.
-    tls_server
+    tls_server,
+
+    /// Generic DTLS.
+    dtls,
+
+    /// DTLS client.
+    dtls_client,
+
+    /// DTLS server.
+    dtls_server
   };
 
   /// Bitmask type for SSL options.
@@ -34,6 +34,10 @@ public:
     return "ssl::stream<>::async_buffered_handshake";
   }
 
+  // The engine steps of a handshake may be performed on the stream's
+  // handshake executor.
+  static constexpr bool offloadable = true;
+
   buffered_handshake_op(stream_base::handshake_type type,
       const ConstBufferSequence& buffers)
     : type_(type),
@@ -69,6 +73,14 @@ private:
     Iterator iter = begin;
     std::size_t accumulated_size = 0;
 
+    // An engine attached to a socket reads its input from the socket itself,
+    // so it cannot accept data that has already been read.
+    if (eng.socket_attached() && total_buffer_size_ != 0)
+    {
+      ec = asio::error::operation_not_supported;
+      return engine::want_nothing;
+    }
+
     for (;;)
     {
       engine::want want = eng.handshake(type_, ec);
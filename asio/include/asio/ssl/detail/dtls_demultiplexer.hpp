@@ -0,0 +1,522 @@
+//
+// ssl/detail/dtls_demultiplexer.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_DETAIL_DTLS_DEMULTIPLEXER_HPP
+#define ASIO_SSL_DETAIL_DTLS_DEMULTIPLEXER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include <deque>
+#include <map>
+#include <vector>
+#include "asio/associator.hpp"
+#include "asio/basic_datagram_socket.hpp"
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/buffer.hpp"
+#include "asio/detail/base_from_cancellation_state.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/error.hpp"
+#include "asio/post.hpp"
+#include "asio/ssl/detail/dtls_listener.hpp"
+
+#if defined(ASIO_HAS_SSL_DTLS)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+namespace detail {
+
+// Routes datagrams arriving on a single socket to per-peer queues. Datagrams
+// from an unknown peer go to the listener, and a peer is only created once it
+// has returned a valid cookie. The socket is read only while an accept or a
+// peer receive is waiting for data.
+template <typename Protocol, typename Executor>
+class dtls_demultiplexer
+  : public std::enable_shared_from_this<
+      dtls_demultiplexer<Protocol, Executor>>,
+    private asio::detail::noncopyable
+{
+public:
+  typedef typename Protocol::endpoint endpoint_type;
+  typedef Executor executor_type;
+  typedef basic_datagram_socket<Protocol, Executor> socket_type;
+  typedef basic_waitable_timer<chrono::steady_clock,
+      wait_traits<chrono::steady_clock>, Executor> event_type;
+
+  enum
+  {
+    // The largest datagram that can be received.
+    max_datagram_size = 65536,
+
+    // The number of datagrams held for a peer that is not reading.
+    max_queued_datagrams = 64,
+
+    // The number of verified peers held until they are accepted.
+    max_pending_accepts = 64
+  };
+
+  // The state for one peer. An event timer that never expires is cancelled
+  // to wake operations waiting for a datagram, as with stream_core.
+  struct peer
+  {
+    peer(const executor_type& ex, const endpoint_type& ep)
+      : endpoint(ep),
+        event(ex),
+        cancel_count(0),
+        closed(false)
+    {
+      event.expires_at((event_type::time_point::max)());
+    }
+
+    endpoint_type endpoint;
+    std::deque<std::vector<unsigned char>> queue;
+    event_type event;
+    std::size_t cancel_count;
+    bool closed;
+  };
+
+  // A peer whose cookie has been verified but which is yet to be accepted.
+  struct pending_accept
+  {
+    std::shared_ptr<peer> p;
+    SSL* ssl;
+  };
+
+  dtls_demultiplexer(const executor_type& ex, SSL_CTX* context)
+    : socket_(ex),
+      accept_event_(ex),
+      accept_waiters_(0),
+      receive_waiters_(0),
+      listener_(context),
+      receiving_(false),
+      receive_buffer_(max_datagram_size)
+  {
+    accept_event_.expires_at((event_type::time_point::max)());
+  }
+
+  ~dtls_demultiplexer()
+  {
+    while (!pending_accepts_.empty())
+    {
+      ::SSL_free(pending_accepts_.front().ssl);
+      pending_accepts_.pop_front();
+    }
+  }
+
+  // Close the socket and wake all waiting operations.
+  void close(asio::error_code& ec)
+  {
+    socket_.close(ec);
+    wake_all();
+  }
+
+  // Remove a peer so that its endpoint is handled by the listener again.
+  void remove_peer(const std::shared_ptr<peer>& p)
+  {
+    typename std::map<endpoint_type, std::shared_ptr<peer>>::iterator iter =
+      peers_.find(p->endpoint);
+    if (iter != peers_.end() && iter->second == p)
+      peers_.erase(iter);
+    p->closed = true;
+    p->event.cancel();
+  }
+
+  // Start reading from the socket if an operation is waiting for data.
+  void start_receive()
+  {
+    if (receiving_ || !socket_.is_open()
+        || (accept_waiters_ == 0 && receive_waiters_ == 0))
+      return;
+
+    receiving_ = true;
+    error_ = asio::error_code();
+    socket_.async_receive_from(asio::buffer(receive_buffer_),
+        sender_, receive_handler(this->shared_from_this()));
+  }
+
+  socket_type socket_;
+  std::deque<pending_accept> pending_accepts_;
+  event_type accept_event_;
+  std::size_t accept_waiters_;
+  std::size_t receive_waiters_;
+  asio::error_code error_;
+
+private:
+  struct receive_handler
+  {
+    explicit receive_handler(
+        const std::shared_ptr<dtls_demultiplexer>& self)
+      : self_(self)
+    {
+    }
+
+    void operator()(const asio::error_code& ec, std::size_t length)
+    {
+      self_->handle_receive(ec, length);
+    }
+
+    std::shared_ptr<dtls_demultiplexer> self_;
+  };
+
+  void handle_receive(const asio::error_code& ec, std::size_t length)
+  {
+    receiving_ = false;
+
+    if (ec)
+    {
+      if (ec != asio::error::operation_aborted)
+        error_ = ec;
+      wake_all();
+      return;
+    }
+
+    dispatch(length);
+    start_receive();
+  }
+
+  void dispatch(std::size_t length)
+  {
+    const unsigned char* data = receive_buffer_.data();
+
+    typename std::map<endpoint_type, std::shared_ptr<peer>>::iterator iter =
+      peers_.find(sender_);
+    if (iter != peers_.end())
+    {
+      peer& p = *iter->second;
+      if (p.queue.size() < max_queued_datagrams)
+        p.queue.push_back(std::vector<unsigned char>(data, data + length));
+      p.event.cancel();
+      return;
+    }
+
+    if (pending_accepts_.size() >= max_pending_accepts)
+      return;
+
+    unsigned char output_data[256];
+    asio::mutable_buffer output = asio::buffer(output_data);
+    SSL* ssl = listener_.listen(sender_.data(), sender_.size(),
+        asio::buffer(data, length), output);
+
+    if (output.size() != 0)
+    {
+      // The reply is sent without waiting, as keeping it would make the
+      // exchange stateful. If it cannot be sent the peer will retransmit.
+      asio::error_code ignored_ec;
+      socket_.send_to(output, sender_, 0, ignored_ec);
+    }
+
+    if (ssl)
+    {
+      std::shared_ptr<peer> p(new peer(socket_.get_executor(), sender_));
+
+      // The ClientHello is delivered again to the session's engine.
+      p->queue.push_back(std::vector<unsigned char>(data, data + length));
+
+      peers_[sender_] = p;
+      pending_accept pa = { p, ssl };
+      pending_accepts_.push_back(pa);
+      accept_event_.cancel();
+    }
+  }
+
+  void wake_all()
+  {
+    accept_event_.cancel();
+    for (typename std::map<endpoint_type, std::shared_ptr<peer>>::iterator
+        iter = peers_.begin(); iter != peers_.end(); ++iter)
+      iter->second->event.cancel();
+  }
+
+  dtls_listener listener_;
+  std::map<endpoint_type, std::shared_ptr<peer>> peers_;
+  bool receiving_;
+  std::vector<unsigned char> receive_buffer_;
+  endpoint_type sender_;
+};
+
+template <typename Protocol, typename Executor,
+    typename MutableBufferSequence, typename Handler>
+class dtls_peer_receive_op
+  : public asio::detail::base_from_cancellation_state<Handler>
+{
+public:
+  typedef dtls_demultiplexer<Protocol, Executor> demultiplexer_type;
+  typedef typename demultiplexer_type::peer peer_type;
+
+  dtls_peer_receive_op(const std::shared_ptr<demultiplexer_type>& demux,
+      const std::shared_ptr<peer_type>& p,
+      const MutableBufferSequence& buffers, Handler& handler)
+    : asio::detail::base_from_cancellation_state<Handler>(
+        handler, enable_partial_cancellation()),
+      demux_(demux),
+      peer_(p),
+      buffers_(buffers),
+      cancel_count_(p ? p->cancel_count : 0),
+      start_(0),
+      handler_(static_cast<Handler&&>(handler))
+  {
+  }
+
+  dtls_peer_receive_op(dtls_peer_receive_op&& other)
+    : asio::detail::base_from_cancellation_state<Handler>(
+        static_cast<
+          asio::detail::base_from_cancellation_state<Handler>&&>(other)),
+      demux_(static_cast<std::shared_ptr<demultiplexer_type>&&>(
+            other.demux_)),
+      peer_(static_cast<std::shared_ptr<peer_type>&&>(other.peer_)),
+      buffers_(static_cast<MutableBufferSequence&&>(other.buffers_)),
+      cancel_count_(other.cancel_count_),
+      start_(other.start_),
+      handler_(static_cast<Handler&&>(other.handler_))
+  {
+  }
+
+  void operator()(asio::error_code ec = asio::error_code(), int start = 0)
+  {
+    if (!(start_ = start))
+      --demux_->receive_waiters_;
+
+    std::size_t bytes_transferred = 0;
+    if (!peer_ || (peer_->closed && peer_->queue.empty()))
+    {
+      ec = start ? asio::error::bad_descriptor
+        : asio::error::operation_aborted;
+    }
+    else if (!peer_->queue.empty())
+    {
+      bytes_transferred = asio::buffer_copy(buffers_,
+          asio::buffer(peer_->queue.front()));
+      peer_->queue.pop_front();
+      ec = asio::error_code();
+    }
+    else if (peer_->cancel_count != cancel_count_
+        || this->cancelled() != cancellation_type::none)
+    {
+      ec = asio::error::operation_aborted;
+    }
+    else if (!demux_->socket_.is_open())
+    {
+      ec = start ? asio::error::bad_descriptor
+        : asio::error::operation_aborted;
+    }
+    else if (!start && demux_->error_)
+    {
+      ec = demux_->error_;
+    }
+    else
+    {
+      // Wait until the demultiplexer queues a datagram for this peer.
+      ++demux_->receive_waiters_;
+      demux_->start_receive();
+      event_type& event = peer_->event;
+      event.async_wait(static_cast<dtls_peer_receive_op&&>(*this));
+      return;
+    }
+
+    if (start)
+    {
+      asio::post(demux_->socket_.get_executor(),
+          asio::detail::bind_handler(static_cast<Handler&&>(handler_),
+            ec, bytes_transferred));
+    }
+    else
+    {
+      static_cast<Handler&&>(handler_)(ec, bytes_transferred);
+    }
+  }
+
+//private:
+  typedef typename demultiplexer_type::event_type event_type;
+
+  std::shared_ptr<demultiplexer_type> demux_;
+  std::shared_ptr<peer_type> peer_;
+  MutableBufferSequence buffers_;
+  std::size_t cancel_count_;
+  int start_;
+  Handler handler_;
+};
+
+template <typename Protocol, typename Executor,
+    typename MutableBufferSequence, typename Handler>
+inline bool asio_handler_is_continuation(
+    dtls_peer_receive_op<Protocol, Executor,
+      MutableBufferSequence, Handler>* this_handler)
+{
+  return this_handler->start_ == 0 ? true
+    : asio_handler_cont_helpers::is_continuation(this_handler->handler_);
+}
+
+template <typename Protocol, typename Executor,
+    typename Stream, typename Handler>
+class dtls_accept_op
+  : public asio::detail::base_from_cancellation_state<Handler>
+{
+public:
+  typedef dtls_demultiplexer<Protocol, Executor> demultiplexer_type;
+
+  dtls_accept_op(const std::shared_ptr<demultiplexer_type>& demux,
+      Stream& stream, Handler& handler)
+    : asio::detail::base_from_cancellation_state<Handler>(
+        handler, enable_partial_cancellation()),
+      demux_(demux),
+      stream_(stream),
+      start_(0),
+      handler_(static_cast<Handler&&>(handler))
+  {
+  }
+
+  dtls_accept_op(dtls_accept_op&& other)
+    : asio::detail::base_from_cancellation_state<Handler>(
+        static_cast<
+          asio::detail::base_from_cancellation_state<Handler>&&>(other)),
+      demux_(static_cast<std::shared_ptr<demultiplexer_type>&&>(
+            other.demux_)),
+      stream_(other.stream_),
+      start_(other.start_),
+      handler_(static_cast<Handler&&>(other.handler_))
+  {
+  }
+
+  void operator()(asio::error_code ec = asio::error_code(), int start = 0)
+  {
+    if (!(start_ = start))
+      --demux_->accept_waiters_;
+
+    if (!demux_->pending_accepts_.empty())
+    {
+      typename demultiplexer_type::pending_accept pa =
+        demux_->pending_accepts_.front();
+      demux_->pending_accepts_.pop_front();
+
+      // Replace the stream with one that continues the verified handshake,
+      // keeping the MTU that was configured on it.
+      std::size_t mtu = stream_.mtu();
+      stream_ = Stream(typename Stream::next_layer_type(demux_, pa.p), pa.ssl);
+      stream_.set_mtu(mtu, ec);
+      ec = asio::error_code();
+    }
+    else if (!demux_->socket_.is_open())
+    {
+      ec = start ? asio::error::bad_descriptor
+        : asio::error::operation_aborted;
+    }
+    else if (this->cancelled() != cancellation_type::none)
+    {
+      ec = asio::error::operation_aborted;
+    }
+    else if (!start && demux_->error_)
+    {
+      ec = demux_->error_;
+    }
+    else
+    {
+      // Wait until the demultiplexer verifies a new peer.
+      ++demux_->accept_waiters_;
+      demux_->start_receive();
+      demux_->accept_event_.async_wait(static_cast<dtls_accept_op&&>(*this));
+      return;
+    }
+
+    if (start)
+    {
+      asio::post(demux_->socket_.get_executor(),
+          asio::detail::bind_handler(static_cast<Handler&&>(handler_), ec));
+    }
+    else
+    {
+      static_cast<Handler&&>(handler_)(ec);
+    }
+  }
+
+//private:
+  std::shared_ptr<demultiplexer_type> demux_;
+  Stream& stream_;
+  int start_;
+  Handler handler_;
+};
+
+template <typename Protocol, typename Executor,
+    typename Stream, typename Handler>
+inline bool asio_handler_is_continuation(
+    dtls_accept_op<Protocol, Executor, Stream, Handler>* this_handler)
+{
+  return this_handler->start_ == 0 ? true
+    : asio_handler_cont_helpers::is_continuation(this_handler->handler_);
+}
+
+} // namespace detail
+} // namespace ssl
+
+template <template <typename, typename> class Associator,
+    typename Protocol, typename Executor, typename MutableBufferSequence,
+    typename Handler, typename DefaultCandidate>
+struct associator<Associator,
+    ssl::detail::dtls_peer_receive_op<Protocol,
+      Executor, MutableBufferSequence, Handler>,
+    DefaultCandidate>
+  : Associator<Handler, DefaultCandidate>
+{
+  static typename Associator<Handler, DefaultCandidate>::type get(
+      const ssl::detail::dtls_peer_receive_op<Protocol,
+        Executor, MutableBufferSequence, Handler>& h) noexcept
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static auto get(
+      const ssl::detail::dtls_peer_receive_op<Protocol,
+        Executor, MutableBufferSequence, Handler>& h,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<Handler, DefaultCandidate>::get(h.handler_, c))
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
+template <template <typename, typename> class Associator,
+    typename Protocol, typename Executor, typename Stream,
+    typename Handler, typename DefaultCandidate>
+struct associator<Associator,
+    ssl::detail::dtls_accept_op<Protocol, Executor, Stream, Handler>,
+    DefaultCandidate>
+  : Associator<Handler, DefaultCandidate>
+{
+  static typename Associator<Handler, DefaultCandidate>::type get(
+      const ssl::detail::dtls_accept_op<Protocol,
+        Executor, Stream, Handler>& h) noexcept
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static auto get(
+      const ssl::detail::dtls_accept_op<Protocol,
+        Executor, Stream, Handler>& h,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<Handler, DefaultCandidate>::get(h.handler_, c))
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_SSL_DTLS)
+
+#endif // ASIO_SSL_DETAIL_DTLS_DEMULTIPLEXER_HPP
@@ -0,0 +1,89 @@
+//
+// ssl/detail/dtls_handshake_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_DETAIL_DTLS_HANDSHAKE_OP_HPP
+#define ASIO_SSL_DETAIL_DTLS_HANDSHAKE_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include "asio/error.hpp"
+#include "asio/ssl/detail/engine.hpp"
+
+#if defined(ASIO_HAS_SSL_DTLS)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+namespace detail {
+
+class dtls_handshake_op
+{
+public:
+  static constexpr const char* tracking_name()
+  {
+    return "ssl::dtls_stream<>::async_handshake";
+  }
+
+  dtls_handshake_op(stream_base::handshake_type type)
+    : type_(type)
+  {
+  }
+
+  engine::want operator()(engine& eng,
+      asio::error_code& ec,
+      std::size_t& bytes_transferred) const
+  {
+    bytes_transferred = 0;
+
+    // The transport completes a read with no data when the handshake timer
+    // expires. Give OpenSSL the chance to retransmit its last flight, which
+    // it writes to the engine's output.
+    int result = DTLSv1_handle_timeout(eng.native_handle());
+    if (result > 0)
+    {
+      ec = asio::error_code();
+      return engine::want_output_and_retry;
+    }
+    else if (result < 0)
+    {
+      // Too many retransmissions without a response from the peer.
+      ec = asio::error::timed_out;
+      return engine::want_nothing;
+    }
+
+    return eng.handshake(type_, ec);
+  }
+
+  template <typename Handler>
+  void call_handler(Handler& handler,
+      const asio::error_code& ec,
+      const std::size_t&) const
+  {
+    static_cast<Handler&&>(handler)(ec);
+  }
+
+private:
+  stream_base::handshake_type type_;
+};
+
+} // namespace detail
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_SSL_DTLS)
+
+#endif // ASIO_SSL_DETAIL_DTLS_HANDSHAKE_OP_HPP
@@ -0,0 +1,98 @@
+//
+// ssl/detail/dtls_listener.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_DETAIL_DTLS_LISTENER_HPP
+#define ASIO_SSL_DETAIL_DTLS_LISTENER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include "asio/buffer.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/socket_types.hpp"
+#include "asio/ssl/detail/openssl_types.hpp"
+
+#if defined(ASIO_HAS_SSL_DTLS)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+namespace detail {
+
+// Performs the stateless part of a DTLS server handshake. Datagrams from
+// unknown peers are passed to DTLSv1_listen, which answers a ClientHello that
+// has no valid cookie with a HelloVerifyRequest and keeps no per-peer state.
+// Cookies are an HMAC of the peer's address under a per-listener secret.
+class dtls_listener
+  : private asio::detail::noncopyable
+{
+public:
+  // The size of the cookie secret, in bytes.
+  enum { secret_size = 32 };
+
+  // Construct a listener that installs cookie callbacks on the context.
+  ASIO_DECL explicit dtls_listener(SSL_CTX* context);
+
+  // Destructor.
+  ASIO_DECL ~dtls_listener();
+
+  // Pass a datagram received from the given peer address to DTLSv1_listen.
+  // Any HelloVerifyRequest to be sent back is copied into the output buffer,
+  // which is updated to refer to it. Returns an SSL object, ready to continue
+  // the handshake, when the datagram is a ClientHello with a valid cookie.
+  // Ownership of the SSL object passes to the caller. Otherwise returns null.
+  ASIO_DECL SSL* listen(const void* peer, std::size_t peer_size,
+      const asio::const_buffer& datagram, asio::mutable_buffer& output);
+
+private:
+  // Create the SSL object used for listening.
+  ASIO_DECL bool create_listen_ssl();
+
+  // Compute the cookie for the current peer.
+  ASIO_DECL bool compute_cookie(unsigned char* cookie,
+      unsigned int* cookie_length) const;
+
+  // The index used to associate a listener with its SSL object.
+  ASIO_DECL static int ex_data_index();
+
+  // Callback used by OpenSSL to generate a cookie.
+  ASIO_DECL static int generate_cookie_function(SSL* ssl,
+      unsigned char* cookie, unsigned int* cookie_length);
+
+  // Callback used by OpenSSL to verify a cookie.
+  ASIO_DECL static int verify_cookie_function(SSL* ssl,
+      const unsigned char* cookie, unsigned int cookie_length);
+
+  SSL_CTX* context_;
+  SSL* ssl_;
+  BIO* input_bio_;
+  BIO* output_bio_;
+  unsigned char secret_[secret_size];
+  unsigned char peer_[sizeof(asio::detail::sockaddr_storage_type)];
+  std::size_t peer_size_;
+};
+
+} // namespace detail
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/ssl/detail/impl/dtls_listener.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // defined(ASIO_HAS_SSL_DTLS)
+
+#endif // ASIO_SSL_DETAIL_DTLS_LISTENER_HPP
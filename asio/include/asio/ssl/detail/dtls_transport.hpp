@@ -0,0 +1,423 @@
+//
+// ssl/detail/dtls_transport.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_DETAIL_DTLS_TRANSPORT_HPP
+#define ASIO_SSL_DETAIL_DTLS_TRANSPORT_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include <vector>
+#include "asio/associator.hpp"
+#include "asio/buffer.hpp"
+#include "asio/cancel_after.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/error.hpp"
+#include "asio/post.hpp"
+#include "asio/ssl/detail/openssl_types.hpp"
+#include "asio/steady_timer.hpp"
+
+#if defined(ASIO_HAS_SSL_DTLS)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+namespace detail {
+
+// Adapts a datagram socket so that the SSL engine can use it as a stream. The
+// engine's output is a sequence of DTLS records, which are packed into
+// datagrams of no more than the path MTU. Each read returns one datagram.
+//
+// While a handshake is in progress, an asynchronous read is cancelled when
+// OpenSSL's retransmission timer expires, and completes successfully with no
+// data so that the handshake operation can retransmit. Synchronous reads do
+// not time out.
+template <typename Stream>
+class dtls_transport
+{
+public:
+  // The type of the next layer.
+  typedef remove_reference_t<Stream> next_layer_type;
+
+  // The type of the executor associated with the object.
+  typedef typename next_layer_type::executor_type executor_type;
+
+  // The size of the header that precedes every DTLS record.
+  enum { record_header_size = 13 };
+
+  template <typename Arg>
+  dtls_transport(Arg&& arg, SSL* ssl, std::size_t mtu)
+    : next_layer_(static_cast<Arg&&>(arg)),
+      ssl_(ssl),
+      timer_(next_layer_.get_executor()),
+      mtu_(mtu)
+  {
+  }
+
+  dtls_transport(dtls_transport&& other)
+    : next_layer_(static_cast<Stream&&>(other.next_layer_)),
+      ssl_(other.ssl_),
+      timer_(static_cast<asio::steady_timer&&>(other.timer_)),
+      mtu_(other.mtu_),
+      pending_output_(
+          static_cast<std::vector<unsigned char>&&>(other.pending_output_))
+  {
+  }
+
+  dtls_transport& operator=(dtls_transport&& other)
+  {
+    if (this != &other)
+    {
+      next_layer_ = static_cast<Stream&&>(other.next_layer_);
+      ssl_ = other.ssl_;
+      timer_ = static_cast<asio::steady_timer&&>(other.timer_);
+      mtu_ = other.mtu_;
+      pending_output_ =
+        static_cast<std::vector<unsigned char>&&>(other.pending_output_);
+    }
+    return *this;
+  }
+
+  executor_type get_executor() noexcept
+  {
+    return next_layer_.get_executor();
+  }
+
+  next_layer_type& next_layer()
+  {
+    return next_layer_;
+  }
+
+  const next_layer_type& next_layer() const
+  {
+    return next_layer_;
+  }
+
+  std::size_t mtu() const
+  {
+    return mtu_;
+  }
+
+  void set_mtu(std::size_t mtu)
+  {
+    mtu_ = mtu;
+  }
+
+  void set_native_handle(SSL* ssl)
+  {
+    ssl_ = ssl;
+  }
+
+  // Receive a single datagram.
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    return next_layer_.receive(buffers, 0, ec);
+  }
+
+  // Send all complete records in the data and hold on to any incomplete one.
+  template <typename ConstBufferSequence>
+  std::size_t write_some(const ConstBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    std::size_t bytes_transferred = append_output(buffers);
+    for (asio::const_buffer datagram = next_datagram();
+        datagram.size() != 0; datagram = next_datagram())
+    {
+      next_layer_.send(asio::buffer(datagram), 0, ec);
+      if (ec)
+        return 0;
+      consume_output(datagram.size());
+    }
+
+    ec = asio::error_code();
+    return bytes_transferred;
+  }
+
+  template <typename MutableBufferSequence, typename ReadHandler>
+  void async_read_some(const MutableBufferSequence& buffers,
+      ReadHandler&& handler);
+
+  template <typename ConstBufferSequence, typename WriteHandler>
+  void async_write_some(const ConstBufferSequence& buffers,
+      WriteHandler&& handler);
+
+  // Append data from the engine to the pending output.
+  template <typename ConstBufferSequence>
+  std::size_t append_output(const ConstBufferSequence& buffers)
+  {
+    std::size_t length = asio::buffer_size(buffers);
+    std::size_t offset = pending_output_.size();
+    pending_output_.resize(offset + length);
+    return asio::buffer_copy(
+        asio::buffer(pending_output_.data() + offset, length), buffers);
+  }
+
+  // Get the largest run of complete records at the start of the pending output
+  // that fits in one datagram. A record larger than the MTU is sent alone.
+  asio::const_buffer next_datagram() const
+  {
+    const unsigned char* data = pending_output_.data();
+    std::size_t size = pending_output_.size();
+    std::size_t length = 0;
+    while (size - length >= record_header_size)
+    {
+      std::size_t record_size = record_header_size
+        + ((static_cast<std::size_t>(data[length + 11]) << 8)
+            | data[length + 12]);
+      if (size - length < record_size)
+        break;
+      if (length > 0 && length + record_size > mtu_)
+        break;
+      length += record_size;
+    }
+    return asio::const_buffer(data, length);
+  }
+
+  // Remove sent data from the start of the pending output.
+  void consume_output(std::size_t length)
+  {
+    pending_output_.erase(pending_output_.begin(),
+        pending_output_.begin() + length);
+  }
+
+  // Determine whether a read was cancelled by the retransmission timer.
+  bool is_timeout(const asio::error_code& ec) const
+  {
+    return ec == asio::error::operation_aborted
+      && timer_.expiry() <= asio::steady_timer::clock_type::now();
+  }
+
+private:
+  Stream next_layer_;
+  SSL* ssl_;
+  asio::steady_timer timer_;
+  std::size_t mtu_;
+  std::vector<unsigned char> pending_output_;
+};
+
+template <typename Stream, typename Handler>
+class dtls_transport_read_op
+{
+public:
+  dtls_transport_read_op(dtls_transport<Stream>& transport, Handler& handler)
+    : transport_(transport),
+      handler_(static_cast<Handler&&>(handler))
+  {
+  }
+
+  dtls_transport_read_op(dtls_transport_read_op&& other)
+    : transport_(other.transport_),
+      handler_(static_cast<Handler&&>(other.handler_))
+  {
+  }
+
+  void operator()(asio::error_code ec, std::size_t bytes_transferred)
+  {
+    // A timeout is reported as an empty read so that the handshake can
+    // retransmit and try again.
+    if (transport_.is_timeout(ec))
+    {
+      ec = asio::error_code();
+      bytes_transferred = 0;
+    }
+
+    static_cast<Handler&&>(handler_)(ec, bytes_transferred);
+  }
+
+//private:
+  dtls_transport<Stream>& transport_;
+  Handler handler_;
+};
+
+template <typename Stream, typename Handler>
+inline bool asio_handler_is_continuation(
+    dtls_transport_read_op<Stream, Handler>* this_handler)
+{
+  return asio_handler_cont_helpers::is_continuation(this_handler->handler_);
+}
+
+template <typename Stream, typename Handler>
+class dtls_transport_write_op
+{
+public:
+  dtls_transport_write_op(dtls_transport<Stream>& transport,
+      std::size_t bytes_transferred, Handler& handler)
+    : transport_(transport),
+      bytes_transferred_(bytes_transferred),
+      start_(0),
+      handler_(static_cast<Handler&&>(handler))
+  {
+  }
+
+  dtls_transport_write_op(dtls_transport_write_op&& other)
+    : transport_(other.transport_),
+      bytes_transferred_(other.bytes_transferred_),
+      start_(other.start_),
+      handler_(static_cast<Handler&&>(other.handler_))
+  {
+  }
+
+  void operator()(asio::error_code ec,
+      std::size_t bytes_sent = 0, int start = 0)
+  {
+    if (!(start_ = start))
+    {
+      if (ec)
+      {
+        static_cast<Handler&&>(handler_)(ec, std::size_t(0));
+        return;
+      }
+
+      transport_.consume_output(bytes_sent);
+    }
+
+    asio::const_buffer datagram = transport_.next_datagram();
+    if (datagram.size() != 0)
+    {
+      transport_.next_layer().async_send(asio::buffer(datagram),
+          static_cast<dtls_transport_write_op&&>(*this));
+    }
+    else if (start)
+    {
+      // Nothing complete to send yet. The data is held until the rest of
+      // the record arrives, but the handler must not run inside the
+      // initiating function.
+      asio::post(transport_.get_executor(),
+          asio::detail::bind_handler(static_cast<Handler&&>(handler_),
+            asio::error_code(), bytes_transferred_));
+    }
+    else
+    {
+      static_cast<Handler&&>(handler_)(ec, bytes_transferred_);
+    }
+  }
+
+//private:
+  dtls_transport<Stream>& transport_;
+  std::size_t bytes_transferred_;
+  int start_;
+  Handler handler_;
+};
+
+template <typename Stream, typename Handler>
+inline bool asio_handler_is_continuation(
+    dtls_transport_write_op<Stream, Handler>* this_handler)
+{
+  return this_handler->start_ == 0 ? true
+    : asio_handler_cont_helpers::is_continuation(this_handler->handler_);
+}
+
+template <typename Stream>
+template <typename MutableBufferSequence, typename ReadHandler>
+void dtls_transport<Stream>::async_read_some(
+    const MutableBufferSequence& buffers, ReadHandler&& handler)
+{
+  typedef decay_t<ReadHandler> handler_type;
+
+  // A datagram socket waits for a datagram even when the buffer is empty, but
+  // the engine uses an empty read to defer completion of its own operations.
+  if (asio::buffer_size(buffers) == 0)
+  {
+    asio::post(next_layer_.get_executor(),
+        asio::detail::bind_handler(static_cast<ReadHandler&&>(handler),
+          asio::error_code(), std::size_t(0)));
+    return;
+  }
+
+  struct timeval timeout;
+  if (ssl_ && DTLSv1_get_timeout(ssl_, &timeout) > 0)
+  {
+    handler_type handler2(static_cast<ReadHandler&&>(handler));
+    next_layer_.async_receive(buffers,
+        asio::cancel_after(timer_,
+          asio::chrono::seconds(timeout.tv_sec)
+            + asio::chrono::microseconds(timeout.tv_usec),
+          dtls_transport_read_op<Stream, handler_type>(*this, handler2)));
+  }
+  else
+  {
+    next_layer_.async_receive(buffers, static_cast<ReadHandler&&>(handler));
+  }
+}
+
+template <typename Stream>
+template <typename ConstBufferSequence, typename WriteHandler>
+void dtls_transport<Stream>::async_write_some(
+    const ConstBufferSequence& buffers, WriteHandler&& handler)
+{
+  typedef decay_t<WriteHandler> handler_type;
+
+  handler_type handler2(static_cast<WriteHandler&&>(handler));
+  dtls_transport_write_op<Stream, handler_type>(
+      *this, append_output(buffers), handler2)(
+        asio::error_code(), 0, 1);
+}
+
+} // namespace detail
+} // namespace ssl
+
+template <template <typename, typename> class Associator,
+    typename Stream, typename Handler, typename DefaultCandidate>
+struct associator<Associator,
+    ssl::detail::dtls_transport_read_op<Stream, Handler>,
+    DefaultCandidate>
+  : Associator<Handler, DefaultCandidate>
+{
+  static typename Associator<Handler, DefaultCandidate>::type get(
+      const ssl::detail::dtls_transport_read_op<Stream, Handler>& h) noexcept
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static auto get(const ssl::detail::dtls_transport_read_op<Stream, Handler>& h,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<Handler, DefaultCandidate>::get(h.handler_, c))
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
+template <template <typename, typename> class Associator,
+    typename Stream, typename Handler, typename DefaultCandidate>
+struct associator<Associator,
+    ssl::detail::dtls_transport_write_op<Stream, Handler>,
+    DefaultCandidate>
+  : Associator<Handler, DefaultCandidate>
+{
+  static typename Associator<Handler, DefaultCandidate>::type get(
+      const ssl::detail::dtls_transport_write_op<Stream, Handler>& h) noexcept
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static auto get(
+      const ssl::detail::dtls_transport_write_op<Stream, Handler>& h,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<Handler, DefaultCandidate>::get(h.handler_, c))
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_SSL_DTLS)
+
+#endif // ASIO_SSL_DETAIL_DTLS_TRANSPORT_HPP
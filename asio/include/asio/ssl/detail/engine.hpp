@@ -17,7 +17,12 @@
 
 #include "asio/detail/config.hpp"
 
+#include <string>
 #include "asio/buffer.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/huge_page_arena.hpp"
+#include "asio/detail/memory_metrics.hpp"
+#include "asio/detail/socket_types.hpp"
 #include "asio/detail/static_mutex.hpp"
 #include "asio/ssl/detail/openssl_types.hpp"
 #include "asio/ssl/detail/verify_callback.hpp"
@@ -35,6 +40,16 @@ class engine
 public:
   enum want
   {
+    // Returned by functions to indicate that the engine is attached to a
+    // socket, and that the socket must become ready to read before the
+    // operation is retried.
+    want_readable_and_retry = -4,
+
+    // Returned by functions to indicate that the engine is attached to a
+    // socket, and that the socket must become ready to write before the
+    // operation is retried.
+    want_writable_and_retry = -3,
+
     // Returned by functions to indicate that the engine wants input. The input
     // buffer should be updated to point to the data. The engine then needs to
     // be called again to retry the operation.
@@ -73,6 +88,28 @@ public:
   // Get the underlying implementation in the native type.
   ASIO_DECL SSL* native_handle();
 
+  // Attach the SSL implementation directly to a socket in place of the BIO
+  // pair, and request that record processing be offloaded to the kernel. Must
+  // be called before the handshake starts.
+  ASIO_DECL asio::error_code attach_socket(
+      asio::detail::socket_type s, asio::error_code& ec);
+
+  // Determine whether the engine is attached directly to a socket.
+  ASIO_DECL bool socket_attached() const;
+
+  // Determine whether the kernel encrypts records sent on the socket.
+  ASIO_DECL bool ktls_send() const;
+
+  // Determine whether the kernel decrypts records received on the socket.
+  ASIO_DECL bool ktls_receive() const;
+
+  // Set the key under which a client session is stored in a session cache.
+  ASIO_DECL asio::error_code set_session_cache_key(
+      const std::string& key, asio::error_code& ec);
+
+  // Determine whether the handshake resumed an earlier session.
+  ASIO_DECL bool session_reused() const;
+
   // Set the peer verification mode.
   ASIO_DECL asio::error_code set_verify_mode(
       verify_mode v, asio::error_code& ec);
@@ -97,18 +134,77 @@ public:
   ASIO_DECL want write(const asio::const_buffer& data,
       asio::error_code& ec, std::size_t& bytes_transferred);
 
+  // Enable or disable dynamic record sizing. When enabled, writes are limited
+  // to small records at the start of the session and after it has been idle.
+  ASIO_DECL void set_dynamic_record_sizing(bool enabled);
+
+  // Determine whether dynamic record sizing is enabled.
+  ASIO_DECL bool dynamic_record_sizing() const;
+
+#if defined(ASIO_HAS_HUGE_PAGES)
+  // Allocate the buffers that are not found in the pool from the specified
+  // arena, or from the system allocator if the arena is null.
+  void use_huge_page_arena(asio::detail::huge_page_arena* arena)
+  {
+    huge_page_arena_ = arena;
+  }
+#endif // defined(ASIO_HAS_HUGE_PAGES)
+
+  // Record the engine's buffers in the specified counters, if not null.
+  void use_memory_metrics(asio::detail::memory_metrics* metrics)
+  {
+    memory_metrics_ = metrics;
+  }
+
+  // Get the largest amount of data that should be passed to the next call to
+  // write(), so that it is encrypted into a record of the current size.
+  ASIO_DECL std::size_t write_size_limit();
+
   // Read bytes from the SSL session.
   ASIO_DECL want read(const asio::mutable_buffer& data,
       asio::error_code& ec, std::size_t& bytes_transferred);
 
-  // Get output data to be written to the transport.
-  ASIO_DECL asio::mutable_buffer get_output(
-      const asio::mutable_buffer& data);
+  // Get the output data to be written to the transport. The buffer refers to
+  // the engine's own storage, and remains valid until consume_output() is
+  // called. Output produced while a write is in progress is appended after it.
+  ASIO_DECL asio::const_buffer get_output() const;
+
+  // Remove output data that has been written to the transport.
+  ASIO_DECL void consume_output(std::size_t length);
+
+  // Get the number of bytes of output that can be produced before the output
+  // buffer is full.
+  ASIO_DECL std::size_t output_space() const;
 
-  // Put input data that was read from the transport.
+  // Get the capacity of the output buffer.
+  ASIO_DECL std::size_t output_buffer_size() const;
+
+  // Set the capacity of the output buffer. The size is rounded up to the size
+  // of the largest possible TLS record. Fails with error::in_progress if there
+  // is output waiting to be written.
+  ASIO_DECL asio::error_code set_output_buffer_size(
+      std::size_t size, asio::error_code& ec);
+
+  // Get the space into which input data should be read from the transport.
+  // Must not be called while a read into previously obtained space is still
+  // in progress. The input buffer is obtained from the pool if the engine does
+  // not hold one.
+  ASIO_DECL asio::mutable_buffer get_input_space();
+
+  // Make input data, read into the space returned by get_input_space(),
+  // available to the engine.
+  ASIO_DECL void commit_input(std::size_t length);
+
+  // Copy input data that was read from the transport into the engine. Returns
+  // the portion of the data that did not fit.
   ASIO_DECL asio::const_buffer put_input(
       const asio::const_buffer& data);
 
+  // Return the input and output buffers to the pool if they hold no data and
+  // no read into the input space is in progress. Called when an operation
+  // completes, so that an idle engine holds no buffers.
+  ASIO_DECL void release_buffers();
+
   // Map an error::eof code returned by the underlying transport according to
   // the type and state of the SSL session. Returns a const reference to the
   // error code object, suitable for passing to a completion handler.
@@ -124,6 +220,48 @@ private:
   ASIO_DECL static int verify_callback_function(
       int preverified, X509_STORE_CTX* ctx);
 
+  // Create the BIO through which the SSL implementation reads its input from,
+  // and writes its output to, the engine's buffers.
+  ASIO_DECL void create_bio();
+
+  // Get the method that implements the engine's BIO.
+  ASIO_DECL static BIO_METHOD* bio_method();
+
+  // BIO method callbacks.
+  ASIO_DECL static int bio_write(BIO* b, const char* data, int length);
+  ASIO_DECL static int bio_read(BIO* b, char* data, int length);
+  ASIO_DECL static long bio_ctrl(BIO* b, int cmd, long num, void* ptr);
+  ASIO_DECL static int bio_create(BIO* b);
+  ASIO_DECL static int bio_destroy(BIO* b);
+
+  // Associate a BIO with an engine.
+  ASIO_DECL static void set_bio_engine(BIO* b, engine* e);
+
+  // Get the engine associated with a BIO.
+  ASIO_DECL static engine* get_bio_engine(BIO* b);
+
+  // A list of free buffers of the default size, linked through their first
+  // bytes, shared by all engines.
+  struct buffer_pool
+  {
+    void* head_;
+    std::size_t count_;
+  };
+
+  // Get the pool of free buffers, and the mutex that protects it.
+  ASIO_DECL static buffer_pool& get_buffer_pool();
+  ASIO_DECL static asio::detail::static_mutex& buffer_pool_mutex();
+
+  // Allocate a buffer, taking it from the pool if it is of the default size.
+  // Returns null on failure.
+  ASIO_DECL unsigned char* allocate_buffer(std::size_t size);
+
+  // Free a buffer, keeping it in the pool if it is of the default size.
+  ASIO_DECL void deallocate_buffer(unsigned char* p, std::size_t size);
+
+  // Ensure that the output buffer is allocated. Returns false on failure.
+  ASIO_DECL bool allocate_output_buffer();
+
 #if (OPENSSL_VERSION_NUMBER < 0x10000000L)
   // The SSL_accept function may not be thread safe. This mutex is used to
   // protect all calls to the SSL_accept function.
@@ -137,6 +275,13 @@ private:
       void* data, std::size_t length, asio::error_code& ec,
       std::size_t* bytes_transferred);
 
+  // Perform one operation when the engine is attached directly to a socket.
+  // Returns want_readable_and_retry or want_writable_and_retry if the socket
+  // must become ready before the operation can continue.
+  ASIO_DECL want perform_on_socket(int (engine::* op)(void*, std::size_t),
+      void* data, std::size_t length, asio::error_code& ec,
+      std::size_t* bytes_transferred);
+
   // Adapt the SSL_accept function to the signature needed for perform().
   ASIO_DECL int do_accept(void*, std::size_t);
 
@@ -152,8 +297,69 @@ private:
   // Adapt the SSL_write function to the signature needed for perform().
   ASIO_DECL int do_write(void* data, std::size_t length);
 
+  // The default size of each of the engine's buffers. This is sufficient to
+  // hold the largest possible TLS record.
+  enum { buffer_size = 17 * 1024 };
+
+  // The maximum number of free buffers kept in the pool.
+  enum { max_pooled_buffers = 256 };
+
+  // The amount of data carried by each record while record sizes are reduced.
+  // The record, with its header and encryption overhead, fits in a single TCP
+  // segment on a typical network path.
+  enum { small_record_size = 1400 };
+
+  // The amount of data written in small records before records grow to the
+  // full size.
+  enum { small_record_threshold = 1024 * 1024 };
+
+  // The time for which the session must be idle before record sizes are
+  // reduced again.
+  enum { small_record_idle_ms = 1000 };
+
   SSL* ssl_;
-  BIO* ext_bio_;
+
+  // The BIO attached to the SSL implementation, or null if the engine has
+  // been attached directly to a socket.
+  BIO* bio_;
+
+  // Input read from the transport. The bytes between input_begin_ and
+  // input_end_ have not yet been consumed by the SSL implementation. The
+  // buffer holds buffer_size bytes, and is null while the engine is idle.
+  unsigned char* input_buffer_;
+  std::size_t input_begin_;
+  std::size_t input_end_;
+
+  // Whether a read into the input space is in progress.
+  bool input_space_in_use_;
+
+  // Output to be written to the transport. The bytes between output_begin_
+  // and output_end_ have not yet been written. The buffer holds
+  // output_buffer_size_ bytes, and is null while the engine is idle.
+  unsigned char* output_buffer_;
+  std::size_t output_buffer_size_;
+  std::size_t output_begin_;
+  std::size_t output_end_;
+
+  // Whether dynamic record sizing is enabled, the amount of data written
+  // since record sizes were last reduced, and the time of the last write.
+  bool dynamic_record_sizing_;
+  std::size_t dynamic_record_bytes_;
+  asio::chrono::steady_clock::time_point last_write_time_;
+
+  // Whether the SSL implementation requires the last write to be retried, in
+  // which case the retry must not pass less data.
+  bool write_retry_;
+
+#if defined(ASIO_HAS_HUGE_PAGES)
+  // The arena from which new buffers are allocated, or null to use the system
+  // allocator.
+  asio::detail::huge_page_arena* huge_page_arena_;
+#endif // defined(ASIO_HAS_HUGE_PAGES)
+
+  // The counters in which the buffers are recorded, or null if they are
+  // disabled.
+  asio::detail::memory_metrics* memory_metrics_;
 };
 
 } // namespace detail
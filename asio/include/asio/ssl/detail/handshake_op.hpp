@@ -33,6 +33,10 @@ public:
     return "ssl::stream<>::async_handshake";
   }
 
+  // The engine steps of a handshake may be performed on the stream's
+  // handshake executor.
+  static constexpr bool offloadable = true;
+
   handshake_op(stream_base::handshake_type type)
     : type_(type)
   {
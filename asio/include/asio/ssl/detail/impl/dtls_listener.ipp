@@ -0,0 +1,204 @@
+//
+// ssl/detail/impl/dtls_listener.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_DETAIL_IMPL_DTLS_LISTENER_IPP
+#define ASIO_SSL_DETAIL_IMPL_DTLS_LISTENER_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include <cstring>
+#include "asio/detail/throw_error.hpp"
+#include "asio/error.hpp"
+#include "asio/ssl/detail/dtls_listener.hpp"
+#include "asio/ssl/error.hpp"
+
+#if defined(ASIO_HAS_SSL_DTLS)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+namespace detail {
+
+dtls_listener::dtls_listener(SSL_CTX* context)
+  : context_(context),
+    ssl_(0),
+    input_bio_(0),
+    output_bio_(0),
+    peer_size_(0)
+{
+  if (::RAND_bytes(secret_, secret_size) != 1)
+  {
+    asio::error_code ec(
+        static_cast<int>(::ERR_get_error()),
+        asio::error::get_ssl_category());
+    asio::detail::throw_error(ec, "dtls_listener");
+  }
+
+  ::SSL_CTX_set_cookie_generate_cb(context_,
+      &dtls_listener::generate_cookie_function);
+  ::SSL_CTX_set_cookie_verify_cb(context_,
+      &dtls_listener::verify_cookie_function);
+
+  if (!create_listen_ssl())
+  {
+    asio::error_code ec(
+        static_cast<int>(::ERR_get_error()),
+        asio::error::get_ssl_category());
+    asio::detail::throw_error(ec, "dtls_listener");
+  }
+}
+
+dtls_listener::~dtls_listener()
+{
+  if (ssl_)
+    ::SSL_free(ssl_);
+  ::OPENSSL_cleanse(secret_, secret_size);
+}
+
+SSL* dtls_listener::listen(const void* peer, std::size_t peer_size,
+    const asio::const_buffer& datagram, asio::mutable_buffer& output)
+{
+  if (!ssl_ && !create_listen_ssl())
+  {
+    output = asio::buffer(output, 0);
+    return 0;
+  }
+
+  peer_size_ = peer_size < sizeof(peer_) ? peer_size : sizeof(peer_);
+  std::memcpy(peer_, peer, peer_size_);
+
+  ::BIO_write(input_bio_, datagram.data(),
+      static_cast<int>(datagram.size()));
+
+  BIO_ADDR* client = ::BIO_ADDR_new();
+  ::ERR_clear_error();
+  int result = client ? ::DTLSv1_listen(ssl_, client) : -1;
+  ::BIO_ADDR_free(client);
+
+  // Collect any HelloVerifyRequest, then discard whatever DTLSv1_listen did
+  // not consume so that nothing carries over to the next peer.
+  int length = ::BIO_read(output_bio_,
+      output.data(), static_cast<int>(output.size()));
+  output = asio::buffer(output,
+      length > 0 ? static_cast<std::size_t>(length) : 0);
+  (void)BIO_reset(input_bio_);
+  (void)BIO_reset(output_bio_);
+
+  if (result > 0)
+  {
+    // The cookie was valid. The SSL object now expects the ClientHello to be
+    // delivered again, this time through its own transport. The cookie has
+    // already been checked, and the listener may not outlive the session.
+    SSL* ssl = ssl_;
+    ::SSL_set_ex_data(ssl, ex_data_index(), 0);
+    ::SSL_clear_options(ssl, SSL_OP_COOKIE_EXCHANGE);
+    ssl_ = 0;
+    input_bio_ = 0;
+    output_bio_ = 0;
+    return ssl;
+  }
+
+  if (result < 0)
+  {
+    // A fatal error leaves the SSL object unusable. A new one is created for
+    // the next datagram.
+    ::SSL_free(ssl_);
+    ssl_ = 0;
+    input_bio_ = 0;
+    output_bio_ = 0;
+  }
+
+  return 0;
+}
+
+bool dtls_listener::create_listen_ssl()
+{
+  ssl_ = ::SSL_new(context_);
+  if (!ssl_)
+    return false;
+
+  input_bio_ = ::BIO_new(::BIO_s_mem());
+  output_bio_ = ::BIO_new(::BIO_s_mem());
+  if (!input_bio_ || !output_bio_)
+  {
+    if (input_bio_)
+      ::BIO_free(input_bio_);
+    if (output_bio_)
+      ::BIO_free(output_bio_);
+    ::SSL_free(ssl_);
+    ssl_ = 0;
+    input_bio_ = 0;
+    output_bio_ = 0;
+    return false;
+  }
+
+  // An empty input BIO asks to be retried, so DTLSv1_listen returns after
+  // each datagram rather than treating the end of input as an error.
+  BIO_set_mem_eof_return(input_bio_, -1);
+  ::SSL_set_bio(ssl_, input_bio_, output_bio_);
+
+  ::SSL_set_options(ssl_, SSL_OP_COOKIE_EXCHANGE);
+  ::SSL_set_accept_state(ssl_);
+  ::SSL_set_ex_data(ssl_, ex_data_index(), this);
+  return true;
+}
+
+bool dtls_listener::compute_cookie(unsigned char* cookie,
+    unsigned int* cookie_length) const
+{
+  return ::HMAC(::EVP_sha256(), secret_, secret_size,
+      peer_, peer_size_, cookie, cookie_length) != 0;
+}
+
+int dtls_listener::ex_data_index()
+{
+  static const int index = ::SSL_get_ex_new_index(0, 0, 0, 0, 0);
+  return index;
+}
+
+int dtls_listener::generate_cookie_function(SSL* ssl,
+    unsigned char* cookie, unsigned int* cookie_length)
+{
+  dtls_listener* self = static_cast<dtls_listener*>(
+      ::SSL_get_ex_data(ssl, ex_data_index()));
+  return self && self->compute_cookie(cookie, cookie_length) ? 1 : 0;
+}
+
+int dtls_listener::verify_cookie_function(SSL* ssl,
+    const unsigned char* cookie, unsigned int cookie_length)
+{
+  dtls_listener* self = static_cast<dtls_listener*>(
+      ::SSL_get_ex_data(ssl, ex_data_index()));
+  if (!self)
+    return 0;
+
+  unsigned char expected[EVP_MAX_MD_SIZE];
+  unsigned int expected_length = 0;
+  if (!self->compute_cookie(expected, &expected_length))
+    return 0;
+
+  return cookie_length == expected_length
+    && ::CRYPTO_memcmp(cookie, expected, expected_length) == 0 ? 1 : 0;
+}
+
+} // namespace detail
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_SSL_DTLS)
+
+#endif // ASIO_SSL_DETAIL_IMPL_DTLS_LISTENER_IPP
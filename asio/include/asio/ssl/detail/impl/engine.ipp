@@ -17,10 +17,16 @@
 
 #include "asio/detail/config.hpp"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
 #include "asio/detail/throw_error.hpp"
+#include "asio/detail/throw_exception.hpp"
 #include "asio/error.hpp"
 #include "asio/ssl/detail/engine.hpp"
 #include "asio/ssl/error.hpp"
+#include "asio/ssl/session_cache.hpp"
 #include "asio/ssl/verify_context.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -30,7 +36,24 @@ namespace ssl {
 namespace detail {
 
 engine::engine(SSL_CTX* context)
-  : ssl_(::SSL_new(context))
+  : ssl_(::SSL_new(context)),
+    bio_(0),
+    input_buffer_(0),
+    input_begin_(0),
+    input_end_(0),
+    input_space_in_use_(false),
+    output_buffer_(0),
+    output_buffer_size_(buffer_size),
+    output_begin_(0),
+    output_end_(0),
+    dynamic_record_sizing_(false),
+    dynamic_record_bytes_(0),
+    last_write_time_(),
+    write_retry_(false)
+#if defined(ASIO_HAS_HUGE_PAGES)
+    , huge_page_arena_(0)
+#endif // defined(ASIO_HAS_HUGE_PAGES)
+    , memory_metrics_(0)
 {
   if (!ssl_)
   {
@@ -43,6 +66,7 @@ engine::engine(SSL_CTX* context)
 #if (OPENSSL_VERSION_NUMBER < 0x10000000L)
   accept_mutex().init();
 #endif // (OPENSSL_VERSION_NUMBER < 0x10000000L)
+  buffer_pool_mutex().init();
 
   ::SSL_set_mode(ssl_, SSL_MODE_ENABLE_PARTIAL_WRITE);
   ::SSL_set_mode(ssl_, SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
@@ -50,17 +74,33 @@ engine::engine(SSL_CTX* context)
   ::SSL_set_mode(ssl_, SSL_MODE_RELEASE_BUFFERS);
 #endif // defined(SSL_MODE_RELEASE_BUFFERS)
 
-  ::BIO* int_bio = 0;
-  ::BIO_new_bio_pair(&int_bio, 0, &ext_bio_, 0);
-  ::SSL_set_bio(ssl_, int_bio, int_bio);
+  create_bio();
 }
 
 engine::engine(SSL* ssl_impl)
-  : ssl_(ssl_impl)
+  : ssl_(ssl_impl),
+    bio_(0),
+    input_buffer_(0),
+    input_begin_(0),
+    input_end_(0),
+    input_space_in_use_(false),
+    output_buffer_(0),
+    output_buffer_size_(buffer_size),
+    output_begin_(0),
+    output_end_(0),
+    dynamic_record_sizing_(false),
+    dynamic_record_bytes_(0),
+    last_write_time_(),
+    write_retry_(false)
+#if defined(ASIO_HAS_HUGE_PAGES)
+    , huge_page_arena_(0)
+#endif // defined(ASIO_HAS_HUGE_PAGES)
+    , memory_metrics_(0)
 {
 #if (OPENSSL_VERSION_NUMBER < 0x10000000L)
   accept_mutex().init();
 #endif // (OPENSSL_VERSION_NUMBER < 0x10000000L)
+  buffer_pool_mutex().init();
 
   ::SSL_set_mode(ssl_, SSL_MODE_ENABLE_PARTIAL_WRITE);
   ::SSL_set_mode(ssl_, SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
@@ -68,17 +108,38 @@ engine::engine(SSL* ssl_impl)
   ::SSL_set_mode(ssl_, SSL_MODE_RELEASE_BUFFERS);
 #endif // defined(SSL_MODE_RELEASE_BUFFERS)
 
-  ::BIO* int_bio = 0;
-  ::BIO_new_bio_pair(&int_bio, 0, &ext_bio_, 0);
-  ::SSL_set_bio(ssl_, int_bio, int_bio);
+  create_bio();
 }
 
 engine::engine(engine&& other) noexcept
   : ssl_(other.ssl_),
-    ext_bio_(other.ext_bio_)
+    bio_(other.bio_),
+    input_buffer_(other.input_buffer_),
+    input_begin_(other.input_begin_),
+    input_end_(other.input_end_),
+    input_space_in_use_(other.input_space_in_use_),
+    output_buffer_(other.output_buffer_),
+    output_buffer_size_(other.output_buffer_size_),
+    output_begin_(other.output_begin_),
+    output_end_(other.output_end_),
+    dynamic_record_sizing_(other.dynamic_record_sizing_),
+    dynamic_record_bytes_(other.dynamic_record_bytes_),
+    last_write_time_(other.last_write_time_),
+    write_retry_(other.write_retry_)
+#if defined(ASIO_HAS_HUGE_PAGES)
+    , huge_page_arena_(other.huge_page_arena_)
+#endif // defined(ASIO_HAS_HUGE_PAGES)
+    , memory_metrics_(other.memory_metrics_)
 {
+  if (bio_)
+    set_bio_engine(bio_, this);
   other.ssl_ = 0;
-  other.ext_bio_ = 0;
+  other.bio_ = 0;
+  other.input_buffer_ = 0;
+  other.input_begin_ = other.input_end_ = 0;
+  other.input_space_in_use_ = false;
+  other.output_buffer_ = 0;
+  other.output_begin_ = other.output_end_ = 0;
 }
 
 engine::~engine()
@@ -89,27 +150,54 @@ engine::~engine()
     SSL_set_app_data(ssl_, 0);
   }
 
-  if (ext_bio_)
-    ::BIO_free(ext_bio_);
-
+  // The SSL implementation owns the BIO and frees it.
   if (ssl_)
     ::SSL_free(ssl_);
+
+  if (input_buffer_)
+    deallocate_buffer(input_buffer_, buffer_size);
+  if (output_buffer_)
+    deallocate_buffer(output_buffer_, output_buffer_size_);
 }
 
 engine& engine::operator=(engine&& other) noexcept
 {
   if (this != &other)
   {
-    if (ext_bio_)
-      ::BIO_free(ext_bio_);
-
     if (ssl_)
       ::SSL_free(ssl_);
+    if (input_buffer_)
+      deallocate_buffer(input_buffer_, buffer_size);
+    if (output_buffer_)
+      deallocate_buffer(output_buffer_, output_buffer_size_);
 
     ssl_ = other.ssl_;
-    ext_bio_ = other.ext_bio_;
+    bio_ = other.bio_;
+    input_buffer_ = other.input_buffer_;
+    input_begin_ = other.input_begin_;
+    input_end_ = other.input_end_;
+    input_space_in_use_ = other.input_space_in_use_;
+    output_buffer_ = other.output_buffer_;
+    output_buffer_size_ = other.output_buffer_size_;
+    output_begin_ = other.output_begin_;
+    output_end_ = other.output_end_;
+    dynamic_record_sizing_ = other.dynamic_record_sizing_;
+    dynamic_record_bytes_ = other.dynamic_record_bytes_;
+    last_write_time_ = other.last_write_time_;
+    write_retry_ = other.write_retry_;
+#if defined(ASIO_HAS_HUGE_PAGES)
+    huge_page_arena_ = other.huge_page_arena_;
+#endif // defined(ASIO_HAS_HUGE_PAGES)
+    memory_metrics_ = other.memory_metrics_;
+    if (bio_)
+      set_bio_engine(bio_, this);
     other.ssl_ = 0;
-    other.ext_bio_ = 0;
+    other.bio_ = 0;
+    other.input_buffer_ = 0;
+    other.input_begin_ = other.input_end_ = 0;
+    other.input_space_in_use_ = false;
+    other.output_buffer_ = 0;
+    other.output_begin_ = other.output_end_ = 0;
   }
   return *this;
 }
@@ -119,6 +207,74 @@ SSL* engine::native_handle()
   return ssl_;
 }
 
+asio::error_code engine::attach_socket(
+    asio::detail::socket_type s, asio::error_code& ec)
+{
+  if (!bio_ || !SSL_in_before(ssl_))
+  {
+    ec = asio::error::already_started;
+    return ec;
+  }
+
+  ::BIO* bio = ::BIO_new_socket(static_cast<int>(s), BIO_NOCLOSE);
+  if (!bio)
+  {
+    ec = asio::error_code(
+        static_cast<int>(::ERR_get_error()),
+        asio::error::get_ssl_category());
+    return ec;
+  }
+
+  // The SSL implementation takes ownership of the new BIO and frees the
+  // engine's BIO.
+  ::SSL_set_bio(ssl_, bio, bio);
+  bio_ = 0;
+
+#if defined(SSL_OP_ENABLE_KTLS)
+  // When the SSL implementation and the kernel support it, the negotiated
+  // keys are installed in the kernel as soon as they are available.
+  ::SSL_set_options(ssl_, SSL_OP_ENABLE_KTLS);
+#endif // defined(SSL_OP_ENABLE_KTLS)
+
+  ec = asio::error_code();
+  return ec;
+}
+
+bool engine::socket_attached() const
+{
+  return ssl_ && !bio_;
+}
+
+bool engine::ktls_send() const
+{
+#if defined(BIO_get_ktls_send)
+  return socket_attached() && BIO_get_ktls_send(::SSL_get_wbio(ssl_));
+#else // defined(BIO_get_ktls_send)
+  return false;
+#endif // defined(BIO_get_ktls_send)
+}
+
+bool engine::ktls_receive() const
+{
+#if defined(BIO_get_ktls_recv)
+  return socket_attached() && BIO_get_ktls_recv(::SSL_get_rbio(ssl_));
+#else // defined(BIO_get_ktls_recv)
+  return false;
+#endif // defined(BIO_get_ktls_recv)
+}
+
+asio::error_code engine::set_session_cache_key(
+    const std::string& key, asio::error_code& ec)
+{
+  ::ERR_clear_error();
+  return session_cache::set_client_key(ssl_, key, ec);
+}
+
+bool engine::session_reused() const
+{
+  return ::SSL_session_reused(ssl_) != 0;
+}
+
 asio::error_code engine::set_verify_mode(
     verify_mode v, asio::error_code& ec)
 {
@@ -152,6 +308,175 @@ asio::error_code engine::set_verify_callback(
   return ec;
 }
 
+void engine::create_bio()
+{
+  bio_ = ::BIO_new(bio_method());
+  if (!bio_)
+  {
+    asio::error_code ec(
+        static_cast<int>(::ERR_get_error()),
+        asio::error::get_ssl_category());
+    asio::detail::throw_error(ec, "engine");
+  }
+
+  set_bio_engine(bio_, this);
+  ::SSL_set_bio(ssl_, bio_, bio_);
+}
+
+BIO_METHOD* engine::bio_method()
+{
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L) \
+  || (defined(LIBRESSL_VERSION_NUMBER) \
+    && (LIBRESSL_VERSION_NUMBER < 0x2070000fL))
+  static BIO_METHOD method =
+  {
+    BIO_TYPE_SOURCE_SINK, "asio engine",
+    &engine::bio_write, &engine::bio_read, 0, 0,
+    &engine::bio_ctrl, &engine::bio_create, &engine::bio_destroy, 0
+  };
+  return &method;
+#else // (OPENSSL_VERSION_NUMBER < 0x10100000L) ...
+  struct method_holder
+  {
+    method_holder()
+      : method_(::BIO_meth_new(
+            ::BIO_get_new_index() | BIO_TYPE_SOURCE_SINK, "asio engine"))
+    {
+      if (method_)
+      {
+        ::BIO_meth_set_write(method_, &engine::bio_write);
+        ::BIO_meth_set_read(method_, &engine::bio_read);
+        ::BIO_meth_set_ctrl(method_, &engine::bio_ctrl);
+        ::BIO_meth_set_create(method_, &engine::bio_create);
+        ::BIO_meth_set_destroy(method_, &engine::bio_destroy);
+      }
+    }
+
+    ~method_holder()
+    {
+      if (method_)
+        ::BIO_meth_free(method_);
+    }
+
+    BIO_METHOD* method_;
+  };
+
+  static method_holder holder;
+  return holder.method_;
+#endif // (OPENSSL_VERSION_NUMBER < 0x10100000L) ...
+}
+
+void engine::set_bio_engine(BIO* b, engine* e)
+{
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L) \
+  || (defined(LIBRESSL_VERSION_NUMBER) \
+    && (LIBRESSL_VERSION_NUMBER < 0x2070000fL))
+  b->ptr = e;
+#else // (OPENSSL_VERSION_NUMBER < 0x10100000L) ...
+  ::BIO_set_data(b, e);
+#endif // (OPENSSL_VERSION_NUMBER < 0x10100000L) ...
+}
+
+engine* engine::get_bio_engine(BIO* b)
+{
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L) \
+  || (defined(LIBRESSL_VERSION_NUMBER) \
+    && (LIBRESSL_VERSION_NUMBER < 0x2070000fL))
+  return static_cast<engine*>(b->ptr);
+#else // (OPENSSL_VERSION_NUMBER < 0x10100000L) ...
+  return static_cast<engine*>(::BIO_get_data(b));
+#endif // (OPENSSL_VERSION_NUMBER < 0x10100000L) ...
+}
+
+int engine::bio_write(BIO* b, const char* data, int length)
+{
+  ::BIO_clear_retry_flags(b);
+
+  engine* e = get_bio_engine(b);
+  if (!e || length <= 0)
+    return 0;
+
+  // Output is written directly into the engine's output buffer. When it is
+  // full, the SSL implementation retries once the output has been written to
+  // the transport.
+  std::size_t space = e->output_buffer_size_ - e->output_end_;
+  if (space == 0)
+  {
+    ::BIO_set_retry_write(b);
+    return -1;
+  }
+
+  if (!e->allocate_output_buffer())
+    return -1;
+
+  std::size_t n = (std::min)(space, static_cast<std::size_t>(length));
+  std::memcpy(e->output_buffer_ + e->output_end_, data, n);
+  e->output_end_ += n;
+  return static_cast<int>(n);
+}
+
+int engine::bio_read(BIO* b, char* data, int length)
+{
+  ::BIO_clear_retry_flags(b);
+
+  engine* e = get_bio_engine(b);
+  if (!e || length <= 0)
+    return 0;
+
+  // Input is read directly from the engine's input buffer. When it is empty,
+  // the SSL implementation retries once more input has been read from the
+  // transport.
+  std::size_t available = e->input_end_ - e->input_begin_;
+  if (available == 0)
+  {
+    ::BIO_set_retry_read(b);
+    return -1;
+  }
+
+  std::size_t n = (std::min)(available, static_cast<std::size_t>(length));
+  std::memcpy(data, e->input_buffer_ + e->input_begin_, n);
+  e->input_begin_ += n;
+  return static_cast<int>(n);
+}
+
+long engine::bio_ctrl(BIO* b, int cmd, long, void*)
+{
+  engine* e = get_bio_engine(b);
+  switch (cmd)
+  {
+  case BIO_CTRL_PENDING:
+    return e ? static_cast<long>(e->input_end_ - e->input_begin_) : 0;
+  case BIO_CTRL_WPENDING:
+    return e ? static_cast<long>(e->output_end_ - e->output_begin_) : 0;
+  case BIO_CTRL_FLUSH:
+  case BIO_CTRL_DUP:
+    return 1;
+  default:
+    return 0;
+  }
+}
+
+int engine::bio_create(BIO* b)
+{
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L) \
+  || (defined(LIBRESSL_VERSION_NUMBER) \
+    && (LIBRESSL_VERSION_NUMBER < 0x2070000fL))
+  b->init = 1;
+  b->ptr = 0;
+#else // (OPENSSL_VERSION_NUMBER < 0x10100000L) ...
+  ::BIO_set_init(b, 1);
+  ::BIO_set_data(b, 0);
+#endif // (OPENSSL_VERSION_NUMBER < 0x10100000L) ...
+  return 1;
+}
+
+int engine::bio_destroy(BIO* b)
+{
+  if (b)
+    set_bio_engine(b, 0);
+  return 1;
+}
+
 int engine::verify_callback_function(int preverified, X509_STORE_CTX* ctx)
 {
   if (ctx)
@@ -178,6 +503,11 @@ int engine::verify_callback_function(int preverified, X509_STORE_CTX* ctx)
 engine::want engine::handshake(
     stream_base::handshake_type type, asio::error_code& ec)
 {
+  // A client resumes a session from the context's session cache, if it has
+  // one, when the handshake starts.
+  if (type == asio::ssl::stream_base::client && SSL_in_before(ssl_))
+    session_cache::resume_client(ssl_);
+
   return perform((type == asio::ssl::stream_base::client)
       ? &engine::do_connect : &engine::do_accept, 0, 0, ec, 0);
 }
@@ -196,9 +526,53 @@ engine::want engine::write(const asio::const_buffer& data,
     return engine::want_nothing;
   }
 
-  return perform(&engine::do_write,
+  std::size_t length = 0;
+  want w = perform(&engine::do_write,
       const_cast<void*>(data.data()),
-      data.size(), ec, &bytes_transferred);
+      data.size(), ec, &length);
+
+  write_retry_ = (w == want_input_and_retry || w == want_output_and_retry);
+  if (length > 0)
+  {
+    bytes_transferred = length;
+    if (dynamic_record_sizing_)
+    {
+      dynamic_record_bytes_ = (std::min)(dynamic_record_bytes_ + length,
+          static_cast<std::size_t>(small_record_threshold));
+      last_write_time_ = asio::chrono::steady_clock::now();
+    }
+  }
+
+  return w;
+}
+
+void engine::set_dynamic_record_sizing(bool enabled)
+{
+  dynamic_record_sizing_ = enabled;
+  dynamic_record_bytes_ = 0;
+}
+
+bool engine::dynamic_record_sizing() const
+{
+  return dynamic_record_sizing_;
+}
+
+std::size_t engine::write_size_limit()
+{
+  if (!dynamic_record_sizing_)
+    return SSL3_RT_MAX_PLAIN_LENGTH;
+
+  // Record sizes are reduced again once the session has been idle, as the
+  // transport's congestion window may have shrunk. A write that must be
+  // retried keeps its original size.
+  if (!write_retry_ && dynamic_record_bytes_ > 0
+      && asio::chrono::steady_clock::now() - last_write_time_
+        >= asio::chrono::milliseconds(small_record_idle_ms))
+    dynamic_record_bytes_ = 0;
+
+  return dynamic_record_bytes_ < small_record_threshold
+    ? static_cast<std::size_t>(small_record_size)
+    : static_cast<std::size_t>(SSL3_RT_MAX_PLAIN_LENGTH);
 }
 
 engine::want engine::read(const asio::mutable_buffer& data,
@@ -214,24 +588,118 @@ engine::want engine::read(const asio::mutable_buffer& data,
       data.size(), ec, &bytes_transferred);
 }
 
-asio::mutable_buffer engine::get_output(
-    const asio::mutable_buffer& data)
+asio::const_buffer engine::get_output() const
 {
-  int length = ::BIO_read(ext_bio_,
-      data.data(), static_cast<int>(data.size()));
+  if (output_begin_ == output_end_)
+    return asio::const_buffer();
 
-  return asio::buffer(data,
-      length > 0 ? static_cast<std::size_t>(length) : 0);
+  return asio::const_buffer(output_buffer_ + output_begin_,
+      output_end_ - output_begin_);
+}
+
+void engine::consume_output(std::size_t length)
+{
+  output_begin_ += (std::min)(length, output_end_ - output_begin_);
+
+  // Reuse the buffer from the start only once all of its output has been
+  // written, as a write may still refer to any part of it.
+  if (output_begin_ == output_end_)
+    output_begin_ = output_end_ = 0;
+}
+
+std::size_t engine::output_space() const
+{
+  return output_buffer_size_ - output_end_;
+}
+
+std::size_t engine::output_buffer_size() const
+{
+  return output_buffer_size_;
+}
+
+asio::error_code engine::set_output_buffer_size(
+    std::size_t size, asio::error_code& ec)
+{
+  if (output_begin_ != output_end_)
+  {
+    ec = asio::error::in_progress;
+    return ec;
+  }
+
+  if (output_buffer_)
+  {
+    deallocate_buffer(output_buffer_, output_buffer_size_);
+    output_buffer_ = 0;
+  }
+
+  output_buffer_size_ = (std::max)(size,
+      static_cast<std::size_t>(buffer_size));
+  output_begin_ = output_end_ = 0;
+
+  ec = asio::error_code();
+  return ec;
+}
+
+asio::mutable_buffer engine::get_input_space()
+{
+  if (!input_buffer_)
+  {
+    input_buffer_ = allocate_buffer(buffer_size);
+    if (!input_buffer_)
+    {
+      std::bad_alloc ex;
+      asio::detail::throw_exception(ex);
+    }
+  }
+
+  if (input_begin_ == input_end_)
+  {
+    input_begin_ = input_end_ = 0;
+  }
+  else if (input_end_ == buffer_size && input_begin_ > 0)
+  {
+    // Move unconsumed input to the start of the buffer to make space.
+    std::memmove(input_buffer_, input_buffer_ + input_begin_,
+        input_end_ - input_begin_);
+    input_end_ -= input_begin_;
+    input_begin_ = 0;
+  }
+
+  input_space_in_use_ = true;
+  return asio::mutable_buffer(input_buffer_ + input_end_,
+      buffer_size - input_end_);
+}
+
+void engine::commit_input(std::size_t length)
+{
+  input_space_in_use_ = false;
+  if (input_buffer_)
+    input_end_ += (std::min)(length, buffer_size - input_end_);
 }
 
 asio::const_buffer engine::put_input(
     const asio::const_buffer& data)
 {
-  int length = ::BIO_write(ext_bio_,
-      data.data(), static_cast<int>(data.size()));
+  std::size_t length = asio::buffer_copy(get_input_space(), data);
+  commit_input(length);
+  return data + length;
+}
 
-  return asio::buffer(data +
-      (length > 0 ? static_cast<std::size_t>(length) : 0));
+void engine::release_buffers()
+{
+  if (input_buffer_ && input_begin_ == input_end_ && !input_space_in_use_)
+  {
+    deallocate_buffer(input_buffer_, buffer_size);
+    input_buffer_ = 0;
+    input_begin_ = input_end_ = 0;
+  }
+
+  if (output_buffer_ && output_begin_ == output_end_)
+  {
+    deallocate_buffer(output_buffer_, output_buffer_size_);
+    output_buffer_ = 0;
+    output_begin_ = output_end_ = 0;
+  }
 }
 
 const asio::error_code& engine::map_error_code(
@@ -242,7 +710,7 @@ const asio::error_code& engine::map_error_code(
     return ec;
 
   // If there's data yet to be read, it's an error.
-  if (BIO_wpending(ext_bio_))
+  if (input_begin_ != input_end_)
   {
     ec = asio::ssl::error::stream_truncated;
     return ec;
@@ -264,6 +732,92 @@ const asio::error_code& engine::map_error_code(
   return ec;
 }
 
+engine::buffer_pool& engine::get_buffer_pool()
+{
+  static buffer_pool pool = { 0, 0 };
+  return pool;
+}
+
+asio::detail::static_mutex& engine::buffer_pool_mutex()
+{
+  static asio::detail::static_mutex mutex = ASIO_STATIC_MUTEX_INIT;
+  return mutex;
+}
+
+unsigned char* engine::allocate_buffer(std::size_t size)
+{
+  unsigned char* p = 0;
+  bool pooled = false;
+
+  if (size == buffer_size)
+  {
+    asio::detail::static_mutex::scoped_lock lock(buffer_pool_mutex());
+    buffer_pool& pool = get_buffer_pool();
+    if (void* head = pool.head_)
+    {
+      std::memcpy(&pool.head_, head, sizeof(void*));
+      --pool.count_;
+      p = static_cast<unsigned char*>(head);
+      pooled = true;
+    }
+  }
+
+#if defined(ASIO_HAS_HUGE_PAGES)
+  if (!p && huge_page_arena_)
+    p = static_cast<unsigned char*>(huge_page_arena_->allocate(size));
+#endif // defined(ASIO_HAS_HUGE_PAGES)
+
+  if (!p)
+    p = new (std::nothrow) unsigned char[size];
+
+  if (p && memory_metrics_)
+  {
+    memory_metrics_->record_allocation(
+        asio::detail::memory_metrics::ssl_buffer_memory, size, pooled);
+  }
+
+  return p;
+}
+
+void engine::deallocate_buffer(unsigned char* p, std::size_t size)
+{
+  if (memory_metrics_)
+  {
+    memory_metrics_->record_deallocation(
+        asio::detail::memory_metrics::ssl_buffer_memory, size);
+  }
+
+  if (size == buffer_size)
+  {
+    asio::detail::static_mutex::scoped_lock lock(buffer_pool_mutex());
+    buffer_pool& pool = get_buffer_pool();
+    if (pool.count_ < max_pooled_buffers)
+    {
+      std::memcpy(p, &pool.head_, sizeof(void*));
+      pool.head_ = p;
+      ++pool.count_;
+      return;
+    }
+  }
+
+#if defined(ASIO_HAS_HUGE_PAGES)
+  if (asio::detail::huge_page_arena::contains(p))
+  {
+    asio::detail::huge_page_arena::deallocate(p);
+    return;
+  }
+#endif // defined(ASIO_HAS_HUGE_PAGES)
+
+  delete[] p;
+}
+
+bool engine::allocate_output_buffer()
+{
+  if (!output_buffer_)
+    output_buffer_ = allocate_buffer(output_buffer_size_);
+  return output_buffer_ != 0;
+}
+
 #if (OPENSSL_VERSION_NUMBER < 0x10000000L)
 asio::detail::static_mutex& engine::accept_mutex()
 {
@@ -276,12 +830,15 @@ engine::want engine::perform(int (engine::* op)(void*, std::size_t),
     void* data, std::size_t length, asio::error_code& ec,
     std::size_t* bytes_transferred)
 {
-  std::size_t pending_output_before = ::BIO_ctrl_pending(ext_bio_);
+  if (!bio_)
+    return perform_on_socket(op, data, length, ec, bytes_transferred);
+
+  std::size_t pending_output_before = output_end_ - output_begin_;
   ::ERR_clear_error();
   int result = (this->*op)(data, length);
   int ssl_error = ::SSL_get_error(ssl_, result);
   int sys_error = static_cast<int>(::ERR_get_error());
-  std::size_t pending_output_after = ::BIO_ctrl_pending(ext_bio_);
+  std::size_t pending_output_after = output_end_ - output_begin_;
 
   if (ssl_error == SSL_ERROR_SSL)
   {
@@ -341,6 +898,66 @@ engine::want engine::perform(int (engine::* op)(void*, std::size_t),
   }
 }
 
+engine::want engine::perform_on_socket(
+    int (engine::* op)(void*, std::size_t), void* data, std::size_t length,
+    asio::error_code& ec, std::size_t* bytes_transferred)
+{
+  ::ERR_clear_error();
+#if defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+  ::WSASetLastError(0);
+  int result = (this->*op)(data, length);
+  int last_error = ::WSAGetLastError();
+#else // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+  errno = 0;
+  int result = (this->*op)(data, length);
+  int last_error = errno;
+#endif // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+  int ssl_error = ::SSL_get_error(ssl_, result);
+  int sys_error = static_cast<int>(::ERR_get_error());
+
+  switch (ssl_error)
+  {
+  case SSL_ERROR_NONE:
+    if (bytes_transferred)
+      *bytes_transferred = static_cast<std::size_t>(result);
+    ec = asio::error_code();
+    return want_nothing;
+  case SSL_ERROR_WANT_READ:
+    ec = asio::error_code();
+    return want_readable_and_retry;
+  case SSL_ERROR_WANT_WRITE:
+    ec = asio::error_code();
+    return want_writable_and_retry;
+  case SSL_ERROR_ZERO_RETURN:
+    ec = asio::error::eof;
+    return want_nothing;
+  case SSL_ERROR_SYSCALL:
+    // The SSL implementation reports an end of file from the socket as a
+    // system error with no error code.
+    if (sys_error != 0)
+      ec = asio::error_code(sys_error, asio::error::get_ssl_category());
+    else if (last_error != 0)
+      ec = asio::error_code(last_error, asio::error::get_system_category());
+    else
+      ec = asio::error::eof;
+    return want_nothing;
+  case SSL_ERROR_SSL:
+#if defined(SSL_R_UNEXPECTED_EOF_WHILE_READING)
+    if (ERR_GET_LIB(sys_error) == ERR_LIB_SSL
+        && ERR_GET_REASON(sys_error) == SSL_R_UNEXPECTED_EOF_WHILE_READING)
+    {
+      ec = asio::error::eof;
+      return want_nothing;
+    }
+#endif // defined(SSL_R_UNEXPECTED_EOF_WHILE_READING)
+    ec = asio::error_code(sys_error, asio::error::get_ssl_category());
+    return want_nothing;
+  default:
+    ec = asio::ssl::error::unexpected_result;
+    return want_nothing;
+  }
+}
+
 int engine::do_accept(void*, std::size_t)
 {
 #if (OPENSSL_VERSION_NUMBER < 0x10000000L)
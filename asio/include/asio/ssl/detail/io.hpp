@@ -18,7 +18,14 @@
 #include "asio/detail/config.hpp"
 
 #include "asio/detail/base_from_cancellation_state.hpp"
+#include "asio/detail/bind_handler.hpp"
 #include "asio/detail/handler_tracking.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/associated_executor.hpp"
+#include "asio/error.hpp"
+#include "asio/executor_work_guard.hpp"
+#include "asio/post.hpp"
+#include "asio/socket_base.hpp"
 #include "asio/ssl/detail/engine.hpp"
 #include "asio/ssl/detail/stream_core.hpp"
 #include "asio/write.hpp"
@@ -29,38 +36,125 @@ namespace asio {
 namespace ssl {
 namespace detail {
 
+// Determines whether the lowest layer of a stream is a socket that the engine
+// can be attached to.
+template <typename Stream, typename = void>
+struct has_native_socket : false_type
+{
+};
+
+template <typename Stream>
+struct has_native_socket<Stream,
+    void_t<decltype(declval<Stream&>().lowest_layer().native_handle())>>
+  : true_type
+{
+};
+
+// Determines whether the engine steps of an operation may be performed on the
+// stream's handshake executor.
+template <typename Operation, typename = void>
+struct is_offloadable_op : false_type
+{
+};
+
+template <typename Operation>
+struct is_offloadable_op<Operation,
+    enable_if_t<Operation::offloadable>>
+  : true_type
+{
+};
+
+inline socket_base::wait_type socket_wait_type(engine::want want)
+{
+  return want == engine::want_readable_and_retry
+    ? socket_base::wait_read : socket_base::wait_write;
+}
+
+// Wait for the socket that the engine is attached to.
+template <typename Stream>
+inline void wait_for_socket(Stream& next_layer, engine::want want,
+    asio::error_code& ec, true_type)
+{
+  next_layer.lowest_layer().wait(socket_wait_type(want), ec);
+}
+
+template <typename Stream>
+inline void wait_for_socket(Stream&, engine::want,
+    asio::error_code& ec, false_type)
+{
+  ec = asio::error::operation_not_supported;
+}
+
+template <typename Stream>
+inline void wait_for_socket(Stream& next_layer,
+    engine::want want, asio::error_code& ec)
+{
+  (wait_for_socket)(next_layer, want, ec, has_native_socket<Stream>());
+}
+
+template <typename Stream, typename Handler>
+inline void async_wait_for_socket(Stream& next_layer,
+    engine::want want, Handler&& handler, true_type)
+{
+  next_layer.lowest_layer().async_wait(socket_wait_type(want),
+      static_cast<Handler&&>(handler));
+}
+
+template <typename Stream, typename Handler>
+inline void async_wait_for_socket(Stream& next_layer,
+    engine::want, Handler&& handler, false_type)
+{
+  asio::post(next_layer.get_executor(),
+      asio::detail::bind_handler(static_cast<Handler&&>(handler),
+        asio::error_code(asio::error::operation_not_supported)));
+}
+
+template <typename Stream, typename Handler>
+inline void async_wait_for_socket(Stream& next_layer,
+    engine::want want, Handler&& handler)
+{
+  (async_wait_for_socket)(next_layer, want,
+      static_cast<Handler&&>(handler), has_native_socket<Stream>());
+}
+
 template <typename Stream, typename Operation>
 std::size_t io(Stream& next_layer, stream_core& core,
     const Operation& op, asio::error_code& ec)
 {
   asio::error_code io_ec;
   std::size_t bytes_transferred = 0;
-  do switch (op(core.engine_, ec, bytes_transferred))
+  engine::want want;
+  do switch (want = op(core.engine_, ec, bytes_transferred))
   {
-  case engine::want_input_and_retry:
+  case engine::want_readable_and_retry:
+  case engine::want_writable_and_retry:
 
-    // If the input buffer is empty then we need to read some more data from
-    // the underlying transport.
-    if (core.input_.size() == 0)
-    {
-      core.input_ = asio::buffer(core.input_buffer_,
-          next_layer.read_some(core.input_buffer_, io_ec));
-      if (!ec)
-        ec = io_ec;
-    }
+    // The engine is attached to the socket and performs its own I/O. Wait
+    // until the socket is ready.
+    wait_for_socket(next_layer, want, io_ec);
+    if (!ec)
+      ec = io_ec;
+
+    // Try the operation again.
+    continue;
 
-    // Pass the new input data to the engine.
-    core.input_ = core.engine_.put_input(core.input_);
+  case engine::want_input_and_retry:
+
+    // Read some more data from the underlying transport directly into the
+    // engine's input buffer.
+    core.engine_.commit_input(
+        next_layer.read_some(core.engine_.get_input_space(), io_ec));
+    if (!ec)
+      ec = io_ec;
 
     // Try the operation again.
     continue;
 
   case engine::want_output_and_retry:
 
-    // Get output data from the engine and write it to the underlying
-    // transport.
-    asio::write(next_layer,
-        core.engine_.get_output(core.output_buffer_), io_ec);
+    // Write the engine's output data to the underlying transport.
+    core.engine_.consume_output(
+        asio::write(next_layer, core.engine_.get_output(), io_ec));
     if (!ec)
       ec = io_ec;
 
@@ -69,30 +163,35 @@ std::size_t io(Stream& next_layer, stream_core& core,
 
   case engine::want_output:
 
-    // Get output data from the engine and write it to the underlying
-    // transport.
-    asio::write(next_layer,
-        core.engine_.get_output(core.output_buffer_), io_ec);
+    // Write the engine's output data to the underlying transport.
+    core.engine_.consume_output(
+        asio::write(next_layer, core.engine_.get_output(), io_ec));
     if (!ec)
       ec = io_ec;
 
     // Operation is complete. Return result to caller.
+    core.engine_.release_buffers();
     core.engine_.map_error_code(ec);
     return bytes_transferred;
 
   default:
 
     // Operation is complete. Return result to caller.
+    core.engine_.release_buffers();
     core.engine_.map_error_code(ec);
     return bytes_transferred;
 
   } while (!ec);
 
   // Operation failed. Return result to caller.
+  core.engine_.release_buffers();
   core.engine_.map_error_code(ec);
   return 0;
 }
 
+template <typename Stream, typename Operation, typename Handler>
+class io_offload_op;
+
 template <typename Stream, typename Operation, typename Handler>
 class io_op
   : public asio::detail::base_from_cancellation_state<Handler>
@@ -147,17 +246,32 @@ public:
     case 1: // Called after at least one async operation.
       do
       {
-        switch (want_ = op_(core_.engine_, ec_, bytes_transferred_))
+        // Hand the engine step to the handshake executor, if one is used.
+        // Control resumes at the "case 2:" label below.
+        if (offload(is_offloadable_op<Operation>()))
+          return;
+
+        want_ = op_(core_.engine_, ec_, bytes_transferred_);
+
+      case 2: // Resumed after the engine step ran on the handshake executor.
+        switch (want_)
         {
-        case engine::want_input_and_retry:
+        case engine::want_readable_and_retry:
+        case engine::want_writable_and_retry:
 
-          // If the input buffer already has data in it we can pass it to the
-          // engine and then retry the operation immediately.
-          if (core_.input_.size() != 0)
-          {
-            core_.input_ = core_.engine_.put_input(core_.input_);
-            continue;
-          }
+          ASIO_HANDLER_LOCATION((
+                __FILE__, __LINE__, Operation::tracking_name()));
+
+          // The engine is attached to the socket and performs its own I/O.
+          // Wait until the socket is ready.
+          async_wait_for_socket(next_layer_, want_,
+              static_cast<io_op&&>(*this));
+
+          // Yield control until asynchronous operation completes. Control
+          // resumes at the "default:" label below.
+          return;
+
+        case engine::want_input_and_retry:
 
           // The engine wants more data to be read from input. However, we
           // cannot allow more than one read operation at a time on the
@@ -171,9 +285,10 @@ public:
             ASIO_HANDLER_LOCATION((
                   __FILE__, __LINE__, Operation::tracking_name()));
 
-            // Start reading some data from the underlying transport.
+            // Start reading some data from the underlying transport directly
+            // into the engine's input buffer.
             next_layer_.async_read_some(
-                asio::buffer(core_.input_buffer_),
+                core_.engine_.get_input_space(),
                 static_cast<io_op&&>(*this));
           }
           else
@@ -204,9 +319,10 @@ public:
             ASIO_HANDLER_LOCATION((
                   __FILE__, __LINE__, Operation::tracking_name()));
 
-            // Start writing all the data to the underlying transport.
+            // Start writing all the data to the underlying transport directly
+            // from the engine's output buffer.
             asio::async_write(next_layer_,
-                core_.engine_.get_output(core_.output_buffer_),
+                core_.engine_.get_output(),
                 static_cast<io_op&&>(*this));
           }
           else
@@ -229,13 +345,13 @@ public:
           // the async operation's initiating function. In this case we're not
           // allowed to call the handler directly. Instead, issue a zero-sized
           // read so the handler runs "as-if" posted using io_context::post().
-          if (start)
+          if (start == 1)
           {
             ASIO_HANDLER_LOCATION((
                   __FILE__, __LINE__, Operation::tracking_name()));
 
             next_layer_.async_read_some(
-                asio::buffer(core_.input_buffer_, 0),
+                asio::mutable_buffer(),
                 static_cast<io_op&&>(*this));
 
             // Yield control until asynchronous operation completes. Control
@@ -257,12 +373,28 @@ public:
 
         switch (want_)
         {
+        case engine::want_readable_and_retry:
+        case engine::want_writable_and_retry:
+
+          // A socket wait reports no bytes transferred, but its error must
+          // still be passed on.
+          if (!ec_)
+            ec_ = ec;
+
+          // Check for cancellation before continuing.
+          if (!ec_ && this->cancelled() != cancellation_type::none)
+          {
+            ec_ = asio::error::operation_aborted;
+            break;
+          }
+
+          // Try the operation again.
+          continue;
+
         case engine::want_input_and_retry:
 
-          // Add received data to the engine's input.
-          core_.input_ = asio::buffer(
-              core_.input_buffer_, bytes_transferred);
-          core_.input_ = core_.engine_.put_input(core_.input_);
+          // Make the received data available to the engine.
+          core_.engine_.commit_input(bytes_transferred);
 
           // Release any waiting read operations.
           core_.pending_read_.expires_at(core_.neg_infin());
@@ -279,7 +411,9 @@ public:
 
         case engine::want_output_and_retry:
 
-          // Release any waiting write operations.
+          // Remove the written data from the engine's output, and release any
+          // waiting write operations.
+          core_.engine_.consume_output(bytes_transferred);
           core_.pending_write_.expires_at(core_.neg_infin());
 
           // Check for cancellation before continuing.
@@ -294,13 +428,18 @@ public:
 
         case engine::want_output:
 
-          // Release any waiting write operations.
+          // Remove the written data from the engine's output, and release any
+          // waiting write operations.
+          core_.engine_.consume_output(bytes_transferred);
           core_.pending_write_.expires_at(core_.neg_infin());
 
           // Fall through to call handler.
 
         default:
 
+          // Return the engine's buffers to the pool while the stream is idle.
+          core_.engine_.release_buffers();
+
           // Pass the result to the handler.
           op_.call_handler(handler_,
               core_.engine_.map_error_code(ec_),
@@ -312,10 +451,32 @@ public:
       } while (!ec_);
 
       // Operation failed. Pass the result to the handler.
+      core_.engine_.release_buffers();
       op_.call_handler(handler_, core_.engine_.map_error_code(ec_), 0);
     }
   }
 
+  // Start the next engine step on the handshake executor. Returns true if
+  // the step was started.
+  bool offload(false_type)
+  {
+    return false;
+  }
+
+  bool offload(true_type)
+  {
+    if (!core_.handshake_executor_)
+      return false;
+
+    ASIO_HANDLER_LOCATION((
+          __FILE__, __LINE__, Operation::tracking_name()));
+
+    asio::any_io_executor ex = core_.handshake_executor_;
+    asio::post(ex, io_offload_op<Stream, Operation, Handler>(
+          static_cast<io_op&&>(*this)));
+    return true;
+  }
+
 //private:
   Stream& next_layer_;
   stream_core& core_;
@@ -327,6 +488,41 @@ public:
   Handler handler_;
 };
 
+// Performs one engine step of an io_op on the handshake executor, and then
+// resumes the io_op on its own executor.
+template <typename Stream, typename Operation, typename Handler>
+class io_offload_op
+{
+public:
+  typedef asio::associated_executor_t<io_op<Stream, Operation, Handler>,
+      decltype(declval<Stream&>().get_executor())> resume_executor_type;
+
+  explicit io_offload_op(io_op<Stream, Operation, Handler>&& op)
+    : work_(asio::get_associated_executor(op,
+          op.next_layer_.get_executor())),
+      op_(static_cast<io_op<Stream, Operation, Handler>&&>(op))
+  {
+  }
+
+  void operator()()
+  {
+    op_.want_ = op_.op_(op_.core_.engine_, op_.ec_, op_.bytes_transferred_);
+
+    resume_executor_type ex = work_.get_executor();
+    asio::post(ex,
+        asio::detail::bind_handler(
+          static_cast<io_op<Stream, Operation, Handler>&&>(op_),
+          asio::error_code(), 0, 2));
+    work_.reset();
+  }
+
+private:
+  // Keeps the io_op's executor from running out of work while the engine step
+  // is performed elsewhere.
+  asio::executor_work_guard<resume_executor_type> work_;
+  io_op<Stream, Operation, Handler> op_;
+};
+
 template <typename Stream, typename Operation, typename Handler>
 inline bool asio_handler_is_continuation(
     io_op<Stream, Operation, Handler>* this_handler)
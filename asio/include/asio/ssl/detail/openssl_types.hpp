@@ -27,8 +27,25 @@
 #endif // !defined(OPENSSL_NO_ENGINE)
 #include <openssl/dh.h>
 #include <openssl/err.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
 #include <openssl/rsa.h>
 #include <openssl/x509.h>
 #include <openssl/x509v3.h>
 
+// Support for DTLS over datagram sockets.
+#if !defined(ASIO_HAS_SSL_DTLS)
+# if !defined(ASIO_DISABLE_SSL_DTLS)
+#  if (OPENSSL_VERSION_NUMBER >= 0x10101000L) \
+    && !defined(LIBRESSL_VERSION_NUMBER) \
+    && !defined(ASIO_USE_WOLFSSL) \
+    && !defined(OPENSSL_NO_DTLS)
+#   define ASIO_HAS_SSL_DTLS 1
+#  endif // (OPENSSL_VERSION_NUMBER >= 0x10101000L)
+         //   && !defined(LIBRESSL_VERSION_NUMBER)
+         //   && !defined(ASIO_USE_WOLFSSL)
+         //   && !defined(OPENSSL_NO_DTLS)
+# endif // !defined(ASIO_DISABLE_SSL_DTLS)
+#endif // !defined(ASIO_HAS_SSL_DTLS)
+
 #endif // ASIO_SSL_DETAIL_OPENSSL_TYPES_HPP
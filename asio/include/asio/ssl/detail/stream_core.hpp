@@ -18,7 +18,13 @@
 #include "asio/detail/config.hpp"
 
 #include "asio/ssl/detail/engine.hpp"
+#include "asio/any_io_executor.hpp"
 #include "asio/buffer.hpp"
+#include "asio/config.hpp"
+#include "asio/detail/memory_metrics_service.hpp"
+#include "asio/execution/context.hpp"
+#include "asio/execution/executor.hpp"
+#include "asio/query.hpp"
 #include "asio/steady_timer.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -29,36 +35,26 @@ namespace detail {
 
 struct stream_core
 {
-  // According to the OpenSSL documentation, this is the buffer size that is
-  // sufficient to hold the largest possible TLS record.
-  enum { max_tls_record_size = 17 * 1024 };
-
   template <typename Executor>
   stream_core(SSL_CTX* context, const Executor& ex)
     : engine_(context),
       pending_read_(ex),
-      pending_write_(ex),
-      output_buffer_space_(max_tls_record_size),
-      output_buffer_(asio::buffer(output_buffer_space_)),
-      input_buffer_space_(max_tls_record_size),
-      input_buffer_(asio::buffer(input_buffer_space_))
+      pending_write_(ex)
   {
     pending_read_.expires_at(neg_infin());
     pending_write_.expires_at(neg_infin());
+    init_memory(get_context(ex));
   }
 
   template <typename Executor>
   stream_core(SSL* ssl_impl, const Executor& ex)
     : engine_(ssl_impl),
       pending_read_(ex),
-      pending_write_(ex),
-      output_buffer_space_(max_tls_record_size),
-      output_buffer_(asio::buffer(output_buffer_space_)),
-      input_buffer_space_(max_tls_record_size),
-      input_buffer_(asio::buffer(input_buffer_space_))
+      pending_write_(ex)
   {
     pending_read_.expires_at(neg_infin());
     pending_write_.expires_at(neg_infin());
+    init_memory(get_context(ex));
   }
 
   stream_core(stream_core&& other)
@@ -69,19 +65,10 @@ struct stream_core
       pending_write_(
          static_cast<asio::steady_timer&&>(
            other.pending_write_)),
-      output_buffer_space_(
-          static_cast<std::vector<unsigned char>&&>(
-            other.output_buffer_space_)),
-      output_buffer_(other.output_buffer_),
-      input_buffer_space_(
-          static_cast<std::vector<unsigned char>&&>(
-            other.input_buffer_space_)),
-      input_buffer_(other.input_buffer_),
-      input_(other.input_)
+      handshake_executor_(
+          static_cast<asio::any_io_executor&&>(
+            other.handshake_executor_))
   {
-    other.output_buffer_ = asio::mutable_buffer(0, 0);
-    other.input_buffer_ = asio::mutable_buffer(0, 0);
-    other.input_ = asio::const_buffer(0, 0);
   }
 
   ~stream_core()
@@ -99,18 +86,9 @@ struct stream_core
       pending_write_ =
         static_cast<asio::steady_timer&&>(
           other.pending_write_);
-      output_buffer_space_ =
-        static_cast<std::vector<unsigned char>&&>(
-          other.output_buffer_space_);
-      output_buffer_ = other.output_buffer_;
-      input_buffer_space_ =
-        static_cast<std::vector<unsigned char>&&>(
-          other.input_buffer_space_);
-      input_buffer_ = other.input_buffer_;
-      input_ = other.input_;
-      other.output_buffer_ = asio::mutable_buffer(0, 0);
-      other.input_buffer_ = asio::mutable_buffer(0, 0);
-      other.input_ = asio::const_buffer(0, 0);
+      handshake_executor_ =
+        static_cast<asio::any_io_executor&&>(
+          other.handshake_executor_);
     }
     return *this;
   }
@@ -124,6 +102,10 @@ struct stream_core
   // Timer used for storing queued write operations.
   asio::steady_timer pending_write_;
 
+  // The executor on which the engine steps of asynchronous handshakes are
+  // performed. If empty, they are performed inline.
+  asio::any_io_executor handshake_executor_;
+
   // Helper function for obtaining a time value that always fires.
   static asio::steady_timer::time_point neg_infin()
   {
@@ -143,20 +125,33 @@ struct stream_core
     return timer.expiry();
   }
 
-  // Buffer space used to prepare output intended for the transport.
-  std::vector<unsigned char> output_buffer_space_;
-
-  // A buffer that may be used to prepare output intended for the transport.
-  asio::mutable_buffer output_buffer_;
-
-  // Buffer space used to read input intended for the engine.
-  std::vector<unsigned char> input_buffer_space_;
+  // Helper function to get an executor's context.
+  template <typename Executor>
+  static execution_context& get_context(const Executor& ex,
+      constraint_t<execution::is_executor<Executor>::value> = 0)
+  {
+    return asio::query(ex, execution::context);
+  }
 
-  // A buffer that may be used to read input intended for the engine.
-  asio::mutable_buffer input_buffer_;
+  // Helper function to get an executor's context.
+  template <typename Executor>
+  static execution_context& get_context(const Executor& ex,
+      constraint_t<!execution::is_executor<Executor>::value> = 0)
+  {
+    return ex.context();
+  }
 
-  // The buffer pointing to the engine's unconsumed input.
-  asio::const_buffer input_;
+  // Helper function to allocate and count the engine's buffers as configured
+  // for the executor's context.
+  void init_memory(execution_context& ctx)
+  {
+#if defined(ASIO_HAS_HUGE_PAGES)
+    engine_.use_huge_page_arena(asio::detail::huge_page_arena::get(
+          config(ctx).get("memory", "huge_pages", 0)));
+#endif // defined(ASIO_HAS_HUGE_PAGES)
+    engine_.use_memory_metrics(
+        asio::detail::memory_metrics_service::get(ctx));
+  }
 };
 
 } // namespace detail
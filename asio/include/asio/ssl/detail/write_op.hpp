@@ -18,6 +18,7 @@
 #include "asio/detail/config.hpp"
 
 #include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/consuming_buffers.hpp"
 #include "asio/ssl/detail/engine.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -40,19 +41,54 @@ public:
   {
   }
 
+  // On entry, bytes_transferred holds the number of bytes already accepted by
+  // the engine for this operation. Records are encrypted into the engine's
+  // output buffer for as long as it has room for another full record, so that
+  // they are written to the transport together. Each record carries no more
+  // data than the engine's current record size limit.
   engine::want operator()(engine& eng,
       asio::error_code& ec,
       std::size_t& bytes_transferred) const
   {
-    unsigned char storage[
-      asio::detail::buffer_sequence_adapter<asio::const_buffer,
-        ConstBufferSequence>::linearisation_storage_size];
-
-    asio::const_buffer buffer =
-      asio::detail::buffer_sequence_adapter<asio::const_buffer,
-        ConstBufferSequence>::linearise(buffers_, asio::buffer(storage));
-
-    return eng.write(buffer, ec, bytes_transferred);
+    buffers_.consume(bytes_transferred - buffers_.total_consumed());
+
+    for (;;)
+    {
+      typedef decltype(buffers_.prepare(0)) prepared_type;
+      prepared_type prepared = buffers_.prepare(eng.write_size_limit());
+
+      unsigned char storage[
+        asio::detail::buffer_sequence_adapter<asio::const_buffer,
+          prepared_type>::linearisation_storage_size];
+
+      asio::const_buffer buffer =
+        asio::detail::buffer_sequence_adapter<asio::const_buffer,
+          prepared_type>::linearise(prepared, asio::buffer(storage));
+
+      std::size_t length = 0;
+      engine::want want = eng.write(buffer, ec, length);
+
+      if (want != engine::want_output || ec || length == 0)
+      {
+        // Complete with the records already encrypted, if any. The condition
+        // that stopped this write is encountered again on the next one.
+        if (bytes_transferred > 0 && want != engine::want_output_and_retry
+            && eng.get_output().size() > 0)
+        {
+          ec = asio::error_code();
+          return engine::want_output;
+        }
+
+        bytes_transferred += length;
+        return want;
+      }
+
+      bytes_transferred += length;
+      buffers_.consume(length);
+
+      if (buffers_.empty() || eng.output_space() < max_record_size)
+        return engine::want_output;
+    }
   }
 
   template <typename Handler>
@@ -64,7 +100,16 @@ public:
   }
 
 private:
-  ConstBufferSequence buffers_;
+  typedef asio::detail::consuming_buffers<asio::const_buffer,
+      ConstBufferSequence, decltype(asio::buffer_sequence_begin(
+        declval<const ConstBufferSequence&>()))> buffers_type;
+
+  // The most output that encrypting a single TLS record can produce.
+  static constexpr std::size_t max_record_size = SSL3_RT_HEADER_LENGTH
+    + SSL3_RT_MAX_PLAIN_LENGTH + SSL3_RT_MAX_ENCRYPTED_OVERHEAD;
+
+  // The position within the buffers is advanced as the engine accepts data.
+  mutable buffers_type buffers_;
 };
 
 } // namespace detail
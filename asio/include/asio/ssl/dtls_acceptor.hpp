@@ -0,0 +1,655 @@
+//
+// ssl/dtls_acceptor.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_DTLS_ACCEPTOR_HPP
+#define ASIO_SSL_DTLS_ACCEPTOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include "asio/any_io_executor.hpp"
+#include "asio/async_result.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/handler_type_requirements.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/error.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/post.hpp"
+#include "asio/ssl/context.hpp"
+#include "asio/ssl/detail/dtls_demultiplexer.hpp"
+#include "asio/ssl/dtls_stream.hpp"
+
+#if defined(ASIO_HAS_SSL_DTLS) || defined(GENERATING_DOCUMENTATION)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+
+/// Accepts DTLS sessions from many peers on a single datagram socket.
+/**
+ * The dtls_acceptor class template owns a datagram socket bound to a local
+ * endpoint, and demultiplexes incoming datagrams by their source endpoint.
+ * Each accepted peer is represented by a dtls_acceptor::peer_socket, which is
+ * used as the next layer of a dtls_stream.
+ *
+ * A datagram from an unknown endpoint is passed to @c DTLSv1_listen. A
+ * ClientHello without a valid cookie is answered with a HelloVerifyRequest,
+ * and no state is kept for the peer until it returns the cookie. Cookies are
+ * derived from the peer's address using a secret chosen when the acceptor is
+ * constructed. The acceptor installs its cookie callbacks on the SSL context.
+ *
+ * The socket is read only while an accept or a peer receive operation is
+ * waiting for data. Datagrams for a peer that is not reading are queued, up to
+ * a fixed limit beyond which they are dropped.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe. The acceptor and all of its peers must be used
+ * within the same implicit or explicit strand.
+ *
+ * @par Example
+ * @code
+ * asio::ssl::context ctx(asio::ssl::context::dtls_server);
+ * // ... load the certificate and private key ...
+ *
+ * typedef asio::ssl::dtls_acceptor<asio::ip::udp> acceptor_type;
+ * acceptor_type acceptor(my_context, ctx,
+ *     asio::ip::udp::endpoint(asio::ip::udp::v4(), 4433));
+ *
+ * asio::ssl::dtls_stream<acceptor_type::peer_socket> session(acceptor, ctx);
+ * acceptor.async_accept(session,
+ *     [&](asio::error_code ec)
+ *     {
+ *       if (!ec)
+ *         session.async_handshake(asio::ssl::stream_base::server, ...);
+ *     });
+ * @endcode
+ */
+template <typename Protocol, typename Executor = any_io_executor>
+class dtls_acceptor
+  : private noncopyable
+{
+private:
+  class initiate_async_accept;
+
+  typedef detail::dtls_demultiplexer<Protocol, Executor> demultiplexer_type;
+
+public:
+  /// The type of the executor associated with the object.
+  typedef Executor executor_type;
+
+  /// The protocol type.
+  typedef Protocol protocol_type;
+
+  /// The endpoint type.
+  typedef typename Protocol::endpoint endpoint_type;
+
+  class peer_socket;
+
+  /// Construct an acceptor bound to the specified endpoint.
+  /**
+   * @param ex The I/O executor that the acceptor will use, by default, to
+   * dispatch handlers for any asynchronous operations performed on the
+   * acceptor.
+   *
+   * @param ctx The SSL context used for accepted sessions. The context must
+   * have been created with a DTLS method, and must remain valid until the
+   * acceptor and all of its sessions have been destroyed.
+   *
+   * @param endpoint The local endpoint to which the socket will be bound.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  dtls_acceptor(const executor_type& ex, context& ctx,
+      const endpoint_type& endpoint)
+    : demux_(new demultiplexer_type(ex, ctx.native_handle()))
+  {
+    open_and_bind(endpoint);
+  }
+
+  /// Construct an acceptor bound to the specified endpoint.
+  /**
+   * @param context An execution context which provides the I/O executor that
+   * the acceptor will use, by default, to dispatch handlers for any
+   * asynchronous operations performed on the acceptor.
+   *
+   * @param ctx The SSL context used for accepted sessions. The context must
+   * have been created with a DTLS method, and must remain valid until the
+   * acceptor and all of its sessions have been destroyed.
+   *
+   * @param endpoint The local endpoint to which the socket will be bound.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename ExecutionContext>
+  dtls_acceptor(ExecutionContext& context, ssl::context& ctx,
+      const endpoint_type& endpoint,
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      > = 0)
+    : demux_(new demultiplexer_type(
+          executor_type(context.get_executor()), ctx.native_handle()))
+  {
+    open_and_bind(endpoint);
+  }
+
+  /// Destructor.
+  /**
+   * Closes the socket. Peers that have already been accepted remain valid
+   * objects, but subsequent operations on them fail.
+   */
+  ~dtls_acceptor()
+  {
+    asio::error_code ignored_ec;
+    demux_->close(ignored_ec);
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() noexcept
+  {
+    return demux_->socket_.get_executor();
+  }
+
+  /// Determine whether the acceptor is open.
+  bool is_open() const
+  {
+    return demux_->socket_.is_open();
+  }
+
+  /// Get the local endpoint of the acceptor.
+  /**
+   * @throws asio::system_error Thrown on failure.
+   */
+  endpoint_type local_endpoint() const
+  {
+    return demux_->socket_.local_endpoint();
+  }
+
+  /// Get the local endpoint of the acceptor.
+  /**
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  endpoint_type local_endpoint(asio::error_code& ec) const
+  {
+    return demux_->socket_.local_endpoint(ec);
+  }
+
+  /// Close the acceptor.
+  /**
+   * This function closes the socket. Outstanding accept operations, and
+   * receive operations on accepted peers, complete with the
+   * asio::error::operation_aborted error.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void close()
+  {
+    asio::error_code ec;
+    close(ec);
+    asio::detail::throw_error(ec, "close");
+  }
+
+  /// Close the acceptor.
+  /**
+   * This function closes the socket. Outstanding accept operations, and
+   * receive operations on accepted peers, complete with the
+   * asio::error::operation_aborted error.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID close(asio::error_code& ec)
+  {
+    demux_->close(ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Start an asynchronous accept.
+  /**
+   * This function is used to asynchronously wait for a peer that has returned
+   * a valid cookie. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * On success, @c stream is replaced by a stream for the new peer, whose SSL
+   * object has already processed the peer's ClientHello. The application
+   * completes the session by calling @c async_handshake with
+   * @c stream_base::server. Settings made on @c stream before the accept,
+   * other than its MTU, are not carried over.
+   *
+   * @param stream The stream to be used for the new session. Ownership of the
+   * stream is retained by the caller, which must guarantee that it is valid
+   * until the completion handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the accept completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        AcceptToken = default_completion_token_t<executor_type>>
+  auto async_accept(dtls_stream<peer_socket>& stream,
+      AcceptToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<AcceptToken, void (asio::error_code)>(
+        declval<initiate_async_accept>(), token, &stream))
+  {
+    return async_initiate<AcceptToken, void (asio::error_code)>(
+        initiate_async_accept(this), token, &stream);
+  }
+
+private:
+  void open_and_bind(const endpoint_type& endpoint)
+  {
+    asio::error_code ec;
+    demux_->socket_.open(endpoint.protocol(), ec);
+    asio::detail::throw_error(ec, "open");
+    demux_->socket_.bind(endpoint, ec);
+    asio::detail::throw_error(ec, "bind");
+  }
+
+  class initiate_async_accept
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_accept(dtls_acceptor* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename AcceptHandler>
+    void operator()(AcceptHandler&& handler,
+        dtls_stream<peer_socket>* stream) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a AcceptHandler.
+      ASIO_ACCEPT_HANDLER_CHECK(AcceptHandler, handler) type_check;
+
+      asio::detail::non_const_lvalue<AcceptHandler> handler2(handler);
+      detail::dtls_accept_op<Protocol, Executor,
+        dtls_stream<peer_socket>, decay_t<AcceptHandler>>(
+          self_->demux_, *stream, handler2.value)(asio::error_code(), 1);
+    }
+
+  private:
+    dtls_acceptor* self_;
+  };
+
+  std::shared_ptr<demultiplexer_type> demux_;
+};
+
+/// A peer accepted by a dtls_acceptor.
+/**
+ * A peer socket sends and receives datagrams through its acceptor's socket,
+ * and is intended for use as the next layer of a dtls_stream. A peer socket
+ * supports asynchronous operations only.
+ *
+ * A newly constructed peer socket is not associated with any peer. It becomes
+ * associated with one when the dtls_stream that contains it is accepted.
+ */
+template <typename Protocol, typename Executor>
+class dtls_acceptor<Protocol, Executor>::peer_socket
+  : private noncopyable
+{
+private:
+  class initiate_async_receive;
+  class initiate_async_send;
+
+  typedef typename demultiplexer_type::peer peer_type;
+
+public:
+  /// The type of the executor associated with the object.
+  typedef Executor executor_type;
+
+  /// The endpoint type.
+  typedef typename Protocol::endpoint endpoint_type;
+
+  /// Construct a peer socket that is not yet associated with a peer.
+  explicit peer_socket(dtls_acceptor& acceptor)
+    : demux_(acceptor.demux_)
+  {
+  }
+
+  /// Move-construct a peer socket from another.
+  peer_socket(peer_socket&& other) noexcept
+    : demux_(static_cast<std::shared_ptr<demultiplexer_type>&&>(
+          other.demux_)),
+      peer_(static_cast<std::shared_ptr<peer_type>&&>(other.peer_))
+  {
+  }
+
+  /// Move-assign a peer socket from another.
+  peer_socket& operator=(peer_socket&& other)
+  {
+    if (this != &other)
+    {
+      asio::error_code ignored_ec;
+      close(ignored_ec);
+      demux_ = static_cast<std::shared_ptr<demultiplexer_type>&&>(
+          other.demux_);
+      peer_ = static_cast<std::shared_ptr<peer_type>&&>(other.peer_);
+    }
+    return *this;
+  }
+
+  /// Destructor.
+  /**
+   * Stops routing datagrams to the peer. A later ClientHello from the same
+   * endpoint starts a new session.
+   */
+  ~peer_socket()
+  {
+    asio::error_code ignored_ec;
+    close(ignored_ec);
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() noexcept
+  {
+    return demux_->socket_.get_executor();
+  }
+
+  /// Determine whether the peer socket is associated with a peer.
+  /**
+   * A peer socket is closed when it is closed explicitly or when its acceptor
+   * is closed.
+   */
+  bool is_open() const
+  {
+    return peer_ && !peer_->closed && demux_->socket_.is_open();
+  }
+
+  /// Get the remote endpoint of the peer.
+  /**
+   * @throws asio::system_error Thrown on failure.
+   */
+  endpoint_type remote_endpoint() const
+  {
+    asio::error_code ec;
+    endpoint_type ep = remote_endpoint(ec);
+    asio::detail::throw_error(ec, "remote_endpoint");
+    return ep;
+  }
+
+  /// Get the remote endpoint of the peer.
+  /**
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  endpoint_type remote_endpoint(asio::error_code& ec) const
+  {
+    if (!is_open())
+    {
+      ec = asio::error::bad_descriptor;
+      return endpoint_type();
+    }
+
+    ec = asio::error_code();
+    return peer_->endpoint;
+  }
+
+  /// Close the peer socket.
+  /**
+   * Outstanding receive operations complete with the
+   * asio::error::operation_aborted error.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void close()
+  {
+    asio::error_code ec;
+    close(ec);
+    asio::detail::throw_error(ec, "close");
+  }
+
+  /// Close the peer socket.
+  /**
+   * Outstanding receive operations complete with the
+   * asio::error::operation_aborted error.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID close(asio::error_code& ec)
+  {
+    if (peer_)
+    {
+      demux_->remove_peer(peer_);
+      peer_.reset();
+    }
+
+    ec = asio::error_code();
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Cancel all outstanding receive operations on the peer socket.
+  /**
+   * @throws asio::system_error Thrown on failure.
+   */
+  void cancel()
+  {
+    asio::error_code ec;
+    cancel(ec);
+    asio::detail::throw_error(ec, "cancel");
+  }
+
+  /// Cancel all outstanding receive operations on the peer socket.
+  /**
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID cancel(asio::error_code& ec)
+  {
+    if (!peer_)
+    {
+      ec = asio::error::bad_descriptor;
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    ++peer_->cancel_count;
+    peer_->event.cancel();
+    ec = asio::error_code();
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Start an asynchronous receive.
+  /**
+   * This function is used to asynchronously receive the next datagram from the
+   * peer. It is an initiating function for an @ref asynchronous_operation, and
+   * always returns immediately.
+   *
+   * @param buffers The buffers into which the datagram will be received. A
+   * datagram larger than the buffers is truncated.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_receive(const MutableBufferSequence& buffers,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_receive>(), token, buffers))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive(this), token, buffers);
+  }
+
+  /// Start an asynchronous send.
+  /**
+   * This function is used to asynchronously send a datagram to the peer. It is
+   * an initiating function for an @ref asynchronous_operation, and always
+   * returns immediately.
+   *
+   * @param buffers The data to be sent as one datagram.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the send completes.
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_send(const ConstBufferSequence& buffers,
+      WriteToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<WriteToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_send>(), token, buffers))
+  {
+    return async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send(this), token, buffers);
+  }
+
+private:
+  template <typename, typename, typename, typename>
+  friend class detail::dtls_accept_op;
+
+  // Construct a peer socket for a verified peer.
+  peer_socket(const std::shared_ptr<demultiplexer_type>& demux,
+      const std::shared_ptr<peer_type>& p)
+    : demux_(demux),
+      peer_(p)
+  {
+  }
+
+  class initiate_async_receive
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive(peer_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ReadHandler&& handler,
+        const MutableBufferSequence& buffers) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      asio::detail::non_const_lvalue<ReadHandler> handler2(handler);
+      detail::dtls_peer_receive_op<Protocol, Executor,
+        MutableBufferSequence, decay_t<ReadHandler>>(
+          self_->demux_, self_->peer_, buffers,
+          handler2.value)(asio::error_code(), 1);
+    }
+
+  private:
+    peer_socket* self_;
+  };
+
+  class initiate_async_send
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send(peer_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(WriteHandler&& handler,
+        const ConstBufferSequence& buffers) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      if (!self_->is_open())
+      {
+        asio::post(self_->get_executor(),
+            asio::detail::bind_handler(static_cast<WriteHandler&&>(handler),
+              asio::error_code(asio::error::bad_descriptor),
+              std::size_t(0)));
+        return;
+      }
+
+      self_->demux_->socket_.async_send_to(buffers,
+          self_->peer_->endpoint, static_cast<WriteHandler&&>(handler));
+    }
+
+  private:
+    peer_socket* self_;
+  };
+
+  std::shared_ptr<demultiplexer_type> demux_;
+  std::shared_ptr<peer_type> peer_;
+};
+
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_SSL_DTLS) || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_SSL_DTLS_ACCEPTOR_HPP
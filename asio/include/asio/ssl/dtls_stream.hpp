@@ -0,0 +1,928 @@
+//
+// ssl/dtls_stream.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_DTLS_STREAM_HPP
+#define ASIO_SSL_DTLS_STREAM_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include "asio/async_result.hpp"
+#include "asio/buffer.hpp"
+#include "asio/detail/handler_type_requirements.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/error.hpp"
+#include "asio/ssl/context.hpp"
+#include "asio/ssl/detail/dtls_handshake_op.hpp"
+#include "asio/ssl/detail/dtls_transport.hpp"
+#include "asio/ssl/detail/dtls_write_op.hpp"
+#include "asio/ssl/detail/io.hpp"
+#include "asio/ssl/detail/read_op.hpp"
+#include "asio/ssl/detail/shutdown_op.hpp"
+#include "asio/ssl/detail/stream_core.hpp"
+#include "asio/ssl/stream_base.hpp"
+
+#if defined(ASIO_HAS_SSL_DTLS) || defined(GENERATING_DOCUMENTATION)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+
+/// Provides datagram-oriented functionality using DTLS.
+/**
+ * The dtls_stream class template provides asynchronous and blocking
+ * functionality for a DTLS session over a connected datagram transport, such
+ * as an ip::udp::socket, or a peer accepted by a dtls_acceptor.
+ *
+ * The stream uses the same SSL engine as ssl::stream. Records produced by the
+ * engine are packed into datagrams of no more than the configured MTU, and
+ * each write_some operation sends at most one record, so that one call to
+ * write_some on a peer corresponds to one call to read_some on the other.
+ *
+ * The asynchronous handshake retransmits its last flight when OpenSSL's
+ * retransmission timer expires, and fails with asio::error::timed_out once
+ * OpenSSL gives up. Blocking handshakes wait indefinitely for each response
+ * and so should only be used where datagrams are not lost.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe. The application must also ensure that all
+ * asynchronous operations are performed within the same implicit or explicit
+ * strand.
+ *
+ * @par Example
+ * To use the DTLS stream template with an ip::udp::socket, you would write:
+ * @code
+ * asio::io_context my_context;
+ * asio::ssl::context ctx(asio::ssl::context::dtls_client);
+ * asio::ssl::dtls_stream<asio::ip::udp::socket> sock(my_context, ctx);
+ * sock.next_layer().connect(server_endpoint);
+ * sock.handshake(asio::ssl::stream_base::client);
+ * @endcode
+ *
+ * @par Concepts:
+ * AsyncReadStream, AsyncWriteStream, Stream, SyncReadStream, SyncWriteStream.
+ */
+template <typename Stream>
+class dtls_stream :
+  public stream_base,
+  private noncopyable
+{
+private:
+  class initiate_async_handshake;
+  class initiate_async_shutdown;
+  class initiate_async_write_some;
+  class initiate_async_read_some;
+
+public:
+  /// The native handle type of the DTLS stream.
+  typedef SSL* native_handle_type;
+
+  /// The type of the next layer.
+  typedef remove_reference_t<Stream> next_layer_type;
+
+  /// The type of the executor associated with the object.
+  typedef typename next_layer_type::executor_type executor_type;
+
+  /// The MTU used when none has been set.
+  static constexpr std::size_t default_mtu = 1400;
+
+  /// Construct a stream.
+  /**
+   * This constructor creates a stream and initialises the underlying datagram
+   * transport object.
+   *
+   * @param arg The argument to be passed to initialise the underlying
+   * transport.
+   *
+   * @param ctx The SSL context to be used for the stream. The context must
+   * have been created with a DTLS method.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename Arg>
+  dtls_stream(Arg&& arg, context& ctx)
+    : transport_(static_cast<Arg&&>(arg), 0, default_mtu),
+      core_(ctx.native_handle(), transport_.get_executor())
+  {
+    init();
+  }
+
+  /// Construct a stream from an existing native implementation.
+  /**
+   * This constructor creates a stream and initialises the underlying datagram
+   * transport object. On success, ownership of the native implementation is
+   * transferred to the stream, and it will be cleaned up when the stream is
+   * destroyed.
+   *
+   * @param arg The argument to be passed to initialise the underlying
+   * transport.
+   *
+   * @param handle An existing native SSL implementation using a DTLS method.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename Arg>
+  dtls_stream(Arg&& arg, native_handle_type handle)
+    : transport_(static_cast<Arg&&>(arg), 0, default_mtu),
+      core_(handle, transport_.get_executor())
+  {
+    init();
+  }
+
+  /// Move-construct a stream from another.
+  /**
+   * @param other The other stream object from which the move will occur. Must
+   * have no outstanding asynchronous operations associated with it. Following
+   * the move, @c other has a valid but unspecified state where the only safe
+   * operation is destruction, or use as the target of a move assignment.
+   */
+  dtls_stream(dtls_stream&& other)
+    : transport_(
+        static_cast<detail::dtls_transport<Stream>&&>(
+          other.transport_)),
+      core_(static_cast<detail::stream_core&&>(other.core_))
+  {
+  }
+
+  /// Move-assign a stream from another.
+  /**
+   * @param other The other stream object from which the move will occur. Must
+   * have no outstanding asynchronous operations associated with it. Following
+   * the move, @c other has a valid but unspecified state where the only safe
+   * operation is destruction, or use as the target of a move assignment.
+   */
+  dtls_stream& operator=(dtls_stream&& other)
+  {
+    if (this != &other)
+    {
+      transport_ = static_cast<detail::dtls_transport<Stream>&&>(
+          other.transport_);
+      core_ = static_cast<detail::stream_core&&>(other.core_);
+    }
+    return *this;
+  }
+
+  /// Destructor.
+  /**
+   * @note A @c dtls_stream object must not be destroyed while there are
+   * pending asynchronous operations associated with it.
+   */
+  ~dtls_stream()
+  {
+  }
+
+  /// Get the executor associated with the object.
+  /**
+   * This function may be used to obtain the executor object that the stream
+   * uses to dispatch handlers for asynchronous operations.
+   *
+   * @return A copy of the executor that stream will use to dispatch handlers.
+   */
+  executor_type get_executor() noexcept
+  {
+    return transport_.get_executor();
+  }
+
+  /// Get the underlying implementation in the native type.
+  /**
+   * This function may be used to obtain the underlying implementation of the
+   * context. This is intended to allow access to context functionality that is
+   * not otherwise provided.
+   */
+  native_handle_type native_handle()
+  {
+    return core_.engine_.native_handle();
+  }
+
+  /// Get a reference to the next layer.
+  /**
+   * This function returns a reference to the underlying datagram transport.
+   *
+   * @return A reference to the next layer. Ownership is not transferred to the
+   * caller.
+   */
+  const next_layer_type& next_layer() const
+  {
+    return transport_.next_layer();
+  }
+
+  /// Get a reference to the next layer.
+  /**
+   * This function returns a reference to the underlying datagram transport.
+   *
+   * @return A reference to the next layer. Ownership is not transferred to the
+   * caller.
+   */
+  next_layer_type& next_layer()
+  {
+    return transport_.next_layer();
+  }
+
+  /// Get the MTU used to size outgoing datagrams.
+  std::size_t mtu() const
+  {
+    return transport_.mtu();
+  }
+
+  /// Set the MTU used to size outgoing datagrams.
+  /**
+   * This function sets the largest datagram, excluding IP and UDP headers,
+   * that the stream will send. Handshake messages are fragmented to fit, and
+   * application data written by write_some is limited accordingly.
+   *
+   * @param mtu The new MTU.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Calls @c SSL_set_mtu.
+   */
+  void set_mtu(std::size_t mtu)
+  {
+    asio::error_code ec;
+    set_mtu(mtu, ec);
+    asio::detail::throw_error(ec, "set_mtu");
+  }
+
+  /// Set the MTU used to size outgoing datagrams.
+  /**
+   * This function sets the largest datagram, excluding IP and UDP headers,
+   * that the stream will send. Handshake messages are fragmented to fit, and
+   * application data written by write_some is limited accordingly.
+   *
+   * @param mtu The new MTU.
+   *
+   * @param ec Set to indicate what error occurred, if any. Fails with
+   * asio::error::invalid_argument if the MTU is below the DTLS minimum.
+   *
+   * @note Calls @c SSL_set_mtu.
+   */
+  ASIO_SYNC_OP_VOID set_mtu(std::size_t mtu, asio::error_code& ec)
+  {
+    if (::SSL_set_mtu(core_.engine_.native_handle(),
+          static_cast<long>(mtu)) <= 0)
+    {
+      ec = asio::error::invalid_argument;
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    transport_.set_mtu(mtu);
+    ec = asio::error_code();
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Set the peer verification mode.
+  /**
+   * This function may be used to configure the peer verification mode used by
+   * the stream. The new mode will override the mode inherited from the context.
+   *
+   * @param v A bitmask of peer verification modes. See @ref verify_mode for
+   * available values.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Calls @c SSL_set_verify.
+   */
+  void set_verify_mode(verify_mode v)
+  {
+    asio::error_code ec;
+    set_verify_mode(v, ec);
+    asio::detail::throw_error(ec, "set_verify_mode");
+  }
+
+  /// Set the peer verification mode.
+  /**
+   * This function may be used to configure the peer verification mode used by
+   * the stream. The new mode will override the mode inherited from the context.
+   *
+   * @param v A bitmask of peer verification modes. See @ref verify_mode for
+   * available values.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note Calls @c SSL_set_verify.
+   */
+  ASIO_SYNC_OP_VOID set_verify_mode(
+      verify_mode v, asio::error_code& ec)
+  {
+    core_.engine_.set_verify_mode(v, ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Set the peer verification depth.
+  /**
+   * This function may be used to configure the maximum verification depth
+   * allowed by the stream.
+   *
+   * @param depth Maximum depth for the certificate chain verification that
+   * shall be allowed.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Calls @c SSL_set_verify_depth.
+   */
+  void set_verify_depth(int depth)
+  {
+    asio::error_code ec;
+    set_verify_depth(depth, ec);
+    asio::detail::throw_error(ec, "set_verify_depth");
+  }
+
+  /// Set the peer verification depth.
+  /**
+   * This function may be used to configure the maximum verification depth
+   * allowed by the stream.
+   *
+   * @param depth Maximum depth for the certificate chain verification that
+   * shall be allowed.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note Calls @c SSL_set_verify_depth.
+   */
+  ASIO_SYNC_OP_VOID set_verify_depth(
+      int depth, asio::error_code& ec)
+  {
+    core_.engine_.set_verify_depth(depth, ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Set the callback used to verify peer certificates.
+  /**
+   * This function is used to specify a callback function that will be called
+   * by the implementation when it needs to verify a peer certificate.
+   *
+   * @param callback The function object to be used for verifying a certificate.
+   * The function signature of the handler must be:
+   * @code bool verify_callback(
+   *   bool preverified, // True if the certificate passed pre-verification.
+   *   verify_context& ctx // The peer certificate and other context.
+   * ); @endcode
+   * The return value of the callback is true if the certificate has passed
+   * verification, false otherwise.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Calls @c SSL_set_verify.
+   */
+  template <typename VerifyCallback>
+  void set_verify_callback(VerifyCallback callback)
+  {
+    asio::error_code ec;
+    this->set_verify_callback(callback, ec);
+    asio::detail::throw_error(ec, "set_verify_callback");
+  }
+
+  /// Set the callback used to verify peer certificates.
+  /**
+   * This function is used to specify a callback function that will be called
+   * by the implementation when it needs to verify a peer certificate.
+   *
+   * @param callback The function object to be used for verifying a certificate.
+   * The function signature of the handler must be:
+   * @code bool verify_callback(
+   *   bool preverified, // True if the certificate passed pre-verification.
+   *   verify_context& ctx // The peer certificate and other context.
+   * ); @endcode
+   * The return value of the callback is true if the certificate has passed
+   * verification, false otherwise.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note Calls @c SSL_set_verify.
+   */
+  template <typename VerifyCallback>
+  ASIO_SYNC_OP_VOID set_verify_callback(VerifyCallback callback,
+      asio::error_code& ec)
+  {
+    core_.engine_.set_verify_callback(
+        new detail::verify_callback<VerifyCallback>(callback), ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Perform DTLS handshaking.
+  /**
+   * This function is used to perform DTLS handshaking on the stream. The
+   * function call will block until handshaking is complete or an error occurs.
+   *
+   * @param type The type of handshaking to be performed, i.e. as a client or as
+   * a server.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void handshake(handshake_type type)
+  {
+    asio::error_code ec;
+    handshake(type, ec);
+    asio::detail::throw_error(ec, "handshake");
+  }
+
+  /// Perform DTLS handshaking.
+  /**
+   * This function is used to perform DTLS handshaking on the stream. The
+   * function call will block until handshaking is complete or an error occurs.
+   *
+   * @param type The type of handshaking to be performed, i.e. as a client or as
+   * a server.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID handshake(handshake_type type,
+      asio::error_code& ec)
+  {
+    detail::io(transport_, core_, detail::dtls_handshake_op(type), ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Start an asynchronous DTLS handshake.
+  /**
+   * This function is used to asynchronously perform a DTLS handshake on the
+   * stream. It is an initiating function for an @ref asynchronous_operation,
+   * and always returns immediately.
+   *
+   * Lost flights are retransmitted as directed by OpenSSL's retransmission
+   * timer. The operation fails with asio::error::timed_out if the peer does
+   * not respond after the maximum number of retransmissions.
+   *
+   * @param type The type of handshaking to be performed, i.e. as a client or as
+   * a server.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the handshake completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * if they are also supported by the @c Stream type's @c async_receive and
+   * @c async_send operations.
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        HandshakeToken = default_completion_token_t<executor_type>>
+  auto async_handshake(handshake_type type,
+      HandshakeToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<HandshakeToken,
+        void (asio::error_code)>(
+          declval<initiate_async_handshake>(), token, type))
+  {
+    return async_initiate<HandshakeToken,
+      void (asio::error_code)>(
+        initiate_async_handshake(this), token, type);
+  }
+
+  /// Shut down DTLS on the stream.
+  /**
+   * This function is used to shut down DTLS on the stream. The function call
+   * will block until DTLS has been shut down or an error occurs.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void shutdown()
+  {
+    asio::error_code ec;
+    shutdown(ec);
+    asio::detail::throw_error(ec, "shutdown");
+  }
+
+  /// Shut down DTLS on the stream.
+  /**
+   * This function is used to shut down DTLS on the stream. The function call
+   * will block until DTLS has been shut down or an error occurs.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID shutdown(asio::error_code& ec)
+  {
+    detail::io(transport_, core_, detail::shutdown_op(), ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Asynchronously shut down DTLS on the stream.
+  /**
+   * This function is used to asynchronously shut down DTLS on the stream. It
+   * is an initiating function for an @ref asynchronous_operation, and always
+   * returns immediately.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the shutdown completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * if they are also supported by the @c Stream type's @c async_receive and
+   * @c async_send operations.
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        ShutdownToken
+          = default_completion_token_t<executor_type>>
+  auto async_shutdown(
+      ShutdownToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ShutdownToken,
+        void (asio::error_code)>(
+          declval<initiate_async_shutdown>(), token))
+  {
+    return async_initiate<ShutdownToken,
+      void (asio::error_code)>(
+        initiate_async_shutdown(this), token);
+  }
+
+  /// Write a record to the stream.
+  /**
+   * This function is used to write data on the stream as a single DTLS record.
+   * The function call will block until the record has been sent, or until an
+   * error occurs.
+   *
+   * @param buffers The data to be written.
+   *
+   * @returns The number of bytes written. This is less than the size of the
+   * data if it does not fit in one datagram.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t write_some(const ConstBufferSequence& buffers)
+  {
+    asio::error_code ec;
+    std::size_t n = write_some(buffers, ec);
+    asio::detail::throw_error(ec, "write_some");
+    return n;
+  }
+
+  /// Write a record to the stream.
+  /**
+   * This function is used to write data on the stream as a single DTLS record.
+   * The function call will block until the record has been sent, or until an
+   * error occurs.
+   *
+   * @param buffers The data to be written to the stream.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes written. Returns 0 if an error occurred. This
+   * is less than the size of the data if it does not fit in one datagram.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t write_some(const ConstBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    return detail::io(transport_, core_,
+        detail::dtls_write_op<ConstBufferSequence>(buffers), ec);
+  }
+
+  /// Start an asynchronous write of a record.
+  /**
+   * This function is used to asynchronously write data to the stream as a
+   * single DTLS record. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * @param buffers The data to be written to the stream. Although the buffers
+   * object may be copied as necessary, ownership of the underlying buffers is
+   * retained by the caller, which must guarantee that they remain valid until
+   * the completion handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the write completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes written.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * if they are also supported by the @c Stream type's @c async_receive and
+   * @c async_send operations.
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_write_some(const ConstBufferSequence& buffers,
+      WriteToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<WriteToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_write_some>(), token, buffers))
+  {
+    return async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_write_some(this), token, buffers);
+  }
+
+  /// Read some data from the stream.
+  /**
+   * This function is used to read data from the stream. The function call will
+   * block until the next record has been received, or until an error occurs.
+   *
+   * @param buffers The buffers into which the data will be read.
+   *
+   * @returns The number of bytes read.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers)
+  {
+    asio::error_code ec;
+    std::size_t n = read_some(buffers, ec);
+    asio::detail::throw_error(ec, "read_some");
+    return n;
+  }
+
+  /// Read some data from the stream.
+  /**
+   * This function is used to read data from the stream. The function call will
+   * block until the next record has been received, or until an error occurs.
+   *
+   * @param buffers The buffers into which the data will be read.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes read. Returns 0 if an error occurred.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    return detail::io(transport_, core_,
+        detail::read_op<MutableBufferSequence>(buffers), ec);
+  }
+
+  /// Start an asynchronous read.
+  /**
+   * This function is used to asynchronously read the next record from the
+   * stream. It is an initiating function for an @ref asynchronous_operation,
+   * and always returns immediately.
+   *
+   * @param buffers The buffers into which the data will be read. Although the
+   * buffers object may be copied as necessary, ownership of the underlying
+   * buffers is retained by the caller, which must guarantee that they remain
+   * valid until the completion handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the read completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes read.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * if they are also supported by the @c Stream type's @c async_receive and
+   * @c async_send operations.
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_read_some(const MutableBufferSequence& buffers,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_read_some>(), token, buffers))
+  {
+    return async_initiate<ReadToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_read_some(this), token, buffers);
+  }
+
+private:
+  // Apply the settings needed to run the engine over datagrams.
+  void init()
+  {
+    SSL* ssl = core_.engine_.native_handle();
+    if (!::SSL_is_dtls(ssl))
+    {
+      asio::detail::throw_error(
+          asio::error::invalid_argument, "dtls_stream");
+    }
+
+    // The MTU cannot be queried through the engine's BIO pair.
+    ::SSL_set_options(ssl, SSL_OP_NO_QUERY_MTU);
+    ::SSL_set_mtu(ssl, static_cast<long>(default_mtu));
+    transport_.set_native_handle(ssl);
+  }
+
+  class initiate_async_handshake
+  {
+  public:
+    typedef typename dtls_stream::executor_type executor_type;
+
+    explicit initiate_async_handshake(dtls_stream* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename HandshakeHandler>
+    void operator()(HandshakeHandler&& handler,
+        handshake_type type) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a HandshakeHandler.
+      ASIO_HANDSHAKE_HANDLER_CHECK(HandshakeHandler, handler) type_check;
+
+      asio::detail::non_const_lvalue<HandshakeHandler> handler2(handler);
+      detail::async_io(self_->transport_, self_->core_,
+          detail::dtls_handshake_op(type), handler2.value);
+    }
+
+  private:
+    dtls_stream* self_;
+  };
+
+  class initiate_async_shutdown
+  {
+  public:
+    typedef typename dtls_stream::executor_type executor_type;
+
+    explicit initiate_async_shutdown(dtls_stream* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ShutdownHandler>
+    void operator()(ShutdownHandler&& handler) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ShutdownHandler.
+      ASIO_HANDSHAKE_HANDLER_CHECK(ShutdownHandler, handler) type_check;
+
+      asio::detail::non_const_lvalue<ShutdownHandler> handler2(handler);
+      detail::async_io(self_->transport_, self_->core_,
+          detail::shutdown_op(), handler2.value);
+    }
+
+  private:
+    dtls_stream* self_;
+  };
+
+  class initiate_async_write_some
+  {
+  public:
+    typedef typename dtls_stream::executor_type executor_type;
+
+    explicit initiate_async_write_some(dtls_stream* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(WriteHandler&& handler,
+        const ConstBufferSequence& buffers) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      asio::detail::non_const_lvalue<WriteHandler> handler2(handler);
+      detail::async_io(self_->transport_, self_->core_,
+          detail::dtls_write_op<ConstBufferSequence>(buffers),
+          handler2.value);
+    }
+
+  private:
+    dtls_stream* self_;
+  };
+
+  class initiate_async_read_some
+  {
+  public:
+    typedef typename dtls_stream::executor_type executor_type;
+
+    explicit initiate_async_read_some(dtls_stream* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ReadHandler&& handler,
+        const MutableBufferSequence& buffers) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      asio::detail::non_const_lvalue<ReadHandler> handler2(handler);
+      detail::async_io(self_->transport_, self_->core_,
+          detail::read_op<MutableBufferSequence>(buffers), handler2.value);
+    }
+
+  private:
+    dtls_stream* self_;
+  };
+
+  detail::dtls_transport<Stream> transport_;
+  detail::stream_core core_;
+};
+
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_SSL_DTLS) || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_SSL_DTLS_STREAM_HPP
@@ -23,6 +23,7 @@
 #include "asio/error.hpp"
 #include "asio/ssl/context.hpp"
 #include "asio/ssl/error.hpp"
+#include "asio/ssl/trust_store.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -355,6 +356,26 @@ context::context(context::method m)
     break;
 #endif // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
 
+    // Any supported DTLS version.
+#if defined(ASIO_HAS_SSL_DTLS)
+  case context::dtls:
+    handle_ = ::SSL_CTX_new(::DTLS_method());
+    break;
+  case context::dtls_client:
+    handle_ = ::SSL_CTX_new(::DTLS_client_method());
+    break;
+  case context::dtls_server:
+    handle_ = ::SSL_CTX_new(::DTLS_server_method());
+    break;
+#else // defined(ASIO_HAS_SSL_DTLS)
+  case context::dtls:
+  case context::dtls_client:
+  case context::dtls_server:
+    asio::detail::throw_error(
+        asio::error::invalid_argument, "context");
+    break;
+#endif // defined(ASIO_HAS_SSL_DTLS)
+
   default:
     handle_ = ::SSL_CTX_new(0);
     break;
@@ -1196,6 +1217,47 @@ ASIO_SYNC_OP_VOID context::do_use_tmp_dh(
   ASIO_SYNC_OP_VOID_RETURN(ec);
 }
 
+void context::set_session_cache(session_cache& cache)
+{
+  asio::error_code ec;
+  set_session_cache(cache, ec);
+  asio::detail::throw_error(ec, "set_session_cache");
+}
+
+ASIO_SYNC_OP_VOID context::set_session_cache(
+    session_cache& cache, asio::error_code& ec)
+{
+  ::ERR_clear_error();
+
+  cache.attach(handle_, ec);
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+void context::set_trust_store(const trust_store& store)
+{
+  asio::error_code ec;
+  set_trust_store(store, ec);
+  asio::detail::throw_error(ec, "set_trust_store");
+}
+
+ASIO_SYNC_OP_VOID context::set_trust_store(
+    const trust_store& store, asio::error_code& ec)
+{
+  if (!store.handle_)
+  {
+    ec = asio::error::invalid_argument;
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  ::X509_STORE_up_ref(store.handle_);
+  ::SSL_CTX_set_cert_store(handle_, store.handle_);
+  ::SSL_CTX_set_cert_verify_callback(handle_,
+      &trust_store::verify_chain_callback, 0);
+
+  ec = asio::error_code();
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
 ASIO_SYNC_OP_VOID context::do_set_verify_callback(
     detail::verify_callback_base* callback, asio::error_code& ec)
 {
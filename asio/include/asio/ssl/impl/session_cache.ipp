@@ -0,0 +1,542 @@
+//
+// ssl/impl/session_cache.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_IMPL_SESSION_CACHE_IPP
+#define ASIO_SSL_IMPL_SESSION_CACHE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include "asio/detail/throw_error.hpp"
+#include "asio/error.hpp"
+#include "asio/ssl/error.hpp"
+#include "asio/ssl/session_cache.hpp"
+
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+# include <openssl/core_names.h>
+#endif // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+
+session_cache::session_cache(std::size_t capacity, std::size_t shards)
+  : capacity_((std::max)(capacity, static_cast<std::size_t>(1))),
+    shard_capacity_(0),
+    ticket_key_lifetime_(3600)
+{
+  std::size_t shard_count = (std::min)(
+      (std::max)(shards, static_cast<std::size_t>(1)), capacity_);
+  shard_capacity_ = (capacity_ + shard_count - 1) / shard_count;
+
+  shards_.reserve(shard_count);
+  for (std::size_t i = 0; i < shard_count; ++i)
+    shards_.push_back(new shard);
+
+  asio::error_code ec;
+  if (::RAND_bytes(id_context_, sizeof(id_context_)) != 1)
+  {
+    ec = asio::error_code(static_cast<int>(::ERR_get_error()),
+        asio::error::get_ssl_category());
+  }
+  else
+  {
+    asio::detail::mutex::scoped_lock lock(ticket_mutex_);
+    generate_ticket_key(ec);
+  }
+
+  if (ec)
+  {
+    for (std::size_t i = 0; i < shards_.size(); ++i)
+      delete shards_[i];
+    asio::detail::throw_error(ec, "session_cache");
+  }
+}
+
+session_cache::~session_cache()
+{
+  for (std::size_t i = 0; i < shards_.size(); ++i)
+  {
+    for (entry_list::iterator iter = shards_[i]->entries_.begin();
+        iter != shards_[i]->entries_.end(); ++iter)
+      ::SSL_SESSION_free(iter->session);
+    delete shards_[i];
+  }
+
+  ::OPENSSL_cleanse(id_context_, sizeof(id_context_));
+  if (!ticket_keys_.empty())
+  {
+    ::OPENSSL_cleanse(&ticket_keys_[0],
+        ticket_keys_.size() * sizeof(ticket_key));
+  }
+}
+
+std::size_t session_cache::size() const
+{
+  std::size_t n = 0;
+  for (std::size_t i = 0; i < shards_.size(); ++i)
+  {
+    asio::detail::mutex::scoped_lock lock(shards_[i]->mutex_);
+    n += shards_[i]->entries_.size();
+  }
+  return n;
+}
+
+void session_cache::clear()
+{
+  for (std::size_t i = 0; i < shards_.size(); ++i)
+  {
+    entry_list entries;
+    {
+      asio::detail::mutex::scoped_lock lock(shards_[i]->mutex_);
+      entries.swap(shards_[i]->entries_);
+      shards_[i]->index_.clear();
+    }
+
+    for (entry_list::iterator iter = entries.begin();
+        iter != entries.end(); ++iter)
+      ::SSL_SESSION_free(iter->session);
+  }
+}
+
+void session_cache::set_ticket_key_lifetime(
+    const asio::chrono::seconds& lifetime)
+{
+  asio::detail::mutex::scoped_lock lock(ticket_mutex_);
+  ticket_key_lifetime_ = lifetime;
+}
+
+void session_cache::rotate_ticket_keys()
+{
+  asio::error_code ec;
+  rotate_ticket_keys(ec);
+  asio::detail::throw_error(ec, "rotate_ticket_keys");
+}
+
+ASIO_SYNC_OP_VOID session_cache::rotate_ticket_keys(asio::error_code& ec)
+{
+  asio::detail::mutex::scoped_lock lock(ticket_mutex_);
+  generate_ticket_key(ec);
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+asio::error_code session_cache::attach(
+    SSL_CTX* ctx, asio::error_code& ec)
+{
+  if (::SSL_CTX_set_ex_data(ctx, context_ex_data_index(), this) != 1
+      || ::SSL_CTX_set_session_id_context(ctx,
+        id_context_, sizeof(id_context_)) != 1)
+  {
+    ec = asio::error_code(static_cast<int>(::ERR_get_error()),
+        asio::error::get_ssl_category());
+    return ec;
+  }
+
+  // The context's internal cache is bypassed so that every session is held
+  // by this cache, where other contexts can find it.
+  ::SSL_CTX_set_session_cache_mode(ctx,
+      SSL_SESS_CACHE_BOTH | SSL_SESS_CACHE_NO_INTERNAL);
+  ::SSL_CTX_sess_set_new_cb(ctx, &session_cache::new_session_callback);
+  ::SSL_CTX_sess_set_get_cb(ctx, &session_cache::get_session_callback);
+  ::SSL_CTX_sess_set_remove_cb(ctx, &session_cache::remove_session_callback);
+
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  ::SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx,
+      &session_cache::ticket_key_callback);
+#else // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  ::SSL_CTX_set_tlsext_ticket_key_cb(ctx,
+      &session_cache::ticket_key_callback);
+#endif // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+
+  ec = asio::error_code();
+  return ec;
+}
+
+session_cache::shard& session_cache::shard_for(const std::string& key)
+{
+  return *shards_[std::hash<std::string>()(key) % shards_.size()];
+}
+
+void session_cache::insert(const std::string& key, SSL_SESSION* session)
+{
+  SSL_SESSION* evicted = 0;
+  SSL_SESSION* replaced = 0;
+  {
+    shard& s = shard_for(key);
+    asio::detail::mutex::scoped_lock lock(s.mutex_);
+
+    std::unordered_map<std::string, entry_list::iterator>::iterator
+      found = s.index_.find(key);
+    if (found != s.index_.end())
+    {
+      replaced = found->second->session;
+      found->second->session = session;
+      s.entries_.splice(s.entries_.begin(), s.entries_, found->second);
+    }
+    else
+    {
+      if (s.entries_.size() >= shard_capacity_)
+      {
+        evicted = s.entries_.back().session;
+        s.index_.erase(s.entries_.back().key);
+        s.entries_.pop_back();
+      }
+
+      entry e = { key, session };
+      s.entries_.push_front(e);
+      s.index_[key] = s.entries_.begin();
+    }
+  }
+
+  // Sessions are freed without holding the lock.
+  if (evicted)
+    ::SSL_SESSION_free(evicted);
+  if (replaced)
+    ::SSL_SESSION_free(replaced);
+}
+
+SSL_SESSION* session_cache::find(const std::string& key)
+{
+  SSL_SESSION* expired = 0;
+  SSL_SESSION* result = 0;
+  {
+    shard& s = shard_for(key);
+    asio::detail::mutex::scoped_lock lock(s.mutex_);
+
+    std::unordered_map<std::string, entry_list::iterator>::iterator
+      found = s.index_.find(key);
+    if (found == s.index_.end())
+      return 0;
+
+    SSL_SESSION* session = found->second->session;
+    bool usable = static_cast<long>(std::time(0))
+      < ::SSL_SESSION_get_time(session) + ::SSL_SESSION_get_timeout(session);
+#if (OPENSSL_VERSION_NUMBER >= 0x10101000L)
+    usable = usable && ::SSL_SESSION_is_resumable(session);
+#endif // (OPENSSL_VERSION_NUMBER >= 0x10101000L)
+
+    if (usable)
+    {
+      s.entries_.splice(s.entries_.begin(), s.entries_, found->second);
+      ::SSL_SESSION_up_ref(session);
+      result = session;
+    }
+    else
+    {
+      expired = session;
+      s.entries_.erase(found->second);
+      s.index_.erase(found);
+    }
+  }
+
+  if (expired)
+    ::SSL_SESSION_free(expired);
+  return result;
+}
+
+void session_cache::erase(const std::string& key, SSL_SESSION* session)
+{
+  {
+    shard& s = shard_for(key);
+    asio::detail::mutex::scoped_lock lock(s.mutex_);
+
+    std::unordered_map<std::string, entry_list::iterator>::iterator
+      found = s.index_.find(key);
+    if (found == s.index_.end() || found->second->session != session)
+      return;
+
+    s.entries_.erase(found->second);
+    s.index_.erase(found);
+  }
+
+  ::SSL_SESSION_free(session);
+}
+
+void session_cache::generate_ticket_key(asio::error_code& ec)
+{
+  ticket_key key;
+  if (::RAND_bytes(key.name, sizeof(key.name)) != 1
+      || ::RAND_bytes(key.aes_key, sizeof(key.aes_key)) != 1
+      || ::RAND_bytes(key.hmac_key, sizeof(key.hmac_key)) != 1)
+  {
+    ::OPENSSL_cleanse(&key, sizeof(key));
+    ec = asio::error_code(static_cast<int>(::ERR_get_error()),
+        asio::error::get_ssl_category());
+    return;
+  }
+  key.created = asio::chrono::steady_clock::now();
+
+  ticket_keys_.insert(ticket_keys_.begin(), key);
+  ::OPENSSL_cleanse(&key, sizeof(key));
+  if (ticket_keys_.size() > max_ticket_keys)
+  {
+    ::OPENSSL_cleanse(&ticket_keys_.back(), sizeof(ticket_key));
+    ticket_keys_.pop_back();
+  }
+
+  ec = asio::error_code();
+}
+
+void session_cache::current_ticket_key(ticket_key& key)
+{
+  asio::detail::mutex::scoped_lock lock(ticket_mutex_);
+
+  if (ticket_key_lifetime_.count() > 0
+      && asio::chrono::steady_clock::now() - ticket_keys_.front().created
+        >= ticket_key_lifetime_)
+  {
+    // If a new key cannot be generated the current one remains in use.
+    asio::error_code ec;
+    generate_ticket_key(ec);
+  }
+
+  key = ticket_keys_.front();
+}
+
+int session_cache::find_ticket_key(const unsigned char* name, ticket_key& key)
+{
+  asio::detail::mutex::scoped_lock lock(ticket_mutex_);
+
+  for (std::size_t i = 0; i < ticket_keys_.size(); ++i)
+  {
+    if (std::memcmp(ticket_keys_[i].name, name, sizeof(key.name)) == 0)
+    {
+      key = ticket_keys_[i];
+      return i == 0 ? 1 : 2;
+    }
+  }
+
+  return 0;
+}
+
+session_cache* session_cache::get_cache(SSL_CTX* ctx)
+{
+  return static_cast<session_cache*>(
+      ::SSL_CTX_get_ex_data(ctx, context_ex_data_index()));
+}
+
+bool session_cache::client_key(SSL* ssl, std::string& key)
+{
+  if (const std::string* explicit_key = static_cast<const std::string*>(
+        ::SSL_get_ex_data(ssl, client_key_ex_data_index())))
+  {
+    key = 'c' + *explicit_key;
+    return true;
+  }
+
+  if (const char* name = ::SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name))
+  {
+    key = std::string("c") + name;
+    return true;
+  }
+
+  return false;
+}
+
+std::string session_cache::server_key(
+    const unsigned char* id, unsigned int length)
+{
+  std::string key(1, 's');
+  key.append(reinterpret_cast<const char*>(id), length);
+  return key;
+}
+
+asio::error_code session_cache::set_client_key(SSL* ssl,
+    const std::string& key, asio::error_code& ec)
+{
+  std::string* new_key = new std::string(key);
+  std::string* old_key = static_cast<std::string*>(
+      ::SSL_get_ex_data(ssl, client_key_ex_data_index()));
+
+  if (::SSL_set_ex_data(ssl, client_key_ex_data_index(), new_key) != 1)
+  {
+    delete new_key;
+    ec = asio::error_code(static_cast<int>(::ERR_get_error()),
+        asio::error::get_ssl_category());
+    return ec;
+  }
+
+  delete old_key;
+  ec = asio::error_code();
+  return ec;
+}
+
+void session_cache::resume_client(SSL* ssl)
+{
+  session_cache* cache = get_cache(::SSL_get_SSL_CTX(ssl));
+  if (!cache || ::SSL_get_session(ssl))
+    return;
+
+  std::string key;
+  if (!client_key(ssl, key))
+    return;
+
+  if (SSL_SESSION* session = cache->find(key))
+  {
+    ::SSL_set_session(ssl, session);
+    ::SSL_SESSION_free(session);
+  }
+}
+
+int session_cache::context_ex_data_index()
+{
+  static const int index = ::SSL_CTX_get_ex_new_index(0, 0, 0, 0, 0);
+  return index;
+}
+
+int session_cache::client_key_ex_data_index()
+{
+  static const int index = ::SSL_get_ex_new_index(0, 0, 0, 0,
+      &session_cache::free_client_key);
+  return index;
+}
+
+void session_cache::free_client_key(void*, void* ptr,
+    CRYPTO_EX_DATA*, int, long, void*)
+{
+  delete static_cast<std::string*>(ptr);
+}
+
+int session_cache::new_session_callback(SSL* ssl, SSL_SESSION* session)
+{
+  session_cache* cache = get_cache(::SSL_get_SSL_CTX(ssl));
+  if (!cache)
+    return 0;
+
+  std::string key;
+  if (::SSL_is_server(ssl))
+  {
+    unsigned int length = 0;
+    const unsigned char* id = ::SSL_SESSION_get_id(session, &length);
+    if (length == 0)
+      return 0;
+    key = server_key(id, length);
+  }
+  else if (!client_key(ssl, key))
+  {
+    return 0;
+  }
+
+  // Returning 1 passes ownership of the session reference to the cache.
+  cache->insert(key, session);
+  return 1;
+}
+
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+SSL_SESSION* session_cache::get_session_callback(SSL* ssl,
+    const unsigned char* id, int length, int* copy)
+#else // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+SSL_SESSION* session_cache::get_session_callback(SSL* ssl,
+    unsigned char* id, int length, int* copy)
+#endif // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+{
+  // The returned reference is passed to the caller.
+  *copy = 0;
+
+  session_cache* cache = get_cache(::SSL_get_SSL_CTX(ssl));
+  if (!cache || length <= 0)
+    return 0;
+
+  return cache->find(server_key(id, static_cast<unsigned int>(length)));
+}
+
+void session_cache::remove_session_callback(
+    SSL_CTX* ctx, SSL_SESSION* session)
+{
+  session_cache* cache = get_cache(ctx);
+  if (!cache)
+    return;
+
+  unsigned int length = 0;
+  const unsigned char* id = ::SSL_SESSION_get_id(session, &length);
+  if (length > 0)
+    cache->erase(server_key(id, length), session);
+}
+
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+int session_cache::ticket_key_callback(SSL* ssl,
+    unsigned char* name, unsigned char* iv, EVP_CIPHER_CTX* cipher_ctx,
+    EVP_MAC_CTX* mac_ctx, int enc)
+#else // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+int session_cache::ticket_key_callback(SSL* ssl,
+    unsigned char* name, unsigned char* iv, EVP_CIPHER_CTX* cipher_ctx,
+    HMAC_CTX* mac_ctx, int enc)
+#endif // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+{
+  session_cache* cache = get_cache(::SSL_get_SSL_CTX(ssl));
+  if (!cache)
+    return -1;
+
+  ticket_key key;
+  int result = 1;
+  if (enc)
+  {
+    cache->current_ticket_key(key);
+    std::memcpy(name, key.name, sizeof(key.name));
+    if (::RAND_bytes(iv, EVP_CIPHER_iv_length(::EVP_aes_256_cbc())) != 1)
+      result = -1;
+  }
+  else
+  {
+    result = cache->find_ticket_key(name, key);
+
+#if defined(TLS1_3_VERSION)
+    // A TLS 1.3 client does not use a ticket more than once, so a resumed
+    // connection always receives a replacement.
+    if (result == 1 && ::SSL_version(ssl) >= TLS1_3_VERSION)
+      result = 2;
+#endif // defined(TLS1_3_VERSION)
+  }
+
+  if (result > 0)
+  {
+    int ok = enc
+      ? ::EVP_EncryptInit_ex(cipher_ctx,
+          ::EVP_aes_256_cbc(), 0, key.aes_key, iv)
+      : ::EVP_DecryptInit_ex(cipher_ctx,
+          ::EVP_aes_256_cbc(), 0, key.aes_key, iv);
+
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+    OSSL_PARAM params[] =
+    {
+      ::OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY,
+          key.hmac_key, sizeof(key.hmac_key)),
+      ::OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST,
+          const_cast<char*>("SHA256"), 0),
+      ::OSSL_PARAM_construct_end()
+    };
+    ok = ok && ::EVP_MAC_CTX_set_params(mac_ctx, params);
+#else // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+    ok = ok && ::HMAC_Init_ex(mac_ctx, key.hmac_key,
+        sizeof(key.hmac_key), ::EVP_sha256(), 0);
+#endif // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+
+    if (!ok)
+      result = -1;
+  }
+
+  ::OPENSSL_cleanse(&key, sizeof(key));
+  return result;
+}
+
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_SSL_IMPL_SESSION_CACHE_IPP
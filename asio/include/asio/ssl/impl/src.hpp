@@ -21,8 +21,11 @@
 
 #include "asio/ssl/impl/context.ipp"
 #include "asio/ssl/impl/error.ipp"
+#include "asio/ssl/detail/impl/dtls_listener.ipp"
 #include "asio/ssl/detail/impl/engine.ipp"
 #include "asio/ssl/detail/impl/openssl_init.ipp"
 #include "asio/ssl/impl/host_name_verification.ipp"
+#include "asio/ssl/impl/session_cache.ipp"
+#include "asio/ssl/impl/trust_store.ipp"
 
 #endif // ASIO_SSL_IMPL_SRC_HPP
@@ -0,0 +1,490 @@
+//
+// ssl/impl/trust_store.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_IMPL_TRUST_STORE_IPP
+#define ASIO_SSL_IMPL_TRUST_STORE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include "asio/detail/throw_error.hpp"
+#include "asio/error.hpp"
+#include "asio/ssl/context.hpp"
+#include "asio/ssl/error.hpp"
+#include "asio/ssl/trust_store.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+
+struct trust_store::bio_cleanup
+{
+  BIO* p;
+  ~bio_cleanup() { if (p) ::BIO_free(p); }
+};
+
+struct trust_store::x509_cleanup
+{
+  X509* p;
+  ~x509_cleanup() { if (p) ::X509_free(p); }
+};
+
+trust_store::trust_store()
+  : handle_(0)
+{
+  init(0, asio::chrono::seconds(0));
+}
+
+trust_store::trust_store(std::size_t cache_capacity,
+    const asio::chrono::seconds& cache_lifetime)
+  : handle_(0)
+{
+  init(cache_capacity, cache_lifetime);
+}
+
+trust_store::trust_store(const trust_store& other) noexcept
+  : handle_(other.handle_)
+{
+  if (handle_)
+    ::X509_STORE_up_ref(handle_);
+}
+
+trust_store::trust_store(trust_store&& other) noexcept
+  : handle_(other.handle_)
+{
+  other.handle_ = 0;
+}
+
+trust_store& trust_store::operator=(const trust_store& other) noexcept
+{
+  if (other.handle_)
+    ::X509_STORE_up_ref(other.handle_);
+  if (handle_)
+    ::X509_STORE_free(handle_);
+  handle_ = other.handle_;
+  return *this;
+}
+
+trust_store::~trust_store()
+{
+  if (handle_)
+    ::X509_STORE_free(handle_);
+}
+
+void trust_store::add_certificate_authority(const const_buffer& ca)
+{
+  asio::error_code ec;
+  add_certificate_authority(ca, ec);
+  asio::detail::throw_error(ec, "add_certificate_authority");
+}
+
+ASIO_SYNC_OP_VOID trust_store::add_certificate_authority(
+    const const_buffer& ca, asio::error_code& ec)
+{
+  ::ERR_clear_error();
+
+  bio_cleanup bio = { ::BIO_new_mem_buf(
+      const_cast<void*>(ca.data()), static_cast<int>(ca.size())) };
+  if (bio.p)
+  {
+    for (bool added = false;; added = true)
+    {
+      x509_cleanup cert = { ::PEM_read_bio_X509(bio.p, 0, 0, 0) };
+      if (!cert.p)
+      {
+        unsigned long err = ::ERR_get_error();
+        if (added && ERR_GET_LIB(err) == ERR_LIB_PEM
+            && ERR_GET_REASON(err) == PEM_R_NO_START_LINE)
+          break;
+
+        ec = context::translate_error(err);
+        ASIO_SYNC_OP_VOID_RETURN(ec);
+      }
+
+      if (::X509_STORE_add_cert(handle_, cert.p) != 1)
+      {
+        ec = context::translate_error(::ERR_get_error());
+        ASIO_SYNC_OP_VOID_RETURN(ec);
+      }
+    }
+  }
+
+  ec = asio::error_code();
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+void trust_store::load_verify_file(const std::string& filename)
+{
+  asio::error_code ec;
+  load_verify_file(filename, ec);
+  asio::detail::throw_error(ec, "load_verify_file");
+}
+
+ASIO_SYNC_OP_VOID trust_store::load_verify_file(
+    const std::string& filename, asio::error_code& ec)
+{
+  ::ERR_clear_error();
+
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  if (::X509_STORE_load_file(handle_, filename.c_str()) != 1)
+#else // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  if (::X509_STORE_load_locations(handle_, filename.c_str(), 0) != 1)
+#endif // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  {
+    ec = context::translate_error(::ERR_get_error());
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  ec = asio::error_code();
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+void trust_store::add_verify_path(const std::string& path)
+{
+  asio::error_code ec;
+  add_verify_path(path, ec);
+  asio::detail::throw_error(ec, "add_verify_path");
+}
+
+ASIO_SYNC_OP_VOID trust_store::add_verify_path(
+    const std::string& path, asio::error_code& ec)
+{
+  ::ERR_clear_error();
+
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  if (::X509_STORE_load_path(handle_, path.c_str()) != 1)
+#else // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  if (::X509_STORE_load_locations(handle_, 0, path.c_str()) != 1)
+#endif // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  {
+    ec = context::translate_error(::ERR_get_error());
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  ec = asio::error_code();
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+void trust_store::set_default_verify_paths()
+{
+  asio::error_code ec;
+  set_default_verify_paths(ec);
+  asio::detail::throw_error(ec, "set_default_verify_paths");
+}
+
+ASIO_SYNC_OP_VOID trust_store::set_default_verify_paths(
+    asio::error_code& ec)
+{
+  ::ERR_clear_error();
+
+  if (::X509_STORE_set_default_paths(handle_) != 1)
+  {
+    ec = context::translate_error(::ERR_get_error());
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  ec = asio::error_code();
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+std::size_t trust_store::verification_cache_size() const
+{
+  verification_cache* cache = get_cache(handle_);
+  if (!cache)
+    return 0;
+
+  asio::detail::mutex::scoped_lock lock(cache->mutex_);
+  return cache->entries_.size();
+}
+
+void trust_store::clear_verification_cache()
+{
+  verification_cache* cache = get_cache(handle_);
+  if (!cache)
+    return;
+
+  entry_list entries;
+  {
+    asio::detail::mutex::scoped_lock lock(cache->mutex_);
+    entries.swap(cache->entries_);
+    cache->index_.clear();
+  }
+
+  free_entries(entries);
+}
+
+void trust_store::init(std::size_t cache_capacity,
+    const asio::chrono::seconds& cache_lifetime)
+{
+  ::ERR_clear_error();
+
+  handle_ = ::X509_STORE_new();
+  if (handle_ == 0)
+  {
+    asio::error_code ec = context::translate_error(::ERR_get_error());
+    asio::detail::throw_error(ec, "trust_store");
+  }
+
+  if (cache_capacity > 0)
+  {
+    verification_cache* cache = new verification_cache;
+    cache->capacity_ = cache_capacity;
+    cache->lifetime_ = cache_lifetime;
+    if (::X509_STORE_set_ex_data(handle_, cache_ex_data_index(), cache) != 1)
+    {
+      delete cache;
+      asio::error_code ec = context::translate_error(::ERR_get_error());
+      ::X509_STORE_free(handle_);
+      handle_ = 0;
+      asio::detail::throw_error(ec, "trust_store");
+    }
+  }
+}
+
+trust_store::verification_cache* trust_store::get_cache(X509_STORE* store)
+{
+  if (!store)
+    return 0;
+
+  return static_cast<verification_cache*>(
+      ::X509_STORE_get_ex_data(store, cache_ex_data_index()));
+}
+
+int trust_store::cache_ex_data_index()
+{
+  static const int index = ::X509_STORE_get_ex_new_index(0, 0, 0, 0,
+      &trust_store::free_cache);
+  return index;
+}
+
+void trust_store::free_cache(void*, void* ptr,
+    CRYPTO_EX_DATA*, int, long, void*)
+{
+  if (verification_cache* cache = static_cast<verification_cache*>(ptr))
+  {
+    free_entries(cache->entries_);
+    delete cache;
+  }
+}
+
+void trust_store::free_entries(entry_list& entries)
+{
+  for (entry_list::iterator iter = entries.begin();
+      iter != entries.end(); ++iter)
+    sk_X509_pop_free(iter->chain, ::X509_free);
+  entries.clear();
+}
+
+bool trust_store::verification_key(SSL* ssl,
+    X509_STORE_CTX* ctx, std::string& key)
+{
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  X509_VERIFY_PARAM* param = ::X509_STORE_CTX_get0_param(ctx);
+  X509* cert = ::X509_STORE_CTX_get0_cert(ctx);
+  if (!param || !cert)
+    return false;
+
+  // A verification at a fixed time is not reused at other times.
+  unsigned long flags = ::X509_VERIFY_PARAM_get_flags(param);
+  if ((flags & X509_V_FLAG_USE_CHECK_TIME) != 0)
+    return false;
+
+  // The parameters that affect the outcome of chain verification.
+  long values[] =
+  {
+    ::SSL_is_server(ssl),
+    static_cast<long>(flags),
+    static_cast<long>(::X509_VERIFY_PARAM_get_inh_flags(param)),
+    static_cast<long>(::X509_VERIFY_PARAM_get_hostflags(param)),
+    ::X509_VERIFY_PARAM_get_depth(param),
+    ::X509_VERIFY_PARAM_get_auth_level(param)
+  };
+  key.assign(reinterpret_cast<const char*>(values), sizeof(values));
+
+  for (int i = 0; const char* host = ::X509_VERIFY_PARAM_get0_host(param, i);
+      ++i)
+    key.append(host).append(1, '\0');
+  key.append(1, '\0');
+  if (const char* email = ::X509_VERIFY_PARAM_get0_email(param))
+    key.append(email);
+  key.append(1, '\0');
+  if (char* ip = ::X509_VERIFY_PARAM_get1_ip_asc(param))
+  {
+    key.append(ip);
+    ::OPENSSL_free(ip);
+  }
+  key.append(1, '\0');
+
+  // The certificates presented by the peer.
+  unsigned char md[EVP_MAX_MD_SIZE];
+  unsigned int md_length = 0;
+  if (::X509_digest(cert, ::EVP_sha256(), md, &md_length) != 1)
+    return false;
+  key.append(reinterpret_cast<const char*>(md), md_length);
+  if (STACK_OF(X509)* untrusted = ::X509_STORE_CTX_get0_untrusted(ctx))
+  {
+    for (int i = 0; i < sk_X509_num(untrusted); ++i)
+    {
+      if (::X509_digest(sk_X509_value(untrusted, i),
+            ::EVP_sha256(), md, &md_length) != 1)
+        return false;
+      key.append(reinterpret_cast<const char*>(md), md_length);
+    }
+  }
+
+  return true;
+#else // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  (void)ssl;
+  (void)ctx;
+  (void)key;
+  return false;
+#endif // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+}
+
+STACK_OF(X509)* trust_store::find(
+    verification_cache& cache, const std::string& key)
+{
+  STACK_OF(X509)* result = 0;
+  STACK_OF(X509)* expired = 0;
+  {
+    asio::detail::mutex::scoped_lock lock(cache.mutex_);
+
+    std::unordered_map<std::string, entry_list::iterator>::iterator
+      found = cache.index_.find(key);
+    if (found == cache.index_.end())
+      return 0;
+
+    STACK_OF(X509)* chain = found->second->chain;
+    bool usable = asio::chrono::steady_clock::now() < found->second->expiry;
+    for (int i = 0; usable && i < sk_X509_num(chain); ++i)
+    {
+      usable = ::X509_cmp_current_time(
+          ::X509_get0_notAfter(sk_X509_value(chain, i))) > 0;
+    }
+
+    if (usable)
+    {
+      cache.entries_.splice(cache.entries_.begin(),
+          cache.entries_, found->second);
+      result = ::X509_chain_up_ref(chain);
+    }
+    else
+    {
+      expired = chain;
+      cache.entries_.erase(found->second);
+      cache.index_.erase(found);
+    }
+  }
+
+  if (expired)
+    sk_X509_pop_free(expired, ::X509_free);
+
+  return result;
+}
+
+void trust_store::insert(verification_cache& cache,
+    const std::string& key, STACK_OF(X509)* chain)
+{
+  STACK_OF(X509)* evicted = 0;
+  STACK_OF(X509)* replaced = 0;
+  {
+    asio::detail::mutex::scoped_lock lock(cache.mutex_);
+
+    asio::chrono::steady_clock::time_point expiry =
+      asio::chrono::steady_clock::now() + cache.lifetime_;
+
+    std::unordered_map<std::string, entry_list::iterator>::iterator
+      found = cache.index_.find(key);
+    if (found != cache.index_.end())
+    {
+      replaced = found->second->chain;
+      found->second->chain = chain;
+      found->second->expiry = expiry;
+      cache.entries_.splice(cache.entries_.begin(),
+          cache.entries_, found->second);
+    }
+    else
+    {
+      if (cache.entries_.size() >= cache.capacity_)
+      {
+        evicted = cache.entries_.back().chain;
+        cache.index_.erase(cache.entries_.back().key);
+        cache.entries_.pop_back();
+      }
+
+      entry e = { key, chain, expiry };
+      cache.entries_.push_front(e);
+      cache.index_[key] = cache.entries_.begin();
+    }
+  }
+
+  if (evicted)
+    sk_X509_pop_free(evicted, ::X509_free);
+  if (replaced)
+    sk_X509_pop_free(replaced, ::X509_free);
+}
+
+int trust_store::reuse_chain(SSL* ssl,
+    X509_STORE_CTX* ctx, STACK_OF(X509)* chain)
+{
+  ::X509_STORE_CTX_set0_verified_chain(ctx, chain);
+  ::X509_STORE_CTX_set_error(ctx, X509_V_OK);
+
+  // The verify callback sees each certificate, from the trust anchor down to
+  // the peer's certificate, as it would during a full verification.
+  int (*callback)(int, X509_STORE_CTX*) = ::SSL_get_verify_callback(ssl);
+  for (int depth = sk_X509_num(chain) - 1; depth >= 0; --depth)
+  {
+    ::X509_STORE_CTX_set_error_depth(ctx, depth);
+    ::X509_STORE_CTX_set_current_cert(ctx, sk_X509_value(chain, depth));
+    if (callback && !callback(1, ctx))
+    {
+      if (::X509_STORE_CTX_get_error(ctx) == X509_V_OK)
+        ::X509_STORE_CTX_set_error(ctx, X509_V_ERR_APPLICATION_VERIFICATION);
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+int trust_store::verify_chain_callback(X509_STORE_CTX* ctx, void*)
+{
+  verification_cache* cache = get_cache(::X509_STORE_CTX_get0_store(ctx));
+  SSL* ssl = static_cast<SSL*>(::X509_STORE_CTX_get_ex_data(
+        ctx, ::SSL_get_ex_data_X509_STORE_CTX_idx()));
+
+  std::string key;
+  if (!cache || !ssl || !verification_key(ssl, ctx, key))
+    return ::X509_verify_cert(ctx);
+
+  if (STACK_OF(X509)* chain = find(*cache, key))
+    return reuse_chain(ssl, ctx, chain);
+
+  // Only chains that verified without any error being overridden by a verify
+  // callback are reused.
+  int result = ::X509_verify_cert(ctx);
+  if (result == 1 && ::X509_STORE_CTX_get_error(ctx) == X509_V_OK)
+    if (STACK_OF(X509)* chain = ::X509_STORE_CTX_get1_chain(ctx))
+      insert(*cache, key, chain);
+
+  return result;
+}
+
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_SSL_IMPL_TRUST_STORE_IPP
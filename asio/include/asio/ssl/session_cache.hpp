@@ -0,0 +1,285 @@
+//
+// ssl/session_cache.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_SESSION_CACHE_HPP
+#define ASIO_SSL_SESSION_CACHE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/error_code.hpp"
+#include "asio/ssl/detail/openssl_types.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+
+class context;
+
+namespace detail { class engine; }
+
+/// A cache of TLS sessions that may be shared between SSL contexts.
+/**
+ * The session_cache class stores TLS sessions so that later connections can
+ * resume them with an abbreviated handshake, avoiding the cost of a full
+ * handshake. A cache is attached to one or more contexts using
+ * context::set_session_cache(). Any number of server and client contexts may
+ * share the same cache.
+ *
+ * For servers, the cache stores the sessions identified by session IDs, and
+ * it holds the keys used to encrypt and decrypt session tickets. A session
+ * established by one context may be resumed by any other context that is
+ * attached to the same cache. Ticket keys are rotated automatically, and
+ * tickets issued with a retired key continue to be accepted until the key has
+ * been retired twice.
+ *
+ * For clients, the cache stores the most recent session for each server. An
+ * ssl::stream looks up a session when it starts a client handshake, and so
+ * a reconnection to the same server resumes the earlier session. Servers are
+ * identified by the name set using @c SSL_set_tlsext_host_name, or by the key
+ * set using stream::set_session_cache_key(). Client contexts that share a
+ * cache should present the same client certificate, as a resumed session
+ * retains the identity under which it was established.
+ *
+ * Entries are distributed across a number of shards, each protected by its
+ * own mutex, and each shard evicts its least recently used entry when it is
+ * full.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ *
+ * @note The cache must outlive every context to which it is attached.
+ *
+ * @par Example
+ * @code
+ * asio::ssl::session_cache cache;
+ *
+ * asio::ssl::context ctx(asio::ssl::context::tls_client);
+ * ctx.set_session_cache(cache);
+ *
+ * asio::ssl::stream<asio::ip::tcp::socket> sock(io_context, ctx);
+ * SSL_set_tlsext_host_name(sock.native_handle(), "host.name");
+ * // ... connect and handshake. A later stream created from ctx (or from any
+ * // other context using the same cache) resumes the session.
+ * @endcode
+ */
+class session_cache
+  : private noncopyable
+{
+public:
+  /// The default maximum number of sessions held by the cache.
+  static constexpr std::size_t default_capacity = 20480;
+
+  /// The default number of shards.
+  static constexpr std::size_t default_shards = 16;
+
+  /// Constructor.
+  /**
+   * @param capacity The maximum number of sessions held by the cache.
+   *
+   * @param shards The number of independently locked shards across which the
+   * sessions are distributed.
+   *
+   * @throws asio::system_error Thrown if the initial ticket key could
+   * not be generated.
+   */
+  ASIO_DECL explicit session_cache(std::size_t capacity = default_capacity,
+      std::size_t shards = default_shards);
+
+  /// Destructor.
+  ASIO_DECL ~session_cache();
+
+  /// Get the maximum number of sessions held by the cache.
+  std::size_t capacity() const
+  {
+    return capacity_;
+  }
+
+  /// Get the number of sessions currently held by the cache.
+  ASIO_DECL std::size_t size() const;
+
+  /// Remove all sessions from the cache.
+  ASIO_DECL void clear();
+
+  /// Set the interval after which the ticket key is rotated.
+  /**
+   * The key used to encrypt new session tickets is replaced once it has been
+   * in use for the specified interval. A zero interval disables automatic
+   * rotation. The default interval is one hour.
+   */
+  ASIO_DECL void set_ticket_key_lifetime(
+      const asio::chrono::seconds& lifetime);
+
+  /// Replace the key used to encrypt new session tickets.
+  /**
+   * The previous key continues to be accepted for decrypting tickets. Tickets
+   * decrypted using a previous key are replaced with new tickets.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  ASIO_DECL void rotate_ticket_keys();
+
+  /// Replace the key used to encrypt new session tickets.
+  /**
+   * The previous key continues to be accepted for decrypting tickets. Tickets
+   * decrypted using a previous key are replaced with new tickets.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID rotate_ticket_keys(asio::error_code& ec);
+
+private:
+  friend class context;
+  friend class detail::engine;
+
+  // A cached session and the key under which it is stored.
+  struct entry
+  {
+    std::string key;
+    SSL_SESSION* session;
+  };
+
+  typedef std::list<entry> entry_list;
+
+  // A subset of the cache's entries, in least recently used order.
+  struct shard
+  {
+    mutable asio::detail::mutex mutex_;
+    entry_list entries_;
+    std::unordered_map<std::string, entry_list::iterator> index_;
+  };
+
+  // A key used to protect session tickets.
+  struct ticket_key
+  {
+    unsigned char name[16];
+    unsigned char aes_key[32];
+    unsigned char hmac_key[32];
+    asio::chrono::steady_clock::time_point created;
+  };
+
+  // The number of ticket keys, including the current one, that are accepted
+  // when decrypting tickets.
+  enum { max_ticket_keys = 3 };
+
+  // Attach the cache to an SSL context.
+  ASIO_DECL asio::error_code attach(SSL_CTX* ctx, asio::error_code& ec);
+
+  // Get the shard that holds the given key.
+  ASIO_DECL shard& shard_for(const std::string& key);
+
+  // Insert a session, taking ownership of one reference to it.
+  ASIO_DECL void insert(const std::string& key, SSL_SESSION* session);
+
+  // Find a session, returning a new reference to it or null if not found.
+  ASIO_DECL SSL_SESSION* find(const std::string& key);
+
+  // Remove a session, provided the entry still refers to it.
+  ASIO_DECL void erase(const std::string& key, SSL_SESSION* session);
+
+  // Generate a new ticket key. Must be called with the ticket mutex locked.
+  ASIO_DECL void generate_ticket_key(asio::error_code& ec);
+
+  // Get the key with which to encrypt a new ticket.
+  ASIO_DECL void current_ticket_key(ticket_key& key);
+
+  // Find the key used to encrypt a ticket. Returns 0 if there is no such key,
+  // 1 if the key is current, and 2 if the ticket should be renewed.
+  ASIO_DECL int find_ticket_key(const unsigned char* name, ticket_key& key);
+
+  // Get the cache attached to an SSL context.
+  ASIO_DECL static session_cache* get_cache(SSL_CTX* ctx);
+
+  // Get the key under which a client session is stored. Returns false if the
+  // connection has neither an explicit key nor a server name.
+  ASIO_DECL static bool client_key(SSL* ssl, std::string& key);
+
+  // Form the key under which a server session is stored.
+  ASIO_DECL static std::string server_key(
+      const unsigned char* id, unsigned int length);
+
+  // Set the explicit key under which a client connection's session is stored.
+  ASIO_DECL static asio::error_code set_client_key(SSL* ssl,
+      const std::string& key, asio::error_code& ec);
+
+  // Prepare a client connection to resume a cached session, if any.
+  ASIO_DECL static void resume_client(SSL* ssl);
+
+  // Get the indexes of the SSL_CTX and SSL extra data used by the cache.
+  ASIO_DECL static int context_ex_data_index();
+  ASIO_DECL static int client_key_ex_data_index();
+
+  // Free a client key stored as SSL extra data.
+  ASIO_DECL static void free_client_key(void* parent, void* ptr,
+      CRYPTO_EX_DATA* ad, int idx, long argl, void* argp);
+
+  // OpenSSL session cache callbacks.
+  ASIO_DECL static int new_session_callback(SSL* ssl, SSL_SESSION* session);
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+  ASIO_DECL static SSL_SESSION* get_session_callback(SSL* ssl,
+      const unsigned char* id, int length, int* copy);
+#else // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+  ASIO_DECL static SSL_SESSION* get_session_callback(SSL* ssl,
+      unsigned char* id, int length, int* copy);
+#endif // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+  ASIO_DECL static void remove_session_callback(
+      SSL_CTX* ctx, SSL_SESSION* session);
+
+  // OpenSSL session ticket key callback.
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  ASIO_DECL static int ticket_key_callback(SSL* ssl,
+      unsigned char* name, unsigned char* iv, EVP_CIPHER_CTX* cipher_ctx,
+      EVP_MAC_CTX* mac_ctx, int enc);
+#else // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  ASIO_DECL static int ticket_key_callback(SSL* ssl,
+      unsigned char* name, unsigned char* iv, EVP_CIPHER_CTX* cipher_ctx,
+      HMAC_CTX* mac_ctx, int enc);
+#endif // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+
+  // The maximum number of sessions and the number held by each shard.
+  std::size_t capacity_;
+  std::size_t shard_capacity_;
+
+  // The shards across which the sessions are distributed.
+  std::vector<shard*> shards_;
+
+  // The session ID context set on attached contexts, so that sessions can be
+  // resumed only by contexts that share this cache.
+  unsigned char id_context_[SSL_MAX_SID_CTX_LENGTH];
+
+  // The ticket keys, with the current key first.
+  asio::detail::mutex ticket_mutex_;
+  std::vector<ticket_key> ticket_keys_;
+  asio::chrono::seconds ticket_key_lifetime_;
+};
+
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/ssl/impl/session_cache.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_SSL_SESSION_CACHE_HPP
@@ -257,6 +257,256 @@ public:
     return next_layer_.lowest_layer();
   }
 
+  /// Attach the stream to its lowest layer socket and request kernel TLS.
+  /**
+   * This function attaches the SSL implementation directly to the native
+   * socket of the lowest layer, in place of the stream's internal buffers.
+   * Handshake, read, write and shutdown operations then send and receive
+   * records on the socket themselves, and wait for the socket to become ready
+   * when they cannot proceed.
+   *
+   * The SSL implementation is also asked to install the negotiated keys into
+   * the kernel, so that the kernel encrypts and decrypts records (kernel TLS).
+   * Whether this succeeds depends on the SSL library, the kernel and the
+   * negotiated cipher. Use kernel_tls_send_active() and
+   * kernel_tls_receive_active() after the handshake to find out. When kernel
+   * TLS is active for sending, @c SSL_sendfile may be used with
+   * native_handle() to send a file without copying it to user space.
+   *
+   * This function must be called before the handshake starts. Once it has
+   * been called, any layers between this stream and the lowest layer are
+   * bypassed, and no other reads or writes may be performed on the socket.
+   * A buffered handshake with initial data is not supported.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Calls @c SSL_set_bio and @c SSL_set_options with
+   * @c SSL_OP_ENABLE_KTLS.
+   */
+  void use_kernel_tls()
+  {
+    asio::error_code ec;
+    use_kernel_tls(ec);
+    asio::detail::throw_error(ec, "use_kernel_tls");
+  }
+
+  /// Attach the stream to its lowest layer socket and request kernel TLS.
+  /**
+   * This function attaches the SSL implementation directly to the native
+   * socket of the lowest layer, in place of the stream's internal buffers.
+   * Handshake, read, write and shutdown operations then send and receive
+   * records on the socket themselves, and wait for the socket to become ready
+   * when they cannot proceed.
+   *
+   * The SSL implementation is also asked to install the negotiated keys into
+   * the kernel, so that the kernel encrypts and decrypts records (kernel TLS).
+   * Whether this succeeds depends on the SSL library, the kernel and the
+   * negotiated cipher. Use kernel_tls_send_active() and
+   * kernel_tls_receive_active() after the handshake to find out.
+   *
+   * This function must be called before the handshake starts.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note Calls @c SSL_set_bio and @c SSL_set_options with
+   * @c SSL_OP_ENABLE_KTLS.
+   */
+  ASIO_SYNC_OP_VOID use_kernel_tls(asio::error_code& ec)
+  {
+    if (!lowest_layer().is_open())
+    {
+      ec = asio::error::bad_descriptor;
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    // The SSL implementation performs its own I/O on the socket, and must not
+    // block when it is called from an asynchronous operation.
+    lowest_layer().native_non_blocking(true, ec);
+    if (!ec)
+      core_.engine_.attach_socket(lowest_layer().native_handle(), ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Determine whether the kernel encrypts records sent on the stream.
+  /**
+   * @returns @c true if use_kernel_tls() was called and the kernel has taken
+   * over record encryption for data sent on the stream.
+   */
+  bool kernel_tls_send_active() const
+  {
+    return core_.engine_.ktls_send();
+  }
+
+  /// Determine whether the kernel decrypts records received on the stream.
+  /**
+   * @returns @c true if use_kernel_tls() was called and the kernel has taken
+   * over record decryption for data received on the stream.
+   */
+  bool kernel_tls_receive_active() const
+  {
+    return core_.engine_.ktls_receive();
+  }
+
+  /// Set the executor used to perform the work of asynchronous handshakes.
+  /**
+   * This function may be used to move the cryptographic work of
+   * async_handshake() off the stream's executor. Each step of the handshake
+   * is performed on the specified executor, such as that of a thread_pool,
+   * and the operation then resumes on the stream's executor to perform I/O
+   * and to invoke the completion handler. This prevents the public key
+   * operations of many concurrent handshakes from delaying other work on the
+   * stream's executor.
+   *
+   * @param ex The executor on which to perform handshake steps. If empty, the
+   * steps are performed on the stream's executor, which is the default.
+   *
+   * @note Synchronous handshakes are not affected. No other operation may be
+   * performed on the stream while an asynchronous handshake is in progress.
+   */
+  void set_handshake_executor(const any_io_executor& ex)
+  {
+    core_.handshake_executor_ = ex;
+  }
+
+  /// Get the executor used to perform the work of asynchronous handshakes.
+  any_io_executor handshake_executor() const
+  {
+    return core_.handshake_executor_;
+  }
+
+  /// Set the size of the buffer that holds encrypted output.
+  /**
+   * This function may be used to enlarge the buffer into which the stream
+   * encrypts data before writing it to the next layer. A single call to
+   * write_some() or async_write_some() encrypts as many TLS records as fit in
+   * the buffer and writes them to the next layer together, so a larger buffer
+   * reduces the number of write operations on the next layer when sending
+   * large amounts of data. The default size holds one TLS record.
+   *
+   * @param size The requested size of the buffer, in bytes. Sizes smaller
+   * than the default are rounded up to the default.
+   *
+   * @throws asio::system_error Thrown on failure. Fails with
+   * asio::error::in_progress if encrypted output is waiting to be
+   * written.
+   */
+  void set_output_buffer_size(std::size_t size)
+  {
+    asio::error_code ec;
+    set_output_buffer_size(size, ec);
+    asio::detail::throw_error(ec, "set_output_buffer_size");
+  }
+
+  /// Set the size of the buffer that holds encrypted output.
+  /**
+   * This function may be used to enlarge the buffer into which the stream
+   * encrypts data before writing it to the next layer. A single call to
+   * write_some() or async_write_some() encrypts as many TLS records as fit in
+   * the buffer and writes them to the next layer together, so a larger buffer
+   * reduces the number of write operations on the next layer when sending
+   * large amounts of data. The default size holds one TLS record.
+   *
+   * @param size The requested size of the buffer, in bytes. Sizes smaller
+   * than the default are rounded up to the default.
+   *
+   * @param ec Set to indicate what error occurred, if any. Set to
+   * asio::error::in_progress if encrypted output is waiting to be
+   * written.
+   */
+  ASIO_SYNC_OP_VOID set_output_buffer_size(
+      std::size_t size, asio::error_code& ec)
+  {
+    core_.engine_.set_output_buffer_size(size, ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Get the size of the buffer that holds encrypted output.
+  std::size_t output_buffer_size() const
+  {
+    return core_.engine_.output_buffer_size();
+  }
+
+  /// Enable or disable dynamic record sizing.
+  /**
+   * This function may be used to reduce the latency of the first data sent on
+   * a connection. When dynamic record sizing is enabled, data is encrypted
+   * into small TLS records, each of which fits in a single TCP segment, so
+   * that the peer can decrypt and process the data as soon as the first
+   * segments arrive. Once 1MB has been written, records grow to the full size
+   * to reduce the overhead of bulk transfers. Records are reduced again after
+   * the stream has not written for one second.
+   *
+   * Dynamic record sizing is disabled by default.
+   *
+   * @param enabled Whether dynamic record sizing is enabled.
+   */
+  void set_dynamic_record_sizing(bool enabled)
+  {
+    core_.engine_.set_dynamic_record_sizing(enabled);
+  }
+
+  /// Determine whether dynamic record sizing is enabled.
+  bool dynamic_record_sizing() const
+  {
+    return core_.engine_.dynamic_record_sizing();
+  }
+
+  /// Set the key that identifies the server in a session cache.
+  /**
+   * This function may be used to specify the key under which a client stream
+   * stores its session in the session cache used by its context, and under
+   * which it looks for a session to resume when the handshake starts. If no
+   * key is set, the server name set using @c SSL_set_tlsext_host_name is used.
+   * Streams connecting to servers that share sessions may use the same key.
+   *
+   * @param key The key that identifies the server.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Has no effect unless the stream's context was configured using
+   * context::set_session_cache().
+   */
+  void set_session_cache_key(const std::string& key)
+  {
+    asio::error_code ec;
+    set_session_cache_key(key, ec);
+    asio::detail::throw_error(ec, "set_session_cache_key");
+  }
+
+  /// Set the key that identifies the server in a session cache.
+  /**
+   * This function may be used to specify the key under which a client stream
+   * stores its session in the session cache used by its context, and under
+   * which it looks for a session to resume when the handshake starts. If no
+   * key is set, the server name set using @c SSL_set_tlsext_host_name is used.
+   * Streams connecting to servers that share sessions may use the same key.
+   *
+   * @param key The key that identifies the server.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note Has no effect unless the stream's context was configured using
+   * context::set_session_cache().
+   */
+  ASIO_SYNC_OP_VOID set_session_cache_key(
+      const std::string& key, asio::error_code& ec)
+  {
+    core_.engine_.set_session_cache_key(key, ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Determine whether the handshake resumed an earlier session.
+  /**
+   * @returns @c true if the handshake has completed using an abbreviated
+   * handshake that resumed an earlier session.
+   *
+   * @note Calls @c SSL_session_reused.
+   */
+  bool session_reused() const
+  {
+    return core_.engine_.session_reused();
+  }
+
   /// Set the peer verification mode.
   /**
    * This function may be used to configure the peer verification mode used by
@@ -0,0 +1,308 @@
+//
+// ssl/trust_store.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_TRUST_STORE_HPP
+#define ASIO_SSL_TRUST_STORE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include "asio/buffer.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/error_code.hpp"
+#include "asio/ssl/detail/openssl_init.hpp"
+#include "asio/ssl/detail/openssl_types.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+
+class context;
+
+/// A store of trusted certificates that may be shared between SSL contexts.
+/**
+ * The trust_store class holds the certificate authorities used to verify
+ * peer certificates. A store is loaded once and attached to any number of
+ * contexts using context::set_trust_store(), so that each context uses the
+ * same certificates rather than parsing and holding its own copy. Copies of
+ * a trust_store object refer to the same underlying store.
+ *
+ * A store may also cache the results of successful chain verifications. When
+ * a peer presents a certificate chain that was verified within the cache
+ * lifetime, under the same verification parameters, the chain is not built
+ * and its signatures are not checked again. Any verify callback set on the
+ * context or stream is still called for each certificate in the chain, so
+ * that checks such as ssl::host_name_verification are applied to every
+ * connection. The cache is used only with OpenSSL 3.0 or later.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe. The certificates should be loaded before the
+ * store is attached to contexts that are in use.
+ *
+ * @note Contexts that share a store with a verification cache should use the
+ * same purpose, trust and DANE settings. Differences in these settings are not
+ * detected, and so a chain verified by one context may be reused by another.
+ *
+ * @par Example
+ * @code
+ * asio::ssl::trust_store store(1024, asio::chrono::minutes(10));
+ * store.load_verify_file("ca-bundle.pem");
+ *
+ * for (tenant& t : tenants)
+ * {
+ *   t.ctx.set_trust_store(store);
+ *   t.ctx.set_verify_mode(asio::ssl::verify_peer);
+ * }
+ * @endcode
+ */
+class trust_store
+{
+public:
+  /// The native handle type of the store.
+  typedef X509_STORE* native_handle_type;
+
+  /// Construct an empty store without a verification cache.
+  /**
+   * @throws asio::system_error Thrown on failure.
+   */
+  ASIO_DECL trust_store();
+
+  /// Construct an empty store with a verification cache.
+  /**
+   * @param cache_capacity The maximum number of verified chains held by the
+   * cache.
+   *
+   * @param cache_lifetime The time for which a verified chain is reused. A
+   * chain is also not reused once any of its certificates has expired.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  ASIO_DECL trust_store(std::size_t cache_capacity,
+      const asio::chrono::seconds& cache_lifetime);
+
+  /// Copy constructor. The new object refers to the same store.
+  ASIO_DECL trust_store(const trust_store& other) noexcept;
+
+  /// Move constructor.
+  /**
+   * @note Following the move, the moved-from object is valid only for
+   * destruction and as a target for assignment.
+   */
+  ASIO_DECL trust_store(trust_store&& other) noexcept;
+
+  /// Copy assignment. The object refers to the same store as @c other.
+  ASIO_DECL trust_store& operator=(const trust_store& other) noexcept;
+
+  /// Destructor.
+  /**
+   * The store is freed once it is no longer referred to by any trust_store
+   * object or context.
+   */
+  ASIO_DECL ~trust_store();
+
+  /// Get the underlying implementation in the native type.
+  native_handle_type native_handle()
+  {
+    return handle_;
+  }
+
+  /// Add certification authorities from a memory buffer.
+  /**
+   * @param ca The buffer containing the certification authority certificates.
+   * The certificates must use the PEM format.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Calls @c X509_STORE_add_cert.
+   */
+  ASIO_DECL void add_certificate_authority(const const_buffer& ca);
+
+  /// Add certification authorities from a memory buffer.
+  /**
+   * @param ca The buffer containing the certification authority certificates.
+   * The certificates must use the PEM format.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note Calls @c X509_STORE_add_cert.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID add_certificate_authority(
+      const const_buffer& ca, asio::error_code& ec);
+
+  /// Load certification authorities from a file.
+  /**
+   * @param filename The name of a file containing certification authority
+   * certificates in PEM format.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Calls @c X509_STORE_load_file.
+   */
+  ASIO_DECL void load_verify_file(const std::string& filename);
+
+  /// Load certification authorities from a file.
+  /**
+   * @param filename The name of a file containing certification authority
+   * certificates in PEM format.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note Calls @c X509_STORE_load_file.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID load_verify_file(
+      const std::string& filename, asio::error_code& ec);
+
+  /// Add a directory containing certificate authority files.
+  /**
+   * Each file in the directory must contain a single certificate. The files
+   * must be named using the subject name's hash and an extension of ".0".
+   *
+   * @param path The name of a directory containing the certificates.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Calls @c X509_STORE_load_path.
+   */
+  ASIO_DECL void add_verify_path(const std::string& path);
+
+  /// Add a directory containing certificate authority files.
+  /**
+   * Each file in the directory must contain a single certificate. The files
+   * must be named using the subject name's hash and an extension of ".0".
+   *
+   * @param path The name of a directory containing the certificates.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note Calls @c X509_STORE_load_path.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID add_verify_path(
+      const std::string& path, asio::error_code& ec);
+
+  /// Use the default locations for certification authority certificates.
+  /**
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Calls @c X509_STORE_set_default_paths.
+   */
+  ASIO_DECL void set_default_verify_paths();
+
+  /// Use the default locations for certification authority certificates.
+  /**
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note Calls @c X509_STORE_set_default_paths.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID set_default_verify_paths(
+      asio::error_code& ec);
+
+  /// Get the number of verified chains held by the verification cache.
+  ASIO_DECL std::size_t verification_cache_size() const;
+
+  /// Remove all verified chains from the verification cache.
+  /**
+   * This function should be called after certificates or revocation lists are
+   * added to the store, so that chains are verified against them.
+   */
+  ASIO_DECL void clear_verification_cache();
+
+private:
+  friend class context;
+
+  struct bio_cleanup;
+  struct x509_cleanup;
+
+  // A verified chain and the key under which it is stored.
+  struct entry
+  {
+    std::string key;
+    STACK_OF(X509)* chain;
+    asio::chrono::steady_clock::time_point expiry;
+  };
+
+  typedef std::list<entry> entry_list;
+
+  // The cache of verified chains, held as extra data of the X509_STORE so
+  // that it lives as long as the store.
+  struct verification_cache
+  {
+    asio::detail::mutex mutex_;
+    std::size_t capacity_;
+    asio::chrono::seconds lifetime_;
+    entry_list entries_;
+    std::unordered_map<std::string, entry_list::iterator> index_;
+  };
+
+  // Create the store, with a cache if the capacity is non-zero.
+  ASIO_DECL void init(std::size_t cache_capacity,
+      const asio::chrono::seconds& cache_lifetime);
+
+  // Get the cache attached to a store, if any.
+  ASIO_DECL static verification_cache* get_cache(X509_STORE* store);
+
+  // Get the index of the X509_STORE extra data used for the cache.
+  ASIO_DECL static int cache_ex_data_index();
+
+  // Free the cache stored as X509_STORE extra data.
+  ASIO_DECL static void free_cache(void* parent, void* ptr,
+      CRYPTO_EX_DATA* ad, int idx, long argl, void* argp);
+
+  // Free the chains held by a list of entries.
+  ASIO_DECL static void free_entries(entry_list& entries);
+
+  // Form the key under which a verification is stored. Returns false if the
+  // verification must not be cached.
+  ASIO_DECL static bool verification_key(SSL* ssl,
+      X509_STORE_CTX* ctx, std::string& key);
+
+  // Find a verified chain, returning a new reference to it or null if there
+  // is no usable entry.
+  ASIO_DECL static STACK_OF(X509)* find(
+      verification_cache& cache, const std::string& key);
+
+  // Insert a verified chain, taking ownership of it.
+  ASIO_DECL static void insert(verification_cache& cache,
+      const std::string& key, STACK_OF(X509)* chain);
+
+  // Complete a verification using a cached chain, taking ownership of it.
+  ASIO_DECL static int reuse_chain(SSL* ssl,
+      X509_STORE_CTX* ctx, STACK_OF(X509)* chain);
+
+  // The OpenSSL certificate verification callback installed on contexts that
+  // use a trust store.
+  ASIO_DECL static int verify_chain_callback(X509_STORE_CTX* ctx, void* arg);
+
+  // The underlying native implementation.
+  X509_STORE* handle_;
+
+  // Ensure openssl is initialised.
+  asio::ssl::detail::openssl_init<> init_;
+};
+
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/ssl/impl/trust_store.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_SSL_TRUST_STORE_HPP
@@ -16,10 +16,14 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include "asio/detail/mutex.hpp"
 #include "asio/detail/scheduler.hpp"
 #include "asio/detail/thread_group.hpp"
 #include "asio/execution.hpp"
 #include "asio/execution_context.hpp"
+#include "asio/thread_pool.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -39,6 +43,68 @@ public:
       std::allocator<void>
     > executor_type;
 
+  /// Options that control the threads of the system thread pool.
+  class options
+  {
+  public:
+    /// Use the default configuration. The pool has twice as many threads as
+    /// the system has processors, the threads are not bound to processors,
+    /// and they are created when the system context is first used.
+    options() noexcept
+      : num_threads_(0),
+        lazy_start_(false)
+    {
+    }
+
+    /// Specify the number of threads in the pool. Zero selects the default.
+    options& threads(std::size_t n) noexcept
+    {
+      num_threads_ = n;
+      return *this;
+    }
+
+    /// Specify the processors on which the threads may run.
+    options& placement(const thread_pool::placement& where)
+    {
+      placement_ = where;
+      return *this;
+    }
+
+    /// Specify whether to defer creating the threads until the first function
+    /// is submitted for execution.
+    /**
+     * If lazy start is enabled, obtaining the system context, for example to
+     * construct an I/O object, does not create the threads. They are created
+     * when a system executor is first used to post, defer or execute a
+     * function that may not block. Until then, asynchronous operations
+     * associated with the system context do not complete.
+     */
+    options& lazy_start(bool enabled) noexcept
+    {
+      lazy_start_ = enabled;
+      return *this;
+    }
+
+  private:
+    friend class system_context;
+
+    std::size_t num_threads_;
+    thread_pool::placement placement_;
+    bool lazy_start_;
+  };
+
+  /// Configure the system thread pool.
+  /**
+   * The options are applied when the system context is created, which happens
+   * when it is first used. This function should therefore be called early in
+   * the program, before any use of system_executor, or of functions such as
+   * post() that fall back to it.
+   *
+   * @returns @c true if the options will be applied, or @c false if the system
+   * context has already been created, in which case the options are ignored.
+   */
+  ASIO_DECL static bool configure(const options& opts);
+
   /// Destructor shuts down all threads in the system thread pool.
   ASIO_DECL ~system_context();
 
@@ -65,9 +131,23 @@ private:
 
   struct thread_function;
 
+  struct configuration;
+
+  // Get the options with which the system context is created.
+  ASIO_DECL static configuration& get_configuration();
+
   // Helper function to create the underlying scheduler.
   ASIO_DECL detail::scheduler& add_scheduler(detail::scheduler* s);
 
+  // Create the threads if they have not yet been created.
+  void start_threads()
+  {
+    if (!threads_started_.load(std::memory_order_acquire))
+      do_start_threads();
+  }
+
+  ASIO_DECL void do_start_threads();
+
   // The underlying scheduler.
   detail::scheduler& scheduler_;
 
@@ -76,6 +156,15 @@ private:
 
   // The number of threads in the pool.
   std::size_t num_threads_;
+
+  // The processors on which the threads may run.
+  thread_pool::placement placement_;
+
+  // Protects the creation of the threads.
+  detail::mutex mutex_;
+
+  // Whether the threads have been created.
+  std::atomic<bool> threads_started_;
 };
 
 } // namespace asio
@@ -16,8 +16,13 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <cstddef>
+#include <vector>
 #include "asio/detail/atomic_count.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/mutex.hpp"
 #include "asio/detail/scheduler.hpp"
+#include "asio/detail/scoped_ptr.hpp"
 #include "asio/detail/thread_group.hpp"
 #include "asio/execution.hpp"
 #include "asio/execution_context.hpp"
@@ -36,10 +41,11 @@ namespace detail {
   };
 } // namespace detail
 
-/// A simple fixed-size thread pool.
+/// A simple thread pool.
 /**
  * The thread pool class is an execution context where functions are permitted
- * to run on one of a fixed number of threads.
+ * to run on one of a fixed number of threads, or, for an elastic pool, on one
+ * of a number of threads that varies within limits.
  *
  * @par Thread Safety
  * @e Distinct @e objects: Safe.@n
@@ -81,6 +87,21 @@ namespace detail {
  *
  * // Wait for all tasks in the pool to complete.
  * pool.join(); @endcode
+ *
+ * @par Elastic pools
+ *
+ * A pool constructed with a thread_pool::elastic object varies its number of
+ * threads between a minimum and a maximum. A thread is added when submitted
+ * functions have been kept waiting for longer than a threshold, and an added
+ * thread exits once it has been idle for a period. Idle threads may check for
+ * new functions for a short time before they block, so that a burst of work
+ * does not pay the cost of waking each thread:
+ *
+ * @code asio::thread_pool pool(
+ *     asio::thread_pool::elastic(2, 16)
+ *       .grow_after(std::chrono::milliseconds(1))
+ *       .shrink_after(std::chrono::seconds(30))
+ *       .spin_before_park(std::chrono::microseconds(50))); @endcode
  */
 class thread_pool
   : public execution_context
@@ -95,6 +116,146 @@ public:
   /// Executor used to submit functions to a thread pool.
   typedef basic_executor_type<std::allocator<void>, 0> executor_type;
 
+  /// Specifies the processors on which the threads of a pool may run.
+  /**
+   * A placement is passed to the thread_pool constructor to bind each of the
+   * pool's threads before it starts running submitted functions. Failure to
+   * bind a thread is not reported, and the thread then runs wherever the
+   * operating system schedules it.
+   *
+   * When a thread is bound to a NUMA node, the memory that it caches for
+   * reuse by handler allocations (including those made through
+   * asio::recycling_allocator) is restricted to blocks that it allocated
+   * itself. Blocks released on a thread bound to a different node are returned
+   * to the system allocator instead of being cached, so that each thread reuses
+   * only node-local memory.
+   */
+  class placement
+  {
+  public:
+    /// Threads are not bound, and run wherever the operating system
+    /// schedules them.
+    placement() noexcept
+      : type_(unbound)
+    {
+    }
+
+    /// Bind every thread to the specified set of processors.
+    /**
+     * @param processors The system numbers of the processors on which the
+     * threads may run.
+     */
+    static placement processor_set(std::vector<std::size_t> processors)
+    {
+      return placement(by_processor_set,
+          static_cast<std::vector<std::size_t>&&>(processors));
+    }
+
+    /// Distribute the threads across the specified NUMA nodes.
+    /**
+     * Threads are assigned to the nodes in turn, and each thread is bound to
+     * all processors of its node.
+     *
+     * @param nodes The numbers of the NUMA nodes to be used.
+     */
+    static placement numa_nodes(std::vector<std::size_t> nodes)
+    {
+      return placement(by_numa_node,
+          static_cast<std::vector<std::size_t>&&>(nodes));
+    }
+
+    /// Distribute the threads across all NUMA nodes in the system.
+    /**
+     * Threads are assigned to the nodes in turn, and each thread is bound to
+     * all processors of its node. On systems that do not provide NUMA
+     * topology information, this is equivalent to a single node.
+     */
+    ASIO_DECL static placement all_numa_nodes();
+
+  private:
+    friend class thread_pool;
+    friend class system_context;
+
+    enum type { unbound, by_processor_set, by_numa_node };
+
+    placement(type t, std::vector<std::size_t>&& ids)
+      : type_(t),
+        ids_(static_cast<std::vector<std::size_t>&&>(ids))
+    {
+    }
+
+    // Bind the calling thread, which is the pool's thread at the given index.
+    ASIO_DECL void apply(std::size_t thread_index) const;
+
+    type type_;
+    std::vector<std::size_t> ids_;
+  };
+
+  /// Specifies the limits within which an elastic pool varies its number of
+  /// threads.
+  class elastic
+  {
+  public:
+    /// Construct with the minimum and maximum number of threads.
+    /**
+     * The pool always has at least one thread. If @c max_threads is less than
+     * @c min_threads, the pool has a fixed number of threads.
+     */
+    elastic(std::size_t min_threads, std::size_t max_threads) noexcept
+      : min_threads_(min_threads > 0 ? min_threads : 1),
+        max_threads_(max_threads > min_threads_ ? max_threads : min_threads_),
+        grow_usec_(1000),
+        shrink_usec_(10000000),
+        spin_usec_(0)
+    {
+    }
+
+    /// Set the time for which submitted functions may wait, while all threads
+    /// are busy, before a thread is added. Defaults to one millisecond.
+    template <typename Rep, typename Period>
+    elastic& grow_after(const chrono::duration<Rep, Period>& delay) noexcept
+    {
+      grow_usec_ = to_usec(delay);
+      return *this;
+    }
+
+    /// Set the time for which an added thread may be idle before it exits.
+    /// Defaults to ten seconds.
+    template <typename Rep, typename Period>
+    elastic& shrink_after(const chrono::duration<Rep, Period>& idle) noexcept
+    {
+      shrink_usec_ = to_usec(idle);
+      return *this;
+    }
+
+    /// Set the time for which an idle thread checks for submitted functions
+    /// before it blocks. Defaults to zero, so that idle threads block at once.
+    template <typename Rep, typename Period>
+    elastic& spin_before_park(
+        const chrono::duration<Rep, Period>& spin) noexcept
+    {
+      spin_usec_ = to_usec(spin);
+      return *this;
+    }
+
+  private:
+    friend class thread_pool;
+
+    template <typename Rep, typename Period>
+    static long to_usec(const chrono::duration<Rep, Period>& d) noexcept
+    {
+      long usec = static_cast<long>(
+          chrono::duration_cast<chrono::microseconds>(d).count());
+      return usec > 0 ? usec : 0;
+    }
+
+    std::size_t min_threads_;
+    std::size_t max_threads_;
+    long grow_usec_;
+    long shrink_usec_;
+    long spin_usec_;
+  };
+
 #if !defined(ASIO_NO_TS_EXECUTORS)
   /// Constructs a pool with an automatically determined number of threads.
   ASIO_DECL thread_pool();
@@ -157,6 +318,51 @@ public:
   thread_pool(allocator_arg_t, const Allocator& a, std::size_t num_threads,
       const execution_context::service_maker& initial_services);
 
+  /// Constructs a pool with a specified number of threads and placement.
+  /**
+   * @param num_threads The number of threads required.
+   *
+   * @param where Specifies the processors on which the threads may run.
+   */
+  ASIO_DECL thread_pool(std::size_t num_threads, const placement& where);
+
+  /// Constructs a pool with a specified number of threads and placement.
+  /**
+   * @param a An allocator that will be used for allocating objects that are
+   * associated with the execution context, such as services and internal state
+   * for I/O objects.
+   *
+   * @param num_threads The number of threads required.
+   *
+   * @param where Specifies the processors on which the threads may run.
+   */
+  template <typename Allocator>
+  thread_pool(allocator_arg_t, const Allocator& a,
+      std::size_t num_threads, const placement& where);
+
+  /// Constructs an elastic pool.
+  /**
+   * The pool starts with the minimum number of threads.
+   *
+   * @param limits Specifies the number of threads, and when threads are added
+   * and removed.
+   */
+  ASIO_DECL explicit thread_pool(const elastic& limits);
+
+  /// Constructs an elastic pool.
+  /**
+   * The pool starts with the minimum number of threads.
+   *
+   * @param a An allocator that will be used for allocating objects that are
+   * associated with the execution context, such as services and internal state
+   * for I/O objects.
+   *
+   * @param limits Specifies the number of threads, and when threads are added
+   * and removed.
+   */
+  template <typename Allocator>
+  thread_pool(allocator_arg_t, const Allocator& a, const elastic& limits);
+
   /// Destructor.
   /**
    * Automatically stops and joins the pool, if not explicitly done beforehand.
@@ -207,6 +413,35 @@ private:
   thread_pool& operator=(const thread_pool&) = delete;
 
   struct thread_function;
+  struct elastic_thread;
+
+  // The state of an elastic pool.
+  struct elastic_state
+  {
+    explicit elastic_state(const elastic& limits)
+      : max_threads_(limits.max_threads_),
+        shrink_usec_(limits.shrink_usec_),
+        threads_(0),
+        stopped_(false)
+    {
+    }
+
+    // The maximum number of threads in the pool.
+    const std::size_t max_threads_;
+
+    // The time for which an added thread may be idle before it exits.
+    const long shrink_usec_;
+
+    // Mutex to protect the list of added threads.
+    detail::mutex mutex_;
+
+    // The threads that have been added, including those that have exited but
+    // have not yet been joined.
+    elastic_thread* threads_;
+
+    // Whether threads may no longer be added.
+    bool stopped_;
+  };
 
 #if !defined(ASIO_NO_TS_EXECUTORS)
   // Helper function to calculate the default number of threads in the pool.
@@ -219,6 +454,18 @@ private:
   // Helper function to start all threads in the pool.
   ASIO_DECL void start();
 
+  // Helper function to configure an elastic pool before it starts.
+  ASIO_DECL void start_elastic(const elastic& limits);
+
+  // Called by the scheduler to add a thread to an elastic pool.
+  ASIO_DECL static void grow(void* owner);
+
+  // Called by an added thread when it exits.
+  ASIO_DECL void retire(elastic_thread* t);
+
+  // Join the threads that have been added to an elastic pool.
+  ASIO_DECL void join_elastic_threads();
+
   // The underlying scheduler.
   detail::scheduler& scheduler_;
 
@@ -230,6 +477,12 @@ private:
 
   // Whether a join call will have any effect.
   bool joinable_;
+
+  // Where the pool's threads run.
+  placement placement_;
+
+  // The state of an elastic pool, or null if the pool has a fixed size.
+  detail::scoped_ptr<elastic_state> elastic_;
 };
 
 /// Executor implementation type used to submit functions to a thread pool.
@@ -620,6 +873,24 @@ public:
         integral_constant<bool, (Bits & blocking_always) != 0>());
   }
 
+  /// Request the thread pool to execute each function object in a range.
+  /**
+   * This function is used to ask the thread pool to execute the function
+   * objects in the given range. None of the function objects will be executed
+   * inside @c post_batch(), regardless of the executor's blocking property.
+   *
+   * All of the function objects are added to the thread pool's queue
+   * together, in a single operation, and up to one idle thread is woken for
+   * each of them. This avoids the synchronisation cost of submitting each
+   * function object separately.
+   *
+   * @param fs A range of function objects, each of which is called as if by
+   * <tt>f()</tt>. The function objects are moved from, unless the range is
+   * const, in which case they are copied.
+   */
+  template <typename Range>
+  void post_batch(Range&& fs) const;
+
 public:
 #if !defined(ASIO_NO_TS_EXECUTORS)
   /// Obtain the underlying execution context.
@@ -0,0 +1,29 @@
+//
+// timeout_timer.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_TIMEOUT_TIMER_HPP
+#define ASIO_TIMEOUT_TIMER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/basic_timeout_timer.hpp"
+#include "asio/detail/chrono.hpp"
+
+namespace asio {
+
+/// Typedef for a single-waiter timeout based on the steady clock.
+typedef basic_timeout_timer<chrono::steady_clock> timeout_timer;
+
+} // namespace asio
+
+#endif // ASIO_TIMEOUT_TIMER_HPP
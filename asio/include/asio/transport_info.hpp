@@ -0,0 +1,64 @@
+//
+// transport_info.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_TRANSPORT_INFO_HPP
+#define ASIO_TRANSPORT_INFO_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/cstdint.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Information about the state of a connection's transport protocol.
+/**
+ * The information is obtained from the operating system using
+ * basic_stream_socket::get_transport_info(), which reads TCP_INFO on Linux,
+ * TCP_CONNECTION_INFO on macOS, and SIO_TCP_INFO on Windows. It may be sampled
+ * periodically using transport_info_sampler.
+ *
+ * A value that the operating system does not provide is reported as zero.
+ */
+struct transport_info
+{
+  /// The smoothed round trip time.
+  chrono::microseconds rtt;
+
+  /// The variation in the round trip time. Not provided on Windows.
+  chrono::microseconds rtt_variance;
+
+  /// The size of the congestion window, in bytes.
+  uint64_t congestion_window;
+
+  /// The number of segments that have been retransmitted.
+  /**
+   * On Windows, this is the number of fast retransmissions plus the number of
+   * retransmission timeouts.
+   */
+  uint64_t retransmits;
+
+  /// The most recent estimate of the delivery rate, in bytes per second.
+  /**
+   * Provided only on Linux 4.18 and later.
+   */
+  uint64_t delivery_rate;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_TRANSPORT_INFO_HPP
@@ -0,0 +1,241 @@
+//
+// transport_info_sampler.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_TRANSPORT_INFO_SAMPLER_HPP
+#define ASIO_TRANSPORT_INFO_SAMPLER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/compose.hpp"
+#include "asio/error.hpp"
+#include "asio/transport_info.hpp"
+#include "asio/wait_traits.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Samples the transport information of a connection at a fixed interval.
+/**
+ * The transport_info_sampler class template obtains the information returned
+ * by basic_stream_socket::get_transport_info() once per interval. Each call to
+ * async_sample() waits until the next sample is due, and completes with that
+ * sample.
+ *
+ * Samples are due at multiples of the interval from the construction of the
+ * sampler. If a sample is requested after the next one was due, it is taken
+ * immediately and the following sample is due one interval later, so that a
+ * slow consumer does not receive a burst of samples.
+ *
+ * The sampler's timer is held in a timer wheel, so that sampling many
+ * connections is cheap. Samples may therefore be taken up to one millisecond
+ * after they are due.
+ *
+ * The socket must outlive the sampler.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe. All functions must be called from within the
+ * executor of the socket.
+ *
+ * @par Example
+ * @code
+ * asio::transport_info_sampler<asio::ip::tcp::socket> sampler(
+ *     socket, std::chrono::milliseconds(500));
+ *
+ * void sample()
+ * {
+ *   sampler.async_sample(
+ *       [](asio::error_code ec, asio::transport_info info)
+ *       {
+ *         if (!ec)
+ *         {
+ *           adjust_bitrate(info.delivery_rate, info.rtt);
+ *           sample();
+ *         }
+ *       });
+ * }
+ * @endcode
+ */
+template <typename Socket>
+class transport_info_sampler
+  : private noncopyable
+{
+private:
+  class sample_op;
+
+public:
+  /// The type of the socket.
+  typedef Socket socket_type;
+
+  /// The type of the executor associated with the object.
+  typedef typename socket_type::executor_type executor_type;
+
+  /// The type used to represent the sampling interval.
+  typedef chrono::steady_clock::duration duration;
+
+private:
+  // The timer type used to wait for the next sample.
+  typedef basic_waitable_timer<chrono::steady_clock,
+      timer_wheel_traits<chrono::steady_clock>, executor_type> timer_type;
+
+public:
+  /// Construct a sampler for the specified socket.
+  /**
+   * @param socket The socket to be sampled. The socket must outlive the
+   * sampler.
+   *
+   * @param interval The interval between samples.
+   */
+  template <typename Rep, typename Period>
+  transport_info_sampler(socket_type& socket,
+      const chrono::duration<Rep, Period>& interval)
+    : socket_(socket),
+      timer_(socket.get_executor()),
+      interval_(chrono::duration_cast<duration>(interval))
+  {
+    timer_.expires_after(interval_);
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() noexcept
+  {
+    return timer_.get_executor();
+  }
+
+  /// Get a reference to the socket that is sampled.
+  socket_type& socket() noexcept
+  {
+    return socket_;
+  }
+
+  /// Get the interval between samples.
+  duration interval() const noexcept
+  {
+    return interval_;
+  }
+
+  /// Cancel any outstanding wait for a sample.
+  /**
+   * Any outstanding async_sample() operation completes with
+   * asio::error::operation_aborted.
+   */
+  void cancel()
+  {
+    timer_.cancel();
+  }
+
+  /// Wait for the next sample.
+  /**
+   * This function is used to asynchronously obtain the transport information
+   * of the socket when the next sample is due. It is an initiating function
+   * for an @ref asynchronous_operation, and always returns immediately.
+   *
+   * At most one async_sample() operation may be outstanding at a time.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the sample has been taken.
+   * The function signature of the completion handler must be:
+   * @code void handler(
+   *   asio::error_code ec, // Result of operation.
+   *   asio::transport_info info // The sample.
+   * ); @endcode
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, asio::transport_info) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        transport_info)) SampleToken
+          = default_completion_token_t<executor_type>>
+  auto async_sample(
+      SampleToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_compose<SampleToken, void (asio::error_code, transport_info)>(
+        declval<sample_op>(), token, declval<timer_type&>()))
+  {
+    return async_compose<SampleToken,
+      void (asio::error_code, transport_info)>(
+        sample_op(this), token, timer_);
+  }
+
+private:
+  // Waits for the next sample to be due, then takes it.
+  class sample_op
+  {
+  public:
+    explicit sample_op(transport_info_sampler* sampler)
+      : sampler_(sampler),
+        started_(false)
+    {
+    }
+
+    template <typename Self>
+    void operator()(Self& self, asio::error_code ec = asio::error_code())
+    {
+      if (!started_)
+      {
+        started_ = true;
+        sampler_->timer_.async_wait(static_cast<Self&&>(self));
+        return;
+      }
+
+      if (ec)
+      {
+        self.complete(ec, transport_info());
+        return;
+      }
+
+      typename timer_type::time_point now = timer_type::clock_type::now();
+      typename timer_type::time_point next =
+        sampler_->timer_.expiry() + sampler_->interval_;
+      sampler_->timer_.expires_at(
+          next > now ? next : now + sampler_->interval_);
+
+      transport_info info = sampler_->socket_.get_transport_info(ec);
+      self.complete(ec, info);
+    }
+
+  private:
+    transport_info_sampler* sampler_;
+    bool started_;
+  };
+
+  // The socket that is sampled.
+  socket_type& socket_;
+
+  // The timer used to wait for the next sample.
+  timer_type timer_;
+
+  // The interval between samples.
+  duration interval_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_TRANSPORT_INFO_SAMPLER_HPP
@@ -21,7 +21,11 @@
 #if defined(ASIO_HAS_STD_FUTURE_CLASS) \
   || defined(GENERATING_DOCUMENTATION)
 
+#include <exception>
 #include <memory>
+#include <new>
+#include "asio/detail/event.hpp"
+#include "asio/detail/mutex.hpp"
 #include "asio/detail/type_traits.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -35,8 +39,62 @@ class packaged_token;
 template <typename Function, typename Allocator, typename Result>
 class packaged_handler;
 
+template <typename T>
+class future_slot_token;
+
+template <typename T>
+class future_slot_handler;
+
+// Storage for the value held by a future_slot.
+template <typename T>
+class future_slot_value
+{
+public:
+  template <typename... Args>
+  void construct(Args&&... args)
+  {
+    new (static_cast<void*>(storage_)) T(static_cast<Args&&>(args)...);
+  }
+
+  T take()
+  {
+    T* p = static_cast<T*>(static_cast<void*>(storage_));
+    T value(static_cast<T&&>(*p));
+    p->~T();
+    return value;
+  }
+
+  void destroy()
+  {
+    static_cast<T*>(static_cast<void*>(storage_))->~T();
+  }
+
+private:
+  alignas(T) unsigned char storage_[sizeof(T)];
+};
+
+template <>
+class future_slot_value<void>
+{
+public:
+  void construct()
+  {
+  }
+
+  void take()
+  {
+  }
+
+  void destroy()
+  {
+  }
+};
+
 } // namespace detail
 
+template <typename T>
+class future_slot;
+
 /// A @ref completion_token type that causes an asynchronous operation to return
 /// a future.
 /**
@@ -111,6 +169,29 @@ public:
 #endif // defined(GENERATING_DOCUMENTATION)
   operator()(Function&& f) const;
 
+  /// Deliver the result of an operation into a future_slot.
+  /**
+   * When the returned object is passed as a completion token to an
+   * asynchronous operation, the initiating function returns @c void and the
+   * result of the operation is written into the specified slot. The slot's
+   * value type must be that of the std::future which use_future would
+   * otherwise return.
+   *
+   * @par Example
+   *
+   * @code asio::future_slot<std::size_t> slot;
+   * my_socket.async_read_some(buffer, use_future(slot));
+   * ...
+   * std::size_t n = slot.get(); @endcode
+   */
+  template <typename T>
+#if defined(GENERATING_DOCUMENTATION)
+  unspecified
+#else // defined(GENERATING_DOCUMENTATION)
+  detail::future_slot_token<T>
+#endif // defined(GENERATING_DOCUMENTATION)
+  operator()(future_slot<T>& slot) const;
+
 private:
   // Helper type to ensure that use_future can be constexpr default-constructed
   // even when std::allocator<void> can't be.
@@ -138,6 +219,119 @@ private:
  */
 ASIO_INLINE_VARIABLE constexpr use_future_t<> use_future;
 
+/// Receives the result of an asynchronous operation started with use_future.
+/**
+ * The future_slot class template is a lightweight alternative to std::future
+ * for callers that start an asynchronous operation and then block until it
+ * completes. The result is written directly into the slot, which is usually
+ * an object on the caller's stack. Unlike a std::future, no shared state is
+ * allocated for the operation.
+ *
+ * The slot is passed to an operation by wrapping it with use_future:
+ *
+ * @code asio::future_slot<std::size_t> slot;
+ * my_socket.async_read_some(my_buffer, asio::use_future(slot));
+ * std::size_t n = slot.get(); @endcode
+ *
+ * The type @c T is the value type of the std::future that would be returned
+ * if the operation were passed use_future itself. The slot must remain valid
+ * until the operation completes. Once get() returns, the slot may be reused
+ * for another operation.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe, except that the operation may complete on
+ * another thread while ready(), wait() or get() is being called.
+ */
+template <typename T>
+class future_slot
+{
+public:
+  /// Construct an empty slot.
+  future_slot()
+    : state_(empty)
+  {
+  }
+
+  /// Destructor.
+  ~future_slot()
+  {
+    if (state_ == has_value)
+      value_.destroy();
+  }
+
+  /// Determine whether the slot holds a result.
+  bool ready() const
+  {
+    detail::mutex::scoped_lock lock(mutex_);
+    return state_ != empty;
+  }
+
+  /// Block until the slot holds a result.
+  void wait()
+  {
+    detail::mutex::scoped_lock lock(mutex_);
+    while (state_ == empty)
+      event_.wait(lock);
+  }
+
+  /// Block until the slot holds a result, and then take it.
+  /**
+   * @returns The value produced by the operation.
+   *
+   * @throws Any exception produced by the operation. An error_code that
+   * indicates failure is thrown as asio::system_error.
+   */
+  T get()
+  {
+    detail::mutex::scoped_lock lock(mutex_);
+    while (state_ == empty)
+      event_.wait(lock);
+    event_.clear(lock);
+
+    if (state_ == has_exception)
+    {
+      state_ = empty;
+      std::exception_ptr e;
+      e.swap(exception_);
+      lock.unlock();
+      std::rethrow_exception(e);
+    }
+
+    state_ = empty;
+    return value_.take();
+  }
+
+private:
+  future_slot(const future_slot&) = delete;
+  future_slot& operator=(const future_slot&) = delete;
+
+  template <typename> friend class detail::future_slot_handler;
+
+  template <typename... Args>
+  void set_value(Args&&... args)
+  {
+    detail::mutex::scoped_lock lock(mutex_);
+    value_.construct(static_cast<Args&&>(args)...);
+    state_ = has_value;
+    event_.signal_all(lock);
+  }
+
+  void set_exception(std::exception_ptr e)
+  {
+    detail::mutex::scoped_lock lock(mutex_);
+    exception_ = static_cast<std::exception_ptr&&>(e);
+    state_ = has_exception;
+    event_.signal_all(lock);
+  }
+
+  mutable detail::mutex mutex_;
+  detail::event event_;
+  enum { empty, has_value, has_exception } state_;
+  detail::future_slot_value<T> value_;
+  std::exception_ptr exception_;
+};
+
 } // namespace asio
 
 #include "asio/detail/pop_options.hpp"
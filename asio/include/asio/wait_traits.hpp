@@ -15,6 +15,10 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include "asio/detail/config.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/cstdint.hpp"
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -49,6 +53,46 @@ struct wait_traits
   }
 };
 
+/// Wait traits that hold a clock's timers in a hierarchical timer wheel.
+/**
+ * By default, the pending timers for a clock are held in a binary heap, so
+ * that scheduling and cancelling a timer have logarithmic cost. When there are
+ * many timers that are frequently rescheduled, such as an idle timeout for
+ * each connection, these traits may be used to hold the timers in a
+ * hierarchical timer wheel instead. Scheduling and cancelling a timer then
+ * have constant cost, but timer expiry is rounded up to the resolution of the
+ * wheel. Timers never complete before their expiry time.
+ *
+ * The timer wheel measures expiry times relative to the time at which it was
+ * created, and so should be used only with a steady clock.
+ *
+ * @par Example
+ * @code typedef asio::basic_waitable_timer<
+ *     asio::chrono::steady_clock,
+ *     asio::timer_wheel_traits<asio::chrono::steady_clock>>
+ *   idle_timer; @endcode
+ *
+ * A user-defined wait traits class selects a timer wheel by providing a
+ * @c timer_wheel_resolution static data member, which specifies the
+ * resolution of the wheel in microseconds.
+ *
+ * @tparam Clock The clock type.
+ *
+ * @tparam Resolution A @c chrono::duration type, one tick of which is the
+ * resolution of the timer wheel.
+ */
+template <typename Clock, typename Resolution = chrono::milliseconds>
+struct timer_wheel_traits : wait_traits<Clock>
+{
+  /// The resolution of the timer wheel, in microseconds.
+  static constexpr long timer_wheel_resolution =
+    (static_cast<int64_t>(Resolution::period::num) * 1000000
+      / static_cast<int64_t>(Resolution::period::den) > 0)
+    ? static_cast<long>(static_cast<int64_t>(Resolution::period::num)
+        * 1000000 / static_cast<int64_t>(Resolution::period::den))
+    : 1;
+};
+
 } // namespace asio
 
 #include "asio/detail/pop_options.hpp"
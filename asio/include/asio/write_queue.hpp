@@ -0,0 +1,526 @@
+//
+// write_queue.hpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_WRITE_QUEUE_HPP
+#define ASIO_WRITE_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <limits>
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/buffer.hpp"
+#include "asio/cancellation_type.hpp"
+#include "asio/chain_buffer.hpp"
+#include "asio/compose.hpp"
+#include "asio/error.hpp"
+#include "asio/post.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/consuming_buffers.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Queues data for writing to a stream, with backpressure.
+/**
+ * The write_queue class template accepts data from producers at any time and
+ * writes it to the next layer in the background, so that producers need not
+ * wait for one write to complete before starting another. Data that is queued
+ * while a write is in progress is written by the next write, which gathers up
+ * to 16 blocks of the queue into a single scatter-gather operation.
+ *
+ * The queue is held in a chain_buffer drawn from a chain_buffer_pool, which may
+ * be shared between connections. Its memory is bounded per queue:
+ *
+ * @li When the queued data reaches the high watermark, the queue is paused.
+ * Producers should stop producing, and wait for async_wait_writable() to
+ * complete. The queue resumes once the queued data falls to the low
+ * watermark.
+ *
+ * @li Data that would take the queue beyond its maximum size is rejected with
+ * asio::error::no_buffer_space.
+ *
+ * If a write fails, the queued data is discarded and the error is reported by
+ * all subsequent operations on the queue.
+ *
+ * The queue must outlive its outstanding operations, including the background
+ * write. Close the next layer and allow the operations to complete before the
+ * queue is destroyed.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe. All functions must be called from within the
+ * executor of the next layer.
+ *
+ * @par Example
+ * @code
+ * asio::write_queue<asio::ip::tcp::socket&> queue(
+ *     socket, pool, 256 * 1024, 64 * 1024, 1024 * 1024);
+ *
+ * void produce()
+ * {
+ *   while (!queue.paused() && have_data())
+ *     queue.enqueue(next_data());
+ *   if (have_data())
+ *     queue.async_wait_writable(
+ *         [](asio::error_code ec)
+ *         {
+ *           if (!ec)
+ *             produce();
+ *         });
+ * }
+ * @endcode
+ */
+template <typename Stream>
+class write_queue
+  : private noncopyable
+{
+private:
+  class write_handler;
+  class wait_writable_op;
+  class flush_op;
+
+public:
+  /// The type of the next layer.
+  typedef remove_reference_t<Stream> next_layer_type;
+
+  /// The type of the lowest layer.
+  typedef typename next_layer_type::lowest_layer_type lowest_layer_type;
+
+  /// The type of the executor associated with the object.
+  typedef typename next_layer_type::executor_type executor_type;
+
+private:
+  // The timer type used to notify waiting operations. The timers never
+  // expire, and are cancelled to wake their waiters.
+  typedef basic_waitable_timer<chrono::steady_clock,
+      wait_traits<chrono::steady_clock>, executor_type> timer_type;
+
+public:
+
+  /// Construct, passing the specified argument to initialise the next layer.
+  /**
+   * @param a The argument used to initialise the next layer.
+   *
+   * @param pool The pool from which the queue's blocks are obtained. The pool
+   * must outlive the queue.
+   *
+   * @param high_watermark The size, in bytes, at which the queue is paused.
+   *
+   * @param low_watermark The size, in bytes, at or below which a paused queue
+   * resumes.
+   *
+   * @param maximum_size The largest size, in bytes, to which the queue may
+   * grow.
+   */
+  template <typename Arg>
+  write_queue(Arg&& a, chain_buffer_pool& pool,
+      std::size_t high_watermark, std::size_t low_watermark,
+      std::size_t maximum_size = (std::numeric_limits<std::size_t>::max)())
+    : next_layer_(static_cast<Arg&&>(a)),
+      buffer_(pool, maximum_size),
+      high_watermark_(high_watermark),
+      low_watermark_(low_watermark < high_watermark
+          ? low_watermark : high_watermark),
+      writable_timer_(next_layer_.get_executor()),
+      flush_timer_(next_layer_.get_executor()),
+      written_(0),
+      flush_waiters_(0),
+      writing_(false),
+      paused_(false)
+  {
+    writable_timer_.expires_at((timer_type::time_point::max)());
+    flush_timer_.expires_at((timer_type::time_point::max)());
+  }
+
+  /// Get a reference to the next layer.
+  next_layer_type& next_layer()
+  {
+    return next_layer_;
+  }
+
+  /// Get a reference to the lowest layer.
+  lowest_layer_type& lowest_layer()
+  {
+    return next_layer_.lowest_layer();
+  }
+
+  /// Get a const reference to the lowest layer.
+  const lowest_layer_type& lowest_layer() const
+  {
+    return next_layer_.lowest_layer();
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() noexcept
+  {
+    return next_layer_.lowest_layer().get_executor();
+  }
+
+  /// Get the number of bytes queued and not yet written.
+  std::size_t size() const noexcept
+  {
+    return buffer_.size();
+  }
+
+  /// Get the largest size to which the queue may grow.
+  std::size_t max_size() const noexcept
+  {
+    return buffer_.max_size();
+  }
+
+  /// Get the size at which the queue is paused.
+  std::size_t high_watermark() const noexcept
+  {
+    return high_watermark_;
+  }
+
+  /// Get the size at or below which a paused queue resumes.
+  std::size_t low_watermark() const noexcept
+  {
+    return low_watermark_;
+  }
+
+  /// Determine whether producers should stop queueing data.
+  /**
+   * @returns @c true if the queued data reached the high watermark and has not
+   * yet fallen to the low watermark.
+   */
+  bool paused() const noexcept
+  {
+    return paused_;
+  }
+
+  /// Queue a copy of the specified data for writing.
+  /**
+   * The data is written after any data already in the queue. Data may be
+   * queued while the queue is paused, up to its maximum size.
+   *
+   * @throws asio::system_error Thrown on failure. An error code of
+   * asio::error::no_buffer_space indicates that the data would take the
+   * queue beyond its maximum size, in which case none of the data is queued.
+   */
+  template <typename ConstBufferSequence>
+  void enqueue(const ConstBufferSequence& buffers,
+      constraint_t<
+        is_const_buffer_sequence<ConstBufferSequence>::value
+      > = 0)
+  {
+    asio::error_code ec;
+    enqueue(buffers, ec);
+    asio::detail::throw_error(ec, "enqueue");
+  }
+
+  /// Queue a copy of the specified data for writing.
+  /**
+   * The data is written after any data already in the queue. Data may be
+   * queued while the queue is paused, up to its maximum size.
+   *
+   * @param buffers The data to be queued.
+   *
+   * @param ec Set to indicate what error occurred, if any. An error code of
+   * asio::error::no_buffer_space indicates that the data would take the
+   * queue beyond its maximum size, in which case none of the data is queued.
+   */
+  template <typename ConstBufferSequence>
+  ASIO_SYNC_OP_VOID enqueue(const ConstBufferSequence& buffers,
+      asio::error_code& ec,
+      constraint_t<
+        is_const_buffer_sequence<ConstBufferSequence>::value
+      > = 0)
+  {
+    if (error_)
+    {
+      ec = error_;
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    std::size_t n = asio::buffer_size(buffers);
+    if (n > buffer_.max_size() - buffer_.size())
+    {
+      ec = asio::error::no_buffer_space;
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    buffer_.append(buffers);
+    if (buffer_.size() >= high_watermark_)
+      paused_ = true;
+
+    start_write();
+    ec = asio::error_code();
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Start an asynchronous operation to wait until the queue is not paused.
+  /**
+   * The operation completes once the queue resumes, or without waiting if
+   * the queue is not paused, although the completion handler is not invoked
+   * from within this function.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the wait completes.
+   * The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error // Result of operation.
+   * ); @endcode
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        WaitToken = default_completion_token_t<executor_type>>
+  auto async_wait_writable(
+      WaitToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_compose<WaitToken, void (asio::error_code)>(
+        declval<wait_writable_op>(), token, declval<timer_type&>()))
+  {
+    return async_compose<WaitToken, void (asio::error_code)>(
+        wait_writable_op(this), token, writable_timer_);
+  }
+
+  /// Start an asynchronous operation to wait until the queued data has been
+  /// written.
+  /**
+   * The operation completes once all of the data that was queued before the
+   * operation started has been written to the next layer, although the
+   * completion handler is not invoked from within this function.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the flush completes.
+   * The function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error // Result of operation.
+   * ); @endcode
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        FlushToken = default_completion_token_t<executor_type>>
+  auto async_flush(
+      FlushToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_compose<FlushToken, void (asio::error_code)>(
+        declval<flush_op>(), token, declval<timer_type&>()))
+  {
+    return async_compose<FlushToken, void (asio::error_code)>(
+        flush_op(this), token, flush_timer_);
+  }
+
+private:
+  // The buffer sequence used for each write.
+  typedef detail::prepared_buffers<const_buffer,
+      detail::buffer_sequence_adapter_base::max_buffers> write_buffers_type;
+
+  // Start a write of the queued data, unless one is already in progress.
+  void start_write()
+  {
+    if (writing_ || buffer_.size() == 0)
+      return;
+
+    // The write uses a copy of the buffer sequence, as appending to the queue
+    // invalidates the sequence but not the data to which it refers.
+    write_buffers_type buffers;
+    chain_buffer::const_buffers_type data = buffer_.data();
+    for (chain_buffer::const_buffers_type::const_iterator
+        i = data.begin(), e = data.end();
+        i != e && buffers.count < write_buffers_type::max_buffers; ++i)
+      buffers.elems[buffers.count++] = *i;
+
+    writing_ = true;
+    next_layer_.async_write_some(buffers, write_handler(this));
+  }
+
+  // Consume the written data, wake the waiters whose conditions are met, and
+  // continue with the remaining data.
+  void handle_write(const asio::error_code& ec, std::size_t n)
+  {
+    writing_ = false;
+    buffer_.consume(n);
+    written_ += n;
+
+    if (ec)
+    {
+      error_ = ec;
+      buffer_.clear();
+    }
+
+    if (paused_ && (ec || buffer_.size() <= low_watermark_))
+    {
+      paused_ = false;
+      writable_timer_.cancel();
+    }
+
+    if (flush_waiters_ > 0)
+      flush_timer_.cancel();
+
+    if (!ec)
+      start_write();
+  }
+
+  // Handles the completion of each write to the next layer.
+  class write_handler
+  {
+  public:
+    explicit write_handler(write_queue* queue)
+      : queue_(queue)
+    {
+    }
+
+    void operator()(const asio::error_code& ec, std::size_t n)
+    {
+      queue_->handle_write(ec, n);
+    }
+
+  private:
+    write_queue* queue_;
+  };
+
+  // Waits on the writable timer until the queue is not paused.
+  class wait_writable_op
+  {
+  public:
+    explicit wait_writable_op(write_queue* queue)
+      : queue_(queue),
+        started_(false)
+    {
+    }
+
+    template <typename Self>
+    void operator()(Self& self, asio::error_code = asio::error_code())
+    {
+      if (!started_)
+      {
+        started_ = true;
+        if (queue_->paused_ && !queue_->error_)
+          queue_->writable_timer_.async_wait(static_cast<Self&&>(self));
+        else
+          asio::post(queue_->writable_timer_.get_executor(),
+              static_cast<Self&&>(self));
+        return;
+      }
+
+      if (queue_->error_)
+        self.complete(queue_->error_);
+      else if (!queue_->paused_)
+        self.complete(asio::error_code());
+      else if (self.cancelled() != cancellation_type::none)
+        self.complete(asio::error::operation_aborted);
+      else
+        queue_->writable_timer_.async_wait(static_cast<Self&&>(self));
+    }
+
+  private:
+    write_queue* queue_;
+    bool started_;
+  };
+
+  // Waits on the flush timer until the data queued before the operation
+  // started has been written.
+  class flush_op
+  {
+  public:
+    explicit flush_op(write_queue* queue)
+      : queue_(queue),
+        target_(0),
+        started_(false),
+        waiting_(false)
+    {
+    }
+
+    template <typename Self>
+    void operator()(Self& self, asio::error_code = asio::error_code())
+    {
+      if (!started_)
+      {
+        started_ = true;
+        target_ = queue_->written_ + queue_->buffer_.size();
+        if (queue_->written_ < target_ && !queue_->error_)
+        {
+          waiting_ = true;
+          ++queue_->flush_waiters_;
+          queue_->flush_timer_.async_wait(static_cast<Self&&>(self));
+        }
+        else
+        {
+          asio::post(queue_->flush_timer_.get_executor(),
+              static_cast<Self&&>(self));
+        }
+        return;
+      }
+
+      if (queue_->written_ < target_ && !queue_->error_
+          && self.cancelled() == cancellation_type::none)
+      {
+        queue_->flush_timer_.async_wait(static_cast<Self&&>(self));
+        return;
+      }
+
+      if (waiting_)
+      {
+        waiting_ = false;
+        --queue_->flush_waiters_;
+      }
+
+      if (queue_->error_)
+        self.complete(queue_->error_);
+      else if (queue_->written_ < target_)
+        self.complete(asio::error::operation_aborted);
+      else
+        self.complete(asio::error_code());
+    }
+
+  private:
+    write_queue* queue_;
+    unsigned long long target_;
+    bool started_;
+    bool waiting_;
+  };
+
+  Stream next_layer_;
+  chain_buffer buffer_;
+  const std::size_t high_watermark_;
+  const std::size_t low_watermark_;
+  timer_type writable_timer_;
+  timer_type flush_timer_;
+  unsigned long long written_;
+  std::size_t flush_waiters_;
+  asio::error_code error_;
+  bool writing_;
+  bool paused_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_WRITE_QUEUE_HPP
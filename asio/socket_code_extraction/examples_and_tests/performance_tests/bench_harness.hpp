@@ -0,0 +1,279 @@
+/**
+ * @file bench_harness.hpp
+ * @brief Minimal benchmark harness shared by the socket performance tests
+ *
+ * A benchmark is a fixture: an object whose call operator performs one
+ * operation (for example, one echo round trip). The harness:
+ * - runs a number of warmup repetitions whose results are discarded
+ * - runs a number of measured repetitions of a fixed number of operations
+ * - times every operation and reports latency percentiles over all of them
+ * - reports the median and spread of the per-repetition throughput
+ * - sweeps each fixture over a configurable list of payload sizes
+ * - pins the measuring thread (and optionally a peer thread) to CPUs
+ *
+ * Command line (parsed by options::parse):
+ *   --warmup=N         warmup repetitions (default 2)
+ *   --repetitions=N    measured repetitions (default 10)
+ *   --iterations=N     operations per repetition (default 2000)
+ *   --payloads=A,B,... payload sizes in bytes (default 64,256,1024,4096)
+ *   --cpus=C[,S]       pin the client thread to C and any server thread to S
+ *   --list             print benchmark names and exit
+ *   NAME...            run only the benchmarks whose names contain NAME
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace bench {
+
+using clock_type = std::chrono::steady_clock;
+
+/**
+ * @brief Pins the calling thread to a CPU. A negative CPU leaves it unpinned.
+ * @return false if pinning was requested but is unsupported or failed
+ */
+inline bool pin_current_thread(int cpu) {
+    if (cpu < 0) return true;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @struct options
+ * @brief Run configuration shared by every benchmark in a program
+ */
+struct options {
+    std::size_t warmup = 2;
+    std::size_t repetitions = 10;
+    std::size_t iterations = 2000;
+    std::vector<std::size_t> payloads = {64, 256, 1024, 4096};
+    int client_cpu = -1;
+    int server_cpu = -1;
+    bool list = false;
+    std::vector<std::string> filters;
+
+    /**
+     * @brief Parses the command line, exiting with a usage message on error
+     */
+    static options parse(int argc, char* argv[]) {
+        options opts;
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            if (std::strncmp(arg, "--warmup=", 9) == 0) {
+                opts.warmup = std::strtoul(arg + 9, nullptr, 10);
+            } else if (std::strncmp(arg, "--repetitions=", 14) == 0) {
+                opts.repetitions = std::max<std::size_t>(1, std::strtoul(arg + 14, nullptr, 10));
+            } else if (std::strncmp(arg, "--iterations=", 13) == 0) {
+                opts.iterations = std::max<std::size_t>(1, std::strtoul(arg + 13, nullptr, 10));
+            } else if (std::strncmp(arg, "--payloads=", 11) == 0) {
+                opts.payloads = parse_list(arg + 11);
+            } else if (std::strncmp(arg, "--cpus=", 7) == 0) {
+                std::vector<std::size_t> cpus = parse_list(arg + 7);
+                if (cpus.size() > 0) opts.client_cpu = static_cast<int>(cpus[0]);
+                if (cpus.size() > 1) opts.server_cpu = static_cast<int>(cpus[1]);
+            } else if (std::strcmp(arg, "--list") == 0) {
+                opts.list = true;
+            } else if (arg[0] == '-') {
+                std::fprintf(stderr,
+                    "Usage: %s [--warmup=N] [--repetitions=N] [--iterations=N]"
+                    " [--payloads=A,B,...] [--cpus=C[,S]] [--list] [NAME...]\n",
+                    argv[0]);
+                std::exit(1);
+            } else {
+                opts.filters.push_back(arg);
+            }
+        }
+        if (opts.payloads.empty()) opts.payloads.push_back(64);
+        return opts;
+    }
+
+    bool selected(const std::string& name) const {
+        if (filters.empty()) return true;
+        for (const auto& f : filters) {
+            if (name.find(f) != std::string::npos) return true;
+        }
+        return false;
+    }
+
+private:
+    static std::vector<std::size_t> parse_list(const char* s) {
+        std::vector<std::size_t> values;
+        while (*s) {
+            char* end = nullptr;
+            values.push_back(std::strtoul(s, &end, 10));
+            if (end == s) break;
+            s = (*end == ',') ? end + 1 : end;
+        }
+        return values;
+    }
+};
+
+/**
+ * @struct result
+ * @brief Summary of one benchmark at one payload size
+ */
+struct result {
+    std::string name;
+    std::size_t payload = 0;
+    std::size_t operations = 0;
+    double ops_per_sec = 0;      // median over repetitions
+    double spread_percent = 0;   // (max - min) / median over repetitions
+    double p50_ns = 0;
+    double p90_ns = 0;
+    double p99_ns = 0;
+    double p999_ns = 0;
+    double max_ns = 0;
+};
+
+/**
+ * @class harness
+ * @brief Runs fixtures according to the options and prints a result table
+ *
+ * A fixture factory is called once per payload size and returns a callable
+ * that performs one operation. Bytes per operation, used for the MB/s column,
+ * are the payload multiplied by the bytes_factor given to run() (2 for an echo
+ * round trip that moves the payload in both directions).
+ */
+class harness {
+public:
+    using operation = std::function<void()>;
+    using factory = std::function<operation(std::size_t payload)>;
+
+    explicit harness(options opts) : opts_(std::move(opts)) {
+        pin_current_thread(opts_.client_cpu);
+    }
+
+    const options& opts() const { return opts_; }
+
+    /**
+     * @brief Runs a fixture once for each configured payload size
+     */
+    void run(const std::string& name, const factory& make, std::size_t bytes_factor = 2) {
+        for (std::size_t payload : opts_.payloads) {
+            run_one(name, payload, make, bytes_factor);
+        }
+    }
+
+    /**
+     * @brief Runs a fixture whose cost does not depend on a payload size
+     */
+    void run_fixed(const std::string& name, const factory& make) {
+        run_one(name, 0, make, 0);
+    }
+
+    const std::vector<result>& results() const { return results_; }
+
+private:
+    options opts_;
+    std::vector<result> results_;
+    bool header_printed_ = false;
+
+    void run_one(const std::string& name, std::size_t payload,
+                 const factory& make, std::size_t bytes_factor) {
+        if (opts_.list) {
+            if (payload == opts_.payloads.front() || bytes_factor == 0) {
+                std::printf("%s\n", name.c_str());
+            }
+            return;
+        }
+        if (!opts_.selected(name)) return;
+
+        operation op;
+        try {
+            op = make(payload);
+        } catch (const std::exception& e) {
+            std::fprintf(stderr, "%s/%zu: setup failed: %s\n", name.c_str(), payload, e.what());
+            return;
+        }
+
+        std::vector<double> latencies;
+        latencies.reserve(opts_.repetitions * opts_.iterations);
+        std::vector<double> rates;
+
+        try {
+            for (std::size_t rep = 0; rep < opts_.warmup + opts_.repetitions; ++rep) {
+                const bool measured = rep >= opts_.warmup;
+                const auto rep_start = clock_type::now();
+                auto last = rep_start;
+                for (std::size_t i = 0; i < opts_.iterations; ++i) {
+                    op();
+                    const auto now = clock_type::now();
+                    if (measured) {
+                        latencies.push_back(static_cast<double>(
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count()));
+                    }
+                    last = now;
+                }
+                if (measured) {
+                    const double secs = std::chrono::duration<double>(last - rep_start).count();
+                    rates.push_back(secs > 0 ? opts_.iterations / secs : 0);
+                }
+            }
+        } catch (const std::exception& e) {
+            std::fprintf(stderr, "%s/%zu: failed: %s\n", name.c_str(), payload, e.what());
+            return;
+        }
+
+        result r;
+        r.name = name;
+        r.payload = payload;
+        r.operations = latencies.size();
+        std::sort(rates.begin(), rates.end());
+        r.ops_per_sec = rates[rates.size() / 2];
+        r.spread_percent = r.ops_per_sec > 0
+            ? 100.0 * (rates.back() - rates.front()) / r.ops_per_sec : 0;
+        std::sort(latencies.begin(), latencies.end());
+        r.p50_ns = percentile(latencies, 50);
+        r.p90_ns = percentile(latencies, 90);
+        r.p99_ns = percentile(latencies, 99);
+        r.p999_ns = percentile(latencies, 99.9);
+        r.max_ns = latencies.back();
+
+        print(r, bytes_factor);
+        results_.push_back(r);
+    }
+
+    static double percentile(const std::vector<double>& sorted, double p) {
+        std::size_t index = static_cast<std::size_t>(std::ceil(p / 100.0 * sorted.size()));
+        return sorted[std::min(sorted.size() - 1, index > 0 ? index - 1 : 0)];
+    }
+
+    void print(const result& r, std::size_t bytes_factor) {
+        if (!header_printed_) {
+            std::printf("%-28s %8s %12s %10s %8s %9s %9s %9s %9s %9s\n",
+                        "benchmark", "payload", "ops/s", "MB/s", "spread",
+                        "p50(us)", "p90(us)", "p99(us)", "p99.9(us)", "max(us)");
+            header_printed_ = true;
+        }
+        const double mbps = r.ops_per_sec * r.payload * bytes_factor / 1e6;
+        std::printf("%-28s %8zu %12.0f %10.2f %7.1f%% %9.2f %9.2f %9.2f %9.2f %9.2f\n",
+                    r.name.c_str(), r.payload, r.ops_per_sec, mbps, r.spread_percent,
+                    r.p50_ns / 1e3, r.p90_ns / 1e3, r.p99_ns / 1e3,
+                    r.p999_ns / 1e3, r.max_ns / 1e3);
+        std::fflush(stdout);
+    }
+};
+
+} // namespace bench
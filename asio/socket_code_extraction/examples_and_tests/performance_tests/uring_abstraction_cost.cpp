@@ -0,0 +1,173 @@
+/**
+ * @file uring_abstraction_cost.cpp
+ * @brief Measures the cost of asio's io_uring backend over a raw liburing loop
+ *
+ * Both benchmarks perform the same single-threaded UDP ping-pong over
+ * loopback: a client socket sends a datagram to a server socket on the same
+ * event loop, the server echoes it, and the operation ends when the client
+ * has received the echo. Each round trip is four io_uring operations.
+ *
+ * - raw_uring_udp_echo uses io_uring_event_loop from udp_async_sketch.cpp.
+ * - asio_udp_echo uses asio::ip::udp::socket with asio built to use
+ *   io_uring_service (ASIO_HAS_IO_URING, ASIO_DISABLE_EPOLL).
+ *
+ * The difference between the two rows at each payload size is the per round
+ * trip cost of asio's abstraction: handler type erasure and allocation,
+ * operation queues, scheduler locking and work counting. The sketch stores
+ * handlers inline in per-socket operation slots, so it allocates nothing per
+ * operation.
+ *
+ * Linux only. Build with the uring_abstraction_benchmark CMake target, which
+ * is created when liburing is found. Takes the bench_harness.hpp options.
+ */
+
+#define SKIP_MAIN
+#include "../../udp_async_sketch.cpp"
+
+#include "bench_harness.hpp"
+
+#include <asio.hpp>
+#include <memory>
+#include <vector>
+
+#if !defined(ASIO_HAS_IO_URING) || defined(ASIO_HAS_EPOLL)
+#error "Build with -DASIO_HAS_IO_URING -DASIO_DISABLE_EPOLL to use asio's io_uring backend"
+#endif
+
+namespace {
+
+/**
+ * @brief Finds a free loopback UDP port, since the sketch cannot report the
+ * port chosen when binding to port 0
+ */
+uint16_t free_udp_port() {
+    asio::io_context io_context;
+    asio::ip::udp::socket probe(io_context,
+        asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0));
+    return probe.local_endpoint().port();
+}
+
+endpoint loopback_endpoint(uint16_t port) {
+    endpoint ep{};
+    ep.address = INADDR_LOOPBACK;
+    ep.port = port;
+    return ep;
+}
+
+/**
+ * @brief Ping-pong through the raw liburing event loop from the sketch
+ */
+struct raw_uring_udp_echo {
+    io_uring_event_loop loop;
+    std::unique_ptr<async_udp_socket> server;
+    std::unique_ptr<async_udp_socket> client;
+    endpoint server_endpoint{};
+    std::vector<std::byte> server_data;
+    std::vector<std::byte> client_data;
+    std::error_code result;
+
+    explicit raw_uring_udp_echo(std::size_t payload)
+        : server(loop.create_udp_socket()),
+          client(loop.create_udp_socket()),
+          server_data(payload),
+          client_data(payload)
+    {
+        server_endpoint = loopback_endpoint(free_udp_port());
+        server->bind(server_endpoint);
+        client->bind(loopback_endpoint(free_udp_port()));
+        start_server_receive();
+    }
+
+    void start_server_receive() {
+        server->async_receive_from(server_data,
+            [this](std::error_code ec, size_t n, endpoint from) {
+                if (ec) { result = ec; loop.stop(); return; }
+                server->async_send_to({server_data.data(), n}, from,
+                    [this](std::error_code ec, size_t) {
+                        if (ec) { result = ec; loop.stop(); }
+                    });
+                start_server_receive();
+            });
+    }
+
+    void operator()() {
+        client->async_receive_from(client_data,
+            [this](std::error_code ec, size_t, endpoint) {
+                result = ec;
+                loop.stop();
+            });
+        client->async_send_to(client_data, server_endpoint,
+            [this](std::error_code ec, size_t) {
+                if (ec) { result = ec; loop.stop(); }
+            });
+        loop.run();
+        if (result) throw std::system_error(result);
+    }
+};
+
+/**
+ * @brief The same ping-pong through asio's io_uring backend
+ */
+struct asio_udp_echo {
+    asio::io_context io_context{1};
+    asio::ip::udp::socket server;
+    asio::ip::udp::socket client;
+    asio::ip::udp::endpoint sender;
+    std::vector<char> server_data;
+    std::vector<char> client_data;
+    std::error_code result;
+
+    explicit asio_udp_echo(std::size_t payload)
+        : server(io_context, asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0)),
+          client(io_context, asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0)),
+          server_data(payload),
+          client_data(payload)
+    {
+        client.connect(server.local_endpoint());
+    }
+
+    void start_server_receive() {
+        server.async_receive_from(asio::buffer(server_data), sender,
+            [this](const std::error_code& ec, std::size_t n) {
+                if (ec) { result = ec; return; }
+                server.async_send_to(asio::buffer(server_data, n), sender,
+                    [this](const std::error_code& ec, std::size_t) {
+                        if (ec) result = ec;
+                    });
+            });
+    }
+
+    void operator()() {
+        // Unlike the sketch, io_context::run() returns when there is no more
+        // work, so the server receive is armed once per round trip.
+        start_server_receive();
+        client.async_receive(asio::buffer(client_data),
+            [this](const std::error_code& ec, std::size_t) {
+                if (ec) result = ec;
+            });
+        client.async_send(asio::buffer(client_data),
+            [this](const std::error_code& ec, std::size_t) {
+                if (ec) result = ec;
+            });
+        io_context.restart();
+        io_context.run();
+        if (result) throw std::system_error(result);
+    }
+};
+
+template <typename Fixture>
+bench::harness::operation make_operation(std::size_t payload) {
+    auto fixture = std::make_shared<Fixture>(payload);
+    return [fixture]() { (*fixture)(); };
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bench::harness h(bench::options::parse(argc, argv));
+
+    h.run("raw_uring_udp_echo", &make_operation<raw_uring_udp_echo>);
+    h.run("asio_udp_echo", &make_operation<asio_udp_echo>);
+
+    return 0;
+}
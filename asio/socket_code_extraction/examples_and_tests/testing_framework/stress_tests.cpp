@@ -0,0 +1,964 @@
+/**
+ * @file stress_tests.cpp
+ * @brief Stress and soak tests with allocation and leak accounting
+ *
+ * socket_tests.cpp checks that each socket operation works once. This suite
+ * checks that they keep working when repeated at volume, and that repeating
+ * them does not allocate or leak memory:
+ * - steady_echo: a fixed set of connections performing echo round trips
+ * - connection_churn: connect, one round trip and an abortive close, repeated
+ *   for --connections connections
+ * - cancel_timeout_mix: round trips mixed with reads ended by a deadline,
+ *   per-operation cancellation, socket::cancel() and close()
+ * - soak: the mixed workload for --duration seconds, reporting every
+ *   --report seconds
+ *
+ * Memory is accounted at two levels:
+ * - Every completion handler is bound, with asio::bind_allocator, to a
+ *   counting_allocator that records the allocations made for each kind of
+ *   operation. It serves them from a few blocks owned by the connection, and
+ *   passes any that do not fit on to asio::recycling_allocator. The report
+ *   gives handler allocations per operation and how many fell back.
+ * - The global operator new and operator delete are replaced to count heap
+ *   allocations. ASIO_DISABLE_STD_ALIGNED_ALLOC routes asio's own aligned
+ *   allocations, including recycling cache misses, through operator new, so
+ *   that none escape the count.
+ *
+ * A test fails if any operation has an unexpected outcome, if any heap
+ * allocation is made once the warmup steps have run (the connections' handler
+ * memory, the reactor's descriptor pool and the server's session pool should
+ * serve every steady state allocation), if any handler allocation is
+ * outstanding at the end, or if fewer heap blocks are freed than were
+ * allocated.
+ *
+ * Command line:
+ *   --connections=N  connections opened by connection_churn (default 100000)
+ *   --concurrency=N  client connections in flight at once (default 64)
+ *   --rounds=N       measured steps per connection (default 200)
+ *   --warmup=N       warmup steps per connection (default 20)
+ *   --payload=N      request size in bytes (default 64)
+ *   --duration=S     soak duration in seconds, 0 to skip (default 10)
+ *   --report=S       soak report interval in seconds (default 1)
+ *   --seed=N         seed for the choice of actions (default 1)
+ *   --list           print test names and exit
+ *   NAME...          run only the tests whose names contain NAME
+ *
+ * Build with the socket_stress_tests CMake target, which also enables the
+ * size-class recycling cache so that the soak report can show its hit and
+ * release counts, or:
+ *   g++ -std=c++20 -O2 -DASIO_STANDALONE -DASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES
+ *       -I/path/to/asio/include stress_tests.cpp -pthread
+ *
+ * Example (a one hour soak):
+ *   socket_stress_tests --duration=3600 --report=60 soak
+ */
+
+// Allocations made by asio itself must go through operator new to be counted.
+#if !defined(ASIO_DISABLE_STD_ALIGNED_ALLOC)
+#define ASIO_DISABLE_STD_ALIGNED_ALLOC 1
+#endif
+
+#include <asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace stress_tests {
+
+/**
+ * @struct heap_counters
+ * @brief Counts the calls made to the global operator new and operator delete
+ */
+struct heap_counters {
+    std::atomic<std::size_t> allocations{0};
+    std::atomic<std::size_t> deallocations{0};
+};
+
+heap_counters heap;
+
+/**
+ * @struct heap_snapshot
+ * @brief The heap counters at one point in time
+ */
+struct heap_snapshot {
+    std::size_t allocations = 0;
+    std::size_t deallocations = 0;
+
+    static heap_snapshot take() {
+        heap_snapshot s;
+        s.allocations = heap.allocations.load(std::memory_order_relaxed);
+        s.deallocations = heap.deallocations.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    std::size_t live() const { return allocations - deallocations; }
+};
+
+} // namespace stress_tests
+
+void* operator new(std::size_t size) {
+    stress_tests::heap.allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    if (!p) return;
+    stress_tests::heap.deallocations.fetch_add(1, std::memory_order_relaxed);
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    ::operator delete(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    ::operator delete(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    ::operator delete(p);
+}
+
+namespace stress_tests {
+
+using asio::ip::tcp;
+using clock_type = std::chrono::steady_clock;
+
+/**
+ * @struct operation_stats
+ * @brief Handler allocation counts for one kind of asynchronous operation
+ */
+struct operation_stats {
+    const char* name = "";
+    std::size_t started = 0;
+    std::size_t allocations = 0;
+    std::size_t fallbacks = 0;  // allocations passed on to recycling_allocator
+    std::size_t deallocations = 0;
+    std::size_t bytes = 0;
+};
+
+/**
+ * @class handler_memory
+ * @brief A few blocks of memory for the handlers of one connection
+ *
+ * A connection has at most a handful of operations outstanding, so its own
+ * blocks serve all of its handlers however many connections complete at once.
+ * A thread's recycling cache, by contrast, has a fixed depth that a burst of
+ * completions across many connections can exceed.
+ */
+class handler_memory {
+public:
+    static constexpr std::size_t block_size = 256;
+    static constexpr std::size_t block_count = 4;
+
+    handler_memory() = default;
+    handler_memory(const handler_memory&) = delete;
+    handler_memory& operator=(const handler_memory&) = delete;
+
+    void* allocate(std::size_t size) {
+        if (size > block_size) return nullptr;
+        for (std::size_t i = 0; i < block_count; ++i) {
+            if (!(in_use_ & (1u << i))) {
+                in_use_ |= 1u << i;
+                return blocks_[i];
+            }
+        }
+        return nullptr;
+    }
+
+    bool deallocate(void* p) {
+        for (std::size_t i = 0; i < block_count; ++i) {
+            if (p == blocks_[i]) {
+                in_use_ &= ~(1u << i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    alignas(std::max_align_t) unsigned char blocks_[block_count][block_size];
+    unsigned in_use_ = 0;
+};
+
+/**
+ * @class counting_allocator
+ * @brief Records handler allocations and serves them from a connection's
+ *        handler_memory, falling back to recycling_allocator
+ */
+template <typename T>
+class counting_allocator {
+public:
+    using value_type = T;
+
+    counting_allocator(operation_stats& stats, handler_memory& memory) noexcept
+        : stats_(&stats), memory_(&memory) {}
+
+    template <typename U>
+    counting_allocator(const counting_allocator<U>& other) noexcept
+        : stats_(other.stats_), memory_(other.memory_) {}
+
+    T* allocate(std::size_t n) {
+        ++stats_->allocations;
+        stats_->bytes += n * sizeof(T);
+        if (void* p = memory_->allocate(n * sizeof(T))) return static_cast<T*>(p);
+        ++stats_->fallbacks;
+        return asio::recycling_allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        ++stats_->deallocations;
+        if (!memory_->deallocate(p)) asio::recycling_allocator<T>().deallocate(p, n);
+    }
+
+    friend bool operator==(const counting_allocator& a, const counting_allocator& b) noexcept {
+        return a.stats_ == b.stats_ && a.memory_ == b.memory_;
+    }
+
+    friend bool operator!=(const counting_allocator& a, const counting_allocator& b) noexcept {
+        return !(a == b);
+    }
+
+private:
+    template <typename> friend class counting_allocator;
+    operation_stats* stats_;
+    handler_memory* memory_;
+};
+
+/**
+ * @brief Associates a handler with a counting_allocator and records the start
+ *        of the operation it completes
+ */
+template <typename Handler>
+auto counted(operation_stats& stats, handler_memory& memory, Handler&& handler) {
+    ++stats.started;
+    return asio::bind_allocator(counting_allocator<void>(stats, memory),
+                                std::forward<Handler>(handler));
+}
+
+/**
+ * @struct operation_table
+ * @brief Handler allocation counts for every kind of operation in a workload
+ */
+struct operation_table {
+    operation_stats connect{"connect"};
+    operation_stats accept{"accept"};
+    operation_stats read{"read"};
+    operation_stats write{"write"};
+    operation_stats wait{"wait"};
+
+    const operation_stats* begin() const { return &connect; }
+    const operation_stats* end() const { return &wait + 1; }
+
+    std::size_t outstanding() const {
+        std::size_t n = 0;
+        for (const operation_stats& s : *this) n += s.allocations - s.deallocations;
+        return n;
+    }
+};
+
+/**
+ * @struct options
+ * @brief Run configuration shared by every test
+ */
+struct options {
+    std::size_t connections = 100000;
+    std::size_t concurrency = 64;
+    std::size_t rounds = 200;
+    std::size_t warmup = 20;
+    std::size_t payload = 64;
+    std::size_t duration = 10;
+    std::size_t report = 1;
+    std::uint64_t seed = 1;
+    bool list = false;
+    std::vector<std::string> filters;
+
+    /**
+     * @brief Parses the command line, exiting with a usage message on error
+     */
+    static options parse(int argc, char* argv[]) {
+        options opts;
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            if (parse_value(arg, "--connections=", opts.connections)
+                || parse_value(arg, "--concurrency=", opts.concurrency)
+                || parse_value(arg, "--rounds=", opts.rounds)
+                || parse_value(arg, "--warmup=", opts.warmup)
+                || parse_value(arg, "--payload=", opts.payload)
+                || parse_value(arg, "--duration=", opts.duration)
+                || parse_value(arg, "--report=", opts.report)) {
+                continue;
+            } else if (std::strncmp(arg, "--seed=", 7) == 0) {
+                opts.seed = std::strtoull(arg + 7, nullptr, 10);
+            } else if (std::strcmp(arg, "--list") == 0) {
+                opts.list = true;
+            } else if (arg[0] == '-') {
+                std::fprintf(stderr,
+                    "Usage: %s [--connections=N] [--concurrency=N] [--rounds=N]"
+                    " [--warmup=N] [--payload=N] [--duration=S] [--report=S]"
+                    " [--seed=N] [--list] [NAME...]\n",
+                    argv[0]);
+                std::exit(1);
+            } else {
+                opts.filters.push_back(arg);
+            }
+        }
+        opts.concurrency = std::max<std::size_t>(1, opts.concurrency);
+        opts.rounds = std::max<std::size_t>(1, opts.rounds);
+        opts.payload = std::max<std::size_t>(1, opts.payload);
+        opts.report = std::max<std::size_t>(1, opts.report);
+        return opts;
+    }
+
+    bool selected(const std::string& name) const {
+        if (filters.empty()) return true;
+        for (const auto& f : filters) {
+            if (name.find(f) != std::string::npos) return true;
+        }
+        return false;
+    }
+
+private:
+    static bool parse_value(const char* arg, const char* prefix, std::size_t& value) {
+        const std::size_t length = std::strlen(prefix);
+        if (std::strncmp(arg, prefix, length) != 0) return false;
+        value = std::strtoul(arg + length, nullptr, 10);
+        return true;
+    }
+};
+
+/**
+ * @enum action
+ * @brief What a client does in one step on an open connection
+ */
+enum class action {
+    echo,           // send a request and read the reply before a deadline
+    timeout,        // send a request the server ignores and let the deadline end the read
+    cancel,         // start a read and cancel it through its cancellation slot
+    socket_cancel,  // start a read and cancel it with socket::cancel()
+    reconnect       // start a read, close the socket and connect again
+};
+
+/**
+ * @struct action_weights
+ * @brief Relative frequency of each action in a workload
+ */
+struct action_weights {
+    unsigned echo = 1;
+    unsigned timeout = 0;
+    unsigned cancel = 0;
+    unsigned socket_cancel = 0;
+    unsigned reconnect = 0;
+};
+
+/**
+ * @struct workload_config
+ * @brief Describes one test's workload
+ */
+struct workload_config {
+    std::string name;
+    std::size_t clients = 64;
+    std::size_t payload = 64;
+    action_weights weights;
+    bool close_after_step = false;   // connect for every step (connection churn)
+    std::size_t warmup_steps = 0;    // steps before allocations must stop
+    std::size_t total_steps = 0;     // 0 runs until the deadline
+    std::chrono::seconds duration{0};
+    std::chrono::seconds report_interval{0};
+    std::uint64_t seed = 1;
+};
+
+/**
+ * @struct outcome_counters
+ * @brief How the steps of a workload ended
+ */
+struct outcome_counters {
+    std::size_t steps = 0;
+    std::size_t connections = 0;
+    std::size_t echoes = 0;
+    std::size_t timeouts = 0;
+    std::size_t cancellations = 0;
+    std::size_t late_echoes = 0;  // echo reads that missed their deadline
+    std::size_t failures = 0;
+};
+
+// Requests starting with this byte are read by the server but not answered.
+constexpr char silent_request = 's';
+
+// Deadlines for reads that expect a reply, and for reads that do not.
+constexpr std::chrono::milliseconds echo_deadline{2000};
+constexpr std::chrono::milliseconds short_deadline{1};
+
+class workload;
+
+/**
+ * @class server_session
+ * @brief Server side of one connection: answers every request that is not silent
+ */
+class server_session {
+public:
+    explicit server_session(workload& w);
+
+    tcp::socket& socket() { return socket_; }
+    void start() { read_request(); }
+
+private:
+    void read_request();
+
+    workload& workload_;
+    tcp::socket socket_;
+    std::vector<char> buffer_;
+    handler_memory memory_;
+};
+
+/**
+ * @class client
+ * @brief Client side of one connection, performing one action per step
+ */
+class client {
+public:
+    client(workload& w, std::uint64_t seed);
+
+    void start() { next_step(); }
+
+private:
+    void next_step();
+    void connect();
+    void perform();
+    void send(action a);
+    void read(action a);
+    void on_read(action a, const std::error_code& ec);
+    void close_abortively();
+    action choose();
+
+    workload& workload_;
+    tcp::socket socket_;
+    asio::steady_timer timer_;
+    asio::cancellation_signal signal_;
+    std::vector<char> request_;
+    std::vector<char> response_;
+    std::uint64_t rng_;
+    std::uint64_t step_id_ = 0;
+    handler_memory memory_;
+};
+
+/**
+ * @class workload
+ * @brief Owns the io_context, the server and the clients of one test
+ */
+class workload {
+public:
+    explicit workload(const workload_config& config)
+        : config_(config),
+          acceptor_(io_context_, tcp::endpoint(asio::ip::address_v4::loopback(), 0)),
+          report_timer_(io_context_) {
+        endpoint_ = acceptor_.local_endpoint();
+        sessions_.reserve(config_.clients * 2);
+        free_sessions_.reserve(config_.clients * 2);
+        for (std::size_t i = 0; i < config_.clients * 2; ++i) {
+            sessions_.push_back(std::make_unique<server_session>(*this));
+            free_sessions_.push_back(sessions_.back().get());
+        }
+        for (std::size_t i = 0; i < config_.clients; ++i) {
+            clients_.push_back(std::make_unique<client>(*this, config_.seed + i));
+        }
+        reserve_descriptors(config_.clients * 4);
+    }
+
+    const workload_config& config() const { return config_; }
+    const tcp::endpoint& endpoint() const { return endpoint_; }
+    asio::io_context& io_context() { return io_context_; }
+    operation_table& operations() { return operations_; }
+    outcome_counters& outcomes() { return outcomes_; }
+
+    /**
+     * @brief Runs the workload to completion
+     * @return true if every check passed
+     */
+    bool run() {
+        start_ = clock_type::now();
+        deadline_ = start_ + config_.duration;
+        accept_next();
+        for (auto& c : clients_) c->start();
+        if (config_.report_interval.count() > 0) schedule_report();
+        io_context_.run();
+        return check();
+    }
+
+    /**
+     * @brief Called by a client before each step
+     * @return false if the workload has finished and the client should stop
+     */
+    bool begin_step() {
+        if (stopping_) return false;
+        if ((config_.total_steps && outcomes_.steps == config_.total_steps)
+            || (config_.duration.count() > 0 && clock_type::now() >= deadline_)) {
+            stop();
+            return false;
+        }
+        if (++outcomes_.steps == config_.warmup_steps) begin_measurement();
+        return true;
+    }
+
+    void client_finished() {
+        if (++finished_clients_ == clients_.size()) {
+            std::error_code ec;
+            acceptor_.close(ec);
+            report_timer_.cancel();
+        }
+    }
+
+    void release(server_session* s) {
+        free_sessions_.push_back(s);
+    }
+
+    void failure(const char* what, const std::error_code& ec) {
+        if (++outcomes_.failures <= 10) {
+            std::fprintf(stderr, "%s: %s failed: %s\n",
+                         config_.name.c_str(), what, ec.message().c_str());
+        }
+    }
+
+private:
+    // The reactor keeps the state of closed descriptors in a pool for reuse,
+    // but allocates more whenever the number of registered descriptors reaches
+    // a new peak. Registering sockets up front, by starting a wait on each,
+    // fills the pool beyond any peak the workload reaches, so that such growth
+    // is not mistaken for a steady state allocation.
+    void reserve_descriptors(std::size_t n) {
+        std::vector<tcp::socket> sockets;
+        sockets.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            sockets.emplace_back(io_context_, tcp::v4());
+            sockets.back().async_wait(tcp::socket::wait_read, [](const std::error_code&) {});
+        }
+        sockets.clear();
+        io_context_.run();
+        io_context_.restart();
+    }
+
+    void accept_next() {
+        server_session* s;
+        if (free_sessions_.empty()) {
+            sessions_.push_back(std::make_unique<server_session>(*this));
+            s = sessions_.back().get();
+        } else {
+            s = free_sessions_.back();
+            free_sessions_.pop_back();
+        }
+        acceptor_.async_accept(s->socket(),
+            counted(operations_.accept, accept_memory_, [this, s](const std::error_code& ec) {
+                if (ec) {
+                    release(s);
+                    if (ec != asio::error::operation_aborted) failure("accept", ec);
+                    return;
+                }
+                s->start();
+                if (acceptor_.is_open()) accept_next();
+            }));
+    }
+
+    void begin_measurement() {
+        measuring_ = true;
+        measured_from_ = heap_snapshot::take();
+        measured_steps_from_ = outcomes_.steps;
+        operations_from_ = operations_;
+    }
+
+    void stop() {
+        stopping_ = true;
+        if (!measuring_) begin_measurement();
+        measured_to_ = heap_snapshot::take();
+        measured_steps_to_ = outcomes_.steps;
+        operations_to_ = operations_;
+    }
+
+    void schedule_report() {
+        report_timer_.expires_after(config_.report_interval);
+        report_timer_.async_wait(
+            counted(operations_.wait, report_memory_, [this](const std::error_code& ec) {
+                if (ec || stopping_) return;
+                report();
+                schedule_report();
+            }));
+    }
+
+    // Prints one line of a soak report. Once measurement has begun, every
+    // interval must be free of heap allocations.
+    void report() {
+        const heap_snapshot now = heap_snapshot::take();
+        const std::size_t allocations = now.allocations - last_report_.allocations;
+        const std::size_t steps = outcomes_.steps - last_report_steps_;
+        const asio::recycling_allocator_statistics cache =
+            asio::get_recycling_allocator_statistics();
+        const double elapsed = std::chrono::duration<double>(clock_type::now() - start_).count();
+        std::printf("  [%7.0fs] steps %10zu (%8.0f/s) connections %9zu"
+                    " heap allocations %+6zd live %6zu cache hits %zu releases %zu\n",
+                    elapsed, outcomes_.steps,
+                    static_cast<double>(steps) / config_.report_interval.count(),
+                    outcomes_.connections, static_cast<std::ptrdiff_t>(allocations),
+                    now.live(), cache.cache_hits, cache.cache_releases);
+        std::fflush(stdout);
+        if (report_measuring_ && allocations != 0) ++growing_intervals_;
+        report_measuring_ = measuring_;
+        last_report_ = now;
+        last_report_steps_ = outcomes_.steps;
+    }
+
+    bool check() {
+        bool passed = true;
+        const std::size_t measured_steps = measured_steps_to_ - measured_steps_from_;
+        const std::size_t steady_allocations = measured_to_.allocations - measured_from_.allocations;
+
+        std::printf("  steps %zu, connections %zu, echoes %zu, timeouts %zu,"
+                    " cancellations %zu, late echoes %zu, failures %zu\n",
+                    outcomes_.steps, outcomes_.connections, outcomes_.echoes,
+                    outcomes_.timeouts, outcomes_.cancellations,
+                    outcomes_.late_echoes, outcomes_.failures);
+        std::printf("  %-10s %12s %12s %10s %12s %10s\n", "operation", "started",
+                    "allocations", "allocs/op", "bytes/alloc", "fallbacks");
+        for (const operation_stats* s = operations_to_.begin(), *f = operations_from_.begin();
+             s != operations_to_.end(); ++s, ++f) {
+            const std::size_t started = s->started - f->started;
+            const std::size_t allocations = s->allocations - f->allocations;
+            const std::size_t bytes = s->bytes - f->bytes;
+            std::printf("  %-10s %12zu %12zu %10.2f %12.0f %10zu\n", s->name, started,
+                        allocations, started ? static_cast<double>(allocations) / started : 0.0,
+                        allocations ? static_cast<double>(bytes) / allocations : 0.0,
+                        s->fallbacks - f->fallbacks);
+        }
+        std::printf("  heap allocations in steady state: %zu over %zu steps\n",
+                    steady_allocations, measured_steps);
+
+        if (outcomes_.failures != 0) {
+            std::printf("  FAILED: %zu operations had unexpected outcomes\n", outcomes_.failures);
+            passed = false;
+        }
+        if (steady_allocations != 0 || growing_intervals_ != 0) {
+            std::printf("  FAILED: steady state allocated from the heap\n");
+            passed = false;
+        }
+        if (operations_.outstanding() != 0) {
+            std::printf("  FAILED: %zu handler allocations were not freed\n",
+                        operations_.outstanding());
+            passed = false;
+        }
+        return passed;
+    }
+
+    workload_config config_;
+    asio::io_context io_context_;
+    tcp::acceptor acceptor_;
+    tcp::endpoint endpoint_;
+    asio::steady_timer report_timer_;
+    handler_memory report_memory_;
+    handler_memory accept_memory_;
+    std::vector<std::unique_ptr<server_session>> sessions_;
+    std::vector<server_session*> free_sessions_;
+    std::vector<std::unique_ptr<client>> clients_;
+    std::size_t finished_clients_ = 0;
+    operation_table operations_;
+    outcome_counters outcomes_;
+    clock_type::time_point start_;
+    clock_type::time_point deadline_;
+    bool stopping_ = false;
+    bool measuring_ = false;
+    heap_snapshot measured_from_;
+    heap_snapshot measured_to_;
+    std::size_t measured_steps_from_ = 0;
+    std::size_t measured_steps_to_ = 0;
+    operation_table operations_from_;
+    operation_table operations_to_;
+    heap_snapshot last_report_;
+    std::size_t last_report_steps_ = 0;
+    bool report_measuring_ = false;
+    std::size_t growing_intervals_ = 0;
+};
+
+server_session::server_session(workload& w)
+    : workload_(w), socket_(w.io_context()), buffer_(w.config().payload) {}
+
+void server_session::read_request() {
+    asio::async_read(socket_, asio::buffer(buffer_),
+        counted(workload_.operations().read, memory_, [this](const std::error_code& ec, std::size_t) {
+            if (ec) {
+                std::error_code ignored;
+                socket_.close(ignored);
+                workload_.release(this);
+                return;
+            }
+            if (buffer_[0] == silent_request) {
+                read_request();
+                return;
+            }
+            asio::async_write(socket_, asio::buffer(buffer_),
+                counted(workload_.operations().write, memory_, [this](const std::error_code& ec, std::size_t) {
+                    if (ec) {
+                        std::error_code ignored;
+                        socket_.close(ignored);
+                        workload_.release(this);
+                        return;
+                    }
+                    read_request();
+                }));
+        }));
+}
+
+client::client(workload& w, std::uint64_t seed)
+    : workload_(w),
+      socket_(w.io_context()),
+      timer_(w.io_context()),
+      request_(w.config().payload, 'e'),
+      response_(w.config().payload),
+      rng_(seed * 0x9E3779B97F4A7C15ull | 1) {}
+
+void client::next_step() {
+    if (!workload_.begin_step()) {
+        std::error_code ignored;
+        socket_.close(ignored);
+        workload_.client_finished();
+        return;
+    }
+    if (!socket_.is_open()) {
+        connect();
+        return;
+    }
+    perform();
+}
+
+void client::connect() {
+    socket_.async_connect(workload_.endpoint(),
+        counted(workload_.operations().connect, memory_, [this](const std::error_code& ec) {
+            if (ec) {
+                workload_.failure("connect", ec);
+                std::error_code ignored;
+                socket_.close(ignored);
+                next_step();
+                return;
+            }
+            ++workload_.outcomes().connections;
+            std::error_code ignored;
+            socket_.set_option(tcp::no_delay(true), ignored);
+            perform();
+        }));
+}
+
+void client::perform() {
+    const action a = choose();
+    switch (a) {
+    case action::echo:
+    case action::timeout:
+        send(a);
+        return;
+    case action::cancel:
+        read(a);
+        signal_.emit(asio::cancellation_type::partial);
+        return;
+    case action::socket_cancel:
+        read(a);
+        socket_.cancel();
+        return;
+    case action::reconnect:
+        read(a);
+        close_abortively();
+        return;
+    }
+}
+
+void client::send(action a) {
+    request_[0] = (a == action::timeout) ? silent_request : 'e';
+    asio::async_write(socket_, asio::buffer(request_),
+        counted(workload_.operations().write, memory_, [this, a](const std::error_code& ec, std::size_t) {
+            if (ec) {
+                workload_.failure("write", ec);
+                close_abortively();
+                next_step();
+                return;
+            }
+            read(a);
+        }));
+}
+
+void client::read(action a) {
+    const std::uint64_t id = ++step_id_;
+    if (a == action::echo || a == action::timeout) {
+        timer_.expires_after(a == action::echo ? echo_deadline : short_deadline);
+        timer_.async_wait(
+            counted(workload_.operations().wait, memory_, [this, id, a](const std::error_code& ec) {
+                if (!ec && id == step_id_) {
+                    signal_.emit(a == action::echo ? asio::cancellation_type::terminal
+                                                   : asio::cancellation_type::partial);
+                }
+            }));
+    }
+
+    auto handler = asio::bind_cancellation_slot(signal_.slot(),
+        counted(workload_.operations().read, memory_, [this, a](const std::error_code& ec, std::size_t) {
+            on_read(a, ec);
+        }));
+    if (a == action::echo) {
+        asio::async_read(socket_, asio::buffer(response_), std::move(handler));
+    } else {
+        socket_.async_read_some(asio::buffer(response_), std::move(handler));
+    }
+}
+
+void client::on_read(action a, const std::error_code& ec) {
+    ++step_id_;
+    timer_.cancel();
+    outcome_counters& outcomes = workload_.outcomes();
+    switch (a) {
+    case action::echo:
+        if (!ec && std::memcmp(request_.data(), response_.data(), request_.size()) == 0) {
+            ++outcomes.echoes;
+        } else if (ec == asio::error::operation_aborted) {
+            // The reply may still arrive, so the connection cannot be reused.
+            ++outcomes.late_echoes;
+            close_abortively();
+        } else {
+            workload_.failure("echo", ec ? ec : make_error_code(std::errc::bad_message));
+            close_abortively();
+        }
+        break;
+    case action::timeout:
+        if (ec == asio::error::operation_aborted) {
+            ++outcomes.timeouts;
+        } else {
+            workload_.failure("timeout", ec ? ec : make_error_code(std::errc::bad_message));
+            close_abortively();
+        }
+        break;
+    case action::cancel:
+    case action::socket_cancel:
+    case action::reconnect:
+        if (ec == asio::error::operation_aborted) {
+            ++outcomes.cancellations;
+        } else {
+            workload_.failure("cancel", ec ? ec : make_error_code(std::errc::bad_message));
+            close_abortively();
+        }
+        break;
+    }
+    if (workload_.config().close_after_step) close_abortively();
+    next_step();
+}
+
+// Closes with a reset rather than a FIN, so that churning through many
+// connections does not leave the client ports in TIME_WAIT.
+void client::close_abortively() {
+    std::error_code ignored;
+    socket_.set_option(asio::socket_base::linger(true, 0), ignored);
+    socket_.close(ignored);
+}
+
+action client::choose() {
+    const action_weights& w = workload_.config().weights;
+    const unsigned total = w.echo + w.timeout + w.cancel + w.socket_cancel + w.reconnect;
+    rng_ ^= rng_ << 13;
+    rng_ ^= rng_ >> 7;
+    rng_ ^= rng_ << 17;
+    unsigned r = static_cast<unsigned>(rng_ % total);
+    if (r < w.echo) return action::echo;
+    if ((r -= w.echo) < w.timeout) return action::timeout;
+    if ((r -= w.timeout) < w.cancel) return action::cancel;
+    if ((r -= w.cancel) < w.socket_cancel) return action::socket_cancel;
+    return action::reconnect;
+}
+
+/**
+ * @brief Runs one workload and checks that it freed every heap block it allocated
+ */
+bool run_test(const workload_config& config) {
+    std::printf("=== %s ===\n", config.name.c_str());
+    std::fflush(stdout);
+    const heap_snapshot before = heap_snapshot::take();
+    bool passed;
+    try {
+        workload w(config);
+        passed = w.run();
+    } catch (const std::exception& e) {
+        std::printf("  FAILED: %s\n", e.what());
+        return false;
+    }
+    const heap_snapshot after = heap_snapshot::take();
+    if (after.live() > before.live()) {
+        std::printf("  FAILED: %zu heap blocks leaked\n", after.live() - before.live());
+        passed = false;
+    }
+    std::printf("  %s\n", passed ? "PASSED" : "FAILED");
+    return passed;
+}
+
+action_weights mixed_weights() {
+    action_weights w;
+    w.echo = 10;
+    w.timeout = 3;
+    w.cancel = 3;
+    w.socket_cancel = 2;
+    w.reconnect = 2;
+    return w;
+}
+
+} // namespace stress_tests
+
+int main(int argc, char* argv[]) {
+    using namespace stress_tests;
+    const options opts = options::parse(argc, argv);
+
+    std::vector<workload_config> tests;
+
+    workload_config steady;
+    steady.name = "steady_echo";
+    steady.clients = opts.concurrency;
+    steady.payload = opts.payload;
+    steady.warmup_steps = opts.concurrency * opts.warmup;
+    steady.total_steps = steady.warmup_steps + opts.concurrency * opts.rounds;
+    steady.seed = opts.seed;
+    tests.push_back(steady);
+
+    workload_config churn = steady;
+    churn.name = "connection_churn";
+    churn.close_after_step = true;
+    churn.warmup_steps = std::min(opts.connections / 10, opts.concurrency * opts.warmup);
+    churn.total_steps = std::max<std::size_t>(opts.connections, churn.warmup_steps + 1);
+    tests.push_back(churn);
+
+    workload_config mixed = steady;
+    mixed.name = "cancel_timeout_mix";
+    mixed.weights = mixed_weights();
+    tests.push_back(mixed);
+
+    if (opts.duration > 0) {
+        workload_config soak = mixed;
+        soak.name = "soak";
+        soak.total_steps = 0;
+        soak.duration = std::chrono::seconds(opts.duration);
+        soak.report_interval = std::chrono::seconds(opts.report);
+        tests.push_back(soak);
+    }
+
+    int failed = 0;
+    for (const workload_config& config : tests) {
+        if (opts.list) {
+            std::printf("%s\n", config.name.c_str());
+        } else if (opts.selected(config.name)) {
+            failed += run_test(config) ? 0 : 1;
+        }
+    }
+    if (!opts.list) {
+        std::printf("%s\n", failed ? "Some stress tests FAILED" : "All stress tests PASSED");
+    }
+    return failed ? 1 : 0;
+}
@@ -1,4 +1,5 @@
 // UDP async sketch with connected sockets for testing
+#define SKIP_MAIN
 #include "udp_async_sketch.cpp"
 
 // Override the example to use connected sockets
@@ -109,6 +110,36 @@ int connected_example() {
   // Create connected client socket
   auto client_socket = loop.create_udp_socket();
 
+#if defined(__linux__)
+  // On io_uring the connected socket sends and receives with
+  // IORING_OP_SEND and IORING_OP_RECV. The operations are queued before the
+  // loop thread starts and are submitted by its first iteration.
+  endpoint server_ep{};
+  server_ep.address = INADDR_LOOPBACK;
+  server_ep.port = 8081;
+  client_socket->connect(server_ep);
+
+  const char connected_msg[] = "Hello, io_uring connected UDP!";
+  std::byte connected_buffer[64];
+  std::atomic<bool> connected_success{false};
+  client_socket->async_receive(
+      connected_buffer, [&](std::error_code ec, size_t bytes) {
+        connected_success =
+            !ec && bytes == sizeof(connected_msg) - 1 &&
+            memcmp(connected_buffer, connected_msg, bytes) == 0;
+        std::cout << "Client: Received " << bytes
+                  << " byte echo on connected socket\n";
+      });
+  client_socket->async_send(
+      std::as_bytes(std::span(connected_msg, sizeof(connected_msg) - 1)),
+      [](std::error_code ec, size_t bytes) {
+        if (!ec) {
+          std::cout << "Client: Sent " << bytes
+                    << " bytes on connected socket\n";
+        }
+      });
+#endif
+
   // Server receive loop
   std::byte recv_buffer[1024];
   std::function<void()> start_receive;
@@ -160,6 +191,13 @@ int connected_example() {
   std::this_thread::sleep_for(std::chrono::milliseconds(100));
   server_thread.join();
 
+#if defined(__linux__)
+  if (!connected_success) {
+    std::cerr << "Client: No echo on connected io_uring socket\n";
+    return 1;
+  }
+#endif
+
   return client.is_success() ? 0 : 1;
 }
 
@@ -172,6 +210,11 @@ int main() {
   std::cout << "\n=== Running async UDP test ===\n";
   int result = example_usage();
 
+  if (result == 0) {
+    std::cout << "\n=== Running connected async UDP test ===\n";
+    result = connected_example();
+  }
+
   if (result == 0) {
     std::cout << "\nALL TESTS PASSED!\n";
   } else {
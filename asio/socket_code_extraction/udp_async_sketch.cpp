@@ -1,18 +1,32 @@
 // Minimal Async UDP Implementation Sketch
 // Platform-specific async I/O without coroutine integration
-
+//
+// Starting an operation never allocates. Each socket owns a fixed number of
+// operation slots per direction, and a completion handler is stored inline
+// in its slot rather than in a std::function. Handlers are template
+// parameters, so a call through the slot is one indirect call with no
+// virtual dispatch on the socket. When every slot for a direction is busy,
+// the operation completes at once with std::errc::device_or_resource_busy,
+// as it does when the io_uring submission queue is full.
+//
+// A socket must outlive its pending operations.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <functional>
 #include <iostream>
-#include <map>
 #include <memory>
+#include <new>
 #include <span>
 #include <system_error>
-#include <variant>
 #include <thread>
-#include <atomic>
-#include <chrono>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #ifndef _WIN32
 #include <arpa/inet.h>
@@ -36,20 +50,95 @@ struct endpoint {
 
 using buffer = std::span<std::byte>;
 using const_buffer = std::span<const std::byte>;
-using completion_handler = std::function<void(std::error_code, size_t)>;
-using receive_handler = std::function<void(std::error_code, size_t, endpoint)>;
 
-// Base interface
-class async_udp_socket {
+// Completion signatures
+using send_signature = void(std::error_code, size_t);
+using receive_signature = void(std::error_code, size_t, endpoint);
+
+// Number of operations that may be pending in each direction on one socket.
+constexpr std::size_t max_pending_ops = 4;
+
+// =============================================================================
+// Inline Handler Storage
+// =============================================================================
+
+// Holds one completion handler in place. A handler that does not fit is
+// rejected at compile time instead of falling back to the heap.
+template <typename Signature, std::size_t Size = 64> class handler_slot;
+
+template <typename... Args, std::size_t Size>
+class handler_slot<void(Args...), Size> {
 public:
-  virtual ~async_udp_socket() = default;
-  virtual void async_send_to(const_buffer data, const endpoint &ep,
-                             completion_handler handler) = 0;
-  virtual void async_receive_from(buffer data, receive_handler handler) = 0;
-  virtual void bind(const endpoint &ep) = 0;
-  virtual void close() = 0;
+  handler_slot() = default;
+  handler_slot(const handler_slot &) = delete;
+  handler_slot &operator=(const handler_slot &) = delete;
+  ~handler_slot() { reset(); }
+
+  bool empty() const { return invoke_ == nullptr; }
+
+  template <typename Handler> void emplace(Handler &&handler) {
+    using handler_type = std::decay_t<Handler>;
+    static_assert(sizeof(handler_type) <= Size,
+                  "handler is too large for its operation slot");
+    static_assert(alignof(handler_type) <= alignof(std::max_align_t),
+                  "handler is over-aligned for its operation slot");
+
+    ::new (static_cast<void *>(storage_))
+        handler_type(std::forward<Handler>(handler));
+    invoke_ = &invoke<handler_type>;
+    destroy_ = &destroy<handler_type>;
+  }
+
+  // The handler is moved out and the slot freed before the call, so the
+  // handler may start another operation that reuses the slot.
+  void complete(Args... args) {
+    auto *invoke_fn = invoke_;
+    invoke_ = nullptr;
+    destroy_ = nullptr;
+    invoke_fn(storage_, std::move(args)...);
+  }
+
+  void reset() {
+    if (destroy_) {
+      destroy_(storage_);
+      invoke_ = nullptr;
+      destroy_ = nullptr;
+    }
+  }
+
+private:
+  template <typename Handler>
+  static void invoke(unsigned char *storage, Args... args) {
+    Handler *stored = std::launder(reinterpret_cast<Handler *>(storage));
+    Handler handler(std::move(*stored));
+    stored->~Handler();
+    handler(std::move(args)...);
+  }
+
+  template <typename Handler> static void destroy(unsigned char *storage) {
+    std::launder(reinterpret_cast<Handler *>(storage))->~Handler();
+  }
+
+  alignas(std::max_align_t) unsigned char storage_[Size];
+  void (*invoke_)(unsigned char *, Args...) = nullptr;
+  void (*destroy_)(unsigned char *) = nullptr;
 };
 
+// Finds a free slot in a socket's fixed array of operations.
+template <typename Operation, std::size_t N>
+Operation *acquire_slot(std::array<Operation, N> &ops) {
+  for (auto &op : ops) {
+    if (!op.busy()) {
+      return &op;
+    }
+  }
+  return nullptr;
+}
+
+inline std::error_code slots_busy_error() {
+  return std::make_error_code(std::errc::device_or_resource_busy);
+}
+
 #ifdef _WIN32
 // =============================================================================
 // Windows IOCP Implementation
@@ -60,62 +149,71 @@ public:
 #include <winsock2.h>
 #include <ws2tcpip.h>
 
-class iocp_udp_socket : public async_udp_socket {
+class iocp_udp_socket {
 private:
   SOCKET socket_;
   HANDLE iocp_;
 
-  // Operation types for IOCP
-  enum op_type { op_send, op_recv };
-
-  // Base operation structure
+  // Base operation structure. The completion function is a plain pointer
+  // set by the derived operation.
   struct operation : OVERLAPPED {
-    op_type type;
-    virtual void complete(DWORD bytes_transferred, DWORD error) = 0;
-    virtual ~operation() = default;
+    void (*complete_fn)(operation *, DWORD, DWORD) = nullptr;
   };
 
   // Send operation
   struct send_operation : operation {
-    completion_handler handler;
+    handler_slot<send_signature> handler;
     WSABUF wsabuf;
 
-    void complete(DWORD bytes_transferred, DWORD error) override {
+    send_operation() { complete_fn = &do_complete; }
+
+    bool busy() const { return !handler.empty(); }
+
+    static void do_complete(operation *base, DWORD bytes_transferred,
+                         DWORD error) {
+      auto *op = static_cast<send_operation *>(base);
       std::error_code ec;
       if (error != 0) {
         ec = std::error_code(error, std::system_category());
       }
-      handler(ec, bytes_transferred);
-      delete this;
+      op->handler.complete(ec, bytes_transferred);
     }
   };
 
   // Receive operation
   struct receive_operation : operation {
-    receive_handler handler;
+    handler_slot<receive_signature> handler;
     WSABUF wsabuf;
     sockaddr_storage addr;
     int addr_len = sizeof(addr);
     DWORD flags = 0;
 
-    void complete(DWORD bytes_transferred, DWORD error) override {
+    receive_operation() { complete_fn = &do_complete; }
+
+    bool busy() const { return !handler.empty(); }
+
+    static void do_complete(operation *base, DWORD bytes_transferred,
+                         DWORD error) {
+      auto *op = static_cast<receive_operation *>(base);
       std::error_code ec;
       if (error != 0) {
         ec = std::error_code(error, std::system_category());
       }
 
-      endpoint ep;
-      if (!ec && addr.ss_family == AF_INET) {
-        auto *sin = reinterpret_cast<sockaddr_in *>(&addr);
+      endpoint ep{};
+      if (!ec && op->addr.ss_family == AF_INET) {
+        auto *sin = reinterpret_cast<sockaddr_in *>(&op->addr);
         ep.address = ntohl(sin->sin_addr.s_addr);
         ep.port = ntohs(sin->sin_port);
       }
 
-      handler(ec, bytes_transferred, ep);
-      delete this;
+      op->handler.complete(ec, bytes_transferred, ep);
     }
   };
 
+  std::array<send_operation, max_pending_ops> send_ops_;
+  std::array<receive_operation, max_pending_ops> receive_ops_;
+
 public:
   iocp_udp_socket(HANDLE iocp) : socket_(INVALID_SOCKET), iocp_(iocp) {
     // Create UDP socket
@@ -135,7 +233,7 @@ public:
 
   ~iocp_udp_socket() { close(); }
 
-  void bind(const endpoint &ep) override {
+  void bind(const endpoint &ep) {
     sockaddr_in addr{};
     addr.sin_family = AF_INET;
     addr.sin_addr.s_addr = htonl(ep.address);
@@ -146,11 +244,17 @@ public:
     }
   }
 
+  template <typename Handler>
   void async_send_to(const_buffer data, const endpoint &ep,
-                     completion_handler handler) override {
-    auto *op = new send_operation();
-    op->type = op_send;
-    op->handler = std::move(handler);
+                     Handler &&handler) {
+    send_operation *op = acquire_slot(send_ops_);
+    if (!op) {
+      handler(slots_busy_error(), size_t(0));
+      return;
+    }
+
+    static_cast<OVERLAPPED &>(*op) = OVERLAPPED{};
+    op->handler.emplace(std::forward<Handler>(handler));
     op->wsabuf.buf = (char *)data.data();
     op->wsabuf.len = data.size();
 
@@ -166,17 +270,25 @@ public:
     if (result == SOCKET_ERROR) {
       int error = WSAGetLastError();
       if (error != WSA_IO_PENDING) {
-        op->complete(0, error);
+        send_operation::do_complete(op, 0, error);
       }
     }
   }
 
-  void async_receive_from(buffer data, receive_handler handler) override {
-    auto *op = new receive_operation();
-    op->type = op_recv;
-    op->handler = std::move(handler);
+  template <typename Handler>
+  void async_receive_from(buffer data, Handler &&handler) {
+    receive_operation *op = acquire_slot(receive_ops_);
+    if (!op) {
+      handler(slots_busy_error(), size_t(0), endpoint{});
+      return;
+    }
+
+    static_cast<OVERLAPPED &>(*op) = OVERLAPPED{};
+    op->handler.emplace(std::forward<Handler>(handler));
     op->wsabuf.buf = (char *)data.data();
     op->wsabuf.len = data.size();
+    op->addr_len = sizeof(op->addr);
+    op->flags = 0;
 
     DWORD bytes_received;
     int result =
@@ -186,12 +298,12 @@ public:
     if (result == SOCKET_ERROR) {
       int error = WSAGetLastError();
       if (error != WSA_IO_PENDING) {
-        op->complete(0, error);
+        receive_operation::do_complete(op, 0, error);
       }
     }
   }
 
-  void close() override {
+  void close() {
     if (socket_ != INVALID_SOCKET) {
       closesocket(socket_);
       socket_ = INVALID_SOCKET;
@@ -202,10 +314,12 @@ public:
   static void handle_completion(OVERLAPPED *overlapped, DWORD bytes_transferred,
                                 DWORD error) {
     auto *op = static_cast<operation *>(overlapped);
-    op->complete(bytes_transferred, error);
+    op->complete_fn(op, bytes_transferred, error);
   }
 };
 
+using async_udp_socket = iocp_udp_socket;
+
 // IOCP Event Loop
 class iocp_event_loop {
   HANDLE iocp_;
@@ -251,28 +365,110 @@ public:
 #include <sys/socket.h>
 #include <unistd.h>
 
-class io_uring_udp_socket : public async_udp_socket {
+// Provided buffer rings need liburing 2.4 and Linux 5.19.
+#if defined(IO_URING_VERSION_MAJOR) &&                                         \
+    (IO_URING_VERSION_MAJOR > 2 ||                                             \
+     (IO_URING_VERSION_MAJOR == 2 && IO_URING_VERSION_MINOR >= 4))
+#define UDP_SKETCH_HAS_BUFFER_RING 1
+#endif
+
+// Base operation structure. The completion function is a plain pointer set
+// by the derived operation, and the operation's address is the SQE's
+// user_data.
+struct io_uring_operation {
+  void (*complete_fn)(io_uring_operation *, int32_t, uint32_t) = nullptr;
+
+  void complete(int32_t result, uint32_t flags) {
+    complete_fn(this, result, flags);
+  }
+};
+
+#if defined(UDP_SKETCH_HAS_BUFFER_RING)
+// A ring of receive buffers registered with io_uring. The kernel picks a
+// buffer when a datagram arrives, so a pending receive does not pin memory
+// of its own. Buffers are returned to the ring after the handler runs.
+class io_uring_buffer_ring {
+  io_uring *ring_ = nullptr;
+  io_uring_buf_ring *buf_ring_ = nullptr;
+  unsigned entries_;
+  size_t buffer_size_;
+  int group_id_;
+  std::vector<std::byte> storage_;
+
+public:
+  io_uring_buffer_ring(io_uring *ring, unsigned entries, size_t buffer_size,
+                       int group_id = 0)
+      : ring_(ring), entries_(entries), buffer_size_(buffer_size),
+        group_id_(group_id), storage_(entries * buffer_size) {
+    int result = 0;
+    buf_ring_ = io_uring_setup_buf_ring(ring_, entries_, group_id_, 0, &result);
+    if (!buf_ring_) {
+      throw std::system_error(-result, std::generic_category());
+    }
+
+    for (unsigned i = 0; i < entries_; ++i) {
+      io_uring_buf_ring_add(buf_ring_, storage_.data() + i * buffer_size_,
+                            buffer_size_, i, io_uring_buf_ring_mask(entries_),
+                            i);
+    }
+    io_uring_buf_ring_advance(buf_ring_, entries_);
+  }
+
+  io_uring_buffer_ring(const io_uring_buffer_ring &) = delete;
+  io_uring_buffer_ring &operator=(const io_uring_buffer_ring &) = delete;
+
+  ~io_uring_buffer_ring() {
+    io_uring_free_buf_ring(ring_, buf_ring_, entries_, group_id_);
+  }
+
+  int group_id() const { return group_id_; }
+  size_t buffer_size() const { return buffer_size_; }
+
+  buffer get(uint16_t id) {
+    return buffer(storage_.data() + id * buffer_size_, buffer_size_);
+  }
+
+  void recycle(uint16_t id) {
+    io_uring_buf_ring_add(buf_ring_, storage_.data() + id * buffer_size_,
+                          buffer_size_, id, io_uring_buf_ring_mask(entries_),
+                          0);
+    io_uring_buf_ring_advance(buf_ring_, 1);
+  }
+};
+#endif // defined(UDP_SKETCH_HAS_BUFFER_RING)
+
+class io_uring_udp_socket {
 private:
   int fd_;
   io_uring *ring_;
+#if defined(UDP_SKETCH_HAS_BUFFER_RING)
+  io_uring_buffer_ring *buffers_;
+#endif
 
-  // Operation types
-  enum op_type { op_send, op_recv };
-
-public:
-  // User data for operations
-  struct operation {
-    op_type type;
-    virtual void complete(int32_t result) = 0;
-    virtual ~operation() = default;
-  };
+  static endpoint to_endpoint(const sockaddr_storage &addr) {
+    endpoint ep{};
+    if (addr.ss_family == AF_INET) {
+      auto *sin = reinterpret_cast<const sockaddr_in *>(&addr);
+      ep.address = ntohl(sin->sin_addr.s_addr);
+      ep.port = ntohs(sin->sin_port);
+      // Also copy the sockaddr_in structure for sendto
+      ep.sin = *sin;
+    }
+    return ep;
+  }
 
-  struct send_operation : operation {
-    completion_handler handler;
+  struct send_operation : io_uring_operation {
+    handler_slot<send_signature> handler;
     sockaddr_storage addr;
     socklen_t addr_len;
 
-    void complete(int32_t result) override {
+    send_operation() { complete_fn = &do_complete; }
+
+    bool busy() const { return !handler.empty(); }
+
+    static void do_complete(io_uring_operation *base, int32_t result,
+                            uint32_t) {
+      auto *op = static_cast<send_operation *>(base);
       std::error_code ec;
       size_t bytes = 0;
 
@@ -282,21 +478,46 @@ public:
         bytes = result;
       }
 
-      handler(ec, bytes);
-      delete this;
+      op->handler.complete(ec, bytes);
     }
   };
 
-  struct receive_operation : operation {
-    receive_handler handler;
+  struct receive_operation : io_uring_operation {
+    handler_slot<receive_signature> handler;
+    handler_slot<send_signature> connected_handler;
+#if defined(UDP_SKETCH_HAS_BUFFER_RING)
+    handler_slot<void(std::error_code, const_buffer, endpoint)> ring_handler;
+    io_uring_buffer_ring *buffers = nullptr;
+#endif
     sockaddr_storage addr;
-    socklen_t addr_len;
     struct msghdr msg;
     struct iovec iov;
-    
-    receive_operation() : addr_len(sizeof(addr)) {}
 
-    void complete(int32_t result) override {
+    receive_operation() { complete_fn = &do_complete; }
+
+    bool busy() const {
+#if defined(UDP_SKETCH_HAS_BUFFER_RING)
+      if (!ring_handler.empty()) {
+        return true;
+      }
+#endif
+      return !handler.empty() || !connected_handler.empty();
+    }
+
+    void prepare(void *data, size_t size) {
+      iov.iov_base = data;
+      iov.iov_len = size;
+
+      memset(&msg, 0, sizeof(msg));
+      msg.msg_name = &addr;
+      msg.msg_namelen = sizeof(addr);
+      msg.msg_iov = &iov;
+      msg.msg_iovlen = 1;
+    }
+
+    static void do_complete(io_uring_operation *base, int32_t result,
+                         [[maybe_unused]] uint32_t flags) {
+      auto *op = static_cast<receive_operation *>(base);
       std::error_code ec;
       size_t bytes = 0;
       endpoint ep{};
@@ -305,23 +526,43 @@ public:
         ec = std::error_code(-result, std::generic_category());
       } else {
         bytes = result;
+        ep = to_endpoint(op->addr);
+      }
 
-        if (addr.ss_family == AF_INET) {
-          auto *sin = reinterpret_cast<sockaddr_in *>(&addr);
-          ep.address = ntohl(sin->sin_addr.s_addr);
-          ep.port = ntohs(sin->sin_port);
-          // Also copy the sockaddr_in structure for sendto
-          ep.sin = *sin;
+#if defined(UDP_SKETCH_HAS_BUFFER_RING)
+      if (!op->ring_handler.empty()) {
+        io_uring_buffer_ring *buffers = op->buffers;
+        if (flags & IORING_CQE_F_BUFFER) {
+          uint16_t id = flags >> IORING_CQE_BUFFER_SHIFT;
+          buffer data = buffers->get(id).first(bytes);
+          op->ring_handler.complete(ec, const_buffer(data), ep);
+          buffers->recycle(id);
+        } else {
+          op->ring_handler.complete(ec, const_buffer(), ep);
         }
+        return;
       }
+#endif
 
-      handler(ec, bytes, ep);
-      delete this;
+      if (!op->connected_handler.empty()) {
+        op->connected_handler.complete(ec, bytes);
+        return;
+      }
+
+      op->handler.complete(ec, bytes, ep);
     }
   };
 
+  std::array<send_operation, max_pending_ops> send_ops_;
+  std::array<receive_operation, max_pending_ops> receive_ops_;
+
 public:
+#if defined(UDP_SKETCH_HAS_BUFFER_RING)
+  io_uring_udp_socket(io_uring *ring, io_uring_buffer_ring *buffers = nullptr)
+      : fd_(-1), ring_(ring), buffers_(buffers) {
+#else
   io_uring_udp_socket(io_uring *ring) : fd_(-1), ring_(ring) {
+#endif
     fd_ = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
     if (fd_ < 0) {
       throw std::system_error(errno, std::generic_category());
@@ -330,7 +571,7 @@ public:
 
   ~io_uring_udp_socket() { close(); }
 
-  void bind(const endpoint &ep) override {
+  void bind(const endpoint &ep) {
     sockaddr_in addr{};
     addr.sin_family = AF_INET;
     addr.sin_addr.s_addr = htonl(ep.address);
@@ -341,11 +582,67 @@ public:
     }
   }
 
+  // Fix the peer, so that datagrams are exchanged with async_send and
+  // async_receive. These use IORING_OP_SEND and IORING_OP_RECV, which take
+  // the buffer directly and need no msghdr or address for each packet.
+  void connect(const endpoint &ep) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(ep.address);
+    addr.sin_port = htons(ep.port);
+
+    if (::connect(fd_, (sockaddr *)&addr, sizeof(addr)) < 0) {
+      throw std::system_error(errno, std::generic_category());
+    }
+  }
+
+  template <typename Handler>
+  void async_send(const_buffer data, Handler &&handler) {
+    send_operation *op = acquire_slot(send_ops_);
+    if (!op) {
+      handler(slots_busy_error(), size_t(0));
+      return;
+    }
+    op->handler.emplace(std::forward<Handler>(handler));
+
+    io_uring_sqe *sqe = io_uring_get_sqe(ring_);
+    if (!sqe) {
+      op->complete(-EBUSY, 0);
+      return;
+    }
+
+    io_uring_prep_send(sqe, fd_, data.data(), data.size(), 0);
+    io_uring_sqe_set_data(sqe, static_cast<io_uring_operation *>(op));
+  }
+
+  template <typename Handler>
+  void async_receive(buffer data, Handler &&handler) {
+    receive_operation *op = acquire_slot(receive_ops_);
+    if (!op) {
+      handler(slots_busy_error(), size_t(0));
+      return;
+    }
+    op->connected_handler.emplace(std::forward<Handler>(handler));
+
+    io_uring_sqe *sqe = io_uring_get_sqe(ring_);
+    if (!sqe) {
+      op->complete(-EBUSY, 0);
+      return;
+    }
+
+    io_uring_prep_recv(sqe, fd_, data.data(), data.size(), 0);
+    io_uring_sqe_set_data(sqe, static_cast<io_uring_operation *>(op));
+  }
+
+  template <typename Handler>
   void async_send_to(const_buffer data, const endpoint &ep,
-                     completion_handler handler) override {
-    auto *op = new send_operation();
-    op->type = op_send;
-    op->handler = std::move(handler);
+                     Handler &&handler) {
+    send_operation *op = acquire_slot(send_ops_);
+    if (!op) {
+      handler(slots_busy_error(), size_t(0));
+      return;
+    }
+    op->handler.emplace(std::forward<Handler>(handler));
 
     // Copy endpoint data to operation for persistence
     if (ep.sin.sin_family == AF_INET) {
@@ -366,46 +663,68 @@ public:
 
     io_uring_sqe *sqe = io_uring_get_sqe(ring_);
     if (!sqe) {
-      op->complete(-EBUSY);
+      op->complete(-EBUSY, 0);
       return;
     }
 
     io_uring_prep_sendto(sqe, fd_, data.data(), data.size(), 0,
                          (sockaddr*)&op->addr, op->addr_len);
-    io_uring_sqe_set_data(sqe, op);
+    io_uring_sqe_set_data(sqe, static_cast<io_uring_operation *>(op));
   }
 
-  void async_receive_from(buffer data, receive_handler handler) override {
-    auto *op = new receive_operation();
-    op->type = op_recv;
-    op->handler = std::move(handler);
+  template <typename Handler>
+  void async_receive_from(buffer data, Handler &&handler) {
+    receive_operation *op = acquire_slot(receive_ops_);
+    if (!op) {
+      handler(slots_busy_error(), size_t(0), endpoint{});
+      return;
+    }
+    op->handler.emplace(std::forward<Handler>(handler));
 
     io_uring_sqe *sqe = io_uring_get_sqe(ring_);
     if (!sqe) {
-      op->complete(-EBUSY);
+      op->complete(-EBUSY, 0);
       return;
     }
 
     // For UDP, we need to use recvmsg to get sender address
-    auto *recv_op = static_cast<receive_operation *>(op);
-    
-    // Setup iovec for the data buffer
-    recv_op->iov.iov_base = data.data();
-    recv_op->iov.iov_len = data.size();
-    
-    // Setup msghdr - must be done after iov is set up
-    memset(&recv_op->msg, 0, sizeof(recv_op->msg));
-    recv_op->msg.msg_name = &recv_op->addr;
-    recv_op->msg.msg_namelen = recv_op->addr_len;
-    recv_op->msg.msg_iov = &recv_op->iov;
-    recv_op->msg.msg_iovlen = 1;
+    op->prepare(data.data(), data.size());
+    io_uring_prep_recvmsg(sqe, fd_, &op->msg, 0);
+    io_uring_sqe_set_data(sqe, static_cast<io_uring_operation *>(op));
+  }
+
+#if defined(UDP_SKETCH_HAS_BUFFER_RING)
+  // Receive into a buffer chosen by the kernel from the event loop's buffer
+  // ring. The handler's signature is
+  //   void(std::error_code, const_buffer data, endpoint from)
+  // and the data is only valid until the handler returns.
+  template <typename Handler> void async_receive_from(Handler &&handler) {
+    receive_operation *op = acquire_slot(receive_ops_);
+    if (!op || !buffers_) {
+      handler(op ? std::make_error_code(std::errc::operation_not_supported)
+                 : slots_busy_error(),
+              const_buffer(), endpoint{});
+      return;
+    }
+    op->ring_handler.emplace(std::forward<Handler>(handler));
+    op->buffers = buffers_;
+
+    io_uring_sqe *sqe = io_uring_get_sqe(ring_);
+    if (!sqe) {
+      op->complete(-EBUSY, 0);
+      return;
+    }
 
-    // Use recvmsg to get sender address
-    io_uring_prep_recvmsg(sqe, fd_, &recv_op->msg, 0);
-    io_uring_sqe_set_data(sqe, op);
+    // With buffer selection the iovec supplies only the maximum length.
+    op->prepare(nullptr, buffers_->buffer_size());
+    io_uring_prep_recvmsg(sqe, fd_, &op->msg, 0);
+    sqe->flags |= IOSQE_BUFFER_SELECT;
+    sqe->buf_group = buffers_->group_id();
+    io_uring_sqe_set_data(sqe, static_cast<io_uring_operation *>(op));
   }
+#endif // defined(UDP_SKETCH_HAS_BUFFER_RING)
 
-  void close() override {
+  void close() {
     if (fd_ >= 0) {
       ::close(fd_);
       fd_ = -1;
@@ -413,22 +732,45 @@ public:
   }
 };
 
+using async_udp_socket = io_uring_udp_socket;
+
 // io_uring Event Loop
 class io_uring_event_loop {
   io_uring ring_;
   bool running_ = false;
+#if defined(UDP_SKETCH_HAS_BUFFER_RING)
+  std::unique_ptr<io_uring_buffer_ring> buffers_;
+#endif
 
 public:
   io_uring_event_loop(unsigned entries = 256) {
     if (io_uring_queue_init(entries, &ring_, 0) < 0) {
       throw std::system_error(errno, std::generic_category());
     }
+
+#if defined(UDP_SKETCH_HAS_BUFFER_RING)
+    // Receives without a buffer are optional, so a kernel without provided
+    // buffer rings still runs everything else.
+    try {
+      buffers_ = std::make_unique<io_uring_buffer_ring>(&ring_, 256, 2048);
+    } catch (const std::system_error &) {
+    }
+#endif
   }
 
-  ~io_uring_event_loop() { io_uring_queue_exit(&ring_); }
+  ~io_uring_event_loop() {
+#if defined(UDP_SKETCH_HAS_BUFFER_RING)
+    buffers_.reset();
+#endif
+    io_uring_queue_exit(&ring_);
+  }
 
   std::unique_ptr<async_udp_socket> create_udp_socket() {
+#if defined(UDP_SKETCH_HAS_BUFFER_RING)
+    return std::make_unique<io_uring_udp_socket>(&ring_, buffers_.get());
+#else
     return std::make_unique<io_uring_udp_socket>(&ring_);
+#endif
   }
 
   void run() {
@@ -444,14 +786,17 @@ public:
         continue;
       }
 
+      // Mark the CQE seen before the handler runs, since the handler may
+      // submit new operations.
+      auto *op = static_cast<io_uring_operation *>(io_uring_cqe_get_data(cqe));
+      int32_t result = cqe->res;
+      uint32_t flags = cqe->flags;
+      io_uring_cqe_seen(&ring_, cqe);
+
       // Process completion
-      auto *op = static_cast<io_uring_udp_socket::operation *>(
-          io_uring_cqe_get_data(cqe));
       if (op) {
-        op->complete(cqe->res);
+        op->complete(result, flags);
       }
-
-      io_uring_cqe_seen(&ring_, cqe);
     }
   }
 
@@ -461,6 +806,7 @@ public:
     io_uring_sqe *sqe = io_uring_get_sqe(&ring_);
     if (sqe) {
       io_uring_prep_nop(sqe);
+      io_uring_sqe_set_data(sqe, nullptr);
       io_uring_submit(&ring_);
     }
   }
@@ -472,7 +818,6 @@ public:
 // =============================================================================
 
 #include <fcntl.h>
-#include <map>
 #include <netinet/in.h>
 #include <sys/event.h>
 #include <sys/socket.h>
@@ -480,27 +825,89 @@ public:
 #include <sys/types.h>
 #include <unistd.h>
 
-class kqueue_udp_socket : public async_udp_socket {
+class kqueue_udp_socket {
 private:
   int fd_;
   int kq_;
 
-  // Operations pending on this socket
-  struct pending_ops {
-    std::unique_ptr<completion_handler> send_handler;
-    const_buffer send_buffer;
-    endpoint send_endpoint;
+  // Operations waiting for readiness. Each one records the order in which
+  // it was started, so operations are performed first-in, first-out.
+  struct send_operation {
+    handler_slot<send_signature> handler;
+    const_buffer data;
+    endpoint to;
+    uint64_t sequence = 0;
+
+    bool busy() const { return !handler.empty(); }
+  };
+
+  struct receive_operation {
+    handler_slot<receive_signature> handler;
+    buffer data;
+    uint64_t sequence = 0;
 
-    std::unique_ptr<receive_handler> recv_handler;
-    buffer recv_buffer;
+    bool busy() const { return !handler.empty(); }
   };
 
-  // Global map of fd -> operations (in real impl, would be in event loop)
-  static std::map<int, pending_ops> pending_operations_;
+  std::array<send_operation, max_pending_ops> send_ops_;
+  std::array<receive_operation, max_pending_ops> receive_ops_;
+  uint64_t next_sequence_ = 0;
+
+  template <typename Operation>
+  static Operation *oldest(std::array<Operation, max_pending_ops> &ops) {
+    Operation *result = nullptr;
+    for (auto &op : ops) {
+      if (op.busy() && (!result || op.sequence < result->sequence)) {
+        result = &op;
+      }
+    }
+    return result;
+  }
+
+  ssize_t send_to(const_buffer data, const endpoint &ep) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(ep.address);
+    addr.sin_port = htons(ep.port);
+
+    return sendto(fd_, data.data(), data.size(), 0, (sockaddr *)&addr,
+                  sizeof(addr));
+  }
+
+  ssize_t receive_from(buffer data, endpoint &ep) {
+    sockaddr_storage addr{};
+    socklen_t addr_len = sizeof(addr);
+
+    ssize_t result = recvfrom(fd_, data.data(), data.size(), 0,
+                              (sockaddr *)&addr, &addr_len);
+
+    ep = endpoint{};
+    if (result >= 0 && addr.ss_family == AF_INET) {
+      auto *sin = reinterpret_cast<sockaddr_in *>(&addr);
+      ep.address = ntohl(sin->sin_addr.s_addr);
+      ep.port = ntohs(sin->sin_port);
+    }
+    return result;
+  }
+
+  // Register interest in one filter. The socket itself is the event's
+  // udata, so no lookup is needed when the event fires.
+  bool watch(int16_t filter) {
+    struct kevent ev;
+    EV_SET(&ev, fd_, filter, EV_ADD | EV_ENABLE | EV_CLEAR, 0, 0, this);
+    return kevent(kq_, &ev, 1, NULL, 0, NULL) == 0;
+  }
+
+  void unwatch(int16_t filter) {
+    struct kevent ev;
+    EV_SET(&ev, fd_, filter, EV_DELETE, 0, 0, NULL);
+    kevent(kq_, &ev, 1, NULL, 0, NULL);
+  }
+
+  static bool would_block() { return errno == EAGAIN || errno == EWOULDBLOCK; }
 
 public:
   kqueue_udp_socket(int kq) : fd_(-1), kq_(kq) {
-    global_kq_ = kq; // Store for static method access
     fd_ = socket(AF_INET, SOCK_DGRAM, 0);
     if (fd_ < 0) {
       throw std::system_error(errno, std::generic_category());
@@ -516,7 +923,7 @@ public:
 
   ~kqueue_udp_socket() { close(); }
 
-  void bind(const endpoint &ep) override {
+  void bind(const endpoint &ep) {
     sockaddr_in addr{};
     addr.sin_family = AF_INET;
     addr.sin_addr.s_addr = htonl(ep.address);
@@ -527,85 +934,82 @@ public:
     }
   }
 
+  template <typename Handler>
   void async_send_to(const_buffer data, const endpoint &ep,
-                     completion_handler handler) override {
-    // Try immediate send
-    sockaddr_in addr{};
-    addr.sin_family = AF_INET;
-    addr.sin_addr.s_addr = htonl(ep.address);
-    addr.sin_port = htons(ep.port);
+                     Handler &&handler) {
+    // Try immediate send, unless earlier sends are still waiting
+    if (!oldest(send_ops_)) {
+      ssize_t result = send_to(data, ep);
 
-    ssize_t result = sendto(fd_, data.data(), data.size(), 0, (sockaddr *)&addr,
-                            sizeof(addr));
+      if (result >= 0) {
+        // Immediate completion
+        handler(std::error_code{}, size_t(result));
+        return;
+      }
 
-    if (result >= 0) {
-      // Immediate completion
-      handler(std::error_code{}, result);
-      return;
+      if (!would_block()) {
+        handler(std::error_code(errno, std::generic_category()), size_t(0));
+        return;
+      }
     }
 
-    if (errno != EAGAIN && errno != EWOULDBLOCK) {
-      handler(std::error_code(errno, std::generic_category()), 0);
+    // Register for write readiness
+    send_operation *op = acquire_slot(send_ops_);
+    if (!op) {
+      handler(slots_busy_error(), size_t(0));
       return;
     }
 
-    // Register for write readiness
-    auto &ops = pending_operations_[fd_];
-    ops.send_handler = std::make_unique<completion_handler>(std::move(handler));
-    ops.send_buffer = data;
-    ops.send_endpoint = ep;
-
-    struct kevent ev;
-    EV_SET(&ev, fd_, EVFILT_WRITE, EV_ADD | EV_ENABLE | EV_CLEAR, 0, 0,
-           (void *)(intptr_t)fd_);
-    if (kevent(kq_, &ev, 1, NULL, 0, NULL) < 0) {
-      ops.send_handler->operator()(
-          std::error_code(errno, std::generic_category()), 0);
-      ops.send_handler.reset();
+    if (!watch(EVFILT_WRITE)) {
+      handler(std::error_code(errno, std::generic_category()), size_t(0));
+      return;
     }
+
+    op->handler.emplace(std::forward<Handler>(handler));
+    op->data = data;
+    op->to = ep;
+    op->sequence = next_sequence_++;
   }
 
-  void async_receive_from(buffer data, receive_handler handler) override {
-    // Try immediate receive
-    sockaddr_storage addr{};
-    socklen_t addr_len = sizeof(addr);
+  template <typename Handler>
+  void async_receive_from(buffer data, Handler &&handler) {
+    // Try immediate receive, unless earlier receives are still waiting
+    if (!oldest(receive_ops_)) {
+      endpoint ep;
+      ssize_t result = receive_from(data, ep);
 
-    ssize_t result = recvfrom(fd_, data.data(), data.size(), 0,
-                              (sockaddr *)&addr, &addr_len);
+      if (result >= 0) {
+        // Immediate completion
+        handler(std::error_code{}, size_t(result), ep);
+        return;
+      }
 
-    if (result >= 0) {
-      // Immediate completion
-      endpoint ep{};
-      if (addr.ss_family == AF_INET) {
-        auto *sin = reinterpret_cast<sockaddr_in *>(&addr);
-        ep.address = ntohl(sin->sin_addr.s_addr);
-        ep.port = ntohs(sin->sin_port);
+      if (!would_block()) {
+        handler(std::error_code(errno, std::generic_category()), size_t(0),
+                endpoint{});
+        return;
       }
-      handler(std::error_code{}, result, ep);
-      return;
     }
 
-    if (errno != EAGAIN && errno != EWOULDBLOCK) {
-      handler(std::error_code(errno, std::generic_category()), 0, endpoint{});
+    // Register for read readiness
+    receive_operation *op = acquire_slot(receive_ops_);
+    if (!op) {
+      handler(slots_busy_error(), size_t(0), endpoint{});
       return;
     }
 
-    // Register for read readiness
-    auto &ops = pending_operations_[fd_];
-    ops.recv_handler = std::make_unique<receive_handler>(std::move(handler));
-    ops.recv_buffer = data;
-
-    struct kevent ev;
-    EV_SET(&ev, fd_, EVFILT_READ, EV_ADD | EV_ENABLE | EV_CLEAR, 0, 0,
-           (void *)(intptr_t)fd_);
-    if (kevent(kq_, &ev, 1, NULL, 0, NULL) < 0) {
-      ops.recv_handler->operator()(
-          std::error_code(errno, std::generic_category()), 0, endpoint{});
-      ops.recv_handler.reset();
+    if (!watch(EVFILT_READ)) {
+      handler(std::error_code(errno, std::generic_category()), size_t(0),
+              endpoint{});
+      return;
     }
+
+    op->handler.emplace(std::forward<Handler>(handler));
+    op->data = data;
+    op->sequence = next_sequence_++;
   }
 
-  void close() override {
+  void close() {
     if (fd_ >= 0) {
       // Remove from kqueue
       struct kevent ev[2];
@@ -614,86 +1018,65 @@ public:
       kevent(kq_, ev, 2, NULL, 0, NULL);
 
       // Clean up pending operations
-      pending_operations_.erase(fd_);
+      for (auto &op : send_ops_) {
+        op.handler.reset();
+      }
+      for (auto &op : receive_ops_) {
+        op.handler.reset();
+      }
 
       ::close(fd_);
       fd_ = -1;
     }
   }
 
-  // Need to store kqueue descriptor for handle_ready
-  static int global_kq_;
-
-  // Called by event loop when fd is ready
-  static void handle_ready(int fd, int16_t filter) {
-    auto it = pending_operations_.find(fd);
-    if (it == pending_operations_.end()) {
-      return;
-    }
-
-    auto &ops = it->second;
-
-    if (filter == EVFILT_WRITE && ops.send_handler) {
-      // Perform the send
-      sockaddr_in addr{};
-      addr.sin_family = AF_INET;
-      addr.sin_addr.s_addr = htonl(ops.send_endpoint.address);
-      addr.sin_port = htons(ops.send_endpoint.port);
-
-      ssize_t result =
-          sendto(fd, ops.send_buffer.data(), ops.send_buffer.size(), 0,
-                 (sockaddr *)&addr, sizeof(addr));
+  // Called by event loop when the socket is ready. Performs waiting
+  // operations in order until one would block.
+  void handle_ready(int16_t filter) {
+    if (filter == EVFILT_WRITE) {
+      while (send_operation *op = oldest(send_ops_)) {
+        // Perform the send
+        ssize_t result = send_to(op->data, op->to);
+        if (result < 0 && would_block()) {
+          return;
+        }
 
-      if (result >= 0) {
-        (*ops.send_handler)(std::error_code{}, result);
-      } else {
-        (*ops.send_handler)(std::error_code(errno, std::generic_category()), 0);
+        if (result >= 0) {
+          op->handler.complete(std::error_code{}, size_t(result));
+        } else {
+          op->handler.complete(std::error_code(errno, std::generic_category()),
+                               size_t(0));
+        }
       }
 
-      ops.send_handler.reset();
-
       // Remove write interest
-      struct kevent ev;
-      EV_SET(&ev, fd, EVFILT_WRITE, EV_DELETE, 0, 0, NULL);
-      kevent(global_kq_, &ev, 1, NULL, 0, NULL);
+      unwatch(EVFILT_WRITE);
     }
 
-    if (filter == EVFILT_READ && ops.recv_handler) {
-      // Perform the receive
-      sockaddr_storage addr{};
-      socklen_t addr_len = sizeof(addr);
-
-      ssize_t result =
-          recvfrom(fd, ops.recv_buffer.data(), ops.recv_buffer.size(), 0,
-                   (sockaddr *)&addr, &addr_len);
-
-      endpoint ep{};
-      if (result >= 0 && addr.ss_family == AF_INET) {
-        auto *sin = reinterpret_cast<sockaddr_in *>(&addr);
-        ep.address = ntohl(sin->sin_addr.s_addr);
-        ep.port = ntohs(sin->sin_port);
-      }
+    if (filter == EVFILT_READ) {
+      while (receive_operation *op = oldest(receive_ops_)) {
+        // Perform the receive
+        endpoint ep;
+        ssize_t result = receive_from(op->data, ep);
+        if (result < 0 && would_block()) {
+          return;
+        }
 
-      if (result >= 0) {
-        (*ops.recv_handler)(std::error_code{}, result, ep);
-      } else {
-        (*ops.recv_handler)(std::error_code(errno, std::generic_category()), 0,
-                            ep);
+        if (result >= 0) {
+          op->handler.complete(std::error_code{}, size_t(result), ep);
+        } else {
+          op->handler.complete(std::error_code(errno, std::generic_category()),
+                               size_t(0), ep);
+        }
       }
 
-      ops.recv_handler.reset();
-
       // Remove read interest
-      struct kevent ev;
-      EV_SET(&ev, fd, EVFILT_READ, EV_DELETE, 0, 0, NULL);
-      kevent(global_kq_, &ev, 1, NULL, 0, NULL);
+      unwatch(EVFILT_READ);
     }
   }
 };
 
-std::map<int, kqueue_udp_socket::pending_ops>
-    kqueue_udp_socket::pending_operations_;
-int kqueue_udp_socket::global_kq_ = -1;
+using async_udp_socket = kqueue_udp_socket;
 
 // kqueue Event Loop
 class kqueue_event_loop {
@@ -728,8 +1111,10 @@ public:
       }
 
       for (int i = 0; i < nev; ++i) {
-        int fd = (int)(intptr_t)events[i].udata;
-        kqueue_udp_socket::handle_ready(fd, events[i].filter);
+        auto *socket = static_cast<kqueue_udp_socket *>(events[i].udata);
+        if (socket) {
+          socket->handle_ready(events[i].filter);
+        }
       }
     }
   }
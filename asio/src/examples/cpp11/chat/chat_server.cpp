@@ -22,7 +22,7 @@ using asio::ip::tcp;
 
 //----------------------------------------------------------------------
 
-typedef std::deque<chat_message> chat_message_queue;
+typedef std::deque<asio::shared_const_buffer> chat_buffer_queue;
 
 //----------------------------------------------------------------------
 
@@ -30,7 +30,7 @@ class chat_participant
 {
 public:
   virtual ~chat_participant() {}
-  virtual void deliver(const chat_message& msg) = 0;
+  virtual void deliver(const asio::shared_const_buffer& msg) = 0;
 };
 
 typedef std::shared_ptr<chat_participant> chat_participant_ptr;
@@ -43,7 +43,7 @@ public:
   void join(chat_participant_ptr participant)
   {
     participants_.insert(participant);
-    for (auto msg: recent_msgs_)
+    for (auto& msg: recent_msgs_)
       participant->deliver(msg);
   }
 
@@ -54,18 +54,21 @@ public:
 
   void deliver(const chat_message& msg)
   {
-    recent_msgs_.push_back(msg);
+    // The encoded message is copied once, and shared by every participant.
+    asio::shared_const_buffer buffer(msg.data(), msg.length());
+
+    recent_msgs_.push_back(buffer);
     while (recent_msgs_.size() > max_recent_msgs)
       recent_msgs_.pop_front();
 
     for (auto participant: participants_)
-      participant->deliver(msg);
+      participant->deliver(buffer);
   }
 
 private:
   std::set<chat_participant_ptr> participants_;
   enum { max_recent_msgs = 100 };
-  chat_message_queue recent_msgs_;
+  chat_buffer_queue recent_msgs_;
 };
 
 //----------------------------------------------------------------------
@@ -87,7 +90,7 @@ public:
     do_read_header();
   }
 
-  void deliver(const chat_message& msg)
+  void deliver(const asio::shared_const_buffer& msg)
   {
     bool write_in_progress = !write_msgs_.empty();
     write_msgs_.push_back(msg);
@@ -138,9 +141,7 @@ private:
   void do_write()
   {
     auto self(shared_from_this());
-    asio::async_write(socket_,
-        asio::buffer(write_msgs_.front().data(),
-          write_msgs_.front().length()),
+    asio::async_write(socket_, write_msgs_.front(),
         [this, self](std::error_code ec, std::size_t /*length*/)
         {
           if (!ec)
@@ -161,7 +162,7 @@ private:
   tcp::socket socket_;
   chat_room& room_;
   chat_message read_msg_;
-  chat_message_queue write_msgs_;
+  chat_buffer_queue write_msgs_;
 };
 
 //----------------------------------------------------------------------
@@ -9,6 +9,7 @@
 //
 
 #include "connection.hpp"
+#include <cstring>
 #include <utility>
 #include "connection_manager.hpp"
 #include "request_handler.hpp"
@@ -16,11 +17,22 @@
 namespace http {
 namespace server {
 
+namespace {
+
+/// How long a connection may wait for a request before it is closed.
+const std::chrono::seconds idle_timeout(30);
+
+} // namespace
+
 connection::connection(asio::ip::tcp::socket socket,
     connection_manager& manager, request_handler& handler)
   : socket_(std::move(socket)),
     connection_manager_(manager),
-    request_handler_(handler)
+    request_handler_(handler),
+    buffer_size_(0),
+    request_size_(0),
+    keep_alive_(false),
+    idle_timer_(socket_.get_executor())
 {
 }
 
@@ -31,35 +43,73 @@ void connection::start()
 
 void connection::stop()
 {
+  idle_timer_.cancel();
   socket_.close();
 }
 
+void connection::handle_data()
+{
+  request_parser::result_type result;
+  const char* request_end;
+  std::tie(result, request_end) = request_parser_.parse(
+      request_, buffer_.data(), buffer_.data() + buffer_size_);
+
+  // A request that does not fit in the buffer is rejected.
+  if (result == request_parser::indeterminate
+      && buffer_size_ == buffer_.size())
+    result = request_parser::bad;
+
+  // The reply object is reused for each request on the connection.
+  if (result != request_parser::indeterminate)
+    reply_ = reply();
+
+  if (result == request_parser::good)
+  {
+    request_size_ = request_end - buffer_.data();
+    keep_alive_ = request_.keep_alive();
+    request_handler_.handle_request(request_, reply_);
+    reply_.headers.push_back(
+        header{"Connection", keep_alive_ ? "keep-alive" : "close"});
+    do_write();
+  }
+  else if (result == request_parser::bad)
+  {
+    keep_alive_ = false;
+    reply_.set_stock_reply(reply::bad_request);
+    reply_.headers.push_back(header{"Connection", "close"});
+    do_write();
+  }
+  else
+  {
+    do_read();
+  }
+}
+
 void connection::do_read()
 {
   auto self(shared_from_this());
-  socket_.async_read_some(asio::buffer(buffer_),
+  idle_timer_.expires_after(idle_timeout);
+  idle_timer_.async_wait(
+      [this, self](std::error_code ec)
+      {
+        // The timer may have been moved on after this handler was queued, so
+        // check that the deadline has really passed.
+        if (!ec && idle_timer_.expiry() <= idle_timer::clock_type::now())
+        {
+          connection_manager_.stop(shared_from_this());
+        }
+      });
+
+  socket_.async_read_some(
+      asio::buffer(buffer_.data() + buffer_size_,
+        buffer_.size() - buffer_size_),
       [this, self](std::error_code ec, std::size_t bytes_transferred)
       {
         if (!ec)
         {
-          request_parser::result_type result;
-          std::tie(result, std::ignore) = request_parser_.parse(
-              request_, buffer_.data(), buffer_.data() + bytes_transferred);
-
-          if (result == request_parser::good)
-          {
-            request_handler_.handle_request(request_, reply_);
-            do_write();
-          }
-          else if (result == request_parser::bad)
-          {
-            reply_ = reply::stock_reply(reply::bad_request);
-            do_write();
-          }
-          else
-          {
-            do_read();
-          }
+          idle_timer_.expires_at(idle_timer::time_point::max());
+          buffer_size_ += bytes_transferred;
+          handle_data();
         }
         else if (ec != asio::error::operation_aborted)
         {
@@ -74,6 +124,18 @@ void connection::do_write()
   asio::async_write(socket_, reply_.to_buffers(),
       [this, self](std::error_code ec, std::size_t)
       {
+        if (!ec && keep_alive_)
+        {
+          // Discard the request and handle any pipelined requests that
+          // follow it. Responses are sent in the order the requests arrived.
+          buffer_size_ -= request_size_;
+          std::memmove(buffer_.data(),
+              buffer_.data() + request_size_, buffer_size_);
+          request_parser_.reset();
+          handle_data();
+          return;
+        }
+
         if (!ec)
         {
           // Initiate graceful connection closure.
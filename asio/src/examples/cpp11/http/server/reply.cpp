@@ -9,6 +9,7 @@
 //
 
 #include "reply.hpp"
+#include <cstddef>
 #include <string>
 
 namespace http {
@@ -16,77 +17,83 @@ namespace server {
 
 namespace status_strings {
 
-const std::string ok =
+const char ok[] =
   "HTTP/1.0 200 OK\r\n";
-const std::string created =
+const char created[] =
   "HTTP/1.0 201 Created\r\n";
-const std::string accepted =
+const char accepted[] =
   "HTTP/1.0 202 Accepted\r\n";
-const std::string no_content =
+const char no_content[] =
   "HTTP/1.0 204 No Content\r\n";
-const std::string multiple_choices =
+const char multiple_choices[] =
   "HTTP/1.0 300 Multiple Choices\r\n";
-const std::string moved_permanently =
+const char moved_permanently[] =
   "HTTP/1.0 301 Moved Permanently\r\n";
-const std::string moved_temporarily =
+const char moved_temporarily[] =
   "HTTP/1.0 302 Moved Temporarily\r\n";
-const std::string not_modified =
+const char not_modified[] =
   "HTTP/1.0 304 Not Modified\r\n";
-const std::string bad_request =
+const char bad_request[] =
   "HTTP/1.0 400 Bad Request\r\n";
-const std::string unauthorized =
+const char unauthorized[] =
   "HTTP/1.0 401 Unauthorized\r\n";
-const std::string forbidden =
+const char forbidden[] =
   "HTTP/1.0 403 Forbidden\r\n";
-const std::string not_found =
+const char not_found[] =
   "HTTP/1.0 404 Not Found\r\n";
-const std::string internal_server_error =
+const char internal_server_error[] =
   "HTTP/1.0 500 Internal Server Error\r\n";
-const std::string not_implemented =
+const char not_implemented[] =
   "HTTP/1.0 501 Not Implemented\r\n";
-const std::string bad_gateway =
+const char bad_gateway[] =
   "HTTP/1.0 502 Bad Gateway\r\n";
-const std::string service_unavailable =
+const char service_unavailable[] =
   "HTTP/1.0 503 Service Unavailable\r\n";
 
+template <std::size_t N>
+asio::const_buffer to_buffer(const char (&s)[N])
+{
+  return asio::buffer(s, N - 1);
+}
+
 asio::const_buffer to_buffer(reply::status_type status)
 {
   switch (status)
   {
   case reply::ok:
-    return asio::buffer(ok);
+    return to_buffer(ok);
   case reply::created:
-    return asio::buffer(created);
+    return to_buffer(created);
   case reply::accepted:
-    return asio::buffer(accepted);
+    return to_buffer(accepted);
   case reply::no_content:
-    return asio::buffer(no_content);
+    return to_buffer(no_content);
   case reply::multiple_choices:
-    return asio::buffer(multiple_choices);
+    return to_buffer(multiple_choices);
   case reply::moved_permanently:
-    return asio::buffer(moved_permanently);
+    return to_buffer(moved_permanently);
   case reply::moved_temporarily:
-    return asio::buffer(moved_temporarily);
+    return to_buffer(moved_temporarily);
   case reply::not_modified:
-    return asio::buffer(not_modified);
+    return to_buffer(not_modified);
   case reply::bad_request:
-    return asio::buffer(bad_request);
+    return to_buffer(bad_request);
   case reply::unauthorized:
-    return asio::buffer(unauthorized);
+    return to_buffer(unauthorized);
   case reply::forbidden:
-    return asio::buffer(forbidden);
+    return to_buffer(forbidden);
   case reply::not_found:
-    return asio::buffer(not_found);
+    return to_buffer(not_found);
   case reply::internal_server_error:
-    return asio::buffer(internal_server_error);
+    return to_buffer(internal_server_error);
   case reply::not_implemented:
-    return asio::buffer(not_implemented);
+    return to_buffer(not_implemented);
   case reply::bad_gateway:
-    return asio::buffer(bad_gateway);
+    return to_buffer(bad_gateway);
   case reply::service_unavailable:
-    return asio::buffer(service_unavailable);
+    return to_buffer(service_unavailable);
   default:
-    return asio::buffer(internal_server_error);
+    return to_buffer(internal_server_error);
   }
 }
 
@@ -99,21 +106,25 @@ const char crlf[] = { '\r', '\n' };
 
 } // namespace misc_strings
 
-std::vector<asio::const_buffer> reply::to_buffers()
+const std::vector<asio::const_buffer>& reply::to_buffers()
 {
-  std::vector<asio::const_buffer> buffers;
-  buffers.push_back(status_strings::to_buffer(status));
+  header_data_.clear();
   for (std::size_t i = 0; i < headers.size(); ++i)
   {
     header& h = headers[i];
-    buffers.push_back(asio::buffer(h.name));
-    buffers.push_back(asio::buffer(misc_strings::name_value_separator));
-    buffers.push_back(asio::buffer(h.value));
-    buffers.push_back(asio::buffer(misc_strings::crlf));
+    header_data_.append(h.name);
+    header_data_.append(misc_strings::name_value_separator,
+        sizeof(misc_strings::name_value_separator));
+    header_data_.append(h.value);
+    header_data_.append(misc_strings::crlf, sizeof(misc_strings::crlf));
   }
-  buffers.push_back(asio::buffer(misc_strings::crlf));
-  buffers.push_back(asio::buffer(content));
-  return buffers;
+  header_data_.append(misc_strings::crlf, sizeof(misc_strings::crlf));
+
+  buffers_.clear();
+  buffers_.push_back(status_strings::to_buffer(status));
+  buffers_.push_back(asio::buffer(header_data_));
+  buffers_.push_back(asio::buffer(content));
+  return buffers_;
 }
 
 namespace stock_replies {
@@ -195,60 +206,66 @@ const char service_unavailable[] =
   "<body><h1>503 Service Unavailable</h1></body>"
   "</html>";
 
-std::string to_string(reply::status_type status)
+template <std::size_t N>
+asio::const_buffer to_buffer(const char (&s)[N])
+{
+  return asio::buffer(s, N - 1);
+}
+
+asio::const_buffer to_buffer(reply::status_type status)
 {
   switch (status)
   {
   case reply::ok:
-    return ok;
+    return to_buffer(ok);
   case reply::created:
-    return created;
+    return to_buffer(created);
   case reply::accepted:
-    return accepted;
+    return to_buffer(accepted);
   case reply::no_content:
-    return no_content;
+    return to_buffer(no_content);
   case reply::multiple_choices:
-    return multiple_choices;
+    return to_buffer(multiple_choices);
   case reply::moved_permanently:
-    return moved_permanently;
+    return to_buffer(moved_permanently);
   case reply::moved_temporarily:
-    return moved_temporarily;
+    return to_buffer(moved_temporarily);
   case reply::not_modified:
-    return not_modified;
+    return to_buffer(not_modified);
   case reply::bad_request:
-    return bad_request;
+    return to_buffer(bad_request);
   case reply::unauthorized:
-    return unauthorized;
+    return to_buffer(unauthorized);
   case reply::forbidden:
-    return forbidden;
+    return to_buffer(forbidden);
   case reply::not_found:
-    return not_found;
+    return to_buffer(not_found);
   case reply::internal_server_error:
-    return internal_server_error;
+    return to_buffer(internal_server_error);
   case reply::not_implemented:
-    return not_implemented;
+    return to_buffer(not_implemented);
   case reply::bad_gateway:
-    return bad_gateway;
+    return to_buffer(bad_gateway);
   case reply::service_unavailable:
-    return service_unavailable;
+    return to_buffer(service_unavailable);
   default:
-    return internal_server_error;
+    return to_buffer(internal_server_error);
   }
 }
 
 } // namespace stock_replies
 
-reply reply::stock_reply(reply::status_type status)
+void reply::set_stock_reply(reply::status_type status)
 {
-  reply rep;
-  rep.status = status;
-  rep.content = stock_replies::to_string(status);
-  rep.headers.resize(2);
-  rep.headers[0].name = "Content-Length";
-  rep.headers[0].value = std::to_string(rep.content.size());
-  rep.headers[1].name = "Content-Type";
-  rep.headers[1].value = "text/html";
-  return rep;
+  asio::const_buffer stock_content = stock_replies::to_buffer(status);
+  this->status = status;
+  content.assign(static_cast<const char*>(stock_content.data()),
+      stock_content.size());
+  headers.resize(2);
+  headers[0].name = "Content-Length";
+  headers[0].value = std::to_string(content.size());
+  headers[1].name = "Content-Type";
+  headers[1].value = "text/html";
 }
 
 } // namespace server
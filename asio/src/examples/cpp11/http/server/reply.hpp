@@ -51,11 +51,20 @@ struct reply
 
   /// Convert the reply into a vector of buffers. The buffers do not own the
   /// underlying memory blocks, therefore the reply object must remain valid and
-  /// not be changed until the write operation has completed.
-  std::vector<asio::const_buffer> to_buffers();
+  /// not be changed until the write operation has completed. The headers are
+  /// serialised into a single block, and the storage for the block and the
+  /// vector is reused by later calls.
+  const std::vector<asio::const_buffer>& to_buffers();
 
-  /// Get a stock reply.
-  static reply stock_reply(status_type status);
+  /// Turn the reply into a stock reply, reusing the reply's storage.
+  void set_stock_reply(status_type status);
+
+private:
+  /// The serialised headers.
+  std::string header_data_;
+
+  /// The buffers returned by to_buffers().
+  std::vector<asio::const_buffer> buffers_;
 };
 
 } // namespace server
@@ -11,21 +11,68 @@
 #ifndef HTTP_REQUEST_HPP
 #define HTTP_REQUEST_HPP
 
-#include <string>
+#include <cctype>
+#include <cstddef>
 #include <vector>
-#include "header.hpp"
 
 namespace http {
 namespace server {
 
-/// A request received from a client.
+/// A sequence of characters in the buffer from which a request was parsed.
+struct string_ref
+{
+  const char* data;
+  std::size_t size;
+};
+
+/// A header received from a client.
+struct request_header
+{
+  string_ref name;
+  string_ref value;
+};
+
+/// A request received from a client. The strings refer to the buffer from
+/// which the request was parsed.
 struct request
 {
-  std::string method;
-  std::string uri;
+  string_ref method;
+  string_ref uri;
   int http_version_major;
   int http_version_minor;
-  std::vector<header> headers;
+  std::vector<request_header> headers;
+
+  /// Determine whether the client wants the connection to remain open after
+  /// the reply has been sent. HTTP/1.1 connections are persistent unless the
+  /// client sends "Connection: close", while HTTP/1.0 clients must ask for a
+  /// persistent connection with "Connection: keep-alive".
+  bool keep_alive() const
+  {
+    bool persistent = http_version_major > 1
+      || (http_version_major == 1 && http_version_minor >= 1);
+    for (std::size_t i = 0; i < headers.size(); ++i)
+    {
+      if (equals_ignore_case(headers[i].name, "Connection"))
+      {
+        if (equals_ignore_case(headers[i].value, "close"))
+          persistent = false;
+        else if (equals_ignore_case(headers[i].value, "keep-alive"))
+          persistent = true;
+      }
+    }
+    return persistent;
+  }
+
+private:
+  static bool equals_ignore_case(const string_ref& a, const char* b)
+  {
+    std::size_t i = 0;
+    for (; i < a.size && b[i]; ++i)
+      if (std::tolower(static_cast<unsigned char>(a.data[i]))
+          != std::tolower(static_cast<unsigned char>(b[i])))
+        return false;
+    return i == a.size && !b[i];
+  }
 };
 
 } // namespace server
@@ -9,16 +9,28 @@
 //
 
 #include "connection.hpp"
+#include <cstring>
 #include <utility>
 #include "request_handler.hpp"
 
 namespace http {
 namespace server2 {
 
+namespace {
+
+/// How long a connection may wait for a request before it is closed.
+const std::chrono::seconds idle_timeout(30);
+
+} // namespace
+
 connection::connection(asio::ip::tcp::socket socket,
     request_handler& handler)
   : socket_(std::move(socket)),
-    request_handler_(handler)
+    request_handler_(handler),
+    buffer_size_(0),
+    request_size_(0),
+    keep_alive_(false),
+    idle_timer_(socket_.get_executor())
 {
 }
 
@@ -27,32 +39,72 @@ void connection::start()
   do_read();
 }
 
+void connection::handle_data()
+{
+  request_parser::result_type result;
+  const char* request_end;
+  std::tie(result, request_end) = request_parser_.parse(
+      request_, buffer_.data(), buffer_.data() + buffer_size_);
+
+  // A request that does not fit in the buffer is rejected.
+  if (result == request_parser::indeterminate
+      && buffer_size_ == buffer_.size())
+    result = request_parser::bad;
+
+  // The reply object is reused for each request on the connection.
+  if (result != request_parser::indeterminate)
+    reply_ = reply();
+
+  if (result == request_parser::good)
+  {
+    request_size_ = request_end - buffer_.data();
+    keep_alive_ = request_.keep_alive();
+    request_handler_.handle_request(request_, reply_);
+    reply_.headers.push_back(
+        header{"Connection", keep_alive_ ? "keep-alive" : "close"});
+    do_write();
+  }
+  else if (result == request_parser::bad)
+  {
+    keep_alive_ = false;
+    reply_.set_stock_reply(reply::bad_request);
+    reply_.headers.push_back(header{"Connection", "close"});
+    do_write();
+  }
+  else
+  {
+    do_read();
+  }
+}
+
 void connection::do_read()
 {
   auto self(shared_from_this());
-  socket_.async_read_some(asio::buffer(buffer_),
+  idle_timer_.expires_after(idle_timeout);
+  idle_timer_.async_wait(
+      [this, self](std::error_code ec)
+      {
+        // The timer may have been moved on after this handler was queued, so
+        // check that the deadline has really passed. Closing the socket
+        // makes the pending read fail.
+        if (!ec && idle_timer_.expiry() <= idle_timer::clock_type::now())
+        {
+          std::error_code ignored_ec;
+          socket_.close(ignored_ec);
+        }
+      });
+
+  socket_.async_read_some(
+      asio::buffer(buffer_.data() + buffer_size_,
+        buffer_.size() - buffer_size_),
       [this, self](std::error_code ec, std::size_t bytes_transferred)
       {
+        idle_timer_.expires_at(idle_timer::time_point::max());
+
         if (!ec)
         {
-          request_parser::result_type result;
-          std::tie(result, std::ignore) = request_parser_.parse(
-              request_, buffer_.data(), buffer_.data() + bytes_transferred);
-
-          if (result == request_parser::good)
-          {
-            request_handler_.handle_request(request_, reply_);
-            do_write();
-          }
-          else if (result == request_parser::bad)
-          {
-            reply_ = reply::stock_reply(reply::bad_request);
-            do_write();
-          }
-          else
-          {
-            do_read();
-          }
+          buffer_size_ += bytes_transferred;
+          handle_data();
         }
 
         // If an error occurs then no new asynchronous operations are
@@ -69,6 +121,18 @@ void connection::do_write()
   asio::async_write(socket_, reply_.to_buffers(),
       [this, self](std::error_code ec, std::size_t)
       {
+        if (!ec && keep_alive_)
+        {
+          // Discard the request and handle any pipelined requests that
+          // follow it. Responses are sent in the order the requests arrived.
+          buffer_size_ -= request_size_;
+          std::memmove(buffer_.data(),
+              buffer_.data() + request_size_, buffer_size_);
+          request_parser_.reset();
+          handle_data();
+          return;
+        }
+
         if (!ec)
         {
           // Initiate graceful connection closure.
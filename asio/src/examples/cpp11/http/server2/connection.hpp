@@ -13,6 +13,7 @@
 
 #include <asio.hpp>
 #include <array>
+#include <chrono>
 #include <memory>
 #include "reply.hpp"
 #include "request.hpp"
@@ -22,6 +23,11 @@
 namespace http {
 namespace server2 {
 
+/// Timer type used to close idle connections. Idle timers are rescheduled on
+/// every request, so they are kept in a timer wheel.
+typedef asio::basic_waitable_timer<std::chrono::steady_clock,
+    asio::timer_wheel_traits<std::chrono::steady_clock>> idle_timer;
+
 /// Represents a single connection from a client.
 class connection
   : public std::enable_shared_from_this<connection>
@@ -38,6 +44,10 @@ public:
   void start();
 
 private:
+  /// Handle the data received so far, which may hold several pipelined
+  /// requests.
+  void handle_data();
+
   /// Perform an asynchronous read operation.
   void do_read();
 
@@ -50,9 +60,13 @@ private:
   /// The handler used to process the incoming request.
   request_handler& request_handler_;
 
-  /// Buffer for incoming data.
+  /// Buffer for incoming data. The request is parsed in place, so the buffer
+  /// must hold the whole request.
   std::array<char, 8192> buffer_;
 
+  /// The number of bytes of incoming data held in the buffer.
+  std::size_t buffer_size_;
+
   /// The incoming request.
   request request_;
 
@@ -61,6 +75,15 @@ private:
 
   /// The reply to be sent back to the client.
   reply reply_;
+
+  /// The number of bytes of the buffer used by the current request.
+  std::size_t request_size_;
+
+  /// Whether the connection remains open after the reply has been sent.
+  bool keep_alive_;
+
+  /// Timer used to close the connection when no request arrives.
+  idle_timer idle_timer_;
 };
 
 typedef std::shared_ptr<connection> connection_ptr;
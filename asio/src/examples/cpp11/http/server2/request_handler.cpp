@@ -30,7 +30,7 @@ void request_handler::handle_request(const request& req, reply& rep)
   std::string request_path;
   if (!url_decode(req.uri, request_path))
   {
-    rep = reply::stock_reply(reply::bad_request);
+    rep.set_stock_reply(reply::bad_request);
     return;
   }
 
@@ -38,7 +38,7 @@ void request_handler::handle_request(const request& req, reply& rep)
   if (request_path.empty() || request_path[0] != '/'
       || request_path.find("..") != std::string::npos)
   {
-    rep = reply::stock_reply(reply::bad_request);
+    rep.set_stock_reply(reply::bad_request);
     return;
   }
 
@@ -62,7 +62,7 @@ void request_handler::handle_request(const request& req, reply& rep)
   std::ifstream is(full_path.c_str(), std::ios::in | std::ios::binary);
   if (!is)
   {
-    rep = reply::stock_reply(reply::not_found);
+    rep.set_stock_reply(reply::not_found);
     return;
   }
 
@@ -78,18 +78,18 @@ void request_handler::handle_request(const request& req, reply& rep)
   rep.headers[1].value = mime_types::extension_to_type(extension);
 }
 
-bool request_handler::url_decode(const std::string& in, std::string& out)
+bool request_handler::url_decode(const string_ref& in, std::string& out)
 {
   out.clear();
-  out.reserve(in.size());
-  for (std::size_t i = 0; i < in.size(); ++i)
+  out.reserve(in.size);
+  for (std::size_t i = 0; i < in.size; ++i)
   {
-    if (in[i] == '%')
+    if (in.data[i] == '%')
     {
-      if (i + 3 <= in.size())
+      if (i + 3 <= in.size)
       {
         int value = 0;
-        std::istringstream is(in.substr(i + 1, 2));
+        std::istringstream is(std::string(in.data + i + 1, 2));
         if (is >> std::hex >> value)
         {
           out += static_cast<char>(value);
@@ -105,13 +105,13 @@ bool request_handler::url_decode(const std::string& in, std::string& out)
         return false;
       }
     }
-    else if (in[i] == '+')
+    else if (in.data[i] == '+')
     {
       out += ' ';
     }
     else
     {
-      out += in[i];
+      out += in.data[i];
     }
   }
   return true;
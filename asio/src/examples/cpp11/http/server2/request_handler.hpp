@@ -12,12 +12,12 @@
 #define HTTP_SERVER2_REQUEST_HANDLER_HPP
 
 #include <string>
+#include "request.hpp"
 
 namespace http {
 namespace server2 {
 
 struct reply;
-struct request;
 
 /// The common handler for all incoming requests.
 class request_handler
@@ -38,7 +38,7 @@ private:
 
   /// Perform URL-decoding on a string. Returns false if the encoding was
   /// invalid.
-  static bool url_decode(const std::string& in, std::string& out);
+  static bool url_decode(const string_ref& in, std::string& out);
 };
 
 } // namespace server2
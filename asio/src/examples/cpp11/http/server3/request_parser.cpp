@@ -9,290 +9,146 @@
 //
 
 #include "request_parser.hpp"
+#include <cstring>
 #include "request.hpp"
 
 namespace http {
 namespace server3 {
 
 request_parser::request_parser()
-  : state_(method_start)
+  : state_(request_line),
+    line_start_(0),
+    scan_pos_(0)
 {
 }
 
 void request_parser::reset()
 {
-  state_ = method_start;
+  state_ = request_line;
+  line_start_ = 0;
+  scan_pos_ = 0;
 }
 
-request_parser::result_type request_parser::consume(request& req, char input)
+std::tuple<request_parser::result_type, const char*> request_parser::parse(
+    request& req, const char* begin, const char* end)
 {
-  switch (state_)
+  for (;;)
   {
-  case method_start:
-    if (!is_char(input) || is_ctl(input) || is_tspecial(input))
+    // Find the end of the current line. The search uses memchr, which is
+    // typically vectorised, rather than examining one character at a time.
+    const char* scan = begin + scan_pos_;
+    const void* newline = std::memchr(scan, '\n', end - scan);
+    if (!newline)
     {
-      return bad;
-    }
-    else
-    {
-      state_ = method;
-      req.method.push_back(input);
-      return indeterminate;
-    }
-  case method:
-    if (input == ' ')
-    {
-      state_ = uri;
-      return indeterminate;
-    }
-    else if (!is_char(input) || is_ctl(input) || is_tspecial(input))
-    {
-      return bad;
-    }
-    else
-    {
-      req.method.push_back(input);
-      return indeterminate;
-    }
-  case uri:
-    if (input == ' ')
-    {
-      state_ = http_version_h;
-      return indeterminate;
-    }
-    else if (is_ctl(input))
-    {
-      return bad;
-    }
-    else
-    {
-      req.uri.push_back(input);
-      return indeterminate;
-    }
-  case http_version_h:
-    if (input == 'H')
-    {
-      state_ = http_version_t_1;
-      return indeterminate;
-    }
-    else
-    {
-      return bad;
-    }
-  case http_version_t_1:
-    if (input == 'T')
-    {
-      state_ = http_version_t_2;
-      return indeterminate;
-    }
-    else
-    {
-      return bad;
-    }
-  case http_version_t_2:
-    if (input == 'T')
-    {
-      state_ = http_version_p;
-      return indeterminate;
-    }
-    else
-    {
-      return bad;
-    }
-  case http_version_p:
-    if (input == 'P')
-    {
-      state_ = http_version_slash;
-      return indeterminate;
-    }
-    else
-    {
-      return bad;
-    }
-  case http_version_slash:
-    if (input == '/')
-    {
-      req.http_version_major = 0;
-      req.http_version_minor = 0;
-      state_ = http_version_major_start;
-      return indeterminate;
-    }
-    else
-    {
-      return bad;
-    }
-  case http_version_major_start:
-    if (is_digit(input))
-    {
-      req.http_version_major = req.http_version_major * 10 + input - '0';
-      state_ = http_version_major;
-      return indeterminate;
-    }
-    else
-    {
-      return bad;
-    }
-  case http_version_major:
-    if (input == '.')
-    {
-      state_ = http_version_minor_start;
-      return indeterminate;
-    }
-    else if (is_digit(input))
-    {
-      req.http_version_major = req.http_version_major * 10 + input - '0';
-      return indeterminate;
-    }
-    else
-    {
-      return bad;
-    }
-  case http_version_minor_start:
-    if (is_digit(input))
-    {
-      req.http_version_minor = req.http_version_minor * 10 + input - '0';
-      state_ = http_version_minor;
-      return indeterminate;
-    }
-    else
-    {
-      return bad;
-    }
-  case http_version_minor:
-    if (input == '\r')
-    {
-      state_ = expecting_newline_1;
-      return indeterminate;
-    }
-    else if (is_digit(input))
-    {
-      req.http_version_minor = req.http_version_minor * 10 + input - '0';
-      return indeterminate;
-    }
-    else
-    {
-      return bad;
-    }
-  case expecting_newline_1:
-    if (input == '\n')
-    {
-      state_ = header_line_start;
-      return indeterminate;
-    }
-    else
-    {
-      return bad;
-    }
-  case header_line_start:
-    if (input == '\r')
-    {
-      state_ = expecting_newline_3;
-      return indeterminate;
-    }
-    else if (!req.headers.empty() && (input == ' ' || input == '\t'))
-    {
-      state_ = header_lws;
-      return indeterminate;
-    }
-    else if (!is_char(input) || is_ctl(input) || is_tspecial(input))
-    {
-      return bad;
-    }
-    else
-    {
-      req.headers.push_back(header());
-      req.headers.back().name.push_back(input);
-      state_ = header_name;
-      return indeterminate;
-    }
-  case header_lws:
-    if (input == '\r')
-    {
-      state_ = expecting_newline_2;
-      return indeterminate;
-    }
-    else if (input == ' ' || input == '\t')
-    {
-      return indeterminate;
-    }
-    else if (is_ctl(input))
-    {
-      return bad;
-    }
-    else
-    {
-      state_ = header_value;
-      req.headers.back().value.push_back(input);
-      return indeterminate;
-    }
-  case header_name:
-    if (input == ':')
-    {
-      state_ = space_before_header_value;
-      return indeterminate;
-    }
-    else if (!is_char(input) || is_ctl(input) || is_tspecial(input))
-    {
-      return bad;
-    }
-    else
-    {
-      req.headers.back().name.push_back(input);
-      return indeterminate;
-    }
-  case space_before_header_value:
-    if (input == ' ')
-    {
-      state_ = header_value;
-      return indeterminate;
-    }
-    else
-    {
-      return bad;
+      scan_pos_ = end - begin;
+      return std::make_tuple(indeterminate, end);
     }
-  case header_value:
-    if (input == '\r')
-    {
-      state_ = expecting_newline_2;
-      return indeterminate;
-    }
-    else if (is_ctl(input))
-    {
-      return bad;
-    }
-    else
+
+    const char* line = begin + line_start_;
+    const char* line_end = static_cast<const char*>(newline);
+    const char* next_line = line_end + 1;
+    line_start_ = scan_pos_ = next_line - begin;
+
+    // Each line must end with CRLF.
+    if (line_end == line || line_end[-1] != '\r')
+      return std::make_tuple(bad, next_line);
+    --line_end;
+
+    if (state_ == request_line)
     {
-      req.headers.back().value.push_back(input);
-      return indeterminate;
+      req.headers.clear();
+      if (parse_request_line(req, line, line_end) == bad)
+        return std::make_tuple(bad, next_line);
+      state_ = header_line;
     }
-  case expecting_newline_2:
-    if (input == '\n')
+    else if (line == line_end)
     {
-      state_ = header_line_start;
-      return indeterminate;
+      // An empty line ends the request.
+      return std::make_tuple(good, next_line);
     }
-    else
+    else if (parse_header_line(req, line, line_end) == bad)
     {
-      return bad;
+      return std::make_tuple(bad, next_line);
     }
-  case expecting_newline_3:
-    return (input == '\n') ? good : bad;
-  default:
-    return bad;
   }
 }
 
-bool request_parser::is_char(int c)
+request_parser::result_type request_parser::parse_request_line(
+    request& req, const char* begin, const char* end)
 {
-  return c >= 0 && c <= 127;
+  // Method.
+  const char* p = begin;
+  while (p != end && is_token_char(*p))
+    ++p;
+  if (p == begin || p == end || *p != ' ')
+    return bad;
+  req.method.data = begin;
+  req.method.size = p - begin;
+
+  // URI.
+  const char* uri = ++p;
+  while (p != end && *p != ' ' && !is_ctl(*p))
+    ++p;
+  if (p == uri || p == end || *p != ' ')
+    return bad;
+  req.uri.data = uri;
+  req.uri.size = p - uri;
+
+  // HTTP version.
+  ++p;
+  if (end - p < 5 || std::memcmp(p, "HTTP/", 5) != 0)
+    return bad;
+  p += 5;
+  int* version[2] = { &req.http_version_major, &req.http_version_minor };
+  for (int i = 0; i < 2; ++i)
+  {
+    if (i == 1 && (p == end || *p++ != '.'))
+      return bad;
+    if (p == end || !is_digit(*p))
+      return bad;
+    *version[i] = 0;
+    while (p != end && is_digit(*p))
+      if ((*version[i] = *version[i] * 10 + *p++ - '0') > 999)
+        return bad;
+  }
+
+  return p == end ? good : bad;
 }
 
-bool request_parser::is_ctl(int c)
+request_parser::result_type request_parser::parse_header_line(
+    request& req, const char* begin, const char* end)
 {
-  return (c >= 0 && c <= 31) || (c == 127);
+  // Name.
+  const char* colon = static_cast<const char*>(
+      std::memchr(begin, ':', end - begin));
+  if (!colon || colon == begin)
+    return bad;
+  for (const char* p = begin; p != colon; ++p)
+    if (!is_token_char(*p))
+      return bad;
+
+  // Value, without surrounding whitespace.
+  const char* value = colon + 1;
+  while (value != end && (*value == ' ' || *value == '\t'))
+    ++value;
+  const char* value_end = end;
+  while (value_end != value
+      && (value_end[-1] == ' ' || value_end[-1] == '\t'))
+    --value_end;
+  for (const char* p = value; p != value_end; ++p)
+    if (is_ctl(*p) && *p != '\t')
+      return bad;
+
+  request_header h;
+  h.name.data = begin;
+  h.name.size = colon - begin;
+  h.value.data = value;
+  h.value.size = value_end - value;
+  req.headers.push_back(h);
+  return good;
 }
 
-bool request_parser::is_tspecial(int c)
+bool request_parser::is_token_char(char c)
 {
   switch (c)
   {
@@ -300,13 +156,18 @@ bool request_parser::is_tspecial(int c)
   case ',': case ';': case ':': case '\\': case '"':
   case '/': case '[': case ']': case '?': case '=':
   case '{': case '}': case ' ': case '\t':
-    return true;
-  default:
     return false;
+  default:
+    return static_cast<unsigned char>(c) <= 127 && !is_ctl(c);
   }
 }
 
-bool request_parser::is_digit(int c)
+bool request_parser::is_ctl(char c)
+{
+  return (c >= 0 && c <= 31) || (c == 127);
+}
+
+bool request_parser::is_digit(char c)
 {
   return c >= '0' && c <= '9';
 }
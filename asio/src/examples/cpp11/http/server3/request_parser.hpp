@@ -11,6 +11,7 @@
 #ifndef HTTP_SERVER3_REQUEST_PARSER_HPP
 #define HTTP_SERVER3_REQUEST_PARSER_HPP
 
+#include <cstddef>
 #include <tuple>
 
 namespace http {
@@ -19,10 +20,15 @@ namespace server3 {
 struct request;
 
 /// Parser for incoming requests.
+/**
+ * The parser does not copy the request. The method, URI and headers are
+ * stored as references into the buffer that holds the request data, which
+ * must remain unchanged until the request has been handled.
+ */
 class request_parser
 {
 public:
-  /// Construct ready to parse the request method.
+  /// Construct ready to parse the request line.
   request_parser();
 
   /// Reset to initial parser state.
@@ -31,63 +37,46 @@ public:
   /// Result of parse.
   enum result_type { good, bad, indeterminate };
 
-  /// Parse some data. The enum return value is good when a complete request has
-  /// been parsed, bad if the data is invalid, indeterminate when more data is
-  /// required. The InputIterator return value indicates how much of the input
-  /// has been consumed.
-  template <typename InputIterator>
-  std::tuple<result_type, InputIterator> parse(request& req,
-      InputIterator begin, InputIterator end)
-  {
-    while (begin != end)
-    {
-      result_type result = consume(req, *begin++);
-      if (result == good || result == bad)
-        return std::make_tuple(result, begin);
-    }
-    return std::make_tuple(indeterminate, begin);
-  }
+  /// Parse the data received so far. The data must start at the beginning of
+  /// the request, and any data passed to earlier calls must be passed again
+  /// at the same address. Parsing resumes where the previous call stopped, so
+  /// each character is examined only once. The enum return value is good when
+  /// a complete request has been parsed, bad if the data is invalid,
+  /// indeterminate when more data is required. The pointer return value
+  /// indicates how much of the input has been consumed.
+  std::tuple<result_type, const char*> parse(request& req,
+      const char* begin, const char* end);
 
 private:
-  /// Handle the next character of input.
-  result_type consume(request& req, char input);
+  /// Handle the request line, excluding the CRLF.
+  result_type parse_request_line(request& req,
+      const char* begin, const char* end);
 
-  /// Check if a byte is an HTTP character.
-  static bool is_char(int c);
+  /// Handle a header line, excluding the CRLF.
+  result_type parse_header_line(request& req,
+      const char* begin, const char* end);
 
-  /// Check if a byte is an HTTP control character.
-  static bool is_ctl(int c);
+  /// Check if a byte may appear in a method or header name.
+  static bool is_token_char(char c);
 
-  /// Check if a byte is defined as an HTTP tspecial character.
-  static bool is_tspecial(int c);
+  /// Check if a byte is an HTTP control character.
+  static bool is_ctl(char c);
 
   /// Check if a byte is a digit.
-  static bool is_digit(int c);
+  static bool is_digit(char c);
 
   /// The current state of the parser.
   enum state
   {
-    method_start,
-    method,
-    uri,
-    http_version_h,
-    http_version_t_1,
-    http_version_t_2,
-    http_version_p,
-    http_version_slash,
-    http_version_major_start,
-    http_version_major,
-    http_version_minor_start,
-    http_version_minor,
-    expecting_newline_1,
-    header_line_start,
-    header_lws,
-    header_name,
-    space_before_header_value,
-    header_value,
-    expecting_newline_2,
-    expecting_newline_3
+    request_line,
+    header_line
   } state_;
+
+  /// The offset of the start of the line being parsed.
+  std::size_t line_start_;
+
+  /// The offset from which to continue searching for the end of the line.
+  std::size_t scan_pos_;
 };
 
 } // namespace server3
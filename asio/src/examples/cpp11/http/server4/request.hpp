@@ -11,6 +11,8 @@
 #ifndef HTTP_SERVER4_REQUEST_HPP
 #define HTTP_SERVER4_REQUEST_HPP
 
+#include <cctype>
+#include <cstddef>
 #include <string>
 #include <vector>
 #include "header.hpp"
@@ -26,6 +28,38 @@ struct request
   int http_version_major;
   int http_version_minor;
   std::vector<header> headers;
+
+  /// Determine whether the client wants the connection to remain open after
+  /// the reply has been sent. HTTP/1.1 connections are persistent unless the
+  /// client sends "Connection: close", while HTTP/1.0 clients must ask for a
+  /// persistent connection with "Connection: keep-alive".
+  bool keep_alive() const
+  {
+    bool persistent = http_version_major > 1
+      || (http_version_major == 1 && http_version_minor >= 1);
+    for (std::size_t i = 0; i < headers.size(); ++i)
+    {
+      if (equals_ignore_case(headers[i].name, "Connection"))
+      {
+        if (equals_ignore_case(headers[i].value, "close"))
+          persistent = false;
+        else if (equals_ignore_case(headers[i].value, "keep-alive"))
+          persistent = true;
+      }
+    }
+    return persistent;
+  }
+
+private:
+  static bool equals_ignore_case(const std::string& a, const char* b)
+  {
+    std::size_t i = 0;
+    for (; i < a.size() && b[i]; ++i)
+      if (std::tolower(static_cast<unsigned char>(a[i]))
+          != std::tolower(static_cast<unsigned char>(b[i])))
+        return false;
+    return i == a.size() && !b[i];
+  }
 };
 
 } // namespace server4
@@ -15,10 +15,20 @@
 namespace http {
 namespace server4 {
 
+namespace {
+
+/// How long a connection may wait for a request before it is closed.
+const std::chrono::seconds idle_timeout(30);
+
+} // namespace
+
 server::server(asio::io_context& io_context,
     const std::string& address, const std::string& port,
     std::function<void(const request&, reply&)> request_handler)
-  : request_handler_(request_handler)
+  : request_handler_(request_handler),
+    buffer_start_(0),
+    buffer_end_(0),
+    keep_alive_(false)
 {
   tcp::resolver resolver(io_context);
   asio::ip::tcp::endpoint endpoint =
@@ -66,43 +76,60 @@ void server::operator()(std::error_code ec, std::size_t length)
         // The child exits the loop and processes the connection.
       } while (is_parent());
 
-      // Create the objects needed to receive a request on the connection.
+      // Create the objects needed to receive requests on the connection.
       buffer_.reset(new std::array<char, 8192>);
       request_.reset(new request);
+      idle_timer_.reset(new idle_timer(socket_->get_executor()));
 
-      // Loop until a complete request (or an invalid one) has been received.
+      // Loop to handle requests until the connection is to be closed.
       do
       {
-        // Receive some more data. When control resumes at the following line,
-        // the ec and length parameters reflect the result of the asynchronous
-        // operation.
-        yield socket_->async_read_some(asio::buffer(*buffer_), *this);
-
-        // Parse the data we just received.
-        std::tie(parse_result_, std::ignore)
-          = request_parser_.parse(*request_,
-              buffer_->data(), buffer_->data() + length);
-
-        // An indeterminate result means we need more data, so keep looping.
-      } while (parse_result_ == request_parser::indeterminate);
-
-      // Create the reply object that will be sent back to the client.
-      reply_.reset(new reply);
-
-      if (parse_result_ == request_parser::good)
-      {
-        // A valid request was received. Call the user-supplied function object
-        // to process the request and compose a reply.
-        request_handler_(*request_, *reply_);
-      }
-      else
-      {
-        // The request was invalid.
-        *reply_ = reply::stock_reply(reply::bad_request);
-      }
-
-      // Send the reply back to the client.
-      yield asio::async_write(*socket_, reply_->to_buffers(), *this);
+        // Clients may send several requests without waiting for the replies,
+        // so start with any data left over from the previous request.
+        *request_ = request();
+        request_parser_.reset();
+        parse_buffered_data();
+
+        // Loop until a complete request (or an invalid one) has been received.
+        while (parse_result_ == request_parser::indeterminate)
+        {
+          // Receive some more data. When control resumes at the following
+          // line, the ec and length parameters reflect the result of the
+          // asynchronous operation.
+          start_idle_timer();
+          yield socket_->async_read_some(asio::buffer(*buffer_), *this);
+          idle_timer_->expires_at(idle_timer::time_point::max());
+
+          // Parse the data we just received.
+          buffer_start_ = 0;
+          buffer_end_ = length;
+          parse_buffered_data();
+        }
+
+        // Create the reply object that will be sent back to the client.
+        reply_.reset(new reply);
+
+        if (parse_result_ == request_parser::good)
+        {
+          // A valid request was received. Call the user-supplied function
+          // object to process the request and compose a reply.
+          keep_alive_ = request_->keep_alive();
+          request_handler_(*request_, *reply_);
+        }
+        else
+        {
+          // The request was invalid.
+          keep_alive_ = false;
+          *reply_ = reply::stock_reply(reply::bad_request);
+        }
+
+        reply_->headers.push_back(
+            header{"Connection", keep_alive_ ? "keep-alive" : "close"});
+
+        // Send the reply back to the client. Replies to pipelined requests
+        // are sent in the order in which the requests were received.
+        yield asio::async_write(*socket_, reply_->to_buffers(), *this);
+      } while (keep_alive_);
 
       // Initiate graceful connection closure.
       socket_->shutdown(tcp::socket::shutdown_both, ec);
@@ -118,5 +145,37 @@ void server::operator()(std::error_code ec, std::size_t length)
 // Disable the pseudo-keywords reenter, yield and fork.
 #include <asio/unyield.hpp>
 
+void server::parse_buffered_data()
+{
+  char* begin = buffer_->data() + buffer_start_;
+  std::tie(parse_result_, begin) = request_parser_.parse(
+      *request_, begin, buffer_->data() + buffer_end_);
+  buffer_start_ = begin - buffer_->data();
+}
+
+void server::start_idle_timer()
+{
+  // The handler must not keep the connection alive, so that the timer is
+  // cancelled when the connection's coroutine finishes.
+  std::weak_ptr<tcp::socket> weak_socket(socket_);
+  std::weak_ptr<idle_timer> weak_timer(idle_timer_);
+
+  idle_timer_->expires_after(idle_timeout);
+  idle_timer_->async_wait(
+      [weak_socket, weak_timer](std::error_code ec)
+      {
+        // The timer may have been moved on after this handler was queued, so
+        // check that the deadline has really passed.
+        std::shared_ptr<tcp::socket> socket = weak_socket.lock();
+        std::shared_ptr<idle_timer> timer = weak_timer.lock();
+        if (!ec && socket && timer
+            && timer->expiry() <= idle_timer::clock_type::now())
+        {
+          std::error_code ignored_ec;
+          socket->close(ignored_ec);
+        }
+      });
+}
+
 } // namespace server4
 } // namespace http
@@ -13,6 +13,7 @@
 
 #include <asio.hpp>
 #include <array>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <string>
@@ -42,6 +43,17 @@ public:
 private:
   typedef asio::ip::tcp tcp;
 
+  /// Timer type used to close idle connections. Idle timers are rescheduled
+  /// on every request, so they are kept in a timer wheel.
+  typedef asio::basic_waitable_timer<std::chrono::steady_clock,
+      asio::timer_wheel_traits<std::chrono::steady_clock>> idle_timer;
+
+  /// Parse the data in the buffer that has not yet been consumed.
+  void parse_buffered_data();
+
+  /// Close the connection if no data arrives before the idle timeout.
+  void start_idle_timer();
+
   /// The user-supplied handler for all incoming requests.
   std::function<void(const request&, reply&)> request_handler_;
 
@@ -54,6 +66,16 @@ private:
   /// Buffer for incoming data.
   std::shared_ptr<std::array<char, 8192>> buffer_;
 
+  /// The offset of the first byte in the buffer not yet consumed by the
+  /// parser. Data after the end of a request belongs to the next request.
+  std::size_t buffer_start_;
+
+  /// The offset of the end of the received data in the buffer.
+  std::size_t buffer_end_;
+
+  /// Timer used to close the connection when no request arrives.
+  std::shared_ptr<idle_timer> idle_timer_;
+
   /// The incoming request.
   std::shared_ptr<request> request_;
 
@@ -65,6 +87,9 @@ private:
 
   /// The reply to be sent back to the client.
   std::shared_ptr<reply> reply_;
+
+  /// Whether the connection remains open after the reply has been sent.
+  bool keep_alive_;
 };
 
 } // namespace server4
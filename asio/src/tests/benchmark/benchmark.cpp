@@ -0,0 +1,1207 @@
+//
+// benchmark.cpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// A self-contained benchmark suite. Each benchmark is run in turn, and the
+// results are written to standard output as a JSON document that identifies
+// the asio version and the I/O backend in use, so that runs of different
+// releases, or of builds using different backends, may be compared.
+//
+// Usage: benchmark [--list] [--scale=<factor>] [--threads=<n>] [<name>...]
+//
+// If any names are given, only the benchmarks whose names contain one of them
+// are run. The scale factor multiplies the number of iterations performed.
+
+#include "asio.hpp"
+#include "asio/experimental/channel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(BENCHMARK_ENABLE_SSL)
+# include "asio/ssl.hpp"
+#endif // defined(BENCHMARK_ENABLE_SSL)
+
+#if defined(BENCHMARK_ENABLE_SPAWN)
+# include "asio/spawn.hpp"
+#endif // defined(BENCHMARK_ENABLE_SPAWN)
+
+#if defined(ASIO_HAS_STD_COROUTINE)
+# include "asio/experimental/co_spawn.hpp"
+# include "asio/experimental/coro.hpp"
+#endif // defined(ASIO_HAS_STD_COROUTINE)
+
+using asio::ip::tcp;
+using asio::ip::udp;
+
+typedef std::chrono::steady_clock clock_type;
+
+//------------------------------------------------------------------------------
+
+struct options
+{
+  double scale = 1.0;
+  std::size_t threads = 0;
+  std::vector<std::string> names;
+
+  std::size_t iterations(std::size_t n) const
+  {
+    std::size_t scaled = static_cast<std::size_t>(n * scale);
+    return scaled > 0 ? scaled : 1;
+  }
+};
+
+struct result
+{
+  std::size_t threads = 1;
+  std::size_t operations = 0;
+  clock_type::duration elapsed = clock_type::duration::zero();
+  bool has_latency = false;
+  asio::latency_histogram latency;
+
+  void record(clock_type::duration d)
+  {
+    has_latency = true;
+    latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(d));
+  }
+};
+
+const char* backend_name()
+{
+#if defined(ASIO_HAS_IOCP)
+  return "iocp";
+#elif defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  return "io_uring";
+#elif defined(ASIO_HAS_EPOLL)
+  return "epoll";
+#elif defined(ASIO_HAS_KQUEUE)
+  return "kqueue";
+#elif defined(ASIO_HAS_DEV_POLL)
+  return "dev_poll";
+#elif defined(ASIO_HAS_POLL)
+  return "poll";
+#else
+  return "select";
+#endif
+}
+
+// Run an io_context using the specified number of threads, including the
+// calling thread.
+void run_threads(asio::io_context& ctx, std::size_t threads)
+{
+  std::vector<std::thread> pool;
+  for (std::size_t i = 1; i < threads; ++i)
+    pool.emplace_back([&ctx]{ ctx.run(); });
+  ctx.run();
+  for (std::thread& t : pool)
+    t.join();
+}
+
+//------------------------------------------------------------------------------
+// Post and dispatch.
+
+// Posts functions from outside the io_context, then runs them all.
+result post_throughput(const options& opts)
+{
+  const std::size_t n = opts.iterations(1000000);
+  asio::io_context ctx(1);
+  std::size_t count = 0;
+
+  result r;
+  clock_type::time_point start = clock_type::now();
+  for (std::size_t i = 0; i < n; ++i)
+    asio::post(ctx, [&count]{ ++count; });
+  ctx.run();
+  r.elapsed = clock_type::now() - start;
+  r.operations = count;
+  return r;
+}
+
+// A function that posts itself until the shared count is exhausted.
+template <typename Executor>
+struct chain_step
+{
+  Executor ex;
+  std::atomic<long>* remaining;
+  std::atomic<long>* executed;
+
+  void operator()() const
+  {
+    long count = remaining->fetch_sub(1, std::memory_order_relaxed);
+    if (count > 0)
+    {
+      executed->fetch_add(1, std::memory_order_relaxed);
+      if (count > 1)
+        asio::post(ex, *this);
+    }
+  }
+};
+
+template <typename Executor>
+void run_chains(asio::io_context& ctx, const Executor& ex,
+    std::size_t chains, std::size_t n, std::size_t threads, result& r)
+{
+  std::atomic<long> remaining(static_cast<long>(n));
+  std::atomic<long> executed(0);
+  for (std::size_t i = 0; i < chains; ++i)
+    asio::post(ex, chain_step<Executor>{ex, &remaining, &executed});
+
+  clock_type::time_point start = clock_type::now();
+  run_threads(ctx, threads);
+  r.elapsed = clock_type::now() - start;
+  r.threads = threads;
+  r.operations = static_cast<std::size_t>(executed.load());
+}
+
+// Chains of functions that post their successors, run by several threads.
+result post_chain_throughput(const options& opts)
+{
+  const std::size_t n = opts.iterations(1000000);
+  asio::io_context ctx(static_cast<int>(opts.threads));
+  result r;
+  run_chains(ctx, ctx.get_executor(), opts.threads * 4, n, opts.threads, r);
+  return r;
+}
+
+// Dispatches functions from within the io_context, so that each is invoked
+// immediately.
+result dispatch_throughput(const options& opts)
+{
+  const std::size_t n = opts.iterations(10000000);
+  asio::io_context ctx(1);
+  std::size_t count = 0;
+
+  result r;
+  asio::post(ctx,
+      [&]
+      {
+        clock_type::time_point start = clock_type::now();
+        for (std::size_t i = 0; i < n; ++i)
+          asio::dispatch(ctx, [&count]{ ++count; });
+        r.elapsed = clock_type::now() - start;
+      });
+  ctx.run();
+  r.operations = count;
+  return r;
+}
+
+// Chains of functions that post their successors through a single strand,
+// while several threads run the io_context.
+result strand_contention(const options& opts)
+{
+  const std::size_t n = opts.iterations(1000000);
+  asio::io_context ctx(static_cast<int>(opts.threads));
+  result r;
+  run_chains(ctx, asio::make_strand(ctx),
+      opts.threads * 4, n, opts.threads, r);
+  return r;
+}
+
+//------------------------------------------------------------------------------
+// Timers.
+
+// Starts waits on timers with scattered expiry times, so that each insertion
+// exercises the timer queue.
+void start_timers(asio::io_context& ctx,
+    std::vector<std::unique_ptr<asio::steady_timer>>& timers, std::size_t n)
+{
+  timers.reserve(n);
+  for (std::size_t i = 0; i < n; ++i)
+    timers.emplace_back(new asio::steady_timer(ctx));
+
+  unsigned long seed = 1;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    seed = seed * 1103515245UL + 12345UL;
+    timers[i]->expires_after(std::chrono::seconds(60)
+        + std::chrono::microseconds(seed % 1000000000UL));
+    timers[i]->async_wait([](const asio::error_code&){});
+  }
+}
+
+result timer_insert(const options& opts)
+{
+  const std::size_t n = opts.iterations(200000);
+  asio::io_context ctx(1);
+  std::vector<std::unique_ptr<asio::steady_timer>> timers;
+
+  result r;
+  clock_type::time_point start = clock_type::now();
+  start_timers(ctx, timers, n);
+  r.elapsed = clock_type::now() - start;
+  r.operations = n;
+
+  for (std::size_t i = 0; i < n; ++i)
+    timers[i]->cancel();
+  ctx.run();
+  return r;
+}
+
+result timer_cancel(const options& opts)
+{
+  const std::size_t n = opts.iterations(200000);
+  asio::io_context ctx(1);
+  std::vector<std::unique_ptr<asio::steady_timer>> timers;
+  start_timers(ctx, timers, n);
+
+  // Cancel in the order the timers were created, which is unrelated to their
+  // order in the timer queue.
+  result r;
+  clock_type::time_point start = clock_type::now();
+  for (std::size_t i = 0; i < n; ++i)
+    timers[i]->cancel();
+  r.elapsed = clock_type::now() - start;
+  r.operations = n;
+
+  ctx.run();
+  return r;
+}
+
+enum { idle_timeout_connections = 1000 };
+
+// Pushes back the idle timeouts of a set of connections, as each connection's
+// reads complete, using a steady_timer that is cancelled and waited on again.
+result timer_rearm(const options& opts)
+{
+  const std::size_t n = opts.iterations(1000000);
+  asio::io_context ctx(1);
+  std::vector<std::unique_ptr<asio::steady_timer>> timers;
+  start_timers(ctx, timers, idle_timeout_connections);
+
+  result r;
+  clock_type::time_point start = clock_type::now();
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    asio::steady_timer& t = *timers[i % idle_timeout_connections];
+    t.expires_after(std::chrono::seconds(60));
+    t.async_wait([](const asio::error_code&){});
+    if (i % idle_timeout_connections == idle_timeout_connections - 1)
+      ctx.poll();
+  }
+  r.elapsed = clock_type::now() - start;
+  r.operations = n;
+
+  for (std::size_t i = 0; i < timers.size(); ++i)
+    timers[i]->cancel();
+  ctx.run();
+  return r;
+}
+
+// As for timer_rearm, but using a timeout_timer, whose wait is not cancelled
+// when its expiry time is pushed back.
+result timeout_timer_rearm(const options& opts)
+{
+  const std::size_t n = opts.iterations(1000000);
+  asio::io_context ctx(1);
+  std::vector<std::unique_ptr<asio::timeout_timer>> timers;
+  for (std::size_t i = 0; i < idle_timeout_connections; ++i)
+  {
+    timers.emplace_back(new asio::timeout_timer(ctx));
+    timers[i]->expires_after(std::chrono::seconds(60));
+    timers[i]->async_wait([](const asio::error_code&){});
+  }
+
+  result r;
+  clock_type::time_point start = clock_type::now();
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    timers[i % idle_timeout_connections]->expires_after(
+        std::chrono::seconds(60));
+    if (i % idle_timeout_connections == idle_timeout_connections - 1)
+      ctx.poll();
+  }
+  r.elapsed = clock_type::now() - start;
+  r.operations = n;
+
+  for (std::size_t i = 0; i < timers.size(); ++i)
+    timers[i]->cancel();
+  ctx.run();
+  return r;
+}
+
+//------------------------------------------------------------------------------
+// Echo latency.
+
+enum { echo_message_size = 64 };
+
+class tcp_echo
+{
+public:
+  tcp_echo(tcp::socket& client, tcp::socket& server,
+      std::size_t n, result& r)
+    : client_(client),
+      server_(server),
+      remaining_(n),
+      result_(r)
+  {
+    std::memset(client_data_, 0, sizeof(client_data_));
+  }
+
+  void start()
+  {
+    do_server_read();
+    do_client_write();
+  }
+
+private:
+  void do_server_read()
+  {
+    asio::async_read(server_, asio::buffer(server_data_),
+        [this](const asio::error_code& ec, std::size_t)
+        {
+          if (!ec)
+          {
+            asio::async_write(server_, asio::buffer(server_data_),
+                [this](const asio::error_code& ec, std::size_t)
+                {
+                  if (!ec)
+                    do_server_read();
+                });
+          }
+        });
+  }
+
+  void do_client_write()
+  {
+    start_ = clock_type::now();
+    asio::async_write(client_, asio::buffer(client_data_),
+        [this](const asio::error_code& ec, std::size_t)
+        {
+          if (!ec)
+          {
+            asio::async_read(client_, asio::buffer(client_data_),
+                [this](const asio::error_code& ec, std::size_t)
+                {
+                  if (!ec)
+                  {
+                    result_.record(clock_type::now() - start_);
+                    ++result_.operations;
+                    if (--remaining_ > 0)
+                      do_client_write();
+                    else
+                      client_.shutdown(tcp::socket::shutdown_send);
+                  }
+                });
+          }
+        });
+  }
+
+  tcp::socket& client_;
+  tcp::socket& server_;
+  std::size_t remaining_;
+  result& result_;
+  clock_type::time_point start_;
+  char client_data_[echo_message_size];
+  char server_data_[echo_message_size];
+};
+
+// Runs an echo workload over a pair of connected loopback sockets. The start
+// function is called to begin the exchange of n messages.
+template <typename Start>
+result run_tcp_echo(const options& opts, Start start_echo)
+{
+  const std::size_t n = opts.iterations(50000);
+  asio::io_context ctx(1);
+
+  tcp::acceptor acceptor(ctx,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket client(ctx);
+  tcp::socket server(ctx);
+  client.connect(acceptor.local_endpoint());
+  acceptor.accept(server);
+  client.set_option(tcp::no_delay(true));
+  server.set_option(tcp::no_delay(true));
+
+  result r;
+  clock_type::time_point start = clock_type::now();
+  start_echo(client, server, n, r);
+  ctx.run();
+  r.elapsed = clock_type::now() - start;
+  return r;
+}
+
+result tcp_echo_latency(const options& opts)
+{
+  std::unique_ptr<tcp_echo> echo;
+  return run_tcp_echo(opts,
+      [&](tcp::socket& client, tcp::socket& server, std::size_t n, result& r)
+      {
+        echo.reset(new tcp_echo(client, server, n, r));
+        echo->start();
+      });
+}
+
+class udp_echo
+{
+public:
+  udp_echo(udp::socket& client, udp::socket& server,
+      std::size_t n, result& r)
+    : client_(client),
+      server_(server),
+      remaining_(n),
+      result_(r)
+  {
+    std::memset(client_data_, 0, sizeof(client_data_));
+  }
+
+  void start()
+  {
+    do_server_receive();
+    do_client_send();
+  }
+
+private:
+  void do_server_receive()
+  {
+    server_.async_receive(asio::buffer(server_data_),
+        [this](const asio::error_code& ec, std::size_t length)
+        {
+          if (!ec)
+          {
+            server_.async_send(asio::buffer(server_data_, length),
+                [this](const asio::error_code& ec, std::size_t)
+                {
+                  if (!ec)
+                    do_server_receive();
+                });
+          }
+        });
+  }
+
+  void do_client_send()
+  {
+    start_ = clock_type::now();
+    client_.async_send(asio::buffer(client_data_),
+        [this](const asio::error_code& ec, std::size_t)
+        {
+          if (!ec)
+          {
+            client_.async_receive(asio::buffer(client_data_),
+                [this](const asio::error_code& ec, std::size_t)
+                {
+                  if (!ec)
+                  {
+                    result_.record(clock_type::now() - start_);
+                    ++result_.operations;
+                    if (--remaining_ > 0)
+                      do_client_send();
+                    else
+                      server_.cancel();
+                  }
+                });
+          }
+        });
+  }
+
+  udp::socket& client_;
+  udp::socket& server_;
+  std::size_t remaining_;
+  result& result_;
+  clock_type::time_point start_;
+  char client_data_[echo_message_size];
+  char server_data_[echo_message_size];
+};
+
+result udp_echo_latency(const options& opts)
+{
+  const std::size_t n = opts.iterations(50000);
+  asio::io_context ctx(1);
+
+  udp::socket client(ctx,
+      udp::endpoint(asio::ip::address_v4::loopback(), 0));
+  udp::socket server(ctx,
+      udp::endpoint(asio::ip::address_v4::loopback(), 0));
+  client.connect(server.local_endpoint());
+  server.connect(client.local_endpoint());
+
+  result r;
+  udp_echo echo(client, server, n, r);
+  clock_type::time_point start = clock_type::now();
+  echo.start();
+  ctx.run();
+  r.elapsed = clock_type::now() - start;
+  return r;
+}
+
+//------------------------------------------------------------------------------
+// Write readiness.
+
+enum { backpressure_chunk_size = 256 * 1024 };
+
+// Sends data faster than a small send buffer can hold it, waiting for the
+// socket to become writable after each send. Most sends fill the buffer, so
+// most waits begin when the socket is already known not to be writable.
+class tcp_backpressure
+{
+public:
+  tcp_backpressure(tcp::socket& client, tcp::socket& server,
+      std::size_t n, result& r)
+    : client_(client),
+      server_(server),
+      remaining_(n),
+      result_(r),
+      client_data_(backpressure_chunk_size),
+      server_data_(backpressure_chunk_size)
+  {
+  }
+
+  void start()
+  {
+    do_server_read();
+    do_client_send();
+  }
+
+private:
+  void do_server_read()
+  {
+    server_.async_read_some(asio::buffer(server_data_),
+        [this](const asio::error_code& ec, std::size_t)
+        {
+          if (!ec)
+            do_server_read();
+        });
+  }
+
+  void do_client_send()
+  {
+    client_.async_send(asio::buffer(client_data_),
+        [this](const asio::error_code& ec, std::size_t)
+        {
+          if (!ec)
+          {
+            client_.async_wait(tcp::socket::wait_write,
+                [this](const asio::error_code& ec)
+                {
+                  if (!ec)
+                  {
+                    ++result_.operations;
+                    if (--remaining_ > 0)
+                      do_client_send();
+                    else
+                      client_.shutdown(tcp::socket::shutdown_send);
+                  }
+                });
+          }
+        });
+  }
+
+  tcp::socket& client_;
+  tcp::socket& server_;
+  std::size_t remaining_;
+  result& result_;
+  std::vector<char> client_data_;
+  std::vector<char> server_data_;
+};
+
+result tcp_write_backpressure(const options& opts)
+{
+  const std::size_t n = opts.iterations(50000);
+  asio::io_context ctx(1);
+
+  tcp::acceptor acceptor(ctx,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket client(ctx);
+  tcp::socket server(ctx);
+  client.connect(acceptor.local_endpoint());
+  acceptor.accept(server);
+  client.set_option(tcp::no_delay(true));
+  client.set_option(tcp::socket::send_buffer_size(64 * 1024));
+
+  result r;
+  tcp_backpressure backpressure(client, server, n, r);
+  clock_type::time_point start = clock_type::now();
+  backpressure.start();
+  ctx.run();
+  r.elapsed = clock_type::now() - start;
+  return r;
+}
+
+//------------------------------------------------------------------------------
+// SSL.
+
+#if defined(BENCHMARK_ENABLE_SSL)
+
+// Give a context a newly generated key and self-signed certificate, so that
+// the benchmark does not depend on any files.
+bool use_generated_certificate(asio::ssl::context& ctx)
+{
+  EVP_PKEY* key = 0;
+  EVP_PKEY_CTX* key_ctx = ::EVP_PKEY_CTX_new_id(EVP_PKEY_EC, 0);
+  bool ok = key_ctx
+    && ::EVP_PKEY_keygen_init(key_ctx) > 0
+    && ::EVP_PKEY_CTX_set_ec_paramgen_curve_nid(
+        key_ctx, NID_X9_62_prime256v1) > 0
+    && ::EVP_PKEY_keygen(key_ctx, &key) > 0;
+  ::EVP_PKEY_CTX_free(key_ctx);
+
+  X509* cert = ok ? ::X509_new() : 0;
+  if (cert)
+  {
+    ::X509_set_version(cert, 2);
+    ::ASN1_INTEGER_set(::X509_get_serialNumber(cert), 1);
+    ::X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    ::X509_gmtime_adj(X509_getm_notAfter(cert), 24 * 60 * 60);
+    ::X509_set_pubkey(cert, key);
+    X509_NAME* name = ::X509_get_subject_name(cert);
+    ::X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+        reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+    ::X509_set_issuer_name(cert, name);
+    ok = ::X509_sign(cert, key, ::EVP_sha256()) > 0
+      && ::SSL_CTX_use_certificate(ctx.native_handle(), cert) == 1
+      && ::SSL_CTX_use_PrivateKey(ctx.native_handle(), key) == 1;
+  }
+
+  ::X509_free(cert);
+  ::EVP_PKEY_free(key);
+  return ok;
+}
+
+// Performs complete TLS handshakes over loopback connections, one at a time.
+result ssl_handshake_rate(const options& opts)
+{
+  const std::size_t n = opts.iterations(500);
+  asio::io_context ctx(1);
+
+  asio::ssl::context server_ctx(asio::ssl::context::tls_server);
+  asio::ssl::context client_ctx(asio::ssl::context::tls_client);
+  client_ctx.set_verify_mode(asio::ssl::verify_none);
+
+  result r;
+  if (!use_generated_certificate(server_ctx))
+  {
+    std::fprintf(stderr, "ssl_handshake_rate: cannot generate certificate\n");
+    return r;
+  }
+
+  tcp::acceptor acceptor(ctx,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    asio::ssl::stream<tcp::socket> client(ctx, client_ctx);
+    asio::ssl::stream<tcp::socket> server(ctx, server_ctx);
+    client.lowest_layer().connect(acceptor.local_endpoint());
+    acceptor.accept(server.lowest_layer());
+
+    std::size_t completed = 0;
+    auto handler = [&completed](const asio::error_code& ec)
+    {
+      if (!ec)
+        ++completed;
+    };
+
+    clock_type::time_point start = clock_type::now();
+    client.async_handshake(asio::ssl::stream_base::client, handler);
+    server.async_handshake(asio::ssl::stream_base::server, handler);
+    ctx.restart();
+    ctx.run();
+    clock_type::duration elapsed = clock_type::now() - start;
+
+    if (completed == 2)
+    {
+      r.record(elapsed);
+      r.elapsed += elapsed;
+      ++r.operations;
+    }
+  }
+
+  return r;
+}
+
+#endif // defined(BENCHMARK_ENABLE_SSL)
+
+//------------------------------------------------------------------------------
+// Channels.
+
+typedef asio::experimental::channel<
+    void(asio::error_code, std::size_t)> benchmark_channel;
+
+// Sends values through a buffered channel to a receiver, using callbacks.
+result channel_throughput(const options& opts)
+{
+  const std::size_t n = opts.iterations(1000000);
+  asio::io_context ctx(1);
+  benchmark_channel channel(ctx, 128);
+
+  std::size_t sent = 0;
+  std::size_t received = 0;
+
+  std::function<void()> do_send = [&]
+  {
+    channel.async_send(asio::error_code(), sent,
+        [&](const asio::error_code& ec)
+        {
+          if (!ec && ++sent < n)
+            do_send();
+        });
+  };
+
+  std::function<void()> do_receive = [&]
+  {
+    channel.async_receive(
+        [&](const asio::error_code& ec, std::size_t)
+        {
+          if (!ec && ++received < n)
+            do_receive();
+        });
+  };
+
+  result r;
+  clock_type::time_point start = clock_type::now();
+  do_send();
+  do_receive();
+  ctx.run();
+  r.elapsed = clock_type::now() - start;
+  r.operations = received;
+  return r;
+}
+
+//------------------------------------------------------------------------------
+// Coroutines.
+
+#if defined(ASIO_HAS_CO_AWAIT)
+
+asio::awaitable<void> empty_coroutine()
+{
+  co_return;
+}
+
+asio::awaitable<void> call_loop(std::size_t n, std::size_t& count)
+{
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    co_await empty_coroutine();
+    ++count;
+  }
+}
+
+asio::awaitable<void> post_loop(std::size_t n, std::size_t& count)
+{
+  auto ex = co_await asio::this_coro::executor;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    co_await asio::post(ex, asio::use_awaitable);
+    ++count;
+  }
+}
+
+// Calls a coroutine that completes immediately, measuring the cost of
+// creating, resuming and destroying a coroutine frame.
+result coroutine_call(const options& opts)
+{
+  const std::size_t n = opts.iterations(2000000);
+  asio::io_context ctx(1);
+  std::size_t count = 0;
+
+  result r;
+  clock_type::time_point start = clock_type::now();
+  asio::co_spawn(ctx, call_loop(n, count), asio::detached);
+  ctx.run();
+  r.elapsed = clock_type::now() - start;
+  r.operations = count;
+  return r;
+}
+
+// Suspends a coroutine on a posted operation, measuring the cost of a
+// round trip through the io_context.
+result coroutine_post_resume(const options& opts)
+{
+  const std::size_t n = opts.iterations(1000000);
+  asio::io_context ctx(1);
+  std::size_t count = 0;
+
+  result r;
+  clock_type::time_point start = clock_type::now();
+  asio::co_spawn(ctx, post_loop(n, count), asio::detached);
+  ctx.run();
+  r.elapsed = clock_type::now() - start;
+  r.operations = count;
+  return r;
+}
+
+#endif // defined(ASIO_HAS_CO_AWAIT)
+
+//------------------------------------------------------------------------------
+// Programming models. Each benchmark runs the workload of tcp_echo_latency,
+// with the client and server written in a different style, so that the cost
+// of the model itself may be compared.
+
+result echo_model_callback(const options& opts)
+{
+  return tcp_echo_latency(opts);
+}
+
+#if defined(ASIO_HAS_CO_AWAIT)
+
+asio::awaitable<void> awaitable_echo_server(tcp::socket& socket)
+{
+  char data[echo_message_size];
+  for (;;)
+  {
+    auto [ec, n] = co_await asio::async_read(socket, asio::buffer(data),
+        asio::as_tuple(asio::use_awaitable));
+    if (ec)
+      co_return;
+    co_await asio::async_write(socket, asio::buffer(data, n),
+        asio::use_awaitable);
+  }
+}
+
+asio::awaitable<void> awaitable_echo_client(
+    tcp::socket& socket, std::size_t n, result& r)
+{
+  char data[echo_message_size] = {};
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    clock_type::time_point start = clock_type::now();
+    co_await asio::async_write(socket, asio::buffer(data),
+        asio::use_awaitable);
+    co_await asio::async_read(socket, asio::buffer(data),
+        asio::use_awaitable);
+    r.record(clock_type::now() - start);
+    ++r.operations;
+  }
+  socket.shutdown(tcp::socket::shutdown_send);
+}
+
+result echo_model_awaitable(const options& opts)
+{
+  return run_tcp_echo(opts,
+      [](tcp::socket& client, tcp::socket& server, std::size_t n, result& r)
+      {
+        asio::co_spawn(server.get_executor(),
+            awaitable_echo_server(server), asio::detached);
+        asio::co_spawn(client.get_executor(),
+            awaitable_echo_client(client, n, r), asio::detached);
+      });
+}
+
+#endif // defined(ASIO_HAS_CO_AWAIT)
+
+#if defined(ASIO_HAS_STD_COROUTINE)
+
+asio::experimental::coro<void> coro_echo_server(
+    asio::any_io_executor, tcp::socket& socket)
+{
+  char data[echo_message_size];
+  for (;;)
+  {
+    auto [ec, n] = co_await asio::async_read(socket, asio::buffer(data),
+        asio::as_tuple(asio::deferred));
+    if (ec)
+      co_return;
+    co_await asio::async_write(socket, asio::buffer(data, n),
+        asio::deferred);
+  }
+}
+
+// Yields the duration of each round trip.
+asio::experimental::coro<clock_type::duration> coro_echo_client(
+    asio::any_io_executor, tcp::socket& socket)
+{
+  char data[echo_message_size] = {};
+  for (;;)
+  {
+    clock_type::time_point start = clock_type::now();
+    co_await asio::async_write(socket, asio::buffer(data), asio::deferred);
+    co_await asio::async_read(socket, asio::buffer(data), asio::deferred);
+    co_yield clock_type::now() - start;
+  }
+}
+
+asio::experimental::coro<void> coro_echo_driver(
+    asio::any_io_executor ex, tcp::socket& socket, std::size_t n, result& r)
+{
+  auto client = coro_echo_client(ex, socket);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    auto d = co_await client;
+    r.record(*d);
+    ++r.operations;
+  }
+  socket.shutdown(tcp::socket::shutdown_send);
+}
+
+result echo_model_coro(const options& opts)
+{
+  return run_tcp_echo(opts,
+      [](tcp::socket& client, tcp::socket& server, std::size_t n, result& r)
+      {
+        asio::experimental::co_spawn(
+            coro_echo_server(server.get_executor(), server), asio::detached);
+        asio::experimental::co_spawn(
+            coro_echo_driver(client.get_executor(), client, n, r),
+            asio::detached);
+      });
+}
+
+asio::experimental::coro<std::size_t> posting_generator(
+    asio::any_io_executor ex)
+{
+  for (std::size_t i = 0;; ++i)
+  {
+    co_await asio::post(ex, asio::deferred);
+    co_yield i;
+  }
+}
+
+asio::awaitable<void> generator_loop(std::size_t n, std::size_t& count)
+{
+  auto ex = co_await asio::this_coro::executor;
+  auto generator = posting_generator(ex);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    co_await generator.async_resume(asio::use_awaitable);
+    ++count;
+  }
+}
+
+// Resumes a generator coroutine that yields from the completion of a posted
+// operation, measuring the cost of delivering each yielded value.
+result coro_generator_resume(const options& opts)
+{
+  const std::size_t n = opts.iterations(1000000);
+  asio::io_context ctx(1);
+  std::size_t count = 0;
+
+  result r;
+  clock_type::time_point start = clock_type::now();
+  asio::co_spawn(ctx, generator_loop(n, count), asio::detached);
+  ctx.run();
+  r.elapsed = clock_type::now() - start;
+  r.operations = count;
+  return r;
+}
+
+#endif // defined(ASIO_HAS_STD_COROUTINE)
+
+#if defined(BENCHMARK_ENABLE_SPAWN)
+
+void spawn_echo_server(tcp::socket& socket, asio::yield_context yield)
+{
+  char data[echo_message_size];
+  for (;;)
+  {
+    asio::error_code ec;
+    std::size_t n = asio::async_read(socket,
+        asio::buffer(data), yield[ec]);
+    if (ec)
+      return;
+    asio::async_write(socket, asio::buffer(data, n), yield);
+  }
+}
+
+void spawn_echo_client(tcp::socket& socket,
+    std::size_t n, result& r, asio::yield_context yield)
+{
+  char data[echo_message_size] = {};
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    clock_type::time_point start = clock_type::now();
+    asio::async_write(socket, asio::buffer(data), yield);
+    asio::async_read(socket, asio::buffer(data), yield);
+    r.record(clock_type::now() - start);
+    ++r.operations;
+  }
+  socket.shutdown(tcp::socket::shutdown_send);
+}
+
+result echo_model_spawn(const options& opts)
+{
+  return run_tcp_echo(opts,
+      [](tcp::socket& client, tcp::socket& server, std::size_t n, result& r)
+      {
+        asio::spawn(server.get_executor(),
+            [&server](asio::yield_context yield)
+            {
+              spawn_echo_server(server, yield);
+            }, asio::detached);
+        asio::spawn(client.get_executor(),
+            [&client, n, &r](asio::yield_context yield)
+            {
+              spawn_echo_client(client, n, r, yield);
+            }, asio::detached);
+      });
+}
+
+#endif // defined(BENCHMARK_ENABLE_SPAWN)
+
+//------------------------------------------------------------------------------
+
+struct benchmark
+{
+  const char* name;
+  result (*function)(const options&);
+};
+
+const benchmark benchmarks[] =
+{
+  { "post_throughput", &post_throughput },
+  { "post_chain_throughput", &post_chain_throughput },
+  { "dispatch_throughput", &dispatch_throughput },
+  { "strand_contention", &strand_contention },
+  { "timer_insert", &timer_insert },
+  { "timer_cancel", &timer_cancel },
+  { "timer_rearm", &timer_rearm },
+  { "timeout_timer_rearm", &timeout_timer_rearm },
+  { "tcp_echo_latency", &tcp_echo_latency },
+  { "udp_echo_latency", &udp_echo_latency },
+  { "tcp_write_backpressure", &tcp_write_backpressure },
+#if defined(BENCHMARK_ENABLE_SSL)
+  { "ssl_handshake_rate", &ssl_handshake_rate },
+#endif // defined(BENCHMARK_ENABLE_SSL)
+  { "channel_throughput", &channel_throughput },
+#if defined(ASIO_HAS_CO_AWAIT)
+  { "coroutine_call", &coroutine_call },
+  { "coroutine_post_resume", &coroutine_post_resume },
+#endif // defined(ASIO_HAS_CO_AWAIT)
+#if defined(ASIO_HAS_STD_COROUTINE)
+  { "coro_generator_resume", &coro_generator_resume },
+#endif // defined(ASIO_HAS_STD_COROUTINE)
+  { "echo_model_callback", &echo_model_callback },
+#if defined(ASIO_HAS_CO_AWAIT)
+  { "echo_model_awaitable", &echo_model_awaitable },
+#endif // defined(ASIO_HAS_CO_AWAIT)
+#if defined(ASIO_HAS_STD_COROUTINE)
+  { "echo_model_coro", &echo_model_coro },
+#endif // defined(ASIO_HAS_STD_COROUTINE)
+#if defined(BENCHMARK_ENABLE_SPAWN)
+  { "echo_model_spawn", &echo_model_spawn },
+#endif // defined(BENCHMARK_ENABLE_SPAWN)
+};
+
+bool selected(const options& opts, const char* name)
+{
+  if (opts.names.empty())
+    return true;
+  for (const std::string& n : opts.names)
+    if (std::strstr(name, n.c_str()))
+      return true;
+  return false;
+}
+
+void print_result(const char* name, const result& r, bool first)
+{
+  long long elapsed_ns = static_cast<long long>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(r.elapsed).count());
+  double seconds = elapsed_ns / 1e9;
+
+  std::printf("%s\n    {\n", first ? "" : ",");
+  std::printf("      \"name\": \"%s\",\n", name);
+  std::printf("      \"threads\": %lu,\n",
+      static_cast<unsigned long>(r.threads));
+  std::printf("      \"operations\": %lu,\n",
+      static_cast<unsigned long>(r.operations));
+  std::printf("      \"elapsed_ns\": %lld,\n", elapsed_ns);
+  std::printf("      \"operations_per_second\": %.1f,\n",
+      seconds > 0 ? r.operations / seconds : 0.0);
+  std::printf("      \"ns_per_operation\": %.1f",
+      r.operations ? static_cast<double>(elapsed_ns) / r.operations : 0.0);
+
+  if (r.has_latency)
+  {
+    const asio::latency_histogram& h = r.latency;
+    std::printf(",\n      \"latency_ns\": {\n");
+    std::printf("        \"min\": %lld,\n",
+        static_cast<long long>(h.min_value().count()));
+    std::printf("        \"mean\": %lld,\n",
+        static_cast<long long>(h.mean().count()));
+    std::printf("        \"p50\": %lld,\n",
+        static_cast<long long>(h.value_at_percentile(50).count()));
+    std::printf("        \"p90\": %lld,\n",
+        static_cast<long long>(h.value_at_percentile(90).count()));
+    std::printf("        \"p99\": %lld,\n",
+        static_cast<long long>(h.value_at_percentile(99).count()));
+    std::printf("        \"p99.9\": %lld,\n",
+        static_cast<long long>(h.value_at_percentile(99.9).count()));
+    std::printf("        \"max\": %lld\n",
+        static_cast<long long>(h.max_value().count()));
+    std::printf("      }");
+  }
+
+  std::printf("\n    }");
+  std::fflush(stdout);
+}
+
+int main(int argc, char* argv[])
+{
+  options opts;
+  bool list = false;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    if (std::strcmp(argv[i], "--list") == 0)
+      list = true;
+    else if (std::strncmp(argv[i], "--scale=", 8) == 0)
+      opts.scale = std::atof(argv[i] + 8);
+    else if (std::strncmp(argv[i], "--threads=", 10) == 0)
+      opts.threads = static_cast<std::size_t>(std::atoi(argv[i] + 10));
+    else if (argv[i][0] == '-')
+    {
+      std::fprintf(stderr, "Usage: benchmark [--list] [--scale=<factor>]"
+          " [--threads=<n>] [<name>...]\n");
+      return 1;
+    }
+    else
+      opts.names.push_back(argv[i]);
+  }
+
+  if (list)
+  {
+    for (const benchmark& b : benchmarks)
+      std::printf("%s\n", b.name);
+    return 0;
+  }
+
+  if (opts.threads == 0)
+  {
+    opts.threads = std::thread::hardware_concurrency();
+    if (opts.threads < 2)
+      opts.threads = 2;
+  }
+
+  std::printf("{\n");
+  std::printf("  \"asio_version\": \"%d.%d.%d\",\n", ASIO_VERSION / 100000,
+      ASIO_VERSION / 100 % 1000, ASIO_VERSION % 100);
+  std::printf("  \"backend\": \"%s\",\n", backend_name());
+  std::printf("  \"hardware_concurrency\": %u,\n",
+      std::thread::hardware_concurrency());
+  std::printf("  \"scale\": %g,\n", opts.scale);
+  std::printf("  \"benchmarks\": [");
+
+  bool first = true;
+  for (const benchmark& b : benchmarks)
+  {
+    if (selected(opts, b.name))
+    {
+      std::fprintf(stderr, "Running %s...\n", b.name);
+      try
+      {
+        result r = b.function(opts);
+        print_result(b.name, r, first);
+        first = false;
+      }
+      catch (std::exception& e)
+      {
+        std::fprintf(stderr, "%s: %s\n", b.name, e.what());
+      }
+    }
+  }
+
+  std::printf("\n  ]\n}\n");
+  return 0;
+}
@@ -0,0 +1,277 @@
+//
+// harness.hpp
+// ~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef HARNESS_HPP
+#define HARNESS_HPP
+
+#include <asio/io_context.hpp>
+#include <asio/latency_histogram.hpp>
+#include <asio/steady_timer.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__linux__)
+# include <pthread.h>
+# include <sched.h>
+#endif // defined(__linux__)
+
+typedef std::chrono::steady_clock latency_clock;
+
+// The options that may follow the positional arguments of the latency
+// clients and servers.
+struct latency_options
+{
+  latency_options()
+    : rate(0),
+      samples(100000),
+      cpu(-1),
+      report(0)
+  {
+  }
+
+  // Parse the arguments from first onwards. Returns false if an argument is
+  // not recognised.
+  bool parse(int argc, char* argv[], int first)
+  {
+    for (int i = first; i < argc; ++i)
+    {
+      const char* arg = argv[i];
+      if (std::strncmp(arg, "--rate=", 7) == 0)
+        rate = std::atof(arg + 7);
+      else if (std::strncmp(arg, "--samples=", 10) == 0)
+        samples = static_cast<std::size_t>(std::atol(arg + 10));
+      else if (std::strncmp(arg, "--cpu=", 6) == 0)
+        cpu = std::atoi(arg + 6);
+      else if (std::strncmp(arg, "--report=", 9) == 0)
+        report = std::atoi(arg + 9);
+      else
+        return false;
+    }
+    return samples > 0;
+  }
+
+  // The number of requests per second to send on a fixed schedule, whether or
+  // not earlier replies have arrived. When zero, each request is sent when the
+  // reply to the previous one has been received.
+  double rate;
+
+  // The number of requests to send.
+  std::size_t samples;
+
+  // The CPU to which the calling thread is pinned, or -1 to leave it unpinned.
+  int cpu;
+
+  // The number of seconds between reports of server-side latency, or zero to
+  // disable them.
+  int report;
+};
+
+// Pin the calling thread to the specified CPU.
+inline void pin_thread(int cpu)
+{
+  if (cpu < 0)
+    return;
+
+#if defined(__linux__)
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu, &cpus);
+  if (::pthread_setaffinity_np(::pthread_self(), sizeof(cpus), &cpus) != 0)
+  {
+    std::fprintf(stderr, "Unable to pin thread to CPU %d\n", cpu);
+    std::exit(1);
+  }
+#else // defined(__linux__)
+  std::fprintf(stderr, "CPU pinning is not supported on this platform\n");
+#endif // defined(__linux__)
+}
+
+// Calculates the times at which requests are to be sent at a constant rate.
+// Latency is measured from these intended times, rather than from the time
+// at which each request was actually sent, so that a stall in the client or
+// server is charged to every request that it delayed.
+class send_schedule
+{
+public:
+  send_schedule(double rate, latency_clock::time_point start)
+    : rate_(rate),
+      start_(start)
+  {
+  }
+
+  latency_clock::time_point operator[](std::size_t i) const
+  {
+    return start_ + std::chrono::duration_cast<latency_clock::duration>(
+        std::chrono::duration<double>(i / rate_));
+  }
+
+private:
+  double rate_;
+  latency_clock::time_point start_;
+};
+
+// Runs an io_context until a handler has run or a scheduled time is reached.
+// Unlike io_context::run_one_until(), which may round the wait up to a whole
+// number of milliseconds, the wakeup is scheduled using a timer.
+class wakeup_timer
+{
+public:
+  explicit wakeup_timer(asio::io_context& io_context)
+    : io_context_(io_context),
+      timer_(io_context),
+      armed_(false)
+  {
+  }
+
+  void run_one_until(latency_clock::time_point t)
+  {
+    if (t <= latency_clock::now())
+    {
+      io_context_.poll();
+      return;
+    }
+
+    if (!armed_ || timer_.expiry() != t)
+    {
+      timer_.expires_at(t);
+      armed_ = true;
+      timer_.async_wait(
+          [this](asio::error_code ec)
+          {
+            if (!ec)
+              armed_ = false;
+          });
+    }
+
+    io_context_.run_one();
+  }
+
+private:
+  asio::io_context& io_context_;
+  asio::steady_timer timer_;
+  bool armed_;
+};
+
+inline double to_usec(std::chrono::nanoseconds ns)
+{
+  return ns.count() / 1000.0;
+}
+
+// Print the distribution of round trip times, in microseconds.
+inline void print_latency(const asio::latency_histogram& h,
+    double elapsed_sec, std::size_t lost = 0)
+{
+  std::printf("  0.0%%\t%f\n", to_usec(h.min_value()));
+  std::printf(" 50.0%%\t%f\n", to_usec(h.value_at_percentile(50)));
+  std::printf(" 90.0%%\t%f\n", to_usec(h.value_at_percentile(90)));
+  std::printf(" 99.0%%\t%f\n", to_usec(h.value_at_percentile(99)));
+  std::printf(" 99.9%%\t%f\n", to_usec(h.value_at_percentile(99.9)));
+  std::printf("99.99%%\t%f\n", to_usec(h.value_at_percentile(99.99)));
+  std::printf("100.0%%\t%f\n", to_usec(h.max_value()));
+  std::printf("  mean\t%f\n", to_usec(h.mean()));
+  std::printf(" count\t%llu\n",
+      static_cast<unsigned long long>(h.total_count()));
+  if (lost)
+    std::printf("  lost\t%llu\n", static_cast<unsigned long long>(lost));
+  std::printf("  rate\t%f\n",
+      elapsed_sec > 0 ? h.total_count() / elapsed_sec : 0.0);
+}
+
+// Print how far behind schedule the client sent its requests. If the lag is
+// comparable to the round trip times, the client could not sustain the rate
+// and the results describe the client rather than the server.
+inline void print_send_lag(const asio::latency_histogram& h)
+{
+  std::printf("send lag p99 %f usec, p99.9 %f usec, max %f usec\n",
+      to_usec(h.value_at_percentile(99)),
+      to_usec(h.value_at_percentile(99.9)),
+      to_usec(h.max_value()));
+}
+
+// Print the time that the server's operations spent in the backend, as
+// recorded by the io_context. These are only available when the server is
+// built with ASIO_ENABLE_LATENCY_HISTOGRAMS defined.
+inline void print_server_latency(asio::io_context& io_context)
+{
+  static const struct { const char* name;
+    asio::io_context::latency_operation op; } ops[] =
+  {
+    { "receive", asio::io_context::receive_operation },
+    { "send", asio::io_context::send_operation },
+    { "accept", asio::io_context::accept_operation }
+  };
+
+  bool any = false;
+  for (std::size_t i = 0; i < sizeof(ops) / sizeof(ops[0]); ++i)
+  {
+    asio::io_context::operation_latency l =
+      io_context.get_operation_latency(ops[i].op);
+    if (l.completion.total_count() == 0 && l.invocation.total_count() == 0)
+      continue;
+
+    any = true;
+    const asio::latency_histogram* h[2] = { &l.completion, &l.invocation };
+    const char* stage[2] = { "completion", "invocation" };
+    for (int j = 0; j < 2; ++j)
+    {
+      std::printf("%-8s %-10s p50 %10.1f  p99 %10.1f  p99.9 %10.1f"
+          "  max %10.1f usec  (%llu)\n", ops[i].name, stage[j],
+          to_usec(h[j]->value_at_percentile(50)),
+          to_usec(h[j]->value_at_percentile(99)),
+          to_usec(h[j]->value_at_percentile(99.9)),
+          to_usec(h[j]->max_value()),
+          static_cast<unsigned long long>(h[j]->total_count()));
+    }
+  }
+
+  if (!any)
+    std::printf("no server-side latencies recorded "
+        "(build with ASIO_ENABLE_LATENCY_HISTOGRAMS)\n");
+  std::fflush(stdout);
+}
+
+// Periodically prints the server-side latency.
+class latency_reporter
+{
+public:
+  latency_reporter(asio::io_context& io_context, int interval)
+    : io_context_(io_context),
+      timer_(io_context),
+      interval_(interval)
+  {
+    start();
+  }
+
+private:
+  void start()
+  {
+    if (interval_ > 0)
+    {
+      timer_.expires_after(std::chrono::seconds(interval_));
+      timer_.async_wait(
+          [this](asio::error_code ec)
+          {
+            if (!ec)
+            {
+              print_server_latency(io_context_);
+              start();
+            }
+          });
+    }
+  }
+
+  asio::io_context& io_context_;
+  asio::steady_timer timer_;
+  int interval_;
+};
+
+#endif // HARNESS_HPP
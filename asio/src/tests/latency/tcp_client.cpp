@@ -11,19 +11,15 @@
 #include <asio/ip/tcp.hpp>
 #include <asio/read.hpp>
 #include <asio/write.hpp>
-#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/shared_ptr.hpp>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <vector>
-#include "high_res_clock.hpp"
+#include "harness.hpp"
 
 using asio::ip::tcp;
-using boost::posix_time::ptime;
-using boost::posix_time::microsec_clock;
-
-const int num_samples = 100000;
 
 struct transfer_all
 {
@@ -34,13 +30,84 @@ struct transfer_all
   }
 };
 
+// A connection on which requests are written when they are due, and replies
+// are read as they arrive, so that a slow reply does not delay the requests
+// that follow it.
+class connection
+{
+public:
+  connection(tcp::socket& socket, std::size_t buf_size,
+      asio::latency_histogram& latency)
+    : socket_(socket),
+      write_buf_(buf_size),
+      read_buf_(buf_size),
+      unwritten_(0),
+      writing_(false),
+      latency_(latency)
+  {
+    start_read();
+  }
+
+  // Send a request that was due at the specified time.
+  void send(latency_clock::time_point due)
+  {
+    due_.push_back(due);
+    ++unwritten_;
+    if (!writing_)
+      start_write();
+  }
+
+private:
+  void start_write()
+  {
+    writing_ = true;
+    --unwritten_;
+    asio::async_write(socket_, asio::buffer(write_buf_),
+        [this](asio::error_code ec, std::size_t)
+        {
+          writing_ = false;
+          if (!ec && unwritten_ > 0)
+            start_write();
+        });
+  }
+
+  void start_read()
+  {
+    asio::async_read(socket_, asio::buffer(read_buf_),
+        [this](asio::error_code ec, std::size_t)
+        {
+          if (!ec && !due_.empty())
+          {
+            latency_.record(latency_clock::now() - due_.front());
+            due_.pop_front();
+            start_read();
+          }
+        });
+  }
+
+  tcp::socket& socket_;
+  std::vector<unsigned char> write_buf_;
+  std::vector<unsigned char> read_buf_;
+
+  // The times at which the requests awaiting replies were due, oldest first.
+  std::deque<latency_clock::time_point> due_;
+
+  // The number of requests that have yet to be written.
+  std::size_t unwritten_;
+
+  bool writing_;
+  asio::latency_histogram& latency_;
+};
+
 int main(int argc, char* argv[])
 {
-  if (argc != 6)
+  latency_options options;
+  if (argc < 6 || !options.parse(argc, argv, 6))
   {
     std::fprintf(stderr,
         "Usage: tcp_client <ip> <port> "
-        "<nconns> <bufsize> {spin|block}\n");
+        "<nconns> <bufsize> {spin|block} "
+        "[--rate=<requests/sec>] [--samples=<n>] [--cpu=<n>]\n");
     return 1;
   }
 
@@ -49,6 +116,9 @@ int main(int argc, char* argv[])
   int num_connections = std::atoi(argv[3]);
   std::size_t buf_size = static_cast<std::size_t>(std::atoi(argv[4]));
   bool spin = (std::strcmp(argv[5], "spin") == 0);
+  std::size_t num_samples = options.samples;
+
+  pin_thread(options.cpu);
 
   asio::io_context io_context;
   std::vector<boost::shared_ptr<tcp::socket> > sockets;
@@ -62,7 +132,7 @@ int main(int argc, char* argv[])
 
     s->set_option(tcp::no_delay(true));
 
-    if (spin)
+    if (spin && options.rate == 0)
     {
       s->non_blocking(true);
     }
@@ -70,55 +140,74 @@ int main(int argc, char* argv[])
     sockets.push_back(s);
   }
 
-  std::vector<unsigned char> write_buf(buf_size);
-  std::vector<unsigned char> read_buf(buf_size);
-
-  ptime start = microsec_clock::universal_time();
-  boost::uint64_t start_hr = high_res_clock();
+  asio::latency_histogram latency;
+  asio::latency_histogram send_lag;
+  latency_clock::time_point start = latency_clock::now();
 
-  boost::uint64_t samples[num_samples];
-  for (int i = 0; i < num_samples; ++i)
+  if (options.rate == 0)
   {
-    tcp::socket& socket = *sockets[i % num_connections];
+    // Closed loop: each request is sent when the previous reply arrives.
+    std::vector<unsigned char> write_buf(buf_size);
+    std::vector<unsigned char> read_buf(buf_size);
+
+    for (std::size_t i = 0; i < num_samples; ++i)
+    {
+      tcp::socket& socket = *sockets[i % num_connections];
+
+      latency_clock::time_point t = latency_clock::now();
+
+      asio::error_code ec;
+      asio::write(socket,
+          asio::buffer(write_buf),
+          transfer_all(), ec);
 
-    boost::uint64_t t = high_res_clock();
+      asio::read(socket,
+          asio::buffer(read_buf),
+          transfer_all(), ec);
 
-    asio::error_code ec;
-    asio::write(socket,
-        asio::buffer(write_buf),
-        transfer_all(), ec);
+      latency.record(latency_clock::now() - t);
+    }
+  }
+  else
+  {
+    // Open loop: requests are sent at a constant rate, spread across the
+    // connections, and each round trip is timed from when it was due.
+    std::vector<boost::shared_ptr<connection> > connections;
+    for (int i = 0; i < num_connections; ++i)
+    {
+      connections.push_back(boost::shared_ptr<connection>(
+            new connection(*sockets[i], buf_size, latency)));
+    }
 
-    asio::read(socket,
-        asio::buffer(read_buf),
-        transfer_all(), ec);
+    send_schedule schedule(options.rate, start);
+    wakeup_timer wakeup(io_context);
+    std::size_t sent = 0;
+    while (latency.total_count() < num_samples)
+    {
+      latency_clock::time_point now = latency_clock::now();
+      for (; sent < num_samples && schedule[sent] <= now; ++sent)
+      {
+        send_lag.record(now - schedule[sent]);
+        connections[sent % num_connections]->send(schedule[sent]);
+      }
+
+      if (spin)
+        io_context.poll();
+      else if (sent < num_samples)
+        wakeup.run_one_until(schedule[sent]);
+      else
+        io_context.run_one();
+    }
 
-    samples[i] = high_res_clock() - t;
+    for (int i = 0; i < num_connections; ++i)
+      sockets[i]->close();
+    io_context.poll();
   }
 
-  ptime stop = microsec_clock::universal_time();
-  boost::uint64_t stop_hr = high_res_clock();
-  boost::uint64_t elapsed_usec = (stop - start).total_microseconds();
-  boost::uint64_t elapsed_hr = stop_hr - start_hr;
-  double scale = 1.0 * elapsed_usec / elapsed_hr;
-
-  std::sort(samples, samples + num_samples);
-  std::printf("  0.0%%\t%f\n", samples[0] * scale);
-  std::printf("  0.1%%\t%f\n", samples[num_samples / 1000 - 1] * scale);
-  std::printf("  1.0%%\t%f\n", samples[num_samples / 100 - 1] * scale);
-  std::printf(" 10.0%%\t%f\n", samples[num_samples / 10 - 1] * scale);
-  std::printf(" 20.0%%\t%f\n", samples[num_samples * 2 / 10 - 1] * scale);
-  std::printf(" 30.0%%\t%f\n", samples[num_samples * 3 / 10 - 1] * scale);
-  std::printf(" 40.0%%\t%f\n", samples[num_samples * 4 / 10 - 1] * scale);
-  std::printf(" 50.0%%\t%f\n", samples[num_samples * 5 / 10 - 1] * scale);
-  std::printf(" 60.0%%\t%f\n", samples[num_samples * 6 / 10 - 1] * scale);
-  std::printf(" 70.0%%\t%f\n", samples[num_samples * 7 / 10 - 1] * scale);
-  std::printf(" 80.0%%\t%f\n", samples[num_samples * 8 / 10 - 1] * scale);
-  std::printf(" 90.0%%\t%f\n", samples[num_samples * 9 / 10 - 1] * scale);
-  std::printf(" 99.0%%\t%f\n", samples[num_samples * 99 / 100 - 1] * scale);
-  std::printf(" 99.9%%\t%f\n", samples[num_samples * 999 / 1000 - 1] * scale);
-  std::printf("100.0%%\t%f\n", samples[num_samples - 1] * scale);
-
-  double total = 0.0;
-  for (int i = 0; i < num_samples; ++i) total += samples[i] * scale;
-  std::printf("  mean\t%f\n", total / num_samples);
+  double elapsed = std::chrono::duration<double>(
+      latency_clock::now() - start).count();
+
+  print_latency(latency, elapsed);
+  if (options.rate != 0)
+    print_send_lag(send_lag);
 }
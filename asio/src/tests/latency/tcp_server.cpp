@@ -17,6 +17,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <vector>
+#include "harness.hpp"
 
 using asio::ip::tcp;
 
@@ -83,11 +84,13 @@ private:
 
 int main(int argc, char* argv[])
 {
-  if (argc != 5)
+  latency_options options;
+  if (argc < 5 || !options.parse(argc, argv, 5))
   {
     std::fprintf(stderr,
         "Usage: tcp_server <port> <nconns> "
-        "<bufsize> {spin|block}\n");
+        "<bufsize> {spin|block} "
+        "[--cpu=<n>] [--report=<seconds>]\n");
     return 1;
   }
 
@@ -107,6 +110,9 @@ int main(int argc, char* argv[])
     (*s)(asio::error_code());
   }
 
+  pin_thread(options.cpu);
+  latency_reporter reporter(io_context, options.report);
+
   if (spin)
     for (;;) io_context.poll();
   else
@@ -9,27 +9,87 @@
 //
 
 #include <asio/ip/udp.hpp>
-#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <vector>
-#include "high_res_clock.hpp"
+#include "harness.hpp"
 
 using asio::ip::udp;
-using boost::posix_time::ptime;
-using boost::posix_time::microsec_clock;
 
-const int num_samples = 100000;
+// The time to wait for outstanding replies after the last request is sent.
+const std::chrono::seconds reply_timeout(1);
+
+// Receives replies to requests that are sent on a schedule. Each request
+// carries its sequence number, which the server returns inverted.
+class receiver
+{
+public:
+  receiver(udp::socket& socket, std::size_t buf_size,
+      const send_schedule& schedule, std::size_t num_samples,
+      asio::latency_histogram& latency)
+    : socket_(socket),
+      read_buf_(buf_size),
+      schedule_(schedule),
+      received_(num_samples),
+      last_reply_(latency_clock::now()),
+      latency_(latency)
+  {
+    start_receive();
+  }
+
+  latency_clock::time_point last_reply() const
+  {
+    return last_reply_;
+  }
+
+private:
+  void start_receive()
+  {
+    socket_.async_receive(asio::buffer(read_buf_),
+        [this](asio::error_code ec, std::size_t n)
+        {
+          if (ec == asio::error::operation_aborted)
+            return;
+
+          if (!ec && n >= sizeof(std::size_t))
+          {
+            last_reply_ = latency_clock::now();
+
+            std::size_t seq;
+            for (std::size_t i = 0; i < sizeof(seq); ++i)
+              read_buf_[i] = ~read_buf_[i];
+            std::memcpy(&seq, &read_buf_[0], sizeof(seq));
+
+            if (seq < received_.size() && !received_[seq])
+            {
+              received_[seq] = true;
+              latency_.record(last_reply_ - schedule_[seq]);
+            }
+          }
+
+          start_receive();
+        });
+  }
+
+  udp::socket& socket_;
+  std::vector<unsigned char> read_buf_;
+  send_schedule schedule_;
+  std::vector<bool> received_;
+  latency_clock::time_point last_reply_;
+  asio::latency_histogram& latency_;
+};
 
 int main(int argc, char* argv[])
 {
-  if (argc != 6)
+  latency_options options;
+  if (argc < 6 || !options.parse(argc, argv, 6))
   {
     std::fprintf(stderr,
         "Usage: udp_client <ip> <port1> "
-        "<nports> <bufsize> {spin|block}\n");
+        "<nports> <bufsize> {spin|block} "
+        "[--rate=<requests/sec>] [--samples=<n>] [--cpu=<n>]\n");
     return 1;
   }
 
@@ -38,12 +98,22 @@ int main(int argc, char* argv[])
   unsigned short num_ports = static_cast<unsigned short>(std::atoi(argv[3]));
   std::size_t buf_size = static_cast<std::size_t>(std::atoi(argv[4]));
   bool spin = (std::strcmp(argv[5], "spin") == 0);
+  std::size_t num_samples = options.samples;
+
+  if (options.rate != 0 && buf_size < sizeof(std::size_t))
+  {
+    std::fprintf(stderr, "bufsize must be at least %d with --rate\n",
+        static_cast<int>(sizeof(std::size_t)));
+    return 1;
+  }
+
+  pin_thread(options.cpu);
 
   asio::io_context io_context;
 
   udp::socket socket(io_context, udp::endpoint(udp::v4(), 0));
 
-  if (spin)
+  if (spin && options.rate == 0)
   {
     socket.non_blocking(true);
   }
@@ -53,52 +123,79 @@ int main(int argc, char* argv[])
   std::vector<unsigned char> write_buf(buf_size);
   std::vector<unsigned char> read_buf(buf_size);
 
-  ptime start = microsec_clock::universal_time();
-  boost::uint64_t start_hr = high_res_clock();
+  asio::latency_histogram latency;
+  asio::latency_histogram send_lag;
+  latency_clock::time_point start = latency_clock::now();
 
-  boost::uint64_t samples[num_samples];
-  for (int i = 0; i < num_samples; ++i)
+  if (options.rate == 0)
   {
-    boost::uint64_t t = high_res_clock();
+    // Closed loop: each request is sent when the previous reply arrives.
+    for (std::size_t i = 0; i < num_samples; ++i)
+    {
+      latency_clock::time_point t = latency_clock::now();
 
-    asio::error_code ec;
-    socket.send_to(asio::buffer(write_buf), target, 0, ec);
+      asio::error_code ec;
+      socket.send_to(asio::buffer(write_buf), target, 0, ec);
 
-    do socket.receive(asio::buffer(read_buf), 0, ec);
-    while (ec == asio::error::would_block);
+      do socket.receive(asio::buffer(read_buf), 0, ec);
+      while (ec == asio::error::would_block);
 
-    samples[i] = high_res_clock() - t;
+      latency.record(latency_clock::now() - t);
 
-    if (target.port() == last_port)
-      target.port(first_port);
-    else
-      target.port(target.port() + 1);
+      if (target.port() == last_port)
+        target.port(first_port);
+      else
+        target.port(target.port() + 1);
+    }
+  }
+  else
+  {
+    // Open loop: requests are sent at a constant rate, and each round trip is
+    // timed from when the request was due. Requests whose replies have not
+    // arrived within the timeout are counted as lost.
+    send_schedule schedule(options.rate, start);
+    receiver r(socket, buf_size, schedule, num_samples, latency);
+    wakeup_timer wakeup(io_context);
+
+    std::size_t sent = 0;
+    while (latency.total_count() < num_samples)
+    {
+      latency_clock::time_point now = latency_clock::now();
+      for (; sent < num_samples && schedule[sent] <= now; ++sent)
+      {
+        send_lag.record(now - schedule[sent]);
+        std::memcpy(&write_buf[0], &sent, sizeof(sent));
+
+        asio::error_code ec;
+        socket.send_to(asio::buffer(write_buf), target, 0, ec);
+
+        if (target.port() == last_port)
+          target.port(first_port);
+        else
+          target.port(target.port() + 1);
+      }
+
+      latency_clock::time_point wake;
+      if (sent < num_samples)
+        wake = schedule[sent];
+      else if ((wake = (std::max)(r.last_reply(),
+              schedule[num_samples - 1]) + reply_timeout) <= now)
+        break;
+
+      if (spin)
+        io_context.poll();
+      else
+        wakeup.run_one_until(wake);
+    }
+
+    socket.close();
+    io_context.poll();
   }
 
-  ptime stop = microsec_clock::universal_time();
-  boost::uint64_t stop_hr = high_res_clock();
-  boost::uint64_t elapsed_usec = (stop - start).total_microseconds();
-  boost::uint64_t elapsed_hr = stop_hr - start_hr;
-  double scale = 1.0 * elapsed_usec / elapsed_hr;
-
-  std::sort(samples, samples + num_samples);
-  std::printf("  0.0%%\t%f\n", samples[0] * scale);
-  std::printf("  0.1%%\t%f\n", samples[num_samples / 1000 - 1] * scale);
-  std::printf("  1.0%%\t%f\n", samples[num_samples / 100 - 1] * scale);
-  std::printf(" 10.0%%\t%f\n", samples[num_samples / 10 - 1] * scale);
-  std::printf(" 20.0%%\t%f\n", samples[num_samples * 2 / 10 - 1] * scale);
-  std::printf(" 30.0%%\t%f\n", samples[num_samples * 3 / 10 - 1] * scale);
-  std::printf(" 40.0%%\t%f\n", samples[num_samples * 4 / 10 - 1] * scale);
-  std::printf(" 50.0%%\t%f\n", samples[num_samples * 5 / 10 - 1] * scale);
-  std::printf(" 60.0%%\t%f\n", samples[num_samples * 6 / 10 - 1] * scale);
-  std::printf(" 70.0%%\t%f\n", samples[num_samples * 7 / 10 - 1] * scale);
-  std::printf(" 80.0%%\t%f\n", samples[num_samples * 8 / 10 - 1] * scale);
-  std::printf(" 90.0%%\t%f\n", samples[num_samples * 9 / 10 - 1] * scale);
-  std::printf(" 99.0%%\t%f\n", samples[num_samples * 99 / 100 - 1] * scale);
-  std::printf(" 99.9%%\t%f\n", samples[num_samples * 999 / 1000 - 1] * scale);
-  std::printf("100.0%%\t%f\n", samples[num_samples - 1] * scale);
-
-  double total = 0.0;
-  for (int i = 0; i < num_samples; ++i) total += samples[i] * scale;
-  std::printf("  mean\t%f\n", total / num_samples);
+  double elapsed = std::chrono::duration<double>(
+      latency_clock::now() - start).count();
+
+  print_latency(latency, elapsed, num_samples - latency.total_count());
+  if (options.rate != 0)
+    print_send_lag(send_lag);
 }
@@ -8,6 +8,7 @@
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 //
 
+#include <asio/config.hpp>
 #include <asio/io_context.hpp>
 #include <asio/ip/udp.hpp>
 #include <boost/shared_ptr.hpp>
@@ -16,6 +17,7 @@
 #include <cstring>
 #include <vector>
 #include "allocator.hpp"
+#include "harness.hpp"
 
 using asio::ip::udp;
 
@@ -94,11 +96,13 @@ private:
 
 int main(int argc, char* argv[])
 {
-  if (argc != 5)
+  latency_options options;
+  if (argc < 5 || !options.parse(argc, argv, 5))
   {
     std::fprintf(stderr,
         "Usage: udp_server <port1> <nports> "
-        "<bufsize> {spin|block}\n");
+        "<bufsize> {spin|block|busypoll} "
+        "[--cpu=<n>] [--report=<seconds>]\n");
     return 1;
   }
 
@@ -106,8 +110,11 @@ int main(int argc, char* argv[])
   unsigned short num_ports = static_cast<unsigned short>(std::atoi(argv[2]));
   std::size_t buf_size = std::atoi(argv[3]);
   bool spin = (std::strcmp(argv[4], "spin") == 0);
+  bool busy_poll = (std::strcmp(argv[4], "busypoll") == 0);
 
-  asio::io_context io_context(1);
+  asio::io_context io_context(asio::config_from_string(busy_poll
+        ? "scheduler.concurrency_hint=1\nscheduler.busy_poll_usec=1000"
+        : "scheduler.concurrency_hint=1"));
   std::vector<boost::shared_ptr<udp_server> > servers;
 
   for (unsigned short i = 0; i < num_ports; ++i)
@@ -118,6 +125,9 @@ int main(int argc, char* argv[])
     (*s)(asio::error_code());
   }
 
+  pin_thread(options.cpu);
+  latency_reporter reporter(io_context, options.report);
+
   if (spin)
     for (;;) io_context.poll();
   else
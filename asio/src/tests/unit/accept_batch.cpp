@@ -0,0 +1,249 @@
+//
+// accept_batch.cpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/accept_batch.hpp"
+
+#include <vector>
+#include "archetypes/async_result.hpp"
+#include "asio/bind_cancellation_slot.hpp"
+#include "asio/cancellation_signal.hpp"
+#include "asio/io_context.hpp"
+#include "asio/io_context_pool.hpp"
+#include "asio/ip/tcp.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// accept_batch_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the async_accept_batch function compiles.
+// Runtime failures are ignored.
+
+namespace accept_batch_compile {
+
+struct accept_batch_handler
+{
+  accept_batch_handler() {}
+  void operator()(const asio::error_code&,
+      std::vector<asio::ip::tcp::socket>) {}
+  accept_batch_handler(accept_batch_handler&&) {}
+private:
+  accept_batch_handler(const accept_batch_handler&);
+};
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    io_context_pool pool(1);
+    archetypes::lazy_handler lazy;
+
+    ip::tcp::acceptor acceptor1(ioc);
+
+    async_accept_batch(acceptor1, 16, accept_batch_handler());
+    async_accept_batch(acceptor1, 16, pool, accept_batch_handler());
+    int i1 = async_accept_batch(acceptor1, 16, lazy);
+    (void)i1;
+    int i2 = async_accept_batch(acceptor1, 16, pool, lazy);
+    (void)i2;
+
+    ioc.run();
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace accept_batch_compile
+
+//------------------------------------------------------------------------------
+
+// accept_batch_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the async_accept_batch
+// function.
+
+namespace accept_batch_runtime {
+
+using asio::ip::tcp;
+
+struct accept_batch_test
+{
+  accept_batch_test()
+    : acceptor(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0))
+  {
+  }
+
+  // Make connections that are pending on the acceptor.
+  void connect(std::size_t n)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      clients.push_back(tcp::socket(ioc));
+      clients.back().connect(acceptor.local_endpoint());
+    }
+  }
+
+  asio::io_context ioc;
+  tcp::acceptor acceptor;
+  std::vector<tcp::socket> clients;
+};
+
+void test_batch()
+{
+  accept_batch_test t;
+  t.connect(5);
+
+  bool called = false;
+  asio::error_code accept_ec;
+  std::vector<tcp::socket> sockets;
+  asio::async_accept_batch(t.acceptor, 3,
+      [&](const asio::error_code& ec, std::vector<tcp::socket> s)
+      {
+        called = true;
+        accept_ec = ec;
+        sockets = std::move(s);
+      });
+  ASIO_CHECK(!called);
+  t.ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(!accept_ec);
+  ASIO_CHECK(sockets.size() == 3);
+
+  // The remaining connections are returned without waiting for more.
+  asio::async_accept_batch(t.acceptor, 16,
+      [&](const asio::error_code& ec, std::vector<tcp::socket> s)
+      {
+        accept_ec = ec;
+        sockets = std::move(s);
+      });
+  t.ioc.restart();
+  t.ioc.run();
+  ASIO_CHECK(!accept_ec);
+  ASIO_CHECK(sockets.size() == 2);
+  for (std::size_t i = 0; i < sockets.size(); ++i)
+  {
+    ASIO_CHECK(sockets[i].is_open());
+    ASIO_CHECK(sockets[i].remote_endpoint()
+        == t.clients[3 + i].local_endpoint());
+  }
+}
+
+void test_wait()
+{
+  accept_batch_test t;
+
+  std::vector<tcp::socket> sockets;
+  asio::async_accept_batch(t.acceptor, 16,
+      [&](const asio::error_code&, std::vector<tcp::socket> s)
+      {
+        sockets = std::move(s);
+      });
+  t.ioc.poll();
+  ASIO_CHECK(sockets.empty());
+
+  t.connect(1);
+  t.ioc.run();
+  ASIO_CHECK(sockets.size() == 1);
+}
+
+void test_zero()
+{
+  accept_batch_test t;
+  t.connect(1);
+
+  bool called = false;
+  std::size_t count = 1;
+  asio::async_accept_batch(t.acceptor, 0,
+      [&](const asio::error_code&, std::vector<tcp::socket> s)
+      {
+        called = true;
+        count = s.size();
+      });
+  t.ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(count == 0);
+}
+
+void test_cancel()
+{
+  accept_batch_test t;
+
+  asio::cancellation_signal cancel;
+  asio::error_code accept_ec;
+  asio::async_accept_batch(t.acceptor, 16,
+      asio::bind_cancellation_slot(cancel.slot(),
+        [&](const asio::error_code& ec, std::vector<tcp::socket>)
+        {
+          accept_ec = ec;
+        }));
+  t.ioc.poll();
+  cancel.emit(asio::cancellation_type::terminal);
+  t.ioc.run();
+  ASIO_CHECK(accept_ec == asio::error::operation_aborted);
+}
+
+void test_distribute()
+{
+  accept_batch_test t;
+  asio::io_context_pool pool(2);
+  t.connect(4);
+
+  std::vector<tcp::socket> sockets;
+  asio::async_accept_batch(t.acceptor, 16, pool,
+      [&](const asio::error_code&, std::vector<tcp::socket> s)
+      {
+        sockets = std::move(s);
+      });
+  t.ioc.run();
+  ASIO_CHECK(sockets.size() == 4);
+
+  // Consecutive sockets are associated with different io_contexts.
+  for (std::size_t i = 0; i < sockets.size(); ++i)
+  {
+    asio::execution_context* ctx = &asio::query(
+        sockets[i].get_executor(), asio::execution::context);
+    ASIO_CHECK(ctx == &pool.get_io_context(0)
+        || ctx == &pool.get_io_context(1));
+    if (i > 0)
+    {
+      ASIO_CHECK(ctx != &asio::query(
+            sockets[i - 1].get_executor(), asio::execution::context));
+    }
+  }
+
+  pool.stop();
+  pool.join();
+}
+
+} // namespace accept_batch_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "accept_batch",
+  ASIO_COMPILE_TEST_CASE(accept_batch_compile::test)
+  ASIO_TEST_CASE(accept_batch_runtime::test_batch)
+  ASIO_TEST_CASE(accept_batch_runtime::test_wait)
+  ASIO_TEST_CASE(accept_batch_runtime::test_zero)
+  ASIO_TEST_CASE(accept_batch_runtime::test_cancel)
+  ASIO_TEST_CASE(accept_batch_runtime::test_distribute)
+)
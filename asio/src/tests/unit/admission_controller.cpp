@@ -0,0 +1,239 @@
+//
+// admission_controller.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/admission_controller.hpp"
+
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// admission_controller_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime behaviour of the admission_controller
+// class.
+
+namespace admission_controller_runtime {
+
+using namespace asio;
+
+// Start an accept that records its outcome.
+void start_accept(admission_controller& admission,
+    ip::tcp::acceptor& acceptor, bool& called,
+    asio::error_code& ec, ip::tcp::socket& peer)
+{
+  admission.async_accept(acceptor,
+      [&called, &ec, &peer](asio::error_code e, ip::tcp::socket s)
+      {
+        called = true;
+        ec = e;
+        peer = std::move(s);
+      });
+}
+
+// Run until the controller has sampled the queue delay and found the
+// executor to be overloaded.
+void run_until_overloaded(io_context& ioc, admission_controller& admission)
+{
+  for (int i = 0; i < 1000 && !admission.overloaded(); ++i)
+  {
+    ioc.restart();
+    ioc.run_one_for(chrono::milliseconds(10));
+  }
+}
+
+// Run until the controller has found the executor to have recovered.
+void run_until_recovered(io_context& ioc, admission_controller& admission)
+{
+  for (int i = 0; i < 1000 && admission.overloaded(); ++i)
+  {
+    ioc.restart();
+    ioc.run_one_for(chrono::milliseconds(10));
+  }
+}
+
+void test_accept()
+{
+  io_context ioc;
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+
+  admission_controller admission(ioc);
+  ASIO_CHECK(!admission.overloaded());
+  ASIO_CHECK(admission.action() == admission_controller::pause_accepting);
+  ASIO_CHECK(admission.threshold() == chrono::milliseconds(10));
+  admission.set_threshold(chrono::hours(1));
+  admission.set_sample_interval(chrono::milliseconds(1));
+
+  bool called = false;
+  asio::error_code ec;
+  ip::tcp::socket peer(ioc);
+  start_accept(admission, acceptor, called, ec, peer);
+
+  ip::tcp::socket client(ioc);
+  client.connect(acceptor.local_endpoint());
+
+  // The context stops once the accept has completed, as sampling stops with
+  // it.
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(peer.is_open());
+  ASIO_CHECK(!admission.overloaded());
+  ASIO_CHECK(admission.reset_count() == 0);
+}
+
+void test_pause()
+{
+  io_context ioc;
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+
+  // Any measurable queue delay exceeds the threshold.
+  admission_controller admission(ioc.get_executor());
+  admission.set_threshold(chrono::nanoseconds(1));
+  admission.set_sample_interval(chrono::milliseconds(1));
+
+  bool called1 = false;
+  asio::error_code ec1;
+  ip::tcp::socket peer1(ioc);
+  start_accept(admission, acceptor, called1, ec1, peer1);
+  run_until_overloaded(ioc, admission);
+  ASIO_CHECK(admission.overloaded());
+  ASIO_CHECK(admission.queue_delay() > admission_controller::duration::zero());
+
+  // An accept that was already waiting on the acceptor still completes.
+  ip::tcp::socket client1(ioc);
+  client1.connect(acceptor.local_endpoint());
+  while (!called1)
+  {
+    ioc.restart();
+    ioc.run_one();
+  }
+  ASIO_CHECK(!ec1);
+
+  // A new accept is paused while the executor is overloaded.
+  bool called2 = false;
+  asio::error_code ec2;
+  ip::tcp::socket peer2(ioc);
+  start_accept(admission, acceptor, called2, ec2, peer2);
+  ip::tcp::socket client2(ioc);
+  client2.connect(acceptor.local_endpoint());
+  ioc.restart();
+  ioc.run_for(chrono::milliseconds(20));
+  ASIO_CHECK(!called2);
+
+  // The accept resumes once the executor recovers.
+  admission.set_threshold(chrono::hours(1));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called2);
+  ASIO_CHECK(!ec2);
+  ASIO_CHECK(peer2.is_open());
+  ASIO_CHECK(!admission.overloaded());
+}
+
+void test_reset()
+{
+  io_context ioc;
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+
+  admission_controller admission(ioc);
+  admission.set_action(admission_controller::reset_connections);
+  admission.set_threshold(chrono::nanoseconds(1));
+  admission.set_sample_interval(chrono::milliseconds(1));
+
+  bool called = false;
+  asio::error_code ec;
+  ip::tcp::socket peer(ioc);
+  start_accept(admission, acceptor, called, ec, peer);
+  run_until_overloaded(ioc, admission);
+  ASIO_CHECK(admission.overloaded());
+
+  // A connection accepted while the executor is overloaded is reset, and
+  // the operation continues to accept.
+  ip::tcp::socket client1(ioc);
+  client1.connect(acceptor.local_endpoint());
+  while (admission.reset_count() == 0)
+  {
+    ioc.restart();
+    ioc.run_one();
+  }
+  ASIO_CHECK(!called);
+
+  char data = 0;
+  asio::error_code read_ec;
+  client1.read_some(buffer(&data, 1), read_ec);
+  ASIO_CHECK(read_ec == asio::error::connection_reset);
+
+  // Connections are admitted once the executor recovers.
+  admission.set_threshold(chrono::hours(1));
+  run_until_recovered(ioc, admission);
+  ASIO_CHECK(!admission.overloaded());
+  ip::tcp::socket client2(ioc);
+  client2.connect(acceptor.local_endpoint());
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(peer.is_open());
+}
+
+void test_destroy()
+{
+  io_context ioc;
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+
+  bool called1 = false, called2 = false;
+  asio::error_code ec1, ec2;
+  ip::tcp::socket peer1(ioc), peer2(ioc);
+  {
+    admission_controller admission(ioc);
+    admission.set_threshold(chrono::nanoseconds(1));
+    admission.set_sample_interval(chrono::milliseconds(1));
+    start_accept(admission, acceptor, called1, ec1, peer1);
+    run_until_overloaded(ioc, admission);
+    ASIO_CHECK(admission.overloaded());
+    start_accept(admission, acceptor, called2, ec2, peer2);
+  }
+
+  // The paused accept is aborted, while the accept waiting on the acceptor
+  // completes when the acceptor is closed.
+  acceptor.close();
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called1);
+  ASIO_CHECK(ec1 == asio::error::operation_aborted);
+  ASIO_CHECK(called2);
+  ASIO_CHECK(ec2 == asio::error::operation_aborted);
+  ASIO_CHECK(!peer2.is_open());
+}
+
+} // namespace admission_controller_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "admission_controller",
+  ASIO_TEST_CASE(admission_controller_runtime::test_accept)
+  ASIO_TEST_CASE(admission_controller_runtime::test_pause)
+  ASIO_TEST_CASE(admission_controller_runtime::test_reset)
+  ASIO_TEST_CASE(admission_controller_runtime::test_destroy)
+)
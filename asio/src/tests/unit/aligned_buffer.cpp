@@ -0,0 +1,119 @@
+//
+// aligned_buffer.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/aligned_buffer.hpp"
+
+#include <cstring>
+#include "asio/system_error.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// aligned_buffer_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the aligned_buffer class.
+
+namespace aligned_buffer_runtime {
+
+bool is_aligned(const void* p, std::size_t alignment)
+{
+  return reinterpret_cast<std::size_t>(p) % alignment == 0;
+}
+
+void test_alignment()
+{
+  asio::aligned_buffer b1(100);
+  ASIO_CHECK(b1.size() == 100);
+  ASIO_CHECK(b1.alignment() == asio::aligned_buffer::default_alignment);
+  ASIO_CHECK(is_aligned(b1.data(), asio::aligned_buffer::default_alignment));
+
+  asio::aligned_buffer b2(3, 512);
+  ASIO_CHECK(b2.size() == 3);
+  ASIO_CHECK(b2.alignment() == 512);
+  ASIO_CHECK(is_aligned(b2.data(), 512));
+
+  // The contents are zero-initialised.
+  char zeroes[100] = {};
+  ASIO_CHECK(std::memcmp(b1.data(), zeroes, sizeof(zeroes)) == 0);
+
+  asio::aligned_buffer b3;
+  ASIO_CHECK(b3.size() == 0);
+  ASIO_CHECK(b3.data() == 0);
+
+  bool threw = false;
+  try
+  {
+    asio::aligned_buffer b4(16, 48);
+  }
+  catch (asio::system_error& e)
+  {
+    threw = true;
+    ASIO_CHECK(e.code() == asio::error::invalid_argument);
+  }
+  ASIO_CHECK(threw);
+}
+
+void test_move()
+{
+  asio::aligned_buffer b1(64);
+  void* data = b1.data();
+
+  asio::aligned_buffer b2(static_cast<asio::aligned_buffer&&>(b1));
+  ASIO_CHECK(b2.data() == data);
+  ASIO_CHECK(b2.size() == 64);
+  ASIO_CHECK(b1.data() == 0);
+  ASIO_CHECK(b1.size() == 0);
+
+  asio::aligned_buffer b3(32);
+  b3 = static_cast<asio::aligned_buffer&&>(b2);
+  ASIO_CHECK(b3.data() == data);
+  ASIO_CHECK(b3.size() == 64);
+  ASIO_CHECK(b2.data() == 0);
+}
+
+void test_buffer()
+{
+  asio::aligned_buffer b1(64);
+  const asio::aligned_buffer& b2 = b1;
+
+  asio::mutable_buffer mb1 = asio::buffer(b1);
+  ASIO_CHECK(mb1.data() == b1.data());
+  ASIO_CHECK(mb1.size() == 64);
+
+  asio::mutable_buffer mb2 = asio::buffer(b1, 16);
+  ASIO_CHECK(mb2.data() == b1.data());
+  ASIO_CHECK(mb2.size() == 16);
+
+  asio::const_buffer cb1 = asio::buffer(b2);
+  ASIO_CHECK(cb1.data() == b2.data());
+  ASIO_CHECK(cb1.size() == 64);
+
+  asio::const_buffer cb2 = asio::buffer(b2, 128);
+  ASIO_CHECK(cb2.data() == b2.data());
+  ASIO_CHECK(cb2.size() == 64);
+}
+
+} // namespace aligned_buffer_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "aligned_buffer",
+  ASIO_TEST_CASE(aligned_buffer_runtime::test_alignment)
+  ASIO_TEST_CASE(aligned_buffer_runtime::test_move)
+  ASIO_TEST_CASE(aligned_buffer_runtime::test_buffer)
+)
@@ -18,7 +18,9 @@
 
 #include "unit_test.hpp"
 
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include "asio/bind_allocator.hpp"
 #include "asio/bind_cancellation_slot.hpp"
 #include "asio/bind_executor.hpp"
@@ -250,6 +252,146 @@ void any_completion_handler_invocation_test()
   ASIO_CHECK(count == 2);
 }
 
+class inline_handler
+{
+public:
+  inline_handler(int* count, std::shared_ptr<int> token, void** location)
+    : count_(count),
+      token_(std::move(token)),
+      location_(location)
+  {
+  }
+
+  inline_handler(inline_handler&& other) noexcept
+    : count_(other.count_),
+      token_(std::move(other.token_)),
+      location_(other.location_)
+  {
+    *location_ = this;
+  }
+
+  void operator()()
+  {
+    ++(*count_);
+  }
+
+private:
+  int* count_;
+  std::shared_ptr<int> token_;
+  void** location_;
+};
+
+template <typename T>
+bool stored_within(const T& object, void* location)
+{
+  std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(&object);
+  std::uintptr_t p = reinterpret_cast<std::uintptr_t>(location);
+  return p >= begin && p < begin + sizeof(T);
+}
+
+void any_completion_handler_inline_storage_test()
+{
+  typedef asio::basic_any_completion_handler<64, void()> handler_type;
+
+  int count = 0;
+  std::shared_ptr<int> token = std::make_shared<int>(0);
+  void* location = 0;
+
+  // Small targets are stored within the wrapper, and move with it.
+  handler_type h1(inline_handler(&count, token, &location));
+
+  ASIO_CHECK(!!h1);
+  ASIO_CHECK(stored_within(h1, location));
+  ASIO_CHECK(token.use_count() == 2);
+
+  handler_type h2(std::move(h1));
+
+  ASIO_CHECK(!h1);
+  ASIO_CHECK(!!h2);
+  ASIO_CHECK(stored_within(h2, location));
+  ASIO_CHECK(token.use_count() == 2);
+
+  handler_type h3;
+  h3 = std::move(h2);
+  h3.swap(h1);
+
+  ASIO_CHECK(!!h1);
+  ASIO_CHECK(!h2);
+  ASIO_CHECK(!h3);
+  ASIO_CHECK(stored_within(h1, location));
+  ASIO_CHECK(token.use_count() == 2);
+
+  std::move(h1)();
+
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(token.use_count() == 1);
+
+  // Memory obtained from the associated allocator may be released after the
+  // target has been moved.
+  handler_type h4(inline_handler(&count, token, &location));
+  ASIO_REBIND_ALLOC(asio::associated_allocator<handler_type>::type,
+      char) alloc1(asio::get_associated_allocator(h4));
+  char* p = alloc1.allocate(16);
+  handler_type h5(std::move(h4));
+  alloc1.deallocate(p, 16);
+
+  // Swapping an inline target with an allocated one.
+  handler_type h6(asio::bind_allocator(
+        std::allocator<void>(), inline_handler(&count, token, &location)));
+  h5.swap(h6);
+  std::move(h5)();
+  std::move(h6)();
+
+  ASIO_CHECK(count == 3);
+  ASIO_CHECK(token.use_count() == 1);
+
+  // Targets with an associated allocator continue to use it.
+  int alloc_count = 0;
+  handler_type h7(
+      asio::bind_allocator(handler_allocator<char>(&alloc_count),
+        bindns::bind(&increment, &count)));
+
+  ASIO_CHECK(alloc_count == 1);
+
+  handler_type h8(std::move(h7));
+  std::move(h8)();
+
+  ASIO_CHECK(count == 4);
+
+  // Targets that do not fit are allocated.
+  asio::basic_any_completion_handler<8, void()> h9(
+      inline_handler(&count, token, &location));
+
+  ASIO_CHECK(!stored_within(h9, location));
+
+  asio::basic_any_completion_handler<8, void()> h10(std::move(h9));
+  std::move(h10)();
+
+  ASIO_CHECK(count == 5);
+
+  // The cancellation slot follows the target when it is moved.
+  int cancel_count = 0;
+  asio::cancellation_signal sig;
+  handler_type h11(
+      asio::bind_cancellation_slot(sig.slot(),
+        inline_handler(&count, token, &location)));
+  handler_type h12(std::move(h11));
+
+  asio::associated_cancellation_slot<handler_type>::type slot1
+    = asio::get_associated_cancellation_slot(h12);
+
+  ASIO_CHECK(slot1.is_connected());
+
+  slot1.emplace<cancel_handler>(&cancel_count);
+  sig.emit(asio::cancellation_type::terminal);
+
+  ASIO_CHECK(cancel_count == 1);
+
+  std::move(h12)();
+
+  ASIO_CHECK(count == 6);
+}
+
 ASIO_TEST_SUITE
 (
   "any_completion_handler",
@@ -257,4 +399,5 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(any_completion_handler_assignment_test)
   ASIO_TEST_CASE(any_completion_handler_associator_test)
   ASIO_TEST_CASE(any_completion_handler_invocation_test)
+  ASIO_TEST_CASE(any_completion_handler_inline_storage_test)
 )
@@ -18,6 +18,9 @@
 
 #include <cstring>
 #include <functional>
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/strand.hpp"
 #include "asio/system_executor.hpp"
 #include "asio/thread_pool.hpp"
 #include "unit_test.hpp"
@@ -503,6 +506,76 @@ void any_io_executor_execute_test()
   ASIO_CHECK(count == 6);
 }
 
+struct move_counting_function
+{
+  move_counting_function(int* count, int* moves)
+    : count_(count),
+      moves_(moves)
+  {
+  }
+
+  move_counting_function(move_counting_function&& other) noexcept
+    : count_(other.count_),
+      moves_(other.moves_)
+  {
+    ++(*moves_);
+  }
+
+  void operator()()
+  {
+    ++(*count_);
+  }
+
+  int* count_;
+  int* moves_;
+};
+
+void any_io_executor_io_context_execute_test()
+{
+  int count = 0;
+  int moves = 0;
+  io_context ioc;
+  asio::any_io_executor ex(ioc.get_executor());
+  asio::any_io_executor tracked_ex = asio::prefer(ex,
+      asio::execution::outstanding_work.tracked);
+  asio::any_io_executor strand_ex(asio::make_strand(ioc));
+
+  ASIO_CHECK(ex.target<io_context::executor_type>() != 0);
+  ASIO_CHECK(strand_ex.target<strand<io_context::executor_type>>() != 0);
+
+  // Functions run immediately by the target are not moved into a type-erased
+  // function object, and so are moved only once, by the target itself.
+  asio::post(ioc,
+      [&]()
+      {
+        ex.execute(move_counting_function(&count, &moves));
+        tracked_ex.execute(move_counting_function(&count, &moves));
+        tracked_ex = nullptr;
+      });
+  ioc.run();
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(moves == 2);
+
+  ioc.restart();
+  asio::post(strand_ex,
+      [&]()
+      {
+        strand_ex.execute(move_counting_function(&count, &moves));
+      });
+  ioc.run();
+  ASIO_CHECK(count == 3);
+  ASIO_CHECK(moves == 3);
+
+  // Functions that cannot run immediately are still executed.
+  ioc.restart();
+  ex.execute(move_counting_function(&count, &moves));
+  strand_ex.execute(move_counting_function(&count, &moves));
+  asio::require(ex, asio::execution::blocking.never).execute(
+      move_counting_function(&count, &moves));
+  ioc.run();
+  ASIO_CHECK(count == 6);
+}
+
 ASIO_TEST_SUITE
 (
   "any_io_executor",
@@ -512,4 +585,5 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(any_io_executor_swap_test)
   ASIO_TEST_CASE(any_io_executor_query_test)
   ASIO_TEST_CASE(any_io_executor_execute_test)
+  ASIO_TEST_CASE(any_io_executor_io_context_execute_test)
 )
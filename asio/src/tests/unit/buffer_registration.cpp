@@ -16,10 +16,142 @@
 // Test that header file is self-contained.
 #include "asio/buffer_registration.hpp"
 
+#include <vector>
+#include "asio/io_context.hpp"
 #include "unit_test.hpp"
 
+//------------------------------------------------------------------------------
+
+// buffer_registration_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// buffer_registration compile and link correctly. Runtime failures are
+// ignored.
+
+namespace buffer_registration_compile {
+
+void test()
+{
+  using namespace asio;
+
+  try
+  {
+    io_context ioc;
+    asio::error_code ec;
+    char data[2][16];
+    std::vector<mutable_buffer> buffers;
+    buffers.push_back(asio::buffer(data[0]));
+
+    buffer_registration<std::vector<mutable_buffer>> reg1(ioc, buffers);
+    buffer_registration<std::vector<mutable_buffer>> reg2(ioc, buffers, 4);
+    buffer_registration<std::vector<mutable_buffer>> reg3(
+        ioc.get_executor(), buffers, 4);
+    buffer_registration<std::vector<mutable_buffer>> reg4(
+        ioc.get_executor(), buffers, 4, std::allocator<void>());
+
+    std::size_t n1 = reg2.size();
+    (void)n1;
+
+    std::size_t n2 = reg2.capacity();
+    (void)n2;
+
+    reg2.update(1, asio::buffer(data[1]));
+    reg2.update(1, asio::buffer(data[1]), ec);
+
+    const mutable_registered_buffer& b1 = reg2[1];
+    (void)b1;
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace buffer_registration_compile
+
+//------------------------------------------------------------------------------
+
+// buffer_registration_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the buffer_registration
+// class.
+
+namespace buffer_registration_runtime {
+
+void test_update()
+{
+  asio::io_context ioc;
+  char data[4][16];
+  std::vector<asio::mutable_buffer> buffers;
+  buffers.push_back(asio::buffer(data[0]));
+  buffers.push_back(asio::buffer(data[1]));
+
+  asio::buffer_registration<std::vector<asio::mutable_buffer>>
+    reg(ioc, buffers, 4);
+  ASIO_CHECK(reg.size() == 2);
+  ASIO_CHECK(reg.capacity() == 4);
+  ASIO_CHECK(reg[1].data() == data[1]);
+  ASIO_CHECK(reg[1].id().native_handle() == 1);
+
+  // Grow into an empty slot.
+  reg.update(3, asio::buffer(data[3]));
+  ASIO_CHECK(reg.size() == 4);
+  ASIO_CHECK(reg[2].size() == 0);
+  ASIO_CHECK(reg[3].data() == data[3]);
+  ASIO_CHECK(reg[3].size() == 16);
+  ASIO_CHECK(reg[3].id().native_handle() == 3);
+
+  // Swap the buffer held in a slot.
+  reg.update(0, asio::buffer(data[2], 8));
+  ASIO_CHECK(reg[0].data() == data[2]);
+  ASIO_CHECK(reg[0].size() == 8);
+  ASIO_CHECK(reg[0].id().native_handle() == 0);
+
+  // Shrink by emptying the trailing slots.
+  reg.update(3, asio::mutable_buffer());
+  ASIO_CHECK(reg.size() == 2);
+  reg.update(1, asio::mutable_buffer());
+  ASIO_CHECK(reg.size() == 1);
+
+  // Slots beyond the capacity are rejected.
+  asio::error_code ec;
+  reg.update(4, asio::buffer(data[3]), ec);
+  ASIO_CHECK(ec == asio::error::invalid_argument);
+  ASIO_CHECK(reg.size() == 1);
+
+  // Moving transfers the slots.
+  asio::buffer_registration<std::vector<asio::mutable_buffer>>
+    reg2(std::move(reg));
+  ASIO_CHECK(reg2.capacity() == 4);
+  ASIO_CHECK(reg.capacity() == 0);
+}
+
+void test_minimum_capacity()
+{
+  asio::io_context ioc;
+  char data[2][16];
+  std::vector<asio::mutable_buffer> buffers;
+  buffers.push_back(asio::buffer(data[0]));
+  buffers.push_back(asio::buffer(data[1]));
+
+  // The capacity is at least the number of buffers.
+  asio::buffer_registration<std::vector<asio::mutable_buffer>>
+    reg(ioc, buffers, 1);
+  ASIO_CHECK(reg.capacity() == 2);
+
+  asio::io_context ioc2;
+  asio::buffer_registration<std::vector<asio::mutable_buffer>>
+    reg2(ioc2, buffers);
+  ASIO_CHECK(reg2.capacity() == 2);
+}
+
+} // namespace buffer_registration_runtime
+
+//------------------------------------------------------------------------------
+
 ASIO_TEST_SUITE
 (
   "buffer_registration",
-  ASIO_TEST_CASE(null_test)
+  ASIO_COMPILE_TEST_CASE(buffer_registration_compile::test)
+  ASIO_TEST_CASE(buffer_registration_runtime::test_update)
+  ASIO_TEST_CASE(buffer_registration_runtime::test_minimum_capacity)
 )
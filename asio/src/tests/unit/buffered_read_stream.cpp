@@ -23,6 +23,7 @@
 #include "asio/io_context.hpp"
 #include "asio/ip/tcp.hpp"
 #include "asio/system_error.hpp"
+#include "asio/write.hpp"
 #include "unit_test.hpp"
 
 #if defined(ASIO_HAS_BOOST_ARRAY)
@@ -70,8 +71,13 @@ void test_compile()
     archetypes::lazy_handler lazy;
     asio::error_code ec;
 
+    buffered_stream_pool pool;
+
     stream_type stream1(ioc);
     stream_type stream2(ioc, 1024);
+    stream_type stream3(ioc, 1024, 65536);
+    stream_type stream4(ioc, pool);
+    stream_type stream5(ioc, pool, 1024, 65536);
 
     stream_type::executor_type ex = stream1.get_executor();
     (void)ex;
@@ -129,6 +135,12 @@ void test_compile()
     (void)i8;
     int i9 = stream1.async_read_some(null_buffers(), lazy);
     (void)i9;
+
+    const_buffer data = stream1.data();
+    (void)data;
+    stream1.consume(1);
+    std::size_t capacity = stream1.buffer_capacity();
+    (void)capacity;
   }
   catch (std::exception&)
   {
@@ -206,6 +218,80 @@ void test_sync_operations()
   client_socket.close(error);
 }
 
+void test_buffer_adaptation()
+{
+  using namespace std; // For memcmp.
+
+  asio::io_context io_context;
+  asio::buffered_stream_pool pool;
+
+  asio::ip::tcp::acceptor acceptor(io_context,
+      asio::ip::tcp::endpoint(asio::ip::tcp::v4(), 0));
+  asio::ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(asio::ip::address_v4::loopback());
+
+  asio::ip::tcp::socket client_socket(io_context);
+  client_socket.connect(server_endpoint);
+
+  std::size_t cached_blocks = 0;
+
+  {
+    stream_type server_socket(io_context, pool, 64, 4096);
+    acceptor.accept(server_socket.lowest_layer());
+    ASIO_CHECK(server_socket.buffer_capacity() == 64);
+
+    char write_data[8192];
+    for (std::size_t i = 0; i < sizeof(write_data); ++i)
+      write_data[i] = static_cast<char>('a' + i % 26);
+    asio::write(client_socket, asio::buffer(write_data));
+
+    // Reads that fill the buffer grow it, keeping the data already read,
+    // until the maximum size is reached.
+    for (int i = 0; i < 64 && server_socket.in_avail() < 4096; ++i)
+      server_socket.fill();
+    ASIO_CHECK(server_socket.buffer_capacity() == 4096);
+    ASIO_CHECK(server_socket.in_avail() == 4096);
+    ASIO_CHECK(server_socket.fill() == 0);
+
+    // The data may be parsed and consumed without copying it out.
+    asio::const_buffer data = server_socket.data();
+    ASIO_CHECK(data.size() == 4096);
+    ASIO_CHECK(memcmp(data.data(), write_data, 4096) == 0);
+    server_socket.consume(100);
+    data = server_socket.data();
+    ASIO_CHECK(data.size() == 3996);
+    ASIO_CHECK(memcmp(data.data(), write_data + 100, 3996) == 0);
+    server_socket.consume(100000);
+    ASIO_CHECK(server_socket.in_avail() == 0);
+
+    std::size_t bytes_read = 4096;
+    while (bytes_read < sizeof(write_data))
+    {
+      bytes_read += server_socket.fill();
+      data = server_socket.data();
+      server_socket.consume(data.size());
+    }
+    ASIO_CHECK(memcmp(data.data(),
+          write_data + sizeof(write_data) - data.size(), data.size()) == 0);
+
+    // Reads that leave most of the buffer unused shrink it again.
+    for (int i = 0; i < 64; ++i)
+    {
+      asio::write(client_socket, asio::buffer(write_data, 10));
+      ASIO_CHECK(server_socket.fill() == 10);
+      server_socket.consume(10);
+    }
+    ASIO_CHECK(server_socket.buffer_capacity() == 64);
+
+    // Buffers released by resizing are held by the pool for reuse.
+    cached_blocks = pool.cached_blocks();
+    ASIO_CHECK(cached_blocks > 0);
+  }
+
+  // The stream's buffer is returned to the pool when it is destroyed.
+  ASIO_CHECK(pool.cached_blocks() == cached_blocks + 1);
+}
+
 void handle_accept(const asio::error_code& e)
 {
   ASIO_CHECK(!e);
@@ -326,4 +412,5 @@ ASIO_TEST_SUITE
   ASIO_COMPILE_TEST_CASE(test_compile)
   ASIO_TEST_CASE(test_sync_operations)
   ASIO_TEST_CASE(test_async_operations)
+  ASIO_TEST_CASE(test_buffer_adaptation)
 )
@@ -0,0 +1,221 @@
+//
+// buffers_cat.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/buffers_cat.hpp"
+
+#include <array>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// buffers_cat_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that buffers_cat_view satisfies the buffer
+// sequence type requirements, and that it can be used with socket operations.
+
+namespace buffers_cat_compile {
+
+typedef asio::buffers_cat_view<asio::mutable_buffer,
+    std::vector<asio::mutable_buffer>> mutable_cat;
+typedef asio::buffers_cat_view<asio::const_buffer,
+    asio::mutable_buffer> const_cat;
+
+static_assert(asio::is_mutable_buffer_sequence<mutable_cat>::value,
+    "a concatenation of mutable buffers must be a MutableBufferSequence");
+static_assert(!asio::is_mutable_buffer_sequence<const_cat>::value,
+    "a concatenation including const buffers must not be mutable");
+static_assert(asio::is_const_buffer_sequence<const_cat>::value,
+    "a concatenation must be a ConstBufferSequence");
+
+void write_handler(const asio::error_code&, std::size_t)
+{
+}
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    ip::tcp::socket socket1(ioc);
+    char raw[16];
+    std::vector<mutable_buffer> v(2, buffer(raw));
+    error_code ec;
+
+    socket1.send(buffers_cat(buffer("a", 1), v));
+    socket1.receive(buffers_cat(buffer(raw), v), 0, ec);
+    socket1.async_send(buffers_cat(buffer("a", 1), v), write_handler);
+    socket1.async_receive(buffers_cat(buffer(raw), v), write_handler);
+    write(socket1, buffers_cat(buffer("a", 1), buffer(raw), v), ec);
+    async_write(socket1, buffers_cat(buffer("a", 1), v), write_handler);
+    read(socket1, buffers_cat(buffer(raw), v), ec);
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace buffers_cat_compile
+
+//------------------------------------------------------------------------------
+
+// buffers_cat_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the buffers_cat_view
+// class template.
+
+namespace buffers_cat_runtime {
+
+template <typename BufferSequence>
+std::string to_string(const BufferSequence& buffers)
+{
+  std::string s(asio::buffer_size(buffers), '\0');
+  asio::buffer_copy(asio::buffer(&s[0], s.size()), buffers);
+  return s;
+}
+
+void test_iteration()
+{
+  std::string a = "abc";
+  std::vector<asio::const_buffer> empty;
+  std::array<asio::const_buffer, 2> b = {{
+    asio::buffer("de", 2), asio::buffer("fgh", 3) }};
+
+  typedef asio::buffers_cat_view<asio::const_buffer,
+    std::vector<asio::const_buffer>, std::array<asio::const_buffer, 2>,
+    std::vector<asio::const_buffer>> cat_type;
+  cat_type cat = asio::buffers_cat(asio::const_buffer(asio::buffer(a)),
+      empty, b, empty);
+
+  ASIO_CHECK(std::distance(cat.begin(), cat.end()) == 3);
+  ASIO_CHECK(asio::buffer_size(cat) == 8);
+  ASIO_CHECK(to_string(cat) == "abcdefgh");
+
+  // Iterate backwards, across the empty sequence.
+  cat_type::const_iterator i = cat.end();
+  --i;
+  ASIO_CHECK((*i).size() == 3);
+  --i;
+  ASIO_CHECK((*i).size() == 2);
+  --i;
+  ASIO_CHECK((*i).size() == 3);
+  ASIO_CHECK(i == cat.begin());
+  i++;
+  i++;
+  ASIO_CHECK(++i == cat.end());
+
+  // A concatenation of empty sequences is itself empty.
+  asio::buffers_cat_view<std::vector<asio::const_buffer>,
+    std::vector<asio::const_buffer>> nothing(empty, empty);
+  ASIO_CHECK(nothing.begin() == nothing.end());
+
+  // A view may be nested within another.
+  ASIO_CHECK(to_string(asio::buffers_cat(cat, asio::buffer("ij", 2)))
+      == "abcdefghij");
+}
+
+void test_native_buffers()
+{
+  using asio::detail::buffer_sequence_native_buffers;
+
+  // The adapter reserves only the storage that the components can use.
+  ASIO_CHECK((buffer_sequence_native_buffers<
+        asio::buffers_cat_view<asio::const_buffer,
+          std::array<asio::const_buffer, 3>>>::value == 4));
+  ASIO_CHECK((buffer_sequence_native_buffers<
+        asio::buffers_cat_view<asio::const_buffer,
+          std::vector<asio::const_buffer>>>::value
+        == static_cast<std::size_t>(
+          asio::detail::buffer_sequence_adapter_base::max_buffers)));
+
+  std::string a = "abc";
+  std::array<asio::const_buffer, 2> b = {{
+    asio::buffer("de", 2), asio::buffer("fgh", 3) }};
+  typedef asio::buffers_cat_view<asio::const_buffer,
+    std::array<asio::const_buffer, 2>> cat_type;
+  cat_type cat(asio::buffer(a), b);
+  asio::detail::buffer_sequence_adapter<asio::const_buffer, cat_type>
+    adapter(cat);
+  ASIO_CHECK(adapter.count() == 3);
+  ASIO_CHECK(adapter.total_size() == 8);
+}
+
+void test_socket()
+{
+  using asio::ip::tcp;
+
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket client(ioc);
+  tcp::socket server(ioc);
+  client.connect(acceptor.local_endpoint());
+  acceptor.accept(server);
+
+  std::string status = "HTTP/1.1 200 OK\r\n";
+  std::array<asio::const_buffer, 2> headers = {{
+    asio::buffer("Server: asio\r\n", 14), asio::buffer("\r\n", 2) }};
+  std::string body = "hello";
+
+  std::size_t written = 0;
+  asio::async_write(client,
+      asio::buffers_cat(asio::buffer(status), headers, asio::buffer(body)),
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        ASIO_CHECK(!e);
+        written = n;
+      });
+
+  char head[17];
+  char rest[21];
+  std::size_t read = 0;
+  asio::async_read(server,
+      asio::buffers_cat(asio::buffer(head), asio::buffer(rest)),
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        ASIO_CHECK(!e);
+        read = n;
+      });
+  ioc.run();
+
+  ASIO_CHECK(written == 38);
+  ASIO_CHECK(read == 38);
+  ASIO_CHECK(std::string(head, 17) == status);
+  ASIO_CHECK(std::string(rest, 21) == "Server: asio\r\n\r\nhello");
+}
+
+} // namespace buffers_cat_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "buffers_cat",
+  ASIO_COMPILE_TEST_CASE(buffers_cat_compile::test)
+  ASIO_TEST_CASE(buffers_cat_runtime::test_iteration)
+  ASIO_TEST_CASE(buffers_cat_runtime::test_native_buffers)
+  ASIO_TEST_CASE(buffers_cat_runtime::test_socket)
+)
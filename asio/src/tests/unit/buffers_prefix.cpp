@@ -0,0 +1,189 @@
+//
+// buffers_prefix.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/buffers_prefix.hpp"
+
+#include <array>
+#include <iterator>
+#include <list>
+#include <string>
+#include <vector>
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// buffers_prefix_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that buffers_prefix_view satisfies the buffer
+// sequence type requirements, and that it can be used with socket operations.
+
+namespace buffers_prefix_compile {
+
+static_assert(asio::is_mutable_buffer_sequence<
+      asio::buffers_prefix_view<std::vector<asio::mutable_buffer>>>::value,
+    "a prefix of mutable buffers must be a MutableBufferSequence");
+static_assert(!asio::is_mutable_buffer_sequence<
+      asio::buffers_prefix_view<std::vector<asio::const_buffer>>>::value,
+    "a prefix of const buffers must not be mutable");
+static_assert(asio::is_const_buffer_sequence<
+      asio::buffers_prefix_view<asio::const_buffer>>::value,
+    "a prefix must be a ConstBufferSequence");
+
+void write_handler(const asio::error_code&, std::size_t)
+{
+}
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    ip::tcp::socket socket1(ioc);
+    char raw[16];
+    std::vector<mutable_buffer> v(2, buffer(raw));
+    error_code ec;
+
+    socket1.send(buffers_prefix(20, v));
+    socket1.receive(buffers_prefix(20, v), 0, ec);
+    socket1.async_send(buffers_prefix(1, buffer("a", 1)), write_handler);
+    socket1.async_receive(buffers_prefix(20, v), write_handler);
+    write(socket1, buffers_prefix(20, v), ec);
+    async_write(socket1, buffers_prefix(20, v), write_handler);
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace buffers_prefix_compile
+
+//------------------------------------------------------------------------------
+
+// buffers_prefix_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the buffers_prefix_view
+// class template.
+
+namespace buffers_prefix_runtime {
+
+template <typename BufferSequence>
+std::string to_string(const BufferSequence& buffers)
+{
+  std::string s(asio::buffer_size(buffers), '\0');
+  asio::buffer_copy(asio::buffer(&s[0], s.size()), buffers);
+  return s;
+}
+
+void test_prefix()
+{
+  std::array<asio::const_buffer, 3> b = {{ asio::buffer("abc", 3),
+    asio::buffer("defg", 4), asio::buffer("hi", 2) }};
+
+  for (std::size_t n = 0; n <= 10; ++n)
+  {
+    asio::buffers_prefix_view<std::array<asio::const_buffer, 3>>
+      prefix = asio::buffers_prefix(n, b);
+    std::size_t expected = n < 9 ? n : 9;
+    ASIO_CHECK(prefix.size() == expected);
+    ASIO_CHECK(asio::buffer_size(prefix) == expected);
+    ASIO_CHECK(to_string(prefix) == std::string("abcdefghi", expected));
+  }
+
+  // The view contains only the elements that contribute data.
+  asio::buffers_prefix_view<std::array<asio::const_buffer, 3>>
+    prefix = asio::buffers_prefix(5, b);
+  ASIO_CHECK(std::distance(prefix.begin(), prefix.end()) == 2);
+  asio::buffers_prefix_view<std::array<asio::const_buffer, 3>>::const_iterator
+    i = prefix.end();
+  --i;
+  ASIO_CHECK((*i).size() == 2);
+  i--;
+  ASIO_CHECK((*i).size() == 3);
+  ASIO_CHECK(i == prefix.begin());
+
+  // The view remains valid when copied.
+  asio::buffers_prefix_view<std::array<asio::const_buffer, 3>> copy(prefix);
+  ASIO_CHECK(to_string(copy) == "abcde");
+
+  // The underlying sequence need not support random access.
+  std::list<asio::const_buffer> l(b.begin(), b.end());
+  ASIO_CHECK(to_string(asio::buffers_prefix(8, l)) == "abcdefgh");
+  ASIO_CHECK(to_string(asio::buffers_prefix(2, asio::buffer("xyz", 3)))
+      == "xy");
+}
+
+void test_native_buffers()
+{
+  using asio::detail::buffer_sequence_native_buffers;
+
+  ASIO_CHECK((buffer_sequence_native_buffers<
+        asio::buffers_prefix_view<std::array<asio::const_buffer, 3>>>::value
+        == 3));
+
+  std::array<asio::const_buffer, 3> b = {{ asio::buffer("abc", 3),
+    asio::buffer("defg", 4), asio::buffer("hi", 2) }};
+  typedef asio::buffers_prefix_view<std::array<asio::const_buffer, 3>>
+    prefix_type;
+  prefix_type prefix(5, b);
+  asio::detail::buffer_sequence_adapter<asio::const_buffer, prefix_type>
+    adapter(prefix);
+  ASIO_CHECK(adapter.count() == 2);
+  ASIO_CHECK(adapter.total_size() == 5);
+}
+
+void test_socket()
+{
+  using asio::ip::tcp;
+
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket client(ioc);
+  tcp::socket server(ioc);
+  client.connect(acceptor.local_endpoint());
+  acceptor.accept(server);
+
+  std::vector<asio::const_buffer> b;
+  b.push_back(asio::buffer("first,", 6));
+  b.push_back(asio::buffer("second", 6));
+  std::size_t n = asio::write(client, asio::buffers_prefix(9, b));
+  ASIO_CHECK(n == 9);
+
+  char data[9];
+  asio::read(server, asio::buffer(data));
+  ASIO_CHECK(std::string(data, 9) == "first,sec");
+}
+
+} // namespace buffers_prefix_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "buffers_prefix",
+  ASIO_COMPILE_TEST_CASE(buffers_prefix_compile::test)
+  ASIO_TEST_CASE(buffers_prefix_runtime::test_prefix)
+  ASIO_TEST_CASE(buffers_prefix_runtime::test_native_buffers)
+  ASIO_TEST_CASE(buffers_prefix_runtime::test_socket)
+)
@@ -0,0 +1,207 @@
+//
+// buffers_suffix.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/buffers_suffix.hpp"
+
+#include <array>
+#include <iterator>
+#include <list>
+#include <string>
+#include <vector>
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/read.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// buffers_suffix_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that buffers_suffix satisfies the buffer sequence
+// type requirements, and that it can be used with socket operations.
+
+namespace buffers_suffix_compile {
+
+static_assert(asio::is_mutable_buffer_sequence<
+      asio::buffers_suffix<std::vector<asio::mutable_buffer>>>::value,
+    "a suffix of mutable buffers must be a MutableBufferSequence");
+static_assert(!asio::is_mutable_buffer_sequence<
+      asio::buffers_suffix<std::vector<asio::const_buffer>>>::value,
+    "a suffix of const buffers must not be mutable");
+static_assert(asio::is_const_buffer_sequence<
+      asio::buffers_suffix<asio::const_buffer>>::value,
+    "a suffix must be a ConstBufferSequence");
+
+void write_handler(const asio::error_code&, std::size_t)
+{
+}
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    ip::tcp::socket socket1(ioc);
+    char raw[16];
+    std::vector<mutable_buffer> v(2, buffer(raw));
+    buffers_suffix<std::vector<mutable_buffer>> suffix(v);
+    error_code ec;
+
+    socket1.send(suffix);
+    socket1.receive(suffix, 0, ec);
+    socket1.async_send(suffix, write_handler);
+    socket1.async_receive(suffix, write_handler);
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace buffers_suffix_compile
+
+//------------------------------------------------------------------------------
+
+// buffers_suffix_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the buffers_suffix class
+// template.
+
+namespace buffers_suffix_runtime {
+
+template <typename BufferSequence>
+std::string to_string(const BufferSequence& buffers)
+{
+  std::string s(asio::buffer_size(buffers), '\0');
+  asio::buffer_copy(asio::buffer(&s[0], s.size()), buffers);
+  return s;
+}
+
+void test_consume()
+{
+  std::array<asio::const_buffer, 3> b = {{ asio::buffer("abc", 3),
+    asio::buffer("defg", 4), asio::buffer("hi", 2) }};
+
+  for (std::size_t n = 0; n <= 10; ++n)
+  {
+    asio::buffers_suffix<std::array<asio::const_buffer, 3>> suffix(b);
+    suffix.consume(n);
+    std::size_t skipped = n < 9 ? n : 9;
+    ASIO_CHECK(asio::buffer_size(suffix) == 9 - skipped);
+    ASIO_CHECK(to_string(suffix) == std::string("abcdefghi" + skipped));
+  }
+
+  // Consume in several steps, including steps that end on a boundary.
+  asio::buffers_suffix<std::array<asio::const_buffer, 3>> suffix(b);
+  suffix.consume(1);
+  ASIO_CHECK(to_string(suffix) == "bcdefghi");
+  suffix.consume(2);
+  ASIO_CHECK(to_string(suffix) == "defghi");
+  ASIO_CHECK(std::distance(suffix.begin(), suffix.end()) == 2);
+  suffix.consume(3);
+  ASIO_CHECK(to_string(suffix) == "ghi");
+
+  asio::buffers_suffix<std::array<asio::const_buffer, 3>>::const_iterator
+    i = suffix.end();
+  --i;
+  ASIO_CHECK((*i).size() == 2);
+  i--;
+  ASIO_CHECK((*i).size() == 1);
+  ASIO_CHECK(i == suffix.begin());
+
+  // The suffix remains valid when copied.
+  asio::buffers_suffix<std::array<asio::const_buffer, 3>> copy(suffix);
+  copy.consume(2);
+  ASIO_CHECK(to_string(copy) == "i");
+  ASIO_CHECK(to_string(suffix) == "ghi");
+
+  // The underlying sequence need not support random access.
+  std::list<asio::const_buffer> l(b.begin(), b.end());
+  asio::buffers_suffix<std::list<asio::const_buffer>> list_suffix(l);
+  list_suffix.consume(4);
+  ASIO_CHECK(to_string(list_suffix) == "efghi");
+  list_suffix.consume(100);
+  ASIO_CHECK(list_suffix.begin() == list_suffix.end());
+}
+
+void test_native_buffers()
+{
+  using asio::detail::buffer_sequence_native_buffers;
+
+  ASIO_CHECK((buffer_sequence_native_buffers<
+        asio::buffers_suffix<std::array<asio::const_buffer, 3>>>::value
+        == 3));
+
+  std::array<asio::const_buffer, 3> b = {{ asio::buffer("abc", 3),
+    asio::buffer("defg", 4), asio::buffer("hi", 2) }};
+  typedef asio::buffers_suffix<std::array<asio::const_buffer, 3>>
+    suffix_type;
+  suffix_type suffix(b);
+  suffix.consume(4);
+  asio::detail::buffer_sequence_adapter<asio::const_buffer, suffix_type>
+    adapter(suffix);
+  ASIO_CHECK(adapter.count() == 2);
+  ASIO_CHECK(adapter.total_size() == 5);
+}
+
+void test_socket()
+{
+  using asio::ip::tcp;
+
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket client(ioc);
+  tcp::socket server(ioc);
+  client.connect(acceptor.local_endpoint());
+  acceptor.accept(server);
+
+  std::string data = "first,second";
+  std::vector<asio::const_buffer> b;
+  b.push_back(asio::buffer(data.data(), 6));
+  b.push_back(asio::buffer(data.data() + 6, 6));
+
+  // Write the sequence with repeated calls to write_some.
+  asio::buffers_suffix<std::vector<asio::const_buffer>> remaining(b);
+  std::size_t total = 0;
+  while (asio::buffer_size(remaining) > 0)
+  {
+    std::size_t n = client.write_some(remaining);
+    remaining.consume(n);
+    total += n;
+  }
+  ASIO_CHECK(total == 12);
+
+  char out[12];
+  asio::read(server, asio::buffer(out));
+  ASIO_CHECK(std::string(out, 12) == data);
+}
+
+} // namespace buffers_suffix_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "buffers_suffix",
+  ASIO_COMPILE_TEST_CASE(buffers_suffix_compile::test)
+  ASIO_TEST_CASE(buffers_suffix_runtime::test_consume)
+  ASIO_TEST_CASE(buffers_suffix_runtime::test_native_buffers)
+  ASIO_TEST_CASE(buffers_suffix_runtime::test_socket)
+)
@@ -18,8 +18,104 @@
 
 #include "unit_test.hpp"
 
+struct small_handler
+{
+  explicit small_handler(int* count)
+    : count_(count)
+  {
+  }
+
+  void operator()(asio::cancellation_type_t)
+  {
+    ++*count_;
+  }
+
+  int* count_;
+};
+
+struct large_handler
+{
+  explicit large_handler(int* count)
+    : count_(count)
+  {
+  }
+
+  void operator()(asio::cancellation_type_t)
+  {
+    ++*count_;
+  }
+
+  int* count_;
+  char padding_[256];
+};
+
+template <typename T>
+bool is_within(const T& object, const asio::cancellation_signal& sig)
+{
+  const char* p = reinterpret_cast<const char*>(&object);
+  const char* begin = reinterpret_cast<const char*>(&sig);
+  return p >= begin && p < begin + sizeof(sig);
+}
+
+void cancellation_signal_storage_test()
+{
+  asio::cancellation_signal sig;
+  asio::cancellation_slot slot = sig.slot();
+  int count = 0;
+
+  ASIO_CHECK(slot.is_connected());
+  ASIO_CHECK(!slot.has_handler());
+  ASIO_CHECK(slot == sig.slot());
+  ASIO_CHECK(slot != asio::cancellation_slot());
+
+  // A small handler is held in the signal's own storage.
+  small_handler& h1 = slot.emplace<small_handler>(&count);
+  ASIO_CHECK(slot.has_handler());
+  ASIO_CHECK(is_within(h1, sig));
+  sig.emit(asio::cancellation_type::terminal);
+  ASIO_CHECK(count == 1);
+
+  // A large handler is allocated.
+  large_handler& h2 = slot.emplace<large_handler>(&count);
+  ASIO_CHECK(!is_within(h2, sig));
+  sig.emit(asio::cancellation_type::terminal);
+  ASIO_CHECK(count == 2);
+
+  // Replacing a large handler with a small one uses the signal's storage.
+  const void* large_memory = &h2;
+  small_handler& h3 = slot.emplace<small_handler>(&count);
+  ASIO_CHECK(is_within(h3, sig));
+  sig.emit(asio::cancellation_type::terminal);
+  ASIO_CHECK(count == 3);
+
+  slot.clear();
+  ASIO_CHECK(!slot.has_handler());
+  sig.emit(asio::cancellation_type::terminal);
+  ASIO_CHECK(count == 3);
+
+  // The memory of the earlier large handler is reused, even after a clear.
+  large_handler& h4 = slot.emplace<large_handler>(&count);
+  ASIO_CHECK(static_cast<const void*>(&h4) == large_memory);
+  slot.clear();
+  large_handler& h5 = slot.emplace<large_handler>(&count);
+  ASIO_CHECK(static_cast<const void*>(&h5) == large_memory);
+  sig.emit(asio::cancellation_type::terminal);
+  ASIO_CHECK(count == 4);
+  slot.clear();
+
+  // Handlers left installed are destroyed with the signal.
+  {
+    asio::cancellation_signal sig2;
+    sig2.slot().emplace<large_handler>(&count);
+  }
+  {
+    asio::cancellation_signal sig3;
+    sig3.slot().emplace<small_handler>(&count);
+  }
+}
+
 ASIO_TEST_SUITE
 (
   "cancellation_signal",
-  ASIO_TEST_CASE(null_test)
+  ASIO_TEST_CASE(cancellation_signal_storage_test)
 )
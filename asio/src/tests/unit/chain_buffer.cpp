@@ -0,0 +1,296 @@
+//
+// chain_buffer.cpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/chain_buffer.hpp"
+
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/read.hpp"
+#include "asio/read_until.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// chain_buffer_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the dynamic_chain_buffer class satisfies the
+// DynamicBuffer_v2 type requirements, and that its buffer sequences satisfy
+// the buffer sequence type requirements.
+
+namespace chain_buffer_compile {
+
+static_assert(asio::is_dynamic_buffer_v2<asio::dynamic_chain_buffer>::value,
+    "dynamic_chain_buffer must be a DynamicBuffer_v2");
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+static_assert(asio::is_dynamic_buffer_v1<asio::dynamic_chain_buffer>::value,
+    "dynamic_chain_buffer must be a DynamicBuffer_v1");
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+static_assert(asio::is_const_buffer_sequence<
+      asio::chain_buffer::const_buffers_type>::value,
+    "const_buffers_type must be a ConstBufferSequence");
+static_assert(asio::is_mutable_buffer_sequence<
+      asio::chain_buffer::mutable_buffers_type>::value,
+    "mutable_buffers_type must be a MutableBufferSequence");
+
+void write_handler(const asio::error_code&, std::size_t)
+{
+}
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    ip::tcp::socket socket1(ioc);
+    chain_buffer_pool pool;
+    chain_buffer chain(pool);
+    error_code ec;
+
+    socket1.send(chain.data());
+    socket1.send(chain.data(), 0, ec);
+    socket1.receive(chain.prepare(1024));
+    socket1.async_send(chain.data(), write_handler);
+    socket1.async_receive(chain.prepare(1024), write_handler);
+
+    read(socket1, dynamic_buffer(chain), ec);
+    read_until(socket1, dynamic_buffer(chain), '\n', ec);
+    async_read(socket1, dynamic_buffer(chain), write_handler);
+    async_read_until(socket1, dynamic_buffer(chain), "\r\n", write_handler);
+    write(socket1, chain.data(), ec);
+    async_write(socket1, chain.data(), write_handler);
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace chain_buffer_compile
+
+//------------------------------------------------------------------------------
+
+// chain_buffer_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the chain_buffer and
+// dynamic_chain_buffer classes.
+
+namespace chain_buffer_runtime {
+
+template <typename BufferSequence>
+std::string to_string(const BufferSequence& buffers)
+{
+  std::string s(asio::buffer_size(buffers), '\0');
+  asio::buffer_copy(asio::buffer(&s[0], s.size()), buffers);
+  return s;
+}
+
+template <typename BufferSequence>
+std::size_t buffer_count(const BufferSequence& buffers)
+{
+  return std::distance(asio::buffer_sequence_begin(buffers),
+      asio::buffer_sequence_end(buffers));
+}
+
+void test_prepare_commit()
+{
+  asio::chain_buffer_pool pool(8);
+  asio::chain_buffer chain(pool);
+
+  ASIO_CHECK(chain.size() == 0);
+  ASIO_CHECK(buffer_count(chain.data()) == 0);
+
+  // The output sequence spans several blocks.
+  asio::chain_buffer::mutable_buffers_type out = chain.prepare(20);
+  ASIO_CHECK(asio::buffer_size(out) == 20);
+  ASIO_CHECK(buffer_count(out) == 3);
+  asio::buffer_copy(out, asio::buffer("abcdefghijklmnopqrst", 20));
+  chain.commit(12);
+  ASIO_CHECK(chain.size() == 12);
+  ASIO_CHECK(to_string(chain.data()) == "abcdefghijkl");
+  ASIO_CHECK(buffer_count(chain.data()) == 2);
+
+  // The free space at the end of the last block is used before a new block.
+  ASIO_CHECK(chain.capacity() == 16);
+  out = chain.prepare(4);
+  ASIO_CHECK(buffer_count(out) == 1);
+  asio::buffer_copy(out, asio::buffer("mnop", 4));
+  chain.commit(4);
+  ASIO_CHECK(to_string(chain.data()) == "abcdefghijklmnop");
+
+  // Consuming data releases whole blocks from the beginning.
+  chain.consume(10);
+  ASIO_CHECK(chain.size() == 6);
+  ASIO_CHECK(to_string(chain.data()) == "klmnop");
+  ASIO_CHECK(buffer_count(chain.data()) == 1);
+  ASIO_CHECK(to_string(chain.data(2, 3)) == "mno");
+  ASIO_CHECK(to_string(chain.data(4, 100)) == "op");
+  ASIO_CHECK(to_string(chain.data(100, 1)) == "");
+
+  chain.consume(100);
+  ASIO_CHECK(chain.size() == 0);
+}
+
+void test_grow_shrink()
+{
+  asio::chain_buffer_pool pool(8);
+  asio::chain_buffer chain(pool, 30);
+  asio::dynamic_chain_buffer db = asio::dynamic_buffer(chain);
+
+  db.grow(10);
+  ASIO_CHECK(db.size() == 10);
+  asio::buffer_copy(db.data(0, 10), asio::buffer("0123456789", 10));
+  db.grow(10);
+  asio::buffer_copy(db.data(10, 10), asio::buffer("abcdefghij", 10));
+  ASIO_CHECK(to_string(db.data(0, 20)) == "0123456789abcdefghij");
+  ASIO_CHECK(to_string(db.data(6, 6)) == "6789ab");
+
+  db.shrink(5);
+  ASIO_CHECK(to_string(db.data(0, db.size())) == "0123456789abcde");
+
+  bool thrown = false;
+  try
+  {
+    db.grow(16);
+  }
+  catch (std::length_error&)
+  {
+    thrown = true;
+  }
+  ASIO_CHECK(thrown);
+  ASIO_CHECK(db.size() == 15);
+
+  db.consume(3);
+  ASIO_CHECK(to_string(db.data(0, db.size())) == "3456789abcde");
+  db.shrink(100);
+  ASIO_CHECK(db.size() == 0);
+}
+
+void test_append()
+{
+  asio::chain_buffer_pool pool(8);
+  asio::chain_buffer cached(pool);
+  cached.append(asio::buffer(std::string("HEADER: value\r\n")));
+  ASIO_CHECK(to_string(cached.data()) == "HEADER: value\r\n");
+
+  asio::chain_buffer response(pool);
+  response.append(asio::buffer("HTTP/1.1 200 OK\r\n", 17));
+  response.append(cached);
+  response.append(cached, 8, 5);
+  ASIO_CHECK(to_string(response.data())
+      == "HTTP/1.1 200 OK\r\nHEADER: value\r\nvalue");
+
+  // The slices share the cached buffer's blocks.
+  asio::const_buffer first_cached = *cached.data().begin();
+  bool shared = false;
+  asio::chain_buffer::const_buffers_type data = response.data();
+  for (asio::chain_buffer::const_buffers_type::const_iterator
+      i = data.begin(); i != data.end(); ++i)
+    if (asio::const_buffer(*i).data() == first_cached.data())
+      shared = true;
+  ASIO_CHECK(shared);
+
+  // New data is never written into a shared block.
+  cached.append(asio::buffer("X", 1));
+  response.append(asio::buffer("Y", 1));
+  ASIO_CHECK(to_string(cached.data()) == "HEADER: value\r\nX");
+  ASIO_CHECK(to_string(response.data())
+      == "HTTP/1.1 200 OK\r\nHEADER: value\r\nvalueY");
+
+  // The slices remain valid after the original buffer is released.
+  cached.clear();
+  ASIO_CHECK(to_string(response.data())
+      == "HTTP/1.1 200 OK\r\nHEADER: value\r\nvalueY");
+
+  // A buffer may append a slice of itself.
+  asio::chain_buffer loop(pool);
+  loop.append(asio::buffer("abc", 3));
+  loop.append(loop);
+  loop.append(loop, 1, 4);
+  ASIO_CHECK(to_string(loop.data()) == "abcabcbcab");
+}
+
+void test_socket()
+{
+  using asio::ip::tcp;
+
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket client(ioc);
+  tcp::socket server(ioc);
+  client.connect(acceptor.local_endpoint());
+  acceptor.accept(server);
+
+  asio::chain_buffer_pool pool(16);
+  asio::chain_buffer out(pool);
+  out.append(asio::buffer(std::string(100, 'a')));
+  out.append(asio::buffer("\r\n", 2));
+  out.append(out, 0, 30);
+  out.append(asio::buffer("\r\n", 2));
+  ASIO_CHECK(buffer_count(out.data()) > 2);
+
+  std::size_t written = 0;
+  asio::async_write(client, out.data(),
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        ASIO_CHECK(!e);
+        written = n;
+      });
+
+  asio::chain_buffer in(pool);
+  std::size_t lines[2] = { 0, 0 };
+  asio::async_read_until(server, asio::dynamic_buffer(in), "\r\n",
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        ASIO_CHECK(!e);
+        lines[0] = n;
+        in.consume(n);
+        asio::async_read_until(server, asio::dynamic_buffer(in), "\r\n",
+            [&](const asio::error_code& e, std::size_t n)
+            {
+              ASIO_CHECK(!e);
+              lines[1] = n;
+            });
+      });
+  ioc.run();
+
+  ASIO_CHECK(written == 134);
+  ASIO_CHECK(lines[0] == 102);
+  ASIO_CHECK(lines[1] == 32);
+  ASIO_CHECK(to_string(in.data(0, lines[1]))
+      == std::string(30, 'a') + "\r\n");
+}
+
+} // namespace chain_buffer_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "chain_buffer",
+  ASIO_COMPILE_TEST_CASE(chain_buffer_compile::test)
+  ASIO_TEST_CASE(chain_buffer_runtime::test_prepare_commit)
+  ASIO_TEST_CASE(chain_buffer_runtime::test_grow_shrink)
+  ASIO_TEST_CASE(chain_buffer_runtime::test_append)
+  ASIO_TEST_CASE(chain_buffer_runtime::test_socket)
+)
@@ -22,8 +22,15 @@
 
 #include <stdexcept>
 #include "asio/any_completion_handler.hpp"
+#include "asio/awaitable_arena_allocator.hpp"
+#include "asio/bind_allocator.hpp"
 #include "asio/bind_cancellation_slot.hpp"
+#include "asio/bind_executor.hpp"
 #include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/steady_timer.hpp"
+#include "asio/this_coro.hpp"
+#include "asio/use_awaitable.hpp"
 
 asio::awaitable<void> void_returning_coroutine()
 {
@@ -115,11 +122,205 @@ void test_co_spawn_immediate_cancel()
   ASIO_CHECK(result != nullptr);
 }
 
+asio::awaitable<void> wait_forever()
+{
+  asio::steady_timer timer(co_await asio::this_coro::executor,
+      asio::steady_timer::time_point::max());
+  co_await timer.async_wait(asio::use_awaitable);
+}
+
+void test_co_spawn_cancel_with_associated_executor()
+{
+  asio::cancellation_signal sig;
+  asio::io_context ctx(ASIO_CONCURRENCY_HINT_UNSAFE);
+
+  std::exception_ptr result = nullptr;
+  bool called = false;
+  asio::co_spawn(ctx, wait_forever(),
+      asio::bind_cancellation_slot(sig.slot(),
+        asio::bind_executor(ctx.get_executor(),
+          [&](std::exception_ptr e)
+          {
+            result = e;
+            called = true;
+          })));
+
+  asio::post(ctx, [&]{ sig.emit(asio::cancellation_type::all); });
+  ctx.run();
+
+  ASIO_CHECK(called);
+  ASIO_CHECK(result != nullptr);
+
+  // The signal is released when the operation completes without cancellation.
+  result = nullptr;
+  called = false;
+  asio::co_spawn(ctx, int_returning_coroutine(),
+      asio::bind_cancellation_slot(sig.slot(),
+        asio::bind_executor(ctx.get_executor(),
+          [&](std::exception_ptr e, int i)
+          {
+            ASIO_CHECK(e == nullptr);
+            ASIO_CHECK(i == 42);
+            result = e;
+            called = true;
+          })));
+
+  ctx.restart();
+  ctx.run();
+  sig.slot().clear();
+  sig.emit(asio::cancellation_type::all);
+
+  ASIO_CHECK(called);
+  ASIO_CHECK(result == nullptr);
+
+  // Emitting from outside the executor defers the emission.
+  called = false;
+  asio::co_spawn(ctx, wait_forever(),
+      asio::bind_cancellation_slot(sig.slot(),
+        asio::bind_executor(asio::require(ctx.get_executor(),
+            asio::execution::blocking.never),
+          [&](std::exception_ptr e)
+          {
+            result = e;
+            called = true;
+          })));
+
+  ctx.restart();
+  ctx.poll();
+  sig.emit(asio::cancellation_type::all);
+  ASIO_CHECK(!called);
+  ctx.run();
+
+  ASIO_CHECK(called);
+  ASIO_CHECK(result != nullptr);
+}
+
+asio::awaitable<int> sum_to(int n)
+{
+  if (n == 0)
+    co_return 0;
+  co_await asio::post(asio::use_awaitable);
+  co_return n + co_await sum_to(n - 1);
+}
+
+asio::awaitable<int> arena_coroutine(asio::io_context& ctx, int* escaped)
+{
+  int total = co_await sum_to(100);
+
+  // Frames destroyed out of LIFO order.
+  asio::awaitable<int> a = int_returning_coroutine();
+  asio::awaitable<int> b = sum_to(10);
+  total += co_await std::move(b);
+  total += co_await std::move(a);
+
+  // A frame that escapes to another thread of execution, and outlives this
+  // one.
+  asio::co_spawn(ctx, sum_to(20),
+      [escaped](std::exception_ptr, int i)
+      {
+        *escaped = i;
+      });
+
+  co_return total;
+}
+
+void test_co_spawn_frame_arena()
+{
+  asio::io_context ctx;
+
+  int result = 0;
+  int escaped = 0;
+  asio::co_spawn(ctx, arena_coroutine(ctx, &escaped),
+      asio::bind_allocator(asio::awaitable_arena_allocator<void>(256),
+        [&](std::exception_ptr e, int i)
+        {
+          ASIO_CHECK(e == nullptr);
+          result = i;
+        }));
+
+  ctx.run();
+
+  ASIO_CHECK(result == 5050 + 55 + 42);
+  ASIO_CHECK(escaped == 210);
+
+  asio::awaitable_arena_allocator<int> a1;
+  asio::awaitable_arena_allocator<void> a2(a1);
+  ASIO_CHECK(a2.chunk_size()
+      == asio::awaitable_arena_allocator<void>::default_chunk_size);
+  int* p = a1.allocate(4);
+  a1.deallocate(p, 4);
+}
+
+asio::awaitable<int> identity(int i)
+{
+  co_return i;
+}
+
+asio::awaitable<int> recurse(int depth)
+{
+  if (depth == 0)
+    co_return 0;
+  co_return 1 + co_await recurse(depth - 1);
+}
+
+asio::awaitable<void> throw_from(int depth)
+{
+  if (depth == 0)
+    throw std::runtime_error("nested");
+  co_await throw_from(depth - 1);
+}
+
+asio::awaitable<int> symmetric_transfer_coroutine()
+{
+  // Awaited coroutines that complete without suspending transfer control
+  // directly to and from their callers, so a long loop does not consume
+  // stack.
+  int total = 0;
+  for (int i = 0; i < 1000000; ++i)
+    total += co_await identity(1);
+
+  total += co_await recurse(10000);
+
+  try
+  {
+    co_await throw_from(100);
+  }
+  catch (const std::runtime_error&)
+  {
+    ++total;
+  }
+
+  // Transfers mixed with asynchronous operations.
+  total += co_await sum_to(10);
+
+  co_return total;
+}
+
+void test_co_spawn_symmetric_transfer()
+{
+  asio::io_context ctx;
+
+  int result = 0;
+  asio::co_spawn(ctx, symmetric_transfer_coroutine(),
+      [&](std::exception_ptr e, int i)
+      {
+        ASIO_CHECK(e == nullptr);
+        result = i;
+      });
+
+  ctx.run();
+
+  ASIO_CHECK(result == 1000000 + 10000 + 1 + 55);
+}
+
 ASIO_TEST_SUITE
 (
   "co_spawn",
   ASIO_TEST_CASE(test_co_spawn_with_any_completion_handler)
   ASIO_TEST_CASE(test_co_spawn_immediate_cancel)
+  ASIO_TEST_CASE(test_co_spawn_cancel_with_associated_executor)
+  ASIO_TEST_CASE(test_co_spawn_frame_arena)
+  ASIO_TEST_CASE(test_co_spawn_symmetric_transfer)
 )
 
 #else // defined(ASIO_HAS_CO_AWAIT)
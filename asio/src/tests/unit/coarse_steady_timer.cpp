@@ -0,0 +1,88 @@
+//
+// coarse_steady_timer.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Prevent link dependency on the Boost.System library.
+#if !defined(BOOST_SYSTEM_NO_DEPRECATED)
+#define BOOST_SYSTEM_NO_DEPRECATED
+#endif // !defined(BOOST_SYSTEM_NO_DEPRECATED)
+
+// Test that header file is self-contained.
+#include "asio/coarse_steady_timer.hpp"
+
+#include "asio/io_context.hpp"
+#include "unit_test.hpp"
+
+void coarse_steady_clock_test()
+{
+  asio::coarse_steady_clock::time_point t1 = asio::coarse_steady_clock::now();
+  asio::coarse_steady_clock::time_point t2 = asio::coarse_steady_clock::now();
+  ASIO_CHECK(t2 >= t1);
+
+  // The coarse clock shares the steady clock's epoch, but may lag it by up to
+  // one tick.
+  asio::chrono::steady_clock::time_point s = asio::chrono::steady_clock::now();
+  asio::coarse_steady_clock::time_point c = asio::coarse_steady_clock::now();
+  ASIO_CHECK(c.time_since_epoch()
+      <= asio::chrono::duration_cast<asio::chrono::nanoseconds>(
+        s.time_since_epoch()) + asio::chrono::milliseconds(50));
+  ASIO_CHECK(c.time_since_epoch() + asio::chrono::milliseconds(50)
+      >= asio::chrono::duration_cast<asio::chrono::nanoseconds>(
+        s.time_since_epoch()));
+}
+
+struct coarse_timer_handler
+{
+  asio::coarse_steady_timer* timer_;
+  int* count_;
+
+  void operator()(const asio::error_code& ec)
+  {
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(timer_->expiry() <= asio::coarse_steady_clock::now());
+    ++(*count_);
+  }
+};
+
+void coarse_steady_timer_test()
+{
+  asio::io_context ioc;
+  int count = 0;
+
+  asio::coarse_steady_timer t1(ioc, asio::chrono::milliseconds(20));
+  coarse_timer_handler h1 = { &t1, &count };
+  t1.async_wait(h1);
+
+  // Rearming a timer cancels the previous wait.
+  asio::coarse_steady_timer t2(ioc);
+  for (int i = 0; i < 100; ++i)
+  {
+    t2.expires_after(asio::chrono::milliseconds(10 + i));
+    t2.async_wait([](const asio::error_code&){});
+  }
+  t2.expires_after(asio::chrono::milliseconds(10));
+  coarse_timer_handler h2 = { &t2, &count };
+  t2.async_wait(h2);
+
+  ioc.run();
+
+  ASIO_CHECK(count == 2);
+}
+
+ASIO_TEST_SUITE
+(
+  "coarse_steady_timer",
+  ASIO_TEST_CASE(coarse_steady_clock_test)
+  ASIO_TEST_CASE(coarse_steady_timer_test)
+)
@@ -519,6 +519,94 @@ void compose_total_cancellation_test()
 
 //------------------------------------------------------------------------------
 
+template <typename Timer>
+class impl_timer_steps
+{
+public:
+  impl_timer_steps(Timer& timer, int* steps)
+    : timer_(timer),
+      steps_(steps)
+  {
+  }
+
+  template <typename Self>
+  void operator()(Self& self, asio::error_code ec = asio::error_code())
+  {
+    // Intermediate handlers use the I/O executor without tracking work.
+    ASIO_CHECK((asio::is_same<decltype(self.get_executor()),
+        typename Timer::executor_type>::value));
+    ASIO_CHECK(self.get_executor() == timer_.get_executor());
+
+    if (!ec && ++(*steps_) < 4)
+    {
+      timer_.expires_after(asio::chrono::seconds(0));
+      timer_.async_wait(static_cast<Self&&>(self));
+    }
+    else
+    {
+      self.complete(ec);
+    }
+  }
+
+private:
+  Timer& timer_;
+  int* steps_;
+};
+
+template <typename Timer, typename CompletionToken>
+ASIO_INITFN_RESULT_TYPE(CompletionToken, void(asio::error_code))
+async_timer_steps(Timer& timer, int* steps, CompletionToken&& token)
+{
+  return asio::async_initiate<CompletionToken, void(asio::error_code)>(
+      asio::composed(impl_timer_steps<Timer>(timer, steps), timer), token);
+}
+
+void compose_timer_steps_handler(int* count, asio::error_code ec)
+{
+  ASIO_CHECK(!ec);
+  ++(*count);
+}
+
+void compose_untracked_steps_test()
+{
+  namespace bindns = std;
+  using bindns::placeholders::_1;
+
+  asio::io_context ioc;
+  asio::system_timer timer(ioc);
+  int steps = 0;
+  int count = 0;
+
+  async_timer_steps(timer, &steps,
+      bindns::bind(&compose_timer_steps_handler, &count, _1));
+
+  // The composed operation keeps the work outstanding between steps.
+  ioc.run();
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(steps == 4);
+  ASIO_CHECK(count == 1);
+
+  ioc.restart();
+  steps = 0;
+  count = 0;
+
+  asio::basic_waitable_timer<asio::chrono::system_clock,
+      asio::wait_traits<asio::chrono::system_clock>,
+      asio::io_context::executor_type> native_timer(ioc);
+
+  async_timer_steps(native_timer, &steps,
+      bindns::bind(&compose_timer_steps_handler, &count, _1));
+
+  ioc.run();
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(steps == 4);
+  ASIO_CHECK(count == 1);
+}
+
+//------------------------------------------------------------------------------
+
 ASIO_TEST_SUITE
 (
   "compose",
@@ -527,4 +615,5 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(compose_default_cancellation_test)
   ASIO_TEST_CASE(compose_partial_cancellation_test)
   ASIO_TEST_CASE(compose_total_cancellation_test)
+  ASIO_TEST_CASE(compose_untracked_steps_test)
 )
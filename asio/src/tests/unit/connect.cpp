@@ -18,6 +18,8 @@
 
 #include <functional>
 #include <vector>
+#include "asio/bind_cancellation_slot.hpp"
+#include "asio/cancellation_signal.hpp"
 #include "asio/detail/thread.hpp"
 #include "asio/ip/tcp.hpp"
 #include "unit_test.hpp"
@@ -1191,6 +1193,69 @@ void test_async_connect_iter_cond()
   ASIO_CHECK(ec == asio::error::not_found);
 }
 
+void test_async_connect_staggered()
+{
+  connection_sink sink;
+  asio::io_context io_context;
+  asio::ip::tcp::socket socket(io_context);
+  std::vector<asio::ip::tcp::endpoint> endpoints;
+  asio::ip::tcp::endpoint result;
+  asio::error_code ec;
+  asio::staggered_connect options(std::chrono::milliseconds(10));
+
+  asio::async_connect(socket, endpoints, options,
+      bindns::bind(range_handler, _1, _2, &ec, &result));
+  io_context.restart();
+  io_context.run();
+  ASIO_CHECK(result == asio::ip::tcp::endpoint());
+  ASIO_CHECK(ec == asio::error::not_found);
+
+  endpoints.push_back(sink.target_endpoint());
+
+  asio::async_connect(socket, endpoints, options,
+      bindns::bind(range_handler, _1, _2, &ec, &result));
+  io_context.restart();
+  io_context.run();
+  ASIO_CHECK(result == endpoints[0]);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(socket.is_open());
+  ASIO_CHECK(socket.remote_endpoint(ec) == endpoints[0]);
+
+  // An endpoint that is unreachable, or does not answer, must not prevent the
+  // following endpoint from being tried.
+  endpoints.insert(endpoints.begin(), asio::ip::tcp::endpoint(
+        asio::ip::make_address_v4("192.0.2.1"), 9));
+
+  asio::async_connect(socket, endpoints, options,
+      bindns::bind(range_handler, _1, _2, &ec, &result));
+  io_context.restart();
+  io_context.run();
+  ASIO_CHECK(result == endpoints[1]);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(socket.is_open());
+
+  asio::async_connect(socket, endpoints, asio::staggered_connect())(
+      bindns::bind(range_handler, _1, _2, &ec, &result));
+  io_context.restart();
+  io_context.run();
+  ASIO_CHECK(result == endpoints[1]);
+  ASIO_CHECK(!ec);
+
+  endpoints.pop_back();
+
+  asio::cancellation_signal cancel;
+  asio::async_connect(socket, endpoints, options,
+      asio::bind_cancellation_slot(cancel.slot(),
+        bindns::bind(range_handler, _1, _2, &ec, &result)));
+  cancel.emit(asio::cancellation_type::terminal);
+  io_context.restart();
+  io_context.run();
+  ASIO_CHECK(result == asio::ip::tcp::endpoint());
+  ASIO_CHECK(ec == asio::error::operation_aborted);
+  ASIO_CHECK(!socket.is_open());
+  ASIO_CHECK(!cancel.slot().has_handler());
+}
+
 ASIO_TEST_SUITE
 (
   "connect",
@@ -1206,4 +1271,5 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(test_async_connect_range_cond)
   ASIO_TEST_CASE(test_async_connect_iter)
   ASIO_TEST_CASE(test_async_connect_iter_cond)
+  ASIO_TEST_CASE(test_async_connect_staggered)
 )
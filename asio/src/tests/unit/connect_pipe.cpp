@@ -25,6 +25,10 @@
 #include "asio/write.hpp"
 #include "unit_test.hpp"
 
+#if defined(ASIO_HAS_PIPE) && !defined(ASIO_HAS_IOCP)
+# include <fcntl.h>
+#endif // defined(ASIO_HAS_PIPE) && !defined(ASIO_HAS_IOCP)
+
 //------------------------------------------------------------------------------
 
 // connect_pipe_compile test
@@ -51,6 +55,14 @@ void test()
     readable_pipe p3(io_context);
     writable_pipe p4(io_context);
     connect_pipe(p3, p4, ec1);
+
+    readable_pipe p5(io_context);
+    writable_pipe p6(io_context);
+    connect_pipe(p5, p6, 65536);
+
+    readable_pipe p7(io_context);
+    writable_pipe p8(io_context);
+    connect_pipe(p7, p8, 65536, ec1);
   }
   catch (std::exception&)
   {
@@ -140,6 +152,32 @@ void test()
 #endif // defined(ASIO_HAS_PIPE)
 }
 
+void test_capacity()
+{
+#if defined(ASIO_HAS_PIPE)
+  asio::io_context io_context;
+  asio::readable_pipe p1(io_context);
+  asio::writable_pipe p2(io_context);
+
+  asio::error_code ec;
+  asio::connect_pipe(p1, p2, 256 * 1024, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(p1.is_open());
+  ASIO_CHECK(p2.is_open());
+
+# if defined(F_GETPIPE_SZ)
+  // The capacity may be rounded up, but is never less than requested.
+  ASIO_CHECK(::fcntl(p2.native_handle(), F_GETPIPE_SZ) >= 256 * 1024);
+# endif // defined(F_GETPIPE_SZ)
+
+  std::string data1(1000, 'x');
+  asio::write(p2, asio::buffer(data1));
+  std::string data2(data1.size(), '\0');
+  asio::read(p1, asio::buffer(data2));
+  ASIO_CHECK(data1 == data2);
+#endif // defined(ASIO_HAS_PIPE)
+}
+
 } // namespace connect_pipe_compile
 
 //------------------------------------------------------------------------------
@@ -149,4 +187,5 @@ ASIO_TEST_SUITE
   "connect_pipe",
   ASIO_COMPILE_TEST_CASE(connect_pipe_compile::test)
   ASIO_TEST_CASE(connect_pipe_runtime::test)
+  ASIO_TEST_CASE(connect_pipe_runtime::test_capacity)
 )
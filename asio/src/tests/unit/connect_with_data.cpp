@@ -0,0 +1,257 @@
+//
+// connect_with_data.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/connect_with_data.hpp"
+
+#include <string>
+#include <vector>
+#include "archetypes/async_result.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/read.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// connect_with_data_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the async_connect_with_data function
+// compiles for the supported buffer sequence types. Runtime failures are
+// ignored.
+
+namespace connect_with_data_compile {
+
+struct write_handler
+{
+  write_handler() {}
+  void operator()(const asio::error_code&, std::size_t) {}
+  write_handler(write_handler&&) {}
+private:
+  write_handler(const write_handler&);
+};
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    archetypes::lazy_handler lazy;
+    char data[1024] = "";
+    std::vector<const_buffer> buffers;
+    buffers.push_back(buffer(data, 512));
+    buffers.push_back(buffer(data + 512, 512));
+
+    ip::tcp::socket socket1(ioc);
+    ip::tcp::endpoint endpoint1(ip::address_v4::loopback(), 0);
+    ip::tcp::acceptor acceptor1(ioc);
+
+    async_connect_with_data(socket1, endpoint1,
+        buffer(data), write_handler());
+    async_connect_with_data(socket1, endpoint1,
+        buffers, write_handler());
+    int i1 = async_connect_with_data(socket1, endpoint1, buffer(data), lazy);
+    (void)i1;
+
+#if defined(ASIO_HAS_TCP_FASTOPEN)
+    ip::tcp::fast_open fast_open1(16);
+    acceptor1.set_option(fast_open1);
+    acceptor1.get_option(fast_open1);
+#endif // defined(ASIO_HAS_TCP_FASTOPEN)
+
+#if defined(ASIO_HAS_TCP_DEFER_ACCEPT)
+    ip::tcp::defer_accept defer_accept1(5);
+    acceptor1.set_option(defer_accept1);
+    acceptor1.get_option(defer_accept1);
+#endif // defined(ASIO_HAS_TCP_DEFER_ACCEPT)
+
+    ioc.run();
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace connect_with_data_compile
+
+//------------------------------------------------------------------------------
+
+// connect_with_data_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the
+// async_connect_with_data function.
+
+namespace connect_with_data_runtime {
+
+using asio::ip::tcp;
+
+std::string make_data(std::size_t size)
+{
+  std::string data(size, '\0');
+  for (std::size_t i = 0; i < size; ++i)
+    data[i] = static_cast<char>(i % 251);
+  return data;
+}
+
+struct connect_with_data_test
+{
+  connect_with_data_test()
+    : acceptor(ioc),
+      client(ioc),
+      server(ioc)
+  {
+    tcp::endpoint endpoint(asio::ip::address_v4::loopback(), 0);
+    acceptor.open(endpoint.protocol());
+    acceptor.bind(endpoint);
+
+    // Fast Open may be disabled for servers on the host, in which case the
+    // connection falls back to a normal handshake.
+    asio::error_code ignored_ec;
+#if defined(ASIO_HAS_TCP_FASTOPEN)
+    acceptor.set_option(tcp::fast_open(16), ignored_ec);
+#endif // defined(ASIO_HAS_TCP_FASTOPEN)
+#if defined(ASIO_HAS_TCP_DEFER_ACCEPT)
+    acceptor.set_option(tcp::defer_accept(1), ignored_ec);
+#endif // defined(ASIO_HAS_TCP_DEFER_ACCEPT)
+
+    acceptor.listen();
+  }
+
+  // Connect with the data and read it back on an accepted socket.
+  void run(const std::string& data, asio::error_code& write_ec,
+      std::size_t& sent, std::string& received)
+  {
+    asio::async_connect_with_data(client, acceptor.local_endpoint(),
+        asio::buffer(data),
+        [&](const asio::error_code& ec, std::size_t n)
+        {
+          write_ec = ec;
+          sent = n;
+          client.shutdown(tcp::socket::shutdown_send);
+        });
+    acceptor.async_accept(server,
+        [&](const asio::error_code& ec)
+        {
+          if (!ec)
+          {
+            asio::async_read(server, asio::dynamic_buffer(received),
+                [](const asio::error_code&, std::size_t) {});
+          }
+        });
+    ioc.run();
+  }
+
+  asio::io_context ioc;
+  tcp::acceptor acceptor;
+  tcp::socket client;
+  tcp::socket server;
+};
+
+void test_small_request()
+{
+  std::string data = make_data(100);
+
+  // The first connection obtains a Fast Open cookie, and the second uses it.
+  for (int i = 0; i < 2; ++i)
+  {
+    connect_with_data_test t;
+
+    asio::error_code ec;
+    std::size_t sent = 0;
+    std::string received;
+    t.run(data, ec, sent, received);
+
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(sent == data.size());
+    ASIO_CHECK(received == data);
+    ASIO_CHECK(t.client.remote_endpoint(ec) == t.acceptor.local_endpoint());
+  }
+}
+
+void test_large_request()
+{
+  // Enough data that the socket fills before the server drains it.
+  std::string data = make_data(4 * 1024 * 1024);
+  connect_with_data_test t;
+
+  asio::error_code ec;
+  std::size_t sent = 0;
+  std::string received;
+  t.run(data, ec, sent, received);
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(sent == data.size());
+  ASIO_CHECK(received == data);
+}
+
+void test_empty_request()
+{
+  connect_with_data_test t;
+
+  asio::error_code ec;
+  std::size_t sent = 1;
+  std::string received;
+  t.run(std::string(), ec, sent, received);
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(sent == 0);
+  ASIO_CHECK(received.empty());
+}
+
+void test_connection_refused()
+{
+  asio::io_context ioc;
+  tcp::endpoint endpoint;
+  {
+    tcp::acceptor acceptor(ioc,
+        tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+    endpoint = acceptor.local_endpoint();
+  }
+
+  tcp::socket client(ioc);
+  std::string data = make_data(100);
+  bool called = false;
+  asio::error_code write_ec;
+  std::size_t sent = 1;
+  asio::async_connect_with_data(client, endpoint, asio::buffer(data),
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        called = true;
+        write_ec = ec;
+        sent = n;
+      });
+  ASIO_CHECK(!called);
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(write_ec == asio::error::connection_refused);
+  ASIO_CHECK(sent == 0 || sent == data.size());
+}
+
+} // namespace connect_with_data_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "connect_with_data",
+  ASIO_COMPILE_TEST_CASE(connect_with_data_compile::test)
+  ASIO_TEST_CASE(connect_with_data_runtime::test_small_request)
+  ASIO_TEST_CASE(connect_with_data_runtime::test_large_request)
+  ASIO_TEST_CASE(connect_with_data_runtime::test_empty_request)
+  ASIO_TEST_CASE(connect_with_data_runtime::test_connection_refused)
+)
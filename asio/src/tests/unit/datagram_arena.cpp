@@ -0,0 +1,240 @@
+//
+// datagram_arena.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/datagram_arena.hpp"
+
+#include <cstring>
+#include <vector>
+#include "archetypes/async_result.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/udp.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_DATAGRAM_BATCH)
+
+//------------------------------------------------------------------------------
+
+// datagram_arena_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// datagram_arena, and the async_receive_arena operations that use it, compile
+// and link correctly. Runtime failures are ignored.
+
+namespace datagram_arena_compile {
+
+struct receive_handler
+{
+  receive_handler() {}
+  void operator()(const asio::error_code&, std::size_t) {}
+  receive_handler(receive_handler&&) {}
+private:
+  receive_handler(const receive_handler&);
+};
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    archetypes::lazy_handler lazy;
+    socket_base::message_flags in_flags = 0;
+
+    datagram_arena<ip::udp> arena(4, 1500);
+
+    std::size_t n1 = arena.max_packets();
+    (void)n1;
+    std::size_t n2 = arena.max_packet_size();
+    (void)n2;
+    std::size_t n3 = arena.size();
+    (void)n3;
+    bool b1 = arena.empty();
+    (void)b1;
+
+    const datagram_arena<ip::udp>::packet* p1 = arena.packets();
+    (void)p1;
+    for (datagram_arena<ip::udp>::const_iterator i = arena.begin();
+        i != arena.end(); ++i)
+    {
+      const_buffer cb1 = arena.payload(*i);
+      (void)cb1;
+      ip::udp::endpoint e1 = i->endpoint;
+      (void)e1;
+      datagram_arena<ip::udp>::clock_type::time_point t1 = i->timestamp;
+      (void)t1;
+    }
+    const datagram_arena<ip::udp>::packet& p2 = arena[0];
+    (void)p2;
+    const_buffer cb2 = arena.payload();
+    (void)cb2;
+    arena.clear();
+
+    ip::udp::socket socket1(ioc, ip::udp::v4());
+    socket1.async_receive_arena(arena, receive_handler());
+    socket1.async_receive_arena(arena, in_flags, receive_handler());
+    int i1 = socket1.async_receive_arena(arena, lazy);
+    (void)i1;
+    int i2 = socket1.async_receive_arena(arena, in_flags, lazy);
+    (void)i2;
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace datagram_arena_compile
+
+//------------------------------------------------------------------------------
+
+// datagram_arena_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the datagram_arena class
+// and the async_receive_arena operations that use it.
+
+namespace datagram_arena_runtime {
+
+using asio::ip::udp;
+
+void test_receive()
+{
+  asio::io_context ioc;
+
+  udp::socket receiver(ioc, udp::endpoint(asio::ip::address_v4::loopback(), 0));
+  udp::socket sender(ioc, udp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+  const char* messages[] = { "ABCDEFGHIJKLMNOPQRSTUVWXYZ", "abcdefghij", "0" };
+  for (int i = 0; i < 3; ++i)
+  {
+    sender.send_to(asio::buffer(messages[i], std::strlen(messages[i])),
+        receiver.local_endpoint());
+  }
+
+  asio::datagram_arena<udp> arena(8, 16);
+  ASIO_CHECK(arena.max_packets() == 8);
+  ASIO_CHECK(arena.max_packet_size() == 16);
+  ASIO_CHECK(arena.empty());
+  ASIO_CHECK(arena.payload().size() == 8 * 16);
+
+  bool called = false;
+  asio::error_code receive_ec;
+  std::size_t received = 0;
+  asio::datagram_arena<udp>::clock_type::time_point before =
+    asio::datagram_arena<udp>::clock_type::now();
+  receiver.async_receive_arena(arena,
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        called = true;
+        receive_ec = ec;
+        received = n;
+      });
+  ASIO_CHECK(!called);
+  ioc.run();
+  ASIO_CHECK(called);
+
+  ASIO_CHECK(!receive_ec);
+  ASIO_CHECK(received == 3);
+  ASIO_CHECK(arena.size() == 3);
+  ASIO_CHECK(arena.end() - arena.begin() == 3);
+
+  // Datagrams have consecutive slots within the payload region. Data beyond
+  // a slot's size is truncated.
+  const char* base = static_cast<const char*>(arena.payload().data());
+  for (std::size_t i = 0; i < arena.size(); ++i)
+  {
+    const asio::datagram_arena<udp>::packet& p = arena[i];
+    std::size_t expected = std::strlen(messages[i]);
+    if (expected > 16)
+      expected = 16;
+    ASIO_CHECK(p.offset == i * 16);
+    ASIO_CHECK(p.length == expected);
+    ASIO_CHECK(p.endpoint == sender.local_endpoint());
+    ASIO_CHECK(p.timestamp >= before);
+    ASIO_CHECK(arena.payload(p).data() == base + p.offset);
+    ASIO_CHECK(std::memcmp(base + p.offset, messages[i], p.length) == 0);
+  }
+
+  arena.clear();
+  ASIO_CHECK(arena.empty());
+}
+
+void test_errors()
+{
+  asio::io_context ioc;
+
+  bool caught = false;
+  try
+  {
+    asio::datagram_arena<udp> arena(0, 1500);
+  }
+  catch (asio::system_error& e)
+  {
+    caught = (e.code() == asio::error::invalid_argument);
+  }
+  ASIO_CHECK(caught);
+
+  caught = false;
+  try
+  {
+    asio::datagram_arena<udp> arena(
+        asio::datagram_arena<udp>::max_capacity + 1, 1500);
+  }
+  catch (asio::system_error& e)
+  {
+    caught = (e.code() == asio::error::invalid_argument);
+  }
+  ASIO_CHECK(caught);
+
+  // A failed receive leaves the arena empty.
+  udp::socket receiver(ioc, udp::endpoint(asio::ip::address_v4::loopback(), 0));
+  asio::datagram_arena<udp> arena(4, 1500);
+  asio::error_code receive_ec;
+  std::size_t received = 1;
+  receiver.async_receive_arena(arena,
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        receive_ec = ec;
+        received = n;
+      });
+  receiver.close();
+  ioc.run();
+  ASIO_CHECK(receive_ec == asio::error::operation_aborted);
+  ASIO_CHECK(received == 0);
+  ASIO_CHECK(arena.empty());
+}
+
+} // namespace datagram_arena_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "datagram_arena",
+  ASIO_COMPILE_TEST_CASE(datagram_arena_compile::test)
+  ASIO_TEST_CASE(datagram_arena_runtime::test_receive)
+  ASIO_TEST_CASE(datagram_arena_runtime::test_errors)
+)
+
+#else // defined(ASIO_HAS_DATAGRAM_BATCH)
+
+ASIO_TEST_SUITE
+(
+  "datagram_arena",
+  ASIO_TEST_CASE(null_test)
+)
+
+#endif // defined(ASIO_HAS_DATAGRAM_BATCH)
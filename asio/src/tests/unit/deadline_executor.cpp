@@ -0,0 +1,198 @@
+//
+// deadline_executor.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/deadline_executor.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include "asio/bind_executor.hpp"
+#include "asio/dispatch.hpp"
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/thread_pool.hpp"
+#include "unit_test.hpp"
+
+using namespace asio;
+typedef std::chrono::steady_clock clock_type;
+
+void append(std::string* s, char c)
+{
+  *s += c;
+}
+
+void deadline_executor_order_test()
+{
+  io_context ioc;
+  deadline_executor<io_context::executor_type> ex =
+    make_deadline_executor(ioc);
+
+  clock_type::time_point now = clock_type::now();
+  std::chrono::hours hour(1);
+  std::string order;
+
+  post(ex, std::bind(append, &order, 'a'));
+  post(ex, with_deadline(now + 3 * hour, std::bind(append, &order, 'b')));
+  post(ex, with_deadline(now + 1 * hour, std::bind(append, &order, 'c')));
+  post(ex, std::bind(append, &order, 'd'));
+  post(ex, with_deadline(now + 2 * hour, std::bind(append, &order, 'e')));
+  post(ex, with_deadline(now + 1 * hour, std::bind(append, &order, 'f')));
+
+  ASIO_CHECK(ex.size() == 6);
+
+  ioc.run();
+
+  ASIO_CHECK(order == "cfebad");
+  ASIO_CHECK(ex.size() == 0);
+
+  deadline_executor<io_context::executor_type>::metrics_snapshot m =
+    ex.get_metrics();
+  ASIO_CHECK(m.handlers_run == 6);
+  ASIO_CHECK(m.deadlines_missed == 0);
+  ASIO_CHECK(m.max_lateness.count() == 0);
+  ASIO_CHECK(m.lateness.total_count() == 0);
+}
+
+void deadline_executor_missed_test()
+{
+  io_context ioc;
+  deadline_executor<io_context::executor_type> ex(ioc.get_executor());
+
+  clock_type::time_point now = clock_type::now();
+  std::string order;
+
+  post(ex, with_deadline(now + std::chrono::hours(1),
+        std::bind(append, &order, 'a')));
+  post(ex, with_deadline(now - std::chrono::milliseconds(10),
+        std::bind(append, &order, 'b')));
+  post(ex, with_deadline(now - std::chrono::milliseconds(20),
+        std::bind(append, &order, 'c')));
+
+  ioc.run();
+
+  ASIO_CHECK(order == "cba");
+
+  deadline_executor<io_context::executor_type>::metrics_snapshot m =
+    ex.get_metrics();
+  ASIO_CHECK(m.handlers_run == 3);
+  ASIO_CHECK(m.deadlines_missed == 2);
+  ASIO_CHECK(m.max_lateness >= std::chrono::milliseconds(20));
+  ASIO_CHECK(m.lateness.total_count() == 2);
+}
+
+void deadline_executor_properties_test()
+{
+  io_context ioc;
+  deadline_executor<io_context::executor_type> ex1 =
+    make_deadline_executor(ioc);
+  deadline_executor<io_context::executor_type> ex2 =
+    make_deadline_executor(ioc);
+
+  ASIO_CHECK(ex1 == ex1);
+  ASIO_CHECK(ex1 != ex2);
+  ASIO_CHECK(ex1.get_inner_executor() == ioc.get_executor());
+  ASIO_CHECK(&query(ex1, execution::context) == &ioc);
+  ASIO_CHECK(query(ex1, execution::blocking) == execution::blocking.possibly);
+
+  auto ex3 = require(ex1, execution::blocking.never);
+  ASIO_CHECK(query(ex3, execution::blocking) == execution::blocking.never);
+
+  std::string order;
+  post(ex3, with_deadline(clock_type::now() + std::chrono::hours(2),
+        std::bind(append, &order, 'a')));
+  post(ex1, with_deadline(clock_type::now() + std::chrono::hours(1),
+        std::bind(append, &order, 'b')));
+
+  ASIO_CHECK(ex1.size() == 2);
+
+  ioc.run();
+
+  ASIO_CHECK(order == "ba");
+  ASIO_CHECK(ex1.get_metrics().handlers_run == 2);
+  ASIO_CHECK(ex2.get_metrics().handlers_run == 0);
+}
+
+void deadline_executor_associated_deadline_test()
+{
+  clock_type::time_point tp = clock_type::now();
+  io_context ioc;
+
+  auto h1 = with_deadline(tp, [](){});
+  ASIO_CHECK(get_associated_deadline(h1) == tp);
+
+  auto h2 = bind_executor(ioc, with_deadline(tp, [](){}));
+  ASIO_CHECK(get_associated_deadline(h2) == tp);
+
+  auto h3 = with_deadline(tp, bind_executor(ioc, [](){}));
+  ASIO_CHECK(get_associated_executor(h3) == ioc.get_executor());
+
+  auto h4 = [](){};
+  ASIO_CHECK(get_associated_deadline(h4) == (clock_type::time_point::max)());
+  ASIO_CHECK(get_associated_deadline(h4, tp) == tp);
+}
+
+void deadline_executor_destroy_test()
+{
+  std::shared_ptr<int> p = std::make_shared<int>(0);
+
+  {
+    io_context ioc;
+    deadline_executor<io_context::executor_type> ex =
+      make_deadline_executor(ioc);
+
+    // The posted function holds a copy of the executor, and so owns the
+    // queue that holds it.
+    post(ex, with_deadline(clock_type::now(), [ex, p](){}));
+    post(ex, [ex, p](){});
+
+    ASIO_CHECK(p.use_count() == 3);
+  }
+
+  ASIO_CHECK(p.use_count() == 1);
+}
+
+void deadline_executor_thread_pool_test()
+{
+  thread_pool pool(4);
+  auto ex = make_deadline_executor(pool);
+
+  std::atomic<int> count(0);
+  clock_type::time_point now = clock_type::now();
+  for (int i = 0; i < 1000; ++i)
+  {
+    post(ex, with_deadline(now + std::chrono::microseconds(i % 7),
+          [&count](){ ++count; }));
+    dispatch(ex, [&count](){ ++count; });
+  }
+
+  pool.wait();
+
+  ASIO_CHECK(count == 2000);
+  ASIO_CHECK(ex.get_metrics().handlers_run == 2000);
+  ASIO_CHECK(ex.size() == 0);
+}
+
+ASIO_TEST_SUITE
+(
+  "deadline_executor",
+  ASIO_TEST_CASE(deadline_executor_order_test)
+  ASIO_TEST_CASE(deadline_executor_missed_test)
+  ASIO_TEST_CASE(deadline_executor_properties_test)
+  ASIO_TEST_CASE(deadline_executor_associated_deadline_test)
+  ASIO_TEST_CASE(deadline_executor_destroy_test)
+  ASIO_TEST_CASE(deadline_executor_thread_pool_test)
+)
@@ -16,10 +16,70 @@
 // Test that header file is self-contained.
 #include "asio/deferred.hpp"
 
+#include "asio/bind_allocator.hpp"
+#include "asio/frame_slot.hpp"
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
 #include "unit_test.hpp"
 
+struct sequence_handler
+{
+  int* count_;
+
+  void operator()()
+  {
+    ++(*count_);
+  }
+};
+
+void test_sequence_frame_slot()
+{
+  asio::io_context ioc;
+  asio::frame_slot slot(1024);
+  asio::frame_slot_allocator<char> allocator(slot);
+  int stages = 0;
+  int count = 0;
+
+  char* block = allocator.allocate(1);
+  allocator.deallocate(block, 1);
+
+  auto stage = [&]()
+  {
+    ++stages;
+    return asio::post(ioc, asio::deferred);
+  };
+
+  for (int i = 0; i < 3; ++i)
+  {
+    auto pipeline = asio::post(ioc, asio::deferred)
+      | asio::deferred(stage)
+      | asio::deferred(stage)
+      | asio::deferred(stage);
+
+    std::move(pipeline)(
+        asio::bind_allocator(slot.get_allocator(),
+          sequence_handler{&count}));
+
+    // The first stage's operation occupies the slot.
+    char* p = allocator.allocate(1);
+    ASIO_CHECK(p != block);
+    allocator.deallocate(p, 1);
+
+    ioc.restart();
+    ioc.run();
+
+    // Every stage reused the same block.
+    ASIO_CHECK(stages == 3 * (i + 1));
+    ASIO_CHECK(count == i + 1);
+    ASIO_CHECK(slot.capacity() == 1024);
+    p = allocator.allocate(1);
+    ASIO_CHECK(p == block);
+    allocator.deallocate(p, 1);
+  }
+}
+
 ASIO_TEST_SUITE
 (
-  "experimental/deferred",
-  ASIO_TEST_CASE(null_test)
+  "deferred",
+  ASIO_TEST_CASE(test_sequence_frame_slot)
 )
@@ -16,10 +16,103 @@
 // Test that header file is self-contained.
 #include "asio/execution_context.hpp"
 
+#include <vector>
+#include "asio/thread.hpp"
 #include "unit_test.hpp"
 
+class counting_service
+  : public asio::execution_context::service
+{
+public:
+  static asio::execution_context::id id;
+
+  explicit counting_service(asio::execution_context& ctx)
+    : asio::execution_context::service(ctx)
+  {
+    ++constructed;
+  }
+
+  static int constructed;
+
+private:
+  void shutdown() {}
+};
+
+asio::execution_context::id counting_service::id;
+int counting_service::constructed = 0;
+
+class added_service
+  : public asio::execution_context::service
+{
+public:
+  static asio::execution_context::id id;
+
+  explicit added_service(asio::execution_context& ctx)
+    : asio::execution_context::service(ctx)
+  {
+  }
+
+private:
+  void shutdown() {}
+};
+
+asio::execution_context::id added_service::id;
+
+struct use_counting_service
+{
+  asio::execution_context* ctx_;
+  counting_service** result_;
+
+  void operator()()
+  {
+    for (int i = 0; i < 1000; ++i)
+      *result_ = &asio::use_service<counting_service>(*ctx_);
+  }
+};
+
+void service_lookup_test()
+{
+  counting_service::constructed = 0;
+
+  {
+    asio::execution_context ctx;
+
+    ASIO_CHECK(!asio::has_service<counting_service>(ctx));
+    ASIO_CHECK(!asio::has_service<added_service>(ctx));
+
+    counting_service* results[4] = { 0, 0, 0, 0 };
+    std::vector<asio::thread*> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+      use_counting_service f = { &ctx, &results[i] };
+      threads.push_back(new asio::thread(f));
+    }
+    for (std::size_t i = 0; i < threads.size(); ++i)
+    {
+      threads[i]->join();
+      delete threads[i];
+    }
+
+    ASIO_CHECK(counting_service::constructed == 1);
+    ASIO_CHECK(asio::has_service<counting_service>(ctx));
+    for (int i = 1; i < 4; ++i)
+      ASIO_CHECK(results[i] == results[0]);
+    ASIO_CHECK(&asio::use_service<counting_service>(ctx) == results[0]);
+
+    added_service& svc = asio::make_service<added_service>(ctx);
+    ASIO_CHECK(asio::has_service<added_service>(ctx));
+    ASIO_CHECK(&asio::use_service<added_service>(ctx) == &svc);
+  }
+
+  // A new context gets its own services.
+  asio::execution_context ctx2;
+  ASIO_CHECK(!asio::has_service<counting_service>(ctx2));
+  asio::use_service<counting_service>(ctx2);
+  ASIO_CHECK(counting_service::constructed == 2);
+}
+
 ASIO_TEST_SUITE
 (
   "execution_context",
-  ASIO_TEST_CASE(null_test)
+  ASIO_TEST_CASE(service_lookup_test)
 )
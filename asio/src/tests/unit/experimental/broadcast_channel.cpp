@@ -0,0 +1,345 @@
+//
+// experimental/broadcast_channel.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/experimental/broadcast_channel.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "asio/bind_cancellation_slot.hpp"
+#include "asio/cancellation_signal.hpp"
+#include "asio/io_context.hpp"
+#include "../unit_test.hpp"
+
+using namespace asio;
+using namespace asio::experimental;
+
+typedef broadcast_channel<int> int_broadcast_channel;
+typedef std::shared_ptr<const int> int_payload;
+
+static int_payload make_int(int i)
+{
+  return std::make_shared<const int>(i);
+}
+
+void fan_out_broadcast_channel_test()
+{
+  io_context ctx;
+
+  broadcast_channel<std::string> ch1(ctx, 4);
+  broadcast_channel<std::string>::subscriber sub1 = ch1.subscribe();
+  broadcast_channel<std::string>::subscriber sub2 = ch1.subscribe();
+
+  ASIO_CHECK(ch1.is_open());
+  ASIO_CHECK(ch1.capacity() == 4);
+  ASIO_CHECK(ch1.subscriber_count() == 2);
+
+  std::shared_ptr<const std::string> received1;
+  sub1.async_receive(
+      [&](asio::error_code ec, std::shared_ptr<const std::string> msg)
+      {
+        ASIO_CHECK(!ec);
+        received1 = msg;
+      });
+
+  std::shared_ptr<const std::string> msg =
+    std::make_shared<const std::string>("hello");
+  bool b1 = ch1.try_send(msg);
+
+  ASIO_CHECK(b1);
+
+  std::shared_ptr<const std::string> received2;
+  bool b2 = sub2.try_receive(
+      [&](asio::error_code ec, std::shared_ptr<const std::string> msg)
+      {
+        ASIO_CHECK(!ec);
+        received2 = msg;
+      });
+
+  ASIO_CHECK(b2);
+
+  ctx.run();
+
+  // Every subscriber receives the same payload object.
+  ASIO_CHECK(received1 == msg);
+  ASIO_CHECK(received2 == msg);
+
+  bool b3 = sub2.try_receive(
+      [](asio::error_code, std::shared_ptr<const std::string>)
+      {
+      });
+
+  ASIO_CHECK(!b3);
+
+  // A late subscriber sees only subsequent messages.
+  broadcast_channel<std::string>::subscriber sub3 = ch1.subscribe();
+
+  bool b4 = sub3.try_receive(
+      [](asio::error_code, std::shared_ptr<const std::string>)
+      {
+      });
+
+  ASIO_CHECK(!b4);
+  ASIO_CHECK(ch1.subscriber_count() == 3);
+
+  {
+    broadcast_channel<std::string>::subscriber sub4 = ch1.subscribe();
+    ASIO_CHECK(ch1.subscriber_count() == 4);
+  }
+
+  ASIO_CHECK(ch1.subscriber_count() == 3);
+}
+
+void drop_broadcast_channel_test()
+{
+  io_context ctx;
+
+  int_broadcast_channel ch1(ctx, 2, broadcast_overflow::drop);
+  int_broadcast_channel::subscriber sub1 = ch1.subscribe();
+
+  for (int i = 0; i < 5; ++i)
+    ASIO_CHECK(ch1.try_send(make_int(i)));
+
+  std::vector<int> values;
+  while (sub1.try_receive(
+        [&](asio::error_code ec, int_payload v)
+        {
+          ASIO_CHECK(!ec);
+          values.push_back(*v);
+        }))
+  {
+  }
+
+  ASIO_CHECK(values.size() == 2);
+  ASIO_CHECK(values[0] == 3);
+  ASIO_CHECK(values[1] == 4);
+  ASIO_CHECK(sub1.dropped() == 3);
+  ASIO_CHECK(sub1.is_connected());
+}
+
+void block_broadcast_channel_test()
+{
+  io_context ctx;
+
+  int_broadcast_channel ch1(ctx, 1, broadcast_overflow::block);
+  int_broadcast_channel::subscriber sub1 = ch1.subscribe();
+  int_broadcast_channel::subscriber sub2 = ch1.subscribe();
+
+  ASIO_CHECK(ch1.try_send(make_int(1)));
+  ASIO_CHECK(!ch1.try_send(make_int(2)));
+
+  bool sent = false;
+  ch1.async_send(make_int(2),
+      [&](asio::error_code ec)
+      {
+        ASIO_CHECK(!ec);
+        sent = true;
+      });
+
+  ctx.poll();
+  ASIO_CHECK(!sent);
+
+  int value = 0;
+  ASIO_CHECK(sub1.try_receive(
+        [&](asio::error_code, int_payload v)
+        {
+          value = *v;
+        }));
+  ASIO_CHECK(value == 1);
+
+  // The slowest subscriber has not yet advanced.
+  ctx.restart();
+  ctx.poll();
+  ASIO_CHECK(!sent);
+
+  ASIO_CHECK(sub2.try_receive(
+        [&](asio::error_code, int_payload v)
+        {
+          value = *v;
+        }));
+  ASIO_CHECK(value == 1);
+
+  ctx.restart();
+  ctx.run();
+  ASIO_CHECK(sent);
+
+  ASIO_CHECK(sub1.try_receive(
+        [&](asio::error_code, int_payload v)
+        {
+          value = *v;
+        }));
+  ASIO_CHECK(value == 2);
+  ASIO_CHECK(sub1.dropped() == 0);
+  ASIO_CHECK(sub2.dropped() == 0);
+}
+
+void disconnect_broadcast_channel_test()
+{
+  io_context ctx;
+
+  int_broadcast_channel ch1(ctx, 2, broadcast_overflow::disconnect);
+  int_broadcast_channel::subscriber sub1 = ch1.subscribe();
+  int_broadcast_channel::subscriber sub2 = ch1.subscribe();
+
+  std::vector<int> values;
+  struct receiver
+  {
+    int_broadcast_channel::subscriber* sub_;
+    std::vector<int>* values_;
+
+    void operator()(asio::error_code ec, int_payload v)
+    {
+      if (!ec)
+      {
+        values_->push_back(*v);
+        sub_->async_receive(*this);
+      }
+    }
+  };
+
+  receiver r = { &sub1, &values };
+  sub1.async_receive(r);
+
+  for (int i = 0; i < 3; ++i)
+    ASIO_CHECK(ch1.try_send(make_int(i)));
+
+  ASIO_CHECK(sub1.is_connected());
+  ASIO_CHECK(!sub2.is_connected());
+
+  asio::error_code ec1;
+  sub2.async_receive(
+      [&](asio::error_code ec, int_payload)
+      {
+        ec1 = ec;
+      });
+
+  ch1.close();
+  ctx.run();
+
+  ASIO_CHECK(ec1 == asio::experimental::error::channel_closed);
+  ASIO_CHECK(values.size() == 3);
+  ASIO_CHECK(values[2] == 2);
+}
+
+void closed_broadcast_channel_test()
+{
+  io_context ctx;
+
+  int_broadcast_channel ch1(ctx, 4);
+  int_broadcast_channel::subscriber sub1 = ch1.subscribe();
+
+  ASIO_CHECK(ch1.try_send(make_int(1)));
+
+  ch1.close();
+
+  ASIO_CHECK(!ch1.is_open());
+  ASIO_CHECK(!ch1.try_send(make_int(2)));
+
+  asio::error_code ec1;
+  ch1.async_send(make_int(2),
+      [&](asio::error_code ec)
+      {
+        ec1 = ec;
+      });
+
+  // Buffered messages are still delivered after the channel is closed.
+  int value = 0;
+  asio::error_code ec2;
+  sub1.async_receive(
+      [&](asio::error_code ec, int_payload v)
+      {
+        ec2 = ec;
+        value = *v;
+      });
+
+  asio::error_code ec3;
+  sub1.async_receive(
+      [&](asio::error_code ec, int_payload v)
+      {
+        ec3 = ec;
+        ASIO_CHECK(!v);
+      });
+
+  ctx.run();
+
+  ASIO_CHECK(ec1 == asio::experimental::error::channel_closed);
+  ASIO_CHECK(!ec2);
+  ASIO_CHECK(value == 1);
+  ASIO_CHECK(ec3 == asio::experimental::error::channel_closed);
+}
+
+void cancelled_broadcast_channel_test()
+{
+  io_context ctx;
+
+  int_broadcast_channel ch1(ctx, 1, broadcast_overflow::block);
+  int_broadcast_channel::subscriber sub1 = ch1.subscribe();
+
+  asio::error_code ec1;
+  sub1.async_receive(
+      [&](asio::error_code ec, int_payload)
+      {
+        ec1 = ec;
+      });
+
+  sub1.cancel();
+  ctx.run();
+
+  ASIO_CHECK(ec1 == asio::experimental::error::channel_cancelled);
+
+  ASIO_CHECK(ch1.try_send(make_int(1)));
+
+  asio::cancellation_signal sig;
+  asio::error_code ec2;
+  ch1.async_send(make_int(2),
+      asio::bind_cancellation_slot(sig.slot(),
+        [&](asio::error_code ec)
+        {
+          ec2 = ec;
+        }));
+
+  sig.emit(asio::cancellation_type::terminal);
+  ctx.restart();
+  ctx.run();
+
+  ASIO_CHECK(ec2 == asio::experimental::error::channel_cancelled);
+
+  // Unsubscribing the only lagging subscriber admits a waiting sender.
+  bool sent = false;
+  ch1.async_send(make_int(3),
+      [&](asio::error_code ec)
+      {
+        ASIO_CHECK(!ec);
+        sent = true;
+      });
+
+  sub1 = ch1.subscribe();
+  ctx.restart();
+  ctx.run();
+
+  ASIO_CHECK(sent);
+}
+
+ASIO_TEST_SUITE
+(
+  "experimental/broadcast_channel",
+  ASIO_TEST_CASE(fan_out_broadcast_channel_test)
+  ASIO_TEST_CASE(drop_broadcast_channel_test)
+  ASIO_TEST_CASE(block_broadcast_channel_test)
+  ASIO_TEST_CASE(disconnect_broadcast_channel_test)
+  ASIO_TEST_CASE(closed_broadcast_channel_test)
+  ASIO_TEST_CASE(cancelled_broadcast_channel_test)
+)
@@ -17,6 +17,7 @@
 #include "asio/experimental/channel.hpp"
 
 #include <utility>
+#include <vector>
 #include "asio/any_completion_handler.hpp"
 #include "asio/bind_executor.hpp"
 #include "asio/bind_immediate_executor.hpp"
@@ -863,6 +864,107 @@ void channel_with_any_completion_handler_test()
   ASIO_CHECK(!ec2);
 }
 
+void batch_channel_test()
+{
+  io_context ctx;
+
+  channel<void(asio::error_code, int)> ch1(ctx, 8);
+
+  std::vector<int> values = { 1, 2, 3, 4, 5 };
+  std::size_t n1 = ch1.try_send_batch(values, asio::error_code());
+
+  ASIO_CHECK(n1 == 5);
+
+  int received[4] = { 0, 0, 0, 0 };
+  asio::error_code ec2;
+  std::size_t n2 = 0;
+  ch1.async_receive_batch(received, 4,
+      [&](asio::error_code ec, std::size_t n)
+      {
+        ec2 = ec;
+        n2 = n;
+      });
+
+  ctx.run();
+
+  ASIO_CHECK(!ec2);
+  ASIO_CHECK(n2 == 4);
+  ASIO_CHECK(received[0] == 1);
+  ASIO_CHECK(received[3] == 4);
+
+  // Receiving stops at the first message that carries an error.
+  ch1.try_send(asio::error::eof, 6);
+  ch1.try_send(asio::error_code(), 7);
+
+  asio::error_code ec3;
+  std::size_t n3 = 0;
+  ch1.async_receive_batch(received, 4,
+      [&](asio::error_code ec, std::size_t n)
+      {
+        ec3 = ec;
+        n3 = n;
+      });
+
+  ctx.restart();
+  ctx.run();
+
+  ASIO_CHECK(ec3 == asio::error::eof);
+  ASIO_CHECK(n3 == 1);
+  ASIO_CHECK(received[0] == 5);
+
+  // With nothing buffered, the operation waits for a single message.
+  ASIO_CHECK(ch1.try_receive([](asio::error_code, int){}));
+
+  asio::error_code ec4;
+  std::size_t n4 = 0;
+  ch1.async_receive_batch(received, 4,
+      [&](asio::error_code ec, std::size_t n)
+      {
+        ec4 = ec;
+        n4 = n;
+      });
+
+  ctx.restart();
+  ctx.poll();
+
+  ASIO_CHECK(n4 == 0);
+
+  ch1.try_send(asio::error_code(), 8);
+
+  ctx.restart();
+  ctx.run();
+
+  ASIO_CHECK(!ec4);
+  ASIO_CHECK(n4 == 1);
+  ASIO_CHECK(received[0] == 8);
+
+  // A batch send stops when the buffer is full.
+  std::vector<int> many(10, 9);
+  std::size_t n5 = ch1.try_send_batch(many, asio::error_code());
+
+  ASIO_CHECK(n5 == 8);
+
+  ch1.close();
+
+  std::size_t total = 0;
+  asio::error_code ec6;
+  for (int i = 0; i < 3; ++i)
+  {
+    ch1.async_receive_batch(received, 4,
+        [&](asio::error_code ec, std::size_t n)
+        {
+          ec6 = ec;
+          total += n;
+        });
+
+    ctx.restart();
+    ctx.run();
+  }
+
+  ASIO_CHECK(total == 8);
+  ASIO_CHECK(ec6 == asio::experimental::error::channel_closed);
+}
+
 ASIO_TEST_SUITE
 (
   "experimental/channel",
@@ -885,4 +987,5 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(try_send_n_via_dispatch)
   ASIO_TEST_CASE(implicit_error_signature_channel_test)
   ASIO_TEST_CASE(channel_with_any_completion_handler_test)
+  ASIO_TEST_CASE(batch_channel_test)
 )
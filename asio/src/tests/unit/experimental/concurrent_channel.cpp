@@ -16,7 +16,9 @@
 // Test that header file is self-contained.
 #include "asio/experimental/concurrent_channel.hpp"
 
+#include <string>
 #include <utility>
+#include <vector>
 #include "asio/error.hpp"
 #include "asio/io_context.hpp"
 #include "../unit_test.hpp"
@@ -157,9 +159,53 @@ void buffered_concurrent_channel_test()
   ASIO_CHECK(!ec2);
 };
 
+void batch_concurrent_channel_test()
+{
+  io_context ctx;
+
+  concurrent_channel<void(std::string)> ch1(ctx, 4);
+
+  // Receiving into an unbuffered batch waits for the first message.
+  std::string received[4];
+  std::size_t n1 = 0;
+  ch1.async_receive_batch(received, 4,
+      [&](asio::error_code ec, std::size_t n)
+      {
+        ASIO_CHECK(!ec);
+        n1 = n;
+      });
+
+  // The elements of an rvalue range are moved into the messages.
+  std::vector<std::string> values = { "a", "b", "c" };
+  std::size_t n2 = ch1.try_send_batch(std::move(values));
+
+  ASIO_CHECK(n2 == 3);
+
+  ctx.run();
+
+  ASIO_CHECK(n1 == 1);
+  ASIO_CHECK(received[0] == "a");
+
+  std::size_t n3 = 0;
+  ch1.async_receive_batch(received, 4,
+      [&](asio::error_code ec, std::size_t n)
+      {
+        ASIO_CHECK(!ec);
+        n3 = n;
+      });
+
+  ctx.restart();
+  ctx.run();
+
+  ASIO_CHECK(n3 == 2);
+  ASIO_CHECK(received[0] == "b");
+  ASIO_CHECK(received[1] == "c");
+}
+
 ASIO_TEST_SUITE
 (
   "experimental/concurrent_channel",
   ASIO_TEST_CASE(unbuffered_concurrent_channel_test)
   ASIO_TEST_CASE(buffered_concurrent_channel_test)
+  ASIO_TEST_CASE(batch_concurrent_channel_test)
 )
@@ -0,0 +1,102 @@
+//
+// experimental/coro/receive_stream.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/experimental/receive_stream.hpp"
+
+#include <string>
+#include <vector>
+#include "asio/co_spawn.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/udp.hpp"
+#include "asio/post.hpp"
+#include "asio/use_awaitable.hpp"
+#include "../../unit_test.hpp"
+
+#if defined(ASIO_HAS_DATAGRAM_BATCH)
+
+namespace coro {
+
+using asio::ip::udp;
+
+asio::awaitable<void> receive_all(udp::socket& socket,
+    asio::datagram_arena<udp>& arena, std::vector<std::string>& received,
+    udp::endpoint& sender)
+{
+  auto packets = asio::experimental::receive_stream(socket, arena);
+  while (auto p = co_await packets.async_resume(asio::use_awaitable))
+  {
+    asio::const_buffer data = arena.payload(*p);
+    received.push_back(std::string(
+          static_cast<const char*>(data.data()), data.size()));
+    sender = p->endpoint;
+
+    // Close the socket once the expected datagrams have arrived. This aborts
+    // the next receive, which completes the stream.
+    if (received.size() == 5)
+      asio::post(socket.get_executor(), [&]{ socket.close(); });
+  }
+}
+
+void receive_stream_test()
+{
+  asio::io_context ctx;
+  const udp::endpoint loopback(asio::ip::address_v4::loopback(), 0);
+  udp::socket receiver(ctx, loopback);
+  udp::socket sender(ctx, loopback);
+
+  // A small arena means that the datagrams span several batches.
+  asio::datagram_arena<udp> arena(2, 16);
+
+  const char* messages[] = { "one", "two", "three", "four", "five" };
+  for (const char* m : messages)
+    sender.send_to(asio::buffer(std::string(m)), receiver.local_endpoint());
+
+  std::vector<std::string> received;
+  udp::endpoint from;
+  bool done = false;
+  asio::co_spawn(ctx, receive_all(receiver, arena, received, from),
+      [&](std::exception_ptr e)
+      {
+        ASIO_CHECK(e == nullptr);
+        done = true;
+      });
+
+  ctx.run();
+
+  ASIO_CHECK(done);
+  ASIO_CHECK(received.size() == 5);
+  for (std::size_t i = 0; i < received.size() && i < 5; ++i)
+    ASIO_CHECK(received[i] == messages[i]);
+  ASIO_CHECK(from == sender.local_endpoint());
+}
+
+} // namespace coro
+
+ASIO_TEST_SUITE
+(
+  "coro/receive_stream",
+  ASIO_TEST_CASE(::coro::receive_stream_test)
+)
+
+#else // defined(ASIO_HAS_DATAGRAM_BATCH)
+
+ASIO_TEST_SUITE
+(
+  "coro/receive_stream",
+  ASIO_TEST_CASE(null_test)
+)
+
+#endif // defined(ASIO_HAS_DATAGRAM_BATCH)
@@ -19,9 +19,12 @@
 
 #include "asio/co_spawn.hpp"
 #include "asio/detached.hpp"
+#include "asio/deferred.hpp"
 #include "asio/io_context.hpp"
+#include "asio/post.hpp"
 #include "asio/use_awaitable.hpp"
 #include <iostream>
+#include <optional>
 #include <vector>
 #include "../../unit_test.hpp"
 
@@ -254,6 +257,62 @@ void run_symmetrical_test()
   ctx.run();
 }
 
+asio::experimental::coro<int> posting_generator_impl(
+    asio::any_io_executor exec)
+{
+  for (int i = 0;; ++i)
+  {
+    co_await asio::post(exec, asio::deferred);
+    co_yield i;
+  }
+}
+
+template <typename Generator>
+void resume_until(Generator& g, int first,
+    int& count, int limit, bool& initiating)
+{
+  initiating = true;
+  g.async_resume(
+      [&g, first, &count, limit, &initiating](
+        std::exception_ptr e, std::optional<int> val)
+      {
+        ASIO_CHECK(!initiating);
+        ASIO_CHECK(!e);
+        ASIO_CHECK(val && *val == first + count);
+        if (++count < limit)
+          resume_until(g, first, count, limit, initiating);
+      });
+  initiating = false;
+}
+
+void run_resume_dispatch_test()
+{
+  asio::io_context ctx;
+
+  // A generator that yields from the completion of an operation on the
+  // handler's executor has its handler dispatched. Only the initial
+  // resumption and the posts made by the generator go through the scheduler.
+  auto g1 = posting_generator_impl(ctx.get_executor());
+  int count = 0;
+  bool initiating = false;
+  resume_until(g1, 0, count, 20, initiating);
+  std::size_t handlers = ctx.run();
+  ASIO_CHECK(count == 20);
+  ASIO_CHECK(handlers == 21);
+
+  // A generator that yields from within the initiating function must still
+  // have its handler posted.
+  ctx.restart();
+  int last = 0;
+  bool destroyed = false;
+  auto g2 = generator_impl(ctx.get_executor(), last, destroyed);
+  count = 0;
+  resume_until(g2, 1, count, 10, initiating);
+  ctx.run();
+  ASIO_CHECK(count == 10);
+  ASIO_CHECK(last == 10);
+}
+
 } // namespace coro
 
 ASIO_TEST_SUITE
@@ -263,4 +322,5 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(::coro::run_task_test)
   ASIO_TEST_CASE(::coro::run_symmetrical_test)
   ASIO_TEST_CASE(::coro::run_completion_generator_test)
+  ASIO_TEST_CASE(::coro::run_resume_dispatch_test)
 )
@@ -16,10 +16,125 @@
 // Test that header file is self-contained.
 #include "asio/experimental/parallel_group.hpp"
 
+#include <array>
+#include <vector>
+#include "asio/bind_allocator.hpp"
+#include "asio/deferred.hpp"
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
 #include "../unit_test.hpp"
 
+template <typename T>
+class test_allocator
+{
+public:
+  typedef T value_type;
+
+  explicit test_allocator(int* allocations)
+    : allocations_(allocations)
+  {
+  }
+
+  template <typename U>
+  test_allocator(const test_allocator<U>& other)
+    : allocations_(other.allocations_)
+  {
+  }
+
+  template <typename U>
+  struct rebind
+  {
+    typedef test_allocator<U> other;
+  };
+
+  bool operator==(const test_allocator&) const
+  {
+    return true;
+  }
+
+  bool operator!=(const test_allocator&) const
+  {
+    return false;
+  }
+
+  T* allocate(std::size_t n) const
+  {
+    ++(*allocations_);
+    return static_cast<T*>(::operator new(sizeof(T) * n));
+  }
+
+  void deallocate(T* p, std::size_t /*n*/) const
+  {
+    --(*allocations_);
+    ::operator delete(p);
+  }
+
+//private:
+  int* allocations_;
+};
+
+void parallel_group_allocator_test()
+{
+  asio::io_context ioc;
+
+  int count = 0;
+  int allocations = 0;
+
+  asio::experimental::make_parallel_group(
+      asio::post(ioc, asio::deferred),
+      asio::post(ioc, asio::deferred)
+    ).async_wait(
+      asio::experimental::wait_for_all(),
+      asio::bind_allocator(test_allocator<int>(&allocations),
+        [&count](std::array<std::size_t, 2> completion_order)
+        {
+          count += static_cast<int>(completion_order.size());
+        }));
+
+  // The state, including the results, is a single allocation.
+  ASIO_CHECK(allocations == 1);
+
+  ioc.run();
+
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(allocations == 0);
+}
+
+void ranged_parallel_group_allocator_test()
+{
+  asio::io_context ioc;
+
+  typedef decltype(asio::post(ioc, asio::deferred)) op_type;
+  std::vector<op_type> ops;
+  for (int i = 0; i < 10; ++i)
+    ops.push_back(asio::post(ioc, asio::deferred));
+
+  int count = 0;
+  int allocations = 0;
+
+  asio::experimental::make_parallel_group(
+      std::allocator_arg, test_allocator<int>(&allocations), ops
+    ).async_wait(
+      asio::experimental::wait_for_all(),
+      [&count](std::vector<std::size_t,
+          test_allocator<std::size_t>> completion_order)
+      {
+        count += static_cast<int>(completion_order.size());
+      });
+
+  // The state, the cancellation signals, the results and the completion order
+  // are each a single allocation from the group's allocator.
+  ASIO_CHECK(allocations == 4);
+
+  ioc.run();
+
+  ASIO_CHECK(count == 10);
+  ASIO_CHECK(allocations == 0);
+}
+
 ASIO_TEST_SUITE
 (
   "experimental/parallel_group",
-  ASIO_TEST_CASE(null_test)
+  ASIO_TEST_CASE(parallel_group_allocator_test)
+  ASIO_TEST_CASE(ranged_parallel_group_allocator_test)
 )
@@ -23,6 +23,7 @@
 #include "asio/deferred.hpp"
 #include "asio/experimental/use_promise.hpp"
 #include "asio/steady_timer.hpp"
+#include <vector>
 #include "../unit_test.hpp"
 
 namespace promise {
@@ -214,6 +215,30 @@ void test_cancel()
       ec.message());
 }
 
+void test_discard()
+{
+  asio::io_context ctx;
+  std::vector<asio::steady_timer> timers;
+  std::vector<asio::error_code> ecs(100);
+  for (std::size_t i = 0; i < ecs.size(); ++i)
+    timers.emplace_back(ctx, std::chrono::seconds(10));
+
+  {
+    std::vector<asio::experimental::promise<void(asio::error_code)>> ps;
+    for (std::size_t i = 0; i < ecs.size(); ++i)
+      ps.push_back(test_cancel_impl(
+            timers[i], ecs[i], asio::experimental::use_promise));
+
+    ps.front()([](asio::error_code){});
+    ASIO_CHECK(!ps.front().completed());
+  }
+
+  ctx.run();
+
+  for (std::size_t i = 0; i < ecs.size(); ++i)
+    ASIO_CHECK(ecs[i] == asio::error::operation_aborted);
+}
+
 } // namespace promise
 
 ASIO_TEST_SUITE
@@ -223,4 +248,5 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(promise::promise_slot_tester)
   ASIO_TEST_CASE(promise::early_completion)
   ASIO_TEST_CASE(promise::test_cancel)
+  ASIO_TEST_CASE(promise::test_discard)
 )
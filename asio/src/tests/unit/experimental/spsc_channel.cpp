@@ -0,0 +1,278 @@
+//
+// experimental/spsc_channel.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/experimental/spsc_channel.hpp"
+
+#include <utility>
+#include <string>
+#include "asio/error.hpp"
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/thread_pool.hpp"
+#include "../unit_test.hpp"
+
+using namespace asio;
+using namespace asio::experimental;
+
+void buffered_spsc_channel_test()
+{
+  io_context ctx;
+
+  spsc_channel<void(asio::error_code, std::string)> ch1(ctx, 1);
+
+  ASIO_CHECK(ch1.is_open());
+  ASIO_CHECK(!ch1.ready());
+
+  bool b1 = ch1.try_send(asio::error::eof, "hello");
+
+  ASIO_CHECK(b1);
+
+  std::string s1 = "abcdefghijklmnopqrstuvwxyz";
+  bool b2 = ch1.try_send(asio::error::eof, std::move(s1));
+
+  ASIO_CHECK(!b2);
+  ASIO_CHECK(!s1.empty());
+
+  asio::error_code ec1;
+  std::string s2;
+  ch1.async_receive(
+      [&](asio::error_code ec, std::string s)
+      {
+        ec1 = ec;
+        s2 = std::move(s);
+      });
+
+  ctx.run();
+
+  ASIO_CHECK(ec1 == asio::error::eof);
+  ASIO_CHECK(s2 == "hello");
+
+  bool b4 = ch1.try_receive([](asio::error_code, std::string){});
+
+  ASIO_CHECK(!b4);
+
+  asio::error_code ec2 = asio::error::would_block;
+  std::string s3 = "zyxwvutsrqponmlkjihgfedcba";
+  ch1.async_send(asio::error::eof, std::move(s3),
+      [&](asio::error_code ec)
+      {
+        ec2 = ec;
+      });
+
+  asio::error_code ec3;
+  std::string s4;
+  bool b5 = ch1.try_receive(
+      [&](asio::error_code ec, std::string s)
+      {
+        ec3 = ec;
+        s4 = s;
+      });
+
+  ASIO_CHECK(b5);
+  ASIO_CHECK(ec3 == asio::error::eof);
+  ASIO_CHECK(s4 == "zyxwvutsrqponmlkjihgfedcba");
+
+  ctx.restart();
+  ctx.run();
+
+  ASIO_CHECK(!ec2);
+};
+
+void closed_spsc_channel_test()
+{
+  io_context ctx;
+
+  spsc_channel<void(asio::error_code, int)> ch1(ctx, 4);
+
+  ASIO_CHECK(ch1.capacity() == 4);
+
+  std::size_t n1 = ch1.try_send_n(8, asio::error_code(), 42);
+
+  ASIO_CHECK(n1 == 4);
+  ASIO_CHECK(ch1.ready());
+
+  ch1.close();
+
+  ASIO_CHECK(!ch1.is_open());
+  ASIO_CHECK(ch1.ready());
+
+  bool b1 = ch1.try_send(asio::error_code(), 42);
+
+  ASIO_CHECK(!b1);
+
+  // Only one receive operation may be outstanding at a time.
+  struct receiver
+  {
+    spsc_channel<void(asio::error_code, int)>* ch_;
+    int* received_;
+    asio::error_code* ec_;
+
+    void operator()(asio::error_code ec, int value)
+    {
+      if (!ec)
+      {
+        ASIO_CHECK(value == 42);
+        ++*received_;
+        ch_->async_receive(*this);
+      }
+      else
+        *ec_ = ec;
+    }
+  };
+
+  int received = 0;
+  asio::error_code ec1;
+  receiver r = { &ch1, &received, &ec1 };
+  ch1.async_receive(r);
+
+  ctx.run();
+
+  ASIO_CHECK(received == 4);
+  ASIO_CHECK(ec1 == asio::experimental::error::channel_closed);
+
+  asio::error_code ec2;
+  ch1.async_send(asio::error_code(), 42,
+      [&](asio::error_code ec)
+      {
+        ec2 = ec;
+      });
+
+  ctx.restart();
+  ctx.run();
+
+  ASIO_CHECK(ec2 == asio::experimental::error::channel_closed);
+}
+
+void cancelled_spsc_channel_test()
+{
+  io_context ctx;
+
+  spsc_channel<void(asio::error_code, int)> ch1(ctx, 1);
+
+  asio::error_code ec1;
+  ch1.async_receive(
+      [&](asio::error_code ec, int)
+      {
+        ec1 = ec;
+      });
+
+  ch1.cancel();
+
+  ctx.run();
+
+  ASIO_CHECK(ec1 == asio::experimental::error::channel_cancelled);
+
+  bool b1 = ch1.try_send(asio::error_code(), 1);
+
+  ASIO_CHECK(b1);
+
+  asio::error_code ec2;
+  ch1.async_send(asio::error_code(), 2,
+      [&](asio::error_code ec)
+      {
+        ec2 = ec;
+      });
+
+  ch1.cancel();
+
+  ctx.restart();
+  ctx.run();
+
+  ASIO_CHECK(ec2 == asio::experimental::error::channel_cancelled);
+
+  int value = 0;
+  bool b2 = ch1.try_receive(
+      [&](asio::error_code, int v)
+      {
+        value = v;
+      });
+
+  ASIO_CHECK(b2);
+  ASIO_CHECK(value == 1);
+}
+
+typedef spsc_channel<void(asio::error_code, int)> int_spsc_channel;
+
+struct spsc_producer
+{
+  int_spsc_channel* ch_;
+  int next_;
+  int count_;
+
+  void operator()(asio::error_code ec)
+  {
+    ASIO_CHECK(!ec);
+    if (!ec && next_ < count_)
+      ch_->async_send(asio::error_code(), next_++, *this);
+  }
+};
+
+struct spsc_consumer
+{
+  int_spsc_channel* ch_;
+  int* next_;
+  int count_;
+
+  void operator()(asio::error_code ec, int value)
+  {
+    ASIO_CHECK(!ec);
+    if (!ec)
+    {
+      // Messages must arrive in the order they were sent.
+      ASIO_CHECK(value == *next_);
+      if (++*next_ < count_)
+        ch_->async_receive(*this);
+    }
+  }
+};
+
+void cross_context_spsc_channel_test()
+{
+  io_context ctx;
+  thread_pool pool(1);
+
+  const int num_messages = 10000;
+
+  // Send operations complete on the pool, and receive operations on ctx.
+  int_spsc_channel ch1(pool.get_executor(), ctx.get_executor(), 8);
+
+  ASIO_CHECK(ch1.capacity() == 8);
+
+  int next = 0;
+  spsc_consumer consumer = { &ch1, &next, num_messages };
+  ch1.async_receive(consumer);
+
+  spsc_producer producer = { &ch1, 0, num_messages };
+  asio::post(pool,
+      [producer]() mutable
+      {
+        producer(asio::error_code());
+      });
+
+  ctx.run();
+  pool.join();
+
+  ASIO_CHECK(next == num_messages);
+}
+
+ASIO_TEST_SUITE
+(
+  "experimental/spsc_channel",
+  ASIO_TEST_CASE(buffered_spsc_channel_test)
+  ASIO_TEST_CASE(closed_spsc_channel_test)
+  ASIO_TEST_CASE(cancelled_spsc_channel_test)
+  ASIO_TEST_CASE(cross_context_spsc_channel_test)
+)
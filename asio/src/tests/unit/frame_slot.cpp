@@ -0,0 +1,96 @@
+//
+// frame_slot.cpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/frame_slot.hpp"
+
+#include "unit_test.hpp"
+#include "asio/bind_allocator.hpp"
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+
+struct frame_slot_loop_handler
+{
+  asio::io_context& ctx;
+  asio::frame_slot& slot;
+  int& count;
+
+  void operator()()
+  {
+    if (++count < 4)
+    {
+      // The previous operation has been released, so its memory is reused.
+      asio::frame_slot_allocator<char> allocator(slot);
+      char* p = allocator.allocate(1);
+      allocator.deallocate(p, 1);
+      asio::post(ctx, asio::bind_allocator(slot.get_allocator(), *this));
+    }
+  }
+};
+
+void frame_slot_test()
+{
+  asio::io_context ctx(1);
+  asio::frame_slot slot;
+  int count = 0;
+
+  ASIO_CHECK(slot.capacity() == 0);
+
+  asio::post(ctx, asio::bind_allocator(slot.get_allocator(),
+        frame_slot_loop_handler{ctx, slot, count}));
+
+  std::size_t capacity = slot.capacity();
+  ASIO_CHECK(capacity > 0);
+
+  // The operation occupies the slot, so other allocations use other memory.
+  asio::frame_slot_allocator<char> allocator(slot);
+  char* p1 = allocator.allocate(1);
+  char* p2 = allocator.allocate(1);
+  ASIO_CHECK(p1 != p2);
+  allocator.deallocate(p1, 1);
+  allocator.deallocate(p2, 1);
+  ASIO_CHECK(slot.capacity() == capacity);
+
+  ctx.run();
+
+  ASIO_CHECK(count == 4);
+  ASIO_CHECK(slot.capacity() == capacity);
+
+  // All invocations shared one block, which is now free.
+  p1 = allocator.allocate(1);
+  p2 = allocator.allocate(1);
+  ASIO_CHECK(p1 != p2);
+  allocator.deallocate(p2, 1);
+  allocator.deallocate(p1, 1);
+
+  asio::post(ctx, asio::bind_allocator(slot.get_allocator(),
+        frame_slot_loop_handler{ctx, slot, count}));
+  p2 = allocator.allocate(1);
+  ASIO_CHECK(p1 != p2);
+  allocator.deallocate(p2, 1);
+
+  ctx.restart();
+  ctx.run();
+
+  ASIO_CHECK(count == 5);
+  ASIO_CHECK(allocator.allocate(1) == p1);
+  allocator.deallocate(p1, 1);
+}
+
+ASIO_TEST_SUITE
+(
+  "frame_slot",
+  ASIO_TEST_CASE(frame_slot_test)
+)
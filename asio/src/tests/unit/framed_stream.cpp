@@ -0,0 +1,232 @@
+//
+// framed_stream.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/framed_stream.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+typedef asio::framed_stream<asio::ip::tcp::socket> stream_type;
+
+//------------------------------------------------------------------------------
+
+// framed_stream_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// framed_stream compile and link correctly. Runtime failures are ignored.
+
+namespace framed_stream_compile {
+
+void read_frame_handler(const asio::error_code&, asio::const_buffer)
+{
+}
+
+void write_frame_handler(const asio::error_code&, std::size_t)
+{
+}
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    char data[16] = "";
+    std::vector<const_buffer> frames(2, buffer(data));
+    asio::error_code ec;
+
+    stream_type stream1(ioc);
+    stream_type stream2(ioc.get_executor(), 1024);
+
+    stream_type::lowest_layer_type& lowest_layer = stream1.lowest_layer();
+    (void)lowest_layer;
+    ip::tcp::socket& next_layer = stream1.next_layer();
+    (void)next_layer;
+    stream_type::executor_type ex = stream1.get_executor();
+    (void)ex;
+    std::size_t max_size = stream1.max_frame_size();
+    (void)max_size;
+
+    const_buffer frame1 = stream1.read_frame();
+    (void)frame1;
+    const_buffer frame2 = stream1.read_frame(ec);
+    (void)frame2;
+    stream1.async_read_frame(&read_frame_handler);
+
+    std::size_t n1 = stream1.write_frame(buffer(data));
+    (void)n1;
+    std::size_t n2 = stream1.write_frame(buffer(data), ec);
+    (void)n2;
+    stream1.async_write_frame(buffer(data), &write_frame_handler);
+    stream1.async_write_frames(frames, &write_frame_handler);
+
+    stream1.close();
+    stream1.close(ec);
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace framed_stream_compile
+
+//------------------------------------------------------------------------------
+
+// framed_stream_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime behaviour of the framed_stream class.
+
+namespace framed_stream_runtime {
+
+struct connection
+{
+  explicit connection(asio::io_context& ioc, std::size_t buffer_size = 1024)
+    : client(ioc, buffer_size),
+      server(ioc, buffer_size)
+  {
+    using asio::ip::tcp;
+    tcp::acceptor acceptor(ioc,
+        tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+    client.next_layer().connect(acceptor.local_endpoint());
+    acceptor.accept(server.next_layer());
+  }
+
+  stream_type client;
+  stream_type server;
+};
+
+std::string to_string(asio::const_buffer b)
+{
+  return std::string(static_cast<const char*>(b.data()), b.size());
+}
+
+void test_async()
+{
+  asio::io_context ioc;
+  connection c(ioc);
+
+  std::string big(600, 'x');
+  std::vector<asio::const_buffer> frames;
+  frames.push_back(asio::buffer("one", 3));
+  frames.push_back(asio::const_buffer());
+  frames.push_back(asio::buffer(big));
+
+  std::size_t written[2] = { 0, 0 };
+  c.client.async_write_frames(frames,
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        ASIO_CHECK(!e);
+        written[0] = n;
+        c.client.async_write_frame(asio::buffer("four", 4),
+            [&](const asio::error_code& e, std::size_t n)
+            {
+              ASIO_CHECK(!e);
+              written[1] = n;
+            });
+      });
+
+  std::vector<std::string> received;
+  std::function<void()> read_loop = [&]()
+  {
+    c.server.async_read_frame(
+        [&](const asio::error_code& e, asio::const_buffer frame)
+        {
+          ASIO_CHECK(!e);
+          received.push_back(to_string(frame));
+          if (received.size() < 4)
+            read_loop();
+        });
+  };
+  read_loop();
+  ioc.run();
+
+  ASIO_CHECK(written[0] == 3 * 4 + 3 + 600);
+  ASIO_CHECK(written[1] == 4 + 4);
+  ASIO_CHECK(received.size() == 4);
+  ASIO_CHECK(received.size() == 4 && received[0] == "one");
+  ASIO_CHECK(received.size() == 4 && received[1].empty());
+  ASIO_CHECK(received.size() == 4 && received[2] == big);
+  ASIO_CHECK(received.size() == 4 && received[3] == "four");
+}
+
+void test_sync()
+{
+  asio::io_context ioc;
+  connection c(ioc);
+
+  ASIO_CHECK(c.client.write_frame(asio::buffer("hello", 5)) == 9);
+  ASIO_CHECK(c.client.write_frame(asio::buffer("world", 5)) == 9);
+
+  // Both frames are received by the first read, and the second is returned
+  // without reading from the socket.
+  ASIO_CHECK(to_string(c.server.read_frame()) == "hello");
+  ASIO_CHECK(c.server.next_layer().available() == 0);
+  ASIO_CHECK(to_string(c.server.read_frame()) == "world");
+
+  // A frame that wraps around the end of the ring is still presented as a
+  // single buffer.
+  for (int i = 0; i < 8; ++i)
+  {
+    std::string payload(300 + i, static_cast<char>('a' + i));
+    c.client.write_frame(asio::buffer(payload));
+    ASIO_CHECK(to_string(c.server.read_frame()) == payload);
+  }
+}
+
+void test_too_large()
+{
+  asio::io_context ioc;
+  connection c(ioc);
+
+  std::string big(c.server.max_frame_size() + 1, 'x');
+  c.client.write_frame(asio::buffer(big));
+
+  asio::error_code ec;
+  asio::const_buffer frame = c.server.read_frame(ec);
+  ASIO_CHECK(ec == asio::error::message_size);
+  ASIO_CHECK(frame.size() == 0);
+
+  bool called = false;
+  c.server.async_read_frame(
+      [&](const asio::error_code& e, asio::const_buffer)
+      {
+        ASIO_CHECK(e == asio::error::message_size);
+        called = true;
+      });
+  ASIO_CHECK(!called);
+  ioc.run();
+  ASIO_CHECK(called);
+}
+
+} // namespace framed_stream_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "framed_stream",
+  ASIO_COMPILE_TEST_CASE(framed_stream_compile::test)
+  ASIO_TEST_CASE(framed_stream_runtime::test_async)
+  ASIO_TEST_CASE(framed_stream_runtime::test_sync)
+  ASIO_TEST_CASE(framed_stream_runtime::test_too_large)
+)
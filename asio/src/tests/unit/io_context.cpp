@@ -16,13 +16,19 @@
 // Test that header file is self-contained.
 #include "asio/io_context.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <sstream>
+#include <string>
+#include <utility>
 #include "asio/bind_executor.hpp"
 #include "asio/dispatch.hpp"
 #include "asio/post.hpp"
 #include "asio/steady_timer.hpp"
+#include "asio/strand.hpp"
 #include "asio/thread.hpp"
+#include "asio/thread_pool.hpp"
 #include "unit_test.hpp"
 
 using namespace asio;
@@ -696,6 +702,425 @@ void io_context_allocator_test()
   ASIO_CHECK(total_count > 0);
 }
 
+void fan_out(io_context* ioc, int depth, std::atomic<int>* count)
+{
+  ++(*count);
+  if (depth > 0)
+  {
+    asio::post(*ioc, bindns::bind(fan_out, ioc, depth - 1, count));
+    asio::post(*ioc, bindns::bind(fan_out, ioc, depth - 1, count));
+  }
+}
+
+void io_context_work_stealing_test()
+{
+  io_context ioc1(ASIO_CONCURRENCY_HINT_WORK_STEALING);
+  std::atomic<int> count(0);
+
+  asio::post(ioc1, bindns::bind(fan_out, &ioc1, 12, &count));
+
+  asio::thread th1(bindns::bind(io_context_run, &ioc1));
+  asio::thread th2(bindns::bind(io_context_run, &ioc1));
+  asio::thread th3(bindns::bind(io_context_run, &ioc1));
+  ioc1.run();
+  th1.join();
+  th2.join();
+  th3.join();
+
+  // Every handler is run exactly once, regardless of which thread ran it.
+  ASIO_CHECK(ioc1.stopped());
+  ASIO_CHECK(count == (1 << 13) - 1);
+
+  // Handlers left in a per-thread queue after stop() are run on restart.
+  count = 0;
+  ioc1.restart();
+  asio::post(ioc1, bindns::bind(fan_out, &ioc1, 4, &count));
+  asio::post(ioc1, bindns::bind(&io_context::stop, &ioc1));
+  ioc1.run();
+  ioc1.restart();
+  ioc1.run();
+  ASIO_CHECK(count == (1 << 5) - 1);
+
+  // A small work queue overflows into the shared queue.
+  io_context ioc2(asio::config_from_string(
+        "scheduler.work_stealing=1\n"
+        "scheduler.work_queue_size=2"));
+  count = 0;
+
+  asio::post(ioc2, bindns::bind(fan_out, &ioc2, 10, &count));
+
+  asio::thread th4(bindns::bind(io_context_run, &ioc2));
+  ioc2.run();
+  th4.join();
+
+  ASIO_CHECK(count == (1 << 11) - 1);
+
+  // Handlers posted from a handler run in the order in which they were posted.
+  io_context ioc3(ASIO_CONCURRENCY_HINT_WORK_STEALING);
+  std::string order;
+
+  asio::post(ioc3,
+      [&]
+      {
+        for (int i = 0; i < 5; ++i)
+          asio::post(ioc3, [&order, i]{ order += static_cast<char>('0' + i); });
+      });
+  ioc3.run();
+
+  ASIO_CHECK(order == "01234");
+
+  // A handler that keeps re-posting itself does not starve handlers posted
+  // before it from the same thread.
+  ioc3.restart();
+  int reposts = 0;
+  int reposts_before_other = -1;
+  std::function<void()> repost = [&]
+  {
+    if (reposts_before_other < 0 && ++reposts < 1000000)
+      asio::post(ioc3, repost);
+  };
+
+  asio::post(ioc3,
+      [&]
+      {
+        asio::post(ioc3, [&]{ reposts_before_other = reposts; });
+        asio::post(ioc3, repost);
+      });
+  ioc3.run();
+
+  ASIO_CHECK(reposts_before_other == 0);
+}
+
+void post_increments(io_context* ioc, std::atomic<int>* count)
+{
+  for (int i = 0; i < 100; ++i)
+    asio::post(*ioc, [count]{ ++(*count); });
+}
+
+void io_context_busy_poll_test()
+{
+  io_context ioc(asio::config_from_string("scheduler.busy_poll_usec=1000"));
+  std::atomic<int> count(0);
+  bool timer_fired = false;
+
+  // Keep the scheduler running the reactor task while handlers are posted
+  // from another thread.
+  timer t(ioc, chronons::milliseconds(100));
+  t.async_wait(
+      [&](const asio::error_code&)
+      {
+        timer_fired = true;
+      });
+
+  asio::thread th(bindns::bind(post_increments, &ioc, &count));
+  ioc.run();
+  th.join();
+
+  ASIO_CHECK(count == 100);
+  ASIO_CHECK(timer_fired);
+}
+
+void io_context_reactor_busy_poll_test()
+{
+  // The reactor's busy poll parameters are ignored where the kernel does not
+  // support them, so the context must run normally either way.
+  io_context ioc(asio::config_from_string(
+        "reactor.busy_poll_usec=50\n"
+        "reactor.busy_poll_budget=8\n"
+        "reactor.prefer_busy_poll=1"));
+  bool timer_fired = false;
+
+  timer t(ioc, chronons::milliseconds(10));
+  t.async_wait(
+      [&](const asio::error_code&)
+      {
+        timer_fired = true;
+      });
+
+  ioc.run();
+
+  ASIO_CHECK(timer_fired);
+}
+
+void ping_pong(io_context* self, io_context* peer,
+    int n, std::atomic<int>* count)
+{
+  ++(*count);
+  if (n > 0)
+    asio::post(*peer, bindns::bind(ping_pong, peer, self, n - 1, count));
+  else
+  {
+    self->stop();
+    peer->stop();
+  }
+}
+
+void io_context_cross_context_post_test()
+{
+  io_context ioc1;
+  io_context ioc2;
+  std::atomic<int> count(0);
+
+  // The timers give each context a task, so that each post from one context's
+  // thread must interrupt the task of the other.
+  timer t1(ioc1, chronons::seconds(60));
+  timer t2(ioc2, chronons::seconds(60));
+  t1.async_wait([](const asio::error_code&){});
+  t2.async_wait([](const asio::error_code&){});
+
+  asio::post(ioc1, bindns::bind(ping_pong, &ioc1, &ioc2, 1000, &count));
+
+  asio::thread th(bindns::bind(io_context_run, &ioc2));
+  ioc1.run();
+  th.join();
+
+  ASIO_CHECK(count == 1001);
+}
+
+void io_context_metrics_test()
+{
+  io_context ioc1;
+  asio::post(ioc1, []{});
+  ioc1.run();
+
+  io_context::metrics_snapshot m1 = ioc1.get_metrics();
+  ASIO_CHECK(!m1.enabled);
+  ASIO_CHECK(m1.handlers_run == 0);
+
+  io_context ioc2(asio::config_from_string("scheduler.metrics=1"));
+  int count = 0;
+
+  for (int i = 0; i < 10; ++i)
+    asio::post(ioc2, bindns::bind(increment, &count));
+
+  asio::strand<io_context::executor_type> s(ioc2.get_executor());
+  for (int i = 0; i < 5; ++i)
+    asio::post(s, bindns::bind(increment, &count));
+
+  timer t(ioc2, chronons::milliseconds(10));
+  t.async_wait(
+      [&](const asio::error_code&)
+      {
+        ++count;
+      });
+
+  io_context::metrics_snapshot m2 = ioc2.get_metrics();
+  ASIO_CHECK(m2.enabled);
+  ASIO_CHECK(m2.pending_timers == 1);
+
+  ioc2.run();
+  ASIO_CHECK(count == 16);
+
+  m2 = ioc2.get_metrics();
+  ASIO_CHECK(m2.handlers_run >= 12);
+  ASIO_CHECK(m2.max_queue_depth >= 10);
+  ASIO_CHECK(m2.reactor_runs >= 1);
+  ASIO_CHECK(m2.reactor_events >= 1);
+  ASIO_CHECK(m2.reactor_time.count() > 0);
+  ASIO_CHECK(m2.pending_timers == 0);
+  ASIO_CHECK(m2.max_strand_queue_depth >= 4);
+}
+
+void io_context_priority_test()
+{
+  io_context ioc1(asio::config_from_string("scheduler.priority_levels=3"));
+  io_context::executor_type ex = ioc1.get_executor();
+
+  auto ex_mid = asio::prefer(ex, asio::execution::priority(1));
+  auto ex_high = asio::prefer(ex, asio::execution::priority(2));
+  ASIO_CHECK(asio::query(ex, asio::execution::priority) == 0);
+  ASIO_CHECK(asio::query(ex_mid, asio::execution::priority) == 1);
+  ASIO_CHECK(asio::query(ex_high, asio::execution::priority) == 2);
+  ASIO_CHECK(asio::prefer(ex, asio::execution::priority(1)) == ex_mid);
+  ASIO_CHECK(asio::prefer(ex, asio::execution::priority(1)) != ex_high);
+
+  // Other properties preserve the priority.
+  ASIO_CHECK(asio::query(
+        asio::require(ex_high, asio::execution::blocking.never),
+        asio::execution::priority) == 2);
+  ASIO_CHECK(asio::query(
+        asio::require(ex_high,
+          asio::execution::allocator(std::allocator<int>())),
+        asio::execution::priority) == 2);
+
+  // Each lane delivers one more handler per round than its priority.
+  std::string order;
+  for (int i = 0; i < 9; ++i)
+    asio::post(ex, [&order]{ order += 'L'; });
+  for (int i = 0; i < 6; ++i)
+    asio::post(ex_high, [&order]{ order += 'H'; });
+  for (int i = 0; i < 4; ++i)
+    asio::post(ex_mid, [&order]{ order += 'M'; });
+
+  ioc1.run();
+  ASIO_CHECK(order == "LMMHHHLMMHHHLLLLLLL");
+
+  // Handlers left in the priority lanes are destroyed on shutdown.
+  ioc1.restart();
+  asio::post(ex_high, []{});
+  asio::post(ex_mid, []{});
+
+  // Priorities are ignored unless priority lanes are enabled.
+  io_context ioc2;
+  auto ex2_high = asio::prefer(ioc2.get_executor(),
+      asio::execution::priority(2));
+  order.clear();
+  asio::post(ioc2, [&order]{ order += 'L'; });
+  asio::post(ex2_high, [&order]{ order += 'H'; });
+  ioc2.run();
+  ASIO_CHECK(order == "LH");
+}
+
+void inline_chain(io_context& ioc, int n, std::string* order)
+{
+  *order += 'c';
+  if (n > 0)
+    asio::dispatch(ioc, std::bind(inline_chain, std::ref(ioc), n - 1, order));
+}
+
+void io_context_inline_budget_test()
+{
+  std::string order;
+
+  // Without a budget, dispatched handlers are always run inline.
+  io_context ioc1;
+  asio::post(ioc1,
+      [&]
+      {
+        asio::post(ioc1, [&order]{ order += 'x'; });
+        inline_chain(ioc1, 10, &order);
+      });
+  ioc1.run();
+  ASIO_CHECK(order == "cccccccccccx");
+
+  // With a budget, the chain goes through the queue after every 4 handlers
+  // that are run inline.
+  order.clear();
+  io_context ioc2(asio::config_from_string("scheduler.inline_budget=4"));
+  asio::post(ioc2,
+      [&]
+      {
+        asio::post(ioc2, [&order]{ order += 'x'; });
+        inline_chain(ioc2, 10, &order);
+      });
+  ioc2.run();
+  ASIO_CHECK(order == "cccccxcccccc");
+
+  // With a time budget, a handler that has run for too long goes through the
+  // queue.
+  order.clear();
+  io_context ioc3(
+      asio::config_from_string("scheduler.inline_budget_usec=1000"));
+  asio::post(ioc3,
+      [&]
+      {
+        asio::post(ioc3, [&order]{ order += 'x'; });
+        asio::dispatch(ioc3, [&order]{ order += 'a'; });
+        std::chrono::steady_clock::time_point end =
+          std::chrono::steady_clock::now() + std::chrono::milliseconds(2);
+        while (std::chrono::steady_clock::now() < end)
+          ;
+        asio::dispatch(ioc3, [&order]{ order += 'b'; });
+      });
+  ioc3.run();
+  ASIO_CHECK(order == "axb");
+}
+
+void hand_off(io_context* ioc, int n, std::atomic<int>* count)
+{
+  ++(*count);
+  if (n > 0)
+  {
+    // Track work on a copy of the executor that is released by the next
+    // handler, which may run on another thread.
+    auto work = asio::prefer(ioc->get_executor(),
+        asio::execution::outstanding_work.tracked);
+    asio::post(*ioc,
+        [ioc, n, count, work]() mutable
+        {
+          {
+            auto released = std::move(work);
+          }
+          hand_off(ioc, n - 1, count);
+        });
+  }
+}
+
+void io_context_work_count_batch_test()
+{
+  io_context ioc1(asio::config_from_string("scheduler.work_count_batch=8"));
+  std::atomic<int> count(0);
+
+  asio::post(ioc1, bindns::bind(fan_out, &ioc1, 10, &count));
+  asio::post(ioc1, bindns::bind(hand_off, &ioc1, 1000, &count));
+
+  // The context runs out of work, and every thread leaves run(), even though
+  // work is started and finished on different threads.
+  asio::thread th1(bindns::bind(io_context_run, &ioc1));
+  asio::thread th2(bindns::bind(io_context_run, &ioc1));
+  ioc1.run();
+  th1.join();
+  th2.join();
+
+  ASIO_CHECK(ioc1.stopped());
+  ASIO_CHECK(count == (1 << 11) - 1 + 1001);
+
+  // Work tracked from outside the context keeps it running.
+  io_context ioc2(asio::config_from_string(
+        "scheduler.work_count_batch=4\n"
+        "scheduler.work_stealing=1"));
+  count = 0;
+
+  auto work = asio::make_work_guard(ioc2);
+  asio::post(ioc2, bindns::bind(fan_out, &ioc2, 8, &count));
+  asio::post(ioc2,
+      [&]
+      {
+        timer t(ioc2, chronons::milliseconds(10));
+        t.wait();
+        work.reset();
+      });
+
+  asio::thread th3(bindns::bind(io_context_run, &ioc2));
+  ioc2.run();
+  th3.join();
+
+  ASIO_CHECK(ioc2.stopped());
+  ASIO_CHECK(count == (1 << 9) - 1);
+}
+
+void io_context_unsafe_test()
+{
+  io_context ioc(ASIO_CONCURRENCY_HINT_UNSAFE);
+  std::atomic<int> count(0);
+
+  // Disabling locking for one context leaves the others in the program with
+  // their locking, so a thread pool still hands work between its threads.
+  asio::thread_pool pool(2);
+  std::atomic<int> pool_count(0);
+  for (int i = 0; i < 100; ++i)
+    asio::post(pool, [&pool_count]{ ++pool_count; });
+
+  auto work = asio::make_work_guard(ioc);
+  asio::post(ioc, bindns::bind(fan_out, &ioc, 8, &count));
+  asio::post(ioc, bindns::bind(hand_off, &ioc, 100, &count));
+  timer t(ioc, chronons::milliseconds(10));
+  t.async_wait(
+      [&](const asio::error_code&)
+      {
+        work.reset();
+      });
+
+  // The context runs out of work only once every handler and the work guard
+  // are finished.
+  ioc.run();
+  pool.join();
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == (1 << 9) - 1 + 101);
+  ASIO_CHECK(pool_count == 100);
+}
+
 ASIO_TEST_SUITE
 (
   "io_context",
@@ -704,4 +1129,13 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(io_context_executor_query_test)
   ASIO_TEST_CASE(io_context_executor_execute_test)
   ASIO_TEST_CASE(io_context_allocator_test)
+  ASIO_TEST_CASE(io_context_work_stealing_test)
+  ASIO_TEST_CASE(io_context_busy_poll_test)
+  ASIO_TEST_CASE(io_context_reactor_busy_poll_test)
+  ASIO_TEST_CASE(io_context_cross_context_post_test)
+  ASIO_TEST_CASE(io_context_metrics_test)
+  ASIO_TEST_CASE(io_context_priority_test)
+  ASIO_TEST_CASE(io_context_inline_budget_test)
+  ASIO_TEST_CASE(io_context_work_count_batch_test)
+  ASIO_TEST_CASE(io_context_unsafe_test)
 )
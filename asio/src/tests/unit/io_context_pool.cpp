@@ -0,0 +1,235 @@
+//
+// io_context_pool.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/io_context_pool.hpp"
+
+#include <atomic>
+#include <functional>
+#include <vector>
+#include "asio/ip/tcp.hpp"
+#include "asio/post.hpp"
+#include "asio/steady_timer.hpp"
+#include "unit_test.hpp"
+
+using namespace asio;
+
+namespace bindns = std;
+
+void increment(std::atomic<int>* count)
+{
+  ++(*count);
+}
+
+void record_thread(io_context* ctx, std::atomic<int>* count)
+{
+  // Handlers run on the thread that runs their io_context.
+  ASIO_CHECK(ctx->get_executor().running_in_this_thread());
+  ++(*count);
+}
+
+void io_context_pool_test()
+{
+  std::atomic<int> count(0);
+
+  {
+    io_context_pool pool(4, false);
+    ASIO_CHECK(pool.size() == 4);
+
+    for (std::size_t i = 0; i < pool.size(); ++i)
+    {
+      asio::post(pool.get_executor(i),
+          bindns::bind(record_thread, &pool.get_io_context(i), &count));
+    }
+
+    // Round-robin executors visit every io_context in turn.
+    for (std::size_t i = 0; i < 2 * pool.size(); ++i)
+    {
+      io_context_pool::executor_type ex = pool.get_executor();
+      ASIO_CHECK(&ex.context() == &pool.get_io_context(i % pool.size()));
+      asio::post(ex, bindns::bind(increment, &count));
+    }
+
+    pool.join();
+    ASIO_CHECK(count == 12);
+  }
+
+  // Destruction without an explicit join stops the pool.
+  {
+    io_context_pool pool;
+    ASIO_CHECK(pool.size() >= 1);
+    asio::post(pool.get_executor(), bindns::bind(increment, &count));
+  }
+}
+
+void io_context_pool_load_balancing_test()
+{
+  io_context_pool::load_balancing strategies[] =
+  {
+    io_context_pool::least_outstanding_work,
+    io_context_pool::power_of_two_choices
+  };
+
+  for (std::size_t s = 0; s < 2; ++s)
+  {
+    io_context_pool pool(4, strategies[s], false);
+    ASIO_CHECK(pool.outstanding_work(0) == pool.outstanding_work(1));
+
+    // Give three of the io_contexts extra work, so that the remaining one is
+    // always the least loaded of any pair.
+    std::vector<executor_work_guard<io_context_pool::executor_type>> busy;
+    for (std::size_t i = 0; i < 3; ++i)
+      busy.push_back(asio::make_work_guard(pool.get_io_context(i)));
+    ASIO_CHECK(pool.outstanding_work(0) == pool.outstanding_work(3) + 1);
+
+    if (strategies[s] == io_context_pool::least_outstanding_work)
+    {
+      for (std::size_t i = 0; i < 8; ++i)
+        ASIO_CHECK(&pool.get_io_context() == &pool.get_io_context(3));
+    }
+    else
+    {
+      // The least loaded io_context is chosen whenever it is one of the two
+      // candidates, so it is chosen more often than any other.
+      std::size_t chosen[4] = { 0, 0, 0, 0 };
+      for (std::size_t i = 0; i < 600; ++i)
+      {
+        io_context& ctx = pool.get_io_context();
+        for (std::size_t j = 0; j < 4; ++j)
+          if (&ctx == &pool.get_io_context(j))
+            ++chosen[j];
+      }
+      ASIO_CHECK(chosen[3] > chosen[0]);
+      ASIO_CHECK(chosen[3] > chosen[1]);
+      ASIO_CHECK(chosen[3] > chosen[2]);
+      ASIO_CHECK(chosen[0] + chosen[1] + chosen[2] + chosen[3] == 600);
+    }
+
+    busy.clear();
+    pool.join();
+  }
+}
+
+void io_context_pool_drain_test()
+{
+  std::atomic<int> count(0);
+  io_context_pool pool(3, io_context_pool::least_outstanding_work, false);
+
+  // Work that was already assigned to a draining io_context still completes.
+  executor_work_guard<io_context_pool::executor_type> work
+    = asio::make_work_guard(pool.get_io_context(1));
+  pool.drain(1);
+  ASIO_CHECK(!pool.get_io_context(1).stopped());
+
+  for (std::size_t i = 0; i < 12; ++i)
+    ASIO_CHECK(&pool.get_io_context() != &pool.get_io_context(1));
+
+  asio::post(pool.get_executor(1), bindns::bind(increment, &count));
+  work.reset();
+
+  // The draining io_context's thread exits once its work is done.
+  for (int i = 0; i < 1000 && !pool.get_io_context(1).stopped(); ++i)
+  {
+    io_context ctx;
+    steady_timer timer(ctx, asio::chrono::milliseconds(10));
+    timer.wait();
+  }
+  ASIO_CHECK(pool.get_io_context(1).stopped());
+  ASIO_CHECK(count == 1);
+
+  // Draining the whole pool lets every thread exit without stop().
+  asio::post(pool.get_executor(), bindns::bind(increment, &count));
+  pool.drain();
+  pool.join();
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(pool.get_io_context(0).stopped());
+  ASIO_CHECK(pool.get_io_context(2).stopped());
+}
+
+struct accept_handler
+{
+  io_context_pool::acceptor<ip::tcp>* acceptor_;
+  std::atomic<int>* accepted_;
+
+  void operator()(const asio::error_code& ec, ip::tcp::socket socket)
+  {
+    if (ec)
+      return;
+
+    ASIO_CHECK(socket.get_executor() == acceptor_->get_executor());
+    ++(*accepted_);
+    acceptor_->async_accept(*this);
+  }
+};
+
+void io_context_pool_listen_test()
+{
+#if defined(ASIO_HAS_SO_REUSEPORT)
+  io_context_pool pool(2, false);
+  std::atomic<int> accepted(0);
+
+  ip::tcp::endpoint endpoint(ip::address_v4::loopback(), 0);
+  std::vector<io_context_pool::acceptor<ip::tcp>> acceptors
+    = pool.listen<ip::tcp>(endpoint);
+
+  ASIO_CHECK(acceptors.size() == 2);
+  ASIO_CHECK(acceptors[0].local_endpoint() == acceptors[1].local_endpoint());
+  ASIO_CHECK(acceptors[1].get_executor() == pool.get_executor(1));
+
+  for (std::size_t i = 0; i < acceptors.size(); ++i)
+  {
+    accept_handler h = { &acceptors[i], &accepted };
+    acceptors[i].async_accept(h);
+  }
+
+  const int num_clients = 16;
+  io_context client_ctx;
+  std::vector<ip::tcp::socket> clients;
+  for (int i = 0; i < num_clients; ++i)
+  {
+    clients.push_back(ip::tcp::socket(client_ctx));
+    clients.back().connect(acceptors[0].local_endpoint());
+  }
+
+  steady_timer timer(client_ctx);
+  for (int i = 0; i < 1000 && accepted < num_clients; ++i)
+  {
+    timer.expires_after(asio::chrono::milliseconds(10));
+    timer.wait();
+  }
+  ASIO_CHECK(accepted == num_clients);
+
+  asio::error_code ec;
+  std::vector<io_context_pool::acceptor<ip::tcp>> steered
+    = pool.listen<ip::tcp>(endpoint,
+        io_context_pool::distribute_by_cpu,
+        socket_base::max_listen_connections, ec);
+  if (!ec)
+    ASIO_CHECK(steered.size() == 2);
+  else
+    ASIO_CHECK(steered.empty());
+
+  pool.stop();
+#endif // defined(ASIO_HAS_SO_REUSEPORT)
+}
+
+ASIO_TEST_SUITE
+(
+  "io_context_pool",
+  ASIO_TEST_CASE(io_context_pool_test)
+  ASIO_TEST_CASE(io_context_pool_load_balancing_test)
+  ASIO_TEST_CASE(io_context_pool_drain_test)
+  ASIO_TEST_CASE(io_context_pool_listen_test)
+)
@@ -18,6 +18,7 @@
 
 #include <functional>
 #include <sstream>
+#include <vector>
 #include "asio/io_context.hpp"
 #include "asio/dispatch.hpp"
 #include "asio/post.hpp"
@@ -210,6 +211,69 @@ void strand_test()
   ASIO_CHECK(count == 0);
 }
 
+void check_other_strands(io_context::strand* s,
+    std::vector<io_context::strand>* strands, int* count)
+{
+  ASIO_CHECK(s->running_in_this_thread());
+  for (std::size_t i = 0; i < strands->size(); ++i)
+    if ((*strands)[i] != *s)
+      ASIO_CHECK(!(*strands)[i].running_in_this_thread());
+  ++(*count);
+}
+
+void strand_independence_test()
+{
+  io_context ioc;
+  std::vector<io_context::strand> strands;
+  for (int i = 0; i < 1000; ++i)
+    strands.push_back(io_context::strand(ioc));
+  int count = 0;
+
+  // Each strand has its own state, so no two strands are equal, and a handler
+  // running in one strand is not running in any other.
+  post(strands[0], bindns::bind(check_other_strands,
+        &strands[0], &strands, &count));
+  post(strands[999], bindns::bind(check_other_strands,
+        &strands[999], &strands, &count));
+
+  ioc.run();
+  ASIO_CHECK(count == 2);
+
+  // Handlers still run after the last strand object is destroyed.
+  {
+    io_context::strand s(ioc);
+    post(s, bindns::bind(increment, &count));
+    post(s, bindns::bind(increment, &count));
+  }
+  count = 0;
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(count == 2);
+}
+
+void strand_lifetime_test()
+{
+  std::vector<io_context::strand> strands;
+  int count = 0;
+
+  // Strands may outlive their io_context, including when handlers are still
+  // queued on them at the time the io_context is destroyed.
+  {
+    io_context ioc;
+    strands.push_back(io_context::strand(ioc));
+    strands.push_back(io_context::strand(ioc));
+    post(strands[0], bindns::bind(increment, &count));
+    post(strands[0], bindns::bind(increment, &count));
+    post(strands[1], bindns::bind(increment, &count));
+    ioc.run_one();
+    ASIO_CHECK(count == 1);
+  }
+
+  ASIO_CHECK(count == 1);
+  strands.pop_back();
+  strands.clear();
+}
+
 void strand_wrap_test()
 {
 #if !defined(ASIO_NO_DEPRECATED)
@@ -294,5 +358,7 @@ ASIO_TEST_SUITE
 (
   "strand",
   ASIO_TEST_CASE(strand_test)
+  ASIO_TEST_CASE(strand_independence_test)
+  ASIO_TEST_CASE(strand_lifetime_test)
   ASIO_TEST_CASE(strand_wrap_test)
 )
@@ -0,0 +1,78 @@
+//
+// io_uring_capabilities.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/io_uring_capabilities.hpp"
+
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// io_uring_capabilities_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime behaviour of the io_uring_capabilities
+// class.
+
+namespace io_uring_capabilities_runtime {
+
+void test()
+{
+  using namespace asio;
+
+  io_context ioc;
+  io_uring_capabilities caps(ioc);
+
+  if (!io_uring_capabilities::available())
+  {
+    ASIO_CHECK(!caps.fast_poll());
+    ASIO_CHECK(!caps.multishot_accept());
+    ASIO_CHECK(!caps.multishot_receive());
+    ASIO_CHECK(!caps.zero_copy_send());
+    ASIO_CHECK(!caps.provided_buffer_rings());
+    ASIO_CHECK(!caps.ring_messages());
+    ASIO_CHECK(!caps.async_close());
+    ASIO_CHECK(!caps.async_shutdown());
+  }
+
+  // Options for unsupported features are accepted, and the socket remains
+  // usable.
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  acceptor.set_option(socket_base::multishot_accept(true));
+
+  ip::tcp::socket client(ioc);
+  client.connect(acceptor.local_endpoint());
+  client.set_option(socket_base::zero_copy(true));
+
+  ip::tcp::socket server(ioc);
+  acceptor.accept(server);
+
+  const char data[] = "capabilities";
+  ASIO_CHECK(client.send(buffer(data)) == sizeof(data));
+  char read_data[sizeof(data)] = "";
+  ASIO_CHECK(server.receive(buffer(read_data)) == sizeof(data));
+}
+
+} // namespace io_uring_capabilities_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "io_uring_capabilities",
+  ASIO_TEST_CASE(io_uring_capabilities_runtime::test)
+)
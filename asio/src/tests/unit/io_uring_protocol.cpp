@@ -0,0 +1,116 @@
+//
+// io_uring_protocol.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/io_uring_protocol.hpp"
+
+#include <cstring>
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/ip/udp.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+typedef asio::io_uring_protocol<asio::ip::tcp> uring_tcp;
+typedef asio::io_uring_protocol<asio::ip::udp> uring_udp;
+
+// Sockets of an adapted protocol exchange data with sockets of the underlying
+// protocol, and may be accepted by an acceptor of either protocol.
+void io_uring_protocol_stream_test()
+{
+  using namespace asio;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+
+  basic_socket_acceptor<uring_tcp> uring_acceptor(ioc, ip::tcp::v4());
+  uring_acceptor.bind(ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  uring_acceptor.listen();
+  ip::tcp::endpoint uring_server_endpoint = uring_acceptor.local_endpoint();
+
+  basic_stream_socket<uring_tcp> client1(ioc);
+  client1.connect(server_endpoint);
+  basic_stream_socket<uring_tcp> server1(ioc);
+  acceptor.accept(server1);
+
+  ip::tcp::socket client2(ioc);
+  client2.connect(uring_server_endpoint);
+  basic_stream_socket<uring_tcp> server2(ioc);
+  uring_acceptor.accept(server2);
+
+  ASIO_CHECK(server1.local_endpoint() == server_endpoint);
+  ASIO_CHECK(server2.remote_endpoint() == client2.local_endpoint());
+
+  const char write_data[] = "The quick brown fox jumps over the lazy dog";
+  char read_data1[sizeof(write_data)] = "";
+  char read_data2[sizeof(write_data)] = "";
+  asio::error_code ec1, ec2;
+  std::size_t n1 = 0, n2 = 0;
+
+  async_write(client1, buffer(write_data), [](asio::error_code, std::size_t){});
+  async_read(server1, buffer(read_data1),
+      [&](asio::error_code e, std::size_t n){ ec1 = e; n1 = n; });
+  async_write(client2, buffer(write_data), [](asio::error_code, std::size_t){});
+  async_read(server2, buffer(read_data2),
+      [&](asio::error_code e, std::size_t n){ ec2 = e; n2 = n; });
+  ioc.run();
+
+  ASIO_CHECK(!ec1);
+  ASIO_CHECK(n1 == sizeof(write_data));
+  ASIO_CHECK(std::memcmp(read_data1, write_data, sizeof(write_data)) == 0);
+  ASIO_CHECK(!ec2);
+  ASIO_CHECK(n2 == sizeof(write_data));
+  ASIO_CHECK(std::memcmp(read_data2, write_data, sizeof(write_data)) == 0);
+}
+
+void io_uring_protocol_datagram_test()
+{
+  using namespace asio;
+
+  io_context ioc;
+
+  basic_datagram_socket<uring_udp> s1(ioc,
+      ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket s2(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+
+  const char write_data[] = "datagram";
+  char read_data[sizeof(write_data)] = "";
+  ip::udp::endpoint sender;
+  std::size_t n = 0;
+
+  s2.send_to(buffer(write_data), s1.local_endpoint());
+  s1.async_receive_from(buffer(read_data), sender,
+      [&](asio::error_code e, std::size_t bytes)
+      {
+        ASIO_CHECK(!e);
+        n = bytes;
+      });
+  ioc.run();
+
+  ASIO_CHECK(n == sizeof(write_data));
+  ASIO_CHECK(sender == s2.local_endpoint());
+  ASIO_CHECK(std::memcmp(read_data, write_data, sizeof(write_data)) == 0);
+}
+
+ASIO_TEST_SUITE
+(
+  "io_uring_protocol",
+  ASIO_TEST_CASE(io_uring_protocol_stream_test)
+  ASIO_TEST_CASE(io_uring_protocol_datagram_test)
+)
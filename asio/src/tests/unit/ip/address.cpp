@@ -17,7 +17,10 @@
 #include "asio/ip/address.hpp"
 
 #include "../unit_test.hpp"
+#include <cstring>
 #include <sstream>
+#include <string>
+#include "asio/error.hpp"
 
 //------------------------------------------------------------------------------
 
@@ -111,6 +114,12 @@ void test()
     std::ostringstream os;
     os << addr1;
 
+    char chars[ip::address::max_string_length];
+    char* chars_end = ip::to_chars(chars,
+        chars + ip::address::max_string_length, addr1, ec);
+    const char* const_chars_end = ip::from_chars(chars, chars_end, addr1, ec);
+    (void)const_chars_end;
+
 #if !defined(BOOST_NO_STD_WSTREAMBUF)
     std::wostringstream wos;
     wos << addr1;
@@ -128,8 +137,153 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// ip_address_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~
+// The following tests check the conversions between addresses and character
+// ranges.
+
+namespace ip_address_runtime {
+
+void test_address_v4_chars()
+{
+  using asio::ip::address_v4;
+
+  asio::error_code ec;
+  char str[address_v4::max_string_length];
+
+  address_v4 a1(0xFFFEFD0A);
+  char* end = to_chars(str, str + sizeof(str), a1, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(std::string(str, end) == "255.254.253.10");
+  ASIO_CHECK(std::string(str, end) == a1.to_string());
+
+  end = to_chars(str, str + 13, a1, ec);
+  ASIO_CHECK(ec == asio::error::no_buffer_space);
+  ASIO_CHECK(end == str);
+
+  const char input1[] = "1.2.3.4:80";
+  address_v4 a2;
+  const char* p = from_chars(input1, input1 + sizeof(input1) - 1, a2, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(p == input1 + 7);
+  ASIO_CHECK(a2.to_uint() == 0x01020304);
+
+  const char* bad[] = { "", "1.2.3", "1.2.3.4.5", "1.2.3.256", "01.2.3.4" };
+  for (std::size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); ++i)
+  {
+    p = from_chars(bad[i], bad[i] + std::strlen(bad[i]), a2, ec);
+    ASIO_CHECK(ec == asio::error::invalid_argument);
+    ASIO_CHECK(p == bad[i]);
+    ASIO_CHECK(a2.to_uint() == 0x01020304);
+    ASIO_CHECK(asio::ip::make_address_v4(bad[i], ec).is_unspecified());
+    ASIO_CHECK(ec == asio::error::invalid_argument);
+  }
+
+  // Whole-string parsing does not accept trailing characters.
+  asio::ip::make_address_v4("1.2.3.4:80", ec);
+  ASIO_CHECK(ec == asio::error::invalid_argument);
+  ASIO_CHECK(asio::ip::make_address_v4("0.0.0.0", ec).is_unspecified());
+  ASIO_CHECK(!ec);
+}
+
+void test_address_v6_chars()
+{
+  using asio::ip::address_v6;
+
+  asio::error_code ec;
+  char str[address_v6::max_string_length];
+
+  const char* round_trip[] = { "::", "::1", "1::", "1:0:0:2::3",
+    "2001:db8::ff00:42:8329", "1:2:3:4:5:6:7:8", "::ffff:1.2.3.4",
+    "::1.2.3.4", "::ffff:0:102:304", "fe80::1%3", "ff02::1%12" };
+  for (std::size_t i = 0; i < sizeof(round_trip) / sizeof(round_trip[0]); ++i)
+  {
+    const char* s = round_trip[i];
+    address_v6 a;
+    const char* p = from_chars(s, s + std::strlen(s), a, ec);
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(p == s + std::strlen(s));
+    char* end = to_chars(str, str + sizeof(str), a, ec);
+    ASIO_CHECK(!ec);
+    // Link-local scope ids may be written as interface names.
+    if (a.scope_id() == 0)
+      ASIO_CHECK(std::string(str, end) == s);
+    ASIO_CHECK(std::string(str, end) == a.to_string());
+    ASIO_CHECK(asio::ip::make_address_v6(s, ec) == a);
+    ASIO_CHECK(!ec);
+  }
+
+  address_v6 a1 = asio::ip::make_address_v6("fe80::1%3", ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(a1.scope_id() == 3);
+
+  char* end = to_chars(str, str + 2, address_v6::loopback(), ec);
+  ASIO_CHECK(ec == asio::error::no_buffer_space);
+  ASIO_CHECK(end == str);
+
+  const char input1[] = "[::1]:80";
+  address_v6 a2;
+  const char* p = from_chars(input1 + 1, input1 + sizeof(input1) - 1, a2, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(p == input1 + 4);
+  ASIO_CHECK(a2.is_loopback());
+
+  const char* bad[] = { "", ":", ":::", "1:2:3:4:5:6:7:8:9", "1::2::3",
+    "12345::", "::1.2.3", "1:2:3:4:5:6:7:8::", "fe80::1%" };
+  for (std::size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); ++i)
+  {
+    p = from_chars(bad[i], bad[i] + std::strlen(bad[i]), a2, ec);
+    ASIO_CHECK(ec == asio::error::invalid_argument);
+    ASIO_CHECK(p == bad[i]);
+    ASIO_CHECK(a2.is_loopback());
+  }
+
+  asio::ip::make_address_v6("::1]", ec);
+  ASIO_CHECK(ec == asio::error::invalid_argument);
+}
+
+void test_address_chars()
+{
+  using asio::ip::address;
+
+  asio::error_code ec;
+  char str[address::max_string_length];
+
+  const char input1[] = "10.0.0.1:80";
+  address a1;
+  const char* p = from_chars(input1, input1 + sizeof(input1) - 1, a1, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(p == input1 + 8);
+  ASIO_CHECK(a1.is_v4());
+  char* end = to_chars(str, str + sizeof(str), a1, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(std::string(str, end) == "10.0.0.1");
+
+  const char input2[] = "1::2]";
+  p = from_chars(input2, input2 + sizeof(input2) - 1, a1, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(p == input2 + 4);
+  ASIO_CHECK(a1.is_v6());
+  end = to_chars(str, str + sizeof(str), a1, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(std::string(str, end) == "1::2");
+
+  const char input3[] = "10.0.0";
+  p = from_chars(input3, input3 + sizeof(input3) - 1, a1, ec);
+  ASIO_CHECK(ec == asio::error::invalid_argument);
+  ASIO_CHECK(p == input3);
+  ASIO_CHECK(a1.is_v6());
+}
+
+} // namespace ip_address_runtime
+
+//------------------------------------------------------------------------------
+
 ASIO_TEST_SUITE
 (
   "ip/address",
   ASIO_COMPILE_TEST_CASE(ip_address_compile::test)
+  ASIO_TEST_CASE(ip_address_runtime::test_address_v4_chars)
+  ASIO_TEST_CASE(ip_address_runtime::test_address_v6_chars)
+  ASIO_TEST_CASE(ip_address_runtime::test_address_chars)
 )
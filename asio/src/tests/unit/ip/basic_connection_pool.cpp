@@ -0,0 +1,323 @@
+//
+// basic_connection_pool.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/ip/basic_connection_pool.hpp"
+
+#include <string>
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+#include "../unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// ip_basic_connection_pool_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// ip::basic_connection_pool compile and link correctly. Runtime failures are
+// ignored.
+
+namespace ip_basic_connection_pool_compile {
+
+void acquire_handler(const asio::error_code&,
+    asio::ip::tcp::connection_pool::lease)
+{
+}
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+
+    ip::tcp::connection_pool pool1(ioc.get_executor());
+    ip::basic_connection_pool<ip::tcp::socket> pool2(ioc.get_executor());
+
+    any_io_executor ex = pool1.get_executor();
+    (void)ex;
+
+    std::size_t n = pool1.max_idle();
+    pool1.set_max_idle(n);
+    ip::tcp::connection_pool::duration d = pool1.idle_timeout();
+    pool1.set_idle_timeout(d);
+    n = pool1.idle_count();
+    pool1.clear();
+
+    pool1.async_acquire("localhost", "http", &acquire_handler);
+    pool1.async_acquire(std::string("localhost"),
+        std::string("http"), &acquire_handler);
+
+    ip::tcp::connection_pool::lease lease1;
+    ip::tcp::connection_pool::lease lease2(std::move(lease1));
+    lease1 = std::move(lease2);
+    bool b = static_cast<bool>(lease1);
+    b = lease1.reused();
+    (void)b;
+    if (lease1)
+    {
+      ip::tcp::socket& s1 = lease1.stream();
+      ip::tcp::socket& s2 = *lease1;
+      (void)s1;
+      (void)s2;
+      lease1->close();
+    }
+    lease1.release();
+    lease1.discard();
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace ip_basic_connection_pool_compile
+
+//------------------------------------------------------------------------------
+
+// ip_basic_connection_pool_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the
+// ip::basic_connection_pool class template.
+
+namespace ip_basic_connection_pool_runtime {
+
+using asio::ip::tcp;
+typedef tcp::connection_pool::lease lease;
+
+struct server
+{
+  explicit server(asio::io_context& ioc)
+    : acceptor(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0)),
+      port(std::to_string(acceptor.local_endpoint().port()))
+  {
+    accept();
+  }
+
+  void accept()
+  {
+    acceptor.async_accept(
+        [this](asio::error_code ec, tcp::socket s)
+        {
+          if (!ec)
+          {
+            sockets.push_back(std::move(s));
+            accept();
+          }
+        });
+  }
+
+  tcp::acceptor acceptor;
+  std::string port;
+  std::vector<tcp::socket> sockets;
+};
+
+struct acquire_result
+{
+  acquire_result()
+    : ec(asio::error::would_block)
+  {
+  }
+
+  asio::error_code ec;
+  lease result;
+};
+
+struct acquire_handler
+{
+  void operator()(asio::error_code e, lease l)
+  {
+    r->ec = e;
+    r->result = std::move(l);
+  }
+
+  acquire_result* r;
+};
+
+void test_reuse()
+{
+  asio::io_context ioc;
+  server srv(ioc);
+  tcp::connection_pool pool(ioc.get_executor());
+
+  acquire_result r1;
+  pool.async_acquire("127.0.0.1", srv.port, acquire_handler{&r1});
+  ASIO_CHECK(r1.ec == asio::error::would_block);
+  while (r1.ec == asio::error::would_block || srv.sockets.empty())
+    ioc.run_one_for(asio::chrono::seconds(5));
+  ASIO_CHECK(!r1.ec);
+  ASIO_CHECK(static_cast<bool>(r1.result));
+  ASIO_CHECK(!r1.result.reused());
+  tcp::endpoint local = r1.result->local_endpoint();
+
+  // Data written on the leased connection reaches the server.
+  asio::write(*r1.result, asio::buffer("ping", 4));
+  char data[4];
+  asio::read(srv.sockets[0], asio::buffer(data));
+  ASIO_CHECK(std::string(data, 4) == "ping");
+
+  // A released connection is held idle and handed out again.
+  r1.result.release();
+  ASIO_CHECK(!r1.result);
+  ASIO_CHECK(pool.idle_count() == 1);
+
+  acquire_result r2;
+  pool.async_acquire("127.0.0.1", srv.port, acquire_handler{&r2});
+  ASIO_CHECK(pool.idle_count() == 0);
+  while (r2.ec == asio::error::would_block)
+    ioc.run_one_for(asio::chrono::seconds(5));
+  ASIO_CHECK(!r2.ec);
+  ASIO_CHECK(r2.result.reused());
+  ASIO_CHECK(r2.result->local_endpoint() == local);
+  ASIO_CHECK(srv.sockets.size() == 1);
+
+  // The aborted health check did not consume data sent to the connection.
+  asio::write(srv.sockets[0], asio::buffer("pong", 4));
+  asio::read(*r2.result, asio::buffer(data));
+  ASIO_CHECK(std::string(data, 4) == "pong");
+
+  // A discarded connection is not reused.
+  r2.result.discard();
+  ASIO_CHECK(pool.idle_count() == 0);
+}
+
+void test_health_check()
+{
+  asio::io_context ioc;
+  server srv(ioc);
+  tcp::connection_pool pool(ioc.get_executor());
+
+  acquire_result r1;
+  pool.async_acquire("127.0.0.1", srv.port, acquire_handler{&r1});
+  while (r1.ec == asio::error::would_block || srv.sockets.empty())
+    ioc.run_one_for(asio::chrono::seconds(5));
+  ASIO_CHECK(!r1.ec);
+  r1.result.release();
+  ASIO_CHECK(pool.idle_count() == 1);
+
+  // A connection closed by the peer while idle is discarded.
+  srv.sockets[0].close();
+  for (int i = 0; i < 100 && pool.idle_count() != 0; ++i)
+    ioc.run_one_for(asio::chrono::milliseconds(50));
+  ASIO_CHECK(pool.idle_count() == 0);
+
+  acquire_result r2;
+  pool.async_acquire("127.0.0.1", srv.port, acquire_handler{&r2});
+  while (r2.ec == asio::error::would_block)
+    ioc.run_one_for(asio::chrono::seconds(5));
+  ASIO_CHECK(!r2.ec);
+  ASIO_CHECK(!r2.result.reused());
+}
+
+void test_idle_limits()
+{
+  asio::io_context ioc;
+  server srv(ioc);
+  tcp::connection_pool pool(ioc.get_executor());
+  pool.set_max_idle(1);
+  pool.set_idle_timeout(asio::chrono::milliseconds(50));
+  ASIO_CHECK(pool.max_idle() == 1);
+  ASIO_CHECK(pool.idle_timeout() == asio::chrono::milliseconds(50));
+
+  // Concurrent acquisitions each receive their own connection.
+  acquire_result r1, r2, r3;
+  pool.async_acquire("127.0.0.1", srv.port, acquire_handler{&r1});
+  pool.async_acquire("127.0.0.1", srv.port, acquire_handler{&r2});
+  pool.async_acquire("127.0.0.1", srv.port, acquire_handler{&r3});
+  while (r1.ec == asio::error::would_block
+      || r2.ec == asio::error::would_block
+      || r3.ec == asio::error::would_block)
+    ioc.run_one_for(asio::chrono::seconds(5));
+  ASIO_CHECK(!r1.ec && !r2.ec && !r3.ec);
+  ASIO_CHECK(r1.result->local_endpoint() != r2.result->local_endpoint());
+  ASIO_CHECK(r2.result->local_endpoint() != r3.result->local_endpoint());
+  ASIO_CHECK(r1.result->local_endpoint() != r3.result->local_endpoint());
+
+  // Only the maximum idle count of connections is held.
+  r1.result.release();
+  r2.result.release();
+  r3.result.release();
+  ASIO_CHECK(pool.idle_count() == 1);
+
+  // The idle connection is closed after the idle timeout.
+  for (int i = 0; i < 100 && pool.idle_count() != 0; ++i)
+    ioc.run_one_for(asio::chrono::milliseconds(50));
+  ASIO_CHECK(pool.idle_count() == 0);
+}
+
+void test_connect_failure()
+{
+  asio::io_context ioc;
+  std::string port;
+  {
+    tcp::acceptor acceptor(ioc,
+        tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+    port = std::to_string(acceptor.local_endpoint().port());
+  }
+
+  // Acquisitions waiting for the same failed connection all see its error.
+  tcp::connection_pool pool(ioc.get_executor());
+  acquire_result r1, r2;
+  pool.async_acquire("127.0.0.1", port, acquire_handler{&r1});
+  pool.async_acquire("127.0.0.1", port, acquire_handler{&r2});
+  ioc.run();
+  ASIO_CHECK(r1.ec == asio::error::connection_refused);
+  ASIO_CHECK(r2.ec == asio::error::connection_refused);
+  ASIO_CHECK(!r1.result);
+  ASIO_CHECK(!r2.result);
+}
+
+void test_destruction()
+{
+  asio::io_context ioc;
+  server srv(ioc);
+
+  acquire_result r1, r2;
+  {
+    tcp::connection_pool pool(ioc.get_executor());
+    pool.async_acquire("127.0.0.1", srv.port, acquire_handler{&r1});
+    while (r1.ec == asio::error::would_block)
+      ioc.run_one_for(asio::chrono::seconds(5));
+    ASIO_CHECK(!r1.ec);
+
+    pool.async_acquire("127.0.0.1", srv.port, acquire_handler{&r2});
+  }
+
+  // Pending acquisitions are aborted, and the lease outlives the pool.
+  ioc.run_for(asio::chrono::milliseconds(100));
+  ASIO_CHECK(r2.ec == asio::error::operation_aborted);
+  ASIO_CHECK(static_cast<bool>(r1.result));
+  asio::write(*r1.result, asio::buffer("ping", 4));
+  r1.result.release();
+}
+
+} // namespace ip_basic_connection_pool_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "ip/basic_connection_pool",
+  ASIO_COMPILE_TEST_CASE(ip_basic_connection_pool_compile::test)
+  ASIO_TEST_CASE(ip_basic_connection_pool_runtime::test_reuse)
+  ASIO_TEST_CASE(ip_basic_connection_pool_runtime::test_health_check)
+  ASIO_TEST_CASE(ip_basic_connection_pool_runtime::test_idle_limits)
+  ASIO_TEST_CASE(ip_basic_connection_pool_runtime::test_connect_failure)
+  ASIO_TEST_CASE(ip_basic_connection_pool_runtime::test_destruction)
+)
@@ -16,10 +16,96 @@
 // Test that header file is self-contained.
 #include "asio/ip/basic_resolver_iterator.hpp"
 
+#include <string>
+#include <vector>
+#include "asio/ip/tcp.hpp"
 #include "../unit_test.hpp"
 
+//------------------------------------------------------------------------------
+
+// ip_basic_resolver_iterator_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime behaviour of the resolver results
+// range and its iterators.
+
+namespace ip_basic_resolver_iterator_runtime {
+
+using asio::ip::tcp;
+
+void test_entry()
+{
+  tcp::resolver::results_type::value_type entry1;
+  ASIO_CHECK(entry1.host_name().empty());
+  ASIO_CHECK(entry1.service_name().empty());
+
+  tcp::endpoint ep(asio::ip::make_address("192.0.2.1"), 80);
+  tcp::resolver::results_type::value_type entry2(ep, "host", "http");
+  ASIO_CHECK(entry2.endpoint() == ep);
+  ASIO_CHECK(entry2.host_name() == "host");
+  ASIO_CHECK(entry2.service_name() == "http");
+
+  entry1 = entry2;
+  entry2 = tcp::resolver::results_type::value_type();
+  ASIO_CHECK(entry1.host_name() == "host");
+  ASIO_CHECK(entry1.service_name() == "http");
+  ASIO_CHECK(entry2.host_name().empty());
+}
+
+void test_results()
+{
+  tcp::resolver::results_type empty;
+  ASIO_CHECK(empty.empty());
+  ASIO_CHECK(empty.size() == 0);
+  ASIO_CHECK(empty.begin() == empty.end());
+
+  std::vector<tcp::endpoint> endpoints;
+  endpoints.push_back(tcp::endpoint(asio::ip::make_address("192.0.2.1"), 80));
+  endpoints.push_back(tcp::endpoint(asio::ip::make_address("2001:db8::1"), 80));
+  endpoints.push_back(tcp::endpoint(asio::ip::make_address("192.0.2.2"), 80));
+
+  tcp::resolver::results_type::value_type entry;
+  {
+    tcp::resolver::results_type results =
+      tcp::resolver::results_type::create(
+          endpoints.begin(), endpoints.end(), "host", "http");
+    ASIO_CHECK(!results.empty());
+    ASIO_CHECK(results.size() == 3);
+
+    tcp::resolver::results_type copy(results);
+    ASIO_CHECK(copy == results);
+
+    std::size_t i = 0;
+    for (tcp::resolver::results_type::const_iterator iter = copy.begin();
+        iter != copy.end(); ++iter, ++i)
+    {
+      ASIO_CHECK(iter->endpoint() == endpoints[i]);
+      ASIO_CHECK(iter->host_name() == "host");
+      ASIO_CHECK(iter->service_name() == "http");
+    }
+    ASIO_CHECK(i == 3);
+
+    entry = *++results.begin();
+  }
+
+  // An entry copied out of the results outlives them.
+  ASIO_CHECK(entry.endpoint() == endpoints[1]);
+  ASIO_CHECK(entry.host_name() == "host");
+  ASIO_CHECK(entry.service_name() == "http");
+
+  tcp::resolver::results_type single =
+    tcp::resolver::results_type::create(endpoints[0], "", "80");
+  ASIO_CHECK(single.size() == 1);
+  ASIO_CHECK(single.begin()->host_name().empty());
+  ASIO_CHECK(single.begin()->service_name() == "80");
+}
+
+} // namespace ip_basic_resolver_iterator_runtime
+
+//------------------------------------------------------------------------------
+
 ASIO_TEST_SUITE
 (
   "ip/basic_resolver_iterator",
-  ASIO_TEST_CASE(null_test)
+  ASIO_TEST_CASE(ip_basic_resolver_iterator_runtime::test_entry)
+  ASIO_TEST_CASE(ip_basic_resolver_iterator_runtime::test_results)
 )
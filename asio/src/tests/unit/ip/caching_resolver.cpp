@@ -0,0 +1,237 @@
+//
+// caching_resolver.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/ip/caching_resolver.hpp"
+
+#include "asio/config.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "../unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// ip_caching_resolver_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// ip::caching_resolver compile and link correctly. Runtime failures are
+// ignored.
+
+namespace ip_caching_resolver_compile {
+
+struct resolve_handler
+{
+  resolve_handler() {}
+  void operator()(const asio::error_code&,
+      asio::ip::tcp::resolver::results_type) {}
+  resolve_handler(resolve_handler&&) {}
+private:
+  resolve_handler(const resolve_handler&);
+};
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    const io_context::executor_type ioc_ex = ioc.get_executor();
+    asio::error_code ec;
+
+    // caching_resolver constructors.
+
+    ip::caching_resolver<ip::tcp> resolver1(ioc);
+    ip::caching_resolver<ip::tcp> resolver2(ioc_ex);
+    ip::caching_resolver<ip::tcp> resolver3(std::move(resolver1));
+
+    // caching_resolver operators.
+
+    resolver1 = std::move(resolver3);
+
+    // caching_resolver functions.
+
+    ip::caching_resolver<ip::tcp>::executor_type ex
+      = resolver1.get_executor();
+    (void)ex;
+
+    resolver1.cancel();
+
+    ip::tcp::resolver::results_type results1 = resolver1.resolve("", "");
+    (void)results1;
+
+    ip::tcp::resolver::results_type results2 =
+      resolver1.resolve("", "", ip::tcp::resolver::flags(), ec);
+    (void)results2;
+
+    resolver1.async_resolve("", "", resolve_handler());
+    resolver1.async_resolve("", "",
+        ip::tcp::resolver::flags(), resolve_handler());
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace ip_caching_resolver_compile
+
+//------------------------------------------------------------------------------
+
+// ip_caching_resolver_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the ip::caching_resolver
+// class.
+
+namespace ip_caching_resolver_runtime {
+
+using asio::ip::tcp;
+
+typedef asio::ip::caching_resolver<tcp> resolver_type;
+typedef resolver_type::results_type results_type;
+
+struct resolve_handler
+{
+  void operator()(const asio::error_code& e, results_type r)
+  {
+    *ec = e;
+    *results = r;
+    ++*count;
+  }
+
+  asio::error_code* ec;
+  results_type* results;
+  int* count;
+};
+
+void test_collapsing()
+{
+  asio::io_context ioc;
+  resolver_type resolver1(ioc);
+  resolver_type resolver2(ioc);
+
+  asio::error_code ec1, ec2;
+  results_type results1, results2;
+  int count = 0;
+
+  // Concurrent lookups of the same name share the same resolution.
+  resolver1.async_resolve("127.0.0.1", "80",
+      resolve_handler{&ec1, &results1, &count});
+  resolver2.async_resolve("127.0.0.1", "80",
+      resolve_handler{&ec2, &results2, &count});
+  ASIO_CHECK(count == 0);
+
+  ioc.run();
+
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(!ec1);
+  ASIO_CHECK(!ec2);
+  ASIO_CHECK(!results1.empty());
+  ASIO_CHECK(results1 == results2);
+  ASIO_CHECK(results1.begin()->endpoint()
+      == tcp::endpoint(asio::ip::make_address("127.0.0.1"), 80));
+
+  // A later lookup is answered from the cache, without a new resolution.
+  results_type results3;
+  asio::error_code ec3;
+  resolver1.async_resolve("127.0.0.1", "80",
+      resolve_handler{&ec3, &results3, &count});
+  ASIO_CHECK(count == 2);
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(count == 3);
+  ASIO_CHECK(!ec3);
+  ASIO_CHECK(results3 == results1);
+
+  // Synchronous lookups also use the cache.
+  results_type results4 = resolver2.resolve("127.0.0.1", "80");
+  ASIO_CHECK(results4 == results1);
+
+  // Lookups using different flags are cached separately.
+  results_type results5 = resolver2.resolve("127.0.0.1", "80",
+      tcp::resolver::numeric_host);
+  ASIO_CHECK(!results5.empty());
+  ASIO_CHECK(results5 != results1);
+}
+
+void test_negative_caching()
+{
+  asio::io_context ioc;
+  resolver_type resolver(ioc);
+
+  asio::error_code ec;
+  results_type results;
+  int count = 0;
+
+  // A name that cannot be resolved is cached as host_not_found.
+  resolver.async_resolve("not a number", "80", tcp::resolver::numeric_host,
+      resolve_handler{&ec, &results, &count});
+  ioc.run();
+
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(ec == asio::error::host_not_found);
+  ASIO_CHECK(results.empty());
+
+  asio::error_code ec2;
+  results_type results2 = resolver.resolve("not a number", "80",
+      tcp::resolver::numeric_host, ec2);
+  ASIO_CHECK(ec2 == asio::error::host_not_found);
+  ASIO_CHECK(results2.empty());
+}
+
+void test_disabled()
+{
+  asio::io_context ioc(asio::config_from_string("resolver.cache_ttl=0"));
+  resolver_type resolver(ioc);
+
+  asio::error_code ec1, ec2;
+  results_type results1, results2;
+  int count = 0;
+
+  // With a zero lifetime, completed resolutions are not reused.
+  resolver.async_resolve("127.0.0.1", "80",
+      resolve_handler{&ec1, &results1, &count});
+  ioc.run();
+  resolver.async_resolve("127.0.0.1", "80",
+      resolve_handler{&ec2, &results2, &count});
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(!ec1);
+  ASIO_CHECK(!ec2);
+  ASIO_CHECK(!results1.empty());
+  ASIO_CHECK(results1 != results2);
+}
+
+void test()
+{
+  test_collapsing();
+  test_negative_caching();
+  test_disabled();
+}
+
+} // namespace ip_caching_resolver_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "ip/caching_resolver",
+  ASIO_COMPILE_TEST_CASE(ip_caching_resolver_compile::test)
+  ASIO_TEST_CASE(ip_caching_resolver_runtime::test)
+)
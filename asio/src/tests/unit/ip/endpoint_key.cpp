@@ -0,0 +1,176 @@
+//
+// endpoint_key.cpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/ip/endpoint_key.hpp"
+
+#include <type_traits>
+#include <unordered_map>
+#include "asio/ip/tcp.hpp"
+#include "asio/ip/udp.hpp"
+#include "../unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// ip_endpoint_key_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// ip::endpoint_key compile and link correctly. Runtime failures are ignored.
+
+namespace ip_endpoint_key_compile {
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    ip::udp::endpoint ep1;
+    ip::tcp::endpoint ep2;
+
+    // endpoint_key constructors.
+
+    ip::endpoint_key key1;
+    ip::endpoint_key key2(ip::address(), 0);
+    ip::endpoint_key key3(ep1);
+    ip::endpoint_key key4(ep2);
+
+    // endpoint_key functions.
+
+    bool b = key1.is_v4();
+    (void)b;
+
+    b = key1.is_v6();
+    (void)b;
+
+    ip::address addr1 = key1.address();
+    (void)addr1;
+
+    unsigned short port1 = key1.port();
+    (void)port1;
+
+    ep1 = key1.to_endpoint<ip::udp>();
+    ep2 = key1.to_endpoint<ip::tcp>();
+
+    std::size_t hash1 = key1.hash();
+    (void)hash1;
+
+    // endpoint_key comparisons.
+
+    b = (key1 == key2);
+    (void)b;
+
+    b = (key1 != key2);
+    (void)b;
+
+    b = (key1 < key2);
+    (void)b;
+
+    b = (key1 > key2);
+    (void)b;
+
+    b = (key1 <= key2);
+    (void)b;
+
+    b = (key1 >= key2);
+    (void)b;
+
+    std::size_t hash2 = std::hash<ip::endpoint_key>()(key3);
+    (void)hash2;
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace ip_endpoint_key_compile
+
+//------------------------------------------------------------------------------
+
+// ip_endpoint_key_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that endpoint keys are equal if and only if the
+// corresponding endpoints are equal.
+
+namespace ip_endpoint_key_runtime {
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  ASIO_CHECK(std::is_trivially_copyable<ip::endpoint_key>::value);
+  ASIO_CHECK(sizeof(ip::endpoint_key) <= 24);
+
+  ip::udp::endpoint endpoints[] =
+  {
+    ip::udp::endpoint(),
+    ip::udp::endpoint(ip::udp::v6(), 0),
+    ip::udp::endpoint(ip::make_address("1.2.3.4"), 80),
+    ip::udp::endpoint(ip::make_address("1.2.3.4"), 81),
+    ip::udp::endpoint(ip::make_address("1.2.3.5"), 80),
+    ip::udp::endpoint(ip::make_address("::ffff:1.2.3.4"), 80),
+    ip::udp::endpoint(ip::make_address("::1"), 80),
+    ip::udp::endpoint(ip::make_address("fe80::1%1"), 80),
+    ip::udp::endpoint(ip::make_address("fe80::1%2"), 80),
+    ip::udp::endpoint(ip::make_address("fe80::1"), 65535)
+  };
+  const std::size_t n = sizeof(endpoints) / sizeof(endpoints[0]);
+
+  ASIO_CHECK(ip::endpoint_key() == ip::endpoint_key(endpoints[0]));
+
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    ip::endpoint_key key1(endpoints[i]);
+    ASIO_CHECK(key1.is_v4() == endpoints[i].address().is_v4());
+    ASIO_CHECK(key1.is_v6() == endpoints[i].address().is_v6());
+    ASIO_CHECK(key1.address() == endpoints[i].address());
+    ASIO_CHECK(key1.port() == endpoints[i].port());
+    ASIO_CHECK(key1.to_endpoint<ip::udp>() == endpoints[i]);
+    ASIO_CHECK(ip::endpoint_key(endpoints[i].address(),
+          endpoints[i].port()) == key1);
+    ASIO_CHECK(std::hash<ip::endpoint_key>()(key1)
+        == std::hash<ip::udp::endpoint>()(endpoints[i]));
+
+    for (std::size_t j = 0; j < n; ++j)
+    {
+      ip::endpoint_key key2(endpoints[j]);
+      ASIO_CHECK((key1 == key2) == (i == j));
+      ASIO_CHECK((key1 != key2) == (i != j));
+      ASIO_CHECK((key1 < key2) + (key2 < key1) + (key1 == key2) == 1);
+      if (i != j)
+        ASIO_CHECK(key1.hash() != key2.hash());
+    }
+  }
+
+  std::unordered_map<ip::endpoint_key, std::size_t> peers;
+  for (std::size_t i = 0; i < n; ++i)
+    peers[ip::endpoint_key(endpoints[i])] = i;
+  ASIO_CHECK(peers.size() == n);
+  for (std::size_t i = 0; i < n; ++i)
+    ASIO_CHECK(peers[ip::endpoint_key(endpoints[i])] == i);
+}
+
+} // namespace ip_endpoint_key_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "ip/endpoint_key",
+  ASIO_COMPILE_TEST_CASE(ip_endpoint_key_compile::test)
+  ASIO_TEST_CASE(ip_endpoint_key_runtime::test)
+)
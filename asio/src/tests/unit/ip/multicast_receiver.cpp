@@ -0,0 +1,206 @@
+//
+// multicast_receiver.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/ip/multicast_receiver.hpp"
+
+#include "../unit_test.hpp"
+
+#if defined(ASIO_HAS_MULTICAST_RECEIVER)
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/ip/multicast.hpp"
+#include "asio/ip/udp.hpp"
+#include "asio/steady_timer.hpp"
+
+//------------------------------------------------------------------------------
+
+// ip_multicast_receiver_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following tests check the runtime operation of the
+// ip::multicast_receiver class.
+
+namespace ip_multicast_receiver_runtime {
+
+using asio::ip::address;
+using asio::ip::address_v4;
+using asio::ip::multicast_receiver;
+using asio::ip::udp;
+
+struct received
+{
+  address group;
+  std::string data;
+};
+
+struct record_handler
+{
+  std::vector<received>* log;
+
+  void operator()(const multicast_receiver::datagram& d) const
+  {
+    received r;
+    r.group = d.group;
+    r.data.assign(static_cast<const char*>(d.data.data()), d.data.size());
+    log->push_back(r);
+  }
+};
+
+struct receive_handler
+{
+  multicast_receiver* receiver;
+  std::size_t* total;
+  std::size_t target;
+  asio::error_code* ec;
+
+  void operator()(const asio::error_code& e, std::size_t n) const
+  {
+    *ec = e;
+    *total += n;
+    if (!e && *total < target)
+      receiver->async_receive(*this);
+  }
+};
+
+void test_demultiplex()
+{
+  asio::io_context ioc;
+  multicast_receiver receiver(ioc);
+  receiver.open(udp::endpoint(udp::v4(), 0), 8, 64);
+  unsigned short port = receiver.socket().local_endpoint().port();
+
+  const address_v4 loopback = address_v4::loopback();
+  const address_v4 group1 = asio::ip::make_address_v4("239.255.17.1");
+  const address_v4 group2 = asio::ip::make_address_v4("239.255.17.2");
+  const address_v4 group3 = asio::ip::make_address_v4("239.255.17.3");
+
+  std::vector<received> log1, log2;
+  record_handler handler1 = { &log1 };
+  record_handler handler2 = { &log2 };
+  asio::error_code ec;
+  receiver.join(group1, loopback, handler1, ec);
+  if (ec)
+  {
+    // The host does not support multicast on the loopback interface.
+    return;
+  }
+  receiver.join(group2, loopback, handler2);
+  ASIO_CHECK(receiver.group_count() == 2);
+
+  receiver.join(group2, loopback, handler2, ec);
+  ASIO_CHECK(ec == asio::error::already_open);
+
+  udp::socket sender(ioc, udp::endpoint(loopback, 0));
+  sender.set_option(asio::ip::multicast::outbound_interface(loopback));
+  sender.set_option(asio::ip::multicast::enable_loopback(true));
+
+  // Datagrams for group 3 are sent to the port but are not dispatched.
+  sender.send_to(asio::buffer("one", 3), udp::endpoint(group1, port));
+  sender.send_to(asio::buffer("skip", 4), udp::endpoint(group3, port));
+  sender.send_to(asio::buffer("two", 3), udp::endpoint(group2, port));
+  sender.send_to(asio::buffer("three", 5), udp::endpoint(group1, port));
+
+  ec = asio::error_code();
+  std::size_t total = 0;
+  receive_handler handler = { &receiver, &total, 3, &ec };
+  receiver.async_receive(handler);
+  ASIO_CHECK(total == 0);
+
+  asio::steady_timer timer(ioc, std::chrono::seconds(5));
+  timer.async_wait([&](asio::error_code){ receiver.cancel(); });
+  while (total < 3 && !ec && ioc.run_one())
+  {
+  }
+  timer.cancel();
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(total == 3);
+  ASIO_CHECK(log1.size() == 2);
+  ASIO_CHECK(log2.size() == 1);
+  if (log1.size() == 2 && log2.size() == 1)
+  {
+    ASIO_CHECK(log1[0].group == address(group1));
+    ASIO_CHECK(log1[0].data == "one");
+    ASIO_CHECK(log1[1].data == "three");
+    ASIO_CHECK(log2[0].group == address(group2));
+    ASIO_CHECK(log2[0].data == "two");
+  }
+
+  receiver.leave(group1);
+  ASIO_CHECK(receiver.group_count() == 1);
+  receiver.leave(group1, ec);
+  ASIO_CHECK(ec == asio::error::not_found);
+}
+
+void test_cancel()
+{
+  asio::io_context ioc;
+  multicast_receiver receiver(ioc);
+  receiver.open(udp::endpoint(udp::v4(), 0));
+
+  asio::error_code ec;
+  std::size_t total = 0;
+  receive_handler handler = { &receiver, &total, 1, &ec };
+  receiver.async_receive(handler);
+  ioc.poll();
+  receiver.cancel();
+  ioc.run();
+
+  ASIO_CHECK(ec == asio::error::operation_aborted);
+  ASIO_CHECK(total == 0);
+}
+
+void test_not_open()
+{
+  asio::io_context ioc;
+  multicast_receiver receiver(ioc);
+
+  asio::error_code ec;
+  receiver.open(udp::endpoint(udp::v4(), 0), 0, 64, ec);
+  ASIO_CHECK(ec == asio::error::invalid_argument);
+  ASIO_CHECK(!receiver.is_open());
+
+  std::size_t total = 0;
+  receive_handler handler = { &receiver, &total, 1, &ec };
+  receiver.async_receive(handler);
+  ioc.run();
+
+  ASIO_CHECK(ec == asio::error::bad_descriptor);
+}
+
+} // namespace ip_multicast_receiver_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "ip/multicast_receiver",
+  ASIO_TEST_CASE(ip_multicast_receiver_runtime::test_demultiplex)
+  ASIO_TEST_CASE(ip_multicast_receiver_runtime::test_cancel)
+  ASIO_TEST_CASE(ip_multicast_receiver_runtime::test_not_open)
+)
+
+#else // defined(ASIO_HAS_MULTICAST_RECEIVER)
+
+ASIO_TEST_SUITE
+(
+  "ip/multicast_receiver",
+  ASIO_TEST_CASE(null_test)
+)
+
+#endif // defined(ASIO_HAS_MULTICAST_RECEIVER)
@@ -0,0 +1,71 @@
+//
+// packet_info.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/ip/packet_info.hpp"
+
+#include "../unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// ip_packet_info_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime behaviour of the ip::packet_info
+// class.
+
+namespace ip_packet_info_runtime {
+
+void test()
+{
+  using asio::ip::packet_info;
+
+  packet_info info;
+  ASIO_CHECK(info.local_address().is_unspecified());
+  ASIO_CHECK(info.interface_index() == 0);
+  ASIO_CHECK(!info.has_traffic_class());
+  ASIO_CHECK(info.traffic_class() == 0);
+
+  info.local_address(asio::ip::make_address("192.0.2.1"));
+  ASIO_CHECK(info.local_address() == asio::ip::make_address("192.0.2.1"));
+  info.interface_index(3);
+  ASIO_CHECK(info.interface_index() == 3);
+
+  // Expedited forwarding, ECT(0).
+  info.dscp(46);
+  ASIO_CHECK(info.has_traffic_class());
+  ASIO_CHECK(info.traffic_class() == 0xB8);
+  info.ecn(packet_info::ect0);
+  ASIO_CHECK(info.traffic_class() == 0xBA);
+  ASIO_CHECK(info.dscp() == 46);
+  ASIO_CHECK(info.ecn() == packet_info::ect0);
+
+  info.traffic_class(0x03);
+  ASIO_CHECK(info.dscp() == 0);
+  ASIO_CHECK(info.ecn() == packet_info::ce);
+
+  info.clear_traffic_class();
+  ASIO_CHECK(!info.has_traffic_class());
+  ASIO_CHECK(info.traffic_class() == 0);
+}
+
+} // namespace ip_packet_info_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "ip/packet_info",
+  ASIO_TEST_CASE(ip_packet_info_runtime::test)
+)
@@ -0,0 +1,270 @@
+//
+// prefix_table.cpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/ip/prefix_table.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// ip_prefix_table_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// ip::prefix_table compile and link correctly. Runtime failures are ignored.
+
+namespace ip_prefix_table_compile {
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    ip::network_v4 net4;
+    ip::network_v6 net6;
+    std::string value;
+
+    ip::prefix_table<std::string> table1;
+    ip::prefix_table<std::string> table2(table1);
+    ip::prefix_table<std::string> table3(std::move(table2));
+    table2 = table1;
+    table3 = std::move(table2);
+
+    bool b = table1.insert(net4, value);
+    b = table1.insert(net4, std::string());
+    b = table1.insert(net6, value);
+    b = table1.insert(net6, std::string());
+    b = table1.erase(net4);
+    b = table1.erase(net6);
+    b = table1.empty();
+    (void)b;
+
+    std::size_t n = table1.size();
+    (void)n;
+
+    std::string* p1 = table1.find(net4);
+    (void)p1;
+    std::string* p2 = table1.find(net6);
+    (void)p2;
+
+    const ip::prefix_table<std::string>& const_table = table1;
+    const std::string* p3 = const_table.find(net4);
+    (void)p3;
+    const std::string* p4 = const_table.find(net6);
+    (void)p4;
+    const std::string* p5 = const_table.lookup(ip::address_v4());
+    (void)p5;
+    const std::string* p6 = const_table.lookup(ip::address_v6());
+    (void)p6;
+    const std::string* p7 = const_table.lookup(ip::address());
+    (void)p7;
+
+    table1.clear();
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace ip_prefix_table_compile
+
+//------------------------------------------------------------------------------
+
+// ip_prefix_table_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime behaviour of the ip::prefix_table
+// class template.
+
+namespace ip_prefix_table_runtime {
+
+using asio::ip::address_v4;
+using asio::ip::make_address;
+using asio::ip::make_network_v4;
+using asio::ip::make_network_v6;
+using asio::ip::network_v4;
+
+int lookup(const asio::ip::prefix_table<int>& table, const char* addr)
+{
+  const int* p = table.lookup(make_address(addr));
+  return p ? *p : -1;
+}
+
+int lookup(const asio::ip::prefix_table<int>& table, unsigned int addr)
+{
+  const int* p = table.lookup(address_v4(addr));
+  return p ? *p : -1;
+}
+
+void test_longest_match()
+{
+  asio::ip::prefix_table<int> table;
+  ASIO_CHECK(table.empty());
+
+  ASIO_CHECK(table.insert(make_network_v4("10.0.0.0/8"), 1));
+  ASIO_CHECK(table.insert(make_network_v4("10.1.0.0/16"), 2));
+  ASIO_CHECK(table.insert(make_network_v4("10.1.2.0/24"), 3));
+  ASIO_CHECK(table.insert(make_network_v4("10.1.2.3/32"), 4));
+  ASIO_CHECK(table.insert(make_network_v4("192.168.0.0/16"), 5));
+  ASIO_CHECK(table.insert(make_network_v6("2001:db8::/32"), 6));
+  ASIO_CHECK(table.insert(make_network_v6("2001:db8:1::/48"), 7));
+  ASIO_CHECK(table.size() == 7);
+
+  // A network with host bits is the same as its canonical form.
+  ASIO_CHECK(!table.insert(make_network_v4("10.9.9.9/8"), 100));
+  ASIO_CHECK(table.size() == 7);
+
+  ASIO_CHECK(lookup(table, "10.200.0.1") == 1);
+  ASIO_CHECK(lookup(table, "10.1.200.1") == 2);
+  ASIO_CHECK(lookup(table, "10.1.2.200") == 3);
+  ASIO_CHECK(lookup(table, "10.1.2.3") == 4);
+  ASIO_CHECK(lookup(table, "192.168.44.1") == 5);
+  ASIO_CHECK(lookup(table, "11.0.0.1") == -1);
+  ASIO_CHECK(lookup(table, "2001:db8:2::1") == 6);
+  ASIO_CHECK(lookup(table, "2001:db8:1:ffff::1") == 7);
+  ASIO_CHECK(lookup(table, "2001:db9::1") == -1);
+  ASIO_CHECK(lookup(table, "::ffff:10.1.2.3") == -1);
+
+  ASIO_CHECK(table.find(make_network_v4("10.1.0.0/16")) != 0);
+  ASIO_CHECK(*table.find(make_network_v4("10.1.0.0/16")) == 2);
+  ASIO_CHECK(table.find(make_network_v4("10.1.0.0/17")) == 0);
+  ASIO_CHECK(table.find(make_network_v6("2001:db8::/33")) == 0);
+
+  *table.find(make_network_v4("10.1.0.0/16")) = 20;
+  ASIO_CHECK(lookup(table, "10.1.200.1") == 20);
+
+  // Erasing a network exposes the less specific networks beneath it.
+  ASIO_CHECK(table.erase(make_network_v4("10.1.2.0/24")));
+  ASIO_CHECK(!table.erase(make_network_v4("10.1.2.0/24")));
+  ASIO_CHECK(lookup(table, "10.1.2.200") == 20);
+  ASIO_CHECK(lookup(table, "10.1.2.3") == 4);
+  ASIO_CHECK(table.erase(make_network_v4("10.1.0.0/16")));
+  ASIO_CHECK(lookup(table, "10.1.2.200") == 1);
+  ASIO_CHECK(table.size() == 5);
+
+  // A default route matches every address of its family.
+  ASIO_CHECK(table.insert(make_network_v4("0.0.0.0/0"), 0));
+  ASIO_CHECK(lookup(table, "11.0.0.1") == 0);
+  ASIO_CHECK(lookup(table, "2001:db9::1") == -1);
+
+  asio::ip::prefix_table<int> copy(table);
+  table.clear();
+  ASIO_CHECK(table.empty());
+  ASIO_CHECK(lookup(table, "10.1.2.3") == -1);
+  ASIO_CHECK(copy.size() == 6);
+  ASIO_CHECK(lookup(copy, "10.1.2.3") == 4);
+  ASIO_CHECK(lookup(copy, "2001:db8:1::1") == 7);
+}
+
+struct rule
+{
+  unsigned int network;
+  unsigned short prefix_length;
+  int value;
+};
+
+bool contains(const rule& r, unsigned int addr)
+{
+  unsigned int mask = r.prefix_length == 0
+    ? 0 : 0xFFFFFFFFu << (32 - r.prefix_length);
+  return (addr & mask) == (r.network & mask);
+}
+
+int linear_lookup(const std::vector<rule>& rules, unsigned int addr)
+{
+  int value = -1;
+  int best = -1;
+  for (std::size_t i = 0; i < rules.size(); ++i)
+  {
+    if (contains(rules[i], addr) && rules[i].prefix_length > best)
+    {
+      best = rules[i].prefix_length;
+      value = rules[i].value;
+    }
+  }
+  return value;
+}
+
+unsigned int random_address()
+{
+  // Restrict the addresses to a few /8 networks so that rules overlap.
+  return (static_cast<unsigned int>(std::rand() % 4) << 24)
+    | (static_cast<unsigned int>(std::rand() & 0xFFF) << 12)
+    | static_cast<unsigned int>(std::rand() & 0xFFF);
+}
+
+void test_random()
+{
+  std::srand(1);
+
+  asio::ip::prefix_table<int> table;
+  std::vector<rule> rules;
+  for (int i = 0; i < 2000; ++i)
+  {
+    rule r;
+    r.prefix_length = static_cast<unsigned short>(std::rand() % 33);
+    r.network = random_address();
+    if (r.prefix_length < 32)
+      r.network &= r.prefix_length == 0
+        ? 0 : 0xFFFFFFFFu << (32 - r.prefix_length);
+    r.value = i;
+    if (table.insert(network_v4(address_v4(r.network), r.prefix_length), i))
+      rules.push_back(r);
+  }
+  ASIO_CHECK(table.size() == rules.size());
+
+  for (int i = 0; i < 5000; ++i)
+  {
+    unsigned int addr = random_address();
+    ASIO_CHECK(lookup(table, addr) == linear_lookup(rules, addr));
+  }
+
+  // Erase half of the rules and check again.
+  std::vector<rule> remaining;
+  for (std::size_t i = 0; i < rules.size(); ++i)
+  {
+    if (i % 2 == 0)
+    {
+      ASIO_CHECK(table.erase(network_v4(
+              address_v4(rules[i].network), rules[i].prefix_length)));
+    }
+    else
+      remaining.push_back(rules[i]);
+  }
+  ASIO_CHECK(table.size() == remaining.size());
+
+  for (int i = 0; i < 5000; ++i)
+  {
+    unsigned int addr = random_address();
+    ASIO_CHECK(lookup(table, addr) == linear_lookup(remaining, addr));
+  }
+}
+
+} // namespace ip_prefix_table_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "ip/prefix_table",
+  ASIO_COMPILE_TEST_CASE(ip_prefix_table_compile::test)
+  ASIO_TEST_CASE(ip_prefix_table_runtime::test_longest_match)
+  ASIO_TEST_CASE(ip_prefix_table_runtime::test_random)
+)
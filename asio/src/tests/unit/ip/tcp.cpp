@@ -19,10 +19,20 @@
 // Test that header file is self-contained.
 #include "asio/ip/tcp.hpp"
 
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
 #include <functional>
+#include <string>
+#include <vector>
+#include "asio/bind_allocator.hpp"
+#include "asio/bind_cancellation_slot.hpp"
+#include "asio/cancel_after.hpp"
+#include "asio/config.hpp"
 #include "asio/io_context.hpp"
+#include "asio/ip/udp.hpp"
 #include "asio/read.hpp"
+#include "asio/thread.hpp"
 #include "asio/write.hpp"
 #include "../unit_test.hpp"
 #include "../archetypes/async_result.hpp"
@@ -66,8 +76,32 @@ void test()
     (void)static_cast<bool>(!no_delay1);
     (void)static_cast<bool>(no_delay1.value());
 
+#if defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
+    // not_sent_low_watermark class.
+
+    ip::tcp::not_sent_low_watermark not_sent_low_watermark1(16384);
+    sock.set_option(not_sent_low_watermark1);
+    ip::tcp::not_sent_low_watermark not_sent_low_watermark2;
+    sock.get_option(not_sent_low_watermark2);
+    not_sent_low_watermark1 = 1024;
+    (void)static_cast<int>(not_sent_low_watermark1.value());
+
+    // bytes_unsent class.
+
+    ip::tcp::bytes_unsent bytes_unsent1;
+    sock.io_control(bytes_unsent1);
+    (void)static_cast<std::size_t>(bytes_unsent1.get());
+#endif // defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
+
     ip::tcp::endpoint ep;
     (void)static_cast<std::size_t>(std::hash<ip::tcp::endpoint>()(ep));
+
+    asio::error_code ec;
+    char chars[ip::tcp::endpoint::max_string_length];
+    char* chars_end = ip::to_chars(chars,
+        chars + ip::tcp::endpoint::max_string_length, ep, ec);
+    const char* const_chars_end = ip::from_chars(chars, chars_end, ep, ec);
+    (void)const_chars_end;
   }
   catch (std::exception&)
   {
@@ -124,6 +158,139 @@ void test()
   ASIO_CHECK(!no_delay4);
 }
 
+#if defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
+void handle_wait_writable(const asio::error_code& err, bool* called)
+{
+  ASIO_CHECK(!err);
+  *called = true;
+}
+#endif // defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
+
+void test_not_sent_low_watermark()
+{
+#if defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  namespace bindns = std;
+  using bindns::placeholders::_1;
+
+  io_context ioc;
+  asio::error_code ec;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
+
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  const int mark = 16384;
+  client_side_socket.set_option(ip::tcp::not_sent_low_watermark(mark), ec);
+  ASIO_CHECK(!ec);
+
+  ip::tcp::not_sent_low_watermark option;
+  client_side_socket.get_option(option, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(option.value() == mark);
+
+  ip::tcp::bytes_unsent unsent;
+  client_side_socket.io_control(unsent, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(unsent.get() == 0);
+
+  // Write until the peer's receive window is full and the backlog reaches the
+  // mark.
+  std::vector<char> data(64 * 1024, 'x');
+  client_side_socket.non_blocking(true);
+  std::size_t total_written = 0;
+  for (;;)
+  {
+    std::size_t n = client_side_socket.write_some(asio::buffer(data), ec);
+    if (ec)
+      break;
+    total_written += n;
+  }
+  ASIO_CHECK(ec == asio::error::would_block);
+
+  client_side_socket.io_control(unsent, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(unsent.get() >= static_cast<std::size_t>(mark));
+  ASIO_CHECK(unsent.get() <= total_written);
+
+  // A wait for writability does not complete while the backlog is above the
+  // mark.
+  bool writable = false;
+  client_side_socket.async_wait(socket_base::wait_write,
+      bindns::bind(handle_wait_writable, _1, &writable));
+  ioc.poll();
+  ASIO_CHECK(!writable);
+
+  // Drain the peer until the wait completes. At that point the backlog must
+  // have fallen below the mark.
+  std::size_t total_read = 0;
+  while (!writable && total_read < total_written)
+  {
+    total_read += server_side_socket.read_some(asio::buffer(data), ec);
+    ASIO_CHECK(!ec);
+    ioc.poll();
+  }
+  ASIO_CHECK(writable);
+
+  client_side_socket.io_control(unsent, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(unsent.get() < static_cast<std::size_t>(mark));
+#endif // defined(ASIO_HAS_TCP_NOTSENT_LOWAT)
+}
+
+void test_endpoint_chars()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  asio::error_code ec;
+  char str[ip::tcp::endpoint::max_string_length];
+
+  const char* round_trip[] = { "1.2.3.4:80", "0.0.0.0:0",
+    "255.255.255.255:65535", "[::1]:443", "[::ffff:1.2.3.4]:8080" };
+  for (std::size_t i = 0; i < sizeof(round_trip) / sizeof(round_trip[0]); ++i)
+  {
+    const char* s = round_trip[i];
+    ip::tcp::endpoint ep;
+    const char* p = ip::from_chars(s, s + std::strlen(s), ep, ec);
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(p == s + std::strlen(s));
+    char* end = ip::to_chars(str, str + sizeof(str), ep, ec);
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(std::string(str, end) == s);
+  }
+
+  ip::tcp::endpoint ep1(ip::make_address("fe80::1%3"), 1);
+  const char input1[] = "[fe80::1%3]:1/path";
+  ip::tcp::endpoint ep2;
+  const char* p = ip::from_chars(input1, input1 + sizeof(input1) - 1, ep2, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(p == input1 + 13);
+  ASIO_CHECK(ep2 == ep1);
+
+  char* end = ip::to_chars(str, str + 5, ep1, ec);
+  ASIO_CHECK(ec == asio::error::no_buffer_space);
+  ASIO_CHECK(end == str);
+
+  const char* bad[] = { "", "1.2.3.4", "1.2.3.4:", "1.2.3.4:65536",
+    "::1:80", "[::1]", "[::1]80", "[1.2.3.4]:80", "1.2.3.4:x" };
+  for (std::size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); ++i)
+  {
+    p = ip::from_chars(bad[i], bad[i] + std::strlen(bad[i]), ep2, ec);
+    ASIO_CHECK(ec == asio::error::invalid_argument);
+    ASIO_CHECK(p == bad[i]);
+    ASIO_CHECK(ep2 == ep1);
+  }
+}
+
 } // namespace ip_tcp_runtime
 
 //------------------------------------------------------------------------------
@@ -290,6 +457,11 @@ void test()
     socket1.close();
     socket1.close(ec);
 
+    socket1.async_close(wait_handler());
+    socket1.async_close(immediate);
+    int i_close = socket1.async_close(lazy);
+    (void)i_close;
+
     socket1.release();
     socket1.release(ec);
 
@@ -348,6 +520,11 @@ void test()
     socket1.io_control(io_control_command);
     socket1.io_control(io_control_command, ec);
 
+    asio::transport_info info1 = socket1.get_transport_info();
+    (void)info1;
+    asio::transport_info info2 = socket1.get_transport_info(ec);
+    (void)info2;
+
     bool non_blocking1 = socket1.non_blocking();
     (void)non_blocking1;
     socket1.non_blocking(true);
@@ -371,6 +548,11 @@ void test()
     socket1.shutdown(socket_base::shutdown_both);
     socket1.shutdown(socket_base::shutdown_both, ec);
 
+    socket1.async_shutdown(socket_base::shutdown_both, wait_handler());
+    socket1.async_shutdown(socket_base::shutdown_both, immediate);
+    int i_shutdown = socket1.async_shutdown(socket_base::shutdown_send, lazy);
+    (void)i_shutdown;
+
     socket1.wait(socket_base::wait_read);
     socket1.wait(socket_base::wait_write, ec);
 
@@ -438,6 +620,36 @@ void test()
     int i13 = socket1.async_send(null_buffers(), in_flags, lazy);
     (void)i13;
 
+#if defined(ASIO_HAS_SOCKET_SEND_ALL)
+    socket1.async_send_all(buffer(mutable_char_buffer), send_handler());
+    socket1.async_send_all(buffer(const_char_buffer), send_handler());
+    socket1.async_send_all(mutable_buffers, send_handler());
+    socket1.async_send_all(const_buffers, send_handler());
+    socket1.async_send_all(buffer(mutable_char_buffer),
+        in_flags, send_handler());
+    socket1.async_send_all(const_buffers, in_flags, send_handler());
+    socket1.async_send_all(buffer(const_char_buffer), immediate);
+    socket1.async_send_all(const_buffers, in_flags, immediate);
+    int i28 = socket1.async_send_all(buffer(const_char_buffer), lazy);
+    (void)i28;
+    int i29 = socket1.async_send_all(const_buffers, in_flags, lazy);
+    (void)i29;
+#endif // defined(ASIO_HAS_SOCKET_SEND_ALL)
+
+#if defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+    socket1.async_receive_all(buffer(mutable_char_buffer), receive_handler());
+    socket1.async_receive_all(mutable_buffers, receive_handler());
+    socket1.async_receive_all(buffer(mutable_char_buffer),
+        in_flags, receive_handler());
+    socket1.async_receive_all(mutable_buffers, in_flags, receive_handler());
+    socket1.async_receive_all(buffer(mutable_char_buffer), immediate);
+    socket1.async_receive_all(mutable_buffers, in_flags, immediate);
+    int i30 = socket1.async_receive_all(buffer(mutable_char_buffer), lazy);
+    (void)i30;
+    int i31 = socket1.async_receive_all(mutable_buffers, in_flags, lazy);
+    (void)i31;
+#endif // defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+
     socket1.receive(buffer(mutable_char_buffer));
     socket1.receive(mutable_buffers);
     socket1.receive(null_buffers());
@@ -692,146 +904,1535 @@ void test()
   ASIO_CHECK(read_eof_completed);
 }
 
-} // namespace ip_tcp_socket_runtime
+void test_registered_files()
+{
+  using namespace std; // For memcmp.
+  using namespace asio;
+  namespace ip = asio::ip;
 
-//------------------------------------------------------------------------------
+  namespace bindns = std;
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
 
-// ip_tcp_acceptor_compile test
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-// The following test checks that all public member functions on the class
-// ip::tcp::acceptor compile and link correctly. Runtime failures are ignored.
+  // The table is smaller than the number of sockets, so that some sockets
+  // use their descriptors directly. The option is ignored by other backends.
+  io_context ioc(asio::config_from_string("io_uring.registered_files=2"));
 
-namespace ip_tcp_acceptor_compile {
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
 
-struct wait_handler
-{
-  wait_handler() {}
-  void operator()(const asio::error_code&) {}
-  wait_handler(wait_handler&&) {}
-private:
-  wait_handler(const wait_handler&);
-};
+  for (int i = 0; i < 3; ++i)
+  {
+    ip::tcp::socket client_side_socket(ioc);
+    ip::tcp::socket server_side_socket(ioc);
+
+    client_side_socket.connect(server_endpoint);
+    acceptor.accept(server_side_socket);
+
+    char read_buffer[sizeof(write_data)];
+    bool read_completed = false;
+    asio::async_read(client_side_socket,
+        asio::buffer(read_buffer),
+        bindns::bind(handle_read,
+          _1, _2, &read_completed));
+
+    bool write_completed = false;
+    asio::async_write(server_side_socket,
+        asio::buffer(write_data),
+        bindns::bind(handle_write,
+          _1, _2, &write_completed));
+
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(read_completed);
+    ASIO_CHECK(write_completed);
+    ASIO_CHECK(memcmp(read_buffer, write_data, sizeof(write_data)) == 0);
+
+    // Closing a socket must close the connection, even though the registered
+    // file table held a reference to it.
+    bool read_eof_completed = false;
+    asio::async_read(client_side_socket,
+        asio::buffer(read_buffer),
+        bindns::bind(handle_read_eof,
+          _1, _2, &read_eof_completed));
+
+    server_side_socket.close();
+
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(read_eof_completed);
+  }
+}
 
-struct accept_handler
+void test_ring_config()
 {
-  accept_handler() {}
-  void operator()(const asio::error_code&) {}
-  accept_handler(accept_handler&&) {}
-private:
-  accept_handler(const accept_handler&);
-};
+  using namespace std; // For memcmp.
+  using namespace asio;
+  namespace ip = asio::ip;
 
-struct move_accept_handler
-{
-  move_accept_handler() {}
-  void operator()(
-      const asio::error_code&, asio::ip::tcp::socket) {}
-  move_accept_handler(move_accept_handler&&) {}
-private:
-  move_accept_handler(const move_accept_handler&) {}
-};
+  namespace bindns = std;
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
 
-struct move_accept_ioc_handler
+  // Use a ring that is smaller than the number of outstanding operations, so
+  // that entries must be submitted early. The options are ignored by other
+  // backends.
+  io_context ioc(asio::config_from_string(
+        "io_uring.ring_size=4\n"
+        "io_uring.submit_batch_size=2\n"
+        "io_uring.adaptive_submit=1"));
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  enum { num_sockets = 8 };
+  ip::tcp::socket client_side_sockets[num_sockets] = {
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc),
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc),
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc),
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc) };
+  ip::tcp::socket server_side_sockets[num_sockets] = {
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc),
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc),
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc),
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc) };
+
+  char read_buffers[num_sockets][sizeof(write_data)];
+  bool read_completed[num_sockets];
+  bool write_completed[num_sockets];
+
+  for (int i = 0; i < num_sockets; ++i)
+  {
+    client_side_sockets[i].connect(server_endpoint);
+    acceptor.accept(server_side_sockets[i]);
+
+    read_completed[i] = false;
+    asio::async_read(client_side_sockets[i],
+        asio::buffer(read_buffers[i]),
+        bindns::bind(handle_read,
+          _1, _2, &read_completed[i]));
+  }
+
+  for (int i = 0; i < num_sockets; ++i)
+  {
+    write_completed[i] = false;
+    asio::async_write(server_side_sockets[i],
+        asio::buffer(write_data),
+        bindns::bind(handle_write,
+          _1, _2, &write_completed[i]));
+  }
+
+  ioc.run();
+
+  for (int i = 0; i < num_sockets; ++i)
+  {
+    ASIO_CHECK(read_completed[i]);
+    ASIO_CHECK(write_completed[i]);
+    ASIO_CHECK(memcmp(read_buffers[i], write_data, sizeof(write_data)) == 0);
+  }
+}
+
+class echo_round_trips
 {
-  move_accept_ioc_handler() {}
-  void operator()(const asio::error_code&,
-      asio::basic_stream_socket<asio::ip::tcp,
-        asio::io_context::executor_type>) {}
-  move_accept_ioc_handler(move_accept_handler&&) {}
+public:
+  echo_round_trips(asio::ip::tcp::socket& socket, int rounds, bool initiator)
+    : socket_(socket),
+      rounds_(rounds),
+      completed_(0),
+      initiator_(initiator),
+      failed_(false)
+  {
+    data_[0] = 'x';
+  }
+
+  void start()
+  {
+    if (initiator_)
+      write();
+    else
+      read();
+  }
+
+  int completed() const
+  {
+    return completed_;
+  }
+
+  bool failed() const
+  {
+    return failed_;
+  }
+
 private:
-  move_accept_ioc_handler(const move_accept_handler&) {}
+  void write()
+  {
+    asio::async_write(socket_, asio::buffer(data_),
+        [this](const asio::error_code& e, std::size_t)
+        {
+          if (e)
+            failed_ = true;
+          else if (initiator_ || completed_ < rounds_)
+            read();
+        });
+  }
+
+  void read()
+  {
+    asio::async_read(socket_, asio::buffer(data_),
+        [this](const asio::error_code& e, std::size_t)
+        {
+          if (e)
+            failed_ = true;
+          else if (++completed_ < rounds_ || !initiator_)
+            write();
+        });
+  }
+
+  asio::ip::tcp::socket& socket_;
+  char data_[1];
+  int rounds_;
+  int completed_;
+  bool initiator_;
+  bool failed_;
 };
 
-void test()
+void test_concurrent_reaping()
 {
   using namespace asio;
   namespace ip = asio::ip;
 
-  try
-  {
-    io_context ioc;
-    const io_context::executor_type ioc_ex = ioc.get_executor();
-    ip::tcp::socket peer_socket1(ioc);
-    asio::basic_stream_socket<ip::tcp,
-        io_context::executor_type> peer_socket2(ioc);
-    ip::tcp::endpoint peer_endpoint;
-    archetypes::settable_socket_option<void> settable_socket_option1;
-    archetypes::settable_socket_option<int> settable_socket_option2;
-    archetypes::settable_socket_option<double> settable_socket_option3;
-    archetypes::gettable_socket_option<void> gettable_socket_option1;
-    archetypes::gettable_socket_option<int> gettable_socket_option2;
-    archetypes::gettable_socket_option<double> gettable_socket_option3;
-    archetypes::io_control_command io_control_command;
-    archetypes::immediate_handler immediate;
-    archetypes::lazy_handler lazy;
-    asio::error_code ec;
+  // Idle threads reap completions while another thread waits in the task. The
+  // small batch returns the task to the scheduler after each completion. The
+  // options are ignored by other backends.
+  io_context ioc(asio::config_from_string(
+        "scheduler.concurrency_hint=4\n"
+        "io_uring.concurrent_reaping=1\n"
+        "io_uring.complete_batch_size=1"));
 
-    // basic_socket_acceptor constructors.
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
 
-    ip::tcp::acceptor acceptor1(ioc);
-    ip::tcp::acceptor acceptor2(ioc, ip::tcp::v4());
-    ip::tcp::acceptor acceptor3(ioc, ip::tcp::v6());
-    ip::tcp::acceptor acceptor4(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
-    ip::tcp::acceptor acceptor5(ioc, ip::tcp::endpoint(ip::tcp::v6(), 0));
-#if !defined(ASIO_WINDOWS_RUNTIME)
-    ip::tcp::acceptor::native_handle_type native_acceptor1
-      = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-    ip::tcp::acceptor acceptor6(ioc, ip::tcp::v4(), native_acceptor1);
-#endif // !defined(ASIO_WINDOWS_RUNTIME)
+  enum { num_pairs = 8, num_rounds = 200 };
+  std::vector<ip::tcp::socket> sockets;
+  for (int i = 0; i < num_pairs * 2; ++i)
+    sockets.push_back(ip::tcp::socket(ioc));
 
-    ip::tcp::acceptor acceptor7(ioc_ex);
-    ip::tcp::acceptor acceptor8(ioc_ex, ip::tcp::v4());
-    ip::tcp::acceptor acceptor9(ioc_ex, ip::tcp::v6());
-    ip::tcp::acceptor acceptor10(ioc_ex, ip::tcp::endpoint(ip::tcp::v4(), 0));
-    ip::tcp::acceptor acceptor11(ioc_ex, ip::tcp::endpoint(ip::tcp::v6(), 0));
-#if !defined(ASIO_WINDOWS_RUNTIME)
-    ip::tcp::acceptor::native_handle_type native_acceptor2
-      = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-    ip::tcp::acceptor acceptor12(ioc_ex, ip::tcp::v4(), native_acceptor2);
-#endif // !defined(ASIO_WINDOWS_RUNTIME)
+  std::vector<echo_round_trips> echoes;
+  for (int i = 0; i < num_pairs; ++i)
+  {
+    sockets[i * 2].connect(server_endpoint);
+    acceptor.accept(sockets[i * 2 + 1]);
+    echoes.push_back(echo_round_trips(sockets[i * 2], num_rounds, true));
+    echoes.push_back(echo_round_trips(sockets[i * 2 + 1], num_rounds, false));
+  }
 
-    ip::tcp::acceptor acceptor13(std::move(acceptor5));
+  for (std::size_t i = 0; i < echoes.size(); ++i)
+    echoes[i].start();
 
-    // basic_socket_acceptor operators.
+  asio::thread t1([&ioc]{ ioc.run(); });
+  asio::thread t2([&ioc]{ ioc.run(); });
+  asio::thread t3([&ioc]{ ioc.run(); });
+  ioc.run();
+  t1.join();
+  t2.join();
+  t3.join();
 
-    acceptor1 = ip::tcp::acceptor(ioc);
-    acceptor1 = std::move(acceptor2);
+  for (std::size_t i = 0; i < echoes.size(); ++i)
+  {
+    ASIO_CHECK(!echoes[i].failed());
+    ASIO_CHECK(echoes[i].completed() == num_rounds);
+  }
+}
 
-    // I/O object functions.
+#if defined(ASIO_HAS_SOCKET_SEND_ALL)
 
-    ip::tcp::acceptor::executor_type ex = acceptor1.get_executor();
-    (void)ex;
+void handle_transfer_all(const asio::error_code& err,
+    size_t bytes_transferred, size_t expected_bytes_transferred, bool* called)
+{
+  *called = true;
+  ASIO_CHECK(!err);
+  ASIO_CHECK(bytes_transferred == expected_bytes_transferred);
+}
 
-    // basic_socket_acceptor functions.
+#endif // defined(ASIO_HAS_SOCKET_SEND_ALL)
 
-    acceptor1.open(ip::tcp::v4());
-    acceptor1.open(ip::tcp::v6());
-    acceptor1.open(ip::tcp::v4(), ec);
-    acceptor1.open(ip::tcp::v6(), ec);
+void test_transport_info()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
 
-#if !defined(ASIO_WINDOWS_RUNTIME)
-    ip::tcp::acceptor::native_handle_type native_acceptor3
-      = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-    acceptor1.assign(ip::tcp::v4(), native_acceptor3);
-    ip::tcp::acceptor::native_handle_type native_acceptor4
-      = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-    acceptor1.assign(ip::tcp::v4(), native_acceptor4, ec);
-#endif // !defined(ASIO_WINDOWS_RUNTIME)
+  io_context ioc;
+  asio::error_code ec;
 
-    bool is_open = acceptor1.is_open();
-    (void)is_open;
+  ip::tcp::socket closed_socket(ioc);
+  transport_info info = closed_socket.get_transport_info(ec);
+  ASIO_CHECK(ec == asio::error::bad_descriptor);
+  ASIO_CHECK(info.congestion_window == 0);
 
-    acceptor1.close();
-    acceptor1.close(ec);
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
 
-    acceptor1.release();
-    acceptor1.release(ec);
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
 
-    ip::tcp::acceptor::native_handle_type native_acceptor5
-      = acceptor1.native_handle();
-    (void)native_acceptor5;
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
 
-    acceptor1.cancel();
+  char data[1024] = "";
+  asio::write(client_side_socket, asio::buffer(data));
+  asio::read(server_side_socket, asio::buffer(data));
+
+  info = client_side_socket.get_transport_info(ec);
+#if defined(__linux__)
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(info.rtt.count() > 0);
+  ASIO_CHECK(info.congestion_window > 0);
+  ASIO_CHECK(info.retransmits == 0);
+#else // defined(__linux__)
+  ASIO_CHECK(!ec || ec == asio::error::operation_not_supported);
+#endif // defined(__linux__)
+}
+
+void test_send_all()
+{
+#if defined(ASIO_HAS_SOCKET_SEND_ALL)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  namespace bindns = std;
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
+
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  // Use a small send buffer so that the data cannot be sent at once.
+  server_side_socket.set_option(socket_base::send_buffer_size(4096));
+
+  enum { num_buffers = 4, buffer_length = 256 * 1024 };
+  std::vector<std::vector<char> > send_data(num_buffers);
+  std::vector<const_buffer> send_buffers;
+  for (int i = 0; i < num_buffers; ++i)
+  {
+    send_data[i].resize(buffer_length);
+    for (std::size_t j = 0; j < send_data[i].size(); ++j)
+      send_data[i][j] = static_cast<char>('a' + (i * 7 + j) % 26);
+    send_buffers.push_back(asio::buffer(send_data[i]));
+  }
+
+  std::vector<char> received(num_buffers * buffer_length);
+
+  bool send_completed = false;
+  server_side_socket.async_send_all(send_buffers,
+      bindns::bind(handle_transfer_all, _1, _2,
+        received.size(), &send_completed));
+
+  bool read_completed = false;
+  asio::async_read(client_side_socket,
+      asio::buffer(received),
+      bindns::bind(handle_transfer_all, _1, _2,
+        received.size(), &read_completed));
+
+  ioc.run();
+
+  ASIO_CHECK(send_completed);
+  ASIO_CHECK(read_completed);
+  bool data_matches = true;
+  for (int i = 0; i < num_buffers; ++i)
+    for (std::size_t j = 0; j < send_data[i].size(); ++j)
+      if (received[i * buffer_length + j] != send_data[i][j])
+        data_matches = false;
+  ASIO_CHECK(data_matches);
+
+  // A composed write that transfers all of the data uses the same operation.
+  std::fill(received.begin(), received.end(), 0);
+
+  bool write_completed = false;
+  asio::async_write(server_side_socket, send_buffers,
+      bindns::bind(handle_transfer_all, _1, _2,
+        received.size(), &write_completed));
+
+  read_completed = false;
+  asio::async_read(client_side_socket,
+      asio::buffer(received),
+      bindns::bind(handle_transfer_all, _1, _2,
+        received.size(), &read_completed));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(write_completed);
+  ASIO_CHECK(read_completed);
+  data_matches = true;
+  for (int i = 0; i < num_buffers; ++i)
+    for (std::size_t j = 0; j < send_data[i].size(); ++j)
+      if (received[i * buffer_length + j] != send_data[i][j])
+        data_matches = false;
+  ASIO_CHECK(data_matches);
+
+  // Sending an empty buffer sequence completes immediately.
+  send_completed = false;
+  server_side_socket.async_send_all(asio::const_buffer(),
+      bindns::bind(handle_transfer_all, _1, _2, 0, &send_completed));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(send_completed);
+#endif // defined(ASIO_HAS_SOCKET_SEND_ALL)
+}
+
+void test_receive_all()
+{
+#if defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
+
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  // Use a small receive buffer so that the data cannot be received at once.
+  server_side_socket.set_option(socket_base::receive_buffer_size(4096));
+
+  enum { num_buffers = 4, buffer_length = 256 * 1024 };
+  std::vector<char> send_data(num_buffers * buffer_length);
+  for (std::size_t i = 0; i < send_data.size(); ++i)
+    send_data[i] = static_cast<char>('a' + i % 26);
+
+  std::vector<std::vector<char> > received(num_buffers);
+  std::vector<mutable_buffer> receive_buffers;
+  for (int i = 0; i < num_buffers; ++i)
+  {
+    received[i].resize(buffer_length);
+    receive_buffers.push_back(asio::buffer(received[i]));
+  }
+
+  std::size_t completions = 0;
+  asio::error_code receive_ec;
+  std::size_t bytes_received = 0;
+  server_side_socket.async_receive_all(receive_buffers,
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        ++completions;
+        receive_ec = e;
+        bytes_received = n;
+      });
+
+  asio::error_code write_ec;
+  asio::async_write(client_side_socket, asio::buffer(send_data),
+      [&](const asio::error_code& e, std::size_t)
+      {
+        write_ec = e;
+      });
+
+  ioc.run();
+
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(!receive_ec);
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(bytes_received == send_data.size());
+  bool data_matches = true;
+  for (int i = 0; i < num_buffers; ++i)
+    for (std::size_t j = 0; j < received[i].size(); ++j)
+      if (received[i][j] != send_data[i * buffer_length + j])
+        data_matches = false;
+  ASIO_CHECK(data_matches);
+
+  // A composed read that transfers all of the data uses the same operation.
+  for (int i = 0; i < num_buffers; ++i)
+    std::fill(received[i].begin(), received[i].end(), 0);
+
+  completions = 0;
+  asio::async_read(server_side_socket, receive_buffers,
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        ++completions;
+        receive_ec = e;
+        bytes_received = n;
+      });
+
+  asio::async_write(client_side_socket, asio::buffer(send_data),
+      [&](const asio::error_code& e, std::size_t)
+      {
+        write_ec = e;
+      });
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(!receive_ec);
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(bytes_received == send_data.size());
+  data_matches = true;
+  for (int i = 0; i < num_buffers; ++i)
+    for (std::size_t j = 0; j < received[i].size(); ++j)
+      if (received[i][j] != send_data[i * buffer_length + j])
+        data_matches = false;
+  ASIO_CHECK(data_matches);
+
+#if !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  // Data held in the read-ahead buffer is received first.
+  server_side_socket.set_option(socket_base::read_ahead(4096));
+
+  enum { header_length = 10, body_length = 1000 };
+  asio::write(client_side_socket,
+      asio::buffer(send_data, header_length + body_length));
+
+  char header[header_length];
+  asio::read(server_side_socket, asio::buffer(header));
+  ASIO_CHECK(memcmp(header, &send_data[0], header_length) == 0);
+
+  char body[body_length];
+  completions = 0;
+  server_side_socket.async_receive_all(asio::buffer(body),
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        ++completions;
+        receive_ec = e;
+        bytes_received = n;
+      });
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(!receive_ec);
+  ASIO_CHECK(bytes_received == body_length);
+  ASIO_CHECK(memcmp(body, &send_data[header_length], body_length) == 0);
+
+  server_side_socket.set_option(socket_base::read_ahead(0));
+#endif // !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
+  // Closing the connection before the buffers are filled completes the
+  // operation with the data received so far.
+  enum { partial_length = 100 };
+  asio::write(client_side_socket, asio::buffer(send_data, partial_length));
+  client_side_socket.shutdown(ip::tcp::socket::shutdown_send);
+
+  completions = 0;
+  server_side_socket.async_receive_all(receive_buffers,
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        ++completions;
+        receive_ec = e;
+        bytes_received = n;
+      });
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(receive_ec == asio::error::eof);
+  ASIO_CHECK(bytes_received == partial_length);
+  ASIO_CHECK(memcmp(&received[0][0], &send_data[0], partial_length) == 0);
+#endif // defined(ASIO_HAS_SOCKET_RECEIVE_ALL)
+}
+
+void test_read_ahead()
+{
+#if !defined(ASIO_HAS_IOCP) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
+
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  server_side_socket.set_option(socket_base::read_ahead(4096));
+
+  enum { data_length = 1000, read_length = 10 };
+  char send_data[data_length];
+  for (std::size_t i = 0; i < sizeof(send_data); ++i)
+    send_data[i] = static_cast<char>('a' + i % 26);
+  asio::write(client_side_socket, asio::buffer(send_data));
+
+  // The first receive drains the socket into the read-ahead buffer.
+  char read_data[data_length];
+  std::size_t total = server_side_socket.read_some(
+      asio::buffer(read_data, read_length));
+  ASIO_CHECK(total == read_length);
+  ASIO_CHECK(server_side_socket.available() == data_length - read_length);
+
+  // The remaining data is served from the read-ahead buffer.
+  bool data_matches = true;
+  std::size_t completions = 0;
+  asio::error_code read_ec;
+  std::function<void(const asio::error_code&, std::size_t)> handler =
+    [&](const asio::error_code& e, std::size_t n)
+    {
+      ++completions;
+      read_ec = e;
+      total += n;
+      if (!e && total < data_length)
+      {
+        server_side_socket.async_read_some(
+            asio::buffer(read_data + total, read_length), handler);
+      }
+    };
+  server_side_socket.async_read_some(
+      asio::buffer(read_data + total, read_length), handler);
+  ioc.run();
+
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(total == data_length);
+  ASIO_CHECK(completions == data_length / read_length - 1);
+  ASIO_CHECK(server_side_socket.available() == 0);
+  for (std::size_t i = 0; i < sizeof(send_data); ++i)
+    if (read_data[i] != send_data[i])
+      data_matches = false;
+  ASIO_CHECK(data_matches);
+
+  // A wait for readability completes immediately when data is buffered.
+  asio::write(client_side_socket, asio::buffer(send_data, 2 * read_length));
+  ASIO_CHECK(server_side_socket.read_some(
+        asio::buffer(read_data, read_length)) == read_length);
+  bool wait_completed = false;
+  server_side_socket.async_wait(socket_base::wait_read,
+      [&](const asio::error_code& e)
+      {
+        wait_completed = !e;
+      });
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(wait_completed);
+
+  // The buffered data is kept when the buffer is resized, but the buffer may
+  // not be shrunk below the amount of data it holds.
+  asio::error_code ec;
+  server_side_socket.set_option(socket_base::read_ahead(1), ec);
+  ASIO_CHECK(ec == asio::error::invalid_argument);
+  server_side_socket.set_option(socket_base::read_ahead(read_length));
+  ASIO_CHECK(server_side_socket.available() == read_length);
+  std::memset(read_data, 0, sizeof(read_data));
+  ASIO_CHECK(server_side_socket.read_some(
+        asio::buffer(read_data)) == read_length);
+  ASIO_CHECK(std::memcmp(read_data,
+        send_data + read_length, read_length) == 0);
+
+  // The end of the stream is reported once the buffered data is consumed.
+  client_side_socket.shutdown(ip::tcp::socket::shutdown_send);
+  read_ec = asio::error_code();
+  total = 0;
+  server_side_socket.async_read_some(asio::buffer(read_data),
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        read_ec = e;
+        total = n;
+      });
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(read_ec == asio::error::eof);
+  ASIO_CHECK(total == 0);
+#endif // !defined(ASIO_HAS_IOCP)
+       //   && !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+}
+
+void test_write_coalescing()
+{
+#if defined(ASIO_HAS_SOCKET_SEND_ALL)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
+
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  server_side_socket.set_option(socket_base::write_coalescing(true));
+
+  // Small writes issued together each complete individually, in order.
+  const char* messages[] = { "header", "body", "x", "trailer" };
+  enum { num_messages = sizeof(messages) / sizeof(messages[0]) };
+  std::vector<int> completed;
+  for (int i = 0; i < num_messages; ++i)
+  {
+    std::size_t length = std::strlen(messages[i]);
+    asio::async_write(server_side_socket,
+        asio::buffer(messages[i], length),
+        [&completed, i, length](const asio::error_code& e, std::size_t n)
+        {
+          ASIO_CHECK(!e);
+          ASIO_CHECK(n == length);
+          completed.push_back(i);
+        });
+  }
+
+  ioc.run();
+
+  ASIO_CHECK(completed.size() == num_messages);
+  bool in_order = true;
+  for (std::size_t i = 0; i < completed.size(); ++i)
+    if (completed[i] != static_cast<int>(i))
+      in_order = false;
+  ASIO_CHECK(in_order);
+
+  const char expected[] = "headerbodyxtrailer";
+  char received[sizeof(expected) - 1];
+  asio::read(client_side_socket, asio::buffer(received));
+  ASIO_CHECK(std::memcmp(received, expected, sizeof(received)) == 0);
+
+  // Large writes that cannot be sent at once keep their order.
+  server_side_socket.set_option(socket_base::send_buffer_size(4096));
+
+  enum { num_buffers = 4, buffer_length = 256 * 1024 };
+  std::vector<std::vector<char> > send_data(num_buffers);
+  std::size_t write_count = 0;
+  for (int i = 0; i < num_buffers; ++i)
+  {
+    send_data[i].resize(buffer_length);
+    for (std::size_t j = 0; j < send_data[i].size(); ++j)
+      send_data[i][j] = static_cast<char>('a' + (i * 7 + j) % 26);
+    asio::async_write(server_side_socket, asio::buffer(send_data[i]),
+        [&write_count](const asio::error_code& e, std::size_t n)
+        {
+          ASIO_CHECK(!e);
+          ASIO_CHECK(n == buffer_length);
+          ++write_count;
+        });
+  }
+
+  std::vector<char> large_received(num_buffers * buffer_length);
+  bool read_completed = false;
+  asio::async_read(client_side_socket, asio::buffer(large_received),
+      [&read_completed](const asio::error_code& e, std::size_t)
+      {
+        read_completed = !e;
+      });
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(write_count == num_buffers);
+  ASIO_CHECK(read_completed);
+  bool data_matches = true;
+  for (int i = 0; i < num_buffers; ++i)
+    for (std::size_t j = 0; j < send_data[i].size(); ++j)
+      if (large_received[i * buffer_length + j] != send_data[i][j])
+        data_matches = false;
+  ASIO_CHECK(data_matches);
+#endif // defined(ASIO_HAS_SOCKET_SEND_ALL)
+}
+
+void test_fixed_size_buffer_sequences()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  // Sequences with a length known at compile time need no more native
+  // buffers than they have elements.
+  ASIO_CHECK(sizeof(detail::buffer_sequence_adapter<const_buffer,
+        std::array<const_buffer, 3> >)
+      < sizeof(detail::buffer_sequence_adapter<const_buffer,
+        std::vector<const_buffer> >));
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
+
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  const char header[] = "header";
+  const char body[] = "body";
+  const char trailer[] = "trailer";
+  std::array<const_buffer, 3> gather = { {
+    asio::buffer(header, 6), asio::buffer(body, 4),
+    asio::buffer(trailer, 7) } };
+  ASIO_CHECK(client_side_socket.send(gather) == 17);
+
+  char received[17];
+  std::array<mutable_buffer, 3> scatter = { {
+    asio::buffer(received, 5), asio::buffer(received + 5, 5),
+    asio::buffer(received + 10, 7) } };
+  ASIO_CHECK(asio::read(server_side_socket, scatter) == 17);
+  ASIO_CHECK(std::memcmp(received, "headerbodytrailer", 17) == 0);
+
+  // A composed write passes parts of the sequence to each send.
+  std::array<const_buffer, 5> parts = { {
+    asio::buffer(header, 6), asio::buffer(body, 4),
+    asio::buffer(trailer, 7), asio::buffer(body, 4),
+    asio::buffer(header, 6) } };
+  std::size_t written = 0;
+  asio::async_write(client_side_socket, parts,
+      [&written](const asio::error_code& e, std::size_t n)
+      {
+        ASIO_CHECK(!e);
+        written = n;
+      });
+  ioc.run();
+  ASIO_CHECK(written == 27);
+
+  char received2[27];
+  asio::read(server_side_socket, asio::buffer(received2));
+  ASIO_CHECK(std::memcmp(received2,
+        "headerbodytrailerbodyheader", 27) == 0);
+}
+
+template <typename T>
+class counting_allocator
+{
+public:
+  typedef T value_type;
+
+  explicit counting_allocator(int* count)
+    : count_(count)
+  {
+  }
+
+  template <typename U>
+  counting_allocator(const counting_allocator<U>& other)
+    : count_(other.count_)
+  {
+  }
+
+  T* allocate(std::size_t n)
+  {
+    ++*count_;
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n)
+  {
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  friend bool operator==(const counting_allocator& a,
+      const counting_allocator& b)
+  {
+    return a.count_ == b.count_;
+  }
+
+  friend bool operator!=(const counting_allocator& a,
+      const counting_allocator& b)
+  {
+    return a.count_ != b.count_;
+  }
+
+private:
+  template <typename> friend class counting_allocator;
+  int* count_;
+};
+
+void test_operation_slots()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
+
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  client_side_socket.set_option(socket_base::operation_slots(true));
+  server_side_socket.set_option(socket_base::operation_slots(true));
+
+  // Exchange messages using operations with a variety of handler types, so
+  // that each slot is reused by operations of differing sizes.
+  enum { rounds = 100 };
+  char client_buffer[64];
+  char server_buffer[64];
+  int exchanged = 0;
+  std::function<void()> next_round = [&]()
+  {
+    if (exchanged == rounds)
+      return;
+
+    std::string large_capture(exchanged, 'x');
+    client_side_socket.async_send(buffer("ping", 4),
+        [large_capture](const asio::error_code& e, std::size_t n)
+        {
+          ASIO_CHECK(!e);
+          ASIO_CHECK(n == 4);
+        });
+    asio::async_read(server_side_socket, buffer(server_buffer, 4),
+        [&](const asio::error_code& e, std::size_t n)
+        {
+          ASIO_CHECK(!e);
+          ASIO_CHECK(n == 4);
+          asio::async_write(server_side_socket, buffer(server_buffer, 4),
+              [](const asio::error_code& e, std::size_t)
+              {
+                ASIO_CHECK(!e);
+              });
+          client_side_socket.async_receive(buffer(client_buffer),
+              [&](const asio::error_code& e, std::size_t n)
+              {
+                ASIO_CHECK(!e);
+                ASIO_CHECK(n == 4);
+                ASIO_CHECK(std::memcmp(client_buffer, "ping", 4) == 0);
+                ++exchanged;
+                next_round();
+              });
+        });
+  };
+
+  next_round();
+  ioc.run();
+  ASIO_CHECK(exchanged == rounds);
+
+  // Handlers with an associated allocator continue to use it.
+  int allocations = 0;
+  client_side_socket.async_send(buffer("pong", 4),
+      bind_allocator(counting_allocator<void>(&allocations),
+        [](const asio::error_code& e, std::size_t)
+        {
+          ASIO_CHECK(!e);
+        }));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(allocations == 1);
+
+  // Operations that are outstanding when the socket is closed may still
+  // return their memory.
+  bool aborted = false;
+  server_side_socket.async_receive(buffer(server_buffer),
+      [&](const asio::error_code&, std::size_t)
+      {
+        aborted = true;
+      });
+  client_side_socket.async_receive(buffer(client_buffer),
+      [&](const asio::error_code& e, std::size_t)
+      {
+        ASIO_CHECK(e == asio::error::operation_aborted);
+      });
+  client_side_socket.close();
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(aborted);
+}
+
+void test_transfer()
+{
+#if !defined(ASIO_HAS_IOCP) && !defined(ASIO_WINDOWS_RUNTIME)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc1;
+  io_context ioc2;
+
+  ip::tcp::acceptor acceptor(ioc1, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_socket(ioc1);
+  ip::tcp::socket server_side_socket(ioc1);
+
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  server_side_socket.non_blocking(true);
+#if !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  server_side_socket.set_option(socket_base::read_ahead(4096));
+#endif // !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
+  enum { data_length = 100, read_length = 10 };
+  char send_data[data_length];
+  for (std::size_t i = 0; i < sizeof(send_data); ++i)
+    send_data[i] = static_cast<char>('a' + i % 26);
+  asio::write(client_side_socket, asio::buffer(send_data));
+
+  char read_data[data_length];
+  std::size_t total = 0;
+  while (total < read_length)
+  {
+    asio::error_code e;
+    total += server_side_socket.read_some(
+        asio::buffer(read_data + total, read_length - total), e);
+    ASIO_CHECK(!e || e == asio::error::would_block);
+  }
+
+  // An operation outstanding on the source socket is cancelled by the move.
+  asio::error_code wait_ec;
+  server_side_socket.async_wait(socket_base::wait_error,
+      [&](const asio::error_code& e)
+      {
+        wait_ec = e;
+      });
+
+  ip::tcp::socket moved_socket(ioc2, std::move(server_side_socket));
+  ASIO_CHECK(!server_side_socket.is_open());
+  ASIO_CHECK(moved_socket.is_open());
+  ASIO_CHECK(moved_socket.non_blocking());
+  ASIO_CHECK(&query(moved_socket.get_executor(), execution::context) == &ioc2);
+
+  ioc1.run();
+  ASIO_CHECK(wait_ec == asio::error::operation_aborted);
+
+  // The data that was pending before the move is delivered on the target
+  // context, including any that was already buffered.
+  asio::error_code read_ec;
+  asio::async_read(moved_socket,
+      asio::buffer(read_data + total, data_length - total),
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        read_ec = e;
+        total += n;
+      });
+  ioc2.run();
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(total == data_length);
+  ASIO_CHECK(std::memcmp(read_data, send_data, data_length) == 0);
+
+  // A closed socket may be moved, as may a socket within its own context.
+  ip::tcp::socket closed_socket(ioc2, std::move(server_side_socket));
+  ASIO_CHECK(!closed_socket.is_open());
+  ip::tcp::socket same_socket(ioc2.get_executor(), std::move(moved_socket));
+  ASIO_CHECK(same_socket.is_open());
+  ASIO_CHECK(same_socket.remote_endpoint()
+      == client_side_socket.local_endpoint());
+#endif // !defined(ASIO_HAS_IOCP) && !defined(ASIO_WINDOWS_RUNTIME)
+}
+
+void test_fork_child()
+{
+#if !defined(ASIO_HAS_IOCP) && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  enum { num_sockets = 3 };
+  ip::tcp::socket client_side_sockets[num_sockets] = {
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc), ip::tcp::socket(ioc) };
+  ip::tcp::socket server_side_sockets[num_sockets] = {
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc), ip::tcp::socket(ioc) };
+
+  char read_data[num_sockets][sizeof(write_data)];
+  std::size_t read_length[num_sockets] = { 0, 0, 0 };
+  asio::error_code read_ec[num_sockets];
+
+  // Make every socket wait in the reactor once, so that it is registered.
+  for (int i = 0; i < num_sockets; ++i)
+  {
+    client_side_sockets[i].connect(server_endpoint);
+    acceptor.accept(server_side_sockets[i]);
+    client_side_sockets[i].async_wait(socket_base::wait_write,
+        [](const asio::error_code&){});
+    server_side_sockets[i].async_wait(socket_base::wait_error,
+        [](const asio::error_code&){});
+    server_side_sockets[i].cancel();
+  }
+  ioc.run();
+  ioc.restart();
+
+  // Only the first socket has an operation outstanding across the fork.
+  asio::async_read(server_side_sockets[0], asio::buffer(read_data[0]),
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        read_ec[0] = e;
+        read_length[0] = n;
+      });
+  ioc.poll();
+  ioc.restart();
+
+  ioc.notify_fork(asio::execution_context::fork_child);
+
+  // A child may close descriptors that it does not use.
+  server_side_sockets[2].close();
+
+  asio::async_read(server_side_sockets[1], asio::buffer(read_data[1]),
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        read_ec[1] = e;
+        read_length[1] = n;
+      });
+  ioc.poll();
+  ioc.restart();
+  ASIO_CHECK(read_length[0] == 0);
+  ASIO_CHECK(read_length[1] == 0);
+
+  asio::write(client_side_sockets[0], asio::buffer(write_data));
+  asio::write(client_side_sockets[1], asio::buffer(write_data));
+  ioc.run();
+
+  for (int i = 0; i < 2; ++i)
+  {
+    ASIO_CHECK(!read_ec[i]);
+    ASIO_CHECK(read_length[i] == sizeof(write_data));
+    ASIO_CHECK(std::memcmp(read_data[i], write_data, sizeof(write_data)) == 0);
+  }
+#endif // !defined(ASIO_HAS_IOCP) && !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+}
+
+void test_wait_peer_closed()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
+
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  bool closed = false;
+  asio::error_code closed_ec;
+  server_side_socket.async_wait(socket_base::wait_peer_closed,
+      [&](const asio::error_code& e)
+      {
+        closed = true;
+        closed_ec = e;
+      });
+
+#if defined(ASIO_HAS_EPOLL) && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  char read_data[sizeof(write_data)];
+  std::size_t read_length = 0;
+  asio::async_read(server_side_socket, asio::buffer(read_data),
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        ASIO_CHECK(!e);
+        read_length = n;
+      });
+
+  // Incoming data completes the read but not the wait.
+  asio::write(client_side_socket, asio::buffer(write_data));
+  while (read_length == 0)
+    ioc.run_one();
+  ioc.poll();
+  ASIO_CHECK(read_length == sizeof(write_data));
+  ASIO_CHECK(!closed);
+
+  client_side_socket.close();
+  ioc.run();
+  ASIO_CHECK(closed);
+  ASIO_CHECK(!closed_ec);
+
+  asio::error_code ec;
+  server_side_socket.wait(socket_base::wait_peer_closed, ec);
+  ASIO_CHECK(!ec);
+#elif !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  ioc.run();
+  ASIO_CHECK(closed);
+  ASIO_CHECK(closed_ec == asio::error::operation_not_supported);
+#else // !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  client_side_socket.close();
+  ioc.run();
+  ASIO_CHECK(closed);
+#endif // !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+}
+
+void test_async_close()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  const int num_sockets = 16;
+  ip::tcp::socket client_side_sockets[num_sockets] = {
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc), ip::tcp::socket(ioc),
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc), ip::tcp::socket(ioc),
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc), ip::tcp::socket(ioc),
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc), ip::tcp::socket(ioc),
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc), ip::tcp::socket(ioc),
+    ip::tcp::socket(ioc) };
+  ip::tcp::socket server_side_sockets[num_sockets] = {
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc), ip::tcp::socket(ioc),
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc), ip::tcp::socket(ioc),
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc), ip::tcp::socket(ioc),
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc), ip::tcp::socket(ioc),
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc), ip::tcp::socket(ioc),
+    ip::tcp::socket(ioc) };
+
+  for (int i = 0; i < num_sockets; ++i)
+  {
+    client_side_sockets[i].connect(server_endpoint);
+    acceptor.accept(server_side_sockets[i]);
+  }
+
+  // Shutting down the sending side is seen by the peer as the end of the
+  // stream.
+  int shutdowns = 0;
+  client_side_sockets[0].async_shutdown(socket_base::shutdown_send,
+      [&](const asio::error_code& e)
+      {
+        ASIO_CHECK(!e);
+        ++shutdowns;
+      });
+
+  char read_data[16];
+  int eofs = 0;
+  asio::async_read(server_side_sockets[0], asio::buffer(read_data),
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        ASIO_CHECK(e == asio::error::eof);
+        ASIO_CHECK(n == 0);
+        ++eofs;
+      });
+
+  ioc.run();
+  ioc.restart();
+  ASIO_CHECK(shutdowns == 1);
+  ASIO_CHECK(eofs == 1);
+
+  // Closing the server side sockets cancels their outstanding operations, and
+  // each peer then sees the end of the stream.
+  int aborted = 0;
+  int closes = 0;
+  for (int i = 0; i < num_sockets; ++i)
+  {
+    if (i > 0)
+    {
+      server_side_sockets[i].async_receive(asio::buffer(read_data),
+          [&](const asio::error_code& e, std::size_t)
+          {
+            ASIO_CHECK(e == asio::error::operation_aborted);
+            ++aborted;
+          });
+    }
+
+    server_side_sockets[i].async_close(
+        [&](const asio::error_code& e)
+        {
+          ASIO_CHECK(!e);
+          ++closes;
+        });
+    ASIO_CHECK(!server_side_sockets[i].is_open());
+
+    asio::async_read(client_side_sockets[i], asio::buffer(read_data),
+        [&](const asio::error_code& e, std::size_t)
+        {
+          ASIO_CHECK(e == asio::error::eof);
+          ++eofs;
+        });
+  }
+
+  ioc.run();
+  ioc.restart();
+  ASIO_CHECK(aborted == num_sockets - 1);
+  ASIO_CHECK(closes == num_sockets);
+  ASIO_CHECK(eofs == num_sockets + 1);
+
+  // Closing a socket that is not open succeeds.
+  server_side_sockets[0].async_close(
+      [&](const asio::error_code& e)
+      {
+        ASIO_CHECK(!e);
+        ++closes;
+      });
+
+  // A socket that is pending close may be reopened straight away.
+  client_side_sockets[0].async_close(
+      [&](const asio::error_code& e)
+      {
+        ASIO_CHECK(!e);
+        ++closes;
+      });
+  client_side_sockets[0].connect(server_endpoint);
+  acceptor.accept(server_side_sockets[0]);
+
+  ioc.run();
+  ASIO_CHECK(closes == num_sockets + 2);
+  ASIO_CHECK(client_side_sockets[0].is_open());
+}
+
+void test_cancel_after()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  // When io_uring is the default backend, cancel_after is applied to sends
+  // and receives by linking a timeout to the operation's submission.
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
+
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  // A receive for which no data arrives is cancelled at the deadline.
+  char read_data[16];
+  asio::error_code read_ec;
+  std::size_t read_bytes = 1;
+  server_side_socket.async_receive(asio::buffer(read_data),
+      cancel_after(chrono::milliseconds(50),
+        [&](const asio::error_code& e, std::size_t n)
+        {
+          read_ec = e;
+          read_bytes = n;
+        }));
+  ioc.run();
+  ioc.restart();
+  ASIO_CHECK(read_ec == asio::error::operation_aborted);
+  ASIO_CHECK(read_bytes == 0);
+
+  // Operations that finish before the deadline complete normally.
+  const char write_data[] = "hello";
+  asio::error_code write_ec = asio::error::would_block;
+  std::size_t write_bytes = 0;
+  client_side_socket.async_send(asio::buffer(write_data, 5),
+      cancel_after(chrono::seconds(10),
+        [&](const asio::error_code& e, std::size_t n)
+        {
+          write_ec = e;
+          write_bytes = n;
+        }));
+  read_ec = asio::error::would_block;
+  server_side_socket.async_receive(asio::buffer(read_data),
+      cancel_after(chrono::seconds(10),
+        [&](const asio::error_code& e, std::size_t n)
+        {
+          read_ec = e;
+          read_bytes = n;
+        }));
+  ioc.run();
+  ioc.restart();
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(write_bytes == 5);
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(read_bytes == 5);
+  ASIO_CHECK(std::memcmp(read_data, write_data, 5) == 0);
+
+  // A zero-copy send is a multishot submission that remains outstanding
+  // until the kernel has released the buffers. A send that is queued behind
+  // it has no submission of its own to which a timeout could be linked, and
+  // so is cancelled using a timer instead.
+  client_side_socket.set_option(socket_base::zero_copy(true));
+  std::vector<char> zero_copy_data(16 * 1024, 'z');
+  asio::error_code zero_copy_ec = asio::error::would_block;
+  std::size_t zero_copy_bytes = 0;
+  client_side_socket.async_send(asio::buffer(zero_copy_data),
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        zero_copy_ec = e;
+        zero_copy_bytes = n;
+      });
+  write_ec = asio::error::would_block;
+  client_side_socket.async_send(asio::buffer(write_data, 5),
+      cancel_after(chrono::seconds(10),
+        [&](const asio::error_code& e, std::size_t n)
+        {
+          write_ec = e;
+          write_bytes = n;
+        }));
+  ioc.run();
+  ASIO_CHECK(!zero_copy_ec);
+  ASIO_CHECK(zero_copy_bytes == zero_copy_data.size());
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(write_bytes == 5);
+
+  std::vector<char> received(zero_copy_data.size() + 5);
+  asio::read(server_side_socket, asio::buffer(received));
+  ASIO_CHECK(std::equal(zero_copy_data.begin(),
+        zero_copy_data.end(), received.begin()));
+  ASIO_CHECK(std::memcmp(&received[zero_copy_data.size()],
+        write_data, 5) == 0);
+}
+
+} // namespace ip_tcp_socket_runtime
+
+//------------------------------------------------------------------------------
+
+// ip_tcp_acceptor_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// ip::tcp::acceptor compile and link correctly. Runtime failures are ignored.
+
+namespace ip_tcp_acceptor_compile {
+
+struct wait_handler
+{
+  wait_handler() {}
+  void operator()(const asio::error_code&) {}
+  wait_handler(wait_handler&&) {}
+private:
+  wait_handler(const wait_handler&);
+};
+
+struct accept_handler
+{
+  accept_handler() {}
+  void operator()(const asio::error_code&) {}
+  accept_handler(accept_handler&&) {}
+private:
+  accept_handler(const accept_handler&);
+};
+
+struct move_accept_handler
+{
+  move_accept_handler() {}
+  void operator()(
+      const asio::error_code&, asio::ip::tcp::socket) {}
+  move_accept_handler(move_accept_handler&&) {}
+private:
+  move_accept_handler(const move_accept_handler&) {}
+};
+
+struct move_accept_ioc_handler
+{
+  move_accept_ioc_handler() {}
+  void operator()(const asio::error_code&,
+      asio::basic_stream_socket<asio::ip::tcp,
+        asio::io_context::executor_type>) {}
+  move_accept_ioc_handler(move_accept_handler&&) {}
+private:
+  move_accept_ioc_handler(const move_accept_handler&) {}
+};
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    const io_context::executor_type ioc_ex = ioc.get_executor();
+    ip::tcp::socket peer_socket1(ioc);
+    asio::basic_stream_socket<ip::tcp,
+        io_context::executor_type> peer_socket2(ioc);
+    ip::tcp::endpoint peer_endpoint;
+    archetypes::settable_socket_option<void> settable_socket_option1;
+    archetypes::settable_socket_option<int> settable_socket_option2;
+    archetypes::settable_socket_option<double> settable_socket_option3;
+    archetypes::gettable_socket_option<void> gettable_socket_option1;
+    archetypes::gettable_socket_option<int> gettable_socket_option2;
+    archetypes::gettable_socket_option<double> gettable_socket_option3;
+    archetypes::io_control_command io_control_command;
+    archetypes::immediate_handler immediate;
+    archetypes::lazy_handler lazy;
+    asio::error_code ec;
+
+    // basic_socket_acceptor constructors.
+
+    ip::tcp::acceptor acceptor1(ioc);
+    ip::tcp::acceptor acceptor2(ioc, ip::tcp::v4());
+    ip::tcp::acceptor acceptor3(ioc, ip::tcp::v6());
+    ip::tcp::acceptor acceptor4(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+    ip::tcp::acceptor acceptor5(ioc, ip::tcp::endpoint(ip::tcp::v6(), 0));
+#if !defined(ASIO_WINDOWS_RUNTIME)
+    ip::tcp::acceptor::native_handle_type native_acceptor1
+      = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    ip::tcp::acceptor acceptor6(ioc, ip::tcp::v4(), native_acceptor1);
+#endif // !defined(ASIO_WINDOWS_RUNTIME)
+
+    ip::tcp::acceptor acceptor7(ioc_ex);
+    ip::tcp::acceptor acceptor8(ioc_ex, ip::tcp::v4());
+    ip::tcp::acceptor acceptor9(ioc_ex, ip::tcp::v6());
+    ip::tcp::acceptor acceptor10(ioc_ex, ip::tcp::endpoint(ip::tcp::v4(), 0));
+    ip::tcp::acceptor acceptor11(ioc_ex, ip::tcp::endpoint(ip::tcp::v6(), 0));
+#if !defined(ASIO_WINDOWS_RUNTIME)
+    ip::tcp::acceptor::native_handle_type native_acceptor2
+      = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    ip::tcp::acceptor acceptor12(ioc_ex, ip::tcp::v4(), native_acceptor2);
+#endif // !defined(ASIO_WINDOWS_RUNTIME)
+
+    ip::tcp::acceptor acceptor13(std::move(acceptor5));
+
+    // basic_socket_acceptor operators.
+
+    acceptor1 = ip::tcp::acceptor(ioc);
+    acceptor1 = std::move(acceptor2);
+
+    // I/O object functions.
+
+    ip::tcp::acceptor::executor_type ex = acceptor1.get_executor();
+    (void)ex;
+
+    // basic_socket_acceptor functions.
+
+    acceptor1.open(ip::tcp::v4());
+    acceptor1.open(ip::tcp::v6());
+    acceptor1.open(ip::tcp::v4(), ec);
+    acceptor1.open(ip::tcp::v6(), ec);
+
+#if !defined(ASIO_WINDOWS_RUNTIME)
+    ip::tcp::acceptor::native_handle_type native_acceptor3
+      = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    acceptor1.assign(ip::tcp::v4(), native_acceptor3);
+    ip::tcp::acceptor::native_handle_type native_acceptor4
+      = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    acceptor1.assign(ip::tcp::v4(), native_acceptor4, ec);
+#endif // !defined(ASIO_WINDOWS_RUNTIME)
+
+    bool is_open = acceptor1.is_open();
+    (void)is_open;
+
+    acceptor1.close();
+    acceptor1.close(ec);
+
+    acceptor1.release();
+    acceptor1.release(ec);
+
+    ip::tcp::acceptor::native_handle_type native_acceptor5
+      = acceptor1.native_handle();
+    (void)native_acceptor5;
+
+    acceptor1.cancel();
     acceptor1.cancel(ec);
 
     acceptor1.bind(ip::tcp::endpoint(ip::tcp::v4(), 0));
@@ -1020,6 +2621,59 @@ void test()
       == client_endpoint.port());
 }
 
+void test_exclusive_listeners()
+{
+#if defined(ASIO_HAS_EPOLL) && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  // Two contexts, each with its own epoll instance, accept connections from
+  // the same listening socket.
+  io_context ioc1(config_from_string("reactor.exclusive_listeners=1"));
+  io_context ioc2(config_from_string("reactor.exclusive_listeners=1"));
+  io_context client_ioc;
+
+  ip::tcp::acceptor acceptor1(ioc1,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::acceptor acceptor2(ioc2);
+  acceptor2.assign(ip::tcp::v4(), ::dup(acceptor1.native_handle()));
+  ip::tcp::endpoint server_endpoint = acceptor1.local_endpoint();
+
+  // Each acceptor keeps an accept outstanding.
+  enum { num_connections = 4 };
+  int accepted = 0;
+  std::function<void(ip::tcp::acceptor&)> start_accept =
+    [&](ip::tcp::acceptor& acceptor)
+    {
+      acceptor.async_accept(
+          [&](const asio::error_code& err, ip::tcp::socket)
+          {
+            ASIO_CHECK(!err);
+            if (!err && ++accepted < num_connections)
+              start_accept(acceptor);
+          });
+    };
+  start_accept(acceptor1);
+  start_accept(acceptor2);
+  ioc1.poll();
+  ioc2.poll();
+
+  ip::tcp::socket clients[num_connections] = {
+    ip::tcp::socket(client_ioc), ip::tcp::socket(client_ioc),
+    ip::tcp::socket(client_ioc), ip::tcp::socket(client_ioc) };
+  for (int i = 0; i < num_connections; ++i)
+    clients[i].connect(server_endpoint);
+
+  for (int i = 0; i < 1000 && accepted < num_connections; ++i)
+  {
+    ioc1.run_one_for(asio::chrono::milliseconds(1));
+    ioc2.run_one_for(asio::chrono::milliseconds(1));
+  }
+
+  ASIO_CHECK(accepted == num_connections);
+#endif // defined(ASIO_HAS_EPOLL) && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+}
+
 } // namespace ip_tcp_acceptor_runtime
 
 //------------------------------------------------------------------------------
@@ -1144,6 +2798,337 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// ip_tcp_resolver_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the ip::tcp::resolver
+// class when it queries the name servers directly.
+
+namespace ip_tcp_resolver_runtime {
+
+using asio::ip::tcp;
+using asio::ip::udp;
+
+// A name server that knows a single name. Its A record is returned over UDP,
+// and its AAAA record only over TCP, after a truncated UDP response.
+class dns_server
+{
+public:
+  dns_server(asio::io_context& ioc, unsigned short port)
+    : udp_socket_(ioc, udp::endpoint(asio::ip::address_v4::loopback(), port)),
+      acceptor_(ioc, tcp::endpoint(asio::ip::address_v4::loopback(),
+            udp_socket_.local_endpoint().port())),
+      tcp_socket_(ioc),
+      tcp_connections_(0)
+  {
+    start_udp_receive();
+    start_accept();
+  }
+
+  unsigned short port() const
+  {
+    return udp_socket_.local_endpoint().port();
+  }
+
+  int tcp_connections() const
+  {
+    return tcp_connections_;
+  }
+
+  void stop()
+  {
+    asio::error_code ignored_ec;
+    udp_socket_.close(ignored_ec);
+    acceptor_.close(ignored_ec);
+    tcp_socket_.close(ignored_ec);
+  }
+
+private:
+  void start_udp_receive()
+  {
+    udp_socket_.async_receive_from(asio::buffer(udp_buffer_), udp_sender_,
+        [this](const asio::error_code& ec, std::size_t n)
+        {
+          if (ec)
+            return;
+          std::vector<unsigned char> reply = respond(udp_buffer_, n, false);
+          udp_socket_.send_to(asio::buffer(reply), udp_sender_);
+          start_udp_receive();
+        });
+  }
+
+  void start_accept()
+  {
+    acceptor_.async_accept(tcp_socket_,
+        [this](const asio::error_code& ec)
+        {
+          if (ec)
+            return;
+          ++tcp_connections_;
+          start_tcp_receive();
+        });
+  }
+
+  void start_tcp_receive()
+  {
+    asio::async_read(tcp_socket_, asio::buffer(tcp_buffer_, 2),
+        [this](const asio::error_code& ec, std::size_t)
+        {
+          if (ec)
+            return;
+          std::size_t length = (tcp_buffer_[0] << 8) | tcp_buffer_[1];
+          asio::async_read(tcp_socket_, asio::buffer(tcp_buffer_, length),
+              [this](const asio::error_code& ec, std::size_t n)
+              {
+                if (ec)
+                  return;
+                std::vector<unsigned char> reply =
+                  respond(tcp_buffer_, n, true);
+                unsigned char prefix[2] = {
+                  static_cast<unsigned char>(reply.size() >> 8),
+                  static_cast<unsigned char>(reply.size() & 0xFF) };
+                asio::write(tcp_socket_, asio::buffer(prefix));
+                asio::write(tcp_socket_, asio::buffer(reply));
+                start_tcp_receive();
+              });
+        });
+  }
+
+  static std::vector<unsigned char> respond(
+      const unsigned char* query, std::size_t n, bool tcp)
+  {
+    // Decode the question.
+    std::string name;
+    std::size_t pos = 12;
+    while (pos < n && query[pos] != 0)
+    {
+      if (!name.empty())
+        name.push_back('.');
+      name.append(reinterpret_cast<const char*>(query) + pos + 1,
+          query[pos]);
+      pos += 1 + query[pos];
+    }
+    pos += 5;
+    unsigned int type = (query[pos - 4] << 8) | query[pos - 3];
+
+    // The reply repeats the header and question.
+    std::vector<unsigned char> reply(query, query + pos);
+    reply[2] = 0x81;
+    reply[3] = 0x80;
+
+    if (name != "host.example.test")
+    {
+      reply[3] |= 3; // Name error.
+    }
+    else if (type == 28 && !tcp)
+    {
+      reply[2] |= 0x02; // Truncated.
+    }
+    else
+    {
+      static const unsigned char v4[4] = { 192, 0, 2, 1 };
+      static const unsigned char v6[16] = { 0x20, 0x01, 0x0d, 0xb8,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 };
+      const unsigned char* data = type == 1 ? v4 : v6;
+      unsigned char length = type == 1 ? 4 : 16;
+      unsigned char answer[12] = { 0xC0, 12, 0,
+        static_cast<unsigned char>(type), 0, 1, 0, 0, 0, 60, 0, length };
+      reply[7] = 1;
+      reply.insert(reply.end(), answer, answer + sizeof(answer));
+      reply.insert(reply.end(), data, data + length);
+    }
+
+    return reply;
+  }
+
+  udp::socket udp_socket_;
+  udp::endpoint udp_sender_;
+  unsigned char udp_buffer_[512];
+  tcp::acceptor acceptor_;
+  tcp::socket tcp_socket_;
+  unsigned char tcp_buffer_[65536];
+  int tcp_connections_;
+};
+
+struct resolve_handler
+{
+  void operator()(const asio::error_code& e, tcp::resolver::results_type r)
+  {
+    *ec = e;
+    *results = r;
+    server->stop();
+  }
+
+  asio::error_code* ec;
+  tcp::resolver::results_type* results;
+  dns_server* server;
+};
+
+std::string write_resolver_config(unsigned short port)
+{
+  const char* path = "ip_tcp_resolver_runtime.conf";
+  std::FILE* file = std::fopen(path, "w");
+  std::fputs("nameserver 127.0.0.1\n", file);
+  std::fputs("search example.test\n", file);
+  std::fputs("options ndots:1 timeout:1 attempts:1\n", file);
+  std::fclose(file);
+
+  std::string s = "resolver.dns=1\nresolver.dns_port=";
+  s += std::to_string(port);
+  s += "\nresolver.dns_config_file=";
+  s += path;
+  return s;
+}
+
+void test()
+{
+  asio::io_context server_ioc;
+  dns_server probe(server_ioc, 0);
+  unsigned short port = probe.port();
+  probe.stop();
+
+  asio::io_context ioc(asio::config_from_string(write_resolver_config(port)));
+  dns_server server(ioc, port);
+  tcp::resolver resolver(ioc);
+  std::remove("ip_tcp_resolver_runtime.conf");
+
+  // The search domain is applied to the name, and the truncated AAAA
+  // response is retried over TCP.
+  asio::error_code ec;
+  tcp::resolver::results_type results;
+  resolver.async_resolve("host", "80",
+      resolve_handler{&ec, &results, &server});
+  ioc.run();
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(results.size() == 2);
+  ASIO_CHECK(server.tcp_connections() == 1);
+  if (results.size() == 2)
+  {
+    tcp::resolver::results_type::const_iterator iter = results.begin();
+    ASIO_CHECK(iter->endpoint() == tcp::endpoint(
+          asio::ip::make_address("192.0.2.1"), 80));
+    ASIO_CHECK(iter->host_name() == "host");
+    ++iter;
+    ASIO_CHECK(iter->endpoint() == tcp::endpoint(
+          asio::ip::make_address("2001:db8::1"), 80));
+  }
+
+  // Only the requested family is queried.
+  dns_server server2(ioc, port);
+  ioc.restart();
+  resolver.async_resolve(tcp::v4(), "host", "443", tcp::resolver::flags(),
+      resolve_handler{&ec, &results, &server2});
+  ioc.run();
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(results.size() == 1);
+  ASIO_CHECK(server2.tcp_connections() == 0);
+  ASIO_CHECK(results.begin()->endpoint() == tcp::endpoint(
+        asio::ip::make_address("192.0.2.1"), 443));
+
+  // A cancelled resolution completes with operation_aborted.
+  dns_server server3(ioc, port);
+  ioc.restart();
+  resolver.async_resolve("host", "80",
+      resolve_handler{&ec, &results, &server3});
+  resolver.cancel();
+  ioc.run();
+
+  ASIO_CHECK(ec == asio::error::operation_aborted);
+
+  // A resolution whose name server does not respond may be cancelled without
+  // waiting for the server's timeout.
+  {
+    udp::socket silent(ioc, udp::endpoint(
+          asio::ip::address_v4::loopback(), port));
+    ec = asio::error_code();
+    ioc.restart();
+    resolver.async_resolve("host", "80",
+        asio::cancel_after(std::chrono::milliseconds(50),
+          [&](const asio::error_code& e, tcp::resolver::results_type)
+          {
+            ec = e;
+          }));
+    ioc.run();
+
+    ASIO_CHECK(ec == asio::error::operation_aborted);
+  }
+}
+
+void test_cancellation()
+{
+  // A lookup with a connected cancellation slot completes normally if the
+  // signal is not emitted, and the slot's handler is cleared.
+  {
+    asio::io_context ioc;
+    tcp::resolver resolver(ioc);
+    asio::cancellation_signal signal;
+    asio::error_code ec = asio::error::would_block;
+    tcp::resolver::results_type results;
+    resolver.async_resolve("127.0.0.1", "80",
+        asio::bind_cancellation_slot(signal.slot(),
+          [&](const asio::error_code& e, tcp::resolver::results_type r)
+          {
+            ec = e;
+            results = r;
+          }));
+    ioc.run();
+
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(results.size() == 1);
+    ASIO_CHECK(!signal.slot().has_handler());
+  }
+
+  // An operation that is cancelled while its lookup is in progress completes
+  // with operation_aborted. The lookup may already have finished, in which
+  // case the operation completes normally.
+  {
+    asio::io_context ioc;
+    tcp::resolver resolver(ioc);
+    asio::cancellation_signal signal;
+    int calls = 0;
+    asio::error_code ec;
+    tcp::resolver::results_type results;
+    resolver.async_resolve("localhost", "80",
+        asio::bind_cancellation_slot(signal.slot(),
+          [&](const asio::error_code& e, tcp::resolver::results_type r)
+          {
+            ++calls;
+            ec = e;
+            results = r;
+          }));
+    signal.emit(asio::cancellation_type::terminal);
+    ioc.run();
+
+    ASIO_CHECK(calls == 1);
+    ASIO_CHECK(ec == asio::error::operation_aborted || !ec);
+    ASIO_CHECK(!ec || results.empty());
+    ASIO_CHECK(!signal.slot().has_handler());
+
+    calls = 0;
+    ioc.restart();
+    resolver.async_resolve(tcp::endpoint(
+          asio::ip::address_v4::loopback(), 80),
+        asio::bind_cancellation_slot(signal.slot(),
+          [&](const asio::error_code& e, tcp::resolver::results_type r)
+          {
+            ++calls;
+            ec = e;
+            results = r;
+          }));
+    signal.emit(asio::cancellation_type::partial);
+    ioc.run();
+
+    ASIO_CHECK(calls == 1);
+    ASIO_CHECK(ec == asio::error::operation_aborted || !ec);
+    ASIO_CHECK(!signal.slot().has_handler());
+  }
+}
+
+} // namespace ip_tcp_resolver_runtime
+
+//------------------------------------------------------------------------------
+
 // ip_tcp_resolver_entry_compile test
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // The following test checks that all public member functions on the class
@@ -1261,6 +3246,8 @@ void test()
   ip::tcp::iostream::duration d = ip::tcp::iostream::duration();
   ios1.expires_after(d);
 
+  ios1.resize_buffers(1024, 1024);
+
   // iostream operators.
 
   int i = 0;
@@ -1273,17 +3260,107 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// ip_tcp_iostream_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the ip::tcp::iostream
+// class.
+
+namespace ip_tcp_iostream_runtime {
+
+void test()
+{
+#if !defined(ASIO_NO_IOSTREAM)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+
+  ip::tcp::iostream client;
+  client.connect(acceptor.local_endpoint());
+  ASIO_CHECK(!!client);
+
+  ip::tcp::iostream server;
+  acceptor.accept(server.socket());
+
+  // Transfer more data than fits in the buffers, in blocking mode.
+  client.resize_buffers(4096, 4096);
+  server.resize_buffers(64, 0);
+  client.unsetf(std::ios_base::unitbuf);
+  std::string line(10000, 'x');
+  client << line << std::endl;
+  std::string received;
+  std::getline(server, received);
+  ASIO_CHECK(!!server);
+  ASIO_CHECK(received == line);
+
+  // Unread input is kept when the buffers are resized.
+  server << "one two" << std::endl;
+  std::string word;
+  client >> word;
+  ASIO_CHECK(word == "one");
+  client.resize_buffers(16, 16);
+  client >> word;
+  ASIO_CHECK(word == "two");
+
+  // An expired stream times out rather than blocking.
+  client.expires_after(chrono::milliseconds(10));
+  client >> word;
+  ASIO_CHECK(!client);
+  ASIO_CHECK(client.error() == asio::error::timed_out);
+
+  // The peer's close is reported as the end of the stream.
+  ip::tcp::iostream other;
+  other.connect(acceptor.local_endpoint());
+  ip::tcp::iostream peer;
+  acceptor.accept(peer.socket());
+  peer << "last" << std::endl;
+  peer.close();
+  std::getline(other, word);
+  ASIO_CHECK(word == "last");
+  std::getline(other, word);
+  ASIO_CHECK(!other);
+  ASIO_CHECK(other.error() == asio::error::eof);
+#endif // !defined(ASIO_NO_IOSTREAM)
+}
+
+} // namespace ip_tcp_iostream_runtime
+
+//------------------------------------------------------------------------------
+
 ASIO_TEST_SUITE
 (
   "ip/tcp",
   ASIO_COMPILE_TEST_CASE(ip_tcp_compile::test)
   ASIO_TEST_CASE(ip_tcp_runtime::test)
+  ASIO_TEST_CASE(ip_tcp_runtime::test_endpoint_chars)
+  ASIO_TEST_CASE(ip_tcp_runtime::test_not_sent_low_watermark)
   ASIO_COMPILE_TEST_CASE(ip_tcp_socket_compile::test)
   ASIO_TEST_CASE(ip_tcp_socket_runtime::test)
+  ASIO_TEST_CASE(ip_tcp_socket_runtime::test_registered_files)
+  ASIO_TEST_CASE(ip_tcp_socket_runtime::test_ring_config)
+  ASIO_TEST_CASE(ip_tcp_socket_runtime::test_concurrent_reaping)
+  ASIO_TEST_CASE(ip_tcp_socket_runtime::test_transport_info)
+  ASIO_TEST_CASE(ip_tcp_socket_runtime::test_send_all)
+  ASIO_TEST_CASE(ip_tcp_socket_runtime::test_receive_all)
+  ASIO_TEST_CASE(ip_tcp_socket_runtime::test_read_ahead)
+  ASIO_TEST_CASE(ip_tcp_socket_runtime::test_write_coalescing)
+  ASIO_TEST_CASE(ip_tcp_socket_runtime::test_fixed_size_buffer_sequences)
+  ASIO_TEST_CASE(ip_tcp_socket_runtime::test_operation_slots)
+  ASIO_TEST_CASE(ip_tcp_socket_runtime::test_transfer)
+  ASIO_TEST_CASE(ip_tcp_socket_runtime::test_fork_child)
+  ASIO_TEST_CASE(ip_tcp_socket_runtime::test_wait_peer_closed)
+  ASIO_TEST_CASE(ip_tcp_socket_runtime::test_async_close)
+  ASIO_TEST_CASE(ip_tcp_socket_runtime::test_cancel_after)
   ASIO_COMPILE_TEST_CASE(ip_tcp_acceptor_compile::test)
   ASIO_TEST_CASE(ip_tcp_acceptor_runtime::test)
+  ASIO_TEST_CASE(ip_tcp_acceptor_runtime::test_exclusive_listeners)
   ASIO_COMPILE_TEST_CASE(ip_tcp_resolver_compile::test)
+  ASIO_TEST_CASE(ip_tcp_resolver_runtime::test)
+  ASIO_TEST_CASE(ip_tcp_resolver_runtime::test_cancellation)
   ASIO_COMPILE_TEST_CASE(ip_tcp_resolver_entry_compile::test)
   ASIO_COMPILE_TEST_CASE(ip_tcp_resolver_entry_compile::test)
   ASIO_COMPILE_TEST_CASE(ip_tcp_iostream_compile::test)
+  ASIO_TEST_CASE(ip_tcp_iostream_runtime::test)
 )
@@ -18,6 +18,7 @@
 
 #include <cstring>
 #include <functional>
+#include <vector>
 #include "asio/io_context.hpp"
 #include "../unit_test.hpp"
 #include "../archetypes/async_result.hpp"
@@ -70,6 +71,15 @@ private:
   receive_handler(const receive_handler&);
 };
 
+struct coalesced_handler
+{
+  coalesced_handler() {}
+  void operator()(const asio::error_code&, std::size_t, std::size_t) {}
+  coalesced_handler(coalesced_handler&&) {}
+private:
+  coalesced_handler(const coalesced_handler&);
+};
+
 void test()
 {
   using namespace asio;
@@ -469,6 +479,85 @@ void test()
     int i29 = socket1.async_receive_from(null_buffers(),
         endpoint, in_flags, lazy);
     (void)i29;
+
+#if defined(ASIO_HAS_DATAGRAM_BATCH)
+    std::vector<mutable_buffer> mutable_buffers(2,
+        buffer(mutable_char_buffer));
+    std::vector<const_buffer> const_buffers(2, buffer(const_char_buffer));
+    ip::udp::endpoint endpoints[2];
+    std::size_t sizes[2];
+
+    socket1.async_send_batch(const_buffers, endpoints, send_handler());
+    socket1.async_send_batch(const_buffers, endpoints,
+        in_flags, send_handler());
+    socket1.async_send_batch(const_buffers, endpoints, immediate);
+    socket1.async_send_batch(const_buffers, endpoints, in_flags, immediate);
+    int i30 = socket1.async_send_batch(const_buffers, endpoints, lazy);
+    (void)i30;
+    int i31 = socket1.async_send_batch(const_buffers, endpoints,
+        in_flags, lazy);
+    (void)i31;
+
+    socket1.async_receive_batch(mutable_buffers,
+        endpoints, sizes, receive_handler());
+    socket1.async_receive_batch(mutable_buffers,
+        endpoints, sizes, in_flags, receive_handler());
+    socket1.async_receive_batch(mutable_buffers,
+        endpoints, sizes, immediate);
+    socket1.async_receive_batch(mutable_buffers,
+        endpoints, sizes, in_flags, immediate);
+    int i32 = socket1.async_receive_batch(mutable_buffers,
+        endpoints, sizes, lazy);
+    (void)i32;
+    int i33 = socket1.async_receive_batch(mutable_buffers,
+        endpoints, sizes, in_flags, lazy);
+    (void)i33;
+#endif // defined(ASIO_HAS_DATAGRAM_BATCH)
+
+#if defined(ASIO_HAS_UDP_OFFLOAD)
+    socket1.async_send_segments(buffer(const_char_buffer), 2,
+        send_handler());
+    socket1.async_send_segments(buffer(const_char_buffer), 2, immediate);
+    int i34 = socket1.async_send_segments(buffer(const_char_buffer), 2, lazy);
+    (void)i34;
+
+    socket1.async_send_segments_to(buffer(const_char_buffer), 2,
+        ip::udp::endpoint(ip::udp::v4(), 0), send_handler());
+    socket1.async_send_segments_to(buffer(const_char_buffer), 2,
+        ip::udp::endpoint(ip::udp::v4(), 0), immediate);
+    int i35 = socket1.async_send_segments_to(buffer(const_char_buffer), 2,
+        ip::udp::endpoint(ip::udp::v4(), 0), lazy);
+    (void)i35;
+
+    socket1.async_receive_coalesced(buffer(mutable_char_buffer),
+        coalesced_handler());
+    socket1.async_receive_coalesced(buffer(mutable_char_buffer), immediate);
+    int i36 = socket1.async_receive_coalesced(
+        buffer(mutable_char_buffer), lazy);
+    (void)i36;
+
+    socket1.async_receive_coalesced_from(buffer(mutable_char_buffer),
+        endpoint, coalesced_handler());
+    socket1.async_receive_coalesced_from(buffer(mutable_char_buffer),
+        endpoint, immediate);
+    int i37 = socket1.async_receive_coalesced_from(
+        buffer(mutable_char_buffer), endpoint, lazy);
+    (void)i37;
+
+    ip::udp::segment_size segment_size1(100);
+    socket1.set_option(segment_size1);
+    socket1.set_option(segment_size1, ec);
+    ip::udp::segment_size segment_size2;
+    socket1.get_option(segment_size2);
+    socket1.get_option(segment_size2, ec);
+
+    ip::udp::receive_offload receive_offload1(true);
+    socket1.set_option(receive_offload1);
+    socket1.set_option(receive_offload1, ec);
+    ip::udp::receive_offload receive_offload2;
+    socket1.get_option(receive_offload2);
+    socket1.get_option(receive_offload2, ec);
+#endif // defined(ASIO_HAS_UDP_OFFLOAD)
   }
   catch (std::exception&)
   {
@@ -542,6 +631,448 @@ void test()
   ASIO_CHECK(memcmp(send_msg, recv_msg, sizeof(send_msg)) == 0);
 }
 
+void handle_recv_count(size_t expected_bytes_recvd, int* count,
+    const asio::error_code& err, size_t bytes_recvd)
+{
+  ASIO_CHECK(!err);
+  ASIO_CHECK(expected_bytes_recvd == bytes_recvd);
+  ++(*count);
+}
+
+void handle_recv_aborted(int* count, const asio::error_code& err, size_t)
+{
+  ASIO_CHECK(err == asio::error::operation_aborted);
+  ++(*count);
+}
+
+void test_deferred_registration()
+{
+  using namespace std; // For memcmp.
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  namespace bindns = std;
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  io_context ioc1;
+  io_context ioc2;
+
+  ip::udp::socket s1(ioc1, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket s2(ioc2, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  char send_msg[] = "0123456789";
+  char recv_msg[sizeof(send_msg)];
+  ip::udp::endpoint sender_endpoint;
+  int count = 0;
+
+  // A receive that completes immediately does not need the reactor.
+  s2.send_to(buffer(send_msg, sizeof(send_msg)), s1.local_endpoint());
+  s1.async_receive_from(buffer(recv_msg, sizeof(recv_msg)), sender_endpoint,
+      bindns::bind(handle_recv_count, sizeof(send_msg), &count, _1, _2));
+  s1.cancel();
+  ioc1.run();
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(memcmp(send_msg, recv_msg, sizeof(send_msg)) == 0);
+
+  // A socket that has not waited may move to another context, where it is
+  // registered when an operation first needs to wait.
+  ip::udp::socket s3(ioc2, std::move(s1));
+  s3.async_receive_from(buffer(recv_msg, sizeof(recv_msg)), sender_endpoint,
+      bindns::bind(handle_recv_count, sizeof(send_msg), &count, _1, _2));
+  s2.async_send_to(buffer(send_msg, sizeof(send_msg)), s3.local_endpoint(),
+      bindns::bind(handle_send, sizeof(send_msg), _1, _2));
+  ioc2.run();
+  ASIO_CHECK(count == 2);
+
+  // Operations that wait on the registered socket may be cancelled.
+  ioc2.restart();
+  s3.async_receive_from(buffer(recv_msg, sizeof(recv_msg)), sender_endpoint,
+      bindns::bind(handle_recv_aborted, &count, _1, _2));
+  ioc2.poll();
+  s3.close();
+  ioc2.run();
+  ASIO_CHECK(count == 3);
+}
+
+#if defined(ASIO_HAS_DATAGRAM_BATCH)
+
+void handle_batch(size_t expected_messages,
+    const asio::error_code& err, size_t messages)
+{
+  ASIO_CHECK(!err);
+  ASIO_CHECK(expected_messages == messages);
+}
+
+void test_batch()
+{
+  using namespace std; // For memcmp and memset.
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  namespace bindns = std;
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  io_context ioc;
+
+  ip::udp::socket s1(ioc, ip::udp::endpoint(ip::udp::v4(), 0));
+  ip::udp::endpoint target_endpoint = s1.local_endpoint();
+  target_endpoint.address(ip::address_v4::loopback());
+
+  ip::udp::socket s2(ioc, ip::udp::endpoint(ip::udp::v4(), 0));
+  ip::udp::endpoint s2_endpoint = s2.local_endpoint();
+  s2_endpoint.address(ip::address_v4::loopback());
+
+  const char send_msg1[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  const char send_msg2[] = "abcdefghij";
+  const char send_msg3[] = "0123456789";
+
+  std::vector<const_buffer> send_bufs;
+  send_bufs.push_back(buffer(send_msg1, sizeof(send_msg1)));
+  send_bufs.push_back(buffer(send_msg2, sizeof(send_msg2)));
+  send_bufs.push_back(buffer(send_msg3, sizeof(send_msg3)));
+  ip::udp::endpoint destinations[3] =
+    { target_endpoint, target_endpoint, target_endpoint };
+
+  s2.async_send_batch(send_bufs, destinations,
+      bindns::bind(handle_batch, 3, _1, _2));
+  ioc.run();
+  ioc.restart();
+
+  char recv_msgs[4][64];
+  std::vector<mutable_buffer> recv_bufs;
+  for (int i = 0; i < 4; ++i)
+    recv_bufs.push_back(buffer(recv_msgs[i]));
+  ip::udp::endpoint senders[4];
+  std::size_t sizes[4] = { 0, 0, 0, 0 };
+
+  s1.async_receive_batch(recv_bufs, senders, sizes,
+      bindns::bind(handle_batch, 3, _1, _2));
+  ioc.run();
+  ioc.restart();
+
+  ASIO_CHECK(sizes[0] == sizeof(send_msg1));
+  ASIO_CHECK(sizes[1] == sizeof(send_msg2));
+  ASIO_CHECK(sizes[2] == sizeof(send_msg3));
+  ASIO_CHECK(memcmp(recv_msgs[0], send_msg1, sizeof(send_msg1)) == 0);
+  ASIO_CHECK(memcmp(recv_msgs[1], send_msg2, sizeof(send_msg2)) == 0);
+  ASIO_CHECK(memcmp(recv_msgs[2], send_msg3, sizeof(send_msg3)) == 0);
+  ASIO_CHECK(senders[0] == s2_endpoint);
+  ASIO_CHECK(senders[2] == s2_endpoint);
+
+  // A connected socket may send without destinations, and a receiver may
+  // ignore the senders.
+  s2.connect(target_endpoint);
+  send_bufs.resize(1);
+  s2.async_send_batch(send_bufs, 0,
+      bindns::bind(handle_batch, 1, _1, _2));
+  ioc.run();
+  ioc.restart();
+
+  memset(sizes, 0, sizeof(sizes));
+  s1.async_receive_batch(recv_bufs, 0, sizes,
+      bindns::bind(handle_batch, 1, _1, _2));
+  ioc.run();
+
+  ASIO_CHECK(sizes[0] == sizeof(send_msg1));
+  ASIO_CHECK(memcmp(recv_msgs[0], send_msg1, sizeof(send_msg1)) == 0);
+}
+
+#else // defined(ASIO_HAS_DATAGRAM_BATCH)
+
+void test_batch()
+{
+}
+
+#endif // defined(ASIO_HAS_DATAGRAM_BATCH)
+
+#if defined(ASIO_HAS_PACKET_INFO)
+
+void test_packet_info_for(const asio::ip::address& loopback)
+{
+  using namespace std; // For memcmp.
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  namespace bindns = std;
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  io_context ioc;
+  asio::error_code ec;
+
+  ip::udp::socket s1(ioc);
+  s1.open(loopback.is_v4() ? ip::udp::v4() : ip::udp::v6(), ec);
+  if (ec)
+    return; // The address family is not available.
+  s1.bind(ip::udp::endpoint(loopback, 0));
+  s1.set_option(ip::udp::receive_packet_info(true));
+  s1.set_option(ip::udp::receive_traffic_class(true));
+
+  ip::udp::receive_packet_info packet_info_option;
+  s1.get_option(packet_info_option);
+  ASIO_CHECK(packet_info_option.value());
+
+  ip::udp::socket s2(ioc, ip::udp::endpoint(loopback, 0));
+
+  const char send_msg1[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  const char send_msg2[] = "0123456789";
+  std::vector<const_buffer> send_bufs;
+  send_bufs.push_back(buffer(send_msg1, sizeof(send_msg1)));
+  send_bufs.push_back(buffer(send_msg2, sizeof(send_msg2)));
+  ip::udp::endpoint destinations[2] =
+    { s1.local_endpoint(), s1.local_endpoint() };
+
+  // The first datagram sets its source address and traffic class, and the
+  // second uses the socket's defaults.
+  ip::udp::packet_info send_infos[2];
+  send_infos[0].local_address(loopback);
+  send_infos[0].dscp(10);
+  send_infos[0].ecn(ip::udp::packet_info::ect0);
+
+  s2.async_send_batch(send_bufs, destinations, send_infos,
+      bindns::bind(handle_batch, 2, _1, _2));
+  ioc.run();
+  ioc.restart();
+
+  char recv_msgs[4][64];
+  std::vector<mutable_buffer> recv_bufs;
+  for (int i = 0; i < 4; ++i)
+    recv_bufs.push_back(buffer(recv_msgs[i]));
+  std::size_t sizes[4] = { 0, 0, 0, 0 };
+  ip::udp::packet_info recv_infos[4];
+
+  std::size_t received = 0;
+  while (received < 2)
+  {
+    std::size_t n = 0;
+    s1.async_receive_batch(recv_bufs, 0, sizes + received,
+        recv_infos + received,
+        [&](const asio::error_code& e, std::size_t messages)
+        {
+          ASIO_CHECK(!e);
+          n = messages;
+        });
+    ioc.run();
+    ioc.restart();
+    ASIO_CHECK(n > 0);
+    received += n;
+    recv_bufs.erase(recv_bufs.begin(), recv_bufs.begin() + n);
+  }
+
+  ASIO_CHECK(sizes[0] == sizeof(send_msg1));
+  ASIO_CHECK(sizes[1] == sizeof(send_msg2));
+  ASIO_CHECK(memcmp(recv_msgs[0], send_msg1, sizeof(send_msg1)) == 0);
+  ASIO_CHECK(memcmp(recv_msgs[1], send_msg2, sizeof(send_msg2)) == 0);
+
+  for (int i = 0; i < 2; ++i)
+  {
+    ASIO_CHECK(recv_infos[i].local_address() == loopback);
+    ASIO_CHECK(recv_infos[i].interface_index() != 0);
+    ASIO_CHECK(recv_infos[i].has_traffic_class());
+  }
+  ASIO_CHECK(recv_infos[0].dscp() == 10);
+  ASIO_CHECK(recv_infos[0].ecn() == ip::udp::packet_info::ect0);
+  ASIO_CHECK(recv_infos[1].traffic_class() == 0);
+}
+
+void test_packet_info()
+{
+  test_packet_info_for(asio::ip::address_v4::loopback());
+  test_packet_info_for(asio::ip::address_v6::loopback());
+}
+
+#else // defined(ASIO_HAS_PACKET_INFO)
+
+void test_packet_info()
+{
+}
+
+#endif // defined(ASIO_HAS_PACKET_INFO)
+
+#if defined(ASIO_HAS_UDP_OFFLOAD)
+
+void handle_segments_send(size_t expected_bytes_sent,
+    const asio::error_code& err, size_t bytes_sent)
+{
+  ASIO_CHECK(!err);
+  ASIO_CHECK(expected_bytes_sent == bytes_sent);
+}
+
+void handle_coalesced_recv(const asio::error_code& err,
+    size_t bytes_recvd, size_t segment_size,
+    size_t* total_bytes, bool* sizes_ok)
+{
+  ASIO_CHECK(!err);
+  *total_bytes += bytes_recvd;
+  if (segment_size != 100 || bytes_recvd % 100 != 0)
+    *sizes_ok = false;
+}
+
+void test_offload()
+{
+  using namespace std; // For memcmp.
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  namespace bindns = std;
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+  using bindns::placeholders::_3;
+
+  io_context ioc;
+
+  ip::udp::socket s1(ioc, ip::udp::endpoint(ip::udp::v4(), 0));
+  ip::udp::endpoint target_endpoint = s1.local_endpoint();
+  target_endpoint.address(ip::address_v4::loopback());
+
+  ip::udp::socket s2(ioc, ip::udp::endpoint(ip::udp::v4(), 0));
+
+  asio::error_code ec;
+  s1.set_option(ip::udp::receive_offload(true), ec);
+  if (ec)
+    return; // Receive offload is not supported by this kernel.
+
+  char send_data[300];
+  for (size_t i = 0; i < sizeof(send_data); ++i)
+    send_data[i] = static_cast<char>('A' + i % 26);
+
+  s2.async_send_segments_to(buffer(send_data), 100, target_endpoint,
+      bindns::bind(handle_segments_send, sizeof(send_data), _1, _2));
+  ioc.run();
+  ioc.restart();
+
+  // The datagrams may arrive coalesced or separately, but each segment is the
+  // size of one sent datagram.
+  char recv_data[sizeof(send_data)];
+  size_t total_bytes = 0;
+  bool sizes_ok = true;
+  while (total_bytes < sizeof(send_data) && sizes_ok)
+  {
+    s1.async_receive_coalesced(buffer(recv_data + total_bytes,
+          sizeof(recv_data) - total_bytes),
+        bindns::bind(handle_coalesced_recv, _1, _2, _3,
+          &total_bytes, &sizes_ok));
+    ioc.run();
+    ioc.restart();
+  }
+
+  ASIO_CHECK(sizes_ok);
+  ASIO_CHECK(total_bytes == sizeof(send_data));
+  ASIO_CHECK(memcmp(recv_data, send_data, sizeof(send_data)) == 0);
+}
+
+#else // defined(ASIO_HAS_UDP_OFFLOAD)
+
+void test_offload()
+{
+}
+
+#endif // defined(ASIO_HAS_UDP_OFFLOAD)
+
+#if !defined(ASIO_HAS_IOCP) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
+struct inline_recv_state
+{
+  asio::ip::udp::socket* socket;
+  char* data;
+  size_t data_size;
+  int remaining;
+  int received;
+  int nesting;
+  int max_nesting;
+
+  void start();
+};
+
+struct inline_recv_handler
+{
+  inline_recv_state* state;
+
+  void operator()(const asio::error_code& err, size_t) const
+  {
+    ASIO_CHECK(!err);
+    ++state->received;
+    if (state->nesting > state->max_nesting)
+      state->max_nesting = state->nesting;
+    if (--state->remaining > 0)
+      state->start();
+  }
+};
+
+// Track how deeply the handlers are nested within initiating functions.
+void inline_recv_state::start()
+{
+  inline_recv_handler handler = { this };
+  ++nesting;
+  socket->async_receive(asio::buffer(data, data_size), handler);
+  --nesting;
+}
+
+void test_inline_completion()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  const int message_count = 40;
+
+  for (int enabled = 0; enabled < 2; ++enabled)
+  {
+    io_context ioc;
+
+    ip::udp::socket s1(ioc, ip::udp::endpoint(ip::udp::v4(), 0));
+    ip::udp::endpoint target_endpoint = s1.local_endpoint();
+    target_endpoint.address(ip::address_v4::loopback());
+    s1.set_option(socket_base::inline_completion(enabled != 0));
+
+    socket_base::inline_completion option;
+    s1.get_option(option);
+    ASIO_CHECK(option.value() == (enabled != 0));
+
+    ip::udp::socket s2(ioc, ip::udp::endpoint(ip::udp::v4(), 0));
+    const char send_msg[] = "0123456789";
+    for (int i = 0; i < message_count; ++i)
+      s2.send_to(buffer(send_msg, sizeof(send_msg)), target_endpoint);
+
+    char recv_msg[sizeof(send_msg)];
+    inline_recv_state chain = { &s1, recv_msg, sizeof(recv_msg),
+      message_count, 0, 0, 0 };
+
+    // A receive started outside the I/O context's threads is never completed
+    // from within the initiating function.
+    chain.start();
+    ASIO_CHECK(chain.received == 0);
+
+    ioc.run();
+
+    ASIO_CHECK(chain.received == message_count);
+    if (enabled)
+    {
+      // Nested invocations are bounded, with the rest posted as usual.
+      ASIO_CHECK(chain.max_nesting > 0);
+      ASIO_CHECK(chain.max_nesting < message_count);
+    }
+    else
+    {
+      ASIO_CHECK(chain.max_nesting == 0);
+    }
+  }
+}
+
+#else // !defined(ASIO_HAS_IOCP)
+      //   && !defined(ASIO_WINDOWS_RUNTIME)
+      //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
+void test_inline_completion()
+{
+}
+
+#endif // !defined(ASIO_HAS_IOCP)
+       //   && !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
 } // namespace ip_udp_socket_runtime
 
 //------------------------------------------------------------------------------
@@ -671,5 +1202,10 @@ ASIO_TEST_SUITE
   "ip/udp",
   ASIO_COMPILE_TEST_CASE(ip_udp_socket_compile::test)
   ASIO_TEST_CASE(ip_udp_socket_runtime::test)
+  ASIO_TEST_CASE(ip_udp_socket_runtime::test_deferred_registration)
+  ASIO_TEST_CASE(ip_udp_socket_runtime::test_batch)
+  ASIO_TEST_CASE(ip_udp_socket_runtime::test_packet_info)
+  ASIO_TEST_CASE(ip_udp_socket_runtime::test_offload)
+  ASIO_TEST_CASE(ip_udp_socket_runtime::test_inline_completion)
   ASIO_COMPILE_TEST_CASE(ip_udp_resolver_compile::test)
 )
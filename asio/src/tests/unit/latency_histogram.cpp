@@ -0,0 +1,123 @@
+//
+// latency_histogram.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/latency_histogram.hpp"
+
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "unit_test.hpp"
+
+using asio::latency_histogram;
+using asio::chrono::nanoseconds;
+
+void latency_histogram_bucket_test()
+{
+  for (std::size_t i = 0; i < latency_histogram::num_buckets; ++i)
+  {
+    nanoseconds lower = latency_histogram::bucket_lower_bound(i);
+    nanoseconds upper = latency_histogram::bucket_upper_bound(i);
+    ASIO_CHECK(lower <= upper);
+    ASIO_CHECK(latency_histogram::bucket_index(lower) == i);
+    ASIO_CHECK(latency_histogram::bucket_index(upper) == i);
+    if (i + 1 < latency_histogram::num_buckets)
+    {
+      ASIO_CHECK(latency_histogram::bucket_lower_bound(i + 1)
+          == upper + nanoseconds(1));
+    }
+
+    // Each bucket is no wider than 1/16 of its lower bound.
+    ASIO_CHECK((upper - lower).count() * 16 <= lower.count() || i < 16);
+  }
+
+  ASIO_CHECK(latency_histogram::bucket_index(nanoseconds(-1)) == 0);
+  ASIO_CHECK(latency_histogram::bucket_index(nanoseconds(15)) == 15);
+  ASIO_CHECK(latency_histogram::bucket_index(nanoseconds(16)) == 16);
+  ASIO_CHECK(latency_histogram::bucket_index(
+        nanoseconds(static_cast<nanoseconds::rep>(1) << 62))
+      == latency_histogram::num_buckets - 1);
+}
+
+void latency_histogram_statistics_test()
+{
+  latency_histogram h;
+  ASIO_CHECK(h.total_count() == 0);
+  ASIO_CHECK(h.min_value() == nanoseconds(0));
+  ASIO_CHECK(h.max_value() == nanoseconds(0));
+  ASIO_CHECK(h.mean() == nanoseconds(0));
+  ASIO_CHECK(h.value_at_percentile(50) == nanoseconds(0));
+
+  for (int i = 1; i <= 100; ++i)
+    h.record(nanoseconds(i * 1000));
+  ASIO_CHECK(h.total_count() == 100);
+
+  ASIO_CHECK(h.min_value() <= nanoseconds(1000));
+  ASIO_CHECK(h.min_value() * 16 >= nanoseconds(15 * 1000));
+  ASIO_CHECK(h.max_value() >= nanoseconds(100000));
+  ASIO_CHECK(h.max_value() * 15 <= nanoseconds(16 * 100000));
+
+  nanoseconds p50 = h.value_at_percentile(50);
+  ASIO_CHECK(p50 >= nanoseconds(50000));
+  ASIO_CHECK(p50 * 15 <= nanoseconds(16 * 50000));
+
+  nanoseconds p99 = h.value_at_percentile(99);
+  ASIO_CHECK(p99 >= nanoseconds(99000));
+  ASIO_CHECK(p99 <= h.max_value());
+  ASIO_CHECK(h.value_at_percentile(100) == h.max_value());
+
+  nanoseconds mean = h.mean();
+  ASIO_CHECK(mean * 16 >= nanoseconds(15 * 50500));
+  ASIO_CHECK(mean * 15 <= nanoseconds(16 * 50500));
+
+  latency_histogram h2;
+  h2.record(nanoseconds(5), 3);
+  ASIO_CHECK(h2.bucket_count(5) == 3);
+  h2 += h;
+  ASIO_CHECK(h2.total_count() == 103);
+  ASIO_CHECK(h2.min_value() == nanoseconds(5));
+  ASIO_CHECK(h2.max_value() == h.max_value());
+}
+
+void latency_histogram_io_context_test()
+{
+  asio::io_context ioc;
+  for (int i = 0; i < 10; ++i)
+    asio::post(ioc, []{});
+  ioc.run();
+
+  asio::io_context::operation_latency l =
+    ioc.get_operation_latency(asio::io_context::post_operation);
+
+#if defined(ASIO_ENABLE_LATENCY_HISTOGRAMS) && !defined(ASIO_HAS_IOCP)
+  ASIO_CHECK(l.completion.total_count() == 10);
+  ASIO_CHECK(l.completion.max_value() == nanoseconds(0));
+  ASIO_CHECK(l.invocation.total_count() == 10);
+#else // defined(ASIO_ENABLE_LATENCY_HISTOGRAMS) && !defined(ASIO_HAS_IOCP)
+  ASIO_CHECK(l.completion.total_count() == 0);
+  ASIO_CHECK(l.invocation.total_count() == 0);
+#endif // defined(ASIO_ENABLE_LATENCY_HISTOGRAMS) && !defined(ASIO_HAS_IOCP)
+
+  l = ioc.get_operation_latency(asio::io_context::receive_operation);
+  ASIO_CHECK(l.completion.total_count() == 0);
+  ASIO_CHECK(l.invocation.total_count() == 0);
+}
+
+ASIO_TEST_SUITE
+(
+  "latency_histogram",
+  ASIO_TEST_CASE(latency_histogram_bucket_test)
+  ASIO_TEST_CASE(latency_histogram_statistics_test)
+  ASIO_TEST_CASE(latency_histogram_io_context_test)
+)
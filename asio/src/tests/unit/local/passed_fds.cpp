@@ -0,0 +1,221 @@
+//
+// passed_fds.cpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/local/passed_fds.hpp"
+
+#include "../unit_test.hpp"
+
+#if defined(ASIO_HAS_FD_PASSING)
+
+#include <cstring>
+#include <unistd.h>
+#include "asio/io_context.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/datagram_protocol.hpp"
+#include "asio/local/stream_protocol.hpp"
+
+//------------------------------------------------------------------------------
+
+// local_passed_fds_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following tests check that file descriptors and credentials are passed
+// between connected local sockets.
+
+namespace local_passed_fds_runtime {
+
+struct result
+{
+  result() : called(false), bytes(0) {}
+  bool called;
+  asio::error_code ec;
+  std::size_t bytes;
+};
+
+struct handler
+{
+  result* r;
+
+  void operator()(const asio::error_code& ec, std::size_t bytes) const
+  {
+    r->called = true;
+    r->ec = ec;
+    r->bytes = bytes;
+  }
+};
+
+// Check that a received pipe descriptor refers to the sent pipe.
+void check_pipe(int received_write_end, int read_end)
+{
+  ASIO_CHECK(::write(received_write_end, "x", 1) == 1);
+  char c = 0;
+  ASIO_CHECK(::read(read_end, &c, 1) == 1);
+  ASIO_CHECK(c == 'x');
+}
+
+template <typename Socket>
+void test_pass(Socket& socket1, Socket& socket2, asio::io_context& ioc)
+{
+  int pipe_fds[2];
+  ASIO_CHECK(::pipe(pipe_fds) == 0);
+
+  asio::local::passed_fds out_fds;
+  ASIO_CHECK(out_fds.push_back(pipe_fds[1]));
+  ASIO_CHECK(out_fds.push_back(pipe_fds[1]));
+
+  char out_data[] = "hello";
+  char in_data[16] = "";
+  asio::local::passed_fds in_fds;
+
+  result send_result, recv_result;
+  handler send_handler = { &send_result };
+  handler recv_handler = { &recv_result };
+  socket2.async_receive_fds(asio::buffer(in_data), in_fds, recv_handler);
+  socket1.async_send_fds(asio::buffer(out_data, 5), out_fds, send_handler);
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(send_result.called);
+  ASIO_CHECK(!send_result.ec);
+  ASIO_CHECK(send_result.bytes == 5);
+  ASIO_CHECK(recv_result.called);
+  ASIO_CHECK(!recv_result.ec);
+  ASIO_CHECK(recv_result.bytes == 5);
+  ASIO_CHECK(std::memcmp(in_data, "hello", 5) == 0);
+  ASIO_CHECK(in_fds.count == 2);
+  ASIO_CHECK(!in_fds.truncated);
+
+  for (std::size_t i = 0; i < in_fds.count; ++i)
+  {
+    ASIO_CHECK(in_fds.fds[i] != pipe_fds[1]);
+    check_pipe(in_fds.fds[i], pipe_fds[0]);
+    ::close(in_fds.fds[i]);
+  }
+
+  ::close(pipe_fds[0]);
+  ::close(pipe_fds[1]);
+}
+
+void test_stream()
+{
+  asio::io_context ioc;
+  asio::local::stream_protocol::socket socket1(ioc), socket2(ioc);
+  asio::local::connect_pair(socket1, socket2);
+
+  test_pass(socket1, socket2, ioc);
+
+  // Data sent without descriptors is received with none.
+  char out_data[] = "abc";
+  char in_data[16] = "";
+  asio::local::passed_fds out_fds, in_fds;
+  result send_result, recv_result;
+  handler send_handler = { &send_result };
+  handler recv_handler = { &recv_result };
+  socket1.async_send_fds(asio::buffer(out_data, 3), out_fds, send_handler);
+  socket2.async_receive_fds(asio::buffer(in_data), in_fds, recv_handler);
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(!send_result.ec);
+  ASIO_CHECK(!recv_result.ec);
+  ASIO_CHECK(recv_result.bytes == 3);
+  ASIO_CHECK(in_fds.count == 0);
+
+  // The end of the stream is reported as eof.
+  socket1.close();
+  result eof_result;
+  handler eof_handler = { &eof_result };
+  socket2.async_receive_fds(asio::buffer(in_data), in_fds, eof_handler);
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(eof_result.called);
+  ASIO_CHECK(eof_result.ec == asio::error::eof);
+}
+
+void test_datagram()
+{
+  asio::io_context ioc;
+  asio::local::datagram_protocol::socket socket1(ioc), socket2(ioc);
+  asio::local::connect_pair(socket1, socket2);
+
+  test_pass(socket1, socket2, ioc);
+}
+
+void test_credentials()
+{
+#if defined(SO_PASSCRED)
+  asio::io_context ioc;
+  asio::local::stream_protocol::socket socket1(ioc), socket2(ioc);
+  asio::local::connect_pair(socket1, socket2);
+
+  socket2.set_option(asio::local::pass_credentials(true));
+  asio::local::pass_credentials option;
+  socket2.get_option(option);
+  ASIO_CHECK(option.value());
+
+  char out_data[] = "x";
+  char in_data[4] = "";
+  asio::local::passed_fds out_fds, in_fds;
+  result send_result, recv_result;
+  handler send_handler = { &send_result };
+  handler recv_handler = { &recv_result };
+  socket1.async_send_fds(asio::buffer(out_data, 1), out_fds, send_handler);
+  socket2.async_receive_fds(asio::buffer(in_data), in_fds, recv_handler);
+
+  ioc.run();
+
+  ASIO_CHECK(!send_result.ec);
+  ASIO_CHECK(!recv_result.ec);
+  ASIO_CHECK(in_fds.has_credentials);
+  ASIO_CHECK(in_fds.pid == ::getpid());
+  ASIO_CHECK(in_fds.uid == ::getuid());
+  ASIO_CHECK(in_fds.gid == ::getgid());
+#endif // defined(SO_PASSCRED)
+}
+
+void test_too_many()
+{
+  asio::local::passed_fds out_fds;
+  for (std::size_t i = 0; i < asio::local::passed_fds::max_fds; ++i)
+    ASIO_CHECK(out_fds.push_back(0));
+  ASIO_CHECK(!out_fds.push_back(0));
+}
+
+} // namespace local_passed_fds_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "local/passed_fds",
+  ASIO_TEST_CASE(local_passed_fds_runtime::test_stream)
+  ASIO_TEST_CASE(local_passed_fds_runtime::test_datagram)
+  ASIO_TEST_CASE(local_passed_fds_runtime::test_credentials)
+  ASIO_TEST_CASE(local_passed_fds_runtime::test_too_many)
+)
+
+#else // defined(ASIO_HAS_FD_PASSING)
+
+ASIO_TEST_SUITE
+(
+  "local/passed_fds",
+  ASIO_TEST_CASE(null_test)
+)
+
+#endif // defined(ASIO_HAS_FD_PASSING)
@@ -0,0 +1,326 @@
+//
+// shm_stream.cpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/local/shm_stream.hpp"
+
+#include "../unit_test.hpp"
+
+#if defined(ASIO_HAS_SHM_STREAM)
+
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+
+//------------------------------------------------------------------------------
+
+// local_shm_stream_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following tests check the runtime operation of the local::shm_stream
+// class.
+
+namespace local_shm_stream_runtime {
+
+struct result
+{
+  result() : called(false), bytes(0) {}
+  bool called;
+  asio::error_code ec;
+  std::size_t bytes;
+};
+
+struct handler
+{
+  result* r;
+
+  void operator()(const asio::error_code& ec, std::size_t bytes) const
+  {
+    r->called = true;
+    r->ec = ec;
+    r->bytes = bytes;
+  }
+};
+
+std::vector<char> make_data(std::size_t size)
+{
+  std::vector<char> data(size);
+  for (std::size_t i = 0; i < size; ++i)
+    data[i] = static_cast<char>(i * 7 + i / 251);
+  return data;
+}
+
+void test_async_transfer()
+{
+  asio::io_context ioc;
+  asio::local::shm_stream stream1(ioc), stream2(ioc);
+  asio::local::connect_pair(stream1, stream2, 4096);
+
+  ASIO_CHECK(stream1.is_open());
+  ASIO_CHECK(stream2.is_open());
+  ASIO_CHECK(stream1.capacity() >= 4096);
+  ASIO_CHECK(stream1.capacity() == stream2.capacity());
+
+  // Transfer more data than fits in the ring in both directions at once.
+  std::vector<char> out_data = make_data(256 * 1024 + 17);
+  std::vector<char> in_data1(out_data.size());
+  std::vector<char> in_data2(out_data.size());
+
+  result write1, write2, read1, read2;
+  handler write1_handler = { &write1 };
+  handler write2_handler = { &write2 };
+  handler read1_handler = { &read1 };
+  handler read2_handler = { &read2 };
+  asio::async_read(stream2, asio::buffer(in_data2), read2_handler);
+  asio::async_write(stream1, asio::buffer(out_data), write1_handler);
+  asio::async_write(stream2, asio::buffer(out_data), write2_handler);
+  asio::async_read(stream1, asio::buffer(in_data1), read1_handler);
+
+  ASIO_CHECK(!write1.called);
+  ASIO_CHECK(!read2.called);
+
+  ioc.run();
+
+  ASIO_CHECK(write1.called);
+  ASIO_CHECK(!write1.ec);
+  ASIO_CHECK(write1.bytes == out_data.size());
+  ASIO_CHECK(write2.called);
+  ASIO_CHECK(!write2.ec);
+  ASIO_CHECK(read1.called);
+  ASIO_CHECK(!read1.ec);
+  ASIO_CHECK(read1.bytes == out_data.size());
+  ASIO_CHECK(read2.called);
+  ASIO_CHECK(!read2.ec);
+  ASIO_CHECK(in_data1 == out_data);
+  ASIO_CHECK(in_data2 == out_data);
+}
+
+void test_sync_transfer()
+{
+  asio::io_context ioc;
+  asio::local::shm_stream stream1(ioc), stream2(ioc);
+  asio::local::connect_pair(stream1, stream2, 4096);
+
+  std::vector<char> out_data = make_data(1024 * 1024);
+  std::vector<char> in_data(out_data.size());
+
+  std::thread writer(
+      [&]
+      {
+        asio::write(stream1, asio::buffer(out_data));
+      });
+
+  std::size_t n = asio::read(stream2, asio::buffer(in_data));
+  writer.join();
+
+  ASIO_CHECK(n == out_data.size());
+  ASIO_CHECK(in_data == out_data);
+}
+
+void test_close()
+{
+  asio::io_context ioc;
+  asio::local::shm_stream stream1(ioc), stream2(ioc);
+  asio::local::connect_pair(stream1, stream2);
+
+  asio::write(stream1, asio::buffer("hello", 5));
+
+  // A pending read on the peer completes with the remaining data, then eof.
+  char in_data[16];
+  result read1, read2;
+  handler read1_handler = { &read1 };
+  handler read2_handler = { &read2 };
+  stream1.close();
+  ASIO_CHECK(!stream1.is_open());
+  stream2.async_read_some(asio::buffer(in_data), read1_handler);
+  ioc.run();
+
+  ASIO_CHECK(read1.called);
+  ASIO_CHECK(!read1.ec);
+  ASIO_CHECK(read1.bytes == 5);
+  ASIO_CHECK(std::memcmp(in_data, "hello", 5) == 0);
+
+  stream2.async_read_some(asio::buffer(in_data), read2_handler);
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(read2.called);
+  ASIO_CHECK(read2.ec == asio::error::eof);
+
+  asio::error_code ec;
+  stream2.write_some(asio::buffer("x", 1), ec);
+  ASIO_CHECK(ec == asio::error::broken_pipe);
+
+  stream1.read_some(asio::buffer(in_data), ec);
+  ASIO_CHECK(ec == asio::error::bad_descriptor);
+}
+
+void test_wake_on_close()
+{
+  asio::io_context ioc;
+  asio::local::shm_stream stream1(ioc), stream2(ioc);
+  asio::local::connect_pair(stream1, stream2);
+
+  char in_data[16];
+  result read;
+  handler read_handler = { &read };
+  stream2.async_read_some(asio::buffer(in_data), read_handler);
+  ioc.poll();
+  ASIO_CHECK(!read.called);
+
+  stream1.close();
+  ioc.run();
+
+  ASIO_CHECK(read.called);
+  ASIO_CHECK(read.ec == asio::error::eof);
+}
+
+void test_simultaneous_waits()
+{
+  asio::io_context ioc;
+  asio::local::shm_stream stream1(ioc), stream2(ioc);
+  asio::local::connect_pair(stream1, stream2, 4096);
+
+  // Fill the ring so that a write on stream1 must wait for space, while a read
+  // on the same end waits for data.
+  std::vector<char> fill = make_data(stream1.capacity());
+  ASIO_CHECK(asio::write(stream1, asio::buffer(fill)) == fill.size());
+
+  char out_data[8] = "abcdefg";
+  char in_data[16];
+  result write, read;
+  handler write_handler = { &write };
+  handler read_handler = { &read };
+  stream1.async_write_some(asio::buffer(out_data), write_handler);
+  stream1.async_read_some(asio::buffer(in_data), read_handler);
+  ioc.poll();
+  ASIO_CHECK(!write.called);
+  ASIO_CHECK(!read.called);
+
+  // Data from the peer wakes only the read.
+  asio::write(stream2, asio::buffer("ping", 4));
+  while (!read.called)
+    ioc.run_one();
+  ASIO_CHECK(!read.ec);
+  ASIO_CHECK(read.bytes == 4);
+  ASIO_CHECK(std::memcmp(in_data, "ping", 4) == 0);
+  ioc.poll();
+  ASIO_CHECK(!write.called);
+
+  // Space made by the peer wakes the write.
+  std::vector<char> drained(fill.size());
+  ASIO_CHECK(asio::read(stream2, asio::buffer(drained)) == drained.size());
+  ASIO_CHECK(drained == fill);
+  while (!write.called)
+    ioc.run_one();
+  ASIO_CHECK(!write.ec);
+  ASIO_CHECK(write.bytes == sizeof(out_data));
+}
+
+void test_cancel()
+{
+  asio::io_context ioc;
+  asio::local::shm_stream stream1(ioc), stream2(ioc);
+  asio::local::connect_pair(stream1, stream2);
+
+  char in_data[16];
+  result read;
+  handler read_handler = { &read };
+  stream2.async_read_some(asio::buffer(in_data), read_handler);
+  ioc.poll();
+  ASIO_CHECK(!read.called);
+
+  stream2.cancel();
+  ioc.run();
+
+  ASIO_CHECK(read.called);
+  ASIO_CHECK(read.ec == asio::error::operation_aborted);
+}
+
+void test_attach()
+{
+  asio::io_context ioc;
+  asio::local::stream_protocol::socket socket1(ioc), socket2(ioc);
+  asio::local::connect_pair(socket1, socket2);
+
+  // Pass the creating end's descriptors over a socket, as a peer process
+  // would receive them.
+  asio::local::shm_stream stream1(ioc), stream2(ioc);
+  stream1.create(8192);
+  asio::local::passed_fds handles = stream1.handles();
+  ASIO_CHECK(handles.count == 5);
+
+  char byte = 0;
+  asio::local::passed_fds received;
+  result send, receive;
+  handler send_handler = { &send };
+  handler receive_handler = { &receive };
+  socket1.async_send_fds(asio::buffer(&byte, 1), handles, send_handler);
+  socket2.async_receive_fds(asio::buffer(&byte, 1), received, receive_handler);
+  ioc.run();
+
+  ASIO_CHECK(!send.ec);
+  ASIO_CHECK(!receive.ec);
+  ASIO_CHECK(received.count == 5);
+
+  stream2.attach(received);
+  ASIO_CHECK(stream2.is_open());
+  ASIO_CHECK(stream2.capacity() == stream1.capacity());
+
+  char in_data[16];
+  asio::write(stream2, asio::buffer("ping", 4));
+  ASIO_CHECK(asio::read(stream1, asio::buffer(in_data, 4)) == 4);
+  ASIO_CHECK(std::memcmp(in_data, "ping", 4) == 0);
+  asio::write(stream1, asio::buffer("pong", 4));
+  ASIO_CHECK(asio::read(stream2, asio::buffer(in_data, 4)) == 4);
+  ASIO_CHECK(std::memcmp(in_data, "pong", 4) == 0);
+
+  asio::local::passed_fds bad;
+  asio::local::shm_stream stream3(ioc);
+  asio::error_code ec;
+  stream3.attach(bad, ec);
+  ASIO_CHECK(ec == asio::error::invalid_argument);
+  ASIO_CHECK(!stream3.is_open());
+}
+
+} // namespace local_shm_stream_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "local/shm_stream",
+  ASIO_TEST_CASE(local_shm_stream_runtime::test_async_transfer)
+  ASIO_TEST_CASE(local_shm_stream_runtime::test_sync_transfer)
+  ASIO_TEST_CASE(local_shm_stream_runtime::test_close)
+  ASIO_TEST_CASE(local_shm_stream_runtime::test_wake_on_close)
+  ASIO_TEST_CASE(local_shm_stream_runtime::test_simultaneous_waits)
+  ASIO_TEST_CASE(local_shm_stream_runtime::test_cancel)
+  ASIO_TEST_CASE(local_shm_stream_runtime::test_attach)
+)
+
+#else // defined(ASIO_HAS_SHM_STREAM)
+
+ASIO_TEST_SUITE
+(
+  "local/shm_stream",
+  ASIO_TEST_CASE(null_test)
+)
+
+#endif // defined(ASIO_HAS_SHM_STREAM)
@@ -0,0 +1,326 @@
+//
+// mapped_file.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/mapped_file.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "archetypes/async_result.hpp"
+#include "asio/connect_pipe.hpp"
+#include "asio/io_context.hpp"
+#include "asio/read.hpp"
+#include "asio/readable_pipe.hpp"
+#include "asio/writable_pipe.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_MAPPED_FILE) && !defined(ASIO_WINDOWS)
+# include <stdlib.h>
+# include <unistd.h>
+#endif // defined(ASIO_HAS_MAPPED_FILE) && !defined(ASIO_WINDOWS)
+
+#if defined(ASIO_HAS_MAPPED_FILE)
+
+//------------------------------------------------------------------------------
+
+// mapped_file_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// mapped_file compile and link correctly. Runtime failures are ignored.
+
+namespace mapped_file_compile {
+
+struct prefetch_handler
+{
+  prefetch_handler() {}
+  void operator()(const asio::error_code&) {}
+  prefetch_handler(prefetch_handler&&) {}
+private:
+  prefetch_handler(const prefetch_handler&);
+};
+
+void test()
+{
+  using namespace asio;
+
+  try
+  {
+    io_context ioc;
+    const io_context::executor_type ioc_ex = ioc.get_executor();
+    archetypes::lazy_handler lazy;
+    asio::error_code ec;
+    const std::string path;
+
+    // mapped_file constructors.
+
+    mapped_file file1;
+    mapped_file file2("");
+    mapped_file file3(path);
+    mapped_file file4(std::move(file3));
+
+    // mapped_file operators.
+
+    file1 = mapped_file();
+    file1 = std::move(file2);
+
+    // mapped_file functions.
+
+    file1.open("");
+    file1.open("", ec);
+    file1.open(path);
+    file1.open(path, ec);
+
+    bool b = file1.is_open();
+    (void)b;
+
+    file1.close();
+    file1.close(ec);
+
+    mapped_file::native_handle_type h = file1.native_handle();
+    (void)h;
+
+    const void* p = file1.data();
+    (void)p;
+
+    std::size_t s1 = file1.size();
+    (void)s1;
+
+    const_buffer cb1 = file1.view(0, 1024);
+    (void)cb1;
+
+    file1.advise(mapped_file::sequential);
+    file1.advise(mapped_file::will_need, 0, 1024);
+    file1.advise(mapped_file::dont_need, 0, 1024, ec);
+
+    file1.prefetch(0, 1024);
+
+    file1.async_prefetch(ioc_ex, 0, 1024, prefetch_handler());
+    int i1 = file1.async_prefetch(ioc_ex, 0, 1024, lazy);
+    (void)i1;
+
+    std::size_t s2 = mapped_file::page_size();
+    (void)s2;
+
+    const_buffer cb2 = asio::buffer(file1);
+    (void)cb2;
+    const_buffer cb3 = asio::buffer(file1, 1024);
+    (void)cb3;
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace mapped_file_compile
+
+//------------------------------------------------------------------------------
+
+// mapped_file_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the mapped_file class.
+
+namespace mapped_file_runtime {
+
+#if !defined(ASIO_WINDOWS)
+
+// Holds a temporary file containing the test data.
+struct temporary_file
+{
+  explicit temporary_file(const std::vector<char>& data)
+  {
+    char name[] = "/tmp/asio_mapped_file_XXXXXX";
+    int fd = ::mkstemp(name);
+    std::size_t written = 0;
+    while (fd != -1 && written < data.size())
+    {
+      ssize_t n = ::write(fd, &data[written], data.size() - written);
+      if (n <= 0)
+        break;
+      written += static_cast<std::size_t>(n);
+    }
+    if (fd != -1)
+      ::close(fd);
+    path = name;
+  }
+
+  ~temporary_file()
+  {
+    std::remove(path.c_str());
+  }
+
+  std::string path;
+};
+
+std::vector<char> make_data(std::size_t size)
+{
+  std::vector<char> data(size);
+  for (std::size_t i = 0; i < size; ++i)
+    data[i] = static_cast<char>(i % 251);
+  return data;
+}
+
+void test_view()
+{
+  std::vector<char> data = make_data(3 * asio::mapped_file::page_size() + 5);
+  temporary_file tmp(data);
+
+  asio::mapped_file file(tmp.path);
+  ASIO_CHECK(file.is_open());
+  ASIO_CHECK(file.native_handle() != -1);
+  ASIO_CHECK(file.size() == data.size());
+  ASIO_CHECK(std::memcmp(file.data(), data.data(), data.size()) == 0);
+
+  asio::const_buffer b1 = file.view(10, 20);
+  ASIO_CHECK(b1.data() == static_cast<const char*>(file.data()) + 10);
+  ASIO_CHECK(b1.size() == 20);
+
+  // Windows are clamped to the end of the file.
+  asio::const_buffer b2 = file.view(data.size() - 5, 1024);
+  ASIO_CHECK(b2.size() == 5);
+  asio::const_buffer b3 = file.view(data.size(), 1024);
+  ASIO_CHECK(b3.size() == 0);
+
+  ASIO_CHECK(asio::buffer(file).size() == data.size());
+  ASIO_CHECK(asio::buffer(file, 7).size() == 7);
+
+  asio::error_code ec;
+  file.advise(asio::mapped_file::sequential, 0, data.size(), ec);
+  ASIO_CHECK(!ec);
+  file.advise(asio::mapped_file::will_need, 3, 100, ec);
+  ASIO_CHECK(!ec);
+  file.advise(asio::mapped_file::random, data.size() + 1, 100, ec);
+  ASIO_CHECK(!ec);
+  file.prefetch(1, data.size());
+
+  // A moved-from file no longer refers to the mapping.
+  asio::mapped_file file2(std::move(file));
+  ASIO_CHECK(!file.is_open());
+  ASIO_CHECK(file.size() == 0);
+  ASIO_CHECK(file2.size() == data.size());
+
+  file2.open(tmp.path, ec);
+  ASIO_CHECK(ec == asio::error::already_open);
+
+  file2.close();
+  ASIO_CHECK(!file2.is_open());
+  ASIO_CHECK(file2.data() == 0);
+}
+
+void test_empty_and_missing()
+{
+  temporary_file tmp((std::vector<char>()));
+
+  asio::mapped_file file(tmp.path);
+  ASIO_CHECK(file.is_open());
+  ASIO_CHECK(file.size() == 0);
+  ASIO_CHECK(file.view(0, 10).size() == 0);
+  file.close();
+
+  asio::error_code ec;
+  file.open(tmp.path + ".missing", ec);
+  ASIO_CHECK(!!ec);
+  ASIO_CHECK(!file.is_open());
+}
+
+void test_async()
+{
+  std::vector<char> data = make_data(256 * 1024);
+  temporary_file tmp(data);
+  asio::mapped_file file(tmp.path);
+
+  asio::io_context ioc;
+  asio::error_code prefetch_ec = asio::error::would_block;
+  file.async_prefetch(ioc.get_executor(), 0, file.size(),
+      [&](const asio::error_code& ec){ prefetch_ec = ec; });
+  ASIO_CHECK(prefetch_ec == asio::error::would_block);
+  ioc.run();
+  ASIO_CHECK(!prefetch_ec);
+
+  // The mapped memory is written to a pipe without being copied first.
+  asio::readable_pipe reader(ioc);
+  asio::writable_pipe writer(ioc);
+  asio::connect_pipe(reader, writer);
+
+  asio::error_code write_ec;
+  std::size_t written = 0;
+  asio::async_write(writer, file.view(0, file.size()),
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        write_ec = ec;
+        written = n;
+      });
+
+  std::vector<char> received(data.size());
+  asio::error_code read_ec;
+  asio::async_read(reader, asio::buffer(received),
+      [&](const asio::error_code& ec, std::size_t){ read_ec = ec; });
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(written == data.size());
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(received == data);
+
+  // A file that is not open reports an error.
+  file.close();
+  file.async_prefetch(ioc.get_executor(), 0, 1,
+      [&](const asio::error_code& ec){ prefetch_ec = ec; });
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(prefetch_ec == asio::error::bad_descriptor);
+}
+
+#else // !defined(ASIO_WINDOWS)
+
+void test_view()
+{
+}
+
+void test_empty_and_missing()
+{
+}
+
+void test_async()
+{
+}
+
+#endif // !defined(ASIO_WINDOWS)
+
+} // namespace mapped_file_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "mapped_file",
+  ASIO_COMPILE_TEST_CASE(mapped_file_compile::test)
+  ASIO_TEST_CASE(mapped_file_runtime::test_view)
+  ASIO_TEST_CASE(mapped_file_runtime::test_empty_and_missing)
+  ASIO_TEST_CASE(mapped_file_runtime::test_async)
+)
+
+#else // defined(ASIO_HAS_MAPPED_FILE)
+
+ASIO_TEST_SUITE
+(
+  "mapped_file",
+  ASIO_TEST_CASE(null_test)
+)
+
+#endif // defined(ASIO_HAS_MAPPED_FILE)
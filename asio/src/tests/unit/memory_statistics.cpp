@@ -0,0 +1,130 @@
+//
+// memory_statistics.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/memory_statistics.hpp"
+
+#include "unit_test.hpp"
+#include <atomic>
+#include "asio/config.hpp"
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/registered_buffer_pool.hpp"
+#include "asio/steady_timer.hpp"
+#include "asio/thread_pool.hpp"
+
+void memory_statistics_disabled_test()
+{
+  asio::io_context ioc;
+
+  int count = 0;
+  for (int i = 0; i < 10; ++i)
+    asio::post(ioc, [&count]{ ++count; });
+  ioc.run();
+  ASIO_CHECK(count == 10);
+
+  asio::memory_statistics s = asio::get_memory_statistics(ioc);
+  ASIO_CHECK(!s.enabled);
+  ASIO_CHECK(s.executor_functions.allocations == 0);
+  ASIO_CHECK(s.operations.allocations == 0);
+}
+
+void memory_statistics_handlers_test()
+{
+  asio::io_context ioc(asio::config_from_string("memory.statistics=1"));
+
+  int count = 0;
+  for (int i = 0; i < 10; ++i)
+    asio::post(ioc, [&count]{ ++count; });
+
+  asio::steady_timer timer(ioc, asio::chrono::milliseconds(1));
+  timer.async_wait([&count](asio::error_code){ ++count; });
+
+  ioc.run();
+  ASIO_CHECK(count == 11);
+
+  // Handlers posted from outside the io_context are not counted, but their
+  // deallocations, and the timer operation, are counted by the thread that
+  // runs them.
+  asio::memory_statistics s1 = asio::get_memory_statistics(ioc);
+  ASIO_CHECK(s1.enabled);
+  ASIO_CHECK(s1.operations.deallocations >= 1);
+  ASIO_CHECK(s1.operations.bytes_deallocated > 0);
+
+  // Handlers posted from within the io_context are counted as both allocated
+  // and deallocated.
+  ioc.restart();
+  asio::post(ioc,
+      [&]
+      {
+        for (int i = 0; i < 10; ++i)
+          asio::post(ioc, [&count]{ ++count; });
+      });
+  ioc.run();
+  ASIO_CHECK(count == 21);
+
+  asio::memory_statistics s2 = asio::get_memory_statistics(ioc);
+  ASIO_CHECK(s2.operations.allocations >= s1.operations.allocations + 10);
+  ASIO_CHECK(s2.operations.deallocations >= s1.operations.deallocations + 10);
+  ASIO_CHECK(s2.operations.bytes_allocated > s1.operations.bytes_allocated);
+  ASIO_CHECK(s2.operations.cache_hits > s1.operations.cache_hits);
+  ASIO_CHECK(s2.operations.cache_hits <= s2.operations.allocations);
+}
+
+void memory_statistics_thread_pool_test()
+{
+  asio::thread_pool pool(2, asio::config_from_string("memory.statistics=1"));
+
+  std::atomic<int> count(0);
+  asio::post(pool,
+      [&]
+      {
+        for (int i = 0; i < 10; ++i)
+          asio::post(pool, [&count]{ ++count; });
+      });
+  pool.wait();
+  ASIO_CHECK(count == 10);
+
+  asio::memory_statistics s = asio::get_memory_statistics(pool);
+  ASIO_CHECK(s.enabled);
+  ASIO_CHECK(s.operations.allocations >= 10);
+}
+
+void memory_statistics_registered_buffers_test()
+{
+  asio::io_context ioc(asio::config_from_string("memory.statistics=1"));
+
+  {
+    asio::registered_buffer_pool pool(ioc, 4, 1024);
+
+    asio::memory_statistics s = asio::get_memory_statistics(ioc);
+    ASIO_CHECK(s.registered_buffers.allocations == 1);
+    ASIO_CHECK(s.registered_buffers.bytes_allocated == 4 * 1024);
+    ASIO_CHECK(s.registered_buffers.deallocations == 0);
+  }
+
+  asio::memory_statistics s = asio::get_memory_statistics(ioc);
+  ASIO_CHECK(s.registered_buffers.deallocations == 1);
+  ASIO_CHECK(s.registered_buffers.bytes_deallocated == 4 * 1024);
+}
+
+ASIO_TEST_SUITE
+(
+  "memory_statistics",
+  ASIO_TEST_CASE(memory_statistics_disabled_test)
+  ASIO_TEST_CASE(memory_statistics_handlers_test)
+  ASIO_TEST_CASE(memory_statistics_thread_pool_test)
+  ASIO_TEST_CASE(memory_statistics_registered_buffers_test)
+)
@@ -0,0 +1,212 @@
+//
+// packet_ring.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/packet_ring.hpp"
+
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_PACKET_RING)
+
+#include <cstring>
+#include <functional>
+#include <net/if.h>
+#include "asio/io_context.hpp"
+#include "asio/ip/udp.hpp"
+
+//------------------------------------------------------------------------------
+
+// packet_ring_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// packet_ring compile and link correctly. Runtime failures are ignored.
+
+namespace packet_ring_compile {
+
+void receive_handler(const asio::error_code&, asio::packet_batch)
+{
+}
+
+void test()
+{
+  try
+  {
+    asio::io_context ioc;
+    const asio::io_context::executor_type ioc_ex = ioc.get_executor();
+    asio::error_code ec;
+
+    asio::packet_ring ring1(ioc);
+    asio::packet_ring ring2(ioc_ex);
+
+    asio::packet_ring::ring_parameters params;
+    ring1.open(params);
+    ring2.open(params, ec);
+
+    bool b = ring1.is_open();
+    (void)b;
+
+    std::size_t n = ring1.block_count() + ring1.block_size();
+    (void)n;
+
+    asio::packet_batch batch = ring1.try_receive();
+    for (asio::packet_batch::const_iterator i = batch.begin();
+        i != batch.end(); ++i)
+    {
+      asio::packet_frame frame = *i;
+      asio::const_buffer data = frame.data();
+      (void)data;
+      n = frame.original_size();
+      int index = frame.interface_index();
+      (void)index;
+      unsigned short protocol = frame.protocol();
+      (void)protocol;
+      asio::packet_frame::clock_type::time_point t = frame.timestamp();
+      (void)t;
+    }
+    n = batch.size();
+    b = batch.empty();
+    batch.release();
+
+    ring1.async_receive(&receive_handler);
+
+    ring1.cancel();
+    ring1.close();
+    ring2.close(ec);
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace packet_ring_compile
+
+//------------------------------------------------------------------------------
+
+// packet_ring_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the packet_ring class.
+
+namespace packet_ring_runtime {
+
+void test_not_open()
+{
+  asio::io_context ioc;
+  asio::packet_ring ring(ioc);
+
+  ASIO_CHECK(!ring.is_open());
+  ASIO_CHECK(ring.try_receive().empty());
+
+  asio::error_code result;
+  bool called = false;
+  ring.async_receive(
+      [&](asio::error_code ec, asio::packet_batch batch)
+      {
+        result = ec;
+        called = true;
+        ASIO_CHECK(batch.empty());
+      });
+
+  ASIO_CHECK(!called);
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(result == asio::error::bad_descriptor);
+}
+
+void test_receive()
+{
+  asio::io_context ioc;
+  asio::packet_ring ring(ioc);
+
+  asio::packet_ring::ring_parameters params;
+  params.interface_index = ::if_nametoindex("lo");
+  params.block_size = 64 * 1024;
+  params.block_count = 4;
+  params.block_timeout = 1;
+
+  asio::error_code ec;
+  ring.open(params, ec);
+  if (ec)
+  {
+    // Capturing frames needs privileges that tests may not have.
+    return;
+  }
+
+  ASIO_CHECK(ring.is_open());
+  ASIO_CHECK(ring.block_count() == 4);
+  ASIO_CHECK(ring.block_size() >= 64 * 1024);
+
+  ring.open(params, ec);
+  ASIO_CHECK(ec == asio::error::already_open);
+
+  asio::ip::udp::socket receiver(ioc,
+      asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0));
+  asio::ip::udp::socket sender(ioc, asio::ip::udp::v4());
+
+  const char marker[] = "asio-packet-ring-test";
+  sender.send_to(asio::buffer(marker), receiver.local_endpoint());
+
+  bool found = false;
+  int batches = 0;
+  std::function<void(asio::error_code, asio::packet_batch)> handler =
+    [&](asio::error_code ec, asio::packet_batch batch)
+    {
+      ASIO_CHECK(!ec);
+      if (ec)
+        return;
+
+      ++batches;
+      for (asio::packet_frame frame : batch)
+      {
+        asio::const_buffer data = frame.data();
+        ASIO_CHECK(data.size() <= frame.original_size());
+        const char* p = static_cast<const char*>(data.data());
+        for (std::size_t i = 0; i + sizeof(marker) <= data.size(); ++i)
+          if (std::memcmp(p + i, marker, sizeof(marker)) == 0)
+            found = true;
+      }
+
+      if (!found && batches < 100)
+        ring.async_receive(handler);
+    };
+
+  ring.async_receive(handler);
+  ioc.run_for(asio::chrono::seconds(5));
+
+  ASIO_CHECK(found);
+  ring.close();
+  ASIO_CHECK(!ring.is_open());
+}
+
+} // namespace packet_ring_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "packet_ring",
+  ASIO_COMPILE_TEST_CASE(packet_ring_compile::test)
+  ASIO_TEST_CASE(packet_ring_runtime::test_not_open)
+  ASIO_TEST_CASE(packet_ring_runtime::test_receive)
+)
+
+#else // defined(ASIO_HAS_PACKET_RING)
+
+ASIO_TEST_SUITE
+(
+  "packet_ring",
+  ASIO_TEST_CASE(null_test)
+)
+
+#endif // defined(ASIO_HAS_PACKET_RING)
@@ -0,0 +1,165 @@
+//
+// parallel_for.cpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/parallel_for.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/thread_pool.hpp"
+#include "asio/use_future.hpp"
+#include "unit_test.hpp"
+
+void parallel_for_thread_pool_test()
+{
+  asio::thread_pool pool(4);
+
+  std::vector<std::atomic<int>> counts(1000);
+  for (std::size_t i = 0; i < counts.size(); ++i)
+    counts[i] = 0;
+
+  bool called = false;
+  std::exception_ptr error = std::make_exception_ptr(0);
+  asio::parallel_for(pool.get_executor(), counts.size(),
+      [&counts](std::size_t i)
+      {
+        ++counts[i];
+      },
+      [&](std::exception_ptr e)
+      {
+        called = true;
+        error = e;
+      });
+
+  pool.wait();
+
+  ASIO_CHECK(called);
+  ASIO_CHECK(!error);
+  for (std::size_t i = 0; i < counts.size(); ++i)
+    ASIO_CHECK(counts[i] == 1);
+}
+
+void parallel_for_empty_test()
+{
+  asio::thread_pool pool(2);
+
+  int calls = 0;
+  bool called = false;
+  asio::parallel_for(pool, 0,
+      [&calls](std::size_t)
+      {
+        ++calls;
+      },
+      [&called](std::exception_ptr)
+      {
+        called = true;
+      });
+
+  pool.wait();
+
+  ASIO_CHECK(calls == 0);
+  ASIO_CHECK(called);
+}
+
+void parallel_for_exception_test()
+{
+#if !defined(ASIO_NO_EXCEPTIONS)
+  asio::thread_pool pool(4);
+
+  std::atomic<int> calls(0);
+  std::exception_ptr error;
+  asio::parallel_for(pool, 100,
+      [&calls](std::size_t i)
+      {
+        ++calls;
+        if (i == 10)
+          throw std::runtime_error("parallel_for");
+      },
+      [&error](std::exception_ptr e)
+      {
+        error = e;
+      });
+
+  pool.wait();
+
+  ASIO_CHECK(!!error);
+  ASIO_CHECK(calls > 0);
+  ASIO_CHECK(calls <= 100);
+
+  try
+  {
+    std::rethrow_exception(error);
+  }
+  catch (const std::runtime_error& e)
+  {
+    ASIO_CHECK(std::string(e.what()) == "parallel_for");
+  }
+#endif // !defined(ASIO_NO_EXCEPTIONS)
+}
+
+void parallel_for_io_context_test()
+{
+  asio::io_context ioc;
+
+  std::vector<int> values(37, 0);
+  bool called = false;
+  asio::parallel_for(ioc, values.size(),
+      [&values](std::size_t i)
+      {
+        values[i] = static_cast<int>(i);
+      },
+      [&called](std::exception_ptr)
+      {
+        called = true;
+      });
+
+  ASIO_CHECK(!called);
+
+  ioc.run();
+
+  ASIO_CHECK(called);
+  for (std::size_t i = 0; i < values.size(); ++i)
+    ASIO_CHECK(values[i] == static_cast<int>(i));
+}
+
+void parallel_for_future_test()
+{
+  asio::thread_pool pool(3);
+
+  std::atomic<std::size_t> sum(0);
+  std::future<void> f = asio::parallel_for(pool, 64,
+      [&sum](std::size_t i)
+      {
+        sum += i;
+      },
+      asio::use_future);
+
+  f.get();
+
+  ASIO_CHECK(sum == 64 * 63 / 2);
+}
+
+ASIO_TEST_SUITE
+(
+  "parallel_for",
+  ASIO_TEST_CASE(parallel_for_thread_pool_test)
+  ASIO_TEST_CASE(parallel_for_empty_test)
+  ASIO_TEST_CASE(parallel_for_exception_test)
+  ASIO_TEST_CASE(parallel_for_io_context_test)
+  ASIO_TEST_CASE(parallel_for_future_test)
+)
@@ -0,0 +1,109 @@
+//
+// pooled_allocator.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/pooled_allocator.hpp"
+
+#include "unit_test.hpp"
+#include <cstring>
+#include <vector>
+#include "asio/basic_streambuf.hpp"
+#include "asio/detail/type_traits.hpp"
+
+void pooled_allocator_test()
+{
+  ASIO_CHECK((
+      asio::is_same<
+        asio::pooled_allocator<int>::value_type,
+        int
+      >::value));
+
+  ASIO_CHECK((
+      asio::is_same<
+        asio::pooled_allocator<int>::rebind<char>::other,
+        asio::pooled_allocator<char>
+      >::value));
+
+  asio::buffered_stream_pool pool;
+  asio::buffered_stream_pool other_pool;
+
+  asio::pooled_allocator<int> a1(pool);
+  asio::pooled_allocator<int> a2(a1);
+  asio::pooled_allocator<int> a3(other_pool);
+
+  ASIO_CHECK(a1 == a2);
+  ASIO_CHECK(!(a1 != a2));
+  ASIO_CHECK(a1 != a3);
+  ASIO_CHECK(&a1.pool() == &pool);
+
+  asio::pooled_allocator<char> a4(a1);
+  ASIO_CHECK(&a4.pool() == &pool);
+
+  int* p = a1.allocate(42);
+  ASIO_CHECK(p != 0);
+  a1.deallocate(p, 42);
+  ASIO_CHECK(pool.cached_blocks() == 1);
+
+  int* q = a2.allocate(40);
+  ASIO_CHECK(q == p);
+  ASIO_CHECK(pool.cached_blocks() == 0);
+  a2.deallocate(q, 40);
+
+  {
+    std::vector<int, asio::pooled_allocator<int> > v(42, 0, a1);
+    ASIO_CHECK(v.size() == 42);
+  }
+  ASIO_CHECK(pool.cached_blocks() >= 1);
+}
+
+void pooled_streambuf_test()
+{
+  typedef asio::basic_streambuf<asio::pooled_allocator<char> > streambuf;
+
+  asio::buffered_stream_pool pool;
+  asio::pooled_allocator<char> alloc(pool);
+
+  char data[4096];
+  std::memset(data, 'x', sizeof(data));
+
+  {
+    streambuf b(sizeof(data) * 2, alloc);
+    b.commit(asio::buffer_copy(b.prepare(sizeof(data)),
+          asio::buffer(data)));
+    ASIO_CHECK(b.size() == sizeof(data));
+  }
+
+  // The storage of the destroyed streambuf is held by the pool.
+  std::size_t cached = pool.cached_blocks();
+  ASIO_CHECK(cached >= 1);
+
+  {
+    // A streambuf for a later connection reuses the storage.
+    streambuf b(sizeof(data) * 2, alloc);
+    b.commit(asio::buffer_copy(b.prepare(sizeof(data)),
+          asio::buffer(data)));
+    ASIO_CHECK(b.size() == sizeof(data));
+    ASIO_CHECK(pool.cached_blocks() < cached);
+  }
+
+  ASIO_CHECK(pool.cached_blocks() == cached);
+}
+
+ASIO_TEST_SUITE
+(
+  "pooled_allocator",
+  ASIO_TEST_CASE(pooled_allocator_test)
+  ASIO_TEST_CASE(pooled_streambuf_test)
+)
@@ -0,0 +1,138 @@
+//
+// post_batch.cpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/post_batch.hpp"
+
+#include <atomic>
+#include <functional>
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/strand.hpp"
+#include "asio/thread_pool.hpp"
+#include "unit_test.hpp"
+
+void post_batch_io_context_test()
+{
+  asio::io_context ioc;
+
+  std::vector<int> order;
+  std::vector<std::function<void()>> fs;
+  for (int i = 0; i < 10; ++i)
+    fs.push_back([&order, i]{ order.push_back(i); });
+
+  asio::post_batch(ioc.get_executor(), fs);
+
+  ASIO_CHECK(order.empty());
+
+  ioc.run();
+
+  ASIO_CHECK(order.size() == 10);
+  for (int i = 0; i < 10; ++i)
+    ASIO_CHECK(order[i] == i);
+}
+
+void post_batch_never_inline_test()
+{
+  asio::io_context ioc;
+
+  int calls = 0;
+  bool inside = false;
+  asio::post(ioc,
+      [&]
+      {
+        std::vector<std::function<void()>> fs(3, [&]{ ++calls; });
+        inside = true;
+        asio::post_batch(ioc, fs);
+        inside = false;
+        ASIO_CHECK(calls == 0);
+      });
+
+  ioc.run();
+
+  ASIO_CHECK(!inside);
+  ASIO_CHECK(calls == 3);
+}
+
+void post_batch_const_range_test()
+{
+  asio::io_context ioc;
+
+  int calls = 0;
+  const std::vector<std::function<void()>> fs(5, [&calls]{ ++calls; });
+
+  asio::post_batch(ioc, fs);
+  ioc.run();
+
+  ASIO_CHECK(calls == 5);
+  for (std::size_t i = 0; i < fs.size(); ++i)
+    ASIO_CHECK(!!fs[i]);
+}
+
+void post_batch_empty_test()
+{
+  asio::io_context ioc;
+
+  std::vector<std::function<void()>> fs;
+  asio::post_batch(ioc, fs);
+
+  ASIO_CHECK(ioc.run() == 0);
+}
+
+void post_batch_thread_pool_test()
+{
+  asio::thread_pool pool(4);
+
+  std::atomic<int> calls(0);
+  std::vector<std::function<void()>> fs(1000, [&calls]{ ++calls; });
+
+  asio::post_batch(pool, fs);
+  pool.wait();
+
+  ASIO_CHECK(calls == 1000);
+}
+
+void post_batch_strand_test()
+{
+  asio::io_context ioc;
+  asio::strand<asio::io_context::executor_type> s(ioc.get_executor());
+
+  std::vector<int> order;
+  std::vector<std::function<void()>> fs;
+  for (int i = 0; i < 10; ++i)
+    fs.push_back([&order, i]{ order.push_back(i); });
+
+  asio::post_batch(s, fs);
+
+  ASIO_CHECK(order.empty());
+
+  ioc.run();
+
+  ASIO_CHECK(order.size() == 10);
+  for (int i = 0; i < 10; ++i)
+    ASIO_CHECK(order[i] == i);
+}
+
+ASIO_TEST_SUITE
+(
+  "post_batch",
+  ASIO_TEST_CASE(post_batch_io_context_test)
+  ASIO_TEST_CASE(post_batch_never_inline_test)
+  ASIO_TEST_CASE(post_batch_const_range_test)
+  ASIO_TEST_CASE(post_batch_empty_test)
+  ASIO_TEST_CASE(post_batch_thread_pool_test)
+  ASIO_TEST_CASE(post_batch_strand_test)
+)
@@ -0,0 +1,222 @@
+//
+// provided_buffer_ring.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/provided_buffer_ring.hpp"
+
+#include <cstring>
+#include <functional>
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/ip/udp.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// provided_buffer_ring_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the provided_buffer_ring
+// class and the async_receive_multishot operations that use it.
+
+namespace provided_buffer_ring_runtime {
+
+#if defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+
+static const char write_data[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+void handle_receive(const asio::error_code& err,
+    std::size_t bytes_transferred, std::size_t buffer_id,
+    asio::error_code* out_err, std::size_t* out_bytes,
+    std::size_t* out_id)
+{
+  *out_err = err;
+  *out_bytes = bytes_transferred;
+  *out_id = buffer_id;
+}
+
+void test_ring()
+{
+  using namespace asio;
+
+  io_context ioc;
+
+  provided_buffer_ring ring(ioc, 3, 128, 1);
+  ASIO_CHECK(ring.buffer_count() == 3);
+  ASIO_CHECK(ring.buffer_size() == 128);
+  ASIO_CHECK(ring.group_id() == 1);
+  ASIO_CHECK(ring.buffer(0).size() == 128);
+  ASIO_CHECK(ring.buffer(2, 10).size() == 10);
+  ASIO_CHECK(ring.buffer(2, 1000).size() == 128);
+  ASIO_CHECK(static_cast<char*>(ring.buffer(1).data())
+      == static_cast<char*>(ring.buffer(0).data()) + 128);
+
+  provided_buffer_ring ring2(ioc.get_executor(), 1, 16, 2);
+  ASIO_CHECK(ring2.buffer_count() == 1);
+
+  bool threw = false;
+  try
+  {
+    provided_buffer_ring ring3(ioc, 0, 16, 3);
+  }
+  catch (asio::system_error& e)
+  {
+    threw = true;
+    ASIO_CHECK(e.code() == asio::error::invalid_argument);
+  }
+  ASIO_CHECK(threw);
+}
+
+void test_stream()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+  using std::placeholders::_1;
+  using std::placeholders::_2;
+  using std::placeholders::_3;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
+
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  provided_buffer_ring ring(ioc, 1, sizeof(write_data), 0);
+
+  asio::error_code err;
+  std::size_t bytes = 0;
+  std::size_t id = 0;
+
+  // A buffer is taken from the ring only when data arrives.
+  server_side_socket.async_receive_multishot(ring,
+      std::bind(handle_receive, _1, _2, _3, &err, &bytes, &id));
+  ioc.poll();
+  ASIO_CHECK(!ioc.stopped());
+  ASIO_CHECK(bytes == 0);
+
+  asio::write(client_side_socket,
+      asio::buffer(write_data, sizeof(write_data)));
+  ioc.run();
+  ioc.restart();
+  ASIO_CHECK(!err);
+  ASIO_CHECK(bytes == sizeof(write_data));
+  ASIO_CHECK(id == 0);
+  ASIO_CHECK(std::memcmp(ring.buffer(id, bytes).data(),
+        write_data, sizeof(write_data)) == 0);
+
+  // With the only buffer still held, arriving data cannot be received.
+  server_side_socket.async_receive_multishot(ring,
+      std::bind(handle_receive, _1, _2, _3, &err, &bytes, &id));
+  asio::write(client_side_socket,
+      asio::buffer(write_data, sizeof(write_data)));
+  ioc.run();
+  ioc.restart();
+  ASIO_CHECK(err == asio::error::no_buffer_space);
+
+  // Once recycled, the buffer may be used again.
+  ring.recycle(id);
+  bytes = 0;
+  server_side_socket.async_receive_multishot(ring, socket_base::message_peek,
+      std::bind(handle_receive, _1, _2, _3, &err, &bytes, &id));
+  ioc.run();
+  ioc.restart();
+  ASIO_CHECK(!err);
+  ASIO_CHECK(bytes == sizeof(write_data));
+  ring.recycle(id);
+
+  // End of file is reported without holding a buffer.
+  char drain_data[sizeof(write_data)];
+  asio::read(server_side_socket, asio::buffer(drain_data));
+  client_side_socket.shutdown(ip::tcp::socket::shutdown_send);
+  server_side_socket.async_receive_multishot(ring,
+      std::bind(handle_receive, _1, _2, _3, &err, &bytes, &id));
+  ioc.run();
+  ASIO_CHECK(err == asio::error::eof);
+  ASIO_CHECK(bytes == 0);
+}
+
+void test_datagram()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+  using std::placeholders::_1;
+  using std::placeholders::_2;
+  using std::placeholders::_3;
+
+  io_context ioc;
+
+  ip::udp::socket s1(ioc, ip::udp::endpoint(ip::udp::v4(), 0));
+  ip::udp::endpoint target_endpoint = s1.local_endpoint();
+  target_endpoint.address(ip::address_v4::loopback());
+
+  ip::udp::socket s2(ioc);
+  s2.open(ip::udp::v4());
+  s2.bind(ip::udp::endpoint(ip::udp::v4(), 0));
+  s2.connect(target_endpoint);
+  ip::udp::endpoint s2_endpoint = s2.local_endpoint();
+  s2_endpoint.address(ip::address_v4::loopback());
+  s1.connect(s2_endpoint);
+
+  provided_buffer_ring ring(ioc, 2, 64, 0);
+
+  asio::error_code err;
+  std::size_t bytes = 0;
+  std::size_t id = 0;
+
+  s1.async_receive_multishot(ring,
+      std::bind(handle_receive, _1, _2, _3, &err, &bytes, &id));
+  s2.send(asio::buffer(write_data, sizeof(write_data)));
+  ioc.run();
+  ASIO_CHECK(!err);
+  ASIO_CHECK(bytes == sizeof(write_data));
+  ASIO_CHECK(std::memcmp(ring.buffer(id, bytes).data(),
+        write_data, sizeof(write_data)) == 0);
+  ring.recycle(id);
+}
+
+#else // defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+
+void test_ring()
+{
+}
+
+void test_stream()
+{
+}
+
+void test_datagram()
+{
+}
+
+#endif // defined(ASIO_HAS_PROVIDED_BUFFER_RING)
+
+} // namespace provided_buffer_ring_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "provided_buffer_ring",
+  ASIO_TEST_CASE(provided_buffer_ring_runtime::test_ring)
+  ASIO_TEST_CASE(provided_buffer_ring_runtime::test_stream)
+  ASIO_TEST_CASE(provided_buffer_ring_runtime::test_datagram)
+)
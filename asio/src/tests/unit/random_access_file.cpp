@@ -16,10 +16,21 @@
 // Test that header file is self-contained.
 #include "asio/random_access_file.hpp"
 
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
 #include "archetypes/async_result.hpp"
+#include "asio/aligned_buffer.hpp"
+#include "asio/config.hpp"
 #include "asio/io_context.hpp"
 #include "unit_test.hpp"
 
+#if defined(ASIO_HAS_FILE) && !defined(ASIO_WINDOWS)
+# include <stdlib.h>
+# include <unistd.h>
+#endif // defined(ASIO_HAS_FILE) && !defined(ASIO_WINDOWS)
+
 // random_access_file_compile test
 // ~~~~~~~~~~~~~~~~~~~~~~~~
 // The following test checks that all public member functions on the class
@@ -45,6 +56,15 @@ private:
   read_some_at_handler(const read_some_at_handler&);
 };
 
+struct sync_handler
+{
+  sync_handler() {}
+  void operator()(const asio::error_code&) {}
+  sync_handler(sync_handler&&) {}
+private:
+  sync_handler(const sync_handler&);
+};
+
 void test()
 {
 #if defined(ASIO_HAS_FILE)
@@ -134,6 +154,18 @@ void test()
     file1.sync_data();
     file1.sync_data(ec);
 
+    file1.async_sync_all(sync_handler());
+    int s5 = file1.async_sync_all(lazy);
+    (void)s5;
+
+    file1.async_sync_data(sync_handler());
+    int s6 = file1.async_sync_data(lazy);
+    (void)s6;
+
+    file1.async_sync_range(0, 0, sync_handler());
+    int s7 = file1.async_sync_range(0, 0, lazy);
+    (void)s7;
+
     file1.write_some_at(0, buffer(mutable_char_buffer));
     file1.write_some_at(0, buffer(const_char_buffer));
     file1.write_some_at(0, buffer(mutable_char_buffer), ec);
@@ -155,6 +187,21 @@ void test()
         read_some_at_handler());
     int i3 = file1.async_read_some_at(0, buffer(mutable_char_buffer), lazy);
     (void)i3;
+
+    random_access_file::write_request write_requests[1] =
+      { { 0, buffer(const_char_buffer) } };
+    file1.async_write_batch_at(write_requests, 1, write_some_at_handler());
+    int i4 = file1.async_write_batch_at(write_requests, 1, lazy);
+    (void)i4;
+
+    random_access_file::read_request read_requests[1] =
+      { { 0, buffer(mutable_char_buffer) } };
+    file1.async_read_batch_at(read_requests, 1, read_some_at_handler());
+    int i5 = file1.async_read_batch_at(read_requests, 1, lazy);
+    (void)i5;
+
+    file1.open(path, random_access_file::read_only
+        | random_access_file::direct, ec);
   }
   catch (std::exception&)
   {
@@ -164,8 +211,306 @@ void test()
 
 } // namespace random_access_file_compile
 
+//------------------------------------------------------------------------------
+
+// random_access_file_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the batched read and
+// write functions of the random_access_file class.
+
+namespace random_access_file_runtime {
+
+#if defined(ASIO_HAS_FILE) && !defined(ASIO_WINDOWS)
+
+using asio::random_access_file;
+
+const std::size_t block_size = 4096;
+
+// Holds the name of a temporary file, which is removed on destruction.
+struct temporary_path
+{
+  temporary_path()
+  {
+    char name[] = "/tmp/asio_random_access_file_XXXXXX";
+    int fd = ::mkstemp(name);
+    if (fd != -1)
+      ::close(fd);
+    path = name;
+  }
+
+  ~temporary_path()
+  {
+    std::remove(path.c_str());
+  }
+
+  std::string path;
+};
+
+// Write a block for each request, then read the blocks back in reverse order.
+void write_and_read(asio::io_context& ioc, random_access_file& file,
+    std::vector<asio::aligned_buffer>& blocks)
+{
+  std::vector<random_access_file::write_request> write_requests;
+  for (std::size_t i = 0; i < blocks.size(); ++i)
+  {
+    std::memset(blocks[i].data(), static_cast<int>('a' + i), block_size);
+    random_access_file::write_request request
+      = { i * block_size, asio::buffer(blocks[i]) };
+    write_requests.push_back(request);
+  }
+
+  asio::error_code write_ec;
+  std::size_t written = 0;
+  file.async_write_batch_at(write_requests.data(), write_requests.size(),
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        write_ec = ec;
+        written = n;
+      });
+  ioc.run();
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(written == blocks.size() * block_size);
+  for (std::size_t i = 0; i < write_requests.size(); ++i)
+  {
+    ASIO_CHECK(!write_requests[i].error);
+    ASIO_CHECK(write_requests[i].bytes_transferred == block_size);
+  }
+
+  std::vector<asio::aligned_buffer> read_blocks;
+  std::vector<random_access_file::read_request> read_requests;
+  for (std::size_t i = 0; i < blocks.size(); ++i)
+    read_blocks.push_back(asio::aligned_buffer(block_size));
+  for (std::size_t i = 0; i < blocks.size(); ++i)
+  {
+    random_access_file::read_request request = { (blocks.size() - i - 1)
+      * block_size, asio::buffer(read_blocks[i]) };
+    read_requests.push_back(request);
+  }
+
+  asio::error_code read_ec;
+  std::size_t read = 0;
+  file.async_read_batch_at(read_requests.data(), read_requests.size(),
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        read_ec = ec;
+        read = n;
+      });
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(read == blocks.size() * block_size);
+  for (std::size_t i = 0; i < read_requests.size(); ++i)
+  {
+    ASIO_CHECK(!read_requests[i].error);
+    ASIO_CHECK(read_requests[i].bytes_transferred == block_size);
+    ASIO_CHECK(std::memcmp(read_blocks[i].data(),
+          blocks[blocks.size() - i - 1].data(), block_size) == 0);
+  }
+}
+
+void test_batch()
+{
+  temporary_path tmp;
+  asio::io_context ioc;
+  random_access_file file(ioc, tmp.path, random_access_file::read_write
+      | random_access_file::truncate);
+
+  std::vector<asio::aligned_buffer> blocks;
+  for (std::size_t i = 0; i < 16; ++i)
+    blocks.push_back(asio::aligned_buffer(block_size));
+  write_and_read(ioc, file, blocks);
+
+  // A read past the end of the file reports the end of the file, without
+  // affecting the other reads in the batch.
+  char data1[16] = "";
+  char data2[16] = "";
+  random_access_file::read_request requests[2] =
+    {
+      { 0, asio::buffer(data1) },
+      { blocks.size() * block_size, asio::buffer(data2) }
+    };
+
+  asio::error_code read_ec;
+  std::size_t read = 0;
+  file.async_read_batch_at(requests, 2,
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        read_ec = ec;
+        read = n;
+      });
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(read_ec == asio::error::eof);
+  ASIO_CHECK(read == sizeof(data1));
+  ASIO_CHECK(!requests[0].error);
+  ASIO_CHECK(requests[0].bytes_transferred == sizeof(data1));
+  ASIO_CHECK(data1[0] == 'a');
+  ASIO_CHECK(requests[1].error == asio::error::eof);
+  ASIO_CHECK(requests[1].bytes_transferred == 0);
+}
+
+void test_empty_batch()
+{
+  temporary_path tmp;
+  asio::io_context ioc;
+  random_access_file file(ioc, tmp.path, random_access_file::read_write);
+
+  bool called = false;
+  asio::error_code read_ec;
+  file.async_read_batch_at(0, 0,
+      [&](const asio::error_code& ec, std::size_t)
+      {
+        called = true;
+        read_ec = ec;
+      });
+  ASIO_CHECK(!called);
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(!read_ec);
+}
+
+void test_direct()
+{
+  temporary_path tmp;
+  asio::io_context ioc;
+  random_access_file file(ioc);
+
+  // Not all file systems support direct I/O.
+  asio::error_code ec;
+  file.open(tmp.path, random_access_file::read_write
+      | random_access_file::direct, ec);
+  if (ec)
+    return;
+
+  std::vector<asio::aligned_buffer> blocks;
+  for (std::size_t i = 0; i < 4; ++i)
+    blocks.push_back(asio::aligned_buffer(block_size));
+  write_and_read(ioc, file, blocks);
+}
+
+void test_registered_files()
+{
+  // The table is smaller than the number of files, so that some files use
+  // their descriptors directly. The option is ignored by other backends.
+  temporary_path tmp1;
+  temporary_path tmp2;
+  asio::io_context ioc(asio::config_from_string("io_uring.registered_files=1"));
+  random_access_file file1(ioc, tmp1.path, random_access_file::read_write);
+  random_access_file file2(ioc, tmp2.path, random_access_file::read_write);
+
+  std::vector<asio::aligned_buffer> blocks;
+  for (std::size_t i = 0; i < 4; ++i)
+    blocks.push_back(asio::aligned_buffer(block_size));
+  write_and_read(ioc, file1, blocks);
+  ioc.restart();
+  write_and_read(ioc, file2, blocks);
+}
+
+void test_sync()
+{
+  temporary_path tmp;
+  asio::io_context ioc;
+  random_access_file file(ioc, tmp.path, random_access_file::read_write);
+
+  // Each synchronisation is started without waiting for the write before it.
+  asio::aligned_buffer block(block_size);
+  std::memset(block.data(), 'x', block_size);
+  asio::error_code write_ec = asio::error::would_block;
+  std::size_t written = 0;
+  file.async_write_some_at(0, asio::buffer(block),
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        write_ec = ec;
+        written = n;
+      });
+
+  asio::error_code range_ec = asio::error::would_block;
+  asio::error_code data_ec = asio::error::would_block;
+  asio::error_code all_ec = asio::error::would_block;
+  file.async_sync_range(0, block_size,
+      [&](const asio::error_code& ec){ range_ec = ec; });
+  file.async_sync_data([&](const asio::error_code& ec){ data_ec = ec; });
+  file.async_sync_all([&](const asio::error_code& ec){ all_ec = ec; });
+  ASIO_CHECK(range_ec == asio::error::would_block);
+  ASIO_CHECK(data_ec == asio::error::would_block);
+  ASIO_CHECK(all_ec == asio::error::would_block);
+
+  ioc.run();
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(written == block_size);
+  ASIO_CHECK(!range_ec);
+  ASIO_CHECK(!data_ec);
+  ASIO_CHECK(!all_ec);
+
+  // A closed file reports an error.
+  file.close();
+  file.async_sync_data([&](const asio::error_code& ec){ data_ec = ec; });
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(data_ec == asio::error::bad_descriptor);
+}
+
+void test_thread_pool()
+{
+  // The options are used only by the thread pool backend, where a batch is
+  // divided among the worker threads.
+  temporary_path tmp;
+  asio::io_context ioc(asio::config_from_string(
+        "file.threads=2\nfile.readahead=65536"));
+  random_access_file file(ioc, tmp.path, random_access_file::read_write);
+
+  std::vector<asio::aligned_buffer> blocks;
+  for (std::size_t i = 0; i < 7; ++i)
+    blocks.push_back(asio::aligned_buffer(block_size));
+  write_and_read(ioc, file, blocks);
+
+  // Without a locking scheduler, operations are performed by the initiating
+  // thread.
+  asio::io_context ioc2(asio::config_from_string("scheduler.locking=0"));
+  random_access_file file2(ioc2, tmp.path, random_access_file::read_write);
+  write_and_read(ioc2, file2, blocks);
+}
+
+#else // defined(ASIO_HAS_FILE) && !defined(ASIO_WINDOWS)
+
+void test_batch()
+{
+}
+
+void test_empty_batch()
+{
+}
+
+void test_direct()
+{
+}
+
+void test_registered_files()
+{
+}
+
+void test_sync()
+{
+}
+
+void test_thread_pool()
+{
+}
+
+#endif // defined(ASIO_HAS_FILE) && !defined(ASIO_WINDOWS)
+
+} // namespace random_access_file_runtime
+
+//------------------------------------------------------------------------------
+
 ASIO_TEST_SUITE
 (
   "random_access_file",
   ASIO_COMPILE_TEST_CASE(random_access_file_compile::test)
+  ASIO_TEST_CASE(random_access_file_runtime::test_batch)
+  ASIO_TEST_CASE(random_access_file_runtime::test_empty_batch)
+  ASIO_TEST_CASE(random_access_file_runtime::test_direct)
+  ASIO_TEST_CASE(random_access_file_runtime::test_registered_files)
+  ASIO_TEST_CASE(random_access_file_runtime::test_sync)
+  ASIO_TEST_CASE(random_access_file_runtime::test_thread_pool)
 )
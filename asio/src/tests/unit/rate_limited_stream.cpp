@@ -0,0 +1,235 @@
+//
+// rate_limited_stream.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/rate_limited_stream.hpp"
+
+#include <string>
+#include <vector>
+#include "asio/bind_cancellation_slot.hpp"
+#include "asio/cancellation_signal.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// rate_limited_stream_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// rate_limited_stream compile and link correctly. Runtime failures are ignored.
+
+namespace rate_limited_stream_compile {
+
+void io_handler(const asio::error_code&, std::size_t)
+{
+}
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    rate_limiter limiter(1024, 256);
+    char mutable_char_buffer[128] = "";
+    const char const_char_buffer[128] = "";
+    asio::error_code ec;
+
+    rate_limited_stream<ip::tcp::socket> stream1(ioc, limiter);
+    rate_limited_stream<ip::tcp::socket&> stream2(stream1.next_layer(), limiter);
+
+    rate_limited_stream<ip::tcp::socket>::lowest_layer_type& lowest_layer
+      = stream1.lowest_layer();
+    (void)lowest_layer;
+
+    const rate_limited_stream<ip::tcp::socket>& const_stream1 = stream1;
+    const rate_limited_stream<ip::tcp::socket>::lowest_layer_type&
+      lowest_layer2 = const_stream1.lowest_layer();
+    (void)lowest_layer2;
+
+    any_io_executor ex = stream1.get_executor();
+    (void)ex;
+
+    rate_limiter& l = stream1.limiter();
+    (void)l;
+
+    stream1.write_some(buffer(mutable_char_buffer));
+    stream1.write_some(buffer(const_char_buffer));
+    stream1.write_some(buffer(mutable_char_buffer), ec);
+    stream1.write_some(buffer(const_char_buffer), ec);
+
+    stream1.async_write_some(buffer(mutable_char_buffer), &io_handler);
+    stream1.async_write_some(buffer(const_char_buffer), &io_handler);
+
+    stream1.read_some(buffer(mutable_char_buffer));
+    stream1.read_some(buffer(mutable_char_buffer), ec);
+
+    stream1.async_read_some(buffer(mutable_char_buffer), &io_handler);
+
+    stream1.close();
+    stream1.close(ec);
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace rate_limited_stream_compile
+
+//------------------------------------------------------------------------------
+
+// rate_limited_stream_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that writes on the rate_limited_stream class are
+// paced by a shared limiter.
+
+namespace rate_limited_stream_runtime {
+
+using asio::ip::tcp;
+typedef asio::rate_limiter::clock_type clock_type;
+
+struct connection
+{
+  explicit connection(asio::io_context& ioc)
+    : client(ioc),
+      server(ioc)
+  {
+    tcp::acceptor acceptor(ioc,
+        tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+    client.connect(acceptor.local_endpoint());
+    acceptor.accept(server);
+  }
+
+  tcp::socket client;
+  tcp::socket server;
+};
+
+void test_async_write()
+{
+  asio::io_context ioc;
+  connection c1(ioc);
+  connection c2(ioc);
+
+  // Two streams share a limit of 100000 bytes per second.
+  asio::rate_limiter limiter(100000, 10000);
+  asio::rate_limited_stream<tcp::socket&> stream1(c1.client, limiter);
+  asio::rate_limited_stream<tcp::socket&> stream2(c2.client, limiter);
+
+  std::string data1(20000, 'a');
+  std::string data2(20000, 'b');
+  std::size_t written1 = 0;
+  std::size_t written2 = 0;
+
+  clock_type::time_point start = clock_type::now();
+  asio::async_write(stream1, asio::buffer(data1),
+      [&](asio::error_code ec, std::size_t n)
+      {
+        ASIO_CHECK(!ec);
+        written1 = n;
+      });
+  asio::async_write(stream2, asio::buffer(data2),
+      [&](asio::error_code ec, std::size_t n)
+      {
+        ASIO_CHECK(!ec);
+        written2 = n;
+      });
+  ioc.run();
+
+  // The 30000 bytes beyond the burst size take at least 300ms to send.
+  ASIO_CHECK(written1 == data1.size());
+  ASIO_CHECK(written2 == data2.size());
+  ASIO_CHECK(clock_type::now() - start >= asio::chrono::milliseconds(300));
+
+  std::string received(data1.size(), '\0');
+  asio::read(c1.server, asio::buffer(&received[0], received.size()));
+  ASIO_CHECK(received == data1);
+  asio::read(c2.server, asio::buffer(&received[0], received.size()));
+  ASIO_CHECK(received == data2);
+}
+
+void test_sync_write()
+{
+  asio::io_context ioc;
+  connection c(ioc);
+  asio::rate_limiter limiter(100000, 5000);
+  asio::rate_limited_stream<tcp::socket&> stream(c.client, limiter);
+
+  // Each write is limited to the burst size.
+  std::string data(15000, 'c');
+  ASIO_CHECK(stream.write_some(asio::buffer(data)) == 5000);
+
+  clock_type::time_point start = clock_type::now();
+  asio::write(stream, asio::buffer(data.data() + 5000, 10000));
+  ASIO_CHECK(clock_type::now() - start >= asio::chrono::milliseconds(100));
+
+  std::string received(data.size(), '\0');
+  asio::read(c.server, asio::buffer(&received[0], received.size()));
+  ASIO_CHECK(received == data);
+
+  // Reads pass through to the next layer.
+  asio::write(c.server, asio::buffer("hello", 5));
+  char buf[5];
+  ASIO_CHECK(asio::read(stream, asio::buffer(buf)) == 5);
+}
+
+void test_cancellation()
+{
+  asio::io_context ioc;
+  connection c(ioc);
+  asio::rate_limiter limiter(1000, 100);
+  asio::rate_limited_stream<tcp::socket&> stream(c.client, limiter);
+  clock_type::time_point t = limiter.reserve(100);
+  ASIO_CHECK(t <= clock_type::now());
+
+  // A write cancelled while waiting for its reservation sends nothing, and
+  // returns the reservation to the limiter.
+  std::string data(100, 'd');
+  asio::cancellation_signal signal;
+  asio::error_code write_ec;
+  std::size_t written = 1;
+  stream.async_write_some(asio::buffer(data),
+      asio::bind_cancellation_slot(signal.slot(),
+        [&](asio::error_code ec, std::size_t n)
+        {
+          write_ec = ec;
+          written = n;
+        }));
+  ioc.poll();
+  signal.emit(asio::cancellation_type::terminal);
+  ioc.run();
+  ASIO_CHECK(write_ec == asio::error::operation_aborted);
+  ASIO_CHECK(written == 0);
+
+  t = limiter.reserve(100);
+  ASIO_CHECK(t <= clock_type::now() + asio::chrono::milliseconds(100));
+}
+
+} // namespace rate_limited_stream_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "rate_limited_stream",
+  ASIO_COMPILE_TEST_CASE(rate_limited_stream_compile::test)
+  ASIO_TEST_CASE(rate_limited_stream_runtime::test_async_write)
+  ASIO_TEST_CASE(rate_limited_stream_runtime::test_sync_write)
+  ASIO_TEST_CASE(rate_limited_stream_runtime::test_cancellation)
+)
@@ -0,0 +1,100 @@
+//
+// rate_limiter.cpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/rate_limiter.hpp"
+
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// rate_limiter_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the schedule calculated by the rate_limiter class.
+
+namespace rate_limiter_runtime {
+
+typedef asio::rate_limiter::clock_type clock_type;
+
+// Determine whether a reservation must wait before sending.
+bool delayed(asio::rate_limiter& limiter, std::size_t n)
+{
+  clock_type::time_point t = limiter.reserve(n);
+  return t > clock_type::now();
+}
+
+void test_burst()
+{
+  asio::rate_limiter limiter(1000, 500);
+  ASIO_CHECK(limiter.rate() == 1000);
+  ASIO_CHECK(limiter.burst_size() == 500);
+
+  // An idle limiter allows the burst size to be sent without delay.
+  clock_type::time_point start = clock_type::now();
+  ASIO_CHECK(!delayed(limiter, 200));
+  ASIO_CHECK(!delayed(limiter, 300));
+
+  // Further bytes are scheduled at the configured rate.
+  clock_type::time_point t = limiter.reserve(100);
+  ASIO_CHECK(t >= start + asio::chrono::milliseconds(100));
+  ASIO_CHECK(t <= clock_type::now() + asio::chrono::milliseconds(100));
+
+  t = limiter.reserve(1000);
+  ASIO_CHECK(t >= start + asio::chrono::milliseconds(1100));
+  ASIO_CHECK(t <= clock_type::now() + asio::chrono::milliseconds(1100));
+}
+
+void test_refund()
+{
+  asio::rate_limiter limiter(1000, 100);
+
+  ASIO_CHECK(!delayed(limiter, 100));
+  clock_type::time_point t1 = limiter.reserve(500);
+  ASIO_CHECK(t1 > clock_type::now());
+
+  // Returned bytes bring forward the next reservation.
+  limiter.refund(500);
+  clock_type::time_point t2 = limiter.reserve(500);
+  ASIO_CHECK(t2 <= t1 + asio::chrono::milliseconds(1));
+}
+
+void test_unlimited()
+{
+  asio::rate_limiter limiter(0, 0);
+  ASIO_CHECK(limiter.rate() == 0);
+  ASIO_CHECK(limiter.burst_size() == 1);
+
+  for (int i = 0; i < 10; ++i)
+    ASIO_CHECK(!delayed(limiter, 1000000));
+
+  // Enabling the limit applies to subsequent reservations.
+  limiter.set_rate(1000, 100);
+  ASIO_CHECK(limiter.rate() == 1000);
+  ASIO_CHECK(limiter.burst_size() == 100);
+  ASIO_CHECK(!delayed(limiter, 100));
+  ASIO_CHECK(delayed(limiter, 100));
+}
+
+} // namespace rate_limiter_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "rate_limiter",
+  ASIO_TEST_CASE(rate_limiter_runtime::test_burst)
+  ASIO_TEST_CASE(rate_limiter_runtime::test_refund)
+  ASIO_TEST_CASE(rate_limiter_runtime::test_unlimited)
+)
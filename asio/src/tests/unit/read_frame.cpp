@@ -0,0 +1,274 @@
+//
+// read_frame.cpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/read_frame.hpp"
+
+#include <cstring>
+#include <string>
+#include "archetypes/async_result.hpp"
+#include "asio/bind_cancellation_slot.hpp"
+#include "asio/cancellation_signal.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/serial_port.hpp"
+#include "asio/steady_timer.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// read_frame_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the async_read_frame function compiles for
+// the supported stream types. Runtime failures are ignored.
+
+namespace read_frame_compile {
+
+struct read_frame_handler
+{
+  read_frame_handler() {}
+  void operator()(const asio::error_code&, std::size_t) {}
+  read_frame_handler(read_frame_handler&&) {}
+private:
+  read_frame_handler(const read_frame_handler&);
+};
+
+void test()
+{
+  using namespace asio;
+
+  try
+  {
+    io_context ioc;
+    char data[128];
+    archetypes::lazy_handler lazy;
+    std::chrono::milliseconds gap(4);
+
+    ip::tcp::socket socket1(ioc);
+    async_read_frame(socket1, buffer(data), gap, read_frame_handler());
+    int i1 = async_read_frame(socket1, buffer(data), gap, lazy);
+    (void)i1;
+
+#if defined(ASIO_HAS_SERIAL_PORT)
+    serial_port port1(ioc);
+    async_read_frame(port1, buffer(data), gap, read_frame_handler());
+    int i2 = async_read_frame(port1, buffer(data), gap, lazy);
+    (void)i2;
+#endif // defined(ASIO_HAS_SERIAL_PORT)
+
+    ioc.run();
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace read_frame_compile
+
+//------------------------------------------------------------------------------
+
+// read_frame_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~
+// The following tests check the runtime behaviour of async_read_frame over a
+// connected pair of TCP sockets.
+
+namespace read_frame_runtime {
+
+void connect_sockets(asio::io_context& ioc,
+    asio::ip::tcp::socket& client, asio::ip::tcp::socket& server)
+{
+  asio::ip::tcp::acceptor acceptor(ioc,
+      asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  client.connect(acceptor.local_endpoint());
+  acceptor.accept(server);
+}
+
+struct frame_result
+{
+  frame_result() : called(false), length(0) {}
+
+  bool called;
+  asio::error_code ec;
+  std::size_t length;
+};
+
+struct frame_handler
+{
+  explicit frame_handler(frame_result& r) : result(&r) {}
+
+  void operator()(const asio::error_code& ec, std::size_t n)
+  {
+    result->called = true;
+    result->ec = ec;
+    result->length = n;
+  }
+
+  frame_result* result;
+};
+
+void test_gap()
+{
+  asio::io_context ioc;
+  asio::ip::tcp::socket client(ioc), server(ioc);
+  connect_sockets(ioc, client, server);
+
+  // Two writes close together form a single frame, and a later write starts
+  // the next frame.
+  asio::write(client, asio::buffer("abc", 3));
+  asio::steady_timer timer1(ioc, std::chrono::milliseconds(20));
+  timer1.async_wait(
+      [&](const asio::error_code&)
+      {
+        asio::write(client, asio::buffer("def", 3));
+      });
+  asio::steady_timer timer2(ioc, std::chrono::milliseconds(1000));
+  timer2.async_wait(
+      [&](const asio::error_code&)
+      {
+        asio::write(client, asio::buffer("xyz", 3));
+      });
+
+  char frame1[16] = "";
+  char frame2[16] = "";
+  frame_result result1, result2;
+  asio::async_read_frame(server, asio::buffer(frame1),
+      std::chrono::milliseconds(200),
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        frame_handler h(result1);
+        h(ec, n);
+        asio::async_read_frame(server, asio::buffer(frame2),
+            std::chrono::milliseconds(200), frame_handler(result2));
+      });
+  ASIO_CHECK(!result1.called);
+
+  ioc.run();
+
+  ASIO_CHECK(result1.called);
+  ASIO_CHECK(!result1.ec);
+  ASIO_CHECK(result1.length == 6);
+  ASIO_CHECK(std::memcmp(frame1, "abcdef", 6) == 0);
+  ASIO_CHECK(result2.called);
+  ASIO_CHECK(!result2.ec);
+  ASIO_CHECK(result2.length == 3);
+  ASIO_CHECK(std::memcmp(frame2, "xyz", 3) == 0);
+}
+
+void test_full_buffer()
+{
+  asio::io_context ioc;
+  asio::ip::tcp::socket client(ioc), server(ioc);
+  connect_sockets(ioc, client, server);
+
+  asio::write(client, asio::buffer("0123456789", 10));
+
+  char frame[4] = "";
+  frame_result result;
+  asio::async_read_frame(server, asio::buffer(frame),
+      std::chrono::seconds(10), frame_handler(result));
+  ioc.run();
+
+  ASIO_CHECK(result.called);
+  ASIO_CHECK(!result.ec);
+  ASIO_CHECK(result.length == 4);
+  ASIO_CHECK(std::memcmp(frame, "0123", 4) == 0);
+}
+
+void test_eof()
+{
+  asio::io_context ioc;
+  asio::ip::tcp::socket client(ioc), server(ioc);
+  connect_sockets(ioc, client, server);
+
+  asio::write(client, asio::buffer("abc", 3));
+  client.close();
+
+  // The frame ends when no more data is available, and the end of the stream
+  // is reported by the following read.
+  char frame[16] = "";
+  frame_result result1, result2;
+  asio::async_read_frame(server, asio::buffer(frame),
+      std::chrono::milliseconds(50),
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        frame_handler h(result1);
+        h(ec, n);
+        asio::async_read_frame(server, asio::buffer(frame),
+            std::chrono::milliseconds(50), frame_handler(result2));
+      });
+  ioc.run();
+
+  ASIO_CHECK(result1.called);
+  ASIO_CHECK(!result1.ec);
+  ASIO_CHECK(result1.length == 3);
+  ASIO_CHECK(result2.called);
+  ASIO_CHECK(result2.ec == asio::error::eof);
+  ASIO_CHECK(result2.length == 0);
+}
+
+void test_cancellation()
+{
+  asio::io_context ioc;
+  asio::ip::tcp::socket client(ioc), server(ioc);
+  connect_sockets(ioc, client, server);
+
+  // Cancel while waiting for the start of a frame.
+  char frame[16] = "";
+  asio::cancellation_signal signal;
+  frame_result result1;
+  asio::async_read_frame(server, asio::buffer(frame),
+      std::chrono::milliseconds(50),
+      asio::bind_cancellation_slot(signal.slot(), frame_handler(result1)));
+  ioc.poll();
+  ASIO_CHECK(!result1.called);
+  signal.emit(asio::cancellation_type::terminal);
+  ioc.run();
+  ASIO_CHECK(result1.called);
+  ASIO_CHECK(result1.ec == asio::error::operation_aborted);
+  ASIO_CHECK(result1.length == 0);
+
+  // Cancel while waiting for the end of a frame.
+  asio::write(client, asio::buffer("abc", 3));
+  frame_result result2;
+  asio::async_read_frame(server, asio::buffer(frame),
+      std::chrono::seconds(10),
+      asio::bind_cancellation_slot(signal.slot(), frame_handler(result2)));
+  ioc.restart();
+  asio::steady_timer timer(ioc, std::chrono::milliseconds(50));
+  timer.async_wait(
+      [&](const asio::error_code&)
+      {
+        signal.emit(asio::cancellation_type::terminal);
+      });
+  ioc.run();
+  ASIO_CHECK(result2.called);
+  ASIO_CHECK(result2.ec == asio::error::operation_aborted);
+  ASIO_CHECK(result2.length == 3);
+}
+
+} // namespace read_frame_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "read_frame",
+  ASIO_COMPILE_TEST_CASE(read_frame_compile::test)
+  ASIO_TEST_CASE(read_frame_runtime::test_gap)
+  ASIO_TEST_CASE(read_frame_runtime::test_full_buffer)
+  ASIO_TEST_CASE(read_frame_runtime::test_eof)
+  ASIO_TEST_CASE(read_frame_runtime::test_cancellation)
+)
@@ -0,0 +1,273 @@
+//
+// read_ranges_at.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/read_ranges_at.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/random_access_file.hpp"
+#include "asio/write_at.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_FILE) && !defined(ASIO_WINDOWS)
+# include <stdlib.h>
+# include <unistd.h>
+#endif // defined(ASIO_HAS_FILE) && !defined(ASIO_WINDOWS)
+
+//------------------------------------------------------------------------------
+
+// read_ranges_at_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime behaviour of the async_read_ranges_at
+// function.
+
+namespace read_ranges_at_runtime {
+
+#if defined(ASIO_HAS_FILE)
+
+using asio::file_base;
+
+// A device that holds its data in memory, and that returns at most a given
+// number of bytes from each read.
+class test_random_access_device
+{
+public:
+  typedef asio::io_context::executor_type executor_type;
+
+  test_random_access_device(asio::io_context& ioc,
+      const std::string& data, std::size_t max_read)
+    : io_context_(ioc),
+      data_(data),
+      max_read_(max_read),
+      reads_(0)
+  {
+  }
+
+  executor_type get_executor() noexcept
+  {
+    return io_context_.get_executor();
+  }
+
+  int reads() const
+  {
+    return reads_;
+  }
+
+  template <typename MutableBufferSequence, typename Handler>
+  void async_read_some_at(asio::uint64_t offset,
+      const MutableBufferSequence& buffers, Handler&& handler)
+  {
+    ++reads_;
+    asio::mutable_buffer b = *asio::buffer_sequence_begin(buffers);
+    std::size_t n = 0;
+    asio::error_code ec;
+    if (offset >= data_.size())
+      ec = asio::error::eof;
+    else
+    {
+      n = (std::min)(b.size(), (std::min)(max_read_,
+            data_.size() - static_cast<std::size_t>(offset)));
+      std::memcpy(b.data(), data_.data() + offset, n);
+    }
+    asio::post(io_context_, asio::detail::bind_handler(
+          static_cast<Handler&&>(handler), ec, n));
+  }
+
+private:
+  asio::io_context& io_context_;
+  std::string data_;
+  std::size_t max_read_;
+  int reads_;
+};
+
+std::string make_data(std::size_t n)
+{
+  std::string data(n, '\0');
+  for (std::size_t i = 0; i < n; ++i)
+    data[i] = static_cast<char>('a' + i % 26);
+  return data;
+}
+
+void test_device()
+{
+  asio::io_context ioc;
+  std::string data = make_data(1000);
+  test_random_access_device device(ioc, data, 7);
+
+  // The first two requests are adjacent in the device and in memory, and so
+  // are read as one. The third is adjacent in the device only. The last
+  // extends beyond the end of the data.
+  char buf1[50];
+  char buf2[60];
+  std::vector<file_base::read_request> requests;
+  requests.push_back(file_base::read_request(150,
+        asio::buffer(buf1 + 20, 30)));
+  requests.push_back(file_base::read_request(100,
+        asio::buffer(buf1, 20)));
+  requests.push_back(file_base::read_request(120,
+        asio::buffer(buf2, 10)));
+  requests.push_back(file_base::read_request(980,
+        asio::buffer(buf2 + 10, 50)));
+
+  asio::error_code ec;
+  std::size_t total = 0;
+  asio::async_read_ranges_at(device, requests.data(), requests.size(),
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        ec = e;
+        total = n;
+      });
+  ioc.run();
+
+  ASIO_CHECK(ec == asio::error::eof);
+  ASIO_CHECK(total == 30 + 20 + 10 + 20);
+  ASIO_CHECK(!requests[0].error);
+  ASIO_CHECK(requests[0].bytes_transferred == 30);
+  ASIO_CHECK(std::memcmp(buf1 + 20, data.data() + 150, 30) == 0);
+  ASIO_CHECK(!requests[1].error);
+  ASIO_CHECK(requests[1].bytes_transferred == 20);
+  ASIO_CHECK(std::memcmp(buf1, data.data() + 100, 20) == 0);
+  ASIO_CHECK(!requests[2].error);
+  ASIO_CHECK(requests[2].bytes_transferred == 10);
+  ASIO_CHECK(std::memcmp(buf2, data.data() + 120, 10) == 0);
+  ASIO_CHECK(requests[3].error == asio::error::eof);
+  ASIO_CHECK(requests[3].bytes_transferred == 20);
+  ASIO_CHECK(std::memcmp(buf2 + 10, data.data() + 980, 20) == 0);
+
+  // The merged range of 50 bytes, and the ranges of 10 bytes and of 20 bytes
+  // followed by eof, each read 7 bytes at a time.
+  ASIO_CHECK(device.reads() == 8 + 2 + 4);
+}
+
+void test_empty()
+{
+  asio::io_context ioc;
+  test_random_access_device device(ioc, make_data(10), 10);
+
+  char buf[1];
+  file_base::read_request request(0, asio::buffer(buf, 0));
+
+  int calls = 0;
+  asio::async_read_ranges_at(device, &request, 1,
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        ASIO_CHECK(!e);
+        ASIO_CHECK(n == 0);
+        ++calls;
+      });
+  asio::async_read_ranges_at(device, 0, 0,
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        ASIO_CHECK(!e);
+        ASIO_CHECK(n == 0);
+        ++calls;
+      });
+  ASIO_CHECK(calls == 0);
+  ioc.run();
+  ASIO_CHECK(calls == 2);
+  ASIO_CHECK(device.reads() == 0);
+}
+
+#if !defined(ASIO_WINDOWS)
+
+void test_file()
+{
+  char name[] = "/tmp/asio_read_ranges_at_XXXXXX";
+  int fd = ::mkstemp(name);
+  if (fd != -1)
+    ::close(fd);
+
+  asio::io_context ioc;
+  std::string data = make_data(100000);
+  {
+    asio::random_access_file file(ioc, name,
+        asio::random_access_file::read_write);
+    asio::write_at(file, 0, asio::buffer(data));
+
+    std::vector<char> chunks(3000);
+    std::vector<file_base::read_request> requests;
+    for (std::size_t i = 0; i < 30; ++i)
+    {
+      // Every third chunk is adjacent to the one before it.
+      asio::uint64_t offset = (i / 3) * 9000 + (i % 3) * 100;
+      requests.push_back(file_base::read_request(offset,
+            asio::buffer(&chunks[i * 100], 100)));
+    }
+
+    asio::error_code ec;
+    std::size_t total = 0;
+    asio::async_read_ranges_at(file, requests.data(), requests.size(),
+        [&](const asio::error_code& e, std::size_t n)
+        {
+          ec = e;
+          total = n;
+        });
+    ioc.run();
+
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(total == 3000);
+    for (std::size_t i = 0; i < requests.size(); ++i)
+    {
+      ASIO_CHECK(!requests[i].error);
+      ASIO_CHECK(requests[i].bytes_transferred == 100);
+      ASIO_CHECK(std::memcmp(&chunks[i * 100],
+            data.data() + requests[i].offset, 100) == 0);
+    }
+  }
+  std::remove(name);
+}
+
+#else // !defined(ASIO_WINDOWS)
+
+void test_file()
+{
+}
+
+#endif // !defined(ASIO_WINDOWS)
+
+#else // defined(ASIO_HAS_FILE)
+
+void test_device()
+{
+}
+
+void test_empty()
+{
+}
+
+void test_file()
+{
+}
+
+#endif // defined(ASIO_HAS_FILE)
+
+} // namespace read_ranges_at_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "read_ranges_at",
+  ASIO_TEST_CASE(read_ranges_at_runtime::test_device)
+  ASIO_TEST_CASE(read_ranges_at_runtime::test_empty)
+  ASIO_TEST_CASE(read_ranges_at_runtime::test_file)
+)
@@ -18,6 +18,7 @@
 
 #include <cstring>
 #include <functional>
+#include <vector>
 #include "archetypes/async_result.hpp"
 #include "asio/io_context.hpp"
 #include "asio/post.hpp"
@@ -1701,6 +1702,61 @@ void test_streambuf_async_read_until_match_condition()
 #endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
 }
 
+void test_buffer_search()
+{
+  using asio::detail::buffer_find;
+  using asio::detail::buffer_partial_search;
+
+  // Data split across several buffers, including an empty one.
+  const char data[] = "abc\r\nde\rfgh\r\n";
+  std::vector<asio::const_buffer> buffers;
+  buffers.push_back(asio::buffer(data, 4));
+  buffers.push_back(asio::const_buffer());
+  buffers.push_back(asio::buffer(data + 4, 5));
+  buffers.push_back(asio::buffer(data + 9, 4));
+
+  ASIO_CHECK(buffer_find(buffers, 0, 'a') == 0);
+  ASIO_CHECK(buffer_find(buffers, 0, '\n') == 4);
+  ASIO_CHECK(buffer_find(buffers, 5, '\n') == 12);
+  ASIO_CHECK(buffer_find(buffers, 0, 'h') == 10);
+  ASIO_CHECK(buffer_find(buffers, 0, 'z') == 13);
+  ASIO_CHECK(buffer_find(buffers, 13, 'a') == 13);
+
+  // A match that spans two buffers.
+  std::pair<std::size_t, bool> result =
+    buffer_partial_search(buffers, 0, "\r\n", 2);
+  ASIO_CHECK(result.first == 3);
+  ASIO_CHECK(result.second);
+
+  // A false start is skipped.
+  result = buffer_partial_search(buffers, 4, "\r\n", 2);
+  ASIO_CHECK(result.first == 11);
+  ASIO_CHECK(result.second);
+
+  result = buffer_partial_search(buffers, 0, "de\rf", 4);
+  ASIO_CHECK(result.first == 5);
+  ASIO_CHECK(result.second);
+
+  // A partial match at the end of the data.
+  result = buffer_partial_search(buffers, 0, "\r\nX", 3);
+  ASIO_CHECK(result.first == 11);
+  ASIO_CHECK(!result.second);
+
+  result = buffer_partial_search(buffers, 0, "xyz", 3);
+  ASIO_CHECK(result.first == 13);
+  ASIO_CHECK(!result.second);
+
+  // An empty string matches at the starting position, if it is within the
+  // data.
+  result = buffer_partial_search(buffers, 2, "", 0);
+  ASIO_CHECK(result.first == 2);
+  ASIO_CHECK(result.second);
+
+  result = buffer_partial_search(buffers, 13, "", 0);
+  ASIO_CHECK(result.first == 13);
+  ASIO_CHECK(!result.second);
+}
+
 ASIO_TEST_SUITE
 (
   "read_until",
@@ -1716,4 +1772,5 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(test_streambuf_async_read_until_string)
   ASIO_TEST_CASE(test_dynamic_string_async_read_until_match_condition)
   ASIO_TEST_CASE(test_streambuf_async_read_until_match_condition)
+  ASIO_TEST_CASE(test_buffer_search)
 )
@@ -45,6 +45,15 @@ private:
   read_some_handler(const read_some_handler&);
 };
 
+struct wait_handler
+{
+  wait_handler() {}
+  void operator()(const asio::error_code&) {}
+  wait_handler(wait_handler&&) {}
+private:
+  wait_handler(const wait_handler&);
+};
+
 void test()
 {
 #if defined(ASIO_HAS_PIPE)
@@ -115,6 +124,15 @@ void test()
     pipe1.async_read_some(buffer(mutable_char_buffer), read_some_handler());
     int i3 = pipe1.async_read_some(buffer(mutable_char_buffer), lazy);
     (void)i3;
+
+#if !defined(ASIO_HAS_IOCP)
+    pipe1.wait();
+    pipe1.wait(ec);
+
+    pipe1.async_wait(wait_handler());
+    int i4 = pipe1.async_wait(lazy);
+    (void)i4;
+#endif // !defined(ASIO_HAS_IOCP)
   }
   catch (std::exception&)
   {
@@ -0,0 +1,274 @@
+//
+// readiness_set.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/readiness_set.hpp"
+
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_READINESS_SET)
+
+#include "asio/io_context.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
+#include "asio/write.hpp"
+
+//------------------------------------------------------------------------------
+
+// readiness_set_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// readiness_set compile and link correctly. Runtime failures are ignored.
+
+namespace readiness_set_compile {
+
+void wait_handler(const asio::error_code&, std::size_t)
+{
+}
+
+void test()
+{
+  try
+  {
+    asio::io_context ioc;
+    const asio::io_context::executor_type ioc_ex = ioc.get_executor();
+    asio::error_code ec;
+    asio::readiness_event events[4];
+
+    asio::readiness_set set1(ioc);
+    asio::readiness_set set2(ioc_ex);
+
+    set1.open();
+    set2.open(ec);
+
+    bool b = set1.is_open();
+    (void)b;
+
+    asio::readiness_set::native_handle_type h = set1.native_handle();
+    (void)h;
+
+    asio::readiness_set::interest_flags interest =
+      asio::readiness_set::interest_read
+        | asio::readiness_set::interest_write
+        | asio::readiness_set::interest_priority;
+
+    set1.add(0, interest);
+    set1.add(0, interest, ec);
+    set1.modify(0, interest);
+    set1.modify(0, interest, ec);
+    set1.remove(0);
+    set1.remove(0, ec);
+
+    std::size_t n = set1.poll(events, 4);
+    n = set1.poll(events, 4, ec);
+    (void)n;
+
+    asio::readiness_event::native_handle_type d = events[0].native_handle();
+    (void)d;
+    b = events[0].readable();
+    b = events[0].writable();
+    b = events[0].priority();
+    b = events[0].hangup();
+    b = events[0].error();
+
+    set1.async_wait(events, 4, &wait_handler);
+
+    set1.cancel();
+    set1.close();
+    set2.close(ec);
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace readiness_set_compile
+
+//------------------------------------------------------------------------------
+
+// readiness_set_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the readiness_set class.
+
+namespace readiness_set_runtime {
+
+using asio::local::stream_protocol;
+
+struct wait_result
+{
+  asio::error_code ec;
+  std::size_t n;
+  int calls;
+};
+
+void wait(asio::io_context& ioc, asio::readiness_set& set,
+    asio::readiness_event* events, std::size_t max_events, wait_result& r)
+{
+  r.n = 0;
+  r.calls = 0;
+  set.async_wait(events, max_events,
+      [&r](asio::error_code ec, std::size_t n)
+      {
+        r.ec = ec;
+        r.n = n;
+        ++r.calls;
+      });
+
+  // The handler is never invoked from within async_wait().
+  ASIO_CHECK(r.calls == 0);
+
+  ioc.restart();
+  ioc.run();
+}
+
+void test()
+{
+  asio::io_context ioc;
+  asio::readiness_set set(ioc);
+  set.open();
+  ASIO_CHECK(set.is_open());
+
+  stream_protocol::socket a[3] = { stream_protocol::socket(ioc),
+    stream_protocol::socket(ioc), stream_protocol::socket(ioc) };
+  stream_protocol::socket b[3] = { stream_protocol::socket(ioc),
+    stream_protocol::socket(ioc), stream_protocol::socket(ioc) };
+  for (int i = 0; i < 3; ++i)
+  {
+    asio::local::connect_pair(a[i], b[i]);
+    set.add(a[i].native_handle(), asio::readiness_set::interest_read);
+  }
+
+  asio::readiness_event events[4];
+  ASIO_CHECK(set.poll(events, 4) == 0);
+
+  // Two descriptors become ready and are reported by one completion.
+  asio::write(b[0], asio::buffer("x", 1));
+  asio::write(b[2], asio::buffer("x", 1));
+
+  wait_result r;
+  wait(ioc, set, events, 4, r);
+  ASIO_CHECK(r.calls == 1);
+  ASIO_CHECK(!r.ec);
+  ASIO_CHECK(r.n == 2);
+  bool seen[3] = { false, false, false };
+  for (std::size_t i = 0; i < r.n; ++i)
+  {
+    ASIO_CHECK(events[i].readable());
+    ASIO_CHECK(!events[i].writable());
+    for (int j = 0; j < 3; ++j)
+      if (events[i].native_handle() == a[j].native_handle())
+        seen[j] = true;
+  }
+  ASIO_CHECK(seen[0] && !seen[1] && seen[2]);
+
+  // Descriptors that are not drained are reported again, limited by the
+  // size of the array.
+  wait(ioc, set, events, 1, r);
+  ASIO_CHECK(!r.ec);
+  ASIO_CHECK(r.n == 1);
+
+  char data;
+  a[0].read_some(asio::buffer(&data, 1));
+  a[2].read_some(asio::buffer(&data, 1));
+  ASIO_CHECK(set.poll(events, 4) == 0);
+
+  // A wait that starts before any descriptor is ready completes once one is.
+  r.calls = 0;
+  set.async_wait(events, 4,
+      [&r](asio::error_code ec, std::size_t n)
+      {
+        r.ec = ec;
+        r.n = n;
+        ++r.calls;
+      });
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(r.calls == 0);
+  asio::write(b[1], asio::buffer("x", 1));
+  ioc.run();
+  ASIO_CHECK(r.calls == 1);
+  ASIO_CHECK(!r.ec);
+  ASIO_CHECK(r.n == 1);
+  ASIO_CHECK(events[0].native_handle() == a[1].native_handle());
+  a[1].read_some(asio::buffer(&data, 1));
+
+  // Interest may be changed and removed.
+  set.modify(a[0].native_handle(), asio::readiness_set::interest_write);
+  set.remove(a[1].native_handle());
+  set.remove(a[2].native_handle());
+  wait(ioc, set, events, 4, r);
+  ASIO_CHECK(!r.ec);
+  ASIO_CHECK(r.n == 1);
+  ASIO_CHECK(events[0].native_handle() == a[0].native_handle());
+  ASIO_CHECK(events[0].writable());
+
+  asio::error_code ec;
+  set.remove(a[1].native_handle(), ec);
+  ASIO_CHECK(ec == asio::error_code(ENOENT, asio::system_category()));
+
+  // Hang-ups are reported without being requested.
+  set.remove(a[0].native_handle());
+  set.add(a[1].native_handle(), 0);
+  b[1].close();
+  wait(ioc, set, events, 4, r);
+  ASIO_CHECK(!r.ec);
+  ASIO_CHECK(r.n == 1);
+  ASIO_CHECK(events[0].hangup());
+  set.remove(a[1].native_handle());
+
+  // A pending wait is cancelled.
+  r.calls = 0;
+  set.async_wait(events, 4,
+      [&r](asio::error_code ec, std::size_t n)
+      {
+        r.ec = ec;
+        r.n = n;
+        ++r.calls;
+      });
+  ioc.restart();
+  ioc.poll();
+  set.cancel();
+  ioc.run();
+  ASIO_CHECK(r.calls == 1);
+  ASIO_CHECK(r.ec == asio::error::operation_aborted);
+  ASIO_CHECK(r.n == 0);
+
+  set.close();
+  ASIO_CHECK(!set.is_open());
+  wait(ioc, set, events, 4, r);
+  ASIO_CHECK(r.calls == 1);
+  ASIO_CHECK(r.ec == asio::error::bad_descriptor);
+}
+
+} // namespace readiness_set_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "readiness_set",
+  ASIO_COMPILE_TEST_CASE(readiness_set_compile::test)
+  ASIO_TEST_CASE(readiness_set_runtime::test)
+)
+
+#else // defined(ASIO_HAS_READINESS_SET)
+
+ASIO_TEST_SUITE
+(
+  "readiness_set",
+  ASIO_TEST_CASE(null_test)
+)
+
+#endif // defined(ASIO_HAS_READINESS_SET)
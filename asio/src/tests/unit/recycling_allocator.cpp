@@ -17,8 +17,11 @@
 #include "asio/recycling_allocator.hpp"
 
 #include "unit_test.hpp"
+#include <thread>
 #include <vector>
 #include "asio/detail/type_traits.hpp"
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
 
 void recycling_allocator_test()
 {
@@ -73,8 +76,112 @@ void recycling_allocator_test()
   ASIO_CHECK(v.size() == 42);
 }
 
+void recycling_allocator_statistics_test()
+{
+  asio::recycling_allocator_statistics s1
+    = asio::get_recycling_allocator_statistics();
+
+  ASIO_CHECK(s1.allocations == 0);
+  ASIO_CHECK(s1.cached_blocks == 0);
+
+  asio::io_context ioc;
+  asio::recycling_allocator_statistics s2 = {};
+  asio::recycling_allocator_statistics s3 = {};
+
+  asio::post(ioc,
+      [&]()
+      {
+        asio::recycling_allocator<char> a;
+        std::vector<char*> blocks;
+        for (int i = 0; i < 8; ++i)
+          blocks.push_back(a.allocate(100));
+        for (int i = 0; i < 8; ++i)
+          a.deallocate(blocks[i], 100);
+        s2 = asio::get_recycling_allocator_statistics();
+
+        for (int i = 0; i < 8; ++i)
+          blocks[i] = a.allocate(100);
+        for (int i = 0; i < 8; ++i)
+          a.deallocate(blocks[i], 100);
+        s3 = asio::get_recycling_allocator_statistics();
+      });
+
+  ioc.run();
+
+#if defined(ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES) \
+  && (ASIO_RECYCLING_ALLOCATOR_SIZE_CLASS_DEPTH >= 8)
+  ASIO_CHECK(s2.allocations >= 8);
+  ASIO_CHECK(s2.deallocations >= 8);
+  ASIO_CHECK(s2.cached_blocks >= 8);
+  ASIO_CHECK(s2.cached_bytes >= 8 * 100);
+  ASIO_CHECK(s3.allocations == s2.allocations + 8);
+  ASIO_CHECK(s3.cache_hits == s2.cache_hits + 8);
+  ASIO_CHECK(s3.cached_blocks == s2.cached_blocks);
+#elif !defined(ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
+  ASIO_CHECK(s2.allocations >= 8);
+  ASIO_CHECK(s2.deallocations >= 8);
+  ASIO_CHECK(s2.cached_blocks == 0);
+  ASIO_CHECK(s3.allocations == s2.allocations + 8);
+  ASIO_CHECK(s3.deallocations == s2.deallocations + 8);
+#endif // !defined(ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
+  ASIO_CHECK(s2.bytes_allocated >= 8 * 100);
+  ASIO_CHECK(s3.bytes_allocated == s2.bytes_allocated + 8 * 100);
+  ASIO_CHECK(s3.bytes_deallocated == s2.bytes_deallocated + 8 * 100);
+}
+
+void recycling_allocator_remote_free_test()
+{
+  asio::io_context ioc;
+  asio::recycling_allocator_statistics s1 = {};
+  asio::recycling_allocator_statistics s2 = {};
+  asio::recycling_allocator_statistics s3 = {};
+
+  asio::post(ioc,
+      [&]()
+      {
+        asio::recycling_allocator<char> a;
+        std::vector<char*> blocks;
+        for (int i = 0; i < 8; ++i)
+          blocks.push_back(a.allocate(100));
+
+        // Release the blocks on another thread.
+        asio::io_context consumer;
+        asio::post(consumer,
+            [&]()
+            {
+              for (int i = 0; i < 8; ++i)
+                a.deallocate(blocks[i], 100);
+              s1 = asio::get_recycling_allocator_statistics();
+            });
+        std::thread t([&](){ consumer.run(); });
+        t.join();
+
+        s2 = asio::get_recycling_allocator_statistics();
+        for (int i = 0; i < 8; ++i)
+          blocks[i] = a.allocate(100);
+        s3 = asio::get_recycling_allocator_statistics();
+        for (int i = 0; i < 8; ++i)
+          a.deallocate(blocks[i], 100);
+      });
+
+  ioc.run();
+
+#if defined(ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE) \
+  && (ASIO_RECYCLING_ALLOCATOR_SIZE_CLASS_DEPTH >= 8)
+  ASIO_CHECK(s1.remote_releases >= 8);
+  ASIO_CHECK(s1.cached_blocks == 0);
+  ASIO_CHECK(s3.remote_returns >= s2.remote_returns + 8);
+  ASIO_CHECK(s3.cache_hits == s2.cache_hits + 8);
+#else // defined(ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE) ...
+  ASIO_CHECK(s1.remote_releases == 0);
+  ASIO_CHECK(s3.remote_returns == 0);
+#endif // defined(ASIO_RECYCLING_ALLOCATOR_REMOTE_FREE) ...
+}
+
 ASIO_TEST_SUITE
 (
   "recycling_allocator",
   ASIO_TEST_CASE(recycling_allocator_test)
+  ASIO_TEST_CASE(recycling_allocator_statistics_test)
+  ASIO_TEST_CASE(recycling_allocator_remote_free_test)
 )
@@ -0,0 +1,298 @@
+//
+// registered_buffer_pool.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/registered_buffer_pool.hpp"
+
+#include <cstring>
+#include <set>
+#include <vector>
+#include "asio/config.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/thread_pool.hpp"
+#include "asio/post.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// registered_buffer_pool_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// registered_buffer_pool compile and link correctly. Runtime failures are
+// ignored.
+
+namespace registered_buffer_pool_compile {
+
+void test()
+{
+  using namespace asio;
+
+  try
+  {
+    io_context ioc;
+    asio::error_code ec;
+
+    registered_buffer_pool pool1(ioc, 4, 1024);
+    registered_buffer_pool pool2(ioc.get_executor(), 4, 1024);
+
+    std::size_t n1 = pool1.block_count();
+    (void)n1;
+
+    std::size_t n2 = pool1.block_size();
+    (void)n2;
+
+    std::size_t n3 = pool1.available();
+    (void)n3;
+
+    bool b1 = pool1.is_registered();
+    (void)b1;
+
+    mutable_registered_buffer b2 = pool1.acquire();
+    pool1.release(b2);
+
+    mutable_registered_buffer b3 = pool1.acquire(ec);
+    pool1.release(b3);
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace registered_buffer_pool_compile
+
+//------------------------------------------------------------------------------
+
+// registered_buffer_pool_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the
+// registered_buffer_pool class.
+
+namespace registered_buffer_pool_runtime {
+
+void test_acquire_release()
+{
+  asio::io_context ioc;
+  asio::registered_buffer_pool pool(ioc, 8, 100);
+
+  ASIO_CHECK(pool.block_count() == 8);
+  ASIO_CHECK(pool.block_size() == 100);
+  ASIO_CHECK(pool.available() == 8);
+
+  std::vector<asio::mutable_registered_buffer> buffers;
+  std::set<void*> addresses;
+  std::set<int> ids;
+  for (int i = 0; i < 8; ++i)
+  {
+    asio::error_code ec;
+    buffers.push_back(pool.acquire(ec));
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(buffers.back().size() == 100);
+    addresses.insert(buffers.back().data());
+    ids.insert(buffers.back().id().native_handle());
+  }
+  ASIO_CHECK(addresses.size() == 8);
+  ASIO_CHECK(ids.size() == 8);
+  ASIO_CHECK(pool.available() == 0);
+
+  // The exhausted pool reports an error.
+  asio::error_code ec;
+  asio::mutable_registered_buffer b = pool.acquire(ec);
+  ASIO_CHECK(ec == asio::error::no_buffer_space);
+  ASIO_CHECK(b.size() == 0);
+
+  bool caught = false;
+  try
+  {
+    pool.acquire();
+  }
+  catch (asio::system_error& e)
+  {
+    caught = (e.code() == asio::error::no_buffer_space);
+  }
+  ASIO_CHECK(caught);
+
+  // A buffer that has been advanced is still returned to the pool.
+  buffers[3] += 10;
+  pool.release(buffers[3]);
+  ASIO_CHECK(pool.available() == 1);
+  b = pool.acquire(ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(b.data() == static_cast<char*>(buffers[3].data()) - 10);
+  ASIO_CHECK(b.size() == 100);
+  buffers[3] = b;
+
+  for (std::size_t i = 0; i < buffers.size(); ++i)
+    pool.release(buffers[i]);
+  ASIO_CHECK(pool.available() == 8);
+}
+
+void test_invalid_arguments()
+{
+  asio::io_context ioc;
+
+  bool caught = false;
+  try
+  {
+    asio::registered_buffer_pool pool(ioc, 0, 100);
+  }
+  catch (asio::system_error& e)
+  {
+    caught = (e.code() == asio::error::invalid_argument);
+  }
+  ASIO_CHECK(caught);
+
+  caught = false;
+  try
+  {
+    asio::registered_buffer_pool pool(ioc, 8, 0);
+  }
+  catch (asio::system_error& e)
+  {
+    caught = (e.code() == asio::error::invalid_argument);
+  }
+  ASIO_CHECK(caught);
+}
+
+void test_threads()
+{
+  asio::io_context ioc;
+  asio::registered_buffer_pool pool(ioc, 16, 64);
+
+  // Buffers acquired on one thread may be released on another, and every
+  // buffer remains available to every thread.
+  asio::thread_pool threads(4);
+  for (int t = 0; t < 4; ++t)
+  {
+    asio::post(threads,
+        [&pool]()
+        {
+          for (int i = 0; i < 1000; ++i)
+          {
+            asio::mutable_registered_buffer b = pool.acquire();
+            std::memset(b.data(), i & 0xFF, b.size());
+            pool.release(b);
+          }
+        });
+  }
+  threads.join();
+  ASIO_CHECK(pool.available() == 16);
+
+  asio::thread_pool other(1);
+  asio::post(other,
+      [&pool]()
+      {
+        std::vector<asio::mutable_registered_buffer> buffers;
+        for (int i = 0; i < 16; ++i)
+          buffers.push_back(pool.acquire());
+        for (std::size_t i = 0; i < buffers.size(); ++i)
+          pool.release(buffers[i]);
+      });
+  other.join();
+  ASIO_CHECK(pool.available() == 16);
+}
+
+void test_socket_io()
+{
+  using asio::ip::tcp;
+
+  asio::io_context ioc;
+  asio::registered_buffer_pool pool(ioc, 2, 256);
+
+  tcp::acceptor acceptor(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket client(ioc), server(ioc);
+  client.connect(acceptor.local_endpoint());
+  acceptor.accept(server);
+
+  asio::mutable_registered_buffer write_buf = pool.acquire();
+  asio::mutable_registered_buffer read_buf = pool.acquire();
+  std::memset(write_buf.data(), 'x', write_buf.size());
+  std::memset(read_buf.data(), 0, read_buf.size());
+
+  asio::error_code write_ec, read_ec;
+  std::size_t written = 0, read = 0;
+  client.async_write_some(write_buf,
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        write_ec = ec;
+        written = n;
+      });
+  server.async_read_some(read_buf,
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        read_ec = ec;
+        read = n;
+      });
+  ioc.run();
+
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(written == 256);
+  ASIO_CHECK(read > 0);
+  ASIO_CHECK(std::memcmp(read_buf.data(), write_buf.data(), read) == 0);
+
+  pool.release(write_buf);
+  pool.release(read_buf);
+}
+
+void test_huge_pages()
+{
+  asio::io_context ioc(asio::config_from_string("memory.huge_pages=1"));
+
+  // The pool falls back to the system allocator if huge pages are not
+  // available, so only the behaviour of the buffers is checked.
+  {
+    asio::registered_buffer_pool pool(ioc, 8, 4096);
+    ASIO_CHECK(pool.available() == 8);
+
+    std::vector<asio::mutable_registered_buffer> buffers;
+    for (int i = 0; i < 8; ++i)
+    {
+      buffers.push_back(pool.acquire());
+      std::memset(buffers.back().data(), i, buffers.back().size());
+    }
+    for (int i = 0; i < 8; ++i)
+    {
+      ASIO_CHECK(static_cast<unsigned char*>(buffers[i].data())[0] == i);
+      ASIO_CHECK(static_cast<unsigned char*>(buffers[i].data())[4095] == i);
+      pool.release(buffers[i]);
+    }
+  }
+
+  // Handler memory is also taken from the arena.
+  int count = 0;
+  for (int i = 0; i < 100; ++i)
+    asio::post(ioc, [&count]{ ++count; });
+  ioc.run();
+  ASIO_CHECK(count == 100);
+
+  asio::registered_buffer_pool pool(ioc, 4, 1024);
+  ASIO_CHECK(pool.available() == 4);
+}
+
+} // namespace registered_buffer_pool_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "registered_buffer_pool",
+  ASIO_COMPILE_TEST_CASE(registered_buffer_pool_compile::test)
+  ASIO_TEST_CASE(registered_buffer_pool_runtime::test_acquire_release)
+  ASIO_TEST_CASE(registered_buffer_pool_runtime::test_invalid_arguments)
+  ASIO_TEST_CASE(registered_buffer_pool_runtime::test_threads)
+  ASIO_TEST_CASE(registered_buffer_pool_runtime::test_socket_io)
+  ASIO_TEST_CASE(registered_buffer_pool_runtime::test_huge_pages)
+)
@@ -0,0 +1,251 @@
+//
+// relay.cpp
+// ~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/relay.hpp"
+
+#include <string>
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// relay_compile test
+// ~~~~~~~~~~~~~~~~~~
+// The following test checks that all variants of async_relay compile and link
+// correctly. Runtime failures are ignored.
+
+namespace relay_compile {
+
+void relay_handler(const asio::error_code&, std::size_t, std::size_t)
+{
+}
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    ip::tcp::socket sock1(ioc);
+    ip::tcp::socket sock2(ioc);
+
+    relay_options options;
+    options.buffer_size = 4096;
+    options.half_close = false;
+    options.use_splice = false;
+
+    async_relay(sock1, sock2, relay_options(), &relay_handler);
+    async_relay(sock1, sock2, options, &relay_handler);
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace relay_compile
+
+//------------------------------------------------------------------------------
+
+// relay_runtime test
+// ~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime behaviour of the async_relay function.
+
+namespace relay_runtime {
+
+using asio::ip::tcp;
+
+// A pair of connected sockets.
+struct connection
+{
+  explicit connection(asio::io_context& ioc)
+    : client(ioc),
+      server(ioc)
+  {
+    tcp::acceptor acceptor(ioc,
+        tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+    client.connect(acceptor.local_endpoint());
+    acceptor.accept(server);
+  }
+
+  tcp::socket client;
+  tcp::socket server;
+};
+
+struct relay_result
+{
+  relay_result()
+    : called(false),
+      a_to_b(0),
+      b_to_a(0)
+  {
+  }
+
+  bool called;
+  asio::error_code ec;
+  std::size_t a_to_b;
+  std::size_t b_to_a;
+};
+
+void run_relay(bool use_splice)
+{
+  asio::io_context ioc;
+
+  // The relay sits between c1.server and c2.client. Data written to c1.client
+  // arrives at c2.server, and vice versa.
+  connection c1(ioc);
+  connection c2(ioc);
+
+  asio::relay_options options;
+  options.buffer_size = 1000;
+  options.use_splice = use_splice;
+
+  relay_result result;
+  asio::async_relay(c1.server, c2.client, options,
+      [&](const asio::error_code& e, std::size_t a_to_b, std::size_t b_to_a)
+      {
+        result.called = true;
+        result.ec = e;
+        result.a_to_b = a_to_b;
+        result.b_to_a = b_to_a;
+      });
+
+  std::string up(100000, 'u');
+  std::string down(5000, 'd');
+
+  // Each end writes its data and then shuts down its sending side. The
+  // shutdown is passed through the relay, so each peer reads until eof.
+  asio::async_write(c1.client, asio::buffer(up),
+      [&](const asio::error_code& e, std::size_t)
+      {
+        ASIO_CHECK(!e);
+        c1.client.shutdown(tcp::socket::shutdown_send);
+      });
+  asio::async_write(c2.server, asio::buffer(down),
+      [&](const asio::error_code& e, std::size_t)
+      {
+        ASIO_CHECK(!e);
+        c2.server.shutdown(tcp::socket::shutdown_send);
+      });
+
+  std::string up_received;
+  std::string down_received;
+  asio::async_read(c2.server, asio::dynamic_buffer(up_received),
+      [&](const asio::error_code& e, std::size_t)
+      {
+        ASIO_CHECK(e == asio::error::eof);
+      });
+  asio::async_read(c1.client, asio::dynamic_buffer(down_received),
+      [&](const asio::error_code& e, std::size_t)
+      {
+        ASIO_CHECK(e == asio::error::eof);
+      });
+
+  ioc.run();
+
+  ASIO_CHECK(result.called);
+  ASIO_CHECK(!result.ec);
+  ASIO_CHECK(result.a_to_b == up.size());
+  ASIO_CHECK(result.b_to_a == down.size());
+  ASIO_CHECK(up_received == up);
+  ASIO_CHECK(down_received == down);
+}
+
+void test_copy()
+{
+  run_relay(false);
+}
+
+void test_splice()
+{
+  run_relay(true);
+}
+
+void test_no_half_close()
+{
+  asio::io_context ioc;
+  connection c1(ioc);
+  connection c2(ioc);
+
+  asio::relay_options options;
+  options.half_close = false;
+
+  relay_result result;
+  asio::async_relay(c1.server, c2.client, options,
+      [&](const asio::error_code& e, std::size_t a_to_b, std::size_t b_to_a)
+      {
+        result.called = true;
+        result.ec = e;
+        result.a_to_b = a_to_b;
+        result.b_to_a = b_to_a;
+      });
+
+  // Nothing is ever sent from c2.server, so the relay finishes only because
+  // the other direction reaches eof.
+  asio::write(c1.client, asio::buffer("hello", 5));
+  c1.client.shutdown(tcp::socket::shutdown_send);
+
+  ioc.run();
+
+  ASIO_CHECK(result.called);
+  ASIO_CHECK(!result.ec);
+  ASIO_CHECK(result.a_to_b == 5);
+  ASIO_CHECK(result.b_to_a == 0);
+
+  char data[5];
+  asio::read(c2.server, asio::buffer(data));
+  ASIO_CHECK(std::string(data, 5) == "hello");
+}
+
+void test_invalid_buffer_size()
+{
+  asio::io_context ioc;
+  connection c(ioc);
+
+  asio::relay_options options;
+  options.buffer_size = 0;
+
+  relay_result result;
+  asio::async_relay(c.client, c.server, options,
+      [&](const asio::error_code& e, std::size_t, std::size_t)
+      {
+        result.called = true;
+        result.ec = e;
+      });
+
+  ASIO_CHECK(!result.called);
+  ioc.run();
+  ASIO_CHECK(result.called);
+  ASIO_CHECK(result.ec == asio::error::invalid_argument);
+}
+
+} // namespace relay_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "relay",
+  ASIO_COMPILE_TEST_CASE(relay_compile::test)
+  ASIO_TEST_CASE(relay_runtime::test_copy)
+  ASIO_TEST_CASE(relay_runtime::test_splice)
+  ASIO_TEST_CASE(relay_runtime::test_no_half_close)
+  ASIO_TEST_CASE(relay_runtime::test_invalid_buffer_size)
+)
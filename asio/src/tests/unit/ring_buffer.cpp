@@ -0,0 +1,264 @@
+//
+// ring_buffer.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/ring_buffer.hpp"
+
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/read_until.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// ring_buffer_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the dynamic_ring_buffer class satisfies the
+// DynamicBuffer_v2 type requirements.
+
+namespace ring_buffer_compile {
+
+static_assert(asio::is_dynamic_buffer_v2<asio::dynamic_ring_buffer>::value,
+    "dynamic_ring_buffer must be a DynamicBuffer_v2");
+static_assert(!asio::is_dynamic_buffer_v1<asio::dynamic_ring_buffer>::value,
+    "dynamic_ring_buffer must not be a DynamicBuffer_v1");
+
+void test()
+{
+  asio::ring_buffer ring(1024);
+  asio::dynamic_ring_buffer db = asio::dynamic_buffer(ring);
+  const asio::dynamic_ring_buffer& cdb = db;
+
+  asio::dynamic_ring_buffer::mutable_buffers_type mb = db.data(0, 1);
+  (void)mb;
+  asio::dynamic_ring_buffer::const_buffers_type cb = cdb.data(0, 1);
+  (void)cb;
+  asio::mutable_buffer mb2 = ring.data();
+  (void)mb2;
+}
+
+} // namespace ring_buffer_compile
+
+//------------------------------------------------------------------------------
+
+// ring_buffer_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the ring_buffer and
+// dynamic_ring_buffer classes.
+
+namespace ring_buffer_runtime {
+
+// A stream that produces numbered lines of text, a few bytes at a time.
+class line_stream
+{
+public:
+  typedef asio::io_context::executor_type executor_type;
+
+  line_stream(asio::io_context& io_context, int lines)
+    : io_context_(io_context),
+      position_(0)
+  {
+    for (int i = 0; i < lines; ++i)
+      data_ += "line " + std::to_string(i) + "\n";
+  }
+
+  executor_type get_executor() noexcept
+  {
+    return io_context_.get_executor();
+  }
+
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    if (position_ == data_.size() && asio::buffer_size(buffers) > 0)
+    {
+      ec = asio::error::eof;
+      return 0;
+    }
+
+    ec = asio::error_code();
+    std::size_t n = asio::buffer_copy(buffers,
+        asio::buffer(data_) + position_, 37);
+    position_ += n;
+    return n;
+  }
+
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers)
+  {
+    asio::error_code ec;
+    return read_some(buffers, ec);
+  }
+
+  template <typename MutableBufferSequence, typename Handler>
+  void async_read_some(const MutableBufferSequence& buffers, Handler handler)
+  {
+    asio::error_code ec;
+    std::size_t bytes_transferred = read_some(buffers, ec);
+    asio::post(get_executor(),
+        asio::detail::bind_handler(
+          static_cast<Handler&&>(handler), ec, bytes_transferred));
+  }
+
+private:
+  asio::io_context& io_context_;
+  std::string data_;
+  std::size_t position_;
+};
+
+void test_capacity()
+{
+  asio::ring_buffer ring(100);
+  ASIO_CHECK(ring.capacity() >= 100);
+  ASIO_CHECK(ring.size() == 0);
+  ASIO_CHECK(ring.empty());
+
+  asio::dynamic_ring_buffer db = asio::dynamic_buffer(ring);
+  ASIO_CHECK(db.size() == 0);
+  ASIO_CHECK(db.max_size() == ring.capacity());
+  ASIO_CHECK(db.capacity() == ring.capacity());
+
+  db.grow(ring.capacity());
+  ASIO_CHECK(ring.size() == ring.capacity());
+
+  bool thrown = false;
+  try
+  {
+    db.grow(1);
+  }
+  catch (std::length_error&)
+  {
+    thrown = true;
+  }
+  ASIO_CHECK(thrown);
+  ASIO_CHECK(ring.size() == ring.capacity());
+
+  db.shrink(10);
+  ASIO_CHECK(ring.size() == ring.capacity() - 10);
+  db.consume(ring.capacity());
+  ASIO_CHECK(ring.empty());
+}
+
+void test_wraparound()
+{
+  asio::ring_buffer ring(4096);
+  asio::dynamic_ring_buffer db = asio::dynamic_buffer(ring);
+  const std::size_t capacity = ring.capacity();
+
+  // Leave a little data close to the end of the storage, then add more so
+  // that the data wraps around the end.
+  db.grow(capacity - 10);
+  db.consume(capacity - 20);
+  ASIO_CHECK(ring.size() == 10);
+  std::size_t pos = ring.size();
+  db.grow(100);
+  asio::mutable_buffer b = db.data(pos, 100);
+  ASIO_CHECK(b.size() == 100);
+  for (std::size_t i = 0; i < 100; ++i)
+    static_cast<char*>(b.data())[i] = static_cast<char>(i);
+
+  db.consume(pos);
+  asio::const_buffer data = ring.data();
+  ASIO_CHECK(data.size() == 100);
+  bool match = true;
+  for (std::size_t i = 0; i < 100; ++i)
+    if (static_cast<const char*>(data.data())[i] != static_cast<char>(i))
+      match = false;
+  ASIO_CHECK(match);
+
+  // The full capacity remains usable as a single contiguous buffer.
+  db.grow(capacity - 100);
+  ASIO_CHECK(ring.data().size() == capacity);
+  ASIO_CHECK(db.data(0, capacity).size() == capacity);
+}
+
+void test_read_until()
+{
+  asio::io_context ioc;
+  line_stream s(ioc, 1000);
+  asio::ring_buffer ring(4096);
+
+  // The lines amount to several times the capacity of the ring.
+  bool match = true;
+  for (int i = 0; i < 1000; ++i)
+  {
+    std::size_t n = asio::read_until(s, asio::dynamic_buffer(ring), '\n');
+    std::string expected = "line " + std::to_string(i) + "\n";
+    if (n != expected.size() || std::memcmp(
+          ring.data().data(), expected.data(), expected.size()) != 0)
+      match = false;
+    ring.consume(n);
+  }
+  ASIO_CHECK(match);
+
+  asio::error_code ec;
+  asio::read_until(s, asio::dynamic_buffer(ring), '\n', ec);
+  ASIO_CHECK(ec == asio::error::eof);
+}
+
+void test_async_read_until()
+{
+  asio::io_context ioc;
+  line_stream s(ioc, 1000);
+  asio::ring_buffer ring(4096);
+
+  int line = 0;
+  bool match = true;
+  asio::error_code last_ec;
+  std::function<void(const asio::error_code&, std::size_t)> handler =
+    [&](const asio::error_code& ec, std::size_t n)
+    {
+      if (ec)
+      {
+        last_ec = ec;
+        return;
+      }
+
+      std::string expected = "line " + std::to_string(line++) + "\n";
+      if (n != expected.size() || std::memcmp(
+            ring.data().data(), expected.data(), expected.size()) != 0)
+        match = false;
+      ring.consume(n);
+
+      asio::async_read_until(s,
+          asio::dynamic_buffer(ring), "\n", handler);
+    };
+
+  asio::async_read_until(s, asio::dynamic_buffer(ring), "\n", handler);
+  ioc.run();
+
+  ASIO_CHECK(line == 1000);
+  ASIO_CHECK(match);
+  ASIO_CHECK(last_ec == asio::error::eof);
+}
+
+} // namespace ring_buffer_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "ring_buffer",
+  ASIO_COMPILE_TEST_CASE(ring_buffer_compile::test)
+  ASIO_TEST_CASE(ring_buffer_runtime::test_capacity)
+  ASIO_TEST_CASE(ring_buffer_runtime::test_wraparound)
+  ASIO_TEST_CASE(ring_buffer_runtime::test_read_until)
+  ASIO_TEST_CASE(ring_buffer_runtime::test_async_read_until)
+)
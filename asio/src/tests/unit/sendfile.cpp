@@ -0,0 +1,301 @@
+//
+// sendfile.cpp
+// ~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/sendfile.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "archetypes/async_result.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/posix/stream_descriptor.hpp"
+#include "asio/random_access_file.hpp"
+#include "asio/read.hpp"
+#include "asio/stream_file.hpp"
+#include "asio/windows/random_access_handle.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+# include <unistd.h>
+#endif // defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+
+#if defined(ASIO_HAS_SENDFILE)
+
+//------------------------------------------------------------------------------
+
+// sendfile_compile test
+// ~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the async_sendfile function compiles for all
+// supported types of file object. Runtime failures are ignored.
+
+namespace sendfile_compile {
+
+struct sendfile_handler
+{
+  sendfile_handler() {}
+  void operator()(const asio::error_code&, std::size_t) {}
+  sendfile_handler(sendfile_handler&&) {}
+private:
+  sendfile_handler(const sendfile_handler&);
+};
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    archetypes::lazy_handler lazy;
+
+    ip::tcp::socket socket1(ioc);
+
+#if defined(ASIO_HAS_FILE)
+    random_access_file file1(ioc);
+    stream_file file2(ioc);
+    async_sendfile(socket1, file1, 0, 1024, sendfile_handler());
+    async_sendfile(socket1, file2, 0, 1024, sendfile_handler());
+    int i1 = async_sendfile(socket1, file1, 0, 1024, lazy);
+    (void)i1;
+#endif // defined(ASIO_HAS_FILE)
+
+#if defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+    posix::stream_descriptor descriptor1(ioc);
+    async_sendfile(socket1, descriptor1, 0, 1024, sendfile_handler());
+    int i2 = async_sendfile(socket1, descriptor1, 0, 1024, lazy);
+    (void)i2;
+#endif // defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+
+#if defined(ASIO_HAS_WINDOWS_RANDOM_ACCESS_HANDLE)
+    windows::random_access_handle handle1(ioc);
+    async_sendfile(socket1, handle1, 0, 1024, sendfile_handler());
+    int i3 = async_sendfile(socket1, handle1, 0, 1024, lazy);
+    (void)i3;
+#endif // defined(ASIO_HAS_WINDOWS_RANDOM_ACCESS_HANDLE)
+
+    ioc.run();
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace sendfile_compile
+
+//------------------------------------------------------------------------------
+
+// sendfile_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the async_sendfile
+// function.
+
+namespace sendfile_runtime {
+
+#if defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+
+using asio::ip::tcp;
+
+std::vector<char> make_data(std::size_t size)
+{
+  std::vector<char> data(size);
+  for (std::size_t i = 0; i < size; ++i)
+    data[i] = static_cast<char>(i % 251);
+  return data;
+}
+
+// Holds a temporary file containing the test data.
+struct temporary_file
+{
+  explicit temporary_file(const std::vector<char>& data)
+  {
+    char name[] = "/tmp/asio_sendfile_XXXXXX";
+    fd = ::mkstemp(name);
+    ::unlink(name);
+    std::size_t written = 0;
+    while (fd != -1 && written < data.size())
+    {
+      ssize_t n = ::write(fd, &data[written], data.size() - written);
+      if (n <= 0)
+        break;
+      written += static_cast<std::size_t>(n);
+    }
+  }
+
+  ~temporary_file()
+  {
+    if (fd != -1)
+      ::close(fd);
+  }
+
+  int fd;
+};
+
+struct sendfile_test
+{
+  explicit sendfile_test(const std::vector<char>& data)
+    : acceptor(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0)),
+      client(ioc),
+      server(ioc),
+      tmp(data),
+      file(ioc, ::dup(tmp.fd))
+  {
+    client.connect(acceptor.local_endpoint());
+    acceptor.accept(server);
+  }
+
+  // Send part of the file and read it back from the other end.
+  void run(asio::uint64_t offset, std::size_t count,
+      asio::error_code& sendfile_ec, std::size_t& sent,
+      std::vector<char>& received)
+  {
+    asio::async_sendfile(server, file, offset, count,
+        [&](const asio::error_code& ec, std::size_t n)
+        {
+          sendfile_ec = ec;
+          sent = n;
+          server.shutdown(tcp::socket::shutdown_send);
+        });
+    asio::async_read(client, asio::dynamic_buffer(received),
+        [](const asio::error_code&, std::size_t) {});
+    ioc.run();
+  }
+
+  asio::io_context ioc;
+  tcp::acceptor acceptor;
+  tcp::socket client;
+  tcp::socket server;
+  temporary_file tmp;
+  asio::posix::stream_descriptor file;
+};
+
+void test_whole_file()
+{
+  // Enough data that the socket fills before the client drains it.
+  std::vector<char> data = make_data(8 * 1024 * 1024);
+  sendfile_test t(data);
+
+  asio::error_code ec;
+  std::size_t sent = 0;
+  std::vector<char> received;
+  t.run(0, data.size(), ec, sent, received);
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(sent == data.size());
+  ASIO_CHECK(received == data);
+
+  // The file position is not changed.
+  ASIO_CHECK(::lseek(t.file.native_handle(), 0, SEEK_CUR)
+      == static_cast<off_t>(data.size()));
+}
+
+void test_range()
+{
+  std::vector<char> data = make_data(100000);
+  sendfile_test t(data);
+
+  asio::error_code ec;
+  std::size_t sent = 0;
+  std::vector<char> received;
+  t.run(12345, 50000, ec, sent, received);
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(sent == 50000);
+  ASIO_CHECK(received == std::vector<char>(
+        data.begin() + 12345, data.begin() + 62345));
+}
+
+void test_end_of_file()
+{
+  std::vector<char> data = make_data(1000);
+  sendfile_test t(data);
+
+  asio::error_code ec;
+  std::size_t sent = 0;
+  std::vector<char> received;
+  t.run(600, 1000, ec, sent, received);
+
+  ASIO_CHECK(ec == asio::error::eof);
+  ASIO_CHECK(sent == 400);
+  ASIO_CHECK(received == std::vector<char>(data.begin() + 600, data.end()));
+}
+
+void test_zero_count()
+{
+  std::vector<char> data = make_data(1000);
+  sendfile_test t(data);
+
+  bool called = false;
+  asio::error_code sendfile_ec;
+  std::size_t sent = 1;
+  asio::async_sendfile(t.server, t.file, 0, 0,
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        called = true;
+        sendfile_ec = ec;
+        sent = n;
+      });
+  ASIO_CHECK(!called);
+  t.ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(!sendfile_ec);
+  ASIO_CHECK(sent == 0);
+}
+
+#else // defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+
+void test_whole_file()
+{
+}
+
+void test_range()
+{
+}
+
+void test_end_of_file()
+{
+}
+
+void test_zero_count()
+{
+}
+
+#endif // defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+
+} // namespace sendfile_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "sendfile",
+  ASIO_COMPILE_TEST_CASE(sendfile_compile::test)
+  ASIO_TEST_CASE(sendfile_runtime::test_whole_file)
+  ASIO_TEST_CASE(sendfile_runtime::test_range)
+  ASIO_TEST_CASE(sendfile_runtime::test_end_of_file)
+  ASIO_TEST_CASE(sendfile_runtime::test_zero_count)
+)
+
+#else // defined(ASIO_HAS_SENDFILE)
+
+ASIO_TEST_SUITE
+(
+  "sendfile",
+  ASIO_TEST_CASE(null_test)
+)
+
+#endif // defined(ASIO_HAS_SENDFILE)
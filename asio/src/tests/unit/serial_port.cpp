@@ -133,6 +133,11 @@ void test()
     port1.send_break();
     port1.send_break(ec);
 
+    std::size_t available1 = port1.available();
+    (void)available1;
+    std::size_t available2 = port1.available(ec);
+    (void)available2;
+
     port1.write_some(buffer(mutable_char_buffer));
     port1.write_some(buffer(const_char_buffer));
     port1.write_some(buffer(mutable_char_buffer), ec);
@@ -17,6 +17,7 @@
 // Test that header file is self-contained.
 #include "asio/serial_port_base.hpp"
 
+#include <stdexcept>
 #include "asio/io_context.hpp"
 #include "asio/serial_port.hpp"
 #include "unit_test.hpp"
@@ -81,6 +82,25 @@ void test()
     serial_port_base::character_size character_size2;
     port.get_option(character_size2);
     (void)static_cast<unsigned int>(character_size2.value());
+
+    // read_timing class.
+
+    serial_port_base::read_timing read_timing1(16,
+        std::chrono::milliseconds(100));
+    port.set_option(read_timing1);
+    serial_port_base::read_timing read_timing2;
+    port.get_option(read_timing2);
+    (void)static_cast<unsigned int>(read_timing2.min_chars());
+    (void)static_cast<std::chrono::milliseconds>(
+        read_timing2.inter_char_timeout());
+
+    // low_latency class.
+
+    serial_port_base::low_latency low_latency1(true);
+    port.set_option(low_latency1);
+    serial_port_base::low_latency low_latency2;
+    port.get_option(low_latency2);
+    (void)static_cast<bool>(low_latency2.value());
   }
   catch (std::exception&)
   {
@@ -92,8 +112,55 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// serial_port_base_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the conversion of serial port options to and from
+// their native representation.
+
+namespace serial_port_base_runtime {
+
+void test_read_timing()
+{
+#if defined(ASIO_HAS_SERIAL_PORT) \
+  && !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  using namespace asio;
+
+  termios ios = termios();
+  asio::error_code ec;
+
+  serial_port_base::read_timing timing1(32, std::chrono::milliseconds(250));
+  timing1.store(ios, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(ios.c_cc[VMIN] == 32);
+  ASIO_CHECK(ios.c_cc[VTIME] == 3);
+
+  serial_port_base::read_timing timing2;
+  timing2.load(ios, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(timing2.min_chars() == 32);
+  ASIO_CHECK(timing2.inter_char_timeout() == std::chrono::milliseconds(300));
+
+  bool threw = false;
+  try
+  {
+    serial_port_base::read_timing timing3(256);
+  }
+  catch (std::out_of_range&)
+  {
+    threw = true;
+  }
+  ASIO_CHECK(threw);
+#endif // defined(ASIO_HAS_SERIAL_PORT)
+       //   && !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+}
+
+} // namespace serial_port_base_runtime
+
+//------------------------------------------------------------------------------
+
 ASIO_TEST_SUITE
 (
   "serial_port_base",
   ASIO_COMPILE_TEST_CASE(serial_port_base_compile::test)
+  ASIO_TEST_CASE(serial_port_base_runtime::test_read_timing)
 )
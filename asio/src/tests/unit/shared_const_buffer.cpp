@@ -0,0 +1,235 @@
+//
+// shared_const_buffer.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/shared_const_buffer.hpp"
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// shared_const_buffer_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a shared_const_buffer, and a container of
+// them, satisfy the ConstBufferSequence type requirements.
+
+namespace shared_const_buffer_compile {
+
+static_assert(asio::is_const_buffer_sequence<
+      asio::shared_const_buffer>::value,
+    "shared_const_buffer must be a ConstBufferSequence");
+static_assert(asio::is_const_buffer_sequence<
+      std::vector<asio::shared_const_buffer>>::value,
+    "vector<shared_const_buffer> must be a ConstBufferSequence");
+
+void write_handler(const asio::error_code&, std::size_t)
+{
+}
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    ip::tcp::socket sock(ioc);
+
+    shared_const_buffer sb1;
+    shared_const_buffer sb2("hello", 5);
+    shared_const_buffer sb3(buffer("hello", 5), std::allocator<void>());
+    std::vector<shared_const_buffer> seq(2, sb2);
+
+    const_buffer cb = sb2;
+    (void)cb;
+    std::size_t n = buffer_size(sb2) + buffer_size(seq);
+    (void)n;
+
+    async_write(sock, sb2, &write_handler);
+    async_write(sock, seq, &write_handler);
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace shared_const_buffer_compile
+
+//------------------------------------------------------------------------------
+
+// shared_const_buffer_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime behaviour of the shared_const_buffer
+// class.
+
+namespace shared_const_buffer_runtime {
+
+struct allocation_counts
+{
+  int allocations;
+  int deallocations;
+};
+
+template <typename T>
+class counting_allocator
+{
+public:
+  typedef T value_type;
+
+  explicit counting_allocator(allocation_counts* counts)
+    : counts_(counts)
+  {
+  }
+
+  template <typename U>
+  counting_allocator(const counting_allocator<U>& other)
+    : counts_(other.counts_)
+  {
+  }
+
+  T* allocate(std::size_t n)
+  {
+    ++counts_->allocations;
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n)
+  {
+    ++counts_->deallocations;
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  allocation_counts* counts_;
+};
+
+void test_copy()
+{
+  asio::shared_const_buffer empty;
+  ASIO_CHECK(empty.size() == 0);
+  ASIO_CHECK(empty.use_count() == 0);
+
+  char data[] = "hello, world";
+  asio::shared_const_buffer b1(data, 12);
+  std::memset(data, 0, sizeof(data));
+  ASIO_CHECK(b1.size() == 12);
+  ASIO_CHECK(std::memcmp(b1.data(), "hello, world", 12) == 0);
+  ASIO_CHECK(b1.use_count() == 1);
+
+  asio::shared_const_buffer b2(b1);
+  ASIO_CHECK(b2.data() == b1.data());
+  ASIO_CHECK(b1.use_count() == 2);
+
+  asio::shared_const_buffer b3(std::move(b2));
+  ASIO_CHECK(b2.size() == 0);
+  ASIO_CHECK(b3.data() == b1.data());
+  ASIO_CHECK(b1.use_count() == 2);
+
+  b3 = b1;
+  ASIO_CHECK(b1.use_count() == 2);
+
+  b3 = asio::shared_const_buffer(asio::buffer("abc", 3));
+  ASIO_CHECK(b1.use_count() == 1);
+  ASIO_CHECK(b3.use_count() == 1);
+  ASIO_CHECK(std::memcmp(b3.data(), "abc", 3) == 0);
+
+  asio::const_buffer cb = b1;
+  ASIO_CHECK(cb.data() == b1.data());
+  ASIO_CHECK(cb.size() == 12);
+}
+
+void test_allocator()
+{
+  allocation_counts counts = { 0, 0 };
+  {
+    counting_allocator<void> alloc(&counts);
+    asio::shared_const_buffer b1(std::string(1000, 'x').data(), 1000, alloc);
+    std::vector<asio::shared_const_buffer> copies(10, b1);
+    ASIO_CHECK(b1.use_count() == 11);
+    ASIO_CHECK(counts.allocations == 1);
+    ASIO_CHECK(counts.deallocations == 0);
+  }
+  ASIO_CHECK(counts.allocations == 1);
+  ASIO_CHECK(counts.deallocations == 1);
+}
+
+void test_socket()
+{
+  using asio::ip::tcp;
+
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket client(ioc);
+  tcp::socket server(ioc);
+  client.connect(acceptor.local_endpoint());
+  acceptor.accept(server);
+
+  asio::shared_const_buffer header("header:", 7);
+  asio::shared_const_buffer body(std::string(100, 'b').data(), 100);
+  std::vector<asio::shared_const_buffer> seq;
+  seq.push_back(header);
+  seq.push_back(body);
+  seq.push_back(header);
+
+  std::size_t written = 0;
+  asio::async_write(client, seq,
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        ASIO_CHECK(!e);
+        written = n;
+      });
+  seq.clear();
+  ASIO_CHECK(header.use_count() > 1);
+  ASIO_CHECK(body.use_count() > 1);
+
+  std::string in(114, '\0');
+  std::size_t read = 0;
+  asio::async_read(server, asio::buffer(&in[0], in.size()),
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        ASIO_CHECK(!e);
+        read = n;
+      });
+  ioc.run();
+
+  ASIO_CHECK(written == 114);
+  ASIO_CHECK(read == 114);
+  ASIO_CHECK(in == "header:" + std::string(100, 'b') + "header:");
+  ASIO_CHECK(header.use_count() == 1);
+  ASIO_CHECK(body.use_count() == 1);
+}
+
+} // namespace shared_const_buffer_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "shared_const_buffer",
+  ASIO_COMPILE_TEST_CASE(shared_const_buffer_compile::test)
+  ASIO_TEST_CASE(shared_const_buffer_runtime::test_copy)
+  ASIO_TEST_CASE(shared_const_buffer_runtime::test_allocator)
+  ASIO_TEST_CASE(shared_const_buffer_runtime::test_socket)
+)
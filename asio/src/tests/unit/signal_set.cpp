@@ -17,9 +17,15 @@
 #include "asio/signal_set.hpp"
 
 #include "archetypes/async_result.hpp"
+#include "asio/config.hpp"
 #include "asio/io_context.hpp"
 #include "unit_test.hpp"
 
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+# include <signal.h>
+# include <unistd.h>
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
 //------------------------------------------------------------------------------
 
 // signal_set_compile test
@@ -91,8 +97,114 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// signal_set_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the signal_set class.
+
+namespace signal_set_runtime {
+
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+struct signal_waiter
+{
+  asio::signal_set* set_;
+  int* signals_;
+  int* count_;
+  asio::error_code* ec_;
+
+  void operator()(const asio::error_code& ec, int signal_number)
+  {
+    if (ec)
+      *ec_ = ec;
+    else if (*count_ < 2)
+    {
+      signals_[(*count_)++] = signal_number;
+      if (*count_ < 2)
+        set_->async_wait(*this);
+    }
+  }
+};
+
+// Raise two signals before running the io_context, so that they are delivered
+// together, and wait for both of them.
+void wait_for_two_signals(asio::io_context& ioc, asio::signal_set& set)
+{
+  ::kill(::getpid(), SIGUSR1);
+  ::kill(::getpid(), SIGUSR2);
+
+  int signals[2] = { 0, 0 };
+  int count = 0;
+  asio::error_code wait_ec;
+  signal_waiter waiter = { &set, signals, &count, &wait_ec };
+  set.async_wait(waiter);
+
+  ioc.run();
+  ASIO_CHECK(!wait_ec);
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK((signals[0] == SIGUSR1 && signals[1] == SIGUSR2)
+      || (signals[0] == SIGUSR2 && signals[1] == SIGUSR1));
+}
+
+void test_signal_handler()
+{
+  asio::io_context ioc;
+  asio::signal_set set(ioc, SIGUSR1, SIGUSR2);
+  wait_for_two_signals(ioc, set);
+}
+
+void test_signalfd()
+{
+#if defined(ASIO_HAS_SIGNALFD)
+  // Signals that are received using a signalfd must be blocked.
+  sigset_t mask, old_mask;
+  sigemptyset(&mask);
+  sigaddset(&mask, SIGUSR1);
+  sigaddset(&mask, SIGUSR2);
+  ::pthread_sigmask(SIG_BLOCK, &mask, &old_mask);
+
+  {
+    asio::io_context ioc(asio::config_from_string("signal.signalfd=1"));
+    asio::signal_set set(ioc, SIGUSR1, SIGUSR2);
+
+    // The signalfd does not support changing the signal's disposition.
+    asio::signal_set set2(ioc);
+    asio::error_code ec;
+    set2.add(SIGUSR1, asio::signal_set::flags::restart, ec);
+    ASIO_CHECK(ec == asio::error::operation_not_supported);
+
+    wait_for_two_signals(ioc, set);
+
+    // A signal that is removed is no longer received using the signalfd.
+    set.remove(SIGUSR2, ec);
+    ASIO_CHECK(!ec);
+    set.clear(ec);
+    ASIO_CHECK(!ec);
+  }
+
+  ::pthread_sigmask(SIG_SETMASK, &old_mask, 0);
+#endif // defined(ASIO_HAS_SIGNALFD)
+}
+
+#else // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+void test_signal_handler()
+{
+}
+
+void test_signalfd()
+{
+}
+
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+} // namespace signal_set_runtime
+
+//------------------------------------------------------------------------------
+
 ASIO_TEST_SUITE
 (
   "signal_set",
   ASIO_COMPILE_TEST_CASE(signal_set_compile::test)
+  ASIO_TEST_CASE(signal_set_runtime::test_signal_handler)
+  ASIO_TEST_CASE(signal_set_runtime::test_signalfd)
 )
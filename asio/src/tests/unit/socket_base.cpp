@@ -16,9 +16,13 @@
 // Test that header file is self-contained.
 #include "asio/socket_base.hpp"
 
+#include <algorithm>
+#include <vector>
 #include "asio/io_context.hpp"
 #include "asio/ip/tcp.hpp"
 #include "asio/ip/udp.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
 #include "unit_test.hpp"
 
 //------------------------------------------------------------------------------
@@ -144,6 +148,61 @@ void test()
     (void)static_cast<bool>(!reuse_address1);
     (void)static_cast<bool>(reuse_address1.value());
 
+#if defined(ASIO_HAS_SO_REUSEPORT)
+    // reuse_port class.
+
+    socket_base::reuse_port reuse_port1(true);
+    sock.set_option(reuse_port1);
+    socket_base::reuse_port reuse_port2;
+    sock.get_option(reuse_port2);
+    reuse_port1 = true;
+    (void)static_cast<bool>(reuse_port1);
+    (void)static_cast<bool>(!reuse_port1);
+    (void)static_cast<bool>(reuse_port1.value());
+#endif // defined(ASIO_HAS_SO_REUSEPORT)
+
+#if defined(ASIO_HAS_SO_BUSY_POLL)
+    // busy_poll class.
+
+    socket_base::busy_poll busy_poll1(50);
+    sock.set_option(busy_poll1);
+    socket_base::busy_poll busy_poll2;
+    sock.get_option(busy_poll2);
+    busy_poll1 = 50;
+    (void)static_cast<int>(busy_poll1.value());
+
+    // prefer_busy_poll class.
+
+    socket_base::prefer_busy_poll prefer_busy_poll1(true);
+    sock.set_option(prefer_busy_poll1);
+    socket_base::prefer_busy_poll prefer_busy_poll2;
+    sock.get_option(prefer_busy_poll2);
+    prefer_busy_poll1 = true;
+    (void)static_cast<bool>(prefer_busy_poll1);
+    (void)static_cast<bool>(!prefer_busy_poll1);
+    (void)static_cast<bool>(prefer_busy_poll1.value());
+
+    // busy_poll_budget class.
+
+    socket_base::busy_poll_budget busy_poll_budget1(8);
+    sock.set_option(busy_poll_budget1);
+    socket_base::busy_poll_budget busy_poll_budget2;
+    sock.get_option(busy_poll_budget2);
+    busy_poll_budget1 = 8;
+    (void)static_cast<int>(busy_poll_budget1.value());
+#endif // defined(ASIO_HAS_SO_BUSY_POLL)
+
+#if defined(ASIO_HAS_SO_MAX_PACING_RATE)
+    // max_pacing_rate class.
+
+    socket_base::max_pacing_rate max_pacing_rate1(1000000);
+    sock.set_option(max_pacing_rate1);
+    socket_base::max_pacing_rate max_pacing_rate2;
+    sock.get_option(max_pacing_rate2);
+    max_pacing_rate1 = 1000000;
+    (void)static_cast<int>(max_pacing_rate1.value());
+#endif // defined(ASIO_HAS_SO_MAX_PACING_RATE)
+
     // linger class.
 
     socket_base::linger linger1(true, 30);
@@ -177,6 +236,70 @@ void test()
     (void)static_cast<bool>(!enable_connection_aborted1);
     (void)static_cast<bool>(enable_connection_aborted1.value());
 
+    // multishot_accept class.
+
+    socket_base::multishot_accept multishot_accept1(true);
+    sock.set_option(multishot_accept1);
+    socket_base::multishot_accept multishot_accept2;
+    sock.get_option(multishot_accept2);
+    multishot_accept1 = true;
+    (void)static_cast<bool>(multishot_accept1);
+    (void)static_cast<bool>(!multishot_accept1);
+    (void)static_cast<bool>(multishot_accept1.value());
+
+    // zero_copy class.
+
+    socket_base::zero_copy zero_copy1(true);
+    sock.set_option(zero_copy1);
+    socket_base::zero_copy zero_copy2;
+    sock.get_option(zero_copy2);
+    zero_copy1 = true;
+    (void)static_cast<bool>(zero_copy1);
+    (void)static_cast<bool>(!zero_copy1);
+    (void)static_cast<bool>(zero_copy1.value());
+
+    // inline_completion class.
+
+    socket_base::inline_completion inline_completion1(true);
+    sock.set_option(inline_completion1);
+    socket_base::inline_completion inline_completion2;
+    sock.get_option(inline_completion2);
+    inline_completion1 = true;
+    (void)static_cast<bool>(inline_completion1);
+    (void)static_cast<bool>(!inline_completion1);
+    (void)static_cast<bool>(inline_completion1.value());
+
+    // read_ahead class.
+
+    socket_base::read_ahead read_ahead1(65536);
+    sock.set_option(read_ahead1);
+    socket_base::read_ahead read_ahead2;
+    sock.get_option(read_ahead2);
+    read_ahead1 = 1;
+    (void)static_cast<int>(read_ahead1.value());
+
+    // write_coalescing class.
+
+    socket_base::write_coalescing write_coalescing1(true);
+    sock.set_option(write_coalescing1);
+    socket_base::write_coalescing write_coalescing2;
+    sock.get_option(write_coalescing2);
+    write_coalescing1 = true;
+    (void)static_cast<bool>(write_coalescing1);
+    (void)static_cast<bool>(!write_coalescing1);
+    (void)static_cast<bool>(write_coalescing1.value());
+
+    // operation_slots class.
+
+    socket_base::operation_slots operation_slots1(true);
+    sock.set_option(operation_slots1);
+    socket_base::operation_slots operation_slots2;
+    sock.get_option(operation_slots2);
+    operation_slots1 = true;
+    (void)static_cast<bool>(operation_slots1);
+    (void)static_cast<bool>(!operation_slots1);
+    (void)static_cast<bool>(operation_slots1.value());
+
     // bytes_readable class.
 
     socket_base::bytes_readable bytes_readable;
@@ -576,6 +699,66 @@ void test()
   ASIO_CHECK(!static_cast<bool>(reuse_address4));
   ASIO_CHECK(!reuse_address4);
 
+#if defined(ASIO_HAS_SO_REUSEPORT)
+  // reuse_port class.
+
+  socket_base::reuse_port reuse_port1(true);
+  ASIO_CHECK(reuse_port1.value());
+  ASIO_CHECK(static_cast<bool>(reuse_port1));
+  ASIO_CHECK(!!reuse_port1);
+  tcp_acceptor.set_option(reuse_port1, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::reuse_port reuse_port2;
+  tcp_acceptor.get_option(reuse_port2, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(reuse_port2.value());
+  ASIO_CHECK(static_cast<bool>(reuse_port2));
+  ASIO_CHECK(!!reuse_port2);
+
+  socket_base::reuse_port reuse_port3(false);
+  ASIO_CHECK(!reuse_port3.value());
+  ASIO_CHECK(!static_cast<bool>(reuse_port3));
+  ASIO_CHECK(!reuse_port3);
+  tcp_acceptor.set_option(reuse_port3, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::reuse_port reuse_port4;
+  tcp_acceptor.get_option(reuse_port4, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(!reuse_port4.value());
+  ASIO_CHECK(!static_cast<bool>(reuse_port4));
+  ASIO_CHECK(!reuse_port4);
+#endif // defined(ASIO_HAS_SO_REUSEPORT)
+
+#if defined(ASIO_HAS_SO_BUSY_POLL)
+  // busy_poll class.
+
+  socket_base::busy_poll busy_poll1(0);
+  ASIO_CHECK(busy_poll1.value() == 0);
+  udp_sock.set_option(busy_poll1, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::busy_poll busy_poll2;
+  udp_sock.get_option(busy_poll2, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(busy_poll2.value() == 0);
+#endif // defined(ASIO_HAS_SO_BUSY_POLL)
+
+#if defined(ASIO_HAS_SO_MAX_PACING_RATE)
+  // max_pacing_rate class.
+
+  socket_base::max_pacing_rate max_pacing_rate1(1000000);
+  ASIO_CHECK(max_pacing_rate1.value() == 1000000);
+  tcp_sock.set_option(max_pacing_rate1, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::max_pacing_rate max_pacing_rate2;
+  tcp_sock.get_option(max_pacing_rate2, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(max_pacing_rate2.value() == 1000000);
+#endif // defined(ASIO_HAS_SO_MAX_PACING_RATE)
+
   // linger class.
 
   socket_base::linger linger1(true, 60);
@@ -631,6 +814,194 @@ void test()
   ASIO_CHECK(!static_cast<bool>(enable_connection_aborted4));
   ASIO_CHECK(!enable_connection_aborted4);
 
+  // multishot_accept class.
+
+  socket_base::multishot_accept multishot_accept1(true);
+  ASIO_CHECK(multishot_accept1.value());
+  ASIO_CHECK(static_cast<bool>(multishot_accept1));
+  ASIO_CHECK(!!multishot_accept1);
+  tcp_acceptor.set_option(multishot_accept1, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::multishot_accept multishot_accept2;
+  tcp_acceptor.get_option(multishot_accept2, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(multishot_accept2.value());
+  ASIO_CHECK(static_cast<bool>(multishot_accept2));
+  ASIO_CHECK(!!multishot_accept2);
+
+  socket_base::multishot_accept multishot_accept3(false);
+  ASIO_CHECK(!multishot_accept3.value());
+  ASIO_CHECK(!static_cast<bool>(multishot_accept3));
+  ASIO_CHECK(!multishot_accept3);
+  tcp_acceptor.set_option(multishot_accept3, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::multishot_accept multishot_accept4;
+  tcp_acceptor.get_option(multishot_accept4, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(!multishot_accept4.value());
+  ASIO_CHECK(!static_cast<bool>(multishot_accept4));
+  ASIO_CHECK(!multishot_accept4);
+
+  // zero_copy class.
+
+  socket_base::zero_copy zero_copy1(true);
+  ASIO_CHECK(zero_copy1.value());
+  ASIO_CHECK(static_cast<bool>(zero_copy1));
+  ASIO_CHECK(!!zero_copy1);
+  tcp_sock.set_option(zero_copy1, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::zero_copy zero_copy2;
+  tcp_sock.get_option(zero_copy2, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(zero_copy2.value());
+  ASIO_CHECK(static_cast<bool>(zero_copy2));
+  ASIO_CHECK(!!zero_copy2);
+
+  socket_base::zero_copy zero_copy3(false);
+  ASIO_CHECK(!zero_copy3.value());
+  ASIO_CHECK(!static_cast<bool>(zero_copy3));
+  ASIO_CHECK(!zero_copy3);
+  tcp_sock.set_option(zero_copy3, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::zero_copy zero_copy4;
+  tcp_sock.get_option(zero_copy4, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(!zero_copy4.value());
+  ASIO_CHECK(!static_cast<bool>(zero_copy4));
+  ASIO_CHECK(!zero_copy4);
+
+  // inline_completion class.
+
+  socket_base::inline_completion inline_completion1(true);
+  ASIO_CHECK(inline_completion1.value());
+  ASIO_CHECK(static_cast<bool>(inline_completion1));
+  ASIO_CHECK(!!inline_completion1);
+  tcp_sock.set_option(inline_completion1, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::inline_completion inline_completion2;
+  tcp_sock.get_option(inline_completion2, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(inline_completion2.value());
+  ASIO_CHECK(static_cast<bool>(inline_completion2));
+  ASIO_CHECK(!!inline_completion2);
+
+  socket_base::inline_completion inline_completion3(false);
+  ASIO_CHECK(!inline_completion3.value());
+  ASIO_CHECK(!static_cast<bool>(inline_completion3));
+  ASIO_CHECK(!inline_completion3);
+  tcp_sock.set_option(inline_completion3, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::inline_completion inline_completion4;
+  tcp_sock.get_option(inline_completion4, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(!inline_completion4.value());
+  ASIO_CHECK(!static_cast<bool>(inline_completion4));
+  ASIO_CHECK(!inline_completion4);
+
+  // read_ahead class.
+
+  socket_base::read_ahead read_ahead1(65536);
+  ASIO_CHECK(read_ahead1.value() == 65536);
+  tcp_sock.set_option(read_ahead1, ec);
+#if !defined(ASIO_HAS_IOCP) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::read_ahead read_ahead2;
+  tcp_sock.get_option(read_ahead2, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(read_ahead2.value() == 65536);
+
+  socket_base::read_ahead read_ahead3(0);
+  tcp_sock.set_option(read_ahead3, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::read_ahead read_ahead4;
+  tcp_sock.get_option(read_ahead4, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(read_ahead4.value() == 0);
+
+  socket_base::read_ahead read_ahead5(-1);
+  tcp_sock.set_option(read_ahead5, ec);
+  ASIO_CHECK(ec == asio::error::invalid_argument);
+
+  udp_sock.set_option(read_ahead1, ec);
+  ASIO_CHECK(ec == asio::error::operation_not_supported);
+#else // !defined(ASIO_HAS_IOCP)
+      //   && !defined(ASIO_WINDOWS_RUNTIME)
+      //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  ASIO_CHECK(ec == asio::error::operation_not_supported);
+#endif // !defined(ASIO_HAS_IOCP)
+       //   && !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
+  // write_coalescing class.
+
+  socket_base::write_coalescing write_coalescing1(true);
+  ASIO_CHECK(write_coalescing1.value());
+  ASIO_CHECK(static_cast<bool>(write_coalescing1));
+  ASIO_CHECK(!!write_coalescing1);
+  tcp_sock.set_option(write_coalescing1, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::write_coalescing write_coalescing2;
+  tcp_sock.get_option(write_coalescing2, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(write_coalescing2.value());
+  ASIO_CHECK(static_cast<bool>(write_coalescing2));
+  ASIO_CHECK(!!write_coalescing2);
+
+  socket_base::write_coalescing write_coalescing3(false);
+  ASIO_CHECK(!write_coalescing3.value());
+  ASIO_CHECK(!static_cast<bool>(write_coalescing3));
+  ASIO_CHECK(!write_coalescing3);
+  tcp_sock.set_option(write_coalescing3, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::write_coalescing write_coalescing4;
+  tcp_sock.get_option(write_coalescing4, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(!write_coalescing4.value());
+  ASIO_CHECK(!static_cast<bool>(write_coalescing4));
+  ASIO_CHECK(!write_coalescing4);
+
+  // operation_slots class.
+
+  socket_base::operation_slots operation_slots1(true);
+  ASIO_CHECK(operation_slots1.value());
+  ASIO_CHECK(static_cast<bool>(operation_slots1));
+  ASIO_CHECK(!!operation_slots1);
+  tcp_sock.set_option(operation_slots1, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::operation_slots operation_slots2;
+  tcp_sock.get_option(operation_slots2, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(operation_slots2.value());
+  ASIO_CHECK(static_cast<bool>(operation_slots2));
+  ASIO_CHECK(!!operation_slots2);
+
+  socket_base::operation_slots operation_slots3(false);
+  ASIO_CHECK(!operation_slots3.value());
+  ASIO_CHECK(!static_cast<bool>(operation_slots3));
+  ASIO_CHECK(!operation_slots3);
+  tcp_sock.set_option(operation_slots3, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::operation_slots operation_slots4;
+  tcp_sock.get_option(operation_slots4, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(!operation_slots4.value());
+  ASIO_CHECK(!static_cast<bool>(operation_slots4));
+  ASIO_CHECK(!operation_slots4);
+
   // bytes_readable class.
 
   socket_base::bytes_readable bytes_readable;
@@ -638,6 +1009,71 @@ void test()
   ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
 }
 
+void test_zero_copy_send()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::socket client_socket(ioc);
+  ip::tcp::socket server_socket(ioc);
+  client_socket.connect(acceptor.local_endpoint());
+  acceptor.accept(server_socket);
+
+  asio::error_code ec;
+  client_socket.set_option(socket_base::zero_copy(true), ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  // Each send is large enough to avoid copying, where that is supported.
+  std::vector<char> sent(256 * 1024);
+  for (std::size_t i = 0; i < sent.size(); ++i)
+    sent[i] = static_cast<char>(i % 251);
+  std::vector<char> received(sent.size());
+
+  asio::error_code write_ec, read_ec;
+  std::size_t write_bytes = 0, read_bytes = 0;
+  asio::async_write(client_socket, asio::buffer(sent),
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        write_ec = e;
+        write_bytes = n;
+      });
+  asio::async_read(server_socket, asio::buffer(received),
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        read_ec = e;
+        read_bytes = n;
+      });
+  ioc.run();
+
+  ASIO_CHECK_MESSAGE(!write_ec, write_ec.value() << ", " << write_ec.message());
+  ASIO_CHECK(write_bytes == sent.size());
+  ASIO_CHECK_MESSAGE(!read_ec, read_ec.value() << ", " << read_ec.message());
+  ASIO_CHECK(read_bytes == sent.size());
+  ASIO_CHECK(std::equal(sent.begin(), sent.end(), received.begin()));
+
+  // A single send operation completes once its data may be reused.
+  std::vector<char> sent2(64 * 1024, 'z');
+  client_socket.async_send(asio::buffer(sent2),
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        write_ec = e;
+        write_bytes = n;
+      });
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK_MESSAGE(!write_ec, write_ec.value() << ", " << write_ec.message());
+  ASIO_CHECK(write_bytes > 0);
+  received.assign(write_bytes, 0);
+  read_bytes = asio::read(server_socket, asio::buffer(received), ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(read_bytes == write_bytes);
+  ASIO_CHECK(std::equal(received.begin(), received.end(), sent2.begin()));
+}
+
 } // namespace socket_base_runtime
 
 //------------------------------------------------------------------------------
@@ -647,4 +1083,5 @@ ASIO_TEST_SUITE
   "socket_base",
   ASIO_COMPILE_TEST_CASE(socket_base_compile::test)
   ASIO_TEST_CASE(socket_base_runtime::test)
+  ASIO_TEST_CASE(socket_base_runtime::test_zero_copy_send)
 )
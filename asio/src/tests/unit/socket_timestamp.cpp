@@ -0,0 +1,327 @@
+//
+// socket_timestamp.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/socket_timestamp.hpp"
+
+#include <cstring>
+#include "archetypes/async_result.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/ip/udp.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+
+//------------------------------------------------------------------------------
+
+// socket_timestamp_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the timestamped receive operations, and the
+// socket options that enable them, compile and link correctly. Runtime
+// failures are ignored.
+
+namespace socket_timestamp_compile {
+
+struct receive_handler
+{
+  receive_handler() {}
+  void operator()(const asio::error_code&, std::size_t) {}
+  receive_handler(receive_handler&&) {}
+private:
+  receive_handler(const receive_handler&);
+};
+
+struct wait_handler
+{
+  wait_handler() {}
+  void operator()(const asio::error_code&) {}
+  wait_handler(wait_handler&&) {}
+private:
+  wait_handler(const wait_handler&);
+};
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    char mutable_char_buffer[128];
+    archetypes::lazy_handler lazy;
+    socket_timestamp ts = socket_timestamp();
+
+    socket_base::timestamping opt1(socket_base::timestamp_rx_software
+        | socket_base::timestamp_rx_hardware
+        | socket_base::timestamp_tx_software
+        | socket_base::timestamp_tx_hardware
+        | socket_base::timestamp_tx_sched
+        | socket_base::timestamp_tx_ack
+        | socket_base::timestamp_software
+        | socket_base::timestamp_raw_hardware
+        | socket_base::timestamp_opt_id
+        | socket_base::timestamp_opt_tsonly);
+    (void)opt1;
+
+    ip::udp::socket socket1(ioc, ip::udp::v4());
+    ip::udp::endpoint endpoint;
+    socket1.async_receive_timestamped(buffer(mutable_char_buffer),
+        ts, receive_handler());
+    socket1.async_receive_from_timestamped(buffer(mutable_char_buffer),
+        endpoint, ts, receive_handler());
+    socket1.async_receive_tx_timestamp(ts, wait_handler());
+    int i1 = socket1.async_receive_timestamped(
+        buffer(mutable_char_buffer), ts, lazy);
+    (void)i1;
+    int i2 = socket1.async_receive_from_timestamped(buffer(mutable_char_buffer),
+        endpoint, ts, lazy);
+    (void)i2;
+    int i3 = socket1.async_receive_tx_timestamp(ts, lazy);
+    (void)i3;
+
+    ip::tcp::socket socket2(ioc);
+    socket2.async_receive_timestamped(buffer(mutable_char_buffer),
+        ts, receive_handler());
+    socket2.async_receive_tx_timestamp(ts, wait_handler());
+    int i4 = socket2.async_receive_timestamped(
+        buffer(mutable_char_buffer), ts, lazy);
+    (void)i4;
+    int i5 = socket2.async_receive_tx_timestamp(ts, lazy);
+    (void)i5;
+
+    socket_timestamp::kind_type k = ts.kind;
+    (void)k;
+    std::chrono::nanoseconds d1 = ts.software;
+    (void)d1;
+    std::chrono::nanoseconds d2 = ts.hardware;
+    (void)d2;
+    uint32_t id = ts.id;
+    (void)id;
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace socket_timestamp_compile
+
+//------------------------------------------------------------------------------
+
+// socket_timestamp_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the timestamped receive
+// operations, using software timestamps on the loopback interface.
+
+namespace socket_timestamp_runtime {
+
+using asio::ip::tcp;
+using asio::ip::udp;
+
+const int rx_flags = asio::socket_base::timestamp_rx_software
+  | asio::socket_base::timestamp_software;
+
+const int tx_flags = asio::socket_base::timestamp_tx_software
+  | asio::socket_base::timestamp_software
+  | asio::socket_base::timestamp_opt_id
+  | asio::socket_base::timestamp_opt_tsonly;
+
+void test_datagram_receive()
+{
+  asio::io_context ioc;
+
+  udp::socket receiver(ioc, udp::endpoint(asio::ip::address_v4::loopback(), 0));
+  udp::socket sender(ioc, udp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+  asio::error_code ec;
+  receiver.set_option(asio::socket_base::timestamping(rx_flags), ec);
+  if (ec)
+    return; // Not supported by the kernel.
+
+  asio::socket_base::timestamping opt;
+  receiver.get_option(opt);
+  ASIO_CHECK((opt.value() & rx_flags) == rx_flags);
+
+  sender.send_to(asio::buffer("hello", 5), receiver.local_endpoint());
+
+  char data[16];
+  udp::endpoint endpoint;
+  asio::socket_timestamp ts = asio::socket_timestamp();
+  asio::error_code receive_ec;
+  std::size_t received = 0;
+  receiver.async_receive_from_timestamped(asio::buffer(data), endpoint, ts,
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        receive_ec = e;
+        received = n;
+      });
+  ioc.run();
+
+  ASIO_CHECK(!receive_ec);
+  ASIO_CHECK(received == 5);
+  ASIO_CHECK(std::memcmp(data, "hello", 5) == 0);
+  ASIO_CHECK(endpoint == sender.local_endpoint());
+  ASIO_CHECK(ts.kind == asio::socket_timestamp::received);
+  ASIO_CHECK(ts.software.count() > 0);
+  ASIO_CHECK(ts.hardware.count() == 0);
+
+  // Without timestamping enabled, the timestamp is reported as zero.
+  receiver.set_option(asio::socket_base::timestamping(0));
+  sender.send_to(asio::buffer("world", 5), receiver.local_endpoint());
+  ts.software = std::chrono::nanoseconds(1);
+  receiver.async_receive_timestamped(asio::buffer(data), ts,
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        receive_ec = e;
+        received = n;
+      });
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(!receive_ec);
+  ASIO_CHECK(received == 5);
+  ASIO_CHECK(ts.software.count() == 0);
+}
+
+void test_stream_receive()
+{
+  asio::io_context ioc;
+
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket client(ioc);
+  tcp::socket server(ioc);
+  client.connect(acceptor.local_endpoint());
+  acceptor.accept(server);
+
+  asio::error_code ec;
+  server.set_option(asio::socket_base::timestamping(rx_flags), ec);
+  if (ec)
+    return; // Not supported by the kernel.
+
+  asio::write(client, asio::buffer("hello", 5));
+
+  char data[16];
+  asio::socket_timestamp ts = asio::socket_timestamp();
+  asio::error_code receive_ec;
+  std::size_t received = 0;
+  server.async_receive_timestamped(asio::buffer(data), ts,
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        receive_ec = e;
+        received = n;
+      });
+  ioc.run();
+
+  ASIO_CHECK(!receive_ec);
+  ASIO_CHECK(received == 5);
+  ASIO_CHECK(std::memcmp(data, "hello", 5) == 0);
+  ASIO_CHECK(ts.kind == asio::socket_timestamp::received);
+  ASIO_CHECK(ts.software.count() > 0);
+
+  // The end of the stream is reported as an error.
+  client.shutdown(tcp::socket::shutdown_send);
+  server.async_receive_timestamped(asio::buffer(data), ts,
+      [&](const asio::error_code& e, std::size_t n)
+      {
+        receive_ec = e;
+        received = n;
+      });
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(receive_ec == asio::error::eof);
+  ASIO_CHECK(received == 0);
+}
+
+void test_stream_transmit()
+{
+  asio::io_context ioc;
+
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket client(ioc);
+  tcp::socket server(ioc);
+  client.connect(acceptor.local_endpoint());
+  acceptor.accept(server);
+
+  asio::error_code ec;
+  client.set_option(asio::socket_base::timestamping(tx_flags), ec);
+  if (ec)
+    return; // Not supported by the kernel.
+
+  asio::write(client, asio::buffer("hello", 5));
+
+  asio::socket_timestamp ts = asio::socket_timestamp();
+  bool called = false;
+  asio::error_code wait_ec;
+  client.async_receive_tx_timestamp(ts,
+      [&](const asio::error_code& e)
+      {
+        called = true;
+        wait_ec = e;
+      });
+  ASIO_CHECK(!called);
+  ioc.run();
+  ASIO_CHECK(called);
+
+  ASIO_CHECK(!wait_ec);
+  ASIO_CHECK(ts.kind == asio::socket_timestamp::sent);
+  ASIO_CHECK(ts.software.count() > 0);
+
+  // The identifier is the offset of the last byte of the timestamped data.
+  ASIO_CHECK(ts.id == 4);
+
+  // With no further data sent, the operation waits until cancelled.
+  called = false;
+  client.async_receive_tx_timestamp(ts,
+      [&](const asio::error_code& e)
+      {
+        called = true;
+        wait_ec = e;
+      });
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(!called);
+  client.cancel();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(wait_ec == asio::error::operation_aborted);
+}
+
+} // namespace socket_timestamp_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "socket_timestamp",
+  ASIO_COMPILE_TEST_CASE(socket_timestamp_compile::test)
+  ASIO_TEST_CASE(socket_timestamp_runtime::test_datagram_receive)
+  ASIO_TEST_CASE(socket_timestamp_runtime::test_stream_receive)
+  ASIO_TEST_CASE(socket_timestamp_runtime::test_stream_transmit)
+)
+
+#else // defined(ASIO_HAS_SOCKET_TIMESTAMPING)
+
+ASIO_TEST_SUITE
+(
+  "socket_timestamp",
+  ASIO_TEST_CASE(null_test)
+)
+
+#endif // defined(ASIO_HAS_SOCKET_TIMESTAMPING)
@@ -0,0 +1,423 @@
+//
+// splice.cpp
+// ~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/splice.hpp"
+
+#include <cstring>
+#include <vector>
+#include "archetypes/async_result.hpp"
+#include "asio/connect_pipe.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/posix/stream_descriptor.hpp"
+#include "asio/read.hpp"
+#include "asio/readable_pipe.hpp"
+#include "asio/stream_file.hpp"
+#include "asio/writable_pipe.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_SPLICE)
+
+//------------------------------------------------------------------------------
+
+// splice_compile test
+// ~~~~~~~~~~~~~~~~~~~
+// The following test checks that the async_splice function compiles for all
+// supported combinations of I/O objects. Runtime failures are ignored.
+
+namespace splice_compile {
+
+struct splice_handler
+{
+  splice_handler() {}
+  void operator()(const asio::error_code&, std::size_t) {}
+  splice_handler(splice_handler&&) {}
+private:
+  splice_handler(const splice_handler&);
+};
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    archetypes::lazy_handler lazy;
+
+    ip::tcp::socket socket1(ioc);
+    ip::tcp::socket socket2(ioc);
+    readable_pipe pipe1(ioc);
+    writable_pipe pipe2(ioc);
+
+    async_splice(socket1, socket2, 1024, splice_handler());
+    async_splice(socket1, pipe2, 1024, splice_handler());
+    async_splice(pipe1, socket2, 1024, splice_handler());
+    async_splice(pipe1, pipe2, 1024, splice_handler());
+    int i1 = async_splice(socket1, socket2, 1024, lazy);
+    (void)i1;
+
+#if defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+    posix::stream_descriptor descriptor1(ioc);
+    async_splice(descriptor1, socket2, 1024, splice_handler());
+    async_splice(socket1, descriptor1, 1024, splice_handler());
+#endif // defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+
+#if defined(ASIO_HAS_FILE)
+    stream_file file1(ioc);
+    async_splice(file1, socket2, 1024, splice_handler());
+    async_splice(socket1, file1, 1024, splice_handler());
+#endif // defined(ASIO_HAS_FILE)
+
+    const char data[1] = { 0 };
+    async_vmsplice(pipe2, buffer(data), splice_handler());
+    async_vmsplice(pipe2, std::vector<const_buffer>(), splice_handler());
+    int i2 = async_vmsplice(pipe2, buffer(data), lazy);
+    (void)i2;
+
+    ioc.run();
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace splice_compile
+
+//------------------------------------------------------------------------------
+
+// splice_runtime test
+// ~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the async_splice
+// function.
+
+namespace splice_runtime {
+
+using asio::ip::tcp;
+
+void connect_sockets(tcp::acceptor& acceptor,
+    tcp::socket& client, tcp::socket& server)
+{
+  client.connect(acceptor.local_endpoint());
+  acceptor.accept(server);
+}
+
+std::vector<char> make_data(std::size_t size)
+{
+  std::vector<char> data(size);
+  for (std::size_t i = 0; i < size; ++i)
+    data[i] = static_cast<char>(i % 251);
+  return data;
+}
+
+// Splice repeatedly from source to dest until the source reaches the end of
+// its data, as a proxy would.
+template <typename Source, typename Dest>
+struct relay
+{
+  Source& source;
+  Dest& dest;
+  std::size_t max_bytes;
+  std::size_t& total;
+  asio::error_code& result;
+
+  void operator()(const asio::error_code& ec, std::size_t n)
+  {
+    total += n;
+    if (ec)
+    {
+      result = ec;
+      return;
+    }
+    asio::async_splice(source, dest, max_bytes, *this);
+  }
+};
+
+template <typename Source, typename Dest>
+void start_relay(Source& source, Dest& dest, std::size_t max_bytes,
+    std::size_t& total, asio::error_code& result)
+{
+  relay<Source, Dest> r = { source, dest, max_bytes, total, result };
+  asio::async_splice(source, dest, max_bytes, r);
+}
+
+void test_socket_to_socket()
+{
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket writer(ioc), source(ioc), dest(ioc), reader(ioc);
+  connect_sockets(acceptor, writer, source);
+  connect_sockets(acceptor, dest, reader);
+
+  // Enough data that the destination fills before the reader drains it.
+  std::vector<char> data = make_data(4 * 1024 * 1024);
+  std::vector<char> received(data.size());
+
+  asio::error_code write_ec, read_ec, splice_ec;
+  std::size_t read_bytes = 0, spliced = 0;
+  asio::async_write(writer, asio::buffer(data),
+      [&](const asio::error_code& ec, std::size_t)
+      {
+        write_ec = ec;
+        writer.shutdown(tcp::socket::shutdown_send);
+      });
+  start_relay(source, dest, 65536, spliced, splice_ec);
+  asio::async_read(reader, asio::buffer(received),
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        read_ec = ec;
+        read_bytes = n;
+      });
+  ioc.run();
+
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(splice_ec == asio::error::eof);
+  ASIO_CHECK(spliced == data.size());
+  ASIO_CHECK(read_bytes == data.size());
+  ASIO_CHECK(received == data);
+}
+
+void test_pipe_to_socket()
+{
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket dest(ioc), reader(ioc);
+  connect_sockets(acceptor, dest, reader);
+  asio::readable_pipe source(ioc);
+  asio::writable_pipe writer(ioc);
+  asio::connect_pipe(source, writer);
+
+  std::vector<char> data = make_data(1024 * 1024);
+  std::vector<char> received(data.size());
+
+  asio::error_code write_ec, read_ec, splice_ec;
+  std::size_t spliced = 0;
+  asio::async_write(writer, asio::buffer(data),
+      [&](const asio::error_code& ec, std::size_t)
+      {
+        write_ec = ec;
+        writer.close();
+      });
+  start_relay(source, dest, 65536, spliced, splice_ec);
+  asio::async_read(reader, asio::buffer(received),
+      [&](const asio::error_code& ec, std::size_t)
+      {
+        read_ec = ec;
+      });
+  ioc.run();
+
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(splice_ec == asio::error::eof);
+  ASIO_CHECK(spliced == data.size());
+  ASIO_CHECK(received == data);
+}
+
+void test_socket_to_pipe()
+{
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket writer(ioc), source(ioc);
+  connect_sockets(acceptor, writer, source);
+  asio::readable_pipe reader(ioc);
+  asio::writable_pipe dest(ioc);
+  asio::connect_pipe(reader, dest);
+
+  std::vector<char> data = make_data(1024 * 1024);
+  std::vector<char> received(data.size());
+
+  asio::error_code write_ec, read_ec, splice_ec;
+  std::size_t spliced = 0;
+  asio::async_write(writer, asio::buffer(data),
+      [&](const asio::error_code& ec, std::size_t)
+      {
+        write_ec = ec;
+        writer.shutdown(tcp::socket::shutdown_send);
+      });
+  start_relay(source, dest, 65536, spliced, splice_ec);
+  asio::async_read(reader, asio::buffer(received),
+      [&](const asio::error_code& ec, std::size_t)
+      {
+        read_ec = ec;
+      });
+  ioc.run();
+
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(splice_ec == asio::error::eof);
+  ASIO_CHECK(spliced == data.size());
+  ASIO_CHECK(received == data);
+}
+
+void test_immediate_completion()
+{
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket writer(ioc), source(ioc), dest(ioc), reader(ioc);
+  connect_sockets(acceptor, writer, source);
+  connect_sockets(acceptor, dest, reader);
+
+  // Data that is already available is spliced without waiting, but the
+  // handler is still not invoked from within async_splice.
+  const char data[] = "hello";
+  asio::write(writer, asio::buffer(data, 5));
+
+  bool called = false;
+  asio::error_code splice_ec;
+  std::size_t spliced = 0;
+  asio::async_splice(source, dest, 3,
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        called = true;
+        splice_ec = ec;
+        spliced = n;
+      });
+  ASIO_CHECK(!called);
+  ioc.run();
+  ASIO_CHECK(called);
+
+  // Data may arrive in pieces, but no more than max_bytes is moved.
+  ASIO_CHECK(!splice_ec);
+  ASIO_CHECK(spliced > 0 && spliced <= 3);
+  char received[3] = "";
+  asio::read(reader, asio::buffer(received, spliced));
+  ASIO_CHECK(std::memcmp(received, data, spliced) == 0);
+
+  // A zero-length splice completes without moving any data.
+  called = false;
+  asio::async_splice(source, dest, 0,
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        called = true;
+        splice_ec = ec;
+        spliced = n;
+      });
+  ASIO_CHECK(!called);
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(!splice_ec);
+  ASIO_CHECK(spliced == 0);
+}
+
+void test_cancellation()
+{
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket writer(ioc), source(ioc), dest(ioc), reader(ioc);
+  connect_sockets(acceptor, writer, source);
+  connect_sockets(acceptor, dest, reader);
+
+  // Closing the source aborts a splice that is waiting for data.
+  asio::error_code splice_ec;
+  asio::async_splice(source, dest, 1024,
+      [&](const asio::error_code& ec, std::size_t)
+      {
+        splice_ec = ec;
+      });
+  asio::post(ioc, [&]{ source.cancel(); });
+  ioc.run();
+  ASIO_CHECK(splice_ec == asio::error::operation_aborted);
+}
+
+void test_vmsplice()
+{
+  asio::io_context ioc;
+  asio::readable_pipe reader(ioc);
+  asio::writable_pipe writer(ioc);
+  asio::connect_pipe(reader, writer);
+
+  // More data than the pipe can hold, in several buffers, so that the
+  // operation must wait for the pipe to become writable.
+  std::vector<char> data1 = make_data(512 * 1024);
+  std::vector<char> data2 = make_data(300 * 1024 + 7);
+  std::vector<asio::const_buffer> buffers;
+  buffers.push_back(asio::buffer(data1));
+  buffers.push_back(asio::buffer(data2));
+
+  std::vector<char> expected(data1);
+  expected.insert(expected.end(), data2.begin(), data2.end());
+  std::vector<char> received(expected.size());
+
+  bool called = false;
+  asio::error_code write_ec, read_ec;
+  std::size_t written = 0;
+  asio::async_vmsplice(writer, buffers,
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        called = true;
+        write_ec = ec;
+        written = n;
+      });
+  ASIO_CHECK(!called);
+  asio::async_read(reader, asio::buffer(received),
+      [&](const asio::error_code& ec, std::size_t)
+      {
+        read_ec = ec;
+      });
+  ioc.run();
+
+  ASIO_CHECK(called);
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(written == expected.size());
+  ASIO_CHECK(received == expected);
+
+  // An empty buffer sequence completes without writing.
+  called = false;
+  asio::async_vmsplice(writer, asio::const_buffer(),
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        called = true;
+        write_ec = ec;
+        written = n;
+      });
+  ASIO_CHECK(!called);
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(written == 0);
+}
+
+} // namespace splice_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "splice",
+  ASIO_COMPILE_TEST_CASE(splice_compile::test)
+  ASIO_TEST_CASE(splice_runtime::test_socket_to_socket)
+  ASIO_TEST_CASE(splice_runtime::test_pipe_to_socket)
+  ASIO_TEST_CASE(splice_runtime::test_socket_to_pipe)
+  ASIO_TEST_CASE(splice_runtime::test_immediate_completion)
+  ASIO_TEST_CASE(splice_runtime::test_cancellation)
+  ASIO_TEST_CASE(splice_runtime::test_vmsplice)
+)
+
+#else // defined(ASIO_HAS_SPLICE)
+
+ASIO_TEST_SUITE
+(
+  "splice",
+  ASIO_TEST_CASE(null_test)
+)
+
+#endif // defined(ASIO_HAS_SPLICE)
@@ -0,0 +1,223 @@
+//
+// connection_pool.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/ssl/connection_pool.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "asio.hpp"
+#include "asio/ssl.hpp"
+#include "../unit_test.hpp"
+#include "test_certificate.hpp"
+
+//------------------------------------------------------------------------------
+
+// ssl_connection_pool_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the ssl::connection_pool type compiles and
+// links correctly. Runtime failures are ignored.
+
+namespace ssl_connection_pool_compile {
+
+void acquire_handler(const asio::error_code&,
+    asio::ssl::connection_pool::lease)
+{
+}
+
+void test()
+{
+  using namespace asio;
+
+  try
+  {
+    io_context ioc;
+    ssl::context ctx(ssl::context::tls_client);
+
+    ssl::connection_pool pool(ioc.get_executor(), ctx);
+    pool.async_acquire("localhost", "https", &acquire_handler);
+
+    ssl::connection_pool::lease l;
+    if (l)
+    {
+      ssl::stream<ip::tcp::socket>& s = *l;
+      (void)s;
+    }
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace ssl_connection_pool_compile
+
+//------------------------------------------------------------------------------
+
+// ssl_connection_pool_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the ssl::connection_pool type performs the
+// handshake, verifies the host name, and reuses connections.
+
+namespace ssl_connection_pool_runtime {
+
+using asio::ip::tcp;
+typedef asio::ssl::stream<tcp::socket> stream_type;
+typedef asio::ssl::connection_pool::lease lease;
+
+struct server
+{
+  explicit server(asio::io_context& ioc)
+    : context(asio::ssl::context::tls_server),
+      acceptor(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0)),
+      port(std::to_string(acceptor.local_endpoint().port())),
+      handshakes(0)
+  {
+    ssl_test::use_certificate(context);
+    accept();
+  }
+
+  void accept()
+  {
+    acceptor.async_accept(
+        [this](asio::error_code ec, tcp::socket s)
+        {
+          if (!ec)
+          {
+            streams.push_back(
+                std::make_shared<stream_type>(std::move(s), context));
+            streams.back()->async_handshake(
+                asio::ssl::stream_base::server,
+                [this](asio::error_code e)
+                {
+                  handshake_ec = e;
+                  ++handshakes;
+                });
+            accept();
+          }
+        });
+  }
+
+  asio::ssl::context context;
+  tcp::acceptor acceptor;
+  std::string port;
+  std::vector<std::shared_ptr<stream_type>> streams;
+  std::size_t handshakes;
+  asio::error_code handshake_ec;
+};
+
+struct acquire_result
+{
+  acquire_result()
+    : ec(asio::error::would_block)
+  {
+  }
+
+  asio::error_code ec;
+  lease result;
+};
+
+struct acquire_handler
+{
+  void operator()(asio::error_code e, lease l)
+  {
+    r->ec = e;
+    r->result = std::move(l);
+  }
+
+  acquire_result* r;
+};
+
+void wait(asio::io_context& ioc, acquire_result& r)
+{
+  while (r.ec == asio::error::would_block)
+    ioc.run_one_for(asio::chrono::seconds(5));
+}
+
+void test_handshake()
+{
+  asio::io_context ioc;
+  server srv(ioc);
+
+  asio::ssl::context ctx(asio::ssl::context::tls_client);
+  ctx.add_certificate_authority(asio::buffer(
+        ssl_test::certificate, sizeof(ssl_test::certificate) - 1));
+  ctx.set_verify_mode(asio::ssl::verify_peer);
+  asio::ssl::connection_pool pool(ioc.get_executor(), ctx);
+
+  acquire_result r1;
+  pool.async_acquire("localhost", srv.port, acquire_handler{&r1});
+  wait(ioc, r1);
+  ASIO_CHECK(!r1.ec);
+  ASIO_CHECK(!r1.result.reused());
+
+  // The server's handshake must finish before its stream is used directly.
+  while (srv.handshakes == 0)
+    ioc.run_one_for(asio::chrono::seconds(5));
+  ASIO_CHECK(!srv.handshake_ec);
+
+  // Data written on the leased stream is encrypted for the server.
+  asio::write(*r1.result, asio::buffer("ping", 4));
+  char data[4];
+  asio::read(*srv.streams[0], asio::buffer(data));
+  ASIO_CHECK(std::string(data, 4) == "ping");
+
+  // The server's session tickets do not fail the idle health check.
+  r1.result.release();
+  ioc.run_for(asio::chrono::milliseconds(50));
+  ASIO_CHECK(pool.idle_count() == 1);
+
+  acquire_result r2;
+  pool.async_acquire("localhost", srv.port, acquire_handler{&r2});
+  wait(ioc, r2);
+  ASIO_CHECK(!r2.ec);
+  ASIO_CHECK(r2.result.reused());
+  ASIO_CHECK(srv.streams.size() == 1);
+
+  asio::write(*srv.streams[0], asio::buffer("pong", 4));
+  asio::read(*r2.result, asio::buffer(data));
+  ASIO_CHECK(std::string(data, 4) == "pong");
+}
+
+void test_host_name_verification()
+{
+  asio::io_context ioc;
+  server srv(ioc);
+
+  asio::ssl::context ctx(asio::ssl::context::tls_client);
+  ctx.add_certificate_authority(asio::buffer(
+        ssl_test::certificate, sizeof(ssl_test::certificate) - 1));
+  ctx.set_verify_mode(asio::ssl::verify_peer);
+  asio::ssl::connection_pool pool(ioc.get_executor(), ctx);
+
+  // The certificate is not issued for the numeric address.
+  acquire_result r;
+  pool.async_acquire("127.0.0.1", srv.port, acquire_handler{&r});
+  wait(ioc, r);
+  ASIO_CHECK(!!r.ec);
+  ASIO_CHECK(!r.result);
+}
+
+} // namespace ssl_connection_pool_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "ssl/connection_pool",
+  ASIO_COMPILE_TEST_CASE(ssl_connection_pool_compile::test)
+  ASIO_TEST_CASE(ssl_connection_pool_runtime::test_handshake)
+  ASIO_TEST_CASE(ssl_connection_pool_runtime::test_host_name_verification)
+)
@@ -0,0 +1,311 @@
+//
+// dtls_acceptor.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/ssl/dtls_acceptor.hpp"
+
+#include "asio.hpp"
+#include "asio/ssl.hpp"
+#include "../archetypes/async_result.hpp"
+#include "../unit_test.hpp"
+#include "test_certificate.hpp"
+
+//------------------------------------------------------------------------------
+
+// ssl_dtls_acceptor_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// ssl::dtls_acceptor compile and link correctly. Runtime failures are ignored.
+
+namespace ssl_dtls_acceptor_compile {
+
+#if defined(ASIO_HAS_SSL_DTLS)
+
+void accept_handler(const asio::error_code&)
+{
+}
+
+void receive_handler(const asio::error_code&, std::size_t)
+{
+}
+
+void send_handler(const asio::error_code&, std::size_t)
+{
+}
+
+#endif // defined(ASIO_HAS_SSL_DTLS)
+
+void test()
+{
+#if defined(ASIO_HAS_SSL_DTLS)
+  using namespace asio;
+  namespace ip = asio::ip;
+  typedef ssl::dtls_acceptor<ip::udp> acceptor_type;
+
+  try
+  {
+    io_context ioc;
+    char mutable_char_buffer[128] = "";
+    const char const_char_buffer[128] = "";
+    asio::ssl::context context(asio::ssl::context::dtls_server);
+    archetypes::lazy_handler lazy;
+    asio::error_code ec;
+    ip::udp::endpoint endpoint(ip::address_v4::loopback(), 0);
+
+    // ssl::dtls_acceptor constructors.
+
+    acceptor_type acceptor1(ioc, context, endpoint);
+    acceptor_type acceptor2(ioc.get_executor(), context, endpoint);
+
+    // ssl::dtls_acceptor functions.
+
+    acceptor_type::executor_type ex = acceptor1.get_executor();
+    (void)ex;
+
+    bool b1 = acceptor1.is_open();
+    (void)b1;
+
+    ip::udp::endpoint e1 = acceptor1.local_endpoint();
+    (void)e1;
+    ip::udp::endpoint e2 = acceptor1.local_endpoint(ec);
+    (void)e2;
+
+    ssl::dtls_stream<acceptor_type::peer_socket> stream1(acceptor1, context);
+    acceptor1.async_accept(stream1, accept_handler);
+    int i1 = acceptor1.async_accept(stream1, lazy);
+    (void)i1;
+
+    // ssl::dtls_acceptor::peer_socket functions.
+
+    acceptor_type::peer_socket peer1(acceptor1);
+    acceptor_type::peer_socket peer2(std::move(peer1));
+    peer1 = std::move(peer2);
+
+    acceptor_type::peer_socket::executor_type ex2 = peer1.get_executor();
+    (void)ex2;
+
+    bool b2 = peer1.is_open();
+    (void)b2;
+
+    ip::udp::endpoint e3 = peer1.remote_endpoint();
+    (void)e3;
+    ip::udp::endpoint e4 = peer1.remote_endpoint(ec);
+    (void)e4;
+
+    peer1.async_receive(buffer(mutable_char_buffer), receive_handler);
+    int i2 = peer1.async_receive(buffer(mutable_char_buffer), lazy);
+    (void)i2;
+
+    peer1.async_send(buffer(const_char_buffer), send_handler);
+    peer1.async_send(buffer(mutable_char_buffer), send_handler);
+    int i3 = peer1.async_send(buffer(const_char_buffer), lazy);
+    (void)i3;
+
+    peer1.cancel();
+    peer1.cancel(ec);
+
+    peer1.close();
+    peer1.close(ec);
+
+    acceptor1.close();
+    acceptor2.close(ec);
+  }
+  catch (std::exception&)
+  {
+  }
+#endif // defined(ASIO_HAS_SSL_DTLS)
+}
+
+} // namespace ssl_dtls_acceptor_compile
+
+//------------------------------------------------------------------------------
+
+// ssl_dtls_acceptor_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that ssl::dtls_acceptor accepts several clients
+// on a single UDP socket, each of which completes a handshake and exchanges
+// data independently.
+
+namespace ssl_dtls_acceptor_runtime {
+
+#if defined(ASIO_HAS_SSL_DTLS)
+
+using asio::ip::udp;
+typedef asio::ssl::dtls_acceptor<udp> acceptor_type;
+typedef asio::ssl::dtls_stream<acceptor_type::peer_socket> session_type;
+typedef asio::ssl::dtls_stream<udp::socket> client_type;
+
+const int num_clients = 3;
+
+struct session
+{
+  session(acceptor_type& acceptor, asio::ssl::context& ctx)
+    : stream(acceptor, ctx)
+  {
+  }
+
+  session_type stream;
+  char data[256];
+};
+
+struct client
+{
+  client(udp::socket sock, asio::ssl::context& ctx, int id)
+    : stream(std::move(sock), ctx),
+      message("hello from client " + std::to_string(id))
+  {
+  }
+
+  client_type stream;
+  std::string message;
+  char data[256];
+  std::string reply;
+};
+
+struct server
+{
+  server(asio::io_context& ioc, asio::ssl::context& ctx)
+    : acceptor(ioc, ctx, udp::endpoint(asio::ip::address_v4::loopback(), 0)),
+      ctx(ctx),
+      accepted(0),
+      echoed(0)
+  {
+  }
+
+  void start_accept()
+  {
+    sessions.emplace_back(new session(acceptor, ctx));
+    session* s = sessions.back().get();
+    acceptor.async_accept(s->stream,
+        [this, s](const asio::error_code& err)
+        {
+          if (err)
+            return;
+          ++accepted;
+          ASIO_CHECK(s->stream.next_layer().is_open());
+          if (accepted < num_clients)
+            start_accept();
+          start_handshake(s);
+        });
+  }
+
+  void start_handshake(session* s)
+  {
+    s->stream.async_handshake(asio::ssl::stream_base::server,
+        [this, s](const asio::error_code& err)
+        {
+          ASIO_CHECK(!err);
+          if (!err)
+            start_echo(s);
+        });
+  }
+
+  void start_echo(session* s)
+  {
+    s->stream.async_read_some(asio::buffer(s->data),
+        [this, s](const asio::error_code& err, std::size_t n)
+        {
+          ASIO_CHECK(!err);
+          if (err)
+            return;
+          s->stream.async_write_some(asio::buffer(s->data, n),
+              [this](const asio::error_code& err, std::size_t)
+              {
+                ASIO_CHECK(!err);
+                ++echoed;
+              });
+        });
+  }
+
+  acceptor_type acceptor;
+  asio::ssl::context& ctx;
+  std::vector<std::unique_ptr<session>> sessions;
+  int accepted;
+  int echoed;
+};
+
+void start_client(client* c, server& srv, int* replies)
+{
+  c->stream.async_handshake(asio::ssl::stream_base::client,
+      [c, &srv, replies](const asio::error_code& err)
+      {
+        ASIO_CHECK(!err);
+        if (err)
+          return;
+        c->stream.async_write_some(asio::buffer(c->message),
+            [c, &srv, replies](const asio::error_code& err, std::size_t)
+            {
+              ASIO_CHECK(!err);
+              c->stream.async_read_some(asio::buffer(c->data),
+                  [c, &srv, replies](const asio::error_code& err, std::size_t n)
+                  {
+                    ASIO_CHECK(!err);
+                    c->reply.assign(c->data, n);
+                    if (++*replies == num_clients)
+                      srv.acceptor.close();
+                  });
+            });
+      });
+}
+
+void test()
+{
+  asio::io_context ioc;
+
+  asio::ssl::context server_ctx(asio::ssl::context::dtls_server);
+  ssl_test::use_certificate(server_ctx);
+  asio::ssl::context client_ctx(asio::ssl::context::dtls_client);
+
+  server srv(ioc, server_ctx);
+  srv.start_accept();
+
+  std::vector<std::unique_ptr<client>> clients;
+  int replies = 0;
+  for (int i = 0; i < num_clients; ++i)
+  {
+    udp::socket sock(ioc, udp::endpoint(asio::ip::address_v4::loopback(), 0));
+    sock.connect(srv.acceptor.local_endpoint());
+    clients.emplace_back(new client(std::move(sock), client_ctx, i));
+    start_client(clients.back().get(), srv, &replies);
+  }
+
+  ioc.run();
+
+  ASIO_CHECK(srv.accepted == num_clients);
+  ASIO_CHECK(srv.echoed == num_clients);
+  ASIO_CHECK(replies == num_clients);
+  for (int i = 0; i < num_clients; ++i)
+    ASIO_CHECK(clients[i]->reply == clients[i]->message);
+  ASIO_CHECK(!srv.acceptor.is_open());
+
+  // Once the acceptor is closed, its peers are closed too.
+  for (int i = 0; i < num_clients; ++i)
+    ASIO_CHECK(!srv.sessions[i]->stream.next_layer().is_open());
+}
+
+#endif // defined(ASIO_HAS_SSL_DTLS)
+
+} // namespace ssl_dtls_acceptor_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "ssl/dtls_acceptor",
+  ASIO_COMPILE_TEST_CASE(ssl_dtls_acceptor_compile::test)
+#if defined(ASIO_HAS_SSL_DTLS)
+  ASIO_TEST_CASE(ssl_dtls_acceptor_runtime::test)
+#endif // defined(ASIO_HAS_SSL_DTLS)
+)
@@ -0,0 +1,330 @@
+//
+// dtls_stream.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/ssl/dtls_stream.hpp"
+
+#include "asio.hpp"
+#include "asio/ssl.hpp"
+#include "../archetypes/async_result.hpp"
+#include "../unit_test.hpp"
+#include "test_certificate.hpp"
+
+//------------------------------------------------------------------------------
+
+// ssl_dtls_stream_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// ssl::dtls_stream compile and link correctly. Runtime failures are ignored.
+
+namespace ssl_dtls_stream_compile {
+
+#if defined(ASIO_HAS_SSL_DTLS)
+
+bool verify_callback(bool, asio::ssl::verify_context&)
+{
+  return false;
+}
+
+void handshake_handler(const asio::error_code&)
+{
+}
+
+void shutdown_handler(const asio::error_code&)
+{
+}
+
+void write_some_handler(const asio::error_code&, std::size_t)
+{
+}
+
+void read_some_handler(const asio::error_code&, std::size_t)
+{
+}
+
+#endif // defined(ASIO_HAS_SSL_DTLS)
+
+void test()
+{
+#if defined(ASIO_HAS_SSL_DTLS)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    char mutable_char_buffer[128] = "";
+    const char const_char_buffer[128] = "";
+    asio::ssl::context context(asio::ssl::context::dtls);
+    archetypes::lazy_handler lazy;
+    asio::error_code ec;
+
+    // ssl::dtls_stream constructors.
+
+    ssl::dtls_stream<ip::udp::socket> stream1(ioc, context);
+    ip::udp::socket socket1(ioc, ip::udp::v4());
+    ssl::dtls_stream<ip::udp::socket&> stream2(socket1, context);
+
+    ssl::dtls_stream<ip::udp::socket> stream3
+      = ssl::dtls_stream<ip::udp::socket>(ioc, context);
+    ssl::dtls_stream<ip::udp::socket> stream4(std::move(stream3));
+
+    // ssl::dtls_stream assignment.
+
+    stream3 = std::move(stream4);
+
+    // I/O object functions.
+
+    ssl::dtls_stream<ip::udp::socket>::executor_type ex
+      = stream1.get_executor();
+    (void)ex;
+
+    // ssl::dtls_stream functions.
+
+    SSL* ssl1 = stream1.native_handle();
+    (void)ssl1;
+
+    ssl::dtls_stream<ip::udp::socket>::next_layer_type& next_layer
+      = stream1.next_layer();
+    (void)next_layer;
+
+    const ssl::dtls_stream<ip::udp::socket>& stream5 = stream1;
+    const ssl::dtls_stream<ip::udp::socket>::next_layer_type& next_layer2
+      = stream5.next_layer();
+    (void)next_layer2;
+
+    std::size_t mtu = stream1.mtu();
+    (void)mtu;
+    stream1.set_mtu(1200);
+    stream1.set_mtu(1200, ec);
+
+    stream1.set_verify_mode(ssl::verify_none);
+    stream1.set_verify_mode(ssl::verify_none, ec);
+
+    stream1.set_verify_depth(1);
+    stream1.set_verify_depth(1, ec);
+
+    stream1.set_verify_callback(verify_callback);
+    stream1.set_verify_callback(verify_callback, ec);
+
+    stream1.handshake(ssl::stream_base::client);
+    stream1.handshake(ssl::stream_base::server);
+    stream1.handshake(ssl::stream_base::client, ec);
+    stream1.handshake(ssl::stream_base::server, ec);
+
+    stream1.async_handshake(ssl::stream_base::client, handshake_handler);
+    stream1.async_handshake(ssl::stream_base::server, handshake_handler);
+    int i1 = stream1.async_handshake(ssl::stream_base::client, lazy);
+    (void)i1;
+    int i2 = stream1.async_handshake(ssl::stream_base::server, lazy);
+    (void)i2;
+
+    stream1.shutdown();
+    stream1.shutdown(ec);
+
+    stream1.async_shutdown(shutdown_handler);
+    int i3 = stream1.async_shutdown(lazy);
+    (void)i3;
+
+    stream1.write_some(buffer(mutable_char_buffer));
+    stream1.write_some(buffer(const_char_buffer));
+    stream1.write_some(buffer(mutable_char_buffer), ec);
+    stream1.write_some(buffer(const_char_buffer), ec);
+
+    stream1.async_write_some(buffer(mutable_char_buffer), write_some_handler);
+    stream1.async_write_some(buffer(const_char_buffer), write_some_handler);
+    int i4 = stream1.async_write_some(buffer(mutable_char_buffer), lazy);
+    (void)i4;
+    int i5 = stream1.async_write_some(buffer(const_char_buffer), lazy);
+    (void)i5;
+
+    stream1.read_some(buffer(mutable_char_buffer));
+    stream1.read_some(buffer(mutable_char_buffer), ec);
+
+    stream1.async_read_some(buffer(mutable_char_buffer), read_some_handler);
+    int i6 = stream1.async_read_some(buffer(mutable_char_buffer), lazy);
+    (void)i6;
+  }
+  catch (std::exception&)
+  {
+  }
+#endif // defined(ASIO_HAS_SSL_DTLS)
+}
+
+} // namespace ssl_dtls_stream_compile
+
+//------------------------------------------------------------------------------
+
+// ssl_dtls_stream_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of ssl::dtls_stream over a
+// pair of connected loopback UDP sockets.
+
+namespace ssl_dtls_stream_runtime {
+
+#if defined(ASIO_HAS_SSL_DTLS)
+
+typedef asio::ssl::dtls_stream<asio::ip::udp::socket> stream_type;
+
+void handshake_handler(const asio::error_code& err,
+    asio::error_code* out_err, int* count)
+{
+  *out_err = err;
+  ++*count;
+}
+
+void io_handler(const asio::error_code& err, std::size_t n,
+    asio::error_code* out_err, std::size_t* out_n)
+{
+  *out_err = err;
+  *out_n = n;
+}
+
+void echo_test()
+{
+  using namespace std; // For memcmp and memset.
+  using asio::ip::udp;
+  namespace bindns = std;
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  asio::io_context ioc;
+
+  asio::ssl::context server_ctx(asio::ssl::context::dtls_server);
+  ssl_test::use_certificate(server_ctx);
+  asio::ssl::context client_ctx(asio::ssl::context::dtls_client);
+
+  udp::socket s1(ioc, udp::endpoint(asio::ip::address_v4::loopback(), 0));
+  udp::socket s2(ioc, udp::endpoint(asio::ip::address_v4::loopback(), 0));
+  s1.connect(s2.local_endpoint());
+  s2.connect(s1.local_endpoint());
+
+  stream_type server(std::move(s1), server_ctx);
+  stream_type client(std::move(s2), client_ctx);
+
+  ASIO_CHECK(client.mtu() == 1400);
+  client.set_mtu(1200);
+  ASIO_CHECK(client.mtu() == 1200);
+
+  asio::error_code server_err = asio::error::would_block;
+  asio::error_code client_err = asio::error::would_block;
+  int handshakes = 0;
+  server.async_handshake(asio::ssl::stream_base::server,
+      bindns::bind(handshake_handler, _1, &server_err, &handshakes));
+  client.async_handshake(asio::ssl::stream_base::client,
+      bindns::bind(handshake_handler, _1, &client_err, &handshakes));
+  ioc.run();
+
+  ASIO_CHECK(handshakes == 2);
+  ASIO_CHECK(!server_err);
+  ASIO_CHECK(!client_err);
+
+  // Each write is carried in a single record, and each read receives a whole
+  // record.
+  char write_data[1000];
+  for (std::size_t i = 0; i < sizeof(write_data); ++i)
+    write_data[i] = static_cast<char>(i);
+  char read_data[2000];
+  memset(read_data, 0, sizeof(read_data));
+
+  std::size_t written = 0;
+  std::size_t read = 0;
+  client.async_write_some(asio::buffer(write_data),
+      bindns::bind(io_handler, _1, _2, &client_err, &written));
+  server.async_read_some(asio::buffer(read_data),
+      bindns::bind(io_handler, _1, _2, &server_err, &read));
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(!client_err);
+  ASIO_CHECK(!server_err);
+  ASIO_CHECK(written == sizeof(write_data));
+  ASIO_CHECK(read == sizeof(write_data));
+  ASIO_CHECK(memcmp(read_data, write_data, sizeof(write_data)) == 0);
+
+  // A write larger than the MTU is truncated to what fits in one datagram.
+  char large_data[4000];
+  memset(large_data, 'x', sizeof(large_data));
+  written = server.write_some(asio::buffer(large_data), server_err);
+  ASIO_CHECK(!server_err);
+  ASIO_CHECK(written > 0);
+  ASIO_CHECK(written < 1400);
+
+  read = client.read_some(asio::buffer(read_data), client_err);
+  ASIO_CHECK(!client_err);
+  ASIO_CHECK(read == written);
+}
+
+void handshake_timeout_test()
+{
+  using asio::ip::udp;
+
+  asio::io_context ioc;
+  asio::ssl::context client_ctx(asio::ssl::context::dtls_client);
+
+  // The peer socket never answers, so the client retransmits its ClientHello
+  // until OpenSSL gives up on the handshake. Depending on where the limit is
+  // detected the error is either asio::error::timed_out or an SSL error.
+  udp::socket silent(ioc, udp::endpoint(asio::ip::address_v4::loopback(), 0));
+  udp::socket s(ioc, udp::endpoint(asio::ip::address_v4::loopback(), 0));
+  s.connect(silent.local_endpoint());
+
+  stream_type client(std::move(s), client_ctx);
+  DTLS_set_timer_cb(client.native_handle(),
+      [](SSL*, unsigned int) -> unsigned int { return 1000; });
+
+  asio::error_code client_err;
+  int handshakes = 0;
+  client.async_handshake(asio::ssl::stream_base::client,
+      [&](const asio::error_code& err)
+      {
+        client_err = err;
+        ++handshakes;
+      });
+  ioc.run();
+
+  ASIO_CHECK(handshakes == 1);
+  ASIO_CHECK(!!client_err);
+
+  char buf[2048];
+  std::size_t datagrams = 0;
+  while (silent.available() > 0)
+  {
+    silent.receive(asio::buffer(buf));
+    ++datagrams;
+  }
+  ASIO_CHECK(datagrams > 1);
+}
+
+#endif // defined(ASIO_HAS_SSL_DTLS)
+
+void test()
+{
+#if defined(ASIO_HAS_SSL_DTLS)
+  echo_test();
+  handshake_timeout_test();
+#endif // defined(ASIO_HAS_SSL_DTLS)
+}
+
+} // namespace ssl_dtls_stream_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "ssl/dtls_stream",
+  ASIO_COMPILE_TEST_CASE(ssl_dtls_stream_compile::test)
+  ASIO_TEST_CASE(ssl_dtls_stream_runtime::test)
+)
@@ -0,0 +1,290 @@
+//
+// session_cache.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/ssl/session_cache.hpp"
+
+#include "asio.hpp"
+#include "asio/ssl.hpp"
+#include "../unit_test.hpp"
+#include "test_certificate.hpp"
+
+//------------------------------------------------------------------------------
+
+// ssl_session_cache_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// ssl::session_cache, and the related members of ssl::context and
+// ssl::stream, compile and link correctly. Runtime failures are ignored.
+
+namespace ssl_session_cache_compile {
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    asio::error_code ec;
+
+    // ssl::session_cache constructors.
+
+    ssl::session_cache cache1;
+    ssl::session_cache cache2(1024);
+    ssl::session_cache cache3(1024, 4);
+
+    // ssl::session_cache functions.
+
+    std::size_t n1 = cache1.capacity();
+    (void)n1;
+
+    std::size_t n2 = cache1.size();
+    (void)n2;
+
+    cache1.clear();
+
+    cache1.set_ticket_key_lifetime(asio::chrono::seconds(60));
+
+    cache1.rotate_ticket_keys();
+    cache1.rotate_ticket_keys(ec);
+
+    // ssl::context functions.
+
+    ssl::context ctx(ssl::context::tls);
+    ctx.set_session_cache(cache1);
+    ctx.set_session_cache(cache1, ec);
+
+    // ssl::stream functions.
+
+    ssl::stream<ip::tcp::socket> stream1(ioc, ctx);
+    stream1.set_session_cache_key("key");
+    stream1.set_session_cache_key("key", ec);
+
+    bool b1 = stream1.session_reused();
+    (void)b1;
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace ssl_session_cache_compile
+
+//------------------------------------------------------------------------------
+
+// ssl_session_cache_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that sessions are stored in a session cache and
+// resumed by later connections, including connections using other contexts
+// that share the cache.
+
+namespace ssl_session_cache_runtime {
+
+typedef asio::ssl::stream<asio::ip::tcp::socket> stream_type;
+
+// Make one connection and return whether the client resumed a session.
+bool connect(asio::ssl::context& server_ctx,
+    asio::ssl::context& client_ctx, const char* host_name,
+    const char* cache_key = 0)
+{
+  using asio::ip::tcp;
+
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  stream_type server(ioc, server_ctx);
+  stream_type client(ioc, client_ctx);
+  client.lowest_layer().connect(acceptor.local_endpoint());
+  acceptor.accept(server.lowest_layer());
+
+  if (host_name)
+    SSL_set_tlsext_host_name(client.native_handle(), host_name);
+  if (cache_key)
+    client.set_session_cache_key(cache_key);
+
+  // The server writes a byte after the handshake. The client reads it, and
+  // so also processes any session tickets sent before it.
+  char server_data = 'x', client_data = 0;
+  asio::error_code server_ec, client_ec;
+  server.async_handshake(asio::ssl::stream_base::server,
+      [&](const asio::error_code& e)
+      {
+        server_ec = e;
+        if (e)
+          return;
+        asio::async_write(server, asio::buffer(&server_data, 1),
+            [&](const asio::error_code& e, std::size_t)
+            {
+              server_ec = e;
+              if (!e)
+                server.async_shutdown([](const asio::error_code&){});
+            });
+      });
+  client.async_handshake(asio::ssl::stream_base::client,
+      [&](const asio::error_code& e)
+      {
+        client_ec = e;
+        if (e)
+          return;
+        asio::async_read(client, asio::buffer(&client_data, 1),
+            [&](const asio::error_code& e, std::size_t)
+            {
+              client_ec = e;
+              if (!e)
+                client.async_shutdown([](const asio::error_code&){});
+            });
+      });
+  ioc.run();
+
+  ASIO_CHECK(!server_ec);
+  ASIO_CHECK(!client_ec);
+  ASIO_CHECK(client_data == 'x');
+  ASIO_CHECK(server.session_reused() == client.session_reused());
+  return client.session_reused();
+}
+
+void make_server_context(asio::ssl::context& ctx,
+    asio::ssl::session_cache& cache)
+{
+  ssl_test::use_certificate(ctx);
+  ctx.set_session_cache(cache);
+}
+
+void test_ticket_resumption()
+{
+  asio::ssl::session_cache server_cache, client_cache;
+
+  asio::ssl::context server_ctx1(asio::ssl::context::tls_server);
+  make_server_context(server_ctx1, server_cache);
+  asio::ssl::context server_ctx2(asio::ssl::context::tls_server);
+  make_server_context(server_ctx2, server_cache);
+
+  asio::ssl::context client_ctx(asio::ssl::context::tls_client);
+  client_ctx.set_session_cache(client_cache);
+
+  ASIO_CHECK(!connect(server_ctx1, client_ctx, "localhost"));
+  ASIO_CHECK(client_cache.size() == 1);
+
+  // A session established with one server context is resumed by another
+  // context that shares the cache.
+  ASIO_CHECK(connect(server_ctx2, client_ctx, "localhost"));
+  ASIO_CHECK(connect(server_ctx1, client_ctx, "localhost"));
+
+  // Without a server name or key the client session is not stored.
+  ASIO_CHECK(!connect(server_ctx1, client_ctx, 0));
+  ASIO_CHECK(client_cache.size() == 1);
+
+  // A different server name does not find the session.
+  ASIO_CHECK(!connect(server_ctx1, client_ctx, "other.host"));
+  ASIO_CHECK(client_cache.size() == 2);
+
+  // A context that does not share the server cache cannot resume.
+  asio::ssl::session_cache other_cache;
+  asio::ssl::context server_ctx3(asio::ssl::context::tls_server);
+  make_server_context(server_ctx3, other_cache);
+  ASIO_CHECK(!connect(server_ctx3, client_ctx, "localhost"));
+
+  client_cache.clear();
+  ASIO_CHECK(client_cache.size() == 0);
+  ASIO_CHECK(!connect(server_ctx1, client_ctx, "localhost"));
+}
+
+void test_session_id_resumption()
+{
+  asio::ssl::session_cache server_cache, client_cache;
+
+  // Without tickets, TLS 1.2 sessions are found by their session ID.
+  asio::ssl::context server_ctx(asio::ssl::context::tls_server);
+  make_server_context(server_ctx, server_cache);
+  server_ctx.set_options(asio::ssl::context::no_tlsv1_3);
+  SSL_CTX_set_options(server_ctx.native_handle(), SSL_OP_NO_TICKET);
+
+  asio::ssl::context client_ctx(asio::ssl::context::tls_client);
+  client_ctx.set_session_cache(client_cache);
+
+  ASIO_CHECK(!connect(server_ctx, client_ctx, 0, "server"));
+  ASIO_CHECK(server_cache.size() == 1);
+  ASIO_CHECK(client_cache.size() == 1);
+
+  ASIO_CHECK(connect(server_ctx, client_ctx, 0, "server"));
+  ASIO_CHECK(server_cache.size() == 1);
+
+  server_cache.clear();
+  ASIO_CHECK(!connect(server_ctx, client_ctx, 0, "server"));
+}
+
+void test_ticket_key_rotation()
+{
+  asio::ssl::session_cache server_cache, client_cache;
+
+  asio::ssl::context server_ctx(asio::ssl::context::tls_server);
+  make_server_context(server_ctx, server_cache);
+
+  asio::ssl::context client_ctx(asio::ssl::context::tls_client);
+  client_ctx.set_session_cache(client_cache);
+
+  ASIO_CHECK(!connect(server_ctx, client_ctx, "localhost"));
+
+  // A ticket issued with the previous key is still accepted, and is replaced
+  // by one issued with the current key.
+  server_cache.rotate_ticket_keys();
+  ASIO_CHECK(connect(server_ctx, client_ctx, "localhost"));
+
+  // A ticket whose key has been retired is rejected.
+  server_cache.rotate_ticket_keys();
+  server_cache.rotate_ticket_keys();
+  server_cache.rotate_ticket_keys();
+  ASIO_CHECK(!connect(server_ctx, client_ctx, "localhost"));
+  ASIO_CHECK(connect(server_ctx, client_ctx, "localhost"));
+}
+
+void test_eviction()
+{
+  asio::ssl::session_cache server_cache;
+  asio::ssl::session_cache client_cache(2, 1);
+  ASIO_CHECK(client_cache.capacity() == 2);
+
+  asio::ssl::context server_ctx(asio::ssl::context::tls_server);
+  make_server_context(server_ctx, server_cache);
+
+  asio::ssl::context client_ctx(asio::ssl::context::tls_client);
+  client_ctx.set_session_cache(client_cache);
+
+  ASIO_CHECK(!connect(server_ctx, client_ctx, 0, "a"));
+  ASIO_CHECK(!connect(server_ctx, client_ctx, 0, "b"));
+  ASIO_CHECK(connect(server_ctx, client_ctx, 0, "a"));
+  ASIO_CHECK(!connect(server_ctx, client_ctx, 0, "c"));
+  ASIO_CHECK(client_cache.size() == 2);
+
+  // The least recently used session, for "b", has been evicted.
+  ASIO_CHECK(connect(server_ctx, client_ctx, 0, "a"));
+  ASIO_CHECK(!connect(server_ctx, client_ctx, 0, "b"));
+}
+
+} // namespace ssl_session_cache_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "ssl/session_cache",
+  ASIO_COMPILE_TEST_CASE(ssl_session_cache_compile::test)
+  ASIO_TEST_CASE(ssl_session_cache_runtime::test_ticket_resumption)
+  ASIO_TEST_CASE(ssl_session_cache_runtime::test_session_id_resumption)
+  ASIO_TEST_CASE(ssl_session_cache_runtime::test_ticket_key_rotation)
+  ASIO_TEST_CASE(ssl_session_cache_runtime::test_eviction)
+)
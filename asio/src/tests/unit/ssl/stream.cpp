@@ -16,10 +16,15 @@
 // Test that header file is self-contained.
 #include "asio/ssl/stream.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <vector>
 #include "asio.hpp"
 #include "asio/ssl.hpp"
 #include "../archetypes/async_result.hpp"
 #include "../unit_test.hpp"
+#include "test_certificate.hpp"
 
 //------------------------------------------------------------------------------
 
@@ -102,6 +107,31 @@ void test()
       = stream5.lowest_layer();
     (void)lowest_layer2;
 
+    stream1.use_kernel_tls();
+    stream1.use_kernel_tls(ec);
+
+    bool b1 = stream1.kernel_tls_send_active();
+    (void)b1;
+    bool b2 = stream1.kernel_tls_receive_active();
+    (void)b2;
+
+    stream1.set_handshake_executor(ioc.get_executor());
+    stream1.set_handshake_executor(any_io_executor());
+
+    any_io_executor ex1 = stream1.handshake_executor();
+    (void)ex1;
+
+    stream1.set_output_buffer_size(65536);
+    stream1.set_output_buffer_size(65536, ec);
+
+    std::size_t size1 = stream1.output_buffer_size();
+    (void)size1;
+
+    stream1.set_dynamic_record_sizing(true);
+
+    bool b3 = stream1.dynamic_record_sizing();
+    (void)b3;
+
     stream1.set_verify_mode(ssl::verify_none);
     stream1.set_verify_mode(ssl::verify_none, ec);
 
@@ -192,8 +222,543 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// ssl_stream_transfer test
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that large amounts of data can be transferred in
+// both directions at once, with reads and writes on each stream concurrently
+// sharing the engine's input and output buffers.
+
+namespace ssl_stream_transfer {
+
+typedef asio::ssl::stream<asio::ip::tcp::socket> stream_type;
+
+const std::size_t transfer_size = 1024 * 1024;
+
+void start_transfer(stream_type& stream, const std::vector<char>& out,
+    std::vector<char>& in, int* completed, asio::error_code* err)
+{
+  asio::async_write(stream, asio::buffer(out),
+      [completed, err](const asio::error_code& e, std::size_t)
+      {
+        if (e)
+          *err = e;
+        ++*completed;
+      });
+  asio::async_read(stream, asio::buffer(in),
+      [completed, err](const asio::error_code& e, std::size_t)
+      {
+        if (e)
+          *err = e;
+        ++*completed;
+      });
+}
+
+void test()
+{
+  using asio::ip::tcp;
+
+  asio::io_context ioc;
+
+  asio::ssl::context server_ctx(asio::ssl::context::tls_server);
+  ssl_test::use_certificate(server_ctx);
+  asio::ssl::context client_ctx(asio::ssl::context::tls_client);
+
+  tcp::acceptor acceptor(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  stream_type server(ioc, server_ctx);
+  stream_type client(ioc, client_ctx);
+  client.lowest_layer().connect(acceptor.local_endpoint());
+  acceptor.accept(server.lowest_layer());
+
+  std::vector<char> client_out(transfer_size), server_out(transfer_size);
+  for (std::size_t i = 0; i < transfer_size; ++i)
+  {
+    client_out[i] = static_cast<char>(i * 7);
+    server_out[i] = static_cast<char>(i * 13);
+  }
+  std::vector<char> client_in(transfer_size), server_in(transfer_size);
+
+  int completed = 0;
+  asio::error_code err;
+  server.async_handshake(asio::ssl::stream_base::server,
+      [&](const asio::error_code& e)
+      {
+        ASIO_CHECK(!e);
+        if (!e)
+          start_transfer(server, server_out, server_in, &completed, &err);
+      });
+  client.async_handshake(asio::ssl::stream_base::client,
+      [&](const asio::error_code& e)
+      {
+        ASIO_CHECK(!e);
+        if (!e)
+          start_transfer(client, client_out, client_in, &completed, &err);
+      });
+  ioc.run();
+
+  ASIO_CHECK(!err);
+  ASIO_CHECK(completed == 4);
+  ASIO_CHECK(server_in == client_out);
+  ASIO_CHECK(client_in == server_out);
+}
+
+} // namespace ssl_stream_transfer
+
+//------------------------------------------------------------------------------
+
+// ssl_stream_batched_write test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a stream with an enlarged output buffer
+// encrypts several TLS records in a single write_some operation.
+
+namespace ssl_stream_batched_write {
+
+typedef asio::ssl::stream<asio::ip::tcp::socket> stream_type;
+
+void test()
+{
+  using asio::ip::tcp;
+
+  asio::io_context ioc;
+
+  asio::ssl::context server_ctx(asio::ssl::context::tls_server);
+  ssl_test::use_certificate(server_ctx);
+  asio::ssl::context client_ctx(asio::ssl::context::tls_client);
+
+  tcp::acceptor acceptor(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  stream_type server(ioc, server_ctx);
+  stream_type client(ioc, client_ctx);
+  client.lowest_layer().connect(acceptor.local_endpoint());
+  acceptor.accept(server.lowest_layer());
+
+  std::size_t default_size = client.output_buffer_size();
+  client.set_output_buffer_size(1);
+  ASIO_CHECK(client.output_buffer_size() == default_size);
+  client.set_output_buffer_size(8 * default_size);
+  ASIO_CHECK(client.output_buffer_size() == 8 * default_size);
+
+  const std::size_t data_size = 4 * default_size;
+  std::vector<char> out(data_size);
+  for (std::size_t i = 0; i < data_size; ++i)
+    out[i] = static_cast<char>(i * 7);
+  std::vector<char> in(data_size);
+
+  // Split the data unevenly so that records straddle buffer boundaries.
+  std::vector<asio::const_buffer> out_buffers;
+  out_buffers.push_back(asio::buffer(out.data(), 1000));
+  out_buffers.push_back(asio::buffer(out.data() + 1000, 30000));
+  out_buffers.push_back(asio::buffer(out.data() + 31000, data_size - 31000));
+
+  std::size_t written = 0;
+  std::size_t total_read = 0;
+  asio::error_code write_err, read_err;
+  std::function<void()> read_more = [&]()
+  {
+    server.async_read_some(asio::buffer(in.data() + total_read,
+          written - total_read),
+        [&](const asio::error_code& e, std::size_t n)
+        {
+          read_err = e;
+          total_read += n;
+          if (!e && total_read < written)
+            read_more();
+        });
+  };
+
+  // The server starts reading once its handshake and the client's write have
+  // both completed.
+  int ready = 0;
+  server.async_handshake(asio::ssl::stream_base::server,
+      [&](const asio::error_code& e)
+      {
+        ASIO_CHECK(!e);
+        if (!e && ++ready == 2)
+          read_more();
+      });
+  client.async_handshake(asio::ssl::stream_base::client,
+      [&](const asio::error_code& e)
+      {
+        ASIO_CHECK(!e);
+        if (!e)
+        {
+          client.async_write_some(out_buffers,
+              [&](const asio::error_code& e, std::size_t n)
+              {
+                write_err = e;
+                written = n;
+                if (!e && ++ready == 2)
+                  read_more();
+              });
+        }
+      });
+  ioc.run();
+
+  ASIO_CHECK(!write_err);
+  ASIO_CHECK(!read_err);
+  ASIO_CHECK(written > 16384);
+  ASIO_CHECK(total_read == written);
+  ASIO_CHECK(std::equal(in.begin(), in.begin() + total_read, out.begin()));
+}
+
+} // namespace ssl_stream_batched_write
+
+//------------------------------------------------------------------------------
+
+// ssl_stream_dynamic_record_sizing test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a stream with dynamic record sizing enabled
+// writes small TLS records, and that full records are written once it is
+// disabled.
+
+namespace ssl_stream_dynamic_record_sizing {
+
+typedef asio::ssl::stream<asio::ip::tcp::socket> stream_type;
+
+// Records the length of each TLS record written once the handshake is done.
+void record_callback(int write_p, int /*version*/, int content_type,
+    const void* buf, std::size_t len, SSL* /*ssl*/, void* arg)
+{
+  std::vector<std::size_t>* lengths = static_cast<std::vector<std::size_t>*>(arg);
+  if (lengths && write_p && content_type == SSL3_RT_HEADER
+      && len >= SSL3_RT_HEADER_LENGTH)
+  {
+    const unsigned char* header = static_cast<const unsigned char*>(buf);
+    lengths->push_back((header[3] << 8) | header[4]);
+  }
+}
+
+void test()
+{
+  using asio::ip::tcp;
+
+  asio::io_context ioc;
+
+  asio::ssl::context server_ctx(asio::ssl::context::tls_server);
+  ssl_test::use_certificate(server_ctx);
+  asio::ssl::context client_ctx(asio::ssl::context::tls_client);
+
+  tcp::acceptor acceptor(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  stream_type server(ioc, server_ctx);
+  stream_type client(ioc, client_ctx);
+  client.lowest_layer().connect(acceptor.local_endpoint());
+  acceptor.accept(server.lowest_layer());
+
+  ASIO_CHECK(!client.dynamic_record_sizing());
+  client.set_dynamic_record_sizing(true);
+  ASIO_CHECK(client.dynamic_record_sizing());
+
+  std::vector<std::size_t> lengths;
+  SSL_set_msg_callback(client.native_handle(), &record_callback);
+
+  asio::error_code client_ec, server_ec;
+  server.async_handshake(asio::ssl::stream_base::server,
+      [&](const asio::error_code& e){ server_ec = e; });
+  client.async_handshake(asio::ssl::stream_base::client,
+      [&](const asio::error_code& e){ client_ec = e; });
+  ioc.run();
+  ASIO_CHECK(!client_ec);
+  ASIO_CHECK(!server_ec);
+
+  SSL_set_msg_callback_arg(client.native_handle(), &lengths);
+
+  const std::size_t data_size = 40000;
+  std::vector<char> out(data_size);
+  for (std::size_t i = 0; i < data_size; ++i)
+    out[i] = static_cast<char>(i * 7);
+  std::vector<char> in(data_size);
+
+  for (int i = 0; i < 2; ++i)
+  {
+    ioc.restart();
+    std::size_t written = 0;
+    asio::error_code write_err, read_err;
+    asio::async_write(client, asio::buffer(out),
+        [&](const asio::error_code& e, std::size_t n)
+        {
+          write_err = e;
+          written = n;
+        });
+    asio::async_read(server, asio::buffer(in),
+        [&](const asio::error_code& e, std::size_t)
+        {
+          read_err = e;
+        });
+    ioc.run();
+
+    ASIO_CHECK(!write_err);
+    ASIO_CHECK(!read_err);
+    ASIO_CHECK(written == data_size);
+    ASIO_CHECK(in == out);
+
+    // Each record holds the data and at most a few hundred bytes of overhead.
+    std::size_t largest = 0;
+    for (std::size_t j = 0; j < lengths.size(); ++j)
+      largest = (std::max)(largest, lengths[j]);
+    if (i == 0)
+    {
+      ASIO_CHECK(lengths.size() >= data_size / 1400);
+      ASIO_CHECK(largest <= 1400 + 256);
+      client.set_dynamic_record_sizing(false);
+    }
+    else
+    {
+      ASIO_CHECK(largest > 16000);
+    }
+    lengths.clear();
+  }
+}
+
+} // namespace ssl_stream_dynamic_record_sizing
+
+//------------------------------------------------------------------------------
+
+// ssl_stream_handshake_executor test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the steps of an asynchronous handshake are
+// performed on the handshake executor, and that the operation completes on
+// the stream's executor.
+
+namespace ssl_stream_handshake_executor {
+
+typedef asio::ssl::stream<asio::ip::tcp::socket> stream_type;
+
+void test()
+{
+  using asio::ip::tcp;
+
+  asio::io_context ioc;
+  asio::thread_pool pool(1);
+
+  asio::ssl::context server_ctx(asio::ssl::context::tls_server);
+  ssl_test::use_certificate(server_ctx);
+  asio::ssl::context client_ctx(asio::ssl::context::tls_client);
+
+  tcp::acceptor acceptor(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  stream_type server(ioc, server_ctx);
+  stream_type client(ioc, client_ctx);
+  client.lowest_layer().connect(acceptor.local_endpoint());
+  acceptor.accept(server.lowest_layer());
+
+  server.set_handshake_executor(pool.get_executor());
+  client.set_handshake_executor(pool.get_executor());
+  ASIO_CHECK(client.handshake_executor() == pool.get_executor());
+
+  // The verify callback runs inside the handshake step that processes the
+  // server's certificate.
+  int verify_calls = 0;
+  bool verify_on_pool = true;
+  client.set_verify_mode(asio::ssl::verify_peer);
+  client.set_verify_callback(
+      [&](bool, asio::ssl::verify_context&)
+      {
+        ++verify_calls;
+        verify_on_pool = verify_on_pool
+          && pool.get_executor().running_in_this_thread();
+        return true;
+      });
+
+  int completed = 0;
+  bool handlers_on_ioc = true;
+  asio::error_code server_ec, client_ec;
+  server.async_handshake(asio::ssl::stream_base::server,
+      [&](const asio::error_code& e)
+      {
+        server_ec = e;
+        handlers_on_ioc = handlers_on_ioc
+          && ioc.get_executor().running_in_this_thread();
+        ++completed;
+      });
+  client.async_handshake(asio::ssl::stream_base::client,
+      [&](const asio::error_code& e)
+      {
+        client_ec = e;
+        handlers_on_ioc = handlers_on_ioc
+          && ioc.get_executor().running_in_this_thread();
+        ++completed;
+      });
+  ioc.run();
+
+  ASIO_CHECK(completed == 2);
+  ASIO_CHECK(!server_ec);
+  ASIO_CHECK(!client_ec);
+  ASIO_CHECK(verify_calls > 0);
+  ASIO_CHECK(verify_on_pool);
+  ASIO_CHECK(handlers_on_ioc);
+
+  // Data transfer after the handshake is unaffected.
+  char out[] = "ping", in[sizeof(out)] = "";
+  asio::write(client, asio::buffer(out));
+  asio::read(server, asio::buffer(in));
+  ASIO_CHECK(std::memcmp(in, out, sizeof(out)) == 0);
+}
+
+} // namespace ssl_stream_handshake_executor
+
+//------------------------------------------------------------------------------
+
+// ssl_stream_kernel_tls test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a stream attached to its socket with
+// use_kernel_tls() interoperates with a stream that uses its internal buffers,
+// whether or not the kernel supports TLS offload.
+
+namespace ssl_stream_kernel_tls {
+
+typedef asio::ssl::stream<asio::ip::tcp::socket> stream_type;
+
+void run_test(bool async)
+{
+  using namespace std; // For memcmp.
+  using asio::ip::tcp;
+
+  asio::io_context ioc;
+
+  asio::ssl::context server_ctx(asio::ssl::context::tls_server);
+  ssl_test::use_certificate(server_ctx);
+  asio::ssl::context client_ctx(asio::ssl::context::tls_client);
+
+  tcp::acceptor acceptor(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  stream_type server(ioc, server_ctx);
+  stream_type client(ioc, client_ctx);
+  client.lowest_layer().connect(acceptor.local_endpoint());
+  acceptor.accept(server.lowest_layer());
+
+  client.use_kernel_tls();
+
+  // Attaching to the socket is only allowed before the handshake.
+  asio::error_code ec;
+  stream_type unopened(ioc, client_ctx);
+  unopened.use_kernel_tls(ec);
+  ASIO_CHECK(ec == asio::error::bad_descriptor);
+
+  const char request[] = "request";
+  char buffer[64] = "";
+  char reply[64] = "";
+  asio::error_code server_err, client_err;
+  std::size_t bytes = 0;
+  int completed = 0;
+
+  server.async_handshake(asio::ssl::stream_base::server,
+      [&](const asio::error_code& err)
+      {
+        server_err = err;
+        if (err)
+          return;
+        asio::async_read(server, asio::buffer(buffer, sizeof(request)),
+            [&](const asio::error_code& err, std::size_t)
+            {
+              server_err = err;
+              if (err)
+                return;
+              asio::async_write(server, asio::buffer(buffer, sizeof(request)),
+                  [&](const asio::error_code& err, std::size_t)
+                  {
+                    server_err = err;
+                    ++completed;
+                  });
+            });
+      });
+
+  if (async)
+  {
+    client.async_handshake(asio::ssl::stream_base::client,
+        [&](const asio::error_code& err)
+        {
+          client_err = err;
+          if (err)
+            return;
+          asio::async_write(client, asio::buffer(request),
+              [&](const asio::error_code& err, std::size_t)
+              {
+                client_err = err;
+                if (err)
+                  return;
+                asio::async_read(client, asio::buffer(reply, sizeof(request)),
+                    [&](const asio::error_code& err, std::size_t n)
+                    {
+                      client_err = err;
+                      bytes = n;
+                      if (memcmp(reply, request, sizeof(request)) != 0)
+                        bytes = 0;
+                      ++completed;
+                    });
+              });
+        });
+    ioc.run();
+  }
+  else
+  {
+    asio::thread server_thread([&]{ ioc.run(); });
+    client.handshake(asio::ssl::stream_base::client, client_err);
+    ASIO_CHECK(!client_err);
+    asio::write(client, asio::buffer(request), client_err);
+    ASIO_CHECK(!client_err);
+    bytes = asio::read(client,
+        asio::buffer(reply, sizeof(request)), client_err);
+    if (memcmp(reply, request, sizeof(request)) != 0)
+      bytes = 0;
+    server_thread.join();
+    ++completed;
+  }
+
+  ASIO_CHECK(!server_err);
+  ASIO_CHECK(!client_err);
+  ASIO_CHECK(completed == 2);
+  ASIO_CHECK(bytes == sizeof(request));
+
+  // The kernel may or may not have accepted the keys, but offload can only be
+  // active on the stream that asked for it.
+  (void)client.kernel_tls_send_active();
+  (void)client.kernel_tls_receive_active();
+  ASIO_CHECK(!server.kernel_tls_send_active());
+  ASIO_CHECK(!server.kernel_tls_receive_active());
+
+  // It is too late to attach once the handshake has started.
+  client.use_kernel_tls(ec);
+  ASIO_CHECK(ec == asio::error::already_started);
+
+  // A clean shutdown from the server is seen as end of file by the client,
+  // which then completes the shutdown from its side.
+  ioc.restart();
+  asio::error_code read_err = asio::error::would_block;
+  server_err = client_err = asio::error::would_block;
+  server.async_shutdown(
+      [&](const asio::error_code& err)
+      {
+        server_err = err;
+      });
+  client.async_read_some(asio::buffer(buffer),
+      [&](const asio::error_code& err, std::size_t)
+      {
+        read_err = err;
+        client.async_shutdown(
+            [&](const asio::error_code& err)
+            {
+              client_err = err;
+            });
+      });
+  ioc.run();
+  ASIO_CHECK(read_err == asio::error::eof);
+  ASIO_CHECK(!server_err);
+  ASIO_CHECK(!client_err);
+}
+
+void test()
+{
+  run_test(true);
+  run_test(false);
+}
+
+} // namespace ssl_stream_kernel_tls
+
+//------------------------------------------------------------------------------
+
 ASIO_TEST_SUITE
 (
   "ssl/stream",
   ASIO_COMPILE_TEST_CASE(ssl_stream_compile::test)
+  ASIO_TEST_CASE(ssl_stream_transfer::test)
+  ASIO_TEST_CASE(ssl_stream_batched_write::test)
+  ASIO_TEST_CASE(ssl_stream_dynamic_record_sizing::test)
+  ASIO_TEST_CASE(ssl_stream_handshake_executor::test)
+  ASIO_TEST_CASE(ssl_stream_kernel_tls::test)
 )
@@ -0,0 +1,263 @@
+//
+// trust_store.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/ssl/trust_store.hpp"
+
+#include "asio.hpp"
+#include "asio/ssl.hpp"
+#include "../unit_test.hpp"
+#include "test_certificate.hpp"
+
+//------------------------------------------------------------------------------
+
+// ssl_trust_store_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// ssl::trust_store, and the related members of ssl::context, compile and link
+// correctly. Runtime failures are ignored.
+
+namespace ssl_trust_store_compile {
+
+void test()
+{
+  using namespace asio;
+
+  try
+  {
+    asio::error_code ec;
+
+    // ssl::trust_store constructors.
+
+    ssl::trust_store store1;
+    ssl::trust_store store2(1024, asio::chrono::seconds(60));
+    ssl::trust_store store3(store1);
+    ssl::trust_store store4(std::move(store3));
+
+    // ssl::trust_store operators.
+
+    store4 = store2;
+
+    // ssl::trust_store functions.
+
+    ssl::trust_store::native_handle_type h = store1.native_handle();
+    (void)h;
+
+    store1.add_certificate_authority(asio::buffer("", 0));
+    store1.add_certificate_authority(asio::buffer("", 0), ec);
+
+    store1.load_verify_file("");
+    store1.load_verify_file("", ec);
+
+    store1.add_verify_path("");
+    store1.add_verify_path("", ec);
+
+    store1.set_default_verify_paths();
+    store1.set_default_verify_paths(ec);
+
+    std::size_t n = store2.verification_cache_size();
+    (void)n;
+
+    store2.clear_verification_cache();
+
+    // ssl::context functions.
+
+    ssl::context ctx(ssl::context::tls);
+    ctx.set_trust_store(store1);
+    ctx.set_trust_store(store1, ec);
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace ssl_trust_store_compile
+
+//------------------------------------------------------------------------------
+
+// ssl_trust_store_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that peer certificates are verified against a
+// trust store shared between contexts, and that cached verifications still
+// apply each context's verify callback.
+
+namespace ssl_trust_store_runtime {
+
+typedef asio::ssl::stream<asio::ip::tcp::socket> stream_type;
+
+// Make one connection and return whether the client handshake succeeded.
+bool connect(asio::ssl::context& server_ctx, asio::ssl::context& client_ctx)
+{
+  using asio::ip::tcp;
+
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  stream_type server(ioc, server_ctx);
+  stream_type client(ioc, client_ctx);
+  client.lowest_layer().connect(acceptor.local_endpoint());
+  acceptor.accept(server.lowest_layer());
+
+  asio::error_code client_ec;
+  server.async_handshake(asio::ssl::stream_base::server,
+      [](const asio::error_code&){});
+  client.async_handshake(asio::ssl::stream_base::client,
+      [&](const asio::error_code& e)
+      {
+        client_ec = e;
+        client.lowest_layer().close();
+      });
+  ioc.run();
+
+  if (!client_ec)
+  {
+    ASIO_CHECK(SSL_get_verify_result(client.native_handle()) == X509_V_OK);
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+    STACK_OF(X509)* chain = SSL_get0_verified_chain(client.native_handle());
+    ASIO_CHECK(chain != 0 && sk_X509_num(chain) == 1);
+#endif // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+  }
+
+  return !client_ec;
+}
+
+void add_test_authority(asio::ssl::trust_store& store)
+{
+  store.add_certificate_authority(asio::buffer(
+        ssl_test::certificate, sizeof(ssl_test::certificate) - 1));
+}
+
+void test_shared_store()
+{
+  asio::ssl::context server_ctx(asio::ssl::context::tls_server);
+  ssl_test::use_certificate(server_ctx);
+
+  asio::ssl::trust_store store;
+  add_test_authority(store);
+
+  // Contexts keep the store alive after the last trust_store object has gone.
+  asio::ssl::context client_ctx1(asio::ssl::context::tls_client);
+  asio::ssl::context client_ctx2(asio::ssl::context::tls_client);
+  {
+    asio::ssl::trust_store copy(store);
+    store = asio::ssl::trust_store();
+    client_ctx1.set_trust_store(copy);
+    client_ctx2.set_trust_store(copy);
+  }
+  client_ctx1.set_verify_mode(asio::ssl::verify_peer);
+  client_ctx2.set_verify_mode(asio::ssl::verify_peer);
+  ASIO_CHECK(SSL_CTX_get_cert_store(client_ctx1.native_handle())
+      == SSL_CTX_get_cert_store(client_ctx2.native_handle()));
+
+  ASIO_CHECK(connect(server_ctx, client_ctx1));
+  ASIO_CHECK(connect(server_ctx, client_ctx2));
+
+  // A context using the empty store rejects the certificate.
+  asio::ssl::context client_ctx3(asio::ssl::context::tls_client);
+  client_ctx3.set_trust_store(store);
+  client_ctx3.set_verify_mode(asio::ssl::verify_peer);
+  ASIO_CHECK(!connect(server_ctx, client_ctx3));
+  ASIO_CHECK(store.verification_cache_size() == 0);
+}
+
+struct counting_verification
+{
+  counting_verification(const std::string& host, int* calls)
+    : verification_(host),
+      calls_(calls)
+  {
+  }
+
+  bool operator()(bool preverified, asio::ssl::verify_context& ctx)
+  {
+    ++*calls_;
+    return verification_(preverified, ctx);
+  }
+
+  asio::ssl::host_name_verification verification_;
+  int* calls_;
+};
+
+void test_verification_cache()
+{
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  asio::ssl::context server_ctx(asio::ssl::context::tls_server);
+  ssl_test::use_certificate(server_ctx);
+
+  asio::ssl::trust_store store(2, asio::chrono::seconds(60));
+  add_test_authority(store);
+
+  int calls1 = 0;
+  asio::ssl::context client_ctx1(asio::ssl::context::tls_client);
+  client_ctx1.set_trust_store(store);
+  client_ctx1.set_verify_mode(asio::ssl::verify_peer);
+  client_ctx1.set_verify_callback(counting_verification("localhost", &calls1));
+
+  ASIO_CHECK(connect(server_ctx, client_ctx1));
+  ASIO_CHECK(store.verification_cache_size() == 1);
+  ASIO_CHECK(calls1 == 1);
+
+  // The cached verification is reused, and the verify callback is still
+  // called for the certificate.
+  ASIO_CHECK(connect(server_ctx, client_ctx1));
+  ASIO_CHECK(store.verification_cache_size() == 1);
+  ASIO_CHECK(calls1 == 2);
+
+  // Another context sharing the store also reuses the verification, but its
+  // own callback rejects the certificate.
+  int calls2 = 0;
+  asio::ssl::context client_ctx2(asio::ssl::context::tls_client);
+  client_ctx2.set_trust_store(store);
+  client_ctx2.set_verify_mode(asio::ssl::verify_peer);
+  client_ctx2.set_verify_callback(counting_verification("other.host", &calls2));
+  ASIO_CHECK(!connect(server_ctx, client_ctx2));
+  ASIO_CHECK(calls2 == 1);
+  ASIO_CHECK(store.verification_cache_size() == 1);
+
+  // Different verification parameters do not find the cached verification,
+  // and a failed verification is not cached.
+  asio::ssl::context client_ctx3(asio::ssl::context::tls_client);
+  client_ctx3.set_trust_store(store);
+  client_ctx3.set_verify_mode(asio::ssl::verify_peer);
+  SSL_CTX_set_verify_depth(client_ctx3.native_handle(), 5);
+  X509_VERIFY_PARAM_set1_host(
+      SSL_CTX_get0_param(client_ctx3.native_handle()), "other.host", 0);
+  ASIO_CHECK(!connect(server_ctx, client_ctx3));
+  ASIO_CHECK(store.verification_cache_size() == 1);
+
+  X509_VERIFY_PARAM_set1_host(
+      SSL_CTX_get0_param(client_ctx3.native_handle()), "localhost", 0);
+  ASIO_CHECK(connect(server_ctx, client_ctx3));
+  ASIO_CHECK(store.verification_cache_size() == 2);
+
+  store.clear_verification_cache();
+  ASIO_CHECK(store.verification_cache_size() == 0);
+  ASIO_CHECK(connect(server_ctx, client_ctx1));
+  ASIO_CHECK(calls1 == 3);
+  ASIO_CHECK(store.verification_cache_size() == 1);
+#endif // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+}
+
+} // namespace ssl_trust_store_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "ssl/trust_store",
+  ASIO_COMPILE_TEST_CASE(ssl_trust_store_compile::test)
+  ASIO_TEST_CASE(ssl_trust_store_runtime::test_shared_store)
+  ASIO_TEST_CASE(ssl_trust_store_runtime::test_verification_cache)
+)
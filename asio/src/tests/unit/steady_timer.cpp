@@ -21,10 +21,188 @@
 // Test that header file is self-contained.
 #include "asio/steady_timer.hpp"
 
+#include <functional>
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/wait_traits.hpp"
 #include "unit_test.hpp"
 
+namespace bindns = std;
+
+typedef asio::basic_waitable_timer<asio::chrono::steady_clock,
+    asio::timer_wheel_traits<asio::chrono::steady_clock>> wheel_timer;
+
+typedef asio::basic_waitable_timer<asio::chrono::steady_clock,
+    asio::timer_wheel_traits<asio::chrono::steady_clock,
+      asio::chrono::microseconds>> fine_wheel_timer;
+
+template <typename Timer>
+struct wheel_timer_handler
+{
+  Timer* timer_;
+  std::vector<Timer*>* fired_;
+  int* aborted_;
+  bool ordered_;
+
+  void operator()(const asio::error_code& ec)
+  {
+    if (ec == asio::error::operation_aborted)
+    {
+      ++(*aborted_);
+      return;
+    }
+
+    ASIO_CHECK(!ec);
+
+    // A timer must never complete before its expiry time.
+    ASIO_CHECK(timer_->expiry() <= asio::chrono::steady_clock::now());
+
+    // Timers must complete in order of expiry, allowing for timers that fall
+    // within the same tick of the wheel.
+    if (ordered_ && !fired_->empty())
+    {
+      ASIO_CHECK(fired_->back()->expiry()
+          <= timer_->expiry() + asio::chrono::milliseconds(1));
+    }
+
+    fired_->push_back(timer_);
+  }
+};
+
+template <typename Timer>
+void steady_timer_wheel_order_test_impl()
+{
+  asio::io_context ioc;
+  std::vector<Timer*> fired;
+  int aborted = 0;
+
+  // Spread expiry times across several levels of the wheel, and cancel every
+  // third timer.
+  const int num_timers = 300;
+  std::vector<Timer*> timers;
+  for (int i = 0; i < num_timers; ++i)
+  {
+    Timer* t = new Timer(ioc);
+    t->expires_after(asio::chrono::microseconds((i * 7919) % 300000));
+    wheel_timer_handler<Timer> h = { t, &fired, &aborted, true };
+    t->async_wait(h);
+    timers.push_back(t);
+  }
+
+  for (int i = 0; i < num_timers; i += 3)
+    ASIO_CHECK(timers[i]->cancel() == 1);
+
+  ioc.run();
+
+  ASIO_CHECK(aborted == num_timers / 3);
+  ASIO_CHECK(static_cast<int>(fired.size()) == num_timers - num_timers / 3);
+
+  for (int i = 0; i < num_timers; ++i)
+    delete timers[i];
+}
+
+void steady_timer_wheel_order_test()
+{
+  steady_timer_wheel_order_test_impl<wheel_timer>();
+  steady_timer_wheel_order_test_impl<fine_wheel_timer>();
+}
+
+void increment(int* count)
+{
+  ++(*count);
+}
+
+void increment_if_not_cancelled(int* count,
+    const asio::error_code& ec)
+{
+  if (!ec)
+    ++(*count);
+}
+
+void steady_timer_wheel_reschedule_test()
+{
+  asio::io_context ioc;
+  int count = 0;
+
+  // A timer that has already expired completes immediately.
+  wheel_timer t1(ioc, asio::chrono::steady_clock::now()
+      - asio::chrono::seconds(1));
+  t1.async_wait(bindns::bind(increment, &count));
+  ioc.poll();
+  ASIO_CHECK(count == 1);
+
+  // A distant timer does not prevent nearer timers from completing.
+  wheel_timer t2(ioc, asio::chrono::hours(24 * 365));
+  t2.async_wait(bindns::bind(increment_if_not_cancelled, &count,
+        bindns::placeholders::_1));
+
+  // Rescheduling a timer repeatedly cancels its previous wait each time.
+  wheel_timer t3(ioc);
+  for (int i = 0; i < 100; ++i)
+  {
+    t3.expires_after(asio::chrono::seconds(10 + i));
+    t3.async_wait(bindns::bind(increment_if_not_cancelled, &count,
+          bindns::placeholders::_1));
+  }
+  t3.expires_after(asio::chrono::milliseconds(20));
+  t3.async_wait(bindns::bind(increment_if_not_cancelled, &count,
+        bindns::placeholders::_1));
+
+  asio::chrono::steady_clock::time_point start
+    = asio::chrono::steady_clock::now();
+  ioc.restart();
+  ioc.run_until(t3.expiry() + asio::chrono::milliseconds(100));
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(asio::chrono::steady_clock::now() - start
+      >= asio::chrono::milliseconds(20));
+
+  // Timers may be moved while waiting.
+  wheel_timer t4(ioc, asio::chrono::milliseconds(5));
+  t4.async_wait(bindns::bind(increment, &count));
+  wheel_timer t5(std::move(t4));
+  ioc.restart();
+  ioc.run_for(asio::chrono::milliseconds(200));
+  ASIO_CHECK(count == 3);
+
+  ASIO_CHECK(t2.cancel() == 1);
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(count == 3);
+}
+
+void steady_timer_wheel_slack_test()
+{
+  asio::io_context ioc;
+  std::vector<wheel_timer*> fired;
+  int aborted = 0;
+
+  // Timers with slack never complete early, but may share a tick with, and
+  // complete before, timers that have an earlier expiry time.
+  const int num_timers = 100;
+  std::vector<wheel_timer*> timers;
+  for (int i = 0; i < num_timers; ++i)
+  {
+    wheel_timer* t = new wheel_timer(ioc);
+    t->expires_after_with_slack(asio::chrono::microseconds(i * 500),
+        asio::chrono::milliseconds(20));
+    wheel_timer_handler<wheel_timer> h = { t, &fired, &aborted, false };
+    t->async_wait(h);
+    timers.push_back(t);
+  }
+
+  ioc.run();
+
+  ASIO_CHECK(static_cast<int>(fired.size()) == num_timers);
+  ASIO_CHECK(aborted == 0);
+
+  for (int i = 0; i < num_timers; ++i)
+    delete timers[i];
+}
+
 ASIO_TEST_SUITE
 (
   "steady_timer",
-  ASIO_TEST_CASE(null_test)
+  ASIO_TEST_CASE(steady_timer_wheel_order_test)
+  ASIO_TEST_CASE(steady_timer_wheel_reschedule_test)
+  ASIO_TEST_CASE(steady_timer_wheel_slack_test)
 )
@@ -45,6 +45,15 @@ private:
   read_some_handler(const read_some_handler&);
 };
 
+struct sync_handler
+{
+  sync_handler() {}
+  void operator()(const asio::error_code&) {}
+  sync_handler(sync_handler&&) {}
+private:
+  sync_handler(const sync_handler&);
+};
+
 void test()
 {
 #if defined(ASIO_HAS_FILE)
@@ -134,6 +143,18 @@ void test()
     file1.sync_data();
     file1.sync_data(ec);
 
+    file1.async_sync_all(sync_handler());
+    int s5 = file1.async_sync_all(lazy);
+    (void)s5;
+
+    file1.async_sync_data(sync_handler());
+    int s6 = file1.async_sync_data(lazy);
+    (void)s6;
+
+    file1.async_sync_range(0, 0, sync_handler());
+    int s7 = file1.async_sync_range(0, 0, lazy);
+    (void)s7;
+
     asio::uint64_t s3 = file1.seek(0, stream_file::seek_set);
     (void)s3;
     asio::uint64_t s4 = file1.seek(0, stream_file::seek_set, ec);
@@ -21,10 +21,46 @@
 // Test that header file is self-contained.
 #include "asio/system_context.hpp"
 
+#include "asio/post.hpp"
+#include "asio/system_executor.hpp"
+#include "asio/use_future.hpp"
 #include "unit_test.hpp"
 
+//------------------------------------------------------------------------------
+
+// system_context_configure test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the system context may be configured before
+// it is first used.
+
+namespace system_context_configure {
+
+void test()
+{
+  asio::system_context::options opts;
+  opts.threads(3)
+    .placement(asio::thread_pool::placement::processor_set({0}))
+    .lazy_start(true);
+  ASIO_CHECK(asio::system_context::configure(opts));
+
+  asio::system_executor ex;
+  ASIO_CHECK(asio::query(ex, asio::execution::occupancy) == 3);
+
+  // The context now exists, so further configuration is ignored.
+  ASIO_CHECK(!asio::system_context::configure(asio::system_context::options()));
+
+#if defined(ASIO_HAS_STD_FUTURE_CLASS)
+  std::future<int> f = asio::post(ex, asio::use_future([]{ return 42; }));
+  ASIO_CHECK(f.get() == 42);
+#endif // defined(ASIO_HAS_STD_FUTURE_CLASS)
+}
+
+} // namespace system_context_configure
+
+//------------------------------------------------------------------------------
+
 ASIO_TEST_SUITE
 (
   "system_context",
-  ASIO_TEST_CASE(null_test)
+  ASIO_TEST_CASE(system_context_configure::test)
 )
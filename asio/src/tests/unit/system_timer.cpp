@@ -22,6 +22,7 @@
 #include "asio/system_timer.hpp"
 
 #include <functional>
+#include <vector>
 #include "asio/bind_cancellation_slot.hpp"
 #include "asio/cancellation_signal.hpp"
 #include "asio/executor_work_guard.hpp"
@@ -488,6 +489,65 @@ void system_timer_op_cancel_test()
   ASIO_CHECK(ioc.stopped());
 }
 
+void record_order(std::vector<int>* order, int id)
+{
+  order->push_back(id);
+}
+
+void system_timer_slack_test()
+{
+  asio::io_context ioc;
+  std::vector<int> order;
+
+  // The first timer is permitted enough slack to let it complete together
+  // with the second, and so completes after it.
+  asio::system_timer t1(ioc);
+  asio::system_timer::time_point start = now();
+  t1.expires_after_with_slack(asio::chrono::milliseconds(10),
+      asio::chrono::seconds(10));
+  t1.async_wait(bindns::bind(record_order, &order, 1));
+
+  asio::system_timer t2(ioc);
+  t2.expires_after(asio::chrono::milliseconds(50));
+  t2.async_wait(bindns::bind(record_order, &order, 2));
+
+  ioc.run();
+
+  ASIO_CHECK(order.size() == 2);
+  ASIO_CHECK(order[0] == 2);
+  ASIO_CHECK(order[1] == 1);
+  ASIO_CHECK(now() - start >= asio::chrono::milliseconds(50));
+
+  // Setting a new expiry time discards the slack.
+  order.clear();
+  t1.expires_after_with_slack(asio::chrono::milliseconds(10),
+      asio::chrono::seconds(10));
+  t1.expires_after(asio::chrono::milliseconds(10));
+  t1.async_wait(bindns::bind(record_order, &order, 1));
+  t2.expires_after(asio::chrono::milliseconds(50));
+  t2.async_wait(bindns::bind(record_order, &order, 2));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(order.size() == 2);
+  ASIO_CHECK(order[0] == 1);
+  ASIO_CHECK(order[1] == 2);
+
+  // A timer with slack never completes before its expiry time.
+  order.clear();
+  start = now();
+  t1.expires_after_with_slack(asio::chrono::milliseconds(20),
+      asio::chrono::milliseconds(5));
+  t1.async_wait(bindns::bind(record_order, &order, 1));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(order.size() == 1);
+  ASIO_CHECK(now() - start >= asio::chrono::milliseconds(20));
+}
+
 ASIO_TEST_SUITE
 (
   "system_timer",
@@ -497,4 +557,5 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(system_timer_thread_test)
   ASIO_TEST_CASE(system_timer_move_test)
   ASIO_TEST_CASE(system_timer_op_cancel_test)
+  ASIO_TEST_CASE(system_timer_slack_test)
 )
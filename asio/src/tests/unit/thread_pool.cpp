@@ -16,7 +16,11 @@
 // Test that header file is self-contained.
 #include "asio/thread_pool.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <functional>
+#include <thread>
+#include <vector>
 #include "asio/dispatch.hpp"
 #include "asio/post.hpp"
 #include "unit_test.hpp"
@@ -417,6 +421,115 @@ void thread_pool_allocator_test()
   ASIO_CHECK(total_count > 0);
 }
 
+void thread_pool_placement_test()
+{
+  std::atomic<int> count(0);
+
+  {
+    thread_pool pool(2, thread_pool::placement::all_numa_nodes());
+
+    for (int i = 0; i < 100; ++i)
+    {
+      asio::post(pool,
+          [&count, &pool]()
+          {
+            // Nested posts allocate from, and return memory to, the
+            // node-local recycling cache of the running thread.
+            asio::post(pool,
+                [&count]()
+                {
+                  ++count;
+                });
+          });
+    }
+
+    pool.join();
+  }
+
+  ASIO_CHECK(count == 100);
+
+  {
+    thread_pool pool(2, thread_pool::placement::processor_set({0}));
+
+    for (int i = 0; i < 100; ++i)
+      asio::post(pool, [&count](){ ++count; });
+
+    pool.join();
+  }
+
+  ASIO_CHECK(count == 200);
+
+  {
+    thread_pool pool(1,
+        thread_pool::placement::numa_nodes(std::vector<std::size_t>()));
+
+    asio::post(pool, [&count](){ ++count; });
+
+    pool.join();
+  }
+
+  ASIO_CHECK(count == 201);
+}
+
+void thread_pool_elastic_test()
+{
+  std::atomic<int> count(0);
+  std::atomic<int> running(0);
+  std::atomic<int> max_running(0);
+
+  thread_pool pool(
+      thread_pool::elastic(1, 4)
+        .grow_after(std::chrono::milliseconds(1))
+        .shrink_after(std::chrono::milliseconds(100))
+        .spin_before_park(std::chrono::microseconds(100)));
+
+  thread_pool::executor_type ex = pool.get_executor();
+  ASIO_CHECK(asio::query(ex, asio::execution::occupancy) == 1);
+
+  // A backlog of blocking functions causes threads to be added.
+  for (int i = 0; i < 16; ++i)
+  {
+    asio::post(pool,
+        [&]()
+        {
+          int n = ++running;
+          for (int m = max_running; n > m; m = max_running)
+            max_running.compare_exchange_weak(m, n);
+          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+          --running;
+          ++count;
+        });
+  }
+
+  while (count < 16)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  ASIO_CHECK(max_running > 1);
+  ASIO_CHECK(max_running <= 4);
+
+  // The added threads exit once they have been idle for long enough.
+  for (int i = 0; i < 200
+      && asio::query(ex, asio::execution::occupancy) > 1; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  ASIO_CHECK(asio::query(ex, asio::execution::occupancy) == 1);
+
+  // The pool continues to run functions with its remaining thread.
+  asio::post(pool, [&count](){ ++count; });
+  pool.join();
+  ASIO_CHECK(count == 17);
+
+  // Idle threads of a pool with a fixed number of threads may spin.
+  thread_pool pool2(
+      thread_pool::elastic(2, 2)
+        .spin_before_park(std::chrono::microseconds(100)));
+
+  for (int i = 0; i < 100; ++i)
+    asio::post(pool2, [&count](){ ++count; });
+
+  pool2.join();
+  ASIO_CHECK(count == 117);
+}
+
 ASIO_TEST_SUITE
 (
   "thread_pool",
@@ -425,4 +538,6 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(thread_pool_executor_query_test)
   ASIO_TEST_CASE(thread_pool_executor_execute_test)
   ASIO_TEST_CASE(thread_pool_allocator_test)
+  ASIO_TEST_CASE(thread_pool_placement_test)
+  ASIO_TEST_CASE(thread_pool_elastic_test)
 )
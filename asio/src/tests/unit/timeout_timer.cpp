@@ -0,0 +1,168 @@
+//
+// timeout_timer.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Prevent link dependency on the Boost.System library.
+#if !defined(BOOST_SYSTEM_NO_DEPRECATED)
+#define BOOST_SYSTEM_NO_DEPRECATED
+#endif // !defined(BOOST_SYSTEM_NO_DEPRECATED)
+
+// Test that header file is self-contained.
+#include "asio/timeout_timer.hpp"
+
+#include <functional>
+#include "asio/bind_cancellation_slot.hpp"
+#include "asio/cancellation_signal.hpp"
+#include "asio/io_context.hpp"
+#include "asio/steady_timer.hpp"
+#include "unit_test.hpp"
+
+typedef asio::chrono::steady_clock clock_type;
+typedef asio::chrono::milliseconds ms;
+
+struct wait_handler
+{
+  asio::error_code* ec_;
+  clock_type::time_point* completed_;
+  int* count_;
+
+  void operator()(const asio::error_code& ec)
+  {
+    *ec_ = ec;
+    *completed_ = clock_type::now();
+    ++(*count_);
+  }
+};
+
+void timeout_timer_push_back_test()
+{
+  asio::io_context ioc;
+  asio::timeout_timer t(ioc);
+  asio::error_code ec;
+  clock_type::time_point completed;
+  int count = 0;
+
+  t.expires_after(ms(30));
+  wait_handler h = { &ec, &completed, &count };
+  t.async_wait(h);
+
+  // Push the timeout back several times while the wait is outstanding.
+  asio::steady_timer ticker(ioc);
+  clock_type::time_point last_push;
+  int pushes = 0;
+  std::function<void(asio::error_code)> tick =
+    [&](asio::error_code)
+    {
+      last_push = clock_type::now();
+      t.expires_at(last_push + ms(30));
+      if (++pushes < 5)
+      {
+        ticker.expires_after(ms(10));
+        ticker.async_wait(tick);
+      }
+    };
+  ticker.expires_after(ms(10));
+  ticker.async_wait(tick);
+
+  ioc.run();
+
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(pushes == 5);
+  ASIO_CHECK(completed >= last_push + ms(30));
+  ASIO_CHECK(completed >= t.expiry());
+
+  // The timer may be waited on again once the previous wait has completed.
+  t.expires_after(ms(1));
+  t.async_wait(h);
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(!ec);
+}
+
+void timeout_timer_bring_forward_test()
+{
+  asio::io_context ioc;
+  asio::timeout_timer t(ioc);
+  asio::error_code ec;
+  clock_type::time_point completed;
+  int count = 0;
+
+  clock_type::time_point start = clock_type::now();
+  t.expires_after(asio::chrono::seconds(10));
+  wait_handler h = { &ec, &completed, &count };
+  t.async_wait(h);
+  t.expires_after(ms(10));
+
+  ioc.run();
+
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(completed >= start + ms(10));
+  ASIO_CHECK(completed < start + asio::chrono::seconds(5));
+}
+
+void timeout_timer_cancel_test()
+{
+  asio::io_context ioc;
+  asio::error_code ec;
+  clock_type::time_point completed;
+  int count = 0;
+  wait_handler h = { &ec, &completed, &count };
+
+  asio::timeout_timer t1(ioc);
+  clock_type::time_point expiry = clock_type::now() + asio::chrono::seconds(10);
+  t1.expires_at(expiry);
+  t1.async_wait(h);
+  ASIO_CHECK(t1.cancel() == 1);
+  ASIO_CHECK(t1.expiry() == expiry);
+
+  ioc.run();
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(ec == asio::error::operation_aborted);
+
+  // Destroying the timer cancels the outstanding wait.
+  {
+    asio::timeout_timer t2(ioc);
+    t2.expires_after(asio::chrono::seconds(10));
+    t2.async_wait(h);
+  }
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(ec == asio::error::operation_aborted);
+
+  // The wait supports per-operation cancellation.
+  asio::cancellation_signal sig;
+  t1.expires_after(asio::chrono::seconds(10));
+  t1.async_wait(asio::bind_cancellation_slot(sig.slot(), h));
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(count == 2);
+  sig.emit(asio::cancellation_type::terminal);
+
+  ioc.run();
+  ASIO_CHECK(count == 3);
+  ASIO_CHECK(ec == asio::error::operation_aborted);
+}
+
+ASIO_TEST_SUITE
+(
+  "timeout_timer",
+  ASIO_TEST_CASE(timeout_timer_push_back_test)
+  ASIO_TEST_CASE(timeout_timer_bring_forward_test)
+  ASIO_TEST_CASE(timeout_timer_cancel_test)
+)
@@ -0,0 +1,189 @@
+//
+// transport_info_sampler.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/transport_info_sampler.hpp"
+
+#include <functional>
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// transport_info_sampler_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// transport_info_sampler compile and link correctly. Runtime failures are
+// ignored.
+
+namespace transport_info_sampler_compile {
+
+void sample_handler(const asio::error_code&, asio::transport_info)
+{
+}
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    ip::tcp::socket sock(ioc);
+
+    transport_info_sampler<ip::tcp::socket> sampler1(
+        sock, chrono::milliseconds(100));
+    transport_info_sampler<ip::tcp::socket> sampler2(
+        sock, chrono::seconds(1));
+
+    any_io_executor ex = sampler1.get_executor();
+    (void)ex;
+
+    ip::tcp::socket& s = sampler1.socket();
+    (void)s;
+
+    transport_info_sampler<ip::tcp::socket>::duration d = sampler2.interval();
+    (void)d;
+
+    sampler1.async_sample(&sample_handler);
+    sampler1.cancel();
+
+    asio::error_code ec;
+    transport_info info = sock.get_transport_info(ec);
+    (void)info;
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace transport_info_sampler_compile
+
+//------------------------------------------------------------------------------
+
+// transport_info_sampler_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the
+// transport_info_sampler class.
+
+namespace transport_info_sampler_runtime {
+
+void handle_sample(const asio::error_code& ec, asio::transport_info info,
+    asio::error_code* out_ec, asio::transport_info* out_info, int* count)
+{
+  *out_ec = ec;
+  *out_info = info;
+  ++*count;
+}
+
+void test_sampling()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  namespace bindns = std;
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  char data[1024] = "";
+  asio::write(client_side_socket, asio::buffer(data));
+
+  const chrono::milliseconds interval(20);
+  transport_info_sampler<ip::tcp::socket> sampler(
+      client_side_socket, interval);
+  ASIO_CHECK(sampler.interval() == interval);
+
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+  asio::error_code ec;
+  transport_info info = transport_info();
+  int count = 0;
+  sampler.async_sample(bindns::bind(handle_sample,
+        _1, _2, &ec, &info, &count));
+  ioc.run();
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(chrono::steady_clock::now() - start >= interval);
+
+#if defined(__linux__)
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(info.rtt.count() > 0);
+  ASIO_CHECK(info.congestion_window > 0);
+#else // defined(__linux__)
+  ASIO_CHECK(!ec || ec == asio::error::operation_not_supported);
+#endif // defined(__linux__)
+
+  // The second sample is due one interval after the first.
+  ioc.restart();
+  sampler.async_sample(bindns::bind(handle_sample,
+        _1, _2, &ec, &info, &count));
+  ioc.run();
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(chrono::steady_clock::now() - start >= 2 * interval);
+}
+
+void test_cancel()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  namespace bindns = std;
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  io_context ioc;
+  ip::tcp::socket sock(ioc, ip::tcp::v4());
+
+  transport_info_sampler<ip::tcp::socket> sampler(sock, chrono::seconds(60));
+
+  asio::error_code ec;
+  transport_info info = transport_info();
+  int count = 0;
+  sampler.async_sample(bindns::bind(handle_sample,
+        _1, _2, &ec, &info, &count));
+  ioc.poll();
+  ASIO_CHECK(count == 0);
+
+  sampler.cancel();
+  ioc.run();
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(ec == asio::error::operation_aborted);
+  ASIO_CHECK(info.congestion_window == 0);
+}
+
+} // namespace transport_info_sampler_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "transport_info_sampler",
+  ASIO_COMPILE_TEST_CASE(transport_info_sampler_compile::test)
+  ASIO_TEST_CASE(transport_info_sampler_runtime::test_sampling)
+  ASIO_TEST_CASE(transport_info_sampler_runtime::test_cancel)
+)
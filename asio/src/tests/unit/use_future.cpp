@@ -17,6 +17,12 @@
 #include "asio/use_future.hpp"
 
 #include <string>
+#include "asio/append.hpp"
+#include "asio/dispatch.hpp"
+#include "asio/executor_work_guard.hpp"
+#include "asio/io_context.hpp"
+#include "asio/steady_timer.hpp"
+#include "asio/thread.hpp"
 #include "unit_test.hpp"
 
 #if defined(ASIO_HAS_STD_FUTURE_CLASS)
@@ -646,6 +652,94 @@ void use_future_package_3_test()
   }
 }
 
+void use_future_slot_test()
+{
+  using asio::future_slot;
+  using asio::use_future;
+  using namespace archetypes;
+
+  future_slot<void> s0;
+  ASIO_CHECK(!s0.ready());
+  async_op_0(use_future(s0));
+  s0.wait();
+  ASIO_CHECK(s0.ready());
+  s0.get();
+  ASIO_CHECK(!s0.ready());
+
+  async_op_ec_0(false, use_future(s0));
+  try
+  {
+    s0.get();
+    ASIO_CHECK(false);
+  }
+  catch (asio::system_error& e)
+  {
+    ASIO_CHECK(e.code() == asio::error::operation_aborted);
+  }
+  catch (...)
+  {
+    ASIO_CHECK(false);
+  }
+
+  future_slot<int> s1;
+  async_op_ec_1(true, use_future(s1));
+  ASIO_CHECK(s1.get() == 42);
+
+  // A slot may be reused once its result has been taken.
+  async_op_ex_1(true, use_future(s1));
+  ASIO_CHECK(s1.get() == 42);
+
+  async_op_ex_1(false, use_future(s1));
+  try
+  {
+    s1.get();
+    ASIO_CHECK(false);
+  }
+  catch (std::exception& e)
+  {
+    ASIO_CHECK(e.what() == std::string("blah"));
+  }
+  catch (...)
+  {
+    ASIO_CHECK(false);
+  }
+
+  future_slot<std::tuple<int, double>> s2;
+  async_op_ec_2(true, use_future(s2));
+  int i;
+  double d;
+  std::tie(i, d) = s2.get();
+  ASIO_CHECK(i == 42);
+  ASIO_CHECK(d == 2.0);
+
+  // A result that is never taken is destroyed with the slot.
+  {
+    future_slot<std::string> s3;
+    asio::dispatch(asio::append(use_future(s3), std::string(100, 'x')));
+    s3.wait();
+  }
+}
+
+void use_future_slot_thread_test()
+{
+  asio::io_context ioc;
+  asio::executor_work_guard<asio::io_context::executor_type>
+    work = asio::make_work_guard(ioc);
+  asio::thread t([&ioc]{ ioc.run(); });
+
+  asio::future_slot<void> slot;
+  asio::steady_timer timer(ioc);
+  for (int i = 0; i < 20; ++i)
+  {
+    timer.expires_after(asio::chrono::milliseconds(1));
+    timer.async_wait(asio::use_future(slot));
+    slot.get();
+  }
+
+  work.reset();
+  t.join();
+}
+
 ASIO_TEST_SUITE
 (
   "use_future",
@@ -657,6 +751,8 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(use_future_package_1_test)
   ASIO_TEST_CASE(use_future_package_2_test)
   ASIO_TEST_CASE(use_future_package_3_test)
+  ASIO_TEST_CASE(use_future_slot_test)
+  ASIO_TEST_CASE(use_future_slot_thread_test)
 )
 
 #else // defined(ASIO_HAS_STD_FUTURE_CLASS)
@@ -45,6 +45,15 @@ private:
   read_some_handler(const read_some_handler&);
 };
 
+struct wait_handler
+{
+  wait_handler() {}
+  void operator()(const asio::error_code&) {}
+  wait_handler(wait_handler&&) {}
+private:
+  wait_handler(const wait_handler&);
+};
+
 void test()
 {
 #if defined(ASIO_HAS_PIPE)
@@ -120,6 +129,15 @@ void test()
     (void)i1;
     int i2 = pipe1.async_write_some(buffer(const_char_buffer), lazy);
     (void)i2;
+
+#if !defined(ASIO_HAS_IOCP)
+    pipe1.wait();
+    pipe1.wait(ec);
+
+    pipe1.async_wait(wait_handler());
+    int i3 = pipe1.async_wait(lazy);
+    (void)i3;
+#endif // !defined(ASIO_HAS_IOCP)
   }
   catch (std::exception&)
   {
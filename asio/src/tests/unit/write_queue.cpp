@@ -0,0 +1,259 @@
+//
+// write_queue.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/write_queue.hpp"
+
+#include <functional>
+#include <string>
+#include "asio/bind_cancellation_slot.hpp"
+#include "asio/cancellation_signal.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/read.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// write_queue_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// write_queue compile and link correctly. Runtime failures are ignored.
+
+namespace write_queue_compile {
+
+void wait_handler(const asio::error_code&)
+{
+}
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    chain_buffer_pool pool;
+    char data[1024] = "";
+    asio::error_code ec;
+
+    write_queue<ip::tcp::socket> queue1(ioc, pool, 1024, 256);
+    write_queue<ip::tcp::socket&> queue2(queue1.next_layer(),
+        pool, 1024, 256, 4096);
+
+    write_queue<ip::tcp::socket>::lowest_layer_type& lowest_layer
+      = queue1.lowest_layer();
+    (void)lowest_layer;
+
+    const write_queue<ip::tcp::socket>& const_queue1 = queue1;
+    const write_queue<ip::tcp::socket>::lowest_layer_type& lowest_layer2
+      = const_queue1.lowest_layer();
+    (void)lowest_layer2;
+
+    any_io_executor ex = queue1.get_executor();
+    (void)ex;
+
+    std::size_t n = queue1.size() + queue1.max_size()
+      + queue1.high_watermark() + queue1.low_watermark();
+    (void)n;
+
+    bool b = queue1.paused();
+    (void)b;
+
+    queue1.enqueue(buffer(data));
+    queue1.enqueue(buffer(data), ec);
+
+    queue1.async_wait_writable(&wait_handler);
+    queue1.async_flush(&wait_handler);
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace write_queue_compile
+
+//------------------------------------------------------------------------------
+
+// write_queue_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the write_queue class.
+
+namespace write_queue_runtime {
+
+using asio::ip::tcp;
+
+struct connection
+{
+  explicit connection(asio::io_context& ioc)
+    : client(ioc),
+      server(ioc)
+  {
+    tcp::acceptor acceptor(ioc,
+        tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+    client.connect(acceptor.local_endpoint());
+    acceptor.accept(server);
+  }
+
+  tcp::socket client;
+  tcp::socket server;
+};
+
+void test_ordering()
+{
+  asio::io_context ioc;
+  connection c(ioc);
+  asio::chain_buffer_pool pool(16);
+  asio::write_queue<tcp::socket&> queue(c.client, pool, 1 << 20, 1 << 10);
+
+  // Data queued while earlier data is being written is delivered in order.
+  std::string expected;
+  for (int i = 0; i < 100; ++i)
+  {
+    std::string message = "message " + std::to_string(i) + ";";
+    queue.enqueue(asio::buffer(message));
+    expected += message;
+  }
+
+  asio::error_code flush_ec = asio::error::would_block;
+  queue.async_flush([&](asio::error_code ec){ flush_ec = ec; });
+  ASIO_CHECK(flush_ec == asio::error::would_block);
+  ioc.run();
+  ASIO_CHECK(!flush_ec);
+  ASIO_CHECK(queue.size() == 0);
+
+  std::string received(expected.size(), '\0');
+  asio::read(c.server, asio::buffer(&received[0], received.size()));
+  ASIO_CHECK(received == expected);
+
+  // A flush with nothing queued completes without waiting.
+  flush_ec = asio::error::would_block;
+  queue.async_flush([&](asio::error_code ec){ flush_ec = ec; });
+  ASIO_CHECK(flush_ec == asio::error::would_block);
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(!flush_ec);
+}
+
+void test_watermarks()
+{
+  asio::io_context ioc;
+  connection c(ioc);
+  c.client.set_option(tcp::socket::send_buffer_size(4096));
+  c.server.set_option(tcp::socket::receive_buffer_size(4096));
+
+  asio::chain_buffer_pool pool(4096);
+  asio::write_queue<tcp::socket&> queue(c.client,
+      pool, 256 * 1024, 64 * 1024, 512 * 1024);
+
+  // Fill the queue until it pauses, while the peer is not reading.
+  std::string chunk(16 * 1024, 'x');
+  std::size_t queued = 0;
+  while (!queue.paused())
+  {
+    queue.enqueue(asio::buffer(chunk));
+    queued += chunk.size();
+  }
+  ioc.poll();
+  ASIO_CHECK(queue.paused());
+  ASIO_CHECK(queue.size() > queue.low_watermark());
+
+  // The memory budget is enforced.
+  asio::error_code ec;
+  while (!ec)
+  {
+    queue.enqueue(asio::buffer(chunk), ec);
+    if (!ec)
+      queued += chunk.size();
+  }
+  ASIO_CHECK(ec == asio::error::no_buffer_space);
+  ASIO_CHECK(queue.size() <= queue.max_size());
+
+  // A paused wait is cancelled through its cancellation slot.
+  asio::cancellation_signal signal;
+  asio::error_code wait_ec;
+  queue.async_wait_writable(asio::bind_cancellation_slot(signal.slot(),
+        [&](asio::error_code e){ wait_ec = e; }));
+  ioc.poll();
+  signal.emit(asio::cancellation_type::terminal);
+  ioc.poll();
+  ASIO_CHECK(wait_ec == asio::error::operation_aborted);
+
+  // Once the peer drains the data, the queue resumes.
+  bool resumed = false;
+  queue.async_wait_writable(
+      [&](asio::error_code e)
+      {
+        ASIO_CHECK(!e);
+        ASIO_CHECK(!queue.paused());
+        ASIO_CHECK(queue.size() <= queue.low_watermark());
+        resumed = true;
+      });
+
+  std::string sink(queued, '\0');
+  std::size_t received = 0;
+  std::function<void()> read_more = [&]()
+  {
+    c.server.async_read_some(
+        asio::buffer(&sink[received], sink.size() - received),
+        [&](asio::error_code e, std::size_t n)
+        {
+          received += n;
+          if (!e && received < sink.size())
+            read_more();
+        });
+  };
+  read_more();
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(resumed);
+  ASIO_CHECK(received == queued);
+  ASIO_CHECK(sink == std::string(queued, 'x'));
+}
+
+void test_error()
+{
+  asio::io_context ioc;
+  connection c(ioc);
+  asio::chain_buffer_pool pool;
+  asio::write_queue<tcp::socket&> queue(c.client, pool, 1024, 512);
+
+  // A failed write discards the queue and is reported by later operations.
+  c.client.shutdown(tcp::socket::shutdown_send);
+  queue.enqueue(asio::buffer("data", 4));
+  asio::error_code flush_ec;
+  queue.async_flush([&](asio::error_code e){ flush_ec = e; });
+  ioc.run();
+  ASIO_CHECK(flush_ec == asio::error::broken_pipe);
+  ASIO_CHECK(queue.size() == 0);
+
+  asio::error_code ec;
+  queue.enqueue(asio::buffer("data", 4), ec);
+  ASIO_CHECK(ec == asio::error::broken_pipe);
+}
+
+} // namespace write_queue_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "write_queue",
+  ASIO_COMPILE_TEST_CASE(write_queue_compile::test)
+  ASIO_TEST_CASE(write_queue_runtime::test_ordering)
+  ASIO_TEST_CASE(write_queue_runtime::test_watermarks)
+  ASIO_TEST_CASE(write_queue_runtime::test_error)
+)
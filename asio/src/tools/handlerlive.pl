@@ -7,7 +7,9 @@
 # to print a list of "live" handlers. These are handlers that are associated
 # with operations that have not yet completed, or running handlers that have
 # not yet finished their execution. Programs write this output to the standard
-# error stream when compiled with the define `ASIO_ENABLE_HANDLER_TRACKING'.
+# error stream when compiled with the define `ASIO_ENABLE_HANDLER_TRACKING', or
+# when draining the records collected with the define
+# `ASIO_ENABLE_BUFFERED_HANDLER_TRACKING'.
 #
 # Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
 #
@@ -5,7 +5,8 @@
 # A tool for post-processing the debug output generated by Asio-based programs
 # to print the tree of handlers that resulted in some specified handler ids.
 # Programs write this output to the standard error stream when compiled with
-# the define `ASIO_ENABLE_HANDLER_TRACKING'.
+# the define `ASIO_ENABLE_HANDLER_TRACKING', or when draining the records
+# collected with the define `ASIO_ENABLE_BUFFERED_HANDLER_TRACKING'.
 #
 # Copyright (c) 2003-2025 Christopher M. Kohlhoff (chris at kohlhoff dot com)
 #
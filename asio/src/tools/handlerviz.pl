@@ -5,7 +5,8 @@
 #
 # A visualisation tool for post-processing the debug output generated by
 # Asio-based programs. Programs write this output to the standard error stream
-# when compiled with the define `ASIO_ENABLE_HANDLER_TRACKING'.
+# when compiled with the define `ASIO_ENABLE_HANDLER_TRACKING', or when draining
+# the records collected with the define `ASIO_ENABLE_BUFFERED_HANDLER_TRACKING'.
 #
 # This tool generates output intended for use with the GraphViz tool `dot'. For
 # example, to convert output to a PNG image, use: